@@ -0,0 +1,184 @@
+/*
+ * AdaptiveTessellation.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ADAPTIVE_TESSELLATION_H
+#define LLGL_ADAPTIVE_TESSELLATION_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "CommandBuffer.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Adaptive tessellation descriptor structure.
+\see AdaptiveTessellation
+*/
+struct AdaptiveTessellationDescriptor
+{
+    /**
+    \brief Specifies the compute pipeline, which computes the tessellation factors of all patches. This must not be null.
+    \remarks The compute shader must read the AdaptiveTessellationParameters from a constant buffer at slot 0,
+    the patches from a read-only structured buffer at slot 0, and write the factors into a read/write structured buffer at slot 1.
+    Each patch is a quad of four corner positions in world space (4 x float4, the w components are ignored),
+    in the same order as the control points of PrimitiveTopology::Patches4, i.e. two rows of two corners each.
+    Each thread computes the factors of one patch (see AdaptiveTessellationFactors), and the patches are dispatched
+    with ceil(numPatches/threadGroupSize) x 1 x 1 thread groups.
+    For each edge, the corners are projected into screen space and the factor is the projected length divided by
+    AdaptiveTessellationParameters::targetEdgeLength, clamped to [minFactor, maxFactor].
+    The inside factors are the maximum of the two opposing edges.
+    */
+    ComputePipeline*    pipeline        = nullptr;
+
+    //! Specifies the maximal number of patches. By default 4096.
+    std::uint32_t       maxPatches      = 4096;
+
+    //! Specifies the number of threads in X dimension of each thread group of the compute shader. By default 64.
+    std::uint32_t       threadGroupSize = 64;
+};
+
+/**
+\brief Adaptive tessellation parameters structure.
+\remarks This is the layout of the constant buffer of the compute shader, which is compatible with the std140 layout in GLSL.
+\see AdaptiveTessellation::Compute
+*/
+struct AdaptiveTessellationParameters
+{
+    //! View-projection matrix (in column-major order), which transforms the patch corners from world space into clip space.
+    float           viewProjection[16]  = { 1.0f, 0.0f, 0.0f, 0.0f,
+                                            0.0f, 1.0f, 0.0f, 0.0f,
+                                            0.0f, 0.0f, 1.0f, 0.0f,
+                                            0.0f, 0.0f, 0.0f, 1.0f };
+
+    //! Size (in pixels) of the viewport the patches are rendered into.
+    float           viewportSize[2]     = { 1.0f, 1.0f };
+
+    /**
+    \brief Specifies the desired length (in pixels) of each tessellated edge segment. By default 16.
+    \remarks Smaller values increase the tessellation of patches close to the camera. Values below 8 pixels
+    rarely improve the image quality but quickly make the tessellator and the rasterizer the bottleneck.
+    */
+    float           targetEdgeLength    = 16.0f;
+
+    //! Specifies the minimal tessellation factor. By default 1.
+    float           minFactor           = 1.0f;
+
+    //! Specifies the maximal tessellation factor, which must not exceed 64. By default 64.
+    float           maxFactor           = 64.0f;
+
+    //! Number of patches. This is written by AdaptiveTessellation::Compute.
+    std::uint32_t   numPatches          = 0;
+
+    std::uint32_t   reserved[2]         = { 0, 0 };
+};
+
+/**
+\brief Tessellation factors of a single quad patch, as written by the compute shader of the adaptive tessellation.
+\remarks The edges are in the order of SV_TessFactor and gl_TessLevelOuter, the inside factors in the order of SV_InsideTessFactor and gl_TessLevelInner.
+The hull or tessellation control shader reads these factors from a structured buffer indexed by SV_PrimitiveID or gl_PrimitiveID.
+*/
+struct AdaptiveTessellationFactors
+{
+    float edges[4];
+    float inside[2];
+    float reserved[2];
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Compute pass, which determines the tessellation factors of quad patches from their projected size in screen space.
+\remarks Fixed tessellation factors waste most of the tessellated triangles on patches that are far away or off screen,
+which makes the tessellator the bottleneck long before the image quality improves.
+This pass computes the factors on the GPU for each frame, so each tessellated edge segment covers roughly the same number of pixels,
+and the factor buffer is bound to the hull or tessellation control shader without any CPU-side readback.
+\code
+LLGL::AdaptiveTessellation adaptiveTess(*renderer, *commands, adaptiveTessDesc);
+
+// Render loop
+LLGL::AdaptiveTessellationParameters params;
+// Fill params.viewProjection and params.viewportSize ...
+adaptiveTess.Compute(*patchBuffer, numPatches, params);
+
+commands->SetStorageBuffer(adaptiveTess.GetFactorBuffer(), 1, LLGL::ShaderStageFlags::TessControlStage | LLGL::ShaderStageFlags::ReadOnlyResource);
+// Draw patches with LLGL::PrimitiveTopology::Patches4 ...
+\endcode
+\note Only supported with: OpenGL 4.3, Direct3D 11, Direct3D 12.
+*/
+class LLGL_EXPORT AdaptiveTessellation
+{
+
+    public:
+
+        AdaptiveTessellation(const AdaptiveTessellation&) = delete;
+        AdaptiveTessellation& operator = (const AdaptiveTessellation&) = delete;
+
+        /**
+        \brief Creates the constant buffer and the factor buffer.
+        \param[in] renderSystem Specifies the render system, which is used to create and write the buffers.
+        \param[in] commandBuffer Specifies the command buffer, which records the compute pass.
+        \param[in] desc Specifies the adaptive tessellation descriptor.
+        \throw std::invalid_argument If the compute pipeline is null, or if the maximal number of patches or the thread group size is zero.
+        \throw std::runtime_error If the render system does not support tessellation or compute shaders.
+        */
+        AdaptiveTessellation(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const AdaptiveTessellationDescriptor& desc);
+
+        //! Releases the constant buffer and the factor buffer.
+        ~AdaptiveTessellation();
+
+        /**
+        \brief Records the compute pass, which writes the tessellation factors of the specified patches into the factor buffer.
+        \param[in] patchBuffer Specifies the storage buffer with the corners of all patches (see AdaptiveTessellationDescriptor::pipeline).
+        \param[in] numPatches Specifies the number of patches.
+        \param[in] params Specifies the parameters of the compute pass. The number of patches of this structure is ignored.
+        \remarks This inserts a barrier for the factor buffer, so it can be read by the subsequent draw commands.
+        \throw std::out_of_range If 'numPatches' is greater than the maximal number of patches.
+        */
+        void Compute(Buffer& patchBuffer, std::uint32_t numPatches, const AdaptiveTessellationParameters& params);
+
+        /**
+        \brief Returns the buffer with the factors of all patches, as computed by the most recent call to Compute.
+        \remarks This is a read/write structured buffer of AdaptiveTessellationFactors entries.
+        */
+        inline Buffer& GetFactorBuffer() const
+        {
+            return *factorBuffer_;
+        }
+
+        //! Returns the descriptor of this adaptive tessellation.
+        inline const AdaptiveTessellationDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+    private:
+
+        RenderSystem&                   renderSystem_;
+        CommandBuffer&                  commandBuffer_;
+        AdaptiveTessellationDescriptor  desc_;
+        Buffer*                         constantBuffer_ = nullptr;
+        Buffer*                         factorBuffer_   = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,83 @@
+/*
+ * Allocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ALLOCATOR_H
+#define LLGL_ALLOCATOR_H
+
+
+#include "Export.h"
+#include <memory>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Interface for the CPU memory allocations of LLGL.
+\remarks Install a custom allocator with SetAllocator to route the internal memory of LLGL into the arenas or pools of the application.
+Every allocation carries a tag that names its purpose (e.g. "ByteBuffer" or "HWObjectContainer"), which can be used for allocation telemetry.
+The allocator must be thread safe, since LLGL allocates memory from worker threads as well.
+\see SetAllocator
+*/
+class LLGL_EXPORT Allocator
+{
+
+    public:
+
+        virtual ~Allocator();
+
+        /**
+        \brief Allocates a block of memory.
+        \param[in] size Specifies the size (in bytes) of the memory block. This is never 0.
+        \param[in] alignment Specifies the alignment (in bytes) of the memory block. This is always a power of two.
+        \param[in] tag Specifies the null-terminated name of the allocation purpose. This is a string literal, i.e. it remains valid.
+        \return Pointer to the memory block. This must not be null; allocation failures must be reported with std::bad_alloc.
+        */
+        virtual void* Allocate(std::size_t size, std::size_t alignment, const char* tag) = 0;
+
+        //! Frees the specified memory block. The parameters are the same as those the block has been allocated with.
+        virtual void Free(void* ptr, std::size_t size, std::size_t alignment, const char* tag) = 0;
+
+};
+
+/**
+\brief Sets the allocator for all internal CPU memory allocations of LLGL.
+\param[in] allocator Pointer to the new allocator, or null to restore the default allocator (which uses the global heap).
+\remarks This must be called before any render system is loaded, and the allocator must not be replaced while any LLGL object is alive,
+because internal containers return their memory to the current allocator. The allocator must remain valid until all LLGL objects have been released.
+\see Allocator
+*/
+LLGL_EXPORT void SetAllocator(Allocator* allocator);
+
+//! Returns the current allocator for all internal CPU memory allocations of LLGL. This is never null.
+LLGL_EXPORT Allocator* GetAllocator();
+
+//! Deleter for memory blocks that have been allocated with the allocator of LLGL (see ByteBuffer).
+struct LLGL_EXPORT AllocatorDeleter
+{
+    AllocatorDeleter() = default;
+    AllocatorDeleter(Allocator* allocator, std::size_t size, std::size_t alignment, const char* tag);
+
+    void operator () (char* ptr) const;
+
+    Allocator*  allocator   = nullptr;
+    std::size_t size        = 0;
+    std::size_t alignment   = 0;
+    const char* tag         = nullptr;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,205 @@
+/*
+ * BackBufferCapture.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BACK_BUFFER_CAPTURE_H
+#define LLGL_BACK_BUFFER_CAPTURE_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "RenderContext.h"
+#include "CommandBuffer.h"
+#include <Gauss/Vector2.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Back buffer capture descriptor structure.
+\see BackBufferCapture
+*/
+struct BackBufferCaptureDescriptor
+{
+    /**
+    \brief Specifies the number of capture slots. By default 3.
+    \remarks Each slot holds one captured frame until it has been released by the consumer (e.g. a video encoder).
+    If all slots are in use, further frames are dropped instead of stalling the renderer.
+    */
+    unsigned int        numSlots            = 3;
+
+    /**
+    \brief Specifies an optional compute pipeline, which converts each captured frame into the NV12 format. By default null.
+    \remarks The compute shader must read the captured RGBA8 texture from slot 0 and write into a
+    read/write structured buffer of 32-bit unsigned integers at slot 1. Each thread converts a block of 4x2 pixels,
+    and the frame is dispatched with ceil(width/4/yuvThreadGroupSize) x ceil(height/2/yuvThreadGroupSize) thread groups.
+    The buffer contains the luma plane (width*height bytes), followed by the interleaved chroma plane (width*height/2 bytes).
+    The resolution must be a multiple of 4 horizontally and a multiple of 2 vertically.
+    \note Only supported with: Direct3D 11, Direct3D 12 (read/write structured buffers).
+    */
+    ComputePipeline*    yuvPipeline         = nullptr;
+
+    //! Specifies the number of threads in X and Y dimension of each thread group of the 'yuvPipeline' compute shader. By default 8.
+    unsigned int        yuvThreadGroupSize  = 8;
+};
+
+/**
+\brief Captured back buffer frame structure.
+\see BackBufferCapture::AcquireFrame
+*/
+struct BackBufferCaptureFrame
+{
+    //! RGBA8 texture with a copy of the back buffer.
+    Texture*        texture     = nullptr;
+
+    //! Buffer with the frame in the NV12 format, or null if no YUV pipeline has been specified.
+    Buffer*         yuvBuffer   = nullptr;
+
+    //! Zero-based index of the frame, which is incremented for each successful capture.
+    std::uint64_t   frameIndex  = 0;
+
+    //! Size (in pixels) of the captured frame.
+    Gs::Vector2ui   size;
+
+    //! Internal slot index of this frame.
+    unsigned int    slot        = ~0u;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Captures the back buffer of a render context into a ring of GPU textures for video encoders.
+\remarks Each captured frame stays on the GPU: the back buffer is copied with RenderContext::CopyBackBuffer,
+optionally converted into the NV12 format with a compute shader, and a fence is signaled after the copy.
+A frame can be acquired as soon as its fence is signaled, so the consumer never stalls the renderer,
+and the texture or buffer of the frame can be shared with a hardware video encoder without any CPU-side copies.
+\code
+LLGL::BackBufferCapture capture(*renderer, *context, *commands, captureDesc);
+
+// Render frame, then capture it before it is presented ...
+capture.Capture();
+context->Present();
+
+// Consume all completed frames
+LLGL::BackBufferCaptureFrame frame;
+while (capture.AcquireFrame(frame))
+{
+    // Pass frame.texture or frame.yuvBuffer to the video encoder ...
+    capture.ReleaseFrame(frame);
+}
+\endcode
+*/
+class LLGL_EXPORT BackBufferCapture
+{
+
+    public:
+
+        BackBufferCapture(const BackBufferCapture&) = delete;
+        BackBufferCapture& operator = (const BackBufferCapture&) = delete;
+
+        /**
+        \brief Creates the fences of all capture slots. The textures are created with the first capture.
+        \param[in] renderSystem Specifies the render system, which is used to create the capture resources.
+        \param[in] renderContext Specifies the render context whose back buffer is captured.
+        \param[in] commandBuffer Specifies the command buffer, which records the YUV conversion and fence signals.
+        \param[in] desc Specifies the capture descriptor.
+        \throw std::invalid_argument If the number of slots or the YUV thread group size is zero.
+        */
+        BackBufferCapture(
+            RenderSystem&                       renderSystem,
+            RenderContext&                      renderContext,
+            CommandBuffer&                      commandBuffer,
+            const BackBufferCaptureDescriptor&  desc
+        );
+
+        //! Waits for all pending captures and releases all capture resources.
+        ~BackBufferCapture();
+
+        /**
+        \brief Captures the current back buffer into the next free slot.
+        \return True if the frame has been captured, or false if all slots are in use and the frame has been dropped.
+        \remarks This must be called before the back buffer is presented.
+        If the resolution of the render context has changed, the resources of the slot are recreated.
+        \throw std::invalid_argument If a YUV pipeline is specified and the resolution is not a multiple of 4x2.
+        */
+        bool Capture();
+
+        /**
+        \brief Acquires the oldest captured frame whose copy has been completed by the GPU.
+        \param[out] frame Receives the captured frame.
+        \return True if a frame has been acquired, or false if no completed frame is available.
+        \remarks The frame must be released with ReleaseFrame, before its slot can be used for another capture.
+        */
+        bool AcquireFrame(BackBufferCaptureFrame& frame);
+
+        /**
+        \brief Releases the specified frame, so its slot can be used for another capture.
+        \throw std::invalid_argument If the frame has not been acquired from this capture.
+        */
+        void ReleaseFrame(const BackBufferCaptureFrame& frame);
+
+        //! Returns the descriptor of this capture.
+        inline const BackBufferCaptureDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+        //! Returns the number of frames that have been dropped, because all slots were in use.
+        inline std::uint64_t GetNumDroppedFrames() const
+        {
+            return numDroppedFrames_;
+        }
+
+    private:
+
+        enum class SlotState
+        {
+            Free,
+            Pending,
+            Ready,
+            Acquired,
+        };
+
+        struct Slot
+        {
+            SlotState       state       = SlotState::Free;
+            Texture*        texture     = nullptr;
+            Buffer*         yuvBuffer   = nullptr;
+            Fence*          fence       = nullptr;
+            Gs::Vector2ui   size;
+            std::uint64_t   frameIndex  = 0;
+        };
+
+        void UpdateSlotResources(Slot& slot, const Gs::Vector2ui& size);
+        void ReleaseSlotResources(Slot& slot);
+
+        RenderSystem&               renderSystem_;
+        RenderContext&              renderContext_;
+        CommandBuffer&              commandBuffer_;
+        BackBufferCaptureDescriptor desc_;
+        std::vector<Slot>           slots_;
+        unsigned int                nextSlot_           = 0;
+        std::uint64_t               numFrames_          = 0;
+        std::uint64_t               numDroppedFrames_   = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,184 @@
+/*
+ * BlockCompressionEncoder.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BLOCK_COMPRESSION_ENCODER_H
+#define LLGL_BLOCK_COMPRESSION_ENCODER_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "CommandBuffer.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Block compression encoder descriptor structure.
+\see BlockCompressionEncoder
+*/
+struct BlockCompressionEncoderDescriptor
+{
+    /**
+    \brief Specifies the compute pipeline, which encodes the blocks of the destination format. This must not be null.
+    \remarks The compute shader must read the BlockCompressionParameters from a constant buffer at slot 0,
+    the uncompressed source texture from a texture at slot 0 (with texelFetch in GLSL or Texture2D::Load in HLSL, i.e. without sampler),
+    and write the compressed blocks into a read/write structured buffer at slot 1.
+    Each entry of the structured buffer is one 4x4 block, i.e. 'uvec2'/'uint2' for 8-byte formats (BC1, ETC2 RGB)
+    and 'uvec4'/'uint4' for 16-byte formats (BC3, BC7, ETC2 RGBA), in the bit layout of the respective format.
+    Each thread encodes one block, and the blocks are stored in row-major order, i.e. at index (blockY * numBlocks.x + blockX).
+    The blocks are dispatched with ceil(numBlocks.x/threadGroupSizeX) x ceil(numBlocks.y/threadGroupSizeY) x 1 thread groups,
+    so the shader must discard threads outside of the number of blocks.
+    */
+    ComputePipeline*    pipeline            = nullptr;
+
+    /**
+    \brief Specifies the compressed destination format. By default TextureFormat::RGBA_BC7.
+    \remarks This must be one of the following formats: TextureFormat::RGB_DXT1, TextureFormat::RGBA_DXT1, TextureFormat::RGBA_DXT5,
+    TextureFormat::RGBA_BC7, TextureFormat::RGB_ETC2, or TextureFormat::RGBA_ETC2. The ETC2 formats are only supported with OpenGL(ES).
+    */
+    TextureFormat       format              = TextureFormat::RGBA_BC7;
+
+    //! Specifies the maximal width (in texels) of the regions to encode. By default 1024.
+    std::uint32_t       maxWidth            = 1024;
+
+    //! Specifies the maximal height (in texels) of the regions to encode. By default 1024.
+    std::uint32_t       maxHeight           = 1024;
+
+    //! Specifies the number of threads in X dimension of each thread group of the compute shader. By default 8.
+    std::uint32_t       threadGroupSizeX    = 8;
+
+    //! Specifies the number of threads in Y dimension of each thread group of the compute shader. By default 8.
+    std::uint32_t       threadGroupSizeY    = 8;
+};
+
+/**
+\brief Block compression parameters structure.
+\remarks This is the layout of the constant buffer of the compute shader, which is compatible with the std140 layout in GLSL.
+All members are written by BlockCompressionEncoder::Encode.
+*/
+struct BlockCompressionParameters
+{
+    //! Offset (in texels) of the region within the source texture. This is a multiple of the block size.
+    std::uint32_t   srcOffset[2]    = { 0, 0 };
+
+    //! Number of blocks in X and Y dimension.
+    std::uint32_t   numBlocks[2]    = { 0, 0 };
+
+    //! MIP-map level of the source texture.
+    std::uint32_t   srcMipLevel     = 0;
+
+    //! Array layer of the source texture.
+    std::uint32_t   srcArrayLayer   = 0;
+
+    /**
+    \brief Encoding quality in the range [0, 1].
+    \remarks The shader can use this to limit the number of partitions or endpoint refinement iterations (e.g. for BC7),
+    to trade off quality for encoding time of textures that are updated every frame.
+    */
+    float           quality         = 1.0f;
+
+    std::uint32_t   reserved        = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Compute pass, which encodes uncompressed textures into block-compressed textures on the GPU.
+\remarks Textures that are generated at runtime (e.g. rendered impostors, baked decals, or streamed user content) would otherwise remain uncompressed,
+although they are sampled just like any static texture. The encoder writes the compressed blocks into a storage buffer with a compute shader,
+and copies them into the destination texture with CommandBuffer::CopyBufferToTexture, so the image never makes a round trip through CPU memory.
+This reduces the video memory and the sampling bandwidth of long-lived dynamic textures by a factor of 4 (BC1, ETC2 RGB) to 8 (BC3, BC7, ETC2 RGBA) compared to RGBA8 textures.
+\code
+LLGL::BlockCompressionEncoderDescriptor encoderDesc;
+{
+    encoderDesc.pipeline    = bc7Pipeline;
+    encoderDesc.format      = LLGL::TextureFormat::RGBA_BC7;
+}
+LLGL::BlockCompressionEncoder encoder(*renderer, *commands, encoderDesc);
+
+// After the impostor has been rendered into 'impostorTexture'
+encoder.Encode(*compressedTexture, LLGL::TextureRegion { 0, { 0, 0, 0 }, { 256, 256, 1 } }, *impostorTexture);
+\endcode
+\note Only supported with: OpenGL 4.3, OpenGLES 3.1, Direct3D 11, Direct3D 12.
+*/
+class LLGL_EXPORT BlockCompressionEncoder
+{
+
+    public:
+
+        BlockCompressionEncoder(const BlockCompressionEncoder&) = delete;
+        BlockCompressionEncoder& operator = (const BlockCompressionEncoder&) = delete;
+
+        /**
+        \brief Creates the constant buffer and the block buffer.
+        \param[in] renderSystem Specifies the render system, which is used to create and write the buffers.
+        \param[in] commandBuffer Specifies the command buffer, which records the compute pass and the copy command.
+        \param[in] desc Specifies the block compression encoder descriptor.
+        \throw std::invalid_argument If the compute pipeline is null, if the format is not supported by the encoder,
+        or if the maximal size or the thread group size is zero.
+        \throw std::runtime_error If the render system does not support compute shaders and storage buffers.
+        */
+        BlockCompressionEncoder(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const BlockCompressionEncoderDescriptor& desc);
+
+        //! Releases the constant buffer and the block buffer.
+        ~BlockCompressionEncoder();
+
+        /**
+        \brief Records the compute pass, which encodes the specified region of the source texture, and the copy into the destination texture.
+        \param[in] dstTexture Specifies the destination texture. This must have the format of the encoder (see BlockCompressionEncoderDescriptor::format).
+        \param[in] dstRegion Specifies the region of the destination texture. The same region is read from the source texture at 'srcMipLevel'.
+        The X- and Y-components of the offset must be multiples of 4, and the Z-component of the extent must be 1.
+        The Z-component of the offset specifies the array layer of both textures.
+        \param[in] srcTexture Specifies the uncompressed source texture.
+        \param[in] srcMipLevel Specifies the MIP-map level of the source texture. By default 0.
+        \param[in] quality Specifies the encoding quality in the range [0, 1]. By default 1. See BlockCompressionParameters::quality.
+        \remarks Regions whose extent is not a multiple of 4 are encoded with partial blocks, which is only valid at the edges of the MIP-map level.
+        \note For Direct3D 12, the size (in bytes) of each row of blocks must be a multiple of 256 (see CommandBuffer::CopyBufferToTexture),
+        i.e. the width of the region must be a multiple of 128 for 8-byte formats and a multiple of 64 for 16-byte formats.
+        \throw std::invalid_argument If the destination texture has a different format, or if the region is not aligned to the blocks.
+        \throw std::out_of_range If the region exceeds the maximal size of the encoder.
+        */
+        void Encode(Texture& dstTexture, const TextureRegion& dstRegion, Texture& srcTexture, unsigned int srcMipLevel = 0, float quality = 1.0f);
+
+        //! Returns the size (in bytes) of each compressed block, i.e. 8 or 16 bytes.
+        inline std::uint32_t GetBlockSize() const
+        {
+            return blockSize_;
+        }
+
+        //! Returns the descriptor of this block compression encoder.
+        inline const BlockCompressionEncoderDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+    private:
+
+        RenderSystem&                       renderSystem_;
+        CommandBuffer&                      commandBuffer_;
+        BlockCompressionEncoderDescriptor   desc_;
+        std::uint32_t                       blockSize_      = 0;
+        Buffer*                             constantBuffer_ = nullptr;
+        Buffer*                             blockBuffer_    = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
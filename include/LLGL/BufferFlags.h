@@ -13,13 +13,17 @@
 #include "VertexFormat.h"
 #include "IndexFormat.h"
 #include "RenderSystemFlags.h"
+#include "ShaderUniform.h"
 #include <string>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class Buffer;
+
 /* ----- Enumerations ----- */
 
 //! Hardware buffer type enumeration.
@@ -34,7 +38,7 @@ enum class BufferType
 
 /**
 \brief Storage buffer type enumeration.
-\note Only supported with: Direct3D 11, Direct3D 12.
+\note Except for the buffers with a hidden counter, only supported with: Direct3D 11, Direct3D 12.
 */
 enum class StorageBufferType
 {
@@ -44,8 +48,20 @@ enum class StorageBufferType
     RWBuffer,                   //!< Typed read/write buffer. \note Only supported with: Direct3D 11, Direct3D 12.
     RWStructuredBuffer,         //!< Structured read/write buffer. \note Only supported with: Direct3D 11, Direct3D 12.
     RWByteAddressBuffer,        //!< Byte-address read/write buffer. \note Only supported with: Direct3D 11, Direct3D 12.
-    AppendStructuredBuffer,     //!< Append structured buffer. \note Only supported with: Direct3D 11, Direct3D 12.
-    ConsumeStructuredBuffer,    //!< Consume structured buffer. \note Only supported with: Direct3D 11, Direct3D 12.
+    /**
+    \brief Append structured buffer with a hidden counter.
+    \remarks With OpenGL, this is a generic storage buffer, and its counter is an atomic counter buffer,
+    which is bound to the same binding point as the storage buffer, e.g. <code>layout(binding = 0, offset = 0) uniform atomic_uint myCounter;</code>.
+    \see CommandBuffer::ResetBufferCounter
+    */
+    AppendStructuredBuffer,
+
+    /**
+    \brief Consume structured buffer with a hidden counter.
+    \remarks With OpenGL, the counter is bound in the same way as for AppendStructuredBuffer.
+    \see AppendStructuredBuffer
+    */
+    ConsumeStructuredBuffer,
 };
 
 /**
@@ -54,9 +70,23 @@ enum class StorageBufferType
 */
 enum class BufferCPUAccess
 {
-    ReadOnly,   //!< CPU read access only.
-    WriteOnly,  //!< CPU write access only.
-    ReadWrite,  //!< CPU read and write access.
+    ReadOnly,           //!< CPU read access only.
+    WriteOnly,          //!< CPU write access only.
+    ReadWrite,          //!< CPU read and write access.
+
+    /**
+    \brief CPU write access only, and the previous content of the entire buffer is discarded.
+    \remarks This allows the driver to provide new memory instead of waiting for the GPU to finish using the buffer.
+    With OpenGL this requires the extension "GL_ARB_map_buffer_range", otherwise it is equivalent to WriteOnly.
+    */
+    WriteDiscard,
+
+    /**
+    \brief CPU write access only without synchronization with the GPU.
+    \remarks The client must not overwrite any buffer range that might still be used by the GPU (e.g. by using a fence).
+    With OpenGL this requires the extension "GL_ARB_map_buffer_range", otherwise it is equivalent to WriteOnly.
+    */
+    WriteNoOverwrite,
 };
 
 //! Buffer flags enumeration.
@@ -82,6 +112,62 @@ struct BufferFlags
         \see RenderSystem::WriteBuffer
         */
         DynamicUsage    = (1 << 2),
+
+        /**
+        \brief Buffer can be used as source for the arguments of indirect draw and dispatch commands.
+        \remarks For Direct3D 11, this flag is required to pass a buffer to one of the indirect commands.
+        \see CommandBuffer::DrawIndirect
+        \see CommandBuffer::DrawIndexedIndirect
+        \see CommandBuffer::DispatchIndirect
+        */
+        IndirectArguments = (1 << 3),
+    };
+};
+
+/**
+\brief Buffer range mapping flags enumeration.
+\see RenderSystem::MapBufferRange
+*/
+struct BufferMapFlags
+{
+    enum
+    {
+        /**
+        \brief The previous content of the mapped range is discarded.
+        \remarks This requires write access. With Direct3D 11, this is only equivalent to BufferCPUAccess::WriteDiscard
+        if the range covers the entire buffer, since Direct3D 11 cannot discard partial ranges.
+        */
+        DiscardRange    = (1 << 0),
+
+        /**
+        \brief The previous content of the entire buffer is discarded, so the driver can provide new memory instead of waiting for the GPU.
+        \remarks This requires write access. This is equivalent to mapping with BufferCPUAccess::WriteDiscard.
+        */
+        DiscardBuffer   = (1 << 1),
+
+        /**
+        \brief The mapping is not synchronized with the GPU.
+        \remarks The client must not overwrite any range that might still be used by the GPU (e.g. by using a fence).
+        This requires write access. This is equivalent to mapping with BufferCPUAccess::WriteNoOverwrite.
+        */
+        Unsynchronized  = (1 << 2),
+
+        /**
+        \brief Only the ranges that are flushed with RenderSystem::FlushMappedBufferRange are written back to the buffer.
+        \remarks This requires write access. Without this flag, the entire mapped range is written back when the buffer is unmapped.
+        \see RenderSystem::FlushMappedBufferRange
+        */
+        FlushExplicit   = (1 << 3),
+
+        /**
+        \brief The mapping returns the most recent copy of the buffer the GPU has already completed, instead of waiting for the current content.
+        \remarks This requires BufferCPUAccess::ReadOnly and is meant for readbacks that are repeated every frame (e.g. histograms or picking results).
+        With Direct3D 11, every mapping schedules a copy of the entire buffer into one of several rotating staging buffers,
+        so the content lags behind by a few frames, but the CPU never waits for the GPU.
+        If no copy has been completed yet, the mapping returns null and the client must try again later (the buffer must not be unmapped in this case).
+        Other renderers ignore this flag and map the current content.
+        */
+        Deferred        = (1 << 4),
     };
 };
 
@@ -98,6 +184,8 @@ struct BufferDescriptor
         \brief Specifies the vertex format layout.
         \remarks This is required to tell the renderer how the vertex attributes are stored inside the vertex buffer and
         it must be the same vertex format which is used for the respective graphics pipeline shader program.
+        For a stream-output buffer, a vertex format with a non-zero stride specifies that the buffer can also be set as vertex buffer,
+        so the captured vertices can be drawn with CommandBuffer::DrawStreamOutput.
         */
         VertexFormat format;
     };
@@ -161,15 +249,53 @@ struct BufferDescriptor
     StorageBufferDescriptor storageBuffer;
 };
 
+/**
+\brief Transient buffer range structure.
+\remarks This structure describes a range of a persistent ring buffer, which is used for dynamic constant data that is only valid for a few frames.
+\see RenderSystem::WriteTransientConstantBuffer
+\see CommandBuffer::SetConstantBufferRange
+*/
+struct TransientBufferRange
+{
+    Buffer*         buffer  = nullptr;  //!< Buffer the range belongs to. This is null if the allocation failed.
+    unsigned int    offset  = 0;        //!< Offset (in bytes) of the range within the buffer.
+    unsigned int    size    = 0;        //!< Size (in bytes) of the range. This is the size of the data, rounded up to the required buffer offset alignment.
+};
+
+/**
+\brief Constant buffer field descriptor structure.
+\remarks This structure describes a single member of a constant buffer as it is laid out in the buffer memory
+(e.g. with the "std140" layout in GLSL, or the packing rules of HLSL constant buffers).
+Members of structures are reported as separate fields with their full names, e.g. "lights[1].color".
+\see ConstantBufferViewDescriptor::fields
+\see ConstantBufferWriter
+*/
+struct ConstantBufferFieldDescriptor
+{
+    std::string     name;                               //!< Full name of the field. Arrays are named without subscript.
+    UniformType     type        = UniformType::Float;   //!< Data type of the field, or of each array element.
+    unsigned int    offset      = 0;                    //!< Offset (in bytes) of the field within the constant buffer.
+    unsigned int    size        = 0;                    //!< Size (in bytes) of a single element, including the padding between matrix columns.
+    unsigned int    arraySize   = 0;                    //!< Number of array elements, or 0 if the field is not an array.
+    unsigned int    arrayStride = 0;                    //!< Stride (in bytes) between two array elements, or 0 if the field is not an array.
+};
+
 /**
 \brief Constant buffer shader-view descriptor structure.
 \remarks This structure is used to describe the view of a constant buffer within a shader.
 */
 struct ConstantBufferViewDescriptor
 {
-    std::string     name;           //!< Constant buffer name.
-    unsigned int    index   = 0;    //!< Index of the constant buffer within the respective shader.
-    unsigned int    size    = 0;    //!< Buffer size (in bytes).
+    std::string                                 name;           //!< Constant buffer name.
+    unsigned int                                index   = 0;    //!< Index of the constant buffer within the respective shader.
+    unsigned int                                size    = 0;    //!< Buffer size (in bytes).
+
+    /**
+    \brief Active fields of the constant buffer, sorted by their offsets.
+    \remarks Fields whose type can not be expressed by UniformType (e.g. non-square matrices) are omitted.
+    \see ConstantBufferWriter
+    */
+    std::vector<ConstantBufferFieldDescriptor>  fields;
 };
 
 /**
@@ -14,6 +14,7 @@
 #include "Key.h"
 #include <string>
 #include <memory>
+#include <cstdint>
 
 
 namespace LLGL
@@ -27,7 +28,30 @@ struct CanvasDescriptor
     std::wstring    title;
 
     //! Specifies whether the canvas is borderless. This is required for a fullscreen render context.
-    bool            borderless = false;
+    bool            borderless                  = false;
+
+    /**
+    \brief Preferred number of frames per second for the frame loop. By default 0, which selects the maximum refresh rate of the display.
+    \remarks On iOS devices with ProMotion, frame rates above 60 Hz also require the 'CADisableMinimumFrameDurationOnPhone' key in the Info.plist of the application.
+    \see Canvas::StartFrameLoop
+    */
+    std::uint32_t   preferredFramesPerSecond    = 0;
+};
+
+/**
+\brief Frame timing structure of the canvas frame loop. All timestamps are in seconds of the host time (e.g. CACurrentMediaTime on iOS).
+\see Canvas::EventListener::OnDrawFrame
+*/
+struct CanvasFrameTimes
+{
+    //! Timestamp of the last display refresh.
+    double timestamp        = 0.0;
+
+    //! Timestamp of the next display refresh, i.e. the time at which the frame that is rendered now is expected to be displayed.
+    double targetTimestamp  = 0.0;
+
+    //! Duration between the last and the next display refresh.
+    double duration         = 0.0;
 };
 
 
@@ -60,6 +84,13 @@ class LLGL_EXPORT Canvas : public Surface
                 */
                 virtual void OnProcessEvents(Canvas& sender);
 
+                /**
+                \brief Send exactly once per display refresh while the frame loop is running. This is where the application renders and presents its next frame.
+                \see Canvas::StartFrameLoop
+                \see Canvas::PostDrawFrame
+                */
+                virtual void OnDrawFrame(Canvas& sender, const CanvasFrameTimes& frameTimes);
+
         };
 
         /* --- Common --- */
@@ -87,6 +118,35 @@ class LLGL_EXPORT Canvas : public Surface
         //! Processes the events for this canvas (i.e. touch input, key presses etc.).
         void ProcessEvents();
 
+        /* --- Frame loop --- */
+
+        /**
+        \brief Starts the frame loop that is driven by the display refresh (e.g. CADisplayLink on iOS).
+        \remarks While the frame loop is running, all event listeners receive the OnDrawFrame event once per display refresh on the main thread,
+        so the application does not need to spin its own render loop. Starting an already running frame loop has no effect.
+        \return True if the frame loop is running. Otherwise, the platform does not support a display driven frame loop.
+        \see EventListener::OnDrawFrame
+        \see StopFrameLoop
+        */
+        virtual bool StartFrameLoop() = 0;
+
+        //! Stops the frame loop. Stopping a frame loop that is not running has no effect.
+        virtual void StopFrameLoop() = 0;
+
+        /**
+        \brief Sets the preferred number of frames per second for the frame loop. A value of 0 selects the maximum refresh rate of the display.
+        \remarks The display only supports certain frame rates, so the actual frame rate is the closest one the display can provide.
+        \see CanvasDescriptor::preferredFramesPerSecond
+        */
+        virtual void SetPreferredFramesPerSecond(std::uint32_t framesPerSecond) = 0;
+
+        /**
+        \brief Posts a 'DrawFrame' event to all event listeners.
+        \remarks For a canvas created with "Canvas::Create", this event is posted automatically by the frame loop.
+        \see EventListener::OnDrawFrame
+        */
+        void PostDrawFrame(const CanvasFrameTimes& frameTimes);
+
         /* --- Event handling --- */
 
         //! Adds a new event listener to this canvas.
@@ -0,0 +1,102 @@
+/*
+ * CaptureReplay.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAPTURE_REPLAY_H
+#define LLGL_CAPTURE_REPLAY_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class CapReplayer;
+
+/**
+\brief Replays a trace of a RenderingCapture with any render system.
+\remarks The trace is replayed frame by frame, where each frame ends with a render context presentation,
+and the CPU time of each replayed frame is measured. Since a presentation waits for the GPU when too many frames are queued,
+the frame time converges to the GPU frame time for GPU bound workloads. A trace can only be replayed on the same architecture it was captured on.
+\code
+LLGL::CaptureReplay replay(*renderer, LLGL::CaptureReplay::LoadTrace("frames.llgltrace"));
+while (replay.ReplayFrame())
+    std::cout << "frame " << replay.GetNumFrames() << ": " << replay.GetFrameTime() << " ns" << std::endl;
+\endcode
+\see RenderingCapture
+*/
+class LLGL_EXPORT CaptureReplay
+{
+
+    public:
+
+        CaptureReplay(const CaptureReplay&) = delete;
+        CaptureReplay& operator = (const CaptureReplay&) = delete;
+
+        /**
+        \brief Initializes the replay of the specified trace.
+        \param[in] renderSystem Specifies the render system which is used to replay the trace. It must outlive this replay.
+        \param[in] trace Specifies the trace, which has been returned by RenderingCapture::GetTrace or LoadTrace.
+        \param[in] headless Specifies whether all render contexts are created as headless render contexts, regardless of how they were captured.
+        This allows to replay a trace on a server without a display. By default false.
+        \throw std::runtime_error If the trace has no valid header or an unsupported version.
+        */
+        CaptureReplay(RenderSystem& renderSystem, std::vector<char>&& trace, bool headless = false);
+
+        //! Releases all objects that have been created by the replay and not been released by the trace.
+        ~CaptureReplay();
+
+        /**
+        \brief Loads the trace from the specified binary file.
+        \throw std::runtime_error If the file could not be opened for reading.
+        \see RenderingCapture::SaveTrace
+        */
+        static std::vector<char> LoadTrace(const std::string& filename);
+
+        /**
+        \brief Replays the next frame, i.e. all records up to and including the next render context presentation.
+        \return True if a frame has been replayed, or false if the end of the trace has been reached.
+        \throw std::runtime_error If a record of the trace is malformed or references an unknown object.
+        */
+        bool ReplayFrame();
+
+        /**
+        \brief Releases all objects of the replay and restarts it from the beginning of the trace.
+        \remarks This can be used to replay a trace multiple times, e.g. to warm up the driver before the frame times are evaluated.
+        */
+        void Restart();
+
+        //! Returns the number of frames that have been replayed since the replay has been started.
+        std::uint32_t GetNumFrames() const;
+
+        //! Returns the CPU time (in nanoseconds) of the most recently replayed frame, including its presentation.
+        std::uint64_t GetFrameTime() const;
+
+        //! Returns the first render context that has been created by the replay, e.g. to process the events of its window. This is null if there is none.
+        RenderContext* GetRenderContext() const;
+
+    private:
+
+        std::unique_ptr<CapReplayer> replayer_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,77 @@
+/*
+ * ColorConversion.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_COLOR_CONVERSION_H
+#define LLGL_COLOR_CONVERSION_H
+
+
+#include "Export.h"
+#include "ColorRGBA.h"
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\defgroup group_color_conversion Color batch conversion functions
+\remarks These functions convert entire arrays of colors at once (e.g. vertex colors or CPU-side images),
+and use SIMD instructions (SSE2 or NEON) where available, instead of converting each color with Color::Cast.
+Source and destination arrays must not overlap.
+\{
+*/
+
+/**
+\brief Converts the specified array of unsigned byte colors into floating-point colors.
+\param[in] src Pointer to the source colors.
+\param[out] dst Pointer to the destination colors.
+\param[in] count Specifies the number of colors.
+\remarks Each component is divided by 255, which is equivalent to 'ColorRGBAub::Cast<float>()'.
+*/
+LLGL_EXPORT void ConvertColors(const ColorRGBAub* src, ColorRGBAf* dst, std::size_t count);
+
+/**
+\brief Converts the specified array of floating-point colors into unsigned byte colors.
+\remarks Each component is multiplied by 255, truncated, and saturated to the range [0, 255].
+Apart from the saturation, this is equivalent to 'ColorRGBAf::Cast<unsigned char>()'.
+*/
+LLGL_EXPORT void ConvertColors(const ColorRGBAf* src, ColorRGBAub* dst, std::size_t count);
+
+/**
+\brief Converts the specified array of unsigned byte colors from sRGB space into floating-point colors in linear space.
+\remarks The RGB components are converted with a lookup table, and the alpha component is only normalized.
+*/
+LLGL_EXPORT void ConvertColorsSRGBToLinear(const ColorRGBAub* src, ColorRGBAf* dst, std::size_t count);
+
+/**
+\brief Converts the specified array of floating-point colors from linear space into unsigned byte colors in sRGB space.
+\remarks The components are saturated to the range [0, 1] and the RGB components are converted with a lookup table,
+which is exact within one step of the 8-bit result. The alpha component is only rounded to the nearest value.
+*/
+LLGL_EXPORT void ConvertColorsLinearToSRGB(const ColorRGBAf* src, ColorRGBAub* dst, std::size_t count);
+
+/**
+\brief Multiplies the RGB components of the specified unsigned byte colors with their alpha component (rounded to nearest).
+\remarks This is used for premultiplied alpha blending, i.e. with BlendOp::One as source color blend factor.
+*/
+LLGL_EXPORT void PremultiplyAlpha(ColorRGBAub* colors, std::size_t count);
+
+//! Multiplies the RGB components of the specified floating-point colors with their alpha component.
+LLGL_EXPORT void PremultiplyAlpha(ColorRGBAf* colors, std::size_t count);
+
+/** \} */
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -10,8 +10,10 @@
 
 
 #include "Export.h"
+#include "CommandBufferFlags.h"
 #include "RenderContextFlags.h"
 #include "RenderSystemFlags.h"
+#include "RenderPassFlags.h"
 #include "ColorRGBA.h"
 
 #include "Buffer.h"
@@ -20,12 +22,15 @@
 #include "TextureArray.h"
 #include "Sampler.h"
 #include "SamplerArray.h"
+#include "ResourceHeap.h"
 
 #include "RenderTarget.h"
 #include "ShaderProgram.h"
 #include "GraphicsPipeline.h"
 #include "ComputePipeline.h"
 #include "Query.h"
+#include "QueryArray.h"
+#include "Fence.h"
 
 
 namespace LLGL
@@ -109,6 +114,39 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void SetScissorArray(unsigned int numScissors, const Scissor* scissorArray) = 0;
 
+        /**
+        \brief Sets the shading rate for subsequent draw commands. By default ShadingRate::Rate1x1.
+        \param[in] rate Specifies the number of pixels each fragment shader invocation covers.
+        \remarks If a shading rate image is bound, the coarser rate of this one and the one of the image is used for each axis.
+        If variable-rate shading is not supported (see RenderingCaps::hasVariableRateShading), this function has no effect.
+        \note This state is guaranteed to be persistent.
+        \see SetShadingRateImage
+        */
+        virtual void SetShadingRate(const ShadingRate rate) = 0;
+
+        /**
+        \brief Sets the screen-space shading rate image for subsequent draw commands.
+        \param[in] texture Specifies the shading rate image, or null to disable it.
+        This must be a 2D texture with format TextureFormat::R8UInt, whose texels are ShadingRate values,
+        and each texel covers RenderingCaps::shadingRateImageTileSize pixels in each dimension.
+        \remarks If shading rate images are not supported (see RenderingCaps::hasShadingRateImage), this function has no effect.
+        \note This state is guaranteed to be persistent.
+        \see SetShadingRate
+        */
+        virtual void SetShadingRateImage(Texture* texture) = 0;
+
+        /**
+        \brief Sets the depth bounds for subsequent draw commands. By default [0, 1].
+        \param[in] minDepth Specifies the minimal depth value, in the range [0, 1].
+        \param[in] maxDepth Specifies the maximal depth value, in the range [0, 1].
+        \remarks The depth-bounds test is only performed with graphics pipelines with DepthDescriptor::boundsTestEnabled,
+        which discard all fragments whose stored depth value lies outside of these bounds, e.g. to cull light or shadow volumes.
+        If the depth-bounds test is not supported (see RenderingCaps::hasDepthBoundsTest), this function has no effect.
+        \note This state is guaranteed to be persistent.
+        \see DepthDescriptor::boundsTestEnabled
+        */
+        virtual void SetDepthBounds(float minDepth, float maxDepth) = 0;
+
         /**
         \brief Sets the new value to clear the color buffer. By default black (0, 0, 0, 0).
         \note This state is guaranteed to be persistent.
@@ -162,11 +200,17 @@ class LLGL_EXPORT CommandBuffer
         \param[in] buffer Specifies the vertex buffer to set. This buffer must have been created with the buffer type: BufferType::Vertex.
         This must not be an unspecified vertex buffer, i.e. it must be initialized with either the initial data in the "RenderSystem::CreateBuffer"
         function or with the "RenderSystem::WriteBuffer" function.
+        \param[in] offset Specifies the offset (in bytes) of the first vertex within the buffer. By default 0.
+        This must be a multiple of 4 and less than the buffer size.
+        \remarks A non-zero offset allows meshes with different vertex formats to be suballocated from a single large buffer.
+        Meshes with the same vertex format should rather share the offset and be addressed by the draw command arguments,
+        so they can be drawn without any buffer switch.
         \see RenderSystem::CreateBuffer
         \see RenderSystem::WriteBuffer
         \see SetVertexBufferArray
+        \see GeometryAllocator
         */
-        virtual void SetVertexBuffer(Buffer& buffer) = 0;
+        virtual void SetVertexBuffer(Buffer& buffer, unsigned int offset = 0) = 0;
 
         /**
         \brief Sets the specified array of vertex buffers for subsequent drawing operations.
@@ -181,10 +225,15 @@ class LLGL_EXPORT CommandBuffer
         \param[in] buffer Specifies the index buffer to set. This buffer must have been created with the buffer type: BufferType::Index.
         This must not be an unspecified index buffer, i.e. it must be initialized with either the initial data in the "RenderSystem::CreateBuffer"
         function or with the "RenderSystem::WriteBuffer" function.
+        \param[in] offset Specifies the offset (in bytes) of the first index within the buffer. By default 0.
+        This must be a multiple of the index format size and less than the buffer size.
+        The 'firstIndex' argument of the indexed draw commands is relative to this offset.
+        For OpenGL, this offset does not apply to indirect draw commands, whose 'firstIndex' is always relative to the start of the buffer.
         \remarks An active index buffer is only required for any "DrawIndexed" or "DrawIndexedInstanced" draw call.
         \see RenderSystem::WriteIndexBuffer
+        \see GeometryAllocator
         */
-        virtual void SetIndexBuffer(Buffer& buffer) = 0;
+        virtual void SetIndexBuffer(Buffer& buffer, unsigned int offset = 0) = 0;
         
         /**
         \brief Sets the active constant buffer at the specified slot index for subsequent drawing and compute operations.
@@ -206,6 +255,20 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) = 0;
 
+        /**
+        \brief Sets a range of the specified constant buffer at the specified slot index for subsequent drawing and compute operations.
+        \param[in] buffer Specifies the constant buffer whose range is to be set. This buffer must have been created with the buffer type: BufferType::Constant.
+        \param[in] offset Specifies the offset (in bytes) of the range. This must be a multiple of 256.
+        \param[in] size Specifies the size (in bytes) of the range. This must be a multiple of 256.
+        \param[in] slot Specifies the slot index where to put the constant buffer.
+        \param[in] shaderStageFlags Specifies at which shader stages the constant buffer is to be set. By default all shader stages are affected.
+        \remarks This is primarily used to bind the ranges returned by RenderSystem::WriteTransientConstantBuffer.
+        \note Only supported if RenderingCaps::hasConstantBufferRanges is true.
+        \see RenderSystem::WriteTransientConstantBuffer
+        \see TransientBufferRange
+        */
+        virtual void SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) = 0;
+
         /**
         \brief Sets the active storage buffer of the specified slot index for subsequent drawing and compute operations.
         \param[in] buffer Specifies the storage buffer to set. This buffer must have been created with the buffer type: BufferType::Storage.
@@ -225,6 +288,30 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) = 0;
 
+        /**
+        \brief Resets the hidden counter of the specified storage buffer.
+        \param[in] buffer Specifies the storage buffer whose counter is to be reset.
+        This buffer must have been created with the storage type StorageBufferType::AppendStructuredBuffer or StorageBufferType::ConsumeStructuredBuffer.
+        \param[in] value Specifies the new counter value. By default 0.
+        \remarks This must be called before the buffer is set with SetStorageBuffer, since Direct3D 11 resets the counter when the buffer is bound.
+        \note Only supported if RenderingCaps::hasBufferCounters is true.
+        \see CopyBufferCounter
+        */
+        virtual void ResetBufferCounter(Buffer& buffer, unsigned int value = 0) = 0;
+
+        /**
+        \brief Copies the hidden counter of the specified storage buffer into another buffer on the GPU.
+        \param[in] dstBuffer Specifies the destination buffer, e.g. a buffer with indirect arguments.
+        \param[in] dstOffset Specifies the offset (in bytes) within the destination buffer. This must be a multiple of 4.
+        \param[in] srcBuffer Specifies the storage buffer whose counter is to be copied as 32-bit unsigned integer.
+        \remarks This can be used to draw or dispatch exactly the number of elements that a compute shader has appended to the storage buffer.
+        \note Only supported if RenderingCaps::hasBufferCounters is true.
+        \see ResetBufferCounter
+        \see DrawIndirect
+        \see DispatchIndirect
+        */
+        virtual void CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer) = 0;
+
         /**
         \brief Sets the active stream-output buffer to the stream-output stage.
         \param[in] buffer Specifies the stream-output buffer to set. This buffer must have been created with the buffer type: BufferType::StreamOutput.
@@ -236,6 +323,8 @@ class LLGL_EXPORT CommandBuffer
         /**
         \brief Sets the active array of stream-output buffers.
         \param[in] bufferArray Specifies the stream-output buffer array to set.
+        \remarks Each buffer receives the stream-output attributes of the respective output slot (see StreamOutputAttribute::outputSlot).
+        With OpenGL, multiple output slots require GL 4.0 (or GL_ARB_transform_feedback3).
         \see RenderSystem::CreateBufferArray
         \see SetStreamOutputBuffer
         */
@@ -254,6 +343,20 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void EndStreamOutput() = 0;
 
+        /**
+        \brief Pauses the current stream-output, so subsequent draw calls do not append vertices to the stream-output buffers.
+        \remarks This can be used to draw other geometry between two captures into the same stream-output buffers.
+        \see ResumeStreamOutput
+        \see RenderingCaps::hasStreamOutputDraws
+        */
+        virtual void PauseStreamOutput() = 0;
+
+        /**
+        \brief Resumes the current stream-output, which has been paused, and continues appending vertices after the previously captured ones.
+        \see PauseStreamOutput
+        */
+        virtual void ResumeStreamOutput() = 0;
+
         /* ----- Textures ----- */
 
         /**
@@ -285,6 +388,17 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) = 0;
 
+        /* ----- Resource Heaps ----- */
+
+        /**
+        \brief Sets all resource bindings of the specified resource heap for subsequent drawing and compute operations.
+        \param[in] resourceHeap Specifies the resource heap to set.
+        \remarks This has the same effect as calling SetConstantBuffer, SetStorageBuffer, SetTexture, and SetSampler for each binding of the resource heap,
+        but the bindings have already been translated into the native binding commands when the resource heap was created.
+        \see RenderSystem::CreateResourceHeap
+        */
+        virtual void SetResourceHeap(ResourceHeap& resourceHeap) = 0;
+
         /* ----- Render Targets ----- */
 
         /**
@@ -303,6 +417,35 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void SetRenderTarget(RenderContext& renderContext) = 0;
 
+        /* ----- Render Passes ----- */
+
+        /**
+        \brief Begins a render pass with the specified render target.
+        \param[in] renderTarget Specifies the render target, which is set as with "SetRenderTarget(RenderTarget&)".
+        \param[in] renderPassDesc Specifies the load and store operations for each attachment.
+        The load operations are performed immediately, where clears use the current clear values.
+        \remarks Each render pass must be finished with "EndRenderPass" before the next render pass begins.
+        \see EndRenderPass
+        \see RenderPassDescriptor
+        */
+        virtual void BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc) = 0;
+
+        /**
+        \brief Begins a render pass with the back buffer of the specified render context.
+        \param[in] renderContext Specifies the render context, which is set as with "SetRenderTarget(RenderContext&)".
+        \param[in] renderPassDesc Specifies the load and store operations for the back buffer.
+        \see BeginRenderPass(RenderTarget&, const RenderPassDescriptor&)
+        */
+        virtual void BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc) = 0;
+
+        /**
+        \brief Ends the current render pass and performs the store operations of its attachments.
+        \remarks Multi-sampled render targets are resolved here, unless all attachments are discarded.
+        In this case, they are not resolved again when the next render target is set.
+        \see BeginRenderPass
+        */
+        virtual void EndRenderPass() = 0;
+
         /* ----- Pipeline States ----- */
 
         /**
@@ -323,6 +466,41 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void SetComputePipeline(ComputePipeline& computePipeline) = 0;
 
+        /**
+        \brief Writes the specified data into the push constants of the active graphics pipeline.
+        \param[in] offset Specifies the offset (in bytes) within the push constants. This must be a multiple of 16.
+        \param[in] size Specifies the size (in bytes) of the data. This must be a multiple of 16, and the range must not exceed the push constants of the graphics pipeline.
+        \param[in] data Raw pointer to the data that is to be written into the push constants.
+        \remarks This is a fast path for small per-draw data (e.g. transformation matrices) that avoids a buffer update and a constant buffer binding.
+        The push constants must be written after the graphics pipeline has been set, and they are undefined after another graphics pipeline has been set.
+        \see GraphicsPipelineDescriptor::pushConstants
+        \see RenderingCaps::maxPushConstantsSize
+        */
+        virtual void SetPushConstants(unsigned int offset, unsigned int size, const void* data) = 0;
+
+        /**
+        \brief Selects the implementations of all shader class interfaces of one stage of the active pipeline.
+        \param[in] stage Specifies the shader stage whose class interfaces are to be selected.
+        \param[in] numSlots Specifies the number of entries in the 'classInstances' array. This must be equal to the number of interface slots of that stage.
+        \param[in] classInstances Array of class instance IDs (see ShaderProgram::QueryShaderClassInstance), indexed by the interface slots (see ShaderProgram::QueryShaderInterfaceSlot).
+        \remarks This allows a single uber-shader to select its code paths per draw command without compiling a permutation for each combination.
+        The selection must be set after the pipeline has been set, and it is undefined after another pipeline has been set.
+        \code
+        // Setup (after the shader program has been linked)
+        int slotLight   = shaderProgram->QueryShaderInterfaceSlot(LLGL::ShaderType::Fragment, "g_light");
+        int pointLight  = shaderProgram->QueryShaderClassInstance(LLGL::ShaderType::Fragment, "g_pointLight");
+
+        // Draw
+        int classInstances[1];
+        classInstances[slotLight] = pointLight;
+        commands->SetGraphicsPipeline(*pipeline);
+        commands->SetShaderClassInstances(LLGL::ShaderType::Fragment, 1, classInstances);
+        \endcode
+        \note Only supported with: OpenGL 4.0+, Direct3D 11.
+        \see RenderingCaps::hasShaderClassInterfaces
+        */
+        virtual void SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances) = 0;
+
         /* ----- Queries ----- */
 
         /**
@@ -339,6 +517,7 @@ class LLGL_EXPORT CommandBuffer
 
         /**
         \brief Ends the specified query.
+        \remarks For queries of type QueryType::Timestamp, this writes the timestamp without a preceding call to "BeginQuery".
         \see RenderSystem::CreateQuery
         \see BeginQuery
         \see QueryResult
@@ -350,9 +529,53 @@ class LLGL_EXPORT CommandBuffer
         \param[in] query Specifies the Query object whose result is to be queried.
         \param[out] result Specifies the output result.
         \return True if the result is available, otherwise false in which case 'result' is not modified.
+        \remarks Query results cannot be retrieved from a command buffer that was created with the CommandBufferFlags::DeferredSubmit flag,
+        because the queries have not been executed at the time the commands are recorded. Such a command buffer always returns false.
+        Retrieve the results from an immediate command buffer instead, after the deferred command buffer has been executed.
         */
         virtual bool QueryResult(Query& query, std::uint64_t& result) = 0;
 
+        /**
+        \brief Queries the results of a range of queries within the specified query array.
+        \param[in] queryArray Specifies the query array whose results are to be queried.
+        \param[in] firstQuery Specifies the zero-based index of the first query within the array.
+        \param[in] numQueries Specifies the number of queries. 'firstQuery + numQueries' must be less than or equal to the size of the array.
+        \param[out] results Pointer to the output array, which must have at least 'numQueries' elements.
+        \return True if all results are available, otherwise false in which case the content of 'results' is undefined.
+        \remarks This function never waits for the GPU. Use this to poll the results of all queries of a frame at once,
+        e.g. a few frames after the queries have been issued.
+        Like the other overload, this always returns false for command buffers with the CommandBufferFlags::DeferredSubmit flag.
+        \see RenderSystem::CreateQueryArray
+        */
+        virtual bool QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results) = 0;
+
+        /**
+        \brief Queries all counters of the specified pipeline statistics query at once.
+        \param[in] query Specifies the Query object whose result is to be queried. This must have the type QueryType::PipelineStatistics.
+        \param[out] result Specifies the output result.
+        \return True if the result is available, otherwise false in which case 'result' is not modified.
+        \remarks This function never waits for the GPU.
+        This always returns false for command buffers with the CommandBufferFlags::DeferredSubmit flag (see QueryResult).
+        \see QueryType::PipelineStatistics
+        */
+        virtual bool QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result) = 0;
+
+        /**
+        \brief Writes the results of a range of queries within the specified query array into a buffer.
+        \param[in] queryArray Specifies the query array whose results are to be written.
+        \param[in] firstQuery Specifies the zero-based index of the first query within the array.
+        \param[in] numQueries Specifies the number of queries. 'firstQuery + numQueries' must be less than or equal to the size of the array.
+        \param[in] dstBuffer Specifies the destination buffer.
+        \param[in] dstOffset Specifies the offset (in bytes) within the destination buffer. This must be a multiple of 8.
+        \remarks Each result is written as 64-bit unsigned integer, i.e. the buffer must have at least 'dstOffset + numQueries*8' bytes.
+        The results can then be read back asynchronously (see RenderSystem::ReadBufferAsync) or consumed by shaders.
+        \note For OpenGL, this requires GL_ARB_query_buffer_object.
+        For Direct3D 11, this is emulated by waiting for the results on the CPU, which stalls the pipeline.
+        For Direct3D 12, this is only supported for occlusion queries (i.e. QueryType::SamplesPassed, QueryType::AnySamplesPassed, and QueryType::AnySamplesPassedConservative).
+        \see RenderSystem::CreateQueryArray
+        */
+        virtual void ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset) = 0;
+
         /**
         \brief Begins conditional rendering with the specified query object.
         \param[in] query Specifies the query object which is to be used as render condition.
@@ -379,6 +602,66 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void EndRenderCondition() = 0;
 
+        /* ----- Copy ----- */
+
+        /**
+        \brief Copies a range of data from one buffer into another buffer on the GPU.
+        \param[in] dstBuffer Specifies the destination buffer.
+        \param[in] dstOffset Specifies the offset (in bytes) within the destination buffer.
+        \param[in] srcBuffer Specifies the source buffer.
+        \param[in] srcOffset Specifies the offset (in bytes) within the source buffer.
+        \param[in] size Specifies the size (in bytes) of the data block which is to be copied.
+        \remarks The ranges must be inside the bounds of their buffers. If source and destination refer to the same buffer, the ranges must not overlap.
+        \note For Direct3D 12, the destination buffer must not be a constant buffer, since constant buffers reside in CPU writable memory.
+        */
+        virtual void CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size) = 0;
+
+        /**
+        \brief Copies a region of texels from one texture into another texture on the GPU.
+        \param[in] dstTexture Specifies the destination texture.
+        \param[in] dstMipLevel Specifies the MIP-map level of the destination texture.
+        \param[in] dstOffset Specifies the offset (in texels) within the destination texture.
+        \param[in] srcTexture Specifies the source texture.
+        \param[in] srcRegion Specifies the region of the source texture which is to be copied.
+        \remarks Both textures must have compatible formats (i.e. the same size per texel) and must not be multi-sampled.
+        \note For OpenGL, this requires GL_ARB_copy_image.
+        \see TextureRegion
+        */
+        virtual void CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) = 0;
+
+        /**
+        \brief Resolves a region of a multi-sampled texture into a non-multi-sampled texture on the GPU.
+        \param[in] dstTexture Specifies the destination texture. This must not be a multi-sampled texture.
+        \param[in] dstMipLevel Specifies the MIP-map level of the destination texture.
+        \param[in] dstOffset Specifies the offset (in texels) within the destination texture. The Z-component specifies the first array layer.
+        \param[in] srcTexture Specifies the source texture. This must be a multi-sampled texture (i.e. TextureType::Texture2DMS or TextureType::Texture2DMSArray).
+        \param[in] srcRegion Specifies the region of the source texture which is to be resolved.
+        The Z-components of the offset and extent specify the range of array layers. The MIP-map level of the region is ignored.
+        \remarks In contrast to the implicit resolve of multi-sampled render targets,
+        this can be used to resolve only the attachments and the region that are actually required.
+        Both textures must have the same format.
+        \note For Direct3D 11 and Direct3D 12, the entire array layers are resolved, i.e. the X- and Y-components of the region and the destination offset must be zero.
+        \see TextureRegion
+        */
+        virtual void ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) = 0;
+
+        /**
+        \brief Copies image data from a buffer into a region of a texture on the GPU.
+        \param[in] dstTexture Specifies the destination texture.
+        \param[in] dstRegion Specifies the region of the destination texture which is to be written.
+        \param[in] srcBuffer Specifies the source buffer, which contains the tightly packed image data.
+        \param[in] srcOffset Specifies the offset (in bytes) within the source buffer where the image data begins.
+        \param[in] imageFormat Specifies the image format of the data within the source buffer.
+        \param[in] dataType Specifies the data type of the data within the source buffer.
+        \remarks This can be used to upload image data, which has been written into a buffer (e.g. by a compute shader or with RenderSystem::MapBuffer),
+        without a round trip through CPU memory. For compressed textures, 'imageFormat' must be ImageFormat::CompressedRGB or ImageFormat::CompressedRGBA.
+        \note For Direct3D 11, this is emulated by a copy through a staging buffer, which stalls the pipeline.
+        For Direct3D 12, the image format and data type must match the texture format, 'srcOffset' must be a multiple of 512,
+        and the size (in bytes) of each row must be a multiple of 256.
+        \see TextureRegion
+        */
+        virtual void CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType) = 0;
+
         /* ----- Drawing ----- */
 
         /**
@@ -427,6 +710,77 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset) = 0;
 
+        /**
+        \brief Draws instances of primitives from the currently set vertex buffer with arguments read from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains the draw arguments. This buffer must have been created with the "BufferFlags::IndirectArguments" flag.
+        \param[in] offset Specifies the offset (in bytes) within the buffer where the arguments begin. This must be a multiple of 4.
+        \remarks The arguments must be laid out in memory as described by the DrawIndirectArguments structure.
+        \see DrawIndirectArguments
+        \see RenderingCaps::hasIndirectDrawing
+        */
+        virtual void DrawIndirect(Buffer& buffer, unsigned int offset) = 0;
+
+        /**
+        \brief Draws several batches of primitives from the currently set vertex buffer with arguments read from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains an array of draw arguments.
+        \param[in] offset Specifies the offset (in bytes) within the buffer where the first arguments begin. This must be a multiple of 4.
+        \param[in] numCommands Specifies the number of draw commands to generate.
+        \param[in] stride Specifies the stride (in bytes) between two consecutive arguments within the buffer.
+        This must be a multiple of 4 and greater than or equal to the size of the DrawIndirectArguments structure.
+        \remarks For render systems that don't support multi-draw commands natively, this is emulated by a sequence of single indirect draw commands.
+        \see DrawIndirect(Buffer&, unsigned int)
+        */
+        virtual void DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) = 0;
+
+        /**
+        \brief Draws instances of primitives from the currently set vertex- and index buffers with arguments read from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains the draw arguments. This buffer must have been created with the "BufferFlags::IndirectArguments" flag.
+        \param[in] offset Specifies the offset (in bytes) within the buffer where the arguments begin. This must be a multiple of 4.
+        \remarks The arguments must be laid out in memory as described by the DrawIndexedIndirectArguments structure.
+        \see DrawIndexedIndirectArguments
+        \see RenderingCaps::hasIndirectDrawing
+        */
+        virtual void DrawIndexedIndirect(Buffer& buffer, unsigned int offset) = 0;
+
+        /**
+        \brief Draws several batches of primitives from the currently set vertex- and index buffers with arguments read from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains an array of draw arguments.
+        \param[in] offset Specifies the offset (in bytes) within the buffer where the first arguments begin. This must be a multiple of 4.
+        \param[in] numCommands Specifies the number of draw commands to generate.
+        \param[in] stride Specifies the stride (in bytes) between two consecutive arguments within the buffer.
+        This must be a multiple of 4 and greater than or equal to the size of the DrawIndexedIndirectArguments structure.
+        \remarks For render systems that don't support multi-draw commands natively, this is emulated by a sequence of single indirect draw commands.
+        \see DrawIndexedIndirect(Buffer&, unsigned int)
+        */
+        virtual void DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) = 0;
+
+        /**
+        \brief Draws all vertices that have been captured into the current vertex buffer during its last stream-output.
+        \remarks The number of vertices is determined by the GPU, so no CPU readback and synchronization is required,
+        and the captured geometry can be drawn again in subsequent frames.
+        The stream-output buffer must be set as vertex buffer with SetVertexBuffer, which requires a vertex format in its buffer descriptor,
+        and the stream-output must have been ended before.
+        \see BufferDescriptor::VertexBufferDescriptor::format
+        \see RenderingCaps::hasStreamOutputDraws
+        */
+        virtual void DrawStreamOutput() = 0;
+
+        /**
+        \brief Draws primitives with the mesh shader of the currently set graphics pipeline.
+        \param[in] numTasksX Specifies the number of task groups in the X-dimension.
+        \param[in] numTasksY Specifies the number of task groups in the Y-dimension.
+        \param[in] numTasksZ Specifies the number of task groups in the Z-dimension.
+        \remarks The graphics pipeline must have been created with a shader program that contains a mesh shader and,
+        optionally, an amplification shader. Each task group launches one amplification shader work group,
+        or one mesh shader work group if there is no amplification shader.
+        Vertex and index buffers are ignored; the mesh shader reads its geometry from storage buffers, e.g. the meshlets generated by BuildMeshlets (see MeshUtility.h).
+        \note For OpenGL (GL_NV_mesh_shader), the task groups are one-dimensional, so the total number of task groups is launched along the X-dimension.
+        \see ShaderType::Mesh
+        \see ShaderType::Amplification
+        \see RenderingCaps::hasMeshShaders
+        */
+        virtual void DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ) = 0;
+
         /* ----- Compute ----- */
 
         /**
@@ -439,8 +793,76 @@ class LLGL_EXPORT CommandBuffer
         */
         virtual void Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ) = 0;
 
+        /**
+        \brief Dispatches a compute command with the number of thread groups read from the specified buffer.
+        \param[in] buffer Specifies the buffer which contains the dispatch arguments. This buffer must have been created with the "BufferFlags::IndirectArguments" flag.
+        \param[in] offset Specifies the offset (in bytes) within the buffer where the arguments begin. This must be a multiple of 4.
+        \remarks The arguments must be laid out in memory as described by the DispatchIndirectArguments structure.
+        \see DispatchIndirectArguments
+        \see RenderingCaps::hasIndirectDrawing
+        */
+        virtual void DispatchIndirect(Buffer& buffer, unsigned int offset) = 0;
+
+        /**
+        \brief Inserts a memory barrier, which makes the shader writes of all previous commands visible to subsequent commands.
+        \param[in] barrierFlags Specifies how the written memory is accessed by subsequent commands.
+        This can be a bitwise OR combination of the BarrierFlags entries. The fewer flags are specified, the less the GPU has to synchronize.
+        \remarks This must be called between two compute dispatches (or a dispatch and a draw command),
+        if the latter one reads the resources that have been written by the former one.
+        \note For Direct3D 12, this is a storage buffer (UAV) barrier on all resources and the flags are ignored.
+        Direct3D 11 resolves these hazards implicitly, so this function has no effect there.
+        OpenGL inserts a full memory barrier after each dispatch, unless GraphicsAPIDependentStateDescriptor::StateOpenGLDescriptor::explicitBarriers is true.
+        \see BarrierFlags
+        \see StorageBarrier
+        */
+        virtual void Barrier(long barrierFlags) = 0;
+
+        /**
+        \brief Inserts a memory barrier for the specified storage buffer only.
+        \param[in] buffer Specifies the storage buffer, whose shader writes of all previous commands must be visible to subsequent shaders.
+        This buffer must have been created with the buffer type: BufferType::Storage.
+        \remarks This is the narrowest barrier for chains of compute passes, where each pass reads the storage buffer written by the previous pass.
+        \note For Direct3D 12, this is a UAV barrier on the buffer resource only.
+        For OpenGL, this is the same as calling Barrier with BarrierFlags::StorageBuffer.
+        \see Barrier
+        */
+        virtual void StorageBarrier(Buffer& buffer) = 0;
+
+        /* ----- Command Recording ----- */
+
+        /**
+        \brief Replays all commands that have been recorded into the specified deferred command buffer.
+        \param[in] deferredCommandBuffer Specifies the command buffer whose commands are to be replayed.
+        This must be a command buffer that was created with the CommandBufferFlags::DeferredSubmit flag.
+        \remarks The recorded commands are not cleared by this function, so a deferred command buffer can be executed several times.
+        For Direct3D 11 and Direct3D 12, the recording of a deferred command buffer is finished by its first execution,
+        i.e. commands that are recorded afterwards are ignored until the command buffer is reset.
+        If this command buffer is a deferred command buffer itself, the execution is recorded as well (not supported by Direct3D 12).
+        \see RenderSystem::ExecuteCommandBuffers
+        \see CommandBufferFlags::DeferredSubmit
+        \see Reset
+        */
+        virtual void Execute(CommandBuffer& deferredCommandBuffer) = 0;
+
+        /**
+        \brief Clears all commands that have been recorded into this command buffer.
+        \remarks This has no effect on command buffers that submit their commands immediately.
+        \see CommandBufferFlags::DeferredSubmit
+        */
+        virtual void Reset() = 0;
+
         /* ----- Misc ----- */
 
+        /**
+        \brief Schedules a signal for the specified fence.
+        \param[in] fence Specifies the fence, which is signaled as soon as the GPU has completed all previously submitted commands.
+        \remarks For command buffers with the CommandBufferFlags::DeferredSubmit flag, the fence is signaled each time the command buffer has been executed.
+        With Direct3D 12, the commands that have been recorded so far are submitted to the command queue for command buffers without the DeferredSubmit flag.
+        \see RenderSystem::CreateFence
+        \see Fence::Wait
+        */
+        virtual void Signal(Fence& fence) = 0;
+
         //! Synchronizes the GPU, i.e. waits until the GPU has completed all pending commands from this command buffer.
         virtual void SyncGPU() = 0;
 
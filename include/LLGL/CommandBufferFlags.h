@@ -0,0 +1,211 @@
+/*
+ * CommandBufferFlags.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_COMMAND_BUFFER_FLAGS_H
+#define LLGL_COMMAND_BUFFER_FLAGS_H
+
+
+namespace LLGL
+{
+
+
+/* ----- Flags ----- */
+
+/**
+\brief Command buffer creation flags.
+\see CommandBufferDescriptor::flags
+*/
+struct CommandBufferFlags
+{
+    enum
+    {
+        /**
+        \brief Specifies that the command buffer records its commands instead of submitting them immediately.
+        \remarks A deferred command buffer records all commands (into a deferred context for Direct3D 11,
+        into its own command list for Direct3D 12, and into a linear command stream for all other render systems),
+        which can be submitted any number of times with the "CommandBuffer::Execute" function of another command buffer.
+        Several deferred command buffers can be recorded concurrently by different threads.
+        Query results cannot be retrieved from a deferred command buffer, i.e. "CommandBuffer::QueryResult" always returns false for it.
+        \see CommandBuffer::Execute
+        \see RenderSystem::ExecuteCommandBuffers
+        */
+        DeferredSubmit = (1 << 0),
+
+        /**
+        \brief Specifies that the command buffer records compute commands for a dedicated compute queue. This must be combined with the DeferredSubmit flag.
+        \remarks Such a command buffer can only record compute and resource binding commands. When it is submitted with "RenderSystem::ExecuteCommandBuffers",
+        its commands run on the compute queue and can overlap with graphics commands that have been submitted before.
+        All graphics commands that are submitted afterwards wait on the GPU until the compute commands are done,
+        i.e. the order of the command buffer array defines the synchronization between the queues.
+        \note Only supported with: Direct3D 12. Other render systems execute such a command buffer like any other deferred command buffer.
+        \see RenderSystem::ExecuteCommandBuffers
+        */
+        AsyncCompute   = (1 << 1),
+
+        /**
+        \brief Specifies that consecutive non-instanced draw commands are merged into a single multi-draw call.
+        \remarks Draw commands (i.e. "Draw", and "DrawIndexed" with or without a vertex offset) are queued as long as
+        no other command is recorded in between, and as long as they use the same primitive topology and index format.
+        The queue is submitted with a single "glMultiDrawArrays" or "glMultiDrawElementsBaseVertex" call before the next command of any command buffer,
+        before a render context is presented, and before the render system writes, reads, or releases a buffer or texture.
+        This is meant for legacy content with many small draw commands between which the render states do not change.
+        \note Only supported with: OpenGL (requires GL_EXT_multi_draw_arrays and GL_ARB_draw_elements_base_vertex),
+        and only for command buffers that are not created with the DeferredSubmit flag.
+        All other render systems ignore this flag.
+        */
+        MergeDraws     = (1 << 2),
+
+        /**
+        \brief Specifies that the command buffer records a static sequence of draw commands, which is replayed with almost no CPU cost. This must be combined with the DeferredSubmit flag.
+        \remarks Such a command buffer can only record pipeline states, resource bindings, push constants, and draw and dispatch commands.
+        It must not record viewports, scissors, render targets, render passes, clear, copy, query, or barrier commands;
+        instead it inherits the viewports, scissors, and render target of the command buffer it is executed within.
+        It can only be submitted with "CommandBuffer::Execute" (but not with "RenderSystem::ExecuteCommandBuffers"),
+        and all pipeline states and resource bindings of the executing command buffer must be set again afterwards.
+        \note Only supported with: Direct3D 12, where the commands are recorded into a bundle that is validated once and replayed with "ExecuteBundle".
+        Other render systems execute such a command buffer like any other deferred command buffer.
+        \see CommandBuffer::Execute
+        */
+        Bundle         = (1 << 3),
+    };
+};
+
+/**
+\brief Memory barrier flags, which specify how the memory written by previous commands is accessed by subsequent commands.
+\see CommandBuffer::Barrier
+*/
+struct BarrierFlags
+{
+    enum
+    {
+        //! Storage buffers (including their hidden counters) are read or written by subsequent shaders.
+        StorageBuffer       = (1 << 0),
+
+        //! Constant buffers are read by subsequent shaders.
+        ConstantBuffer      = (1 << 1),
+
+        //! Vertex buffers are read by subsequent draw commands.
+        VertexBuffer        = (1 << 2),
+
+        //! Index buffers are read by subsequent draw commands.
+        IndexBuffer         = (1 << 3),
+
+        //! Indirect arguments are read by subsequent indirect draw or dispatch commands.
+        IndirectArguments   = (1 << 4),
+
+        //! Textures are sampled, or read or written as images, by subsequent shaders.
+        Texture             = (1 << 5),
+
+        //! Buffers or textures are copied, updated, mapped, or read back by subsequent commands.
+        Copy                = (1 << 6),
+
+        //! All memory accesses of subsequent commands.
+        All                 = (StorageBuffer | ConstantBuffer | VertexBuffer | IndexBuffer | IndirectArguments | Texture | Copy),
+    };
+};
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Variable-rate shading enumeration, which specifies the number of pixels each fragment shader invocation covers.
+\remarks The values of this enumeration are also the texel values of a shading rate image:
+the binary logarithm of the width is stored in bits 2 to 3, and the binary logarithm of the height in bits 0 to 1.
+\see CommandBuffer::SetShadingRate
+\see CommandBuffer::SetShadingRateImage
+*/
+enum class ShadingRate
+{
+    Rate1x1 = 0x0, //!< One invocation per pixel (default).
+    Rate1x2 = 0x1, //!< One invocation per 1x2 pixels.
+    Rate2x1 = 0x4, //!< One invocation per 2x1 pixels.
+    Rate2x2 = 0x5, //!< One invocation per 2x2 pixels.
+    Rate2x4 = 0x6, //!< One invocation per 2x4 pixels.
+    Rate4x2 = 0x9, //!< One invocation per 4x2 pixels.
+    Rate4x4 = 0xA, //!< One invocation per 4x4 pixels.
+};
+
+
+/* ----- Structures ----- */
+
+//! Command buffer descriptor structure.
+struct CommandBufferDescriptor
+{
+    CommandBufferDescriptor() = default;
+
+    CommandBufferDescriptor(long flags, unsigned int nodeIndex = 0) :
+        flags     { flags     },
+        nodeIndex { nodeIndex }
+    {
+    }
+
+    /**
+    \brief Specifies the creation flags. This can be a bitwise OR combination of the entries of the CommandBufferFlags enumeration. By default 0.
+    \see CommandBufferFlags
+    */
+    long            flags       = 0;
+
+    /**
+    \brief Specifies the zero-based index of the GPU node the command buffer records and executes its commands on. By default 0.
+    \remarks GPU nodes are the physical GPUs of a linked adapter. Command buffers for any other node than 0 must be created with the
+    DeferredSubmit flag and must not have the AsyncCompute flag. Resources are located on node 0 and are visible to all nodes,
+    so each node can read and write all buffers and textures, but accesses from other nodes are slower.
+    \note Only supported with: Direct3D 12. This must be less than RenderingCaps::numGPUNodes.
+    \see RenderingCaps::numGPUNodes
+    \see GPUNodeScheduler
+    */
+    unsigned int    nodeIndex   = 0;
+};
+
+/**
+\brief Memory layout of the arguments for a single indirect draw command.
+\remarks This structure must be tightly packed into a buffer, which has been created with the "BufferFlags::IndirectArguments" flag.
+\see CommandBuffer::DrawIndirect
+*/
+struct DrawIndirectArguments
+{
+    unsigned int numVertices    = 0;
+    unsigned int numInstances   = 1;
+    unsigned int firstVertex    = 0;
+    unsigned int firstInstance  = 0;
+};
+
+/**
+\brief Memory layout of the arguments for a single indirect indexed draw command.
+\remarks This structure must be tightly packed into a buffer, which has been created with the "BufferFlags::IndirectArguments" flag.
+\see CommandBuffer::DrawIndexedIndirect
+*/
+struct DrawIndexedIndirectArguments
+{
+    unsigned int    numIndices      = 0;
+    unsigned int    numInstances    = 1;
+    unsigned int    firstIndex      = 0;
+    int             vertexOffset    = 0;
+    unsigned int    firstInstance   = 0;
+};
+
+/**
+\brief Memory layout of the arguments for a single indirect compute dispatch command.
+\remarks This structure must be tightly packed into a buffer, which has been created with the "BufferFlags::IndirectArguments" flag.
+\see CommandBuffer::DispatchIndirect
+*/
+struct DispatchIndirectArguments
+{
+    unsigned int numThreadGroupsX = 1;
+    unsigned int numThreadGroupsY = 1;
+    unsigned int numThreadGroupsZ = 1;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,137 @@
+/*
+ * ConstantBufferWriter.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CONSTANT_BUFFER_WRITER_H
+#define LLGL_CONSTANT_BUFFER_WRITER_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "BufferFlags.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Constant buffer writer, which writes typed values into the fields of a constant buffer and uploads only the modified byte ranges.
+\remarks The field layout is taken from the shader reflection (see ConstantBufferViewDescriptor::fields),
+so the offsets are looked up only once and the application does not need to mirror the buffer layout
+with its own structures (including the padding of the "std140" layout or the HLSL packing rules).
+All values are written into a CPU-side copy of the buffer. Only the bytes that actually changed are marked as modified,
+and the modified ranges are merged and uploaded with RenderSystem::WriteBuffer when Flush is called.
+\code
+LLGL::ConstantBufferWriter writer(*renderer, *constantBuffer, shaderProgram->QueryConstantBuffers()[0]);
+auto wvpMatrixField = writer.FindField("wvpMatrix");
+
+// Each frame ...
+writer.Write(*wvpMatrixField, wvpMatrix);
+writer.Write("lightColor", lightColor);
+writer.Flush();
+\endcode
+*/
+class LLGL_EXPORT ConstantBufferWriter
+{
+
+    public:
+
+        ConstantBufferWriter(const ConstantBufferWriter&) = delete;
+        ConstantBufferWriter& operator = (const ConstantBufferWriter&) = delete;
+
+        /**
+        \brief Initializes the writer for the specified constant buffer.
+        \param[in] renderSystem Specifies the render system, which is used to upload the modified ranges.
+        \param[in] buffer Specifies the constant buffer. Its size must be at least 'desc.size'.
+        \param[in] desc Specifies the constant buffer view descriptor with its field layout, as returned by ShaderProgram::QueryConstantBuffers.
+        \param[in] partialUpdates Specifies whether the modified ranges can be uploaded separately. Otherwise, the entire buffer is uploaded
+        if any field has been modified. This must be false for Direct3D 11 constant buffers that were created without BufferFlags::DynamicUsage,
+        since those can only be updated entirely. By default true.
+        \remarks The writer initially considers the entire buffer as modified, so the first call to Flush uploads the whole buffer.
+        */
+        ConstantBufferWriter(RenderSystem& renderSystem, Buffer& buffer, const ConstantBufferViewDescriptor& desc, bool partialUpdates = true);
+
+        //! Returns the field with the specified name, or null if there is no such field.
+        const ConstantBufferFieldDescriptor* FindField(const std::string& name) const;
+
+        /**
+        \brief Writes the specified data into a field of the constant buffer.
+        \param[in] field Specifies the field. This should be one of the fields returned by GetFields or FindField.
+        \param[in] data Raw pointer to the data.
+        \param[in] dataSize Specifies the size (in bytes) of the data. This must not be greater than the size of the field.
+        \param[in] arrayIndex Specifies the array element. By default 0.
+        \remarks Matrices are written as they are laid out in the buffer, i.e. each column (or row) begins at a new 16-byte register.
+        \throw std::out_of_range If 'dataSize' is greater than the field size, or 'arrayIndex' is out of range.
+        */
+        void Write(const ConstantBufferFieldDescriptor& field, const void* data, std::size_t dataSize, unsigned int arrayIndex = 0);
+
+        //! Writes the specified value into a field of the constant buffer.
+        template <typename T>
+        void Write(const ConstantBufferFieldDescriptor& field, const T& value, unsigned int arrayIndex = 0)
+        {
+            Write(field, &value, sizeof(T), arrayIndex);
+        }
+
+        /**
+        \brief Writes the specified value into the field with the specified name.
+        \remarks Prefer the overload with a field descriptor for fields that are written frequently, to avoid the lookup by name.
+        \throw std::invalid_argument If there is no field with the specified name.
+        */
+        template <typename T>
+        void Write(const std::string& name, const T& value, unsigned int arrayIndex = 0)
+        {
+            Write(GetField(name), &value, sizeof(T), arrayIndex);
+        }
+
+        /**
+        \brief Uploads all modified ranges into the constant buffer.
+        \return Number of bytes that have been uploaded.
+        */
+        std::size_t Flush();
+
+        //! Marks the entire buffer as modified, e.g. after the buffer has been written by other means.
+        void Invalidate();
+
+        //! Returns the fields of the constant buffer, sorted by their offsets.
+        inline const std::vector<ConstantBufferFieldDescriptor>& GetFields() const
+        {
+            return fields_;
+        }
+
+    private:
+
+        struct DirtyRange
+        {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        const ConstantBufferFieldDescriptor& GetField(const std::string& name) const;
+
+        void MarkDirty(std::size_t begin, std::size_t end);
+
+        RenderSystem&                               renderSystem_;
+        Buffer&                                     buffer_;
+        std::vector<ConstantBufferFieldDescriptor>  fields_;
+        std::vector<char>                           data_;
+        std::vector<DirtyRange>                     dirtyRanges_;
+        bool                                        partialUpdates_ = true;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
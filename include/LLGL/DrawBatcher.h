@@ -0,0 +1,202 @@
+/*
+ * DrawBatcher.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DRAW_BATCHER_H
+#define LLGL_DRAW_BATCHER_H
+
+
+#include "Export.h"
+#include "CommandBuffer.h"
+#include <vector>
+#include <map>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Draw batcher sorting mode enumeration.
+\see DrawBatcher::SetPassSortMode
+*/
+enum class DrawSortMode
+{
+    /**
+    \brief Sort draw packets primarily by render states, and front-to-back by depth within equal render states.
+    \remarks This is the default mode and is meant for opaque geometry.
+    */
+    StateFrontToBack,
+
+    /**
+    \brief Sort draw packets primarily back-to-front by depth, and by render states within equal depth.
+    \remarks This is meant for translucent geometry, which must be rendered in depth order.
+    */
+    BackToFront,
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Draw packet structure, which describes a single draw call together with its render states.
+\remarks Only the graphics pipeline is required. All other resources are optional and will only be bound if they are non-null.
+\see DrawBatcher::Submit
+*/
+struct DrawPacket
+{
+    /**
+    \brief Specifies the render pass this draw packet belongs to. By default 0.
+    \remarks Draw packets are never reordered across passes, i.e. all packets of a pass with a lower index are drawn first.
+    */
+    std::uint8_t        pass                = 0;
+
+    //! Specifies the normalized depth value in the range [0, 1]. This is used to sort draw packets within a pass. By default 0.
+    float               depth               = 0.0f;
+
+    //! Specifies the graphics pipeline. This must not be null.
+    GraphicsPipeline*   graphicsPipeline    = nullptr;
+
+    //! Specifies the optional vertex buffer. By default null.
+    Buffer*             vertexBuffer        = nullptr;
+
+    //! Specifies the optional index buffer. If this is non-null, an indexed draw command will be generated. By default null.
+    Buffer*             indexBuffer         = nullptr;
+
+    //! Specifies the optional texture which is bound to the slot 'textureSlot'. This is ignored if 'textureArray' is non-null. By default null.
+    Texture*            texture             = nullptr;
+
+    //! Specifies the optional texture array which is bound to the start slot 'textureSlot'. By default null.
+    TextureArray*       textureArray        = nullptr;
+
+    //! Specifies the (start) slot for either 'texture' or 'textureArray'. By default 0.
+    unsigned int        textureSlot         = 0;
+
+    /**
+    \brief Specifies the optional constant buffer range which is bound to the slot 'constantBufferSlot'. By default empty.
+    \remarks This is typically the range that has been returned by RenderSystem::WriteTransientConstantBuffer.
+    \see CommandBuffer::SetConstantBufferRange
+    */
+    TransientBufferRange constantBuffer;
+
+    //! Specifies the slot for the constant buffer range. By default 0.
+    unsigned int        constantBufferSlot  = 0;
+
+    //! Specifies the shader stages, the textures and constant buffers are bound to. By default ShaderStageFlags::AllStages.
+    long                shaderStageFlags    = ShaderStageFlags::AllStages;
+
+    //! Specifies the number of vertices (or indices if 'indexBuffer' is non-null) to generate. By default 0.
+    unsigned int        numVertices         = 0;
+
+    //! Specifies the zero-based offset of the first vertex (or first index if 'indexBuffer' is non-null). By default 0.
+    unsigned int        firstVertex         = 0;
+
+    //! Specifies the base vertex offset for indexed draw commands. By default 0.
+    int                 vertexOffset        = 0;
+
+    //! Specifies the number of instances to generate. By default 1.
+    unsigned int        numInstances        = 1;
+
+    //! Specifies the zero-based instance offset. By default 0.
+    unsigned int        instanceOffset      = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Optional batching front-end for command buffers.
+\remarks The draw batcher collects draw packets, sorts them by a 64-bit sort key, which is built from
+the pass index, graphics pipeline, textures, vertex buffer, and depth value, and then generates the minimal sequence
+of state changes and draw commands for a command buffer. Render states that have been set outside of the draw batcher
+(e.g. viewports and render targets) are left untouched.
+\code
+LLGL::DrawBatcher batcher;
+for (const auto& mesh : meshes)
+{
+    LLGL::DrawPacket packet;
+    packet.graphicsPipeline = mesh.pipeline;
+    packet.vertexBuffer     = mesh.vertexBuffer;
+    packet.texture          = mesh.texture;
+    packet.depth            = mesh.viewDepth;
+    packet.numVertices      = mesh.numVertices;
+    batcher.Submit(packet);
+}
+batcher.Flush(*commands);
+\endcode
+*/
+class LLGL_EXPORT DrawBatcher
+{
+
+    public:
+
+        /**
+        \brief Sets the sorting mode for the specified pass. By default DrawSortMode::StateFrontToBack.
+        \see DrawSortMode
+        */
+        void SetPassSortMode(std::uint8_t pass, const DrawSortMode mode);
+
+        /**
+        \brief Submits the specified draw packet into the batch.
+        \remarks The resources referenced by the draw packet must be valid until the next call to "Flush" or "Clear".
+        \see DrawPacket
+        */
+        void Submit(const DrawPacket& packet);
+
+        /**
+        \brief Sorts all submitted draw packets and records the required commands into the specified command buffer.
+        \remarks After this call, all submitted draw packets are removed from the batch.
+        Since the draw batcher does not know about states that have been set outside of the batch,
+        the first draw packet always binds all of its resources.
+        */
+        void Flush(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Removes all submitted draw packets and resets the internal resource identifiers.
+        \remarks Call this function after resources, which have been submitted with a draw packet, have been released.
+        */
+        void Clear();
+
+        //! Returns the number of draw packets that have been submitted since the last flush.
+        inline std::size_t GetNumPackets() const
+        {
+            return packets_.size();
+        }
+
+    private:
+
+        struct SortEntry
+        {
+            std::uint64_t   key;
+            std::uint32_t   index;
+        };
+
+        std::uint64_t MakeSortKey(const DrawPacket& packet);
+        std::uint64_t GetResourceID(const void* resource, std::uint64_t maxID);
+
+        void SortEntries();
+
+        std::vector<DrawPacket>                 packets_;
+        std::vector<SortEntry>                  entries_;
+        std::vector<SortEntry>                  entriesTemp_;
+
+        std::map<const void*, std::uint64_t>    resourceIDs_;
+        std::map<std::uint8_t, DrawSortMode>    passSortModes_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,169 @@
+/*
+ * DynamicResolution.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DYNAMIC_RESOLUTION_H
+#define LLGL_DYNAMIC_RESOLUTION_H
+
+
+#include "Export.h"
+#include "RenderContextFlags.h"
+#include "GPUProfiler.h"
+#include <Gauss/Vector2.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Dynamic resolution descriptor structure.
+\see DynamicResolution
+*/
+struct DynamicResolutionDescriptor
+{
+    /**
+    \brief Specifies the maximal resolution, i.e. the size the render targets are allocated with.
+    \remarks The scaled resolution never exceeds this size, so the render targets never need to be reallocated.
+    */
+    Gs::Vector2ui   maxResolution;
+
+    //! Specifies the GPU frame time (in nanoseconds) the controller aims for. By default 16.6 ms (i.e. 60 Hz).
+    std::uint64_t   targetFrameTime = 16666666;
+
+    //! Specifies the minimal resolution scale. By default 0.5.
+    float           minScale        = 0.5f;
+
+    //! Specifies the maximal resolution scale. By default 1.0.
+    float           maxScale        = 1.0f;
+
+    /**
+    \brief Specifies the relative tolerance around the target frame time, in which the scale is left unchanged. By default 0.05.
+    \remarks This avoids oscillation of the resolution when the frame time is close to its target.
+    */
+    float           tolerance       = 0.05f;
+
+    //! Specifies the maximal change of the scale per update. By default 0.05.
+    float           maxScaleStep    = 0.05f;
+
+    //! Specifies the weight of the most recent frame time for its exponential moving average, within the range (0, 1]. By default 0.2.
+    float           smoothing       = 0.2f;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Controller for dynamic resolution scaling, which adjusts the rendering resolution to hold a GPU frame time target.
+\remarks The render targets are allocated once with the maximal resolution, and each frame only renders into
+the top-left region of the scaled resolution (see GetViewport and GetScissor). The final pass samples this region
+(see GetUVScale) and upscales it to the screen, so neither render targets nor swap chains are reallocated when the scale changes.
+Since the GPU cost is roughly proportional to the number of pixels, the scale is adjusted by the square root of the ratio
+between target and smoothed frame time.
+\code
+LLGL::GPUProfiler gpuProfiler(*renderer, *commands);
+LLGL::DynamicResolution dynamicResolution(resolutionDesc);
+
+// Render loop
+gpuProfiler.BeginFrame();
+{
+    commands->SetRenderTarget(*sceneRenderTarget);
+    commands->SetViewport(dynamicResolution.GetViewport());
+    // Render scene ...
+
+    commands->SetRenderTarget(*context);
+    // Upscale scene with texture coordinates scaled by dynamicResolution.GetUVScale() ...
+}
+gpuProfiler.EndFrame();
+
+dynamicResolution.Update(gpuProfiler);
+\endcode
+\see GPUProfiler
+*/
+class LLGL_EXPORT DynamicResolution
+{
+
+    public:
+
+        //! Initializes the controller with the maximal scale.
+        DynamicResolution(const DynamicResolutionDescriptor& desc);
+
+        /**
+        \brief Updates the scale with the specified GPU frame time (in nanoseconds).
+        \return True if the scaled resolution has changed.
+        */
+        bool Update(std::uint64_t gpuFrameTime);
+
+        /**
+        \brief Updates the scale with the most recently resolved frame of the GPU profiler.
+        \return True if the scaled resolution has changed. Frames that have already been used for an update are ignored.
+        */
+        bool Update(const GPUProfiler& profiler);
+
+        /**
+        \brief Sets the scale explicitly, e.g. to reset it after a scene change.
+        \remarks The scale is clamped to the range [minScale, maxScale], and the smoothed frame time is reset.
+        */
+        void SetScale(float scale);
+
+        /**
+        \brief Sets the maximal resolution, e.g. after the render targets have been reallocated for a new screen size.
+        \remarks The current scale is kept.
+        */
+        void SetMaxResolution(const Gs::Vector2ui& maxResolution);
+
+        //! Returns the scaled resolution, which is at least 1 in each dimension.
+        Gs::Vector2ui GetResolution() const;
+
+        //! Returns the viewport that covers the scaled resolution within the render targets.
+        Viewport GetViewport() const;
+
+        //! Returns the scissor rectangle that covers the scaled resolution within the render targets.
+        Scissor GetScissor() const;
+
+        //! Returns the ratio between the scaled and the maximal resolution, to scale the texture coordinates when sampling the render targets.
+        Gs::Vector2f GetUVScale() const;
+
+        //! Returns the current resolution scale.
+        inline float GetScale() const
+        {
+            return scale_;
+        }
+
+        //! Returns the smoothed GPU frame time (in nanoseconds), or 0 if no frame time has been recorded yet.
+        inline std::uint64_t GetSmoothedFrameTime() const
+        {
+            return static_cast<std::uint64_t>(smoothedFrameTime_);
+        }
+
+        //! Returns the descriptor of this controller.
+        inline const DynamicResolutionDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+    private:
+
+        DynamicResolutionDescriptor desc_;
+        float                       scale_              = 1.0f;
+        double                      smoothedFrameTime_  = 0.0;
+        bool                        hasProfilerFrame_   = false;
+        std::uint64_t               lastFrameIndex_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
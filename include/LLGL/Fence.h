@@ -0,0 +1,73 @@
+/*
+ * Fence.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_FENCE_H
+#define LLGL_FENCE_H
+
+
+#include "Export.h"
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Fence interface for explicit CPU/GPU synchronization.
+\remarks A fence is signaled by the GPU as soon as all commands, which have been submitted before the respective "CommandBuffer::Signal" call, are completed.
+In contrast to "CommandBuffer::SyncGPU", the CPU can poll the fence or wait for it at a later time, e.g. to recycle per-frame resources.
+If a fence is signaled again, only the most recent signal is observed by "IsSignaled" and "Wait".
+A fence that has never been signaled is considered to be signaled.
+\code
+auto fence = renderSystem->CreateFence();
+// ...
+commands->Signal(*fence);
+// ...
+fence->Wait();
+\endcode
+\see RenderSystem::CreateFence
+\see CommandBuffer::Signal
+*/
+class LLGL_EXPORT Fence
+{
+
+    public:
+
+        Fence(const Fence&) = delete;
+        Fence& operator = (const Fence&) = delete;
+
+        virtual ~Fence();
+
+        /**
+        \brief Returns true if the GPU has completed the most recent signal of this fence.
+        \remarks This function never blocks.
+        */
+        virtual bool IsSignaled() = 0;
+
+        /**
+        \brief Blocks the CPU until the GPU has completed the most recent signal of this fence, or the timeout has elapsed.
+        \param[in] timeout Specifies the timeout (in nanoseconds). By default ~0, which waits without timeout.
+        \return True if the fence has been signaled, or false if the timeout has elapsed.
+        */
+        virtual bool Wait(std::uint64_t timeout = ~0ull) = 0;
+
+    protected:
+
+        Fence() = default;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -32,6 +32,12 @@ enum class DataType
     
     Float,  //!< 32-bit floating-point (float).
     Double, //!< 64-bit real type (double).
+
+    /**
+    \brief 16-bit floating-point (half) in the IEEE 754 binary16 format.
+    \remarks There is no native C++ type for this data type, so each component is stored as 'std::uint16_t'.
+    */
+    Float16,
 };
 
 //! Renderer vector types enumeration.
@@ -53,6 +59,17 @@ enum class VectorType
     UInt2,      //!< 2-Dimensional unsigned integer vector (uvec2 in GLSL, uint2 in HLSL).
     UInt3,      //!< 3-Dimensional unsigned integer vector (uvec3 in GLSL, uint3 in HLSL).
     UInt4,      //!< 4-Dimensional unsigned integer vector (uvec4 in GLSL, uint4 in HLSL).
+
+    /* --- Compact vector types (always read as floating-point vectors in the shader) --- */
+    Half2,              //!< 2-Dimensional half precision floating-point vector with 16 bits per component (vec2 in GLSL, float2 in HLSL).
+    Half4,              //!< 4-Dimensional half precision floating-point vector with 16 bits per component (vec4 in GLSL, float4 in HLSL).
+    Byte4Norm,          //!< 4-Dimensional signed-normalized vector with 8 bits per component (vec4 in GLSL, float4 in HLSL).
+    UByte4Norm,         //!< 4-Dimensional unsigned-normalized vector with 8 bits per component (vec4 in GLSL, float4 in HLSL).
+    Short2Norm,         //!< 2-Dimensional signed-normalized vector with 16 bits per component (vec2 in GLSL, float2 in HLSL).
+    Short4Norm,         //!< 4-Dimensional signed-normalized vector with 16 bits per component (vec4 in GLSL, float4 in HLSL).
+    UShort2Norm,        //!< 2-Dimensional unsigned-normalized vector with 16 bits per component (vec2 in GLSL, float2 in HLSL).
+    UShort4Norm,        //!< 4-Dimensional unsigned-normalized vector with 16 bits per component (vec4 in GLSL, float4 in HLSL).
+    UInt1010102Norm,    //!< 4-Dimensional unsigned-normalized vector packed into 32 bits with 10 bits for X, Y, Z and 2 bits for W, beginning with X at the least significant bits (vec4 in GLSL, float4 in HLSL).
 };
 
 /*
@@ -93,10 +110,20 @@ LLGL_EXPORT unsigned int VectorTypeSize(const VectorType vectorType);
 \brief Retrieves the format of the specified vector type.
 \param[in] vectorType Specifies the vector type whose format is to be retrieved.
 \param[out] dataType Specifies the output parameter for the resulting data type.
+For compact vector types, this is the integral storage type of a component, i.e. DataType::UInt16 for half precision floating-points
+and DataType::UInt32 (for all components together) for VectorType::UInt1010102Norm.
 \param[out] components Specifiefs the output parameter for the resulting number of vector components.
+\see IsCompactVectorType
 */
 LLGL_EXPORT void VectorTypeFormat(const VectorType vectorType, DataType& dataType, unsigned int& components);
 
+/**
+\brief Returns true if the specified vector type is a compact vector type, i.e. VectorType::Half2 up to VectorType::UInt1010102Norm.
+\remarks Compact vector types are always converted to floating-points when they are read in the shader,
+so the VertexAttribute::conversion flag has no effect for them.
+*/
+LLGL_EXPORT bool IsCompactVectorType(const VectorType vectorType);
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,141 @@
+/*
+ * FrustumCulling.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_FRUSTUM_CULLING_H
+#define LLGL_FRUSTUM_CULLING_H
+
+#ifdef LLGL_ENABLE_UTILITY
+
+/*
+THIS HEADER MUST BE EXPLICITLY INCLUDED
+*/
+
+#include "Export.h"
+#include "RenderSystemFlags.h"
+#include <Gauss/Matrix.h>
+#include <Gauss/Vector4.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief View frustum with six normalized planes, whose normals point into the frustum.
+\see MakeFrustum
+*/
+struct Frustum
+{
+    /**
+    \brief Planes in the order left, right, bottom, top, near, and far.
+    \remarks A point \c P is on the inner side of a plane, if <code>dot(plane.xyz, P) + plane.w >= 0</code>.
+    */
+    Gs::Vector4f planes[6];
+};
+
+/**
+\brief Bounding spheres in SoA layout (structure of arrays), i.e. one array per component.
+\remarks Each array must contain one entry per object, and all arrays must be valid for the same number of objects.
+\see CullBoundingSpheres
+*/
+struct BoundingSphereArrays
+{
+    const float* centerX    = nullptr;
+    const float* centerY    = nullptr;
+    const float* centerZ    = nullptr;
+    const float* radius     = nullptr;
+};
+
+/**
+\brief Axis-aligned bounding boxes in SoA layout (structure of arrays), i.e. one array per component.
+\remarks Each array must contain one entry per object, and all arrays must be valid for the same number of objects.
+\see CullBoundingBoxes
+*/
+struct BoundingBoxArrays
+{
+    const float* minX       = nullptr;
+    const float* minY       = nullptr;
+    const float* minZ       = nullptr;
+    const float* maxX       = nullptr;
+    const float* maxY       = nullptr;
+    const float* maxZ       = nullptr;
+};
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Extracts the view frustum planes from the specified view-projection matrix.
+\param[in] viewProjection Specifies the view-projection matrix, which transforms world coordinates into clip coordinates with column vectors,
+i.e. <code>clip = viewProjection * position</code>. Objects are culled in world space with this matrix,
+or in their model space with the world-view-projection matrix.
+\param[in] clippingRange Specifies the depth range of the clip coordinates. This should be RenderingCaps::clippingRange,
+unless the projection matrix has been built for the other range. By default ClippingRange::ZeroToOne.
+\remarks The far plane of a projection matrix with infinite far clipping plane is degenerated, so it is replaced by a plane that contains all points.
+*/
+LLGL_EXPORT Frustum MakeFrustum(const Gs::Matrix4f& viewProjection, const ClippingRange clippingRange = ClippingRange::ZeroToOne);
+
+/**
+\brief Tests the specified bounding spheres against the view frustum and writes the results into a visibility bitmask.
+\param[in] frustum Specifies the view frustum.
+\param[in] spheres Specifies the arrays of the bounding spheres.
+\param[in] numObjects Specifies the number of bounding spheres.
+\param[out] visibilityMask Pointer to the visibility bitmask, which must have at least <code>(numObjects + 31) / 32</code> entries.
+Bit <code>(i % 32)</code> of entry <code>(i / 32)</code> is set if object \c i intersects the frustum, and the unused bits of the last entry are cleared.
+\return Number of visible objects.
+\remarks The spheres are tested with SSE, AVX, or NEON instructions depending on the target architecture of the library,
+and large arrays are distributed over the worker threads of the shared thread pool. The test is conservative,
+i.e. a sphere outside the frustum near its corners may be reported as visible.
+*/
+LLGL_EXPORT std::uint32_t CullBoundingSpheres(
+    const Frustum&              frustum,
+    const BoundingSphereArrays& spheres,
+    std::uint32_t               numObjects,
+    std::uint32_t*              visibilityMask
+);
+
+/**
+\brief Tests the specified axis-aligned bounding boxes against the view frustum and writes the results into a visibility bitmask.
+\param[in] frustum Specifies the view frustum.
+\param[in] boxes Specifies the arrays of the bounding boxes.
+\param[in] numObjects Specifies the number of bounding boxes.
+\param[out] visibilityMask Pointer to the visibility bitmask. See CullBoundingSpheres.
+\return Number of visible objects.
+\remarks Each box is only tested with its corner that is farthest along each plane normal, so the test is conservative as well.
+\see CullBoundingSpheres
+*/
+LLGL_EXPORT std::uint32_t CullBoundingBoxes(
+    const Frustum&              frustum,
+    const BoundingBoxArrays&    boxes,
+    std::uint32_t               numObjects,
+    std::uint32_t*              visibilityMask
+);
+
+/**
+\brief Writes the indices of all visible objects of the specified visibility bitmask in ascending order.
+\param[in] visibilityMask Pointer to the visibility bitmask, as written by CullBoundingSpheres or CullBoundingBoxes.
+\param[in] numObjects Specifies the number of objects.
+\param[out] indices Pointer to the output indices, which must have space for the number of visible objects.
+\return Number of indices that have been written.
+\remarks The indices can be used to gather the instance data of the visible objects for an InstanceStream, or to submit them to a DrawBatcher.
+*/
+LLGL_EXPORT std::uint32_t GetVisibleIndices(const std::uint32_t* visibilityMask, std::uint32_t numObjects, std::uint32_t* indices);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,139 @@
+/*
+ * GPUNodeScheduler.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GPU_NODE_SCHEDULER_H
+#define LLGL_GPU_NODE_SCHEDULER_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <Gauss/Vector2.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Scheduler that distributes the work of each frame over the GPU nodes of a linked adapter.
+\remarks The scheduler holds one deferred command buffer for each GPU node (see CommandBufferDescriptor::nodeIndex)
+and supports two simple schemes:
+- Alternate-frame rendering (AFR): each frame is rendered entirely by a single node, and the nodes take turns frame by frame (see NextFrame).
+- Split-frame rendering (SFR): each frame is rendered by all nodes, each within a horizontal band of the screen (see BeginSplitFrame and GetSplitScissor).
+
+With alternate-frame rendering, consecutive frames run concurrently on different nodes, so each frame must only write
+to its own resources, e.g. one render target per node. Commands that are submitted to node 0 afterwards,
+such as copying the result into the swap chain, wait on the GPU until the previously submitted frames of the other nodes are done.
+If the render system has only a single node, all frames are recorded into the command buffer of node 0.
+\code
+LLGL::GPUNodeScheduler scheduler(*renderer);
+
+// Render loop (alternate-frame rendering)
+auto& commands = scheduler.NextFrame();
+{
+    commands.SetRenderTarget(*frameRenderTargets[scheduler.GetFrameNode()]);
+    // Render scene ...
+}
+scheduler.SubmitFrame();
+\endcode
+\see RenderingCaps::numGPUNodes
+*/
+class LLGL_EXPORT GPUNodeScheduler
+{
+
+    public:
+
+        GPUNodeScheduler(const GPUNodeScheduler&) = delete;
+        GPUNodeScheduler& operator = (const GPUNodeScheduler&) = delete;
+
+        /**
+        \brief Creates a deferred command buffer for each GPU node.
+        \param[in] renderSystem Specifies the render system, which is used to create and submit the command buffers.
+        \param[in] maxNumNodes Specifies the maximal number of GPU nodes to use, or 0 to use all nodes. By default 0.
+        */
+        GPUNodeScheduler(RenderSystem& renderSystem, unsigned int maxNumNodes = 0);
+
+        //! Releases the command buffers of all GPU nodes.
+        ~GPUNodeScheduler();
+
+        /**
+        \brief Begins the next frame for alternate-frame rendering and returns the command buffer of the node that renders it.
+        \remarks The nodes are selected in turn, and the command buffer is reset before it is returned,
+        which waits until the GPU node has finished its previous frame.
+        \see SubmitFrame
+        */
+        CommandBuffer& NextFrame();
+
+        /**
+        \brief Submits the command buffer of the current frame, which has been begun with NextFrame.
+        \throw std::runtime_error If no frame has been begun.
+        */
+        void SubmitFrame();
+
+        /**
+        \brief Begins the next frame for split-frame rendering, i.e. resets the command buffers of all nodes.
+        \see GetSplitScissor
+        \see SubmitSplitFrame
+        */
+        void BeginSplitFrame();
+
+        //! Submits the command buffers of all nodes with a single call to RenderSystem::ExecuteCommandBuffers.
+        void SubmitSplitFrame();
+
+        /**
+        \brief Returns the scissor rectangle of the horizontal band the specified node renders with split-frame rendering.
+        \param[in] nodeIndex Specifies the zero-based index of the GPU node.
+        \param[in] resolution Specifies the resolution of the entire frame.
+        \remarks The bands of all nodes have (almost) the same height and cover the entire frame without overlapping.
+        */
+        Scissor GetSplitScissor(unsigned int nodeIndex, const Gs::Vector2ui& resolution) const;
+
+        /**
+        \brief Returns the command buffer of the specified GPU node.
+        \throw std::out_of_range If 'nodeIndex' is not less than the number of nodes.
+        */
+        CommandBuffer& GetCommandBuffer(unsigned int nodeIndex) const;
+
+        //! Returns the number of GPU nodes the work is distributed over.
+        inline unsigned int GetNumNodes() const
+        {
+            return static_cast<unsigned int>(commandBuffers_.size());
+        }
+
+        //! Returns the index of the GPU node that renders the current frame with alternate-frame rendering.
+        inline unsigned int GetFrameNode() const
+        {
+            return frameNode_;
+        }
+
+        //! Returns the number of frames that have been begun so far.
+        inline std::uint64_t GetNumFrames() const
+        {
+            return numFrames_;
+        }
+
+    private:
+
+        RenderSystem&               renderSystem_;
+        std::vector<CommandBuffer*> commandBuffers_;
+        unsigned int                frameNode_      = 0;
+        std::uint64_t               numFrames_      = 0;
+        bool                        insideFrame_    = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,242 @@
+/*
+ * GPUProfiler.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GPU_PROFILER_H
+#define LLGL_GPU_PROFILER_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+//! GPU profiler scope timing structure.
+struct GPUProfilerScope
+{
+    //! Name of the scope, as specified with "GPUProfiler::PushScope".
+    std::string     name;
+
+    //! Nesting depth of the scope, i.e. 0 for top-level scopes.
+    unsigned int    depth       = 0;
+
+    //! Index of the parent scope within the list of scopes of its frame, or -1 for top-level scopes.
+    int             parent      = -1;
+
+    //! GPU time (in nanoseconds) at which the scope has started, relative to the beginning of the frame.
+    std::uint64_t   startTime   = 0;
+
+    //! Elapsed GPU time (in nanoseconds) of the scope, including all of its child scopes.
+    std::uint64_t   elapsedTime = 0;
+
+    /**
+    \brief Pipeline statistics of the scope, including all of its child scopes.
+    \remarks This is only recorded if the profiler has been created with pipeline statistics, otherwise all counters are zero.
+    */
+    QueryPipelineStatistics statistics;
+};
+
+/**
+\brief GPU profiler frame timing structure.
+\see GPUProfiler::GetResolvedFrame
+*/
+struct GPUProfilerFrame
+{
+    //! Zero-based index of the frame, counted by "GPUProfiler::BeginFrame".
+    std::uint64_t                   frameIndex  = 0;
+
+    /**
+    \brief GPU timestamp (in nanoseconds) at which the frame has been started with "GPUProfiler::BeginFrame".
+    \remarks This is in the GPU time base, which can be mapped onto the CPU timeline with a ClockCalibration.
+    \see RenderSystem::QueryClockCalibration
+    */
+    std::uint64_t                   startTimestamp  = 0;
+
+    //! Elapsed GPU time (in nanoseconds) between "GPUProfiler::BeginFrame" and "GPUProfiler::EndFrame".
+    std::uint64_t                   elapsedTime = 0;
+
+    //! Pipeline statistics between "GPUProfiler::BeginFrame" and "GPUProfiler::EndFrame", if the profiler records them.
+    QueryPipelineStatistics         statistics;
+
+    /**
+    \brief Timings of all scopes of this frame in depth-first order, i.e. each scope is followed by its child scopes.
+    \see GPUProfilerScope::parent
+    */
+    std::vector<GPUProfilerScope>   scopes;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Profiler for GPU timings of nested named scopes.
+\remarks In contrast to the counters of the RenderingProfiler, which are recorded on the CPU side, this profiler measures
+the time the GPU spends within each scope. Each scope is measured with a pair of timestamp queries (see QueryType::Timestamp)
+from a pool that grows on demand. The query results are polled without blocking at the end of each frame,
+so the timings of a frame are available a few frames later. The resolved frame forms a tree of scope timings.
+Optionally, the profiler also records the pipeline statistics of each scope (see QueryType::PipelineStatistics),
+which helps to find passes that are bound by overdraw (fragment shader invocations) or by the vertex processing.
+Since pipeline statistics queries must not overlap on all platforms, they are recorded in consecutive segments between
+any two scope boundaries, and the statistics of each scope are the sum of its segments.
+\code
+LLGL::GPUProfiler gpuProfiler(*renderer, *commands);
+
+// Render loop
+gpuProfiler.BeginFrame();
+{
+    gpuProfiler.PushScope("Shadows");
+    // Render shadow maps ...
+    gpuProfiler.PopScope();
+
+    gpuProfiler.PushScope("Scene");
+    // Render scene ...
+    gpuProfiler.PopScope();
+}
+gpuProfiler.EndFrame();
+
+for (const auto& scope : gpuProfiler.GetResolvedFrame().scopes)
+    std::cout << std::string(scope.depth * 2, ' ') << scope.name << ": " << scope.elapsedTime/1000 << " us" << std::endl;
+\endcode
+\note Only supported with: OpenGL (with GL_ARB_timer_query), Direct3D 11.
+*/
+class LLGL_EXPORT GPUProfiler
+{
+
+    public:
+
+        GPUProfiler(const GPUProfiler&) = delete;
+        GPUProfiler& operator = (const GPUProfiler&) = delete;
+
+        /**
+        \brief Initializes the GPU profiler.
+        \param[in] renderSystem Specifies the render system, which is used to create the timestamp queries.
+        \param[in] commandBuffer Specifies the command buffer, which is used to record the timestamps and to retrieve the query results.
+        This must be the command buffer that is used within the profiled scopes.
+        \param[in] maxPendingFrames Specifies the maximal number of frames, whose results are pending.
+        If the results of the oldest frame are not available when this limit is exceeded, this frame is discarded. By default 4.
+        \param[in] pipelineStatistics Specifies whether the pipeline statistics of each scope are recorded as well. By default false.
+        \throw std::runtime_error If 'pipelineStatistics' is true but the render system does not support pipeline statistics queries.
+        */
+        GPUProfiler(RenderSystem& renderSystem, CommandBuffer& commandBuffer, std::size_t maxPendingFrames = 4, bool pipelineStatistics = false);
+
+        //! Releases all timestamp and pipeline statistics queries.
+        ~GPUProfiler();
+
+        /**
+        \brief Begins a new frame.
+        \throw std::runtime_error If the previous frame has not been ended.
+        */
+        void BeginFrame();
+
+        /**
+        \brief Ends the current frame and resolves the results of any pending frames, that are available, without blocking.
+        \throw std::runtime_error If no frame has been begun or if any scope has not been popped.
+        */
+        void EndFrame();
+
+        /**
+        \brief Pushes a new named scope onto the stack, i.e. the scope is nested into the current scope.
+        \throw std::runtime_error If no frame has been begun.
+        */
+        void PushScope(const std::string& name);
+
+        /**
+        \brief Pops the current scope from the stack.
+        \throw std::runtime_error If there is no scope to pop.
+        */
+        void PopScope();
+
+        //! Returns true if the timings of any frame have been resolved so far.
+        inline bool HasResolvedFrame() const
+        {
+            return hasResolvedFrame_;
+        }
+
+        //! Returns the timings of the most recently resolved frame.
+        inline const GPUProfilerFrame& GetResolvedFrame() const
+        {
+            return resolvedFrame_;
+        }
+
+        //! Returns the number of frames that have been discarded, because their results were not available in time.
+        inline std::uint64_t GetNumDiscardedFrames() const
+        {
+            return numDiscardedFrames_;
+        }
+
+    private:
+
+        struct PendingScope
+        {
+            std::string     name;
+            unsigned int    depth       = 0;
+            int             parent      = -1;
+            std::size_t     beginQuery      = 0;
+            std::size_t     endQuery        = 0;
+            std::size_t     beginSegment    = 0;
+            std::size_t     endSegment      = 0;
+        };
+
+        struct PendingFrame
+        {
+            std::uint64_t               frameIndex  = 0;
+            std::vector<Query*>         queries;
+            std::vector<std::uint64_t>  timestamps;
+            std::vector<PendingScope>   scopes;
+
+            std::vector<Query*>                     segmentQueries;
+            std::vector<QueryPipelineStatistics>    segments;
+        };
+
+        std::size_t WriteTimestamp();
+        std::size_t NextStatisticsSegment();
+        void EndStatisticsSegment();
+
+        bool ResolveFrame(PendingFrame& frame);
+        void RecycleFrame(PendingFrame& frame);
+
+        RenderSystem&               renderSystem_;
+        CommandBuffer&              commandBuffer_;
+        std::size_t                 maxPendingFrames_   = 4;
+
+        std::vector<Query*>         allQueries_;
+        std::vector<Query*>         freeQueries_;
+
+        bool                        pipelineStatistics_ = false;
+        std::vector<Query*>         allSegmentQueries_;
+        std::vector<Query*>         freeSegmentQueries_;
+
+        bool                        insideFrame_        = false;
+        PendingFrame                currentFrame_;
+        std::vector<std::size_t>    scopeStack_;
+        std::deque<PendingFrame>    pendingFrames_;
+
+        std::uint64_t               nextFrameIndex_     = 0;
+        std::uint64_t               numDiscardedFrames_ = 0;
+
+        bool                        hasResolvedFrame_   = false;
+        GPUProfilerFrame            resolvedFrame_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
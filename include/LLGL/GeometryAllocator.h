@@ -0,0 +1,231 @@
+/*
+ * GeometryAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GEOMETRY_ALLOCATOR_H
+#define LLGL_GEOMETRY_ALLOCATOR_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "CommandBuffer.h"
+#include "VertexFormat.h"
+#include "IndexFormat.h"
+#include "RenderingProfiler.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Geometry allocator descriptor structure.
+\see GeometryAllocator
+*/
+struct GeometryAllocatorDescriptor
+{
+    //! Specifies the vertex format of all meshes. The stride of this format must not be zero.
+    VertexFormat    vertexFormat;
+
+    //! Specifies the index format of all meshes. By default DataType::UInt32.
+    IndexFormat     indexFormat     = IndexFormat(DataType::UInt32);
+
+    /**
+    \brief Specifies the number of vertices of the vertex buffer. By default 1048576.
+    \remarks The buffers are allocated once and are never reallocated, so they can be bound permanently.
+    */
+    unsigned int    maxVertices     = (1u << 20);
+
+    //! Specifies the number of indices of the index buffer. By default 4194304.
+    unsigned int    maxIndices      = (1u << 22);
+};
+
+/**
+\brief Geometry range structure, which describes where a mesh has been placed within the buffers of a geometry allocator.
+\remarks The indices of a mesh are relative to its first vertex, i.e. the mesh is drawn with
+CommandBuffer::DrawIndexed(numIndices, firstIndex, firstVertex) after the buffers of the allocator have been bound.
+\see GeometryAllocator::Insert
+*/
+struct GeometryRange
+{
+    //! Zero-based index of the first vertex within the vertex buffer.
+    unsigned int firstVertex    = 0;
+
+    //! Number of vertices.
+    unsigned int numVertices    = 0;
+
+    //! Zero-based index of the first index within the index buffer.
+    unsigned int firstIndex     = 0;
+
+    //! Number of indices.
+    unsigned int numIndices     = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Geometry allocator, which packs many meshes of the same vertex format into a single vertex buffer and a single index buffer.
+\remarks Binding separate vertex and index buffers for each mesh requires a buffer switch before each draw command,
+and prevents consecutive draw commands from being merged. All meshes of the allocator are drawn with the same buffer bindings instead,
+and are only addressed by the 'firstIndex' and 'vertexOffset' arguments of the indexed draw commands.
+The ranges are managed with a first-fit free list for each buffer, so meshes can be inserted and freed while the application is running.
+\code
+LLGL::GeometryAllocator geometry(*renderer, geometryDesc);
+
+LLGL::GeometryRange meshRange;
+geometry.Insert(vertices.data(), numVertices, indices.data(), numIndices, meshRange);
+
+// Render loop
+geometry.Bind(*commands);
+for (const auto& range : meshRanges)
+    geometry.Draw(*commands, range);
+\endcode
+\see CommandBuffer::SetVertexBuffer
+\see CommandBuffer::SetIndexBuffer
+*/
+class LLGL_EXPORT GeometryAllocator
+{
+
+    public:
+
+        GeometryAllocator(const GeometryAllocator&) = delete;
+        GeometryAllocator& operator = (const GeometryAllocator&) = delete;
+
+        /**
+        \brief Creates the vertex buffer and the index buffer.
+        \param[in] renderSystem Specifies the render system, which is used to create and write the buffers.
+        \param[in] desc Specifies the geometry allocator descriptor.
+        \throw std::invalid_argument If the vertex format has no stride, or if the maximal number of vertices or indices is zero.
+        */
+        GeometryAllocator(RenderSystem& renderSystem, const GeometryAllocatorDescriptor& desc);
+
+        //! Releases the vertex buffer and the index buffer.
+        ~GeometryAllocator();
+
+        /**
+        \brief Allocates a range of the specified number of vertices and indices without writing any data.
+        \param[in] numVertices Specifies the number of vertices.
+        \param[in] numIndices Specifies the number of indices. This can be zero for non-indexed meshes.
+        \param[out] range Receives the allocated range.
+        \return True if the range has been allocated, or false if either buffer has no contiguous space left.
+        */
+        bool Allocate(unsigned int numVertices, unsigned int numIndices, GeometryRange& range);
+
+        /**
+        \brief Allocates a range and writes the specified vertices and indices into it.
+        \param[in] vertices Raw pointer to the vertex data, which must be laid out in the vertex format of this allocator.
+        \param[in] numVertices Specifies the number of vertices.
+        \param[in] indices Raw pointer to the index data, which must be laid out in the index format of this allocator.
+        The indices are relative to the first vertex of the mesh. This may be null if 'numIndices' is zero.
+        \param[in] numIndices Specifies the number of indices.
+        \param[out] range Receives the allocated range.
+        \return True if the mesh has been inserted, or false if either buffer has no contiguous space left.
+        */
+        bool Insert(const void* vertices, unsigned int numVertices, const void* indices, unsigned int numIndices, GeometryRange& range);
+
+        /**
+        \brief Writes the specified vertices and indices into a range that has been allocated before.
+        \remarks The data must cover the entire range. The indices may be null if the range has no indices.
+        */
+        void Write(const GeometryRange& range, const void* vertices, const void* indices);
+
+        /**
+        \brief Frees the specified range, so it can be allocated again.
+        \remarks The range must have been allocated by this allocator and must not be freed twice.
+        Adjacent free ranges are merged, so freeing all meshes restores the entire buffers.
+        */
+        void Free(const GeometryRange& range);
+
+        //! Frees all ranges.
+        void Clear();
+
+        //! Binds the vertex buffer and the index buffer of this allocator at offset zero.
+        void Bind(CommandBuffer& commandBuffer) const;
+
+        /**
+        \brief Records an indexed draw command for the specified range, or a non-indexed draw command if the range has no indices.
+        \param[in] commandBuffer Specifies the command buffer, which records the draw command.
+        \param[in] range Specifies the range of the mesh.
+        \param[in] numInstances Specifies the number of instances. By default 1.
+        \remarks The buffers of this allocator must have been bound with "Bind" before.
+        */
+        void Draw(CommandBuffer& commandBuffer, const GeometryRange& range, unsigned int numInstances = 1) const;
+
+        /**
+        \brief Reports the usage and fragmentation of both buffers to the specified profiler.
+        \param[in] profiler Specifies the profiler, which receives the usage of the suballocators.
+        \param[in] name Specifies the name of this allocator. The buffers are reported as "<name>.vertices" and "<name>.indices" in units of vertices and indices.
+        \see RenderingProfiler::ReportSuballocator
+        */
+        void ReportMemoryUsage(RenderingProfiler& profiler, const std::string& name) const;
+
+        //! Returns the vertex buffer of the allocator.
+        inline Buffer& GetVertexBuffer() const
+        {
+            return *vertexBuffer_;
+        }
+
+        //! Returns the index buffer of the allocator.
+        inline Buffer& GetIndexBuffer() const
+        {
+            return *indexBuffer_;
+        }
+
+        //! Returns the descriptor of this allocator.
+        inline const GeometryAllocatorDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+        //! Returns the number of vertices that are currently allocated.
+        inline unsigned int GetNumAllocatedVertices() const
+        {
+            return numAllocatedVertices_;
+        }
+
+        //! Returns the number of indices that are currently allocated.
+        inline unsigned int GetNumAllocatedIndices() const
+        {
+            return numAllocatedIndices_;
+        }
+
+    private:
+
+        struct FreeBlock
+        {
+            unsigned int offset;
+            unsigned int size;
+        };
+
+        static bool AllocateBlock(std::vector<FreeBlock>& freeBlocks, unsigned int size, unsigned int& offset);
+        static void ReleaseBlock(std::vector<FreeBlock>& freeBlocks, unsigned int offset, unsigned int size);
+        static unsigned int GetLargestBlockSize(const std::vector<FreeBlock>& freeBlocks);
+
+        RenderSystem&                   renderSystem_;
+        GeometryAllocatorDescriptor     desc_;
+        Buffer*                         vertexBuffer_           = nullptr;
+        Buffer*                         indexBuffer_            = nullptr;
+
+        std::vector<FreeBlock>          freeVertices_;
+        std::vector<FreeBlock>          freeIndices_;
+        unsigned int                    numAllocatedVertices_   = 0;
+        unsigned int                    numAllocatedIndices_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
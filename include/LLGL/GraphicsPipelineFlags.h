@@ -239,13 +239,20 @@ struct DepthDescriptor
     \brief Specifies whether the depth test is enabled or disabled. By default disabled.
     \remarks If no pixel shader is used in the graphics pipeline, the depth test must be disabled.
     */
-    bool        testEnabled     = false;
+    bool        testEnabled         = false;
 
     //! Specifies whether writing to the depth buffer is enabled or disabled. By default disabled.
-    bool        writeEnabled    = false;
+    bool        writeEnabled        = false;
 
     //! Specifies the depth test comparison function. By default CompareOp::Less.
-    CompareOp   compareOp       = CompareOp::Less;
+    CompareOp   compareOp           = CompareOp::Less;
+
+    /**
+    \brief Specifies whether the depth-bounds test is enabled or disabled. By default disabled.
+    \remarks If enabled, fragments are discarded whose stored depth value lies outside of the depth bounds specified with CommandBuffer::SetDepthBounds.
+    This requires RenderingCaps::hasDepthBoundsTest, otherwise this state is ignored.
+    */
+    bool        boundsTestEnabled   = false;
 };
 
 //! Stencil face descriptor structure.
@@ -330,8 +337,10 @@ struct RasterizerDescriptor
     bool                    antiAliasedLineEnabled      = false;
 
     /**
-    \brief If ture, conservative rasterization is enabled.
-    \note Only supported with: Direct3D 12 (or OpenGL if the extension "GL_NV_conservative_raster" or "GL_INTEL_conservative_rasterization" is supported).
+    \brief If true, conservative rasterization is enabled. By default disabled.
+    \remarks With conservative rasterization, every pixel that is partially covered by a primitive is rasterized, e.g. for voxelization.
+    This requires RenderingCaps::hasConservativeRasterization.
+    \note Only supported with: Direct3D 11.3, Direct3D 12, OpenGL (if the extension "GL_NV_conservative_raster" or "GL_INTEL_conservative_rasterization" is supported).
     \see https://www.opengl.org/registry/specs/NV/conservative_raster.txt
     \see https://www.opengl.org/registry/specs/INTEL/conservative_rasterization.txt
     */
@@ -381,6 +390,30 @@ struct BlendDescriptor
     std::vector<BlendTargetDescriptor>  targets;
 };
 
+/**
+\brief Push constants descriptor structure.
+\remarks Push constants are a small block of constants that is written directly into the command buffer
+(see CommandBuffer::SetPushConstants), which avoids a buffer update for small per-draw data such as transformation matrices.
+The push constants must be named "PushConstants" in the shader source.
+In HLSL, they are declared as constant buffer at the specified slot, e.g. <code>cbuffer PushConstants : register(b13) { float4x4 wvpMatrix; };</code>.
+In GLSL, they are declared as uniform array of 4D-vectors, e.g. <code>uniform vec4 PushConstants[4];</code>.
+\see GraphicsPipelineDescriptor::pushConstants
+*/
+struct PushConstantsDescriptor
+{
+    /**
+    \brief Specifies the size (in bytes) of the push constants. By default 0, i.e. the pipeline has no push constants.
+    \remarks This must be a multiple of 16 and must not be greater than RenderingCaps::maxPushConstantsSize.
+    */
+    unsigned int    size    = 0;
+
+    /**
+    \brief Specifies the constant buffer slot of the push constants. By default 13.
+    \remarks This is only used for Direct3D, and the slot must not be used by any other constant buffer of the shader program.
+    */
+    unsigned int    slot    = 13;
+};
+
 /**
 \brief Graphics pipeline descriptor structure.
 \remarks This structure describes the entire graphics pipeline:
@@ -413,6 +446,24 @@ struct GraphicsPipelineDescriptor
 
     //! Specifies the blending state descriptor.
     BlendDescriptor         blend;
+
+    /**
+    \brief Specifies the push constants descriptor.
+    \see CommandBuffer::SetPushConstants
+    */
+    PushConstantsDescriptor pushConstants;
+
+    /**
+    \brief Specifies the bit mask of views this graphics pipeline renders into with a single draw call. By default 0.
+    \remarks If this is non-zero, each draw call is instanced for every view whose bit is set, and view i is rendered into the layer 'i'
+    of the multiview attachments (see RenderTargetAttachmentDescriptor::numViews). The shaders read the current view index from
+    'gl_ViewID_OVR' in GLSL, and the vertex shader declares the number of views with 'layout(num_views = N) in'.
+    With OpenGL, the views are determined by the attachments, so the view mask must be (1 << N) - 1 for N views.
+    The number of views must not exceed RenderingCaps::maxNumViews. If this is 0, multiview rendering is disabled.
+    \note Only supported with: OpenGL (requires GL_OVR_multiview2).
+    \see RenderTargetAttachmentDescriptor::numViews
+    */
+    std::uint32_t           viewMask            = 0;
 };
 
 
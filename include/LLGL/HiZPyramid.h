@@ -0,0 +1,178 @@
+/*
+ * HiZPyramid.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_HI_Z_PYRAMID_H
+#define LLGL_HI_Z_PYRAMID_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "CommandBuffer.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Hierarchical-Z pyramid descriptor structure.
+\see HiZPyramid
+*/
+struct HiZPyramidDescriptor
+{
+    /**
+    \brief Specifies the graphics pipeline, which downsamples one level of the pyramid. This must not be null.
+    \remarks The pipeline draws a full-screen triangle with 3 vertices and without vertex buffer (i.e. with SV_VertexID or gl_VertexID),
+    and must have push constants of the size of HiZPyramidParameters (see GraphicsPipelineDescriptor::pushConstants).
+    The fragment shader reads the source level from a texture at slot 0 (with texelFetch in GLSL or Texture2D::Load in HLSL, i.e. without sampler),
+    and writes the reduced depth into the first color attachment. For level 0, the source is the depth texture itself and has the same size as the destination.
+    For all other levels, each destination texel covers a 2x2 footprint of the source level,
+    which is extended to 3 texels in each dimension where the size of the source level is odd, so no depth value is skipped.
+    The reduction is up to the shader, e.g. the maximum for conservative occlusion culling with a standard depth range,
+    or minimum and maximum in the red and green components for screen-space ray marching.
+    */
+    GraphicsPipeline*   pipeline    = nullptr;
+
+    //! Specifies the width of level 0 of the pyramid, which must be equal to the width of the depth texture. This must not be zero.
+    std::uint32_t       width       = 0;
+
+    //! Specifies the height of level 0 of the pyramid, which must be equal to the height of the depth texture. This must not be zero.
+    std::uint32_t       height      = 0;
+
+    /**
+    \brief Specifies the texture format of the pyramid. By default TextureFormat::R32Float.
+    \remarks Use TextureFormat::RG32Float to store both the minimum and the maximum depth.
+    */
+    TextureFormat       format      = TextureFormat::R32Float;
+};
+
+/**
+\brief Hierarchical-Z pyramid parameters structure.
+\remarks This is the layout of the push constants of the graphics pipeline, which are set by HiZPyramid::Build for each level.
+\see HiZPyramidDescriptor::pipeline
+*/
+struct HiZPyramidParameters
+{
+    //! Size of the source level, i.e. of the depth texture for level 0.
+    std::uint32_t   srcSize[2]  = { 0, 0 };
+
+    //! Size of the destination level.
+    std::uint32_t   dstSize[2]  = { 0, 0 };
+
+    //! Index of the destination level.
+    std::uint32_t   level       = 0;
+
+    std::uint32_t   reserved[3] = { 0, 0, 0 };
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Builder of a hierarchical-Z pyramid, i.e. a MIP-mapped texture with the reduced depth values of a depth texture.
+\remarks GPU occlusion culling and screen-space reflections test against the pyramid level whose texels cover the screen-space bounds of an object or ray segment,
+so they read only a few texels instead of the entire depth buffer. The pyramid texture has a full MIP-map chain, and each level is rendered in its own render pass,
+which reads the previous level through a texture view of that single level. The entire pyramid is thus built with one draw call per level and without any CPU round trip.
+\code
+LLGL::HiZPyramid hiZ(*renderer, *commands, hiZDesc);
+
+// Render loop, after the depth pre-pass into 'depthTexture'
+hiZ.Build(*depthTexture);
+
+commands->SetTexture(hiZ.GetTexture(), 1, LLGL::ShaderStageFlags::ComputeStage);
+// Dispatch culling shader ...
+\endcode
+\note Only supported with: OpenGL, Direct3D 11, Direct3D 12.
+*/
+class LLGL_EXPORT HiZPyramid
+{
+
+    public:
+
+        HiZPyramid(const HiZPyramid&) = delete;
+        HiZPyramid& operator = (const HiZPyramid&) = delete;
+
+        /**
+        \brief Creates the pyramid texture, a texture view and a render target for each level.
+        \param[in] renderSystem Specifies the render system, which is used to create the resources.
+        \param[in] commandBuffer Specifies the command buffer, which records the render passes.
+        \param[in] desc Specifies the hierarchical-Z pyramid descriptor.
+        \throw std::invalid_argument If the graphics pipeline is null, or if the width or height is zero.
+        \throw std::runtime_error If the render system does not support render targets, texture views, or push constants of the size of HiZPyramidParameters.
+        */
+        HiZPyramid(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const HiZPyramidDescriptor& desc);
+
+        //! Releases the pyramid texture, all texture views, and all render targets.
+        ~HiZPyramid();
+
+        /**
+        \brief Records the render passes, which build all levels of the pyramid from the specified depth texture.
+        \param[in] depthTexture Specifies the depth texture, which must have the size of level 0 of the pyramid.
+        \remarks This must not be called within a render pass. The viewport, graphics pipeline, and render target of the command buffer are undefined afterwards.
+        */
+        void Build(Texture& depthTexture);
+
+        /**
+        \brief Resizes level 0 of the pyramid, e.g. after the depth buffer has been resized.
+        \remarks This recreates all resources if the size has changed.
+        \throw std::invalid_argument If the width or height is zero.
+        */
+        void Resize(std::uint32_t width, std::uint32_t height);
+
+        //! Returns the pyramid texture with all levels, as built by the most recent call to Build.
+        inline Texture& GetTexture() const
+        {
+            return *texture_;
+        }
+
+        //! Returns the number of levels of the pyramid.
+        inline std::uint32_t GetNumLevels() const
+        {
+            return static_cast<std::uint32_t>(levels_.size());
+        }
+
+        //! Returns the descriptor of this hierarchical-Z pyramid, including the current size.
+        inline const HiZPyramidDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+    private:
+
+        // Render target and texture view of a single level.
+        struct Level
+        {
+            RenderTarget*   renderTarget    = nullptr;
+            Texture*        textureView     = nullptr;
+            std::uint32_t   width           = 0;
+            std::uint32_t   height          = 0;
+        };
+
+        void CreateResources();
+        void ReleaseResources();
+
+        RenderSystem&           renderSystem_;
+        CommandBuffer&          commandBuffer_;
+        HiZPyramidDescriptor    desc_;
+        Texture*                texture_        = nullptr;
+        std::vector<Level>      levels_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
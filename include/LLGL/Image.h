@@ -10,10 +10,12 @@
 
 
 #include "Export.h"
+#include "Allocator.h"
 #include "Format.h"
 #include "RenderSystemFlags.h"
 #include "TextureFlags.h"
 #include <memory>
+#include <vector>
 
 
 namespace LLGL
@@ -26,10 +28,12 @@ namespace LLGL
 \brief Common byte buffer type.
 \remarks Commonly this would be an std::vector<char>, but the buffer conversion is an optimized process,
 where the default initialization of an std::vector is undesired.
-Therefore, the byte buffer type is an std::unique_ptr<char[]>.
+Therefore, the byte buffer type is an std::unique_ptr<char[], AllocatorDeleter>, whose memory is allocated with the allocator of LLGL.
 \see ConvertImageBuffer
+\see AllocByteBuffer
+\see SetAllocator
 */
-using ByteBuffer = std::unique_ptr<char[]>;
+using ByteBuffer = std::unique_ptr<char[], AllocatorDeleter>;
 
 
 /* ----- Enumerations ----- */
@@ -56,6 +60,59 @@ enum class ImageFormat
     CompressedRGBA, //!< Generic compressed format with four color components: Red, Green, Blue, Alpha.
 };
 
+/**
+\brief MIP-map filter enumeration for the CPU-side MIP-map generation.
+\see GenerateMipMaps
+*/
+enum class MipMapFilter
+{
+    //! Box filter, which averages each 2x2 block of texels. This is the fastest filter.
+    Box,
+
+    /**
+    \brief Kaiser-windowed sinc filter with 6x6 texels.
+    \remarks This preserves more details than the box filter, but is also more expensive.
+    */
+    Kaiser,
+};
+
+/**
+\brief Filter enumeration for the CPU-side image resampling.
+\remarks When an image is downsampled, the filter footprint is widened by the scaling factor, so every source texel contributes to the result.
+\see ResampleImage
+*/
+enum class ResampleFilter
+{
+    //! Box filter, which averages all source texels covered by a destination texel. This is a nearest-neighbor filter when an image is upsampled.
+    Box,
+
+    //! Bilinear (i.e. triangle) filter.
+    Bilinear,
+
+    /**
+    \brief Lanczos filter with 3 lobes.
+    \remarks This preserves the most details, but is also the most expensive filter. Its negative lobes can overshoot at sharp edges,
+    so the results are clamped to the normalized range for integral data types.
+    */
+    Lanczos,
+};
+
+/**
+\brief Color space enumeration for the image conversion.
+\see ConvertImageBuffer(ImageFormat, DataType, ColorSpace, const void*, std::size_t, ImageFormat, DataType, ColorSpace, void*, std::size_t, std::size_t)
+*/
+enum class ColorSpace
+{
+    //! Color components are stored linearly.
+    Linear,
+
+    /**
+    \brief Color components are gamma-encoded with the sRGB transfer function.
+    \remarks The alpha component is always stored linearly.
+    */
+    SRGB,
+};
+
 
 /* ----- Structures ----- */
 
@@ -95,12 +152,26 @@ struct LLGL_EXPORT ImageDescriptor
     ImageFormat     format          = ImageFormat::RGBA;    //!< Specifies the image format. By default ImageFormat::RGBA.
     DataType        dataType        = DataType::UInt8;      //!< Specifies the image data type. This must be DataType::UInt8 for compressed images.
     const void*     buffer          = nullptr;              //!< Pointer to the image buffer.
-    unsigned int    compressedSize  = 0;                    //!< Specifies the size (in bytes) of a compressed image. This must be 0 for uncompressed images.
+    /**
+    \brief Specifies the size (in bytes) of a compressed image. This must be 0 for uncompressed images.
+    \remarks For compressed images, this can also be 0 to determine the size from the block size of the texture format.
+    \see CompressedImageSize
+    */
+    unsigned int    compressedSize  = 0;
 };
 
 
 /* ----- Functions ----- */
 
+/**
+\brief Allocates a new byte buffer with the allocator of LLGL.
+\param[in] size Specifies the size (in bytes) of the byte buffer. The content of the buffer is not initialized.
+\param[in] tag Specifies the allocation tag that is passed to the allocator. By default "ByteBuffer".
+\return Byte buffer of the specified size, or null if 'size' is 0.
+\see SetAllocator
+*/
+LLGL_EXPORT ByteBuffer AllocByteBuffer(std::size_t size, const char* tag = "ByteBuffer");
+
 /**
 \brief Returns the size (in number of components) of the specified image format.
 \param[in] imageFormat Specifies the image format.
@@ -154,6 +225,239 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     std::size_t threadCount = 0
 );
 
+/**
+\brief Converts the image format and data type of the source image into the specified destination buffer (only uncompressed color formats).
+\param[in] srcFormat Specifies the source image format.
+\param[in] srcDataType Specifies the source data type.
+\param[in] srcBuffer Pointer to the source image buffer which is to be converted.
+\param[in] srcBufferSize Specifies the size (in bytes) of the source image buffer.
+\param[in] dstFormat Specifies the destination image format.
+\param[in] dstDataType Specifies the destination data type.
+\param[out] dstBuffer Pointer to the destination image buffer, the converted image is written to.
+This can be any memory that is writable by the CPU, e.g. a mapped buffer (see RenderSystem::MapBuffer).
+\param[in] dstBufferSize Specifies the size (in bytes) of the destination image buffer.
+\param[in] threadCount Specifies the number of threads to use for conversion. By default 0.
+\remarks In contrast to the other variant of this function, no memory is allocated for the destination image.
+If neither the format nor the data type differ, the source image is copied into the destination buffer,
+unless both buffers are the same, in which case this function returns immediately.
+If 'srcBuffer' and 'dstBuffer' are the same, the image is converted in place (see ConvertImageBufferInPlace).
+\throw std::invalid_argument If the destination buffer size is too small,
+if 'dstBuffer' is a null pointer, if the image is converted in place but the conversion changes the pixel size,
+or for the same reasons as the other variant of this function.
+\see ConvertImageBuffer(ImageFormat, DataType, const void*, std::size_t, ImageFormat, DataType, std::size_t)
+*/
+LLGL_EXPORT void ConvertImageBuffer(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    const void* srcBuffer,
+    std::size_t srcBufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    void*       dstBuffer,
+    std::size_t dstBufferSize,
+    std::size_t threadCount = 0
+);
+
+/**
+\brief Converts the image format and data type of the specified image in place (only uncompressed color formats).
+\param[in] srcFormat Specifies the source image format.
+\param[in] srcDataType Specifies the source data type.
+\param[in,out] buffer Pointer to the image buffer which is to be converted. The converted image is written into the same buffer.
+\param[in] bufferSize Specifies the size (in bytes) of the image buffer.
+\param[in] dstFormat Specifies the destination image format.
+\param[in] dstDataType Specifies the destination data type.
+\param[in] threadCount Specifies the number of threads to use for conversion. By default 0.
+\remarks This is only allowed for conversions which preserve the size of each pixel,
+e.g. ImageFormat::RGBA to ImageFormat::BGRA, or DataType::UInt8 to DataType::Int8.
+No memory is allocated unless both the format and the data type differ. If neither differs, this function returns immediately.
+\code
+// Swizzle an image from BGRA to RGBA without another allocation
+LLGL::ConvertImageBufferInPlace(
+    LLGL::ImageFormat::BGRA, LLGL::DataType::UInt8, image, imageSize,
+    LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8
+);
+\endcode
+\throw std::invalid_argument If the conversion changes the pixel size, if 'buffer' is a null pointer,
+or for the same reasons as the other variants of the ConvertImageBuffer function.
+*/
+LLGL_EXPORT void ConvertImageBufferInPlace(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    void*       buffer,
+    std::size_t bufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    std::size_t threadCount = 0
+);
+
+/**
+\brief Converts the image format and data type of the source image rows into the specified destination buffer (only uncompressed color formats).
+\param[in] srcFormat Specifies the source image format.
+\param[in] srcDataType Specifies the source data type.
+\param[in] srcBuffer Pointer to the first row of the source image buffer which is to be converted.
+\param[in] srcRowPitch Specifies the distance (in bytes) between two rows of the source image buffer.
+\param[in] dstFormat Specifies the destination image format.
+\param[in] dstDataType Specifies the destination data type.
+\param[out] dstBuffer Pointer to the first row of the destination image buffer, the converted image is written to.
+\param[in] dstRowPitch Specifies the distance (in bytes) between two rows of the destination image buffer.
+This is typically the row pitch of a mapped texture or an upload buffer with an aligned row pitch.
+\param[in] rowLength Specifies the number of image elements (i.e. pixels) per row.
+\param[in] numRows Specifies the number of rows to convert.
+\param[in] threadCount Specifies the number of threads to use for conversion. By default 0.
+\remarks Rows are converted separately if either of the row pitches is larger than the tightly packed row size,
+i.e. the padding between the rows of the destination buffer is left untouched.
+\throw std::invalid_argument If either of the row pitches is too small,
+if 'dstBuffer' is a null pointer, or for the same reasons as the other variants of this function.
+*/
+LLGL_EXPORT void ConvertImageBuffer(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    const void* srcBuffer,
+    std::size_t srcRowPitch,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    void*       dstBuffer,
+    std::size_t dstRowPitch,
+    std::size_t rowLength,
+    std::size_t numRows,
+    std::size_t threadCount = 0
+);
+
+/**
+\brief Converts the image format, data type, and color space of the source image into the specified destination buffer (only uncompressed color formats).
+\param[in] srcColorSpace Specifies the color space of the source image.
+\param[in] dstColorSpace Specifies the color space of the destination image.
+\remarks All other parameters are equivalent to the other variants of this function.
+If both color spaces are equal, this is equivalent to the variant without color spaces.
+Otherwise, the sRGB transfer function is applied to all color components except alpha.
+Images are decoded from and encoded into 8-bit sRGB with lookup tables (encoding rounds to the nearest value),
+and all other conversions use an intermediate floating-point image.
+\code
+// Decode 8-bit sRGB image into 16-bit floating-point linear image, e.g. for an HDR render target
+LLGL::ConvertImageBuffer(
+    LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   LLGL::ColorSpace::SRGB,   srcImage, srcImageSize,
+    LLGL::ImageFormat::RGBA, LLGL::DataType::Float16, LLGL::ColorSpace::Linear, dstImage, dstImageSize
+);
+\endcode
+\throw std::invalid_argument For the same reasons as the other variants of this function.
+*/
+LLGL_EXPORT void ConvertImageBuffer(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    ColorSpace  srcColorSpace,
+    const void* srcBuffer,
+    std::size_t srcBufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    ColorSpace  dstColorSpace,
+    void*       dstBuffer,
+    std::size_t dstBufferSize,
+    std::size_t threadCount = 0
+);
+
+/**
+\brief Resamples the specified 2D image to another size on the CPU (only uncompressed color formats).
+\param[in] format Specifies the image format of both the source and destination image.
+\param[in] dataType Specifies the data type of both the source and destination image.
+\param[in] srcBuffer Pointer to the source image buffer.
+\param[in] srcWidth Specifies the width of the source image.
+\param[in] srcHeight Specifies the height of the source image.
+\param[out] dstBuffer Pointer to the destination image buffer, the resampled image is written to.
+\param[in] dstBufferSize Specifies the size (in bytes) of the destination image buffer.
+\param[in] dstWidth Specifies the width of the destination image.
+\param[in] dstHeight Specifies the height of the destination image.
+\param[in] filter Specifies the resampling filter. By default ResampleFilter::Bilinear.
+\param[in] sRGB Specifies whether the color components are in sRGB space. If true, all components except alpha are filtered in linear space. By default false.
+\param[in] threadCount Specifies the number of threads to use for filtering. By default 0.
+\remarks The filter is separable, i.e. the image is filtered horizontally and then vertically in a floating-point image,
+which is converted from and into the actual data type with the same conversion functions as ConvertImageBuffer.
+Texels outside the source image are clamped to the edge.
+\code
+// Create a thumbnail of a texture image
+std::vector<std::uint8_t> thumbnail(128 * 128 * 4);
+LLGL::ResampleImage(
+    LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,
+    imageData, imageWidth, imageHeight,
+    thumbnail.data(), thumbnail.size(), 128, 128,
+    LLGL::ResampleFilter::Lanczos, true
+);
+\endcode
+\throw std::invalid_argument If any of the sizes is zero, if the destination buffer size is too small,
+if 'dstBuffer' is a null pointer, or for the same reasons as the ConvertImageBuffer function.
+*/
+LLGL_EXPORT void ResampleImage(
+    ImageFormat             format,
+    DataType                dataType,
+    const void*             srcBuffer,
+    unsigned int            srcWidth,
+    unsigned int            srcHeight,
+    void*                   dstBuffer,
+    std::size_t             dstBufferSize,
+    unsigned int            dstWidth,
+    unsigned int            dstHeight,
+    const ResampleFilter    filter      = ResampleFilter::Bilinear,
+    bool                    sRGB        = false,
+    std::size_t             threadCount = 0
+);
+
+/**
+\brief Resamples the specified 2D image to another size on the CPU (only uncompressed color formats).
+\return Byte buffer with the resampled image, which has the same format and data type as the source image.
+\remarks All parameters are equivalent to the other variant of this function.
+\see ResampleImage(ImageFormat, DataType, const void*, unsigned int, unsigned int, void*, std::size_t, unsigned int, unsigned int, const ResampleFilter, bool, std::size_t)
+*/
+LLGL_EXPORT ByteBuffer ResampleImage(
+    ImageFormat             format,
+    DataType                dataType,
+    const void*             srcBuffer,
+    unsigned int            srcWidth,
+    unsigned int            srcHeight,
+    unsigned int            dstWidth,
+    unsigned int            dstHeight,
+    const ResampleFilter    filter      = ResampleFilter::Bilinear,
+    bool                    sRGB        = false,
+    std::size_t             threadCount = 0
+);
+
+/**
+\brief Generates all MIP-map levels of the specified 2D image on the CPU (only uncompressed color formats).
+\param[in] format Specifies the image format.
+\param[in] dataType Specifies the image data type.
+\param[in] buffer Pointer to the image buffer of the base MIP-map level.
+\param[in] width Specifies the width of the base MIP-map level.
+\param[in] height Specifies the height of the base MIP-map level.
+\param[in] filter Specifies the MIP-map filter. By default MipMapFilter::Box.
+\param[in] sRGB Specifies whether the color components are in sRGB space. If true, all components except alpha are filtered in linear space,
+which avoids the darkening of MIP-map levels that results from filtering gamma-corrected colors. By default false.
+\param[in] threadCount Specifies the number of threads to use for filtering. By default 0.
+\return List of byte buffers for all MIP-map levels after the base level, i.e. the first entry is the MIP-map level 1.
+Each buffer has the same format and data type as the base level, and the size of a MIP-map level is half the size of the previous level (but at least 1).
+\remarks The MIP-map levels can be written to a texture with "RenderSystem::WriteTexture" instead of generating them on the GPU with "RenderSystem::GenerateMips":
+\code
+auto mipLevels = LLGL::GenerateMipMaps(LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, imageData, width, height, LLGL::MipMapFilter::Kaiser, true);
+for (unsigned int i = 1; i <= mipLevels.size(); ++i)
+{
+    LLGL::SubTextureDescriptor subTextureDesc;
+    subTextureDesc.mipLevel         = i;
+    subTextureDesc.texture2D.width  = std::max(1u, width >> i);
+    subTextureDesc.texture2D.height = std::max(1u, height >> i);
+    renderer->WriteTexture(*texture, subTextureDesc, { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, mipLevels[i - 1].get() });
+}
+\endcode
+\throw std::invalid_argument If the width or height is zero, or for the same reasons as the ConvertImageBuffer function.
+\see NumMipLevels
+*/
+LLGL_EXPORT std::vector<ByteBuffer> GenerateMipMaps(
+    ImageFormat         format,
+    DataType            dataType,
+    const void*         buffer,
+    unsigned int        width,
+    unsigned int        height,
+    const MipMapFilter  filter      = MipMapFilter::Box,
+    bool                sRGB        = false,
+    std::size_t         threadCount = 0
+);
+
 
 } // /namespace LLGL
 
@@ -12,13 +12,29 @@
 #include <LLGL/Window.h>
 #include <LLGL/Types.h>
 #include <array>
+#include <vector>
 #include <string>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+/**
+\brief Raw mouse motion sample structure.
+\see Input::GetMouseMotionSamples
+*/
+struct MouseMotionSample
+{
+    //! Relative mouse motion of this sample, independent of the screen resolution and pointer acceleration.
+    Point           motion;
+
+    //! Time (in nanoseconds of a monotonic clock) when this sample has arrived. \see Window::GetEventTimestamp
+    std::uint64_t   timestamp   = 0;
+};
+
+
 class LLGL_EXPORT Input : public Window::EventListener
 {
 
@@ -47,12 +63,23 @@ class LLGL_EXPORT Input : public Window::EventListener
             return mousePosition_;
         }
 
-        //! Returns the global mouse motion.
+        //! Returns the global mouse motion, i.e. the sum of all raw mouse motion samples of the previous event processing.
         inline const Point& GetMouseMotion() const
         {
             return mouseMotion_;
         }
 
+        /**
+        \brief Returns all raw mouse motion samples of the previous event processing in the order they have arrived.
+        \remarks The samples are not coalesced, so mice with a high polling rate (e.g. 1000 Hz) are fully represented,
+        and sub-frame camera motion can be reconstructed from the timestamps.
+        The samples are taken from Win32 raw input (WM_INPUT) and XInput2 raw motion events (if LLGL was built with XInput2).
+        */
+        inline const std::vector<MouseMotionSample>& GetMouseMotionSamples() const
+        {
+            return mouseMotionSamples_;
+        }
+
         //! Returns the mouse wheel motion.
         inline int GetWheelMotion() const
         {
@@ -101,23 +128,24 @@ class LLGL_EXPORT Input : public Window::EventListener
         void OnLocalMotion(Window& sender, const Point& position) override;
         void OnGlobalMotion(Window& sender, const Point& motion) override;
 
-        KeyStateArray       keyPressed_;
-        KeyStateArray       keyDown_;
-        KeyStateArray       keyUp_;
+        KeyStateArray                   keyPressed_;
+        KeyStateArray                   keyDown_;
+        KeyStateArray                   keyUp_;
 
-        Point               mousePosition_;
-        Point               mouseMotion_;
+        Point                           mousePosition_;
+        Point                           mouseMotion_;
+        std::vector<MouseMotionSample>  mouseMotionSamples_;
 
-        int                 wheelMotion_    = 0;
+        int                             wheelMotion_    = 0;
 
-        KeyTracker          keyDownTracker_;
-        KeyTracker          keyUpTracker_;
+        KeyTracker                      keyDownTracker_;
+        KeyTracker                      keyUpTracker_;
 
-        std::array<bool, 3> doubleClick_;
+        std::array<bool, 3>             doubleClick_;
 
-        std::wstring        chars_;
+        std::wstring                    chars_;
 
-        std::size_t         anyKeyCount_    = 0;
+        std::size_t                     anyKeyCount_    = 0;
 
 };
 
@@ -0,0 +1,182 @@
+/*
+ * InstanceStream.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_INSTANCE_STREAM_H
+#define LLGL_INSTANCE_STREAM_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "CommandBuffer.h"
+#include "Image.h"
+#include <vector>
+#include <map>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Instance stream descriptor structure.
+\see InstanceStream
+*/
+struct InstanceStreamDescriptor
+{
+    /**
+    \brief Specifies the vertex format of the per-instance attributes.
+    \remarks The attributes of this format should have a non-zero instance divisor, and the stride of this format specifies the size of each instance.
+    \see VertexAttribute::instanceDivisor
+    */
+    VertexFormat    format;
+
+    //! Specifies the maximal number of instances that can be appended per frame. By default 4096.
+    std::uint32_t   maxInstances    = 4096;
+
+    /**
+    \brief Specifies the number of instance buffers the stream cycles through. By default 3.
+    \remarks This should be at least the number of frames the GPU can lag behind the CPU,
+    so the instance buffer of the current frame is never written while the GPU still reads from it.
+    */
+    std::uint32_t   numFrames       = 3;
+};
+
+/**
+\brief Instance range structure.
+\remarks This describes a contiguous range of instances within the instance buffer of the current frame.
+\see InstanceStream::Append
+*/
+struct InstanceRange
+{
+    //! Zero-based index of the first instance. This is passed as 'instanceOffset' to the draw commands.
+    std::uint32_t firstInstance = 0;
+
+    //! Number of instances. This is 0 if the instances could not be appended.
+    std::uint32_t numInstances  = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Streaming front-end for per-instance vertex data, which is rebuilt every frame.
+\remarks Instances can be appended from any thread without locks. Each append reserves a contiguous range
+of the CPU-side staging memory with a single atomic operation. The render thread then uploads all appended
+instances into the instance buffer of the current frame with "Upload", and draws each range with
+the respective instance offset, so all ranges of a frame share a single instance buffer.
+\code
+// Any thread
+auto range = instanceStream.Append(treeInstances.data(), numTrees);
+
+// Render thread (once all appending threads are done)
+instanceStream.Upload();
+commands->SetVertexBufferArray(instanceStream.GetBufferArray(*treeVertexBuffer));
+commands->SetIndexBuffer(*treeIndexBuffer);
+instanceStream.DrawIndexed(*commands, range, numTreeIndices);
+...
+instanceStream.NextFrame();
+\endcode
+\note Instance offsets require OpenGL 4.2 (or GL_ARB_base_instance), or any version of Direct3D.
+*/
+class LLGL_EXPORT InstanceStream
+{
+
+    public:
+
+        InstanceStream(const InstanceStream&) = delete;
+        InstanceStream& operator = (const InstanceStream&) = delete;
+
+        /**
+        \brief Initializes the instance stream and creates its instance buffers with the specified render system.
+        \throw std::invalid_argument If the stride of the instance format, the maximal number of instances, or the number of frames is 0.
+        */
+        InstanceStream(RenderSystem& renderSystem, const InstanceStreamDescriptor& desc);
+
+        //! Releases the instance buffers and all buffer arrays that have been created by this instance stream.
+        ~InstanceStream();
+
+        /**
+        \brief Appends the specified instances to the current frame.
+        \param[in] instances Pointer to the instance data, whose layout must match the instance format of this stream.
+        \param[in] numInstances Specifies the number of instances.
+        \return Range of the appended instances. If the instances exceed the maximal number of instances per frame, the returned range is empty.
+        \remarks This function is thread safe and lock-free, but it must not be called concurrently with "Upload" or "NextFrame".
+        */
+        InstanceRange Append(const void* instances, std::uint32_t numInstances);
+
+        /**
+        \brief Uploads all instances that have been appended since the last upload into the instance buffer of the current frame.
+        \remarks This must be called on the thread the render system is used with, before the instances are drawn.
+        All threads that append instances must have been synchronized with the calling thread.
+        */
+        void Upload();
+
+        /**
+        \brief Switches to the instance buffer of the next frame and discards all appended instances.
+        \remarks Call this once per frame after all instances of the current frame have been drawn.
+        */
+        void NextFrame();
+
+        /**
+        \brief Returns the buffer array of the specified vertex buffer and the instance buffer of the current frame.
+        \remarks The buffer arrays are created on first use for each vertex buffer and kept until "ReleaseBufferArrays" is called.
+        The instance format must therefore use the input slot after the format of the vertex buffer.
+        \see CommandBuffer::SetVertexBufferArray
+        */
+        BufferArray& GetBufferArray(Buffer& vertexBuffer);
+
+        /**
+        \brief Releases the buffer arrays of the specified vertex buffer.
+        \remarks Call this function before the vertex buffer is released.
+        */
+        void ReleaseBufferArrays(Buffer& vertexBuffer);
+
+        //! Records a non-indexed instanced draw command for the specified instance range. Empty ranges are ignored.
+        void Draw(CommandBuffer& commandBuffer, const InstanceRange& range, unsigned int numVertices, unsigned int firstVertex = 0);
+
+        //! Records an indexed instanced draw command for the specified instance range. Empty ranges are ignored.
+        void DrawIndexed(CommandBuffer& commandBuffer, const InstanceRange& range, unsigned int numIndices, unsigned int firstIndex = 0, int vertexOffset = 0);
+
+        //! Returns the instance buffer of the current frame.
+        inline Buffer& GetInstanceBuffer() const
+        {
+            return *instanceBuffers_[frame_];
+        }
+
+        //! Returns the number of instances that have been appended to the current frame. This function is thread safe.
+        std::uint32_t GetNumInstances() const;
+
+    private:
+
+        RenderSystem&                               renderSystem_;
+        InstanceStreamDescriptor                    desc_;
+
+        ByteBuffer                                  staging_;
+        std::atomic<std::uint32_t>                  numAppended_    { 0 };
+        std::uint32_t                               numUploaded_    = 0;
+
+        std::vector<Buffer*>                        instanceBuffers_;
+        std::uint32_t                               frame_          = 0;
+
+        std::map<Buffer*, std::vector<BufferArray*>> bufferArrays_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
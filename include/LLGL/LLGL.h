@@ -18,6 +18,7 @@
 #include "ColorRGBA.h"
 #include "Desktop.h"
 #include "Version.h"
+#include "Allocator.h"
 
 
 //DOXYGEN MAIN PAGE
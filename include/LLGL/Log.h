@@ -11,6 +11,10 @@
 
 #include "Export.h"
 #include <ostream>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 
 
 namespace LLGL
@@ -20,10 +24,24 @@ namespace Log
 {
 
 
-//! Sets the standard output stream. By default std::cout.
+//! Log message severity enumeration.
+enum class Severity
+{
+    Info,       //!< Informational message, which is written to the standard output stream.
+    Warning,    //!< Warning message, which is written to the standard output stream for error and warning messages.
+    Error,      //!< Error message, which is written to the standard output stream for error and warning messages.
+};
+
+/**
+\brief Sets the standard output stream. By default std::cout.
+\remarks All messages that have been posted so far are written before the stream is replaced.
+*/
 LLGL_EXPORT void SetStdOut(std::ostream& stream);
 
-//! Sets the standard output stream for error and warning messages. By default std::cerr.
+/**
+\brief Sets the standard output stream for error and warning messages. By default std::cerr.
+\remarks All messages that have been posted so far are written before the stream is replaced.
+*/
 LLGL_EXPORT void SetStdErr(std::ostream& stream);
 
 //! Returns the standard output stream.
@@ -32,6 +50,55 @@ LLGL_EXPORT std::ostream& StdOut();
 //! Returns the standard output stream for error and warning messages.
 LLGL_EXPORT std::ostream& StdErr();
 
+//! Sets the minimal severity of the messages that are posted. Messages with a lower severity are discarded. By default Severity::Info.
+LLGL_EXPORT void SetMinSeverity(const Severity severity);
+
+/**
+\brief Returns true if messages with the specified severity are posted.
+\remarks Check this before an expensive message is formatted, so discarded messages cost no more than this call.
+*/
+LLGL_EXPORT bool IsEnabled(const Severity severity);
+
+/**
+\brief Posts the specified message to the asynchronous logger.
+\remarks The message is written as a single line by a background thread, so the calling thread never waits for console I/O.
+This function is thread safe and lock-free; the messages of each thread are written in the order they have been posted.
+Messages of type Severity::Info are written to the standard output stream, all others to the stream for error and warning messages.
+\see SetRateLimit
+*/
+LLGL_EXPORT void Post(const Severity severity, const std::string& message);
+
+//! Blocks until all messages, which have been posted so far, have been written and the output streams are flushed.
+LLGL_EXPORT void Flush();
+
+/**
+\brief Sets the rate limit for repeating messages.
+\param[in] maxRepeats Specifies the maximal number of identical messages that are written within each interval.
+Further repetitions are only counted and reported once the interval has elapsed. If this is 0, the rate limit is disabled. By default 8.
+\param[in] intervalMs Specifies the length of the interval (in milliseconds). By default 1000.
+*/
+LLGL_EXPORT void SetRateLimit(std::size_t maxRepeats, std::uint32_t intervalMs = 1000);
+
+/**
+\brief Writes all pending messages and stops the background thread of the asynchronous logger.
+\remarks The thread is started again with the next posted message. This is called when the last render system is unloaded (see RenderSystem::Unload).
+Call this before the application exits or unloads the library, if messages are posted without a render system,
+since the logger thread is never joined during static destruction.
+*/
+LLGL_EXPORT void Shutdown();
+
+//! Callback function interface for errors that are reported instead of thrown.
+using ErrorCallback = std::function<void(const std::string& message)>;
+
+/**
+\brief Sets the callback for errors of the renderer hot paths (e.g. failed buffer mappings), if LLGL is built without exceptions.
+\remarks If LLGL is built with the CMake option \c LLGL_ENABLE_EXCEPTIONS disabled, the hot paths return with an error code
+(e.g. a null pointer for a failed mapping) and pass the error message to this callback, instead of throwing an std::runtime_error.
+If no callback is set, these errors are posted with Severity::Error. To collect them with a RenderingDebugger, call RenderingDebugger::PostError inside the callback.
+The callback can be invoked by any thread that calls into the render system. This has no effect if LLGL is built with exceptions (default).
+*/
+LLGL_EXPORT void SetErrorCallback(const ErrorCallback& callback);
+
 
 } // /namespace Log
 
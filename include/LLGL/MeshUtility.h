@@ -0,0 +1,192 @@
+/*
+ * MeshUtility.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MESH_UTILITY_H
+#define LLGL_MESH_UTILITY_H
+
+#ifdef LLGL_ENABLE_UTILITY
+
+/*
+THIS HEADER MUST BE EXPLICITLY INCLUDED
+*/
+
+#include "Export.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Meshlet (i.e. a small cluster of triangles) for mesh shaders, which is generated by BuildMeshlets.
+\remarks The layout of this structure is suitable for a structured storage buffer with a stride of 48 bytes.
+\see BuildMeshlets
+*/
+struct Meshlet
+{
+    //! Index of the first vertex index of this meshlet within the meshlet vertices.
+    std::uint32_t   vertexOffset;
+
+    //! Index of the first local index of this meshlet within the meshlet triangles, i.e. three local indices per triangle.
+    std::uint32_t   triangleOffset;
+
+    //! Number of unique vertices of this meshlet.
+    std::uint32_t   numVertices;
+
+    //! Number of triangles of this meshlet.
+    std::uint32_t   numTriangles;
+
+    //! Center of the bounding sphere of this meshlet.
+    float           center[3];
+
+    //! Radius of the bounding sphere of this meshlet.
+    float           radius;
+
+    //! Normalized axis of the normal cone of this meshlet, i.e. the average direction its triangles face.
+    float           coneAxis[3];
+
+    /**
+    \brief Cutoff of the normal cone for backface culling of the entire meshlet, or 1 if the meshlet must never be culled.
+    \remarks The meshlet can be culled for a camera at position \c P, if <code>dot(center - P, coneAxis) >= coneCutoff * length(center - P) + radius</code>.
+    */
+    float           coneCutoff;
+};
+
+/**
+\defgroup group_mesh_util Mesh optimization utility functions for indexed triangle lists.
+\remarks These functions only reorder the triangles and vertices of a mesh, they never change its appearance.
+A typical order is: OptimizeVertexCache, OptimizeOverdraw, OptimizeVertexFetch, and finally NarrowIndices.
+Functions that process independent elements run on the shared thread pool of the render system, if there is one.
+\addtogroup group_mesh_util
+@{
+*/
+
+/**
+\brief Reorders the triangles of the specified triangle list for the post-transform vertex cache.
+\param[in,out] indices Pointer to the triangle list indices, which are reordered in place.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3; trailing indices of an incomplete triangle are left unchanged.
+\param[in] numVertices Specifies the number of vertices. All indices must be less than this value.
+\param[in] cacheSize Specifies the number of vertices the vertex cache is optimized for. By default 16.
+\remarks This uses the "Tipsify" algorithm (Sander, Nehab, and Barczak 2007), which runs in linear time
+and also produces triangle clusters that can be reordered with OptimizeOverdraw.
+*/
+LLGL_EXPORT void OptimizeVertexCache(
+    std::uint32_t*  indices,
+    std::size_t     numIndices,
+    std::size_t     numVertices,
+    std::size_t     cacheSize   = 16
+);
+
+/**
+\brief Reorders clusters of triangles of the specified triangle list to reduce overdraw, while the vertex cache efficiency is mostly kept.
+\param[in,out] indices Pointer to the triangle list indices, which should already be optimized with OptimizeVertexCache.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3; trailing indices of an incomplete triangle are left unchanged.
+\param[in] vertexPositions Pointer to the first vertex position, which is read as three floats.
+\param[in] numVertices Specifies the number of vertices. All indices must be less than this value.
+\param[in] vertexStride Specifies the stride (in bytes) between consecutive vertex positions.
+\param[in] cacheSize Specifies the number of vertices of the vertex cache. This should be the same as for OptimizeVertexCache. By default 16.
+\param[in] threshold Specifies how much the average cache miss ratio of a cluster may exceed the one of the input order,
+to split the input into more (and smaller) clusters. By default 1.05.
+\remarks The clusters are sorted by how much they face outwards of the mesh (Sander, Nehab, and Barczak 2007),
+so the outer clusters, which are more likely to occlude the others, are drawn first.
+*/
+LLGL_EXPORT void OptimizeOverdraw(
+    std::uint32_t*  indices,
+    std::size_t     numIndices,
+    const float*    vertexPositions,
+    std::size_t     numVertices,
+    std::size_t     vertexStride,
+    std::size_t     cacheSize   = 16,
+    float           threshold   = 1.05f
+);
+
+/**
+\brief Reorders the vertices in the order they are referenced by the specified triangle list, and remaps the indices accordingly.
+\param[in,out] vertices Pointer to the vertices, which are reordered in place.
+\param[in] numVertices Specifies the number of vertices.
+\param[in] vertexStride Specifies the stride (in bytes) between consecutive vertices.
+\param[in,out] indices Pointer to the indices, which are remapped in place.
+\param[in] numIndices Specifies the number of indices.
+\return Number of vertices that are referenced by the indices. Unreferenced vertices are moved to the end.
+\remarks This improves the locality of the vertex fetch, which should be the last reordering of a mesh.
+*/
+LLGL_EXPORT std::size_t OptimizeVertexFetch(
+    void*           vertices,
+    std::size_t     numVertices,
+    std::size_t     vertexStride,
+    std::uint32_t*  indices,
+    std::size_t     numIndices
+);
+
+/**
+\brief Converts the specified 32-bit indices into 16-bit indices, if all of them are small enough.
+\param[in] srcIndices Pointer to the 32-bit source indices.
+\param[in] numIndices Specifies the number of indices.
+\param[out] dstIndices Pointer to the 16-bit destination indices. This is only written to, if the function succeeds.
+\return True if all indices are less than or equal to 0xFFFF and have been converted. In this case, the index buffer can be created
+with the 16-bit index format, i.e. IndexFormat(DataType::UInt16).
+*/
+LLGL_EXPORT bool NarrowIndices(
+    const std::uint32_t*    srcIndices,
+    std::size_t             numIndices,
+    std::uint16_t*          dstIndices
+);
+
+/**
+\brief Splits the specified triangle list into meshlets for mesh shaders.
+\param[out] meshlets Specifies the output container for the meshlets. Previous entries are cleared.
+\param[out] meshletVertices Specifies the output container for the vertex indices of all meshlets.
+Each meshlet refers to the range [vertexOffset, vertexOffset + numVertices) of this container.
+\param[out] meshletTriangles Specifies the output container for the local indices of all meshlet triangles.
+Each meshlet refers to the range [triangleOffset, triangleOffset + numTriangles*3) of this container, whose entries index into the vertices of that meshlet.
+\param[in] indices Pointer to the triangle list indices, which should already be optimized with OptimizeVertexCache.
+\param[in] numIndices Specifies the number of indices. This must be a multiple of 3.
+\param[in] vertexPositions Pointer to the first vertex position, which is read as three floats.
+\param[in] numVertices Specifies the number of vertices. All indices must be less than this value.
+\param[in] vertexStride Specifies the stride (in bytes) between consecutive vertex positions.
+\param[in] maxVertices Specifies the maximum number of vertices per meshlet. This must be in the range [3, 256]. By default 64.
+\param[in] maxTriangles Specifies the maximum number of triangles per meshlet. This must be in the range [1, 512]. By default 124.
+\return Number of generated meshlets.
+\remarks The triangles are assigned to the meshlets in the order of the triangle list, so the meshlets are only as local as the input order.
+The defaults match the output limits that are recommended for most hardware. The bounding sphere and normal cone of each meshlet
+are meant for culling entire meshlets in an amplification shader.
+\throw std::invalid_argument If 'maxVertices' or 'maxTriangles' is out of range.
+\see CommandBuffer::DrawMeshTasks
+*/
+LLGL_EXPORT std::size_t BuildMeshlets(
+    std::vector<Meshlet>&       meshlets,
+    std::vector<std::uint32_t>& meshletVertices,
+    std::vector<std::uint8_t>&  meshletTriangles,
+    const std::uint32_t*        indices,
+    std::size_t                 numIndices,
+    const float*                vertexPositions,
+    std::size_t                 numVertices,
+    std::size_t                 vertexStride,
+    std::size_t                 maxVertices     = 64,
+    std::size_t                 maxTriangles    = 124
+);
+
+/** @} */
+
+
+} // /namespace LLGL
+
+
+#else
+
+#error LLGL was not compiled with LLGL_ENABLE_UTILITY option
+
+#endif
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,191 @@
+/*
+ * OcclusionCuller.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_OCCLUSION_CULLER_H
+#define LLGL_OCCLUSION_CULLER_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "CommandBuffer.h"
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Occlusion culler descriptor structure.
+\see OcclusionCuller
+*/
+struct OcclusionCullerDescriptor
+{
+    //! Specifies the maximal number of objects. Object IDs must be in the range [0, maxObjects). By default 1024.
+    std::uint32_t       maxObjects          = 1024;
+
+    /**
+    \brief Specifies the number of query sets the culler cycles through. By default 3.
+    \remarks This should be at least the number of frames the GPU can lag behind the CPU,
+    so the query results of a frame are usually available when its query set is reused.
+    */
+    std::uint32_t       numFrames           = 3;
+
+    /**
+    \brief Specifies the type of the occlusion queries. By default QueryType::AnySamplesPassed.
+    \remarks This must be QueryType::SamplesPassed, QueryType::AnySamplesPassed, or QueryType::AnySamplesPassedConservative.
+    */
+    QueryType           queryType           = QueryType::AnySamplesPassed;
+
+    /**
+    \brief Specifies the render condition mode for objects that have been occluded. By default RenderConditionMode::NoWait.
+    \remarks With RenderConditionMode::NoWait, the GPU may draw an object before the occlusion query of its proxy is complete,
+    which is conservative but never stalls the GPU.
+    */
+    RenderConditionMode conditionMode       = RenderConditionMode::NoWait;
+
+    /**
+    \brief Specifies the interval (in frames) in which visible objects are tested again. By default 4.
+    \remarks The tests are staggered by the object IDs, so only a fraction of the visible objects is tested each frame.
+    Occluded objects are tested every frame.
+    */
+    std::uint32_t       visibleTestInterval = 4;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Front-end for occlusion culling with conditional rendering, which manages the occlusion state of many objects across frames.
+\remarks The occlusion query results are polled without blocking, and each object reuses its most recent result:
+- Objects that have been visible are drawn directly. Every few frames their draw call is wrapped into an occlusion query,
+  to detect when they become occluded (see OcclusionCullerDescriptor::visibleTestInterval).
+- Objects that have been occluded are tested with a proxy (e.g. their bounding box) within an occlusion query,
+  and the object itself is drawn with this query as render condition. The GPU thus skips the object while it is still occluded,
+  and draws it in the same frame it becomes visible, without any CPU readback stall.
+- Objects without any available result are treated as visible.
+\code
+LLGL::OcclusionCuller culler(*renderer, *commands, cullerDesc);
+
+// Render loop
+culler.BeginFrame();
+for (std::uint32_t i = 0; i < numBuildings; ++i)
+{
+    culler.Draw(
+        i,
+        [&]() { DrawBoundingBox(buildings[i]); }, // Pipeline without color and depth writes
+        [&]() { DrawBuilding(buildings[i]); }
+    );
+}
+culler.EndFrame();
+\endcode
+\note The callbacks must not issue other occlusion queries or render conditions.
+*/
+class LLGL_EXPORT OcclusionCuller
+{
+
+    public:
+
+        //! Callback interface to record the draw commands of a proxy or an object.
+        using DrawCallback = std::function<void()>;
+
+        OcclusionCuller(const OcclusionCuller&) = delete;
+        OcclusionCuller& operator = (const OcclusionCuller&) = delete;
+
+        /**
+        \brief Initializes the occlusion culler and creates its queries.
+        \param[in] renderSystem Specifies the render system, which is used to create the occlusion queries.
+        \param[in] commandBuffer Specifies the command buffer, which is used to record the queries and render conditions and to retrieve the query results.
+        \param[in] desc Specifies the occlusion culler descriptor.
+        \throw std::invalid_argument If the maximal number of objects or the number of frames is 0, or if the query type is not an occlusion query.
+        \throw std::runtime_error If the render system does not support occlusion queries.
+        */
+        OcclusionCuller(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const OcclusionCullerDescriptor& desc = {});
+
+        //! Releases all queries.
+        ~OcclusionCuller();
+
+        /**
+        \brief Begins a new frame and resolves the query results of all previous frames, that are available, without blocking.
+        \throw std::runtime_error If the previous frame has not been ended.
+        */
+        void BeginFrame();
+
+        /**
+        \brief Ends the current frame.
+        \throw std::runtime_error If no frame has been begun.
+        */
+        void EndFrame();
+
+        /**
+        \brief Draws the specified object with occlusion culling.
+        \param[in] object Specifies the ID of the object. Each object must only be drawn once per frame.
+        \param[in] drawProxy Specifies the callback that draws the proxy of the object, e.g. its bounding box.
+        The proxy should be drawn without color and depth writes, and it must cover the object entirely.
+        \param[in] drawObject Specifies the callback that draws the object itself.
+        \remarks If all queries of the current frame are in use, the object is drawn without occlusion culling.
+        \throw std::runtime_error If no frame has been begun.
+        \throw std::out_of_range If 'object' is not less than the maximal number of objects.
+        */
+        void Draw(std::uint32_t object, const DrawCallback& drawProxy, const DrawCallback& drawObject);
+
+        //! Returns true if the most recent query result of the specified object says it is visible, or if there is no result yet.
+        bool IsVisible(std::uint32_t object) const;
+
+        //! Returns the number of objects whose draw commands were recorded under a render condition in the current (or last) frame.
+        inline std::uint32_t GetNumConditionalDraws() const
+        {
+            return numConditionalDraws_;
+        }
+
+    private:
+
+        struct ObjectState
+        {
+            bool            visible     = true;
+            std::uint64_t   resultFrame = 0;
+        };
+
+        struct QuerySet
+        {
+            std::vector<Query*>         queries;
+            QueryArray*                 queryArray  = nullptr;
+            std::vector<std::uint32_t>  objects;
+            std::uint64_t               frameIndex  = 0;
+        };
+
+        Query* NextQuery(std::uint32_t object);
+
+        bool ResolveQuerySet(QuerySet& querySet);
+
+        RenderSystem&               renderSystem_;
+        CommandBuffer&              commandBuffer_;
+        OcclusionCullerDescriptor   desc_;
+
+        std::vector<ObjectState>    objects_;
+        std::vector<QuerySet>       querySets_;
+        std::vector<std::uint64_t>  results_;
+
+        bool                        insideFrame_            = false;
+        std::uint64_t               frameIndex_             = 0;
+        std::uint32_t               numConditionalDraws_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
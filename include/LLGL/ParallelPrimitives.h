@@ -0,0 +1,240 @@
+/*
+ * ParallelPrimitives.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PARALLEL_PRIMITIVES_H
+#define LLGL_PARALLEL_PRIMITIVES_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "CommandBuffer.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Parallel primitives descriptor structure.
+\see ParallelPrimitives
+*/
+struct ParallelPrimitivesDescriptor
+{
+    /**
+    \brief Specifies the maximal number of elements of each operation. By default 1048576.
+    \remarks The scratch buffers of the scan levels and of the radix sort are allocated for this number of elements.
+    */
+    std::uint32_t   maxElements     = (1u << 20);
+
+    /**
+    \brief Specifies the number of threads of each thread group of the built-in compute shaders. By default 0.
+    \remarks If this is 0, the thread group size is derived from RenderingCaps::waveSize, i.e. 8 waves per thread group,
+    but at least 64 and at most 256 threads. If the wave size is unknown, 256 threads are used.
+    Otherwise, this must be in the range [16, 256] and should be a multiple of the wave size.
+    Each thread processes 4 elements, so each thread group processes a block of 4 times the thread group size.
+    */
+    std::uint32_t   threadGroupSize = 0;
+
+    /**
+    \brief Specifies whether the compute shader for ParallelPrimitives::SortKeyValues is created. By default false.
+    \remarks This compute shader binds 5 storage buffers, which exceeds the minimum of OpenGLES 3.1.
+    */
+    bool            keyValueSort    = false;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Library of parallel primitives on the GPU: exclusive prefix sum, stream compaction, and radix sort of 32-bit unsigned integers.
+\remarks GPU-driven rendering (e.g. visibility culling, particle sorting, or order-independent transparency) builds upon these primitives,
+so they are provided with built-in compute shaders, which are tuned to the wave size of the GPU (see RenderingCaps::waveSize).
+All operations are recorded into the command buffer of this instance and operate on storage buffers only, so the data never leaves video memory.
+All buffers must be storage buffers of type StorageBufferType::RWStructuredBuffer with a stride of 4 bytes (i.e. 'uint' elements),
+and the operations always start at the first element of each buffer. Each compute pass is followed by a storage buffer barrier,
+so the results can be read by subsequent shaders; other uses (e.g. as indirect arguments) require another barrier (see CommandBuffer::Barrier).
+\code
+LLGL::ParallelPrimitivesDescriptor primitivesDesc;
+{
+    primitivesDesc.maxElements  = maxInstances;
+    primitivesDesc.keyValueSort = true;
+}
+LLGL::ParallelPrimitives primitives(*renderer, *commands, primitivesDesc);
+
+// Compact the indices of all visible instances into 'visibleInstances' and write their number into 'visibleCount[0]'
+primitives.Compact(*visibilityFlags, *instanceIndices, *visibleInstances, numInstances, *visibleCount);
+
+// Sort particle indices back-to-front, i.e. by their inverted depth keys
+primitives.SortKeyValues(*depthKeys, *particleIndices, numParticles);
+\endcode
+\note The parameters of each operation are written into constant buffers when the operation is recorded,
+so each of the functions ExclusiveScan, Compact, and Sort/SortKeyValues must be recorded at most once per command buffer submission.
+\note Only supported with: OpenGL 4.3, OpenGLES 3.1, Direct3D 11, Direct3D 12.
+*/
+class LLGL_EXPORT ParallelPrimitives
+{
+
+    public:
+
+        ParallelPrimitives(const ParallelPrimitives&) = delete;
+        ParallelPrimitives& operator = (const ParallelPrimitives&) = delete;
+
+        /**
+        \brief Creates the built-in compute pipelines, the constant buffers, and the scratch buffers.
+        \param[in] renderSystem Specifies the render system, which is used to create and write the resources.
+        \param[in] commandBuffer Specifies the command buffer, which records the compute passes.
+        \param[in] desc Specifies the parallel primitives descriptor.
+        \throw std::invalid_argument If the maximal number of elements is zero, if the thread group size is out of range,
+        or if the maximal number of elements requires more thread groups than a single dispatch command supports.
+        \throw std::runtime_error If the render system does not support compute shaders and storage buffers,
+        if the shading language of the render system is not supported, or if the built-in shaders failed to compile.
+        */
+        ParallelPrimitives(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const ParallelPrimitivesDescriptor& desc = {});
+
+        //! Releases all resources.
+        ~ParallelPrimitives();
+
+        /**
+        \brief Records the exclusive prefix sum of the source buffer into the destination buffer.
+        \param[in] srcBuffer Specifies the source buffer with at least 'numElements' elements.
+        \param[in] dstBuffer Specifies the destination buffer with at least 'numElements' elements. This must not be the source buffer.
+        \param[in] numElements Specifies the number of elements.
+        \remarks The destination element i is the sum of the source elements 0 to i-1, i.e. the first destination element is 0.
+        \throw std::out_of_range If the number of elements exceeds the maximal number of elements.
+        */
+        void ExclusiveScan(Buffer& srcBuffer, Buffer& dstBuffer, std::uint32_t numElements);
+
+        /**
+        \brief Records the stream compaction of the source buffer into the destination buffer.
+        \param[in] flagsBuffer Specifies the buffer with one flag per element. All elements with a non-zero flag are kept.
+        This can be the source buffer itself, to keep all non-zero elements.
+        \param[in] srcBuffer Specifies the source buffer with at least 'numElements' elements.
+        \param[in] dstBuffer Specifies the destination buffer, which receives the kept elements in their original order. This must not be the source buffer.
+        \param[in] numElements Specifies the number of elements.
+        \param[in] countBuffer Specifies the buffer, which receives the number of kept elements, e.g. to be copied into the arguments of an indirect draw command.
+        \param[in] countIndex Specifies the index of the element within the count buffer, which receives the number of kept elements. By default 0.
+        \throw std::out_of_range If the number of elements exceeds the maximal number of elements.
+        */
+        void Compact(
+            Buffer&         flagsBuffer,
+            Buffer&         srcBuffer,
+            Buffer&         dstBuffer,
+            std::uint32_t   numElements,
+            Buffer&         countBuffer,
+            std::uint32_t   countIndex  = 0
+        );
+
+        /**
+        \brief Records the stable radix sort of the keys in ascending order.
+        \param[in] keysBuffer Specifies the buffer with the keys, which are sorted in place.
+        \param[in] numElements Specifies the number of keys.
+        \param[in] keyBits Specifies the number of low-order bits of each key that are sorted. By default 32.
+        Each pass sorts 4 bits, so sorting 16-bit keys (e.g. quantized depth values) takes half the passes of 32-bit keys.
+        \throw std::out_of_range If the number of elements exceeds the maximal number of elements.
+        \throw std::invalid_argument If the number of key bits is 0 or greater than 32.
+        */
+        void Sort(Buffer& keysBuffer, std::uint32_t numElements, std::uint32_t keyBits = 32);
+
+        /**
+        \brief Records the stable radix sort of the keys in ascending order, and reorders the values in the same way.
+        \param[in] keysBuffer Specifies the buffer with the keys, which are sorted in place.
+        \param[in] valuesBuffer Specifies the buffer with one value per key (e.g. an index), which is reordered in place.
+        \param[in] numElements Specifies the number of keys and values.
+        \param[in] keyBits Specifies the number of low-order bits of each key that are sorted. By default 32.
+        \throw std::out_of_range If the number of elements exceeds the maximal number of elements.
+        \throw std::invalid_argument If the number of key bits is 0 or greater than 32.
+        \throw std::runtime_error If ParallelPrimitivesDescriptor::keyValueSort was false.
+        */
+        void SortKeyValues(Buffer& keysBuffer, Buffer& valuesBuffer, std::uint32_t numElements, std::uint32_t keyBits = 32);
+
+        //! Returns the number of threads of each thread group of the built-in compute shaders.
+        inline std::uint32_t GetThreadGroupSize() const
+        {
+            return threadGroupSize_;
+        }
+
+        //! Returns the descriptor of this parallel primitives library.
+        inline const ParallelPrimitivesDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+    private:
+
+        enum Kernel
+        {
+            KernelScanBlocks = 0,
+            KernelAddOffsets,
+            KernelCompact,
+            KernelSortHistogram,
+            KernelSortScatter,
+            KernelSortScatterKeyValues,
+            KernelCount,
+        };
+
+        // Block sums of each level of the hierarchical scan.
+        struct ScanLevel
+        {
+            Buffer* blockSums       = nullptr;  // Sum of each block of this level
+            Buffer* scannedSums     = nullptr;  // Exclusive prefix sum of the block sums, i.e. the input of the next level
+        };
+
+        void CreateKernels();
+        void CreateBuffers();
+
+        Buffer* CreateStorageBuffer(std::uint32_t numElements);
+        Buffer* CreateConstantBuffer();
+
+        void RecordScan(
+            Buffer&         srcBuffer,
+            Buffer&         dstBuffer,
+            std::uint32_t   numElements,
+            bool            predicate,
+            std::uint32_t   countIndex,
+            Buffer* const*  paramBuffers
+        );
+        void RecordSort(Buffer& keysBuffer, Buffer* valuesBuffer, std::uint32_t numElements, std::uint32_t keyBits);
+
+        void Dispatch(Kernel kernel, Buffer& paramBuffer, std::uint32_t numBlocks, Buffer* const* storageBuffers, std::uint32_t numStorageBuffers);
+
+        std::uint32_t NumBlocks(std::uint32_t numElements) const;
+
+        RenderSystem&                   renderSystem_;
+        CommandBuffer&                  commandBuffer_;
+        ParallelPrimitivesDescriptor    desc_;
+        std::uint32_t                   threadGroupSize_    = 0;
+
+        std::vector<Shader*>            shaders_;
+        ShaderProgram*                  shaderPrograms_[KernelCount]    = {};
+        ComputePipeline*                pipelines_[KernelCount]         = {};
+
+        std::vector<ScanLevel>          scanLevels_;
+        std::vector<Buffer*>            scanParams_;
+        std::vector<Buffer*>            compactParams_;
+        std::vector<Buffer*>            sortParams_;
+
+        Buffer*                         compactIndices_     = nullptr;
+        Buffer*                         sortHistogram_      = nullptr;
+        Buffer*                         sortOffsets_        = nullptr;
+        Buffer*                         sortKeys_           = nullptr;
+        Buffer*                         sortValues_         = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
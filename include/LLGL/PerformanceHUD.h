@@ -0,0 +1,181 @@
+/*
+ * PerformanceHUD.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PERFORMANCE_HUD_H
+#define LLGL_PERFORMANCE_HUD_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "RenderingProfiler.h"
+#include "GPUProfiler.h"
+#include "ColorRGBA.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Performance HUD descriptor structure.
+\see PerformanceHUD::PerformanceHUD
+*/
+struct PerformanceHUDDescriptor
+{
+    //! Specifies the X coordinate (in pixels) of the upper-left corner of the overlay. By default 8.
+    unsigned int    x               = 8;
+
+    //! Specifies the Y coordinate (in pixels) of the upper-left corner of the overlay. By default 8.
+    unsigned int    y               = 8;
+
+    //! Specifies the size (in pixels) of each pixel of the built-in 3x5 font. By default 2.
+    unsigned int    scale           = 2;
+
+    /**
+    \brief Specifies the maximal number of vertices per frame. By default 32768.
+    \remarks If the overlay requires more vertices, the remaining elements are not drawn.
+    */
+    unsigned int    maxVertices     = 32768;
+
+    /**
+    \brief Specifies the number of frames the vertex ring buffer is partitioned into. By default 3.
+    \remarks Each frame writes its vertices into the next partition, so the vertices of previous frames, which might still be in flight on the GPU, are not overwritten.
+    */
+    unsigned int    numFrames       = 3;
+
+    //! Specifies the number of samples of the render context the overlay is drawn into. By default 1.
+    unsigned int    samples         = 1;
+
+    //! Specifies the frame time (in milliseconds) at the top of the frame-time graph. By default 50.
+    float           graphMaxTime    = 50.0f;
+
+    //! Specifies the maximal number of top-level GPU scopes that are listed. By default 8.
+    unsigned int    maxGPUScopes    = 8;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Performance HUD, which draws an overlay with frame-time graph, draw and binding counts, GPU scope timings, and memory usage.
+\remarks All elements are generated as colored triangles (including the text of the built-in font) into a vertex ring buffer,
+so the overlay is drawn with a single graphics pipeline, a single vertex buffer binding, and a single draw call.
+The frame-time graph and the counters are taken from the frame history of a RenderingProfiler (see RenderingProfiler::NextFrame),
+the GPU timings from the most recent GPUProfilerFrame, and the memory usage from RenderSystem::QueryMemoryInfo.
+\code
+LLGL::PerformanceHUD hud(*renderer, *context);
+hud.SetRenderingProfiler(&profiler);
+
+// Render loop
+profiler.NextFrame(timer->GetDeltaTime());
+if (gpuProfiler.HasResolvedFrame())
+    hud.SetGPUFrame(gpuProfiler.GetResolvedFrame());
+commands->SetRenderTarget(*context);
+// render scene ...
+hud.Draw(*commands);
+context->Present();
+\endcode
+\note The draw call of the overlay itself is also counted by the rendering profiler.
+*/
+class LLGL_EXPORT PerformanceHUD
+{
+
+    public:
+
+        PerformanceHUD(const PerformanceHUD&) = delete;
+        PerformanceHUD& operator = (const PerformanceHUD&) = delete;
+
+        /**
+        \brief Initializes the performance HUD and creates its shader program, graphics pipeline, and vertex ring buffer.
+        \param[in] renderSystem Specifies the render system, which is used to create the resources and to query the memory usage.
+        \param[in] renderContext Specifies the render context the overlay is drawn into. Its resolution is read for every frame.
+        \param[in] desc Specifies the performance HUD descriptor.
+        \throw std::invalid_argument If the scale, the maximal number of vertices, or the number of frames is 0.
+        \throw std::runtime_error If the shading language of the render system is not supported, or if the built-in shaders failed to compile.
+        */
+        PerformanceHUD(RenderSystem& renderSystem, RenderContext& renderContext, const PerformanceHUDDescriptor& desc = {});
+
+        //! Releases all resources.
+        ~PerformanceHUD();
+
+        /**
+        \brief Sets the rendering profiler whose frame history is displayed. By default null.
+        \remarks If this is null, the frame-time graph and the counters are omitted.
+        */
+        void SetRenderingProfiler(const RenderingProfiler* profiler);
+
+        //! Stores the timings of the specified GPU profiler frame, which are displayed until the next frame is set.
+        void SetGPUFrame(const GPUProfilerFrame& frame);
+
+        /**
+        \brief Generates the overlay and records its draw command into the specified command buffer.
+        \remarks The render context must already be set as render target (see CommandBuffer::SetRenderTarget(RenderContext&)).
+        This sets the viewport to the entire render context and binds the graphics pipeline and vertex buffer of the overlay,
+        so these states must be set again before other draw commands are recorded.
+        */
+        void Draw(CommandBuffer& commandBuffer);
+
+        //! Returns the number of vertices that have been generated by the last call to "Draw".
+        inline unsigned int GetNumVertices() const
+        {
+            return static_cast<unsigned int>(vertices_.size());
+        }
+
+    private:
+
+        struct Vertex
+        {
+            float           position[2];
+            ColorRGBAub     color;
+        };
+
+        void CreateShaderProgram();
+        void CreateGraphicsPipeline();
+        void CreateVertexBuffer();
+
+        void BuildOverlay();
+        void BuildFrameTimeGraph(float x, float& y);
+
+        void AddRect(float x, float y, float width, float height, const ColorRGBAub& color);
+        void WriteRect(Vertex* vertices, float x, float y, float width, float height, const ColorRGBAub& color);
+        void AddText(float x, float& y, const std::string& text, const ColorRGBAub& color);
+
+        RenderSystem&               renderSystem_;
+        RenderContext&              renderContext_;
+        PerformanceHUDDescriptor    desc_;
+
+        VertexFormat                vertexFormat_;
+        ShaderProgram*              shaderProgram_      = nullptr;
+        std::vector<Shader*>        shaders_;
+        GraphicsPipeline*           graphicsPipeline_   = nullptr;
+        Buffer*                     vertexBuffer_       = nullptr;
+
+        const RenderingProfiler*    profiler_           = nullptr;
+        GPUProfilerFrame            gpuFrame_;
+        bool                        hasGPUFrame_        = false;
+
+        std::vector<Vertex>         vertices_;
+        float                       pixelToNDC_[2]      = { 0.0f, 0.0f };
+        float                       panelWidth_         = 0.0f;
+        std::uint64_t               frameIndex_         = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,161 @@
+/*
+ * PipelineManifest.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PIPELINE_MANIFEST_H
+#define LLGL_PIPELINE_MANIFEST_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <future>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+//! Statistics of a pipeline manifest.
+struct PipelineManifestStatistics
+{
+    //! Number of pipelines that have been created on first use, i.e. the pipelines that were missing in the loaded manifest.
+    std::uint64_t numCreated        = 0;
+
+    //! Number of pipelines that have been pre-created from the loaded manifest.
+    std::uint64_t numWarmedUp       = 0;
+
+    //! Number of pipeline requests that were served without creating a pipeline.
+    std::uint64_t numHits           = 0;
+
+    //! Number of pipelines whose pre-creation failed. These pipelines are created again on first use.
+    std::uint64_t numFailed         = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Manifest of the graphics pipelines that have been used, to pre-create them during the next run of the application.
+\remarks Even with a pipeline cache (see RenderSystem::LoadPipelineCache), the pipelines are only created when they are used for the first time,
+which causes hitches when new pipelines are required (e.g. when the player enters a new area). This manifest records the state of all graphics pipelines
+that are requested with GetGraphicsPipeline, so the next run of the application can pre-create exactly these pipelines in the background,
+e.g. while the loading screen is shown (see Save and Load). Equal pipeline states are only created once and shared between all requests.
+Shader programs are identified by their names, which must be unique and should change whenever their shaders change (e.g. by appending a hash of their source),
+since pipelines of unknown programs are skipped, but pipelines of renamed programs would be created with a stale state.
+\code
+LLGL::PipelineManifest manifest(*renderer);
+
+manifest.AddShaderProgram("Scene", *sceneProgram);
+manifest.AddShaderProgram("Shadow", *shadowProgram);
+manifest.Load(ReadFile("Pipelines.bin")); // Pre-creates the pipelines used in the previous run
+
+while (manifest.GetNumPendingPipelines() > 0)
+    DrawLoadingScreen();
+
+auto pipeline = manifest.GetGraphicsPipeline(pipelineDesc);
+// ...
+
+WriteFile("Pipelines.bin", manifest.Save());
+\endcode
+\note The pipelines are pre-created with RenderSystem::CreateGraphicsPipelineAsync,
+i.e. only Direct3D 11 and Direct3D 12 create them on worker threads, while all other render systems create them immediately within Load.
+*/
+class LLGL_EXPORT PipelineManifest
+{
+
+    public:
+
+        PipelineManifest(const PipelineManifest&) = delete;
+        PipelineManifest& operator = (const PipelineManifest&) = delete;
+
+        //! Initializes the manifest for the specified render system, which is used to create and release the pipelines.
+        PipelineManifest(RenderSystem& renderSystem);
+
+        //! Waits for all pending pipelines and releases all pipelines of this manifest.
+        ~PipelineManifest();
+
+        /**
+        \brief Adds a shader program under the specified name.
+        \remarks Pipelines of the loaded manifest, which refer to this name, are pre-created immediately.
+        The shader program must stay alive as long as this manifest is used.
+        \throw std::invalid_argument If a shader program with the same name, or the same shader program under another name, has already been added.
+        */
+        void AddShaderProgram(const std::string& name, ShaderProgram& shaderProgram);
+
+        /**
+        \brief Returns the graphics pipeline for the specified descriptor and records it in the manifest.
+        \remarks The pipeline is created on first use. If it is still being pre-created, this function waits for its creation.
+        The pipeline remains valid until this manifest is destroyed or cleared.
+        \throw std::invalid_argument If the shader program of the descriptor has not been added to this manifest.
+        */
+        GraphicsPipeline* GetGraphicsPipeline(const GraphicsPipelineDescriptor& desc);
+
+        /**
+        \brief Pre-creates all pipelines of the specified serialized manifest (see Save).
+        \remarks Entries of shader programs that have not been added yet, are pre-created as soon as their shader program is added.
+        Entries of shader programs that are never added, are ignored but kept in the manifest.
+        \return True if the data is valid (an empty container is also valid). Otherwise, the data was not serialized with "Save".
+        */
+        bool Load(const std::vector<char>& data);
+
+        //! Serializes the manifest of all pipelines that have been used so far (including the loaded ones).
+        std::vector<char> Save() const;
+
+        /**
+        \brief Returns the number of pipelines that are still being pre-created.
+        \remarks This does not wait for any pipeline, so it can be used to show the progress of a loading screen.
+        */
+        std::size_t GetNumPendingPipelines() const;
+
+        //! Waits until all pending pipelines have been created.
+        void WaitForPendingPipelines();
+
+        //! Waits for all pending pipelines and releases all pipelines and the recorded entries. The shader programs remain.
+        void Clear();
+
+        //! Returns the statistics of this manifest.
+        inline const PipelineManifestStatistics& GetStatistics() const
+        {
+            return stats_;
+        }
+
+    private:
+
+        struct Entry
+        {
+            std::string                             programName;
+            std::vector<char>                       state;                  // Serialized pipeline state without the shader program.
+            GraphicsPipeline*                       pipeline    = nullptr;
+            std::shared_future<GraphicsPipeline*>   pending;                // Valid while the pipeline is being pre-created.
+        };
+
+        void WarmUp(Entry& entry);
+        void ResolveEntry(Entry& entry);
+
+        RenderSystem&                           renderSystem_;
+
+        std::map<std::string, ShaderProgram*>   programs_;
+        std::map<std::string, Entry>            entries_;       // Entries by program name and serialized pipeline state.
+
+        PipelineManifestStatistics              stats_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
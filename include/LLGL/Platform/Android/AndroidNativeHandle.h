@@ -0,0 +1,57 @@
+/*
+ * AndroidNativeHandle.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ANDROID_NATIVE_HANDLE_H
+#define LLGL_ANDROID_NATIVE_HANDLE_H
+
+
+#include <LLGL/Export.h>
+#include <android/native_window.h>
+
+
+namespace LLGL
+{
+
+
+//! Android native handle structure.
+struct NativeHandle
+{
+    ANativeWindow* window;
+};
+
+//! Android native context handle structure.
+struct NativeContextHandle
+{
+    ANativeWindow* window;
+};
+
+namespace Android
+{
+
+
+/**
+\brief Sets the native window of the activity, which is used by Canvas::Create and Canvas::Recreate.
+\remarks This must be called whenever the activity has (re-)created its window, e.g. for the APP_CMD_INIT_WINDOW command of the native app glue,
+and with null when the window is about to be destroyed (APP_CMD_TERM_WINDOW).
+*/
+LLGL_EXPORT void SetNativeWindow(ANativeWindow* window);
+
+//! Returns the native window of the activity, or null if there is currently no window.
+LLGL_EXPORT ANativeWindow* GetNativeWindow();
+
+
+} // /namespace Android
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
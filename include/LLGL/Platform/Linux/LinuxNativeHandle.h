@@ -13,16 +13,25 @@
 #include <X11/Xutil.h>
 
 
+struct wl_display;
+struct wl_surface;
+
 namespace LLGL
 {
 
 
-//! Linux native handle structure.
+/**
+\brief Linux native handle structure.
+\remarks Either the X11 members or the Wayland members are specified, depending on whether the window is an X11 or a Wayland window.
+Wayland windows are only available if LLGL has been built with the CMake option \c LLGL_ENABLE_WAYLAND and the \c WAYLAND_DISPLAY environment variable is set.
+*/
 struct NativeHandle
 {
     ::Display*      display;
     ::Window        window;
     ::XVisualInfo*  visual;
+    ::wl_display*   wlDisplay;  //!< Wayland display connection, or null for an X11 window.
+    ::wl_surface*   wlSurface;  //!< Wayland surface of the window, or null for an X11 window.
 };
 
 //! Linux native context handle structure.
@@ -0,0 +1,74 @@
+/*
+ * QueryArray.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_QUERY_ARRAY_H
+#define LLGL_QUERY_ARRAY_H
+
+
+#include "Export.h"
+#include "QueryFlags.h"
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Query array interface.
+\remarks A query array groups several queries of the same type, whose results can be retrieved with a single call.
+\see RenderSystem::CreateQueryArray
+\see CommandBuffer::QueryResult(QueryArray&, unsigned int, unsigned int, std::uint64_t*)
+\see CommandBuffer::ResolveQueryData
+*/
+class LLGL_EXPORT QueryArray
+{
+
+    public:
+
+        QueryArray(const QueryArray&) = delete;
+        QueryArray& operator = (const QueryArray&) = delete;
+
+        virtual ~QueryArray()
+        {
+        }
+
+        //! Returns the type of all queries in this array.
+        inline QueryType GetType() const
+        {
+            return type_;
+        }
+
+        //! Returns the number of queries in this array.
+        inline unsigned int GetNumQueries() const
+        {
+            return numQueries_;
+        }
+
+    protected:
+
+        QueryArray(const QueryType type, unsigned int numQueries) :
+            type_       { type       },
+            numQueries_ { numQueries }
+        {
+        }
+
+    private:
+
+        QueryType       type_;
+        unsigned int    numQueries_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -9,6 +9,9 @@
 #define LLGL_QUERY_FLAGS_H
 
 
+#include <cstdint>
+
+
 namespace LLGL
 {
 
@@ -21,6 +24,15 @@ enum class QueryType
     AnySamplesPassedConservative,       //!< Non-zero if any samples passed the depth test within a conservative rasterization. This can be used as render condition.
     PrimitivesGenerated,                //!< Number of generated primitives which are send to the rasterizer (either emitted from the geometry or vertex shader).
     TimeElapsed,                        //!< Elapsed time (in nanoseconds) between the begin- and end query command.
+
+    /**
+    \brief GPU timestamp (in nanoseconds), which is written when all previous commands have been completed.
+    \remarks This query is only ended with "CommandBuffer::EndQuery", i.e. "CommandBuffer::BeginQuery" must not be called.
+    In contrast to TimeElapsed, timestamp queries can be used for nested and overlapping time ranges.
+    Only the difference between two timestamps is meaningful.
+    */
+    Timestamp,
+
     StreamOutPrimitivesWritten,         //!< Number of vertices that have been written into a stream output (also called "Transform Feedback").
     StreamOutOverflow,                  //!< Non-zero if any of the streaming output buffers (also called "Transform Feedback Buffers") has an overflow.
     VerticesSubmitted,                  //!< Number of vertices submitted to the input-assembly.
@@ -34,6 +46,14 @@ enum class QueryType
     GeometryPrimitivesGenerated,        //!< Number of primitives generated by the geometry shader.
     ClippingInputPrimitives,            //!< Number of primitives that reached the primitive clipping stage.
     ClippingOutputPrimitives,           //!< Number of primitives that passed the primitive clipping stage.
+
+    /**
+    \brief All pipeline statistics at once, i.e. all counters from PrimitivesGenerated to ClippingOutputPrimitives.
+    \remarks The result of this query can only be retrieved with "CommandBuffer::QueryPipelineStatisticsResult".
+    \note For OpenGL, this requires GL_ARB_pipeline_statistics_query.
+    \see QueryPipelineStatistics
+    */
+    PipelineStatistics,
 };
 
 
@@ -59,6 +79,28 @@ struct QueryDescriptor
     bool        renderCondition = false;
 };
 
+/**
+\brief Pipeline statistics query result structure.
+\remarks Each member corresponds to the query type of the same name.
+\see QueryType::PipelineStatistics
+\see CommandBuffer::QueryPipelineStatisticsResult
+*/
+struct QueryPipelineStatistics
+{
+    std::uint64_t numPrimitivesGenerated                = 0; //!< Number of generated primitives which are send to the rasterizer.
+    std::uint64_t numVerticesSubmitted                  = 0; //!< Number of vertices submitted to the input-assembly.
+    std::uint64_t numPrimitivesSubmitted                = 0; //!< Number of primitives submitted to the input-assembly.
+    std::uint64_t numVertexShaderInvocations            = 0; //!< Number of vertex shader invocations.
+    std::uint64_t numTessControlShaderInvocations       = 0; //!< Number of tessellation-control shader invocations.
+    std::uint64_t numTessEvaluationShaderInvocations    = 0; //!< Number of tessellation-evaluation shader invocations.
+    std::uint64_t numGeometryShaderInvocations          = 0; //!< Number of geometry shader invocations.
+    std::uint64_t numFragmentShaderInvocations          = 0; //!< Number of fragment shader invocations.
+    std::uint64_t numComputeShaderInvocations           = 0; //!< Number of compute shader invocations.
+    std::uint64_t numGeometryPrimitivesGenerated        = 0; //!< Number of primitives generated by the geometry shader.
+    std::uint64_t numClippingInputPrimitives            = 0; //!< Number of primitives that reached the primitive clipping stage.
+    std::uint64_t numClippingOutputPrimitives           = 0; //!< Number of primitives that passed the primitive clipping stage.
+};
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,86 @@
+/*
+ * Readback.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_READBACK_H
+#define LLGL_READBACK_H
+
+
+#include "Export.h"
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Asynchronous readback interface.
+\remarks A readback refers to a copy of GPU resource data (from a texture or buffer) into CPU accessible memory,
+which is scheduled by the render system without waiting for the GPU to finish.
+Poll the readback with "IsReady" (e.g. once per frame) and retrieve the data with "ReadData" as soon as it is ready.
+\code
+auto readback = renderSystem->ReadTextureAsync(*texture, 0, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8);
+// ...
+if (readback->IsReady())
+{
+    std::vector<LLGL::ColorRGBAub> image(readback->GetDataSize() / sizeof(LLGL::ColorRGBAub));
+    readback->ReadData(image.data(), readback->GetDataSize());
+    renderSystem->Release(*readback);
+}
+\endcode
+\see RenderSystem::ReadTextureAsync
+\see RenderSystem::ReadBufferAsync
+*/
+class LLGL_EXPORT Readback
+{
+
+    public:
+
+        Readback(const Readback&) = delete;
+        Readback& operator = (const Readback&) = delete;
+
+        virtual ~Readback();
+
+        /**
+        \brief Returns true if the GPU has finished copying the data into CPU accessible memory.
+        \remarks This function never blocks.
+        */
+        virtual bool IsReady() = 0;
+
+        /**
+        \brief Copies the read back data into the specified output buffer.
+        \param[out] buffer Specifies the output buffer. This must not be null.
+        \param[in] bufferSize Specifies the size (in bytes) of the output buffer. At most "GetDataSize()" bytes are copied.
+        \remarks If the readback is not ready yet, this function blocks until the GPU has finished copying the data.
+        */
+        virtual void ReadData(void* buffer, std::size_t bufferSize) = 0;
+
+        //! Returns the size (in bytes) of the data this readback refers to.
+        inline std::size_t GetDataSize() const
+        {
+            return dataSize_;
+        }
+
+    protected:
+
+        Readback(std::size_t dataSize);
+
+    private:
+
+        std::size_t dataSize_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -28,6 +28,7 @@
 
 #include <Gauss/Vector3.h>
 #include <string>
+#include <chrono>
 #include <map>
 
 
@@ -54,7 +55,82 @@ class LLGL_EXPORT RenderContext
         //! Presents the back buffer on this render context.
         virtual void Present() = 0;
 
-        //! Returns the surface which is used to present the content on the screen.
+        /**
+        \brief Presents the back buffer on this render context without waiting for the vertical blank, regardless of the Vsync configuration.
+        \remarks This is used by RenderSystem::PresentAll for all but the first render context of a batch.
+        With Direct3D, tearing is only allowed if Vsync is disabled for this render context,
+        so the desktop window manager still composes the presentation with the next vertical blank in windowed mode.
+        The default implementation calls Present.
+        \see RenderSystem::PresentAll
+        */
+        virtual void PresentWithoutVsync();
+
+        /**
+        \brief Blocks the calling thread until the swap chain of this render context is ready to render the next frame.
+        \remarks Call this function at the beginning of each frame, before the user input is sampled,
+        to keep the latency between input and presentation as low as possible.
+        This waits for the frame latency waitable object if the render context was created with a non-zero frame latency,
+        for the time slot of the next frame if a target frame rate is set, and for the next vertical blank if Vsync is enabled with the OpenGL renderer
+        (requires "WGL_OML_sync_control" or "GLX_OML_sync_control"). Otherwise, it returns immediately.
+        \see RenderContextDescriptor::maxFrameLatency
+        \see SetTargetFrameRate
+        */
+        virtual void WaitForNextFrame();
+
+        /**
+        \brief Queries the presentation statistics of this render context.
+        \param[out] stats Specifies the output statistics of the frames that have been presented so far.
+        \return True if the statistics could be queried. Otherwise, the renderer does not support presentation statistics
+        (e.g. OpenGL without "WGL_OML_sync_control" or "GLX_OML_sync_control", or Direct3D with a blit model swap chain in windowed mode).
+        */
+        virtual bool QueryFrameStatistics(FrameStatistics& stats);
+
+        /**
+        \brief Returns true if the content of this render context is currently not visible on the screen.
+        \remarks With Direct3D, this is the occlusion status (DXGI_STATUS_OCCLUDED) of the last call to Present or TestPresent,
+        e.g. when the window is minimized, covered by a fullscreen window, or the screen is locked.
+        Otherwise, the render context is only reported as occluded while it is minimized.
+        While occluded, WaitForNextFrame paces the frames to the background frame rate (if non-zero).
+        \see IsMinimized
+        \see SetBackgroundFrameRate
+        */
+        virtual bool IsOccluded() const;
+
+        /**
+        \brief Returns true if the surface of this render context is currently minimized, i.e. its content area is empty.
+        \remarks This is used as occlusion status by default.
+        \see IsOccluded
+        */
+        bool IsMinimized() const;
+
+        /**
+        \brief Polls whether the content of this render context would be visible, without presenting the back buffer.
+        \return True if the content would be visible on the screen.
+        \remarks Use this while the render context is occluded to determine when to resume rendering at the full frame rate,
+        instead of rendering and presenting frames nobody can see. With Direct3D, this presents with DXGI_PRESENT_TEST
+        and updates the occlusion status. The default implementation returns the negated result of IsOccluded.
+        \see IsOccluded
+        */
+        virtual bool TestPresent();
+
+        /**
+        \brief Copies the current content of the back buffer into the first MIP-map level of the specified texture.
+        \param[in] dstTexture Specifies the destination texture. This must be a 2D texture with the format TextureFormat::RGBA8.
+        \remarks This must be called before the back buffer is presented. The copy is executed on the GPU without any CPU-side copies,
+        so the texture can be passed to a video encoder or converted by a compute shader afterwards.
+        Only the region that is covered by both the back buffer and the texture is copied.
+        A multi-sampled back buffer is resolved, in which case the texture must have the same size as the back buffer.
+        With OpenGL, the rows of the texture are in bottom-up order like all other OpenGL textures.
+        \throws std::runtime_error If the renderer does not support this function (i.e. Direct3D 12).
+        \see BackBufferCapture
+        */
+        virtual void CopyBackBuffer(Texture& dstTexture);
+
+        /**
+        \brief Returns the surface which is used to present the content on the screen.
+        \remarks For a headless render context, this surface is neither a Window nor a Canvas.
+        \see RenderContextDescriptor::headless
+        */
         inline Surface& GetSurface() const
         {
             return *surface_;
@@ -79,6 +155,36 @@ class LLGL_EXPORT RenderContext
             return videoModeDesc_;
         }
 
+        /**
+        \brief Sets the target frame rate (in frames per second) this render context is paced to. By default 0.
+        \remarks If this is non-zero, WaitForNextFrame blocks the calling thread until the time slot of the next frame begins,
+        so frames are delivered in even intervals also when Vsync is disabled. If this is 0, frames are not paced by the CPU.
+        \see WaitForNextFrame
+        */
+        virtual void SetTargetFrameRate(unsigned int frameRate);
+
+        //! Returns the target frame rate (in frames per second) of this render context, or 0 if frames are not paced.
+        inline unsigned int GetTargetFrameRate() const
+        {
+            return targetFrameRate_;
+        }
+
+        /**
+        \brief Sets the frame rate (in frames per second) this render context is throttled to while it is occluded. By default 0.
+        \remarks If this is non-zero, WaitForNextFrame paces the frames to this frame rate instead of the target frame rate while IsOccluded returns true,
+        so applications that are minimized or covered drop to a few frames per second and save CPU and GPU power.
+        If this is 0, frames are not throttled while the render context is occluded.
+        \see IsOccluded
+        \see WaitForNextFrame
+        */
+        virtual void SetBackgroundFrameRate(unsigned int frameRate);
+
+        //! Returns the frame rate (in frames per second) this render context is throttled to while it is occluded, or 0 if frames are not throttled.
+        inline unsigned int GetBackgroundFrameRate() const
+        {
+            return backgroundFrameRate_;
+        }
+
     protected:
 
         RenderContext() = default;
@@ -94,6 +200,13 @@ class LLGL_EXPORT RenderContext
         */
         void SetOrCreateSurface(const std::shared_ptr<Surface>& surface, VideoModeDescriptor& videoModeDesc, const void* windowContext);
 
+        /**
+        \brief Creates a surface without a native handle for a headless render context.
+        \param[in] videoModeDesc Specifies the video mode descriptor. Only the 'resolution' field is used.
+        \see RenderContextDescriptor::headless
+        */
+        void SetHeadlessSurface(const VideoModeDescriptor& videoModeDesc);
+
         /**
         \brief Shares the surface and video mode with another render context.
         \note This is only used by the renderer debug layer.
@@ -102,8 +215,12 @@ class LLGL_EXPORT RenderContext
 
     private:
 
-        std::shared_ptr<Surface>    surface_;
-        VideoModeDescriptor         videoModeDesc_;
+        std::shared_ptr<Surface>                surface_;
+        VideoModeDescriptor                     videoModeDesc_;
+
+        unsigned int                            targetFrameRate_        = 0;
+        unsigned int                            backgroundFrameRate_    = 0;
+        std::chrono::steady_clock::time_point   nextFrameTime_;
 
 };
 
@@ -13,6 +13,7 @@
 #include "Types.h"
 #include "GraphicsPipelineFlags.h"
 #include <functional>
+#include <cstdint>
 
 
 namespace LLGL
@@ -67,12 +68,35 @@ enum class SwapChainMode
 
 /* ----- Structures ----- */
 
-//! Vertical-synchronization (Vsync) descriptor structure.
+/**
+\brief Vertical-synchronization (Vsync) descriptor structure.
+\remarks If Vsync is disabled, the Direct3D renderers present with tearing allowed when the display supports it (e.g. variable refresh rate displays).
+*/
 struct VsyncDescriptor
 {
     bool            enabled     = false;    //!< Specifies whether vertical-synchronisation (Vsync) is enabled or disabled. By default disabled.
     unsigned int    refreshRate = 60;       //!< Refresh rate (in Hz). By default 60.
     unsigned int    interval    = 1;        //!< Synchronisation interval. Can be 1, 2, 3, or 4. If Vsync is disabled, this value is implicit zero.
+
+    /**
+    \brief Specifies whether a frame that missed its vertical blank is presented immediately (with tearing) instead of waiting for the next one. By default false.
+    \remarks This is also known as "adaptive Vsync" or "late swap tearing" and only has an effect if Vsync is enabled.
+    If the extension "WGL_EXT_swap_control_tear" or "GLX_EXT_swap_control_tear" is not supported, regular Vsync is used.
+    \note Only supported with: OpenGL.
+    */
+    bool            adaptive    = false;
+};
+
+/**
+\brief Frame presentation statistics structure.
+\remarks The counters are only comparable between two queries of the same render context.
+\see RenderContext::QueryFrameStatistics
+*/
+struct FrameStatistics
+{
+    std::uint64_t   presentCount        = 0;    //!< Number of frames that have been presented so far.
+    std::uint64_t   syncRefreshCount    = 0;    //!< Number of vertical blanks of the display at the time of 'syncTime'.
+    std::uint64_t   syncTime            = 0;    //!< Time stamp (in microseconds) of the last vertical blank.
 };
 
 //! Video mode descriptor structure.
@@ -104,6 +128,24 @@ struct ProfileOpenGLDescriptor
     \remarks This required 'coreProfile' to be enabled.
     */
     OpenGLVersion   version     = OpenGLVersion::OpenGL_Latest;
+
+    /**
+    \brief Specifies whether shader programs are built from separable single-stage programs. By default disabled.
+    \remarks If enabled (and 'GL_ARB_separate_shader_objects' is supported), each shader is linked only once into its own program,
+    and a shader program only combines the stages in a program pipeline object. This avoids re-linking a shader for every combination it is used in.
+    Uniforms and reflection queries of such a shader program refer to its first shader, and stream-outputs are not supported.
+    The option is determined when the first render context is created.
+    */
+    bool            separableShaders = false;
+
+    /**
+    \brief Specifies whether the context is created without error checking of the driver. By default disabled.
+    \remarks If enabled (and 'GL_KHR_no_error' is supported), the driver skips the validation of all GL calls,
+    which removes CPU overhead for release builds where the debug layer is disabled, but leaves invalid API usage undefined.
+    This requires 'extProfile' and 'coreProfile' to be enabled, and it is ignored in debug builds of LLGL and if a driver debugger is used.
+    \see RenderSystemDescriptor::driverDebugger
+    */
+    bool            noErrorContext  = false;
 };
 
 //! Render context descriptor structure.
@@ -114,6 +156,38 @@ struct RenderContextDescriptor
     VideoModeDescriptor     videoMode;      //!< Video mode descriptor.
     ProfileOpenGLDescriptor profileOpenGL;  //!< OpenGL profile descriptor (to switch between compatability or core profile).
     DebugCallback           debugCallback;  //!< Debuging callback descriptor.
+
+    /**
+    \brief Specifies the maximal number of frames the CPU can record ahead of the GPU. By default 2.
+    \remarks The CPU will only wait for the GPU when it is this number of frames ahead,
+    i.e. when a new frame would reuse the command allocator of a frame that is still in flight.
+    A value of 1 fully serializes CPU and GPU every frame. This is clamped to the range [1, 3].
+    \note Only supported with: Direct3D 12.
+    */
+    unsigned int            framesInFlight  = 2;
+
+    /**
+    \brief Specifies the maximal number of frames that can be queued for presentation. By default 0.
+    \remarks If this is 0, the default frame latency of the swap chain is used (which is 3 for DXGI).
+    Otherwise, RenderContext::WaitForNextFrame blocks until the number of queued frames is less than this value.
+    A value of 1 minimizes the input latency, since the input for a frame is then sampled right before it can be rendered.
+    \note Only supported with: Direct3D 11, Direct3D 12.
+    \see RenderContext::WaitForNextFrame
+    */
+    unsigned int            maxFrameLatency = 0;
+
+    /**
+    \brief Specifies whether the render context is created without a window, e.g. for display-less servers. By default false.
+    \remarks A headless render context has an offscreen back buffer with the resolution of 'videoMode',
+    which can be rendered into and read back like any other render target, but which is never presented on the screen.
+    RenderContext::Present only submits the pending commands, and the surface of the render context has no native handle.
+    Any surface passed to RenderSystem::CreateRenderContext is ignored.
+    For the OpenGL renderer on Linux, the context is created with EGL (if LLGL has been built with EGL support),
+    so no X server is required. On other platforms, the OpenGL renderer uses a window which is never shown.
+    All render contexts of an OpenGL render system must be either headless or not.
+    \note Only supported with: OpenGL, Direct3D 11, Direct3D 12.
+    */
+    bool                    headless        = false;
 };
 
 
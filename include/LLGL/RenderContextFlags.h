@@ -156,6 +156,7 @@ union GraphicsAPIDependentStateDescriptor
         stateOpenGL.invertFrontFace                 = false;
         stateOpenGL.logicOp                         = LogicOp::Keep;
         stateOpenGL.lineWidth                       = 0.0f;
+        stateOpenGL.explicitBarriers                = false;
 
         stateDirect3D12.disableAutoStateSubmission  = false;
     }
@@ -188,6 +189,16 @@ union GraphicsAPIDependentStateDescriptor
         \see https://www.opengl.org/sdk/docs/man/html/glLineWidth.xhtml
         */
         float       lineWidth;
+
+        /**
+        \brief Specifies whether memory barriers for compute shaders are only inserted explicitly. By default false.
+        \remarks If this is false, a full memory barrier (i.e. GL_ALL_BARRIER_BITS) is inserted after each compute dispatch.
+        If this is true, the client programmer must call "CommandBuffer::Barrier" or "CommandBuffer::StorageBarrier" where needed,
+        which avoids over-synchronization for chains of compute passes.
+        \see CommandBuffer::Barrier
+        \see https://www.opengl.org/sdk/docs/man/html/glMemoryBarrier.xhtml
+        */
+        bool        explicitBarriers;
     }
     stateOpenGL;
 
@@ -0,0 +1,424 @@
+/*
+ * RenderGraph.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_GRAPH_H
+#define LLGL_RENDER_GRAPH_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "CommandBuffer.h"
+#include "TransientTexturePool.h"
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Render graph pass type enumeration.
+\see RenderGraph::AddPass
+*/
+enum class RenderGraphPassType
+{
+    //! Pass with draw commands. Such a pass can write at most one render target.
+    Graphics,
+
+    /**
+    \brief Pass with compute commands only. Such a pass cannot write any render target.
+    \remarks Compute passes, which are independent of the graphics passes before them, are scheduled onto the async compute queue.
+    \see RenderGraph::RenderGraph
+    */
+    Compute,
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Handle to a resource of a render graph.
+\remarks Handles are only valid for the frame they have been created in, i.e. until the next call to RenderGraph::Execute.
+*/
+struct RenderGraphResource
+{
+    //! Invalid resource ID.
+    static const std::uint32_t invalidID = ~0u;
+
+    //! Returns true if this handle refers to a resource.
+    inline bool IsValid() const
+    {
+        return (id != invalidID);
+    }
+
+    //! Internal resource ID.
+    std::uint32_t id = invalidID;
+};
+
+
+/* ----- Classes ----- */
+
+class RenderGraph;
+
+/**
+\brief Interface to declare the resources a render graph pass creates, reads, and writes.
+\remarks An instance of this class is passed to the setup function of each pass.
+\see RenderGraph::AddPass
+*/
+class LLGL_EXPORT RenderGraphBuilder
+{
+
+    public:
+
+        RenderGraphBuilder(const RenderGraphBuilder&) = delete;
+        RenderGraphBuilder& operator = (const RenderGraphBuilder&) = delete;
+
+        /**
+        \brief Creates a transient texture, which is allocated from the texture pool of the render graph.
+        \remarks The texture is only allocated for the passes between its first and last access,
+        so transient textures with non-overlapping lifetimes share the same pool entries.
+        The contents of a transient texture are undefined until a pass writes to it.
+        \throw std::invalid_argument If the width or height of the descriptor is 0.
+        */
+        RenderGraphResource CreateTexture(const TransientTextureDescriptor& desc);
+
+        /**
+        \brief Declares that this pass reads the specified resource.
+        \param[in] resource Specifies the resource.
+        \param[in] barrierFlags Specifies how the resource is read. This is a bitwise OR combination of the BarrierFlags entries.
+        A barrier with these flags is only inserted before this pass, if a previous pass has written the resource as storage resource.
+        By default BarrierFlags::Texture.
+        \throw std::invalid_argument If the resource handle is invalid.
+        */
+        void Read(RenderGraphResource resource, long barrierFlags = BarrierFlags::Texture);
+
+        /**
+        \brief Declares that this pass writes the specified resource as storage buffer or read/write texture.
+        \throw std::invalid_argument If the resource handle is invalid or refers to a render target or render context.
+        */
+        void WriteStorage(RenderGraphResource resource);
+
+        /**
+        \brief Declares that this pass renders into the specified resource and preserves its previous contents.
+        \remarks The resource must be a transient texture, an imported render target, or an imported render context.
+        The render graph begins the render pass before the execute function of the pass is called,
+        and selects the load and store operations depending on which passes access the resource before and after this pass.
+        \throw std::invalid_argument If the resource handle is invalid, if this is not a graphics pass, or if the pass already writes a render target.
+        */
+        void WriteRenderTarget(RenderGraphResource resource);
+
+        /**
+        \brief Declares that this pass clears the specified resource and renders into it.
+        \param[in] resource Specifies the resource (see WriteRenderTarget).
+        \param[in] color Specifies the clear color for color attachments.
+        \param[in] depth Specifies the clear depth for depth-stencil attachments. By default 1.
+        \remarks Since the previous contents are not needed, passes which only wrote this resource before can be culled.
+        \see WriteRenderTarget
+        */
+        void ClearRenderTarget(RenderGraphResource resource, const ColorRGBAf& color = {}, float depth = 1.0f);
+
+        //! Declares that this pass has side effects outside of the render graph (e.g. a readback), so it is never culled.
+        void SetSideEffects();
+
+    protected:
+
+        friend class RenderGraph;
+
+        RenderGraphBuilder(RenderGraph& graph, std::uint32_t passIndex);
+
+    private:
+
+        RenderGraph&    graph_;
+        std::uint32_t   passIndex_  = 0;
+
+};
+
+/**
+\brief Interface to access the actual objects of render graph resources within the execute function of a pass.
+\see RenderGraph::AddPass
+*/
+class LLGL_EXPORT RenderGraphResources
+{
+
+    public:
+
+        RenderGraphResources(const RenderGraphResources&) = delete;
+        RenderGraphResources& operator = (const RenderGraphResources&) = delete;
+
+        /**
+        \brief Returns the texture of the specified transient or imported texture resource.
+        \throw std::invalid_argument If the resource is not a texture or has not been declared by the current pass.
+        */
+        Texture& GetTexture(RenderGraphResource resource) const;
+
+        /**
+        \brief Returns the buffer of the specified imported buffer resource.
+        \throw std::invalid_argument If the resource is not a buffer or has not been declared by the current pass.
+        */
+        Buffer& GetBuffer(RenderGraphResource resource) const;
+
+    protected:
+
+        friend class RenderGraph;
+
+        RenderGraphResources(const RenderGraph& graph, std::uint32_t passIndex);
+
+    private:
+
+        const RenderGraph&  graph_;
+        std::uint32_t       passIndex_  = 0;
+
+};
+
+/**
+\brief Frame graph, which orders and records the passes of a frame from their declared resource accesses.
+\remarks Instead of recording a hand-ordered sequence of render target switches, clears, and draw commands,
+each pass declares which resources it reads and writes, and the render graph derives everything else when it is executed:
+- Passes whose results are never used are culled. Only passes with side effects, passes writing imported resources,
+  and the passes they depend on are recorded.
+- Transient textures are acquired from a TransientTexturePool right before their first use and released right after their last use,
+  so textures with non-overlapping lifetimes alias the same pool entries.
+- Barriers are only inserted before passes that read or write a resource that has been written as storage resource before,
+  and all such barriers of a pass are merged into a single CommandBuffer::Barrier call.
+- The load and store operations of render passes are derived from the accesses before and after each pass,
+  e.g. the first write of a transient texture does not load its previous contents, and the last write is discarded if nothing reads it.
+- Compute passes, which neither read results of graphics passes nor write resources that preceding graphics passes access,
+  are recorded into an async compute command buffer. It is submitted after the graphics passes it can overlap with,
+  and before the first graphics pass that depends on it.
+
+The graph is rebuilt every frame: all passes and resources are declared anew and executed with a single call to "Execute".
+\code
+LLGL::RenderGraph graph(*renderer, texturePool);
+
+// Once per frame
+auto backBuffer = graph.ImportRenderContext(*context);
+LLGL::RenderGraphResource sceneColor;
+
+graph.AddPass(
+    "Scene", LLGL::RenderGraphPassType::Graphics,
+    [&](LLGL::RenderGraphBuilder& builder)
+    {
+        sceneColor = builder.CreateTexture({ resolution, LLGL::TextureFormat::RGBA16Float });
+        builder.ClearRenderTarget(sceneColor, { 0.0f, 0.0f, 0.0f, 1.0f });
+    },
+    [&](LLGL::CommandBuffer& commands, const LLGL::RenderGraphResources& resources)
+    {
+        // Draw scene ...
+    }
+);
+
+graph.AddPass(
+    "Tonemap", LLGL::RenderGraphPassType::Graphics,
+    [&](LLGL::RenderGraphBuilder& builder)
+    {
+        builder.Read(sceneColor);
+        builder.WriteRenderTarget(backBuffer);
+    },
+    [&](LLGL::CommandBuffer& commands, const LLGL::RenderGraphResources& resources)
+    {
+        commands.SetTexture(resources.GetTexture(sceneColor), 0);
+        // Draw fullscreen triangle ...
+    }
+);
+
+graph.Execute();
+context->Present();
+texturePool.NextFrame();
+\endcode
+\note Only Direct3D 12 runs async compute command buffers concurrently with the graphics commands.
+All other render systems execute them in submission order, which still respects all dependencies.
+\see TransientTexturePool
+\see CommandBufferFlags::AsyncCompute
+*/
+class LLGL_EXPORT RenderGraph
+{
+
+    public:
+
+        //! Setup function of a pass, which declares the resource accesses with the specified builder.
+        using SetupFunction = std::function<void(RenderGraphBuilder& builder)>;
+
+        //! Execute function of a pass, which records the commands of the pass.
+        using ExecuteFunction = std::function<void(CommandBuffer& commands, const RenderGraphResources& resources)>;
+
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator = (const RenderGraph&) = delete;
+
+        /**
+        \brief Initializes the render graph.
+        \param[in] renderSystem Specifies the render system, which is used to create and submit the command buffers.
+        \param[in] texturePool Specifies the pool, which allocates the transient textures. This pool must outlive the render graph.
+        \param[in] asyncCompute Specifies whether independent compute passes are scheduled onto the async compute queue. By default true.
+        \param[in] parallelRecording Specifies whether each pass is recorded into its own command buffer on the worker threads of the shared thread pool.
+        Otherwise, all passes of a queue segment are recorded into the same command buffer on the calling thread. By default true.
+        \remarks With parallel recording, the execute functions of the passes are called concurrently, so they must not modify any shared state without synchronization.
+        */
+        RenderGraph(RenderSystem& renderSystem, TransientTexturePool& texturePool, bool asyncCompute = true, bool parallelRecording = true);
+
+        //! Releases all command buffers of this render graph.
+        ~RenderGraph();
+
+        //! Imports the specified texture, which can be read and written as storage resource by the passes.
+        RenderGraphResource ImportTexture(Texture& texture);
+
+        //! Imports the specified buffer, which can be read and written as storage resource by the passes.
+        RenderGraphResource ImportBuffer(Buffer& buffer);
+
+        //! Imports the specified render target, which can be rendered into by the passes.
+        RenderGraphResource ImportRenderTarget(RenderTarget& renderTarget);
+
+        //! Imports the specified render context, whose back buffer can be rendered into by the passes.
+        RenderGraphResource ImportRenderContext(RenderContext& renderContext);
+
+        /**
+        \brief Adds a new pass to the current frame.
+        \param[in] name Specifies the name of the pass, e.g. for debugging.
+        \param[in] type Specifies the pass type.
+        \param[in] setup Specifies the setup function, which is called immediately to declare the resource accesses of the pass.
+        \param[in] execute Specifies the execute function, which is called during "Execute" unless the pass is culled.
+        \remarks Passes must be added in a valid order, i.e. a pass can only read results of the passes that have been added before.
+        */
+        void AddPass(const std::string& name, const RenderGraphPassType type, const SetupFunction& setup, const ExecuteFunction& execute);
+
+        /**
+        \brief Culls, schedules, records, and submits all passes of the current frame, and removes all passes and resources afterwards.
+        \remarks The commands are recorded into deferred command buffers of the render graph, which are submitted with RenderSystem::ExecuteCommandBuffers.
+        All transient textures and barriers are resolved before the recording starts, so the passes have no recording dependencies among each other
+        and are submitted in their scheduled order afterwards. With OpenGL, the deferred command buffers are replayed on the calling thread.
+        \throw Any exception that has been thrown by an execute function is rethrown after all passes have been recorded. In this case, nothing is submitted.
+        */
+        void Execute();
+
+        //! Returns the number of passes that have been culled by the most recent call to "Execute".
+        inline std::size_t GetNumCulledPasses() const
+        {
+            return numCulledPasses_;
+        }
+
+        //! Returns the number of passes that have been scheduled onto the async compute queue by the most recent call to "Execute".
+        inline std::size_t GetNumAsyncComputePasses() const
+        {
+            return numAsyncComputePasses_;
+        }
+
+    private:
+
+        friend class RenderGraphBuilder;
+        friend class RenderGraphResources;
+
+        enum class ResourceType
+        {
+            TransientTexture,
+            Texture,
+            Buffer,
+            RenderTarget,
+            RenderContext,
+        };
+
+        enum class AccessType
+        {
+            Read,
+            WriteStorage,
+            WriteRenderTarget,
+            ClearRenderTarget,
+        };
+
+        struct Resource
+        {
+            ResourceType                type;
+            TransientTextureDescriptor  desc;
+            Texture*                    texture         = nullptr;
+            Buffer*                     buffer          = nullptr;
+            RenderTarget*               renderTarget    = nullptr;
+            RenderContext*              renderContext   = nullptr;
+            TransientTarget             transient;
+
+            /* Per-frame execution state */
+            std::size_t                 firstUse        = 0;        // Index of the first pass in submission order, which uses this transient texture
+            std::size_t                 lastUse         = 0;        // Index of the last pass in submission order, which uses this transient texture
+            bool                        used            = false;
+            bool                        asyncAccess     = false;    // Accessed by an async compute pass, so it must not be aliased
+        };
+
+        struct Access
+        {
+            std::uint32_t   resource;
+            AccessType      type;
+            long            barrierFlags;
+            ColorRGBAf      clearColor;
+            float           clearDepth;
+        };
+
+        struct Pass
+        {
+            std::string             name;
+            RenderGraphPassType     type            = RenderGraphPassType::Graphics;
+            ExecuteFunction         execute;
+            std::vector<Access>     accesses;
+            long                    barrierFlags    = 0;        // Barrier before this pass, which is resolved in submission order
+            bool                    sideEffects     = false;
+            bool                    culled          = false;
+            bool                    async           = false;
+        };
+
+        struct Segment
+        {
+            bool                        async       = false;
+            std::vector<std::uint32_t>  passes;
+        };
+
+        RenderGraphResource AddResource(const Resource& resource);
+        void AddAccess(std::uint32_t passIndex, RenderGraphResource resource, const Access& access);
+        const Resource& GetResource(std::uint32_t passIndex, RenderGraphResource resource) const;
+
+        void CullPasses();
+        void SchedulePasses();
+        void SplitSegments();
+        void AllocateTransientTextures();
+        void ResolveBarriers();
+
+        void RecordSegments(const std::vector<CommandBuffer*>& commandBuffers);
+        void RecordPass(CommandBuffer& commands, std::uint32_t passIndex);
+        void RecordBeginRenderPass(CommandBuffer& commands, std::uint32_t passIndex, const Access& access);
+
+        bool IsImported(const Resource& resource) const;
+        bool HasContentsBefore(std::uint32_t passIndex, std::uint32_t resource) const;
+        bool IsAccessedAfter(std::uint32_t passIndex, std::uint32_t resource) const;
+
+        CommandBuffer& GetCommandBuffer(bool async, std::size_t index);
+
+        RenderSystem&                   renderSystem_;
+        TransientTexturePool&           texturePool_;
+        bool                            asyncCompute_           = true;
+        bool                            parallelRecording_      = true;
+
+        std::vector<Resource>           resources_;
+        std::vector<Pass>               passes_;
+        std::vector<Segment>            segments_;
+
+        std::vector<CommandBuffer*>     graphicsCommandBuffers_;
+        std::vector<CommandBuffer*>     computeCommandBuffers_;
+
+        std::size_t                     numCulledPasses_        = 0;
+        std::size_t                     numAsyncComputePasses_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
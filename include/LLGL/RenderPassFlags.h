@@ -0,0 +1,116 @@
+/*
+ * RenderPassFlags.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_PASS_FLAGS_H
+#define LLGL_RENDER_PASS_FLAGS_H
+
+
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Enumeration of attachment load operations at the beginning of a render pass.
+\see RenderPassAttachmentDescriptor::loadOp
+*/
+enum class AttachmentLoadOp
+{
+    Load,       //!< The previous content of the attachment is preserved.
+    Clear,      //!< The attachment is cleared with the current clear value (see CommandBuffer::SetClearColor, SetClearDepth, and SetClearStencil).
+    DontCare,   //!< The previous content of the attachment is undefined, i.e. it does not need to be loaded from memory.
+};
+
+/**
+\brief Enumeration of attachment store operations at the end of a render pass.
+\see RenderPassAttachmentDescriptor::storeOp
+*/
+enum class AttachmentStoreOp
+{
+    //! The content of the attachment is stored. Multi-sampled render targets are resolved as well.
+    Store,
+
+    /**
+    \brief Multi-sampled render targets are resolved into the attached textures, but the multi-sampled content is discarded.
+    \remarks For attachments without multi-sampling, this is equivalent to AttachmentStoreOp::Store.
+    */
+    Resolve,
+
+    //! The content of the attachment is discarded, i.e. it does not need to be written back into memory.
+    Discard,
+};
+
+
+/* ----- Structures ----- */
+
+//! Render pass attachment descriptor structure with the load and store operations of a single attachment.
+struct RenderPassAttachmentDescriptor
+{
+    RenderPassAttachmentDescriptor() = default;
+
+    RenderPassAttachmentDescriptor(AttachmentLoadOp loadOp, AttachmentStoreOp storeOp = AttachmentStoreOp::Store) :
+        loadOp  { loadOp  },
+        storeOp { storeOp }
+    {
+    }
+
+    //! Specifies the load operation at the beginning of the render pass. By default AttachmentLoadOp::Load.
+    AttachmentLoadOp    loadOp  = AttachmentLoadOp::Load;
+
+    //! Specifies the store operation at the end of the render pass. By default AttachmentStoreOp::Store.
+    AttachmentStoreOp   storeOp = AttachmentStoreOp::Store;
+};
+
+/**
+\brief Render pass descriptor structure.
+\remarks A render pass specifies which attachments of a render target must be loaded from and stored into memory.
+This avoids redundant clears and resolves, and saves memory bandwidth especially on tile-based GPUs.
+\code
+// Clear color and depth buffer, and discard the depth buffer after rendering
+LLGL::RenderPassDescriptor renderPassDesc;
+renderPassDesc.colorAttachments = { { LLGL::AttachmentLoadOp::Clear } };
+renderPassDesc.depthAttachment  = { LLGL::AttachmentLoadOp::Clear, LLGL::AttachmentStoreOp::Discard };
+commands->BeginRenderPass(*renderTarget, renderPassDesc);
+// ...
+commands->EndRenderPass();
+\endcode
+\see CommandBuffer::BeginRenderPass
+*/
+struct RenderPassDescriptor
+{
+    /**
+    \brief Specifies the operations for each color attachment.
+    \remarks The entries correspond to the color attachments in the order they have been attached to the render target.
+    Color attachments without an entry use the default operations (i.e. AttachmentLoadOp::Load and AttachmentStoreOp::Store).
+    For the back buffer of a render context, only the first entry is used.
+    */
+    std::vector<RenderPassAttachmentDescriptor> colorAttachments;
+
+    //! Specifies the operations for the depth attachment (if the render target has one).
+    RenderPassAttachmentDescriptor              depthAttachment;
+
+    /**
+    \brief Specifies the operations for the stencil attachment (if the render target has one).
+    \note With Direct3D, a depth-stencil attachment can only be loaded with AttachmentLoadOp::DontCare
+    or stored with AttachmentStoreOp::Discard if both the depth and the stencil attachment specify this operation.
+    */
+    RenderPassAttachmentDescriptor              stencilAttachment;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
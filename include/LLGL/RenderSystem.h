@@ -15,6 +15,7 @@
 #include "RenderSystemFlags.h"
 #include "RenderingProfiler.h"
 #include "RenderingDebugger.h"
+#include "RenderingTracer.h"
 
 #include "Buffer.h"
 #include "BufferArray.h"
@@ -22,22 +23,35 @@
 #include "TextureArray.h"
 #include "Sampler.h"
 #include "SamplerArray.h"
+#include "ResourceHeap.h"
 
 #include "RenderTarget.h"
 #include "ShaderProgram.h"
 #include "GraphicsPipeline.h"
 #include "ComputePipeline.h"
 #include "Query.h"
+#include "QueryArray.h"
+#include "Readback.h"
+#include "Fence.h"
+#include "VideoAdapter.h"
 
 #include <string>
 #include <memory>
 #include <vector>
+#include <future>
+#include <set>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+class RenderingCapture;
+
+
 /**
 \brief Render system interface.
 \remarks This is the main interface for the entire renderer.
@@ -71,9 +85,21 @@ class LLGL_EXPORT RenderSystem
         /**
         \brief Returns the list of all available render system modules for the current platform
         (e.g. on Win32 this might be { "OpenGL", "Direct3D11", "Direct3D12" }, but on MacOS it might be only { "OpenGL" }).
+        \remarks The modules are not loaded to determine their availability, i.e. loading a listed module can still fail.
+        The list is determined with the first call to this function, so modules that are installed afterwards are not listed.
         */
         static std::vector<std::string> FindModules();
 
+        /**
+        \brief Loads the specified render system module in advance and keeps it loaded until the program terminates.
+        \param[in] moduleName Specifies the name of the module as returned by FindModules (e.g. "OpenGL").
+        \return True if the module has been loaded and its build ID matches this library. Otherwise, false is returned.
+        \remarks Subsequent calls to the Load function with the same module name use the preloaded module,
+        and unloading a render system created from it does not unload the module.
+        This can be used to pin one backend, e.g. when render systems are created and destroyed repeatedly.
+        */
+        static bool PreloadModule(const std::string& moduleName);
+
         /**
         \brief Loads a new render system from the specified module.
         \param[in] moduleName Specifies the name from which the new render system is to be loaded.
@@ -86,6 +112,14 @@ class LLGL_EXPORT RenderSystem
         This is only supported if LLGL was compiled with the "LLGL_ENABLE_DEBUG_LAYER" flag.
         \param[in] debugger Optional pointer to a rendering debugger.
         This is only supported if LLGL was compiled with the "LLGL_ENABLE_DEBUG_LAYER" flag.
+        How much is validated is selected at compile time with the CMake option "LLGL_DEBUG_LAYER_VALIDATION" (Off, State, or Full).
+        With "State", draw and dispatch calls only check the bound render states, whose compatibility is determined once when they are bound.
+        With "Off", the debugger is ignored and the debug layer is only used if a profiler or tracer is specified.
+        \param[in] tracer Optional pointer to a rendering tracer, which records an event for most functions of the render system,
+        its command buffers, shaders, and render contexts. If only a tracer is specified, the debug layer does not validate any function calls.
+        This is only supported if LLGL was compiled with the "LLGL_ENABLE_DEBUG_LAYER" flag.
+        \param[in] capture Optional pointer to a rendering capture, which records all functions of the render system and its objects into a binary trace.
+        The trace can be replayed with any render system (see CaptureReplay). The capture must outlive the render system.
         \throws std::runtime_error If loading the render system from the specified module failed.
         \throws std::runtime_error If there is already a loaded instance of a render system
         (make sure there are no more shared pointer references to the previous render system!)
@@ -93,7 +127,22 @@ class LLGL_EXPORT RenderSystem
         static std::unique_ptr<RenderSystem> Load(
             const std::string& moduleName,
             RenderingProfiler* profiler = nullptr,
-            RenderingDebugger* debugger = nullptr
+            RenderingDebugger* debugger = nullptr,
+            RenderingTracer*   tracer   = nullptr,
+            RenderingCapture*  capture  = nullptr
+        );
+
+        /**
+        \brief Loads a new render system from the module that is specified by the descriptor, and selects the video adapter of the descriptor.
+        \remarks This is equivalent to the other Load function, except that the video adapter can be selected.
+        \see RenderSystemDescriptor
+        */
+        static std::unique_ptr<RenderSystem> Load(
+            const RenderSystemDescriptor&   renderSystemDesc,
+            RenderingProfiler*              profiler    = nullptr,
+            RenderingDebugger*              debugger    = nullptr,
+            RenderingTracer*                tracer      = nullptr,
+            RenderingCapture*               capture     = nullptr
         );
 
         /**
@@ -139,6 +188,17 @@ class LLGL_EXPORT RenderSystem
             return caps_;
         }
 
+        /**
+        \brief Returns the descriptors of all video adapters of the host system.
+        \remarks This list is only provided by the Direct3D render systems, and it is empty for all other render systems.
+        The index of an entry can be used to select the respective adapter with RenderSystemDescriptor::adapterIndex.
+        \see RenderSystemDescriptor::adapterIndex
+        */
+        inline const std::vector<VideoAdapterDescriptor>& GetVideoAdapters() const
+        {
+            return videoAdapters_;
+        }
+
         /**
         \brief Sets the basic configuration.
         \remarks This can be used to change the behavior of default initializion of textures for instance.
@@ -170,13 +230,43 @@ class LLGL_EXPORT RenderSystem
         //! Releases the specified render context. This will all release all resources, that are associated with this render context.
         virtual void Release(RenderContext& renderContext) = 0;
 
+        /**
+        \brief Presents the back buffers of several render contexts with a single wait for the vertical blank.
+        \param[in] numRenderContexts Specifies the number of render contexts in the array.
+        \param[in] renderContextArray Pointer to an array of RenderContext object pointers. This must not be null.
+        \remarks The first render context is presented with its own Vsync configuration, and all other render contexts are presented
+        right afterwards with RenderContext::PresentWithoutVsync. Calling RenderContext::Present for each of N render contexts
+        with Vsync enabled waits for N vertical blanks, which divides the frame rate by N.
+        Therefore, all render contexts of the batch should be shown on displays with the same refresh rate.
+        \see RenderContext::PresentWithoutVsync
+        */
+        virtual void PresentAll(unsigned int numRenderContexts, RenderContext* const * renderContextArray);
+
         /* ----- Command buffers ----- */
 
         /**
         \brief Creates a new command buffer.
+        \param[in] desc Specifies the command buffer descriptor. By default an immediate command buffer is created.
         \remarks Some render systems only support a single command buffer, such as OpenGL and Direct3D 11.
+        However, deferred command buffers (see CommandBufferFlags::DeferredSubmit) are supported by all render systems.
+        Query results can only be retrieved from immediate command buffers (see CommandBuffer::QueryResult).
+        \see CommandBuffer::Execute
         */
-        virtual CommandBuffer* CreateCommandBuffer() = 0;
+        virtual CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) = 0;
+
+        /**
+        \brief Submits the specified deferred command buffers in the specified order.
+        \param[in] numCommandBuffers Specifies the number of command buffers in the array.
+        \param[in] commandBufferArray Pointer to an array of CommandBuffer object pointers. This must not be null.
+        Each command buffer must have been created with the CommandBufferFlags::DeferredSubmit flag.
+        \remarks Deferred command buffers can be recorded concurrently by several worker threads (one command buffer per thread),
+        but this function must only be called by the thread that owns the render system.
+        Direct3D 11 submits the command lists of its deferred contexts, and Direct3D 12 submits all command lists with a single call.
+        The other render systems replay the recorded commands on their immediate command buffer.
+        \see CommandBufferFlags::DeferredSubmit
+        \see CommandBuffer::Execute
+        */
+        virtual void ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray) = 0;
 
         //! Releases the specified command buffer. After this call, the specified object must no longer be used.
         virtual void Release(CommandBuffer& commandBuffer) = 0;
@@ -189,9 +279,37 @@ class LLGL_EXPORT RenderSystem
         \param[in] initialData Optional raw pointer to the data with which the buffer is to be initialized.
         This may also be null, to only initialize the size of the buffer. In this case, the buffer must
         be initialized with the "WriteBuffer" function before it is used for drawing operations. By default null.
+        \remarks With Direct3D 11 and Direct3D 12, this function can be called concurrently by several threads.
+        Each object type is guarded by its own lock, so creating buffers does not block the creation of textures or samplers.
+        With OpenGL, this function must only be called by the thread that owns the GL context (see CreateBufferAsync instead).
         \see WriteBuffer
         */
         virtual Buffer* CreateBuffer(const BufferDescriptor& desc, const void* initialData = nullptr) = 0;
+
+        /**
+        \brief Creates a new generic hardware buffer and uploads its initial data asynchronously.
+        \param[in] desc Specifies the buffer descriptor.
+        \param[in] initialData Optional raw pointer to the initial buffer data. This must be valid until the future is ready.
+        \return Future of the new buffer. The buffer must not be used before the future is ready.
+        \remarks With OpenGL, the buffer is created on the calling thread and its data is uploaded on a background loader context,
+        which shares its objects with the render contexts. On X11, this requires that the application has called \c XInitThreads.
+        For all other render systems, the buffer is created immediately and the returned future is already ready.
+        \see CreateBuffer
+        */
+        virtual std::shared_future<Buffer*> CreateBufferAsync(const BufferDescriptor& desc, const void* initialData = nullptr);
+
+        /**
+        \brief Creates several generic hardware buffers at once, e.g. while a level is loaded.
+        \param[in] numBuffers Specifies the number of buffers to create.
+        \param[in] descArray Pointer to an array of 'numBuffers' buffer descriptors. This must not be null if 'numBuffers' is greater than 0.
+        \param[in] initialDataArray Optional pointer to an array of 'numBuffers' pointers to the initial data of each buffer.
+        Each entry may also be null (see CreateBuffer). If the array itself is null, no buffer is initialized. By default null.
+        \return List of the new buffers in the same order as their descriptors. Each buffer must be released individually.
+        \remarks This is equivalent to calling CreateBuffer for each descriptor, but lets the render system share the per-object overhead:
+        OpenGL generates all buffer names with a single call, and Direct3D 12 submits all initial data with a single upload command list.
+        \see CreateBuffer
+        */
+        virtual std::vector<Buffer*> CreateBuffers(unsigned int numBuffers, const BufferDescriptor* descArray, const void* const * initialDataArray = nullptr);
         
         /**
         \brief Creates a new buffer array.
@@ -232,12 +350,60 @@ class LLGL_EXPORT RenderSystem
         */
         virtual void* MapBuffer(Buffer& buffer, const BufferCPUAccess access) = 0;
 
+        /**
+        \brief Maps the specified range of a buffer from GPU to CPU memory space.
+        \param[in] buffer Specifies the buffer which is to be mapped.
+        \param[in] offset Specifies the offset (in bytes) of the range which is to be mapped.
+        \param[in] size Specifies the size (in bytes) of the range which is to be mapped.
+        This offset plus the size (i.e. 'offset + size') must be less than or equal to the size of the buffer.
+        \param[in] access Specifies the CPU buffer access requirement.
+        BufferCPUAccess::WriteDiscard and BufferCPUAccess::WriteNoOverwrite are equivalent to BufferCPUAccess::WriteOnly
+        with the flags BufferMapFlags::DiscardBuffer and BufferMapFlags::Unsynchronized respectively.
+        \param[in] mapFlags Specifies the mapping flags. This can be a bitwise OR combination of the BufferMapFlags entries. By default 0.
+        \return Raw pointer to the beginning of the mapped range (not the beginning of the buffer), or null if the mapping failed.
+        \remarks Mapping only the range that is actually accessed allows the driver to avoid stalls and copies of the remaining buffer:
+        With OpenGL, this is mapped with \c glMapBufferRange (requires the extension "GL_ARB_map_buffer_range").
+        With Direct3D 11, the entire buffer is mapped but only the specified range is copied to and from the CPU-access buffer if there is one.
+        With Direct3D 12, only the specified range is read and written back, and the buffer must be in an upload or readback heap.
+        The buffer is unmapped with UnmapBuffer.
+        \see BufferMapFlags
+        \see FlushMappedBufferRange
+        \see UnmapBuffer
+        */
+        virtual void* MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags = 0);
+
+        /**
+        \brief Flushes a range of a buffer that has been mapped with the BufferMapFlags::FlushExplicit flag, so it is written back to the buffer.
+        \param[in] buffer Specifies the mapped buffer.
+        \param[in] offset Specifies the offset (in bytes) of the range which is to be flushed, relative to the beginning of the mapped range.
+        \param[in] size Specifies the size (in bytes) of the range which is to be flushed.
+        \remarks This can be called several times before the buffer is unmapped. By default, this function has no effect.
+        \see MapBufferRange
+        */
+        virtual void FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size);
+
         /**
         \brief Unmaps the specified buffer.
         \see MapBuffer
+        \see MapBufferRange
         */
         virtual void UnmapBuffer(Buffer& buffer) = 0;
 
+        /**
+        \brief Writes dynamic constant data into the next free range of a persistently mapped ring buffer.
+        \param[in] data Raw pointer to the data which is to be written. This must not be null!
+        \param[in] dataSize Specifies the size (in bytes) of the data block. This must not be greater than RenderingCaps::maxConstantBufferSize.
+        \return Range of the ring buffer the data has been written to. This range can be bound with CommandBuffer::SetConstantBufferRange.
+        If transient buffers are not supported, the buffer of the returned range is null.
+        \remarks This is meant for many small per-object constant buffer updates per frame, which would otherwise require a separate buffer update each.
+        The ring buffer is owned by the render system and wraps around when its end is reached.
+        The render system only waits for the GPU if a range is about to be reused while it is still in use,
+        so the written data must be consumed within the next few frames.
+        \note Only supported if RenderingCaps::hasConstantBufferRanges is true.
+        \see CommandBuffer::SetConstantBufferRange
+        */
+        virtual TransientBufferRange WriteTransientConstantBuffer(const void* data, std::size_t dataSize) = 0;
+
         /* ----- Textures ----- */
 
         /**
@@ -247,11 +413,40 @@ class LLGL_EXPORT RenderSystem
         If this is null, the texture will be initialized with the currently configured default image color.
         If this is non-null, it is used to initialize the texture data.
         This parameter will be ignored if the texture type is a multi-sampled texture (i.e. TextureType::Texture2DMS or TextureType::Texture2DMSArray).
+        \remarks With Direct3D 11 and Direct3D 12, this function can be called concurrently by several threads (see CreateBuffer).
+        With Direct3D 11, the initialization of the texture data is serialized on the immediate context,
+        so it must not overlap with commands that are recorded into an immediate command buffer at the same time.
         \see WriteTexture
         \see RenderSystemConfiguration::defaultImageColor
         */
         virtual Texture* CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc = nullptr) = 0;
 
+        /**
+        \brief Creates a new texture and uploads its initial image asynchronously.
+        \param[in] textureDesc Specifies the texture descriptor.
+        \param[in] imageDesc Optional pointer to the image data descriptor for the first MIP-map level.
+        The descriptor is copied, but the image data it refers to must be valid until the future is ready.
+        \return Future of the new texture. The texture must not be used before the future is ready.
+        \remarks With OpenGL, the texture is created on the calling thread and its image is uploaded on a background loader context
+        (see CreateBufferAsync). For all other render systems, the texture is created immediately and the returned future is already ready.
+        \see CreateTexture
+        \see CreateBufferAsync
+        */
+        virtual std::shared_future<Texture*> CreateTextureAsync(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc = nullptr);
+
+        /**
+        \brief Creates several textures at once, e.g. while a level is loaded.
+        \param[in] numTextures Specifies the number of textures to create.
+        \param[in] textureDescArray Pointer to an array of 'numTextures' texture descriptors. This must not be null if 'numTextures' is greater than 0.
+        \param[in] imageDescArray Optional pointer to an array of 'numTextures' pointers to the image data descriptor of each texture.
+        Each entry may also be null (see CreateTexture). If the array itself is null, all textures are initialized with the default image color. By default null.
+        \return List of the new textures in the same order as their descriptors. Each texture must be released individually.
+        \remarks This is equivalent to calling CreateTexture for each descriptor,
+        but Direct3D 12 submits the image data of all textures with a single upload command list.
+        \see CreateTexture
+        */
+        virtual std::vector<Texture*> CreateTextures(unsigned int numTextures, const TextureDescriptor* textureDescArray, const ImageDescriptor* const * imageDescArray = nullptr);
+
         /**
         \brief Creates a new texture array.
         \param[in] numTextures Specifies the number of textures in the array. This must be greater than 0.
@@ -263,6 +458,36 @@ class LLGL_EXPORT RenderSystem
         */
         virtual TextureArray* CreateTextureArray(unsigned int numTextures, Texture* const * textureArray) = 0;
 
+        /**
+        \brief Creates a new texture view, which shares the memory of the specified texture.
+        \param[in] sharedTexture Specifies the texture whose memory is shared with the new view. This must not be a texture view itself.
+        \param[in] textureViewDesc Specifies the range of MIP-map levels and array layers, and the format of the view.
+        \remarks The texture view can be bound like any other texture, e.g. with "CommandBuffer::SetTexture", and it is released with "Release(Texture&)".
+        It must be released before the shared texture is released. Writing into the shared texture is visible through the view and vice versa.
+        For the sake of portability, a texture view should only be bound as shader resource.
+        To render into a single MIP-map level or array layer, attach the shared texture with "RenderTargetAttachmentDescriptor::mipLevel" and "RenderTargetAttachmentDescriptor::layer" instead.
+        \note Only supported if RenderingCaps::hasTextureViews is true.
+        For OpenGL, the shared texture must have been created with a sized or compressed texture format (e.g. TextureFormat::RGBA8, but not TextureFormat::RGBA).
+        \see TextureViewDescriptor
+        */
+        virtual Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) = 0;
+
+        /**
+        \brief Creates a new sparse texture, whose memory is only reserved but not committed.
+        \param[in] textureDesc Specifies the texture descriptor. The texture type must be TextureType::Texture2D, TextureType::Texture2DArray,
+        TextureType::Texture3D, TextureType::TextureCube, or TextureType::TextureCubeArray, and the format must be a sized or compressed format (e.g. TextureFormat::RGBA8).
+        \remarks The texture has a full MIP-map chain, which is divided into pages (see QuerySparseTexturePageSize).
+        The pages are committed to and decommitted from physical memory with "CommitSparseTexture", so only the pages that are resident occupy video memory.
+        This allows virtual texturing with a fixed video memory budget. The smallest MIP-map levels, which are smaller than a page, form the MIP-map tail and are always resident.
+        Reading from pages that are not resident returns undefined values, and writing to them is discarded.
+        \note Only supported if RenderingCaps::hasSparseTextures is true.
+        For Direct3D 11, TextureType::Texture3D is not supported.
+        \throws std::runtime_error If the renderer does not support sparse textures.
+        \throws std::invalid_argument If the texture type or format is not supported for sparse textures.
+        \see CommitSparseTexture
+        */
+        virtual Texture* CreateSparseTexture(const TextureDescriptor& textureDesc) = 0;
+
         //! Releases the specified texture object. After this call, the specified object must no longer be used.
         virtual void Release(Texture& texture) = 0;
 
@@ -299,20 +524,72 @@ class LLGL_EXPORT RenderSystem
         std::vector<LLGL::ColorRGBAub> image(textureWidth*textureHeight);
         renderSystem->ReadTexture(texture, 0, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data());
         \endcode
+        For textures with a compressed format, 'imageFormat' must be either ImageFormat::CompressedRGB or ImageFormat::CompressedRGBA,
+        and the tightly packed blocks are read without conversion. The required buffer size can be determined with the "CompressedImageSize" function.
         \see QueryTextureDescriptor
+        \see CompressedImageSize
         */
         virtual void ReadTexture(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType, void* buffer) = 0;
 
         /**
         \brief Generates the MIP ("Multum in Parvo") maps for the specified texture.
+        \remarks With Direct3D 12, the MIP-maps are generated by a built-in compute shader, which only supports 2D textures (including arrays and cube maps)
+        with a non-integral and non-sRGB color format. The MIP-maps of other textures remain unchanged.
         \see https://developer.valvesoftware.com/wiki/MIP_Mapping
         */
         virtual void GenerateMips(Texture& texture) = 0;
 
+        /**
+        \brief Returns a 64-bit bindless handle for the specified texture, optionally combined with a sampler state.
+        \param[in] texture Specifies the texture whose handle is to be returned.
+        \param[in] sampler Optional pointer to a sampler whose states are combined with the texture. By default null.
+        \remarks The handle is made resident before it is returned and remains valid until the texture is released.
+        Shaders can read these handles from a constant or storage buffer (e.g. as 'sampler2D' with the GLSL extension "GL_ARB_bindless_texture"),
+        so materials can be switched without any texture bindings. Requesting the same texture and sampler again returns the same handle.
+        \note For OpenGL, the texture storage becomes immutable once a handle has been created,
+        i.e. the texture must not be re-created with a different type or size afterwards.
+        \throws std::runtime_error If the renderer does not support bindless textures.
+        \see RenderingCaps::hasBindlessTextures
+        */
+        virtual std::uint64_t GetBindlessTextureHandle(Texture& texture, Sampler* sampler = nullptr) = 0;
+
+        /**
+        \brief Commits or decommits the pages of a sparse texture, which the specified region overlaps with.
+        \param[in] texture Specifies the sparse texture. This must have been created with "CreateSparseTexture".
+        \param[in] region Specifies the region of a single MIP-map level. Array layers (and cube faces) are addressed by the Z-component.
+        The offset must be a multiple of the page size, and so must be the extent, unless the region ends at the border of its MIP-map level.
+        \param[in] commit Specifies whether the pages are to be committed (true) or decommitted (false).
+        \remarks Committed pages have undefined content until they are written, e.g. with "WriteTexture".
+        Regions within the MIP-map tail are ignored, since the tail is always resident.
+        The GPU must not access the affected pages while they are being committed or decommitted.
+        \throws std::out_of_range If the region exceeds its MIP-map level.
+        \throws std::invalid_argument If the region is not aligned to the page size.
+        \see QuerySparseTexturePageSize
+        \see IsSparseTextureResident
+        */
+        virtual void CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit) = 0;
+
+        /**
+        \brief Returns true if all pages of the sparse texture, which the specified region overlaps with, are committed.
+        \remarks This is tracked on the CPU side, i.e. it does not synchronize with the GPU.
+        \see CommitSparseTexture
+        */
+        virtual bool IsSparseTextureResident(const Texture& texture, const TextureRegion& region) = 0;
+
+        /**
+        \brief Returns the extent (in texels) of a single page of the specified sparse texture.
+        \remarks The page size depends on the texture type and format, e.g. 128x128x1 texels for a 2D texture of format TextureFormat::RGBA8 with 64 KB pages.
+        For array textures, the Z-component is always 1.
+        */
+        virtual Gs::Vector3ui QuerySparseTexturePageSize(const Texture& texture) = 0;
+
         /* ----- Samplers ---- */
 
         /**
-        \brief Creates a new Sampler object.
+        \brief Creates a new Sampler object, or returns the existing one with an equal descriptor.
+        \remarks Sampler objects are immutable, so all samplers with an equal descriptor share the same object,
+        which is reference counted, i.e. it must be released as often as it has been created.
+        With Direct3D 11, this function can be called concurrently by several threads (see CreateBuffer).
         \throws std::runtime_error If the renderer does not support Sampler objects (e.g. if OpenGL 3.1 or lower is used).
         \see RenderContext::QueryRenderingCaps
         */
@@ -327,12 +604,31 @@ class LLGL_EXPORT RenderSystem
         */
         virtual SamplerArray* CreateSamplerArray(unsigned int numSamplers, Sampler* const * samplerArray) = 0;
 
-        //! Releases the specified Sampler object. After this call, the specified object must no longer be used.
+        /**
+        \brief Releases one reference of the specified Sampler object. After this call, the specified object must no longer be used.
+        \remarks The sampler is only deleted when all references, which have been returned by CreateSampler, are released.
+        \see CreateSampler
+        */
         virtual void Release(Sampler& sampler) = 0;
 
         //! Releases the specified sampler array object. After this call, the specified object must no longer be used.
         virtual void Release(SamplerArray& samplerArray) = 0;
 
+        /* ----- Resource Heaps ----- */
+
+        /**
+        \brief Creates a new resource heap, i.e. an immutable set of resource bindings that can be bound with a single command.
+        \param[in] desc Specifies the resource heap descriptor with all resource bindings.
+        \remarks The resource heap only references the resources, so all of them must stay alive as long as the resource heap is used.
+        \throws std::invalid_argument If a binding has an undefined resource type or if its resource pointer is null.
+        \see CommandBuffer::SetResourceHeap
+        \see ResourceHeapDescriptor
+        */
+        virtual ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) = 0;
+
+        //! Releases the specified resource heap. After this call, the specified object must no longer be used.
+        virtual void Release(ResourceHeap& resourceHeap) = 0;
+
         /* ----- Render Targets ----- */
 
         /**
@@ -377,6 +673,16 @@ class LLGL_EXPORT RenderSystem
         */
         virtual GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) = 0;
 
+        /**
+        \brief Creates a new graphics pipeline state object asynchronously.
+        \param[in] desc Specifies the graphics pipeline descriptor. The descriptor is copied, but the shader program must be valid until the future is ready.
+        \return Future of the new graphics pipeline. The application can keep rendering with a fallback pipeline until the future is ready.
+        \remarks With Direct3D 11 and Direct3D 12, the pipeline is created on a worker thread of the render system.
+        For all other render systems, the pipeline is created immediately and the returned future is already ready.
+        \see CreateGraphicsPipeline
+        */
+        virtual std::shared_future<GraphicsPipeline*> CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc);
+
         /**
         \brief Creates a new and initialized compute pipeline state object.
         \param[in] desc Specifies the compute pipeline descriptor. This will describe the shader states.
@@ -391,6 +697,28 @@ class LLGL_EXPORT RenderSystem
         //! Releases the specified ComputePipeline object. After this call, the specified object must no longer be used.
         virtual void Release(ComputePipeline& computePipeline) = 0;
 
+        /**
+        \brief Loads a pipeline cache, which has previously been serialized with "SavePipelineCache".
+        \param[in] data Specifies the serialized pipeline cache (e.g. the content of a file from a previous run of the application).
+        \return True if the pipeline cache has been loaded. Otherwise, the data is either invalid,
+        was serialized from another render system, or the render system does not support pipeline caches.
+        \remarks The pipeline cache should be loaded before any pipeline state objects are created.
+        Cached pipeline states whose driver or hardware no longer match are silently rebuilt.
+        For OpenGL, the pipeline cache stores the program binaries of all linked shader programs (see GL_ARB_get_program_binary).
+        This cache is opt-in and only enabled after this function has been called, so pass an empty container on the first run.
+        \note Only supported with: OpenGL, Direct3D 12.
+        \see SavePipelineCache
+        */
+        virtual bool LoadPipelineCache(const std::vector<char>& data);
+
+        /**
+        \brief Serializes all pipeline states, which have been created so far, into a binary blob.
+        \return The serialized pipeline cache, which can be stored on disk and passed to "LoadPipelineCache"
+        during the next run of the application. The returned container is empty if the render system does not support pipeline caches.
+        \see LoadPipelineCache
+        */
+        virtual std::vector<char> SavePipelineCache();
+
         /* ----- Queries ----- */
 
         //! Creates a new query.
@@ -399,9 +727,153 @@ class LLGL_EXPORT RenderSystem
         //! Releases the specified Query object. After this call, the specified object must no longer be used.
         virtual void Release(Query& query) = 0;
 
+        /**
+        \brief Creates a new query array.
+        \param[in] numQueries Specifies the number of queries. This must be greater than 0.
+        \param[in] queryArray Pointer to an array of Query object pointers. This must not be null.
+        All queries must have the same type.
+        \remarks The queries must not be released before the query array is released.
+        \throws std::invalid_argument If 'numQueries' is 0, if 'queryArray' is null,
+        if any of the pointers in the array are null, or if not all queries have the same type.
+        \see CommandBuffer::QueryResult(QueryArray&, unsigned int, unsigned int, std::uint64_t*)
+        \see CommandBuffer::ResolveQueryData
+        */
+        virtual QueryArray* CreateQueryArray(unsigned int numQueries, Query* const * queryArray) = 0;
+
+        //! Releases the specified QueryArray object. After this call, the specified object must no longer be used.
+        virtual void Release(QueryArray& queryArray) = 0;
+
+        /* ----- Readbacks ----- */
+
+        /**
+        \brief Schedules an asynchronous readback of the image data from the specified texture.
+        \param[in] texture Specifies the texture object to read from.
+        \param[in] mipLevel Specifies the MIP-level from which to read the image data.
+        \param[in] imageFormat Specifies the output image format.
+        \param[in] dataType Specifies the output data type.
+        \return Pointer to the new readback object, which must be released with "Release(Readback&)".
+        \remarks In contrast to "ReadTexture", this function does not wait for the GPU to finish all pending commands.
+        The same format restrictions apply as for "ReadTexture".
+        \note Only asynchronous with: OpenGL (requires GL_ARB_sync), Direct3D 11. Other render systems read the data immediately.
+        \see ReadTexture
+        \see Readback
+        */
+        virtual Readback* ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType);
+
+        /**
+        \brief Schedules an asynchronous readback of the data from the specified buffer.
+        \param[in] buffer Specifies the buffer object to read from.
+        \param[in] offset Specifies the offset (in bytes) at which the data is to be read.
+        \param[in] dataSize Specifies the size (in bytes) of the data block which is to be read.
+        The offset plus the data block size (i.e. 'offset + dataSize') must be less than or equal to the size of the buffer.
+        \return Pointer to the new readback object, which must be released with "Release(Readback&)".
+        \note Only asynchronous with: OpenGL (requires GL_ARB_sync), Direct3D 11. Other render systems read the data immediately.
+        \see Readback
+        */
+        virtual Readback* ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize);
+
+        //! Releases the specified Readback object. After this call, the specified object must no longer be used.
+        virtual void Release(Readback& readback);
+
+        /* ----- Uploads ----- */
+
+        /**
+        \brief Writes the specified data into the buffer through a staging buffer, without waiting for the GPU.
+        \param[in] buffer Specifies the destination buffer whose data is to be updated.
+        \param[in] data Raw pointer to the data with which the buffer is to be updated. This must not be null!
+        \param[in] dataSize Specifies the size (in bytes) of the data block which is to be updated.
+        \param[in] offset Specifies the offset (in bytes) at which the buffer is to be updated.
+        \return Pointer to a new fence, which is signaled once the GPU has finished the upload. It must be released with "Release(Fence&)".
+        \remarks The data is copied into staging memory before this function returns, so it can be released immediately.
+        In contrast to "WriteBuffer", the GPU copies the data into the buffer after all previously submitted commands,
+        so the render thread does not wait for commands that are still using the buffer.
+        \note Only asynchronous with: OpenGL (requires GL_ARB_copy_buffer and GL_ARB_sync), Direct3D 11.
+        Other render systems write the data immediately and return a fence that is already signaled.
+        \see WriteBuffer
+        \see UploadQueue
+        */
+        virtual Fence* WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset);
+
+        /**
+        \brief Writes the specified image data into the texture region through a staging buffer, without waiting for the GPU.
+        \return Pointer to a new fence, which is signaled once the GPU has finished the upload. It must be released with "Release(Fence&)".
+        \remarks The image data is copied into staging memory before this function returns, so it can be released immediately.
+        For OpenGL, the image data is copied into a pixel unpack buffer, from which the GPU transfers it into the texture asynchronously.
+        Compressed image data requires the 'compressedSize' attribute, otherwise the texture is written immediately.
+        \note Only asynchronous with: OpenGL (requires GL_ARB_sync), Direct3D 11.
+        Other render systems write the image data immediately and return a fence that is already signaled.
+        \see WriteTexture
+        \see UploadQueue
+        */
+        virtual Fence* WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc);
+
+        /* ----- Fences ----- */
+
+        /**
+        \brief Creates a new fence for explicit CPU/GPU synchronization.
+        \remarks The fence is initially signaled. Use "CommandBuffer::Signal" to schedule a new signal.
+        \note Only asynchronous with: OpenGL (requires GL_ARB_sync), Direct3D 11, Direct3D 12.
+        \see CommandBuffer::Signal
+        \see Fence
+        */
+        virtual Fence* CreateFence() = 0;
+
+        //! Releases the specified Fence object. After this call, the specified object must no longer be used.
+        virtual void Release(Fence& fence) = 0;
+
+        /* ----- Memory ----- */
+
+        /**
+        \brief Queries the memory budget and current usage of the GPU memory heaps, and the amount of memory this render system has allocated.
+        \remarks The memory budget is queried from the driver each time this function is called, so it should not be called more than once per frame.
+        With OpenGL, the budget requires either the GL_NVX_gpu_memory_info or the GL_ATI_meminfo extension. With GL_ATI_meminfo,
+        the driver only reports the free memory, so the budget is estimated as the free memory plus the memory this render system has allocated.
+        With Direct3D, the budget requires the IDXGIAdapter3 interface (i.e. Windows 10). Otherwise, the budget and current usage are 0.
+        \see MemoryInfo
+        */
+        virtual MemoryInfo QueryMemoryInfo() = 0;
+
+        /**
+        \brief Makes the specified buffer resident in video memory, or evicts it from video memory.
+        \return True if the residency of the buffer has been changed, or false if the render system does not support explicit residency for this buffer.
+        \remarks An evicted buffer must be made resident again before it is used by a command buffer that is submitted afterwards.
+        With Direct3D 12, only resources that have been created as committed resources (i.e. that are larger than a heap block of the memory allocator, and constant buffers)
+        can change their residency individually. All other render systems do not support explicit residency, and the driver pages their memory on demand.
+        \see ResidencyManager
+        */
+        virtual bool SetResidency(Buffer& buffer, bool resident);
+
+        /**
+        \brief Makes the specified texture resident in video memory, or evicts it from video memory.
+        \remarks Sparse textures are never evicted, and a texture view has the same residency as the texture it has been created from.
+        \see SetResidency(Buffer&, bool)
+        */
+        virtual bool SetResidency(Texture& texture, bool resident);
+
+        /**
+        \brief Samples the GPU and CPU clocks at the same moment to correlate GPU timestamps with the CPU timeline.
+        \param[out] calibration Specifies the output calibration. This is only written if the function succeeds.
+        \return True if the calibration has been queried, or false if the render system does not support timestamp queries or clock calibration.
+        \remarks With Direct3D 12, this uses the clock calibration of the command queue.
+        With OpenGL, this requires the extension \c GL_ARB_timer_query and the GPU time is read immediately without waiting for the command queue.
+        Direct3D 11 does not support clock calibration.
+        \see ClockCalibration
+        \see GPUProfiler
+        */
+        virtual bool QueryClockCalibration(ClockCalibration& calibration);
+
+        /**
+        \brief Reports the hit and miss counts of the internal state cache into the specified profiler and resets these counts.
+        \param[in,out] profiler Specifies the profiler which accumulates the counts. \see RenderingProfiler::ReportStateCache
+        \return True if the counts have been reported, or false if the render system does not record state cache statistics.
+        \remarks This is only supported by the OpenGL renderer, if it has been built with the CMake option \c LLGL_GL_ENABLE_STATE_CACHE_STATS.
+        The counts are recorded by the state manager of each render context, which filters out redundant GL state changes.
+        */
+        virtual bool ReportStateCacheStatistics(RenderingProfiler& profiler);
+
     protected:
 
-        RenderSystem() = default;
+        RenderSystem();
 
         //! Sets the renderer information.
         void SetRendererInfo(const RendererInfo& info);
@@ -409,6 +881,9 @@ class LLGL_EXPORT RenderSystem
         //! Sets the rendering capabilities.
         void SetRenderingCaps(const RenderingCaps& caps);
 
+        //! Sets the descriptors of all video adapters.
+        void SetVideoAdapters(const std::vector<VideoAdapterDescriptor>& videoAdapters);
+
         //! Creates an RGBA unsigned-byte image buffer for the specified number of pixels.
         std::vector<ColorRGBAub> GetDefaultTextureImageRGBAub(int numPixels) const;
 
@@ -424,14 +899,50 @@ class LLGL_EXPORT RenderSystem
         //! Validates the specified arguments to be used for sampler array creation.
         void AssertCreateSamplerArray(unsigned int numSamplers, Sampler* const * samplerArray);
 
+        //! Validates the specified arguments to be used for query array creation.
+        void AssertCreateQueryArray(unsigned int numQueries, Query* const * queryArray);
+
+        //! Validates the specified descriptor to be used for resource heap creation.
+        void AssertCreateResourceHeap(const ResourceHeapDescriptor& desc);
+
+        //! Returns the size (in bytes) of the image data, which is read from the specified texture MIP-level with "ReadTexture".
+        std::size_t GetTextureReadbackSize(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType);
+
+        //! Returns the size (in bytes) of the image data, which is written into the specified sub-texture region, or 0 if the size is unknown.
+        std::size_t GetSubTextureDataSize(const Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc);
+
+        //! Adds the specified buffer with its size (in bytes) to the memory accounting of this render system.
+        void TrackMemory(const Buffer& buffer, std::uint64_t size);
+
+        //! Adds the specified texture with the estimated size of its entire MIP-map chain to the memory accounting of this render system.
+        void TrackMemory(const Texture& texture, const TextureDescriptor& textureDesc);
+
+        //! Removes the specified buffer from the memory accounting. Untracked buffers are ignored.
+        void UntrackMemory(const Buffer& buffer);
+
+        //! Removes the specified texture from the memory accounting. Untracked textures are ignored.
+        void UntrackMemory(const Texture& texture);
+
+        //! Writes the accounted buffer and texture memory into the 'bufferMemory' and 'textureMemory' fields of the specified memory information.
+        void GetTrackedMemory(MemoryInfo& memoryInfo) const;
+
     private:
 
-        int                         rendererID_ = 0;
-        std::string                 name_;
+        int                                 rendererID_ = 0;
+        std::string                         name_;
+
+        RendererInfo                        info_;
+        RenderingCaps                       caps_;
+        RenderSystemConfiguration           config_;
+        std::vector<VideoAdapterDescriptor> videoAdapters_;
+
+        std::set<std::unique_ptr<Readback>> immediateReadbacks_;
 
-        RendererInfo                info_;
-        RenderingCaps               caps_;
-        RenderSystemConfiguration   config_;
+        mutable std::mutex                                  memoryMutex_;
+        std::unordered_map<const Buffer*, std::uint64_t>    bufferMemory_;
+        std::unordered_map<const Texture*, std::uint64_t>   textureMemory_;
+        std::uint64_t                                       totalBufferMemory_  = 0;
+        std::uint64_t                                       totalTextureMemory_ = 0;
 
 };
 
@@ -12,6 +12,7 @@
 #include <Gauss/Vector3.h>
 #include "ColorRGBA.h"
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 
@@ -19,6 +20,8 @@ namespace LLGL
 {
 
 
+class RenderingDebugger;
+
 /* ----- Constants ----- */
 
 /**
@@ -89,6 +92,18 @@ enum class ClippingRange
     ZeroToOne,      //!< Clipping depth is in the range [0, 1] (default in Direct3D).
 };
 
+/**
+\brief Video adapter preference enumeration.
+\remarks This determines which video adapter (GPU) is selected on systems with more than one adapter, e.g. laptops with an integrated and a discrete GPU.
+\see RenderSystemDescriptor::adapterPreference
+*/
+enum class VideoAdapterPreference
+{
+    Unspecified,        //!< The default adapter of the operating system is preferred.
+    HighPerformance,    //!< The adapter with the highest performance is preferred, e.g. the discrete GPU.
+    MinimumPower,       //!< The adapter with the lowest power consumption is preferred, e.g. the integrated GPU.
+};
+
 
 /* ----- Structures ----- */
 
@@ -132,6 +147,58 @@ struct RenderSystemConfiguration
     size_t              threadCount         { maxThreadCount };
 };
 
+/**
+\brief Render system descriptor structure.
+\remarks This is used to select the video adapter when a render system is loaded.
+Video adapters can only be selected by the Direct3D render systems. The OpenGL render systems always use the adapter that is selected by the driver.
+\see RenderSystem::Load
+*/
+struct RenderSystemDescriptor
+{
+    RenderSystemDescriptor() = default;
+
+    RenderSystemDescriptor(const std::string& moduleName) :
+        moduleName { moduleName }
+    {
+    }
+
+    //! Specifies the name of the render system module (see RenderSystem::Load).
+    std::string             moduleName;
+
+    /**
+    \brief Specifies which video adapter is preferred if 'adapterIndex' is negative. By default VideoAdapterPreference::HighPerformance.
+    \remarks If the device cannot be created with the preferred adapter, all other hardware adapters are tried,
+    and a software adapter is used as fallback.
+    */
+    VideoAdapterPreference  adapterPreference   = VideoAdapterPreference::HighPerformance;
+
+    /**
+    \brief Specifies the index of the video adapter that is to be used, or a negative value to select the adapter by 'adapterPreference'. By default -1.
+    \remarks This is an index into the list of video adapters that is returned by RenderSystem::GetVideoAdapters.
+    \throws std::runtime_error If the index is out of range when the render system is loaded.
+    */
+    int                     adapterIndex        = -1;
+
+    /**
+    \brief Specifies an optional rendering debugger, which receives the messages of the driver. By default null.
+    \remarks Without a driver debugger, the rendering debugger of RenderSystem::Load only receives the messages of the LLGL debug layer.
+    With a driver debugger, the errors, performance warnings (WarningType::PerformanceHint), and warnings about deprecated or undefined behavior
+    of the driver are posted to this debugger, e.g. buffer stalls and shader recompilations that are invisible to the debug layer.
+    OpenGL receives these messages with GL_KHR_debug, Direct3D 11 and Direct3D 12 read them from their info queues whenever a render context is presented.
+    The Direct3D render systems enable the debug layer of the runtime for this, which adds CPU overhead to all API calls.
+    The debugger must outlive the render system. It can be the same debugger that is passed to RenderSystem::Load.
+    \see driverMessageLimit
+    */
+    RenderingDebugger*      driverDebugger      = nullptr;
+
+    /**
+    \brief Specifies how often each driver message is posted to the driver debugger at most, or 0 for no limit. By default 8.
+    \remarks Drivers tend to report the same performance warning for every draw call. Further occurrences of a message are dropped before they reach the debugger.
+    \see driverDebugger
+    */
+    std::uint32_t           driverMessageLimit  = 8;
+};
+
 /**
 \brief Renderer identification number enumeration.
 \remarks There are several IDs for reserved future renderes, which are currently not supported (and maybe never supported).
@@ -215,6 +282,18 @@ struct RenderingCaps
     \see TextureType::Texture2DMSArray
     */
     bool            hasMultiSampleTextures          = false;
+
+    /**
+    \brief Specifies whether texture views are supported.
+    \see RenderSystem::CreateTextureView
+    */
+    bool            hasTextureViews                 = false;
+
+    /**
+    \brief Specifies whether sparse textures are supported, whose pages can be committed individually.
+    \see RenderSystem::CreateSparseTexture
+    */
+    bool            hasSparseTextures               = false;
     
     //! Specifies whether samplers are supported.
     bool            hasSamplers                     = false;
@@ -231,6 +310,35 @@ struct RenderingCaps
     */
     bool            hasStorageBuffers               = false;
 
+    /**
+    \brief Specifies whether the hidden counters of append and consume storage buffers are supported.
+    \see StorageBufferType::AppendStructuredBuffer
+    \see CommandBuffer::ResetBufferCounter
+    \see CommandBuffer::CopyBufferCounter
+    */
+    bool            hasBufferCounters               = false;
+
+    /**
+    \brief Specifies whether constant buffer ranges and transient constant buffers are supported.
+    \see CommandBuffer::SetConstantBufferRange
+    \see RenderSystem::WriteTransientConstantBuffer
+    */
+    bool            hasConstantBufferRanges         = false;
+
+    /**
+    \brief Specifies whether indirect draw and dispatch commands are supported.
+    \see CommandBuffer::DrawIndirect
+    \see CommandBuffer::DrawIndexedIndirect
+    \see CommandBuffer::DispatchIndirect
+    */
+    bool            hasIndirectDrawing              = false;
+
+    /**
+    \brief Specifies whether bindless textures are supported (e.g. with GL_ARB_bindless_texture).
+    \see RenderSystem::GetBindlessTextureHandle
+    */
+    bool            hasBindlessTextures             = false;
+
     /**
     \brief Specifies whether individual shader uniforms are supported (typically only for OpenGL 2.0+).
     \see ShaderProgram::LockShaderUniform
@@ -246,6 +354,14 @@ struct RenderingCaps
     //! Speciifes whether compute shaders are supported.
     bool            hasComputeShaders               = false;
 
+    /**
+    \brief Specifies whether mesh and amplification shaders are supported.
+    \remarks For Direct3D 12 this requires mesh shader tier 1, and for OpenGL this requires GL_NV_mesh_shader and a build with LLGL_GL_ENABLE_VENDOR_EXT.
+    \see ShaderType::Mesh
+    \see CommandBuffer::DrawMeshTasks
+    */
+    bool            hasMeshShaders                  = false;
+
     /**
     \brief Specifies whether hardware instancing is supported.
     \see RenderContext::DrawInstanced(unsigned int, unsigned int, unsigned int)
@@ -264,12 +380,54 @@ struct RenderingCaps
     //! Specifies whether multiple viewports, depth-ranges, and scissors are supported at once.
     bool            hasViewportArrays               = false;
 
+    /**
+    \brief Specifies whether layered render target attachments are supported, whose layer is selected per primitive in the geometry shader.
+    \see RenderTargetAttachmentDescriptor::layered
+    */
+    bool            hasLayeredRenderTargets         = false;
+
+    /**
+    \brief Specifies whether the render target layer can also be selected in the vertex or tessellation-evaluation shader, i.e. without a geometry shader.
+    \remarks For Direct3D 11 this requires the Direct3D 11.3 runtime, and for OpenGL this requires GL_ARB_shader_viewport_layer_array or GL_AMD_vertex_shader_layer.
+    \see RenderTargetAttachmentDescriptor::layered
+    */
+    bool            hasVertexShaderLayer            = false;
+
     /**
     \brief Specifies whether conservative rasterization is supported.
+    \remarks For Direct3D 11 this requires the Direct3D 11.3 runtime, and for OpenGL this requires a build with LLGL_GL_ENABLE_VENDOR_EXT.
     \see RasterizerDescriptor::conservativeRasterization
     */
     bool            hasConservativeRasterization    = false;
 
+    /**
+    \brief Specifies whether variable-rate shading with a per-draw shading rate is supported.
+    \remarks For Direct3D 12 this requires shading rate tier 1, and for OpenGL this requires GL_NV_shading_rate_image and a build with LLGL_GL_ENABLE_VENDOR_EXT.
+    \see CommandBuffer::SetShadingRate
+    */
+    bool            hasVariableRateShading          = false;
+
+    /**
+    \brief Specifies whether variable-rate shading with a screen-space shading rate image is supported.
+    \remarks For Direct3D 12 this requires shading rate tier 2.
+    \see CommandBuffer::SetShadingRateImage
+    */
+    bool            hasShadingRateImage             = false;
+
+    /**
+    \brief Specifies the width and height (in pixels) of the screen area each texel of a shading rate image covers, or 0 if shading rate images are not supported.
+    \see CommandBuffer::SetShadingRateImage
+    */
+    unsigned int    shadingRateImageTileSize        = 0;
+
+    /**
+    \brief Specifies whether the depth-bounds test is supported.
+    \remarks For Direct3D 12 this requires the depth-bounds test feature option, and for OpenGL this requires GL_EXT_depth_bounds_test. Not supported for Direct3D 11.
+    \see DepthDescriptor::boundsTestEnabled
+    \see CommandBuffer::SetDepthBounds
+    */
+    bool            hasDepthBoundsTest              = false;
+
     /**
     \brief Specifies whether stream-output is supported.
     \see ShaderSource::streamOutput
@@ -277,15 +435,60 @@ struct RenderingCaps
     */
     bool            hasStreamOutputs                = false;
 
+    /**
+    \brief Specifies whether stream-outputs can be paused and resumed, and whether the captured vertices can be drawn without CPU readback.
+    \see CommandBuffer::PauseStreamOutput
+    \see CommandBuffer::DrawStreamOutput
+    */
+    bool            hasStreamOutputDraws            = false;
+
+    /**
+    \brief Specifies whether shaders can be loaded from precompiled byte code (DXBC with Direct3D, SPIR-V with OpenGL).
+    \see Shader::LoadBinary
+    */
+    bool            hasShaderBinaries               = false;
+
+    /**
+    \brief Specifies whether shader class interfaces are supported, i.e. class instances with Direct3D 11 and subroutines with OpenGL 4.0+.
+    \see ShaderProgram::QueryShaderInterfaceSlot
+    \see CommandBuffer::SetShaderClassInstances
+    */
+    bool            hasShaderClassInterfaces        = false;
+
+    /**
+    \brief Specifies the number of GPU nodes, i.e. the physical GPUs of a linked adapter, that can execute command buffers. This is at least 1.
+    \see CommandBufferDescriptor::nodeIndex
+    */
+    unsigned int    numGPUNodes                     = 1;
+
     //! Specifies maximum number of texture array layers (for 1D-, 2D-, and cube textures).
     unsigned int    maxNumTextureArrayLayers        = 0;
 
     //! Specifies maximum number of attachment points for each render target.
     unsigned int    maxNumRenderTargetAttachments   = 0;
+
+    /**
+    \brief Specifies maximum number of views for multiview rendering, or 0 if multiview rendering is not supported.
+    \see GraphicsPipelineDescriptor::viewMask
+    */
+    unsigned int    maxNumViews                     = 0;
     
     //! Specifies maximum size (in bytes) of each constant buffer.
     unsigned int    maxConstantBufferSize           = 0;
 
+    /**
+    \brief Specifies maximum size (in bytes) of the push constants of each graphics pipeline, or 0 if push constants are not supported.
+    \see PushConstantsDescriptor::size
+    */
+    unsigned int    maxPushConstantsSize            = 0;
+
+    /**
+    \brief Specifies the number of threads that are executed in lockstep (also "warp" or "subgroup"), or 0 if the wave size is unknown.
+    \remarks If the wave size of the GPU varies between shaders, this is the minimal wave size.
+    \see ParallelPrimitivesDescriptor::threadGroupSize
+    */
+    unsigned int    waveSize                        = 0;
+
     //! Specifies maximum number of patch control points.
     int             maxPatchVertices                = 0;
 
@@ -317,6 +520,69 @@ struct RenderingCaps
     Gs::Vector3ui   maxComputeShaderWorkGroupSize;
 };
 
+/**
+\brief Memory information of a single memory heap.
+\see MemoryInfo
+*/
+struct MemoryHeapInfo
+{
+    /**
+    \brief Specifies the amount of memory (in bytes) the application should stay within, or 0 if the budget is unknown.
+    \remarks With Direct3D, this is the budget the operating system grants the process, which may change over time.
+    */
+    std::uint64_t   budget          = 0;
+
+    //! Specifies the amount of memory (in bytes) that is currently in use by the process.
+    std::uint64_t   currentUsage    = 0;
+};
+
+/**
+\brief Memory budget and usage information of the render system.
+\see RenderSystem::QueryMemoryInfo
+*/
+struct MemoryInfo
+{
+    //! Memory heap that is local to the GPU (i.e. video memory).
+    MemoryHeapInfo  local;
+
+    //! Memory heap that is not local to the GPU (i.e. system memory, which is visible to the GPU).
+    MemoryHeapInfo  nonLocal;
+
+    //! Specifies the amount of memory (in bytes) the render system has allocated for buffers.
+    std::uint64_t   bufferMemory        = 0;
+
+    /**
+    \brief Specifies the estimated amount of memory (in bytes) the render system has allocated for textures.
+    \remarks This includes the complete MIP-map chain of each texture, but neither texture views nor sparse textures.
+    */
+    std::uint64_t   textureMemory       = 0;
+
+    /**
+    \brief Specifies the estimated amount of memory (in bytes) the render targets have allocated internally.
+    \remarks This only includes the depth-stencil and multi-sample buffers each render target creates for itself,
+    but not the textures that are attached to render targets.
+    */
+    std::uint64_t   renderTargetMemory  = 0;
+};
+
+/**
+\brief Pair of GPU and CPU timestamps that have been sampled at the same moment.
+\remarks This is used to map GPU timestamps (e.g. from QueryType::Timestamp) onto the CPU timeline.
+Since the GPU and CPU clocks drift apart over time, a calibration should be queried again periodically (e.g. once per frame or every few seconds).
+\see RenderSystem::QueryClockCalibration
+*/
+struct ClockCalibration
+{
+    /**
+    \brief Specifies the GPU timestamp (in nanoseconds).
+    \remarks This is in the same time base as the results of timestamp queries, i.e. QueryType::Timestamp.
+    */
+    std::uint64_t   gpuTime = 0;
+
+    //! Specifies the CPU timestamp (in nanoseconds) since the epoch of std::chrono::steady_clock.
+    std::uint64_t   cpuTime = 0;
+};
+
 
 } // /namespace LLGL
 
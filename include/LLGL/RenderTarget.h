@@ -42,6 +42,32 @@ struct RenderTargetAttachmentDescriptor
     \remarks This is only used for cube textures (i.e. TextureType::TextureCube and TextureType::TextureCubeArray).
     */
     AxisDirection   cubeFace    = AxisDirection::XPos;
+
+    /**
+    \brief Number of consecutive array layers, beginning with 'layer', which are attached as views for multiview rendering. By default 1.
+    \remarks If this is greater than 1, a graphics pipeline with a non-zero view mask renders each view into its own layer
+    (i.e. view i into layer 'layer + i'), so a single draw call renders into all views at once, e.g. both eyes for stereo rendering.
+    This is only used for TextureType::Texture2DArray, and all attachments of a render target must use the same number of views.
+    Depth buffers must be attached as 2D array textures as well (see AttachTexture), since internal depth buffers only have a single layer.
+    \note Only supported with: OpenGL (requires GL_OVR_multiview), Direct3D 11 (layer selection with SV_RenderTargetArrayIndex in the shader only).
+    \see GraphicsPipelineDescriptor::viewMask
+    \see RenderingCaps::maxNumViews
+    */
+    unsigned int    numViews    = 1;
+
+    /**
+    \brief Specifies whether all array layers of the MIP-map level are attached at once for layered rendering. By default false.
+    \remarks If this is true, 'layer', 'cubeFace', and 'numViews' are ignored, and all array layers are attached,
+    i.e. all faces of cube textures (with the layer index 'cube * 6 + face' for cube array textures) and all depth slices of 3D textures.
+    Each primitive is then routed into its layer by the shader that feeds the rasterizer, i.e. with \c gl_Layer in GLSL or \c SV_RenderTargetArrayIndex in HLSL,
+    so a cube shadow map or all cascades of a shadow map array are rendered in a single pass. Primitives that do not write the layer are rendered into the first layer.
+    All attachments of a render target must be layered, so depth buffers must be attached as textures as well (see AttachTexture),
+    since internal depth buffers only have a single layer. Multi-sampled render targets require custom multi-sampling for layered attachments.
+    \note Only supported with: OpenGL, Direct3D 11, Direct3D 12.
+    \see RenderingCaps::hasLayeredRenderTargets
+    \see RenderingCaps::hasVertexShaderLayer
+    */
+    bool            layered     = false;
 };
 
 //! Render target descriptor structure.
@@ -80,7 +106,10 @@ class LLGL_EXPORT RenderTarget
         \brief Attaches an internal depth buffer to this render target.
         \param[in] size Specifies the size of the depth buffer. This must be the same as for all other attachemnts.
         \remarks Only a single depth buffer, stencil buffer, or depth-stencil buffer can be attached.
+        An internal depth buffer can not be read by a shader. To sample the depth values after rendering (e.g. for shadow maps),
+        attach a texture with a depth format instead (see AttachTexture).
         \see AttachDepthStencilBuffer
+        \see AttachTexture
         */
         virtual void AttachDepthBuffer(const Gs::Vector2ui& size) = 0;
 
@@ -102,6 +131,21 @@ class LLGL_EXPORT RenderTarget
         \brief Attaches the specified texture to this render target.
         \param[in] attachmnetDesc Specifies the attachment descriptor.
         Unused members will be ignored, e.g. the 'layer' member is ignored when a non-array texture is passed.
+        \remarks If the texture has a depth format (i.e. TextureFormat::DepthComponent or TextureFormat::DepthStencil),
+        it is attached as depth- or depth-stencil attachment, and it can be bound as texture (e.g. with CommandBuffer::SetTexture)
+        after the render target has been rendered. Only a single depth attachment can be used, i.e. this can not be combined with "AttachDepthBuffer" etc.
+        The depth texture must not be bound as texture while it is rendered into.
+        \code
+        // Create shadow map and attach it to a render target
+        LLGL::TextureDescriptor shadowMapDesc;
+        shadowMapDesc.type              = LLGL::TextureType::Texture2D;
+        shadowMapDesc.format            = LLGL::TextureFormat::DepthComponent;
+        shadowMapDesc.texture2D.width   = 1024;
+        shadowMapDesc.texture2D.height  = 1024;
+        auto shadowMap = renderer->CreateTexture(shadowMapDesc);
+        shadowMapRenderTarget->AttachTexture(*shadowMap, {});
+        \endcode
+        \note With Direct3D 11, a depth texture that is attached to a multi-sample render target must be a multi-sample texture, too.
         \note A mixed attachment of multi-sample and non-multi-sample textures to a render-target is currently only supported with: Direct3D 11.
         */
         virtual void AttachTexture(Texture& texture, const RenderTargetAttachmentDescriptor& attachmentDesc) = 0;
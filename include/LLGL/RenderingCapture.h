@@ -0,0 +1,97 @@
+/*
+ * RenderingCapture.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDERING_CAPTURE_H
+#define LLGL_RENDERING_CAPTURE_H
+
+
+#include "Export.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Rendering capture model class.
+\remarks This stores a compact binary trace of all rendering activity, which can be replayed offline with the CaptureReplay class,
+e.g. to reproduce a performance issue or to compare different render systems with an identical workload.
+If a capture is passed to RenderSystem::Load, the capture layer records the creation and release of all objects,
+all resource uploads (including the content of mapped buffers when they are unmapped),
+all shader compilations, all command buffer function calls, and every render context presentation.
+Queries of results and read-backs are not recorded, and neither are the values of shader uniforms (see ShaderProgram::LockShaderUniform).
+\code
+LLGL::RenderingCapture capture;
+auto renderer = LLGL::RenderSystem::Load("OpenGL", nullptr, nullptr, nullptr, &capture);
+// render frames ...
+capture.SaveTrace("frames.llgltrace");
+\endcode
+\note All functions of this class are thread-safe.
+\see CaptureReplay
+*/
+class LLGL_EXPORT RenderingCapture
+{
+
+    public:
+
+        //! Initializes the capture with an empty trace.
+        RenderingCapture();
+
+        RenderingCapture(const RenderingCapture&) = delete;
+        RenderingCapture& operator = (const RenderingCapture&) = delete;
+
+        /**
+        \brief Appends the specified record to the trace.
+        \remarks This is used by the capture layer, and each record must be a complete record of the trace format.
+        */
+        void AppendRecord(const void* data, std::size_t size);
+
+        //! Increments the number of captured frames. This is used by the capture layer for every render context presentation.
+        void NextFrame();
+
+        //! Returns the number of frames that have been captured so far.
+        std::uint32_t GetNumFrames() const;
+
+        //! Returns the size (in bytes) of the trace, including its header.
+        std::size_t GetSize() const;
+
+        //! Returns a copy of the trace, which can be passed to the CaptureReplay class.
+        std::vector<char> GetTrace() const;
+
+        //! Writes the trace to the specified binary output stream.
+        void WriteTrace(std::ostream& stream) const;
+
+        /**
+        \brief Saves the trace as binary file.
+        \see WriteTrace
+        \throws std::runtime_error If the file could not be opened for writing.
+        */
+        void SaveTrace(const std::string& filename) const;
+
+    private:
+
+        mutable std::mutex  mutex_;
+        std::vector<char>   data_;
+        std::uint32_t       numFrames_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
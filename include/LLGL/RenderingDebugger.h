@@ -10,8 +10,9 @@
 
 
 #include "Export.h"
-#include <map>
+#include <unordered_map>
 #include <string>
+#include <cstdint>
 
 
 namespace LLGL
@@ -31,20 +32,42 @@ enum class WarningType
     ImproperArgument,   //!< Warning due to improper argument (e.g. generating 4 vertices while having triangle list as primitive topology).
     ImproperState,      //!< Warning due to improper state (e.g. rendering while viewport is not visible).
     PointlessOperation, //!< Warning due to a operation without any effect (e.g. drawing with 0 vertices).
+    PerformanceHint,    //!< Warning due to a slow operation that is reported by the driver (e.g. a pipeline stall on a buffer update, or a shader recompilation).
 };
 
 
 /**
 \brief Rendering debugger interface.
 \remarks This can be used to profile the renderer draw calls and buffer updates.
+Messages are identified by a message ID rather than their text. The debug layer uses one ID per call site,
+so repeated messages only cost a hash map lookup, and their text is only formatted when a handler requests it.
 */
 class LLGL_EXPORT RenderingDebugger
 {
 
     public:
 
+        //! Message identifier type.
+        using MessageID = std::uint64_t;
+
+        /**
+        \brief Message text formatter.
+        \remarks The formatter refers to a callable object of the poster, and it is only valid during a call to PostError or PostWarning.
+        */
+        struct MessageFormatter
+        {
+            const void* data                    = nullptr;
+            std::string (*format)(const void*)  = nullptr;
+        };
+
         virtual ~RenderingDebugger();
-        
+
+        /**
+        \brief Returns an interned message ID for the specified key and index.
+        \remarks The debug layer uses the file name and line number of each call site as key and index.
+        */
+        static MessageID MakeMessageID(const char* key, std::uint32_t index = 0);
+
         //! Sets the new source function name.
         void SetSource(const char* source);
 
@@ -64,6 +87,33 @@ class LLGL_EXPORT RenderingDebugger
         */
         void PostWarning(const WarningType type, const std::string& message);
 
+        /**
+        \brief Posts an error message with the specified ID, whose text is only formatted when it is requested.
+        \remarks Blocked messages return immediately without formatting.
+        \see Message::GetText
+        */
+        void PostError(const ErrorType type, MessageID id, const MessageFormatter& formatter);
+
+        //! Posts a warning message with the specified ID, whose text is only formatted when it is requested.
+        void PostWarning(const WarningType type, MessageID id, const MessageFormatter& formatter);
+
+        /**
+        \brief Posts an error message with the specified ID and the callable object that formats its text.
+        \param[in] formatText Specifies the callable object that returns the message text as std::string, e.g. a lambda expression.
+        */
+        template <typename TFormatter>
+        void PostError(const ErrorType type, MessageID id, const TFormatter& formatText)
+        {
+            PostError(type, id, MakeFormatter(formatText));
+        }
+
+        //! Posts a warning message with the specified ID and the callable object that formats its text.
+        template <typename TFormatter>
+        void PostWarning(const WarningType type, MessageID id, const TFormatter& formatText)
+        {
+            PostWarning(type, id, MakeFormatter(formatText));
+        }
+
     protected:
 
         //! Rendering debugger message class.
@@ -76,7 +126,7 @@ class LLGL_EXPORT RenderingDebugger
                 Message(const Message&) = default;
                 Message& operator = (const Message&) = default;
 
-                Message(const std::string& text, const std::string& source);
+                Message(const std::string& source);
 
                 //! Blocks further occurrences of this message.
                 void Block();
@@ -84,11 +134,12 @@ class LLGL_EXPORT RenderingDebugger
                 //! Blocks further occurrences of this message after the specified amount of messages have been occurred.
                 void BlockAfter(std::size_t occurrences);
 
-                //! Returns the message text.
-                inline const std::string& GetText() const
-                {
-                    return text_;
-                }
+                /**
+                \brief Returns the message text.
+                \remarks The text is formatted on the first call within each OnError or OnWarning callback.
+                Outside of these callbacks, this returns the text that was last formatted.
+                */
+                const std::string& GetText() const;
 
                 //! Returns the source function where this message occurred.
                 inline const std::string& GetSource() const
@@ -114,12 +165,15 @@ class LLGL_EXPORT RenderingDebugger
 
                 void IncOccurrence();
 
+                void SetFormatter(const MessageFormatter& formatter);
+
             private:
 
-                std::string text_;
-                std::string source_;
-                std::size_t occurrences_    = 1;
-                bool        blocked_        = false;
+                mutable std::string         text_;
+                mutable MessageFormatter    formatter_;
+                std::string                 source_;
+                std::size_t                 occurrences_    = 1;
+                bool                        blocked_        = false;
 
         };
 
@@ -131,9 +185,25 @@ class LLGL_EXPORT RenderingDebugger
 
     private:
 
-        std::map<std::string, Message>  errors_;
-        std::map<std::string, Message>  warnings_;
-        const char*                     source_     = "";
+        template <typename TFormatter>
+        static MessageFormatter MakeFormatter(const TFormatter& formatText)
+        {
+            MessageFormatter formatter;
+            {
+                formatter.data      = &formatText;
+                formatter.format    = [](const void* data) -> std::string
+                {
+                    return (*reinterpret_cast<const TFormatter*>(data))();
+                };
+            }
+            return formatter;
+        }
+
+        Message* FindMessage(std::unordered_map<MessageID, Message>& messages, MessageID id, const MessageFormatter& formatter);
+
+        std::unordered_map<MessageID, Message>  errors_;
+        std::unordered_map<MessageID, Message>  warnings_;
+        const char*                             source_     = "";
 
 };
 
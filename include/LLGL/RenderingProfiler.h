@@ -12,6 +12,17 @@
 #include "Export.h"
 #include "RenderContextFlags.h"
 #include "GraphicsPipelineFlags.h"
+#include "TextureFlags.h"
+#include <atomic>
+#include <array>
+#include <vector>
+#include <map>
+#include <string>
+#include <tuple>
+#include <mutex>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
 
 
 namespace LLGL
@@ -21,13 +32,47 @@ namespace LLGL
 /**
 \brief Rendering profiler model class.
 \remarks This can be used to profile the renderer draw calls and buffer updates.
+All counters can be incremented concurrently from multiple threads (e.g. by command buffers which are recorded on worker threads).
+If "NextFrame" is called once every frame, the profiler also keeps a history of the counter values and frame times of the most recent frames:
+\code
+LLGL::RenderingProfiler profiler;
+auto renderer = LLGL::RenderSystem::Load("OpenGL", &profiler);
+auto timer = LLGL::Timer::Create();
+while (...)
+{
+    timer->MeasureTime();
+    // render frame ...
+    profiler.NextFrame(timer->GetDeltaTime());
+}
+auto frameTimeStats = profiler.GetFrameTimeStatistics();
+\endcode
+The debug layer also detects wasted work, i.e. commands which have no effect (see WastedWorkType).
+Each occurrence increments one of the wasted-work counters and is recorded together with the command name and the call-site tag of the calling thread,
+so the worst offenders can be queried with "GetTopWastedWork":
+\code
+LLGL::RenderingProfiler::SetCallSiteTag("ShadowPass");
+// record shadow pass ...
+LLGL::RenderingProfiler::SetCallSiteTag(nullptr);
+for (const auto& record : profiler.GetTopWastedWork(10))
+    std::cout << record.command << " [" << record.callSite << "]: " << record.count << std::endl;
+\endcode
+Moreover, the debug layer records the estimated GPU memory of all buffers, textures, and render targets when they are created and released.
+The memory is accounted by resource type, texture format, and the call-site tag that was active when the resource was created:
+\code
+LLGL::RenderingProfiler::SetCallSiteTag("Terrain");
+// create terrain textures and buffers ...
+LLGL::RenderingProfiler::SetCallSiteTag(nullptr);
+geometryAllocator.ReportMemoryUsage(profiler, "SceneGeometry");
+profiler.WriteMemoryReport(std::cout);
+\endcode
+\note If a profiler but no debugger is passed to RenderSystem::Load, the debug layer only counts the commands but does not validate them.
 */
 class LLGL_EXPORT RenderingProfiler
 {
 
     public:
 
-        //! Profiling counter class.
+        //! Profiling counter class. All functions of this class are lock-free and can be called concurrently.
         class LLGL_EXPORT Counter
         {
 
@@ -35,29 +80,34 @@ class LLGL_EXPORT RenderingProfiler
 
                 using ValueType = unsigned int;
 
+                Counter() = default;
+
+                Counter(const Counter&) = delete;
+                Counter& operator = (const Counter&) = delete;
+
                 //! Increment internal counter by one.
-                void Inc()
+                inline void Inc()
                 {
-                    ++value_;
+                    Inc(1);
                 }
 
                 //! Increment internal counter by the specified value.
-                void Inc(ValueType value)
+                inline void Inc(ValueType value)
                 {
-                    value_ += value;
+                    shards_[GetThreadShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
                 }
 
                 //! Reset internal counter to zero.
-                void Reset()
-                {
-                    value_ = 0;
-                }
+                void Reset();
 
-                //! Returns the internal counter value.
-                inline ValueType Count() const
-                {
-                    return value_;
-                }
+                /**
+                \brief Returns the internal counter value and resets it to zero in a single atomic operation per shard.
+                \remarks Increments from other threads, which happen during this call, are either included in the returned value or remain in the counter, but are never lost.
+                */
+                ValueType Flush();
+
+                //! Returns the internal counter value, i.e. the sum of all per-thread shards.
+                ValueType Count() const;
 
                 //! Returns the internal counter value (same as "Count()" function).
                 inline operator unsigned int () const
@@ -67,10 +117,142 @@ class LLGL_EXPORT RenderingProfiler
 
             private:
 
-                ValueType value_ = 0;
+                // Number of shards. Each thread is assigned to one shard, so threads rarely increment the same cache line.
+                static const std::size_t numShards = 8;
+
+                // Returns the shard index of the calling thread.
+                static std::size_t GetThreadShardIndex();
+
+                struct alignas(64) Shard
+                {
+                    std::atomic<ValueType> value { 0 };
+                };
+
+                Shard shards_[numShards];
+
+        };
+
+        //! Number of counters in this profiler.
+        static const std::size_t numCounters = 23;
+
+        //! Categories of wasted work, which is detected by the debug layer.
+        enum class WastedWorkType
+        {
+            RedundantBinding,       //!< The same pipeline, buffer, texture, sampler, or render target has been bound again.
+            RedundantClear,         //!< All attachments of a clear command have already been cleared since the last draw call.
+            EmptyDraw,              //!< A draw call with zero vertices or zero instances.
+            RedundantBufferWrite,   //!< A constant buffer has been written with the contents it already has.
+        };
+
+        //! Number of occurrences of wasted work at a single call site.
+        struct WastedWorkRecord
+        {
+            WastedWorkType      type        = WastedWorkType::RedundantBinding; //!< Category of the wasted work.
+            const char*         command     = "";                               //!< Name of the command (e.g. "SetGraphicsPipeline").
+            std::string         callSite;                                       //!< Call-site tag, which was active when the command was recorded. \see SetCallSiteTag
+            Counter::ValueType  count       = 0;                                //!< Number of occurrences.
+        };
+
+        //! Categories of GPU memory, which is tracked by the debug layer.
+        enum class MemoryType
+        {
+            Buffer,         //!< Memory of Buffer objects.
+            Texture,        //!< Memory of Texture objects, including their full MIP-map chains.
+            RenderTarget,   //!< Memory of the depth-stencil buffers, which are allocated by RenderTarget objects themselves.
+        };
+
+        //! Number of memory types.
+        static const std::size_t numMemoryTypes = 3;
 
+        /**
+        \brief Single GPU memory allocation.
+        \remarks The size is only an estimate, since the alignment and padding of the driver are unknown.
+        \see RecordAllocation
+        */
+        struct MemoryAllocation
+        {
+            MemoryType      type    = MemoryType::Buffer;       //!< Resource type of the allocation.
+            TextureFormat   format  = TextureFormat::Unknown;   //!< Texture format of the allocation, or TextureFormat::Unknown for buffers.
+            std::uint64_t   size    = 0;                        //!< Estimated size (in bytes).
+            std::string     tag;                                //!< Call-site tag, which was active when the resource was created. \see SetCallSiteTag
         };
 
+        //! Accumulated size of multiple allocations.
+        struct MemoryUsage
+        {
+            std::uint64_t   bytes           = 0;    //!< Estimated size (in bytes) of all allocations.
+            std::size_t     numAllocations  = 0;    //!< Number of allocations.
+        };
+
+        //! Usage of a suballocator, which hands out ranges of a larger allocation (e.g. GeometryAllocator).
+        struct SuballocatorUsage
+        {
+            std::uint64_t   capacity            = 0;    //!< Number of elements (e.g. bytes or vertices) of the entire allocation.
+            std::uint64_t   used                = 0;    //!< Number of elements, which are currently allocated.
+            std::uint64_t   largestFreeBlock    = 0;    //!< Number of elements of the largest contiguous free range.
+
+            /**
+            \brief Returns the fragmentation of the free elements in the range [0, 1].
+            \remarks This is 0 if all free elements are contiguous, and approaches 1 the more the free elements are scattered into small ranges.
+            */
+            double GetFragmentation() const;
+        };
+
+        //! Snapshot of the GPU memory, which is tracked by the profiler.
+        struct MemoryReport
+        {
+            MemoryUsage                                 total;                          //!< Usage of all allocations.
+            std::uint64_t                               peakBytes           = 0;        //!< Maximal total size (in bytes) since the last call to "ResetPeakMemory".
+            MemoryUsage                                 types[numMemoryTypes];          //!< Usage per memory type. \see MemoryType
+            std::map<TextureFormat, MemoryUsage>        formats;                        //!< Usage per texture format (textures and render targets only).
+            std::map<std::string, MemoryUsage>          tags;                           //!< Usage per call-site tag. Allocations without tag have an empty string.
+            std::map<std::string, SuballocatorUsage>    suballocators;                  //!< Most recent usage of each suballocator by name. \see ReportSuballocator
+        };
+
+        //! Counter values and frame time of a single frame.
+        struct FrameRecord
+        {
+            //! Frame time (in seconds), which has been passed to "NextFrame".
+            double                                      frameTime   = 0.0;
+
+            //! Counter values of this frame. The indices correspond to the counter indices (see "GetCounter").
+            std::array<Counter::ValueType, numCounters> counters;
+
+            //! High-water mark (in bytes) of the tracked GPU memory during this frame. \see MemoryReport
+            std::uint64_t                               peakMemory  = 0;
+        };
+
+        //! Minimum, average, and 99th percentile of a value over the recorded frame history.
+        struct FrameStatistics
+        {
+            double      min         = 0.0;  //!< Minimum value.
+            double      avg         = 0.0;  //!< Average value.
+            double      p99         = 0.0;  //!< 99th percentile, i.e. 99% of the values are less than or equal to this value.
+            std::size_t numFrames   = 0;    //!< Number of frames these statistics have been computed from.
+        };
+
+        /**
+        \brief Hit and miss counts of a single category of the state cache of a render system.
+        \see RenderSystem::ReportStateCacheStatistics
+        */
+        struct StateCacheUsage
+        {
+            std::uint64_t   hits    = 0;    //!< Number of state changes, which have been filtered out because the state was already set.
+            std::uint64_t   misses  = 0;    //!< Number of state changes, which have been submitted to the graphics API.
+
+            //! Returns the ratio of hits to all state changes in the range [0, 1], or 0 if there were no state changes.
+            double GetHitRate() const;
+        };
+
+        /**
+        \brief Initializes the profiler with the specified size of the frame history.
+        \param[in] frameHistorySize Specifies the maximal number of frames, which are kept in the history. By default 128.
+        */
+        RenderingProfiler(std::size_t frameHistorySize = 128);
+
+        RenderingProfiler(const RenderingProfiler&) = delete;
+        RenderingProfiler& operator = (const RenderingProfiler&) = delete;
+
         /**
         \brief Resets all counters.
         \see Counter::Reset
@@ -80,6 +262,126 @@ class LLGL_EXPORT RenderingProfiler
         void RecordDrawCall(const PrimitiveTopology topology, Counter::ValueType numVertices);
         void RecordDrawCall(const PrimitiveTopology topology, Counter::ValueType numVertices, Counter::ValueType numInstances);
 
+        /**
+        \brief Records one occurrence of wasted work: increments the respective counter and the entry of the current call site.
+        \param[in] type Specifies the category of the wasted work.
+        \param[in] command Specifies the name of the command. This must be a string literal, since only the pointer is stored.
+        \remarks This is called by the debug layer and can be called concurrently.
+        */
+        void RecordWastedWork(const WastedWorkType type, const char* command);
+
+        /**
+        \brief Returns the call sites with the most occurrences of wasted work since the last call to "ClearWastedWork", in descending order.
+        \param[in] maxCount Specifies the maximal number of records.
+        \remarks The per-frame number of occurrences is available through the counters "redundantBindings", "redundantClears", "emptyDraws", and "redundantBufferWrites".
+        */
+        std::vector<WastedWorkRecord> GetTopWastedWork(std::size_t maxCount) const;
+
+        //! Removes all wasted-work records. This does not reset the counters.
+        void ClearWastedWork();
+
+        /**
+        \brief Adds the specified allocation to the tracked GPU memory.
+        \remarks This is called by the debug layer whenever a resource is created.
+        The same allocation must be passed to "RecordRelease" when the resource is released.
+        */
+        void RecordAllocation(const MemoryAllocation& allocation);
+
+        //! Removes the specified allocation from the tracked GPU memory. \see RecordAllocation
+        void RecordRelease(const MemoryAllocation& allocation);
+
+        /**
+        \brief Stores the current usage of the specified suballocator, which is included in all subsequent memory reports.
+        \param[in] name Specifies the unique name of the suballocator.
+        \param[in] usage Specifies the current usage. This replaces the previous usage of the same suballocator.
+        \see GeometryAllocator::ReportMemoryUsage
+        */
+        void ReportSuballocator(const std::string& name, const SuballocatorUsage& usage);
+
+        //! Returns a snapshot of the tracked GPU memory.
+        MemoryReport GetMemoryReport() const;
+
+        //! Resets the peak memory of the memory report to the current total size.
+        void ResetPeakMemory();
+
+        /**
+        \brief Writes the current memory report in a human readable form to the specified output stream.
+        \remarks The tags and texture formats are sorted by their size in descending order, so the largest consumers are listed first.
+        */
+        void WriteMemoryReport(std::ostream& stream) const;
+
+        /**
+        \brief Adds the specified hit and miss counts to the state cache statistics of the specified category.
+        \param[in] category Specifies the name of the state cache category (e.g. "Texture").
+        \param[in] usage Specifies the counts, which are added to the previous counts of the same category.
+        \remarks This is called by the render system. \see RenderSystem::ReportStateCacheStatistics
+        */
+        void ReportStateCache(const std::string& category, const StateCacheUsage& usage);
+
+        //! Returns the accumulated state cache statistics of all categories.
+        std::map<std::string, StateCacheUsage> GetStateCacheReport() const;
+
+        //! Resets the accumulated state cache statistics of all categories.
+        void ResetStateCacheReport();
+
+        /**
+        \brief Sets the call-site tag of the calling thread, which is recorded with all subsequent wasted work and resource allocations on this thread.
+        \param[in] tag Specifies the new tag, e.g. the name of a render pass. This can be null to clear the tag.
+        The string is copied only when wasted work is recorded, so it must remain valid until the tag is changed again.
+        */
+        static void SetCallSiteTag(const char* tag);
+
+        //! Returns the call-site tag of the calling thread, or null if no tag has been set.
+        static const char* GetCallSiteTag();
+
+        /**
+        \brief Ends the current frame: moves the values of all counters into the frame history and resets the counters.
+        \param[in] frameTime Specifies the elapsed time (in seconds) of the current frame, e.g. Timer::GetDeltaTime.
+        \remarks If the frame history is full, the oldest frame is overwritten. Call this once every frame instead of "ResetCounters".
+        \see Counter::Flush
+        */
+        void NextFrame(double frameTime);
+
+        //! Removes all frames from the history.
+        void ClearFrameHistory();
+
+        //! Returns the number of frames which are currently stored in the history.
+        inline std::size_t GetNumFrames() const
+        {
+            return numFrames_;
+        }
+
+        /**
+        \brief Returns the specified frame of the history.
+        \param[in] index Specifies the frame index, where 0 is the oldest frame and "GetNumFrames() - 1" is the most recent frame.
+        \throws std::out_of_range If 'index' is out of range.
+        */
+        const FrameRecord& GetFrame(std::size_t index) const;
+
+        //! Returns the statistics of the frame times (in seconds) over the frame history.
+        FrameStatistics GetFrameTimeStatistics() const;
+
+        /**
+        \brief Returns the statistics of the specified counter over the frame history.
+        \param[in] counterIndex Specifies the counter index. This must be less than "numCounters".
+        \throws std::out_of_range If 'counterIndex' is out of range.
+        */
+        FrameStatistics GetCounterStatistics(std::size_t counterIndex) const;
+
+        /**
+        \brief Returns the specified counter.
+        \param[in] counterIndex Specifies the counter index. This must be less than "numCounters".
+        The counters are indexed in the order of their declaration, i.e. 0 is "writeBuffer" and 22 is "redundantBufferWrites".
+        \throws std::out_of_range If 'counterIndex' is out of range.
+        */
+        const Counter& GetCounter(std::size_t counterIndex) const;
+
+        /**
+        \brief Returns the name of the specified counter (e.g. "drawCalls"), or null if 'counterIndex' is out of range.
+        \remarks This can be used to export the counters, e.g. into a log file.
+        */
+        static const char* GetCounterName(std::size_t counterIndex);
+
         Counter writeBuffer;            //!< Counter for buffer writings. \see RenderSystem::WriteBuffer
         Counter mapBuffer;              //!< Counter for buffer mappings. \see RenderSystem::MapBuffer
 
@@ -92,6 +394,7 @@ class LLGL_EXPORT RenderingProfiler
         Counter setComputePipeline;     //!< Counter for compute pipeline bindings. \see CommandBuffer::SetComputePipeline
         Counter setTexture;             //!< Counter for texture bindings. \see CommandBuffer::SetTexture
         Counter setSampler;             //!< Counter for sampler bindings. \see CommandBuffer::SetSampler
+        Counter setResourceHeap;        //!< Counter for resource heap bindings. \see CommandBuffer::SetResourceHeap
         Counter setRenderTarget;        //!< Counter for render target bindings. \see CommandBuffer::SetRenderTarget
 
         /**
@@ -109,6 +412,32 @@ class LLGL_EXPORT RenderingProfiler
         Counter renderedTriangles;      //!< Counter for rendered triangle primitives.
         Counter renderedPatches;        //!< Counter for rendered patch primitives.
 
+        Counter redundantBindings;      //!< Counter for bindings of the same object at the same slot. \see WastedWorkType::RedundantBinding
+        Counter redundantClears;        //!< Counter for clears of already cleared attachments. \see WastedWorkType::RedundantClear
+        Counter emptyDraws;             //!< Counter for draw calls with zero vertices or zero instances. \see WastedWorkType::EmptyDraw
+        Counter redundantBufferWrites;  //!< Counter for constant buffer writes with unchanged contents. \see WastedWorkType::RedundantBufferWrite
+
+    private:
+
+        using WastedWorkKey = std::tuple<WastedWorkType, const char*, std::string>;
+
+        template <typename TGetter>
+        FrameStatistics ComputeStatistics(TGetter getter) const;
+
+        std::vector<FrameRecord>    frames_;
+        std::size_t                 firstFrame_ = 0;
+        std::size_t                 numFrames_  = 0;
+
+        mutable std::mutex                              wastedWorkMutex_;
+        std::map<WastedWorkKey, Counter::ValueType>     wastedWork_;
+
+        mutable std::mutex                              memoryMutex_;
+        MemoryReport                                    memory_;
+        std::uint64_t                                   framePeakMemory_    = 0;
+
+        mutable std::mutex                              stateCacheMutex_;
+        std::map<std::string, StateCacheUsage>          stateCache_;
+
 };
 
 
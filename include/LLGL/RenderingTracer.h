@@ -0,0 +1,237 @@
+/*
+ * RenderingTracer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDERING_TRACER_H
+#define LLGL_RENDERING_TRACER_H
+
+
+#include "Export.h"
+#include "RenderSystemFlags.h"
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <functional>
+#include <ostream>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+struct GPUProfilerFrame;
+
+
+/* ----- Enumerations ----- */
+
+//! Trace event category enumeration.
+enum class TraceCategory
+{
+    CommandBuffer,  //!< Command buffer function call (e.g. CommandBuffer::Draw).
+    RenderSystem,   //!< Render system function call (e.g. RenderSystem::CreateBuffer).
+    Shader,         //!< Shader compilation (e.g. Shader::Compile).
+    Present,        //!< Presentation of a render context (see RenderContext::Present).
+    GPU,            //!< GPU scope timing (see RenderingTracer::RecordGPUFrame).
+    User,           //!< User defined event.
+};
+
+
+/* ----- Structures ----- */
+
+//! Trace event structure. Each event describes a time span on either the CPU or the GPU timeline.
+struct TraceEvent
+{
+    //! Name of the event (e.g. the name of the function call).
+    std::string     name;
+
+    //! Category of the event.
+    TraceCategory   category    = TraceCategory::User;
+
+    //! Start time (in nanoseconds) relative to the creation of the tracer.
+    std::uint64_t   startTime   = 0;
+
+    //! Duration (in nanoseconds) of the event.
+    std::uint64_t   duration    = 0;
+
+    /**
+    \brief Zero-based index of the thread which recorded the event. Threads are indexed in the order of their first recorded event.
+    \remarks For GPU events, this is always 0.
+    */
+    std::uint32_t   threadIndex = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Rendering tracer model class.
+\remarks This records timestamped events for a timeline view of the rendering activity.
+If a tracer is passed to RenderSystem::Load, the debug layer records an event for every command buffer function call,
+every create and release function call of the render system, every shader compilation, and every render context presentation.
+Without the debug layer (e.g. in release builds), events can still be recorded with the TraceScope class and GPU timings with "RecordGPUFrame".
+The recorded events can be saved as Chrome trace file (which can be viewed with "chrome://tracing", Perfetto, or be imported by Tracy),
+or they can be streamed to another profiler with an event callback.
+\code
+LLGL::RenderingTracer tracer;
+auto renderer = LLGL::RenderSystem::Load("OpenGL", nullptr, nullptr, &tracer);
+// render frames ...
+tracer.SaveChromeTrace("trace.json");
+\endcode
+\note All functions of this class are thread-safe.
+*/
+class LLGL_EXPORT RenderingTracer
+{
+
+    public:
+
+        //! Event callback function interface, which is called for every recorded event.
+        using EventCallback = std::function<void(const TraceEvent& event)>;
+
+        RenderingTracer();
+
+        RenderingTracer(const RenderingTracer&) = delete;
+        RenderingTracer& operator = (const RenderingTracer&) = delete;
+
+        //! Returns the current CPU time (in nanoseconds), relative to the creation of this tracer.
+        std::uint64_t GetTime() const;
+
+        /**
+        \brief Records a CPU event of the calling thread.
+        \param[in] name Specifies the name of the event. This must not be null.
+        \param[in] category Specifies the event category.
+        \param[in] startTime Specifies the start time (in nanoseconds), which has previously been returned by "GetTime".
+        \param[in] endTime Specifies the end time (in nanoseconds), which has previously been returned by "GetTime".
+        \see TraceScope
+        */
+        void RecordEvent(const char* name, const TraceCategory category, std::uint64_t startTime, std::uint64_t endTime);
+
+        /**
+        \brief Records the scope timings of the specified GPU profiler frame on the GPU timeline.
+        \param[in] frame Specifies the resolved GPU profiler frame.
+        \param[in] cpuStartTime Specifies the CPU time (in nanoseconds), at which the frame has been started with GPUProfiler::BeginFrame.
+        This is only used if no clock calibration has been set.
+        \remarks Since the GPU has its own clock, the GPU timeline is aligned to the CPU timeline by the start of each frame,
+        unless a clock calibration has been set. In that case, the GPU start timestamp of the frame is mapped onto the CPU timeline,
+        so the GPU events show when the GPU actually executed the commands, i.e. including the latency between CPU and GPU.
+        \see GPUProfiler::GetResolvedFrame
+        \see SetClockCalibration
+        */
+        void RecordGPUFrame(const GPUProfilerFrame& frame, std::uint64_t cpuStartTime);
+
+        /**
+        \brief Sets the clock calibration to map GPU timestamps onto the CPU timeline of this tracer.
+        \remarks The calibration should be updated periodically (e.g. once per frame), because the GPU and CPU clocks drift apart over time.
+        \see RenderSystem::QueryClockCalibration
+        */
+        void SetClockCalibration(const ClockCalibration& calibration);
+
+        /**
+        \brief Sets the event callback, which is called for every recorded event. By default null.
+        \param[in] callback Specifies the new callback, or null to disable it.
+        \param[in] storeEvents Specifies whether the events are also stored, so they can be saved with "SaveChromeTrace". By default true.
+        \remarks The callback can be used to stream the events to another profiler while the application is running.
+        It is called by the thread which recorded the event, while the tracer is locked, i.e. the callback must not record events by itself.
+        */
+        void SetEventCallback(const EventCallback& callback, bool storeEvents = true);
+
+        //! Returns a copy of all events that have been stored so far.
+        std::vector<TraceEvent> GetEvents() const;
+
+        //! Removes all stored events.
+        void Clear();
+
+        /**
+        \brief Writes all stored events in the Chrome trace event format (JSON) to the specified output stream.
+        \remarks CPU events are written with process ID 0 and the thread index as thread ID. GPU events are written with process ID 1.
+        */
+        void WriteChromeTrace(std::ostream& stream) const;
+
+        /**
+        \brief Saves all stored events as Chrome trace file.
+        \see WriteChromeTrace
+        \throws std::runtime_error If the file could not be opened for writing.
+        */
+        void SaveChromeTrace(const std::string& filename) const;
+
+    private:
+
+        void PostEvent(TraceEvent&& event);
+
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point       startTime_;
+
+        mutable std::mutex      mutex_;
+        std::vector<TraceEvent> events_;
+        EventCallback           callback_;
+        bool                    storeEvents_    = true;
+
+        ClockCalibration        calibration_;
+        bool                    hasCalibration_ = false;
+
+};
+
+/**
+\brief Trace scope class, which records a CPU event from its construction until its destruction.
+\remarks This does nothing if the tracer is null, so the scopes can always be compiled in.
+\code
+void UpdateShadowMaps(LLGL::RenderingTracer* tracer)
+{
+    LLGL::TraceScope scope { tracer, "UpdateShadowMaps" };
+    // ...
+}
+\endcode
+*/
+class TraceScope
+{
+
+    public:
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator = (const TraceScope&) = delete;
+
+        /**
+        \brief Begins the trace scope.
+        \param[in] tracer Specifies the optional tracer. If this is null, no event is recorded.
+        \param[in] name Specifies the event name. This must remain valid until the scope is destroyed.
+        \param[in] category Specifies the event category. By default TraceCategory::User.
+        */
+        inline TraceScope(RenderingTracer* tracer, const char* name, const TraceCategory category = TraceCategory::User) :
+            tracer_   { tracer   },
+            name_     { name     },
+            category_ { category }
+        {
+            if (tracer_)
+                startTime_ = tracer_->GetTime();
+        }
+
+        //! Ends the trace scope and records the event.
+        inline ~TraceScope()
+        {
+            if (tracer_)
+                tracer_->RecordEvent(name_, category_, startTime_, tracer_->GetTime());
+        }
+
+    private:
+
+        RenderingTracer*    tracer_     = nullptr;
+        const char*         name_       = nullptr;
+        TraceCategory       category_   = TraceCategory::User;
+        std::uint64_t       startTime_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
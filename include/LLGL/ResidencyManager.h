@@ -0,0 +1,197 @@
+/*
+ * ResidencyManager.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RESIDENCY_MANAGER_H
+#define LLGL_RESIDENCY_MANAGER_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Residency manager descriptor structure.
+\see ResidencyManager
+*/
+struct ResidencyManagerDescriptor
+{
+    /**
+    \brief Specifies the video memory budget (in bytes) for all registered resources, or 0 to use the budget of the driver. By default 0.
+    \remarks If this is 0, the budget and current usage of the local memory heap are queried with RenderSystem::QueryMemoryInfo once per frame.
+    If the driver does not report a budget either, no resource is ever evicted.
+    */
+    std::uint64_t   budget                  = 0;
+
+    /**
+    \brief Specifies the fraction of the budget the usage is reduced to, once it has exceeded the budget. By default 0.9.
+    \remarks A value below 1 keeps the manager from evicting a resource with every frame when the usage is close to the budget.
+    */
+    float           targetRatio             = 0.9f;
+
+    //! Specifies the number of frames a resource must not have been used before it can be evicted. By default 3.
+    std::uint32_t   minUnusedFrames         = 3;
+
+    /**
+    \brief Specifies the maximal number of resources that are evicted or demoted per frame, or 0 for no limit. By default 64.
+    \remarks This spreads the eviction over several frames, so performance degrades gradually when video memory is oversubscribed.
+    */
+    std::uint32_t   maxEvictionsPerFrame    = 64;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Manager for the residency of buffers and textures under a video memory budget.
+\remarks Registered resources are tagged with the frame they have been used in last (see MarkUsed).
+Once the usage exceeds the budget, the least recently used resources are evicted from video memory with RenderSystem::SetResidency,
+or, for textures that can not be evicted by the render system, demoted by the application (e.g. by dropping their high-resolution MIP-map levels).
+Evicted and demoted resources are restored as soon as they are used again.
+\code
+LLGL::ResidencyManager residency(*renderer);
+residency.Register(*texture, textureSize, [&](LLGL::Texture& texture, bool demote) -> std::uint64_t {
+    // Drop or restore the high-resolution MIP-map levels, e.g. via LLGL::UploadQueue ...
+    return (demote ? releasedSize : 0);
+});
+
+// Once per frame
+residency.MarkUsed(*texture);
+commands->SetTexture(*texture, 0);
+// ...
+residency.NextFrame();
+\endcode
+\note This class is not thread safe; it must be used on the thread the render system is used with.
+*/
+class LLGL_EXPORT ResidencyManager
+{
+
+    public:
+
+        /**
+        \brief Callback to demote or restore a texture that can not be evicted by the render system.
+        \param[in] texture Specifies the texture that is to be demoted or restored.
+        \param[in] demote Specifies whether the texture is to be demoted (true) or restored (false).
+        \return Number of bytes of video memory that have been released by the demotion. The return value is ignored for restorations.
+        */
+        using DemoteCallback = std::function<std::uint64_t(Texture& texture, bool demote)>;
+
+        ResidencyManager(const ResidencyManager&) = delete;
+        ResidencyManager& operator = (const ResidencyManager&) = delete;
+
+        //! Initializes the residency manager for the specified render system.
+        ResidencyManager(RenderSystem& renderSystem, const ResidencyManagerDescriptor& desc = {});
+
+        //! Registers the specified buffer with its size (in bytes). Registering a resource again only updates its size.
+        void Register(Buffer& buffer, std::uint64_t size);
+
+        /**
+        \brief Registers the specified texture with its size (in bytes) and an optional demotion callback.
+        \remarks The callback is only invoked if the render system can not evict the texture (see RenderSystem::SetResidency).
+        Textures that can neither be evicted nor demoted remain resident.
+        */
+        void Register(Texture& texture, std::uint64_t size, const DemoteCallback& demoteCallback = nullptr);
+
+        //! Unregisters the specified buffer. This must be called before the buffer is released.
+        void Unregister(Buffer& buffer);
+
+        //! Unregisters the specified texture. This must be called before the texture is released.
+        void Unregister(Texture& texture);
+
+        /**
+        \brief Marks the specified buffer as used in the current frame, e.g. right before it is bound with CommandBuffer::SetVertexBuffer.
+        \return True if the buffer has been evicted and was made resident again, i.e. its contents have been paged in from system memory.
+        \remarks Unregistered buffers are ignored.
+        */
+        bool MarkUsed(Buffer& buffer);
+
+        /**
+        \brief Marks the specified texture as used in the current frame, e.g. right before it is bound with CommandBuffer::SetTexture.
+        \return True if the texture has been evicted or demoted and was restored.
+        \remarks A demoted texture is restored with its demotion callback, which might only schedule the upload of the dropped MIP-map levels.
+        Unregistered textures are ignored.
+        */
+        bool MarkUsed(Texture& texture);
+
+        /**
+        \brief Evicts or demotes the least recently used resources while the usage exceeds the budget, and starts a new frame.
+        \remarks This must be called once per frame, after all resources of the frame have been marked as used.
+        */
+        void NextFrame();
+
+        //! Returns the total size (in bytes) of all registered resources that are currently resident.
+        inline std::uint64_t GetResidentSize() const
+        {
+            return residentSize_;
+        }
+
+        //! Returns the total size (in bytes) of all registered resources that are currently evicted or demoted.
+        inline std::uint64_t GetEvictedSize() const
+        {
+            return evictedSize_;
+        }
+
+        //! Returns the number of the current frame, which starts with 0.
+        inline std::uint64_t GetFrame() const
+        {
+            return frame_;
+        }
+
+    private:
+
+        enum class State
+        {
+            Resident,
+            Evicted,
+            Demoted,
+        };
+
+        struct Entry
+        {
+            Buffer*         buffer          = nullptr;
+            Texture*        texture         = nullptr;
+            std::uint64_t   size            = 0;
+            std::uint64_t   releasedSize    = 0;    // size that has been released by eviction or demotion
+            std::uint64_t   lastFrame       = 0;
+            State           state           = State::Resident;
+            DemoteCallback  demoteCallback;
+        };
+
+        void Register(const void* resource, const Entry& entry);
+        void Unregister(const void* resource);
+
+        bool Restore(Entry& entry);
+        bool Evict(Entry& entry);
+
+        RenderSystem&                               renderSystem_;
+        ResidencyManagerDescriptor                  desc_;
+
+        std::unordered_map<const void*, Entry>      entries_;
+        std::uint64_t                               residentSize_   = 0;
+        std::uint64_t                               evictedSize_    = 0;
+        std::uint64_t                               frame_          = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,54 @@
+/*
+ * ResourceHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RESOURCE_HEAP_H
+#define LLGL_RESOURCE_HEAP_H
+
+
+#include "Export.h"
+#include "ResourceHeapFlags.h"
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Resource heap interface.
+\remarks A resource heap is an immutable set of resource bindings (also "descriptor set"),
+which is translated into the native binding commands of the respective render system once at creation time.
+All resources of a resource heap must stay alive as long as the resource heap is used.
+\see RenderSystem::CreateResourceHeap
+\see CommandBuffer::SetResourceHeap
+*/
+class LLGL_EXPORT ResourceHeap
+{
+
+    public:
+
+        ResourceHeap(const ResourceHeap&) = delete;
+        ResourceHeap& operator = (const ResourceHeap&) = delete;
+
+        virtual ~ResourceHeap()
+        {
+        }
+
+    protected:
+
+        ResourceHeap() = default;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,86 @@
+/*
+ * ResourceHeapFlags.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RESOURCE_HEAP_FLAGS_H
+#define LLGL_RESOURCE_HEAP_FLAGS_H
+
+
+#include "Export.h"
+#include "ShaderFlags.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class Buffer;
+class Texture;
+class Sampler;
+
+/* ----- Enumerations ----- */
+
+//! Resource type enumeration for the bindings of a resource heap.
+enum class ResourceType
+{
+    Undefined,      //!< Undefined resource type.
+    ConstantBuffer, //!< Constant buffer resource, i.e. a buffer of type BufferType::Constant.
+    StorageBuffer,  //!< Storage buffer resource, i.e. a buffer of type BufferType::Storage.
+    Texture,        //!< Texture resource.
+    Sampler,        //!< Sampler state resource.
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Resource view descriptor structure.
+\remarks This structure describes a single binding of a resource heap,
+i.e. the resource, the slot index, and the shader stages where the resource is to be bound.
+Only the resource pointer that corresponds to the resource type must be specified, i.e.
+'buffer' for ResourceType::ConstantBuffer and ResourceType::StorageBuffer, 'texture' for ResourceType::Texture, and 'sampler' for ResourceType::Sampler.
+\see ResourceHeapDescriptor
+*/
+struct ResourceViewDescriptor
+{
+    ResourceType    type                = ResourceType::Undefined;      //!< Resource type. By default ResourceType::Undefined.
+    unsigned int    slot                = 0;                            //!< Slot index where the resource is to be bound. By default 0.
+
+    /**
+    \brief Specifies at which shader stages the resource is to be bound. By default ShaderStageFlags::AllStages.
+    \remarks This is the same as the 'shaderStageFlags' parameter of the CommandBuffer::Set... functions,
+    e.g. ShaderStageFlags::ReadOnlyResource can be used to bind the SRV of a storage buffer instead of its UAV.
+    \see ShaderStageFlags
+    */
+    long            shaderStageFlags    = ShaderStageFlags::AllStages;
+
+    Buffer*         buffer              = nullptr;                      //!< Pointer to the buffer for constant and storage buffer bindings.
+    Texture*        texture             = nullptr;                      //!< Pointer to the texture for texture bindings.
+    Sampler*        sampler             = nullptr;                      //!< Pointer to the sampler for sampler bindings.
+};
+
+/**
+\brief Resource heap descriptor structure.
+\remarks A resource heap can mix constant buffers, storage buffers, textures, and samplers,
+which are all bound with a single call to CommandBuffer::SetResourceHeap.
+\see RenderSystem::CreateResourceHeap
+*/
+struct ResourceHeapDescriptor
+{
+    //! List of all resource bindings. Each slot index must only be used once per resource type.
+    std::vector<ResourceViewDescriptor> resourceViews;
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
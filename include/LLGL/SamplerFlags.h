@@ -64,6 +64,12 @@ struct LLGL_EXPORT SamplerDescriptor
 };
 
 
+/* ----- Operators ----- */
+
+LLGL_EXPORT bool operator == (const SamplerDescriptor& lhs, const SamplerDescriptor& rhs);
+LLGL_EXPORT bool operator != (const SamplerDescriptor& lhs, const SamplerDescriptor& rhs);
+
+
 } // /namespace LLGL
 
 
@@ -11,6 +11,7 @@
 
 #include "Export.h"
 #include "ShaderFlags.h"
+#include <future>
 
 
 namespace LLGL
@@ -39,11 +40,28 @@ class LLGL_EXPORT Shader
         */
         virtual bool Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) = 0;
 
+        /**
+        \brief Compiles the specified shader source asynchronously.
+        \param[in] sourceCode Specifies the shader source code which is to be compiled.
+        \param[in] shaderDesc Specifies the shader descriptor.
+        \return Future of the compilation result, i.e. the same value "Compile" would return.
+        \remarks The shader must not be used (e.g. attached to a shader program) before the future is ready.
+        With Direct3D 11 and Direct3D 12, the shader is compiled on a worker thread of the render system.
+        With OpenGL, the compilation is only dispatched to the driver (if GL_ARB_parallel_shader_compile is supported)
+        and the returned future is deferred, i.e. it must be resolved with "get" on the thread that owns the GL context.
+        If asynchronous compilation is not supported, the shader is compiled immediately and the returned future is already ready.
+        \see Compile
+        */
+        virtual std::shared_future<bool> CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {});
+
         /**
         \brief Loads the specified binary code into the shader object.
         \param[in] binaryCode Binary shader code container.
-        \param[in] shaderDesc Specifies the shader descriptor. Only the optional stream output format is used here.
-        \note Only supported with: Direct3D 11, Direct3D 12.
+        \param[in] shaderDesc Specifies the shader descriptor. Only the optional stream output format and the entry point (for SPIR-V) are used here.
+        \remarks The binary code is DXBC with Direct3D and a SPIR-V module with OpenGL (requires 'GL_ARB_gl_spirv').
+        Loading precompiled byte code avoids the shader compilation at runtime.
+        \note Only supported with: OpenGL, Direct3D 11, Direct3D 12.
+        \see RenderingCaps::hasShaderBinaries
         \return True on success, otherwise "QueryInfoLog" can be used to query the reason for failure.
         \see QueryInfoLog
         \see ShaderDescriptor
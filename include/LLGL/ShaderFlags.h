@@ -29,6 +29,8 @@ enum class ShaderType
     Geometry,       //!< Geometry shader type.
     Fragment,       //!< Fragment shader type (also "Pixel Shader").
     Compute,        //!< Compute shader type.
+    Amplification,  //!< Amplification shader type (also "Task Shader"). Optional stage in front of a mesh shader.
+    Mesh,           //!< Mesh shader type. Replaces the vertex, tessellation, and geometry stages of a graphics pipeline.
 };
 
 
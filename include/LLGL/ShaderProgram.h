@@ -89,6 +89,28 @@ class LLGL_EXPORT ShaderProgram
         */
         virtual std::vector<UniformDescriptor> QueryUniforms() const = 0;
 
+        /**
+        \brief Returns the slot of the specified shader class interface, i.e. an interface variable (Direct3D 11) or a subroutine uniform (OpenGL).
+        \param[in] stage Specifies the shader stage of the interface.
+        \param[in] name Specifies the name of the interface variable or subroutine uniform.
+        \return Zero-based index into the array of class instances for "CommandBuffer::SetShaderClassInstances",
+        or -1 if there is no such interface in the specified stage or shader class interfaces are not supported.
+        \remarks The shader program must have been linked successfully.
+        \see RenderingCaps::hasShaderClassInterfaces
+        \see QueryShaderClassInstance
+        */
+        virtual int QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name) = 0;
+
+        /**
+        \brief Returns the ID of the specified implementation of a shader class interface, i.e. a class instance (Direct3D 11) or a subroutine function (OpenGL).
+        \param[in] stage Specifies the shader stage of the implementation.
+        \param[in] name Specifies the name of the class instance variable or subroutine function.
+        \return ID of the class instance for "CommandBuffer::SetShaderClassInstances", or -1 if there is no such class instance in the specified stage.
+        \remarks The shader program must have been linked successfully. With Direct3D 11, only class instances that are declared as global variables in the shader can be used.
+        \see QueryShaderInterfaceSlot
+        */
+        virtual int QueryShaderClassInstance(const ShaderType stage, const std::string& name) = 0;
+
         /**
         \brief Builds the input layout with the specified vertex format for this shader program.
         \param[in] vertexFormat Specifies the input vertex format.
@@ -36,6 +36,14 @@ enum class UniformType
     Int2,           //!< int2/ ivec2 uniform.
     Int3,           //!< int3/ ivec3 uniform.
     Int4,           //!< int4/ ivec4 uniform.
+    UInt,           //!< uint uniform.
+    UInt2,          //!< uint2/ uvec2 uniform.
+    UInt3,          //!< uint3/ uvec3 uniform.
+    UInt4,          //!< uint4/ uvec4 uniform.
+    Boolean,        //!< bool uniform. (Can not be called "Bool" due to conflict with X11 lib on Linux).
+    Boolean2,       //!< bool2/ bvec2 uniform.
+    Boolean3,       //!< bool3/ bvec3 uniform.
+    Boolean4,       //!< bool4/ bvec4 uniform.
     Float2x2,       //!< float2x2/ mat2 uniform.
     Float3x3,       //!< float3x3/ mat3 uniform.
     Float4x4,       //!< float4x4/ mat4 uniform.
@@ -72,6 +80,14 @@ class LLGL_EXPORT ShaderUniform
         {
         }
 
+        /**
+        \brief Returns the location of the specified uniform, or -1 if the shader program has no active uniform with that name.
+        \remarks The locations of all active uniforms are reflected once after the shader program has been linked,
+        so this does not query the driver for these names. Use the returned location for the location based setter functions,
+        to avoid the name lookup for each call.
+        */
+        virtual int GetUniformLocation(const std::string& name) = 0;
+
         virtual void SetUniform(int location, const int value) = 0;
         virtual void SetUniform(int location, const Gs::Vector2i& value) = 0;
         virtual void SetUniform(int location, const Gs::Vector3i& value) = 0;
@@ -0,0 +1,201 @@
+/*
+ * ShaderVariantCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SHADER_VARIANT_CACHE_H
+#define LLGL_SHADER_VARIANT_CACHE_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <future>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Shader variant source descriptor structure, i.e. a base source with the define keys of its permutations.
+\see ShaderVariantCache::AddSource
+*/
+struct ShaderVariantSourceDescriptor
+{
+    /**
+    \brief Unique name of this source (e.g. its filename).
+    \remarks This identifies the source in the serialized list of used variants (see ShaderVariantCache::Save).
+    */
+    std::string                 name;
+
+    //! Shader type of all variants.
+    ShaderType                  type        = ShaderType::Vertex;
+
+    //! Base source code of all variants.
+    std::string                 sourceCode;
+
+    //! Shader descriptor of all variants.
+    ShaderDescriptor            shaderDesc;
+
+    /**
+    \brief Names of the macros that can be defined for the variants. At most 64 keys are allowed.
+    \remarks A variant is selected with a bit mask over these keys, where bit i defines the macro 'defineKeys[i]' with the value 1.
+    Macros of keys, which are not part of the mask, are left undefined. For GLSL, the macros are inserted after the '#version' directive.
+    */
+    std::vector<std::string>    defineKeys;
+};
+
+//! Statistics of a shader variant cache.
+struct ShaderVariantCacheStatistics
+{
+    //! Number of variants that have been compiled, i.e. the number of distinct shaders.
+    std::uint64_t numCompiled       = 0;
+
+    //! Number of variant requests that were served without compilation.
+    std::uint64_t numHits           = 0;
+
+    //! Number of variants of different sources or masks that resolved to the same final source and share a shader.
+    std::uint64_t numDeduplicated   = 0;
+
+    //! Number of variants whose compilation failed.
+    std::uint64_t numFailed         = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Cache for shader permutations, which are compiled from a base source and a set of macro definitions.
+\remarks Each variant is identified by a hash over its final source code (i.e. including the macro definitions) and its shader descriptor,
+so identical variants are only compiled once, even if they are requested from different sources or with different masks (e.g. for keys that the source ignores).
+The cache also records which variants have been used, so the next run of the application can pre-compile exactly these variants in the background
+(see Save and Load). Shader binaries are not part of this data, since they are not exposed by all render systems;
+the linked programs are cached with RenderSystem::SavePipelineCache instead, which should be stored alongside.
+\code
+LLGL::ShaderVariantCache variants(*renderer);
+
+auto lighting = variants.AddSource({ "Lighting.frag", LLGL::ShaderType::Fragment, lightingSource, {}, { "USE_SHADOWS", "USE_NORMAL_MAP", "USE_FOG" } });
+variants.Load(ReadFile("ShaderVariants.bin")); // Pre-compiles the variants used in the previous run
+
+auto shader = variants.GetVariant(lighting, variants.MakeMask(lighting, { "USE_SHADOWS", "USE_FOG" }));
+// ...
+
+WriteFile("ShaderVariants.bin", variants.Save());
+\endcode
+*/
+class LLGL_EXPORT ShaderVariantCache
+{
+
+    public:
+
+        ShaderVariantCache(const ShaderVariantCache&) = delete;
+        ShaderVariantCache& operator = (const ShaderVariantCache&) = delete;
+
+        //! Initializes the cache for the specified render system, which is used to create and release the shaders.
+        ShaderVariantCache(RenderSystem& renderSystem);
+
+        //! Waits for all pending compilations and releases all shaders of this cache.
+        ~ShaderVariantCache();
+
+        /**
+        \brief Adds a new base source for shader variants.
+        \return Zero-based index of the new source, which is used to select its variants.
+        \throw std::invalid_argument If the descriptor has more than 64 define keys, or if a source with the same name has already been added.
+        */
+        std::size_t AddSource(const ShaderVariantSourceDescriptor& desc);
+
+        /**
+        \brief Returns the bit mask for the specified defines of the specified source.
+        \throw std::invalid_argument If any of the defines is not a key of the source.
+        */
+        std::uint64_t MakeMask(std::size_t source, const std::vector<std::string>& defines) const;
+
+        /**
+        \brief Returns the shader variant of the specified source with the specified macros defined.
+        \remarks The variant is compiled on first use. If it is still being pre-compiled, this function waits for its compilation.
+        \return Pointer to the shader, or null if the compilation failed. In this case, the info log is available with "GetInfoLog".
+        The shader remains valid until this cache is destroyed or cleared.
+        */
+        Shader* GetVariant(std::size_t source, std::uint64_t mask);
+
+        /**
+        \brief Starts the compilation of the specified variants in the background (see Shader::CompileAsync).
+        \remarks Variants that are already compiled or pending are ignored.
+        */
+        void Precompile(std::size_t source, const std::vector<std::uint64_t>& masks);
+
+        //! Returns the info log of the last variant whose compilation failed.
+        inline const std::string& GetInfoLog() const
+        {
+            return infoLog_;
+        }
+
+        /**
+        \brief Pre-compiles all variants of the specified serialized list of used variants (see Save).
+        \remarks Entries of sources that have not been added or whose source code or define keys have changed, are ignored.
+        Therefore, all sources should be added before this function is called.
+        \return True if the data is valid (an empty container is also valid). Otherwise, the data was not serialized with "Save".
+        */
+        bool Load(const std::vector<char>& data);
+
+        //! Serializes the list of all variants that have been used so far (including the loaded ones).
+        std::vector<char> Save() const;
+
+        //! Waits for all pending compilations and releases all shaders. The sources remain.
+        void Clear();
+
+        //! Returns the statistics of this cache.
+        inline const ShaderVariantCacheStatistics& GetStatistics() const
+        {
+            return stats_;
+        }
+
+    private:
+
+        struct Source
+        {
+            ShaderVariantSourceDescriptor           desc;
+            std::uint64_t                           hash        = 0;    // Hash over type, source code, shader descriptor, and define keys.
+            std::map<std::uint64_t, std::uint64_t>  variantHashes;      // Hashes of the used variants by their masks.
+        };
+
+        struct Variant
+        {
+            Shader*                     shader  = nullptr;
+            std::shared_future<bool>    pending;            // Valid while the variant is being pre-compiled.
+            bool                        failed  = false;
+            std::string                 infoLog;
+        };
+
+        Variant& FindOrCompileVariant(std::size_t source, std::uint64_t mask, bool async);
+        void ResolveVariant(Variant& variant);
+
+        const Source& GetSource(std::size_t source) const;
+
+        RenderSystem&                       renderSystem_;
+
+        std::vector<Source>                 sources_;
+        std::map<std::uint64_t, Variant>    variants_;      // Variants by hash over their final source code and shader descriptor.
+
+        ShaderVariantCacheStatistics        stats_;
+        std::string                         infoLog_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,229 @@
+/*
+ * SpriteBatch.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SPRITE_BATCH_H
+#define LLGL_SPRITE_BATCH_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "RenderContext.h"
+#include "InstanceStream.h"
+#include "TextureAtlas.h"
+#include "ColorRGBA.h"
+#include <vector>
+#include <string>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Sprite batch descriptor structure.
+\see SpriteBatch::SpriteBatch
+*/
+struct SpriteBatchDescriptor
+{
+    /**
+    \brief Specifies the maximal number of sprites per frame. By default 4096.
+    \remarks If more sprites are drawn within a single frame, the remaining sprites are not drawn.
+    */
+    std::uint32_t   maxSprites      = 4096;
+
+    /**
+    \brief Specifies the number of instance buffers the sprites are streamed through. By default 3.
+    \see InstanceStreamDescriptor::numFrames
+    */
+    std::uint32_t   numFrames       = 3;
+
+    //! Specifies the number of samples of the render context the sprites are drawn into. By default 1.
+    unsigned int    samples         = 1;
+
+    /**
+    \brief Specifies whether the sprites are sorted by their texture before they are drawn. By default true.
+    \remarks If this is true, all sprites of the same texture are drawn with a single draw call, but sprites of different textures
+    no longer overlap in the order they have been drawn. Sprites of the same texture always keep their order.
+    If this is false, only consecutive sprites of the same texture are drawn together.
+    */
+    bool            sortByTexture   = true;
+};
+
+/**
+\brief Sprite font structure with the glyph regions of a texture atlas.
+\see SpriteBatch::DrawString
+*/
+struct SpriteFont
+{
+    //! Texture of the atlas all glyphs have been allocated from. This must not be null.
+    Texture*                        texture     = nullptr;
+
+    //! Atlas regions of the glyphs for the characters 'firstChar', 'firstChar + 1', and so on.
+    std::vector<TextureAtlasRegion> glyphs;
+
+    //! Character of the first glyph. Characters without glyph are skipped. By default ' '.
+    char                            firstChar   = ' ';
+
+    //! Spacing (in texels) between two glyphs and between two lines. By default 1.
+    float                           spacing     = 1.0f;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Sprite batch, which draws textured and colored 2D rectangles with a minimal number of draw calls.
+\remarks Each sprite is a single instance of a unit quad. The instances of a frame are streamed through an InstanceStream,
+so all sprites share one instance buffer and the sprites of each texture are drawn with a single instanced draw call.
+Since all images of a TextureAtlas are layers of a single texture, the sprites of an entire atlas (including text) are drawn together.
+Sprites are sampled with texel precision, i.e. each texel of the atlas region is mapped onto the sprite without filtering.
+\code
+LLGL::SpriteBatch spriteBatch(*renderer, *context);
+
+// Render loop
+commands->SetRenderTarget(*context);
+// render scene ...
+spriteBatch.Begin();
+spriteBatch.Draw(atlas.GetTexture(), iconRegion, 16.0f, 16.0f, 64.0f, 64.0f);
+spriteBatch.DrawString(font, 96.0f, 16.0f, "Score: 42");
+spriteBatch.End(*commands);
+context->Present();
+\endcode
+\note Requires instance offsets (see InstanceStream) and 2D array textures, i.e. OpenGL 3.1, OpenGL ES 3.0, or Direct3D 10 shading language.
+*/
+class LLGL_EXPORT SpriteBatch
+{
+
+    public:
+
+        SpriteBatch(const SpriteBatch&) = delete;
+        SpriteBatch& operator = (const SpriteBatch&) = delete;
+
+        /**
+        \brief Initializes the sprite batch and creates its shader program, graphics pipeline, quad vertex buffer, and instance stream.
+        \param[in] renderSystem Specifies the render system, which is used to create the resources.
+        \param[in] renderContext Specifies the render context the sprites are drawn into. Its resolution is read for every frame.
+        \param[in] desc Specifies the sprite batch descriptor.
+        \throw std::invalid_argument If the maximal number of sprites or the number of frames is 0.
+        \throw std::runtime_error If the shading language of the render system is not supported, or if the built-in shaders failed to compile.
+        */
+        SpriteBatch(RenderSystem& renderSystem, RenderContext& renderContext, const SpriteBatchDescriptor& desc = {});
+
+        //! Releases all resources.
+        ~SpriteBatch();
+
+        //! Discards all sprites that have not been drawn yet and starts a new batch.
+        void Begin();
+
+        /**
+        \brief Adds a sprite with the specified region of a 2D array texture.
+        \param[in] texture Specifies the texture. This must be a 2D array texture, e.g. the texture of a TextureAtlas.
+        \param[in] region Specifies the region (in texels) and the array layer within the texture.
+        \param[in] x Specifies the X coordinate (in pixels) of the upper-left corner of the sprite.
+        \param[in] y Specifies the Y coordinate (in pixels) of the upper-left corner of the sprite.
+        \param[in] width Specifies the width (in pixels) of the sprite.
+        \param[in] height Specifies the height (in pixels) of the sprite.
+        \param[in] color Specifies the color, which is multiplied with the texels. By default white.
+        */
+        void Draw(
+            Texture&                    texture,
+            const TextureAtlasRegion&   region,
+            float                       x,
+            float                       y,
+            float                       width,
+            float                       height,
+            const ColorRGBAub&          color   = { 255, 255, 255, 255 }
+        );
+
+        //! Adds a solid rectangle with the specified position, size (in pixels), and color.
+        void DrawRect(float x, float y, float width, float height, const ColorRGBAub& color);
+
+        /**
+        \brief Adds one sprite per character of the specified text.
+        \param[in] font Specifies the font with the glyph regions. Line feeds ('\n') start a new line.
+        \param[in] x Specifies the X coordinate (in pixels) of the upper-left corner of the text.
+        \param[in] y Specifies the Y coordinate (in pixels) of the upper-left corner of the text.
+        \param[in] text Specifies the text.
+        \param[in] color Specifies the text color. By default white.
+        \param[in] scale Specifies the size (in pixels) of each glyph texel. By default 1.
+        \return Width (in pixels) of the longest line of the text.
+        */
+        float DrawString(
+            const SpriteFont&   font,
+            float               x,
+            float               y,
+            const std::string&  text,
+            const ColorRGBAub&  color   = { 255, 255, 255, 255 },
+            float               scale   = 1.0f
+        );
+
+        /**
+        \brief Streams all sprites of the current batch into the instance buffer and records their draw commands into the specified command buffer.
+        \remarks The render context must already be set as render target (see CommandBuffer::SetRenderTarget(RenderContext&)).
+        This sets the viewport to the entire render context and binds the graphics pipeline, vertex buffer array, and texture slot 0,
+        so these states must be set again before other draw commands are recorded. Call this function at most once per frame.
+        */
+        void End(CommandBuffer& commandBuffer);
+
+        //! Returns the number of draw calls that have been recorded by the last call to "End".
+        inline unsigned int GetNumDrawCalls() const
+        {
+            return numDrawCalls_;
+        }
+
+    private:
+
+        struct Instance
+        {
+            float           rect[4];    // Position and size in pixels, converted to normalized device coordinates by "End"
+            float           texRect[4]; // Position and size in texels
+            float           layer;
+            ColorRGBAub     color;
+        };
+
+        struct Sprite
+        {
+            Texture*        texture;
+            Instance        instance;
+        };
+
+        void CreateShaderProgram();
+        void CreateGraphicsPipeline();
+        void CreateBuffers();
+        void CreateWhiteTexture();
+
+        RenderSystem&                   renderSystem_;
+        RenderContext&                  renderContext_;
+        SpriteBatchDescriptor           desc_;
+
+        VertexFormat                    vertexFormat_;
+        VertexFormat                    instanceFormat_;
+        ShaderProgram*                  shaderProgram_      = nullptr;
+        std::vector<Shader*>            shaders_;
+        GraphicsPipeline*               graphicsPipeline_   = nullptr;
+        Buffer*                         vertexBuffer_       = nullptr;
+        Texture*                        whiteTexture_       = nullptr;
+        std::unique_ptr<InstanceStream> instanceStream_;
+
+        std::vector<Sprite>             sprites_;
+        std::vector<Instance>           instances_;
+        unsigned int                    numDrawCalls_       = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
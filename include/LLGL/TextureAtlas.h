@@ -0,0 +1,220 @@
+/*
+ * TextureAtlas.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEXTURE_ATLAS_H
+#define LLGL_TEXTURE_ATLAS_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <Gauss/Vector2.h>
+#include <memory>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class AtlasPacker;
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Texture atlas packing algorithm enumeration.
+\see TextureAtlasDescriptor::packing
+*/
+enum class TextureAtlasPacking
+{
+    /**
+    \brief Images are placed in horizontal shelves, which are stacked from top to bottom.
+    \remarks This is the fastest algorithm and packs images of uniform height (e.g. font glyphs or UI icons) tightly.
+    */
+    Shelf,
+
+    /**
+    \brief Images are placed at the lowest position along the upper contour of all previous images (bottom-left heuristic).
+    \remarks This wastes less space than the shelf algorithm for images of different heights (e.g. decals).
+    */
+    Skyline,
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Texture atlas descriptor structure.
+\see TextureAtlas
+*/
+struct TextureAtlasDescriptor
+{
+    //! Specifies the hardware texture format of the atlas. By default TextureFormat::RGBA8.
+    TextureFormat       format      = TextureFormat::RGBA8;
+
+    //! Specifies the size (in texels) of each array layer. By default 2048 x 2048.
+    Gs::Vector2ui       layerSize   = { 2048u, 2048u };
+
+    /**
+    \brief Specifies the number of array layers of the atlas texture. By default 4.
+    \remarks The texture is allocated with all layers at once and is never reallocated, so it can be bound in resource heaps permanently.
+    */
+    unsigned int        numLayers   = 4;
+
+    /**
+    \brief Specifies the number of empty texels around each image. By default 1.
+    \remarks This avoids that bilinear filtering samples texels of neighboring images.
+    */
+    unsigned int        padding     = 1;
+
+    //! Specifies the packing algorithm. By default TextureAtlasPacking::Skyline.
+    TextureAtlasPacking packing     = TextureAtlasPacking::Skyline;
+};
+
+/**
+\brief Texture atlas region structure, which describes where an image has been placed within the atlas.
+\remarks The texture coordinates (u, v) of the original image are remapped into the atlas with 'uvOffset + (u, v) * uvScale',
+and the array layer is sampled with 'layer'. Both can be passed to the shaders, e.g. as per-instance attributes.
+\see TextureAtlas::Insert
+*/
+struct TextureAtlasRegion
+{
+    //! X-axis offset (in texels) of the image within its layer.
+    unsigned int    x           = 0;
+
+    //! Y-axis offset (in texels) of the image within its layer.
+    unsigned int    y           = 0;
+
+    //! Width (in texels) of the image.
+    unsigned int    width       = 0;
+
+    //! Height (in texels) of the image.
+    unsigned int    height      = 0;
+
+    //! Zero-based array layer of the image.
+    unsigned int    layer       = 0;
+
+    //! Offset of the texture coordinates within the layer.
+    Gs::Vector2f    uvOffset;
+
+    //! Scale of the texture coordinates within the layer.
+    Gs::Vector2f    uvScale;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Texture atlas, which packs many small images into the layers of a single 2D array texture.
+\remarks In contrast to a TextureArray, which only groups existing textures to bind them together,
+all images of the atlas share a single texture. Materials with many small images (e.g. UI elements or decals)
+can then be drawn with a single texture binding, instead of one binding for each image.
+Images are packed incrementally, and each image is uploaded with RenderSystem::WriteTexture when it is inserted
+or updated, so the atlas can be filled while the application is running.
+The atlas texture has no MIP-maps, because the MIP-map levels would blend neighboring images.
+\code
+LLGL::TextureAtlas atlas(*renderer, atlasDesc);
+
+LLGL::TextureAtlasRegion iconRegion;
+if (atlas.Insert({ 32, 32 }, iconImage, iconRegion))
+{
+    // Draw icon with atlas.GetTexture(), iconRegion.layer, iconRegion.uvOffset, and iconRegion.uvScale ...
+}
+\endcode
+*/
+class LLGL_EXPORT TextureAtlas
+{
+
+    public:
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator = (const TextureAtlas&) = delete;
+
+        /**
+        \brief Creates the atlas texture with all of its array layers.
+        \param[in] renderSystem Specifies the render system, which is used to create and write the atlas texture.
+        \param[in] desc Specifies the atlas descriptor.
+        \throw std::invalid_argument If the layer size or number of layers is zero.
+        */
+        TextureAtlas(RenderSystem& renderSystem, const TextureAtlasDescriptor& desc);
+
+        //! Releases the atlas texture.
+        ~TextureAtlas();
+
+        /**
+        \brief Allocates a region of the specified size without writing any image data.
+        \param[in] size Specifies the size (in texels) of the region.
+        \param[out] region Receives the allocated region.
+        \return True if the region has been allocated, or false if no layer has enough space left.
+        \remarks The layers are searched in order, so the first layers are filled up first.
+        */
+        bool Allocate(const Gs::Vector2ui& size, TextureAtlasRegion& region);
+
+        /**
+        \brief Allocates a region of the specified size and writes the image into it.
+        \param[in] size Specifies the size (in texels) of the image.
+        \param[in] imageDesc Specifies the image data, which must cover the entire size.
+        \param[out] region Receives the allocated region.
+        \return True if the image has been inserted, or false if no layer has enough space left.
+        */
+        bool Insert(const Gs::Vector2ui& size, const ImageDescriptor& imageDesc, TextureAtlasRegion& region);
+
+        /**
+        \brief Writes the specified image into a region that has been allocated before, e.g. to update an animated image.
+        \param[in] region Specifies the region whose image is to be written.
+        \param[in] imageDesc Specifies the image data, which must cover the entire region.
+        */
+        void Write(const TextureAtlasRegion& region, const ImageDescriptor& imageDesc);
+
+        /**
+        \brief Clears all regions of the specified layer, so the layer can be filled again.
+        \remarks The previous contents of the layer remain in the texture until they are overwritten.
+        \throw std::out_of_range If 'layer' is not less than the number of layers.
+        */
+        void ClearLayer(unsigned int layer);
+
+        //! Clears all regions of all layers.
+        void Clear();
+
+        //! Returns the 2D array texture of the atlas.
+        inline Texture& GetTexture() const
+        {
+            return *texture_;
+        }
+
+        //! Returns the descriptor of this atlas.
+        inline const TextureAtlasDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+        //! Returns the number of regions that are currently allocated in all layers.
+        inline std::size_t GetNumRegions() const
+        {
+            return numRegions_;
+        }
+
+    private:
+
+        RenderSystem&                               renderSystem_;
+        TextureAtlasDescriptor                      desc_;
+        Texture*                                    texture_        = nullptr;
+        std::vector<std::unique_ptr<AtlasPacker>>   packers_;
+        std::vector<std::size_t>                    layerRegions_;
+        std::size_t                                 numRegions_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,146 @@
+/*
+ * TextureContainer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEXTURE_CONTAINER_H
+#define LLGL_TEXTURE_CONTAINER_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include "TextureFlags.h"
+#include "Image.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class MappedFile;
+
+/**
+\brief Read-only texture container file (DDS or KTX2), whose pre-built MIP-map levels are uploaded directly from a memory mapping of the file.
+\remarks The file is neither decoded nor converted: each image descriptor points into the mapped file,
+and describes the image data in the exact format of the texture, so the render system can upload it without conversion.
+Supported are uncompressed formats without 16-bit floating-point components, and all compressed formats of TextureFormat.
+Supercompressed KTX2 files (e.g. Basis Universal) are not supported.
+\code
+LLGL::TextureContainer container("Textures/Stone.dds");
+auto texture = container.CreateTexture(*renderer);
+\endcode
+\see TextureFormat
+*/
+class LLGL_EXPORT TextureContainer
+{
+
+    public:
+
+        TextureContainer(const TextureContainer&) = delete;
+        TextureContainer& operator = (const TextureContainer&) = delete;
+
+        /**
+        \brief Opens and maps the specified DDS or KTX2 file, and reads its header.
+        \throw std::runtime_error If the file could not be mapped, is neither a DDS nor a KTX2 file, has an unsupported format, or is truncated.
+        */
+        explicit TextureContainer(const std::string& filename);
+
+        //! Unmaps the file. All image descriptors of this container become invalid.
+        ~TextureContainer();
+
+        /**
+        \brief Returns the image descriptor of the specified MIP-map level and array layer, which points directly into the mapped file.
+        \param[in] mipLevel Specifies the MIP-map level.
+        \param[in] layer Specifies the array layer. For cube textures, each face is a separate layer. 3D textures only have a single layer with all slices.
+        \throw std::out_of_range If 'mipLevel' or 'layer' is out of range.
+        */
+        ImageDescriptor GetImageDescriptor(unsigned int mipLevel, unsigned int layer = 0) const;
+
+        /**
+        \brief Creates a texture from this container and uploads all of its MIP-map levels.
+        \remarks The texture is created with the first MIP-map level, and all further levels are written with RenderSystem::WriteTexture.
+        \see RenderSystem::CreateTexture
+        */
+        Texture* CreateTexture(RenderSystem& renderSystem) const;
+
+        //! Returns the descriptor of the texture in this container.
+        inline const TextureDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+        //! Returns the number of MIP-map levels in this container.
+        inline unsigned int GetNumMipLevels() const
+        {
+            return numMipLevels_;
+        }
+
+        //! Returns the number of array layers (including cube faces) in this container.
+        inline unsigned int GetNumLayers() const
+        {
+            return numLayers_;
+        }
+
+    private:
+
+        struct Subresource
+        {
+            std::size_t offset  = 0;
+            std::size_t size    = 0;
+        };
+
+        void ReadDDS(const char* data, std::size_t size);
+        void ReadKTX2(const char* data, std::size_t size);
+
+        // Sets the texture format and the respective image format, or throws an exception if the format is not supported.
+        void SetFormat(const TextureFormat format, const std::string& formatName);
+
+        // Sets the texture type and extent, and the number of layers in the container.
+        void SetTypeAndExtent(const TextureType type, const Gs::Vector3ui& extent, unsigned int layers);
+
+        // Returns the extent of the specified MIP-map level.
+        Gs::Vector3ui GetMipExtent(unsigned int mipLevel) const;
+
+        // Returns the size (in bytes) of a single layer of the specified MIP-map level.
+        std::size_t GetLayerSize(unsigned int mipLevel) const;
+
+        // Throws an exception if any subresource exceeds the mapped file.
+        void ValidateSubresources(std::size_t fileSize) const;
+
+        const Subresource& GetSubresource(unsigned int mipLevel, unsigned int layer) const;
+
+        ImageDescriptor MakeImageDescriptor(std::size_t offset, std::size_t size) const;
+
+        SubTextureDescriptor MakeSubTextureDescriptor(unsigned int mipLevel, unsigned int firstLayer, unsigned int numLayers) const;
+
+        std::unique_ptr<MappedFile> file_;
+
+        TextureDescriptor           desc_;
+        ImageFormat                 imageFormat_        = ImageFormat::RGBA;
+        DataType                    dataType_           = DataType::UInt8;
+        unsigned int                numMipLevels_       = 1;
+        unsigned int                numLayers_          = 1;
+
+        // Subresources in the order (layer * numMipLevels + mipLevel).
+        std::vector<Subresource>    subresources_;
+
+        // Specifies whether all layers of each MIP-map level are stored consecutively (KTX2), or all MIP-map levels of each layer (DDS).
+        bool                        levelMajor_         = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
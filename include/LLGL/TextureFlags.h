@@ -53,6 +53,7 @@ enum class TextureFormat
     /* --- Sized formats --- */
     R8,             //!< Sized format: red 8-bit normalized unsigned integer component.
     R8Sgn,          //!< Sized format: red 8-bit normalized signed integer component.
+    R8UInt,         //!< Sized format: red 8-bit un-normalized unsigned interger component.
 
     R16,            //!< Sized format: red 16-bit normalized unsigned interger component.
     R16Sgn,         //!< Sized format: red 16-bit normalized signed interger component.
@@ -96,10 +97,18 @@ enum class TextureFormat
     RGBA32Float,    //!< Sized format: red, green, blue, alpha 32-bit floating point components.
 
     /* --- Compressed formats --- */
-    RGB_DXT1,       //!< Compressed format: RGB S3TC DXT1.
-    RGBA_DXT1,      //!< Compressed format: RGBA S3TC DXT1.
-    RGBA_DXT3,      //!< Compressed format: RGBA S3TC DXT3.
-    RGBA_DXT5,      //!< Compressed format: RGBA S3TC DXT5.
+    RGB_DXT1,       //!< Compressed format: RGB S3TC DXT1 (also known as BC1).
+    RGBA_DXT1,      //!< Compressed format: RGBA S3TC DXT1 (also known as BC1).
+    RGBA_DXT3,      //!< Compressed format: RGBA S3TC DXT3 (also known as BC2).
+    RGBA_DXT5,      //!< Compressed format: RGBA S3TC DXT5 (also known as BC3).
+    R_BC4,          //!< Compressed format: red RGTC1 (also known as BC4).
+    RG_BC5,         //!< Compressed format: red, green RGTC2 (also known as BC5).
+    RGB_BC6H,       //!< Compressed format: RGB unsigned floating-point BPTC (also known as BC6H).
+    RGBA_BC7,       //!< Compressed format: RGBA BPTC (also known as BC7).
+    RGB_ETC2,       //!< Compressed format: RGB ETC2. \note Only supported with: OpenGL, OpenGLES.
+    RGBA_ETC2,      //!< Compressed format: RGBA ETC2 with EAC alpha. \note Only supported with: OpenGL, OpenGLES.
+    RGBA_ASTC4x4,   //!< Compressed format: RGBA ASTC with 4x4 block size. \note Only supported with: OpenGL, OpenGLES.
+    RGBA_ASTC8x8,   //!< Compressed format: RGBA ASTC with 8x8 block size. \note Only supported with: OpenGL, OpenGLES.
 };
 
 //! Axis direction (also used for texture cube face).
@@ -258,6 +267,73 @@ struct LLGL_EXPORT SubTextureDescriptor
     };
 };
 
+/**
+\brief Texture region structure, which describes a box within a single MIP-map level of a texture.
+\remarks Array layers are addressed by the component after the last dimension of the texture type,
+i.e. by the Y-component for 1D array textures and by the Z-component for 2D array textures.
+For cube textures, the Z-component addresses the cube faces (i.e. 'layer * 6 + face').
+\see CommandBuffer::CopyTexture
+\see CommandBuffer::CopyBufferToTexture
+*/
+struct TextureRegion
+{
+    TextureRegion() = default;
+
+    TextureRegion(unsigned int mipLevel, const Gs::Vector3ui& offset, const Gs::Vector3ui& extent) :
+        mipLevel { mipLevel },
+        offset   { offset   },
+        extent   { extent   }
+    {
+    }
+
+    //! MIP-map level of the region, where 0 is the base texture. By default 0.
+    unsigned int    mipLevel    = 0;
+
+    //! Offset (in texels) of the region. By default (0, 0, 0).
+    Gs::Vector3ui   offset;
+
+    //! Extent (in texels) of the region. For 1D textures, the Y- and Z-components must be 1. By default (0, 0, 0).
+    Gs::Vector3ui   extent;
+};
+
+/**
+\brief Texture view descriptor structure.
+\remarks A texture view shares the memory of another texture, but only covers a range of its MIP-map levels and array layers,
+and optionally reinterprets its format. This allows, for instance, to read one MIP-map level in a shader while rendering into the next one.
+\see RenderSystem::CreateTextureView
+*/
+struct TextureViewDescriptor
+{
+    /**
+    \brief Texture type of the view. By default TextureType::Texture2D.
+    \remarks This must be compatible with the type of the shared texture,
+    e.g. a view of type TextureType::Texture2D can be created for a single layer of a TextureType::Texture2DArray or a single face of a TextureType::TextureCube texture.
+    */
+    TextureType     type            = TextureType::Texture2D;
+
+    /**
+    \brief Texture format of the view. By default TextureFormat::Unknown.
+    \remarks If this is TextureFormat::Unknown, the view has the same format as the shared texture.
+    Otherwise, the format must have the same size per texel as the format of the shared texture, e.g. TextureFormat::R32UInt for a TextureFormat::R32Float texture.
+    */
+    TextureFormat   format          = TextureFormat::Unknown;
+
+    //! First MIP-map level of the shared texture, which is level 0 of the view. By default 0.
+    unsigned int    firstMipLevel   = 0;
+
+    //! Number of MIP-map levels of the view. By default 1.
+    unsigned int    numMipLevels    = 1;
+
+    /**
+    \brief First array layer of the shared texture, which is layer 0 of the view. By default 0.
+    \remarks For cube textures, the array layers address the cube faces (i.e. 'layer * 6 + face').
+    */
+    unsigned int    firstArrayLayer = 0;
+
+    //! Number of array layers of the view. For cube textures, this must be a multiple of 6. By default 1.
+    unsigned int    numArrayLayers  = 1;
+};
+
 
 /* ----- Functions ----- */
 
@@ -273,11 +349,41 @@ LLGL_EXPORT unsigned int NumMipLevels(unsigned int width, unsigned int height =
 
 /**
 \brief Returns true if the specified texture format is a compressed format,
-i.e. either TextureFormat::RGB_DXT1, TextureFormat::RGBA_DXT1, TextureFormat::RGBA_DXT3, or TextureFormat::RGBA_DXT5.
+i.e. any of the block-compressed formats from TextureFormat::RGB_DXT1 to TextureFormat::RGBA_ASTC8x8.
 \see TextureFormat
 */
 LLGL_EXPORT bool IsCompressedFormat(const TextureFormat format);
 
+/**
+\brief Returns the size (in bytes) of a single row of blocks for the specified compressed texture format.
+\param[in] format Specifies the compressed texture format.
+\param[in] width Specifies the image width (in texels). This is rounded up to the block width.
+\return Size of a row of blocks, or 0 if 'format' is not a compressed format.
+This is the row pitch to upload compressed data, e.g. with "ID3D11DeviceContext::UpdateSubresource".
+\see IsCompressedFormat(const TextureFormat)
+*/
+LLGL_EXPORT unsigned int CompressedImageRowPitch(const TextureFormat format, unsigned int width);
+
+/**
+\brief Returns the size (in bytes) of an image with the specified compressed texture format.
+\param[in] format Specifies the compressed texture format.
+\param[in] width Specifies the image width (in texels). This is rounded up to the block width.
+\param[in] height Specifies the image height (in texels). This is rounded up to the block height. By default 1.
+\param[in] depth Specifies the image depth or number of array layers. By default 1.
+\return Size of the compressed image, or 0 if 'format' is not a compressed format.
+This is the value for the "ImageDescriptor::compressedSize" attribute.
+*/
+LLGL_EXPORT unsigned int CompressedImageSize(const TextureFormat format, unsigned int width, unsigned int height = 1, unsigned int depth = 1);
+
+/**
+\brief Returns the size (in bytes) of a single texel of the specified uncompressed texture format.
+\remarks Base formats are assumed to have 8-bit color components and a 32-bit depth(-stencil) component,
+since their actual size is only determined by the driver.
+\return Size of a single texel, or 0 if 'format' is unknown or a compressed format.
+\see CompressedImageSize
+*/
+LLGL_EXPORT unsigned int TextureFormatSize(const TextureFormat format);
+
 /**
 \brief Returns true if the specified texture format is a depth or depth-stencil format,
 i.e. either TextureFormat::DepthComponent, or TextureFormat::DepthStencil.
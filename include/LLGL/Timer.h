@@ -11,12 +11,101 @@
 
 #include <LLGL/Export.h>
 #include <memory>
+#include <vector>
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
+/**
+\brief Frame time statistics structure.
+\remarks All times are in seconds.
+\see FrameTimeHistory::GetStatistics
+*/
+struct FrameTimeStatistics
+{
+    //! Number of frames the statistics have been computed from.
+    std::size_t numFrames   = 0;
+
+    //! Minimal frame time.
+    double      minTime     = 0.0;
+
+    //! Maximal frame time.
+    double      maxTime     = 0.0;
+
+    //! Average frame time.
+    double      averageTime = 0.0;
+
+    //! Median frame time (50th percentile).
+    double      medianTime  = 0.0;
+
+    //! 95th percentile of the frame times, i.e. 95% of the frames have been faster than this.
+    double      p95Time     = 0.0;
+
+    //! 99th percentile of the frame times, i.e. 99% of the frames have been faster than this.
+    double      p99Time     = 0.0;
+};
+
+/**
+\brief Ring buffer of the most recent frame times.
+\remarks When the history is full, each new frame time replaces the oldest one.
+*/
+class LLGL_EXPORT FrameTimeHistory
+{
+
+    public:
+
+        //! Initializes the history with the specified capacity. A capacity of 0 is clamped to 1.
+        explicit FrameTimeHistory(std::size_t capacity = 120);
+
+        //! Appends the specified frame time (in seconds), and discards the oldest frame time if the history is full.
+        void Push(double frameTime);
+
+        //! Removes all frame times from the history.
+        void Clear();
+
+        //! Removes all frame times and changes the capacity of the history.
+        void Resize(std::size_t capacity);
+
+        /**
+        \brief Returns the specified percentile of the recorded frame times (in seconds), or 0 if the history is empty.
+        \param[in] percentile Specifies the percentile in the range [0, 100], e.g. 99 for the time 99% of the frames have been faster than.
+        */
+        double GetPercentile(double percentile) const;
+
+        //! Computes the statistics of all recorded frame times.
+        FrameTimeStatistics GetStatistics() const;
+
+        //! Returns the most recent frame time (in seconds), or 0 if the history is empty.
+        double GetLatest() const;
+
+        //! Returns the number of recorded frame times.
+        inline std::size_t GetNumFrames() const
+        {
+            return numFrames_;
+        }
+
+        //! Returns the maximal number of frame times the history holds.
+        inline std::size_t GetCapacity() const
+        {
+            return frameTimes_.size();
+        }
+
+    private:
+
+        // Copies the recorded frame times into the sorted scratch buffer.
+        const std::vector<double>& SortFrameTimes() const;
+
+        std::vector<double>         frameTimes_;
+        std::size_t                 next_       = 0;
+        std::size_t                 numFrames_  = 0;
+        mutable std::vector<double> sorted_;
+
+};
+
+
 // Interface for a Timer class
 class LLGL_EXPORT Timer
 {
@@ -30,7 +119,11 @@ class LLGL_EXPORT Timer
         //! Creates a platform specific timer object.
         static std::unique_ptr<Timer> Create();
 
-        //! Starts the timer.
+        /**
+        \brief Starts the timer.
+        \remarks The platform timers use a monotonic clock, so the measured times are never negative,
+        and the elapsed times are computed with 64-bit tick differences that do not overflow.
+        */
         virtual void Start() = 0;
 
         //! Stops the timer and returns the elapsed time since "Start" was called.
@@ -41,11 +134,27 @@ class LLGL_EXPORT Timer
 
         /**
         \brief Measures the time (elapsed time, and frame count) for each frame.
+        \remarks The elapsed time is also recorded in the CPU frame time history.
         \see GetDeltaTime
         \see GetFrameCount()
+        \see GetCPUFrameTimes
         */
         void MeasureTime();
 
+        /**
+        \brief Records the GPU time (in seconds) of a frame in the GPU frame time history.
+        \remarks The GPU times are usually available a few frames later than the CPU times,
+        e.g. from the elapsed time of GPUProfiler::GetResolvedFrame (which is in nanoseconds).
+        \see GetGPUFrameTimes
+        */
+        void MeasureGPUTime(double gpuTime);
+
+        /**
+        \brief Sets the number of frames the CPU and GPU frame time histories hold. By default 120.
+        \remarks This clears both histories.
+        */
+        void SetFrameHistorySize(std::size_t numFrames);
+
         /**
         \brief Restes the frame counter.
         \see GetFrameCount
@@ -72,10 +181,25 @@ class LLGL_EXPORT Timer
             return frameCount_;
         }
 
+        //! Returns the history of the CPU frame times, which are recorded by "MeasureTime".
+        const FrameTimeHistory& GetCPUFrameTimes() const
+        {
+            return cpuFrameTimes_;
+        }
+
+        //! Returns the history of the GPU frame times, which are recorded by "MeasureGPUTime".
+        const FrameTimeHistory& GetGPUFrameTimes() const
+        {
+            return gpuFrameTimes_;
+        }
+
     private:
         
-        double      deltaTime_  = 0.0;
-        FrameCount  frameCount_ = 0;
+        double              deltaTime_  = 0.0;
+        FrameCount          frameCount_ = 0;
+
+        FrameTimeHistory    cpuFrameTimes_;
+        FrameTimeHistory    gpuFrameTimes_;
 
 };
 
@@ -0,0 +1,177 @@
+/*
+ * TransientTexturePool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TRANSIENT_TEXTURE_POOL_H
+#define LLGL_TRANSIENT_TEXTURE_POOL_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Transient texture descriptor structure.
+\remarks Transient textures with equal descriptors are interchangeable, i.e. they share the same pool entries.
+\see TransientTexturePool::Acquire
+*/
+struct TransientTextureDescriptor
+{
+    TransientTextureDescriptor() = default;
+
+    inline TransientTextureDescriptor(const Gs::Vector2ui& size, const TextureFormat format, unsigned int samples = 1) :
+        size    { size    },
+        format  { format  },
+        samples { samples }
+    {
+    }
+
+    //! Specifies the texture size (in texels).
+    Gs::Vector2ui   size;
+
+    //! Specifies the hardware texture format. By default TextureFormat::RGBA.
+    TextureFormat   format  = TextureFormat::RGBA;
+
+    /**
+    \brief Specifies the number of samples. By default 1.
+    \remarks If this is greater than 1, the texture is of type TextureType::Texture2DMS, otherwise TextureType::Texture2D.
+    */
+    unsigned int    samples = 1;
+};
+
+/**
+\brief Transient render target structure, i.e. a pooled texture together with a render target it is attached to.
+\see TransientTexturePool::Acquire
+*/
+struct TransientTarget
+{
+    //! Texture, which can be bound after the render target has been rendered.
+    Texture*        texture         = nullptr;
+
+    /**
+    \brief Render target with 'texture' as its only attachment.
+    \remarks The texture is attached as depth-stencil attachment if it has a depth format, and as color attachment otherwise.
+    */
+    RenderTarget*   renderTarget    = nullptr;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Pool for transient render targets, whose contents are only used within a frame (e.g. intermediate targets of a post-processing chain).
+\remarks Instead of keeping every intermediate target alive for the whole run, the targets are acquired when a pass needs them
+and released as soon as their contents have been consumed. Targets with non-overlapping lifetimes within a frame
+and equal descriptors are then the same objects, so a chain of N passes only requires as many textures as are alive at the same time.
+Pool entries, which have not been used for a number of frames, are released.
+\code
+LLGL::TransientTexturePool pool(*renderer);
+
+// Once per frame
+auto sceneTarget = pool.Acquire({ resolution, LLGL::TextureFormat::RGBA16Float });
+// Render scene into 'sceneTarget.renderTarget' ...
+
+auto blurTarget = pool.Acquire({ resolution, LLGL::TextureFormat::RGBA16Float });
+// Render blur pass from 'sceneTarget.texture' into 'blurTarget.renderTarget' ...
+
+pool.Release(sceneTarget);  // Contents of the scene target are no longer required
+// ...
+
+pool.NextFrame();
+\endcode
+\note This is independent of the render system and its memory management, i.e. transient targets share objects, but no heap memory.
+*/
+class LLGL_EXPORT TransientTexturePool
+{
+
+    public:
+
+        TransientTexturePool(const TransientTexturePool&) = delete;
+        TransientTexturePool& operator = (const TransientTexturePool&) = delete;
+
+        /**
+        \brief Initializes the pool for the specified render system.
+        \param[in] renderSystem Specifies the render system, which is used to create and release the textures and render targets.
+        \param[in] maxUnusedFrames Specifies the number of frames, after which unused pool entries are released. By default 2.
+        */
+        TransientTexturePool(RenderSystem& renderSystem, unsigned int maxUnusedFrames = 2);
+
+        //! Releases all textures and render targets of this pool.
+        ~TransientTexturePool();
+
+        /**
+        \brief Acquires a transient render target with the specified descriptor.
+        \remarks The target is reused from the pool if any free entry with an equal descriptor exists, otherwise a new entry is created.
+        The previous contents of the returned texture are undefined.
+        The target remains in use until it is released or until the next call to "NextFrame".
+        \throw std::invalid_argument If the width or height of the descriptor is 0.
+        */
+        TransientTarget Acquire(const TransientTextureDescriptor& desc);
+
+        /**
+        \brief Releases the specified transient target for reuse within the current frame.
+        \remarks The target must not be used after it has been released, since it can be returned by any further acquisition.
+        \throw std::invalid_argument If the target has not been acquired from this pool or has already been released.
+        */
+        void Release(const TransientTarget& target);
+
+        /**
+        \brief Releases all acquired targets and starts a new frame.
+        \remarks Pool entries, which have not been used for more than the maximal number of unused frames, are released.
+        */
+        void NextFrame();
+
+        //! Releases all textures and render targets of this pool. All acquired targets become invalid.
+        void Clear();
+
+        //! Returns the number of textures that are currently allocated by this pool.
+        inline std::size_t GetNumTextures() const
+        {
+            return entries_.size();
+        }
+
+        //! Returns the number of textures that are currently acquired.
+        std::size_t GetNumTexturesInUse() const;
+
+    private:
+
+        struct Entry
+        {
+            TransientTextureDescriptor  desc;
+            Texture*                    texture         = nullptr;
+            RenderTarget*               renderTarget    = nullptr;
+            bool                        inUse           = false;
+            std::uint64_t               lastFrame       = 0;
+        };
+
+        Entry CreateEntry(const TransientTextureDescriptor& desc);
+        void ReleaseEntry(Entry& entry);
+
+        RenderSystem&       renderSystem_;
+        unsigned int        maxUnusedFrames_    = 2;
+
+        std::vector<Entry>  entries_;
+        std::uint64_t       frame_              = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
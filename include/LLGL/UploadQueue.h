@@ -0,0 +1,226 @@
+/*
+ * UploadQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_UPLOAD_QUEUE_H
+#define LLGL_UPLOAD_QUEUE_H
+
+
+#include "Export.h"
+#include "RenderSystem.h"
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class AsyncFileRead;
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Upload queue descriptor structure.
+\see UploadQueue
+*/
+struct UploadQueueDescriptor
+{
+    /**
+    \brief Specifies the maximal number of bytes that are uploaded with a single call to "UploadQueue::Flush". By default 16 MB.
+    \remarks This limits the time the render thread spends on uploads per frame. At least one upload is always executed per flush,
+    even if it is larger than this limit. If this is 0, all pending uploads are executed with each flush.
+    */
+    std::size_t maxBytesPerFlush    = 16 * 1024 * 1024;
+
+    /**
+    \brief Specifies the maximal number of bytes of staging memory that are kept for reuse. By default 64 MB.
+    \remarks Staging memory that exceeds this limit is released once its upload has been executed.
+    */
+    std::size_t maxStagingPoolSize  = 64 * 1024 * 1024;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Queue for asynchronous buffer and texture uploads.
+\remarks Buffer and texture writes can be submitted from any thread. The data is copied into pooled staging memory
+on the submitting thread, so the source data can be released immediately after submission.
+The render thread then executes the pending uploads in submission order with "Flush", typically once per frame.
+Each upload is executed with RenderSystem::WriteBufferAsync or RenderSystem::WriteTextureAsync, i.e. the data is passed to the GPU
+through a staging buffer (a pixel unpack buffer for OpenGL), and the render thread does not wait for the GPU to finish the copy.
+Each submission returns a ticket, which increases in submission order: once the GPU has finished an upload,
+all tickets up to and including its ticket are complete. The completion is detected by the next call to "Flush" or "FlushAll".
+\code
+// Streaming thread
+auto ticket = uploadQueue.WriteTexture(*texture, subTextureDesc, imageDesc);
+
+// Render thread (once per frame)
+uploadQueue.Flush();
+if (uploadQueue.IsComplete(ticket))
+    // Texture is ready to be used ...
+\endcode
+\note The resources that are referenced by pending uploads must not be released before their uploads are complete.
+\note Only the render systems for which WriteBufferAsync and WriteTextureAsync are asynchronous track the completion on the GPU
+(OpenGL and Direct3D 11). With the other render systems, the uploads are written immediately during "Flush", and their tickets are complete right away.
+*/
+class LLGL_EXPORT UploadQueue
+{
+
+    public:
+
+        UploadQueue(const UploadQueue&) = delete;
+        UploadQueue& operator = (const UploadQueue&) = delete;
+
+        //! Initializes the upload queue for the specified render system.
+        UploadQueue(RenderSystem& renderSystem, const UploadQueueDescriptor& desc = {});
+
+        //! Releases the fences of the uploads that are still in flight. This must be called on the thread the render system is used with.
+        ~UploadQueue();
+
+        /**
+        \brief Submits a write of the specified data into the buffer at the specified offset.
+        \return Ticket of this upload.
+        \remarks This function is thread safe.
+        \see RenderSystem::WriteBuffer
+        */
+        std::uint64_t WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset = 0);
+
+        /**
+        \brief Submits a write of the specified image into the texture region.
+        \return Ticket of this upload.
+        \remarks This function is thread safe. The size of the image data is determined by the sub-texture region,
+        or by the 'compressedSize' attribute for compressed images, which must not be 0 for this function.
+        \throw std::invalid_argument If the image is compressed and 'imageDesc.compressedSize' is 0, or if the texture type is not supported.
+        \see RenderSystem::WriteTexture
+        */
+        std::uint64_t WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc);
+
+        /**
+        \brief Submits a write of the specified file range into the buffer at the specified offset.
+        \param[in] filename Specifies the file to read from.
+        \param[in] fileOffset Specifies the offset (in bytes) of the data within the file.
+        \param[in] dataSize Specifies the number of bytes to read from the file and write into the buffer.
+        \param[in] offset Specifies the offset (in bytes) within the buffer.
+        \return Ticket of this upload.
+        \remarks The file is read asynchronously directly into staging memory (with overlapped I/O on Win32, and POSIX AIO otherwise),
+        so the data neither passes through an intermediate application buffer, nor blocks the submitting thread.
+        "Flush" stops at uploads whose file reads are still in flight, while "FlushAll" waits for them.
+        This function is thread safe.
+        \throw std::runtime_error If the file could not be opened, or the read could not be started.
+        If the read fails later, "Flush" or "FlushAll" throws a std::runtime_error, and the ticket of the failed upload is completed
+        together with the uploads that have been submitted before it.
+        */
+        std::uint64_t WriteBufferFromFile(Buffer& buffer, const std::string& filename, std::uint64_t fileOffset, std::size_t dataSize, std::size_t offset = 0);
+
+        /**
+        \brief Submits a write of the specified file range into the texture region.
+        \param[in] imageDesc Specifies the format of the image data in the file. Its 'buffer' attribute is ignored.
+        \remarks The file is read asynchronously directly into staging memory (see WriteBufferFromFile).
+        The size of the file range is determined the same way as the size of the image data in "WriteTexture".
+        \see WriteBufferFromFile
+        \see WriteTexture
+        */
+        std::uint64_t WriteTextureFromFile(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc, const std::string& filename, std::uint64_t fileOffset);
+
+        /**
+        \brief Executes the pending uploads in submission order, until the limit of bytes per flush has been reached,
+        and completes the tickets of all uploads the GPU has finished so far.
+        \return Ticket of the last completed upload.
+        \remarks This must be called on the thread the render system is used with. This function never waits for the GPU.
+        \see UploadQueueDescriptor::maxBytesPerFlush
+        */
+        std::uint64_t Flush();
+
+        /**
+        \brief Executes all pending uploads, regardless of the limit of bytes per flush, and waits until the GPU has finished all of them.
+        \return Ticket of the last completed upload.
+        */
+        std::uint64_t FlushAll();
+
+        /**
+        \brief Returns true if the GPU has finished the upload with the specified ticket (and all uploads submitted before it).
+        \remarks The completion is detected by "Flush" or "FlushAll", so a ticket is not complete before the next call to one of these functions.
+        This function is thread safe.
+        */
+        inline bool IsComplete(std::uint64_t ticket) const
+        {
+            return (ticket <= completedTicket_.load());
+        }
+
+        //! Returns the ticket of the last completed upload, or 0 if no upload has been executed yet. This function is thread safe.
+        inline std::uint64_t GetCompletedTicket() const
+        {
+            return completedTicket_.load();
+        }
+
+        //! Returns the number of pending uploads, which have not been executed by "Flush" or "FlushAll" yet. This function is thread safe.
+        std::size_t GetNumPendingUploads() const;
+
+    private:
+
+        using StagingBlock = std::vector<char>;
+
+        struct Upload
+        {
+            std::uint64_t                   ticket          = 0;
+            Buffer*                         buffer          = nullptr;
+            std::size_t                     offset          = 0;
+            Texture*                        texture         = nullptr;
+            SubTextureDescriptor            subTextureDesc;
+            ImageDescriptor                 imageDesc;
+            std::size_t                     dataSize        = 0;
+            StagingBlock                    staging;
+            std::shared_ptr<AsyncFileRead>  fileRead;
+        };
+
+        // Upload that has been executed, but might still be in progress on the GPU.
+        struct InFlightUpload
+        {
+            std::uint64_t                   ticket          = 0;
+            Fence*                          fence           = nullptr;
+        };
+
+        StagingBlock AcquireStagingBlock(std::size_t size);
+        void ReleaseStagingBlock(StagingBlock&& block);
+
+        std::uint64_t Submit(Upload&& upload, const void* data);
+        std::uint64_t SubmitFromFile(Upload&& upload, const std::string& filename, std::uint64_t fileOffset);
+        std::uint64_t ExecuteUploads(std::size_t maxBytes, bool waitForCompletion);
+        void ExecuteUpload(Upload& upload);
+        void CompleteUploads(bool waitForCompletion);
+
+        RenderSystem&                   renderSystem_;
+        UploadQueueDescriptor           desc_;
+
+        mutable std::mutex              mutex_;
+        std::deque<Upload>              pendingUploads_;
+        std::vector<StagingBlock>       stagingPool_;
+        std::size_t                     stagingPoolSize_    = 0;
+
+        std::deque<InFlightUpload>      inFlightUploads_;   // Only accessed on the render thread
+
+        std::uint64_t                   nextTicket_         = 1;
+        std::atomic<std::uint64_t>      completedTicket_    { 0 };
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
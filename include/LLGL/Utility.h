@@ -17,6 +17,9 @@ THIS HEADER MUST BE EXPLICITLY INCLUDED
 #include "Export.h"
 #include "TextureFlags.h"
 #include "BufferFlags.h"
+#include "RenderSystemFlags.h"
+#include <string>
+#include <cstddef>
 
 
 namespace LLGL
@@ -72,6 +75,40 @@ LLGL_EXPORT BufferDescriptor ConstantBufferDesc(unsigned int size, long flags =
 //! Returns a BufferDescriptor structure for a storage buffer.
 LLGL_EXPORT BufferDescriptor StorageBufferDesc(unsigned int size, const StorageBufferType storageType, unsigned int stride, long flags = BufferFlags::MapReadAccess | BufferFlags::MapWriteAccess);
 
+/* ----- Vertex data utility functions ----- */
+
+/**
+\brief Converts interleaved vertices from one vertex format into another, e.g. to quantize floating-point vertices into compact vector types.
+\param[in] srcVertices Pointer to the source vertices with the layout of 'srcFormat'.
+\param[in] srcFormat Specifies the source vertex format.
+\param[out] dstVertices Pointer to the destination vertices with the layout of 'dstFormat'. This must provide at least 'numVertices * dstFormat.stride' bytes.
+\param[in] dstFormat Specifies the destination vertex format. Each attribute is read from the source attribute with the same name and semantic index.
+\param[in] numVertices Specifies the number of vertices to convert.
+\remarks Source attributes are either copied (if they have the same vector type as the destination attribute),
+or they must be floating-point vectors (i.e. VectorType::Float to VectorType::Float4), which are converted into the destination vector type.
+Missing components are filled with (0, 0, 0, 1) and values are clamped to the range of normalized vector types.
+Both vertex formats must describe a single vertex buffer, i.e. all attributes use the same input slot.
+\throws std::invalid_argument If a destination attribute has no source attribute, or its source attribute can not be converted.
+\see IsCompactVectorType
+*/
+LLGL_EXPORT void ConvertVertices(const void* srcVertices, const VertexFormat& srcFormat, void* dstVertices, const VertexFormat& dstFormat, std::size_t numVertices);
+
+/**
+\brief Generates a shader include to fetch vertices from a storage buffer instead of the input assembler (also referred to as "vertex pulling").
+\param[in] vertexFormat Specifies the vertex format of the vertices inside the storage buffer.
+\param[in] language Specifies the shading language of the generated code. This must be GLSL 4.30 or later, GLSL ES 3.10 or later, or HLSL 5.0 or later.
+\param[in] slot Specifies the binding slot of the storage buffer, i.e. the SSBO binding point for GLSL, or the SRV register for HLSL.
+\return Shader source, which declares the storage buffer 'vertexPullingData', the structure 'PulledVertex' with one member per vertex attribute,
+and the function 'PulledVertex FetchVertex(uint vertexID)'. The storage buffer must be bound as byte address buffer with CommandBuffer::SetStorageBuffer.
+\remarks With vertex pulling, no vertex buffer is bound and the shader program has no vertex layout (i.e. ShaderProgram::BuildInputLayout is not called).
+Instead, the vertex shader fetches its vertex with 'gl_VertexID' or 'SV_VertexID', so meshes with different vertex formats can be drawn without layout changes.
+Index data can be pulled the same way, by reading the vertex index from another storage buffer before calling 'FetchVertex'.
+\remarks Each attribute is named after VertexAttribute::name, followed by VertexAttribute::semanticIndex if it is greater than zero.
+\throws std::invalid_argument If the shading language is not supported, if the stride or an attribute offset is not a multiple of 4,
+if an attribute has a double-precision vector type, or if the attributes are spread over more than one input slot.
+*/
+LLGL_EXPORT std::string GenerateVertexPullingShader(const VertexFormat& vertexFormat, const ShadingLanguage language, unsigned int slot = 0);
+
 /** @} */
 
 
@@ -87,7 +87,11 @@ struct LLGL_EXPORT VertexAttribute
     */
     unsigned int    instanceDivisor = 0;
 
-    //! Specifies whether non-floating-point data types are to be converted to floating-points. By default false.
+    /**
+    \brief Specifies whether non-floating-point data types are to be converted to floating-points. By default false.
+    \remarks This has no effect for compact vector types (e.g. VectorType::Half2 or VectorType::UByte4Norm), which are always converted.
+    \see IsCompactVectorType
+    */
     bool            conversion      = false;
 
     //! Byte offset within each vertex. By default 0.
@@ -12,6 +12,7 @@
 #include "Export.h"
 #include "VertexAttribute.h"
 #include <vector>
+#include <cstdint>
 
 
 namespace LLGL
@@ -51,6 +52,23 @@ struct LLGL_EXPORT VertexFormat
     */
     void AppendAttributes(const VertexFormat& format);
 
+    /**
+    \brief Rebuilds the compact layout and the layout hash from the current vertex attributes.
+    \remarks This is called automatically by "AppendAttribute" and "AppendAttributes",
+    but it must be called manually if the 'attributes' member has been modified directly.
+    \see compactLayout
+    \see layoutHash
+    */
+    void UpdateLayout();
+
+    /**
+    \brief Returns true if this vertex format has the same attribute layout as the specified vertex format.
+    \remarks This only compares the layout hashes and the compact layouts, i.e. no attribute names are compared.
+    The result is equivalent to comparing the 'attributes' members, as long as the layouts of both formats are up to date.
+    \see UpdateLayout
+    */
+    bool HasEqualLayout(const VertexFormat& rhs) const;
+
     /**
     \brief Specifies the list of vertex attributes.
     \remarks Use "AppendAttribute" or "AppendAttributes" to append new attributes.
@@ -63,6 +81,19 @@ struct LLGL_EXPORT VertexFormat
     but it can also modified manually. It is commonly the size of all vertex attributes.
     */
     unsigned int                    stride = 0;
+
+    /**
+    \brief Compact binary form of all vertex attributes, which is used to compare vertex layouts without string comparisons.
+    \remarks Each attribute is stored as a fixed-size record, in which the attribute name is replaced by its interned name ID.
+    Equal attribute names have the same ID throughout the entire application. This is updated automatically by "UpdateLayout".
+    */
+    std::vector<std::uint32_t>      compactLayout;
+
+    /**
+    \brief 64-bit hash of the compact layout, which can be used as key in caches of vertex layouts. The stride is not included.
+    \remarks This is updated automatically by "UpdateLayout". By default 0, which is also the hash of an empty vertex format.
+    */
+    std::uint64_t                   layoutHash = 0;
 };
 
 
@@ -15,12 +15,17 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+struct WindowEvent;
+struct WindowEventThread;
+
+
 //! Value for an invalid window timer ID.
 static const unsigned int invalidWindowTimerID = 0;
 
@@ -236,6 +241,34 @@ class LLGL_EXPORT Window : public Surface
         */
         bool ProcessEvents();
 
+        /**
+        \brief Starts a dedicated thread that pumps the OS events of this window into a lock-free event queue.
+        \return True if the event thread is running. Returns false if the platform does not support pumping events on another thread.
+        \remarks While the event thread is running, each event is time-stamped when it arrives,
+        and "ProcessEvents" dispatches all queued events to the event listeners in one batch on the calling thread.
+        Stalls of the render thread therefore no longer delay the OS events.
+        \note Only supported on: Linux. On Win32 and macOS, the events of a window must be pumped by the thread that created it.
+        If the X11 display is provided by the client (see WindowDescriptor::windowContext), XInitThreads must have been called before it was opened.
+        \see GetEventTimestamp
+        */
+        bool StartEventThread();
+
+        //! Stops the event thread if it is running. Events that are still queued are dispatched with the next call to "ProcessEvents".
+        void StopEventThread();
+
+        //! Returns true if the event thread is running.
+        bool HasEventThread() const;
+
+        /**
+        \brief Returns the time (in nanoseconds of a monotonic clock) when the event that is currently dispatched has arrived.
+        \remarks This can be used by the event listeners to measure the input latency.
+        Without an event thread, the events are time-stamped when they are posted.
+        */
+        inline std::uint64_t GetEventTimestamp() const
+        {
+            return eventTimestamp_;
+        }
+
         /* --- Event handling --- */
 
         //! Adds a new event listener to this window.
@@ -287,6 +320,8 @@ class LLGL_EXPORT Window : public Surface
 
     protected:
 
+        Window();
+
         /**
         \briefs Called inside the "ProcessEvents" function after all event listeners received the same event.
         \see ProcessEvents
@@ -294,12 +329,33 @@ class LLGL_EXPORT Window : public Surface
         */
         virtual void OnProcessEvents() = 0;
 
+        /**
+        \brief Returns true if the window supports pumping its events on a dedicated thread. By default false.
+        \remarks If this returns true, "OnProcessEvents" and "OnWaitForEvents" are called on the event thread.
+        Derived classes must then call "StopEventThread" in their destructor.
+        \see StartEventThread
+        */
+        virtual bool IsEventThreadSupported() const;
+
+        /**
+        \brief Waits on the event thread until new OS events arrive, or until the specified timeout (in milliseconds) has expired.
+        \remarks The default implementation sleeps for the specified timeout.
+        */
+        virtual void OnWaitForEvents(std::uint32_t timeout);
+
     private:
 
+        bool EnqueueEvent(const WindowEvent& event);
+        void DispatchEvent(const WindowEvent& event);
+        void DispatchQueuedEvents();
+
         std::vector<std::shared_ptr<EventListener>> eventListeners_;
         WindowBehavior                              behavior_;
         bool                                        quit_           = false;
 
+        std::unique_ptr<WindowEventThread>          eventThread_;
+        std::uint64_t                               eventTimestamp_ = 0;
+
 };
 
 
@@ -0,0 +1,102 @@
+/*
+ * Allocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Allocator.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Default allocator on the global heap. Aligned memory blocks are over-allocated,
+and the pointer that has been returned by malloc is stored right in front of the aligned block.
+*/
+class DefaultAllocator final : public Allocator
+{
+
+    public:
+
+        void* Allocate(std::size_t size, std::size_t alignment, const char* /*tag*/) override
+        {
+            if (alignment < alignof(void*))
+                alignment = alignof(void*);
+
+            auto block = std::malloc(size + alignment + sizeof(void*));
+            if (!block)
+                throw std::bad_alloc();
+
+            auto addr = (reinterpret_cast<std::uintptr_t>(block) + sizeof(void*) + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+            auto ptr = reinterpret_cast<void*>(addr);
+            reinterpret_cast<void**>(ptr)[-1] = block;
+
+            return ptr;
+        }
+
+        void Free(void* ptr, std::size_t /*size*/, std::size_t /*alignment*/, const char* /*tag*/) override
+        {
+            if (ptr)
+                std::free(reinterpret_cast<void**>(ptr)[-1]);
+        }
+
+};
+
+static DefaultAllocator         g_defaultAllocator;
+static std::atomic<Allocator*>  g_allocator { &g_defaultAllocator };
+
+
+/*
+ * Allocator class
+ */
+
+Allocator::~Allocator()
+{
+}
+
+
+/*
+ * Global functions
+ */
+
+LLGL_EXPORT void SetAllocator(Allocator* allocator)
+{
+    g_allocator = (allocator != nullptr ? allocator : &g_defaultAllocator);
+}
+
+LLGL_EXPORT Allocator* GetAllocator()
+{
+    return g_allocator;
+}
+
+
+/*
+ * AllocatorDeleter structure
+ */
+
+AllocatorDeleter::AllocatorDeleter(Allocator* allocator, std::size_t size, std::size_t alignment, const char* tag) :
+    allocator { allocator },
+    size      { size      },
+    alignment { alignment },
+    tag       { tag       }
+{
+}
+
+void AllocatorDeleter::operator () (char* ptr) const
+{
+    if (ptr != nullptr && allocator != nullptr)
+        allocator->Free(ptr, size, alignment, tag);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,79 @@
+/*
+ * Allocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CORE_ALLOCATOR_H
+#define LLGL_CORE_ALLOCATOR_H
+
+
+#include <LLGL/Allocator.h>
+#include <cstddef>
+#include <new>
+
+
+namespace LLGL
+{
+
+
+/*
+Standard library allocator that routes the memory of an internal container into the allocator of LLGL (see SetAllocator).
+The allocator is selected when memory is allocated, and memory is freed with the allocator it has been allocated with,
+so the tag of each container is compiled into its type: TTag must be a class with a static function "Name" that returns a string literal.
+*/
+template <typename T, typename TTag>
+class STLAllocator
+{
+
+    public:
+
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = STLAllocator<U, TTag>;
+        };
+
+        STLAllocator() = default;
+
+        template <typename U>
+        STLAllocator(const STLAllocator<U, TTag>&)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(GetAllocator()->Allocate(n * sizeof(T), alignof(T), TTag::Name()));
+        }
+
+        void deallocate(T* ptr, std::size_t n)
+        {
+            GetAllocator()->Free(ptr, n * sizeof(T), alignof(T), TTag::Name());
+        }
+
+};
+
+template <typename T, typename U, typename TTag>
+bool operator == (const STLAllocator<T, TTag>&, const STLAllocator<U, TTag>&)
+{
+    return true;
+}
+
+template <typename T, typename U, typename TTag>
+bool operator != (const STLAllocator<T, TTag>&, const STLAllocator<U, TTag>&)
+{
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
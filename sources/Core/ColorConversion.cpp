@@ -0,0 +1,54 @@
+/*
+ * ColorConversion.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ColorConversion.h>
+#include "ColorKernels.h"
+
+
+namespace LLGL
+{
+
+
+static_assert(sizeof(ColorRGBAub) == 4, "ColorRGBAub must be tightly packed for color batch conversion");
+static_assert(sizeof(ColorRGBAf) == 16, "ColorRGBAf must be tightly packed for color batch conversion");
+
+LLGL_EXPORT void ConvertColors(const ColorRGBAub* src, ColorRGBAf* dst, std::size_t count)
+{
+    ConvertUInt8ToFloat(src, dst, 0, count * 4);
+}
+
+LLGL_EXPORT void ConvertColors(const ColorRGBAf* src, ColorRGBAub* dst, std::size_t count)
+{
+    ConvertFloatToUInt8(src, dst, 0, count * 4);
+}
+
+LLGL_EXPORT void ConvertColorsSRGBToLinear(const ColorRGBAub* src, ColorRGBAf* dst, std::size_t count)
+{
+    ConvertSRGBUInt8ToLinearFloat(reinterpret_cast<const std::uint8_t*>(src), reinterpret_cast<float*>(dst), 4, 3, 0, count);
+}
+
+LLGL_EXPORT void ConvertColorsLinearToSRGB(const ColorRGBAf* src, ColorRGBAub* dst, std::size_t count)
+{
+    ConvertLinearFloatToSRGBUInt8(reinterpret_cast<const float*>(src), reinterpret_cast<std::uint8_t*>(dst), 4, 3, 0, count);
+}
+
+LLGL_EXPORT void PremultiplyAlpha(ColorRGBAub* colors, std::size_t count)
+{
+    PremultiplyAlphaUInt8(reinterpret_cast<std::uint8_t*>(colors), 0, count);
+}
+
+LLGL_EXPORT void PremultiplyAlpha(ColorRGBAf* colors, std::size_t count)
+{
+    PremultiplyAlphaFloat(reinterpret_cast<float*>(colors), 0, count);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,430 @@
+/*
+ * ColorKernels.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ColorKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- Data type conversion ----- */
+
+void ConvertUInt8ToFloat(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src    = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst    = reinterpret_cast<float*>(dstBuffer);
+    auto i      = idxBegin;
+
+    #if defined LLGL_IMAGE_SSE2
+
+    const auto zero     = _mm_setzero_si128();
+    const auto scale    = _mm_set1_ps(255.0f);
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v8     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        auto v16lo  = _mm_unpacklo_epi8(v8, zero);
+        auto v16hi  = _mm_unpackhi_epi8(v8, zero);
+        _mm_storeu_ps(dst + i     , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v16lo, zero)), scale));
+        _mm_storeu_ps(dst + i +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v16lo, zero)), scale));
+        _mm_storeu_ps(dst + i +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v16hi, zero)), scale));
+        _mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v16hi, zero)), scale));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    const auto scale = vdupq_n_f32(1.0f / 255.0f);
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v8     = vld1q_u8(src + i);
+        auto v16lo  = vmovl_u8(vget_low_u8(v8));
+        auto v16hi  = vmovl_u8(vget_high_u8(v8));
+        vst1q_f32(dst + i     , vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16lo))), scale));
+        vst1q_f32(dst + i +  4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16lo))), scale));
+        vst1q_f32(dst + i +  8, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16hi))), scale));
+        vst1q_f32(dst + i + 12, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16hi))), scale));
+    }
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+        dst[i] = static_cast<float>(src[i]) / 255.0f;
+}
+
+void ConvertFloatToUInt8(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src    = reinterpret_cast<const float*>(srcBuffer);
+    auto dst    = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i      = idxBegin;
+
+    /* Values are truncated (like the generic conversion) and saturated to the range [0, 255] */
+    #if defined LLGL_IMAGE_SSE2
+
+    const auto scale = _mm_set1_ps(255.0f);
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v0 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i     ), scale));
+        auto v1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i +  4), scale));
+        auto v2 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i +  8), scale));
+        auto v3 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 12), scale));
+        auto v8 = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v8);
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    const auto scale = vdupq_n_f32(255.0f);
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto v0 = vqmovn_u32(vcvtq_u32_f32(vmulq_f32(vld1q_f32(src + i     ), scale)));
+        auto v1 = vqmovn_u32(vcvtq_u32_f32(vmulq_f32(vld1q_f32(src + i +  4), scale)));
+        auto v2 = vqmovn_u32(vcvtq_u32_f32(vmulq_f32(vld1q_f32(src + i +  8), scale)));
+        auto v3 = vqmovn_u32(vcvtq_u32_f32(vmulq_f32(vld1q_f32(src + i + 12), scale)));
+        vst1q_u8(dst + i, vcombine_u8(vqmovn_u16(vcombine_u16(v0, v1)), vqmovn_u16(vcombine_u16(v2, v3))));
+    }
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+        dst[i] = static_cast<std::uint8_t>(std::max(0.0f, std::min(src[i] * 255.0f, 255.0f)));
+}
+
+/* ----- Half-float conversion ----- */
+
+float HalfToFloat(std::uint16_t value)
+{
+    std::uint32_t sign      = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+    std::uint32_t exponent  = (value >> 10) & 0x1Fu;
+    std::uint32_t mantissa  = value & 0x03FFu;
+    std::uint32_t bits      = 0;
+
+    if (exponent == 0x1Fu)
+    {
+        /* Infinity or NaN */
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        /* Normalized value: rebias exponent from 15 to 127 */
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    else if (mantissa != 0)
+    {
+        /* Denormalized value: normalize mantissa */
+        exponent = 113u;
+        while ((mantissa & 0x0400u) == 0)
+        {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x03FFu) << 13);
+    }
+    else
+    {
+        /* Signed zero */
+        bits = sign;
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+std::uint16_t FloatToHalf(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    auto sign       = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+    auto exponent   = static_cast<int>((bits >> 23) & 0xFFu);
+    auto mantissa   = bits & 0x007FFFFFu;
+
+    if (exponent == 0xFF)
+    {
+        /* Infinity or NaN (keep NaN quiet) */
+        return static_cast<std::uint16_t>(sign | 0x7C00u | (mantissa != 0 ? 0x0200u : 0u));
+    }
+
+    exponent -= 112;
+
+    if (exponent >= 0x1F)
+    {
+        /* Overflow to infinity */
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+
+    if (exponent <= 0)
+    {
+        /* Underflow to denormalized value or zero */
+        if (exponent < -10)
+            return sign;
+        mantissa |= 0x00800000u;
+        auto shift      = static_cast<std::uint32_t>(14 - exponent);
+        auto halfBits   = mantissa >> shift;
+        auto remainder  = mantissa & ((1u << shift) - 1u);
+        auto halfway    = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (halfBits & 1u) != 0))
+            ++halfBits;
+        return static_cast<std::uint16_t>(sign | halfBits);
+    }
+
+    /* Normalized value: round mantissa to nearest even, which may carry into the exponent */
+    auto halfBits = (static_cast<std::uint32_t>(exponent) << 10) | (mantissa >> 13);
+    auto remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (halfBits & 1u) != 0))
+        ++halfBits;
+
+    return static_cast<std::uint16_t>(sign | halfBits);
+}
+
+void ConvertFloat16ToFloat(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src    = reinterpret_cast<const std::uint16_t*>(srcBuffer);
+    auto dst    = reinterpret_cast<float*>(dstBuffer);
+    auto i      = idxBegin;
+
+    #if defined LLGL_IMAGE_F16C
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(v16));
+    }
+
+    #elif defined LLGL_IMAGE_NEON_FP16
+
+    for (; i + 4 <= idxEnd; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+        dst[i] = HalfToFloat(src[i]);
+}
+
+void ConvertFloatToFloat16(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src    = reinterpret_cast<const float*>(srcBuffer);
+    auto dst    = reinterpret_cast<std::uint16_t*>(dstBuffer);
+    auto i      = idxBegin;
+
+    #if defined LLGL_IMAGE_F16C
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v16);
+    }
+
+    #elif defined LLGL_IMAGE_NEON_FP16
+
+    for (; i + 4 <= idxEnd; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+        dst[i] = FloatToHalf(src[i]);
+}
+
+
+/* ----- Color space conversion ----- */
+
+float SRGBToLinear(float value)
+{
+    return (value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f));
+}
+
+float LinearToSRGB(float value)
+{
+    return (value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f);
+}
+
+// Returns the lookup table of all 8-bit sRGB values in linear space.
+static const float* GetSRGBToLinearTable()
+{
+    static const struct SRGBToLinearTable
+    {
+        SRGBToLinearTable()
+        {
+            for (int i = 0; i < 256; ++i)
+                values[i] = SRGBToLinear(static_cast<float>(i) / 255.0f);
+        }
+
+        float values[256];
+    }
+    table;
+
+    return table.values;
+}
+
+// Number of entries in the lookup table for the linear to sRGB conversion, which is fine enough to be exact within one 8-bit step.
+static const int g_linearToSRGBTableSize = 4096;
+
+// Returns the lookup table of equidistant linear values in the range [0, 1] in 8-bit sRGB space.
+static const std::uint8_t* GetLinearToSRGBTable()
+{
+    static const struct LinearToSRGBTable
+    {
+        LinearToSRGBTable()
+        {
+            for (int i = 0; i < g_linearToSRGBTableSize; ++i)
+            {
+                auto value = LinearToSRGB(static_cast<float>(i) / static_cast<float>(g_linearToSRGBTableSize - 1));
+                values[i] = static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+            }
+        }
+
+        std::uint8_t values[g_linearToSRGBTableSize];
+    }
+    table;
+
+    return table.values;
+}
+
+void ConvertSRGBUInt8ToLinearFloat(
+    const std::uint8_t* src, float* dst, unsigned int numComponents, int alphaIndex, std::size_t idxBegin, std::size_t idxEnd)
+{
+    const auto table = GetSRGBToLinearTable();
+
+    for (auto i = idxBegin * numComponents, n = idxEnd * numComponents; i < n; i += numComponents)
+    {
+        for (unsigned int c = 0; c < numComponents; ++c)
+        {
+            if (static_cast<int>(c) == alphaIndex)
+                dst[i + c] = static_cast<float>(src[i + c]) / 255.0f;
+            else
+                dst[i + c] = table[src[i + c]];
+        }
+    }
+}
+
+void ConvertLinearFloatToSRGBUInt8(
+    const float* src, std::uint8_t* dst, unsigned int numComponents, int alphaIndex, std::size_t idxBegin, std::size_t idxEnd)
+{
+    const auto table    = GetLinearToSRGBTable();
+    const auto maxIndex = static_cast<float>(g_linearToSRGBTableSize - 1);
+
+    for (auto i = idxBegin * numComponents, n = idxEnd * numComponents; i < n; i += numComponents)
+    {
+        for (unsigned int c = 0; c < numComponents; ++c)
+        {
+            auto value = std::max(0.0f, std::min(src[i + c], 1.0f));
+            if (static_cast<int>(c) == alphaIndex)
+                dst[i + c] = static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+            else
+                dst[i + c] = table[static_cast<int>(value * maxIndex + 0.5f)];
+        }
+    }
+}
+
+
+/* ----- Alpha premultiplication ----- */
+
+void PremultiplyAlphaUInt8(std::uint8_t* data, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_SSE2
+
+    const auto zero         = _mm_setzero_si128();
+    const auto bias         = _mm_set1_epi16(128);
+    const auto maskAlpha    = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+    for (; i + 4 <= idxEnd; i += 4)
+    {
+        auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i*4));
+
+        /* Process two pixels per 16-bit vector: broadcast alpha, multiply, and divide by 255 with rounding */
+        __m128i results[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            auto v      = (j == 0 ? _mm_unpacklo_epi8(pixels, zero) : _mm_unpackhi_epi8(pixels, zero));
+            auto alpha  = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            auto alphaM = _mm_or_si128(_mm_andnot_si128(maskAlpha, alpha), _mm_and_si128(maskAlpha, _mm_set1_epi16(255)));
+            auto x      = _mm_add_epi16(_mm_mullo_epi16(v, alphaM), bias);
+            results[j]  = _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i*4), _mm_packus_epi16(results[0], results[1]));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto pixels = vld4_u8(data + i*4);
+        for (int c = 0; c < 3; ++c)
+        {
+            auto x = vmull_u8(pixels.val[c], pixels.val[3]);
+            pixels.val[c] = vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+        }
+        vst4_u8(data + i*4, pixels);
+    }
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+    {
+        auto alpha = static_cast<unsigned int>(data[i*4 + 3]);
+        for (int c = 0; c < 3; ++c)
+        {
+            auto x = static_cast<unsigned int>(data[i*4 + c]) * alpha + 128u;
+            data[i*4 + c] = static_cast<std::uint8_t>((x + (x >> 8)) >> 8);
+        }
+    }
+}
+
+void PremultiplyAlphaFloat(float* data, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_SSE2
+
+    const auto maskAlpha = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+    for (; i < idxEnd; ++i)
+    {
+        auto pixel  = _mm_loadu_ps(data + i*4);
+        auto alpha  = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+        auto scale  = _mm_or_ps(_mm_andnot_ps(maskAlpha, alpha), _mm_and_ps(maskAlpha, _mm_set1_ps(1.0f)));
+        _mm_storeu_ps(data + i*4, _mm_mul_ps(pixel, scale));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    for (; i < idxEnd; ++i)
+    {
+        auto pixel = vld1q_f32(data + i*4);
+        auto alpha = vgetq_lane_f32(pixel, 3);
+        vst1q_f32(data + i*4, vsetq_lane_f32(alpha, vmulq_n_f32(pixel, alpha), 3));
+    }
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+    {
+        auto alpha = data[i*4 + 3];
+        data[i*4    ] *= alpha;
+        data[i*4 + 1] *= alpha;
+        data[i*4 + 2] *= alpha;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,91 @@
+/*
+ * ColorKernels.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_COLOR_KERNELS_H
+#define LLGL_COLOR_KERNELS_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define LLGL_IMAGE_SSE2
+#   include <emmintrin.h>
+#   if defined(__F16C__) || defined(__AVX2__)
+#       define LLGL_IMAGE_F16C
+#       include <immintrin.h>
+#   endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define LLGL_IMAGE_NEON
+#   include <arm_neon.h>
+#   if defined(__aarch64__) || defined(_M_ARM64)
+#       define LLGL_IMAGE_NEON_FP16
+#   endif
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+Color conversion kernels, which are shared by the image conversion and the color batch conversion functions.
+Each kernel converts the components or pixels in the range [idxBegin, idxEnd).
+*/
+
+// Converts 8-bit unsigned normalized components into floating-point components.
+void ConvertUInt8ToFloat(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd);
+
+// Converts floating-point components into 8-bit unsigned normalized components (truncated and saturated).
+void ConvertFloatToUInt8(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd);
+
+// Converts a 16-bit floating-point value (IEEE 754 binary16) into a 32-bit floating-point value.
+float HalfToFloat(std::uint16_t value);
+
+// Converts a 32-bit floating-point value into a 16-bit floating-point value (IEEE 754 binary16), rounded to nearest even.
+std::uint16_t FloatToHalf(float value);
+
+// Converts 16-bit floating-point components into 32-bit floating-point components.
+void ConvertFloat16ToFloat(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd);
+
+// Converts 32-bit floating-point components into 16-bit floating-point components.
+void ConvertFloatToFloat16(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd);
+
+// Converts a single component from sRGB into linear space.
+float SRGBToLinear(float value);
+
+// Converts a single component from linear into sRGB space.
+float LinearToSRGB(float value);
+
+/*
+Converts 8-bit sRGB pixels into floating-point linear pixels with a lookup table.
+The component at 'alphaIndex' is converted without the transfer function, or no component if 'alphaIndex' is negative.
+*/
+void ConvertSRGBUInt8ToLinearFloat(
+    const std::uint8_t* src, float* dst, unsigned int numComponents, int alphaIndex, std::size_t idxBegin, std::size_t idxEnd
+);
+
+// Converts floating-point linear pixels into 8-bit sRGB pixels (rounded to nearest) with a lookup table.
+void ConvertLinearFloatToSRGBUInt8(
+    const float* src, std::uint8_t* dst, unsigned int numComponents, int alphaIndex, std::size_t idxBegin, std::size_t idxEnd
+);
+
+// Multiplies the RGB components of 8-bit RGBA pixels with their alpha component (rounded to nearest).
+void PremultiplyAlphaUInt8(std::uint8_t* data, std::size_t idxBegin, std::size_t idxEnd);
+
+// Multiplies the RGB components of floating-point RGBA pixels with their alpha component.
+void PremultiplyAlphaFloat(float* data, std::size_t idxBegin, std::size_t idxEnd);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,7 +6,9 @@
  */
 
 #include "Exception.h"
+#include <LLGL/Log.h>
 #include <stdexcept>
+#include <mutex>
 
 
 namespace LLGL
@@ -25,6 +27,44 @@ LLGL_EXPORT void ThrowNotImplemented(const std::string& functionName)
     throw std::runtime_error(functionName + " function is not implemented yet");
 }
 
+#ifdef LLGL_DISABLE_EXCEPTIONS
+
+static std::mutex           g_errorCallbackMutex;
+static Log::ErrorCallback   g_errorCallback;
+
+#endif
+
+LLGL_EXPORT void ReportRuntimeError(const std::string& message)
+{
+    #ifdef LLGL_DISABLE_EXCEPTIONS
+
+    /* Errors are rare, so the lock is only taken on the error path */
+    std::lock_guard<std::mutex> guard(g_errorCallbackMutex);
+    if (g_errorCallback)
+        g_errorCallback(message);
+    else
+        Log::Post(Log::Severity::Error, message);
+
+    #else
+
+    throw std::runtime_error(message);
+
+    #endif
+}
+
+namespace Log
+{
+
+LLGL_EXPORT void SetErrorCallback(const ErrorCallback& callback)
+{
+    #ifdef LLGL_DISABLE_EXCEPTIONS
+    std::lock_guard<std::mutex> guard(g_errorCallbackMutex);
+    g_errorCallback = callback;
+    #endif
+}
+
+} // /namespace Log
+
 
 } // /namespace LLGL
 
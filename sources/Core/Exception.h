@@ -25,6 +25,12 @@ LLGL_EXPORT void ThrowNotSupported(const std::string& featureName);
 [[noreturn]]
 LLGL_EXPORT void ThrowNotImplemented(const std::string& functionName);
 
+/*
+Throws an std::runtime_error exception with the specified message, or passes it to the error callback if LLGL_DISABLE_EXCEPTIONS is defined.
+Hot paths must return with an error code after this call, since it only returns without exceptions.
+*/
+LLGL_EXPORT void ReportRuntimeError(const std::string& message);
+
 
 } // /namespace LLGL
 
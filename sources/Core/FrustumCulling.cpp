@@ -0,0 +1,304 @@
+/*
+ * FrustumCulling.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_ENABLE_UTILITY
+
+#include <LLGL/FrustumCulling.h>
+#include "ThreadPool.h"
+#include <atomic>
+#include <cmath>
+
+#if defined(__AVX__)
+#   define LLGL_CULLING_AVX
+#   include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define LLGL_CULLING_SSE2
+#   include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define LLGL_CULLING_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Minimal number of bitmask entries (32 objects each) each worker thread shall process
+static const std::size_t g_threadMinWorkSize = 128;
+
+static std::uint32_t CountBits(std::uint32_t bits)
+{
+    bits = bits - ((bits >> 1) & 0x55555555u);
+    bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+    return ((((bits + (bits >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+}
+
+static Gs::Vector4f MakePlane(const Gs::Matrix4f& m, int row, float sign, int baseRow = 3)
+{
+    Gs::Vector4f plane
+    {
+        m(baseRow, 0) + sign * m(row, 0),
+        m(baseRow, 1) + sign * m(row, 1),
+        m(baseRow, 2) + sign * m(row, 2),
+        m(baseRow, 3) + sign * m(row, 3),
+    };
+
+    /* Normalize plane so the sphere radius can be compared with the plane distance; degenerated planes contain all points */
+    auto length = std::sqrt(plane.x*plane.x + plane.y*plane.y + plane.z*plane.z);
+    if (length > 0.0f)
+    {
+        plane.x /= length;
+        plane.y /= length;
+        plane.z /= length;
+        plane.w /= length;
+    }
+    else
+        plane = Gs::Vector4f { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    return plane;
+}
+
+/*
+Input of the plane test for each object i: dot(plane.xyz, (x[i], y[i], z[i])) + plane.w + r[i] >= 0.
+Spheres use their centers for all planes and their radius as 'r', while boxes use their corner
+that is farthest along the plane normal and no 'r', so the corner arrays are selected per plane.
+*/
+struct PlaneTest
+{
+    const float*    x;
+    const float*    y;
+    const float*    z;
+    const float*    r;
+    float           a;
+    float           b;
+    float           c;
+    float           d;
+};
+
+// Returns the bit of the specified object, which is set if it is on the inner side of all planes.
+static std::uint32_t TestObject(const PlaneTest* tests, std::size_t i)
+{
+    for (int p = 0; p < 6; ++p)
+    {
+        const auto& t = tests[p];
+        auto dist = t.a * t.x[i] + t.b * t.y[i] + t.c * t.z[i] + t.d;
+        if (t.r != nullptr)
+            dist += t.r[i];
+        if (dist < 0.0f)
+            return 0;
+    }
+    return 1;
+}
+
+// Returns the visibility bits of the 32 objects starting at the specified index.
+static std::uint32_t TestObjectWord(const PlaneTest* tests, std::size_t first)
+{
+    std::uint32_t bits = 0;
+
+    #if defined LLGL_CULLING_AVX
+
+    const auto zero = _mm256_setzero_ps();
+    for (std::size_t i = 0; i < 32; i += 8)
+    {
+        auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p)
+        {
+            const auto& t = tests[p];
+            auto dist = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(t.a), _mm256_loadu_ps(t.x + first + i)), _mm256_mul_ps(_mm256_set1_ps(t.b), _mm256_loadu_ps(t.y + first + i))),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(t.c), _mm256_loadu_ps(t.z + first + i)), _mm256_set1_ps(t.d))
+            );
+            if (t.r != nullptr)
+                dist = _mm256_add_ps(dist, _mm256_loadu_ps(t.r + first + i));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, zero, _CMP_GE_OQ));
+        }
+        bits |= static_cast<std::uint32_t>(_mm256_movemask_ps(inside)) << i;
+    }
+
+    #elif defined LLGL_CULLING_SSE2
+
+    const auto zero = _mm_setzero_ps();
+    for (std::size_t i = 0; i < 32; i += 4)
+    {
+        auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p)
+        {
+            const auto& t = tests[p];
+            auto dist = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.a), _mm_loadu_ps(t.x + first + i)), _mm_mul_ps(_mm_set1_ps(t.b), _mm_loadu_ps(t.y + first + i))),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c), _mm_loadu_ps(t.z + first + i)), _mm_set1_ps(t.d))
+            );
+            if (t.r != nullptr)
+                dist = _mm_add_ps(dist, _mm_loadu_ps(t.r + first + i));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, zero));
+        }
+        bits |= static_cast<std::uint32_t>(_mm_movemask_ps(inside)) << i;
+    }
+
+    #elif defined LLGL_CULLING_NEON
+
+    const std::uint32_t laneBitsData[4] = { 1, 2, 4, 8 };
+    const auto laneBits = vld1q_u32(laneBitsData);
+    for (std::size_t i = 0; i < 32; i += 4)
+    {
+        auto inside = vdupq_n_u32(~0u);
+        for (int p = 0; p < 6; ++p)
+        {
+            const auto& t = tests[p];
+            auto dist = vmlaq_n_f32(vdupq_n_f32(t.d), vld1q_f32(t.x + first + i), t.a);
+            dist = vmlaq_n_f32(dist, vld1q_f32(t.y + first + i), t.b);
+            dist = vmlaq_n_f32(dist, vld1q_f32(t.z + first + i), t.c);
+            if (t.r != nullptr)
+                dist = vaddq_f32(dist, vld1q_f32(t.r + first + i));
+            inside = vandq_u32(inside, vcgeq_f32(dist, vdupq_n_f32(0.0f)));
+        }
+        auto laneMask = vandq_u32(inside, laneBits);
+        auto pairMask = vpadd_u32(vget_low_u32(laneMask), vget_high_u32(laneMask));
+        bits |= (vget_lane_u32(pairMask, 0) | vget_lane_u32(pairMask, 1)) << i;
+    }
+
+    #else
+
+    for (std::size_t i = 0; i < 32; ++i)
+        bits |= TestObject(tests, first + i) << i;
+
+    #endif
+
+    return bits;
+}
+
+// Tests all objects against the planes and writes the visibility bitmask, distributed over the shared thread pool.
+static std::uint32_t CullObjects(const PlaneTest* tests, std::uint32_t numObjects, std::uint32_t* visibilityMask)
+{
+    const std::size_t numWords = (numObjects + 31) / 32;
+    std::atomic<std::uint32_t> numVisible { 0 };
+
+    RunParallel(
+        numWords,
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            std::uint32_t count = 0;
+            for (auto word = begin; word < end; ++word)
+            {
+                const auto first = word * 32;
+                std::uint32_t bits = 0;
+
+                /* Test full words with SIMD instructions, and the remaining objects of the last word individually */
+                if (first + 32 <= numObjects)
+                    bits = TestObjectWord(tests, first);
+                else
+                {
+                    for (auto i = first; i < numObjects; ++i)
+                        bits |= TestObject(tests, i) << (i - first);
+                }
+
+                visibilityMask[word] = bits;
+                count += CountBits(bits);
+            }
+            numVisible += count;
+        }
+    );
+
+    return numVisible.load();
+}
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT Frustum MakeFrustum(const Gs::Matrix4f& viewProjection, const ClippingRange clippingRange)
+{
+    Frustum frustum;
+    {
+        frustum.planes[0] = MakePlane(viewProjection, 0, +1.0f);
+        frustum.planes[1] = MakePlane(viewProjection, 0, -1.0f);
+        frustum.planes[2] = MakePlane(viewProjection, 1, +1.0f);
+        frustum.planes[3] = MakePlane(viewProjection, 1, -1.0f);
+        if (clippingRange == ClippingRange::ZeroToOne)
+            frustum.planes[4] = MakePlane(viewProjection, 2, 0.0f, 2);
+        else
+            frustum.planes[4] = MakePlane(viewProjection, 2, +1.0f);
+        frustum.planes[5] = MakePlane(viewProjection, 2, -1.0f);
+    }
+    return frustum;
+}
+
+LLGL_EXPORT std::uint32_t CullBoundingSpheres(
+    const Frustum&              frustum,
+    const BoundingSphereArrays& spheres,
+    std::uint32_t               numObjects,
+    std::uint32_t*              visibilityMask)
+{
+    PlaneTest tests[6];
+
+    for (int p = 0; p < 6; ++p)
+    {
+        const auto& plane = frustum.planes[p];
+        tests[p] = PlaneTest { spheres.centerX, spheres.centerY, spheres.centerZ, spheres.radius, plane.x, plane.y, plane.z, plane.w };
+    }
+
+    return CullObjects(tests, numObjects, visibilityMask);
+}
+
+LLGL_EXPORT std::uint32_t CullBoundingBoxes(
+    const Frustum&              frustum,
+    const BoundingBoxArrays&    boxes,
+    std::uint32_t               numObjects,
+    std::uint32_t*              visibilityMask)
+{
+    PlaneTest tests[6];
+
+    for (int p = 0; p < 6; ++p)
+    {
+        /* Select the corner that is farthest along the plane normal (positive vertex) */
+        const auto& plane = frustum.planes[p];
+        tests[p] = PlaneTest
+        {
+            (plane.x >= 0.0f ? boxes.maxX : boxes.minX),
+            (plane.y >= 0.0f ? boxes.maxY : boxes.minY),
+            (plane.z >= 0.0f ? boxes.maxZ : boxes.minZ),
+            nullptr,
+            plane.x,
+            plane.y,
+            plane.z,
+            plane.w
+        };
+    }
+
+    return CullObjects(tests, numObjects, visibilityMask);
+}
+
+LLGL_EXPORT std::uint32_t GetVisibleIndices(const std::uint32_t* visibilityMask, std::uint32_t numObjects, std::uint32_t* indices)
+{
+    std::uint32_t numIndices = 0;
+
+    for (std::uint32_t word = 0, numWords = (numObjects + 31) / 32; word < numWords; ++word)
+    {
+        /* Skip words without visible objects, and then iterate over the set bits only */
+        for (auto bits = visibilityMask[word]; bits != 0; bits &= bits - 1)
+        {
+            std::uint32_t bit = 0;
+            while ((bits & (1u << bit)) == 0)
+                ++bit;
+            indices[numIndices++] = word * 32 + bit;
+        }
+    }
+
+    return numIndices;
+}
+
+
+} // /namespace LLGL
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,52 @@
+/*
+ * Hash.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_HASH_H
+#define LLGL_HASH_H
+
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Returns the initial value for a 64-bit FNV-1a hash.
+inline std::uint64_t HashInitValue()
+{
+    return 14695981039346656037ull;
+}
+
+// Accumulates the specified data into a 64-bit FNV-1a hash.
+inline void HashBytes(std::uint64_t& hash, const void* data, std::size_t size)
+{
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+// Accumulates the native memory layout of the specified plain value into a 64-bit FNV-1a hash.
+template <typename T>
+void HashValue(std::uint64_t& hash, const T& value)
+{
+    HashBytes(hash, &value, sizeof(value));
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
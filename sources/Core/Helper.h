@@ -137,6 +137,13 @@ SubType* TakeOwnership(std::vector<std::unique_ptr<BaseType>>& objectSet, std::u
     return ref;
 }
 
+// Combines the hash of the specified value with the seed (like boost::hash_combine).
+template <typename T>
+void HashCombine(std::size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
 template <typename T>
 std::string ToHex(T value)
 {
@@ -9,7 +9,9 @@
 #define LLGL_HELPER_MACROS_H
 
 
+#include <LLGL/Log.h>
 #include <Gauss/Equals.h>
+#include <sstream>
 
 
 #define LLGL_COMPARE_MEMBER_EQ(MEMBER) \
@@ -25,6 +27,19 @@
 #define LLGL_CASE_TO_STR(VALUE) \
     case VALUE: return #VALUE
 
+// Posts a log message, which is only formatted if the severity is enabled (see Log::IsEnabled).
+#define LLGL_LOG(SEVERITY, MESSAGE)                                                 \
+    do                                                                              \
+    {                                                                               \
+        if (::LLGL::Log::IsEnabled(::LLGL::Log::Severity::SEVERITY))                \
+        {                                                                           \
+            std::ostringstream logStream_;                                          \
+            logStream_ << MESSAGE;                                                  \
+            ::LLGL::Log::Post(::LLGL::Log::Severity::SEVERITY, logStream_.str());   \
+        }                                                                           \
+    }                                                                               \
+    while (false)
+
 
 #endif
 
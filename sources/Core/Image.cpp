@@ -10,8 +10,14 @@
 #include <limits>
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+#include <vector>
 #include <thread>
 #include "../Renderer/Assertion.h"
+#include "ThreadPool.h"
+#include "ColorKernels.h"
 
 
 namespace LLGL
@@ -119,6 +125,8 @@ static double ReadNormalizedTypedVariant(DataType srcDataType, const VariantCons
             return static_cast<double>(srcBuffer.real32[idx]);
         case DataType::Double:
             return srcBuffer.real64[idx];
+        case DataType::Float16:
+            return static_cast<double>(HalfToFloat(srcBuffer.uint16[idx]));
     }
     return 0.0;
 }
@@ -151,12 +159,311 @@ static void WriteNormalizedTypedVariant(DataType dstDataType, VariantBuffer& dst
         case DataType::Double:
             dstBuffer.real64[idx] = value;
             break;
+        case DataType::Float16:
+            dstBuffer.uint16[idx] = FloatToHalf(static_cast<float>(value));
+            break;
     }
 }
 
 static ByteBuffer AllocByteArray(std::size_t size)
 {
-    return ByteBuffer(new char[size]);
+    return AllocByteBuffer(size, "ImageConversion");
+}
+
+// Minimal number of entries each worker thread shall process
+static const std::size_t g_threadMinWorkSize = 64;
+
+/*
+Runs the specified conversion task for the range [0, workSize), which is distributed over at most the specified number of threads.
+The work is distributed over the persistent worker threads of the shared thread pool if there is one, instead of spawning new threads for each call.
+*/
+template <typename Task>
+void RunConversionWorkers(std::size_t workSize, std::size_t threadCount, const Task& task)
+{
+    threadCount = std::min(threadCount, workSize / g_threadMinWorkSize);
+
+    if (threadCount > 1)
+    {
+        if (auto threadPool = GetSharedThreadPool())
+        {
+            /* Execute conversion in chunks on worker threads of the shared thread pool (a few chunks per thread for load balancing) */
+            auto chunkSize = std::max(g_threadMinWorkSize, workSize / (threadCount * 4));
+            threadPool->ParallelFor(workSize, chunkSize, threadCount, task);
+        }
+        else
+        {
+            /* Create worker threads */
+            std::vector<std::thread> workers(threadCount);
+
+            auto workSizePerThread  = workSize / threadCount;
+            auto workSizeRemain     = workSize % threadCount;
+
+            std::size_t offset = 0;
+
+            for (std::size_t i = 0; i < threadCount; ++i)
+            {
+                workers[i] = std::thread(task, offset, offset + workSizePerThread);
+                offset += workSizePerThread;
+            }
+
+            /* Execute conversion of remaining work on main thread */
+            if (workSizeRemain > 0)
+                task(offset, offset + workSizeRemain);
+
+            /* Join worker threads */
+            for (auto& w : workers)
+                w.join();
+        }
+    }
+    else
+    {
+        /* Execute conversion only on main thread */
+        task(0, workSize);
+    }
+}
+
+
+/* ----- Data type conversion kernels ----- */
+
+/*
+Specialized kernels for the most common conversions, which avoid the per-element switch and the round-trip through double.
+Each kernel converts the elements in the range [idxBegin, idxEnd).
+*/
+using DataTypeConversionKernel = void (*)(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd);
+
+static void ConvertUInt16ToFloat(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src    = reinterpret_cast<const std::uint16_t*>(srcBuffer);
+    auto dst    = reinterpret_cast<float*>(dstBuffer);
+    auto i      = idxBegin;
+
+    #if defined LLGL_IMAGE_SSE2
+
+    const auto zero     = _mm_setzero_si128();
+    const auto scale    = _mm_set1_ps(65535.0f);
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i    , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v16, zero)), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v16, zero)), scale));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    const auto scale = vdupq_n_f32(1.0f / 65535.0f);
+
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        auto v16 = vld1q_u16(src + i);
+        vst1q_f32(dst + i    , vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v16))), scale));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v16))), scale));
+    }
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+        dst[i] = static_cast<float>(src[i]) / 65535.0f;
+}
+
+// Returns the specialized kernel for the specified data type conversion, or null if there is none.
+static DataTypeConversionKernel FindDataTypeConversionKernel(DataType srcDataType, DataType dstDataType)
+{
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float)
+        return ConvertUInt8ToFloat;
+    if (srcDataType == DataType::Float && dstDataType == DataType::UInt8)
+        return ConvertFloatToUInt8;
+    if (srcDataType == DataType::UInt16 && dstDataType == DataType::Float)
+        return ConvertUInt16ToFloat;
+    if (srcDataType == DataType::Float16 && dstDataType == DataType::Float)
+        return ConvertFloat16ToFloat;
+    if (srcDataType == DataType::Float && dstDataType == DataType::Float16)
+        return ConvertFloatToFloat16;
+    return nullptr;
+}
+
+
+/* ----- Format conversion kernels ----- */
+
+/*
+Specialized kernels for the most common format conversions, which avoid the per-component switch.
+Each kernel converts the pixels in the range [idxBegin, idxEnd).
+*/
+using FormatConversionKernel = void (*)(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd);
+
+// Returns the value of the normalized alpha component 1.0 for the specified data type.
+template <typename T>
+T NormalizedOne()
+{
+    return std::numeric_limits<T>::max();
+}
+
+template <>
+float NormalizedOne<float>()
+{
+    return 1.0f;
+}
+
+template <>
+double NormalizedOne<double>()
+{
+    return 1.0;
+}
+
+template <typename T, std::size_t R, std::size_t G, std::size_t B>
+void ConvertRGBToRGBA(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src    = reinterpret_cast<const T*>(srcBuffer);
+    auto dst    = reinterpret_cast<T*>(dstBuffer);
+    auto alpha  = NormalizedOne<T>();
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        dst[i*4    ] = src[i*3 + R];
+        dst[i*4 + 1] = src[i*3 + G];
+        dst[i*4 + 2] = src[i*3 + B];
+        dst[i*4 + 3] = alpha;
+    }
+}
+
+template <typename T>
+void SwapRedBlue(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src = reinterpret_cast<const T*>(srcBuffer);
+    auto dst = reinterpret_cast<T*>(dstBuffer);
+
+    /* Read red and blue components before writing, so this kernel can also convert in place */
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        const T r = src[i*4    ];
+        const T b = src[i*4 + 2];
+        dst[i*4    ] = b;
+        dst[i*4 + 1] = src[i*4 + 1];
+        dst[i*4 + 2] = r;
+        dst[i*4 + 3] = src[i*4 + 3];
+    }
+}
+
+// RGBA <-> BGRA conversion for 8-bit components.
+static void SwapRedBlue8Bit(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto src    = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst    = reinterpret_cast<std::uint8_t*>(dstBuffer);
+    auto i      = idxBegin;
+
+    #if defined LLGL_IMAGE_SSE2
+
+    /* Swap bytes 0 and 2 of each 32-bit pixel */
+    const auto maskGA = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+
+    for (; i + 4 <= idxEnd; i += 4)
+    {
+        auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4));
+        auto ga     = _mm_and_si128(pixels, maskGA);
+        auto rb     = _mm_andnot_si128(maskGA, pixels);
+        auto br     = _mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_or_si128(ga, br));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto pixels     = vld4q_u8(src + i*4);
+        auto red        = pixels.val[0];
+        pixels.val[0]   = pixels.val[2];
+        pixels.val[2]   = red;
+        vst4q_u8(dst + i*4, pixels);
+    }
+
+    #endif
+
+    SwapRedBlue<std::uint8_t>(src, dst, i, idxEnd);
+}
+
+// RGB -> RGBA conversion for 8-bit unsigned components.
+static void ConvertRGBToRGBAUInt8(const void* srcBuffer, void* dstBuffer, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto i = idxBegin;
+
+    #if defined LLGL_IMAGE_NEON
+
+    auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+    auto dst = reinterpret_cast<std::uint8_t*>(dstBuffer);
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        auto rgb = vld3q_u8(src + i*3);
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(dst + i*4, rgba);
+    }
+
+    #endif
+
+    ConvertRGBToRGBA<std::uint8_t, 0, 1, 2>(srcBuffer, dstBuffer, i, idxEnd);
+}
+
+template <typename T>
+FormatConversionKernel FindFormatConversionKernelTyped(ImageFormat srcFormat, ImageFormat dstFormat)
+{
+    if (dstFormat == ImageFormat::RGBA)
+    {
+        if (srcFormat == ImageFormat::RGB)
+            return ConvertRGBToRGBA<T, 0, 1, 2>;
+        if (srcFormat == ImageFormat::BGR)
+            return ConvertRGBToRGBA<T, 2, 1, 0>;
+    }
+    if ( ( srcFormat == ImageFormat::RGBA && dstFormat == ImageFormat::BGRA ) ||
+         ( srcFormat == ImageFormat::BGRA && dstFormat == ImageFormat::RGBA ) )
+    {
+        return SwapRedBlue<T>;
+    }
+    return nullptr;
+}
+
+// Returns the specialized kernel for the specified format conversion, or null if there is none.
+static FormatConversionKernel FindFormatConversionKernel(ImageFormat srcFormat, DataType dataType, ImageFormat dstFormat)
+{
+    switch (dataType)
+    {
+        case DataType::Int8:
+        case DataType::UInt8:
+            if ( ( srcFormat == ImageFormat::RGBA && dstFormat == ImageFormat::BGRA ) ||
+                 ( srcFormat == ImageFormat::BGRA && dstFormat == ImageFormat::RGBA ) )
+            {
+                return SwapRedBlue8Bit;
+            }
+            if (dataType == DataType::UInt8 && srcFormat == ImageFormat::RGB && dstFormat == ImageFormat::RGBA)
+                return ConvertRGBToRGBAUInt8;
+            if (dataType == DataType::UInt8)
+                return FindFormatConversionKernelTyped<std::uint8_t>(srcFormat, dstFormat);
+            return FindFormatConversionKernelTyped<std::int8_t>(srcFormat, dstFormat);
+        case DataType::Int16:
+            return FindFormatConversionKernelTyped<std::int16_t>(srcFormat, dstFormat);
+        case DataType::UInt16:
+            return FindFormatConversionKernelTyped<std::uint16_t>(srcFormat, dstFormat);
+        case DataType::Int32:
+            return FindFormatConversionKernelTyped<std::int32_t>(srcFormat, dstFormat);
+        case DataType::UInt32:
+            return FindFormatConversionKernelTyped<std::uint32_t>(srcFormat, dstFormat);
+        case DataType::Float:
+            return FindFormatConversionKernelTyped<float>(srcFormat, dstFormat);
+        case DataType::Double:
+            return FindFormatConversionKernelTyped<double>(srcFormat, dstFormat);
+        case DataType::Float16:
+            /* Only swap components, since the normalized alpha of half-floats is not the maximum of 'std::uint16_t' */
+            if ( ( srcFormat == ImageFormat::RGBA && dstFormat == ImageFormat::BGRA ) ||
+                 ( srcFormat == ImageFormat::BGRA && dstFormat == ImageFormat::RGBA ) )
+            {
+                return SwapRedBlue<std::uint16_t>;
+            }
+            return nullptr;
+    }
+    return nullptr;
 }
 
 // Worker thread procedure for the "ConvertImageBufferDataType" function
@@ -177,63 +484,44 @@ static void ConvertImageBufferDataTypeWorker(
     }
 }
 
-// Minimal number of entries each worker thread shall process
-static const std::size_t g_threadMinWorkSize = 64;
-
-static ByteBuffer ConvertImageBufferDataType(
+static void ConvertImageBufferDataType(
     DataType    srcDataType,
     const void* srcBuffer,
     std::size_t srcBufferSize,
     DataType    dstDataType,
+    void*       dstBuffer,
     std::size_t threadCount)
 {
-    /* Allocate destination buffer */
-    auto imageSize      = srcBufferSize / DataTypeSize(srcDataType);
-    auto dstBufferSize  = imageSize * DataTypeSize(dstDataType);
-    auto dstBuffer      = AllocByteArray(dstBufferSize);
+    auto imageSize = srcBufferSize / DataTypeSize(srcDataType);
 
     /* Get variant buffer for source and destination images */
     VariantConstBuffer src(srcBuffer);
-    VariantBuffer dst(dstBuffer.get());
-    
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
+    VariantBuffer dst(dstBuffer);
 
-    if (threadCount > 1)
+    if (auto kernel = FindDataTypeConversionKernel(srcDataType, dstDataType))
     {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-        
-        auto workSize = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-        
-        std::size_t offset = 0;
-        
-        for (std::size_t i = 0; i < threadCount; ++i)
-        {
-            workers[i] = std::thread(
-                ConvertImageBufferDataTypeWorker,
-                srcDataType, std::ref(src),
-                dstDataType, std::ref(dst),
-                offset, offset + workSize
-            );
-            offset += workSize;
-        }
-        
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, offset, offset + workSizeRemain);
-        
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
+        /* Execute specialized conversion kernel */
+        RunConversionWorkers(
+            imageSize,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                kernel(src.raw, dst.raw, idxBegin, idxEnd);
+            }
+        );
     }
     else
     {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, 0, imageSize);
+        /* Execute generic conversion */
+        RunConversionWorkers(
+            imageSize,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, idxBegin, idxEnd);
+            }
+        );
     }
-
-    return dstBuffer;
 }
 
 static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
@@ -264,6 +552,9 @@ static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
         case DataType::Double:
             var.real64 = (setMin ? 0.0 : 1.0);
             break;
+        case DataType::Float16:
+            var.uint16 = (setMin ? 0x0000 : 0x3C00);
+            break;
     }
 }
 
@@ -281,6 +572,7 @@ static void CopyTypedVariant(DataType dataType, const VariantConstBuffer& srcBuf
             dst.int16 = srcBuffer.int16[idx];
             break;
         case DataType::UInt16:
+        case DataType::Float16:
             dst.uint16 = srcBuffer.uint16[idx];
             break;
         case DataType::Int32:
@@ -312,6 +604,7 @@ static void CopyTypedVariant(DataType dataType, VariantBuffer& dstBuffer, std::s
             dstBuffer.int16[idx] = src.int16;
             break;
         case DataType::UInt16:
+        case DataType::Float16:
             dstBuffer.uint16[idx] = src.uint16;
             break;
         case DataType::Int32:
@@ -421,154 +714,1115 @@ static void ConvertImageBufferFormatWorker(
     }
 }
 
-static ByteBuffer ConvertImageBufferFormat(
+static void ConvertImageBufferFormat(
     ImageFormat srcFormat,
     DataType    srcDataType,
     const void* srcBuffer,
     std::size_t srcBufferSize,
     ImageFormat dstFormat,
+    void*       dstBuffer,
     std::size_t threadCount)
 {
-    /* Allocate destination buffer */
-    auto dataTypeSize   = DataTypeSize(srcDataType);
-    auto srcFormatSize  = ImageFormatSize(srcFormat);
-    auto dstFormatSize  = ImageFormatSize(dstFormat);
-
-    auto imageSize      = srcBufferSize / srcFormatSize;
-    auto dstBufferSize  = imageSize * dstFormatSize;
-    imageSize /= dataTypeSize;
-
-    auto dstBuffer = AllocByteArray(dstBufferSize);
+    auto imageSize = srcBufferSize / ImageFormatSize(srcFormat) / DataTypeSize(srcDataType);
 
     /* Get variant buffer for source and destination images */
     VariantConstBuffer src(srcBuffer);
-    VariantBuffer dst(dstBuffer.get());
-
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
+    VariantBuffer dst(dstBuffer);
 
-    if (threadCount > 1)
+    if (auto kernel = FindFormatConversionKernel(srcFormat, srcDataType, dstFormat))
     {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-        
-        auto workSize = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-        
-        std::size_t offset = 0;
-        
-        for (std::size_t i = 0; i < threadCount; ++i)
-        {
-            workers[i] = std::thread(
-                ConvertImageBufferFormatWorker,
-                srcFormat, srcDataType, std::ref(src),
-                dstFormat, std::ref(dst),
-                offset, offset + workSize
-            );
-            offset += workSize;
-        }
-        
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-            ConvertImageBufferFormatWorker(srcFormat, srcDataType, src, dstFormat, dst, offset, offset + workSizeRemain);
-        
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
+        /* Execute specialized conversion kernel */
+        RunConversionWorkers(
+            imageSize,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                kernel(src.raw, dst.raw, idxBegin, idxEnd);
+            }
+        );
     }
     else
     {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferFormatWorker(srcFormat, srcDataType, src, dstFormat, dst, 0, imageSize);
+        /* Execute generic conversion */
+        RunConversionWorkers(
+            imageSize,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                ConvertImageBufferFormatWorker(srcFormat, srcDataType, src, dstFormat, dst, idxBegin, idxEnd);
+            }
+        );
     }
+}
 
-    return dstBuffer;
+// Returns the size (in bytes) of the specified source image buffer after conversion.
+static std::size_t GetConvertedImageBufferSize(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    std::size_t srcBufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType)
+{
+    auto numElements = srcBufferSize / (ImageFormatSize(srcFormat) * DataTypeSize(srcDataType));
+    return numElements * ImageFormatSize(dstFormat) * DataTypeSize(dstDataType);
 }
 
+static void ValidateImageConversion(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    const void* srcBuffer,
+    std::size_t srcBufferSize,
+    ImageFormat dstFormat)
+{
+    LLGL_ASSERT_PTR(srcBuffer);
 
-/* ----- Public structures ----- */
+    if (IsCompressedFormat(srcFormat) || IsCompressedFormat(dstFormat))
+        throw std::invalid_argument("can not convert compressed image formats");
+    if (IsDepthStencilFormat(srcFormat) || IsDepthStencilFormat(dstFormat))
+        throw std::invalid_argument("can not convert depth-stencil image formats");
+    if (srcBufferSize % (DataTypeSize(srcDataType) * ImageFormatSize(srcFormat)) != 0)
+        throw std::invalid_argument("source buffer size is not a multiple of the source data type size");
+}
 
-unsigned int ImageDescriptor::GetElementSize() const
+static std::size_t GetConversionThreadCount(std::size_t threadCount)
 {
-    return ImageFormatSize(format) * DataTypeSize(dataType);
+    return (threadCount == maxThreadCount ? std::thread::hardware_concurrency() : threadCount);
 }
 
-
-/* ----- Public functions ----- */
-
-LLGL_EXPORT unsigned int ImageFormatSize(const ImageFormat imageFormat)
+/*
+Converts the source image buffer into the destination buffer, which must be large enough for the converted image.
+An intermediate buffer is only allocated if both the data type and the image format must be converted.
+*/
+static void ConvertImageBufferIntoDestination(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    const void* srcBuffer,
+    std::size_t srcBufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    void*       dstBuffer,
+    std::size_t threadCount)
 {
-    switch (imageFormat)
+    if (srcDataType != dstDataType && srcFormat != dstFormat)
     {
-        case ImageFormat::R:                return 1;
-        case ImageFormat::RG:               return 2;
-        case ImageFormat::RGB:              return 3;
-        case ImageFormat::BGR:              return 3;
-        case ImageFormat::RGBA:             return 4;
-        case ImageFormat::BGRA:             return 4;
-        case ImageFormat::ARGB:             return 4;
-        case ImageFormat::ABGR:             return 4;
-        case ImageFormat::Depth:            return 1;
-        case ImageFormat::DepthStencil:     return 2;
-        case ImageFormat::CompressedRGB:    return 0;
-        case ImageFormat::CompressedRGBA:   return 0;
+        /* Convert image data type into intermediate buffer, then convert image format into destination buffer */
+        auto tempBufferSize = GetConvertedImageBufferSize(srcFormat, srcDataType, srcBufferSize, srcFormat, dstDataType);
+        auto tempBuffer     = AllocByteArray(tempBufferSize);
+        ConvertImageBufferDataType(srcDataType, srcBuffer, srcBufferSize, dstDataType, tempBuffer.get(), threadCount);
+        ConvertImageBufferFormat(srcFormat, dstDataType, tempBuffer.get(), tempBufferSize, dstFormat, dstBuffer, threadCount);
+    }
+    else if (srcDataType != dstDataType)
+    {
+        /* Convert image data type */
+        ConvertImageBufferDataType(srcDataType, srcBuffer, srcBufferSize, dstDataType, dstBuffer, threadCount);
+    }
+    else if (srcFormat != dstFormat)
+    {
+        /* Convert image format */
+        ConvertImageBufferFormat(srcFormat, srcDataType, srcBuffer, srcBufferSize, dstFormat, dstBuffer, threadCount);
+    }
+    else if (srcBuffer != dstBuffer)
+    {
+        /* Copy image buffer without conversion */
+        std::memcpy(dstBuffer, srcBuffer, srcBufferSize);
     }
-    return 0;
 }
 
-LLGL_EXPORT bool IsCompressedFormat(const ImageFormat format)
+/*
+Returns true if the conversion preserves the size of each pixel, so it can write into the source buffer.
+All conversion kernels read each pixel (or each component for data type conversions) before they write it,
+and the worker threads operate on disjoint pixel ranges, which then map to the same memory range in both buffers.
+*/
+static bool IsInPlaceConversion(ImageFormat srcFormat, DataType srcDataType, ImageFormat dstFormat, DataType dstDataType)
 {
-    return (format >= ImageFormat::CompressedRGB);
+    if (srcFormat != dstFormat && srcDataType != dstDataType)
+        return (ImageFormatSize(srcFormat) * DataTypeSize(srcDataType) == ImageFormatSize(dstFormat) * DataTypeSize(dstDataType));
+    if (srcFormat != dstFormat)
+        return (ImageFormatSize(srcFormat) == ImageFormatSize(dstFormat));
+    return (DataTypeSize(srcDataType) == DataTypeSize(dstDataType));
 }
 
-LLGL_EXPORT bool IsDepthStencilFormat(const ImageFormat format)
+
+/* ----- Color space conversion ----- */
+
+// Returns the index of the alpha component within the specified image format, or -1 if there is no alpha component.
+static int GetAlphaComponentIndex(ImageFormat format)
 {
-    return (format == ImageFormat::Depth || format == ImageFormat::DepthStencil);
+    switch (format)
+    {
+        case ImageFormat::RGBA:
+        case ImageFormat::BGRA:
+            return 3;
+        case ImageFormat::ARGB:
+        case ImageFormat::ABGR:
+            return 0;
+        default:
+            return -1;
+    }
 }
 
-LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+// Converts all color components (i.e. except alpha) of the specified floating-point image between sRGB and linear space.
+static void ConvertImageColorSpace(float* data, std::size_t numPixels, unsigned int numComponents, int alphaIndex, bool toLinear, std::size_t threadCount)
+{
+    RunConversionWorkers(
+        numPixels,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
+        {
+            for (auto i = idxBegin; i < idxEnd; ++i)
+            {
+                for (unsigned int c = 0; c < numComponents; ++c)
+                {
+                    if (static_cast<int>(c) != alphaIndex)
+                    {
+                        auto& value = data[i * numComponents + c];
+                        value = (toLinear ? SRGBToLinear(value) : LinearToSRGB(std::max(0.0f, value)));
+                    }
+                }
+            }
+        }
+    );
+}
+
+/*
+Converts the source image buffer between sRGB and linear space into the destination buffer.
+8-bit sRGB images are decoded and encoded with lookup tables, all other images are converted through a floating-point image.
+*/
+static void ConvertImageBufferColorSpace(
     ImageFormat srcFormat,
     DataType    srcDataType,
     const void* srcBuffer,
     std::size_t srcBufferSize,
     ImageFormat dstFormat,
     DataType    dstDataType,
+    void*       dstBuffer,
+    bool        toLinear,
     std::size_t threadCount)
 {
-    /* Validate input parameters */
-    LLGL_ASSERT_PTR(srcBuffer);
+    const auto numComponents    = ImageFormatSize(srcFormat);
+    const auto numPixels        = srcBufferSize / (numComponents * DataTypeSize(srcDataType));
+    const auto alphaIndex       = GetAlphaComponentIndex(srcFormat);
 
-    if (IsCompressedFormat(srcFormat) || IsCompressedFormat(dstFormat))
-        throw std::invalid_argument("can not convert compressed image formats");
-    if (IsDepthStencilFormat(srcFormat) || IsDepthStencilFormat(dstFormat))
-        throw std::invalid_argument("can not convert depth-stencil image formats");
-    if (srcBufferSize % (DataTypeSize(srcDataType) * ImageFormatSize(srcFormat)) != 0)
-        throw std::invalid_argument("source buffer size is not a multiple of the source data type size");
+    if (!toLinear && dstDataType == DataType::UInt8)
+    {
+        /* Get floating-point linear source image */
+        ByteBuffer floatBuffer;
+        auto linearImage = reinterpret_cast<const float*>(srcBuffer);
 
-    ByteBuffer dstImage;
+        if (srcDataType != DataType::Float)
+        {
+            floatBuffer = AllocByteArray(numPixels * numComponents * sizeof(float));
+            ConvertImageBufferIntoDestination(
+                srcFormat, srcDataType, srcBuffer, srcBufferSize,
+                srcFormat, DataType::Float, floatBuffer.get(),
+                threadCount
+            );
+            linearImage = reinterpret_cast<const float*>(floatBuffer.get());
+        }
 
-    if (threadCount == maxThreadCount)
-        threadCount = std::thread::hardware_concurrency();
-    
-    if (srcDataType != dstDataType)
-    {
-        /* Convert image data type */
-        dstImage = ConvertImageBufferDataType(srcDataType, srcBuffer, srcBufferSize, dstDataType, threadCount);
+        /* Encode into 8-bit sRGB image with lookup table, which is the destination buffer itself if the format is not converted */
+        ByteBuffer byteBuffer;
+        auto sRGBImage = reinterpret_cast<std::uint8_t*>(dstBuffer);
 
-        /* Set new source buffer and source data type */
-        srcBufferSize   = srcBufferSize / DataTypeSize(srcDataType) * DataTypeSize(dstDataType);
-        srcDataType     = dstDataType;
-        srcBuffer       = dstImage.get();
+        if (srcFormat != dstFormat)
+        {
+            byteBuffer  = AllocByteArray(numPixels * numComponents);
+            sRGBImage   = reinterpret_cast<std::uint8_t*>(byteBuffer.get());
+        }
+
+        RunConversionWorkers(
+            numPixels,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                ConvertLinearFloatToSRGBUInt8(linearImage, sRGBImage, numComponents, alphaIndex, idxBegin, idxEnd);
+            }
+        );
+
+        if (byteBuffer)
+        {
+            ConvertImageBufferIntoDestination(
+                srcFormat, DataType::UInt8, sRGBImage, numPixels * numComponents,
+                dstFormat, DataType::UInt8, dstBuffer,
+                threadCount
+            );
+        }
+
+        return;
     }
 
-    if (srcFormat != dstFormat)
+    /* Decode source image into floating-point image, which is the destination buffer itself if possible */
+    ByteBuffer tempBuffer;
+    float* linearImage = nullptr;
+
+    if (srcFormat == dstFormat && dstDataType == DataType::Float)
+        linearImage = reinterpret_cast<float*>(dstBuffer);
+    else
     {
-        /* Convert image format */
-        dstImage = ConvertImageBufferFormat(srcFormat, srcDataType, srcBuffer, srcBufferSize, dstFormat, threadCount);
+        tempBuffer  = AllocByteArray(numPixels * numComponents * sizeof(float));
+        linearImage = reinterpret_cast<float*>(tempBuffer.get());
+    }
+
+    if (toLinear && srcDataType == DataType::UInt8)
+    {
+        auto src = reinterpret_cast<const std::uint8_t*>(srcBuffer);
+
+        RunConversionWorkers(
+            numPixels,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                ConvertSRGBUInt8ToLinearFloat(src, linearImage, numComponents, alphaIndex, idxBegin, idxEnd);
+            }
+        );
+    }
+    else
+    {
+        ConvertImageBufferIntoDestination(
+            srcFormat, srcDataType, srcBuffer, srcBufferSize,
+            srcFormat, DataType::Float, linearImage,
+            threadCount
+        );
+        ConvertImageColorSpace(linearImage, numPixels, numComponents, alphaIndex, toLinear, threadCount);
+    }
+
+    /* Convert floating-point image into destination buffer */
+    if (tempBuffer)
+    {
+        ConvertImageBufferIntoDestination(
+            srcFormat, DataType::Float, linearImage, numPixels * numComponents * sizeof(float),
+            dstFormat, dstDataType, dstBuffer,
+            threadCount
+        );
+    }
+}
+
+/* ----- MIP-map generation ----- */
+
+/*
+All MIP-map levels are filtered in a floating-point image with tightly packed components,
+which is converted from and into the actual image data type with the conversion functions above.
+*/
+struct MipMapImage
+{
+    std::vector<float>  data;
+    unsigned int        width   = 0;
+    unsigned int        height  = 0;
+};
+
+// Number of source texels per dimension the Kaiser filter reads for each destination texel
+static const int g_kaiserFilterTaps = 6;
+
+static double BesselI0(double x)
+{
+    /* Evaluate power series of the modified Bessel function of the first kind and order 0 */
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; ++k)
+    {
+        auto t = x / (2.0 * k);
+        term *= t * t;
+        sum += term;
+    }
+    return sum;
+}
+
+/*
+Returns the normalized weights of the Kaiser-windowed sinc filter to downsample by a factor of 2,
+for the source texels at the offsets [-2, 3] relative to twice the destination texel coordinate.
+*/
+static const float* GetKaiserFilterWeights()
+{
+    static const struct KaiserFilterWeights
+    {
+        KaiserFilterWeights()
+        {
+            const double alpha  = 4.0;
+            const double radius = g_kaiserFilterTaps / 4.0;
+            const double pi     = 3.14159265358979323846;
+
+            double sum = 0.0;
+            double w[g_kaiserFilterTaps];
+
+            for (int i = 0; i < g_kaiserFilterTaps; ++i)
+            {
+                /* Distance of source texel center to destination texel center (in destination texels) */
+                auto x      = (i - g_kaiserFilterTaps / 2 + 0.5) * 0.5;
+                auto sinc   = std::sin(pi * x) / (pi * x);
+                auto r      = x / radius;
+                auto window = BesselI0(alpha * std::sqrt(std::max(0.0, 1.0 - r*r))) / BesselI0(alpha);
+                w[i] = sinc * window;
+                sum += w[i];
+            }
+
+            for (int i = 0; i < g_kaiserFilterTaps; ++i)
+                weights[i] = static_cast<float>(w[i] / sum);
+        }
+
+        float weights[g_kaiserFilterTaps];
+    }
+    filterWeights;
+
+    return filterWeights.weights;
+}
+
+// Converts all color components (i.e. except alpha) of the specified image between sRGB and linear space.
+static void ConvertMipMapColorSpace(MipMapImage& image, unsigned int numComponents, int alphaIndex, bool toLinear, std::size_t threadCount)
+{
+    ConvertImageColorSpace(image.data.data(), image.data.size() / numComponents, numComponents, alphaIndex, toLinear, threadCount);
+}
+
+// Converts the specified image buffer into a floating-point image (sRGB images are converted into linear space).
+static void LoadFloatImage(
+    MipMapImage&    image,
+    ImageFormat     format,
+    DataType        dataType,
+    const void*     buffer,
+    unsigned int    width,
+    unsigned int    height,
+    bool            sRGB,
+    std::size_t     threadCount)
+{
+    const auto numComponents    = ImageFormatSize(format);
+    const auto numTexels        = static_cast<std::size_t>(width) * height;
+    const auto alphaIndex       = GetAlphaComponentIndex(format);
+
+    image.width     = width;
+    image.height    = height;
+    image.data.resize(numTexels * numComponents);
+
+    if (sRGB && dataType == DataType::UInt8)
+    {
+        /* Convert 8-bit sRGB components directly into linear space with a lookup table */
+        auto src = reinterpret_cast<const std::uint8_t*>(buffer);
+        auto dst = image.data.data();
+
+        RunConversionWorkers(
+            numTexels,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                ConvertSRGBUInt8ToLinearFloat(src, dst, numComponents, alphaIndex, idxBegin, idxEnd);
+            }
+        );
+    }
+    else
+    {
+        ConvertImageBufferIntoDestination(
+            format, dataType, buffer, numTexels * numComponents * DataTypeSize(dataType),
+            format, DataType::Float, image.data.data(),
+            threadCount
+        );
+
+        if (sRGB)
+            ConvertMipMapColorSpace(image, numComponents, alphaIndex, true, threadCount);
+    }
+}
+
+/*
+Returns the bias that is added to floating-point values before they are converted into the specified data type.
+The conversion into unsigned normalized integers truncates, which would shift flat colors one step down
+(e.g. 77/255 is stored as 76.99...), so the values are biased by half a step to round to the nearest integer.
+*/
+static float GetStoreRoundingBias(DataType dataType)
+{
+    switch (dataType)
+    {
+        case DataType::UInt8:   return 0.5f / 255.0f;
+        case DataType::UInt16:  return 0.5f / 65535.0f;
+        default:                return 0.0f;
+    }
+}
+
+/*
+Converts the specified floating-point image into the destination buffer, which must be large enough for the specified data type.
+The image is modified in place, i.e. clamped to the normalized range (if 'clamp' is true), converted back into sRGB space (if 'sRGB' is true),
+and biased for rounding (see GetStoreRoundingBias).
+*/
+static void StoreFloatImage(
+    MipMapImage&    image,
+    ImageFormat     format,
+    DataType        dataType,
+    void*           dstBuffer,
+    bool            sRGB,
+    bool            clamp,
+    std::size_t     threadCount)
+{
+    if (clamp)
+    {
+        for (auto& value : image.data)
+            value = std::max(0.0f, std::min(value, 1.0f));
+    }
+
+    if (sRGB)
+        ConvertMipMapColorSpace(image, ImageFormatSize(format), GetAlphaComponentIndex(format), false, threadCount);
+
+    const auto roundingBias = GetStoreRoundingBias(dataType);
+    if (roundingBias > 0.0f)
+    {
+        for (auto& value : image.data)
+            value += roundingBias;
+    }
+
+    ConvertImageBufferIntoDestination(
+        format, DataType::Float, image.data.data(), image.data.size() * sizeof(float),
+        format, dataType, dstBuffer,
+        threadCount
+    );
+}
+
+// Downsamples the source image by averaging each 2x2 block of texels (texels outside the image are clamped to the edge).
+static void DownsampleMipMapBox(const MipMapImage& src, MipMapImage& dst, unsigned int numComponents, std::size_t threadCount)
+{
+    const auto srcData = src.data.data();
+    const auto dstData = dst.data.data();
+
+    RunConversionWorkers(
+        dst.height,
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto y = rowBegin; y < rowEnd; ++y)
+            {
+                auto srcRow0 = srcData + (std::min<std::size_t>(y*2    , src.height - 1) * src.width) * numComponents;
+                auto srcRow1 = srcData + (std::min<std::size_t>(y*2 + 1, src.height - 1) * src.width) * numComponents;
+                auto dstRow  = dstData + (y * dst.width) * numComponents;
+
+                for (std::size_t x = 0; x < dst.width; ++x)
+                {
+                    auto x0 = (x*2) * numComponents;
+                    auto x1 = std::min<std::size_t>(x*2 + 1, src.width - 1) * numComponents;
+
+                    for (unsigned int c = 0; c < numComponents; ++c)
+                        dstRow[x * numComponents + c] = (srcRow0[x0 + c] + srcRow0[x1 + c] + srcRow1[x0 + c] + srcRow1[x1 + c]) * 0.25f;
+                }
+            }
+        }
+    );
+}
+
+// Downsamples the source image with a separable Kaiser-windowed sinc filter (texels outside the image are clamped to the edge).
+static void DownsampleMipMapKaiser(const MipMapImage& src, MipMapImage& dst, unsigned int numComponents, std::size_t threadCount)
+{
+    const auto weights  = GetKaiserFilterWeights();
+    const auto offset   = g_kaiserFilterTaps / 2 - 1;
+
+    /* Filter horizontally into temporary image with destination width and source height */
+    std::vector<float> temp(static_cast<std::size_t>(dst.width) * src.height * numComponents);
+
+    const auto srcData  = src.data.data();
+    const auto tempData = temp.data();
+    const auto dstData  = dst.data.data();
+
+    const auto srcMaxX  = static_cast<int>(src.width) - 1;
+    const auto srcMaxY  = static_cast<int>(src.height) - 1;
+
+    RunConversionWorkers(
+        src.height,
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto y = rowBegin; y < rowEnd; ++y)
+            {
+                auto srcRow     = srcData + (y * src.width) * numComponents;
+                auto tempRow    = tempData + (y * dst.width) * numComponents;
+
+                for (std::size_t x = 0; x < dst.width; ++x)
+                {
+                    for (unsigned int c = 0; c < numComponents; ++c)
+                    {
+                        float value = 0.0f;
+                        for (int i = 0; i < g_kaiserFilterTaps; ++i)
+                        {
+                            auto srcX = std::max(0, std::min(static_cast<int>(x*2) - offset + i, srcMaxX));
+                            value += srcRow[srcX * numComponents + c] * weights[i];
+                        }
+                        tempRow[x * numComponents + c] = value;
+                    }
+                }
+            }
+        }
+    );
+
+    /* Filter vertically into destination image */
+    RunConversionWorkers(
+        dst.height,
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            const auto rowSize = static_cast<std::size_t>(dst.width) * numComponents;
+
+            for (auto y = rowBegin; y < rowEnd; ++y)
+            {
+                auto dstRow = dstData + y * rowSize;
+                std::fill(dstRow, dstRow + rowSize, 0.0f);
+
+                for (int i = 0; i < g_kaiserFilterTaps; ++i)
+                {
+                    auto srcY       = std::max(0, std::min(static_cast<int>(y*2) - offset + i, srcMaxY));
+                    auto tempRow    = tempData + srcY * rowSize;
+                    for (std::size_t j = 0; j < rowSize; ++j)
+                        dstRow[j] += tempRow[j] * weights[i];
+                }
+            }
+        }
+    );
+}
+
+
+/* ----- Image resampling ----- */
+
+// Filter weights of a separable resampling filter for each destination coordinate along one dimension.
+struct ResampleFilterTable
+{
+    int                 numTaps = 0;
+    std::vector<int>    indices;    // Clamped source coordinates, 'numTaps' entries per destination coordinate
+    std::vector<float>  weights;    // Normalized weights, 'numTaps' entries per destination coordinate
+};
+
+static double EvalResampleFilter(const ResampleFilter filter, double x)
+{
+    const double pi = 3.14159265358979323846;
+
+    x = std::abs(x);
+    switch (filter)
+    {
+        case ResampleFilter::Box:
+            return (x < 0.5 ? 1.0 : 0.0);
+        case ResampleFilter::Bilinear:
+            return std::max(0.0, 1.0 - x);
+        case ResampleFilter::Lanczos:
+            if (x < 1.0e-6)
+                return 1.0;
+            if (x < 3.0)
+                return (3.0 * std::sin(pi * x) * std::sin(pi * x / 3.0)) / (pi * pi * x * x);
+            return 0.0;
+    }
+    return 0.0;
+}
+
+static double GetResampleFilterRadius(const ResampleFilter filter)
+{
+    switch (filter)
+    {
+        case ResampleFilter::Box:       return 0.5;
+        case ResampleFilter::Bilinear:  return 1.0;
+        case ResampleFilter::Lanczos:   return 3.0;
+    }
+    return 0.5;
+}
+
+/*
+Builds the filter table to resample 'srcSize' texels into 'dstSize' texels. When downsampling, the filter footprint is widened by the scaling factor.
+All destination coordinates have the same number of taps, so the unused taps are padded with zero weights.
+*/
+static void BuildResampleFilterTable(ResampleFilterTable& table, const ResampleFilter filter, unsigned int srcSize, unsigned int dstSize)
+{
+    const auto scale        = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+    const auto filterScale  = std::max(1.0, scale);
+    const auto radius       = GetResampleFilterRadius(filter) * filterScale;
+    const auto srcMax       = static_cast<int>(srcSize) - 1;
+
+    table.numTaps = static_cast<int>(std::ceil(radius * 2.0)) + 1;
+    table.indices.resize(static_cast<std::size_t>(dstSize) * table.numTaps);
+    table.weights.resize(static_cast<std::size_t>(dstSize) * table.numTaps);
+
+    for (unsigned int i = 0; i < dstSize; ++i)
+    {
+        /* Center of destination texel in source texel coordinates */
+        const auto center   = (i + 0.5) * scale;
+        const auto first    = static_cast<int>(std::floor(center - radius));
+
+        auto indices = &table.indices[i * table.numTaps];
+        auto weights = &table.weights[i * table.numTaps];
+
+        double sum = 0.0;
+        for (int j = 0; j < table.numTaps; ++j)
+        {
+            auto w = EvalResampleFilter(filter, (first + j + 0.5 - center) / filterScale);
+            indices[j] = std::max(0, std::min(first + j, srcMax));
+            weights[j] = static_cast<float>(w);
+            sum += w;
+        }
+
+        if (sum != 0.0)
+        {
+            for (int j = 0; j < table.numTaps; ++j)
+                weights[j] = static_cast<float>(weights[j] / sum);
+        }
+        else
+        {
+            /* Fall back to the nearest source texel if no tap has been hit */
+            std::fill(weights, weights + table.numTaps, 0.0f);
+            indices[0] = std::max(0, std::min(static_cast<int>(center), srcMax));
+            weights[0] = 1.0f;
+        }
+    }
+}
+
+// Accumulates the weighted source row into the destination row, i.e. dst[i] += src[i] * weight.
+static void AccumulateWeightedRow(float* dst, const float* src, float weight, std::size_t rowSize)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_IMAGE_SSE2
+
+    const auto w = _mm_set1_ps(weight);
+
+    for (; i + 8 <= rowSize; i += 8)
+    {
+        _mm_storeu_ps(dst + i    , _mm_add_ps(_mm_loadu_ps(dst + i    ), _mm_mul_ps(_mm_loadu_ps(src + i    ), w)));
+        _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(_mm_loadu_ps(src + i + 4), w)));
+    }
+
+    #elif defined LLGL_IMAGE_NEON
+
+    for (; i + 8 <= rowSize; i += 8)
+    {
+        vst1q_f32(dst + i    , vmlaq_n_f32(vld1q_f32(dst + i    ), vld1q_f32(src + i    ), weight));
+        vst1q_f32(dst + i + 4, vmlaq_n_f32(vld1q_f32(dst + i + 4), vld1q_f32(src + i + 4), weight));
+    }
+
+    #endif
+
+    for (; i < rowSize; ++i)
+        dst[i] += src[i] * weight;
+}
+
+// Resamples the source image with a separable filter: horizontally into a temporary image, then vertically into the destination image.
+static void ResampleFloatImage(const MipMapImage& src, MipMapImage& dst, unsigned int numComponents, const ResampleFilter filter, std::size_t threadCount)
+{
+    ResampleFilterTable tableX, tableY;
+    BuildResampleFilterTable(tableX, filter, src.width, dst.width);
+    BuildResampleFilterTable(tableY, filter, src.height, dst.height);
+
+    /* Filter horizontally into temporary image with destination width and source height */
+    std::vector<float> temp(static_cast<std::size_t>(dst.width) * src.height * numComponents);
+
+    const auto srcData  = src.data.data();
+    const auto tempData = temp.data();
+    const auto dstData  = dst.data.data();
+
+    RunConversionWorkers(
+        src.height,
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto y = rowBegin; y < rowEnd; ++y)
+            {
+                auto srcRow     = srcData + (y * src.width) * numComponents;
+                auto tempRow    = tempData + (y * dst.width) * numComponents;
+
+                for (std::size_t x = 0; x < dst.width; ++x)
+                {
+                    auto indices = &tableX.indices[x * tableX.numTaps];
+                    auto weights = &tableX.weights[x * tableX.numTaps];
+
+                    for (unsigned int c = 0; c < numComponents; ++c)
+                    {
+                        float value = 0.0f;
+                        for (int i = 0; i < tableX.numTaps; ++i)
+                            value += srcRow[indices[i] * numComponents + c] * weights[i];
+                        tempRow[x * numComponents + c] = value;
+                    }
+                }
+            }
+        }
+    );
+
+    /* Filter vertically into destination image; whole rows are accumulated, which maps directly onto SIMD registers */
+    RunConversionWorkers(
+        dst.height,
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            const auto rowSize = static_cast<std::size_t>(dst.width) * numComponents;
+
+            for (auto y = rowBegin; y < rowEnd; ++y)
+            {
+                auto indices    = &tableY.indices[y * tableY.numTaps];
+                auto weights    = &tableY.weights[y * tableY.numTaps];
+                auto dstRow     = dstData + y * rowSize;
+
+                std::fill(dstRow, dstRow + rowSize, 0.0f);
+
+                for (int i = 0; i < tableY.numTaps; ++i)
+                {
+                    if (weights[i] != 0.0f)
+                        AccumulateWeightedRow(dstRow, tempData + indices[i] * rowSize, weights[i], rowSize);
+                }
+            }
+        }
+    );
+}
+
+
+/* ----- Public structures ----- */
+
+unsigned int ImageDescriptor::GetElementSize() const
+{
+    return ImageFormatSize(format) * DataTypeSize(dataType);
+}
+
+
+/* ----- Public functions ----- */
+
+LLGL_EXPORT ByteBuffer AllocByteBuffer(std::size_t size, const char* tag)
+{
+    if (size == 0)
+        return nullptr;
+
+    /* Align byte buffers for any fundamental type, since they are casted to the respective data type (e.g. float) */
+    auto allocator = GetAllocator();
+    const auto alignment = alignof(std::max_align_t);
+    return ByteBuffer(
+        static_cast<char*>(allocator->Allocate(size, alignment, tag)),
+        AllocatorDeleter(allocator, size, alignment, tag)
+    );
+}
+
+LLGL_EXPORT unsigned int ImageFormatSize(const ImageFormat imageFormat)
+{
+    switch (imageFormat)
+    {
+        case ImageFormat::R:                return 1;
+        case ImageFormat::RG:               return 2;
+        case ImageFormat::RGB:              return 3;
+        case ImageFormat::BGR:              return 3;
+        case ImageFormat::RGBA:             return 4;
+        case ImageFormat::BGRA:             return 4;
+        case ImageFormat::ARGB:             return 4;
+        case ImageFormat::ABGR:             return 4;
+        case ImageFormat::Depth:            return 1;
+        case ImageFormat::DepthStencil:     return 2;
+        case ImageFormat::CompressedRGB:    return 0;
+        case ImageFormat::CompressedRGBA:   return 0;
+    }
+    return 0;
+}
+
+LLGL_EXPORT bool IsCompressedFormat(const ImageFormat format)
+{
+    return (format >= ImageFormat::CompressedRGB);
+}
+
+LLGL_EXPORT bool IsDepthStencilFormat(const ImageFormat format)
+{
+    return (format == ImageFormat::Depth || format == ImageFormat::DepthStencil);
+}
+
+LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    const void* srcBuffer,
+    std::size_t srcBufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    std::size_t threadCount)
+{
+    /* Validate input parameters */
+    ValidateImageConversion(srcFormat, srcDataType, srcBuffer, srcBufferSize, dstFormat);
+
+    if (srcDataType == dstDataType && srcFormat == dstFormat)
+        return nullptr;
+
+    /* Allocate destination buffer and convert image */
+    auto dstBuffer = AllocByteArray(GetConvertedImageBufferSize(srcFormat, srcDataType, srcBufferSize, dstFormat, dstDataType));
+
+    ConvertImageBufferIntoDestination(
+        srcFormat, srcDataType, srcBuffer, srcBufferSize,
+        dstFormat, dstDataType, dstBuffer.get(),
+        GetConversionThreadCount(threadCount)
+    );
+
+    return dstBuffer;
+}
+
+LLGL_EXPORT void ConvertImageBuffer(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    const void* srcBuffer,
+    std::size_t srcBufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    void*       dstBuffer,
+    std::size_t dstBufferSize,
+    std::size_t threadCount)
+{
+    /* Validate input parameters */
+    ValidateImageConversion(srcFormat, srcDataType, srcBuffer, srcBufferSize, dstFormat);
+    LLGL_ASSERT_PTR(dstBuffer);
+
+    if (dstBufferSize < GetConvertedImageBufferSize(srcFormat, srcDataType, srcBufferSize, dstFormat, dstDataType))
+        throw std::invalid_argument("destination buffer size is too small for image conversion");
+    if (srcBuffer == dstBuffer && !IsInPlaceConversion(srcFormat, srcDataType, dstFormat, dstDataType))
+        throw std::invalid_argument("can not convert image in place if the conversion changes the pixel size");
+
+    /* Convert image directly into destination buffer (this is a no-op if it converts in place without any conversion) */
+    ConvertImageBufferIntoDestination(
+        srcFormat, srcDataType, srcBuffer, srcBufferSize,
+        dstFormat, dstDataType, dstBuffer,
+        GetConversionThreadCount(threadCount)
+    );
+}
+
+LLGL_EXPORT void ConvertImageBufferInPlace(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    void*       buffer,
+    std::size_t bufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    std::size_t threadCount)
+{
+    /* Validate input parameters */
+    ValidateImageConversion(srcFormat, srcDataType, buffer, bufferSize, dstFormat);
+
+    if (!IsInPlaceConversion(srcFormat, srcDataType, dstFormat, dstDataType))
+        throw std::invalid_argument("can not convert image in place if the conversion changes the pixel size");
+
+    if (srcDataType == dstDataType && srcFormat == dstFormat)
+        return;
+
+    /* Convert image into its own buffer */
+    ConvertImageBufferIntoDestination(
+        srcFormat, srcDataType, buffer, bufferSize,
+        dstFormat, dstDataType, buffer,
+        GetConversionThreadCount(threadCount)
+    );
+}
+
+LLGL_EXPORT void ConvertImageBuffer(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    const void* srcBuffer,
+    std::size_t srcRowPitch,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    void*       dstBuffer,
+    std::size_t dstRowPitch,
+    std::size_t rowLength,
+    std::size_t numRows,
+    std::size_t threadCount)
+{
+    /* Validate input parameters */
+    auto srcRowSize = rowLength * ImageFormatSize(srcFormat) * DataTypeSize(srcDataType);
+    auto dstRowSize = rowLength * ImageFormatSize(dstFormat) * DataTypeSize(dstDataType);
+
+    ValidateImageConversion(srcFormat, srcDataType, srcBuffer, srcRowSize, dstFormat);
+    LLGL_ASSERT_PTR(dstBuffer);
+
+    if (srcRowPitch < srcRowSize || dstRowPitch < dstRowSize)
+        throw std::invalid_argument("row pitch is too small for image conversion");
+
+    if (rowLength == 0 || numRows == 0)
+        return;
+
+    threadCount = GetConversionThreadCount(threadCount);
+
+    if (srcRowPitch == srcRowSize && dstRowPitch == dstRowSize)
+    {
+        /* Convert all rows at once, since they are tightly packed */
+        ConvertImageBufferIntoDestination(
+            srcFormat, srcDataType, srcBuffer, srcRowSize * numRows,
+            dstFormat, dstDataType, dstBuffer,
+            threadCount
+        );
+    }
+    else
+    {
+        /* Convert each row separately, and distribute the rows over the worker threads */
+        auto src = reinterpret_cast<const char*>(srcBuffer);
+        auto dst = reinterpret_cast<char*>(dstBuffer);
+
+        RunConversionWorkers(
+            numRows * rowLength,
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                /* Convert rows that begin within the range [idxBegin, idxEnd) */
+                for (auto row = (idxBegin + rowLength - 1) / rowLength; row * rowLength < idxEnd; ++row)
+                {
+                    ConvertImageBufferIntoDestination(
+                        srcFormat, srcDataType, src + row * srcRowPitch, srcRowSize,
+                        dstFormat, dstDataType, dst + row * dstRowPitch,
+                        1
+                    );
+                }
+            }
+        );
     }
+}
+
+LLGL_EXPORT void ConvertImageBuffer(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    ColorSpace  srcColorSpace,
+    const void* srcBuffer,
+    std::size_t srcBufferSize,
+    ImageFormat dstFormat,
+    DataType    dstDataType,
+    ColorSpace  dstColorSpace,
+    void*       dstBuffer,
+    std::size_t dstBufferSize,
+    std::size_t threadCount)
+{
+    if (srcColorSpace == dstColorSpace)
+    {
+        ConvertImageBuffer(srcFormat, srcDataType, srcBuffer, srcBufferSize, dstFormat, dstDataType, dstBuffer, dstBufferSize, threadCount);
+        return;
+    }
+
+    /* Validate input parameters */
+    ValidateImageConversion(srcFormat, srcDataType, srcBuffer, srcBufferSize, dstFormat);
+    LLGL_ASSERT_PTR(dstBuffer);
+
+    if (dstBufferSize < GetConvertedImageBufferSize(srcFormat, srcDataType, srcBufferSize, dstFormat, dstDataType))
+        throw std::invalid_argument("destination buffer size is too small for image conversion");
 
-    return dstImage;
+    /* Convert image between color spaces directly into destination buffer */
+    ConvertImageBufferColorSpace(
+        srcFormat, srcDataType, srcBuffer, srcBufferSize,
+        dstFormat, dstDataType, dstBuffer,
+        (srcColorSpace == ColorSpace::SRGB),
+        GetConversionThreadCount(threadCount)
+    );
 }
 
+LLGL_EXPORT void ResampleImage(
+    ImageFormat             format,
+    DataType                dataType,
+    const void*             srcBuffer,
+    unsigned int            srcWidth,
+    unsigned int            srcHeight,
+    void*                   dstBuffer,
+    std::size_t             dstBufferSize,
+    unsigned int            dstWidth,
+    unsigned int            dstHeight,
+    const ResampleFilter    filter,
+    bool                    sRGB,
+    std::size_t             threadCount)
+{
+    /* Validate input parameters */
+    const auto numComponents    = ImageFormatSize(format);
+    const auto texelSize        = numComponents * DataTypeSize(dataType);
+
+    if (srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0)
+        throw std::invalid_argument("can not resample image with zero size");
+
+    ValidateImageConversion(format, dataType, srcBuffer, static_cast<std::size_t>(srcWidth) * srcHeight * texelSize, format);
+
+    if (!dstBuffer)
+        throw std::invalid_argument("can not resample image with null pointer as destination buffer");
+    if (dstBufferSize < static_cast<std::size_t>(dstWidth) * dstHeight * texelSize)
+        throw std::invalid_argument("destination buffer size is too small for resampled image");
+
+    threadCount = GetConversionThreadCount(threadCount);
+
+    /* Resample image in floating-point format and linear color space */
+    MipMapImage src, dst;
+    LoadFloatImage(src, format, dataType, srcBuffer, srcWidth, srcHeight, sRGB, threadCount);
+
+    dst.width   = dstWidth;
+    dst.height  = dstHeight;
+    dst.data.resize(static_cast<std::size_t>(dstWidth) * dstHeight * numComponents);
+
+    ResampleFloatImage(src, dst, numComponents, filter, threadCount);
+
+    /* Convert resampled image back into the source data type and color space; only Lanczos can overshoot the normalized range */
+    const bool clampOutput = (filter == ResampleFilter::Lanczos && dataType != DataType::Float && dataType != DataType::Double);
+    StoreFloatImage(dst, format, dataType, dstBuffer, sRGB, clampOutput, threadCount);
+}
+
+LLGL_EXPORT ByteBuffer ResampleImage(
+    ImageFormat             format,
+    DataType                dataType,
+    const void*             srcBuffer,
+    unsigned int            srcWidth,
+    unsigned int            srcHeight,
+    unsigned int            dstWidth,
+    unsigned int            dstHeight,
+    const ResampleFilter    filter,
+    bool                    sRGB,
+    std::size_t             threadCount)
+{
+    const auto dstBufferSize = static_cast<std::size_t>(dstWidth) * dstHeight * ImageFormatSize(format) * DataTypeSize(dataType);
+
+    auto dstBuffer = AllocByteArray(dstBufferSize);
+
+    ResampleImage(
+        format, dataType, srcBuffer, srcWidth, srcHeight,
+        dstBuffer.get(), dstBufferSize, dstWidth, dstHeight,
+        filter, sRGB, threadCount
+    );
+
+    return dstBuffer;
+}
+
+LLGL_EXPORT std::vector<ByteBuffer> GenerateMipMaps(
+    ImageFormat         format,
+    DataType            dataType,
+    const void*         buffer,
+    unsigned int        width,
+    unsigned int        height,
+    const MipMapFilter  filter,
+    bool                sRGB,
+    std::size_t         threadCount)
+{
+    /* Validate input parameters */
+    const auto numComponents    = ImageFormatSize(format);
+    const auto numTexels        = static_cast<std::size_t>(width) * height;
+
+    if (width == 0 || height == 0)
+        throw std::invalid_argument("can not generate MIP-maps for image with zero size");
+
+    ValidateImageConversion(format, dataType, buffer, numTexels * numComponents * DataTypeSize(dataType), format);
+
+    threadCount = GetConversionThreadCount(threadCount);
+
+    /* Convert base level into floating-point image */
+    MipMapImage current;
+    LoadFloatImage(current, format, dataType, buffer, width, height, sRGB, threadCount);
+
+    /* Generate all MIP-map levels after the base level */
+    const auto numMipLevels = NumMipLevels(width, height);
+
+    std::vector<ByteBuffer> mipLevels;
+    mipLevels.reserve(numMipLevels - 1);
+
+    MipMapImage next, output;
+
+    for (unsigned int mipLevel = 1; mipLevel < numMipLevels; ++mipLevel)
+    {
+        /* Downsample previous MIP-map level */
+        next.width  = std::max(1u, current.width  / 2);
+        next.height = std::max(1u, current.height / 2);
+        next.data.resize(static_cast<std::size_t>(next.width) * next.height * numComponents);
+
+        if (filter == MipMapFilter::Kaiser)
+            DownsampleMipMapKaiser(current, next, numComponents, threadCount);
+        else
+            DownsampleMipMapBox(current, next, numComponents, threadCount);
+
+        /* Convert MIP-map level into the data type and color space of the base level (the next level is filtered from the unmodified image) */
+        const bool clampOutput = (filter == MipMapFilter::Kaiser && dataType != DataType::Float && dataType != DataType::Double);
+
+        auto dstBuffer = AllocByteArray(next.data.size() * DataTypeSize(dataType));
+
+        if (sRGB || clampOutput || GetStoreRoundingBias(dataType) > 0.0f)
+        {
+            output = next;
+            StoreFloatImage(output, format, dataType, dstBuffer.get(), sRGB, clampOutput, threadCount);
+        }
+        else
+            StoreFloatImage(next, format, dataType, dstBuffer.get(), false, false, threadCount);
+
+        mipLevels.push_back(std::move(dstBuffer));
+
+        std::swap(current, next);
+    }
+
+    return mipLevels;
+}
 
 } // /namespace LLGL
 
@@ -64,6 +64,7 @@ void Input::OnProcessEvents(Window& sender)
 {
     wheelMotion_ = 0;
     mouseMotion_ = { 0, 0 };
+    mouseMotionSamples_.clear();
 
     keyDownTracker_.Reset(keyDown_);
     keyUpTracker_.Reset(keyUp_);
@@ -147,6 +148,13 @@ void Input::OnLocalMotion(Window& sender, const Point& position)
 void Input::OnGlobalMotion(Window& sender, const Point& motion)
 {
     mouseMotion_ += motion;
+
+    MouseMotionSample sample;
+    {
+        sample.motion       = motion;
+        sample.timestamp    = sender.GetEventTimestamp();
+    }
+    mouseMotionSamples_.push_back(sample);
 }
 
 void Input::KeyTracker::Add(Key keyCode)
@@ -7,6 +7,12 @@
 
 #include <LLGL/Log.h>
 #include <iostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <chrono>
 
 
 namespace LLGL
@@ -16,39 +22,390 @@ namespace Log
 {
 
 
-struct LogState
+/*
+Intrusive multi-producer single-consumer queue (after Dmitry Vyukov).
+Producers only exchange the head pointer, so posting a message never blocks;
+the consumer (i.e. the logger thread) is the only one that advances the tail.
+*/
+class MessageQueue
+{
+
+    public:
+
+        struct Node
+        {
+            std::atomic<Node*>  next        { nullptr };
+            Severity            severity    = Severity::Info;
+            std::string         text;
+        };
+
+        MessageQueue() :
+            head_ { &stub_ },
+            tail_ { &stub_ }
+        {
+        }
+
+        ~MessageQueue()
+        {
+            Node* node = nullptr;
+            while ((node = Pop()) != nullptr)
+                delete node;
+        }
+
+        void Push(Node* node)
+        {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            auto prev = head_.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // Returns the next node, which is owned by the caller, or null if the queue is empty (or a push is in progress).
+        Node* Pop()
+        {
+            auto tail = tail_;
+            auto next = tail->next.load(std::memory_order_acquire);
+
+            /* Skip stub node */
+            if (tail == &stub_)
+            {
+                if (next == nullptr)
+                    return nullptr;
+                tail_ = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next != nullptr)
+            {
+                tail_ = next;
+                return tail;
+            }
+
+            /* Tail is the last node, so re-insert stub node before it can be returned */
+            if (tail != head_.load(std::memory_order_acquire))
+                return nullptr;
+
+            Push(&stub_);
+
+            next = tail->next.load(std::memory_order_acquire);
+            if (next != nullptr)
+            {
+                tail_ = next;
+                return tail;
+            }
+
+            return nullptr;
+        }
+
+    private:
+
+        std::atomic<Node*>  head_;
+        Node*               tail_;
+        Node                stub_;
+
+};
+
+class AsyncLogger
 {
-    LogState() :
-        stdOut { &(std::cout) },
-        stdErr { &(std::cerr) }
-    {
-    }
 
-    std::ostream* stdOut = nullptr;
-    std::ostream* stdErr = nullptr;
+    public:
+
+        AsyncLogger() :
+            stdOut_ { &(std::cout) },
+            stdErr_ { &(std::cerr) }
+        {
+        }
+
+        void Post(const Severity severity, const std::string& message)
+        {
+            auto node = new MessageQueue::Node();
+            {
+                node->severity  = severity;
+                node->text      = message;
+            }
+            queue_.Push(node);
+            numPosted_.fetch_add(1);
+
+            /* Start logger thread with the first message (or the first message after a shutdown) */
+            if (!running_.load())
+                StartThread();
+
+            wakeup_.notify_one();
+        }
+
+        void Flush()
+        {
+            const auto numPosted = numPosted_.load();
+
+            if (numPosted > 0)
+            {
+                /* Start logger thread if a concurrent post has not started it yet, so its message is not skipped */
+                if (!running_.load())
+                    StartThread();
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeup_.notify_one();
+                flushed_.wait(lock, [this, numPosted]() { return (numWritten_ >= numPosted || !running_.load()); });
+            }
+
+            std::lock_guard<std::mutex> guard(streamMutex_);
+            stdOut_->flush();
+            stdErr_->flush();
+        }
+
+        void SetStream(std::ostream*& dst, std::ostream& stream)
+        {
+            Flush();
+            std::lock_guard<std::mutex> guard(streamMutex_);
+            dst = &stream;
+        }
+
+        void SetRateLimit(std::size_t maxRepeats, std::uint32_t intervalMs)
+        {
+            std::lock_guard<std::mutex> guard(streamMutex_);
+            maxRepeats_ = maxRepeats;
+            interval_   = std::chrono::milliseconds(intervalMs);
+        }
+
+        void Shutdown()
+        {
+            std::lock_guard<std::mutex> threadLock(threadMutex_);
+
+            if (!running_.load())
+                return;
+
+            /* Let the logger thread write all queued messages before it exits */
+            quit_.store(true);
+            wakeup_.notify_one();
+            thread_.join();
+            running_.store(false);
+
+            /*
+            Write messages that were posted while the thread was exiting; posts that observe the stopped
+            thread are pushed after this point and start a new thread (see Post)
+            */
+            auto numWritten = WriteMessages();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                numWritten_ += numWritten;
+            }
+            flushed_.notify_all();
+
+            std::lock_guard<std::mutex> guard(streamMutex_);
+            ReportSuppressedMessages();
+            stdOut_->flush();
+            stdErr_->flush();
+        }
+
+    public:
+
+        std::ostream*           stdOut_         = nullptr;
+        std::ostream*           stdErr_         = nullptr;
+        std::atomic<int>        minSeverity_    { static_cast<int>(Severity::Info) };
+
+    private:
+
+        using Clock = std::chrono::steady_clock;
+
+        struct RepeatCounter
+        {
+            std::size_t numWritten      = 0;
+            std::size_t numSuppressed   = 0;
+            Severity    severity        = Severity::Info;
+        };
+
+        void StartThread()
+        {
+            std::lock_guard<std::mutex> threadLock(threadMutex_);
+
+            /* The running state is set before the thread is launched, so no concurrent Flush can miss the thread */
+            if (!running_.load())
+            {
+                quit_.store(false);
+                running_.store(true);
+                thread_ = std::thread(&AsyncLogger::Run, this);
+            }
+        }
+
+        void Run()
+        {
+            while (true)
+            {
+                /* Wait for new messages; the timeout bounds the latency of a missed notification, since posting takes no lock */
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    wakeup_.wait_for(
+                        lock,
+                        std::chrono::milliseconds(10),
+                        [this]() { return (numWritten_ < numPosted_.load() || quit_.load()); }
+                    );
+                }
+
+                auto numWritten = WriteMessages();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    numWritten_ += numWritten;
+                }
+                flushed_.notify_all();
+
+                if (quit_.load() && numWritten_ >= numPosted_.load())
+                    break;
+            }
+
+            /* Report remaining suppressed repetitions */
+            std::lock_guard<std::mutex> guard(streamMutex_);
+            ReportSuppressedMessages();
+            stdOut_->flush();
+            stdErr_->flush();
+        }
+
+        // Writes all queued messages and returns the number of messages taken from the queue.
+        std::uint64_t WriteMessages()
+        {
+            std::lock_guard<std::mutex> guard(streamMutex_);
+
+            /* Start new rate limit interval */
+            auto now = Clock::now();
+            if (now - intervalStart_ >= interval_)
+            {
+                ReportSuppressedMessages();
+                intervalStart_ = now;
+            }
+
+            std::uint64_t numMessages = 0;
+
+            while (auto node = queue_.Pop())
+            {
+                if (maxRepeats_ > 0)
+                {
+                    auto& counter = repeatCounters_[node->text];
+                    counter.severity = node->severity;
+                    if (counter.numWritten < maxRepeats_)
+                    {
+                        ++counter.numWritten;
+                        WriteLine(node->severity, node->text);
+                    }
+                    else
+                        ++counter.numSuppressed;
+                }
+                else
+                    WriteLine(node->severity, node->text);
+
+                delete node;
+                ++numMessages;
+            }
+
+            if (numMessages > 0)
+            {
+                stdOut_->flush();
+                stdErr_->flush();
+            }
+
+            return numMessages;
+        }
+
+        void WriteLine(const Severity severity, const std::string& text)
+        {
+            auto& stream = (severity == Severity::Info ? *stdOut_ : *stdErr_);
+            stream << text << '\n';
+        }
+
+        void ReportSuppressedMessages()
+        {
+            for (const auto& entry : repeatCounters_)
+            {
+                if (entry.second.numSuppressed > 0)
+                {
+                    WriteLine(
+                        entry.second.severity,
+                        entry.first + " [repeated " + std::to_string(entry.second.numSuppressed) + " more times]"
+                    );
+                }
+            }
+            repeatCounters_.clear();
+        }
+
+        MessageQueue                                    queue_;
+        std::atomic<std::uint64_t>                      numPosted_      { 0 };
+        std::uint64_t                                   numWritten_     = 0;
+        std::atomic<bool>                               quit_           { false };
+
+        std::mutex                                      threadMutex_;   // Guards the start and shutdown of the logger thread.
+        std::atomic<bool>                               running_        { false };
+        std::thread                                     thread_;
+        std::mutex                                      mutex_;
+        std::condition_variable                         wakeup_;
+        std::condition_variable                         flushed_;
+
+        std::mutex                                      streamMutex_;
+        std::size_t                                     maxRepeats_     = 8;
+        Clock::duration                                 interval_       = std::chrono::milliseconds(1000);
+        Clock::time_point                               intervalStart_  = Clock::now();
+        std::unordered_map<std::string, RepeatCounter>  repeatCounters_;
+
 };
 
-static LogState g_logState;
+/*
+The logger is never destroyed, so its thread is never joined during static destruction
+(which can deadlock when the library is unloaded); the thread is stopped with Shutdown instead.
+*/
+static AsyncLogger& GetLogger()
+{
+    static AsyncLogger* logger = new AsyncLogger();
+    return *logger;
+}
 
 
 LLGL_EXPORT void SetStdOut(std::ostream& stream)
 {
-    g_logState.stdOut = &stream;
+    GetLogger().SetStream(GetLogger().stdOut_, stream);
 }
 
 LLGL_EXPORT void SetStdErr(std::ostream& stream)
 {
-    g_logState.stdErr = &stream;
+    GetLogger().SetStream(GetLogger().stdErr_, stream);
 }
 
 LLGL_EXPORT std::ostream& StdOut()
 {
-    return *(g_logState.stdOut);
+    return *(GetLogger().stdOut_);
 }
 
 LLGL_EXPORT std::ostream& StdErr()
 {
-    return *(g_logState.stdErr);
+    return *(GetLogger().stdErr_);
+}
+
+LLGL_EXPORT void SetMinSeverity(const Severity severity)
+{
+    GetLogger().minSeverity_.store(static_cast<int>(severity), std::memory_order_relaxed);
+}
+
+LLGL_EXPORT bool IsEnabled(const Severity severity)
+{
+    return (static_cast<int>(severity) >= GetLogger().minSeverity_.load(std::memory_order_relaxed));
+}
+
+LLGL_EXPORT void Post(const Severity severity, const std::string& message)
+{
+    if (IsEnabled(severity))
+        GetLogger().Post(severity, message);
+}
+
+LLGL_EXPORT void Flush()
+{
+    GetLogger().Flush();
+}
+
+LLGL_EXPORT void SetRateLimit(std::size_t maxRepeats, std::uint32_t intervalMs)
+{
+    GetLogger().SetRateLimit(maxRepeats, intervalMs);
+}
+
+LLGL_EXPORT void Shutdown()
+{
+    GetLogger().Shutdown();
 }
 
 
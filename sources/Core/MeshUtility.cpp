@@ -0,0 +1,643 @@
+/*
+ * MeshUtility.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_ENABLE_UTILITY
+
+#include <LLGL/MeshUtility.h>
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+// Minimal number of elements each worker thread shall process
+static const std::size_t g_threadMinWorkSize = 4096;
+
+// Vertex-triangle adjacency in compressed form: the triangles of vertex 'v' are triangles[offsets[v] .. offsets[v + 1]).
+struct VertexAdjacency
+{
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> triangles;
+};
+
+static void BuildVertexAdjacency(VertexAdjacency& adjacency, const std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices)
+{
+    auto& offsets   = adjacency.offsets;
+    auto& triangles = adjacency.triangles;
+
+    /* Count triangles per vertex */
+    offsets.assign(numVertices + 1, 0);
+    for (std::size_t i = 0; i < numIndices; ++i)
+        ++offsets[indices[i] + 1];
+
+    /* Accumulate counts to offsets */
+    for (std::size_t v = 0; v < numVertices; ++v)
+        offsets[v + 1] += offsets[v];
+
+    /* Fill triangle lists */
+    triangles.resize(numIndices);
+    std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+
+    for (std::size_t i = 0; i < numIndices; ++i)
+        triangles[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+}
+
+// Simulates a FIFO vertex cache of the specified size for the specified triangles and returns the number of cache misses.
+static std::size_t CountCacheMisses(
+    const std::uint32_t*        indices,
+    std::size_t                 firstTriangle,
+    std::size_t                 numTriangles,
+    std::vector<std::size_t>&   timestamps,
+    std::size_t&                time,
+    std::size_t                 cacheSize)
+{
+    std::size_t misses = 0;
+
+    for (std::size_t i = firstTriangle * 3, n = (firstTriangle + numTriangles) * 3; i < n; ++i)
+    {
+        auto v = indices[i];
+        if (time - timestamps[v] > cacheSize)
+        {
+            /* Vertex is not in the cache -> push it into the FIFO */
+            timestamps[v] = time++;
+            ++misses;
+        }
+    }
+
+    return misses;
+}
+
+
+/* ----- Mesh optimization utility functions ----- */
+
+LLGL_EXPORT void OptimizeVertexCache(std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices, std::size_t cacheSize)
+{
+    const auto numTriangles = numIndices / 3;
+    if (numTriangles == 0 || numVertices == 0)
+        return;
+
+    /* Ignore trailing indices of an incomplete triangle, so each adjacent triangle ID is in the range [0, numTriangles) */
+    numIndices = numTriangles * 3;
+
+    VertexAdjacency adjacency;
+    BuildVertexAdjacency(adjacency, indices, numIndices, numVertices);
+
+    /* Initialize number of live triangles per vertex and cache timestamps */
+    std::vector<std::uint32_t> liveTriangles(numVertices);
+    for (std::size_t v = 0; v < numVertices; ++v)
+        liveTriangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+
+    std::vector<std::size_t>    timestamps(numVertices, 0);
+    std::vector<bool>           emitted(numTriangles, false);
+    std::vector<std::uint32_t>  deadEnds;
+    std::vector<std::uint32_t>  candidates;
+    std::vector<std::uint32_t>  output;
+
+    deadEnds.reserve(numIndices);
+    candidates.reserve(64);
+    output.reserve(numIndices);
+
+    std::size_t time        = cacheSize + 1;
+    std::size_t cursor      = 0;
+    std::int64_t fanning    = 0;
+
+    while (fanning >= 0)
+    {
+        candidates.clear();
+
+        /* Emit all live triangles of the current fanning vertex */
+        auto f = static_cast<std::size_t>(fanning);
+        for (auto j = adjacency.offsets[f]; j < adjacency.offsets[f + 1]; ++j)
+        {
+            auto t = adjacency.triangles[j];
+            if (emitted[t])
+                continue;
+
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                auto v = indices[t * 3 + k];
+
+                output.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+
+                --liveTriangles[v];
+
+                if (time - timestamps[v] > cacheSize)
+                    timestamps[v] = time++;
+            }
+
+            emitted[t] = true;
+        }
+
+        /* Select next fanning vertex among the candidates that will still be in the cache */
+        fanning = -1;
+        std::int64_t bestPriority = -1;
+
+        for (auto v : candidates)
+        {
+            if (liveTriangles[v] > 0)
+            {
+                std::int64_t priority = 0;
+                if (time - timestamps[v] + 2 * liveTriangles[v] <= cacheSize)
+                    priority = static_cast<std::int64_t>(time - timestamps[v]);
+
+                if (priority > bestPriority)
+                {
+                    bestPriority    = priority;
+                    fanning         = v;
+                }
+            }
+        }
+
+        if (fanning < 0)
+        {
+            /* Skip dead end: continue with the most recent vertex that still has live triangles */
+            while (!deadEnds.empty())
+            {
+                auto v = deadEnds.back();
+                deadEnds.pop_back();
+                if (liveTriangles[v] > 0)
+                {
+                    fanning = v;
+                    break;
+                }
+            }
+
+            /* Otherwise continue with the next vertex in input order */
+            while (fanning < 0 && cursor < numVertices)
+            {
+                if (liveTriangles[cursor] > 0)
+                    fanning = static_cast<std::int64_t>(cursor);
+                ++cursor;
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+LLGL_EXPORT void OptimizeOverdraw(
+    std::uint32_t*  indices,
+    std::size_t     numIndices,
+    const float*    vertexPositions,
+    std::size_t     numVertices,
+    std::size_t     vertexStride,
+    std::size_t     cacheSize,
+    float           threshold)
+{
+    const auto numTriangles = numIndices / 3;
+    if (numTriangles < 2 || numVertices == 0)
+        return;
+
+    numIndices = numTriangles * 3;
+
+    /* Generate hard cluster boundaries, where a triangle misses all its vertices in the cache */
+    std::vector<std::size_t> hardClusters;
+    {
+        std::vector<std::size_t> timestamps(numVertices, 0);
+        std::size_t time = cacheSize + 1;
+
+        for (std::size_t t = 0; t < numTriangles; ++t)
+        {
+            if (CountCacheMisses(indices, t, 1, timestamps, time, cacheSize) == 3)
+                hardClusters.push_back(t);
+        }
+
+        if (hardClusters.empty() || hardClusters.front() != 0)
+            hardClusters.insert(hardClusters.begin(), 0);
+    }
+
+    /* Split hard clusters into soft clusters where the cache miss ratio so far is within the threshold of the entire hard cluster */
+    std::vector<std::size_t> clusters;
+    {
+        std::vector<std::size_t> timestamps(numVertices, 0);
+        std::size_t time = cacheSize + 1;
+
+        for (std::size_t i = 0, n = hardClusters.size(); i < n; ++i)
+        {
+            auto start  = hardClusters[i];
+            auto end    = (i + 1 < n ? hardClusters[i + 1] : numTriangles);
+
+            time += cacheSize + 1;
+            auto clusterMisses  = CountCacheMisses(indices, start, end - start, timestamps, time, cacheSize);
+            auto clusterRatio   = static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+            time += cacheSize + 1;
+            clusters.push_back(start);
+
+            std::size_t misses = 0;
+            for (auto t = start, softStart = start; t < end; ++t)
+            {
+                misses += CountCacheMisses(indices, t, 1, timestamps, time, cacheSize);
+
+                auto ratio = static_cast<float>(misses) / static_cast<float>(t + 1 - softStart);
+                if (t + 1 < end && ratio <= clusterRatio * threshold && t + 1 - softStart >= 2)
+                {
+                    /* Start new soft cluster with a flushed cache */
+                    softStart = t + 1;
+                    misses = 0;
+                    time += cacheSize + 1;
+                    clusters.push_back(softStart);
+                }
+            }
+        }
+    }
+
+    if (clusters.size() < 2)
+        return;
+
+    /* Get vertex position */
+    auto GetPosition = [&](std::uint32_t v) -> const float*
+    {
+        return reinterpret_cast<const float*>(reinterpret_cast<const char*>(vertexPositions) + v * vertexStride);
+    };
+
+    /* Compute mesh centroid */
+    float meshCenter[3] = { 0.0f, 0.0f, 0.0f };
+    for (std::size_t i = 0; i < numIndices; ++i)
+    {
+        auto p = GetPosition(indices[i]);
+        for (int k = 0; k < 3; ++k)
+            meshCenter[k] += p[k];
+    }
+    for (int k = 0; k < 3; ++k)
+        meshCenter[k] /= static_cast<float>(numIndices);
+
+    /* Compute sort key of each cluster: dot product of area-weighted cluster normal and direction from mesh centroid to cluster centroid */
+    const auto numClusters = clusters.size();
+    std::vector<float> sortKeys(numClusters);
+
+    RunParallel(
+        numClusters,
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto c = begin; c < end; ++c)
+            {
+                auto start  = clusters[c];
+                auto last   = (c + 1 < numClusters ? clusters[c + 1] : numTriangles);
+
+                float center[3] = { 0.0f, 0.0f, 0.0f };
+                float normal[3] = { 0.0f, 0.0f, 0.0f };
+                float area      = 0.0f;
+
+                for (auto t = start; t < last; ++t)
+                {
+                    auto p0 = GetPosition(indices[t * 3 + 0]);
+                    auto p1 = GetPosition(indices[t * 3 + 1]);
+                    auto p2 = GetPosition(indices[t * 3 + 2]);
+
+                    const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                    const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                    const float n[3]  = { e1[1]*e2[2] - e1[2]*e2[1], e1[2]*e2[0] - e1[0]*e2[2], e1[0]*e2[1] - e1[1]*e2[0] };
+
+                    auto a = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        center[k] += (p0[k] + p1[k] + p2[k]) * (a / 3.0f);
+                        normal[k] += n[k];
+                    }
+
+                    area += a;
+                }
+
+                auto normalLength = std::sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+                if (area > 0.0f && normalLength > 0.0f)
+                {
+                    float key = 0.0f;
+                    for (int k = 0; k < 3; ++k)
+                        key += (center[k] / area - meshCenter[k]) * (normal[k] / normalLength);
+                    sortKeys[c] = key;
+                }
+                else
+                    sortKeys[c] = 0.0f;
+            }
+        }
+    );
+
+    /* Sort clusters by descending key, so outer clusters are drawn first */
+    std::vector<std::size_t> order(numClusters);
+    for (std::size_t c = 0; c < numClusters; ++c)
+        order[c] = c;
+
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&sortKeys](std::size_t lhs, std::size_t rhs)
+        {
+            return (sortKeys[lhs] > sortKeys[rhs]);
+        }
+    );
+
+    /* Write triangles in the order of the sorted clusters */
+    std::vector<std::uint32_t> output;
+    output.reserve(numTriangles * 3);
+
+    for (auto c : order)
+    {
+        auto start  = clusters[c];
+        auto last   = (c + 1 < numClusters ? clusters[c + 1] : numTriangles);
+        output.insert(output.end(), indices + start * 3, indices + last * 3);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+LLGL_EXPORT std::size_t OptimizeVertexFetch(
+    void*           vertices,
+    std::size_t     numVertices,
+    std::size_t     vertexStride,
+    std::uint32_t*  indices,
+    std::size_t     numIndices)
+{
+    static const std::uint32_t invalidIndex = ~0u;
+
+    /* Assign new vertex indices in the order of their first reference */
+    std::vector<std::uint32_t> remap(numVertices, invalidIndex);
+    std::uint32_t numReferenced = 0;
+
+    for (std::size_t i = 0; i < numIndices; ++i)
+    {
+        auto& newIndex = remap[indices[i]];
+        if (newIndex == invalidIndex)
+            newIndex = numReferenced++;
+    }
+
+    /* Move unreferenced vertices to the end */
+    auto numRemapped = numReferenced;
+    for (auto& newIndex : remap)
+    {
+        if (newIndex == invalidIndex)
+            newIndex = numRemapped++;
+    }
+
+    /* Remap indices and copy vertices into their new order */
+    RunParallel(
+        numIndices,
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+                indices[i] = remap[indices[i]];
+        }
+    );
+
+    auto src = reinterpret_cast<char*>(vertices);
+    std::vector<char> reordered(numVertices * vertexStride);
+
+    RunParallel(
+        numVertices,
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto v = begin; v < end; ++v)
+                std::memcpy(&reordered[remap[v] * vertexStride], src + v * vertexStride, vertexStride);
+        }
+    );
+
+    std::copy(reordered.begin(), reordered.end(), src);
+
+    return numReferenced;
+}
+
+LLGL_EXPORT bool NarrowIndices(const std::uint32_t* srcIndices, std::size_t numIndices, std::uint16_t* dstIndices)
+{
+    /* Check if all indices fit into 16 bits */
+    std::atomic<bool> fits { true };
+
+    RunParallel(
+        numIndices,
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end && fits.load(std::memory_order_relaxed); ++i)
+            {
+                if (srcIndices[i] > 0xFFFFu)
+                    fits = false;
+            }
+        }
+    );
+
+    if (!fits)
+        return false;
+
+    /* Convert indices */
+    RunParallel(
+        numIndices,
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+                dstIndices[i] = static_cast<std::uint16_t>(srcIndices[i]);
+        }
+    );
+
+    return true;
+}
+
+// Computes the bounding sphere and normal cone of the specified meshlet.
+static void ComputeMeshletBounds(
+    Meshlet&                            meshlet,
+    const std::vector<std::uint32_t>&   meshletVertices,
+    const std::vector<std::uint8_t>&    meshletTriangles,
+    const float*                        vertexPositions,
+    std::size_t                         vertexStride)
+{
+    auto GetPosition = [&](std::uint32_t localIndex) -> const float*
+    {
+        auto v = meshletVertices[meshlet.vertexOffset + localIndex];
+        return reinterpret_cast<const float*>(reinterpret_cast<const char*>(vertexPositions) + v * vertexStride);
+    };
+
+    /* Bounding sphere around the center of the bounding box */
+    float minPos[3], maxPos[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        minPos[k] = GetPosition(0)[k];
+        maxPos[k] = minPos[k];
+    }
+
+    for (std::uint32_t i = 1; i < meshlet.numVertices; ++i)
+    {
+        auto p = GetPosition(i);
+        for (int k = 0; k < 3; ++k)
+        {
+            minPos[k] = std::min(minPos[k], p[k]);
+            maxPos[k] = std::max(maxPos[k], p[k]);
+        }
+    }
+
+    for (int k = 0; k < 3; ++k)
+        meshlet.center[k] = (minPos[k] + maxPos[k]) * 0.5f;
+
+    float radiusSq = 0.0f;
+    for (std::uint32_t i = 0; i < meshlet.numVertices; ++i)
+    {
+        auto p = GetPosition(i);
+        const float d[3] = { p[0] - meshlet.center[0], p[1] - meshlet.center[1], p[2] - meshlet.center[2] };
+        radiusSq = std::max(radiusSq, d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+    }
+    meshlet.radius = std::sqrt(radiusSq);
+
+    /* Normal cone: average of the normalized triangle normals, and the widest angle between the axis and any triangle normal */
+    std::vector<float> normals;
+    normals.reserve(meshlet.numTriangles * 3);
+
+    float axis[3] = { 0.0f, 0.0f, 0.0f };
+
+    for (std::uint32_t t = 0; t < meshlet.numTriangles; ++t)
+    {
+        auto tri = &meshletTriangles[meshlet.triangleOffset + t * 3];
+        auto p0 = GetPosition(tri[0]);
+        auto p1 = GetPosition(tri[1]);
+        auto p2 = GetPosition(tri[2]);
+
+        const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        const float n[3]  = { e1[1]*e2[2] - e1[2]*e2[1], e1[2]*e2[0] - e1[0]*e2[2], e1[0]*e2[1] - e1[1]*e2[0] };
+
+        /* Skip degenerate triangles */
+        auto length = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+        if (length > 0.0f)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                normals.push_back(n[k] / length);
+                axis[k] += n[k] / length;
+            }
+        }
+    }
+
+    auto axisLength = std::sqrt(axis[0]*axis[0] + axis[1]*axis[1] + axis[2]*axis[2]);
+
+    float minDot = 1.0f;
+    if (axisLength > 0.0f)
+    {
+        for (int k = 0; k < 3; ++k)
+            axis[k] /= axisLength;
+        for (std::size_t i = 0; i < normals.size(); i += 3)
+            minDot = std::min(minDot, axis[0]*normals[i] + axis[1]*normals[i + 1] + axis[2]*normals[i + 2]);
+    }
+    else
+        minDot = 0.0f;
+
+    for (int k = 0; k < 3; ++k)
+        meshlet.coneAxis[k] = axis[k];
+
+    /* Triangles facing in a hemisphere or more never allow to cull the entire meshlet */
+    meshlet.coneCutoff = (minDot > 0.0f ? std::sqrt(1.0f - minDot*minDot) : 1.0f);
+}
+
+LLGL_EXPORT std::size_t BuildMeshlets(
+    std::vector<Meshlet>&       meshlets,
+    std::vector<std::uint32_t>& meshletVertices,
+    std::vector<std::uint8_t>&  meshletTriangles,
+    const std::uint32_t*        indices,
+    std::size_t                 numIndices,
+    const float*                vertexPositions,
+    std::size_t                 numVertices,
+    std::size_t                 vertexStride,
+    std::size_t                 maxVertices,
+    std::size_t                 maxTriangles)
+{
+    if (maxVertices < 3 || maxVertices > 256)
+        throw std::invalid_argument("maximum number of vertices per meshlet must be in the range [3, 256]");
+    if (maxTriangles < 1 || maxTriangles > 512)
+        throw std::invalid_argument("maximum number of triangles per meshlet must be in the range [1, 512]");
+
+    static const std::uint32_t invalidIndex = ~0u;
+
+    meshlets.clear();
+    meshletVertices.clear();
+    meshletTriangles.clear();
+
+    const auto numTriangles = numIndices / 3;
+    if (numTriangles == 0 || numVertices == 0)
+        return 0;
+
+    /* Local index of each vertex within the current meshlet */
+    std::vector<std::uint32_t> localIndices(numVertices, invalidIndex);
+
+    Meshlet meshlet = {};
+
+    auto FlushMeshlet = [&]()
+    {
+        if (meshlet.numTriangles > 0)
+        {
+            for (std::size_t i = meshlet.vertexOffset; i < meshletVertices.size(); ++i)
+                localIndices[meshletVertices[i]] = invalidIndex;
+            meshlets.push_back(meshlet);
+        }
+        meshlet                 = {};
+        meshlet.vertexOffset    = static_cast<std::uint32_t>(meshletVertices.size());
+        meshlet.triangleOffset  = static_cast<std::uint32_t>(meshletTriangles.size());
+    };
+
+    /* Assign triangles greedily in input order, and start a new meshlet whenever the next triangle exceeds the limits */
+    for (std::size_t t = 0; t < numTriangles; ++t)
+    {
+        const std::uint32_t triangle[3] = { indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2] };
+        const auto a = triangle[0], b = triangle[1], c = triangle[2];
+
+        std::size_t numNewVertices = 0;
+        if (localIndices[a] == invalidIndex)
+            ++numNewVertices;
+        if (localIndices[b] == invalidIndex && b != a)
+            ++numNewVertices;
+        if (localIndices[c] == invalidIndex && c != a && c != b)
+            ++numNewVertices;
+
+        if (meshlet.numVertices + numNewVertices > maxVertices || meshlet.numTriangles + 1 > maxTriangles)
+            FlushMeshlet();
+
+        for (auto v : triangle)
+        {
+            if (localIndices[v] == invalidIndex)
+            {
+                localIndices[v] = meshlet.numVertices++;
+                meshletVertices.push_back(v);
+            }
+            meshletTriangles.push_back(static_cast<std::uint8_t>(localIndices[v]));
+        }
+
+        ++meshlet.numTriangles;
+    }
+
+    FlushMeshlet();
+
+    /* Compute culling bounds of all meshlets */
+    RunParallel(
+        meshlets.size(),
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+                ComputeMeshletBounds(meshlets[i], meshletVertices, meshletTriangles, vertexPositions, vertexStride);
+        }
+    );
+
+    return meshlets.size();
+}
+
+
+} // /namespace LLGL
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,245 @@
+/*
+ * ThreadPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ThreadPool.h"
+#include <algorithm>
+#include <exception>
+
+
+namespace LLGL
+{
+
+
+static ThreadPool*                  g_sharedThreadPool          = nullptr;
+static std::mutex                   g_sharedThreadPoolMutex;
+static std::condition_variable      g_sharedThreadPoolVar;
+static std::size_t                  g_sharedThreadPoolRefCount  = 0;   // Number of render systems
+static std::size_t                  g_sharedThreadPoolNumUsers  = 0;   // Number of pointers returned by GetSharedThreadPool
+
+ThreadPool::ThreadPool(std::size_t threadCount) :
+    threadCount_ { threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()) }
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    var_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+void ThreadPool::ParallelFor(
+    std::size_t                                             count,
+    std::size_t                                             minChunkSize,
+    std::size_t                                             maxThreadCount,
+    const std::function<void(std::size_t, std::size_t)>&    task)
+{
+    if (count == 0)
+        return;
+
+    /* Determine number of chunks and number of helper tasks */
+    const auto chunkSize    = std::max(minChunkSize, std::size_t(1));
+    const auto numChunks    = (count + chunkSize - 1) / chunkSize;
+    const auto numThreads   = std::min({ numChunks, maxThreadCount, threadCount_ + 1 });
+
+    if (numThreads <= 1)
+    {
+        task(0, count);
+        return;
+    }
+
+    /*
+    The state is shared with the helper tasks, because helpers that start after all chunks have been done
+    must still be able to access it, while the calling thread has already returned
+    */
+    struct ParallelForState
+    {
+        std::function<void(std::size_t, std::size_t)>  task;
+        std::atomic<std::size_t>                        nextChunk       { 0 };
+        std::atomic<std::size_t>                        numDoneChunks   { 0 };
+        std::atomic<bool>                               failed          { false };
+        std::exception_ptr                              exception;      // First exception of any chunk; guarded by 'mutex'
+        std::mutex                                      mutex;
+        std::condition_variable                         var;
+    };
+
+    auto state = std::make_shared<ParallelForState>();
+    state->task = task;
+
+    auto runChunks = [state, count, chunkSize, numChunks]()
+    {
+        for (std::size_t chunk; (chunk = state->nextChunk.fetch_add(1)) < numChunks;)
+        {
+            /*
+            Catch exceptions, so they neither escape the worker thread nor unwind the calling thread while other threads still run the task.
+            Chunks after a failure are skipped, but still counted as done, so the calling thread can wait for all chunks
+            */
+            if (!state->failed.load())
+            {
+                try
+                {
+                    const auto begin = chunk * chunkSize;
+                    state->task(begin, std::min(begin + chunkSize, count));
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->exception)
+                        state->exception = std::current_exception();
+                    state->failed = true;
+                }
+            }
+
+            if (state->numDoneChunks.fetch_add(1) + 1 == numChunks)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->var.notify_all();
+            }
+        }
+    };
+
+    /* Submit helper tasks and work on the chunks with the calling thread as well */
+    for (std::size_t i = 1; i < numThreads; ++i)
+        Enqueue(runChunks);
+
+    runChunks();
+
+    /* Wait until the chunks, that are still in progress by other threads, have been done */
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->var.wait(lock, [&state, numChunks]{ return (state->numDoneChunks.load() == numChunks); });
+
+    /* Forward the first exception of any chunk to the calling thread */
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+}
+
+void ThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleVar_.wait(lock, [this]{ return (tasks_.empty() && numBusyTasks_ == 0); });
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ThreadPool::Enqueue(std::function<void()>&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (workers_.empty())
+            StartWorkers();
+        tasks_.push(std::move(task));
+    }
+    var_.notify_one();
+}
+
+void ThreadPool::StartWorkers()
+{
+    workers_.reserve(threadCount_);
+    for (std::size_t i = 0; i < threadCount_; ++i)
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            /* Wait for next task, and exit once all tasks have been done after the pool has been stopped */
+            std::unique_lock<std::mutex> lock(mutex_);
+            var_.wait(lock, [this]{ return (stop_ || !tasks_.empty()); });
+
+            if (tasks_.empty())
+                return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+            ++numBusyTasks_;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --numBusyTasks_;
+            if (tasks_.empty() && numBusyTasks_ == 0)
+                idleVar_.notify_all();
+        }
+    }
+}
+
+
+/* ----- Shared thread pool ----- */
+
+// Deleter of the pointers returned by GetSharedThreadPool, which only signals that the thread pool is no longer used.
+static void ReleaseSharedThreadPoolUser(ThreadPool* /*threadPool*/)
+{
+    std::lock_guard<std::mutex> lock(g_sharedThreadPoolMutex);
+    if (--g_sharedThreadPoolNumUsers == 0)
+        g_sharedThreadPoolVar.notify_all();
+}
+
+std::shared_ptr<ThreadPool> GetSharedThreadPool()
+{
+    std::lock_guard<std::mutex> lock(g_sharedThreadPoolMutex);
+    if (g_sharedThreadPool == nullptr)
+        return nullptr;
+    ++g_sharedThreadPoolNumUsers;
+    return std::shared_ptr<ThreadPool>(g_sharedThreadPool, ReleaseSharedThreadPoolUser);
+}
+
+void RunParallel(
+    std::size_t                                             count,
+    std::size_t                                             minChunkSize,
+    const std::function<void(std::size_t, std::size_t)>&    task)
+{
+    auto threadPool = (count >= minChunkSize * 2 ? GetSharedThreadPool() : nullptr);
+    if (threadPool)
+        threadPool->ParallelFor(count, minChunkSize, threadPool->GetThreadCount() + 1, task);
+    else
+        task(0, count);
+}
+
+ThreadPool& AcquireSharedThreadPool()
+{
+    std::lock_guard<std::mutex> lock(g_sharedThreadPoolMutex);
+    if (g_sharedThreadPoolRefCount++ == 0)
+        g_sharedThreadPool = new ThreadPool();
+    return *g_sharedThreadPool;
+}
+
+void ReleaseSharedThreadPool()
+{
+    std::unique_ptr<ThreadPool> threadPool;
+    {
+        std::unique_lock<std::mutex> lock(g_sharedThreadPoolMutex);
+        if (g_sharedThreadPoolRefCount == 0 || --g_sharedThreadPoolRefCount > 0)
+            return;
+
+        /* Unpublish the thread pool, and wait until the current users are done with it */
+        threadPool.reset(g_sharedThreadPool);
+        g_sharedThreadPool = nullptr;
+        g_sharedThreadPoolVar.wait(lock, []{ return (g_sharedThreadPoolNumUsers == 0); });
+    }
+    /* Thread pool is destroyed outside the lock, since its pending tasks might still request the shared thread pool */
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
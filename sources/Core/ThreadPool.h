@@ -0,0 +1,149 @@
+/*
+ * ThreadPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include <LLGL/Export.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <queue>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Thread pool class to run tasks on a fixed number of worker threads.
+\remarks The worker threads are persistent, i.e. they are only started once and are then reused for all tasks.
+\see GetSharedThreadPool
+*/
+class LLGL_EXPORT ThreadPool
+{
+
+    public:
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        /**
+        \brief Initializes the thread pool with the specified amount of worker threads.
+        \remarks If 'threadCount' is 0, the number of hardware threads is used.
+        The worker threads are only started with the first submitted task.
+        */
+        ThreadPool(std::size_t threadCount = 0);
+
+        //! Waits until all submitted tasks have been done and then stops all worker threads.
+        ~ThreadPool();
+
+        //! Submits the specified task and returns a future to wait for its result.
+        template <typename Task>
+        auto Submit(Task&& task) -> std::shared_future<decltype(task())>
+        {
+            using Result = decltype(task());
+            auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+            auto future = packagedTask->get_future().share();
+            Enqueue([packagedTask]() { (*packagedTask)(); });
+            return future;
+        }
+
+        /**
+        \brief Runs the specified task for the index range [0, count), which is divided into chunks of at least 'minChunkSize' indices.
+        \param[in] count Specifies the number of indices.
+        \param[in] minChunkSize Specifies the minimal number of indices a single invocation of the task will process.
+        \param[in] maxThreadCount Specifies the maximal number of threads (including the calling thread) that will work on the range.
+        \param[in] task Specifies the task, which is invoked with the index range [begin, end) of a chunk.
+        \remarks The calling thread also works on the chunks, and all threads fetch the next chunk from a shared counter
+        until all chunks are done, so no thread stays idle while another one still has a backlog of work.
+        This function returns once all chunks have been processed. It can also be called from within a task of this thread pool.
+        If the task throws an exception, the remaining chunks are skipped, and the first exception is rethrown on the calling thread
+        once no other thread runs the task anymore.
+        */
+        void ParallelFor(
+            std::size_t                                             count,
+            std::size_t                                             minChunkSize,
+            std::size_t                                             maxThreadCount,
+            const std::function<void(std::size_t, std::size_t)>&    task
+        );
+
+        //! Blocks the calling thread until all submitted tasks have been done.
+        void WaitIdle();
+
+        //! Returns the number of worker threads.
+        inline std::size_t GetThreadCount() const
+        {
+            return threadCount_;
+        }
+
+    private:
+
+        void Enqueue(std::function<void()>&& task);
+        void StartWorkers();
+        void WorkerLoop();
+
+        std::size_t                         threadCount_    = 0;
+        std::vector<std::thread>            workers_;
+
+        std::queue<std::function<void()>>   tasks_;
+        std::mutex                          mutex_;
+        std::condition_variable             var_;
+        std::condition_variable             idleVar_;
+        std::size_t                         numBusyTasks_   = 0;
+        bool                                stop_           = false;
+
+};
+
+
+/**
+\brief Returns the thread pool that is shared by the library internal tasks, such as image conversion and shader compilation, or null if there is none.
+\remarks The shared thread pool is alive as long as at least one render system is alive.
+The returned pointer keeps the thread pool alive while it is in use, i.e. "ReleaseSharedThreadPool" waits until all returned pointers have been released,
+so it must not be held longer than the current operation (and must not be held by the thread that releases the last render system).
+\see AcquireSharedThreadPool
+*/
+LLGL_EXPORT std::shared_ptr<ThreadPool> GetSharedThreadPool();
+
+/**
+\brief Runs the specified task for the index range [0, count) on the shared thread pool if there is one, or on the calling thread otherwise.
+\remarks The range is only distributed over the worker threads if it has at least two chunks of 'minChunkSize' indices.
+\see ThreadPool::ParallelFor
+*/
+LLGL_EXPORT void RunParallel(
+    std::size_t                                             count,
+    std::size_t                                             minChunkSize,
+    const std::function<void(std::size_t, std::size_t)>&    task
+);
+
+/**
+\brief Increments the reference counter of the shared thread pool and creates it with the first reference.
+\remarks This is called by the constructor of each render system.
+*/
+LLGL_EXPORT ThreadPool& AcquireSharedThreadPool();
+
+/**
+\brief Decrements the reference counter of the shared thread pool and destroys it with the last reference.
+\remarks With the last reference, this waits until all pointers returned by "GetSharedThreadPool" have been released and all tasks have been done.
+*/
+LLGL_EXPORT void ReleaseSharedThreadPool();
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
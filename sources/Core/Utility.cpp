@@ -8,6 +8,12 @@
 #ifdef LLGL_ENABLE_UTILITY
 
 #include <LLGL/Utility.h>
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
 
 
 namespace LLGL
@@ -181,6 +187,464 @@ LLGL_EXPORT BufferDescriptor StorageBufferDesc(unsigned int size, const StorageB
     return desc;
 }
 
+/* ----- Vertex data utility functions ----- */
+
+// Converts the specified single precision float into a half precision float (rounded to nearest).
+static std::uint16_t FloatToHalf(float value)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const auto sign = static_cast<std::uint32_t>((bits >> 16) & 0x8000u);
+    const auto mant = static_cast<std::uint32_t>(bits & 0x007FFFFFu);
+    const auto exp  = static_cast<std::int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+
+    if (((bits >> 23) & 0xFFu) == 0xFFu)
+    {
+        /* Keep infinity and NaN */
+        return static_cast<std::uint16_t>(sign | 0x7C00u | (mant != 0 ? 0x0200u : 0u));
+    }
+    if (exp >= 31)
+    {
+        /* Overflow to infinity */
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+    if (exp <= 0)
+    {
+        /* Underflow to zero or denormalized half */
+        if (exp < -10)
+            return static_cast<std::uint16_t>(sign);
+
+        const auto mantFull = (mant | 0x00800000u);
+        const auto shift    = static_cast<std::uint32_t>(14 - exp);
+        auto half           = (mantFull >> shift);
+
+        if (((mantFull >> (shift - 1)) & 1u) != 0)
+            ++half;
+
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    /* Rounding might carry over into the exponent, which is the correct result */
+    auto half = (sign | (static_cast<std::uint32_t>(exp) << 10) | (mant >> 13));
+    if ((mant & 0x00001000u) != 0)
+        ++half;
+
+    return static_cast<std::uint16_t>(half);
+}
+
+// Converts the specified float into a signed-normalized integer with the specified maximum.
+static long FloatToSNorm(float value, float maxValue)
+{
+    return std::lround(std::max(-1.0f, std::min(value, 1.0f)) * maxValue);
+}
+
+// Converts the specified float into an unsigned-normalized integer with the specified maximum.
+static unsigned long FloatToUNorm(float value, float maxValue)
+{
+    return static_cast<unsigned long>(std::lround(std::max(0.0f, std::min(value, 1.0f)) * maxValue));
+}
+
+template <typename T>
+static void WriteComponents(char* dst, unsigned int components, const T* values)
+{
+    std::memcpy(dst, values, sizeof(T) * components);
+}
+
+// Writes the specified floating-point vector as the specified vector type.
+static void WriteVertexAttribute(char* dst, const VectorType vectorType, const float (&v)[4])
+{
+    switch (vectorType)
+    {
+        case VectorType::Float:
+        case VectorType::Float2:
+        case VectorType::Float3:
+        case VectorType::Float4:
+        {
+            WriteComponents(dst, static_cast<unsigned int>(vectorType) - static_cast<unsigned int>(VectorType::Float) + 1, v);
+        }
+        break;
+
+        case VectorType::Half2:
+        case VectorType::Half4:
+        {
+            const std::uint16_t h[4] = { FloatToHalf(v[0]), FloatToHalf(v[1]), FloatToHalf(v[2]), FloatToHalf(v[3]) };
+            WriteComponents(dst, (vectorType == VectorType::Half2 ? 2u : 4u), h);
+        }
+        break;
+
+        case VectorType::Byte4Norm:
+        {
+            std::int8_t c[4];
+            for (int i = 0; i < 4; ++i)
+                c[i] = static_cast<std::int8_t>(FloatToSNorm(v[i], 127.0f));
+            WriteComponents(dst, 4, c);
+        }
+        break;
+
+        case VectorType::UByte4Norm:
+        {
+            std::uint8_t c[4];
+            for (int i = 0; i < 4; ++i)
+                c[i] = static_cast<std::uint8_t>(FloatToUNorm(v[i], 255.0f));
+            WriteComponents(dst, 4, c);
+        }
+        break;
+
+        case VectorType::Short2Norm:
+        case VectorType::Short4Norm:
+        {
+            std::int16_t c[4];
+            for (int i = 0; i < 4; ++i)
+                c[i] = static_cast<std::int16_t>(FloatToSNorm(v[i], 32767.0f));
+            WriteComponents(dst, (vectorType == VectorType::Short2Norm ? 2u : 4u), c);
+        }
+        break;
+
+        case VectorType::UShort2Norm:
+        case VectorType::UShort4Norm:
+        {
+            std::uint16_t c[4];
+            for (int i = 0; i < 4; ++i)
+                c[i] = static_cast<std::uint16_t>(FloatToUNorm(v[i], 65535.0f));
+            WriteComponents(dst, (vectorType == VectorType::UShort2Norm ? 2u : 4u), c);
+        }
+        break;
+
+        case VectorType::UInt1010102Norm:
+        {
+            const auto packed = static_cast<std::uint32_t>(
+                (FloatToUNorm(v[0], 1023.0f)      ) |
+                (FloatToUNorm(v[1], 1023.0f) << 10) |
+                (FloatToUNorm(v[2], 1023.0f) << 20) |
+                (FloatToUNorm(v[3],    3.0f) << 30)
+            );
+            WriteComponents(dst, 1, &packed);
+        }
+        break;
+
+        default:
+            throw std::invalid_argument("cannot convert vertex attribute from floating-point vector into integral vector type");
+    }
+}
+
+static const VertexAttribute* FindVertexAttribute(const VertexFormat& format, const VertexAttribute& attrib)
+{
+    for (const auto& other : format.attributes)
+    {
+        if (other.name == attrib.name && other.semanticIndex == attrib.semanticIndex)
+            return (&other);
+    }
+    return nullptr;
+}
+
+static bool IsFloatVectorType(const VectorType vectorType)
+{
+    return (vectorType >= VectorType::Float && vectorType <= VectorType::Float4);
+}
+
+LLGL_EXPORT void ConvertVertices(const void* srcVertices, const VertexFormat& srcFormat, void* dstVertices, const VertexFormat& dstFormat, std::size_t numVertices)
+{
+    /* Find source attribute for each destination attribute */
+    std::vector<const VertexAttribute*> srcAttribs;
+    srcAttribs.reserve(dstFormat.attributes.size());
+
+    for (const auto& dstAttrib : dstFormat.attributes)
+    {
+        auto srcAttrib = FindVertexAttribute(srcFormat, dstAttrib);
+        if (!srcAttrib)
+            throw std::invalid_argument("missing source for vertex attribute: " + dstAttrib.name);
+        if (srcAttrib->vectorType != dstAttrib.vectorType && !IsFloatVectorType(srcAttrib->vectorType))
+            throw std::invalid_argument("cannot convert non floating-point source of vertex attribute: " + dstAttrib.name);
+        srcAttribs.push_back(srcAttrib);
+    }
+
+    auto src = reinterpret_cast<const char*>(srcVertices);
+    auto dst = reinterpret_cast<char*>(dstVertices);
+
+    for (std::size_t i = 0; i < numVertices; ++i, src += srcFormat.stride, dst += dstFormat.stride)
+    {
+        for (std::size_t j = 0, n = dstFormat.attributes.size(); j < n; ++j)
+        {
+            const auto& dstAttrib = dstFormat.attributes[j];
+            const auto& srcAttrib = *srcAttribs[j];
+
+            if (srcAttrib.vectorType == dstAttrib.vectorType)
+            {
+                /* Copy attribute with the same vector type */
+                std::memcpy(dst + dstAttrib.offset, src + srcAttrib.offset, dstAttrib.GetSize());
+            }
+            else
+            {
+                /* Read floating-point vector and convert it into the destination vector type */
+                float v[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                std::memcpy(v, src + srcAttrib.offset, srcAttrib.GetSize());
+                WriteVertexAttribute(dst + dstAttrib.offset, dstAttrib.vectorType, v);
+            }
+        }
+    }
+}
+
+// Shader code generator for vertex pulling; all attributes are decoded from 32-bit words of the storage buffer.
+class VertexPullingGenerator
+{
+
+    public:
+
+        VertexPullingGenerator(const ShadingLanguage language) :
+            hlsl_ { language >= ShadingLanguage::HLSL_2_0 && language <= ShadingLanguage::HLSL_5_1 }
+        {
+            const bool supported =
+            (
+                (language >= ShadingLanguage::GLSL_430    && language <= ShadingLanguage::GLSL_460   ) ||
+                (language >= ShadingLanguage::GLSL_ES_310 && language <= ShadingLanguage::GLSL_ES_320) ||
+                (language >= ShadingLanguage::HLSL_5_0    && language <= ShadingLanguage::HLSL_5_1   )
+            );
+            if (!supported)
+                throw std::invalid_argument("shading language does not support vertex pulling (requires GLSL 4.30, GLSL ES 3.10, or HLSL 5.0)");
+        }
+
+        // Returns the type name of a float, int, or uint vector ('scalarType' is 'f', 'i', or 'u').
+        std::string TypeName(char scalarType, unsigned int components) const
+        {
+            static const char* glslFloat[]  = { "float", "vec2", "vec3", "vec4" };
+            static const char* glslInt[]    = { "int", "ivec2", "ivec3", "ivec4" };
+            static const char* glslUInt[]   = { "uint", "uvec2", "uvec3", "uvec4" };
+            static const char* hlslFloat[]  = { "float", "float2", "float3", "float4" };
+            static const char* hlslInt[]    = { "int", "int2", "int3", "int4" };
+            static const char* hlslUInt[]   = { "uint", "uint2", "uint3", "uint4" };
+
+            const auto i = components - 1;
+            switch (scalarType)
+            {
+                case 'f': return (hlsl_ ? hlslFloat[i] : glslFloat[i]);
+                case 'i': return (hlsl_ ? hlslInt[i]   : glslInt[i]  );
+                default:  return (hlsl_ ? hlslUInt[i]  : glslUInt[i] );
+            }
+        }
+
+        // Returns the expression to load the 32-bit word at the specified offset (in bytes) of the current vertex.
+        std::string Word(unsigned int offset) const
+        {
+            if (hlsl_)
+                return "vertexPullingData.Load(base + " + std::to_string(offset) + "u)";
+            else
+                return "vertexPullingData[base + " + std::to_string(offset / 4) + "u]";
+        }
+
+        // Returns the expression to load 'count' consecutive 32-bit words as uint vector.
+        std::string Words(unsigned int offset, unsigned int count) const
+        {
+            if (count == 1)
+                return Word(offset);
+            std::string s = TypeName('u', count) + "(";
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                if (i > 0)
+                    s += ", ";
+                s += Word(offset + i * 4);
+            }
+            return s + ")";
+        }
+
+        // Returns the expression to decode a vertex attribute and the scalar type of the shader variable.
+        std::string Decode(const VertexAttribute& attrib, char& scalarType, unsigned int& components) const
+        {
+            const auto offset = attrib.offset;
+            switch (attrib.vectorType)
+            {
+                case VectorType::Float:
+                case VectorType::Float2:
+                case VectorType::Float3:
+                case VectorType::Float4:
+                    scalarType  = 'f';
+                    components  = attrib.GetSize() / 4;
+                    return (hlsl_ ? "asfloat(" : "uintBitsToFloat(") + Words(offset, components) + ")";
+
+                case VectorType::Int:
+                case VectorType::Int2:
+                case VectorType::Int3:
+                case VectorType::Int4:
+                    components = attrib.GetSize() / 4;
+                    return Convert(attrib, 'i', components, (hlsl_ ? "asint(" : TypeName('i', components) + "(") + Words(offset, components) + ")", scalarType);
+
+                case VectorType::UInt:
+                case VectorType::UInt2:
+                case VectorType::UInt3:
+                case VectorType::UInt4:
+                    components = attrib.GetSize() / 4;
+                    return Convert(attrib, 'u', components, Words(offset, components), scalarType);
+
+                case VectorType::Half2:
+                    scalarType  = 'f';
+                    components  = 2;
+                    return UnpackHalf2(Word(offset));
+
+                case VectorType::Half4:
+                    scalarType  = 'f';
+                    components  = 4;
+                    return TypeName('f', 4) + "(" + UnpackHalf2(Word(offset)) + ", " + UnpackHalf2(Word(offset + 4)) + ")";
+
+                case VectorType::Byte4Norm:
+                    scalarType  = 'f';
+                    components  = 4;
+                    if (hlsl_)
+                        return "max(float4(int4(" + Word(offset) + " << uint4(24u, 16u, 8u, 0u)) >> 24) / 127.0, -1.0)";
+                    return "unpackSnorm4x8(" + Word(offset) + ")";
+
+                case VectorType::UByte4Norm:
+                    scalarType  = 'f';
+                    components  = 4;
+                    if (hlsl_)
+                        return "float4((" + Word(offset) + " >> uint4(0u, 8u, 16u, 24u)) & 0xFFu) / 255.0";
+                    return "unpackUnorm4x8(" + Word(offset) + ")";
+
+                case VectorType::Short2Norm:
+                    scalarType  = 'f';
+                    components  = 2;
+                    return UnpackShort2Norm(Word(offset));
+
+                case VectorType::Short4Norm:
+                    scalarType  = 'f';
+                    components  = 4;
+                    return TypeName('f', 4) + "(" + UnpackShort2Norm(Word(offset)) + ", " + UnpackShort2Norm(Word(offset + 4)) + ")";
+
+                case VectorType::UShort2Norm:
+                    scalarType  = 'f';
+                    components  = 2;
+                    return UnpackUShort2Norm(Word(offset));
+
+                case VectorType::UShort4Norm:
+                    scalarType  = 'f';
+                    components  = 4;
+                    return TypeName('f', 4) + "(" + UnpackUShort2Norm(Word(offset)) + ", " + UnpackUShort2Norm(Word(offset + 4)) + ")";
+
+                case VectorType::UInt1010102Norm:
+                    scalarType  = 'f';
+                    components  = 4;
+                    return
+                    (
+                        TypeName('f', 4) + "((" + TypeName('u', 4) + "(" + Word(offset) + ") >> " + TypeName('u', 4) + "(0u, 10u, 20u, 30u)) & " +
+                        TypeName('u', 4) + "(0x3FFu, 0x3FFu, 0x3FFu, 0x3u)) / " + TypeName('f', 4) + "(1023.0, 1023.0, 1023.0, 3.0)"
+                    );
+
+                default:
+                    throw std::invalid_argument("cannot generate vertex pulling code for vector type of vertex attribute \"" + attrib.name + "\"");
+            }
+        }
+
+    private:
+
+        // Converts integer vectors into floating-point vectors if the attribute has the conversion flag.
+        std::string Convert(const VertexAttribute& attrib, char srcType, unsigned int components, const std::string& expr, char& scalarType) const
+        {
+            if (attrib.conversion)
+            {
+                scalarType = 'f';
+                return TypeName('f', components) + "(" + expr + ")";
+            }
+            scalarType = srcType;
+            return expr;
+        }
+
+        std::string UnpackHalf2(const std::string& word) const
+        {
+            if (hlsl_)
+                return "f16tof32(uint2(" + word + ", " + word + " >> 16u))";
+            return "unpackHalf2x16(" + word + ")";
+        }
+
+        std::string UnpackShort2Norm(const std::string& word) const
+        {
+            if (hlsl_)
+                return "max(float2(int2(" + word + " << uint2(16u, 0u)) >> 16) / 32767.0, -1.0)";
+            return "unpackSnorm2x16(" + word + ")";
+        }
+
+        std::string UnpackUShort2Norm(const std::string& word) const
+        {
+            if (hlsl_)
+                return "float2((" + word + " >> uint2(0u, 16u)) & 0xFFFFu) / 65535.0";
+            return "unpackUnorm2x16(" + word + ")";
+        }
+
+        bool hlsl_ = false;
+
+};
+
+static std::string GetPulledAttributeName(const VertexAttribute& attrib)
+{
+    if (attrib.semanticIndex > 0)
+        return attrib.name + std::to_string(attrib.semanticIndex);
+    else
+        return attrib.name;
+}
+
+LLGL_EXPORT std::string GenerateVertexPullingShader(const VertexFormat& vertexFormat, const ShadingLanguage language, unsigned int slot)
+{
+    VertexPullingGenerator generator { language };
+
+    const bool hlsl = (language >= ShadingLanguage::HLSL_2_0 && language <= ShadingLanguage::HLSL_5_1);
+
+    /* Validate vertex format; all attributes are loaded as 32-bit words from a single buffer */
+    if (vertexFormat.stride % 4 != 0)
+        throw std::invalid_argument("vertex pulling requires a vertex stride that is a multiple of 4, but got " + std::to_string(vertexFormat.stride));
+
+    for (const auto& attrib : vertexFormat.attributes)
+    {
+        if (attrib.offset % 4 != 0)
+            throw std::invalid_argument("vertex pulling requires attribute offsets that are multiples of 4 (for vertex attribute \"" + attrib.name + "\")");
+        if (attrib.inputSlot != vertexFormat.attributes.front().inputSlot)
+            throw std::invalid_argument("vertex pulling requires all vertex attributes to be in the same input slot");
+    }
+
+    /* Decode all attributes before anything is written, so unsupported vector types throw early */
+    std::vector<std::string>    decodeExprs;
+    std::vector<std::string>    typeNames;
+
+    for (const auto& attrib : vertexFormat.attributes)
+    {
+        char            scalarType  = 'f';
+        unsigned int    components  = 4;
+        decodeExprs.push_back(generator.Decode(attrib, scalarType, components));
+        typeNames.push_back(generator.TypeName(scalarType, components));
+    }
+
+    std::stringstream s;
+
+    s << "// Vertex pulling code generated by LLGL for a vertex stride of " << vertexFormat.stride << " bytes\n\n";
+
+    /* Write storage buffer declaration */
+    if (hlsl)
+        s << "ByteAddressBuffer vertexPullingData : register(t" << slot << ");\n\n";
+    else
+    {
+        s << "layout(std430, binding = " << slot << ") readonly buffer VertexPullingBuffer\n";
+        s << "{\n";
+        s << "    uint vertexPullingData[];\n";
+        s << "};\n\n";
+    }
+
+    /* Write vertex structure */
+    s << "struct PulledVertex\n";
+    s << "{\n";
+    for (std::size_t i = 0; i < vertexFormat.attributes.size(); ++i)
+        s << "    " << typeNames[i] << ' ' << GetPulledAttributeName(vertexFormat.attributes[i]) << ";\n";
+    s << "};\n\n";
+
+    /* Write fetch function; the base is in bytes for HLSL and in 32-bit words for GLSL */
+    s << "PulledVertex FetchVertex(uint vertexID)\n";
+    s << "{\n";
+    s << "    uint base = vertexID * " << (hlsl ? vertexFormat.stride : vertexFormat.stride / 4) << "u;\n";
+    s << "    PulledVertex v;\n";
+    for (std::size_t i = 0; i < vertexFormat.attributes.size(); ++i)
+        s << "    v." << GetPulledAttributeName(vertexFormat.attributes[i]) << " = " << decodeExprs[i] << ";\n";
+    s << "    return v;\n";
+    s << "}\n";
+
+    return s.str();
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,100 @@
+/*
+ * AndroidAsyncFileRead.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "AndroidAsyncFileRead.h"
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace LLGL
+{
+
+
+std::unique_ptr<AsyncFileRead> AsyncFileRead::Start(const std::string& filename, std::uint64_t offset, std::size_t size, void* data)
+{
+    return std::unique_ptr<AsyncFileRead>(new AndroidAsyncFileRead(filename, offset, size, data));
+}
+
+AndroidAsyncFileRead::AndroidAsyncFileRead(const std::string& filename, std::uint64_t offset, std::size_t size, void* data) :
+    completed_ { false },
+    cancelled_ { false }
+{
+    fd_ = open(filename.c_str(), O_RDONLY);
+    if (fd_ == -1)
+        throw std::runtime_error("failed to open file \"" + filename + "\"");
+
+    try
+    {
+        worker_ = std::thread(&AndroidAsyncFileRead::ReadFile, this, offset, size, data);
+    }
+    catch (const std::system_error&)
+    {
+        close(fd_);
+        throw std::runtime_error("failed to start asynchronous read of file \"" + filename + "\"");
+    }
+}
+
+AndroidAsyncFileRead::~AndroidAsyncFileRead()
+{
+    /* Cancel remaining chunks, but wait for the current one, since it still writes into the destination memory */
+    cancelled_ = true;
+    if (worker_.joinable())
+        worker_.join();
+    close(fd_);
+}
+
+bool AndroidAsyncFileRead::Poll()
+{
+    return completed_;
+}
+
+bool AndroidAsyncFileRead::Wait()
+{
+    if (worker_.joinable())
+        worker_.join();
+    return succeeded_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void AndroidAsyncFileRead::ReadFile(std::uint64_t offset, std::size_t size, void* data)
+{
+    /* Read in chunks, so a cancellation does not have to wait for the entire range */
+    static const std::size_t chunkSize = 1024 * 1024;
+
+    auto dst = reinterpret_cast<char*>(data);
+
+    while (size > 0 && !cancelled_)
+    {
+        auto result = pread(fd_, dst, std::min(size, chunkSize), static_cast<off_t>(offset));
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            break;
+
+        dst     += result;
+        offset  += static_cast<std::uint64_t>(result);
+        size    -= static_cast<std::size_t>(result);
+    }
+
+    succeeded_ = (size == 0);
+    completed_ = true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
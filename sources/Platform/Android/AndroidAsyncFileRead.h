@@ -0,0 +1,56 @@
+/*
+ * AndroidAsyncFileRead.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ANDROID_ASYNC_FILE_READ_H
+#define LLGL_ANDROID_ASYNC_FILE_READ_H
+
+
+#include "../AsyncFileRead.h"
+#include <atomic>
+#include <thread>
+
+
+namespace LLGL
+{
+
+
+// Asynchronous file read with a worker thread, since the Android C library does not provide POSIX AIO.
+class AndroidAsyncFileRead : public AsyncFileRead
+{
+
+    public:
+
+        AndroidAsyncFileRead(const std::string& filename, std::uint64_t offset, std::size_t size, void* data);
+        ~AndroidAsyncFileRead();
+
+        AndroidAsyncFileRead(const AndroidAsyncFileRead&) = delete;
+        AndroidAsyncFileRead& operator = (const AndroidAsyncFileRead&) = delete;
+
+        bool Poll() override;
+        bool Wait() override;
+
+    private:
+
+        void ReadFile(std::uint64_t offset, std::size_t size, void* data);
+
+        int                 fd_         = -1;
+        std::thread         worker_;
+        std::atomic<bool>   completed_;
+        std::atomic<bool>   cancelled_;
+        bool                succeeded_  = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
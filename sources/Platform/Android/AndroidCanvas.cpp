@@ -0,0 +1,240 @@
+/*
+ * AndroidCanvas.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "AndroidCanvas.h"
+#include <LLGL/Platform/NativeHandle.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/* ----- Android activity ----- */
+
+static ANativeWindow* g_nativeWindow = nullptr;
+
+namespace Android
+{
+
+
+LLGL_EXPORT void SetNativeWindow(ANativeWindow* window)
+{
+    g_nativeWindow = window;
+}
+
+LLGL_EXPORT ANativeWindow* GetNativeWindow()
+{
+    return g_nativeWindow;
+}
+
+
+} // /namespace Android
+
+
+/* ----- AndroidCanvas class ----- */
+
+// Default refresh period (60 Hz) until the period has been measured from consecutive frame callbacks.
+static const std::int64_t g_defaultVsyncPeriod = 16666667;
+
+static double NanosecondsToSeconds(std::int64_t t)
+{
+    return static_cast<double>(t) * 1.0e-9;
+}
+
+std::unique_ptr<Canvas> Canvas::Create(const CanvasDescriptor& desc)
+{
+    return std::unique_ptr<Canvas>(new AndroidCanvas(desc));
+}
+
+AndroidCanvas::AndroidCanvas(const CanvasDescriptor& desc) :
+    desc_ { desc }
+{
+    if (!g_nativeWindow)
+        throw std::runtime_error("cannot create Android canvas without native window (see LLGL::Android::SetNativeWindow)");
+    AcquireWindow(g_nativeWindow);
+}
+
+AndroidCanvas::~AndroidCanvas()
+{
+    StopFrameLoop();
+    ReleaseWindow();
+}
+
+void AndroidCanvas::GetNativeHandle(void* nativeHandle) const
+{
+    auto& handle = *reinterpret_cast<NativeHandle*>(nativeHandle);
+    handle.window = window_;
+}
+
+void AndroidCanvas::Recreate()
+{
+    /* Take the current window of the activity, since the previous one is destroyed when the activity is paused */
+    ReleaseWindow();
+    if (g_nativeWindow)
+        AcquireWindow(g_nativeWindow);
+}
+
+Size AndroidCanvas::GetContentSize() const
+{
+    if (window_)
+        return { ANativeWindow_getWidth(window_), ANativeWindow_getHeight(window_) };
+    else
+        return {};
+}
+
+void AndroidCanvas::SetTitle(const std::wstring& title)
+{
+    /* Activities have no title bar, so the title is only stored */
+    desc_.title = title;
+}
+
+std::wstring AndroidCanvas::GetTitle() const
+{
+    return desc_.title;
+}
+
+bool AndroidCanvas::StartFrameLoop()
+{
+    if (!choreographer_)
+    {
+        /* Choreographer instance is bound to the looper of the calling thread */
+        choreographer_ = AChoreographer_getInstance();
+        if (!choreographer_)
+            return false;
+
+        lastVsyncTime_  = 0;
+        lastFrameTime_  = 0;
+        vsyncPeriod_    = g_defaultVsyncPeriod;
+
+        SetPreferredFramesPerSecond(desc_.preferredFramesPerSecond);
+        PostFrameCallback();
+    }
+    return true;
+}
+
+void AndroidCanvas::StopFrameLoop()
+{
+    if (pendingFrameCallback_)
+    {
+        /* Detach canvas from the pending callback, which deletes its data when it is invoked */
+        pendingFrameCallback_->canvas = nullptr;
+        pendingFrameCallback_ = nullptr;
+    }
+    choreographer_ = nullptr;
+}
+
+void AndroidCanvas::SetPreferredFramesPerSecond(std::uint32_t framesPerSecond)
+{
+    desc_.preferredFramesPerSecond = framesPerSecond;
+
+    #if __ANDROID_API__ >= 30
+
+    /* Let the compositor switch the display to a matching refresh rate (if supported), instead of only skipping refreshes */
+    if (window_)
+        ANativeWindow_setFrameRate(window_, static_cast<float>(framesPerSecond), ANATIVEWINDOW_FRAME_RATE_COMPATIBILITY_DEFAULT);
+
+    #endif
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void AndroidCanvas::OnProcessEvents()
+{
+    // dummy
+}
+
+void AndroidCanvas::AcquireWindow(ANativeWindow* window)
+{
+    window_ = window;
+    ANativeWindow_acquire(window_);
+}
+
+void AndroidCanvas::ReleaseWindow()
+{
+    if (window_)
+    {
+        ANativeWindow_release(window_);
+        window_ = nullptr;
+    }
+}
+
+void AndroidCanvas::PostFrameCallback()
+{
+    pendingFrameCallback_ = new FrameCallbackData{ this };
+
+    #if __ANDROID_API__ >= 29
+    AChoreographer_postFrameCallback64(choreographer_, AndroidCanvas::OnFrameCallback, pendingFrameCallback_);
+    #else
+    AChoreographer_postFrameCallback(
+        choreographer_,
+        [](long frameTimeNanos, void* data)
+        {
+            AndroidCanvas::OnFrameCallback(static_cast<std::int64_t>(frameTimeNanos), data);
+        },
+        pendingFrameCallback_
+    );
+    #endif
+}
+
+void AndroidCanvas::OnFrame(std::int64_t frameTimeNanos)
+{
+    /* Measure refresh period from consecutive display refreshes, but ignore gaps of dropped frames */
+    if (lastVsyncTime_ > 0)
+    {
+        const auto delta = frameTimeNanos - lastVsyncTime_;
+        if (delta > 0 && delta < vsyncPeriod_ * 3 / 2)
+            vsyncPeriod_ = delta;
+    }
+    lastVsyncTime_ = frameTimeNanos;
+
+    /* Skip display refreshes until the frame period of the preferred frame rate has elapsed (tolerate half a refresh period of jitter) */
+    auto framePeriod = vsyncPeriod_;
+
+    if (desc_.preferredFramesPerSecond > 0)
+    {
+        framePeriod = std::max(framePeriod, static_cast<std::int64_t>(1000000000ll / desc_.preferredFramesPerSecond));
+        if (lastFrameTime_ > 0 && frameTimeNanos - lastFrameTime_ < framePeriod - vsyncPeriod_ / 2)
+            return;
+    }
+
+    lastFrameTime_ = frameTimeNanos;
+
+    /* Frame that is rendered now is presented with the display refresh at the end of its frame period */
+    CanvasFrameTimes frameTimes;
+    {
+        frameTimes.timestamp        = NanosecondsToSeconds(frameTimeNanos);
+        frameTimes.targetTimestamp  = NanosecondsToSeconds(frameTimeNanos + framePeriod);
+        frameTimes.duration         = NanosecondsToSeconds(framePeriod);
+    }
+    PostDrawFrame(frameTimes);
+}
+
+void AndroidCanvas::OnFrameCallback(std::int64_t frameTimeNanos, void* data)
+{
+    auto callbackData = reinterpret_cast<FrameCallbackData*>(data);
+    auto canvas = callbackData->canvas;
+    delete callbackData;
+
+    if (canvas)
+    {
+        /* Post next callback first, so the frame loop can be stopped within the DrawFrame event */
+        canvas->PostFrameCallback();
+        canvas->OnFrame(frameTimeNanos);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,86 @@
+/*
+ * AndroidCanvas.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ANDROID_CANVAS_H
+#define LLGL_ANDROID_CANVAS_H
+
+
+#include <LLGL/Canvas.h>
+#include <android/native_window.h>
+#include <android/choreographer.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Canvas for the window of an Android activity. The frame loop is driven by AChoreographer frame callbacks,
+which are invoked once per display refresh on the thread that started the frame loop (this thread requires an ALooper).
+*/
+class AndroidCanvas : public Canvas
+{
+
+    public:
+
+        AndroidCanvas(const CanvasDescriptor& desc);
+        ~AndroidCanvas();
+
+        void GetNativeHandle(void* nativeHandle) const override;
+
+        void Recreate() override;
+
+        Size GetContentSize() const override;
+
+        void SetTitle(const std::wstring& title) override;
+        std::wstring GetTitle() const override;
+
+        bool StartFrameLoop() override;
+        void StopFrameLoop() override;
+        void SetPreferredFramesPerSecond(std::uint32_t framesPerSecond) override;
+
+    private:
+
+        // Data of a pending frame callback; Choreographer callbacks cannot be cancelled, so the canvas is detached from it instead.
+        struct FrameCallbackData
+        {
+            AndroidCanvas* canvas;
+        };
+
+        void OnProcessEvents() override;
+
+        void AcquireWindow(ANativeWindow* window);
+        void ReleaseWindow();
+
+        void PostFrameCallback();
+        void OnFrame(std::int64_t frameTimeNanos);
+
+        static void OnFrameCallback(std::int64_t frameTimeNanos, void* data);
+
+        CanvasDescriptor    desc_;
+
+        ANativeWindow*      window_                 = nullptr;
+
+        AChoreographer*     choreographer_          = nullptr;
+        FrameCallbackData*  pendingFrameCallback_   = nullptr;
+
+        std::int64_t        lastVsyncTime_          = 0;    // Time of the previous display refresh (in nanoseconds of CLOCK_MONOTONIC).
+        std::int64_t        lastFrameTime_          = 0;    // Time of the display refresh for the previous DrawFrame event.
+        std::int64_t        vsyncPeriod_            = 0;    // Measured refresh period of the display (in nanoseconds).
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,50 @@
+/*
+ * Desktop.cpp (Android)
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/Desktop.h>
+#include <LLGL/Platform/NativeHandle.h>
+
+
+namespace LLGL
+{
+
+namespace Desktop
+{
+
+
+LLGL_EXPORT Size GetResolution()
+{
+    /* Activity window always covers the entire display */
+    if (auto window = Android::GetNativeWindow())
+        return { ANativeWindow_getWidth(window), ANativeWindow_getHeight(window) };
+    else
+        return {};
+}
+
+LLGL_EXPORT int GetColorDepth()
+{
+    return 24;
+}
+
+LLGL_EXPORT bool SetVideoMode(const VideoModeDescriptor& videoMode)
+{
+    return false;
+}
+
+LLGL_EXPORT bool ResetVideoMode()
+{
+    return false;
+}
+
+
+} // /namespace Desktop
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
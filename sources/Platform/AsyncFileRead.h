@@ -0,0 +1,61 @@
+/*
+ * AsyncFileRead.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ASYNC_FILE_READ_H
+#define LLGL_ASYNC_FILE_READ_H
+
+
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+//! Asynchronous read of a file range into caller provided memory (overlapped I/O on Win32, POSIX AIO otherwise)
+class AsyncFileRead
+{
+
+    public:
+
+        AsyncFileRead() = default;
+
+        AsyncFileRead(const AsyncFileRead&) = delete;
+        AsyncFileRead& operator = (const AsyncFileRead&) = delete;
+
+        //! Cancels the read if it is still in flight and waits until the destination memory is no longer accessed.
+        virtual ~AsyncFileRead()
+        {
+        }
+
+        /**
+        \brief Opens the specified file and starts reading 'size' bytes at 'offset' into the destination memory.
+        \remarks The destination memory must remain valid until the read has completed or this object has been destroyed.
+        \throws std::runtime_error If the file could not be opened, or the read could not be started.
+        */
+        static std::unique_ptr<AsyncFileRead> Start(const std::string& filename, std::uint64_t offset, std::size_t size, void* data);
+
+        //! Returns true if the read has completed (successfully or not), without blocking.
+        virtual bool Poll() = 0;
+
+        //! Blocks until the read has completed, and returns true if all requested bytes have been read.
+        virtual bool Wait() = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
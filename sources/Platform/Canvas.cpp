@@ -24,6 +24,11 @@ void Canvas::EventListener::OnProcessEvents(Canvas& sender)
     // dummy
 }
 
+void Canvas::EventListener::OnDrawFrame(Canvas& sender, const CanvasFrameTimes& frameTimes)
+{
+    // dummy
+}
+
 
 /* ----- Window class ----- */
 
@@ -56,6 +61,13 @@ void Canvas::ProcessEvents()
     OnProcessEvents();
 }
 
+/* --- Frame loop --- */
+
+void Canvas::PostDrawFrame(const CanvasFrameTimes& frameTimes)
+{
+    FOREACH_LISTENER_CALL( OnDrawFrame(*this, frameTimes) );
+}
+
 /* --- Event handling --- */
 
 void Canvas::AddEventListener(const std::shared_ptr<EventListener>& eventListener)
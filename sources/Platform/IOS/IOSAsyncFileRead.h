@@ -0,0 +1,54 @@
+/*
+ * IOSAsyncFileRead.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IOS_ASYNC_FILE_READ_H
+#define LLGL_IOS_ASYNC_FILE_READ_H
+
+
+#include "../AsyncFileRead.h"
+#include <aio.h>
+
+
+namespace LLGL
+{
+
+
+class IOSAsyncFileRead : public AsyncFileRead
+{
+
+    public:
+
+        IOSAsyncFileRead(const std::string& filename, std::uint64_t offset, std::size_t size, void* data);
+        ~IOSAsyncFileRead();
+
+        IOSAsyncFileRead(const IOSAsyncFileRead&) = delete;
+        IOSAsyncFileRead& operator = (const IOSAsyncFileRead&) = delete;
+
+        bool Poll() override;
+        bool Wait() override;
+
+    private:
+
+        // Blocks until the request has completed, and retrieves its result exactly once.
+        void Complete();
+
+        int             fd_         = -1;
+        struct aiocb    request_;
+        bool            completed_  = false;
+        ssize_t         result_     = -1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
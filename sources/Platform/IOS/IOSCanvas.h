@@ -10,9 +10,13 @@
 
 
 #include <UIKit/UIKit.h>
+#include <QuartzCore/QuartzCore.h>
 #include <LLGL/Canvas.h>
 
 
+@class IOSCanvasDisplayLinkTarget;
+
+
 namespace LLGL
 {
 
@@ -34,13 +38,20 @@ class IOSCanvas : public Canvas
         void SetTitle(const std::wstring& title) override;
         std::wstring GetTitle() const override;
 
+        bool StartFrameLoop() override;
+        void StopFrameLoop() override;
+        void SetPreferredFramesPerSecond(std::uint32_t framesPerSecond) override;
+
     private:
         
         void OnProcessEvents() override;
 
-        CanvasDescriptor    desc_;
+        CanvasDescriptor                desc_;
+
+        UIView*                         view_               = nullptr;
 
-        UIView*             view_ = nullptr;
+        CADisplayLink*                  displayLink_        = nullptr;
+        IOSCanvasDisplayLinkTarget*     displayLinkTarget_  = nullptr;
 
 };
 
@@ -7,6 +7,46 @@
 
 #include "IOSCanvas.h"
 #include <LLGL/Platform/NativeHandle.h>
+#include <algorithm>
+
+
+/*
+Target of the CADisplayLink, which forwards each display refresh to the canvas.
+The display link retains its target, so the target must not retain the canvas.
+*/
+@interface IOSCanvasDisplayLinkTarget : NSObject
+
+- (id)initWithCanvas:(LLGL::IOSCanvas*)canvas;
+- (void)onDisplayLink:(CADisplayLink*)displayLink;
+
+@end
+
+@implementation IOSCanvasDisplayLinkTarget
+{
+    LLGL::IOSCanvas* canvas_;
+}
+
+- (id)initWithCanvas:(LLGL::IOSCanvas*)canvas
+{
+    self = [super init];
+
+    canvas_ = canvas;
+
+    return (self);
+}
+
+- (void)onDisplayLink:(CADisplayLink*)displayLink
+{
+    LLGL::CanvasFrameTimes frameTimes;
+    {
+        frameTimes.timestamp        = displayLink.timestamp;
+        frameTimes.targetTimestamp  = displayLink.targetTimestamp;
+        frameTimes.duration         = displayLink.targetTimestamp - displayLink.timestamp;
+    }
+    canvas_->PostDrawFrame(frameTimes);
+}
+
+@end
 
 
 /*@interface AppDelegate : NSObject
@@ -89,6 +129,7 @@ IOSCanvas::IOSCanvas(const CanvasDescriptor& desc) :
 
 IOSCanvas::~IOSCanvas()
 {
+    StopFrameLoop();
 }
 
 void IOSCanvas::GetNativeHandle(void* nativeHandle) const
@@ -117,6 +158,56 @@ std::wstring IOSCanvas::GetTitle() const
     return L""; //todo...
 }
 
+bool IOSCanvas::StartFrameLoop()
+{
+    if (displayLink_ == nullptr)
+    {
+        /* Create display link that invokes the target once per display refresh on the main run loop */
+        displayLinkTarget_  = [[IOSCanvasDisplayLinkTarget alloc] initWithCanvas:this];
+        displayLink_        = [CADisplayLink displayLinkWithTarget:displayLinkTarget_ selector:@selector(onDisplayLink:)];
+        [displayLink_ retain];
+
+        SetPreferredFramesPerSecond(desc_.preferredFramesPerSecond);
+
+        [displayLink_ addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+    return true;
+}
+
+void IOSCanvas::StopFrameLoop()
+{
+    if (displayLink_ != nullptr)
+    {
+        /* Invalidating the display link removes it from all run loops and releases its target */
+        [displayLink_ invalidate];
+        [displayLink_ release];
+        [displayLinkTarget_ release];
+        displayLink_        = nullptr;
+        displayLinkTarget_  = nullptr;
+    }
+}
+
+void IOSCanvas::SetPreferredFramesPerSecond(std::uint32_t framesPerSecond)
+{
+    desc_.preferredFramesPerSecond = framesPerSecond;
+
+    if (displayLink_ == nullptr)
+        return;
+
+    if (@available(iOS 15.0, *))
+    {
+        /* Request a fixed frame rate range, so the frame times remain consistent on displays with variable refresh rates (ProMotion) */
+        const auto maxFramesPerSecond   = static_cast<float>([[UIScreen mainScreen] maximumFramesPerSecond]);
+        const auto preferredFrameRate   = (framesPerSecond > 0 ? std::min(static_cast<float>(framesPerSecond), maxFramesPerSecond) : maxFramesPerSecond);
+        displayLink_.preferredFrameRateRange = CAFrameRateRangeMake(preferredFrameRate, preferredFrameRate, preferredFrameRate);
+    }
+    else
+    {
+        /* Zero selects the native refresh rate of the display */
+        displayLink_.preferredFramesPerSecond = static_cast<NSInteger>(framesPerSecond);
+    }
+}
+
 
 /*
  * ======= Private: =======
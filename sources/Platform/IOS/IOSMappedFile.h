@@ -0,0 +1,48 @@
+/*
+ * IOSMappedFile.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IOS_MAPPED_FILE_H
+#define LLGL_IOS_MAPPED_FILE_H
+
+
+#include "../MappedFile.h"
+
+
+namespace LLGL
+{
+
+
+class IOSMappedFile : public MappedFile
+{
+
+    public:
+
+        IOSMappedFile(const std::string& filename);
+        ~IOSMappedFile();
+
+        IOSMappedFile(const IOSMappedFile&) = delete;
+        IOSMappedFile& operator = (const IOSMappedFile&) = delete;
+
+        const void* GetData() const override;
+        std::size_t GetSize() const override;
+
+    private:
+
+        void*       data_   = nullptr;
+        std::size_t size_   = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
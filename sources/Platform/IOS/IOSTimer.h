@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Timer.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -30,9 +31,11 @@ class IOSTimer : public Timer
         double GetFrequency() const override;
         
     private:
-    
-        //todo...
-    
+
+        std::uint64_t   numer_  = 1;
+        std::uint64_t   denom_  = 1;
+        std::uint64_t   t0_     = 0;
+
 };
     
     
@@ -6,6 +6,7 @@
  */
 
 #include "IOSTimer.h"
+#include <mach/mach_time.h>
 
 
 namespace LLGL
@@ -19,20 +20,29 @@ std::unique_ptr<Timer> Timer::Create()
 
 IOSTimer::IOSTimer()
 {
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    numer_ = timebase.numer;
+    denom_ = timebase.denom;
+    Start();
 }
 
 void IOSTimer::Start()
 {
+    t0_ = mach_absolute_time();
 }
 
 double IOSTimer::Stop()
 {
-    return 0.0;
+    /* Convert ticks to nanoseconds without overflowing the intermediate product */
+    const auto elapsedTicks = mach_absolute_time() - t0_;
+    const auto elapsedTime  = (elapsedTicks / denom_) * numer_ + (elapsedTicks % denom_) * numer_ / denom_;
+    return static_cast<double>(elapsedTime);
 }
 
 double IOSTimer::GetFrequency() const
 {
-    return 0.0;
+    return 1000000000.0;
 }
     
     
@@ -0,0 +1,90 @@
+/*
+ * LinuxAsyncFileRead.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "LinuxAsyncFileRead.h"
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace LLGL
+{
+
+
+std::unique_ptr<AsyncFileRead> AsyncFileRead::Start(const std::string& filename, std::uint64_t offset, std::size_t size, void* data)
+{
+    return std::unique_ptr<AsyncFileRead>(new LinuxAsyncFileRead(filename, offset, size, data));
+}
+
+LinuxAsyncFileRead::LinuxAsyncFileRead(const std::string& filename, std::uint64_t offset, std::size_t size, void* data)
+{
+    fd_ = open(filename.c_str(), O_RDONLY);
+    if (fd_ == -1)
+        throw std::runtime_error("failed to open file \"" + filename + "\"");
+
+    /* Enqueue read request; the file descriptor must remain open until the request has completed */
+    ::memset(&request_, 0, sizeof(request_));
+    {
+        request_.aio_fildes = fd_;
+        request_.aio_offset = static_cast<off_t>(offset);
+        request_.aio_buf    = data;
+        request_.aio_nbytes = size;
+    }
+
+    if (aio_read(&request_) != 0)
+    {
+        close(fd_);
+        throw std::runtime_error("failed to start asynchronous read of file \"" + filename + "\"");
+    }
+}
+
+LinuxAsyncFileRead::~LinuxAsyncFileRead()
+{
+    if (!completed_)
+    {
+        aio_cancel(fd_, &request_);
+        Complete();
+    }
+    close(fd_);
+}
+
+bool LinuxAsyncFileRead::Poll()
+{
+    return (completed_ || aio_error(&request_) != EINPROGRESS);
+}
+
+bool LinuxAsyncFileRead::Wait()
+{
+    Complete();
+    return (result_ >= 0 && static_cast<std::size_t>(result_) == request_.aio_nbytes);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void LinuxAsyncFileRead::Complete()
+{
+    if (!completed_)
+    {
+        const struct aiocb* requestList[] = { &request_ };
+        while (aio_error(&request_) == EINPROGRESS)
+            aio_suspend(requestList, 1, nullptr);
+        result_     = aio_return(&request_);
+        completed_  = true;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
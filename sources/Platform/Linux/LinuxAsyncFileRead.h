@@ -0,0 +1,54 @@
+/*
+ * LinuxAsyncFileRead.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_LINUX_ASYNC_FILE_READ_H
+#define LLGL_LINUX_ASYNC_FILE_READ_H
+
+
+#include "../AsyncFileRead.h"
+#include <aio.h>
+
+
+namespace LLGL
+{
+
+
+class LinuxAsyncFileRead : public AsyncFileRead
+{
+
+    public:
+
+        LinuxAsyncFileRead(const std::string& filename, std::uint64_t offset, std::size_t size, void* data);
+        ~LinuxAsyncFileRead();
+
+        LinuxAsyncFileRead(const LinuxAsyncFileRead&) = delete;
+        LinuxAsyncFileRead& operator = (const LinuxAsyncFileRead&) = delete;
+
+        bool Poll() override;
+        bool Wait() override;
+
+    private:
+
+        // Blocks until the request has completed, and retrieves its result exactly once.
+        void Complete();
+
+        int             fd_         = -1;
+        struct aiocb    request_;
+        bool            completed_  = false;
+        ssize_t         result_     = -1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
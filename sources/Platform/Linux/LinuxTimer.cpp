@@ -7,6 +7,7 @@
 
 #include "LinuxTimer.h"
 #include <algorithm>
+#include <time.h>
 
 
 namespace LLGL
@@ -18,22 +19,34 @@ std::unique_ptr<Timer> Timer::Create()
     return std::unique_ptr<Timer>(new LinuxTimer());
 }
 
+// Returns the current time (in nanoseconds) of the monotonic clock, which is unaffected by changes of the system time.
+static std::uint64_t GetMonotonicNanoseconds()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (static_cast<std::uint64_t>(t.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(t.tv_nsec));
+}
+
 LinuxTimer::LinuxTimer()
 {
+    Start();
 }
 
 void LinuxTimer::Start()
 {
+    t0_ = GetMonotonicNanoseconds();
 }
 
 double LinuxTimer::Stop()
 {
-    return 0.0;
+    /* Unsigned difference is correct even if the counter wraps around */
+    const auto elapsedTime = GetMonotonicNanoseconds() - t0_;
+    return static_cast<double>(elapsedTime);
 }
 
 double LinuxTimer::GetFrequency() const
 {
-    return 1000.0; //todo...
+    return 1000000000.0;
 }
 
 
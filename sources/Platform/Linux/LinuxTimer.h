@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Timer.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -29,6 +30,10 @@ class LinuxTimer : public Timer
 
         double GetFrequency() const override;
 
+    private:
+
+        std::uint64_t t0_ = 0;
+
 };
 
 
@@ -10,12 +10,33 @@
 #include "LinuxWindow.h"
 #include "MapKey.h"
 #include <exception>
+#include <poll.h>
+
+#ifdef LLGL_ENABLE_XINPUT2
+#   include <X11/extensions/XInput2.h>
+#endif
+
+#ifdef LLGL_ENABLE_WAYLAND
+#   include "WaylandWindow.h"
+#endif
 
 
 namespace LLGL
 {
 
 
+/*
+Xlib thread support must be enabled before any other Xlib call of the process, so it is enabled when the library is loaded
+instead of when the first window is opened. Returns true if Xlib thread support is enabled.
+*/
+static bool InitXlibThreads()
+{
+    static const bool threadsEnabled = (XInitThreads() != 0);
+    return threadsEnabled;
+}
+
+static const bool g_xlibThreadsEnabled = InitXlibThreads();
+
 static Point GetScreenCenteredPosition(const Size& size)
 {
     return (Desktop::GetResolution()/2 - size/2);
@@ -23,6 +44,10 @@ static Point GetScreenCenteredPosition(const Size& size)
 
 std::unique_ptr<Window> Window::Create(const WindowDescriptor& desc)
 {
+    #ifdef LLGL_ENABLE_WAYLAND
+    if (WaylandWindow::IsSessionAvailable())
+        return std::unique_ptr<Window>(new WaylandWindow(desc));
+    #endif
     return std::unique_ptr<Window>(new LinuxWindow(desc));
 }
 
@@ -34,6 +59,7 @@ LinuxWindow::LinuxWindow(const WindowDescriptor& desc) :
 
 LinuxWindow::~LinuxWindow()
 {
+    StopEventThread();
     XDestroyWindow(display_, wnd_);
     XCloseDisplay(display_);
 }
@@ -41,9 +67,11 @@ LinuxWindow::~LinuxWindow()
 void LinuxWindow::GetNativeHandle(void* nativeHandle) const
 {
     auto& handle = *reinterpret_cast<NativeHandle*>(nativeHandle);
-    handle.display  = display_;
-    handle.window   = wnd_;
-    handle.visual   = visual_;
+    handle.display      = display_;
+    handle.window       = wnd_;
+    handle.visual       = visual_;
+    handle.wlDisplay    = nullptr;
+    handle.wlSurface    = nullptr;
 }
 
 void LinuxWindow::Recreate()
@@ -115,6 +143,27 @@ WindowDescriptor LinuxWindow::GetDesc() const
     return desc_; //todo...
 }
 
+bool LinuxWindow::IsEventThreadSupported() const
+{
+    /* Displays of the application might have been opened before Xlib thread support was enabled, so only own displays are pumped on the event thread */
+    return (!foreignDisplay_ && g_xlibThreadsEnabled);
+}
+
+void LinuxWindow::OnWaitForEvents(std::uint32_t timeout)
+{
+    /* Wait for the X11 connection to become readable, unless events are already queued */
+    if (XPending(display_) == 0)
+    {
+        pollfd fd;
+        {
+            fd.fd       = ConnectionNumber(display_);
+            fd.events   = POLLIN;
+            fd.revents  = 0;
+        }
+        poll(&fd, 1, static_cast<int>(timeout));
+    }
+}
+
 void LinuxWindow::OnProcessEvents()
 {
     XEvent event;
@@ -140,6 +189,14 @@ void LinuxWindow::OnProcessEvents()
             case ButtonRelease:
                 ProcessMouseKeyEvent(event.xbutton, false);
                 break;
+
+            case MotionNotify:
+                ProcessMotionEvent(event.xmotion);
+                break;
+
+            case GenericEvent:
+                ProcessGenericEvent(event.xcookie);
+                break;
                 
             case ResizeRequest:
                 ProcessResizeRequestEvent(event.xresizerequest);
@@ -168,14 +225,16 @@ void LinuxWindow::OpenWindow()
     if (nativeHandle)
     {
         /* Get X11 display from context handle */
-        display_    = nativeHandle->display;
-        visual_     = nativeHandle->visual;
+        display_        = nativeHandle->display;
+        visual_         = nativeHandle->visual;
+        foreignDisplay_ = true;
     }
     else
     {
-        /* Open X11 display */
-        display_    = XOpenDisplay(nullptr);
-        visual_     = nullptr;
+        /* Open X11 display (thread support has already been enabled by the static initializer) */
+        display_        = XOpenDisplay(nullptr);
+        visual_         = nullptr;
+        foreignDisplay_ = false;
     }
 
     if (!display_)
@@ -248,6 +307,9 @@ void LinuxWindow::OpenWindow()
     /* Enable WM_DELETE_WINDOW protocol */
     closeWndAtom_ = XInternAtom(display_, "WM_DELETE_WINDOW", False); 
     XSetWMProtocols(display_, wnd_, &closeWndAtom_, 1);
+
+    /* Enable raw mouse motion events for high-resolution global motion */
+    EnableRawMotion();
 }
 
 void LinuxWindow::ProcessKeyEvent(XKeyEvent& event, bool down)
@@ -293,6 +355,80 @@ void LinuxWindow::ProcessClientMessage(XClientMessageEvent& event)
         PostQuit();
 }
 
+void LinuxWindow::ProcessMotionEvent(XMotionEvent& event)
+{
+    PostLocalMotion({ event.x, event.y });
+}
+
+void LinuxWindow::ProcessGenericEvent(XGenericEventCookie& cookie)
+{
+    #ifdef LLGL_ENABLE_XINPUT2
+
+    if (cookie.extension == xiOpcode_ && XGetEventData(display_, &cookie))
+    {
+        if (cookie.evtype == XI_RawMotion)
+        {
+            const auto& event = *reinterpret_cast<const XIRawEvent*>(cookie.data);
+
+            /* Read unaccelerated motion of the first two valuators (X and Y axes); values are only stored for valuators in the mask */
+            const double* value = event.raw_values;
+            for (int i = 0; i < 2 && i < event.valuators.mask_len * 8; ++i)
+            {
+                if (XIMaskIsSet(event.valuators.mask, i))
+                    rawMotion_[i] += *value++;
+            }
+
+            /* Post integral motion and keep the sub-pixel remainder for the next sample */
+            const int dx = static_cast<int>(rawMotion_[0]);
+            const int dy = static_cast<int>(rawMotion_[1]);
+
+            if (dx != 0 || dy != 0)
+            {
+                rawMotion_[0] -= dx;
+                rawMotion_[1] -= dy;
+                PostGlobalMotion({ dx, dy });
+            }
+        }
+        XFreeEventData(display_, &cookie);
+    }
+
+    #endif
+}
+
+void LinuxWindow::EnableRawMotion()
+{
+    #ifdef LLGL_ENABLE_XINPUT2
+
+    /* Query XInput extension and version 2.0 */
+    int event = 0, error = 0;
+    if (!XQueryExtension(display_, "XInputExtension", &xiOpcode_, &event, &error))
+    {
+        xiOpcode_ = -1;
+        return;
+    }
+
+    int major = 2, minor = 0;
+    if (XIQueryVersion(display_, &major, &minor) != Success)
+    {
+        xiOpcode_ = -1;
+        return;
+    }
+
+    /* Select raw motion events of all master devices; these are only delivered to the root window */
+    unsigned char mask[XIMaskLen(XI_RawMotion)] = {};
+    XISetMask(mask, XI_RawMotion);
+
+    XIEventMask eventMask;
+    {
+        eventMask.deviceid  = XIAllMasterDevices;
+        eventMask.mask_len  = sizeof(mask);
+        eventMask.mask      = mask;
+    }
+    XISelectEvents(display_, DefaultRootWindow(display_), &eventMask, 1);
+
+    #endif
+}
+
 void LinuxWindow::PostMouseKeyEvent(Key key, bool down)
 {
     if (down)
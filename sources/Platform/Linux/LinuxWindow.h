@@ -50,12 +50,19 @@ class LinuxWindow : public Window
 
         void OnProcessEvents() override;
 
+        bool IsEventThreadSupported() const override;
+        void OnWaitForEvents(std::uint32_t timeout) override;
+
         void OpenWindow();
 
         void ProcessKeyEvent(XKeyEvent& event, bool down);
         void ProcessMouseKeyEvent(XButtonEvent& event, bool down);
         void ProcessResizeRequestEvent(XResizeRequestEvent& event);
         void ProcessClientMessage(XClientMessageEvent& event);
+        void ProcessMotionEvent(XMotionEvent& event);
+        void ProcessGenericEvent(XGenericEventCookie& cookie);
+
+        void EnableRawMotion();
 
         void PostMouseKeyEvent(Key key, bool down);
         
@@ -66,9 +73,13 @@ class LinuxWindow : public Window
         ::Window            wnd_;
         //::Cursor            cursor_;
         XVisualInfo*        visual_         = nullptr;
+        bool                foreignDisplay_ = false;
         
         ::Atom              closeWndAtom_;
 
+        int                 xiOpcode_       = -1;
+        double              rawMotion_[2]   = { 0.0, 0.0 };
+
 };
 
 
@@ -8,6 +8,7 @@
 #include "MapKey.h"
 #include <map>
 #include <X11/Xutil.h>
+#include <linux/input.h>
 
 
 namespace LLGL
@@ -147,6 +148,134 @@ static std::map<KeySym, Key> GenerateLinuxKeyCodeMap()
 
 static std::map<KeySym, Key> linuxKeyCodeMap = GenerateLinuxKeyCodeMap();
 
+static std::map<std::uint32_t, Key> GenerateEvdevKeyCodeMap()
+{
+    return
+    {
+        KEYPAIR( KEY_BACKSPACE   , Back            ),
+        KEYPAIR( KEY_TAB         , Tab             ),
+        KEYPAIR( KEY_ENTER       , Return          ),
+        KEYPAIR( KEY_LEFTALT     , Menu            ),
+        KEYPAIR( KEY_PAUSE       , Pause           ),
+        KEYPAIR( KEY_CAPSLOCK    , Capital         ),
+        KEYPAIR( KEY_ESC         , Escape          ),
+        KEYPAIR( KEY_SPACE       , Space           ),
+        KEYPAIR( KEY_PAGEUP      , PageUp          ),
+        KEYPAIR( KEY_PAGEDOWN    , PageDown        ),
+        KEYPAIR( KEY_END         , End             ),
+        KEYPAIR( KEY_HOME        , Home            ),
+        KEYPAIR( KEY_LEFT        , Left            ),
+        KEYPAIR( KEY_UP          , Up              ),
+        KEYPAIR( KEY_RIGHT       , Right           ),
+        KEYPAIR( KEY_DOWN        , Down            ),
+        KEYPAIR( KEY_SYSRQ       , Snapshot        ),
+        KEYPAIR( KEY_INSERT      , Insert          ),
+        KEYPAIR( KEY_DELETE      , Delete          ),
+        KEYPAIR( KEY_HELP        , Help            ),
+    
+        KEYPAIR( KEY_0           , D0              ),
+        KEYPAIR( KEY_1           , D1              ),
+        KEYPAIR( KEY_2           , D2              ),
+        KEYPAIR( KEY_3           , D3              ),
+        KEYPAIR( KEY_4           , D4              ),
+        KEYPAIR( KEY_5           , D5              ),
+        KEYPAIR( KEY_6           , D6              ),
+        KEYPAIR( KEY_7           , D7              ),
+        KEYPAIR( KEY_8           , D8              ),
+        KEYPAIR( KEY_9           , D9              ),
+    
+        KEYPAIR( KEY_A           , A               ),
+        KEYPAIR( KEY_B           , B               ),
+        KEYPAIR( KEY_C           , C               ),
+        KEYPAIR( KEY_D           , D               ),
+        KEYPAIR( KEY_E           , E               ),
+        KEYPAIR( KEY_F           , F               ),
+        KEYPAIR( KEY_G           , G               ),
+        KEYPAIR( KEY_H           , H               ),
+        KEYPAIR( KEY_I           , I               ),
+        KEYPAIR( KEY_J           , J               ),
+        KEYPAIR( KEY_K           , K               ),
+        KEYPAIR( KEY_L           , L               ),
+        KEYPAIR( KEY_M           , M               ),
+        KEYPAIR( KEY_N           , N               ),
+        KEYPAIR( KEY_O           , O               ),
+        KEYPAIR( KEY_P           , P               ),
+        KEYPAIR( KEY_Q           , Q               ),
+        KEYPAIR( KEY_R           , R               ),
+        KEYPAIR( KEY_S           , S               ),
+        KEYPAIR( KEY_T           , T               ),
+        KEYPAIR( KEY_U           , U               ),
+        KEYPAIR( KEY_V           , V               ),
+        KEYPAIR( KEY_W           , W               ),
+        KEYPAIR( KEY_X           , X               ),
+        KEYPAIR( KEY_Y           , Y               ),
+        KEYPAIR( KEY_Z           , Z               ),
+    
+        KEYPAIR( KEY_LEFTMETA    , LWin            ),
+        KEYPAIR( KEY_RIGHTMETA   , RWin            ),
+    
+        KEYPAIR( KEY_KP0         , Keypad0         ),
+        KEYPAIR( KEY_KP1         , Keypad1         ),
+        KEYPAIR( KEY_KP2         , Keypad2         ),
+        KEYPAIR( KEY_KP3         , Keypad3         ),
+        KEYPAIR( KEY_KP4         , Keypad4         ),
+        KEYPAIR( KEY_KP5         , Keypad5         ),
+        KEYPAIR( KEY_KP6         , Keypad6         ),
+        KEYPAIR( KEY_KP7         , Keypad7         ),
+        KEYPAIR( KEY_KP8         , Keypad8         ),
+        KEYPAIR( KEY_KP9         , Keypad9         ),
+    
+        KEYPAIR( KEY_KPASTERISK  , KeypadMultiply  ),
+        KEYPAIR( KEY_KPPLUS      , KeypadPlus      ),
+        KEYPAIR( KEY_KPCOMMA     , KeypadSeparator ),
+        KEYPAIR( KEY_KPMINUS     , KeypadMinus     ),
+        KEYPAIR( KEY_KPDOT       , KeypadDecimal   ),
+        KEYPAIR( KEY_KPSLASH     , KeypadDivide    ),
+    
+        KEYPAIR( KEY_F1          , F1              ),
+        KEYPAIR( KEY_F2          , F2              ),
+        KEYPAIR( KEY_F3          , F3              ),
+        KEYPAIR( KEY_F4          , F4              ),
+        KEYPAIR( KEY_F5          , F5              ),
+        KEYPAIR( KEY_F6          , F6              ),
+        KEYPAIR( KEY_F7          , F7              ),
+        KEYPAIR( KEY_F8          , F8              ),
+        KEYPAIR( KEY_F9          , F9              ),
+        KEYPAIR( KEY_F10         , F10             ),
+        KEYPAIR( KEY_F11         , F11             ),
+        KEYPAIR( KEY_F12         , F12             ),
+        KEYPAIR( KEY_F13         , F13             ),
+        KEYPAIR( KEY_F14         , F14             ),
+        KEYPAIR( KEY_F15         , F15             ),
+        KEYPAIR( KEY_F16         , F16             ),
+        KEYPAIR( KEY_F17         , F17             ),
+        KEYPAIR( KEY_F18         , F18             ),
+        KEYPAIR( KEY_F19         , F19             ),
+        KEYPAIR( KEY_F20         , F20             ),
+        KEYPAIR( KEY_F21         , F21             ),
+        KEYPAIR( KEY_F22         , F22             ),
+        KEYPAIR( KEY_F23         , F23             ),
+        KEYPAIR( KEY_F24         , F24             ),
+    
+        KEYPAIR( KEY_NUMLOCK     , NumLock         ),
+        KEYPAIR( KEY_SCROLLLOCK  , ScrollLock      ),
+    
+        KEYPAIR( KEY_LEFTSHIFT   , LShift          ),
+        KEYPAIR( KEY_RIGHTSHIFT  , RShift          ),
+        KEYPAIR( KEY_LEFTCTRL    , LControl        ),
+        KEYPAIR( KEY_RIGHTCTRL   , RControl        ),
+        KEYPAIR( KEY_RIGHTALT    , RMenu           ),
+    
+        KEYPAIR( KEY_EQUAL       , Plus            ),
+        KEYPAIR( KEY_COMMA       , Comma           ),
+        KEYPAIR( KEY_MINUS       , Minus           ),
+        KEYPAIR( KEY_DOT         , Period          ),
+        KEYPAIR( KEY_GRAVE       , Exponent        ),
+    };
+};
+
+static std::map<std::uint32_t, Key> evdevKeyCodeMap = GenerateEvdevKeyCodeMap();
+
 #undef KEYPAIR
 
 
@@ -157,6 +286,12 @@ Key MapKey(XKeyEvent& keyEvent)
     return (it != linuxKeyCodeMap.end() ? it->second : Key::Pause);
 }
 
+Key MapEvdevKey(std::uint32_t keyCode)
+{
+    auto it = evdevKeyCodeMap.find(keyCode);
+    return (it != evdevKeyCodeMap.end() ? it->second : Key::Pause);
+}
+
 
 
 } // /namespace LLGL
@@ -11,6 +11,7 @@
 
 #include <LLGL/Key.h>
 #include <X11/Xlib.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -19,6 +20,9 @@ namespace LLGL
 
 Key MapKey(XKeyEvent& keyEvent);
 
+// Maps the specified Linux evdev key code (e.g. KEY_ESC), which is reported by Wayland keyboards, to a key.
+Key MapEvdevKey(std::uint32_t keyCode);
+
 
 } // /namespace LLGL
 
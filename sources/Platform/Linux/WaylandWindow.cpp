@@ -0,0 +1,621 @@
+/*
+ * WaylandWindow.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_ENABLE_WAYLAND
+
+
+#include <LLGL/Platform/NativeHandle.h>
+#include "WaylandWindow.h"
+#include "MapKey.h"
+#include "xdg-shell-client-protocol.h"
+#include "presentation-time-client-protocol.h"
+#include <linux/input.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <poll.h>
+#include <unistd.h>
+
+
+namespace LLGL
+{
+
+
+/* ----- Display connection ----- */
+
+/*
+All windows share the same connection to the compositor, so that the EGL displays of their render contexts are identical
+and OpenGL contexts can be shared between windows. Events of all windows are dispatched by whichever window processes events.
+*/
+
+static wl_display*  g_display           = nullptr;
+static std::size_t  g_displayRefCount   = 0;
+
+static wl_display* AcquireDisplay()
+{
+    if (g_displayRefCount == 0)
+    {
+        /* Connect to the Wayland compositor specified by WAYLAND_DISPLAY */
+        g_display = wl_display_connect(nullptr);
+        if (!g_display)
+            throw std::runtime_error("failed to connect to Wayland display");
+    }
+    ++g_displayRefCount;
+    return g_display;
+}
+
+static void ReleaseDisplay()
+{
+    if (g_displayRefCount > 0 && --g_displayRefCount == 0)
+    {
+        wl_display_disconnect(g_display);
+        g_display = nullptr;
+    }
+}
+
+
+/* ----- Listeners ----- */
+
+/*
+All interfaces are bound with version 1, so the listeners only need the callbacks of the first protocol version.
+Unspecified callbacks of later versions are initialized with null.
+*/
+
+static const wl_registry_listener g_registryListener =
+{
+    WaylandWindow::OnRegistryGlobal,
+    WaylandWindow::OnRegistryGlobalRemove,
+};
+
+static const xdg_wm_base_listener g_wmBaseListener =
+{
+    WaylandWindow::OnWmBasePing,
+};
+
+static const xdg_surface_listener g_xdgSurfaceListener =
+{
+    WaylandWindow::OnXdgSurfaceConfigure,
+};
+
+static const xdg_toplevel_listener g_toplevelListener =
+{
+    WaylandWindow::OnToplevelConfigure,
+    WaylandWindow::OnToplevelClose,
+};
+
+static const wl_seat_listener g_seatListener =
+{
+    WaylandWindow::OnSeatCapabilities,
+};
+
+static const wl_pointer_listener g_pointerListener =
+{
+    WaylandWindow::OnPointerEnter,
+    WaylandWindow::OnPointerLeave,
+    WaylandWindow::OnPointerMotion,
+    WaylandWindow::OnPointerButton,
+    WaylandWindow::OnPointerAxis,
+};
+
+static const wl_keyboard_listener g_keyboardListener =
+{
+    WaylandWindow::OnKeyboardKeymap,
+    WaylandWindow::OnKeyboardEnter,
+    WaylandWindow::OnKeyboardLeave,
+    WaylandWindow::OnKeyboardKey,
+    WaylandWindow::OnKeyboardModifiers,
+};
+
+static const wl_callback_listener g_frameListener =
+{
+    WaylandWindow::OnFrameDone,
+};
+
+static const wp_presentation_listener g_presentationListener =
+{
+    WaylandWindow::OnPresentationClockId,
+};
+
+static const wp_presentation_feedback_listener g_feedbackListener =
+{
+    WaylandWindow::OnFeedbackSyncOutput,
+    WaylandWindow::OnFeedbackPresented,
+    WaylandWindow::OnFeedbackDiscarded,
+};
+
+
+/* ----- WaylandWindow class ----- */
+
+WaylandWindow::WaylandWindow(const WindowDescriptor& desc) :
+    desc_ { desc }
+{
+    OpenWindow();
+}
+
+WaylandWindow::~WaylandWindow()
+{
+    CloseWindow();
+}
+
+void WaylandWindow::GetNativeHandle(void* nativeHandle) const
+{
+    auto& handle = *reinterpret_cast<NativeHandle*>(nativeHandle);
+    handle.display      = nullptr;
+    handle.window       = 0;
+    handle.visual       = nullptr;
+    handle.wlDisplay    = display_;
+    handle.wlSurface    = surface_;
+}
+
+void WaylandWindow::Recreate()
+{
+    //todo...
+}
+
+Size WaylandWindow::GetContentSize() const
+{
+    /* Return the size of the client area */
+    return GetSize(true);
+}
+
+void WaylandWindow::SetPosition(const Point& position)
+{
+    /* Wayland clients cannot position their toplevel surfaces, this is up to the compositor */
+    desc_.position = position;
+}
+
+Point WaylandWindow::GetPosition() const
+{
+    /* Wayland clients cannot query the position of their toplevel surfaces */
+    return desc_.position;
+}
+
+void WaylandWindow::SetSize(const Size& size, bool /*useClientArea*/)
+{
+    /* The surface size is determined by the buffers of the render context, so only the size hint of the window is stored */
+    if (desc_.size != size)
+    {
+        desc_.size = size;
+        PostResize(size);
+    }
+}
+
+Size WaylandWindow::GetSize(bool /*useClientArea*/) const
+{
+    /* Without server-side decorations, the window size is equal to the client area */
+    return desc_.size;
+}
+
+void WaylandWindow::SetTitle(const std::wstring& title)
+{
+    /* Convert UTF16 to UTF8 string and set window title */
+    desc_.title = title;
+    std::string s(title.begin(), title.end());
+    xdg_toplevel_set_title(toplevel_, s.c_str());
+}
+
+std::wstring WaylandWindow::GetTitle() const
+{
+    return desc_.title;
+}
+
+void WaylandWindow::Show(bool show)
+{
+    if (shown_ != show)
+    {
+        shown_ = show;
+        if (!show)
+        {
+            /* Unmap surface by committing a null buffer; the next presented frame maps the surface again */
+            wl_surface_attach(surface_, nullptr, 0, 0);
+            wl_surface_commit(surface_);
+            wl_display_flush(display_);
+        }
+    }
+}
+
+bool WaylandWindow::IsShown() const
+{
+    return shown_;
+}
+
+void WaylandWindow::SetDesc(const WindowDescriptor& desc)
+{
+    if (desc.title != desc_.title)
+        SetTitle(desc.title);
+    if (desc.size != desc_.size)
+        SetSize(desc.size);
+    if (desc.visible != shown_)
+        Show(desc.visible);
+}
+
+WindowDescriptor WaylandWindow::GetDesc() const
+{
+    auto desc = desc_;
+    desc.visible = shown_;
+    return desc;
+}
+
+/* ----- Presentation ----- */
+
+void WaylandWindow::PrepareSurfaceCommit()
+{
+    /* Request presentation feedback for the next commit; the feedback object is destroyed by its own listener */
+    if (presentation_ != nullptr)
+    {
+        auto feedback = wp_presentation_feedback(presentation_, surface_);
+        wp_presentation_feedback_add_listener(feedback, &g_feedbackListener, this);
+    }
+
+    /* Replace pending frame callback with the one of the next commit */
+    if (frameCallback_ != nullptr)
+        wl_callback_destroy(frameCallback_);
+
+    frameCallback_ = wl_surface_frame(surface_);
+    wl_callback_add_listener(frameCallback_, &g_frameListener, this);
+
+    /* Presenting a frame maps the surface */
+    shown_ = true;
+}
+
+bool WaylandWindow::QueryPresentationStatistics(FrameStatistics& stats)
+{
+    /* Dispatch the feedback events that have arrived so far, but don't wait for new ones */
+    DispatchEvents(0);
+
+    if (hasPresentStats_)
+    {
+        stats = presentStats_;
+        return true;
+    }
+
+    return false;
+}
+
+bool WaylandWindow::WaitForFrameCallback()
+{
+    /* Dispatch events until the compositor has signaled the frame callback of the last commit */
+    while (frameCallback_ != nullptr)
+    {
+        if (!DispatchEvents(-1))
+            return false;
+    }
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void WaylandWindow::OnProcessEvents()
+{
+    DispatchEvents(0);
+}
+
+void WaylandWindow::OnWaitForEvents(std::uint32_t timeout)
+{
+    DispatchEvents(static_cast<int>(timeout));
+}
+
+void WaylandWindow::OpenWindow()
+{
+    display_ = AcquireDisplay();
+
+    /* Bind global interfaces of the compositor */
+    registry_ = wl_display_get_registry(display_);
+    wl_registry_add_listener(registry_, &g_registryListener, this);
+    wl_display_roundtrip(display_);
+
+    if (!compositor_ || !wmBase_)
+        throw std::runtime_error("Wayland compositor does not support the xdg-shell protocol");
+
+    /* Create toplevel surface */
+    surface_    = wl_compositor_create_surface(compositor_);
+    xdgSurface_ = xdg_wm_base_get_xdg_surface(wmBase_, surface_);
+    xdg_surface_add_listener(xdgSurface_, &g_xdgSurfaceListener, this);
+
+    toplevel_ = xdg_surface_get_toplevel(xdgSurface_);
+    xdg_toplevel_add_listener(toplevel_, &g_toplevelListener, this);
+
+    /* Set title and size constraints before the initial commit */
+    SetTitle(desc_.title);
+
+    if (!desc_.resizable)
+    {
+        xdg_toplevel_set_min_size(toplevel_, desc_.size.x, desc_.size.y);
+        xdg_toplevel_set_max_size(toplevel_, desc_.size.x, desc_.size.y);
+    }
+
+    if (desc_.borderless)
+        xdg_toplevel_set_fullscreen(toplevel_, nullptr);
+
+    /* Commit surface without buffer and wait for the initial configure event */
+    wl_surface_commit(surface_);
+
+    while (!configured_)
+    {
+        if (wl_display_dispatch(display_) < 0)
+            throw std::runtime_error("failed to configure Wayland surface");
+    }
+
+    shown_ = desc_.visible;
+}
+
+void WaylandWindow::CloseWindow()
+{
+    if (frameCallback_)
+        wl_callback_destroy(frameCallback_);
+    if (toplevel_)
+        xdg_toplevel_destroy(toplevel_);
+    if (xdgSurface_)
+        xdg_surface_destroy(xdgSurface_);
+    if (surface_)
+        wl_surface_destroy(surface_);
+    if (pointer_)
+        wl_pointer_destroy(pointer_);
+    if (keyboard_)
+        wl_keyboard_destroy(keyboard_);
+    if (seat_)
+        wl_seat_destroy(seat_);
+    if (presentation_)
+        wp_presentation_destroy(presentation_);
+    if (wmBase_)
+        xdg_wm_base_destroy(wmBase_);
+    if (compositor_)
+        wl_compositor_destroy(compositor_);
+    if (registry_)
+        wl_registry_destroy(registry_);
+    if (display_)
+        ReleaseDisplay();
+}
+
+bool WaylandWindow::DispatchEvents(int timeout)
+{
+    /* Dispatch queued events first, since events may only be read from the display while the queue is empty */
+    while (wl_display_prepare_read(display_) != 0)
+    {
+        if (wl_display_dispatch_pending(display_) < 0)
+            return false;
+    }
+
+    wl_display_flush(display_);
+
+    pollfd fd;
+    {
+        fd.fd       = wl_display_get_fd(display_);
+        fd.events   = POLLIN;
+        fd.revents  = 0;
+    }
+
+    if (poll(&fd, 1, timeout) > 0)
+    {
+        if (wl_display_read_events(display_) < 0)
+            return false;
+    }
+    else
+        wl_display_cancel_read(display_);
+
+    return (wl_display_dispatch_pending(display_) >= 0);
+}
+
+/* ----- Listener callbacks ----- */
+
+void WaylandWindow::OnRegistryGlobal(void* data, wl_registry* registry, std::uint32_t name, const char* interface, std::uint32_t /*version*/)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+
+    if (std::strcmp(interface, wl_compositor_interface.name) == 0)
+    {
+        self->compositor_ = reinterpret_cast<wl_compositor*>(wl_registry_bind(registry, name, &wl_compositor_interface, 1));
+    }
+    else if (std::strcmp(interface, xdg_wm_base_interface.name) == 0)
+    {
+        self->wmBase_ = reinterpret_cast<xdg_wm_base*>(wl_registry_bind(registry, name, &xdg_wm_base_interface, 1));
+        xdg_wm_base_add_listener(self->wmBase_, &g_wmBaseListener, self);
+    }
+    else if (std::strcmp(interface, wl_seat_interface.name) == 0 && self->seat_ == nullptr)
+    {
+        self->seat_ = reinterpret_cast<wl_seat*>(wl_registry_bind(registry, name, &wl_seat_interface, 1));
+        wl_seat_add_listener(self->seat_, &g_seatListener, self);
+    }
+    else if (std::strcmp(interface, wp_presentation_interface.name) == 0)
+    {
+        self->presentation_ = reinterpret_cast<wp_presentation*>(wl_registry_bind(registry, name, &wp_presentation_interface, 1));
+        wp_presentation_add_listener(self->presentation_, &g_presentationListener, self);
+    }
+}
+
+void WaylandWindow::OnRegistryGlobalRemove(void* /*data*/, wl_registry* /*registry*/, std::uint32_t /*name*/)
+{
+    // dummy
+}
+
+void WaylandWindow::OnWmBasePing(void* /*data*/, xdg_wm_base* wmBase, std::uint32_t serial)
+{
+    /* Respond to the compositor, otherwise the window is considered unresponsive */
+    xdg_wm_base_pong(wmBase, serial);
+}
+
+void WaylandWindow::OnXdgSurfaceConfigure(void* data, xdg_surface* xdgSurface, std::uint32_t serial)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+    xdg_surface_ack_configure(xdgSurface, serial);
+    self->configured_ = true;
+}
+
+void WaylandWindow::OnToplevelConfigure(void* data, xdg_toplevel* /*toplevel*/, std::int32_t width, std::int32_t height, wl_array* /*states*/)
+{
+    /* A size of zero means the client can decide the size itself */
+    if (width > 0 && height > 0)
+    {
+        auto self = reinterpret_cast<WaylandWindow*>(data);
+        self->SetSize({ width, height });
+    }
+}
+
+void WaylandWindow::OnToplevelClose(void* data, xdg_toplevel* /*toplevel*/)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+    self->PostQuit();
+}
+
+void WaylandWindow::OnSeatCapabilities(void* data, wl_seat* seat, std::uint32_t capabilities)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+
+    if ((capabilities & WL_SEAT_CAPABILITY_POINTER) != 0 && self->pointer_ == nullptr)
+    {
+        self->pointer_ = wl_seat_get_pointer(seat);
+        wl_pointer_add_listener(self->pointer_, &g_pointerListener, self);
+    }
+
+    if ((capabilities & WL_SEAT_CAPABILITY_KEYBOARD) != 0 && self->keyboard_ == nullptr)
+    {
+        self->keyboard_ = wl_seat_get_keyboard(seat);
+        wl_keyboard_add_listener(self->keyboard_, &g_keyboardListener, self);
+    }
+}
+
+void WaylandWindow::OnPointerEnter(void* data, wl_pointer* /*pointer*/, std::uint32_t /*serial*/, wl_surface* /*surface*/, wl_fixed_t x, wl_fixed_t y)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+    self->PostLocalMotion({ wl_fixed_to_int(x), wl_fixed_to_int(y) });
+}
+
+void WaylandWindow::OnPointerLeave(void* /*data*/, wl_pointer* /*pointer*/, std::uint32_t /*serial*/, wl_surface* /*surface*/)
+{
+    // dummy
+}
+
+void WaylandWindow::OnPointerMotion(void* data, wl_pointer* /*pointer*/, std::uint32_t /*time*/, wl_fixed_t x, wl_fixed_t y)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+    self->PostLocalMotion({ wl_fixed_to_int(x), wl_fixed_to_int(y) });
+}
+
+void WaylandWindow::OnPointerButton(void* data, wl_pointer* /*pointer*/, std::uint32_t /*serial*/, std::uint32_t /*time*/, std::uint32_t button, std::uint32_t state)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+
+    Key key;
+    switch (button)
+    {
+        case BTN_LEFT:      key = Key::LButton; break;
+        case BTN_RIGHT:     key = Key::RButton; break;
+        case BTN_MIDDLE:    key = Key::MButton; break;
+        case BTN_SIDE:      key = Key::XButton1; break;
+        case BTN_EXTRA:     key = Key::XButton2; break;
+        default:            return;
+    }
+
+    if (state == WL_POINTER_BUTTON_STATE_PRESSED)
+        self->PostKeyDown(key);
+    else
+        self->PostKeyUp(key);
+}
+
+void WaylandWindow::OnPointerAxis(void* data, wl_pointer* /*pointer*/, std::uint32_t /*time*/, std::uint32_t axis, wl_fixed_t value)
+{
+    /* Positive values of the vertical axis scroll down, which is a negative wheel motion */
+    if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL)
+    {
+        auto self = reinterpret_cast<WaylandWindow*>(data);
+        auto motion = wl_fixed_to_double(value);
+        if (motion != 0.0)
+            self->PostWheelMotion(motion > 0.0 ? -1 : 1);
+    }
+}
+
+void WaylandWindow::OnKeyboardKeymap(void* /*data*/, wl_keyboard* /*keyboard*/, std::uint32_t /*format*/, std::int32_t fd, std::uint32_t /*size*/)
+{
+    /* Keys are mapped by their evdev key codes, so the keymap is not required */
+    close(fd);
+}
+
+void WaylandWindow::OnKeyboardEnter(void* /*data*/, wl_keyboard* /*keyboard*/, std::uint32_t /*serial*/, wl_surface* /*surface*/, wl_array* /*keys*/)
+{
+    // dummy
+}
+
+void WaylandWindow::OnKeyboardLeave(void* /*data*/, wl_keyboard* /*keyboard*/, std::uint32_t /*serial*/, wl_surface* /*surface*/)
+{
+    // dummy
+}
+
+void WaylandWindow::OnKeyboardKey(void* data, wl_keyboard* /*keyboard*/, std::uint32_t /*serial*/, std::uint32_t /*time*/, std::uint32_t key, std::uint32_t state)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+    if (state == WL_KEYBOARD_KEY_STATE_PRESSED)
+        self->PostKeyDown(MapEvdevKey(key));
+    else
+        self->PostKeyUp(MapEvdevKey(key));
+}
+
+void WaylandWindow::OnKeyboardModifiers(
+    void* /*data*/, wl_keyboard* /*keyboard*/, std::uint32_t /*serial*/, std::uint32_t /*depressed*/, std::uint32_t /*latched*/, std::uint32_t /*locked*/, std::uint32_t /*group*/)
+{
+    // dummy
+}
+
+void WaylandWindow::OnFrameDone(void* data, wl_callback* callback, std::uint32_t /*time*/)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+    if (self->frameCallback_ == callback)
+        self->frameCallback_ = nullptr;
+    wl_callback_destroy(callback);
+}
+
+void WaylandWindow::OnPresentationClockId(void* /*data*/, wp_presentation* /*presentation*/, std::uint32_t /*clockId*/)
+{
+    // dummy
+}
+
+void WaylandWindow::OnFeedbackSyncOutput(void* /*data*/, struct wp_presentation_feedback* /*feedback*/, wl_output* /*output*/)
+{
+    // dummy
+}
+
+void WaylandWindow::OnFeedbackPresented(
+    void*                             data,
+    struct wp_presentation_feedback*  feedback,
+    std::uint32_t                     secondsHi,
+    std::uint32_t                     secondsLo,
+    std::uint32_t                     nanoseconds,
+    std::uint32_t                     /*refresh*/,
+    std::uint32_t                     sequenceHi,
+    std::uint32_t                     sequenceLo,
+    std::uint32_t                     /*flags*/)
+{
+    auto self = reinterpret_cast<WaylandWindow*>(data);
+
+    /* Convert timestamp of the presentation clock into microseconds */
+    const auto seconds = ((static_cast<std::uint64_t>(secondsHi) << 32) | secondsLo);
+
+    self->presentStats_.presentCount++;
+    self->presentStats_.syncRefreshCount    = ((static_cast<std::uint64_t>(sequenceHi) << 32) | sequenceLo);
+    self->presentStats_.syncTime            = seconds * 1000000ull + nanoseconds / 1000u;
+    self->hasPresentStats_                  = true;
+
+    wp_presentation_feedback_destroy(feedback);
+}
+
+void WaylandWindow::OnFeedbackDiscarded(void* /*data*/, struct wp_presentation_feedback* feedback)
+{
+    /* Frame has been replaced by a later commit before it was presented */
+    wp_presentation_feedback_destroy(feedback);
+}
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_ENABLE_WAYLAND
+
+
+
+// ================================================================================
@@ -0,0 +1,174 @@
+/*
+ * WaylandWindow.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_WAYLAND_WINDOW_H
+#define LLGL_WAYLAND_WINDOW_H
+
+
+#ifdef LLGL_ENABLE_WAYLAND
+
+
+#include <LLGL/Window.h>
+#include <LLGL/RenderContextDescriptor.h>
+#include <wayland-client.h>
+#include <cstdlib>
+
+
+struct xdg_wm_base;
+struct xdg_surface;
+struct xdg_toplevel;
+struct wp_presentation;
+struct wp_presentation_feedback;
+
+namespace LLGL
+{
+
+
+/*
+Window for Wayland compositors with the xdg-shell protocol. The surface has no buffer until the first frame is presented by the render context (e.g. with eglSwapBuffers).
+The presentation timing is reported by the presentation-time protocol (wp_presentation) and frames are paced with the frame callbacks of the surface.
+*/
+class WaylandWindow : public Window
+{
+
+    public:
+
+        WaylandWindow(const WindowDescriptor& desc);
+        ~WaylandWindow();
+
+        // Returns true if a Wayland compositor is available, i.e. the WAYLAND_DISPLAY environment variable is set.
+        static inline bool IsSessionAvailable()
+        {
+            return (std::getenv("WAYLAND_DISPLAY") != nullptr);
+        }
+
+        void GetNativeHandle(void* nativeHandle) const override;
+
+        void Recreate() override;
+
+        Size GetContentSize() const override;
+
+        void SetPosition(const Point& position) override;
+        Point GetPosition() const override;
+
+        void SetSize(const Size& size, bool useClientArea = true) override;
+        Size GetSize(bool useClientArea = true) const override;
+
+        void SetTitle(const std::wstring& title) override;
+        std::wstring GetTitle() const override;
+
+        void Show(bool show = true) override;
+        bool IsShown() const override;
+
+        void SetDesc(const WindowDescriptor& desc) override;
+        WindowDescriptor GetDesc() const override;
+
+        /* ----- Presentation ----- */
+
+        /*
+        Requests a presentation feedback and a frame callback for the next surface commit.
+        This must be called by the render context immediately before the back buffer is presented (e.g. with eglSwapBuffers).
+        */
+        void PrepareSurfaceCommit();
+
+        // Returns the statistics of the most recently presented frame, or false if no frame has been presented yet or wp_presentation is not supported.
+        bool QueryPresentationStatistics(FrameStatistics& stats);
+
+        // Blocks until the compositor signals with the frame callback of the last surface commit that a new frame should be drawn.
+        bool WaitForFrameCallback();
+
+        /* ----- Listener callbacks ----- */
+
+        // Callbacks of the listeners for the Wayland protocol objects; the user data is always the WaylandWindow instance.
+
+        static void OnRegistryGlobal(void* data, wl_registry* registry, std::uint32_t name, const char* interface, std::uint32_t version);
+        static void OnRegistryGlobalRemove(void* data, wl_registry* registry, std::uint32_t name);
+
+        static void OnWmBasePing(void* data, xdg_wm_base* wmBase, std::uint32_t serial);
+        static void OnXdgSurfaceConfigure(void* data, xdg_surface* xdgSurface, std::uint32_t serial);
+        static void OnToplevelConfigure(void* data, xdg_toplevel* toplevel, std::int32_t width, std::int32_t height, wl_array* states);
+        static void OnToplevelClose(void* data, xdg_toplevel* toplevel);
+
+        static void OnSeatCapabilities(void* data, wl_seat* seat, std::uint32_t capabilities);
+
+        static void OnPointerEnter(void* data, wl_pointer* pointer, std::uint32_t serial, wl_surface* surface, wl_fixed_t x, wl_fixed_t y);
+        static void OnPointerLeave(void* data, wl_pointer* pointer, std::uint32_t serial, wl_surface* surface);
+        static void OnPointerMotion(void* data, wl_pointer* pointer, std::uint32_t time, wl_fixed_t x, wl_fixed_t y);
+        static void OnPointerButton(void* data, wl_pointer* pointer, std::uint32_t serial, std::uint32_t time, std::uint32_t button, std::uint32_t state);
+        static void OnPointerAxis(void* data, wl_pointer* pointer, std::uint32_t time, std::uint32_t axis, wl_fixed_t value);
+
+        static void OnKeyboardKeymap(void* data, wl_keyboard* keyboard, std::uint32_t format, std::int32_t fd, std::uint32_t size);
+        static void OnKeyboardEnter(void* data, wl_keyboard* keyboard, std::uint32_t serial, wl_surface* surface, wl_array* keys);
+        static void OnKeyboardLeave(void* data, wl_keyboard* keyboard, std::uint32_t serial, wl_surface* surface);
+        static void OnKeyboardKey(void* data, wl_keyboard* keyboard, std::uint32_t serial, std::uint32_t time, std::uint32_t key, std::uint32_t state);
+        static void OnKeyboardModifiers(void* data, wl_keyboard* keyboard, std::uint32_t serial, std::uint32_t depressed, std::uint32_t latched, std::uint32_t locked, std::uint32_t group);
+
+        static void OnFrameDone(void* data, wl_callback* callback, std::uint32_t time);
+
+        static void OnPresentationClockId(void* data, wp_presentation* presentation, std::uint32_t clockId);
+        static void OnFeedbackSyncOutput(void* data, struct wp_presentation_feedback* feedback, wl_output* output);
+        static void OnFeedbackPresented(
+            void*                             data,
+            struct wp_presentation_feedback*  feedback,
+            std::uint32_t                     secondsHi,
+            std::uint32_t                     secondsLo,
+            std::uint32_t                     nanoseconds,
+            std::uint32_t                     refresh,
+            std::uint32_t                     sequenceHi,
+            std::uint32_t                     sequenceLo,
+            std::uint32_t                     flags
+        );
+        static void OnFeedbackDiscarded(void* data, struct wp_presentation_feedback* feedback);
+
+    private:
+
+        void OnProcessEvents() override;
+
+        void OnWaitForEvents(std::uint32_t timeout) override;
+
+        void OpenWindow();
+        void CloseWindow();
+
+        // Reads and dispatches the events of the display, and waits up to 'timeout' milliseconds for new events (or infinitely if negative).
+        bool DispatchEvents(int timeout);
+
+        WindowDescriptor    desc_;
+
+        wl_display*         display_            = nullptr;
+        wl_registry*        registry_           = nullptr;
+        wl_compositor*      compositor_         = nullptr;
+        xdg_wm_base*        wmBase_             = nullptr;
+        wl_seat*            seat_               = nullptr;
+        wl_pointer*         pointer_            = nullptr;
+        wl_keyboard*        keyboard_           = nullptr;
+        wp_presentation*    presentation_       = nullptr;
+
+        wl_surface*         surface_            = nullptr;
+        xdg_surface*        xdgSurface_         = nullptr;
+        xdg_toplevel*       toplevel_           = nullptr;
+
+        bool                configured_         = false;
+        bool                shown_              = false;
+
+        wl_callback*        frameCallback_      = nullptr;  // pending frame callback of the last surface commit
+        FrameStatistics     presentStats_;                  // statistics of the most recently presented frame
+        bool                hasPresentStats_    = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_ENABLE_WAYLAND
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,58 @@
+/*
+ * MappedFile.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MAPPED_FILE_H
+#define LLGL_MAPPED_FILE_H
+
+
+#include <memory>
+#include <string>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+//! Read-only memory-mapped file (to access large files without copying them into a buffer first)
+class MappedFile
+{
+
+    public:
+
+        MappedFile() = default;
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator = (const MappedFile&) = delete;
+
+        virtual ~MappedFile()
+        {
+        }
+
+        /**
+        \brief Opens the specified file and maps its entire content into memory.
+        \throws std::runtime_error If the file could not be opened, is empty, or could not be mapped.
+        */
+        static std::unique_ptr<MappedFile> Open(const std::string& filename);
+
+        //! Returns a pointer to the mapped file content.
+        virtual const void* GetData() const = 0;
+
+        //! Returns the size (in bytes) of the mapped file content.
+        virtual std::size_t GetSize() const = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -42,7 +42,10 @@ class Module
         //! Converts the module name into a specific filename (e.g. "OpenGL" to "LLGL_OpenGL.dll" on Windows).
         static std::string GetModuleFilename(std::string moduleName);
 
-        //! Returns true if the specified module is available.
+        /**
+        \brief Returns true if the specified module is available.
+        \remarks This might only check if the module file exists, i.e. loading the module can still fail.
+        */
         static bool IsAvailable(const std::string& moduleFilename);
 
         //! Returns the specified module or null if it is not available.
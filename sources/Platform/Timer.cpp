@@ -6,12 +6,99 @@
  */
 
 #include <LLGL/Timer.h>
+#include <algorithm>
+#include <cmath>
 
 
 namespace LLGL
 {
 
 
+/* ----- FrameTimeHistory class ----- */
+
+FrameTimeHistory::FrameTimeHistory(std::size_t capacity) :
+    frameTimes_ ( std::max<std::size_t>(1, capacity), 0.0 )
+{
+}
+
+void FrameTimeHistory::Push(double frameTime)
+{
+    frameTimes_[next_] = frameTime;
+    next_ = (next_ + 1) % frameTimes_.size();
+    numFrames_ = std::min(numFrames_ + 1, frameTimes_.size());
+}
+
+void FrameTimeHistory::Clear()
+{
+    next_       = 0;
+    numFrames_  = 0;
+}
+
+void FrameTimeHistory::Resize(std::size_t capacity)
+{
+    frameTimes_.assign(std::max<std::size_t>(1, capacity), 0.0);
+    sorted_.clear();
+    Clear();
+}
+
+// Returns the index of the specified percentile within the sorted frame times (nearest-rank method).
+static std::size_t PercentileIndex(double percentile, std::size_t numFrames)
+{
+    const auto p    = std::max(0.0, std::min(percentile, 100.0));
+    const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(numFrames)));
+    return (rank > 0 ? rank - 1 : 0);
+}
+
+double FrameTimeHistory::GetPercentile(double percentile) const
+{
+    if (numFrames_ == 0)
+        return 0.0;
+    const auto& sorted = SortFrameTimes();
+    return sorted[PercentileIndex(percentile, numFrames_)];
+}
+
+FrameTimeStatistics FrameTimeHistory::GetStatistics() const
+{
+    FrameTimeStatistics stats;
+
+    if (numFrames_ > 0)
+    {
+        const auto& sorted = SortFrameTimes();
+
+        double sum = 0.0;
+        for (auto t : sorted)
+            sum += t;
+
+        stats.numFrames     = numFrames_;
+        stats.minTime       = sorted.front();
+        stats.maxTime       = sorted.back();
+        stats.averageTime   = sum / static_cast<double>(numFrames_);
+        stats.medianTime    = sorted[PercentileIndex(50.0, numFrames_)];
+        stats.p95Time       = sorted[PercentileIndex(95.0, numFrames_)];
+        stats.p99Time       = sorted[PercentileIndex(99.0, numFrames_)];
+    }
+
+    return stats;
+}
+
+double FrameTimeHistory::GetLatest() const
+{
+    if (numFrames_ == 0)
+        return 0.0;
+    return frameTimes_[(next_ + frameTimes_.size() - 1) % frameTimes_.size()];
+}
+
+const std::vector<double>& FrameTimeHistory::SortFrameTimes() const
+{
+    /* Recorded frame times are the first entries until the ring buffer has wrapped around */
+    sorted_.assign(frameTimes_.begin(), frameTimes_.begin() + numFrames_);
+    std::sort(sorted_.begin(), sorted_.end());
+    return sorted_;
+}
+
+
+/* ----- Timer class ----- */
+
 Timer::~Timer()
 {
 }
@@ -22,10 +109,22 @@ void Timer::MeasureTime()
     Start();
 
     deltaTime_ = elapsed / GetFrequency();
+    cpuFrameTimes_.Push(deltaTime_);
 
     ++frameCount_;
 }
 
+void Timer::MeasureGPUTime(double gpuTime)
+{
+    gpuFrameTimes_.Push(gpuTime);
+}
+
+void Timer::SetFrameHistorySize(std::size_t numFrames)
+{
+    cpuFrameTimes_.Resize(numFrames);
+    gpuFrameTimes_.Resize(numFrames);
+}
+
 void Timer::ResetFrameCounter()
 {
     frameCount_ = 0;
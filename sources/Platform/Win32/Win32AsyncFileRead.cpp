@@ -0,0 +1,93 @@
+/*
+ * Win32AsyncFileRead.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Win32AsyncFileRead.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+std::unique_ptr<AsyncFileRead> AsyncFileRead::Start(const std::string& filename, std::uint64_t offset, std::size_t size, void* data)
+{
+    return std::unique_ptr<AsyncFileRead>(new Win32AsyncFileRead(filename, offset, size, data));
+}
+
+Win32AsyncFileRead::Win32AsyncFileRead(const std::string& filename, std::uint64_t offset, std::size_t size, void* data) :
+    size_ { static_cast<DWORD>(size) }
+{
+    if (size > MAXDWORD)
+        throw std::runtime_error("asynchronous file read exceeds limit of 4 GB");
+
+    file_ = CreateFileA(
+        filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr
+    );
+
+    if (file_ == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("failed to open file \"" + filename + "\"");
+
+    /* Start overlapped read; the file handle must remain open until the request has completed */
+    ZeroMemory(&overlapped_, sizeof(overlapped_));
+    {
+        overlapped_.Offset      = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped_.OffsetHigh  = static_cast<DWORD>(offset >> 32);
+        overlapped_.hEvent      = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+    }
+
+    if (!ReadFile(file_, data, size_, nullptr, &overlapped_) && GetLastError() != ERROR_IO_PENDING)
+    {
+        CloseHandle(overlapped_.hEvent);
+        CloseHandle(file_);
+        throw std::runtime_error("failed to start asynchronous read of file \"" + filename + "\"");
+    }
+}
+
+Win32AsyncFileRead::~Win32AsyncFileRead()
+{
+    if (!completed_)
+    {
+        CancelIoEx(file_, &overlapped_);
+        Complete();
+    }
+    CloseHandle(overlapped_.hEvent);
+    CloseHandle(file_);
+}
+
+bool Win32AsyncFileRead::Poll()
+{
+    return (completed_ || HasOverlappedIoCompleted(&overlapped_));
+}
+
+bool Win32AsyncFileRead::Wait()
+{
+    Complete();
+    return succeeded_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void Win32AsyncFileRead::Complete()
+{
+    if (!completed_)
+    {
+        DWORD numBytesRead = 0;
+        succeeded_ = (GetOverlappedResult(file_, &overlapped_, &numBytesRead, TRUE) && numBytesRead == size_);
+        completed_ = true;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
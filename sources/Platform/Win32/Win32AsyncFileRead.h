@@ -0,0 +1,56 @@
+/*
+ * Win32AsyncFileRead.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_WIN32_ASYNC_FILE_READ_H
+#define LLGL_WIN32_ASYNC_FILE_READ_H
+
+
+#include "../AsyncFileRead.h"
+
+#include <Windows.h>
+
+
+namespace LLGL
+{
+
+
+class Win32AsyncFileRead : public AsyncFileRead
+{
+
+    public:
+
+        Win32AsyncFileRead(const std::string& filename, std::uint64_t offset, std::size_t size, void* data);
+        ~Win32AsyncFileRead();
+
+        Win32AsyncFileRead(const Win32AsyncFileRead&) = delete;
+        Win32AsyncFileRead& operator = (const Win32AsyncFileRead&) = delete;
+
+        bool Poll() override;
+        bool Wait() override;
+
+    private:
+
+        // Blocks until the request has completed, and retrieves its result exactly once.
+        void Complete();
+
+        HANDLE      file_       = INVALID_HANDLE_VALUE;
+        OVERLAPPED  overlapped_;
+        DWORD       size_       = 0;
+        bool        completed_  = false;
+        bool        succeeded_  = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
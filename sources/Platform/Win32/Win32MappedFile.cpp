@@ -0,0 +1,75 @@
+/*
+ * Win32MappedFile.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Win32MappedFile.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+std::unique_ptr<MappedFile> MappedFile::Open(const std::string& filename)
+{
+    return std::unique_ptr<MappedFile>(new Win32MappedFile(filename));
+}
+
+Win32MappedFile::Win32MappedFile(const std::string& filename)
+{
+    /* Open file and determine its size */
+    HANDLE file = CreateFileA(
+        filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("failed to open file \"" + filename + "\"");
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("failed to map empty file \"" + filename + "\"");
+    }
+
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+
+    /* Map entire file into memory; the view keeps the file mapping alive after its handles are closed */
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (!mapping)
+        throw std::runtime_error("failed to create file mapping for \"" + filename + "\"");
+
+    view_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (!view_)
+        throw std::runtime_error("failed to map file \"" + filename + "\" into memory");
+}
+
+Win32MappedFile::~Win32MappedFile()
+{
+    UnmapViewOfFile(view_);
+}
+
+const void* Win32MappedFile::GetData() const
+{
+    return view_;
+}
+
+std::size_t Win32MappedFile::GetSize() const
+{
+    return size_;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -39,14 +39,8 @@ static HMODULE LoadLibrarySafe(LPCSTR filename)
 
 bool Module::IsAvailable(const std::string& moduleFilename)
 {
-    /* Check if Win32 dynamic link library can be loaded properly */
-    auto handle = LoadLibrarySafe(moduleFilename.c_str());
-    if (handle)
-    {
-        FreeLibrary(handle);
-        return true;
-    }
-    return false;
+    /* Only search for the Win32 dynamic link library in the search paths, since loading the library is expensive */
+    return (SearchPathA(nullptr, moduleFilename.c_str(), nullptr, 0, nullptr, nullptr) > 0);
 }
 
 std::unique_ptr<Module> Module::Load(const std::string& moduleFilename)
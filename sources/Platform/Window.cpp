@@ -6,7 +6,9 @@
  */
 
 #include <LLGL/Window.h>
+#include "WindowEventQueue.h"
 #include "../Core/Helper.h"
+#include <chrono>
 
 
 namespace LLGL
@@ -80,8 +82,32 @@ void Window::EventListener::OnTimer(Window& sender, unsigned int timerID)
 #define FOREACH_LISTENER_CALL(FUNC) \
     for (const auto& lst : eventListeners_) { lst->FUNC; }
 
+// Returns the current time (in nanoseconds) of the monotonic clock.
+static std::uint64_t GetEventTime()
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+    );
+}
+
+// Returns a new window event of the specified type, which is time-stamped with the current time.
+static WindowEvent MakeEvent(const WindowEventType type)
+{
+    WindowEvent event;
+    {
+        event.type      = type;
+        event.timestamp = GetEventTime();
+    }
+    return event;
+}
+
+Window::Window()
+{
+}
+
 Window::~Window()
 {
+    StopEventThread();
 }
 
 #ifdef LLGL_MOBILE_PLATFORM
@@ -128,11 +154,59 @@ bool Window::ProcessEvents()
 {
     FOREACH_LISTENER_CALL( OnProcessEvents(*this) );
 
-    OnProcessEvents();
+    if (eventThread_)
+    {
+        /* Dispatch all events the event thread has queued since the last call */
+        DispatchQueuedEvents();
+    }
+    else
+        OnProcessEvents();
 
     return (!quit_);
 }
 
+bool Window::StartEventThread()
+{
+    if (eventThread_)
+        return true;
+
+    if (!IsEventThreadSupported())
+        return false;
+
+    eventThread_ = MakeUnique<WindowEventThread>();
+    eventThread_->thread = std::thread(
+        [this]()
+        {
+            /* Publish own ID before any event is posted, so EnqueueEvent never reads the thread object while it is being assigned */
+            eventThread_->threadID.store(std::this_thread::get_id());
+            while (!eventThread_->quit.load())
+            {
+                OnWaitForEvents(10);
+                OnProcessEvents();
+            }
+        }
+    );
+
+    return true;
+}
+
+void Window::StopEventThread()
+{
+    if (eventThread_)
+    {
+        /* Join thread before the remaining events are dispatched */
+        eventThread_->quit.store(true);
+        eventThread_->thread.join();
+        DispatchQueuedEvents();
+        eventThread_.reset();
+    }
+}
+
+bool Window::HasEventThread() const
+{
+    return (eventThread_ != nullptr);
+}
+
 /* --- Event handling --- */
 
 void Window::AddEventListener(const std::shared_ptr<EventListener>& eventListener)
@@ -147,57 +221,170 @@ void Window::RemoveEventListener(const EventListener* eventListener)
 
 void Window::PostKeyDown(Key keyCode)
 {
-    FOREACH_LISTENER_CALL( OnKeyDown(*this, keyCode) );
+    auto event = MakeEvent(WindowEventType::KeyDown);
+    event.keyCode = keyCode;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
 }
 
 void Window::PostKeyUp(Key keyCode)
 {
-    FOREACH_LISTENER_CALL( OnKeyUp(*this, keyCode) );
+    auto event = MakeEvent(WindowEventType::KeyUp);
+    event.keyCode = keyCode;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
 }
 
 void Window::PostDoubleClick(Key keyCode)
 {
-    FOREACH_LISTENER_CALL( OnDoubleClick(*this, keyCode) );
+    auto event = MakeEvent(WindowEventType::DoubleClick);
+    event.keyCode = keyCode;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
 }
 
 void Window::PostChar(wchar_t chr)
 {
-    FOREACH_LISTENER_CALL( OnChar(*this, chr) );
+    auto event = MakeEvent(WindowEventType::Char);
+    event.chr = chr;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
 }
 
 void Window::PostWheelMotion(int motion)
 {
-    FOREACH_LISTENER_CALL( OnWheelMotion(*this, motion) );
+    auto event = MakeEvent(WindowEventType::WheelMotion);
+    event.motion = motion;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
 }
 
 void Window::PostLocalMotion(const Point& position)
 {
-    FOREACH_LISTENER_CALL( OnLocalMotion(*this, position) );
+    auto event = MakeEvent(WindowEventType::LocalMotion);
+    event.point = position;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
 }
 
 void Window::PostGlobalMotion(const Point& motion)
 {
-    FOREACH_LISTENER_CALL( OnGlobalMotion(*this, motion) );
+    auto event = MakeEvent(WindowEventType::GlobalMotion);
+    event.point = motion;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
 }
 
 void Window::PostResize(const Size& clientAreaSize)
 {
-    FOREACH_LISTENER_CALL( OnResize(*this, clientAreaSize) );
+    auto event = MakeEvent(WindowEventType::Resize);
+    event.point = clientAreaSize;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
 }
 
 void Window::PostQuit()
 {
-    for (const auto& lst : eventListeners_)
+    auto event = MakeEvent(WindowEventType::Quit);
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
+}
+
+void Window::PostTimer(unsigned int timerID)
+{
+    auto event = MakeEvent(WindowEventType::Timer);
+    event.timerID = timerID;
+    if (!EnqueueEvent(event))
+        DispatchEvent(event);
+}
+
+
+
+/*
+ * ======= Protected: =======
+ */
+
+bool Window::IsEventThreadSupported() const
+{
+    return false;
+}
+
+void Window::OnWaitForEvents(std::uint32_t timeout)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool Window::EnqueueEvent(const WindowEvent& event)
+{
+    /* Only the event thread queues its events; events that are posted by other threads are dispatched immediately */
+    if (!eventThread_ || std::this_thread::get_id() != eventThread_->threadID.load())
+        return false;
+
+    /* Wait until the render thread has drained the queue, rather than losing events */
+    while (!eventThread_->queue.Push(event))
+    {
+        if (eventThread_->quit.load())
+            return true;
+        std::this_thread::yield();
+    }
+
+    return true;
+}
+
+void Window::DispatchEvent(const WindowEvent& event)
+{
+    eventTimestamp_ = event.timestamp;
+
+    switch (event.type)
     {
-        if (!lst->OnQuit(*this))
-            return;
+        case WindowEventType::KeyDown:
+            FOREACH_LISTENER_CALL( OnKeyDown(*this, event.keyCode) );
+            break;
+        case WindowEventType::KeyUp:
+            FOREACH_LISTENER_CALL( OnKeyUp(*this, event.keyCode) );
+            break;
+        case WindowEventType::DoubleClick:
+            FOREACH_LISTENER_CALL( OnDoubleClick(*this, event.keyCode) );
+            break;
+        case WindowEventType::Char:
+            FOREACH_LISTENER_CALL( OnChar(*this, event.chr) );
+            break;
+        case WindowEventType::WheelMotion:
+            FOREACH_LISTENER_CALL( OnWheelMotion(*this, event.motion) );
+            break;
+        case WindowEventType::LocalMotion:
+            FOREACH_LISTENER_CALL( OnLocalMotion(*this, event.point) );
+            break;
+        case WindowEventType::GlobalMotion:
+            FOREACH_LISTENER_CALL( OnGlobalMotion(*this, event.point) );
+            break;
+        case WindowEventType::Resize:
+            FOREACH_LISTENER_CALL( OnResize(*this, event.point) );
+            break;
+        case WindowEventType::Quit:
+            for (const auto& lst : eventListeners_)
+            {
+                if (!lst->OnQuit(*this))
+                    return;
+            }
+            quit_ = true;
+            break;
+        case WindowEventType::Timer:
+            FOREACH_LISTENER_CALL( OnTimer(*this, event.timerID) );
+            break;
     }
-    quit_ = true;
 }
 
-void Window::PostTimer(unsigned int timerID)
+void Window::DispatchQueuedEvents()
 {
-    FOREACH_LISTENER_CALL( OnTimer(*this, timerID) );
+    WindowEvent event;
+    while (eventThread_->queue.Pop(event))
+        DispatchEvent(event);
 }
 
 #undef FOREACH_LISTENER_CALL
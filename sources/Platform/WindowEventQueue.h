@@ -0,0 +1,108 @@
+/*
+ * WindowEventQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_WINDOW_EVENT_QUEUE_H
+#define LLGL_WINDOW_EVENT_QUEUE_H
+
+
+#include <LLGL/Types.h>
+#include <LLGL/Key.h>
+#include <atomic>
+#include <thread>
+#include <array>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+enum class WindowEventType
+{
+    KeyDown,
+    KeyUp,
+    DoubleClick,
+    Char,
+    WheelMotion,
+    LocalMotion,
+    GlobalMotion,
+    Resize,
+    Quit,
+    Timer,
+};
+
+// Window event with the time (in nanoseconds of the monotonic clock) it has arrived.
+struct WindowEvent
+{
+    WindowEventType type        = WindowEventType::Quit;
+    std::uint64_t   timestamp   = 0;
+    Key             keyCode     = Key::Any;
+    wchar_t         chr         = 0;
+    int             motion      = 0;
+    unsigned int    timerID     = 0;
+    Point           point;
+};
+
+/*
+Bounded lock-free single-producer single-consumer ring of window events.
+The event thread is the only producer, and the thread that calls "Window::ProcessEvents" the only consumer.
+*/
+class WindowEventQueue
+{
+
+    public:
+
+        static const std::size_t capacity = 1024;
+
+        // Pushes the event into the ring, or returns false if the ring is full.
+        bool Push(const WindowEvent& event)
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (head - tail_.load(std::memory_order_acquire) >= capacity)
+                return false;
+            events_[head % capacity] = event;
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Pops the next event from the ring, or returns false if the ring is empty.
+        bool Pop(WindowEvent& event)
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            if (tail == head_.load(std::memory_order_acquire))
+                return false;
+            event = events_[tail % capacity];
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+
+        std::array<WindowEvent, capacity>   events_;
+        std::atomic<std::size_t>            head_   { 0 };
+        std::atomic<std::size_t>            tail_   { 0 };
+
+};
+
+// State of the dedicated event thread of a window.
+struct WindowEventThread
+{
+    WindowEventQueue                queue;
+    std::thread                     thread;
+    std::atomic<bool>               quit        { false };
+    std::atomic<std::thread::id>    threadID    { std::thread::id() }; // Published by the event thread itself, since 'thread' is still being assigned when the thread starts.
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
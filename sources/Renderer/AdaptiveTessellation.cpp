@@ -0,0 +1,84 @@
+/*
+ * AdaptiveTessellation.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/AdaptiveTessellation.h>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+AdaptiveTessellation::AdaptiveTessellation(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const AdaptiveTessellationDescriptor& desc) :
+    renderSystem_  { renderSystem  },
+    commandBuffer_ { commandBuffer },
+    desc_          { desc          }
+{
+    if (!desc.pipeline)
+        throw std::invalid_argument("cannot create adaptive tessellation without compute pipeline");
+    if (desc.maxPatches == 0 || desc.threadGroupSize == 0)
+        throw std::invalid_argument("cannot create adaptive tessellation with zero patches or zero thread group size");
+
+    const auto& caps = renderSystem.GetRenderingCaps();
+    if (!caps.hasTessellationShaders || !caps.hasComputeShaders || !caps.hasStorageBuffers)
+        throw std::runtime_error("adaptive tessellation requires tessellation shaders, compute shaders, and storage buffers");
+
+    /* Create constant buffer for the parameters */
+    BufferDescriptor constantBufferDesc;
+    {
+        constantBufferDesc.type     = BufferType::Constant;
+        constantBufferDesc.size     = sizeof(AdaptiveTessellationParameters);
+        constantBufferDesc.flags    = BufferFlags::DynamicUsage;
+    }
+    constantBuffer_ = renderSystem.CreateBuffer(constantBufferDesc);
+
+    /* Create factor buffer with one entry per patch */
+    BufferDescriptor factorBufferDesc;
+    {
+        factorBufferDesc.type                       = BufferType::Storage;
+        factorBufferDesc.size                       = desc.maxPatches * sizeof(AdaptiveTessellationFactors);
+        factorBufferDesc.storageBuffer.storageType  = StorageBufferType::RWStructuredBuffer;
+        factorBufferDesc.storageBuffer.stride       = sizeof(AdaptiveTessellationFactors);
+    }
+    factorBuffer_ = renderSystem.CreateBuffer(factorBufferDesc);
+}
+
+AdaptiveTessellation::~AdaptiveTessellation()
+{
+    renderSystem_.Release(*constantBuffer_);
+    renderSystem_.Release(*factorBuffer_);
+}
+
+void AdaptiveTessellation::Compute(Buffer& patchBuffer, std::uint32_t numPatches, const AdaptiveTessellationParameters& params)
+{
+    if (numPatches > desc_.maxPatches)
+        throw std::out_of_range("number of patches exceeds maximum of adaptive tessellation");
+    if (numPatches == 0)
+        return;
+
+    /* Update parameters with the actual number of patches */
+    auto paramsCopy = params;
+    paramsCopy.numPatches = numPatches;
+    renderSystem_.WriteBuffer(*constantBuffer_, &paramsCopy, sizeof(paramsCopy), 0);
+
+    /* Compute factors with one thread per patch */
+    commandBuffer_.SetComputePipeline(*desc_.pipeline);
+    commandBuffer_.SetConstantBuffer(*constantBuffer_, 0, ShaderStageFlags::ComputeStage);
+    commandBuffer_.SetStorageBuffer(patchBuffer, 0, ShaderStageFlags::ComputeStage | ShaderStageFlags::ReadOnlyResource);
+    commandBuffer_.SetStorageBuffer(*factorBuffer_, 1, ShaderStageFlags::ComputeStage);
+    commandBuffer_.Dispatch((numPatches + desc_.threadGroupSize - 1) / desc_.threadGroupSize, 1, 1);
+
+    /* Make factors visible to the hull or tessellation control shader */
+    commandBuffer_.StorageBarrier(*factorBuffer_);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
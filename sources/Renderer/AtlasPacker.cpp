@@ -0,0 +1,179 @@
+/*
+ * AtlasPacker.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "AtlasPacker.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+/* ----- ShelfPacker class ----- */
+
+ShelfPacker::ShelfPacker(unsigned int width, unsigned int height) :
+    AtlasPacker { width, height }
+{
+}
+
+bool ShelfPacker::Insert(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y)
+{
+    if (width > width_ || height > height_)
+        return false;
+
+    /* Find the lowest shelf with enough space left */
+    Shelf* bestShelf = nullptr;
+
+    for (auto& shelf : shelves_)
+    {
+        if (shelf.height >= height && width_ - shelf.usedWidth >= width)
+        {
+            if (!bestShelf || shelf.height < bestShelf->height)
+                bestShelf = &shelf;
+        }
+    }
+
+    /* Open a new shelf if no shelf fits, or if the best shelf would waste more than half of its height */
+    if (!bestShelf || bestShelf->height > height * 2)
+    {
+        if (height_ - top_ >= height)
+        {
+            shelves_.push_back({ top_, height, 0 });
+            top_ += height;
+            bestShelf = &(shelves_.back());
+        }
+        else if (!bestShelf)
+            return false;
+    }
+
+    x = bestShelf->usedWidth;
+    y = bestShelf->y;
+    bestShelf->usedWidth += width;
+
+    return true;
+}
+
+void ShelfPacker::Reset()
+{
+    shelves_.clear();
+    top_ = 0;
+}
+
+
+/* ----- SkylinePacker class ----- */
+
+SkylinePacker::SkylinePacker(unsigned int width, unsigned int height) :
+    AtlasPacker { width, height }
+{
+    Reset();
+}
+
+bool SkylinePacker::Insert(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y)
+{
+    /* Find the segment that places the rectangle lowest, and the narrowest segment among equal positions */
+    std::size_t bestIndex   = skyline_.size();
+    unsigned int bestY      = height_;
+    unsigned int bestWidth  = width_;
+
+    for (std::size_t i = 0; i < skyline_.size(); ++i)
+    {
+        unsigned int posY = 0;
+        if (Fit(i, width, height, posY))
+        {
+            if (posY < bestY || (posY == bestY && skyline_[i].width < bestWidth))
+            {
+                bestIndex   = i;
+                bestY       = posY;
+                bestWidth   = skyline_[i].width;
+            }
+        }
+    }
+
+    if (bestIndex == skyline_.size())
+        return false;
+
+    x = skyline_[bestIndex].x;
+    y = bestY;
+
+    AddSegment(bestIndex, x, y + height, width);
+
+    return true;
+}
+
+void SkylinePacker::Reset()
+{
+    skyline_.clear();
+    skyline_.push_back({ 0, 0, width_ });
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool SkylinePacker::Fit(std::size_t index, unsigned int width, unsigned int height, unsigned int& y) const
+{
+    auto x = skyline_[index].x;
+    if (x + width > width_)
+        return false;
+
+    /* The rectangle rests on the highest segment below its entire width */
+    y = 0;
+    for (auto widthLeft = static_cast<int>(width); widthLeft > 0; ++index)
+    {
+        y = std::max(y, skyline_[index].y);
+        if (y + height > height_)
+            return false;
+        widthLeft -= static_cast<int>(skyline_[index].width);
+    }
+
+    return true;
+}
+
+void SkylinePacker::AddSegment(std::size_t index, unsigned int x, unsigned int y, unsigned int width)
+{
+    skyline_.insert(skyline_.begin() + index, { x, y, width });
+
+    /* Shrink or remove the segments that are covered by the new segment */
+    for (auto i = index + 1; i < skyline_.size();)
+    {
+        auto& prev = skyline_[i - 1];
+        auto& next = skyline_[i];
+
+        if (next.x >= prev.x + prev.width)
+            break;
+
+        auto shrink = prev.x + prev.width - next.x;
+        if (shrink < next.width)
+        {
+            next.x      += shrink;
+            next.width  -= shrink;
+            break;
+        }
+
+        skyline_.erase(skyline_.begin() + i);
+    }
+
+    /* Merge neighboring segments of the same height */
+    for (std::size_t i = 0; i + 1 < skyline_.size();)
+    {
+        if (skyline_[i].y == skyline_[i + 1].y)
+        {
+            skyline_[i].width += skyline_[i + 1].width;
+            skyline_.erase(skyline_.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
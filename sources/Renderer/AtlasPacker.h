@@ -0,0 +1,117 @@
+/*
+ * AtlasPacker.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ATLAS_PACKER_H
+#define LLGL_ATLAS_PACKER_H
+
+
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Interface of a rectangle packer for a single layer of a texture atlas.
+class AtlasPacker
+{
+
+    public:
+
+        virtual ~AtlasPacker() = default;
+
+        // Finds space for a rectangle of the specified size and returns its position, or returns false if the layer has no space left.
+        virtual bool Insert(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y) = 0;
+
+        // Clears all rectangles of this layer.
+        virtual void Reset() = 0;
+
+    protected:
+
+        AtlasPacker(unsigned int width, unsigned int height) :
+            width_  { width  },
+            height_ { height }
+        {
+        }
+
+        unsigned int width_     = 0;
+        unsigned int height_    = 0;
+
+};
+
+/*
+Shelf packer: rectangles are placed from left to right in horizontal shelves, which are stacked from top to bottom.
+Each rectangle goes into the shelf with the smallest height that fits, so rectangles of similar height share their shelves.
+This is fast and works well for rectangles of uniform height, such as glyphs.
+*/
+class ShelfPacker final : public AtlasPacker
+{
+
+    public:
+
+        ShelfPacker(unsigned int width, unsigned int height);
+
+        bool Insert(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y) override;
+        void Reset() override;
+
+    private:
+
+        struct Shelf
+        {
+            unsigned int y;
+            unsigned int height;
+            unsigned int usedWidth;
+        };
+
+        std::vector<Shelf>  shelves_;
+        unsigned int        top_        = 0;
+
+};
+
+/*
+Skyline packer (bottom-left heuristic): the upper contour of all rectangles is stored as a list of horizontal segments,
+and each rectangle is placed at the lowest position along this contour. This wastes less space than the shelf packer
+for rectangles of different heights, such as decals.
+*/
+class SkylinePacker final : public AtlasPacker
+{
+
+    public:
+
+        SkylinePacker(unsigned int width, unsigned int height);
+
+        bool Insert(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y) override;
+        void Reset() override;
+
+    private:
+
+        struct Segment
+        {
+            unsigned int x;
+            unsigned int y;
+            unsigned int width;
+        };
+
+        // Determines the Y position of a rectangle that starts at the specified segment, or returns false if it does not fit.
+        bool Fit(std::size_t index, unsigned int width, unsigned int height, unsigned int& y) const;
+
+        void AddSegment(std::size_t index, unsigned int x, unsigned int y, unsigned int width);
+
+        std::vector<Segment> skyline_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
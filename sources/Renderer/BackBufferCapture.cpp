@@ -0,0 +1,189 @@
+/*
+ * BackBufferCapture.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/BackBufferCapture.h>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+BackBufferCapture::BackBufferCapture(
+    RenderSystem&                       renderSystem,
+    RenderContext&                      renderContext,
+    CommandBuffer&                      commandBuffer,
+    const BackBufferCaptureDescriptor&  desc) :
+        renderSystem_  { renderSystem  },
+        renderContext_ { renderContext },
+        commandBuffer_ { commandBuffer },
+        desc_          { desc          }
+{
+    if (desc.numSlots == 0 || desc.yuvThreadGroupSize == 0)
+        throw std::invalid_argument("cannot create back buffer capture with zero slots or zero YUV thread group size");
+
+    slots_.resize(desc.numSlots);
+    for (auto& slot : slots_)
+        slot.fence = renderSystem.CreateFence();
+}
+
+BackBufferCapture::~BackBufferCapture()
+{
+    for (auto& slot : slots_)
+    {
+        /* Resources must not be released while the GPU still copies into them */
+        if (slot.state == SlotState::Pending)
+            slot.fence->Wait();
+        ReleaseSlotResources(slot);
+        renderSystem_.Release(*slot.fence);
+    }
+}
+
+bool BackBufferCapture::Capture()
+{
+    /* Find next free slot in ring order, or drop the frame if the consumer has not released any slot yet */
+    auto numSlots = static_cast<unsigned int>(slots_.size());
+
+    Slot* slot = nullptr;
+    for (unsigned int i = 0; i < numSlots && !slot; ++i)
+    {
+        auto& nextSlot = slots_[(nextSlot_ + i) % numSlots];
+        if (nextSlot.state == SlotState::Free)
+        {
+            slot        = &nextSlot;
+            nextSlot_   = (nextSlot_ + i + 1) % numSlots;
+        }
+    }
+
+    if (!slot)
+    {
+        ++numDroppedFrames_;
+        return false;
+    }
+
+    const auto& resolution = renderContext_.GetVideoMode().resolution;
+    Gs::Vector2ui size { static_cast<unsigned int>(resolution.x), static_cast<unsigned int>(resolution.y) };
+
+    if (desc_.yuvPipeline && (size.x % 4 != 0 || size.y % 2 != 0))
+        throw std::invalid_argument("resolution of back buffer capture with YUV conversion must be a multiple of 4x2");
+
+    UpdateSlotResources(*slot, size);
+
+    /* Copy back buffer on the GPU */
+    renderContext_.CopyBackBuffer(*slot->texture);
+
+    /* Convert frame into NV12 format, where each thread converts 4x2 pixels */
+    if (desc_.yuvPipeline)
+    {
+        auto groupSize = desc_.yuvThreadGroupSize;
+        commandBuffer_.SetComputePipeline(*desc_.yuvPipeline);
+        commandBuffer_.SetTexture(*slot->texture, 0, ShaderStageFlags::ComputeStage);
+        commandBuffer_.SetStorageBuffer(*slot->yuvBuffer, 1, ShaderStageFlags::ComputeStage);
+        commandBuffer_.Dispatch((size.x / 4 + groupSize - 1) / groupSize, (size.y / 2 + groupSize - 1) / groupSize, 1);
+    }
+
+    commandBuffer_.Signal(*slot->fence);
+
+    slot->state         = SlotState::Pending;
+    slot->frameIndex    = numFrames_++;
+
+    return true;
+}
+
+bool BackBufferCapture::AcquireFrame(BackBufferCaptureFrame& frame)
+{
+    /* Find oldest frame that has been completed by the GPU */
+    Slot* oldestSlot = nullptr;
+
+    for (auto& slot : slots_)
+    {
+        if (slot.state == SlotState::Pending && slot.fence->IsSignaled())
+            slot.state = SlotState::Ready;
+        if (slot.state == SlotState::Ready && (!oldestSlot || slot.frameIndex < oldestSlot->frameIndex))
+            oldestSlot = &slot;
+    }
+
+    if (!oldestSlot)
+        return false;
+
+    oldestSlot->state = SlotState::Acquired;
+
+    frame.texture       = oldestSlot->texture;
+    frame.yuvBuffer     = oldestSlot->yuvBuffer;
+    frame.frameIndex    = oldestSlot->frameIndex;
+    frame.size          = oldestSlot->size;
+    frame.slot          = static_cast<unsigned int>(oldestSlot - slots_.data());
+
+    return true;
+}
+
+void BackBufferCapture::ReleaseFrame(const BackBufferCaptureFrame& frame)
+{
+    if (frame.slot >= slots_.size() || slots_[frame.slot].state != SlotState::Acquired)
+        throw std::invalid_argument("cannot release back buffer capture frame that has not been acquired");
+    slots_[frame.slot].state = SlotState::Free;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void BackBufferCapture::UpdateSlotResources(Slot& slot, const Gs::Vector2ui& size)
+{
+    if (slot.texture && slot.size == size)
+        return;
+
+    ReleaseSlotResources(slot);
+
+    slot.size = size;
+
+    /* Create texture with the same format and size as the back buffer */
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.type                = TextureType::Texture2D;
+        textureDesc.format              = TextureFormat::RGBA8;
+        textureDesc.texture2D.width     = size.x;
+        textureDesc.texture2D.height    = size.y;
+        textureDesc.texture2D.layers    = 1;
+    }
+    slot.texture = renderSystem_.CreateTexture(textureDesc);
+
+    /* Create buffer for the luma plane (1 byte per pixel) and the interleaved chroma plane (1 byte per 2 pixels) */
+    if (desc_.yuvPipeline)
+    {
+        BufferDescriptor bufferDesc;
+        {
+            bufferDesc.type                         = BufferType::Storage;
+            bufferDesc.size                         = size.x * size.y * 3 / 2;
+            bufferDesc.storageBuffer.storageType    = StorageBufferType::RWStructuredBuffer;
+            bufferDesc.storageBuffer.stride         = sizeof(std::uint32_t);
+        }
+        slot.yuvBuffer = renderSystem_.CreateBuffer(bufferDesc);
+    }
+}
+
+void BackBufferCapture::ReleaseSlotResources(Slot& slot)
+{
+    if (slot.texture)
+    {
+        renderSystem_.Release(*slot.texture);
+        slot.texture = nullptr;
+    }
+    if (slot.yuvBuffer)
+    {
+        renderSystem_.Release(*slot.yuvBuffer);
+        slot.yuvBuffer = nullptr;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
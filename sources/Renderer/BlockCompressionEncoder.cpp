@@ -0,0 +1,133 @@
+/*
+ * BlockCompressionEncoder.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/BlockCompressionEncoder.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Dimension (in texels) of each compressed block
+static const std::uint32_t g_blockDim = 4;
+
+// Returns the size (in bytes) of each block of the specified format, or 0 if the format is not supported by the encoder.
+static std::uint32_t GetEncoderBlockSize(const TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::RGB_DXT1:
+        case TextureFormat::RGBA_DXT1:
+        case TextureFormat::RGB_ETC2:
+            return 8;
+        case TextureFormat::RGBA_DXT5:
+        case TextureFormat::RGBA_BC7:
+        case TextureFormat::RGBA_ETC2:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+static std::uint32_t NumBlocks(std::uint32_t size)
+{
+    return (size + g_blockDim - 1) / g_blockDim;
+}
+
+BlockCompressionEncoder::BlockCompressionEncoder(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const BlockCompressionEncoderDescriptor& desc) :
+    renderSystem_  { renderSystem                      },
+    commandBuffer_ { commandBuffer                     },
+    desc_          { desc                              },
+    blockSize_     { GetEncoderBlockSize(desc.format)  }
+{
+    if (!desc.pipeline)
+        throw std::invalid_argument("cannot create block compression encoder without compute pipeline");
+    if (blockSize_ == 0)
+        throw std::invalid_argument("cannot create block compression encoder for texture format other than BC1, BC3, BC7, or ETC2");
+    if (desc.maxWidth == 0 || desc.maxHeight == 0 || desc.threadGroupSizeX == 0 || desc.threadGroupSizeY == 0)
+        throw std::invalid_argument("cannot create block compression encoder with zero size or zero thread group size");
+
+    const auto& caps = renderSystem.GetRenderingCaps();
+    if (!caps.hasComputeShaders || !caps.hasStorageBuffers)
+        throw std::runtime_error("block compression encoder requires compute shaders and storage buffers");
+
+    /* Create constant buffer for the parameters */
+    BufferDescriptor constantBufferDesc;
+    {
+        constantBufferDesc.type     = BufferType::Constant;
+        constantBufferDesc.size     = sizeof(BlockCompressionParameters);
+        constantBufferDesc.flags    = BufferFlags::DynamicUsage;
+    }
+    constantBuffer_ = renderSystem.CreateBuffer(constantBufferDesc);
+
+    /* Create block buffer with one entry per block of the maximal region */
+    BufferDescriptor blockBufferDesc;
+    {
+        blockBufferDesc.type                        = BufferType::Storage;
+        blockBufferDesc.size                        = NumBlocks(desc.maxWidth) * NumBlocks(desc.maxHeight) * blockSize_;
+        blockBufferDesc.storageBuffer.storageType   = StorageBufferType::RWStructuredBuffer;
+        blockBufferDesc.storageBuffer.stride        = blockSize_;
+    }
+    blockBuffer_ = renderSystem.CreateBuffer(blockBufferDesc);
+}
+
+BlockCompressionEncoder::~BlockCompressionEncoder()
+{
+    renderSystem_.Release(*constantBuffer_);
+    renderSystem_.Release(*blockBuffer_);
+}
+
+void BlockCompressionEncoder::Encode(Texture& dstTexture, const TextureRegion& dstRegion, Texture& srcTexture, unsigned int srcMipLevel, float quality)
+{
+    if (renderSystem_.QueryTextureDescriptor(dstTexture).format != desc_.format)
+        throw std::invalid_argument("cannot encode blocks into texture with different format than the block compression encoder");
+    if (dstRegion.offset.x % g_blockDim != 0 || dstRegion.offset.y % g_blockDim != 0 || dstRegion.extent.z != 1)
+        throw std::invalid_argument("cannot encode blocks into texture region that is not aligned to the blocks");
+    if (dstRegion.extent.x > desc_.maxWidth || dstRegion.extent.y > desc_.maxHeight)
+        throw std::out_of_range("texture region exceeds maximal size of block compression encoder");
+    if (dstRegion.extent.x == 0 || dstRegion.extent.y == 0)
+        return;
+
+    /* Update parameters for the region */
+    BlockCompressionParameters params;
+    {
+        params.srcOffset[0]     = dstRegion.offset.x;
+        params.srcOffset[1]     = dstRegion.offset.y;
+        params.numBlocks[0]     = NumBlocks(dstRegion.extent.x);
+        params.numBlocks[1]     = NumBlocks(dstRegion.extent.y);
+        params.srcMipLevel      = srcMipLevel;
+        params.srcArrayLayer    = dstRegion.offset.z;
+        params.quality          = std::max(0.0f, std::min(quality, 1.0f));
+    }
+    renderSystem_.WriteBuffer(*constantBuffer_, &params, sizeof(params), 0);
+
+    /* Encode blocks with one thread per block */
+    commandBuffer_.SetComputePipeline(*desc_.pipeline);
+    commandBuffer_.SetConstantBuffer(*constantBuffer_, 0, ShaderStageFlags::ComputeStage);
+    commandBuffer_.SetTexture(srcTexture, 0, ShaderStageFlags::ComputeStage);
+    commandBuffer_.SetStorageBuffer(*blockBuffer_, 1, ShaderStageFlags::ComputeStage);
+    commandBuffer_.Dispatch(
+        (params.numBlocks[0] + desc_.threadGroupSizeX - 1) / desc_.threadGroupSizeX,
+        (params.numBlocks[1] + desc_.threadGroupSizeY - 1) / desc_.threadGroupSizeY,
+        1
+    );
+
+    /* Make blocks visible to the copy command, and copy them into the compressed texture */
+    commandBuffer_.Barrier(BarrierFlags::Copy);
+
+    const auto imageFormat = (desc_.format == TextureFormat::RGB_DXT1 || desc_.format == TextureFormat::RGB_ETC2 ? ImageFormat::CompressedRGB : ImageFormat::CompressedRGBA);
+    commandBuffer_.CopyBufferToTexture(dstTexture, dstRegion, *blockBuffer_, 0, imageFormat, DataType::UInt8);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
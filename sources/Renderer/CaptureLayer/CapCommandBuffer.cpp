@@ -0,0 +1,569 @@
+/*
+ * CapCommandBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapCommandBuffer.h"
+#include "CapRenderContext.h"
+#include "CapRenderTarget.h"
+#include "../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+CapCommandBuffer::CapCommandBuffer(CommandBuffer& instance, CapRecorder& recorder) :
+    instance  { instance },
+    recorder_ { recorder }
+{
+}
+
+/* ----- Configuration ----- */
+
+void CapCommandBuffer::SetGraphicsAPIDependentState(const GraphicsAPIDependentStateDescriptor& state)
+{
+    RecordCommand(CapOpcode::SetGraphicsAPIDependentState, state);
+    instance.SetGraphicsAPIDependentState(state);
+}
+
+void CapCommandBuffer::SetViewport(const Viewport& viewport)
+{
+    RecordCommand(CapOpcode::SetViewport, viewport);
+    instance.SetViewport(viewport);
+}
+
+void CapCommandBuffer::SetViewportArray(unsigned int numViewports, const Viewport* viewportArray)
+{
+    CapWriter writer { CapOpcode::SetViewportArray };
+    {
+        writer.Write(id);
+        writer.WriteData(viewportArray, numViewports * sizeof(Viewport));
+    }
+    recorder_.Append(writer);
+
+    instance.SetViewportArray(numViewports, viewportArray);
+}
+
+void CapCommandBuffer::SetScissor(const Scissor& scissor)
+{
+    RecordCommand(CapOpcode::SetScissor, scissor);
+    instance.SetScissor(scissor);
+}
+
+void CapCommandBuffer::SetScissorArray(unsigned int numScissors, const Scissor* scissorArray)
+{
+    CapWriter writer { CapOpcode::SetScissorArray };
+    {
+        writer.Write(id);
+        writer.WriteData(scissorArray, numScissors * sizeof(Scissor));
+    }
+    recorder_.Append(writer);
+
+    instance.SetScissorArray(numScissors, scissorArray);
+}
+
+void CapCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    RecordCommand(CapOpcode::SetShadingRate, rate);
+    instance.SetShadingRate(rate);
+}
+
+void CapCommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    RecordCommand(CapOpcode::SetShadingRateImage, GetID(texture));
+    instance.SetShadingRateImage(texture);
+}
+
+void CapCommandBuffer::SetDepthBounds(float minDepth, float maxDepth)
+{
+    RecordCommand(CapOpcode::SetDepthBounds, minDepth, maxDepth);
+    instance.SetDepthBounds(minDepth, maxDepth);
+}
+
+void CapCommandBuffer::SetClearColor(const ColorRGBAf& color)
+{
+    RecordCommand(CapOpcode::SetClearColor, color);
+    instance.SetClearColor(color);
+}
+
+void CapCommandBuffer::SetClearDepth(float depth)
+{
+    RecordCommand(CapOpcode::SetClearDepth, depth);
+    instance.SetClearDepth(depth);
+}
+
+void CapCommandBuffer::SetClearStencil(int stencil)
+{
+    RecordCommand(CapOpcode::SetClearStencil, stencil);
+    instance.SetClearStencil(stencil);
+}
+
+void CapCommandBuffer::Clear(long flags)
+{
+    RecordCommand(CapOpcode::Clear, flags);
+    instance.Clear(flags);
+}
+
+void CapCommandBuffer::ClearTarget(unsigned int targetIndex, const LLGL::ColorRGBAf& color)
+{
+    RecordCommand(CapOpcode::ClearTarget, targetIndex, color);
+    instance.ClearTarget(targetIndex, color);
+}
+
+/* ----- Buffers ------ */
+
+void CapCommandBuffer::SetVertexBuffer(Buffer& buffer, unsigned int offset)
+{
+    RecordCommand(CapOpcode::SetVertexBuffer, GetID(&buffer), offset);
+    instance.SetVertexBuffer(buffer, offset);
+}
+
+void CapCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
+{
+    RecordCommand(CapOpcode::SetVertexBufferArray, GetID(&bufferArray));
+    instance.SetVertexBufferArray(bufferArray);
+}
+
+void CapCommandBuffer::SetIndexBuffer(Buffer& buffer, unsigned int offset)
+{
+    RecordCommand(CapOpcode::SetIndexBuffer, GetID(&buffer), offset);
+    instance.SetIndexBuffer(buffer, offset);
+}
+
+void CapCommandBuffer::SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetConstantBuffer, GetID(&buffer), slot, shaderStageFlags);
+    instance.SetConstantBuffer(buffer, slot, shaderStageFlags);
+}
+
+void CapCommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetConstantBufferArray, GetID(&bufferArray), startSlot, shaderStageFlags);
+    instance.SetConstantBufferArray(bufferArray, startSlot, shaderStageFlags);
+}
+
+void CapCommandBuffer::SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetConstantBufferRange, GetID(&buffer), offset, size, slot, shaderStageFlags);
+    instance.SetConstantBufferRange(buffer, offset, size, slot, shaderStageFlags);
+}
+
+void CapCommandBuffer::SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetStorageBuffer, GetID(&buffer), slot, shaderStageFlags);
+    instance.SetStorageBuffer(buffer, slot, shaderStageFlags);
+}
+
+void CapCommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetStorageBufferArray, GetID(&bufferArray), startSlot, shaderStageFlags);
+    instance.SetStorageBufferArray(bufferArray, startSlot, shaderStageFlags);
+}
+
+void CapCommandBuffer::ResetBufferCounter(Buffer& buffer, unsigned int value)
+{
+    RecordCommand(CapOpcode::ResetBufferCounter, GetID(&buffer), value);
+    instance.ResetBufferCounter(buffer, value);
+}
+
+void CapCommandBuffer::CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer)
+{
+    RecordCommand(CapOpcode::CopyBufferCounter, GetID(&dstBuffer), dstOffset, GetID(&srcBuffer));
+    instance.CopyBufferCounter(dstBuffer, dstOffset, srcBuffer);
+}
+
+void CapCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
+{
+    RecordCommand(CapOpcode::SetStreamOutputBuffer, GetID(&buffer));
+    instance.SetStreamOutputBuffer(buffer);
+}
+
+void CapCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
+{
+    RecordCommand(CapOpcode::SetStreamOutputBufferArray, GetID(&bufferArray));
+    instance.SetStreamOutputBufferArray(bufferArray);
+}
+
+void CapCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
+{
+    RecordCommand(CapOpcode::BeginStreamOutput, primitiveType);
+    instance.BeginStreamOutput(primitiveType);
+}
+
+void CapCommandBuffer::EndStreamOutput()
+{
+    RecordCommand(CapOpcode::EndStreamOutput);
+    instance.EndStreamOutput();
+}
+
+void CapCommandBuffer::PauseStreamOutput()
+{
+    RecordCommand(CapOpcode::PauseStreamOutput);
+    instance.PauseStreamOutput();
+}
+
+void CapCommandBuffer::ResumeStreamOutput()
+{
+    RecordCommand(CapOpcode::ResumeStreamOutput);
+    instance.ResumeStreamOutput();
+}
+
+/* ----- Textures ----- */
+
+void CapCommandBuffer::SetTexture(Texture& texture, unsigned int slot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetTexture, GetID(&texture), slot, shaderStageFlags);
+    instance.SetTexture(texture, slot, shaderStageFlags);
+}
+
+void CapCommandBuffer::SetTextureArray(TextureArray& textureArray, unsigned int startSlot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetTextureArray, GetID(&textureArray), startSlot, shaderStageFlags);
+    instance.SetTextureArray(textureArray, startSlot, shaderStageFlags);
+}
+
+/* ----- Sampler States ----- */
+
+void CapCommandBuffer::SetSampler(Sampler& sampler, unsigned int slot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetSampler, GetID(&sampler), slot, shaderStageFlags);
+    instance.SetSampler(sampler, slot, shaderStageFlags);
+}
+
+void CapCommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags)
+{
+    RecordCommand(CapOpcode::SetSamplerArray, GetID(&samplerArray), startSlot, shaderStageFlags);
+    instance.SetSamplerArray(samplerArray, startSlot, shaderStageFlags);
+}
+
+/* ----- Resource Heaps ----- */
+
+void CapCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap)
+{
+    RecordCommand(CapOpcode::SetResourceHeap, GetID(&resourceHeap));
+    instance.SetResourceHeap(resourceHeap);
+}
+
+/* ----- Render Targets ----- */
+
+void CapCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
+{
+    auto& renderTargetCap = LLGL_CAST(CapRenderTarget&, renderTarget);
+    RecordCommand(CapOpcode::SetRenderTarget, renderTargetCap.id);
+    instance.SetRenderTarget(renderTargetCap.instance);
+}
+
+void CapCommandBuffer::SetRenderTarget(RenderContext& renderContext)
+{
+    auto& renderContextCap = LLGL_CAST(CapRenderContext&, renderContext);
+    RecordCommand(CapOpcode::SetRenderTarget, renderContextCap.id);
+    instance.SetRenderTarget(renderContextCap.instance);
+}
+
+/* ----- Render Passes ----- */
+
+void CapCommandBuffer::BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc)
+{
+    auto& renderTargetCap = LLGL_CAST(CapRenderTarget&, renderTarget);
+
+    CapWriter writer { CapOpcode::BeginRenderPass };
+    {
+        writer.WriteAll(id, renderTargetCap.id);
+        WriteCapRenderPassDescriptor(writer, renderPassDesc);
+    }
+    recorder_.Append(writer);
+
+    instance.BeginRenderPass(renderTargetCap.instance, renderPassDesc);
+}
+
+void CapCommandBuffer::BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc)
+{
+    auto& renderContextCap = LLGL_CAST(CapRenderContext&, renderContext);
+
+    CapWriter writer { CapOpcode::BeginRenderPass };
+    {
+        writer.WriteAll(id, renderContextCap.id);
+        WriteCapRenderPassDescriptor(writer, renderPassDesc);
+    }
+    recorder_.Append(writer);
+
+    instance.BeginRenderPass(renderContextCap.instance, renderPassDesc);
+}
+
+void CapCommandBuffer::EndRenderPass()
+{
+    RecordCommand(CapOpcode::EndRenderPass);
+    instance.EndRenderPass();
+}
+
+/* ----- Pipeline States ----- */
+
+void CapCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
+{
+    RecordCommand(CapOpcode::SetGraphicsPipeline, GetID(&graphicsPipeline));
+    instance.SetGraphicsPipeline(graphicsPipeline);
+}
+
+void CapCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
+{
+    RecordCommand(CapOpcode::SetComputePipeline, GetID(&computePipeline));
+    instance.SetComputePipeline(computePipeline);
+}
+
+void CapCommandBuffer::SetPushConstants(unsigned int offset, unsigned int size, const void* data)
+{
+    CapWriter writer { CapOpcode::SetPushConstants };
+    {
+        writer.WriteAll(id, offset);
+        writer.WriteData(data, size);
+    }
+    recorder_.Append(writer);
+
+    instance.SetPushConstants(offset, size, data);
+}
+
+void CapCommandBuffer::SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances)
+{
+    CapWriter writer { CapOpcode::SetShaderClassInstances };
+    {
+        writer.WriteAll(id, stage);
+        writer.WriteData(classInstances, numSlots * sizeof(int));
+    }
+    recorder_.Append(writer);
+
+    instance.SetShaderClassInstances(stage, numSlots, classInstances);
+}
+
+/* ----- Queries ----- */
+
+void CapCommandBuffer::BeginQuery(Query& query)
+{
+    RecordCommand(CapOpcode::BeginQuery, GetID(&query));
+    instance.BeginQuery(query);
+}
+
+void CapCommandBuffer::EndQuery(Query& query)
+{
+    RecordCommand(CapOpcode::EndQuery, GetID(&query));
+    instance.EndQuery(query);
+}
+
+bool CapCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
+{
+    return instance.QueryResult(query, result);
+}
+
+bool CapCommandBuffer::QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results)
+{
+    return instance.QueryResult(queryArray, firstQuery, numQueries, results);
+}
+
+bool CapCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    return instance.QueryPipelineStatisticsResult(query, result);
+}
+
+void CapCommandBuffer::ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset)
+{
+    RecordCommand(CapOpcode::ResolveQueryData, GetID(&queryArray), firstQuery, numQueries, GetID(&dstBuffer), dstOffset);
+    instance.ResolveQueryData(queryArray, firstQuery, numQueries, dstBuffer, dstOffset);
+}
+
+void CapCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
+{
+    RecordCommand(CapOpcode::BeginRenderCondition, GetID(&query), mode);
+    instance.BeginRenderCondition(query, mode);
+}
+
+void CapCommandBuffer::EndRenderCondition()
+{
+    RecordCommand(CapOpcode::EndRenderCondition);
+    instance.EndRenderCondition();
+}
+
+/* ----- Copy ----- */
+
+void CapCommandBuffer::CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size)
+{
+    RecordCommand(CapOpcode::CopyBuffer, GetID(&dstBuffer), dstOffset, GetID(&srcBuffer), srcOffset, size);
+    instance.CopyBuffer(dstBuffer, dstOffset, srcBuffer, srcOffset, size);
+}
+
+void CapCommandBuffer::CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    RecordCommand(CapOpcode::CopyTexture, GetID(&dstTexture), dstMipLevel, dstOffset, GetID(&srcTexture), srcRegion);
+    instance.CopyTexture(dstTexture, dstMipLevel, dstOffset, srcTexture, srcRegion);
+}
+
+void CapCommandBuffer::ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    RecordCommand(CapOpcode::ResolveTexture, GetID(&dstTexture), dstMipLevel, dstOffset, GetID(&srcTexture), srcRegion);
+    instance.ResolveTexture(dstTexture, dstMipLevel, dstOffset, srcTexture, srcRegion);
+}
+
+void CapCommandBuffer::CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType)
+{
+    RecordCommand(CapOpcode::CopyBufferToTexture, GetID(&dstTexture), dstRegion, GetID(&srcBuffer), srcOffset, imageFormat, dataType);
+    instance.CopyBufferToTexture(dstTexture, dstRegion, srcBuffer, srcOffset, imageFormat, dataType);
+}
+
+/* ----- Drawing ----- */
+
+void CapCommandBuffer::Draw(unsigned int numVertices, unsigned int firstVertex)
+{
+    RecordCommand(CapOpcode::Draw, numVertices, firstVertex);
+    instance.Draw(numVertices, firstVertex);
+}
+
+void CapCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex)
+{
+    RecordCommand(CapOpcode::DrawIndexed, numVertices, firstIndex);
+    instance.DrawIndexed(numVertices, firstIndex);
+}
+
+void CapCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex, int vertexOffset)
+{
+    RecordCommand(CapOpcode::DrawIndexedOffset, numVertices, firstIndex, vertexOffset);
+    instance.DrawIndexed(numVertices, firstIndex, vertexOffset);
+}
+
+void CapCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances)
+{
+    RecordCommand(CapOpcode::DrawInstanced, numVertices, firstVertex, numInstances);
+    instance.DrawInstanced(numVertices, firstVertex, numInstances);
+}
+
+void CapCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset)
+{
+    RecordCommand(CapOpcode::DrawInstancedOffset, numVertices, firstVertex, numInstances, instanceOffset);
+    instance.DrawInstanced(numVertices, firstVertex, numInstances, instanceOffset);
+}
+
+void CapCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex)
+{
+    RecordCommand(CapOpcode::DrawIndexedInstanced, numVertices, numInstances, firstIndex);
+    instance.DrawIndexedInstanced(numVertices, numInstances, firstIndex);
+}
+
+void CapCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset)
+{
+    RecordCommand(CapOpcode::DrawIndexedInstancedOffset, numVertices, numInstances, firstIndex, vertexOffset);
+    instance.DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset);
+}
+
+void CapCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset)
+{
+    RecordCommand(CapOpcode::DrawIndexedInstancedOffsets, numVertices, numInstances, firstIndex, vertexOffset, instanceOffset);
+    instance.DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset, instanceOffset);
+}
+
+void CapCommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset)
+{
+    RecordCommand(CapOpcode::DrawIndirect, GetID(&buffer), offset);
+    instance.DrawIndirect(buffer, offset);
+}
+
+void CapCommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    RecordCommand(CapOpcode::DrawIndirectMulti, GetID(&buffer), offset, numCommands, stride);
+    instance.DrawIndirect(buffer, offset, numCommands, stride);
+}
+
+void CapCommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset)
+{
+    RecordCommand(CapOpcode::DrawIndexedIndirect, GetID(&buffer), offset);
+    instance.DrawIndexedIndirect(buffer, offset);
+}
+
+void CapCommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    RecordCommand(CapOpcode::DrawIndexedIndirectMulti, GetID(&buffer), offset, numCommands, stride);
+    instance.DrawIndexedIndirect(buffer, offset, numCommands, stride);
+}
+
+void CapCommandBuffer::DrawStreamOutput()
+{
+    RecordCommand(CapOpcode::DrawStreamOutput);
+    instance.DrawStreamOutput();
+}
+
+void CapCommandBuffer::DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ)
+{
+    RecordCommand(CapOpcode::DrawMeshTasks, numTasksX, numTasksY, numTasksZ);
+    instance.DrawMeshTasks(numTasksX, numTasksY, numTasksZ);
+}
+
+/* ----- Compute ----- */
+
+void CapCommandBuffer::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ)
+{
+    RecordCommand(CapOpcode::Dispatch, groupSizeX, groupSizeY, groupSizeZ);
+    instance.Dispatch(groupSizeX, groupSizeY, groupSizeZ);
+}
+
+void CapCommandBuffer::DispatchIndirect(Buffer& buffer, unsigned int offset)
+{
+    RecordCommand(CapOpcode::DispatchIndirect, GetID(&buffer), offset);
+    instance.DispatchIndirect(buffer, offset);
+}
+
+void CapCommandBuffer::Barrier(long barrierFlags)
+{
+    RecordCommand(CapOpcode::Barrier, barrierFlags);
+    instance.Barrier(barrierFlags);
+}
+
+void CapCommandBuffer::StorageBarrier(Buffer& buffer)
+{
+    RecordCommand(CapOpcode::StorageBarrier, GetID(&buffer));
+    instance.StorageBarrier(buffer);
+}
+
+/* ----- Command Recording ----- */
+
+void CapCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    auto& commandBufferCap = LLGL_CAST(CapCommandBuffer&, deferredCommandBuffer);
+    RecordCommand(CapOpcode::Execute, commandBufferCap.id);
+    instance.Execute(commandBufferCap.instance);
+}
+
+void CapCommandBuffer::Reset()
+{
+    RecordCommand(CapOpcode::Reset);
+    instance.Reset();
+}
+
+/* ----- Misc ----- */
+
+void CapCommandBuffer::Signal(Fence& fence)
+{
+    RecordCommand(CapOpcode::Signal, GetID(&fence));
+    instance.Signal(fence);
+}
+
+void CapCommandBuffer::SyncGPU()
+{
+    RecordCommand(CapOpcode::SyncGPU);
+    instance.SyncGPU();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint32_t CapCommandBuffer::GetID(const void* object)
+{
+    return recorder_.GetID(object);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
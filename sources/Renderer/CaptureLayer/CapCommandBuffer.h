@@ -0,0 +1,206 @@
+/*
+ * CapCommandBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_COMMAND_BUFFER_H
+#define LLGL_CAP_COMMAND_BUFFER_H
+
+
+#include <LLGL/CommandBuffer.h>
+#include "CapRecorder.h"
+
+
+namespace LLGL
+{
+
+
+class CapCommandBuffer : public CommandBuffer
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        CapCommandBuffer(CommandBuffer& instance, CapRecorder& recorder);
+
+        /* ----- Configuration ----- */
+
+        void SetGraphicsAPIDependentState(const GraphicsAPIDependentStateDescriptor& state) override;
+
+        void SetViewport(const Viewport& viewport) override;
+        void SetViewportArray(unsigned int numViewports, const Viewport* viewportArray) override;
+
+        void SetScissor(const Scissor& scissor) override;
+        void SetScissorArray(unsigned int numScissors, const Scissor* scissorArray) override;
+
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetDepthBounds(float minDepth, float maxDepth) override;
+
+        void SetClearColor(const ColorRGBAf& color) override;
+        void SetClearDepth(float depth) override;
+        void SetClearStencil(int stencil) override;
+
+        void Clear(long flags) override;
+        void ClearTarget(unsigned int targetIndex, const LLGL::ColorRGBAf& color) override;
+
+        /* ----- Buffers ------ */
+
+        void SetVertexBuffer(Buffer& buffer, unsigned int offset = 0) override;
+        void SetVertexBufferArray(BufferArray& bufferArray) override;
+
+        void SetIndexBuffer(Buffer& buffer, unsigned int offset = 0) override;
+        
+        void SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        
+        void SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+
+        void ResetBufferCounter(Buffer& buffer, unsigned int value = 0) override;
+        void CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer) override;
+
+        void SetStreamOutputBuffer(Buffer& buffer) override;
+        void SetStreamOutputBufferArray(BufferArray& bufferArray) override;
+
+        void BeginStreamOutput(const PrimitiveType primitiveType) override;
+        void EndStreamOutput() override;
+
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
+        /* ----- Textures ----- */
+
+        void SetTexture(Texture& texture, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetTextureArray(TextureArray& textureArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+
+        /* ----- Sampler States ----- */
+
+        void SetSampler(Sampler& sampler, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+
+        /* ----- Resource Heaps ----- */
+
+        void SetResourceHeap(ResourceHeap& resourceHeap) override;
+
+        /* ----- Render Targets ----- */
+
+        void SetRenderTarget(RenderTarget& renderTarget) override;
+        void SetRenderTarget(RenderContext& renderContext) override;
+
+        /* ----- Render Passes ----- */
+
+        void BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc) override;
+        void BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc) override;
+
+        void EndRenderPass() override;
+
+        /* ----- Pipeline States ----- */
+
+        void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
+        void SetComputePipeline(ComputePipeline& computePipeline) override;
+
+        void SetPushConstants(unsigned int offset, unsigned int size, const void* data) override;
+
+        void SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances) override;
+
+        /* ----- Queries ----- */
+
+        void BeginQuery(Query& query) override;
+        void EndQuery(Query& query) override;
+
+        bool QueryResult(Query& query, std::uint64_t& result) override;
+        bool QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results) override;
+        bool QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result) override;
+
+        void ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset) override;
+
+        void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
+        void EndRenderCondition() override;
+
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size) override;
+        void CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType) override;
+
+        /* ----- Drawing ----- */
+
+        void Draw(unsigned int numVertices, unsigned int firstVertex) override;
+
+        void DrawIndexed(unsigned int numVertices, unsigned int firstIndex) override;
+        void DrawIndexed(unsigned int numVertices, unsigned int firstIndex, int vertexOffset) override;
+
+        void DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances) override;
+        void DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset) override;
+
+        void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex) override;
+        void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset) override;
+        void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset) override;
+
+        void DrawIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ) override;
+
+        /* ----- Compute ----- */
+
+        void Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ) override;
+        void DispatchIndirect(Buffer& buffer, unsigned int offset) override;
+
+        void Barrier(long barrierFlags) override;
+        void StorageBarrier(Buffer& buffer) override;
+
+        /* ----- Command Recording ----- */
+
+        void Execute(CommandBuffer& deferredCommandBuffer) override;
+
+        void Reset() override;
+
+        /* ----- Misc ----- */
+
+        void Signal(Fence& fence) override;
+
+        void SyncGPU() override;
+
+        /* ----- Capture members ----- */
+
+        CommandBuffer&  instance;
+        std::uint32_t   id          = 0;
+
+    private:
+
+        // Records a command of this command buffer with the specified arguments.
+        template <typename... TArgs>
+        void RecordCommand(const CapOpcode opcode, const TArgs&... args)
+        {
+            recorder_.Record(opcode, id, args...);
+        }
+
+        // Returns the ID of the specified object.
+        std::uint32_t GetID(const void* object);
+
+        CapRecorder&    recorder_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,359 @@
+/*
+ * CapFormat.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapFormat.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/*
+ * CapWriter class
+ */
+
+// Size of the record header, i.e. the opcode (16 bits) and the payload size (32 bits).
+static const std::size_t g_capRecordHeaderSize = sizeof(std::uint16_t) + sizeof(std::uint32_t);
+
+CapWriter::CapWriter(const CapOpcode opcode)
+{
+    data_.reserve(64);
+    Write(static_cast<std::uint16_t>(opcode));
+    Write(std::uint32_t(0));
+}
+
+void CapWriter::WriteData(const void* data, std::size_t size)
+{
+    Write(static_cast<std::uint32_t>(size));
+    WriteRaw(data, size);
+}
+
+void CapWriter::WriteString(const std::string& str)
+{
+    WriteData(str.data(), str.size());
+}
+
+const std::vector<char>& CapWriter::Finish()
+{
+    auto payloadSize = static_cast<std::uint32_t>(data_.size() - g_capRecordHeaderSize);
+    std::memcpy(&data_[sizeof(std::uint16_t)], &payloadSize, sizeof(payloadSize));
+    return data_;
+}
+
+void CapWriter::WriteRaw(const void* data, std::size_t size)
+{
+    if (size > 0)
+    {
+        auto bytes = reinterpret_cast<const char*>(data);
+        data_.insert(data_.end(), bytes, bytes + size);
+    }
+}
+
+
+/*
+ * CapReader class
+ */
+
+CapReader::CapReader(const char* data, std::size_t size) :
+    data_ { data },
+    size_ { size }
+{
+}
+
+const char* CapReader::ReadData(std::size_t& size)
+{
+    size = Read<std::uint32_t>();
+    return Advance(size);
+}
+
+std::string CapReader::ReadString()
+{
+    std::size_t size = 0;
+    auto data = ReadData(size);
+    return std::string(data, size);
+}
+
+void CapReader::ReadRaw(void* data, std::size_t size)
+{
+    std::memcpy(data, Advance(size), size);
+}
+
+const char* CapReader::Advance(std::size_t size)
+{
+    if (size > size_ - pos_)
+        throw std::runtime_error("capture trace record is truncated");
+    auto ptr = data_ + pos_;
+    pos_ += size;
+    return ptr;
+}
+
+
+/*
+ * Global functions
+ */
+
+static std::size_t GetImageDataSize(const ImageDescriptor& imageDesc, std::size_t numTexels)
+{
+    if (IsCompressedFormat(imageDesc.format))
+        return imageDesc.compressedSize;
+    else
+        return numTexels * imageDesc.GetElementSize();
+}
+
+std::size_t GetCapImageDataSize(const TextureDescriptor& textureDesc, const ImageDescriptor& imageDesc)
+{
+    std::size_t numTexels = 0;
+
+    switch (textureDesc.type)
+    {
+        case TextureType::Texture1D:
+            numTexels = textureDesc.texture1D.width;
+            break;
+        case TextureType::Texture1DArray:
+            numTexels = textureDesc.texture1D.width * textureDesc.texture1D.layers;
+            break;
+        case TextureType::Texture2D:
+            numTexels = textureDesc.texture2D.width * textureDesc.texture2D.height;
+            break;
+        case TextureType::Texture2DArray:
+            numTexels = textureDesc.texture2D.width * textureDesc.texture2D.height * textureDesc.texture2D.layers;
+            break;
+        case TextureType::Texture3D:
+            numTexels = textureDesc.texture3D.width * textureDesc.texture3D.height * textureDesc.texture3D.depth;
+            break;
+        case TextureType::TextureCube:
+            numTexels = textureDesc.textureCube.width * textureDesc.textureCube.height * 6;
+            break;
+        case TextureType::TextureCubeArray:
+            numTexels = textureDesc.textureCube.width * textureDesc.textureCube.height * textureDesc.textureCube.layers * 6;
+            break;
+        case TextureType::Texture2DMS:
+        case TextureType::Texture2DMSArray:
+            return 0;
+    }
+
+    return GetImageDataSize(imageDesc, numTexels);
+}
+
+std::size_t GetCapImageDataSize(const TextureType type, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    std::size_t numTexels = 0;
+
+    switch (type)
+    {
+        case TextureType::Texture1D:
+            numTexels = subTextureDesc.texture1D.width;
+            break;
+        case TextureType::Texture1DArray:
+            numTexels = subTextureDesc.texture1D.width * subTextureDesc.texture1D.layers;
+            break;
+        case TextureType::Texture2D:
+            numTexels = subTextureDesc.texture2D.width * subTextureDesc.texture2D.height;
+            break;
+        case TextureType::Texture2DArray:
+            numTexels = subTextureDesc.texture2D.width * subTextureDesc.texture2D.height * subTextureDesc.texture2D.layers;
+            break;
+        case TextureType::Texture3D:
+            numTexels = subTextureDesc.texture3D.width * subTextureDesc.texture3D.height * subTextureDesc.texture3D.depth;
+            break;
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            numTexels = subTextureDesc.textureCube.width * subTextureDesc.textureCube.height * subTextureDesc.textureCube.cubeFaces;
+            break;
+        case TextureType::Texture2DMS:
+        case TextureType::Texture2DMSArray:
+            return 0;
+    }
+
+    return GetImageDataSize(imageDesc, numTexels);
+}
+
+void WriteCapImage(CapWriter& writer, const ImageDescriptor& imageDesc, std::size_t dataSize)
+{
+    writer.WriteAll(imageDesc.format, imageDesc.dataType, imageDesc.compressedSize);
+    writer.WriteData(imageDesc.buffer, (imageDesc.buffer != nullptr ? dataSize : 0));
+}
+
+void ReadCapImage(CapReader& reader, ImageDescriptor& imageDesc)
+{
+    reader.Read(imageDesc.format);
+    reader.Read(imageDesc.dataType);
+    reader.Read(imageDesc.compressedSize);
+
+    std::size_t dataSize = 0;
+    imageDesc.buffer = reader.ReadData(dataSize);
+    if (dataSize == 0)
+        imageDesc.buffer = nullptr;
+}
+
+void WriteCapVertexFormat(CapWriter& writer, const VertexFormat& vertexFormat)
+{
+    writer.Write(static_cast<std::uint32_t>(vertexFormat.attributes.size()));
+    for (const auto& attrib : vertexFormat.attributes)
+    {
+        writer.WriteString(attrib.name);
+        writer.WriteAll(attrib.vectorType, attrib.instanceDivisor, attrib.conversion, attrib.offset, attrib.semanticIndex, attrib.inputSlot);
+    }
+    writer.Write(vertexFormat.stride);
+}
+
+void ReadCapVertexFormat(CapReader& reader, VertexFormat& vertexFormat)
+{
+    vertexFormat.attributes.resize(reader.Read<std::uint32_t>());
+    for (auto& attrib : vertexFormat.attributes)
+    {
+        attrib.name = reader.ReadString();
+        reader.Read(attrib.vectorType);
+        reader.Read(attrib.instanceDivisor);
+        reader.Read(attrib.conversion);
+        reader.Read(attrib.offset);
+        reader.Read(attrib.semanticIndex);
+        reader.Read(attrib.inputSlot);
+    }
+    reader.Read(vertexFormat.stride);
+    vertexFormat.UpdateLayout();
+}
+
+void WriteCapBufferDescriptor(CapWriter& writer, const BufferDescriptor& desc)
+{
+    writer.WriteAll(desc.type, desc.size, desc.flags);
+    WriteCapVertexFormat(writer, desc.vertexBuffer.format);
+    writer.WriteAll(desc.indexBuffer.format.GetDataType(), desc.storageBuffer);
+}
+
+void ReadCapBufferDescriptor(CapReader& reader, BufferDescriptor& desc)
+{
+    reader.Read(desc.type);
+    reader.Read(desc.size);
+    reader.Read(desc.flags);
+    ReadCapVertexFormat(reader, desc.vertexBuffer.format);
+    desc.indexBuffer.format = IndexFormat(reader.Read<DataType>());
+    reader.Read(desc.storageBuffer);
+}
+
+void WriteCapShaderDescriptor(CapWriter& writer, const ShaderDescriptor& desc)
+{
+    writer.WriteString(desc.entryPoint);
+    writer.WriteString(desc.target);
+    writer.Write(desc.flags);
+
+    const auto& attributes = desc.streamOutput.format.attributes;
+    writer.Write(static_cast<std::uint32_t>(attributes.size()));
+    for (const auto& attrib : attributes)
+    {
+        writer.WriteString(attrib.name);
+        writer.WriteAll(attrib.stream, attrib.startComponent, attrib.components, attrib.semanticIndex, attrib.outputSlot);
+    }
+}
+
+void ReadCapShaderDescriptor(CapReader& reader, ShaderDescriptor& desc)
+{
+    desc.entryPoint = reader.ReadString();
+    desc.target     = reader.ReadString();
+    reader.Read(desc.flags);
+
+    auto& attributes = desc.streamOutput.format.attributes;
+    attributes.resize(reader.Read<std::uint32_t>());
+    for (auto& attrib : attributes)
+    {
+        attrib.name = reader.ReadString();
+        reader.Read(attrib.stream);
+        reader.Read(attrib.startComponent);
+        reader.Read(attrib.components);
+        reader.Read(attrib.semanticIndex);
+        reader.Read(attrib.outputSlot);
+    }
+}
+
+void WriteCapGraphicsPipelineDescriptor(CapWriter& writer, const GraphicsPipelineDescriptor& desc)
+{
+    writer.WriteAll(desc.primitiveTopology, desc.depth, desc.stencil, desc.rasterizer);
+    writer.WriteAll(desc.blend.blendEnabled, desc.blend.blendFactor);
+
+    writer.Write(static_cast<std::uint32_t>(desc.blend.targets.size()));
+    for (const auto& target : desc.blend.targets)
+    {
+        writer.WriteAll(target.srcColor, target.destColor, target.colorArithmetic, target.srcAlpha, target.destAlpha, target.alphaArithmetic);
+        writer.WriteAll(target.colorMask.r, target.colorMask.g, target.colorMask.b, target.colorMask.a);
+    }
+
+    writer.Write(desc.pushConstants);
+    writer.Write(desc.viewMask);
+}
+
+void ReadCapGraphicsPipelineDescriptor(CapReader& reader, GraphicsPipelineDescriptor& desc)
+{
+    reader.Read(desc.primitiveTopology);
+    reader.Read(desc.depth);
+    reader.Read(desc.stencil);
+    reader.Read(desc.rasterizer);
+    reader.Read(desc.blend.blendEnabled);
+    reader.Read(desc.blend.blendFactor);
+
+    desc.blend.targets.resize(reader.Read<std::uint32_t>());
+    for (auto& target : desc.blend.targets)
+    {
+        reader.Read(target.srcColor);
+        reader.Read(target.destColor);
+        reader.Read(target.colorArithmetic);
+        reader.Read(target.srcAlpha);
+        reader.Read(target.destAlpha);
+        reader.Read(target.alphaArithmetic);
+        reader.Read(target.colorMask.r);
+        reader.Read(target.colorMask.g);
+        reader.Read(target.colorMask.b);
+        reader.Read(target.colorMask.a);
+    }
+
+    reader.Read(desc.pushConstants);
+    reader.Read(desc.viewMask);
+}
+
+void WriteCapRenderPassDescriptor(CapWriter& writer, const RenderPassDescriptor& desc)
+{
+    writer.Write(static_cast<std::uint32_t>(desc.colorAttachments.size()));
+    for (const auto& attachment : desc.colorAttachments)
+        writer.WriteAll(attachment.loadOp, attachment.storeOp);
+    writer.WriteAll(desc.depthAttachment, desc.stencilAttachment);
+}
+
+void ReadCapRenderPassDescriptor(CapReader& reader, RenderPassDescriptor& desc)
+{
+    desc.colorAttachments.resize(reader.Read<std::uint32_t>());
+    for (auto& attachment : desc.colorAttachments)
+    {
+        reader.Read(attachment.loadOp);
+        reader.Read(attachment.storeOp);
+    }
+
+    reader.Read(desc.depthAttachment);
+    reader.Read(desc.stencilAttachment);
+}
+
+void WriteCapRenderContextDescriptor(CapWriter& writer, const RenderContextDescriptor& desc)
+{
+    writer.WriteAll(desc.vsync, desc.multiSampling, desc.videoMode, desc.profileOpenGL, desc.framesInFlight, desc.maxFrameLatency, desc.headless);
+}
+
+void ReadCapRenderContextDescriptor(CapReader& reader, RenderContextDescriptor& desc)
+{
+    reader.Read(desc.vsync);
+    reader.Read(desc.multiSampling);
+    reader.Read(desc.videoMode);
+    reader.Read(desc.profileOpenGL);
+    reader.Read(desc.framesInFlight);
+    reader.Read(desc.maxFrameLatency);
+    reader.Read(desc.headless);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
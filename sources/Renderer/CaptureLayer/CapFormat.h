@@ -0,0 +1,321 @@
+/*
+ * CapFormat.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_FORMAT_H
+#define LLGL_CAP_FORMAT_H
+
+
+#include <LLGL/BufferFlags.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/ShaderFlags.h>
+#include <LLGL/GraphicsPipelineFlags.h>
+#include <LLGL/RenderPassFlags.h>
+#include <LLGL/RenderContextDescriptor.h>
+#include <LLGL/Image.h>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+~~~~~~ INFO ~~~~~~
+A capture trace starts with a header of the magic number and the format version (see CapTraceHeader),
+which is followed by a sequence of records. Each record consists of its opcode (16 bits), the size of its payload (32 bits),
+and the payload. Objects are referenced by non-zero IDs, which are assigned in the order of their creation, and 0 denotes a null object.
+Plain structures are written in their native memory layout, so a trace can only be replayed on the same architecture it was captured on.
+*/
+
+static const std::uint32_t capTraceMagic    = 0x5443474C; // "LGCT"
+static const std::uint32_t capTraceVersion  = 8;
+
+struct CapTraceHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+};
+
+// Type of the objects that are referenced by a capture trace.
+enum class CapObjectType : std::uint8_t
+{
+    RenderContext,
+    CommandBuffer,
+    Buffer,
+    BufferArray,
+    Texture,
+    TextureArray,
+    Sampler,
+    SamplerArray,
+    ResourceHeap,
+    RenderTarget,
+    Shader,
+    ShaderProgram,
+    GraphicsPipeline,
+    ComputePipeline,
+    Query,
+    QueryArray,
+    Fence,
+};
+
+// Opcodes of the capture trace records. Records of objects start with the ID of the respective object.
+enum class CapOpcode : std::uint16_t
+{
+    /* ----- Render system ----- */
+    CreateRenderContext = 1,
+    CreateCommandBuffer,
+    ExecuteCommandBuffers,
+    CreateBuffer,
+    CreateBufferArray,
+    WriteBuffer,
+    WriteTransientConstantBuffer,
+    CreateTexture,
+    CreateTextureArray,
+    CreateTextureView,
+    CreateSparseTexture,
+    WriteTexture,
+    GenerateMips,
+    CommitSparseTexture,
+    CreateSampler,
+    CreateSamplerArray,
+    CreateResourceHeap,
+    CreateRenderTarget,
+    CreateShader,
+    CreateShaderProgram,
+    CreateGraphicsPipeline,
+    CreateComputePipeline,
+    CreateQuery,
+    CreateQueryArray,
+    CreateFence,
+    Release,
+
+    /* ----- Render context ----- */
+    Present = 100,
+    WaitForNextFrame,
+    SetVideoMode,
+    SetVsync,
+
+    /* ----- Render target ----- */
+    AttachDepthBuffer = 200,
+    AttachStencilBuffer,
+    AttachDepthStencilBuffer,
+    AttachTexture,
+    DetachAllAttachments,
+
+    /* ----- Shader and shader program ----- */
+    CompileShader = 300,
+    LoadShaderBinary,
+    AttachShader,
+    DetachAllShaders,
+    LinkShaders,
+    BuildInputLayout,
+    BindConstantBuffer,
+    BindStorageBuffer,
+    QueryShaderClassInstance,
+
+    /* ----- Command buffer ----- */
+    SetGraphicsAPIDependentState = 400,
+    SetViewport,
+    SetViewportArray,
+    SetScissor,
+    SetScissorArray,
+    SetShadingRate,
+    SetShadingRateImage,
+    SetDepthBounds,
+    SetClearColor,
+    SetClearDepth,
+    SetClearStencil,
+    Clear,
+    ClearTarget,
+    SetVertexBuffer,
+    SetVertexBufferArray,
+    SetIndexBuffer,
+    SetConstantBuffer,
+    SetConstantBufferArray,
+    SetConstantBufferRange,
+    SetStorageBuffer,
+    SetStorageBufferArray,
+    ResetBufferCounter,
+    CopyBufferCounter,
+    SetStreamOutputBuffer,
+    SetStreamOutputBufferArray,
+    BeginStreamOutput,
+    EndStreamOutput,
+    PauseStreamOutput,
+    ResumeStreamOutput,
+    SetTexture,
+    SetTextureArray,
+    SetSampler,
+    SetSamplerArray,
+    SetResourceHeap,
+    SetRenderTarget,
+    BeginRenderPass,
+    EndRenderPass,
+    SetGraphicsPipeline,
+    SetComputePipeline,
+    SetPushConstants,
+    BeginQuery,
+    EndQuery,
+    ResolveQueryData,
+    BeginRenderCondition,
+    EndRenderCondition,
+    CopyBuffer,
+    CopyTexture,
+    ResolveTexture,
+    CopyBufferToTexture,
+    Draw,
+    DrawIndexed,
+    DrawIndexedOffset,
+    DrawInstanced,
+    DrawInstancedOffset,
+    DrawIndexedInstanced,
+    DrawIndexedInstancedOffset,
+    DrawIndexedInstancedOffsets,
+    DrawIndirect,
+    DrawIndirectMulti,
+    DrawIndexedIndirect,
+    DrawIndexedIndirectMulti,
+    DrawStreamOutput,
+    DrawMeshTasks,
+    Dispatch,
+    DispatchIndirect,
+    Barrier,
+    StorageBarrier,
+    Execute,
+    Reset,
+    Signal,
+    SyncGPU,
+    SetShaderClassInstances,
+};
+
+// Writer for a single record of a capture trace.
+class CapWriter
+{
+
+    public:
+
+        // Begins a new record with the specified opcode.
+        CapWriter(const CapOpcode opcode);
+
+        // Writes the specified plain structure in its native memory layout.
+        template <typename T>
+        void Write(const T& value)
+        {
+            WriteRaw(&value, sizeof(T));
+        }
+
+        // Writes all the specified plain structures.
+        template <typename... TArgs>
+        void WriteAll(const TArgs&... args)
+        {
+            int expansion[] = { 0, (Write(args), 0)... };
+            (void)expansion;
+        }
+
+        // Writes the size (32 bits) and the content of the specified data block.
+        void WriteData(const void* data, std::size_t size);
+
+        void WriteString(const std::string& str);
+
+        // Returns the finished record, i.e. with the payload size in its header.
+        const std::vector<char>& Finish();
+
+    private:
+
+        void WriteRaw(const void* data, std::size_t size);
+
+        std::vector<char> data_;
+
+};
+
+// Reader for the payload of a single record of a capture trace.
+class CapReader
+{
+
+    public:
+
+        CapReader(const char* data, std::size_t size);
+
+        // Reads the specified plain structure in its native memory layout.
+        template <typename T>
+        void Read(T& value)
+        {
+            ReadRaw(&value, sizeof(T));
+        }
+
+        template <typename T>
+        T Read()
+        {
+            T value;
+            Read(value);
+            return value;
+        }
+
+        // Reads a data block that has been written with "CapWriter::WriteData", and returns a pointer into the payload.
+        const char* ReadData(std::size_t& size);
+
+        std::string ReadString();
+
+    private:
+
+        void ReadRaw(void* data, std::size_t size);
+
+        // Returns the current read position and advances it by the specified size, or throws if the payload is truncated.
+        const char* Advance(std::size_t size);
+
+        const char*         data_   = nullptr;
+        std::size_t         size_   = 0;
+        std::size_t         pos_    = 0;
+
+};
+
+
+/* ----- Functions ----- */
+
+// Returns the size (in bytes) of the image data for the initial content of the specified texture.
+std::size_t GetCapImageDataSize(const TextureDescriptor& textureDesc, const ImageDescriptor& imageDesc);
+
+// Returns the size (in bytes) of the image data for the specified sub-texture.
+std::size_t GetCapImageDataSize(const TextureType type, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc);
+
+// Writes the image descriptor with its image data of the specified size. The data size is written as 0 if the image buffer is null.
+void WriteCapImage(CapWriter& writer, const ImageDescriptor& imageDesc, std::size_t dataSize);
+void ReadCapImage(CapReader& reader, ImageDescriptor& imageDesc);
+
+void WriteCapVertexFormat(CapWriter& writer, const VertexFormat& vertexFormat);
+void ReadCapVertexFormat(CapReader& reader, VertexFormat& vertexFormat);
+
+void WriteCapBufferDescriptor(CapWriter& writer, const BufferDescriptor& desc);
+void ReadCapBufferDescriptor(CapReader& reader, BufferDescriptor& desc);
+
+void WriteCapShaderDescriptor(CapWriter& writer, const ShaderDescriptor& desc);
+void ReadCapShaderDescriptor(CapReader& reader, ShaderDescriptor& desc);
+
+// Writes the graphics pipeline descriptor without its shader program, which is written as object ID by the caller.
+void WriteCapGraphicsPipelineDescriptor(CapWriter& writer, const GraphicsPipelineDescriptor& desc);
+void ReadCapGraphicsPipelineDescriptor(CapReader& reader, GraphicsPipelineDescriptor& desc);
+
+void WriteCapRenderPassDescriptor(CapWriter& writer, const RenderPassDescriptor& desc);
+void ReadCapRenderPassDescriptor(CapReader& reader, RenderPassDescriptor& desc);
+
+// Writes the render context descriptor without its debug callback.
+void WriteCapRenderContextDescriptor(CapWriter& writer, const RenderContextDescriptor& desc);
+void ReadCapRenderContextDescriptor(CapReader& reader, RenderContextDescriptor& desc);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,75 @@
+/*
+ * CapRecorder.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapRecorder.h"
+
+
+namespace LLGL
+{
+
+
+CapRecorder::CapRecorder(RenderingCapture& capture) :
+    capture_ { capture }
+{
+}
+
+std::uint32_t CapRecorder::Register(const void* object)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto id = nextObjectID_++;
+    objectIDs_[object] = id;
+    return id;
+}
+
+std::uint32_t CapRecorder::Unregister(const void* object)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto it = objectIDs_.find(object);
+    if (it == objectIDs_.end())
+        return 0;
+    auto id = it->second;
+    objectIDs_.erase(it);
+    return id;
+}
+
+std::uint32_t CapRecorder::GetID(const void* object)
+{
+    if (object == nullptr)
+        return 0;
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto it = objectIDs_.find(object);
+    return (it != objectIDs_.end() ? it->second : 0);
+}
+
+std::uint32_t CapRecorder::GetOrRegisterID(const void* object)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto it = objectIDs_.find(object);
+    if (it != objectIDs_.end())
+        return it->second;
+    auto id = nextObjectID_++;
+    objectIDs_[object] = id;
+    return id;
+}
+
+void CapRecorder::Append(CapWriter& writer)
+{
+    const auto& data = writer.Finish();
+    capture_.AppendRecord(data.data(), data.size());
+}
+
+void CapRecorder::NextFrame()
+{
+    capture_.NextFrame();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,75 @@
+/*
+ * CapRecorder.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_RECORDER_H
+#define LLGL_CAP_RECORDER_H
+
+
+#include <LLGL/RenderingCapture.h>
+#include "CapFormat.h"
+#include <unordered_map>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+// Records the trace of the capture layer and assigns the IDs of all captured objects.
+class CapRecorder
+{
+
+    public:
+
+        CapRecorder(RenderingCapture& capture);
+
+        // Assigns a new ID to the specified object.
+        std::uint32_t Register(const void* object);
+
+        // Removes the ID of the specified object and returns it, or 0 if the object has not been registered.
+        std::uint32_t Unregister(const void* object);
+
+        // Returns the ID of the specified object, or 0 if the object is null or has not been registered.
+        std::uint32_t GetID(const void* object);
+
+        // Returns the ID of the specified object, and registers it if it has not been registered yet.
+        std::uint32_t GetOrRegisterID(const void* object);
+
+        // Appends the finished record of the specified writer to the trace.
+        void Append(CapWriter& writer);
+
+        // Appends a record of the specified plain structures to the trace.
+        template <typename... TArgs>
+        void Record(const CapOpcode opcode, const TArgs&... args)
+        {
+            CapWriter writer { opcode };
+            writer.WriteAll(args...);
+            Append(writer);
+        }
+
+        // Increments the number of captured frames.
+        void NextFrame();
+
+    private:
+
+        RenderingCapture&                               capture_;
+
+        std::mutex                                      mutex_;
+        std::unordered_map<const void*, std::uint32_t>  objectIDs_;
+        std::uint32_t                                   nextObjectID_   = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,99 @@
+/*
+ * CapRenderContext.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapRenderContext.h"
+
+
+namespace LLGL
+{
+
+
+CapRenderContext::CapRenderContext(RenderContext& instance, CapRecorder& recorder) :
+    instance  { instance },
+    recorder_ { recorder }
+{
+    ShareSurfaceAndVideoMode(instance);
+}
+
+void CapRenderContext::Present()
+{
+    recorder_.Record(CapOpcode::Present, id);
+    recorder_.NextFrame();
+    instance.Present();
+}
+
+void CapRenderContext::PresentWithoutVsync()
+{
+    /* Recorded as regular presentation, since the Vsync wait does not affect the frame content */
+    recorder_.Record(CapOpcode::Present, id);
+    recorder_.NextFrame();
+    instance.PresentWithoutVsync();
+}
+
+void CapRenderContext::WaitForNextFrame()
+{
+    recorder_.Record(CapOpcode::WaitForNextFrame, id);
+    instance.WaitForNextFrame();
+}
+
+bool CapRenderContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    return instance.QueryFrameStatistics(stats);
+}
+
+bool CapRenderContext::IsOccluded() const
+{
+    return instance.IsOccluded();
+}
+
+bool CapRenderContext::TestPresent()
+{
+    /* Test presentations are not recorded, since they do not present any content */
+    return instance.TestPresent();
+}
+
+void CapRenderContext::CopyBackBuffer(Texture& dstTexture)
+{
+    /* Back buffer copies are not recorded, like all other read-backs */
+    instance.CopyBackBuffer(dstTexture);
+}
+
+/* ----- Configuration ----- */
+
+void CapRenderContext::SetVideoMode(const VideoModeDescriptor& videoModeDesc)
+{
+    recorder_.Record(CapOpcode::SetVideoMode, id, videoModeDesc);
+    instance.SetVideoMode(videoModeDesc);
+    RenderContext::SetVideoMode(videoModeDesc);
+}
+
+void CapRenderContext::SetVsync(const VsyncDescriptor& vsyncDesc)
+{
+    recorder_.Record(CapOpcode::SetVsync, id, vsyncDesc);
+    instance.SetVsync(vsyncDesc);
+}
+
+void CapRenderContext::SetTargetFrameRate(unsigned int frameRate)
+{
+    /* Frame rate limit is not recorded, since the replay is meant to run as fast as possible */
+    instance.SetTargetFrameRate(frameRate);
+    RenderContext::SetTargetFrameRate(frameRate);
+}
+
+void CapRenderContext::SetBackgroundFrameRate(unsigned int frameRate)
+{
+    /* Background frame rate is not recorded for the same reason as the target frame rate */
+    instance.SetBackgroundFrameRate(frameRate);
+    RenderContext::SetBackgroundFrameRate(frameRate);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
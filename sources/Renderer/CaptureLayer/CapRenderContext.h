@@ -0,0 +1,68 @@
+/*
+ * CapRenderContext.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_RENDER_CONTEXT_H
+#define LLGL_CAP_RENDER_CONTEXT_H
+
+
+#include <LLGL/RenderContext.h>
+#include "CapRecorder.h"
+
+
+namespace LLGL
+{
+
+
+class CapRenderContext : public RenderContext
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        CapRenderContext(RenderContext& instance, CapRecorder& recorder);
+
+        void Present() override;
+        void PresentWithoutVsync() override;
+
+        void WaitForNextFrame() override;
+
+        bool QueryFrameStatistics(FrameStatistics& stats) override;
+
+        bool IsOccluded() const override;
+        bool TestPresent() override;
+
+        void CopyBackBuffer(Texture& dstTexture) override;
+
+        /* ----- Configuration ----- */
+
+        void SetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
+        void SetVsync(const VsyncDescriptor& vsyncDesc) override;
+
+        void SetTargetFrameRate(unsigned int frameRate) override;
+        void SetBackgroundFrameRate(unsigned int frameRate) override;
+
+        /* ----- Capture members ----- */
+
+        RenderContext&  instance;
+        std::uint32_t   id          = 0;
+
+    private:
+
+        CapRecorder&    recorder_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,705 @@
+/*
+ * CapRenderSystem.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapRenderSystem.h"
+#include "../../Core/Helper.h"
+#include "../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+/*
+~~~~~~ INFO ~~~~~~
+This is the capture layer render system.
+It is a wrapper for the actual render system to record all function calls into the trace of a RenderingCapture (see CapFormat.h).
+Each call is recorded before it is passed on to the actual render system, so the trace has the same order of calls on all threads.
+Only those objects that have functions which must be recorded are wrapped (render contexts, command buffers, render targets, shaders, and shader programs),
+all other objects are passed on unchanged and are only identified by their ID.
+*/
+
+CapRenderSystem::CapRenderSystem(const std::shared_ptr<RenderSystem>& instance, RenderingCapture& capture) :
+    instance_ { instance },
+    recorder_ { capture  }
+{
+    SetVideoAdapters(instance_->GetVideoAdapters());
+}
+
+CapRenderSystem::~CapRenderSystem()
+{
+}
+
+void CapRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
+{
+    RenderSystem::SetConfiguration(config);
+    instance_->SetConfiguration(config);
+}
+
+/* ----- Render Context ----- */
+
+RenderContext* CapRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
+{
+    auto renderContextInstance = instance_->CreateRenderContext(desc, surface);
+
+    SetRendererInfo(instance_->GetRendererInfo());
+    SetRenderingCaps(instance_->GetRenderingCaps());
+
+    auto renderContextCap = TakeOwnership(renderContexts_, MakeUnique<CapRenderContext>(*renderContextInstance, recorder_));
+    renderContextCap->id = recorder_.Register(renderContextCap);
+
+    CapWriter writer { CapOpcode::CreateRenderContext };
+    {
+        writer.Write(renderContextCap->id);
+        WriteCapRenderContextDescriptor(writer, desc);
+    }
+    recorder_.Append(writer);
+
+    return renderContextCap;
+}
+
+void CapRenderSystem::Release(RenderContext& renderContext)
+{
+    ReleaseCap(renderContexts_, renderContext);
+}
+
+/* ----- Command buffers ----- */
+
+CommandBuffer* CapRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
+{
+    auto commandBufferCap = TakeOwnership(
+        commandBuffers_,
+        MakeUnique<CapCommandBuffer>(*instance_->CreateCommandBuffer(desc), recorder_)
+    );
+
+    commandBufferCap->id = recorder_.Register(commandBufferCap);
+    recorder_.Record(CapOpcode::CreateCommandBuffer, commandBufferCap->id, desc);
+
+    return commandBufferCap;
+}
+
+void CapRenderSystem::ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray)
+{
+    /* Create temporary command buffer array with command buffer instances */
+    std::vector<CommandBuffer*> commandBufferInstanceArray;
+    commandBufferInstanceArray.reserve(numCommandBuffers);
+
+    std::vector<std::uint32_t> commandBufferIDs;
+    commandBufferIDs.reserve(numCommandBuffers);
+
+    for (unsigned int i = 0; i < numCommandBuffers; ++i)
+    {
+        auto commandBufferCap = LLGL_CAST(CapCommandBuffer*, commandBufferArray[i]);
+        commandBufferInstanceArray.push_back(&(commandBufferCap->instance));
+        commandBufferIDs.push_back(commandBufferCap->id);
+    }
+
+    CapWriter writer { CapOpcode::ExecuteCommandBuffers };
+    {
+        writer.WriteData(commandBufferIDs.data(), commandBufferIDs.size() * sizeof(std::uint32_t));
+    }
+    recorder_.Append(writer);
+
+    instance_->ExecuteCommandBuffers(numCommandBuffers, commandBufferInstanceArray.data());
+}
+
+void CapRenderSystem::Release(CommandBuffer& commandBuffer)
+{
+    ReleaseCap(commandBuffers_, commandBuffer);
+}
+
+/* ----- Buffers ------ */
+
+Buffer* CapRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
+{
+    auto buffer = instance_->CreateBuffer(desc, initialData);
+    bufferSizes_[buffer] = desc.size;
+
+    CapWriter writer { CapOpcode::CreateBuffer };
+    {
+        writer.Write(recorder_.Register(buffer));
+        WriteCapBufferDescriptor(writer, desc);
+        writer.WriteData(initialData, (initialData != nullptr ? desc.size : 0));
+    }
+    recorder_.Append(writer);
+
+    return buffer;
+}
+
+BufferArray* CapRenderSystem::CreateBufferArray(unsigned int numBuffers, Buffer* const * bufferArray)
+{
+    auto bufferArrayInstance = instance_->CreateBufferArray(numBuffers, bufferArray);
+
+    std::vector<std::uint32_t> bufferIDs(numBuffers);
+    for (unsigned int i = 0; i < numBuffers; ++i)
+        bufferIDs[i] = recorder_.GetID(bufferArray[i]);
+
+    CapWriter writer { CapOpcode::CreateBufferArray };
+    {
+        writer.Write(recorder_.Register(bufferArrayInstance));
+        writer.WriteData(bufferIDs.data(), bufferIDs.size() * sizeof(std::uint32_t));
+    }
+    recorder_.Append(writer);
+
+    return bufferArrayInstance;
+}
+
+void CapRenderSystem::Release(Buffer& buffer)
+{
+    Unregister(&buffer);
+    bufferSizes_.erase(&buffer);
+    mappedBuffers_.erase(&buffer);
+    instance_->Release(buffer);
+}
+
+void CapRenderSystem::Release(BufferArray& bufferArray)
+{
+    Unregister(&bufferArray);
+    instance_->Release(bufferArray);
+}
+
+void CapRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    CapWriter writer { CapOpcode::WriteBuffer };
+    {
+        writer.WriteAll(recorder_.GetID(&buffer), static_cast<std::uint32_t>(offset));
+        writer.WriteData(data, dataSize);
+    }
+    recorder_.Append(writer);
+
+    instance_->WriteBuffer(buffer, data, dataSize, offset);
+}
+
+void* CapRenderSystem::MapBuffer(Buffer& buffer, const BufferCPUAccess access)
+{
+    auto data = instance_->MapBuffer(buffer, access);
+
+    /* Record content of buffers that are mapped for writing when they are unmapped */
+    if (data != nullptr && access != BufferCPUAccess::ReadOnly)
+        mappedBuffers_[&buffer] = { data, 0, bufferSizes_[&buffer] };
+
+    return data;
+}
+
+void* CapRenderSystem::MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags)
+{
+    auto data = instance_->MapBufferRange(buffer, offset, size, access, mapFlags);
+
+    /* Record content of the mapped range only, since the remaining buffer content is not affected */
+    if (data != nullptr && access != BufferCPUAccess::ReadOnly)
+        mappedBuffers_[&buffer] = { data, static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(size) };
+
+    return data;
+}
+
+void CapRenderSystem::FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size)
+{
+    instance_->FlushMappedBufferRange(buffer, offset, size);
+}
+
+void CapRenderSystem::UnmapBuffer(Buffer& buffer)
+{
+    auto it = mappedBuffers_.find(&buffer);
+    if (it != mappedBuffers_.end())
+    {
+        /* Record content of the mapped range as buffer write */
+        CapWriter writer { CapOpcode::WriteBuffer };
+        {
+            writer.WriteAll(recorder_.GetID(&buffer), it->second.offset);
+            writer.WriteData(it->second.data, it->second.size);
+        }
+        recorder_.Append(writer);
+
+        mappedBuffers_.erase(it);
+    }
+
+    instance_->UnmapBuffer(buffer);
+}
+
+TransientBufferRange CapRenderSystem::WriteTransientConstantBuffer(const void* data, std::size_t dataSize)
+{
+    auto range = instance_->WriteTransientConstantBuffer(data, dataSize);
+
+    /* Register ring buffer of the instance on its first use, so the replay can map it to its own ring buffer */
+    auto bufferID = (range.buffer != nullptr ? recorder_.GetOrRegisterID(range.buffer) : 0);
+
+    CapWriter writer { CapOpcode::WriteTransientConstantBuffer };
+    {
+        writer.WriteData(data, dataSize);
+        writer.WriteAll(bufferID, range.offset);
+    }
+    recorder_.Append(writer);
+
+    return range;
+}
+
+/* ----- Textures ----- */
+
+Texture* CapRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
+{
+    auto texture = instance_->CreateTexture(textureDesc, imageDesc);
+    RecordCreateTexture(CapOpcode::CreateTexture, texture, textureDesc, imageDesc);
+    return texture;
+}
+
+TextureArray* CapRenderSystem::CreateTextureArray(unsigned int numTextures, Texture* const * textureArray)
+{
+    auto textureArrayInstance = instance_->CreateTextureArray(numTextures, textureArray);
+
+    std::vector<std::uint32_t> textureIDs(numTextures);
+    for (unsigned int i = 0; i < numTextures; ++i)
+        textureIDs[i] = recorder_.GetID(textureArray[i]);
+
+    CapWriter writer { CapOpcode::CreateTextureArray };
+    {
+        writer.Write(recorder_.Register(textureArrayInstance));
+        writer.WriteData(textureIDs.data(), textureIDs.size() * sizeof(std::uint32_t));
+    }
+    recorder_.Append(writer);
+
+    return textureArrayInstance;
+}
+
+Texture* CapRenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto sharedTextureID = recorder_.GetID(&sharedTexture);
+    auto textureView = instance_->CreateTextureView(sharedTexture, textureViewDesc);
+    recorder_.Record(CapOpcode::CreateTextureView, recorder_.Register(textureView), sharedTextureID, textureViewDesc);
+    return textureView;
+}
+
+Texture* CapRenderSystem::CreateSparseTexture(const TextureDescriptor& textureDesc)
+{
+    auto texture = instance_->CreateSparseTexture(textureDesc);
+    RecordCreateTexture(CapOpcode::CreateSparseTexture, texture, textureDesc, nullptr);
+    return texture;
+}
+
+void CapRenderSystem::Release(Texture& texture)
+{
+    Unregister(&texture);
+    instance_->Release(texture);
+}
+
+void CapRenderSystem::Release(TextureArray& textureArray)
+{
+    Unregister(&textureArray);
+    instance_->Release(textureArray);
+}
+
+TextureDescriptor CapRenderSystem::QueryTextureDescriptor(const Texture& texture)
+{
+    return instance_->QueryTextureDescriptor(texture);
+}
+
+void CapRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    CapWriter writer { CapOpcode::WriteTexture };
+    {
+        writer.WriteAll(recorder_.GetID(&texture), subTextureDesc);
+        WriteCapImage(writer, imageDesc, GetCapImageDataSize(texture.GetType(), subTextureDesc, imageDesc));
+    }
+    recorder_.Append(writer);
+
+    instance_->WriteTexture(texture, subTextureDesc, imageDesc);
+}
+
+void CapRenderSystem::ReadTexture(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType, void* buffer)
+{
+    instance_->ReadTexture(texture, mipLevel, imageFormat, dataType, buffer);
+}
+
+void CapRenderSystem::GenerateMips(Texture& texture)
+{
+    recorder_.Record(CapOpcode::GenerateMips, recorder_.GetID(&texture));
+    instance_->GenerateMips(texture);
+}
+
+std::uint64_t CapRenderSystem::GetBindlessTextureHandle(Texture& texture, Sampler* sampler)
+{
+    /* Bindless handles are only meaningful within the process, so they are not recorded */
+    return instance_->GetBindlessTextureHandle(texture, sampler);
+}
+
+void CapRenderSystem::CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit)
+{
+    recorder_.Record(CapOpcode::CommitSparseTexture, recorder_.GetID(&texture), region, commit);
+    instance_->CommitSparseTexture(texture, region, commit);
+}
+
+bool CapRenderSystem::IsSparseTextureResident(const Texture& texture, const TextureRegion& region)
+{
+    return instance_->IsSparseTextureResident(texture, region);
+}
+
+Gs::Vector3ui CapRenderSystem::QuerySparseTexturePageSize(const Texture& texture)
+{
+    return instance_->QuerySparseTexturePageSize(texture);
+}
+
+/* ----- Sampler States ---- */
+
+Sampler* CapRenderSystem::CreateSampler(const SamplerDescriptor& desc)
+{
+    auto sampler = instance_->CreateSampler(desc);
+    recorder_.Record(CapOpcode::CreateSampler, recorder_.Register(sampler), desc);
+    return sampler;
+}
+
+SamplerArray* CapRenderSystem::CreateSamplerArray(unsigned int numSamplers, Sampler* const * samplerArray)
+{
+    auto samplerArrayInstance = instance_->CreateSamplerArray(numSamplers, samplerArray);
+
+    std::vector<std::uint32_t> samplerIDs(numSamplers);
+    for (unsigned int i = 0; i < numSamplers; ++i)
+        samplerIDs[i] = recorder_.GetID(samplerArray[i]);
+
+    CapWriter writer { CapOpcode::CreateSamplerArray };
+    {
+        writer.Write(recorder_.Register(samplerArrayInstance));
+        writer.WriteData(samplerIDs.data(), samplerIDs.size() * sizeof(std::uint32_t));
+    }
+    recorder_.Append(writer);
+
+    return samplerArrayInstance;
+}
+
+void CapRenderSystem::Release(Sampler& sampler)
+{
+    Unregister(&sampler);
+    instance_->Release(sampler);
+}
+
+void CapRenderSystem::Release(SamplerArray& samplerArray)
+{
+    Unregister(&samplerArray);
+    instance_->Release(samplerArray);
+}
+
+/* ----- Resource Heaps ----- */
+
+ResourceHeap* CapRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    auto resourceHeap = instance_->CreateResourceHeap(desc);
+
+    CapWriter writer { CapOpcode::CreateResourceHeap };
+    {
+        writer.Write(recorder_.Register(resourceHeap));
+        writer.Write(static_cast<std::uint32_t>(desc.resourceViews.size()));
+        for (const auto& resourceView : desc.resourceViews)
+        {
+            writer.WriteAll(resourceView.type, resourceView.slot, resourceView.shaderStageFlags);
+            writer.WriteAll(recorder_.GetID(resourceView.buffer), recorder_.GetID(resourceView.texture), recorder_.GetID(resourceView.sampler));
+        }
+    }
+    recorder_.Append(writer);
+
+    return resourceHeap;
+}
+
+void CapRenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    Unregister(&resourceHeap);
+    instance_->Release(resourceHeap);
+}
+
+/* ----- Render Targets ----- */
+
+RenderTarget* CapRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
+{
+    auto renderTargetCap = TakeOwnership(
+        renderTargets_,
+        MakeUnique<CapRenderTarget>(*instance_->CreateRenderTarget(desc), recorder_)
+    );
+
+    renderTargetCap->id = recorder_.Register(renderTargetCap);
+    recorder_.Record(CapOpcode::CreateRenderTarget, renderTargetCap->id, desc);
+
+    return renderTargetCap;
+}
+
+void CapRenderSystem::Release(RenderTarget& renderTarget)
+{
+    ReleaseCap(renderTargets_, renderTarget);
+}
+
+/* ----- Shader ----- */
+
+Shader* CapRenderSystem::CreateShader(const ShaderType type)
+{
+    auto shaderCap = TakeOwnership(shaders_, MakeUnique<CapShader>(*instance_->CreateShader(type), type, recorder_));
+
+    shaderCap->id = recorder_.Register(shaderCap);
+    recorder_.Record(CapOpcode::CreateShader, shaderCap->id, type);
+
+    return shaderCap;
+}
+
+ShaderProgram* CapRenderSystem::CreateShaderProgram()
+{
+    auto shaderProgramCap = TakeOwnership(shaderPrograms_, MakeUnique<CapShaderProgram>(*instance_->CreateShaderProgram(), recorder_));
+
+    shaderProgramCap->id = recorder_.Register(shaderProgramCap);
+    recorder_.Record(CapOpcode::CreateShaderProgram, shaderProgramCap->id);
+
+    return shaderProgramCap;
+}
+
+void CapRenderSystem::Release(Shader& shader)
+{
+    ReleaseCap(shaders_, shader);
+}
+
+void CapRenderSystem::Release(ShaderProgram& shaderProgram)
+{
+    ReleaseCap(shaderPrograms_, shaderProgram);
+}
+
+/* ----- Pipeline States ----- */
+
+GraphicsPipeline* CapRenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
+{
+    /* Create temporary descriptor with shader program instance */
+    auto instanceDesc = desc;
+    std::uint32_t shaderProgramID = 0;
+
+    if (desc.shaderProgram != nullptr)
+    {
+        auto shaderProgramCap = LLGL_CAST(CapShaderProgram*, desc.shaderProgram);
+        instanceDesc.shaderProgram  = &(shaderProgramCap->instance);
+        shaderProgramID             = shaderProgramCap->id;
+    }
+
+    auto graphicsPipeline = instance_->CreateGraphicsPipeline(instanceDesc);
+
+    CapWriter writer { CapOpcode::CreateGraphicsPipeline };
+    {
+        writer.WriteAll(recorder_.Register(graphicsPipeline), shaderProgramID);
+        WriteCapGraphicsPipelineDescriptor(writer, desc);
+    }
+    recorder_.Append(writer);
+
+    return graphicsPipeline;
+}
+
+ComputePipeline* CapRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
+{
+    /* Create temporary descriptor with shader program instance */
+    auto instanceDesc = desc;
+    std::uint32_t shaderProgramID = 0;
+
+    if (desc.shaderProgram != nullptr)
+    {
+        auto shaderProgramCap = LLGL_CAST(CapShaderProgram*, desc.shaderProgram);
+        instanceDesc.shaderProgram  = &(shaderProgramCap->instance);
+        shaderProgramID             = shaderProgramCap->id;
+    }
+
+    auto computePipeline = instance_->CreateComputePipeline(instanceDesc);
+    recorder_.Record(CapOpcode::CreateComputePipeline, recorder_.Register(computePipeline), shaderProgramID);
+
+    return computePipeline;
+}
+
+void CapRenderSystem::Release(GraphicsPipeline& graphicsPipeline)
+{
+    Unregister(&graphicsPipeline);
+    instance_->Release(graphicsPipeline);
+}
+
+void CapRenderSystem::Release(ComputePipeline& computePipeline)
+{
+    Unregister(&computePipeline);
+    instance_->Release(computePipeline);
+}
+
+bool CapRenderSystem::LoadPipelineCache(const std::vector<char>& data)
+{
+    return instance_->LoadPipelineCache(data);
+}
+
+std::vector<char> CapRenderSystem::SavePipelineCache()
+{
+    return instance_->SavePipelineCache();
+}
+
+/* ----- Queries ----- */
+
+Query* CapRenderSystem::CreateQuery(const QueryDescriptor& desc)
+{
+    auto query = instance_->CreateQuery(desc);
+    recorder_.Record(CapOpcode::CreateQuery, recorder_.Register(query), desc);
+    return query;
+}
+
+QueryArray* CapRenderSystem::CreateQueryArray(unsigned int numQueries, Query* const * queryArray)
+{
+    auto queryArrayInstance = instance_->CreateQueryArray(numQueries, queryArray);
+
+    std::vector<std::uint32_t> queryIDs(numQueries);
+    for (unsigned int i = 0; i < numQueries; ++i)
+        queryIDs[i] = recorder_.GetID(queryArray[i]);
+
+    CapWriter writer { CapOpcode::CreateQueryArray };
+    {
+        writer.Write(recorder_.Register(queryArrayInstance));
+        writer.WriteData(queryIDs.data(), queryIDs.size() * sizeof(std::uint32_t));
+    }
+    recorder_.Append(writer);
+
+    return queryArrayInstance;
+}
+
+void CapRenderSystem::Release(Query& query)
+{
+    Unregister(&query);
+    instance_->Release(query);
+}
+
+void CapRenderSystem::Release(QueryArray& queryArray)
+{
+    Unregister(&queryArray);
+    instance_->Release(queryArray);
+}
+
+/* ----- Readbacks ----- */
+
+Readback* CapRenderSystem::ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType)
+{
+    return instance_->ReadTextureAsync(texture, mipLevel, imageFormat, dataType);
+}
+
+Readback* CapRenderSystem::ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize)
+{
+    return instance_->ReadBufferAsync(buffer, offset, dataSize);
+}
+
+void CapRenderSystem::Release(Readback& readback)
+{
+    instance_->Release(readback);
+}
+
+/* ----- Uploads ----- */
+
+/*
+Asynchronous writes are recorded as immediate writes, followed by the creation of the returned fence,
+since the replay does not depend on the timing of the GPU.
+*/
+
+Fence* CapRenderSystem::WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    CapWriter writer { CapOpcode::WriteBuffer };
+    {
+        writer.WriteAll(recorder_.GetID(&buffer), static_cast<std::uint32_t>(offset));
+        writer.WriteData(data, dataSize);
+    }
+    recorder_.Append(writer);
+
+    auto fence = instance_->WriteBufferAsync(buffer, data, dataSize, offset);
+    recorder_.Record(CapOpcode::CreateFence, recorder_.Register(fence));
+    return fence;
+}
+
+Fence* CapRenderSystem::WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    CapWriter writer { CapOpcode::WriteTexture };
+    {
+        writer.WriteAll(recorder_.GetID(&texture), subTextureDesc);
+        WriteCapImage(writer, imageDesc, GetCapImageDataSize(texture.GetType(), subTextureDesc, imageDesc));
+    }
+    recorder_.Append(writer);
+
+    auto fence = instance_->WriteTextureAsync(texture, subTextureDesc, imageDesc);
+    recorder_.Record(CapOpcode::CreateFence, recorder_.Register(fence));
+    return fence;
+}
+
+/* ----- Fences ----- */
+
+Fence* CapRenderSystem::CreateFence()
+{
+    auto fence = instance_->CreateFence();
+    recorder_.Record(CapOpcode::CreateFence, recorder_.Register(fence));
+    return fence;
+}
+
+void CapRenderSystem::Release(Fence& fence)
+{
+    Unregister(&fence);
+    instance_->Release(fence);
+}
+
+/* ----- Memory ----- */
+
+MemoryInfo CapRenderSystem::QueryMemoryInfo()
+{
+    return instance_->QueryMemoryInfo();
+}
+
+bool CapRenderSystem::SetResidency(Buffer& buffer, bool resident)
+{
+    return instance_->SetResidency(buffer, resident);
+}
+
+bool CapRenderSystem::SetResidency(Texture& texture, bool resident)
+{
+    return instance_->SetResidency(texture, resident);
+}
+
+bool CapRenderSystem::QueryClockCalibration(ClockCalibration& calibration)
+{
+    return instance_->QueryClockCalibration(calibration);
+}
+
+bool CapRenderSystem::ReportStateCacheStatistics(RenderingProfiler& profiler)
+{
+    return instance_->ReportStateCacheStatistics(profiler);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint32_t CapRenderSystem::Unregister(const void* object)
+{
+    auto id = recorder_.Unregister(object);
+    if (id != 0)
+        recorder_.Record(CapOpcode::Release, id);
+    return id;
+}
+
+template <typename T, typename TBase>
+void CapRenderSystem::ReleaseCap(HWObjectContainer<T>& cont, TBase& entry)
+{
+    auto& entryCap = LLGL_CAST(T&, entry);
+    Unregister(&entryCap);
+    instance_->Release(entryCap.instance);
+    RemoveFromUniqueSet(cont, &entry);
+}
+
+void CapRenderSystem::RecordCreateTexture(const CapOpcode opcode, const Texture* texture, const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
+{
+    CapWriter writer { opcode };
+    {
+        writer.WriteAll(recorder_.Register(texture), textureDesc);
+        if (opcode == CapOpcode::CreateTexture)
+        {
+            writer.Write(static_cast<std::uint8_t>(imageDesc != nullptr ? 1 : 0));
+            if (imageDesc != nullptr)
+                WriteCapImage(writer, *imageDesc, GetCapImageDataSize(textureDesc, *imageDesc));
+        }
+    }
+    recorder_.Append(writer);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
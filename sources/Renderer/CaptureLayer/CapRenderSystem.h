@@ -0,0 +1,220 @@
+/*
+ * CapRenderSystem.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_RENDER_SYSTEM_H
+#define LLGL_CAP_RENDER_SYSTEM_H
+
+
+#include <LLGL/RenderSystem.h>
+#include "CapRecorder.h"
+#include "CapRenderContext.h"
+#include "CapCommandBuffer.h"
+#include "CapRenderTarget.h"
+#include "CapShader.h"
+#include "CapShaderProgram.h"
+
+#include "../ContainerTypes.h"
+
+
+namespace LLGL
+{
+
+
+class CapRenderSystem : public RenderSystem
+{
+
+    public:
+
+        /* ----- Common ----- */
+
+        CapRenderSystem(const std::shared_ptr<RenderSystem>& instance, RenderingCapture& capture);
+        ~CapRenderSystem();
+
+        void SetConfiguration(const RenderSystemConfiguration& config) override;
+
+        /* ----- Render Context ------ */
+
+        RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
+
+        void Release(RenderContext& renderContext) override;
+
+        /* ----- Command buffers ----- */
+
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
+
+        void ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray) override;
+
+        void Release(CommandBuffer& commandBuffer) override;
+
+        /* ----- Buffers ------ */
+
+        Buffer* CreateBuffer(const BufferDescriptor& desc, const void* initialData = nullptr) override;
+        BufferArray* CreateBufferArray(unsigned int numBuffers, Buffer* const * bufferArray) override;
+
+        void Release(Buffer& buffer) override;
+        void Release(BufferArray& bufferArray) override;
+
+        void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
+
+        void* MapBuffer(Buffer& buffer, const BufferCPUAccess access) override;
+        void* MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags = 0) override;
+        void FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size) override;
+        void UnmapBuffer(Buffer& buffer) override;
+
+        TransientBufferRange WriteTransientConstantBuffer(const void* data, std::size_t dataSize) override;
+
+        /* ----- Textures ----- */
+
+        Texture* CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc = nullptr) override;
+        TextureArray* CreateTextureArray(unsigned int numTextures, Texture* const * textureArray) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
+        Texture* CreateSparseTexture(const TextureDescriptor& textureDesc) override;
+
+        void Release(Texture& texture) override;
+        void Release(TextureArray& textureArray) override;
+
+        TextureDescriptor QueryTextureDescriptor(const Texture& texture) override;
+        
+        void WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc) override;
+
+        void ReadTexture(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType, void* buffer) override;
+
+        void GenerateMips(Texture& texture) override;
+
+        std::uint64_t GetBindlessTextureHandle(Texture& texture, Sampler* sampler = nullptr) override;
+
+        void CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit) override;
+        bool IsSparseTextureResident(const Texture& texture, const TextureRegion& region) override;
+        Gs::Vector3ui QuerySparseTexturePageSize(const Texture& texture) override;
+
+        /* ----- Sampler States ---- */
+
+        Sampler* CreateSampler(const SamplerDescriptor& desc) override;
+        SamplerArray* CreateSamplerArray(unsigned int numSamplers, Sampler* const * samplerArray) override;
+
+        void Release(Sampler& sampler) override;
+        void Release(SamplerArray& samplerArray) override;
+
+        /* ----- Resource Heaps ----- */
+
+        ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
+
+        void Release(ResourceHeap& resourceHeap) override;
+
+        /* ----- Render Targets ----- */
+
+        RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
+
+        void Release(RenderTarget& renderTarget) override;
+
+        /* ----- Shader ----- */
+
+        Shader* CreateShader(const ShaderType type) override;
+        ShaderProgram* CreateShaderProgram() override;
+
+        void Release(Shader& shader) override;
+        void Release(ShaderProgram& shaderProgram) override;
+
+        /* ----- Pipeline States ----- */
+
+        GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) override;
+        ComputePipeline* CreateComputePipeline(const ComputePipelineDescriptor& desc) override;
+        
+        void Release(GraphicsPipeline& graphicsPipeline) override;
+        void Release(ComputePipeline& computePipeline) override;
+
+        bool LoadPipelineCache(const std::vector<char>& data) override;
+        std::vector<char> SavePipelineCache() override;
+
+        /* ----- Queries ----- */
+
+        Query* CreateQuery(const QueryDescriptor& desc) override;
+        QueryArray* CreateQueryArray(unsigned int numQueries, Query* const * queryArray) override;
+
+        void Release(Query& query) override;
+        void Release(QueryArray& queryArray) override;
+
+        /* ----- Readbacks ----- */
+
+        Readback* ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType) override;
+        Readback* ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize) override;
+
+        void Release(Readback& readback) override;
+
+        /* ----- Uploads ----- */
+
+        Fence* WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
+        Fence* WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc) override;
+
+        /* ----- Fences ----- */
+
+        Fence* CreateFence() override;
+
+        void Release(Fence& fence) override;
+
+        /* ----- Memory ----- */
+
+        MemoryInfo QueryMemoryInfo() override;
+
+        bool SetResidency(Buffer& buffer, bool resident) override;
+        bool SetResidency(Texture& texture, bool resident) override;
+
+        bool QueryClockCalibration(ClockCalibration& calibration) override;
+
+        bool ReportStateCacheStatistics(RenderingProfiler& profiler) override;
+
+    private:
+
+        // Records the release of the specified object and returns its ID.
+        std::uint32_t Unregister(const void* object);
+
+        template <typename T, typename TBase>
+        void ReleaseCap(HWObjectContainer<T>& cont, TBase& entry);
+
+        // Records the creation of a texture, optionally with its initial image data.
+        void RecordCreateTexture(const CapOpcode opcode, const Texture* texture, const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc);
+
+        /* ----- Common objects ----- */
+
+        std::shared_ptr<RenderSystem>                   instance_;
+        CapRecorder                                     recorder_;
+
+        /* ----- Hardware object containers ----- */
+
+        HWObjectContainer<CapRenderContext>             renderContexts_;
+        HWObjectContainer<CapCommandBuffer>             commandBuffers_;
+        HWObjectContainer<CapRenderTarget>              renderTargets_;
+        HWObjectContainer<CapShader>                    shaders_;
+        HWObjectContainer<CapShaderProgram>             shaderPrograms_;
+
+        /* ----- Buffer states ----- */
+
+        // Sizes of all buffers, to record the entire content of mapped buffers when they are unmapped.
+        std::unordered_map<const Buffer*, unsigned int> bufferSizes_;
+
+        // Mapped range of a buffer, whose content is recorded when the buffer is unmapped.
+        struct MappedBufferRange
+        {
+            const void*     data;
+            std::uint32_t   offset;
+            std::uint32_t   size;
+        };
+
+        // Mapped buffers whose content is recorded when they are unmapped.
+        std::unordered_map<const Buffer*, MappedBufferRange>    mappedBuffers_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,61 @@
+/*
+ * CapRenderTarget.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapRenderTarget.h"
+
+
+namespace LLGL
+{
+
+
+CapRenderTarget::CapRenderTarget(RenderTarget& instance, CapRecorder& recorder) :
+    instance  { instance },
+    recorder_ { recorder }
+{
+}
+
+void CapRenderTarget::AttachDepthBuffer(const Gs::Vector2ui& size)
+{
+    recorder_.Record(CapOpcode::AttachDepthBuffer, id, size);
+    instance.AttachDepthBuffer(size);
+    ApplyResolution(instance.GetResolution());
+}
+
+void CapRenderTarget::AttachStencilBuffer(const Gs::Vector2ui& size)
+{
+    recorder_.Record(CapOpcode::AttachStencilBuffer, id, size);
+    instance.AttachStencilBuffer(size);
+    ApplyResolution(instance.GetResolution());
+}
+
+void CapRenderTarget::AttachDepthStencilBuffer(const Gs::Vector2ui& size)
+{
+    recorder_.Record(CapOpcode::AttachDepthStencilBuffer, id, size);
+    instance.AttachDepthStencilBuffer(size);
+    ApplyResolution(instance.GetResolution());
+}
+
+void CapRenderTarget::AttachTexture(Texture& texture, const RenderTargetAttachmentDescriptor& attachmentDesc)
+{
+    recorder_.Record(CapOpcode::AttachTexture, id, recorder_.GetID(&texture), attachmentDesc);
+    instance.AttachTexture(texture, attachmentDesc);
+    ApplyResolution(instance.GetResolution());
+}
+
+void CapRenderTarget::DetachAll()
+{
+    recorder_.Record(CapOpcode::DetachAllAttachments, id);
+    instance.DetachAll();
+    ResetResolution();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,52 @@
+/*
+ * CapRenderTarget.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_RENDER_TARGET_H
+#define LLGL_CAP_RENDER_TARGET_H
+
+
+#include <LLGL/RenderTarget.h>
+#include "CapRecorder.h"
+
+
+namespace LLGL
+{
+
+
+class CapRenderTarget : public RenderTarget
+{
+
+    public:
+
+        CapRenderTarget(RenderTarget& instance, CapRecorder& recorder);
+
+        void AttachDepthBuffer(const Gs::Vector2ui& size) override;
+        void AttachStencilBuffer(const Gs::Vector2ui& size) override;
+        void AttachDepthStencilBuffer(const Gs::Vector2ui& size) override;
+
+        void AttachTexture(Texture& texture, const RenderTargetAttachmentDescriptor& attachmentDesc) override;
+
+        void DetachAll() override;
+
+        RenderTarget&   instance;
+        std::uint32_t   id          = 0;
+
+    private:
+
+        CapRecorder&    recorder_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
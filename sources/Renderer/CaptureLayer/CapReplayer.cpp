@@ -0,0 +1,1288 @@
+/*
+ * CapReplayer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapReplayer.h"
+#include <stdexcept>
+#include <chrono>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+~~~~~~ INFO ~~~~~~
+This is the replayer of the capture layer.
+It maps the object IDs of a capture trace to the objects it creates with its render system,
+and replays the records frame by frame, where each frame ends with a render context presentation.
+The image data and buffer data of the records are passed on directly from the trace, so they are not copied.
+*/
+
+// Size of the record header, i.e. the opcode (16 bits) and the payload size (32 bits).
+static const std::size_t g_capRecordHeaderSize = sizeof(std::uint16_t) + sizeof(std::uint32_t);
+
+CapReplayer::CapReplayer(RenderSystem& renderSystem, std::vector<char>&& trace, bool headless) :
+    renderSystem_ { renderSystem     },
+    trace_        { std::move(trace) },
+    headless_     { headless         }
+{
+    /* Validate trace header */
+    CapTraceHeader header;
+    if (trace_.size() < sizeof(header))
+        throw std::runtime_error("capture trace is too small for its header");
+
+    std::memcpy(&header, trace_.data(), sizeof(header));
+
+    if (header.magic != capTraceMagic)
+        throw std::runtime_error("invalid magic number in capture trace header");
+    if (header.version != capTraceVersion)
+        throw std::runtime_error("unsupported capture trace version: " + std::to_string(header.version));
+
+    pos_ = sizeof(header);
+}
+
+CapReplayer::~CapReplayer()
+{
+    ReleaseAllObjects();
+}
+
+bool CapReplayer::ReplayFrame()
+{
+    if (pos_ >= trace_.size())
+        return false;
+
+    using Clock = std::chrono::steady_clock;
+    auto startTime = Clock::now();
+
+    while (pos_ < trace_.size())
+    {
+        /* Read record header */
+        if (trace_.size() - pos_ < g_capRecordHeaderSize)
+            throw std::runtime_error("capture trace is truncated");
+
+        std::uint16_t opcode = 0;
+        std::uint32_t payloadSize = 0;
+        std::memcpy(&opcode, &trace_[pos_], sizeof(opcode));
+        std::memcpy(&payloadSize, &trace_[pos_ + sizeof(opcode)], sizeof(payloadSize));
+        pos_ += g_capRecordHeaderSize;
+
+        if (payloadSize > trace_.size() - pos_)
+            throw std::runtime_error("capture trace is truncated");
+
+        /* Replay record and skip to the next one, regardless of how much of the payload has been read */
+        CapReader reader { trace_.data() + pos_, payloadSize };
+        pos_ += payloadSize;
+
+        if (ReplayRecord(static_cast<CapOpcode>(opcode), reader))
+            break;
+    }
+
+    frameTime_ = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count());
+    ++numFrames_;
+
+    return true;
+}
+
+void CapReplayer::Restart()
+{
+    ReleaseAllObjects();
+    pos_        = sizeof(CapTraceHeader);
+    numFrames_  = 0;
+    frameTime_  = 0;
+}
+
+RenderContext* CapReplayer::GetRenderContext() const
+{
+    for (const auto& entry : objects_)
+    {
+        if (entry.second.type == CapObjectType::RenderContext)
+            return static_cast<RenderContext*>(entry.second.object);
+    }
+    return nullptr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool CapReplayer::ReplayRecord(const CapOpcode opcode, CapReader& reader)
+{
+    /* Replay command buffer records separately */
+    if (opcode >= CapOpcode::SetGraphicsAPIDependentState)
+    {
+        auto& commandBuffer = GetObject<CommandBuffer>(reader.Read<std::uint32_t>(), CapObjectType::CommandBuffer);
+        ReplayCommand(opcode, commandBuffer, reader);
+        return false;
+    }
+
+    switch (opcode)
+    {
+        /* ----- Render system ----- */
+
+        case CapOpcode::CreateRenderContext:
+        {
+            auto id = reader.Read<std::uint32_t>();
+            RenderContextDescriptor desc;
+            ReadCapRenderContextDescriptor(reader, desc);
+            if (headless_)
+                desc.headless = true;
+            AddObject(id, CapObjectType::RenderContext, renderSystem_.CreateRenderContext(desc));
+        }
+        break;
+
+        case CapOpcode::CreateCommandBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto desc   = reader.Read<CommandBufferDescriptor>();
+
+            /* Fall back to node 0 if the trace has been captured with more GPU nodes than available */
+            if (desc.nodeIndex >= renderSystem_.GetRenderingCaps().numGPUNodes)
+                desc.nodeIndex = 0;
+
+            AddObject(id, CapObjectType::CommandBuffer, renderSystem_.CreateCommandBuffer(desc));
+        }
+        break;
+
+        case CapOpcode::ExecuteCommandBuffers:
+        {
+            auto commandBuffers = ReadObjectArray<CommandBuffer>(reader, CapObjectType::CommandBuffer);
+            renderSystem_.ExecuteCommandBuffers(static_cast<unsigned int>(commandBuffers.size()), commandBuffers.data());
+        }
+        break;
+
+        case CapOpcode::CreateBuffer:
+        {
+            auto id = reader.Read<std::uint32_t>();
+            BufferDescriptor desc;
+            ReadCapBufferDescriptor(reader, desc);
+            std::size_t dataSize = 0;
+            auto initialData = reader.ReadData(dataSize);
+            AddObject(id, CapObjectType::Buffer, renderSystem_.CreateBuffer(desc, (dataSize > 0 ? initialData : nullptr)));
+        }
+        break;
+
+        case CapOpcode::CreateBufferArray:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto buffers    = ReadObjectArray<Buffer>(reader, CapObjectType::Buffer);
+            AddObject(id, CapObjectType::BufferArray, renderSystem_.CreateBufferArray(static_cast<unsigned int>(buffers.size()), buffers.data()));
+        }
+        break;
+
+        case CapOpcode::WriteBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto offset = reader.Read<std::uint32_t>();
+            std::size_t dataSize = 0;
+            auto data = reader.ReadData(dataSize);
+            renderSystem_.WriteBuffer(GetObject<Buffer>(id, CapObjectType::Buffer), data, dataSize, offset);
+        }
+        break;
+
+        case CapOpcode::WriteTransientConstantBuffer:
+        {
+            std::size_t dataSize = 0;
+            auto data   = reader.ReadData(dataSize);
+            auto id     = reader.Read<std::uint32_t>();
+            auto offset = reader.Read<unsigned int>();
+
+            /* Map the captured range to the range of the replay, since the ring buffers may differ in their alignment */
+            auto range = renderSystem_.WriteTransientConstantBuffer(data, dataSize);
+            if (id != 0)
+                transientRanges_[id][offset] = range;
+        }
+        break;
+
+        case CapOpcode::CreateTexture:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto desc   = reader.Read<TextureDescriptor>();
+            if (reader.Read<std::uint8_t>() != 0)
+            {
+                ImageDescriptor imageDesc;
+                ReadCapImage(reader, imageDesc);
+                AddObject(id, CapObjectType::Texture, renderSystem_.CreateTexture(desc, &imageDesc));
+            }
+            else
+                AddObject(id, CapObjectType::Texture, renderSystem_.CreateTexture(desc));
+        }
+        break;
+
+        case CapOpcode::CreateTextureArray:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto textures   = ReadObjectArray<Texture>(reader, CapObjectType::Texture);
+            AddObject(id, CapObjectType::TextureArray, renderSystem_.CreateTextureArray(static_cast<unsigned int>(textures.size()), textures.data()));
+        }
+        break;
+
+        case CapOpcode::CreateTextureView:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto sharedID   = reader.Read<std::uint32_t>();
+            auto desc       = reader.Read<TextureViewDescriptor>();
+            AddObject(id, CapObjectType::Texture, renderSystem_.CreateTextureView(GetObject<Texture>(sharedID, CapObjectType::Texture), desc));
+        }
+        break;
+
+        case CapOpcode::CreateSparseTexture:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto desc   = reader.Read<TextureDescriptor>();
+            AddObject(id, CapObjectType::Texture, renderSystem_.CreateSparseTexture(desc));
+        }
+        break;
+
+        case CapOpcode::WriteTexture:
+        {
+            auto id             = reader.Read<std::uint32_t>();
+            auto subTextureDesc = reader.Read<SubTextureDescriptor>();
+            ImageDescriptor imageDesc;
+            ReadCapImage(reader, imageDesc);
+            renderSystem_.WriteTexture(GetObject<Texture>(id, CapObjectType::Texture), subTextureDesc, imageDesc);
+        }
+        break;
+
+        case CapOpcode::GenerateMips:
+        {
+            renderSystem_.GenerateMips(GetObject<Texture>(reader.Read<std::uint32_t>(), CapObjectType::Texture));
+        }
+        break;
+
+        case CapOpcode::CommitSparseTexture:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto region = reader.Read<TextureRegion>();
+            auto commit = reader.Read<bool>();
+            renderSystem_.CommitSparseTexture(GetObject<Texture>(id, CapObjectType::Texture), region, commit);
+        }
+        break;
+
+        case CapOpcode::CreateSampler:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto desc   = reader.Read<SamplerDescriptor>();
+            AddObject(id, CapObjectType::Sampler, renderSystem_.CreateSampler(desc));
+        }
+        break;
+
+        case CapOpcode::CreateSamplerArray:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto samplers   = ReadObjectArray<Sampler>(reader, CapObjectType::Sampler);
+            AddObject(id, CapObjectType::SamplerArray, renderSystem_.CreateSamplerArray(static_cast<unsigned int>(samplers.size()), samplers.data()));
+        }
+        break;
+
+        case CapOpcode::CreateResourceHeap:
+        {
+            auto id = reader.Read<std::uint32_t>();
+
+            ResourceHeapDescriptor desc;
+            desc.resourceViews.resize(reader.Read<std::uint32_t>());
+
+            for (auto& resourceView : desc.resourceViews)
+            {
+                reader.Read(resourceView.type);
+                reader.Read(resourceView.slot);
+                reader.Read(resourceView.shaderStageFlags);
+
+                auto bufferID   = reader.Read<std::uint32_t>();
+                auto textureID  = reader.Read<std::uint32_t>();
+                auto samplerID  = reader.Read<std::uint32_t>();
+
+                resourceView.buffer     = GetOptionalObject<Buffer>(bufferID, CapObjectType::Buffer);
+                resourceView.texture    = GetOptionalObject<Texture>(textureID, CapObjectType::Texture);
+                resourceView.sampler    = GetOptionalObject<Sampler>(samplerID, CapObjectType::Sampler);
+            }
+
+            AddObject(id, CapObjectType::ResourceHeap, renderSystem_.CreateResourceHeap(desc));
+        }
+        break;
+
+        case CapOpcode::CreateRenderTarget:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto desc   = reader.Read<RenderTargetDescriptor>();
+            AddObject(id, CapObjectType::RenderTarget, renderSystem_.CreateRenderTarget(desc));
+        }
+        break;
+
+        case CapOpcode::CreateShader:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto type   = reader.Read<ShaderType>();
+            AddObject(id, CapObjectType::Shader, renderSystem_.CreateShader(type));
+        }
+        break;
+
+        case CapOpcode::CreateShaderProgram:
+        {
+            AddObject(reader.Read<std::uint32_t>(), CapObjectType::ShaderProgram, renderSystem_.CreateShaderProgram());
+        }
+        break;
+
+        case CapOpcode::CreateGraphicsPipeline:
+        {
+            auto id                 = reader.Read<std::uint32_t>();
+            auto shaderProgramID    = reader.Read<std::uint32_t>();
+
+            GraphicsPipelineDescriptor desc;
+            ReadCapGraphicsPipelineDescriptor(reader, desc);
+            desc.shaderProgram = GetOptionalObject<ShaderProgram>(shaderProgramID, CapObjectType::ShaderProgram);
+
+            AddObject(id, CapObjectType::GraphicsPipeline, renderSystem_.CreateGraphicsPipeline(desc));
+        }
+        break;
+
+        case CapOpcode::CreateComputePipeline:
+        {
+            auto id                 = reader.Read<std::uint32_t>();
+            auto shaderProgramID    = reader.Read<std::uint32_t>();
+
+            ComputePipelineDescriptor desc;
+            desc.shaderProgram = GetOptionalObject<ShaderProgram>(shaderProgramID, CapObjectType::ShaderProgram);
+
+            AddObject(id, CapObjectType::ComputePipeline, renderSystem_.CreateComputePipeline(desc));
+        }
+        break;
+
+        case CapOpcode::CreateQuery:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto desc   = reader.Read<QueryDescriptor>();
+            AddObject(id, CapObjectType::Query, renderSystem_.CreateQuery(desc));
+        }
+        break;
+
+        case CapOpcode::CreateQueryArray:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto queries    = ReadObjectArray<Query>(reader, CapObjectType::Query);
+            AddObject(id, CapObjectType::QueryArray, renderSystem_.CreateQueryArray(static_cast<unsigned int>(queries.size()), queries.data()));
+        }
+        break;
+
+        case CapOpcode::CreateFence:
+        {
+            AddObject(reader.Read<std::uint32_t>(), CapObjectType::Fence, renderSystem_.CreateFence());
+        }
+        break;
+
+        case CapOpcode::Release:
+        {
+            ReleaseObject(reader.Read<std::uint32_t>());
+        }
+        break;
+
+        /* ----- Render context ----- */
+
+        case CapOpcode::Present:
+        {
+            GetObject<RenderContext>(reader.Read<std::uint32_t>(), CapObjectType::RenderContext).Present();
+        }
+        return true;
+
+        case CapOpcode::WaitForNextFrame:
+        {
+            GetObject<RenderContext>(reader.Read<std::uint32_t>(), CapObjectType::RenderContext).WaitForNextFrame();
+        }
+        break;
+
+        case CapOpcode::SetVideoMode:
+        {
+            auto id             = reader.Read<std::uint32_t>();
+            auto videoModeDesc  = reader.Read<VideoModeDescriptor>();
+            GetObject<RenderContext>(id, CapObjectType::RenderContext).SetVideoMode(videoModeDesc);
+        }
+        break;
+
+        case CapOpcode::SetVsync:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto vsyncDesc  = reader.Read<VsyncDescriptor>();
+            GetObject<RenderContext>(id, CapObjectType::RenderContext).SetVsync(vsyncDesc);
+        }
+        break;
+
+        /* ----- Render target ----- */
+
+        case CapOpcode::AttachDepthBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto size   = reader.Read<Gs::Vector2ui>();
+            GetObject<RenderTarget>(id, CapObjectType::RenderTarget).AttachDepthBuffer(size);
+        }
+        break;
+
+        case CapOpcode::AttachStencilBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto size   = reader.Read<Gs::Vector2ui>();
+            GetObject<RenderTarget>(id, CapObjectType::RenderTarget).AttachStencilBuffer(size);
+        }
+        break;
+
+        case CapOpcode::AttachDepthStencilBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto size   = reader.Read<Gs::Vector2ui>();
+            GetObject<RenderTarget>(id, CapObjectType::RenderTarget).AttachDepthStencilBuffer(size);
+        }
+        break;
+
+        case CapOpcode::AttachTexture:
+        {
+            auto id             = reader.Read<std::uint32_t>();
+            auto textureID      = reader.Read<std::uint32_t>();
+            auto attachmentDesc = reader.Read<RenderTargetAttachmentDescriptor>();
+            auto& texture       = GetObject<Texture>(textureID, CapObjectType::Texture);
+            GetObject<RenderTarget>(id, CapObjectType::RenderTarget).AttachTexture(texture, attachmentDesc);
+        }
+        break;
+
+        case CapOpcode::DetachAllAttachments:
+        {
+            GetObject<RenderTarget>(reader.Read<std::uint32_t>(), CapObjectType::RenderTarget).DetachAll();
+        }
+        break;
+
+        /* ----- Shader and shader program ----- */
+
+        case CapOpcode::CompileShader:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto sourceCode = reader.ReadString();
+            ShaderDescriptor shaderDesc;
+            ReadCapShaderDescriptor(reader, shaderDesc);
+            GetObject<Shader>(id, CapObjectType::Shader).Compile(sourceCode, shaderDesc);
+        }
+        break;
+
+        case CapOpcode::LoadShaderBinary:
+        {
+            auto id = reader.Read<std::uint32_t>();
+            std::size_t size = 0;
+            auto data = reader.ReadData(size);
+            ShaderDescriptor shaderDesc;
+            ReadCapShaderDescriptor(reader, shaderDesc);
+            GetObject<Shader>(id, CapObjectType::Shader).LoadBinary(std::vector<char>(data, data + size), shaderDesc);
+        }
+        break;
+
+        case CapOpcode::AttachShader:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto shaderID   = reader.Read<std::uint32_t>();
+            auto& shader    = GetObject<Shader>(shaderID, CapObjectType::Shader);
+            GetObject<ShaderProgram>(id, CapObjectType::ShaderProgram).AttachShader(shader);
+        }
+        break;
+
+        case CapOpcode::DetachAllShaders:
+        {
+            GetObject<ShaderProgram>(reader.Read<std::uint32_t>(), CapObjectType::ShaderProgram).DetachAll();
+        }
+        break;
+
+        case CapOpcode::LinkShaders:
+        {
+            GetObject<ShaderProgram>(reader.Read<std::uint32_t>(), CapObjectType::ShaderProgram).LinkShaders();
+        }
+        break;
+
+        case CapOpcode::BuildInputLayout:
+        {
+            auto id = reader.Read<std::uint32_t>();
+            VertexFormat vertexFormat;
+            ReadCapVertexFormat(reader, vertexFormat);
+            GetObject<ShaderProgram>(id, CapObjectType::ShaderProgram).BuildInputLayout(vertexFormat);
+        }
+        break;
+
+        case CapOpcode::BindConstantBuffer:
+        {
+            auto id             = reader.Read<std::uint32_t>();
+            auto name           = reader.ReadString();
+            auto bindingIndex   = reader.Read<unsigned int>();
+            GetObject<ShaderProgram>(id, CapObjectType::ShaderProgram).BindConstantBuffer(name, bindingIndex);
+        }
+        break;
+
+        case CapOpcode::BindStorageBuffer:
+        {
+            auto id             = reader.Read<std::uint32_t>();
+            auto name           = reader.ReadString();
+            auto bindingIndex   = reader.Read<unsigned int>();
+            GetObject<ShaderProgram>(id, CapObjectType::ShaderProgram).BindStorageBuffer(name, bindingIndex);
+        }
+        break;
+
+        case CapOpcode::QueryShaderClassInstance:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto stage  = reader.Read<ShaderType>();
+            auto name   = reader.ReadString();
+            GetObject<ShaderProgram>(id, CapObjectType::ShaderProgram).QueryShaderClassInstance(stage, name);
+        }
+        break;
+
+        default:
+            throw std::runtime_error("unknown opcode in capture trace: " + std::to_string(static_cast<int>(opcode)));
+    }
+
+    return false;
+}
+
+void CapReplayer::ReplayCommand(const CapOpcode opcode, CommandBuffer& commandBuffer, CapReader& reader)
+{
+    switch (opcode)
+    {
+        /* ----- Configuration ----- */
+
+        case CapOpcode::SetGraphicsAPIDependentState:
+        {
+            commandBuffer.SetGraphicsAPIDependentState(reader.Read<GraphicsAPIDependentStateDescriptor>());
+        }
+        break;
+
+        case CapOpcode::SetViewport:
+        {
+            commandBuffer.SetViewport(reader.Read<Viewport>());
+        }
+        break;
+
+        case CapOpcode::SetViewportArray:
+        {
+            std::size_t size = 0;
+            auto data = reader.ReadData(size);
+            std::vector<Viewport> viewports(size / sizeof(Viewport));
+            std::memcpy(viewports.data(), data, viewports.size() * sizeof(Viewport));
+            commandBuffer.SetViewportArray(static_cast<unsigned int>(viewports.size()), viewports.data());
+        }
+        break;
+
+        case CapOpcode::SetScissor:
+        {
+            commandBuffer.SetScissor(reader.Read<Scissor>());
+        }
+        break;
+
+        case CapOpcode::SetScissorArray:
+        {
+            std::size_t size = 0;
+            auto data = reader.ReadData(size);
+            std::vector<Scissor> scissors(size / sizeof(Scissor));
+            std::memcpy(scissors.data(), data, scissors.size() * sizeof(Scissor));
+            commandBuffer.SetScissorArray(static_cast<unsigned int>(scissors.size()), scissors.data());
+        }
+        break;
+
+        case CapOpcode::SetShadingRate:
+        {
+            commandBuffer.SetShadingRate(reader.Read<ShadingRate>());
+        }
+        break;
+
+        case CapOpcode::SetDepthBounds:
+        {
+            auto minDepth = reader.Read<float>();
+            auto maxDepth = reader.Read<float>();
+            commandBuffer.SetDepthBounds(minDepth, maxDepth);
+        }
+        break;
+
+        case CapOpcode::SetShadingRateImage:
+        {
+            commandBuffer.SetShadingRateImage(GetOptionalObject<Texture>(reader.Read<std::uint32_t>(), CapObjectType::Texture));
+        }
+        break;
+
+        case CapOpcode::SetClearColor:
+        {
+            commandBuffer.SetClearColor(reader.Read<ColorRGBAf>());
+        }
+        break;
+
+        case CapOpcode::SetClearDepth:
+        {
+            commandBuffer.SetClearDepth(reader.Read<float>());
+        }
+        break;
+
+        case CapOpcode::SetClearStencil:
+        {
+            commandBuffer.SetClearStencil(reader.Read<int>());
+        }
+        break;
+
+        case CapOpcode::Clear:
+        {
+            commandBuffer.Clear(reader.Read<long>());
+        }
+        break;
+
+        case CapOpcode::ClearTarget:
+        {
+            auto targetIndex    = reader.Read<unsigned int>();
+            auto color          = reader.Read<ColorRGBAf>();
+            commandBuffer.ClearTarget(targetIndex, color);
+        }
+        break;
+
+        /* ----- Buffers ----- */
+
+        case CapOpcode::SetVertexBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto offset = reader.Read<unsigned int>();
+            commandBuffer.SetVertexBuffer(GetObject<Buffer>(id, CapObjectType::Buffer), offset);
+        }
+        break;
+
+        case CapOpcode::SetVertexBufferArray:
+        {
+            commandBuffer.SetVertexBufferArray(GetObject<BufferArray>(reader.Read<std::uint32_t>(), CapObjectType::BufferArray));
+        }
+        break;
+
+        case CapOpcode::SetIndexBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto offset = reader.Read<unsigned int>();
+            commandBuffer.SetIndexBuffer(GetObject<Buffer>(id, CapObjectType::Buffer), offset);
+        }
+        break;
+
+        case CapOpcode::SetConstantBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto slot   = reader.Read<unsigned int>();
+            auto flags  = reader.Read<long>();
+            commandBuffer.SetConstantBuffer(GetObject<Buffer>(id, CapObjectType::Buffer), slot, flags);
+        }
+        break;
+
+        case CapOpcode::SetConstantBufferArray:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto startSlot  = reader.Read<unsigned int>();
+            auto flags      = reader.Read<long>();
+            commandBuffer.SetConstantBufferArray(GetObject<BufferArray>(id, CapObjectType::BufferArray), startSlot, flags);
+        }
+        break;
+
+        case CapOpcode::SetConstantBufferRange:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto offset = reader.Read<unsigned int>();
+            auto size   = reader.Read<unsigned int>();
+            auto slot   = reader.Read<unsigned int>();
+            auto flags  = reader.Read<long>();
+
+            /* Translate ranges of transient constant buffers into the ranges of the replay */
+            auto it = transientRanges_.find(id);
+            if (it != transientRanges_.end())
+            {
+                auto itRange = it->second.find(offset);
+                if (itRange == it->second.end() || itRange->second.buffer == nullptr)
+                    throw std::runtime_error("invalid transient constant buffer range in capture trace");
+                commandBuffer.SetConstantBufferRange(*(itRange->second.buffer), itRange->second.offset, size, slot, flags);
+            }
+            else
+                commandBuffer.SetConstantBufferRange(GetObject<Buffer>(id, CapObjectType::Buffer), offset, size, slot, flags);
+        }
+        break;
+
+        case CapOpcode::SetStorageBuffer:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto slot   = reader.Read<unsigned int>();
+            auto flags  = reader.Read<long>();
+            commandBuffer.SetStorageBuffer(GetObject<Buffer>(id, CapObjectType::Buffer), slot, flags);
+        }
+        break;
+
+        case CapOpcode::SetStorageBufferArray:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto startSlot  = reader.Read<unsigned int>();
+            auto flags      = reader.Read<long>();
+            commandBuffer.SetStorageBufferArray(GetObject<BufferArray>(id, CapObjectType::BufferArray), startSlot, flags);
+        }
+        break;
+
+        case CapOpcode::ResetBufferCounter:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto value  = reader.Read<unsigned int>();
+            commandBuffer.ResetBufferCounter(GetObject<Buffer>(id, CapObjectType::Buffer), value);
+        }
+        break;
+
+        case CapOpcode::CopyBufferCounter:
+        {
+            auto dstID      = reader.Read<std::uint32_t>();
+            auto dstOffset  = reader.Read<unsigned int>();
+            auto srcID      = reader.Read<std::uint32_t>();
+            commandBuffer.CopyBufferCounter(GetObject<Buffer>(dstID, CapObjectType::Buffer), dstOffset, GetObject<Buffer>(srcID, CapObjectType::Buffer));
+        }
+        break;
+
+        case CapOpcode::SetStreamOutputBuffer:
+        {
+            commandBuffer.SetStreamOutputBuffer(GetObject<Buffer>(reader.Read<std::uint32_t>(), CapObjectType::Buffer));
+        }
+        break;
+
+        case CapOpcode::SetStreamOutputBufferArray:
+        {
+            commandBuffer.SetStreamOutputBufferArray(GetObject<BufferArray>(reader.Read<std::uint32_t>(), CapObjectType::BufferArray));
+        }
+        break;
+
+        case CapOpcode::BeginStreamOutput:
+        {
+            commandBuffer.BeginStreamOutput(reader.Read<PrimitiveType>());
+        }
+        break;
+
+        case CapOpcode::EndStreamOutput:
+        {
+            commandBuffer.EndStreamOutput();
+        }
+        break;
+
+        case CapOpcode::PauseStreamOutput:
+        {
+            commandBuffer.PauseStreamOutput();
+        }
+        break;
+
+        case CapOpcode::ResumeStreamOutput:
+        {
+            commandBuffer.ResumeStreamOutput();
+        }
+        break;
+
+        /* ----- Textures and samplers ----- */
+
+        case CapOpcode::SetTexture:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto slot   = reader.Read<unsigned int>();
+            auto flags  = reader.Read<long>();
+            commandBuffer.SetTexture(GetObject<Texture>(id, CapObjectType::Texture), slot, flags);
+        }
+        break;
+
+        case CapOpcode::SetTextureArray:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto startSlot  = reader.Read<unsigned int>();
+            auto flags      = reader.Read<long>();
+            commandBuffer.SetTextureArray(GetObject<TextureArray>(id, CapObjectType::TextureArray), startSlot, flags);
+        }
+        break;
+
+        case CapOpcode::SetSampler:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto slot   = reader.Read<unsigned int>();
+            auto flags  = reader.Read<long>();
+            commandBuffer.SetSampler(GetObject<Sampler>(id, CapObjectType::Sampler), slot, flags);
+        }
+        break;
+
+        case CapOpcode::SetSamplerArray:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto startSlot  = reader.Read<unsigned int>();
+            auto flags      = reader.Read<long>();
+            commandBuffer.SetSamplerArray(GetObject<SamplerArray>(id, CapObjectType::SamplerArray), startSlot, flags);
+        }
+        break;
+
+        case CapOpcode::SetResourceHeap:
+        {
+            commandBuffer.SetResourceHeap(GetObject<ResourceHeap>(reader.Read<std::uint32_t>(), CapObjectType::ResourceHeap));
+        }
+        break;
+
+        /* ----- Render targets and render passes ----- */
+
+        case CapOpcode::SetRenderTarget:
+        {
+            auto id = reader.Read<std::uint32_t>();
+            auto it = objects_.find(id);
+            if (it != objects_.end() && it->second.type == CapObjectType::RenderContext)
+                commandBuffer.SetRenderTarget(*static_cast<RenderContext*>(it->second.object));
+            else
+                commandBuffer.SetRenderTarget(GetObject<RenderTarget>(id, CapObjectType::RenderTarget));
+        }
+        break;
+
+        case CapOpcode::BeginRenderPass:
+        {
+            auto id = reader.Read<std::uint32_t>();
+            RenderPassDescriptor renderPassDesc;
+            ReadCapRenderPassDescriptor(reader, renderPassDesc);
+
+            auto it = objects_.find(id);
+            if (it != objects_.end() && it->second.type == CapObjectType::RenderContext)
+                commandBuffer.BeginRenderPass(*static_cast<RenderContext*>(it->second.object), renderPassDesc);
+            else
+                commandBuffer.BeginRenderPass(GetObject<RenderTarget>(id, CapObjectType::RenderTarget), renderPassDesc);
+        }
+        break;
+
+        case CapOpcode::EndRenderPass:
+        {
+            commandBuffer.EndRenderPass();
+        }
+        break;
+
+        /* ----- Pipeline states ----- */
+
+        case CapOpcode::SetGraphicsPipeline:
+        {
+            commandBuffer.SetGraphicsPipeline(GetObject<GraphicsPipeline>(reader.Read<std::uint32_t>(), CapObjectType::GraphicsPipeline));
+        }
+        break;
+
+        case CapOpcode::SetComputePipeline:
+        {
+            commandBuffer.SetComputePipeline(GetObject<ComputePipeline>(reader.Read<std::uint32_t>(), CapObjectType::ComputePipeline));
+        }
+        break;
+
+        case CapOpcode::SetPushConstants:
+        {
+            auto offset = reader.Read<unsigned int>();
+            std::size_t size = 0;
+            auto data = reader.ReadData(size);
+            commandBuffer.SetPushConstants(offset, static_cast<unsigned int>(size), data);
+        }
+        break;
+
+        case CapOpcode::SetShaderClassInstances:
+        {
+            auto stage = reader.Read<ShaderType>();
+            std::size_t size = 0;
+            auto data = reader.ReadData(size);
+
+            /* Copy IDs out of the record, since the record data is not aligned */
+            std::vector<int> classInstances(size / sizeof(int));
+            if (!classInstances.empty())
+                std::memcpy(classInstances.data(), data, classInstances.size() * sizeof(int));
+
+            commandBuffer.SetShaderClassInstances(stage, static_cast<unsigned int>(classInstances.size()), classInstances.data());
+        }
+        break;
+
+        /* ----- Queries ----- */
+
+        case CapOpcode::BeginQuery:
+        {
+            commandBuffer.BeginQuery(GetObject<Query>(reader.Read<std::uint32_t>(), CapObjectType::Query));
+        }
+        break;
+
+        case CapOpcode::EndQuery:
+        {
+            commandBuffer.EndQuery(GetObject<Query>(reader.Read<std::uint32_t>(), CapObjectType::Query));
+        }
+        break;
+
+        case CapOpcode::ResolveQueryData:
+        {
+            auto id         = reader.Read<std::uint32_t>();
+            auto firstQuery = reader.Read<unsigned int>();
+            auto numQueries = reader.Read<unsigned int>();
+            auto dstID      = reader.Read<std::uint32_t>();
+            auto dstOffset  = reader.Read<unsigned int>();
+            commandBuffer.ResolveQueryData(
+                GetObject<QueryArray>(id, CapObjectType::QueryArray), firstQuery, numQueries,
+                GetObject<Buffer>(dstID, CapObjectType::Buffer), dstOffset
+            );
+        }
+        break;
+
+        case CapOpcode::BeginRenderCondition:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto mode   = reader.Read<RenderConditionMode>();
+            commandBuffer.BeginRenderCondition(GetObject<Query>(id, CapObjectType::Query), mode);
+        }
+        break;
+
+        case CapOpcode::EndRenderCondition:
+        {
+            commandBuffer.EndRenderCondition();
+        }
+        break;
+
+        /* ----- Copy ----- */
+
+        case CapOpcode::CopyBuffer:
+        {
+            auto dstID      = reader.Read<std::uint32_t>();
+            auto dstOffset  = reader.Read<unsigned int>();
+            auto srcID      = reader.Read<std::uint32_t>();
+            auto srcOffset  = reader.Read<unsigned int>();
+            auto size       = reader.Read<unsigned int>();
+            commandBuffer.CopyBuffer(
+                GetObject<Buffer>(dstID, CapObjectType::Buffer), dstOffset,
+                GetObject<Buffer>(srcID, CapObjectType::Buffer), srcOffset, size
+            );
+        }
+        break;
+
+        case CapOpcode::CopyTexture:
+        case CapOpcode::ResolveTexture:
+        {
+            auto dstID          = reader.Read<std::uint32_t>();
+            auto dstMipLevel    = reader.Read<unsigned int>();
+            auto dstOffset      = reader.Read<Gs::Vector3ui>();
+            auto srcID          = reader.Read<std::uint32_t>();
+            auto srcRegion      = reader.Read<TextureRegion>();
+
+            auto& dstTexture = GetObject<Texture>(dstID, CapObjectType::Texture);
+            auto& srcTexture = GetObject<Texture>(srcID, CapObjectType::Texture);
+
+            if (opcode == CapOpcode::CopyTexture)
+                commandBuffer.CopyTexture(dstTexture, dstMipLevel, dstOffset, srcTexture, srcRegion);
+            else
+                commandBuffer.ResolveTexture(dstTexture, dstMipLevel, dstOffset, srcTexture, srcRegion);
+        }
+        break;
+
+        case CapOpcode::CopyBufferToTexture:
+        {
+            auto dstID          = reader.Read<std::uint32_t>();
+            auto dstRegion      = reader.Read<TextureRegion>();
+            auto srcID          = reader.Read<std::uint32_t>();
+            auto srcOffset      = reader.Read<unsigned int>();
+            auto imageFormat    = reader.Read<ImageFormat>();
+            auto dataType       = reader.Read<DataType>();
+            commandBuffer.CopyBufferToTexture(
+                GetObject<Texture>(dstID, CapObjectType::Texture), dstRegion,
+                GetObject<Buffer>(srcID, CapObjectType::Buffer), srcOffset, imageFormat, dataType
+            );
+        }
+        break;
+
+        /* ----- Drawing ----- */
+
+        case CapOpcode::Draw:
+        {
+            auto numVertices = reader.Read<unsigned int>();
+            auto firstVertex = reader.Read<unsigned int>();
+            commandBuffer.Draw(numVertices, firstVertex);
+        }
+        break;
+
+        case CapOpcode::DrawIndexed:
+        {
+            auto numVertices    = reader.Read<unsigned int>();
+            auto firstIndex     = reader.Read<unsigned int>();
+            commandBuffer.DrawIndexed(numVertices, firstIndex);
+        }
+        break;
+
+        case CapOpcode::DrawIndexedOffset:
+        {
+            auto numVertices    = reader.Read<unsigned int>();
+            auto firstIndex     = reader.Read<unsigned int>();
+            auto vertexOffset   = reader.Read<int>();
+            commandBuffer.DrawIndexed(numVertices, firstIndex, vertexOffset);
+        }
+        break;
+
+        case CapOpcode::DrawInstanced:
+        {
+            auto numVertices    = reader.Read<unsigned int>();
+            auto firstVertex    = reader.Read<unsigned int>();
+            auto numInstances   = reader.Read<unsigned int>();
+            commandBuffer.DrawInstanced(numVertices, firstVertex, numInstances);
+        }
+        break;
+
+        case CapOpcode::DrawInstancedOffset:
+        {
+            auto numVertices    = reader.Read<unsigned int>();
+            auto firstVertex    = reader.Read<unsigned int>();
+            auto numInstances   = reader.Read<unsigned int>();
+            auto instanceOffset = reader.Read<unsigned int>();
+            commandBuffer.DrawInstanced(numVertices, firstVertex, numInstances, instanceOffset);
+        }
+        break;
+
+        case CapOpcode::DrawIndexedInstanced:
+        {
+            auto numVertices    = reader.Read<unsigned int>();
+            auto numInstances   = reader.Read<unsigned int>();
+            auto firstIndex     = reader.Read<unsigned int>();
+            commandBuffer.DrawIndexedInstanced(numVertices, numInstances, firstIndex);
+        }
+        break;
+
+        case CapOpcode::DrawIndexedInstancedOffset:
+        {
+            auto numVertices    = reader.Read<unsigned int>();
+            auto numInstances   = reader.Read<unsigned int>();
+            auto firstIndex     = reader.Read<unsigned int>();
+            auto vertexOffset   = reader.Read<int>();
+            commandBuffer.DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset);
+        }
+        break;
+
+        case CapOpcode::DrawIndexedInstancedOffsets:
+        {
+            auto numVertices    = reader.Read<unsigned int>();
+            auto numInstances   = reader.Read<unsigned int>();
+            auto firstIndex     = reader.Read<unsigned int>();
+            auto vertexOffset   = reader.Read<int>();
+            auto instanceOffset = reader.Read<unsigned int>();
+            commandBuffer.DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset, instanceOffset);
+        }
+        break;
+
+        case CapOpcode::DrawIndirect:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto offset = reader.Read<unsigned int>();
+            commandBuffer.DrawIndirect(GetObject<Buffer>(id, CapObjectType::Buffer), offset);
+        }
+        break;
+
+        case CapOpcode::DrawIndirectMulti:
+        {
+            auto id             = reader.Read<std::uint32_t>();
+            auto offset         = reader.Read<unsigned int>();
+            auto numCommands    = reader.Read<unsigned int>();
+            auto stride         = reader.Read<unsigned int>();
+            commandBuffer.DrawIndirect(GetObject<Buffer>(id, CapObjectType::Buffer), offset, numCommands, stride);
+        }
+        break;
+
+        case CapOpcode::DrawIndexedIndirect:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto offset = reader.Read<unsigned int>();
+            commandBuffer.DrawIndexedIndirect(GetObject<Buffer>(id, CapObjectType::Buffer), offset);
+        }
+        break;
+
+        case CapOpcode::DrawIndexedIndirectMulti:
+        {
+            auto id             = reader.Read<std::uint32_t>();
+            auto offset         = reader.Read<unsigned int>();
+            auto numCommands    = reader.Read<unsigned int>();
+            auto stride         = reader.Read<unsigned int>();
+            commandBuffer.DrawIndexedIndirect(GetObject<Buffer>(id, CapObjectType::Buffer), offset, numCommands, stride);
+        }
+        break;
+
+        case CapOpcode::DrawStreamOutput:
+        {
+            commandBuffer.DrawStreamOutput();
+        }
+        break;
+
+        case CapOpcode::DrawMeshTasks:
+        {
+            auto numTasksX = reader.Read<unsigned int>();
+            auto numTasksY = reader.Read<unsigned int>();
+            auto numTasksZ = reader.Read<unsigned int>();
+            commandBuffer.DrawMeshTasks(numTasksX, numTasksY, numTasksZ);
+        }
+        break;
+
+        /* ----- Compute ----- */
+
+        case CapOpcode::Dispatch:
+        {
+            auto groupSizeX = reader.Read<unsigned int>();
+            auto groupSizeY = reader.Read<unsigned int>();
+            auto groupSizeZ = reader.Read<unsigned int>();
+            commandBuffer.Dispatch(groupSizeX, groupSizeY, groupSizeZ);
+        }
+        break;
+
+        case CapOpcode::DispatchIndirect:
+        {
+            auto id     = reader.Read<std::uint32_t>();
+            auto offset = reader.Read<unsigned int>();
+            commandBuffer.DispatchIndirect(GetObject<Buffer>(id, CapObjectType::Buffer), offset);
+        }
+        break;
+
+        case CapOpcode::Barrier:
+        {
+            commandBuffer.Barrier(reader.Read<long>());
+        }
+        break;
+
+        case CapOpcode::StorageBarrier:
+        {
+            commandBuffer.StorageBarrier(GetObject<Buffer>(reader.Read<std::uint32_t>(), CapObjectType::Buffer));
+        }
+        break;
+
+        /* ----- Command recording and misc ----- */
+
+        case CapOpcode::Execute:
+        {
+            commandBuffer.Execute(GetObject<CommandBuffer>(reader.Read<std::uint32_t>(), CapObjectType::CommandBuffer));
+        }
+        break;
+
+        case CapOpcode::Reset:
+        {
+            commandBuffer.Reset();
+        }
+        break;
+
+        case CapOpcode::Signal:
+        {
+            commandBuffer.Signal(GetObject<Fence>(reader.Read<std::uint32_t>(), CapObjectType::Fence));
+        }
+        break;
+
+        case CapOpcode::SyncGPU:
+        {
+            commandBuffer.SyncGPU();
+        }
+        break;
+
+        default:
+            throw std::runtime_error("unknown opcode in capture trace: " + std::to_string(static_cast<int>(opcode)));
+    }
+}
+
+void CapReplayer::AddObject(std::uint32_t id, const CapObjectType type, void* object)
+{
+    if (id == 0 || object == nullptr)
+        throw std::runtime_error("failed to create object of capture trace with ID " + std::to_string(id));
+    objects_[id] = { type, object };
+}
+
+template <typename T>
+T& CapReplayer::GetObject(std::uint32_t id, const CapObjectType type)
+{
+    auto it = objects_.find(id);
+    if (it == objects_.end() || it->second.type != type)
+        throw std::runtime_error("invalid object ID in capture trace: " + std::to_string(id));
+    return *static_cast<T*>(it->second.object);
+}
+
+template <typename T>
+T* CapReplayer::GetOptionalObject(std::uint32_t id, const CapObjectType type)
+{
+    return (id != 0 ? &(GetObject<T>(id, type)) : nullptr);
+}
+
+template <typename T>
+std::vector<T*> CapReplayer::ReadObjectArray(CapReader& reader, const CapObjectType type)
+{
+    std::size_t size = 0;
+    auto data = reader.ReadData(size);
+
+    std::vector<T*> objects(size / sizeof(std::uint32_t));
+    for (std::size_t i = 0; i < objects.size(); ++i)
+    {
+        std::uint32_t id = 0;
+        std::memcpy(&id, data + i * sizeof(std::uint32_t), sizeof(id));
+        objects[i] = &(GetObject<T>(id, type));
+    }
+
+    return objects;
+}
+
+void CapReplayer::ReleaseObject(std::uint32_t id)
+{
+    auto it = objects_.find(id);
+    if (it == objects_.end())
+        return;
+
+    auto object = it->second.object;
+
+    switch (it->second.type)
+    {
+        case CapObjectType::RenderContext:
+            renderSystem_.Release(*static_cast<RenderContext*>(object));
+            break;
+        case CapObjectType::CommandBuffer:
+            renderSystem_.Release(*static_cast<CommandBuffer*>(object));
+            break;
+        case CapObjectType::Buffer:
+            renderSystem_.Release(*static_cast<Buffer*>(object));
+            break;
+        case CapObjectType::BufferArray:
+            renderSystem_.Release(*static_cast<BufferArray*>(object));
+            break;
+        case CapObjectType::Texture:
+            renderSystem_.Release(*static_cast<Texture*>(object));
+            break;
+        case CapObjectType::TextureArray:
+            renderSystem_.Release(*static_cast<TextureArray*>(object));
+            break;
+        case CapObjectType::Sampler:
+            renderSystem_.Release(*static_cast<Sampler*>(object));
+            break;
+        case CapObjectType::SamplerArray:
+            renderSystem_.Release(*static_cast<SamplerArray*>(object));
+            break;
+        case CapObjectType::ResourceHeap:
+            renderSystem_.Release(*static_cast<ResourceHeap*>(object));
+            break;
+        case CapObjectType::RenderTarget:
+            renderSystem_.Release(*static_cast<RenderTarget*>(object));
+            break;
+        case CapObjectType::Shader:
+            renderSystem_.Release(*static_cast<Shader*>(object));
+            break;
+        case CapObjectType::ShaderProgram:
+            renderSystem_.Release(*static_cast<ShaderProgram*>(object));
+            break;
+        case CapObjectType::GraphicsPipeline:
+            renderSystem_.Release(*static_cast<GraphicsPipeline*>(object));
+            break;
+        case CapObjectType::ComputePipeline:
+            renderSystem_.Release(*static_cast<ComputePipeline*>(object));
+            break;
+        case CapObjectType::Query:
+            renderSystem_.Release(*static_cast<Query*>(object));
+            break;
+        case CapObjectType::QueryArray:
+            renderSystem_.Release(*static_cast<QueryArray*>(object));
+            break;
+        case CapObjectType::Fence:
+            renderSystem_.Release(*static_cast<Fence*>(object));
+            break;
+    }
+
+    objects_.erase(it);
+}
+
+void CapReplayer::ReleaseAllObjects()
+{
+    /* Release objects in reverse order of their creation, so dependent objects are released first */
+    while (!objects_.empty())
+        ReleaseObject(objects_.rbegin()->first);
+    transientRanges_.clear();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,101 @@
+/*
+ * CapReplayer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_REPLAYER_H
+#define LLGL_CAP_REPLAYER_H
+
+
+#include <LLGL/RenderSystem.h>
+#include "CapFormat.h"
+#include <map>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Replays the records of a capture trace with a render system (see CaptureReplay).
+class CapReplayer
+{
+
+    public:
+
+        CapReplayer(RenderSystem& renderSystem, std::vector<char>&& trace, bool headless);
+        ~CapReplayer();
+
+        bool ReplayFrame();
+
+        void Restart();
+
+        RenderContext* GetRenderContext() const;
+
+        inline std::uint32_t GetNumFrames() const
+        {
+            return numFrames_;
+        }
+
+        inline std::uint64_t GetFrameTime() const
+        {
+            return frameTime_;
+        }
+
+    private:
+
+        struct Object
+        {
+            CapObjectType   type;
+            void*           object;
+        };
+
+        // Replays the specified record and returns true if it has presented a render context.
+        bool ReplayRecord(const CapOpcode opcode, CapReader& reader);
+
+        void ReplayCommand(const CapOpcode opcode, CommandBuffer& commandBuffer, CapReader& reader);
+
+        void AddObject(std::uint32_t id, const CapObjectType type, void* object);
+
+        // Returns the object with the specified ID and type, or throws if there is no such object.
+        template <typename T>
+        T& GetObject(std::uint32_t id, const CapObjectType type);
+
+        // Returns the object with the specified ID and type, or null if the ID is 0.
+        template <typename T>
+        T* GetOptionalObject(std::uint32_t id, const CapObjectType type);
+
+        // Reads an array of object IDs and returns the respective objects.
+        template <typename T>
+        std::vector<T*> ReadObjectArray(CapReader& reader, const CapObjectType type);
+
+        void ReleaseObject(std::uint32_t id);
+        void ReleaseAllObjects();
+
+        RenderSystem&                                                           renderSystem_;
+        std::vector<char>                                                       trace_;
+        std::size_t                                                             pos_            = 0;
+        bool                                                                    headless_       = false;
+
+        std::map<std::uint32_t, Object>                                         objects_;
+
+        // Ranges of transient constant buffers per captured ring buffer ID and captured offset.
+        std::map<std::uint32_t, std::map<unsigned int, TransientBufferRange>>   transientRanges_;
+
+        std::uint32_t                                                           numFrames_      = 0;
+        std::uint64_t                                                           frameTime_      = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
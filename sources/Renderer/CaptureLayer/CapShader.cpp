@@ -0,0 +1,63 @@
+/*
+ * CapShader.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapShader.h"
+
+
+namespace LLGL
+{
+
+
+CapShader::CapShader(Shader& instance, const ShaderType type, CapRecorder& recorder) :
+    Shader    { type     },
+    instance  { instance },
+    recorder_ { recorder }
+{
+}
+
+bool CapShader::Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
+{
+    CapWriter writer { CapOpcode::CompileShader };
+    {
+        writer.Write(id);
+        writer.WriteString(sourceCode);
+        WriteCapShaderDescriptor(writer, shaderDesc);
+    }
+    recorder_.Append(writer);
+
+    return instance.Compile(sourceCode, shaderDesc);
+}
+
+bool CapShader::LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc)
+{
+    CapWriter writer { CapOpcode::LoadShaderBinary };
+    {
+        writer.Write(id);
+        writer.WriteData(binaryCode.data(), binaryCode.size());
+        WriteCapShaderDescriptor(writer, shaderDesc);
+    }
+    recorder_.Append(writer);
+
+    return instance.LoadBinary(std::move(binaryCode), shaderDesc);
+}
+
+std::string CapShader::Disassemble(int flags)
+{
+    return instance.Disassemble(flags);
+}
+
+std::string CapShader::QueryInfoLog()
+{
+    return instance.QueryInfoLog();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,52 @@
+/*
+ * CapShader.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_SHADER_H
+#define LLGL_CAP_SHADER_H
+
+
+#include <LLGL/Shader.h>
+#include "CapRecorder.h"
+
+
+namespace LLGL
+{
+
+
+class CapShader : public Shader
+{
+
+    public:
+
+        CapShader(Shader& instance, const ShaderType type, CapRecorder& recorder);
+
+        bool Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
+
+        bool LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc = {}) override;
+
+        std::string Disassemble(int flags = 0) override;
+
+        std::string QueryInfoLog() override;
+
+        Shader&         instance;
+        std::uint32_t   id          = 0;
+
+    private:
+
+        CapRecorder&    recorder_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
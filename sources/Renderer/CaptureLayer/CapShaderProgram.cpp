@@ -0,0 +1,144 @@
+/*
+ * CapShaderProgram.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CapShaderProgram.h"
+#include "CapShader.h"
+#include "../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+CapShaderProgram::CapShaderProgram(ShaderProgram& instance, CapRecorder& recorder) :
+    instance  { instance },
+    recorder_ { recorder }
+{
+}
+
+void CapShaderProgram::AttachShader(Shader& shader)
+{
+    auto& shaderCap = LLGL_CAST(CapShader&, shader);
+    recorder_.Record(CapOpcode::AttachShader, id, shaderCap.id);
+    instance.AttachShader(shaderCap.instance);
+}
+
+void CapShaderProgram::DetachAll()
+{
+    recorder_.Record(CapOpcode::DetachAllShaders, id);
+    instance.DetachAll();
+}
+
+bool CapShaderProgram::LinkShaders()
+{
+    recorder_.Record(CapOpcode::LinkShaders, id);
+    return instance.LinkShaders();
+}
+
+std::string CapShaderProgram::QueryInfoLog()
+{
+    return instance.QueryInfoLog();
+}
+
+std::vector<VertexAttribute> CapShaderProgram::QueryVertexAttributes() const
+{
+    return instance.QueryVertexAttributes();
+}
+
+std::vector<StreamOutputAttribute> CapShaderProgram::QueryStreamOutputAttributes() const
+{
+    return instance.QueryStreamOutputAttributes();
+}
+
+std::vector<ConstantBufferViewDescriptor> CapShaderProgram::QueryConstantBuffers() const
+{
+    return instance.QueryConstantBuffers();
+}
+
+std::vector<StorageBufferViewDescriptor> CapShaderProgram::QueryStorageBuffers() const
+{
+    return instance.QueryStorageBuffers();
+}
+
+std::vector<UniformDescriptor> CapShaderProgram::QueryUniforms() const
+{
+    return instance.QueryUniforms();
+}
+
+int CapShaderProgram::QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name)
+{
+    return instance.QueryShaderInterfaceSlot(stage, name);
+}
+
+int CapShaderProgram::QueryShaderClassInstance(const ShaderType stage, const std::string& name)
+{
+    /* Record query, since class instance IDs can be assigned on first query (e.g. with Direct3D 11) */
+    CapWriter writer { CapOpcode::QueryShaderClassInstance };
+    {
+        writer.WriteAll(id, stage);
+        writer.WriteString(name);
+    }
+    recorder_.Append(writer);
+
+    return instance.QueryShaderClassInstance(stage, name);
+}
+
+void CapShaderProgram::BuildInputLayout(const VertexFormat& vertexFormat)
+{
+    CapWriter writer { CapOpcode::BuildInputLayout };
+    {
+        writer.Write(id);
+        WriteCapVertexFormat(writer, vertexFormat);
+    }
+    recorder_.Append(writer);
+
+    instance.BuildInputLayout(vertexFormat);
+}
+
+void CapShaderProgram::BindConstantBuffer(const std::string& name, unsigned int bindingIndex)
+{
+    CapWriter writer { CapOpcode::BindConstantBuffer };
+    {
+        writer.Write(id);
+        writer.WriteString(name);
+        writer.Write(bindingIndex);
+    }
+    recorder_.Append(writer);
+
+    instance.BindConstantBuffer(name, bindingIndex);
+}
+
+void CapShaderProgram::BindStorageBuffer(const std::string& name, unsigned int bindingIndex)
+{
+    CapWriter writer { CapOpcode::BindStorageBuffer };
+    {
+        writer.Write(id);
+        writer.WriteString(name);
+        writer.Write(bindingIndex);
+    }
+    recorder_.Append(writer);
+
+    instance.BindStorageBuffer(name, bindingIndex);
+}
+
+ShaderUniform* CapShaderProgram::LockShaderUniform()
+{
+    /* Uniform values are not recorded */
+    return instance.LockShaderUniform();
+}
+
+void CapShaderProgram::UnlockShaderUniform()
+{
+    instance.UnlockShaderUniform();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
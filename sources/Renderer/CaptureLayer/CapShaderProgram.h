@@ -0,0 +1,66 @@
+/*
+ * CapShaderProgram.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAP_SHADER_PROGRAM_H
+#define LLGL_CAP_SHADER_PROGRAM_H
+
+
+#include <LLGL/ShaderProgram.h>
+#include "CapRecorder.h"
+
+
+namespace LLGL
+{
+
+
+class CapShaderProgram : public ShaderProgram
+{
+
+    public:
+
+        CapShaderProgram(ShaderProgram& instance, CapRecorder& recorder);
+
+        void AttachShader(Shader& shader) override;
+        void DetachAll() override;
+
+        bool LinkShaders() override;
+
+        std::string QueryInfoLog() override;
+        std::vector<VertexAttribute> QueryVertexAttributes() const override;
+        std::vector<StreamOutputAttribute> QueryStreamOutputAttributes() const override;
+        std::vector<ConstantBufferViewDescriptor> QueryConstantBuffers() const override;
+        std::vector<StorageBufferViewDescriptor> QueryStorageBuffers() const override;
+        std::vector<UniformDescriptor> QueryUniforms() const override;
+
+        int QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name) override;
+        int QueryShaderClassInstance(const ShaderType stage, const std::string& name) override;
+
+        void BuildInputLayout(const VertexFormat& vertexFormat) override;
+        void BindConstantBuffer(const std::string& name, unsigned int bindingIndex) override;
+        void BindStorageBuffer(const std::string& name, unsigned int bindingIndex) override;
+
+        ShaderUniform* LockShaderUniform() override;
+        void UnlockShaderUniform() override;
+
+        ShaderProgram&  instance;
+        std::uint32_t   id          = 0;
+
+    private:
+
+        CapRecorder&    recorder_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
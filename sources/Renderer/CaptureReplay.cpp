@@ -0,0 +1,67 @@
+/*
+ * CaptureReplay.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CaptureReplay.h>
+#include "CaptureLayer/CapReplayer.h"
+#include "../Core/Helper.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+CaptureReplay::CaptureReplay(RenderSystem& renderSystem, std::vector<char>&& trace, bool headless) :
+    replayer_ { MakeUnique<CapReplayer>(renderSystem, std::move(trace), headless) }
+{
+}
+
+CaptureReplay::~CaptureReplay()
+{
+}
+
+std::vector<char> CaptureReplay::LoadTrace(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.good())
+        throw std::runtime_error("failed to open file for reading: \"" + filename + "\"");
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool CaptureReplay::ReplayFrame()
+{
+    return replayer_->ReplayFrame();
+}
+
+void CaptureReplay::Restart()
+{
+    replayer_->Restart();
+}
+
+std::uint32_t CaptureReplay::GetNumFrames() const
+{
+    return replayer_->GetNumFrames();
+}
+
+std::uint64_t CaptureReplay::GetFrameTime() const
+{
+    return replayer_->GetFrameTime();
+}
+
+RenderContext* CaptureReplay::GetRenderContext() const
+{
+    return replayer_->GetRenderContext();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
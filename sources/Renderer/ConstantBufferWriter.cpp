@@ -0,0 +1,148 @@
+/*
+ * ConstantBufferWriter.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ConstantBufferWriter.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Modified ranges with a gap of up to this many bytes are uploaded together, since each upload has a fixed overhead.
+static const std::size_t g_dirtyRangeMergeGap = 64;
+
+ConstantBufferWriter::ConstantBufferWriter(RenderSystem& renderSystem, Buffer& buffer, const ConstantBufferViewDescriptor& desc, bool partialUpdates) :
+    renderSystem_   { renderSystem   },
+    buffer_         { buffer         },
+    fields_         { desc.fields    },
+    data_           ( desc.size, 0   ),
+    partialUpdates_ { partialUpdates }
+{
+    Invalidate();
+}
+
+const ConstantBufferFieldDescriptor* ConstantBufferWriter::FindField(const std::string& name) const
+{
+    for (const auto& field : fields_)
+    {
+        if (field.name == name)
+            return &field;
+    }
+    return nullptr;
+}
+
+void ConstantBufferWriter::Write(const ConstantBufferFieldDescriptor& field, const void* data, std::size_t dataSize, unsigned int arrayIndex)
+{
+    if (dataSize > field.size)
+        throw std::out_of_range("data size exceeds size of constant buffer field: " + field.name);
+    if (arrayIndex > 0 && arrayIndex >= field.arraySize)
+        throw std::out_of_range("array index out of range for constant buffer field: " + field.name);
+
+    auto offset = static_cast<std::size_t>(field.offset) + static_cast<std::size_t>(field.arrayStride) * arrayIndex;
+    if (offset + dataSize > data_.size())
+        throw std::out_of_range("constant buffer field exceeds buffer size: " + field.name);
+
+    /* Only mark the range as modified if the value actually changed */
+    auto dst = data_.data() + offset;
+    if (std::memcmp(dst, data, dataSize) != 0)
+    {
+        std::memcpy(dst, data, dataSize);
+        MarkDirty(offset, offset + dataSize);
+    }
+}
+
+std::size_t ConstantBufferWriter::Flush()
+{
+    if (dirtyRanges_.empty())
+        return 0;
+
+    std::size_t numBytes = 0;
+
+    if (partialUpdates_)
+    {
+        /* Sort modified ranges and merge those that overlap or are close together */
+        std::sort(
+            dirtyRanges_.begin(), dirtyRanges_.end(),
+            [](const DirtyRange& lhs, const DirtyRange& rhs)
+            {
+                return (lhs.begin < rhs.begin);
+            }
+        );
+
+        auto range = dirtyRanges_.front();
+
+        for (std::size_t i = 1; i <= dirtyRanges_.size(); ++i)
+        {
+            if (i < dirtyRanges_.size() && dirtyRanges_[i].begin <= range.end + g_dirtyRangeMergeGap)
+                range.end = std::max(range.end, dirtyRanges_[i].end);
+            else
+            {
+                /* Upload merged range */
+                auto size = range.end - range.begin;
+                renderSystem_.WriteBuffer(buffer_, data_.data() + range.begin, size, range.begin);
+                numBytes += size;
+
+                if (i < dirtyRanges_.size())
+                    range = dirtyRanges_[i];
+            }
+        }
+    }
+    else
+    {
+        /* Upload entire buffer */
+        renderSystem_.WriteBuffer(buffer_, data_.data(), data_.size(), 0);
+        numBytes = data_.size();
+    }
+
+    dirtyRanges_.clear();
+
+    return numBytes;
+}
+
+void ConstantBufferWriter::Invalidate()
+{
+    dirtyRanges_.clear();
+    if (!data_.empty())
+        dirtyRanges_.push_back({ 0, data_.size() });
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+const ConstantBufferFieldDescriptor& ConstantBufferWriter::GetField(const std::string& name) const
+{
+    if (auto field = FindField(name))
+        return *field;
+    throw std::invalid_argument("constant buffer has no field named: " + name);
+}
+
+void ConstantBufferWriter::MarkDirty(std::size_t begin, std::size_t end)
+{
+    /* Extend the last range if the fields are written in order, which is the common case */
+    if (!dirtyRanges_.empty())
+    {
+        auto& last = dirtyRanges_.back();
+        if (begin >= last.begin && begin <= last.end + g_dirtyRangeMergeGap)
+        {
+            last.end = std::max(last.end, end);
+            return;
+        }
+    }
+    dirtyRanges_.push_back({ begin, end });
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -9,16 +9,253 @@
 #define LLGL_CONTAINER_TYPES_H
 
 
-#include <set>
+#include "../Core/Allocator.h"
+#include <vector>
+#include <unordered_map>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
+// Allocation tags of the containers below (see STLAllocator).
+struct HWObjectContainerTag
+{
+    static const char* Name() { return "HWObjectContainer"; }
+};
+
+struct HWObjectCacheTag
+{
+    static const char* Name() { return "HWObjectCache"; }
+};
+
+
+/*
+Container that owns the hardware objects of a render system.
+Objects are stored densely in a vector and the slot of each object is found with a hash map,
+so creating and releasing an object is O(1) regardless of the number of live objects.
+A released object is replaced by the last object, i.e. the order of the objects is not preserved.
+Creating and releasing objects is synchronized, so each container acts as a lock shard for its object type;
+iterating over the objects is not synchronized and must only happen while no other thread creates or releases objects.
+*/
 template <typename T>
-using HWObjectContainer = std::set<std::unique_ptr<T>>;
+class HWObjectContainer
+{
+
+    public:
+
+        using ObjectList        = std::vector<std::unique_ptr<T>, STLAllocator<std::unique_ptr<T>, HWObjectContainerTag>>;
+        using iterator          = typename ObjectList::iterator;
+        using const_iterator    = typename ObjectList::const_iterator;
+
+        HWObjectContainer() = default;
+
+        HWObjectContainer(const HWObjectContainer&) = delete;
+        HWObjectContainer& operator = (const HWObjectContainer&) = delete;
+
+        // Takes ownership of the specified object.
+        void emplace(std::unique_ptr<T>&& object)
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            slots_[object.get()] = objects_.size();
+            objects_.emplace_back(std::move(object));
+        }
+
+        // Deletes the specified object. Returns false if the object is not owned by this container.
+        bool erase(const T* object)
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            auto it = slots_.find(object);
+            if (it == slots_.end())
+                return false;
+
+            /* Move last object into the slot of the released object */
+            auto slot = it->second;
+            slots_.erase(it);
+
+            if (slot + 1 < objects_.size())
+            {
+                objects_[slot] = std::move(objects_.back());
+                slots_[objects_[slot].get()] = slot;
+            }
+
+            objects_.pop_back();
+
+            return true;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            slots_.clear();
+            objects_.clear();
+        }
+
+        bool empty() const
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            return objects_.empty();
+        }
+
+        std::size_t size() const
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            return objects_.size();
+        }
+
+        iterator begin()
+        {
+            return objects_.begin();
+        }
+
+        iterator end()
+        {
+            return objects_.end();
+        }
+
+        const_iterator begin() const
+        {
+            return objects_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return objects_.end();
+        }
+
+    private:
+
+        using SlotMap = std::unordered_map<
+            const T*, std::size_t, std::hash<const T*>, std::equal_to<const T*>,
+            STLAllocator<std::pair<const T* const, std::size_t>, HWObjectContainerTag>
+        >;
+
+        ObjectList                                  objects_;
+        SlotMap                                     slots_;
+        mutable std::mutex                          mutex_;
+
+};
+
+
+/*
+Container that owns hardware objects, which are interned by their descriptors.
+Requesting an object with a descriptor that equals the descriptor of a live object returns that same object
+and increments its reference count. The object is only deleted when it has been released as often as it has been acquired.
+THash must be a hash function object for TDesc, and TDesc must provide an equality operator.
+Acquiring and releasing objects is synchronized; the creation function is called while the cache is locked,
+so concurrent requests for the same descriptor never create the object twice.
+*/
+template <typename T, typename TDesc, typename THash>
+class HWObjectCache
+{
+
+    public:
+
+        HWObjectCache() = default;
+
+        HWObjectCache(const HWObjectCache&) = delete;
+        HWObjectCache& operator = (const HWObjectCache&) = delete;
+
+        // Returns the object with the specified descriptor, or creates it with the specified function object that returns std::unique_ptr<T>.
+        template <typename TCreateFunc>
+        T* Acquire(const TDesc& desc, TCreateFunc createFunc)
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            auto it = entries_.find(desc);
+            if (it != entries_.end())
+            {
+                /* Share existing object */
+                ++(it->second.refCount);
+                return it->second.object.get();
+            }
+
+            /* Create new object and keep a reference to its descriptor, which is stable in the hash map */
+            auto object = createFunc();
+            auto ref    = object.get();
+            auto result = entries_.emplace(desc, Entry{ std::move(object), 1 });
+            descs_[ref] = &(result.first->first);
+
+            return ref;
+        }
+
+        // Releases one reference of the specified object. Returns false if the object is not owned by this container.
+        template <typename TBase>
+        bool Release(const TBase* entry)
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            auto it = descs_.find(static_cast<const T*>(entry));
+            if (it == descs_.end())
+                return false;
+
+            auto entryIt = entries_.find(*(it->second));
+            if (--(entryIt->second.refCount) == 0)
+            {
+                /* Delete object with its last reference */
+                descs_.erase(it);
+                entries_.erase(entryIt);
+            }
+
+            return true;
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            descs_.clear();
+            entries_.clear();
+        }
+
+        // Returns the number of distinct objects.
+        std::size_t size() const
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            return entries_.size();
+        }
+
+    private:
+
+        struct Entry
+        {
+            std::unique_ptr<T>  object;
+            std::size_t         refCount;
+        };
+
+        using EntryMap = std::unordered_map<
+            TDesc, Entry, THash, std::equal_to<TDesc>,
+            STLAllocator<std::pair<const TDesc, Entry>, HWObjectCacheTag>
+        >;
+
+        using DescMap = std::unordered_map<
+            const T*, const TDesc*, std::hash<const T*>, std::equal_to<const T*>,
+            STLAllocator<std::pair<const T* const, const TDesc*>, HWObjectCacheTag>
+        >;
+
+        EntryMap                                        entries_;
+        DescMap                                         descs_;
+        mutable std::mutex                              mutex_;
+
+};
+
+
+template <typename BaseType, typename SubType>
+SubType* TakeOwnership(HWObjectContainer<BaseType>& objectSet, std::unique_ptr<SubType>&& object)
+{
+    auto ref = object.get();
+    objectSet.emplace(std::move(object));
+    return ref;
+}
+
+// Deletes the specified object from the container. The entry is passed by its interface type (e.g. Buffer for a GLBuffer).
+template <typename T, typename TBase>
+void RemoveFromUniqueSet(HWObjectContainer<T>& cont, const TBase* entry)
+{
+    if (entry)
+        cont.erase(static_cast<const T*>(entry));
+}
 
 
 } // /namespace LLGL
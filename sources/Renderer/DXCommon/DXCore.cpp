@@ -10,10 +10,12 @@
 #include "../../Core/Helper.h"
 #include "../../Core/HelperMacros.h"
 #include "../../Core/Vendor.h"
+#include "../../Core/Exception.h"
 #include <LLGL/Shader.h>
 #include <stdexcept>
 #include <algorithm>
 #include <d3dcompiler.h>
+#include <dxgi1_6.h>
 
 
 namespace LLGL
@@ -85,6 +87,16 @@ void DXThrowIfFailed(const HRESULT errorCode, const std::string& info)
         throw std::runtime_error(info + " (error code = " + DXErrorToStr(errorCode) + ")");
 }
 
+bool DXReportIfFailed(const HRESULT errorCode, const char* info)
+{
+    if (FAILED(errorCode))
+    {
+        ReportRuntimeError(std::string(info) + " (error code = " + DXErrorToStr(errorCode) + ")");
+        return true;
+    }
+    return false;
+}
+
 template <typename Cont>
 Cont GetBlobDataTmpl(ID3DBlob* blob)
 {
@@ -160,6 +172,7 @@ void DXGetRenderingCaps(RenderingCaps& caps, D3D_FEATURE_LEVEL featureLevel)
     caps.hasTextureArrays               = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
     caps.hasCubeTextureArrays           = (featureLevel >= D3D_FEATURE_LEVEL_10_1);
     caps.hasMultiSampleTextures         = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
+    caps.hasTextureViews                = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
     caps.hasSamplers                    = (featureLevel >= D3D_FEATURE_LEVEL_9_3);
     caps.hasConstantBuffers             = true;
     caps.hasStorageBuffers              = true;
@@ -167,14 +180,22 @@ void DXGetRenderingCaps(RenderingCaps& caps, D3D_FEATURE_LEVEL featureLevel)
     caps.hasGeometryShaders             = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
     caps.hasTessellationShaders         = (featureLevel >= D3D_FEATURE_LEVEL_11_0);
     caps.hasComputeShaders              = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
+    caps.hasIndirectDrawing             = (featureLevel >= D3D_FEATURE_LEVEL_11_0);
+    caps.hasBindlessTextures            = false;
     caps.hasInstancing                  = (featureLevel >= D3D_FEATURE_LEVEL_9_3);
     caps.hasOffsetInstancing            = (featureLevel >= D3D_FEATURE_LEVEL_9_3);
     caps.hasViewportArrays              = true;
-    caps.hasConservativeRasterization   = (featureLevel >= D3D_FEATURE_LEVEL_11_1);
+    caps.hasLayeredRenderTargets        = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
+    caps.hasVertexShaderLayer           = false; // queried by each backend
+    caps.hasConservativeRasterization   = false; // queried by each backend
     caps.hasStreamOutputs               = (featureLevel >= D3D_FEATURE_LEVEL_10_0);
+    caps.hasShaderBinaries              = true;
+    caps.hasShaderClassInterfaces       = false; // queried by each backend
     caps.maxNumTextureArrayLayers       = (featureLevel >= D3D_FEATURE_LEVEL_10_0 ? 2048 : 256);
     caps.maxNumRenderTargetAttachments  = GetMaxRenderTargets(featureLevel);
     caps.maxConstantBufferSize          = 16384;
+    caps.maxPushConstantsSize           = 128;
+    caps.waveSize                       = 0; // queried by Direct3D 12 only
     caps.maxPatchVertices               = 32;
     caps.max1DTextureSize               = GetMaxTextureDimension(featureLevel);
     caps.max2DTextureSize               = GetMaxTextureDimension(featureLevel);
@@ -349,6 +370,90 @@ VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter)
     return videoAdapterDesc;
 }
 
+static bool IsSoftwareAdapter(IDXGIAdapter* adapter)
+{
+    ComPtr<IDXGIAdapter1> adapter1;
+    if (SUCCEEDED(adapter->QueryInterface(IID_PPV_ARGS(&adapter1))))
+    {
+        DXGI_ADAPTER_DESC1 desc;
+        if (SUCCEEDED(adapter1->GetDesc1(&desc)))
+            return ((desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0);
+    }
+    return false;
+}
+
+static SIZE_T GetDedicatedVideoMemory(IDXGIAdapter* adapter)
+{
+    DXGI_ADAPTER_DESC desc;
+    adapter->GetDesc(&desc);
+    return desc.DedicatedVideoMemory;
+}
+
+std::vector<ComPtr<IDXGIAdapter>> DXGetPreferredAdapters(IDXGIFactory* factory, const RenderSystemDescriptor& desc)
+{
+    std::vector<ComPtr<IDXGIAdapter>> adapters;
+
+    /* Enumerate adapters in their default order, which is also the order of the video adapter descriptors */
+    ComPtr<IDXGIAdapter> adapter;
+    for (UINT i = 0; factory->EnumAdapters(i, adapter.ReleaseAndGetAddressOf()) != DXGI_ERROR_NOT_FOUND; ++i)
+        adapters.push_back(adapter);
+
+    /* Use only the explicitly selected adapter */
+    if (desc.adapterIndex >= 0)
+    {
+        if (static_cast<std::size_t>(desc.adapterIndex) >= adapters.size())
+        {
+            throw std::runtime_error(
+                "video adapter index out of range: " + std::to_string(desc.adapterIndex) +
+                " specified, but only " + std::to_string(adapters.size()) + " adapter(s) available"
+            );
+        }
+        return { adapters[desc.adapterIndex] };
+    }
+
+    if (desc.adapterPreference != VideoAdapterPreference::Unspecified)
+    {
+        const auto gpuPreference = (desc.adapterPreference == VideoAdapterPreference::MinimumPower ? DXGI_GPU_PREFERENCE_MINIMUM_POWER : DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE);
+
+        ComPtr<IDXGIFactory6> factory6;
+        if (SUCCEEDED(factory->QueryInterface(IID_PPV_ARGS(&factory6))))
+        {
+            /* Enumerate adapters by GPU preference (requires DXGI 1.6) */
+            adapters.clear();
+            for (UINT i = 0; SUCCEEDED(factory6->EnumAdapterByGpuPreference(i, gpuPreference, IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()))); ++i)
+                adapters.push_back(adapter);
+        }
+        else
+        {
+            /* Approximate GPU preference by the amount of dedicated video memory, which is small for integrated GPUs */
+            std::stable_sort(
+                adapters.begin(), adapters.end(),
+                [gpuPreference](const ComPtr<IDXGIAdapter>& lhs, const ComPtr<IDXGIAdapter>& rhs)
+                {
+                    if (gpuPreference == DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE)
+                        return (GetDedicatedVideoMemory(lhs.Get()) > GetDedicatedVideoMemory(rhs.Get()));
+                    else
+                        return (GetDedicatedVideoMemory(lhs.Get()) < GetDedicatedVideoMemory(rhs.Get()));
+                }
+            );
+        }
+    }
+
+    /* Remove software adapters, since the WARP adapter is only used as fallback */
+    adapters.erase(
+        std::remove_if(
+            adapters.begin(), adapters.end(),
+            [](const ComPtr<IDXGIAdapter>& entry)
+            {
+                return IsSoftwareAdapter(entry.Get());
+            }
+        ),
+        adapters.end()
+    );
+
+    return adapters;
+}
+
 D3DTextureFormatDescriptor DXGetTextureFormatDesc(DXGI_FORMAT format)
 {
     switch (format)
@@ -357,11 +462,13 @@ D3DTextureFormatDescriptor DXGetTextureFormatDesc(DXGI_FORMAT format)
         case DXGI_FORMAT_D24_UNORM_S8_UINT:     return { ImageFormat::DepthStencil,     DataType::Float  };
         case DXGI_FORMAT_R8_UNORM:              return { ImageFormat::R,                DataType::UInt8  };
         case DXGI_FORMAT_R8_SNORM:              return { ImageFormat::R,                DataType::Int8   };
+        case DXGI_FORMAT_R8_UINT:               return { ImageFormat::R,                DataType::UInt8  };
         case DXGI_FORMAT_R16_UNORM:             return { ImageFormat::R,                DataType::UInt16 };
         case DXGI_FORMAT_R16_SNORM:             return { ImageFormat::R,                DataType::Int16  };
         case DXGI_FORMAT_R32_UINT:              return { ImageFormat::R,                DataType::UInt32 };
         case DXGI_FORMAT_R32_SINT:              return { ImageFormat::R,                DataType::Int32  };
         case DXGI_FORMAT_R32_FLOAT:             return { ImageFormat::R,                DataType::Float  };
+        case DXGI_FORMAT_R16_FLOAT:             return { ImageFormat::R,                DataType::Float16 };
         case DXGI_FORMAT_R8G8_UNORM:            return { ImageFormat::RG,               DataType::UInt8  };
         case DXGI_FORMAT_R8G8_SNORM:            return { ImageFormat::RG,               DataType::Int8   };
         case DXGI_FORMAT_R16G16_UNORM:          return { ImageFormat::RG,               DataType::UInt16 };
@@ -369,6 +476,7 @@ D3DTextureFormatDescriptor DXGetTextureFormatDesc(DXGI_FORMAT format)
         case DXGI_FORMAT_R32G32_UINT:           return { ImageFormat::RG,               DataType::UInt32 };
         case DXGI_FORMAT_R32G32_SINT:           return { ImageFormat::RG,               DataType::Int32  };
         case DXGI_FORMAT_R32G32_FLOAT:          return { ImageFormat::RG,               DataType::Float  };
+        case DXGI_FORMAT_R16G16_FLOAT:          return { ImageFormat::RG,               DataType::Float16 };
         case DXGI_FORMAT_R32G32B32_UINT:        return { ImageFormat::RGB,              DataType::UInt32 };
         case DXGI_FORMAT_R32G32B32_SINT:        return { ImageFormat::RGB,              DataType::Int32  };
         case DXGI_FORMAT_R32G32B32_FLOAT:       return { ImageFormat::RGB,              DataType::Float  };
@@ -379,14 +487,245 @@ D3DTextureFormatDescriptor DXGetTextureFormatDesc(DXGI_FORMAT format)
         case DXGI_FORMAT_R32G32B32A32_UINT:     return { ImageFormat::RGBA,             DataType::UInt32 };
         case DXGI_FORMAT_R32G32B32A32_SINT:     return { ImageFormat::RGBA,             DataType::Int32  };
         case DXGI_FORMAT_R32G32B32A32_FLOAT:    return { ImageFormat::RGBA,             DataType::Float  };
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:    return { ImageFormat::RGBA,             DataType::Float16 };
         case DXGI_FORMAT_BC1_UNORM:             return { ImageFormat::CompressedRGB,    DataType::UInt8  };
         case DXGI_FORMAT_BC2_UNORM:             return { ImageFormat::CompressedRGBA,   DataType::UInt8  };
         case DXGI_FORMAT_BC3_UNORM:             return { ImageFormat::CompressedRGBA,   DataType::UInt8  };
+        case DXGI_FORMAT_BC4_UNORM:             return { ImageFormat::CompressedRGB,    DataType::UInt8  };
+        case DXGI_FORMAT_BC5_UNORM:             return { ImageFormat::CompressedRGB,    DataType::UInt8  };
+        case DXGI_FORMAT_BC6H_UF16:             return { ImageFormat::CompressedRGB,    DataType::UInt8  };
+        case DXGI_FORMAT_BC7_UNORM:             return { ImageFormat::CompressedRGBA,   DataType::UInt8  };
         default:                                break;
     }
     throw std::invalid_argument("failed to map hardware texture format into image buffer format");
 }
 
+bool DXIsDepthStencilFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_D16_UNORM:
+        case DXGI_FORMAT_D24_UNORM_S8_UINT:
+        case DXGI_FORMAT_D32_FLOAT:
+        case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+DXGI_FORMAT DXGetTypelessDepthStencilFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_D16_UNORM:             return DXGI_FORMAT_R16_TYPELESS;
+        case DXGI_FORMAT_D24_UNORM_S8_UINT:     return DXGI_FORMAT_R24G8_TYPELESS;
+        case DXGI_FORMAT_D32_FLOAT:             return DXGI_FORMAT_R32_TYPELESS;
+        case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:  return DXGI_FORMAT_R32G8X24_TYPELESS;
+        default:                                return format;
+    }
+}
+
+DXGI_FORMAT DXGetDepthSRVFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_D16_UNORM:             return DXGI_FORMAT_R16_UNORM;
+        case DXGI_FORMAT_D24_UNORM_S8_UINT:     return DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+        case DXGI_FORMAT_D32_FLOAT:             return DXGI_FORMAT_R32_FLOAT;
+        case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:  return DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS;
+        default:                                return format;
+    }
+}
+
+D3DTextureRegion DXGetTextureRegion(const TextureType type, const Gs::Vector3ui& offset, const Gs::Vector3ui& extent)
+{
+    D3DTextureRegion region;
+
+    region.left     = offset.x;
+    region.right    = offset.x + extent.x;
+
+    switch (type)
+    {
+        case TextureType::Texture1DArray:
+            /* Array layers are addressed by the Y-component */
+            region.top              = 0;
+            region.bottom           = 1;
+            region.front            = 0;
+            region.back             = 1;
+            region.firstArrayLayer  = offset.y;
+            region.numArrayLayers   = extent.y;
+            break;
+
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+            /* Array layers (and cube faces) are addressed by the Z-component */
+            region.top              = offset.y;
+            region.bottom           = offset.y + extent.y;
+            region.front            = 0;
+            region.back             = 1;
+            region.firstArrayLayer  = offset.z;
+            region.numArrayLayers   = extent.z;
+            break;
+
+        default:
+            region.top              = offset.y;
+            region.bottom           = offset.y + extent.y;
+            region.front            = offset.z;
+            region.back             = offset.z + extent.z;
+            region.firstArrayLayer  = 0;
+            region.numArrayLayers   = 1;
+            break;
+    }
+
+    return region;
+}
+
+
+bool DXIsTearingSupported(IDXGIFactory* factory)
+{
+    /* Tearing requires DXGI 1.5 (Windows 10) and a driver with support for variable refresh rate displays */
+    ComPtr<IDXGIFactory5> factory5;
+    if (SUCCEEDED(factory->QueryInterface(IID_PPV_ARGS(&factory5))))
+    {
+        BOOL allowTearing = FALSE;
+        auto hr = factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing));
+        return (SUCCEEDED(hr) && allowTearing != FALSE);
+    }
+    return false;
+}
+
+bool DXGetFrameStatistics(IDXGISwapChain* swapChain, FrameStatistics& stats)
+{
+    DXGI_FRAME_STATISTICS frameStats;
+    if (FAILED(swapChain->GetFrameStatistics(&frameStats)))
+        return false;
+
+    /* Convert QPC time stamp into microseconds */
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    const auto syncTicks = static_cast<std::uint64_t>(frameStats.SyncQPCTime.QuadPart);
+    const auto ticksPerSec = static_cast<std::uint64_t>(frequency.QuadPart);
+
+    stats.presentCount      = frameStats.PresentCount;
+    stats.syncRefreshCount  = frameStats.SyncRefreshCount;
+    stats.syncTime          = (syncTicks / ticksPerSec) * 1000000ull + (syncTicks % ticksPerSec) * 1000000ull / ticksPerSec;
+
+    return true;
+}
+
+bool DXQueryVideoMemoryInfo(IDXGIAdapter* adapter, MemoryInfo& memoryInfo)
+{
+    /* Video memory budget is only available with DXGI 1.4 */
+    ComPtr<IDXGIAdapter3> adapter3;
+    if (FAILED(adapter->QueryInterface(IID_PPV_ARGS(adapter3.ReleaseAndGetAddressOf()))))
+        return false;
+
+    DXGI_QUERY_VIDEO_MEMORY_INFO localInfo, nonLocalInfo;
+    if (FAILED(adapter3->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &localInfo)) ||
+        FAILED(adapter3->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL, &nonLocalInfo)))
+    {
+        return false;
+    }
+
+    memoryInfo.local.budget             = localInfo.Budget;
+    memoryInfo.local.currentUsage       = localInfo.CurrentUsage;
+    memoryInfo.nonLocal.budget          = nonLocalInfo.Budget;
+    memoryInfo.nonLocal.currentUsage    = nonLocalInfo.CurrentUsage;
+
+    return true;
+}
+
+bool DXGetUniformType(D3D_SHADER_VARIABLE_CLASS varClass, D3D_SHADER_VARIABLE_TYPE varType, UINT rows, UINT columns, UniformType& type)
+{
+    /* Select base type and number of components */
+    UniformType baseTypes[4];
+    switch (varType)
+    {
+        case D3D_SVT_FLOAT:
+            baseTypes[0] = UniformType::Float;
+            baseTypes[1] = UniformType::Float2;
+            baseTypes[2] = UniformType::Float3;
+            baseTypes[3] = UniformType::Float4;
+            break;
+        case D3D_SVT_DOUBLE:
+            baseTypes[0] = UniformType::Double;
+            baseTypes[1] = UniformType::Double2;
+            baseTypes[2] = UniformType::Double3;
+            baseTypes[3] = UniformType::Double4;
+            break;
+        case D3D_SVT_INT:
+            baseTypes[0] = UniformType::Int;
+            baseTypes[1] = UniformType::Int2;
+            baseTypes[2] = UniformType::Int3;
+            baseTypes[3] = UniformType::Int4;
+            break;
+        case D3D_SVT_UINT:
+            baseTypes[0] = UniformType::UInt;
+            baseTypes[1] = UniformType::UInt2;
+            baseTypes[2] = UniformType::UInt3;
+            baseTypes[3] = UniformType::UInt4;
+            break;
+        case D3D_SVT_BOOL:
+            baseTypes[0] = UniformType::Boolean;
+            baseTypes[1] = UniformType::Boolean2;
+            baseTypes[2] = UniformType::Boolean3;
+            baseTypes[3] = UniformType::Boolean4;
+            break;
+        default:
+            return false;
+    }
+
+    switch (varClass)
+    {
+        case D3D_SVC_SCALAR:
+        case D3D_SVC_VECTOR:
+            if (columns >= 1 && columns <= 4)
+            {
+                type = baseTypes[columns - 1];
+                return true;
+            }
+            break;
+
+        case D3D_SVC_MATRIX_ROWS:
+        case D3D_SVC_MATRIX_COLUMNS:
+            if (rows == columns && (varType == D3D_SVT_FLOAT || varType == D3D_SVT_DOUBLE))
+            {
+                const bool isFloat = (varType == D3D_SVT_FLOAT);
+                switch (rows)
+                {
+                    case 2: type = (isFloat ? UniformType::Float2x2 : UniformType::Double2x2); return true;
+                    case 3: type = (isFloat ? UniformType::Float3x3 : UniformType::Double3x3); return true;
+                    case 4: type = (isFloat ? UniformType::Float4x4 : UniformType::Double4x4); return true;
+                    default: break;
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+UINT DXGetConstantElementSize(D3D_SHADER_VARIABLE_CLASS varClass, D3D_SHADER_VARIABLE_TYPE varType, UINT rows, UINT columns)
+{
+    const UINT componentSize = (varType == D3D_SVT_DOUBLE ? 8 : 4);
+
+    switch (varClass)
+    {
+        case D3D_SVC_MATRIX_COLUMNS:
+            return (columns - 1) * 16 + rows * componentSize;
+        case D3D_SVC_MATRIX_ROWS:
+            return (rows - 1) * 16 + columns * componentSize;
+        default:
+            return rows * columns * componentSize;
+    }
+}
 
 } // /namespace LLGL
 
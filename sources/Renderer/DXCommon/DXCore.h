@@ -11,8 +11,12 @@
 
 #include <LLGL/ColorRGBA.h>
 #include <LLGL/RenderSystemFlags.h>
+#include <LLGL/RenderContextDescriptor.h>
 #include <LLGL/VideoAdapter.h>
 #include <LLGL/Image.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/ShaderUniform.h>
+#include "ComPtr.h"
 #include <dxgi.h>
 #include <string>
 #include <vector>
@@ -41,6 +45,19 @@ struct D3DTextureFormatDescriptor
     DataType    dataType;
 };
 
+// D3D texture region structure with a box within each array layer (same layout as D3D11_BOX and D3D12_BOX) and a range of array layers.
+struct D3DTextureRegion
+{
+    UINT left;
+    UINT top;
+    UINT front;
+    UINT right;
+    UINT bottom;
+    UINT back;
+    UINT firstArrayLayer;
+    UINT numArrayLayers;
+};
+
 
 /* ----- Functions ----- */
 
@@ -50,6 +67,12 @@ std::string DXErrorToStr(const HRESULT errorCode);
 // Throws an std::runtime_error exception if 'errorCode' is not S_OK.
 void DXThrowIfFailed(const HRESULT errorCode, const std::string& info);
 
+/*
+Reports an error if 'errorCode' is not S_OK and returns true in that case (see ReportRuntimeError), so hot paths can return with an error code.
+The info string is only formatted on failure.
+*/
+bool DXReportIfFailed(const HRESULT errorCode, const char* info);
+
 // Returns the blob data as string.
 std::string DXGetBlobString(ID3DBlob* blob);
 
@@ -77,9 +100,39 @@ UINT DXGetDisassemblerFlags(int flags);
 // Returns the video adapter descriptor from the specified DXGI adapter.
 VideoAdapterDescriptor DXGetVideoAdapterDesc(IDXGIAdapter* adapter);
 
+// Returns the hardware adapters of the specified factory in the order in which they are to be tried for device creation (see RenderSystemDescriptor).
+std::vector<ComPtr<IDXGIAdapter>> DXGetPreferredAdapters(IDXGIFactory* factory, const RenderSystemDescriptor& desc);
+
 // Returns the LLGL format and data type for the specified DXGI format.
 D3DTextureFormatDescriptor DXGetTextureFormatDesc(DXGI_FORMAT format);
 
+// Returns true if the specified DXGI format is a depth or depth-stencil format.
+bool DXIsDepthStencilFormat(DXGI_FORMAT format);
+
+// Returns the typeless resource format for the specified depth-stencil format, so that the resource can be used with both DSVs and SRVs.
+DXGI_FORMAT DXGetTypelessDepthStencilFormat(DXGI_FORMAT format);
+
+// Returns the SRV format to read the depth component of the specified depth-stencil format.
+DXGI_FORMAT DXGetDepthSRVFormat(DXGI_FORMAT format);
+
+// Returns true if the specified DXGI factory supports presentation with tearing, i.e. DXGI_PRESENT_ALLOW_TEARING.
+bool DXIsTearingSupported(IDXGIFactory* factory);
+
+// Queries the frame statistics of the specified swap chain. Returns false if the swap chain has no statistics yet.
+bool DXGetFrameStatistics(IDXGISwapChain* swapChain, FrameStatistics& stats);
+
+// Returns the D3D texture region for the specified texture type, offset, and extent (see TextureRegion).
+D3DTextureRegion DXGetTextureRegion(const TextureType type, const Gs::Vector3ui& offset, const Gs::Vector3ui& extent);
+
+// Queries the budget and current usage of the local and non-local memory heaps. Returns false if the adapter does not support IDXGIAdapter3.
+bool DXQueryVideoMemoryInfo(IDXGIAdapter* adapter, MemoryInfo& memoryInfo);
+
+// Determines the uniform type of a constant buffer variable. Returns false if the type can not be expressed by UniformType (e.g. non-square matrices).
+bool DXGetUniformType(D3D_SHADER_VARIABLE_CLASS varClass, D3D_SHADER_VARIABLE_TYPE varType, UINT rows, UINT columns, UniformType& type);
+
+// Returns the size (in bytes) of a single non-structure element within a constant buffer, where each matrix row or column begins at a new 16-byte register.
+UINT DXGetConstantElementSize(D3D_SHADER_VARIABLE_CLASS varClass, D3D_SHADER_VARIABLE_TYPE varType, UINT rows, UINT columns);
+
 
 } // /namespace LLGL
 
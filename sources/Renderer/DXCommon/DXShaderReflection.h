@@ -0,0 +1,140 @@
+/*
+ * DXShaderReflection.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DX_SHADER_REFLECTION_H
+#define LLGL_DX_SHADER_REFLECTION_H
+
+
+#include "DXCore.h"
+#include <LLGL/BufferFlags.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Constant buffer reflection for both D3D11 and D3D12. The reflection interfaces of both APIs only differ in their names,
+so the templates are instantiated with ID3D11ShaderReflectionType/D3D11_SHADER_TYPE_DESC or ID3D12ShaderReflectionType/D3D12_SHADER_TYPE_DESC.
+*/
+
+// Returns the stride (in bytes) between two array elements within a constant buffer, since each element begins at a new 16-byte register.
+inline UINT DXGetConstantArrayStride(UINT elementSize)
+{
+    return ((elementSize + 15) / 16) * 16;
+}
+
+// Returns the size (in bytes) of a single element of the specified type, i.e. without its array elements.
+template <typename TTypeDesc, typename TTypeReflection>
+UINT DXGetConstantTypeElementSize(TTypeReflection* typeReflection, const TTypeDesc& typeDesc)
+{
+    if (typeDesc.Class != D3D_SVC_STRUCT)
+        return DXGetConstantElementSize(typeDesc.Class, typeDesc.Type, typeDesc.Rows, typeDesc.Columns);
+
+    /* Structures end with their last member */
+    UINT size = 0;
+
+    for (UINT i = 0; i < typeDesc.Members; ++i)
+    {
+        auto memberReflection = typeReflection->GetMemberTypeByIndex(i);
+
+        TTypeDesc memberDesc;
+        if (SUCCEEDED(memberReflection->GetDesc(&memberDesc)))
+        {
+            auto memberSize = DXGetConstantTypeElementSize<TTypeDesc>(memberReflection, memberDesc);
+            if (memberDesc.Elements > 1)
+                memberSize += DXGetConstantArrayStride(memberSize) * (memberDesc.Elements - 1);
+            size = std::max(size, memberDesc.Offset + memberSize);
+        }
+    }
+
+    return size;
+}
+
+// Appends the fields of the specified type at the specified offset. Members of structures are appended as separate fields, e.g. "lights[1].color".
+template <typename TTypeDesc, typename TTypeReflection>
+void DXReflectConstantFields(TTypeReflection* typeReflection, const std::string& name, UINT offset, std::vector<ConstantBufferFieldDescriptor>& fields)
+{
+    TTypeDesc typeDesc;
+    if (FAILED(typeReflection->GetDesc(&typeDesc)))
+        return;
+
+    auto elementSize = DXGetConstantTypeElementSize<TTypeDesc>(typeReflection, typeDesc);
+
+    if (typeDesc.Class == D3D_SVC_STRUCT)
+    {
+        /* Reflect members of each array element */
+        auto stride = DXGetConstantArrayStride(elementSize);
+
+        for (UINT i = 0, n = std::max(typeDesc.Elements, 1u); i < n; ++i)
+        {
+            auto elementName = (typeDesc.Elements > 0 ? name + "[" + std::to_string(i) + "]" : name);
+
+            for (UINT j = 0; j < typeDesc.Members; ++j)
+            {
+                auto memberReflection = typeReflection->GetMemberTypeByIndex(j);
+
+                TTypeDesc memberDesc;
+                if (SUCCEEDED(memberReflection->GetDesc(&memberDesc)))
+                {
+                    DXReflectConstantFields<TTypeDesc>(
+                        memberReflection,
+                        elementName + "." + typeReflection->GetMemberTypeName(j),
+                        offset + stride * i + memberDesc.Offset,
+                        fields
+                    );
+                }
+            }
+        }
+    }
+    else
+    {
+        /* Append field unless its type can not be expressed by UniformType */
+        ConstantBufferFieldDescriptor field;
+        if (DXGetUniformType(typeDesc.Class, typeDesc.Type, typeDesc.Rows, typeDesc.Columns, field.type))
+        {
+            field.name      = name;
+            field.offset    = offset;
+            field.size      = elementSize;
+
+            if (typeDesc.Elements > 0)
+            {
+                field.arraySize     = typeDesc.Elements;
+                field.arrayStride   = DXGetConstantArrayStride(elementSize);
+            }
+
+            fields.push_back(field);
+        }
+    }
+}
+
+// Appends the fields of all variables of the specified constant buffer.
+template <typename TVariableDesc, typename TTypeDesc, typename TBufferReflection>
+void DXReflectConstantBufferFields(TBufferReflection* bufferReflection, UINT numVariables, std::vector<ConstantBufferFieldDescriptor>& fields)
+{
+    for (UINT i = 0; i < numVariables; ++i)
+    {
+        auto variableReflection = bufferReflection->GetVariableByIndex(i);
+
+        TVariableDesc variableDesc;
+        if (SUCCEEDED(variableReflection->GetDesc(&variableDesc)))
+            DXReflectConstantFields<TTypeDesc>(variableReflection->GetType(), std::string(variableDesc.Name), variableDesc.StartOffset, fields);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -45,6 +45,18 @@ DXGI_FORMAT Map(const VectorType vectorType)
         case VectorType::UInt2:     return DXGI_FORMAT_R32G32_UINT;
         case VectorType::UInt3:     return DXGI_FORMAT_R32G32B32_UINT;
         case VectorType::UInt4:     return DXGI_FORMAT_R32G32B32A32_UINT;
+
+        case VectorType::Half2:             return DXGI_FORMAT_R16G16_FLOAT;
+        case VectorType::Half4:             return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case VectorType::Byte4Norm:         return DXGI_FORMAT_R8G8B8A8_SNORM;
+        case VectorType::UByte4Norm:        return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case VectorType::Short2Norm:        return DXGI_FORMAT_R16G16_SNORM;
+        case VectorType::Short4Norm:        return DXGI_FORMAT_R16G16B16A16_SNORM;
+        case VectorType::UShort2Norm:       return DXGI_FORMAT_R16G16_UNORM;
+        case VectorType::UShort4Norm:       return DXGI_FORMAT_R16G16B16A16_UNORM;
+        case VectorType::UInt1010102Norm:   return DXGI_FORMAT_R10G10B10A2_UNORM;
+
+        default:                    break;
     }
     MapFailed("VectorType", "DXGI_FORMAT");
 }
@@ -61,6 +73,7 @@ DXGI_FORMAT Map(const DataType dataType)
         case DataType::UInt32:  return DXGI_FORMAT_R32_UINT;
         case DataType::Float:   return DXGI_FORMAT_R32_FLOAT;
         case DataType::Double:  break;
+        case DataType::Float16: return DXGI_FORMAT_R16_FLOAT;
     }
     MapFailed("DataType", "DXGI_FORMAT");
 }
@@ -80,6 +93,7 @@ DXGI_FORMAT Map(const TextureFormat textureFormat)
         /* --- Sized internal formats --- */
         case TextureFormat::R8:             return DXGI_FORMAT_R8_UNORM;
         case TextureFormat::R8Sgn:          return DXGI_FORMAT_R8_SNORM;
+        case TextureFormat::R8UInt:         return DXGI_FORMAT_R8_UINT;
 
         case TextureFormat::R16:            return DXGI_FORMAT_R16_UNORM;
         case TextureFormat::R16Sgn:         return DXGI_FORMAT_R16_SNORM;
@@ -127,6 +141,12 @@ DXGI_FORMAT Map(const TextureFormat textureFormat)
         case TextureFormat::RGBA_DXT1:      return DXGI_FORMAT_BC1_UNORM;
         case TextureFormat::RGBA_DXT3:      return DXGI_FORMAT_BC2_UNORM;
         case TextureFormat::RGBA_DXT5:      return DXGI_FORMAT_BC3_UNORM;
+        case TextureFormat::R_BC4:          return DXGI_FORMAT_BC4_UNORM;
+        case TextureFormat::RG_BC5:         return DXGI_FORMAT_BC5_UNORM;
+        case TextureFormat::RGB_BC6H:       return DXGI_FORMAT_BC6H_UF16;
+        case TextureFormat::RGBA_BC7:       return DXGI_FORMAT_BC7_UNORM;
+
+        default:                            break;
     }
     MapFailed("TextureFormat", "DXGI_FORMAT");
 }
@@ -193,6 +213,7 @@ TextureFormat Unmap(const DXGI_FORMAT format)
         /* --- Sized internal formats --- */
         case DXGI_FORMAT_R8_UNORM:              return TextureFormat::R8;
         case DXGI_FORMAT_R8_SNORM:              return TextureFormat::R8Sgn;
+        case DXGI_FORMAT_R8_UINT:               return TextureFormat::R8UInt;
 
         case DXGI_FORMAT_R16_UNORM:             return TextureFormat::R16;
         case DXGI_FORMAT_R16_SNORM:             return TextureFormat::R16Sgn;
@@ -232,6 +253,10 @@ TextureFormat Unmap(const DXGI_FORMAT format)
         case DXGI_FORMAT_BC1_UNORM:             return TextureFormat::RGBA_DXT1;
         case DXGI_FORMAT_BC2_UNORM:             return TextureFormat::RGBA_DXT3;
         case DXGI_FORMAT_BC3_UNORM:             return TextureFormat::RGBA_DXT5;
+        case DXGI_FORMAT_BC4_UNORM:             return TextureFormat::R_BC4;
+        case DXGI_FORMAT_BC5_UNORM:             return TextureFormat::RG_BC5;
+        case DXGI_FORMAT_BC6H_UF16:             return TextureFormat::RGB_BC6H;
+        case DXGI_FORMAT_BC7_UNORM:             return TextureFormat::RGBA_BC7;
     }
     return TextureFormat::Unknown;
 }
@@ -10,6 +10,8 @@
 
 
 #include <LLGL/Buffer.h>
+#include <LLGL/RenderingProfiler.h>
+#include <vector>
 
 
 namespace LLGL
@@ -31,6 +33,14 @@ class DbgBuffer : public Buffer
         BufferDescriptor    desc;
         unsigned int        elements    = 0;
         bool                initialized = false;
+        std::size_t         mappedSize  = 0;
+        long                mapFlags    = 0;
+
+        RenderingProfiler::MemoryAllocation memory; // Memory allocation, which has been recorded by the profiler.
+
+        // Copy of the constant buffer contents to detect redundant writes; only maintained if the profiler is enabled.
+        std::vector<char>   shadowData;
+        std::size_t         shadowSize  = 0;    // Number of valid bytes at the beginning of 'shadowData'
 
 };
 
@@ -16,6 +16,7 @@
 #include "DbgRenderTarget.h"
 #include "DbgShaderProgram.h"
 #include "DbgQuery.h"
+#include "DbgQueryArray.h"
 
 
 namespace LLGL
@@ -23,10 +24,11 @@ namespace LLGL
 
 
 DbgCommandBuffer::DbgCommandBuffer(
-    CommandBuffer& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, const RenderingCaps& caps) :
+    CommandBuffer& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, RenderingTracer* tracer, const RenderingCaps& caps) :
         instance  { instance },
         profiler_ { profiler },
         debugger_ { debugger },
+        tracer_   { tracer   },
         caps_     { caps     }
 {
 }
@@ -35,16 +37,19 @@ DbgCommandBuffer::DbgCommandBuffer(
 
 void DbgCommandBuffer::SetGraphicsAPIDependentState(const GraphicsAPIDependentStateDescriptor& state)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.SetGraphicsAPIDependentState(state);
 }
 
 void DbgCommandBuffer::SetViewport(const Viewport& viewport)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.SetViewport(viewport);
 }
 
 void DbgCommandBuffer::SetViewportArray(unsigned int numViewports, const Viewport* viewportArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -59,11 +64,13 @@ void DbgCommandBuffer::SetViewportArray(unsigned int numViewports, const Viewpor
 
 void DbgCommandBuffer::SetScissor(const Scissor& scissor)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.SetScissor(scissor);
 }
 
 void DbgCommandBuffer::SetScissorArray(unsigned int numScissors, const Scissor* scissorArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -76,78 +83,168 @@ void DbgCommandBuffer::SetScissorArray(unsigned int numScissors, const Scissor*
     instance.SetScissorArray(numScissors, scissorArray);
 }
 
+void DbgCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!caps_.hasVariableRateShading && rate != ShadingRate::Rate1x1)
+            LLGL_DBG_WARN(WarningType::ImproperState, "variable-rate shading is not supported; shading rate is ignored");
+    }
+
+    instance.SetShadingRate(rate);
+}
+
+void DbgCommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (texture)
+    {
+        auto& textureDbg = LLGL_CAST(DbgTexture&, *texture);
+
+        if (debugger_)
+        {
+            LLGL_DBG_SOURCE;
+            if (!caps_.hasShadingRateImage)
+                LLGL_DBG_WARN(WarningType::ImproperState, "shading rate images are not supported; shading rate image is ignored");
+            if (textureDbg.GetType() != TextureType::Texture2D)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "shading rate image must be a 2D texture");
+            if (textureDbg.desc.format != TextureFormat::R8UInt)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "shading rate image must have format TextureFormat::R8UInt");
+        }
+
+        instance.SetShadingRateImage(&(textureDbg.instance));
+    }
+    else
+        instance.SetShadingRateImage(nullptr);
+}
+
+void DbgCommandBuffer::SetDepthBounds(float minDepth, float maxDepth)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!caps_.hasDepthBoundsTest)
+            LLGL_DBG_WARN(WarningType::ImproperState, "depth-bounds test is not supported; depth bounds are ignored");
+        if (minDepth < 0.0f || maxDepth > 1.0f)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "depth bounds must be in the range [0, 1]");
+        if (minDepth > maxDepth)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "minimal depth bound must not be greater than the maximal depth bound");
+    }
+
+    instance.SetDepthBounds(minDepth, maxDepth);
+}
+
 void DbgCommandBuffer::SetClearColor(const ColorRGBAf& color)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.SetClearColor(color);
 }
 
 void DbgCommandBuffer::SetClearDepth(float depth)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.SetClearDepth(depth);
 }
 
 void DbgCommandBuffer::SetClearStencil(int stencil)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.SetClearStencil(stencil);
 }
 
 void DbgCommandBuffer::Clear(long flags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.Clear(flags);
+    ProfileClear(__FUNCTION__, flags, 0);
 }
 
 void DbgCommandBuffer::ClearTarget(unsigned int targetIndex, const LLGL::ColorRGBAf& color)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.ClearTarget(targetIndex, color);
+    ProfileClear(__FUNCTION__, 0, (targetIndex < 32 ? (1u << targetIndex) : 0u));
 }
 
 /* ----- Buffers ------ */
 
-void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer)
+void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer, unsigned int offset)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        DebugBufferType(buffer.GetType(), BufferType::Vertex);
+        if (buffer.GetType() == BufferType::StreamOutput)
+        {
+            if (bufferDbg.desc.vertexBuffer.format.stride == 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "stream-output buffer cannot be used as vertex buffer without vertex format");
+        }
+        else
+            DebugBufferType(buffer.GetType(), BufferType::Vertex);
+        if (offset % 4 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "vertex buffer offset must be a multiple of 4, but got " + std::to_string(offset));
+        if (offset > 0 && offset >= bufferDbg.desc.size)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "vertex buffer offset out of bounds (" + std::to_string(offset) + " specified but limit is " + std::to_string(bufferDbg.desc.size) + ")");
     }
-
-    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
     
     if (debugger_)
     {
+        const auto& vertexFormat = bufferDbg.desc.vertexBuffer.format;
         bindings_.vertexBuffer = (&bufferDbg);
-        vertexFormat_ = bufferDbg.desc.vertexBuffer.format;
+        bindings_.vertexBufferOffset = (vertexFormat.stride > 0 ? offset / vertexFormat.stride : 0);
+        states_.drawStates |= DrawStateVertexBuffer;
+        UpdateVertexLayoutState();
     }
     
-    instance.SetVertexBuffer(bufferDbg.instance);
+    instance.SetVertexBuffer(bufferDbg.instance, offset);
     
     LLGL_DBG_PROFILER_DO(setVertexBuffer.Inc());
+    ProfileBinding(__FUNCTION__, profiled_.vertexBuffer, { &buffer, 0, offset, 0 });
 }
 
 void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     //todo...
     instance.SetVertexBufferArray(bufferArray);
+    profiled_.vertexBuffer = {};
 }
 
-void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
+void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer, unsigned int offset)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
         DebugBufferType(buffer.GetType(), BufferType::Index);
-        bindings_.indexBuffer = (&bufferDbg);
+
+        const auto formatSize = bufferDbg.desc.indexBuffer.format.GetFormatSize();
+        if (formatSize > 0 && offset % formatSize != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "index buffer offset must be a multiple of the index format size, but got " + std::to_string(offset));
+        if (offset > 0 && offset >= bufferDbg.desc.size)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "index buffer offset out of bounds (" + std::to_string(offset) + " specified but limit is " + std::to_string(bufferDbg.desc.size) + ")");
+
+        bindings_.indexBuffer       = (&bufferDbg);
+        bindings_.indexBufferOffset = (formatSize > 0 ? offset / formatSize : 0);
+        states_.drawStates |= DrawStateIndexBuffer;
     }
 
-    instance.SetIndexBuffer(bufferDbg.instance);
+    instance.SetIndexBuffer(bufferDbg.instance, offset);
     
     LLGL_DBG_PROFILER_DO(setIndexBuffer.Inc());
+    ProfileBinding(__FUNCTION__, profiled_.indexBuffer, { &buffer, 0, offset, 0 });
 }
 
 void DbgCommandBuffer::SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
     if (debugger_)
@@ -160,10 +257,12 @@ void DbgCommandBuffer::SetConstantBuffer(Buffer& buffer, unsigned int slot, long
     instance.SetConstantBuffer(bufferDbg.instance, slot, shaderStageFlags);
     
     LLGL_DBG_PROFILER_DO(setConstantBuffer.Inc());
+    ProfileSlotBinding(__FUNCTION__, profiled_.constantBuffers, slot, { &buffer, shaderStageFlags, 0, 0 });
 }
 
 void DbgCommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -174,10 +273,38 @@ void DbgCommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsigned
     instance.SetConstantBufferArray(bufferArray, startSlot, shaderStageFlags);
     
     LLGL_DBG_PROFILER_DO(setConstantBuffer.Inc());
+    ResetProfiledSlotBindings();
+}
+
+void DbgCommandBuffer::SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!caps_.hasConstantBufferRanges)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("constant buffer ranges");
+        DebugBufferType(buffer.GetType(), BufferType::Constant);
+        DebugShaderStageFlags(shaderStageFlags, ShaderStageFlags::AllStages);
+        if (offset % 256 != 0 || size % 256 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "offset and size of constant buffer range must be multiples of 256");
+        if (size == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "constant buffer range is empty");
+        if (bufferDbg.desc.size > 0 && offset + size > bufferDbg.desc.size)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "constant buffer range out of bounds");
+    }
+
+    instance.SetConstantBufferRange(bufferDbg.instance, offset, size, slot, shaderStageFlags);
+
+    LLGL_DBG_PROFILER_DO(setConstantBuffer.Inc());
+    ProfileSlotBinding(__FUNCTION__, profiled_.constantBuffers, slot, { &buffer, shaderStageFlags, offset, size });
 }
 
 void DbgCommandBuffer::SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
     
     if (debugger_)
@@ -190,10 +317,12 @@ void DbgCommandBuffer::SetStorageBuffer(Buffer& buffer, unsigned int slot, long
     instance.SetStorageBuffer(bufferDbg.instance, slot, shaderStageFlags);
     
     LLGL_DBG_PROFILER_DO(setStorageBuffer.Inc());
+    ProfileSlotBinding(__FUNCTION__, profiled_.storageBuffers, slot, { &buffer, shaderStageFlags, 0, 0 });
 }
 
 void DbgCommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -204,10 +333,44 @@ void DbgCommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigned
     instance.SetStorageBufferArray(bufferArray, startSlot, shaderStageFlags);
     
     LLGL_DBG_PROFILER_DO(setStorageBuffer.Inc());
+    ResetProfiledSlotBindings();
+}
+
+void DbgCommandBuffer::ResetBufferCounter(Buffer& buffer, unsigned int value)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugBufferCounter(bufferDbg);
+    }
+
+    instance.ResetBufferCounter(bufferDbg.instance, value);
+}
+
+void DbgCommandBuffer::CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+    auto& srcBufferDbg = LLGL_CAST(DbgBuffer&, srcBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugBufferCounter(srcBufferDbg);
+        DebugBufferRange(dstBufferDbg, dstOffset, 4);
+        if (dstOffset % 4 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "offset for buffer counter copy must be a multiple of 4");
+    }
+
+    instance.CopyBufferCounter(dstBufferDbg.instance, dstOffset, srcBufferDbg.instance);
 }
 
 void DbgCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
     
     if (debugger_)
@@ -224,6 +387,7 @@ void DbgCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 
 void DbgCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -237,6 +401,7 @@ void DbgCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 
 void DbgCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -252,21 +417,58 @@ void DbgCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 
 void DbgCommandBuffer::EndStreamOutput()
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
         if (!states_.streamOutputBusy)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output has not started");
-        states_.streamOutputBusy = false;
+        states_.streamOutputBusy    = false;
+        states_.streamOutputPaused  = false;
     }
 
     instance.EndStreamOutput();
 }
 
+void DbgCommandBuffer::PauseStreamOutput()
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!caps_.hasStreamOutputDraws)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("pausing stream-outputs");
+        if (!states_.streamOutputBusy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output has not started");
+        else if (states_.streamOutputPaused)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output is already paused");
+        states_.streamOutputPaused = true;
+    }
+
+    instance.PauseStreamOutput();
+}
+
+void DbgCommandBuffer::ResumeStreamOutput()
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!caps_.hasStreamOutputDraws)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("resuming stream-outputs");
+        if (!states_.streamOutputPaused)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output has not been paused");
+        states_.streamOutputPaused = false;
+    }
+
+    instance.ResumeStreamOutput();
+}
+
 /* ----- Textures ----- */
 
 void DbgCommandBuffer::SetTexture(Texture& texture, unsigned int slot, long shaderStageFlags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
 
     if (debugger_)
@@ -278,10 +480,12 @@ void DbgCommandBuffer::SetTexture(Texture& texture, unsigned int slot, long shad
     instance.SetTexture(textureDbg.instance, slot, shaderStageFlags);
     
     LLGL_DBG_PROFILER_DO(setTexture.Inc());
+    ProfileSlotBinding(__FUNCTION__, profiled_.textures, slot, { &texture, shaderStageFlags, 0, 0 });
 }
 
 void DbgCommandBuffer::SetTextureArray(TextureArray& textureArray, unsigned int startSlot, long shaderStageFlags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -291,12 +495,14 @@ void DbgCommandBuffer::SetTextureArray(TextureArray& textureArray, unsigned int
     instance.SetTextureArray(textureArray, startSlot, shaderStageFlags);
     
     LLGL_DBG_PROFILER_DO(setTexture.Inc());
+    ResetProfiledSlotBindings();
 }
 
 /* ----- Sampler States ----- */
 
 void DbgCommandBuffer::SetSampler(Sampler& sampler, unsigned int slot, long shaderStageFlags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -306,10 +512,12 @@ void DbgCommandBuffer::SetSampler(Sampler& sampler, unsigned int slot, long shad
     instance.SetSampler(sampler, slot, shaderStageFlags);
     
     LLGL_DBG_PROFILER_DO(setSampler.Inc());
+    ProfileSlotBinding(__FUNCTION__, profiled_.samplers, slot, { &sampler, shaderStageFlags, 0, 0 });
 }
 
 void DbgCommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -319,65 +527,209 @@ void DbgCommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned int
     instance.SetSamplerArray(samplerArray, startSlot, shaderStageFlags);
     
     LLGL_DBG_PROFILER_DO(setSampler.Inc());
+    ResetProfiledSlotBindings();
+}
+
+/* ----- Resource Heaps ----- */
+
+void DbgCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    instance.SetResourceHeap(resourceHeap);
+
+    LLGL_DBG_PROFILER_DO(setResourceHeap.Inc());
+    ProfileBinding(__FUNCTION__, profiled_.resourceHeap, { &resourceHeap, 0, 0, 0 });
+    ResetProfiledSlotBindings();
 }
 
 /* ----- Render Targets ----- */
 
 void DbgCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& renderTargetDbg = LLGL_CAST(DbgRenderTarget&, renderTarget);
     
     instance.SetRenderTarget(renderTargetDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setRenderTarget.Inc());
+    if (profiled_.renderTarget.object != &renderTarget)
+        ResetProfiledClears();
+    ProfileBinding(__FUNCTION__, profiled_.renderTarget, { &renderTarget, 0, 0, 0 });
 }
 
 void DbgCommandBuffer::SetRenderTarget(RenderContext& renderContext)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& renderContextDbg = LLGL_CAST(DbgRenderContext&, renderContext);
     
     instance.SetRenderTarget(renderContextDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setRenderTarget.Inc());
+    if (profiled_.renderTarget.object != &renderContext)
+        ResetProfiledClears();
+    ProfileBinding(__FUNCTION__, profiled_.renderTarget, { &renderContext, 0, 0, 0 });
+}
+
+/* ----- Render Passes ----- */
+
+void DbgCommandBuffer::BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& renderTargetDbg = LLGL_CAST(DbgRenderTarget&, renderTarget);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (states_.renderPassBusy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "render pass is already busy");
+        states_.renderPassBusy = true;
+    }
+
+    instance.BeginRenderPass(renderTargetDbg.instance, renderPassDesc);
+
+    LLGL_DBG_PROFILER_DO(setRenderTarget.Inc());
+    profiled_.renderTarget = { &renderTarget, 0, 0, 0 };
+    ResetProfiledClears();
+}
+
+void DbgCommandBuffer::BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& renderContextDbg = LLGL_CAST(DbgRenderContext&, renderContext);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (states_.renderPassBusy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "render pass is already busy");
+        states_.renderPassBusy = true;
+    }
+
+    instance.BeginRenderPass(renderContextDbg.instance, renderPassDesc);
+
+    LLGL_DBG_PROFILER_DO(setRenderTarget.Inc());
+    profiled_.renderTarget = { &renderContext, 0, 0, 0 };
+    ResetProfiledClears();
+}
+
+void DbgCommandBuffer::EndRenderPass()
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!states_.renderPassBusy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "render pass has not started");
+        states_.renderPassBusy = false;
+    }
+
+    instance.EndRenderPass();
+    ResetProfiledClears();
 }
 
 /* ----- Pipeline States ----- */
 
 void DbgCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& graphicsPipelineDbg = LLGL_CAST(DbgGraphicsPipeline&, graphicsPipeline);
 
     if (debugger_)
     {
         bindings_.graphicsPipeline = (&graphicsPipelineDbg);
         topology_ = graphicsPipelineDbg.desc.primitiveTopology;
+        states_.drawStates |= DrawStateGraphicsPipeline;
+        UpdateVertexLayoutState();
     }
 
     instance.SetGraphicsPipeline(graphicsPipelineDbg.instance);
     
     LLGL_DBG_PROFILER_DO(setGraphicsPipeline.Inc());
+    ProfileBinding(__FUNCTION__, profiled_.graphicsPipeline, { &graphicsPipeline, 0, 0, 0 });
 }
 
 void DbgCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
         bindings_.computePipeline = (&computePipeline);
     
     instance.SetComputePipeline(computePipeline);
     
     LLGL_DBG_PROFILER_DO(setComputePipeline.Inc());
+    ProfileBinding(__FUNCTION__, profiled_.computePipeline, { &computePipeline, 0, 0, 0 });
+}
+
+void DbgCommandBuffer::SetPushConstants(unsigned int offset, unsigned int size, const void* data)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (caps_.maxPushConstantsSize == 0)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("push constants");
+        DebugGraphicsPipelineSet();
+        if (offset % 16 != 0 || size % 16 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "offset and size of push constants must be multiples of 16");
+        if (size == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "push constants range is empty");
+        if (data == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid data for push constants");
+        if (bindings_.graphicsPipeline && offset + size > bindings_.graphicsPipeline->desc.pushConstants.size)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "push constants range out of bounds");
+    }
+
+    instance.SetPushConstants(offset, size, data);
+}
+
+void DbgCommandBuffer::SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!caps_.hasShaderClassInterfaces)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("shader class interfaces");
+        if (stage == ShaderType::Compute)
+            DebugComputePipelineSet();
+        else
+        {
+            DebugGraphicsPipelineSet();
+            if (bindings_.graphicsPipeline)
+            {
+                auto shaderProgramDbg = LLGL_CAST(DbgShaderProgram*, bindings_.graphicsPipeline->desc.shaderProgram);
+                if (!shaderProgramDbg->HasShaderType(stage))
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "no shader of the specified stage in the shader program of the bound graphics pipeline");
+            }
+        }
+        if (numSlots > 0 && classInstances == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid array of class instances");
+        else
+        {
+            for (unsigned int i = 0; i < numSlots; ++i)
+            {
+                if (classInstances[i] < 0)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid class instance ID for interface slot " + std::to_string(i));
+            }
+        }
+    }
+
+    instance.SetShaderClassInstances(stage, numSlots, classInstances);
 }
 
 /* ----- Queries ----- */
 
 void DbgCommandBuffer::BeginQuery(Query& query)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& queryDbg = LLGL_CAST(DbgQuery&, query);
 
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        if (queryDbg.state == DbgQuery::State::Busy)
+        if (queryDbg.GetType() == QueryType::Timestamp)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "timestamp queries must only be ended");
+        else if (queryDbg.state == DbgQuery::State::Busy)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "query is already busy");
         queryDbg.state = DbgQuery::State::Busy;
     }
@@ -387,12 +739,13 @@ void DbgCommandBuffer::BeginQuery(Query& query)
 
 void DbgCommandBuffer::EndQuery(Query& query)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& queryDbg = LLGL_CAST(DbgQuery&, query);
 
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-        if (queryDbg.state != DbgQuery::State::Busy)
+        if (queryDbg.state != DbgQuery::State::Busy && queryDbg.GetType() != QueryType::Timestamp)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "query has not started");
         queryDbg.state = DbgQuery::State::Ready;
     }
@@ -402,33 +755,197 @@ void DbgCommandBuffer::EndQuery(Query& query)
 
 bool DbgCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& queryDbg = LLGL_CAST(DbgQuery&, query);
 
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
+        DebugImmediateCommandBuffer();
         if (queryDbg.state != DbgQuery::State::Ready)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "query result is not ready");
     }
 
+    /* Query results cannot be recorded, so they are never available to deferred command buffers */
+    if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
+        return false;
+
     return instance.QueryResult(queryDbg.instance, result);
 }
 
+bool DbgCommandBuffer::QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& queryArrayDbg = LLGL_CAST(DbgQueryArray&, queryArray);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugImmediateCommandBuffer();
+        DebugQueryArrayRange(queryArrayDbg, firstQuery, numQueries);
+        if (results == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid output array for query results");
+    }
+
+    if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
+        return false;
+
+    return instance.QueryResult(queryArrayDbg.instance, firstQuery, numQueries, results);
+}
+
+bool DbgCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& queryDbg = LLGL_CAST(DbgQuery&, query);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugImmediateCommandBuffer();
+        if (queryDbg.GetType() != QueryType::PipelineStatistics)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "query must have type QueryType::PipelineStatistics");
+        if (queryDbg.state != DbgQuery::State::Ready)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "query result is not ready");
+    }
+
+    if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
+        return false;
+
+    return instance.QueryPipelineStatisticsResult(queryDbg.instance, result);
+}
+
+void DbgCommandBuffer::ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& queryArrayDbg = LLGL_CAST(DbgQueryArray&, queryArray);
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugQueryArrayRange(queryArrayDbg, firstQuery, numQueries);
+        if (dstOffset % sizeof(std::uint64_t) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer offset for query results must be a multiple of 8");
+        DebugBufferRange(dstBufferDbg, dstOffset, numQueries * static_cast<unsigned int>(sizeof(std::uint64_t)));
+    }
+
+    instance.ResolveQueryData(queryArrayDbg.instance, firstQuery, numQueries, dstBufferDbg.instance, dstOffset);
+}
+
 void DbgCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     auto& queryDbg = LLGL_CAST(DbgQuery&, query);
     instance.BeginRenderCondition(queryDbg.instance, mode);
 }
 
 void DbgCommandBuffer::EndRenderCondition()
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.EndRenderCondition();
 }
 
+/* ----- Copy ----- */
+
+void DbgCommandBuffer::CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
+    auto& srcBufferDbg = LLGL_CAST(DbgBuffer&, srcBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugBufferRange(dstBufferDbg, dstOffset, size);
+        DebugBufferRange(srcBufferDbg, srcOffset, size);
+        if (&dstBufferDbg == &srcBufferDbg && dstOffset < srcOffset + size && srcOffset < dstOffset + size)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "overlapping source and destination ranges in buffer copy");
+    }
+
+    instance.CopyBuffer(dstBufferDbg.instance, dstOffset, srcBufferDbg.instance, srcOffset, size);
+}
+
+void DbgCommandBuffer::CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+    auto& srcTextureDbg = LLGL_CAST(DbgTexture&, srcTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugTextureRegion(dstTextureDbg, dstMipLevel, dstOffset, srcRegion.extent);
+        DebugTextureRegion(srcTextureDbg, srcRegion.mipLevel, srcRegion.offset, srcRegion.extent);
+        if (IsMultiSampleTexture(dstTextureDbg.GetType()) || IsMultiSampleTexture(srcTextureDbg.GetType()))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot copy multi-sampled textures");
+    }
+
+    instance.CopyTexture(dstTextureDbg.instance, dstMipLevel, dstOffset, srcTextureDbg.instance, srcRegion);
+    ResetProfiledClears();
+}
+
+void DbgCommandBuffer::ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+    auto& srcTextureDbg = LLGL_CAST(DbgTexture&, srcTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugTextureRegion(dstTextureDbg, dstMipLevel, dstOffset, srcRegion.extent);
+        DebugTextureRegion(srcTextureDbg, 0, srcRegion.offset, srcRegion.extent);
+        if (!IsMultiSampleTexture(srcTextureDbg.GetType()))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "source texture of resolve must be multi-sampled");
+        if (IsMultiSampleTexture(dstTextureDbg.GetType()))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "destination texture of resolve must not be multi-sampled");
+        if (dstTextureDbg.desc.format != srcTextureDbg.desc.format)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "source and destination textures of resolve have different formats");
+    }
+
+    instance.ResolveTexture(dstTextureDbg.instance, dstMipLevel, dstOffset, srcTextureDbg.instance, srcRegion);
+    ResetProfiledClears();
+}
+
+void DbgCommandBuffer::CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+    auto& srcBufferDbg = LLGL_CAST(DbgBuffer&, srcBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugTextureRegion(dstTextureDbg, dstRegion.mipLevel, dstRegion.offset, dstRegion.extent);
+
+        /* Validate size of image data */
+        const auto& extent = dstRegion.extent;
+        std::uint64_t dataSize = 0;
+
+        if (IsCompressedFormat(imageFormat))
+            dataSize = CompressedImageSize(dstTextureDbg.desc.format, extent.x, extent.y, extent.z);
+        else
+            dataSize = static_cast<std::uint64_t>(extent.x) * extent.y * extent.z * ImageFormatSize(imageFormat) * DataTypeSize(dataType);
+
+        if (srcOffset + dataSize > srcBufferDbg.desc.size)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "image data out of bounds (" + std::to_string(srcOffset + dataSize) +
+                " bytes required but buffer size is " + std::to_string(srcBufferDbg.desc.size) + ")"
+            );
+        }
+    }
+
+    instance.CopyBufferToTexture(dstTextureDbg.instance, dstRegion, srcBufferDbg.instance, srcOffset, imageFormat, dataType);
+    ResetProfiledClears();
+}
+
 /* ----- Drawing ----- */
 
 void DbgCommandBuffer::Draw(unsigned int numVertices, unsigned int firstVertex)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -437,11 +954,13 @@ void DbgCommandBuffer::Draw(unsigned int numVertices, unsigned int firstVertex)
     
     instance.Draw(numVertices, firstVertex);
     
+    ProfileDraw(__FUNCTION__, numVertices, 1);
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices));
 }
 
 void DbgCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -450,11 +969,13 @@ void DbgCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstI
     
     instance.DrawIndexed(numVertices, firstIndex);
     
+    ProfileDraw(__FUNCTION__, numVertices, 1);
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices));
 }
 
 void DbgCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex, int vertexOffset)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -463,11 +984,13 @@ void DbgCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstI
     
     instance.DrawIndexed(numVertices, firstIndex, vertexOffset);
     
+    ProfileDraw(__FUNCTION__, numVertices, 1);
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices));
 }
 
 void DbgCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -477,11 +1000,13 @@ void DbgCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firs
     
     instance.DrawInstanced(numVertices, firstVertex, numInstances);
     
+    ProfileDraw(__FUNCTION__, numVertices, numInstances);
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices, numInstances));
 }
 
 void DbgCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -491,11 +1016,13 @@ void DbgCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firs
     
     instance.DrawInstanced(numVertices, firstVertex, numInstances, instanceOffset);
     
+    ProfileDraw(__FUNCTION__, numVertices, numInstances);
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices, numInstances));
 }
 
 void DbgCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -505,11 +1032,13 @@ void DbgCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned i
     
     instance.DrawIndexedInstanced(numVertices, numInstances, firstIndex);
     
+    ProfileDraw(__FUNCTION__, numVertices, numInstances);
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices, numInstances));
 }
 
 void DbgCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -519,11 +1048,13 @@ void DbgCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned i
     
     instance.DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset);
     
+    ProfileDraw(__FUNCTION__, numVertices, numInstances);
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices, numInstances));
 }
 
 void DbgCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -533,9 +1064,126 @@ void DbgCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned i
     
     instance.DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset, instanceOffset);
     
+    ProfileDraw(__FUNCTION__, numVertices, numInstances);
     LLGL_DBG_PROFILER_DO(RecordDrawCall(topology_, numVertices, numInstances));
 }
 
+void DbgCommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugDrawIndirect(bufferDbg, offset, 1, sizeof(DrawIndirectArguments), sizeof(DrawIndirectArguments));
+    }
+
+    instance.DrawIndirect(bufferDbg.instance, offset);
+    ResetProfiledClears();
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc());
+}
+
+void DbgCommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugDrawIndirect(bufferDbg, offset, numCommands, stride, sizeof(DrawIndirectArguments));
+    }
+
+    instance.DrawIndirect(bufferDbg.instance, offset, numCommands, stride);
+    ResetProfiledClears();
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc(numCommands));
+}
+
+void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugIndexBufferSet();
+        DebugDrawIndirect(bufferDbg, offset, 1, sizeof(DrawIndexedIndirectArguments), sizeof(DrawIndexedIndirectArguments));
+    }
+
+    instance.DrawIndexedIndirect(bufferDbg.instance, offset);
+    ResetProfiledClears();
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc());
+}
+
+void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugIndexBufferSet();
+        DebugDrawIndirect(bufferDbg, offset, numCommands, stride, sizeof(DrawIndexedIndirectArguments));
+    }
+
+    instance.DrawIndexedIndirect(bufferDbg.instance, offset, numCommands, stride);
+    ResetProfiledClears();
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc(numCommands));
+}
+
+void DbgCommandBuffer::DrawStreamOutput()
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!caps_.hasStreamOutputDraws)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("drawing stream-outputs");
+        DebugDrawStates(DrawStateGraphicsPipeline | DrawStateVertexBuffer | DrawStateVertexLayout);
+        if (bindings_.vertexBuffer && bindings_.vertexBuffer->desc.type != BufferType::StreamOutput)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "no stream-output buffer is bound as vertex buffer");
+        else if (states_.streamOutputBusy && !states_.streamOutputPaused && bindings_.vertexBuffer == bindings_.streamOutput)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot draw stream-output buffer while it is captured");
+    }
+
+    instance.DrawStreamOutput();
+    ResetProfiledClears();
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc());
+}
+
+void DbgCommandBuffer::DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!caps_.hasMeshShaders)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("mesh shaders");
+        DebugDrawStates(DrawStateGraphicsPipeline);
+        if (bindings_.graphicsPipeline)
+        {
+            auto shaderProgramDbg = LLGL_CAST(DbgShaderProgram*, bindings_.graphicsPipeline->desc.shaderProgram);
+            if (!shaderProgramDbg->HasShaderType(ShaderType::Mesh))
+                LLGL_DBG_ERROR(ErrorType::InvalidState, "no mesh shader in the shader program of the bound graphics pipeline");
+        }
+        if (numTasksX * numTasksY * numTasksZ == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "mesh task count has volume of 0 units");
+    }
+
+    instance.DrawMeshTasks(numTasksX, numTasksY, numTasksZ);
+    ResetProfiledClears();
+
+    LLGL_DBG_PROFILER_DO(drawCalls.Inc());
+}
+
 /* ----- Compute ----- */
 
 void DbgCommandBuffer::DebugThreadGroupLimit(unsigned int size, unsigned int limit)
@@ -552,17 +1200,22 @@ void DbgCommandBuffer::DebugThreadGroupLimit(unsigned int size, unsigned int lim
 
 void DbgCommandBuffer::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ)
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
+        DebugComputePipelineSet();
+
+        #if LLGL_DBG_VALIDATION_LEVEL >= LLGL_DBG_VALIDATION_FULL
 
         if (groupSizeX * groupSizeY * groupSizeZ == 0)
             LLGL_DBG_WARN(WarningType::PointlessOperation, "thread group size has volume of 0 units");
 
-        DebugComputePipelineSet();
         DebugThreadGroupLimit(groupSizeX, caps_.maxNumComputeShaderWorkGroups.x);
         DebugThreadGroupLimit(groupSizeY, caps_.maxNumComputeShaderWorkGroups.y);
         DebugThreadGroupLimit(groupSizeZ, caps_.maxNumComputeShaderWorkGroups.z);
+
+        #endif
     }
     
     instance.Dispatch(groupSizeX, groupSizeY, groupSizeZ);
@@ -570,10 +1223,98 @@ void DbgCommandBuffer::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY
     LLGL_DBG_PROFILER_DO(dispatchComputeCalls.Inc());
 }
 
+void DbgCommandBuffer::DispatchIndirect(Buffer& buffer, unsigned int offset)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugComputePipelineSet();
+        #if LLGL_DBG_VALIDATION_LEVEL >= LLGL_DBG_VALIDATION_FULL
+        DebugIndirectArguments(bufferDbg, offset, 1, sizeof(DispatchIndirectArguments), sizeof(DispatchIndirectArguments));
+        #endif
+    }
+
+    instance.DispatchIndirect(bufferDbg.instance, offset);
+
+    LLGL_DBG_PROFILER_DO(dispatchComputeCalls.Inc());
+}
+
+void DbgCommandBuffer::Barrier(long barrierFlags)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (barrierFlags == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "memory barrier without any barrier flags");
+        else if ((barrierFlags & ~BarrierFlags::All) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "unknown barrier flags specified");
+    }
+
+    instance.Barrier(barrierFlags);
+}
+
+void DbgCommandBuffer::StorageBarrier(Buffer& buffer)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugBufferType(buffer.GetType(), BufferType::Storage);
+    }
+
+    instance.StorageBarrier(bufferDbg.instance);
+}
+
+/* ----- Command Recording ----- */
+
+void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    auto& deferredCommandBufferDbg = LLGL_CAST(DbgCommandBuffer&, deferredCommandBuffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if ((deferredCommandBufferDbg.desc.flags & CommandBufferFlags::DeferredSubmit) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot execute command buffer that was not created with 'CommandBufferFlags::DeferredSubmit'");
+        if ((deferredCommandBufferDbg.desc.flags & CommandBufferFlags::AsyncCompute) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot execute command buffer that was created with 'CommandBufferFlags::AsyncCompute' within another command buffer");
+        if (&deferredCommandBufferDbg == this)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot execute command buffer within itself");
+        if ((desc.flags & CommandBufferFlags::Bundle) != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot execute command buffer within command buffer that was created with 'CommandBufferFlags::Bundle'");
+    }
+
+    instance.Execute(deferredCommandBufferDbg.instance);
+
+    /* Secondary command buffer might have changed any binding */
+    profiled_ = ProfiledBindings{};
+}
+
+void DbgCommandBuffer::Reset()
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    instance.Reset();
+    profiled_ = ProfiledBindings{};
+}
+
 /* ----- Misc ----- */
 
+void DbgCommandBuffer::Signal(Fence& fence)
+{
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
+    instance.Signal(fence);
+}
+
 void DbgCommandBuffer::SyncGPU()
 {
+    LLGL_DBG_TRACE(TraceCategory::CommandBuffer);
     instance.SyncGPU();
 }
 
@@ -621,7 +1362,7 @@ void DbgCommandBuffer::DebugVertexLayout()
         if (vertexLayout.bound)
         {
             /* Check if all vertex attributes are served by active vertex buffer(s) */
-            if (vertexLayout.attributes != vertexFormat_.attributes)
+            if (!vertexLayout.format.HasEqualLayout(bindings_.vertexBuffer->desc.vertexBuffer.format))
                 LLGL_DBG_ERROR(ErrorType::InvalidState, "vertex layout mismatch between shader program and vertex buffer(s)");
         }
         else
@@ -629,6 +1370,67 @@ void DbgCommandBuffer::DebugVertexLayout()
     }
 }
 
+/*
+Validates the draw states with the bits that have been cached at bind time. Only if any required state is missing,
+the individual checks are repeated to report the respective errors. The buffers are still checked for initialization,
+since they can be bound before their contents are written.
+*/
+void DbgCommandBuffer::DebugDrawStates(unsigned int requiredStates)
+{
+    if ((desc.flags & CommandBufferFlags::AsyncCompute) != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot record draw commands in command buffer that was created with 'CommandBufferFlags::AsyncCompute'");
+
+    /* Vertex pulling neither requires a vertex buffer nor a vertex layout */
+    if ((states_.drawStates & DrawStateVertexPulling) != 0)
+        requiredStates &= ~(DrawStateVertexBuffer | DrawStateVertexLayout);
+
+    const bool statesValid =
+    (
+        (states_.drawStates & requiredStates) == requiredStates &&
+        ( (requiredStates & DrawStateVertexBuffer) == 0 || bindings_.vertexBuffer->initialized ) &&
+        ( (requiredStates & DrawStateIndexBuffer ) == 0 || bindings_.indexBuffer->initialized  )
+    );
+
+    if (!statesValid)
+    {
+        if ((requiredStates & DrawStateGraphicsPipeline) != 0)
+            DebugGraphicsPipelineSet();
+        if ((requiredStates & DrawStateVertexBuffer) != 0)
+            DebugVertexBufferSet();
+        if ((requiredStates & DrawStateIndexBuffer) != 0)
+            DebugIndexBufferSet();
+        if ((requiredStates & DrawStateVertexLayout) != 0)
+            DebugVertexLayout();
+    }
+}
+
+// Updates the cached vertex layout and vertex pulling state bits, whenever the graphics pipeline or the vertex buffer changes.
+void DbgCommandBuffer::UpdateVertexLayoutState()
+{
+    bool compatible     = false;
+    bool vertexPulling  = false;
+
+    if (bindings_.graphicsPipeline)
+    {
+        auto shaderProgramDbg = LLGL_CAST(DbgShaderProgram*, bindings_.graphicsPipeline->desc.shaderProgram);
+        const auto& vertexLayout = shaderProgramDbg->GetVertexLayout();
+        if (bindings_.vertexBuffer)
+            compatible = (vertexLayout.bound && vertexLayout.format.HasEqualLayout(bindings_.vertexBuffer->desc.vertexBuffer.format));
+        else
+            vertexPulling = !vertexLayout.bound;
+    }
+
+    if (compatible)
+        states_.drawStates |= DrawStateVertexLayout;
+    else
+        states_.drawStates &= ~DrawStateVertexLayout;
+
+    if (vertexPulling)
+        states_.drawStates |= DrawStateVertexPulling;
+    else
+        states_.drawStates &= ~DrawStateVertexPulling;
+}
+
 void DbgCommandBuffer::DebugNumVertices(unsigned int numVertices)
 {
     if (numVertices == 0)
@@ -708,28 +1510,155 @@ void DbgCommandBuffer::DebugNumInstances(unsigned int numInstances, unsigned int
 void DbgCommandBuffer::DebugDraw(
     unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset)
 {
-    DebugGraphicsPipelineSet();
-    DebugVertexBufferSet();
-    DebugVertexLayout();
+    DebugDrawStates(DrawStateGraphicsPipeline | DrawStateVertexBuffer | DrawStateVertexLayout);
+
+    #if LLGL_DBG_VALIDATION_LEVEL >= LLGL_DBG_VALIDATION_FULL
+
     DebugNumVertices(numVertices);
     DebugNumInstances(numInstances, instanceOffset);
 
     if (bindings_.vertexBuffer)
-        DebugVertexLimit(numVertices + firstVertex, static_cast<unsigned int>(bindings_.vertexBuffer->elements));
+        DebugVertexLimit(numVertices + firstVertex, static_cast<unsigned int>(bindings_.vertexBuffer->elements) - bindings_.vertexBufferOffset);
+
+    #endif
 }
 
 void DbgCommandBuffer::DebugDrawIndexed(
     unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset)
 {
-    DebugGraphicsPipelineSet();
-    DebugVertexBufferSet();
-    DebugIndexBufferSet();
-    DebugVertexLayout();
+    DebugDrawStates(DrawStateGraphicsPipeline | DrawStateVertexBuffer | DrawStateIndexBuffer | DrawStateVertexLayout);
+
+    #if LLGL_DBG_VALIDATION_LEVEL >= LLGL_DBG_VALIDATION_FULL
+
     DebugNumVertices(numVertices);
     DebugNumInstances(numInstances, instanceOffset);
 
     if (bindings_.indexBuffer)
-        DebugVertexLimit(numVertices + firstIndex, static_cast<unsigned int>(bindings_.indexBuffer->elements));
+        DebugVertexLimit(numVertices + firstIndex, static_cast<unsigned int>(bindings_.indexBuffer->elements) - bindings_.indexBufferOffset);
+
+    #endif
+}
+
+void DbgCommandBuffer::DebugDrawIndirect(
+    DbgBuffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride, unsigned int argumentsSize)
+{
+    DebugDrawStates(DrawStateGraphicsPipeline | DrawStateVertexBuffer | DrawStateVertexLayout);
+
+    #if LLGL_DBG_VALIDATION_LEVEL >= LLGL_DBG_VALIDATION_FULL
+    DebugIndirectArguments(buffer, offset, numCommands, stride, argumentsSize);
+    #endif
+}
+
+void DbgCommandBuffer::DebugIndirectArguments(
+    DbgBuffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride, unsigned int argumentsSize)
+{
+    if (!caps_.hasIndirectDrawing)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("indirect draw and dispatch commands");
+
+    if ((buffer.desc.flags & BufferFlags::IndirectArguments) == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer for indirect arguments was not created with 'BufferFlags::IndirectArguments'");
+
+    if (offset % 4 != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "offset for indirect arguments must be a multiple of 4");
+
+    if (numCommands == 0)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "no indirect commands specified");
+    else if (numCommands > 1 && (stride % 4 != 0 || stride < argumentsSize))
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "invalid stride for indirect arguments (" + std::to_string(stride) +
+            " specified but must be a multiple of 4 and at least " + std::to_string(argumentsSize) + ")"
+        );
+    }
+
+    if (numCommands > 0)
+    {
+        auto requiredSize = static_cast<std::uint64_t>(offset) + static_cast<std::uint64_t>(numCommands - 1) * stride + argumentsSize;
+        if (requiredSize > buffer.desc.size)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidArgument,
+                "indirect arguments out of bounds (" + std::to_string(requiredSize) +
+                " bytes required but buffer size is " + std::to_string(buffer.desc.size) + ")"
+            );
+        }
+    }
+}
+
+void DbgCommandBuffer::DebugBufferRange(DbgBuffer& buffer, unsigned int offset, unsigned int size)
+{
+    if (size == 0)
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "no data specified for buffer copy");
+
+    auto requiredSize = static_cast<std::uint64_t>(offset) + size;
+    if (requiredSize > buffer.desc.size)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "buffer range out of bounds (" + std::to_string(requiredSize) +
+            " bytes required but buffer size is " + std::to_string(buffer.desc.size) + ")"
+        );
+    }
+}
+
+void DbgCommandBuffer::DebugBufferCounter(DbgBuffer& buffer)
+{
+    if (!caps_.hasBufferCounters)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("buffer counters");
+
+    if (buffer.desc.type != BufferType::Storage ||
+        ( buffer.desc.storageBuffer.storageType != StorageBufferType::AppendStructuredBuffer &&
+          buffer.desc.storageBuffer.storageType != StorageBufferType::ConsumeStructuredBuffer ))
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer has no counter (only append and consume storage buffers have a hidden counter)");
+    }
+}
+
+void DbgCommandBuffer::DebugImmediateCommandBuffer()
+{
+    if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot retrieve query results from command buffer that was created with 'CommandBufferFlags::DeferredSubmit'");
+}
+
+void DbgCommandBuffer::DebugQueryArrayRange(DbgQueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries)
+{
+    auto requiredSize = static_cast<std::uint64_t>(firstQuery) + numQueries;
+    if (requiredSize > queryArray.queries.size())
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "query range out of bounds (" + std::to_string(requiredSize) +
+            " queries required but query array size is " + std::to_string(queryArray.queries.size()) + ")"
+        );
+        return;
+    }
+
+    for (unsigned int i = 0; i < numQueries; ++i)
+    {
+        if (queryArray.queries[firstQuery + i]->state != DbgQuery::State::Ready)
+        {
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "query result is not ready (index " + std::to_string(firstQuery + i) + " in query array)");
+            break;
+        }
+    }
+}
+
+void DbgCommandBuffer::DebugTextureRegion(DbgTexture& texture, unsigned int mipLevel, const Gs::Vector3ui& offset, const Gs::Vector3ui& extent)
+{
+    if (mipLevel >= static_cast<unsigned int>(texture.mipLevels))
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "mip level out of bounds (" + std::to_string(mipLevel) +
+            " specified but limit is " + std::to_string(texture.mipLevels - 1) + ")"
+        );
+        return;
+    }
+
+    auto size = texture.QueryMipLevelSize(mipLevel);
+    if (offset.x + extent.x > size.x || offset.y + extent.y > size.y || offset.z + extent.z > size.z)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture region out of bounds");
 }
 
 void DbgCommandBuffer::DebugInstancing()
@@ -764,6 +1693,68 @@ void DbgCommandBuffer::DebugBufferType(const BufferType bufferType, const Buffer
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid buffer type");
 }
 
+void DbgCommandBuffer::ProfileBinding(const char* command, ProfiledBinding& boundBinding, const ProfiledBinding& binding)
+{
+    if (profiler_)
+    {
+        if (boundBinding.object     == binding.object     &&
+            boundBinding.stageFlags == binding.stageFlags &&
+            boundBinding.offset     == binding.offset     &&
+            boundBinding.size       == binding.size)
+        {
+            profiler_->RecordWastedWork(RenderingProfiler::WastedWorkType::RedundantBinding, command);
+        }
+        boundBinding = binding;
+    }
+}
+
+void DbgCommandBuffer::ProfileSlotBinding(const char* command, ProfiledBinding* boundBindings, unsigned int slot, const ProfiledBinding& binding)
+{
+    /* Bindings beyond the tracked slots are never reported as redundant */
+    if (slot < maxProfiledSlots)
+        ProfileBinding(command, boundBindings[slot], binding);
+}
+
+void DbgCommandBuffer::ProfileClear(const char* command, long flags, std::uint32_t targets)
+{
+    if (profiler_)
+    {
+        /* Clear is redundant if all of its attachments have already been cleared since the last draw call */
+        if ((flags | targets) != 0 && (flags & ~profiled_.clearedFlags) == 0 && (targets & ~profiled_.clearedTargets) == 0)
+            profiler_->RecordWastedWork(RenderingProfiler::WastedWorkType::RedundantClear, command);
+        profiled_.clearedFlags      |= flags;
+        profiled_.clearedTargets    |= targets;
+    }
+}
+
+void DbgCommandBuffer::ProfileDraw(const char* command, unsigned int numVertices, unsigned int numInstances)
+{
+    if (profiler_)
+    {
+        if (numVertices == 0 || numInstances == 0)
+            profiler_->RecordWastedWork(RenderingProfiler::WastedWorkType::EmptyDraw, command);
+        else
+            ResetProfiledClears();
+    }
+}
+
+void DbgCommandBuffer::ResetProfiledSlotBindings()
+{
+    for (unsigned int i = 0; i < maxProfiledSlots; ++i)
+    {
+        profiled_.constantBuffers[i]    = {};
+        profiled_.storageBuffers[i]     = {};
+        profiled_.textures[i]           = {};
+        profiled_.samplers[i]           = {};
+    }
+}
+
+void DbgCommandBuffer::ResetProfiledClears()
+{
+    profiled_.clearedFlags      = 0;
+    profiled_.clearedTargets    = 0;
+}
+
 void DbgCommandBuffer::WarnImproperVertices(const std::string& topologyName, unsigned int unusedVertices)
 {
     std::string vertexSingularPlural = (unusedVertices > 1 ? "vertices" : "vertex");
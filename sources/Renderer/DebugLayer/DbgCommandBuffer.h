@@ -11,6 +11,7 @@
 
 #include <LLGL/CommandBuffer.h>
 #include <LLGL/RenderingProfiler.h>
+#include <LLGL/RenderingTracer.h>
 #include <LLGL/RenderingDebugger.h>
 
 #include "DbgGraphicsPipeline.h"
@@ -21,6 +22,8 @@ namespace LLGL
 
 
 class DbgBuffer;
+class DbgTexture;
+class DbgQueryArray;
 
 class DbgCommandBuffer : public CommandBuffer
 {
@@ -33,6 +36,7 @@ class DbgCommandBuffer : public CommandBuffer
             CommandBuffer& instance,
             RenderingProfiler* profiler,
             RenderingDebugger* debugger,
+            RenderingTracer* tracer,
             const RenderingCaps& caps
         );
 
@@ -46,6 +50,11 @@ class DbgCommandBuffer : public CommandBuffer
         void SetScissor(const Scissor& scissor) override;
         void SetScissorArray(unsigned int numScissors, const Scissor* scissorArray) override;
 
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetDepthBounds(float minDepth, float maxDepth) override;
+
         void SetClearColor(const ColorRGBAf& color) override;
         void SetClearDepth(float depth) override;
         void SetClearStencil(int stencil) override;
@@ -55,23 +64,30 @@ class DbgCommandBuffer : public CommandBuffer
 
         /* ----- Buffers ------ */
 
-        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer, unsigned int offset = 0) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
-        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer, unsigned int offset = 0) override;
         
         void SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         
         void SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
 
+        void ResetBufferCounter(Buffer& buffer, unsigned int value = 0) override;
+        void CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer) override;
+
         void SetStreamOutputBuffer(Buffer& buffer) override;
         void SetStreamOutputBufferArray(BufferArray& bufferArray) override;
 
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Textures ----- */
 
         void SetTexture(Texture& texture, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
@@ -82,26 +98,52 @@ class DbgCommandBuffer : public CommandBuffer
         void SetSampler(Sampler& sampler, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
 
+        /* ----- Resource Heaps ----- */
+
+        void SetResourceHeap(ResourceHeap& resourceHeap) override;
+
         /* ----- Render Targets ----- */
 
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        /* ----- Render Passes ----- */
+
+        void BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc) override;
+        void BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc) override;
+
+        void EndRenderPass() override;
+
         /* ----- Pipeline States ----- */
 
         void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
         void SetComputePipeline(ComputePipeline& computePipeline) override;
 
+        void SetPushConstants(unsigned int offset, unsigned int size, const void* data) override;
+
+        void SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances) override;
+
         /* ----- Queries ----- */
 
         void BeginQuery(Query& query) override;
         void EndQuery(Query& query) override;
 
         bool QueryResult(Query& query, std::uint64_t& result) override;
+        bool QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results) override;
+        bool QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result) override;
+
+        void ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset) override;
 
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size) override;
+        void CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType) override;
+
         /* ----- Drawing ----- */
 
         void Draw(unsigned int numVertices, unsigned int firstVertex) override;
@@ -116,31 +158,75 @@ class DbgCommandBuffer : public CommandBuffer
         void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset) override;
         void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset) override;
 
+        void DrawIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ) override;
+        void DispatchIndirect(Buffer& buffer, unsigned int offset) override;
+
+        void Barrier(long barrierFlags) override;
+        void StorageBarrier(Buffer& buffer) override;
+
+        /* ----- Command Recording ----- */
+
+        void Execute(CommandBuffer& deferredCommandBuffer) override;
+
+        void Reset() override;
 
         /* ----- Misc ----- */
 
+        void Signal(Fence& fence) override;
+
         void SyncGPU() override;
 
         /* ----- Debugging members ----- */
 
-        CommandBuffer& instance;
+        CommandBuffer&          instance;
+        CommandBufferDescriptor desc;
 
     private:
 
+        // Draw state bits, which are cached at bind time to keep the per-draw validation cheap.
+        enum DrawStateBits : unsigned int
+        {
+            DrawStateGraphicsPipeline   = (1 << 0),
+            DrawStateVertexBuffer       = (1 << 1),
+            DrawStateIndexBuffer        = (1 << 2),
+            DrawStateVertexLayout       = (1 << 3), // Vertex format of the bound vertex buffer matches the vertex layout of the bound pipeline.
+            DrawStateVertexPulling      = (1 << 4), // Neither a vertex buffer nor a vertex layout is bound, i.e. the vertex shader fetches its vertices from storage buffers.
+        };
+
         void DebugGraphicsPipelineSet();
         void DebugComputePipelineSet();
         void DebugVertexBufferSet();
         void DebugIndexBufferSet();
         void DebugVertexLayout();
+        void DebugDrawStates(unsigned int requiredStates);
+
+        void UpdateVertexLayoutState();
 
         void DebugNumVertices(unsigned int numVertices);
         void DebugNumInstances(unsigned int numInstances, unsigned int instanceOffset);
 
         void DebugDraw(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset);
         void DebugDrawIndexed(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset);
+        void DebugDrawIndirect(DbgBuffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride, unsigned int argumentsSize);
+        void DebugIndirectArguments(DbgBuffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride, unsigned int argumentsSize);
+
+        void DebugBufferRange(DbgBuffer& buffer, unsigned int offset, unsigned int size);
+        void DebugBufferCounter(DbgBuffer& buffer);
+        void DebugImmediateCommandBuffer();
+        void DebugQueryArrayRange(DbgQueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries);
+        void DebugTextureRegion(DbgTexture& texture, unsigned int mipLevel, const Gs::Vector3ui& offset, const Gs::Vector3ui& extent);
 
         void DebugInstancing();
         void DebugVertexLimit(unsigned int vertexCount, unsigned int vertexLimit);
@@ -151,22 +237,46 @@ class DbgCommandBuffer : public CommandBuffer
 
         void WarnImproperVertices(const std::string& topologyName, unsigned int unusedVertices);
 
+        /* ----- Wasted work ----- */
+
+        // Maximal number of binding slots per resource type, which are tracked to detect redundant bindings.
+        static const unsigned int maxProfiledSlots = 16;
+
+        // Binding of a single object; this is an aggregate, so "{}" is a binding of no object. Otherwise, all members are specified.
+        struct ProfiledBinding
+        {
+            const void*     object;
+            long            stageFlags;
+            unsigned int    offset;
+            unsigned int    size;
+        };
+
+        void ProfileBinding(const char* command, ProfiledBinding& boundBinding, const ProfiledBinding& binding);
+        void ProfileSlotBinding(const char* command, ProfiledBinding* boundBindings, unsigned int slot, const ProfiledBinding& binding);
+        void ProfileClear(const char* command, long flags, std::uint32_t targets);
+        void ProfileDraw(const char* command, unsigned int numVertices, unsigned int numInstances);
+
+        void ResetProfiledSlotBindings();
+        void ResetProfiledClears();
+
         /* ----- Common objects ----- */
 
         RenderingProfiler*      profiler_       = nullptr;
         RenderingDebugger*      debugger_       = nullptr;
+        RenderingTracer*        tracer_         = nullptr;
 
         const RenderingCaps&    caps_;
 
         /* ----- Render states ----- */
 
         PrimitiveTopology       topology_       = PrimitiveTopology::TriangleList;
-        VertexFormat            vertexFormat_;
 
         struct Bindings
         {
             DbgBuffer*              vertexBuffer        = nullptr;
             DbgBuffer*              indexBuffer         = nullptr;
+            unsigned int            vertexBufferOffset  = 0;        // Offset (in vertices) of the bound vertex buffer range
+            unsigned int            indexBufferOffset   = 0;        // Offset (in indices) of the bound index buffer range
             DbgBuffer*              streamOutput        = nullptr;
             DbgGraphicsPipeline*    graphicsPipeline    = nullptr;
             ComputePipeline*        computePipeline     = nullptr;
@@ -175,10 +285,31 @@ class DbgCommandBuffer : public CommandBuffer
 
         struct States
         {
-            bool streamOutputBusy = false;
+            bool            streamOutputBusy    = false;
+            bool            streamOutputPaused  = false;
+            bool            renderPassBusy      = false;
+            unsigned int    drawStates          = 0;
         }
         states_;
 
+        // Previously bound objects, which are only tracked if the profiler is enabled to detect wasted work.
+        struct ProfiledBindings
+        {
+            ProfiledBinding vertexBuffer;
+            ProfiledBinding indexBuffer;
+            ProfiledBinding graphicsPipeline;
+            ProfiledBinding computePipeline;
+            ProfiledBinding resourceHeap;
+            ProfiledBinding renderTarget;
+            ProfiledBinding constantBuffers[maxProfiledSlots];
+            ProfiledBinding storageBuffers[maxProfiledSlots];
+            ProfiledBinding textures[maxProfiledSlots];
+            ProfiledBinding samplers[maxProfiledSlots];
+            long            clearedFlags;   // Clear flags since the last draw call or render target change
+            std::uint32_t   clearedTargets; // Bit mask of color targets cleared with "ClearTarget" since the last draw call
+        }
+        profiled_ {};
+
 };
 
 
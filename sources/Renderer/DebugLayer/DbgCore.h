@@ -10,6 +10,7 @@
 
 
 #include <LLGL/RenderingProfiler.h>
+#include <LLGL/RenderingTracer.h>
 #include <LLGL/RenderingDebugger.h>
 
 
@@ -17,18 +18,42 @@ namespace LLGL
 {
 
 
+/*
+Validation levels of the debug layer, selected at compile time with LLGL_DBG_VALIDATION_LEVEL:
+- LLGL_DBG_VALIDATION_OFF:      Nothing is validated; the debug layer is only used for profiling and tracing.
+- LLGL_DBG_VALIDATION_STATE:    Draw and dispatch calls only check the render states, which are cached when they are bound.
+- LLGL_DBG_VALIDATION_FULL:     Draw and dispatch calls additionally validate all of their arguments.
+*/
+#define LLGL_DBG_VALIDATION_OFF     0
+#define LLGL_DBG_VALIDATION_STATE   1
+#define LLGL_DBG_VALIDATION_FULL    2
+
+#ifndef LLGL_DBG_VALIDATION_LEVEL
+#   define LLGL_DBG_VALIDATION_LEVEL LLGL_DBG_VALIDATION_FULL
+#endif
+
 #define LLGL_DBG_PROFILER_DO(EXPR)  \
     if (profiler_)                  \
         profiler_->EXPR
 
+#define LLGL_DBG_TRACE(CATEGORY) \
+    TraceScope dbgTraceScope { tracer_, __FUNCTION__, (CATEGORY) }
+
 #define LLGL_DBG_SOURCE \
     DbgSetSource(debugger_, __FUNCTION__)
 
+/*
+Each call site interns its message ID once (from file name and line number),
+and the message text is only formatted by the lambda if the debugger requests it.
+*/
+#define LLGL_DBG_MESSAGE_ID \
+    []() -> RenderingDebugger::MessageID { static const auto id = RenderingDebugger::MakeMessageID(__FILE__, __LINE__); return id; }()
+
 #define LLGL_DBG_ERROR(TYPE, MESSAGE) \
-    DbgPostError(debugger_, (TYPE), (MESSAGE))
+    DbgPostError(debugger_, (TYPE), LLGL_DBG_MESSAGE_ID, [&]() -> std::string { return (MESSAGE); })
 
 #define LLGL_DBG_WARN(TYPE, MESSAGE) \
-    DbgPostWarning(debugger_, (TYPE), (MESSAGE))
+    DbgPostWarning(debugger_, (TYPE), LLGL_DBG_MESSAGE_ID, [&]() -> std::string { return (MESSAGE); })
 
 #define LLGL_DBG_ERROR_NOT_SUPPORTED(FEATURE) \
     LLGL_DBG_ERROR(ErrorType::UnsupportedFeature, std::string(FEATURE) + " is not supported")
@@ -40,16 +65,25 @@ inline void DbgSetSource(RenderingDebugger* debugger, const char* source)
         debugger->SetSource(source);
 }
 
-inline void DbgPostError(RenderingDebugger* debugger, ErrorType type, const std::string& message)
+template <typename TFormatter>
+void DbgPostError(RenderingDebugger* debugger, ErrorType type, RenderingDebugger::MessageID id, const TFormatter& formatText)
 {
     if (debugger)
-        debugger->PostError(type, message);
+        debugger->PostError(type, id, formatText);
 }
 
-inline void DbgPostWarning(RenderingDebugger* debugger, WarningType type, const std::string& message)
+template <typename TFormatter>
+void DbgPostWarning(RenderingDebugger* debugger, WarningType type, RenderingDebugger::MessageID id, const TFormatter& formatText)
 {
     if (debugger)
-        debugger->PostWarning(type, message);
+        debugger->PostWarning(type, id, formatText);
+}
+
+// Returns the call-site tag of the calling thread, or an empty string if no tag has been set.
+inline std::string DbgGetCallSiteTag()
+{
+    auto tag = RenderingProfiler::GetCallSiteTag();
+    return (tag != nullptr ? std::string(tag) : std::string());
 }
 
 
@@ -0,0 +1,46 @@
+/*
+ * DbgQueryArray.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DBG_QUERY_ARRAY_H
+#define LLGL_DBG_QUERY_ARRAY_H
+
+
+#include <LLGL/QueryArray.h>
+#include "DbgQuery.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class DbgQueryArray : public QueryArray
+{
+
+    public:
+
+        DbgQueryArray(QueryArray& instance, std::vector<DbgQuery*>&& queries) :
+            QueryArray { instance.GetType(), instance.GetNumQueries() },
+            instance   { instance           },
+            queries    { std::move(queries) }
+        {
+        }
+
+        QueryArray&             instance;
+        std::vector<DbgQuery*>  queries;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,23 +6,60 @@
  */
 
 #include "DbgRenderContext.h"
+#include "DbgTexture.h"
+#include "DbgCore.h"
+#include "../CheckedCast.h"
 
 
 namespace LLGL
 {
 
 
-DbgRenderContext::DbgRenderContext(RenderContext& instance) :
-    instance { instance }
+DbgRenderContext::DbgRenderContext(RenderContext& instance, RenderingTracer* tracer) :
+    instance { instance },
+    tracer_  { tracer   }
 {
     ShareSurfaceAndVideoMode(instance);
 }
 
 void DbgRenderContext::Present()
 {
+    LLGL_DBG_TRACE(TraceCategory::Present);
     instance.Present();
 }
 
+void DbgRenderContext::PresentWithoutVsync()
+{
+    LLGL_DBG_TRACE(TraceCategory::Present);
+    instance.PresentWithoutVsync();
+}
+
+void DbgRenderContext::WaitForNextFrame()
+{
+    instance.WaitForNextFrame();
+}
+
+bool DbgRenderContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    return instance.QueryFrameStatistics(stats);
+}
+
+bool DbgRenderContext::IsOccluded() const
+{
+    return instance.IsOccluded();
+}
+
+bool DbgRenderContext::TestPresent()
+{
+    return instance.TestPresent();
+}
+
+void DbgRenderContext::CopyBackBuffer(Texture& dstTexture)
+{
+    auto& dstTextureDbg = LLGL_CAST(DbgTexture&, dstTexture);
+    instance.CopyBackBuffer(dstTextureDbg.instance);
+}
+
 /* ----- Configuration ----- */
 
 void DbgRenderContext::SetVideoMode(const VideoModeDescriptor& videoModeDesc)
@@ -36,6 +73,18 @@ void DbgRenderContext::SetVsync(const VsyncDescriptor& vsyncDesc)
     instance.SetVsync(vsyncDesc);
 }
 
+void DbgRenderContext::SetTargetFrameRate(unsigned int frameRate)
+{
+    instance.SetTargetFrameRate(frameRate);
+    RenderContext::SetTargetFrameRate(frameRate);
+}
+
+void DbgRenderContext::SetBackgroundFrameRate(unsigned int frameRate)
+{
+    instance.SetBackgroundFrameRate(frameRate);
+    RenderContext::SetBackgroundFrameRate(frameRate);
+}
+
 
 } // /namespace LLGL
 
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/RenderContext.h>
+#include <LLGL/RenderingTracer.h>
 
 
 namespace LLGL
@@ -25,19 +26,36 @@ class DbgRenderContext : public RenderContext
 
         /* ----- Common ----- */
 
-        DbgRenderContext(RenderContext& instance);
+        DbgRenderContext(RenderContext& instance, RenderingTracer* tracer);
 
         void Present() override;
+        void PresentWithoutVsync() override;
+
+        void WaitForNextFrame() override;
+
+        bool QueryFrameStatistics(FrameStatistics& stats) override;
+
+        bool IsOccluded() const override;
+        bool TestPresent() override;
+
+        void CopyBackBuffer(Texture& dstTexture) override;
 
         /* ----- Configuration ----- */
 
         void SetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
         void SetVsync(const VsyncDescriptor& vsyncDesc) override;
 
+        void SetTargetFrameRate(unsigned int frameRate) override;
+        void SetBackgroundFrameRate(unsigned int frameRate) override;
+
         /* ----- Debugging members ----- */
 
         RenderContext& instance;
 
+    private:
+
+        RenderingTracer* tracer_ = nullptr;
+
 };
 
 
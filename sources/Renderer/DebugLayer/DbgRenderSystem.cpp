@@ -9,6 +9,9 @@
 #include "DbgCore.h"
 #include "../../Core/Helper.h"
 #include "../CheckedCast.h"
+#include "../Assertion.h"
+#include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
@@ -25,11 +28,13 @@ All the actual render system objects are stored in the members named "instance",
 */
 
 DbgRenderSystem::DbgRenderSystem(
-    const std::shared_ptr<RenderSystem>& instance, RenderingProfiler* profiler, RenderingDebugger* debugger) :
+    const std::shared_ptr<RenderSystem>& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, RenderingTracer* tracer) :
         instance_ { instance },
         profiler_ { profiler },
-        debugger_ { debugger }
+        debugger_ { debugger },
+        tracer_   { tracer   }
 {
+    SetVideoAdapters(instance_->GetVideoAdapters());
 }
 
 DbgRenderSystem::~DbgRenderSystem()
@@ -38,6 +43,7 @@ DbgRenderSystem::~DbgRenderSystem()
 
 void DbgRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     RenderSystem::SetConfiguration(config);
     instance_->SetConfiguration(config);
 }
@@ -46,30 +52,79 @@ void DbgRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
 
 RenderContext* DbgRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     auto renderContextInstance = instance_->CreateRenderContext(desc, surface);
 
     SetRendererInfo(instance_->GetRendererInfo());
     SetRenderingCaps(instance_->GetRenderingCaps());
 
-    return TakeOwnership(renderContexts_, MakeUnique<DbgRenderContext>(*renderContextInstance));
+    return TakeOwnership(renderContexts_, MakeUnique<DbgRenderContext>(*renderContextInstance, tracer_));
 }
 
 void DbgRenderSystem::Release(RenderContext& renderContext)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     ReleaseDbg(renderContexts_, renderContext);
 }
 
 /* ----- Command buffers ----- */
 
-CommandBuffer* DbgRenderSystem::CreateCommandBuffer()
+CommandBuffer* DbgRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
-    return TakeOwnership(commandBuffers_, MakeUnique<DbgCommandBuffer>(
-        *instance_->CreateCommandBuffer(), profiler_, debugger_, GetRenderingCaps()
-    ));
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (desc.nodeIndex >= GetRenderingCaps().numGPUNodes)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "command buffer node index exceeds the number of GPU nodes");
+        else if (desc.nodeIndex > 0 && (desc.flags & CommandBufferFlags::DeferredSubmit) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "command buffer for GPU node other than 0 requires 'CommandBufferFlags::DeferredSubmit'");
+        if ((desc.flags & CommandBufferFlags::Bundle) != 0 && (desc.flags & CommandBufferFlags::DeferredSubmit) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "command buffer with 'CommandBufferFlags::Bundle' requires 'CommandBufferFlags::DeferredSubmit'");
+    }
+
+    /* Create command buffer object */
+    auto commandBufferDbg = MakeUnique<DbgCommandBuffer>(
+        *instance_->CreateCommandBuffer(desc), profiler_, debugger_, tracer_, GetRenderingCaps()
+    );
+
+    /* Store settings */
+    commandBufferDbg->desc = desc;
+
+    return TakeOwnership(commandBuffers_, std::move(commandBufferDbg));
+}
+
+void DbgRenderSystem::ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    LLGL_ASSERT_PTR(commandBufferArray);
+
+    /* Create temporary command buffer array with command buffer instances */
+    std::vector<CommandBuffer*> commandBufferInstanceArray;
+    commandBufferInstanceArray.reserve(numCommandBuffers);
+
+    for (unsigned int i = 0; i < numCommandBuffers; ++i)
+    {
+        auto commandBufferDbg = LLGL_CAST(DbgCommandBuffer*, commandBufferArray[i]);
+
+        if (debugger_)
+        {
+            LLGL_DBG_SOURCE;
+            if ((commandBufferDbg->desc.flags & CommandBufferFlags::DeferredSubmit) == 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot execute command buffer that was not created with 'CommandBufferFlags::DeferredSubmit'");
+            if ((commandBufferDbg->desc.flags & CommandBufferFlags::Bundle) != 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot submit command buffer that was created with 'CommandBufferFlags::Bundle' other than within another command buffer");
+        }
+
+        commandBufferInstanceArray.push_back(&(commandBufferDbg->instance));
+    }
+
+    instance_->ExecuteCommandBuffers(numCommandBuffers, commandBufferInstanceArray.data());
 }
 
 void DbgRenderSystem::Release(CommandBuffer& commandBuffer)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     ReleaseDbg(commandBuffers_, commandBuffer);
 }
 
@@ -77,6 +132,7 @@ void DbgRenderSystem::Release(CommandBuffer& commandBuffer)
 
 Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     /* Validate and store format size (if supported) */
     unsigned int formatSize = 0;
 
@@ -126,11 +182,35 @@ Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void*
     bufferDbg->elements     = (formatSize > 0 ? desc.size / formatSize : 0);
     bufferDbg->initialized  = (initialData != nullptr);
 
+    /* Rebuild compact vertex layout, so it can be compared with the vertex layout of shader programs without string comparisons */
+    if (desc.type == BufferType::Vertex)
+        bufferDbg->desc.vertexBuffer.format.UpdateLayout();
+
+    if (profiler_)
+    {
+        bufferDbg->memory.type  = RenderingProfiler::MemoryType::Buffer;
+        bufferDbg->memory.size  = desc.size;
+        bufferDbg->memory.tag   = DbgGetCallSiteTag();
+        profiler_->RecordAllocation(bufferDbg->memory);
+    }
+
+    /* Keep copy of constant buffer contents to detect redundant writes */
+    if (profiler_ && desc.type == BufferType::Constant)
+    {
+        bufferDbg->shadowData.resize(static_cast<std::size_t>(desc.size));
+        if (initialData != nullptr)
+        {
+            std::memcpy(bufferDbg->shadowData.data(), initialData, bufferDbg->shadowData.size());
+            bufferDbg->shadowSize = bufferDbg->shadowData.size();
+        }
+    }
+
     return TakeOwnership(buffers_, std::move(bufferDbg));
 }
 
 BufferArray* DbgRenderSystem::CreateBufferArray(unsigned int numBuffers, Buffer* const * bufferArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     AssertCreateBufferArray(numBuffers, bufferArray);
 
     /* Create temporary buffer array with buffer instances */
@@ -146,17 +226,22 @@ BufferArray* DbgRenderSystem::CreateBufferArray(unsigned int numBuffers, Buffer*
 
 void DbgRenderSystem::Release(Buffer& buffer)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+    LLGL_DBG_PROFILER_DO(RecordRelease(bufferDbg.memory));
     ReleaseDbg(buffers_, buffer);
 }
 
 void DbgRenderSystem::Release(BufferArray& bufferArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     instance_->Release(bufferArray);
     //ReleaseDbg(bufferArrays_, bufferArray);
 }
 
 void DbgRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
     
     if (debugger_)
@@ -176,39 +261,226 @@ void DbgRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t
     instance_->WriteBuffer(bufferDbg.instance, data, dataSize, offset);
     
     LLGL_DBG_PROFILER_DO(writeBuffer.Inc());
+
+    ProfileBufferWrite(bufferDbg, data, dataSize, offset, __FUNCTION__);
 }
 
 void* DbgRenderSystem::MapBuffer(Buffer& buffer, const BufferCPUAccess access)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     void* result = nullptr;
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
     {
         result = instance_->MapBuffer(bufferDbg.instance, access);
     }
+    bufferDbg.mappedSize    = static_cast<std::size_t>(bufferDbg.desc.size);
+    bufferDbg.mapFlags      = 0;
+    if (access != BufferCPUAccess::ReadOnly)
+        bufferDbg.shadowSize = 0;
     LLGL_DBG_PROFILER_DO(mapBuffer.Inc());
     return result;
 }
 
+void* DbgRenderSystem::MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    void* result = nullptr;
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugBufferSize(bufferDbg.desc.size, size, offset);
+        if (size == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot map buffer range of size zero");
+        if ((mapFlags & BufferMapFlags::Deferred) != 0)
+        {
+            if (access != BufferCPUAccess::ReadOnly)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "deferred buffer mapping requires read-only access");
+        }
+        else if (mapFlags != 0 && (access == BufferCPUAccess::ReadOnly || access == BufferCPUAccess::ReadWrite))
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer mapping flags require write-only access");
+    }
+
+    result = instance_->MapBufferRange(bufferDbg.instance, offset, size, access, mapFlags);
+
+    bufferDbg.mappedSize    = size;
+    bufferDbg.mapFlags      = mapFlags;
+    if (access != BufferCPUAccess::ReadOnly)
+        bufferDbg.shadowSize = std::min(bufferDbg.shadowSize, offset);
+
+    LLGL_DBG_PROFILER_DO(mapBuffer.Inc());
+    return result;
+}
+
+void DbgRenderSystem::FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if ((bufferDbg.mapFlags & BufferMapFlags::FlushExplicit) == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot flush buffer range that has not been mapped with BufferMapFlags::FlushExplicit");
+        else
+            DebugBufferSize(bufferDbg.mappedSize, size, offset);
+    }
+
+    instance_->FlushMappedBufferRange(bufferDbg.instance, offset, size);
+}
+
 void DbgRenderSystem::UnmapBuffer(Buffer& buffer)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
     instance_->UnmapBuffer(bufferDbg.instance);
+    bufferDbg.mappedSize    = 0;
+    bufferDbg.mapFlags      = 0;
+}
+
+TransientBufferRange DbgRenderSystem::WriteTransientConstantBuffer(const void* data, std::size_t dataSize)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!GetRenderingCaps().hasConstantBufferRanges)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("transient constant buffers");
+        if (!data)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "transient constant buffer data must not be a null pointer");
+        if (dataSize == 0 || dataSize > GetRenderingCaps().maxConstantBufferSize)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid size of transient constant buffer data (" + std::to_string(dataSize) + " bytes)");
+    }
+
+    auto range = instance_->WriteTransientConstantBuffer(data, dataSize);
+
+    if (range.buffer)
+    {
+        /* Wrap ring buffer of the instance, which stays the same for the lifetime of the render system */
+        if (!transientConstantBuffer_ || &(transientConstantBuffer_->instance) != range.buffer)
+        {
+            transientConstantBuffer_ = MakeUnique<DbgBuffer>(*range.buffer, BufferType::Constant);
+            {
+                /* Leave buffer size at zero, since the size of the ring buffer is up to the render system */
+                transientConstantBuffer_->desc.type     = BufferType::Constant;
+                transientConstantBuffer_->initialized   = true;
+            }
+        }
+
+        range.buffer = transientConstantBuffer_.get();
+    }
+
+    LLGL_DBG_PROFILER_DO(writeBuffer.Inc());
+
+    return range;
 }
 
 /* ----- Textures ----- */
 
+// Returns the number of MIP-map levels of a full MIP-map chain for the specified texture.
+static unsigned int GetFullMipLevelCount(const TextureDescriptor& desc)
+{
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            return NumMipLevels(desc.texture1D.width);
+        case TextureType::Texture3D:
+            return NumMipLevels(desc.texture3D.width, desc.texture3D.height, desc.texture3D.depth);
+        case TextureType::Texture2DMS:
+        case TextureType::Texture2DMSArray:
+            return 1;
+        default:
+            return NumMipLevels(desc.texture2D.width, desc.texture2D.height);
+    }
+}
+
+// Returns the estimated memory size (in bytes) of the specified texture with a full MIP-map chain.
+static std::uint64_t GetTextureMemorySize(const TextureDescriptor& desc)
+{
+    /* Determine extent of the first MIP-map level and number of array layers */
+    unsigned int width = 1, height = 1, depth = 1, layers = 1, samples = 1;
+
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            width   = desc.texture1D.width;
+            layers  = (desc.type == TextureType::Texture1DArray ? desc.texture1D.layers : 1);
+            break;
+        case TextureType::Texture3D:
+            width   = desc.texture3D.width;
+            height  = desc.texture3D.height;
+            depth   = desc.texture3D.depth;
+            break;
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            width   = desc.textureCube.width;
+            height  = desc.textureCube.height;
+            layers  = 6 * (desc.type == TextureType::TextureCubeArray ? std::max(desc.textureCube.layers, 1u) : 1);
+            break;
+        case TextureType::Texture2DMS:
+        case TextureType::Texture2DMSArray:
+            width   = desc.texture2DMS.width;
+            height  = desc.texture2DMS.height;
+            layers  = (desc.type == TextureType::Texture2DMSArray ? desc.texture2DMS.layers : 1);
+            samples = std::max(desc.texture2DMS.samples, 1u);
+            break;
+        default:
+            width   = desc.texture2D.width;
+            height  = desc.texture2D.height;
+            layers  = (desc.type == TextureType::Texture2DArray ? desc.texture2D.layers : 1);
+            break;
+    }
+
+    layers = std::max(layers, 1u);
+
+    /* Accumulate size of all MIP-map levels */
+    std::uint64_t size = 0;
+    const auto numMipLevels = GetFullMipLevelCount(desc);
+
+    for (unsigned int mip = 0; mip < numMipLevels; ++mip)
+    {
+        const auto mipWidth     = std::max(width  >> mip, 1u);
+        const auto mipHeight    = std::max(height >> mip, 1u);
+        const auto mipDepth     = std::max(depth  >> mip, 1u);
+
+        if (IsCompressedFormat(desc.format))
+            size += static_cast<std::uint64_t>(CompressedImageSize(desc.format, mipWidth, mipHeight, mipDepth)) * layers;
+        else
+            size += static_cast<std::uint64_t>(mipWidth) * mipHeight * mipDepth * layers * samples * TextureFormatSize(desc.format);
+    }
+
+    return size;
+}
+
 Texture* DbgRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
         DebugTextureDescriptor(textureDesc);
     }
-    return TakeOwnership(textures_, MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc));
+
+    auto texture = MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc);
+
+    if (profiler_)
+    {
+        texture->memory.type    = RenderingProfiler::MemoryType::Texture;
+        texture->memory.format  = textureDesc.format;
+        texture->memory.size    = GetTextureMemorySize(textureDesc);
+        texture->memory.tag     = DbgGetCallSiteTag();
+        profiler_->RecordAllocation(texture->memory);
+    }
+
+    return TakeOwnership(textures_, std::move(texture));
 }
 
 TextureArray* DbgRenderSystem::CreateTextureArray(unsigned int numTextures, Texture* const * textureArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     AssertCreateTextureArray(numTextures, textureArray);
 
     /* Create temporary buffer array with buffer instances */
@@ -222,25 +494,96 @@ TextureArray* DbgRenderSystem::CreateTextureArray(unsigned int numTextures, Text
     return instance_->CreateTextureArray(numTextures, textureInstanceArray.data());
 }
 
+Texture* DbgRenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& sharedTextureDbg = LLGL_CAST(DbgTexture&, sharedTexture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugTextureViewDescriptor(sharedTextureDbg, textureViewDesc);
+    }
+
+    /* Keep dimensions of the shared texture, since they are only used for validation */
+    auto viewDesc = sharedTextureDbg.desc;
+    {
+        viewDesc.type = textureViewDesc.type;
+        if (textureViewDesc.format != TextureFormat::Unknown)
+            viewDesc.format = textureViewDesc.format;
+    }
+
+    auto textureView = MakeUnique<DbgTexture>(*instance_->CreateTextureView(sharedTextureDbg.instance, textureViewDesc), viewDesc);
+    {
+        textureView->mipLevels      = static_cast<int>(textureViewDesc.numMipLevels);
+        textureView->sharedTexture  = &sharedTextureDbg;
+    }
+    ++sharedTextureDbg.numViews;
+
+    return TakeOwnership(textures_, std::move(textureView));
+}
+
+Texture* DbgRenderSystem::CreateSparseTexture(const TextureDescriptor& textureDesc)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugSparseTextureDescriptor(textureDesc);
+    }
+
+    auto texture = MakeUnique<DbgTexture>(*instance_->CreateSparseTexture(textureDesc), textureDesc);
+    {
+        texture->mipLevels  = static_cast<int>(GetFullMipLevelCount(textureDesc));
+        texture->sparse     = true;
+    }
+    return TakeOwnership(textures_, std::move(texture));
+}
+
 void DbgRenderSystem::Release(Texture& texture)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (textureDbg.numViews > 0)
+        {
+            LLGL_DBG_ERROR(
+                ErrorType::InvalidState,
+                "releasing texture that is still shared by " + std::to_string(textureDbg.numViews) + " texture view(s)"
+            );
+        }
+    }
+
+    if (textureDbg.sharedTexture)
+        --(textureDbg.sharedTexture->numViews);
+
+    /* Texture views and sparse textures have not recorded any memory */
+    if (profiler_ && !textureDbg.sharedTexture && !textureDbg.sparse)
+        profiler_->RecordRelease(textureDbg.memory);
+
     ReleaseDbg(textures_, texture);
 }
 
 void DbgRenderSystem::Release(TextureArray& textureArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     instance_->Release(textureArray);
     //ReleaseDbg(textureArrays_, textureArray);
 }
 
 TextureDescriptor DbgRenderSystem::QueryTextureDescriptor(const Texture& texture)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     auto& textureDbg = LLGL_CAST(const DbgTexture&, texture);
     return instance_->QueryTextureDescriptor(textureDbg.instance);
 }
 
 void DbgRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
 
     if (debugger_)
@@ -254,6 +597,7 @@ void DbgRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor&
 
 void DbgRenderSystem::ReadTexture(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType, void* buffer)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     auto& textureDbg = LLGL_CAST(const DbgTexture&, texture);
 
     if (debugger_)
@@ -267,6 +611,7 @@ void DbgRenderSystem::ReadTexture(const Texture& texture, int mipLevel, ImageFor
 
 void DbgRenderSystem::GenerateMips(Texture& texture)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
     {
         instance_->GenerateMips(textureDbg.instance);
@@ -275,41 +620,147 @@ void DbgRenderSystem::GenerateMips(Texture& texture)
     textureDbg.mipLevels = NumMipLevels(tex3DDesc.width, tex3DDesc.height, tex3DDesc.depth);
 }
 
+std::uint64_t DbgRenderSystem::GetBindlessTextureHandle(Texture& texture, Sampler* sampler)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (!GetRenderingCaps().hasBindlessTextures)
+            LLGL_DBG_ERROR_NOT_SUPPORTED("bindless textures");
+    }
+
+    return instance_->GetBindlessTextureHandle(textureDbg.instance, sampler);
+}
+
+void DbgRenderSystem::CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugSparseTexture(textureDbg);
+        DebugMipLevelLimit(static_cast<int>(region.mipLevel), textureDbg.mipLevels);
+        if (region.extent.x == 0 || region.extent.y == 0 || region.extent.z == 0)
+            LLGL_DBG_WARN(WarningType::PointlessOperation, "committing sparse texture region of zero extent");
+    }
+
+    instance_->CommitSparseTexture(textureDbg.instance, region, commit);
+}
+
+bool DbgRenderSystem::IsSparseTextureResident(const Texture& texture, const TextureRegion& region)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& textureDbg = LLGL_CAST(const DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugSparseTexture(textureDbg);
+        DebugMipLevelLimit(static_cast<int>(region.mipLevel), textureDbg.mipLevels);
+    }
+
+    return instance_->IsSparseTextureResident(textureDbg.instance, region);
+}
+
+Gs::Vector3ui DbgRenderSystem::QuerySparseTexturePageSize(const Texture& texture)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& textureDbg = LLGL_CAST(const DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugSparseTexture(textureDbg);
+    }
+
+    return instance_->QuerySparseTexturePageSize(textureDbg.instance);
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* DbgRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     return instance_->CreateSampler(desc);
     //return TakeOwnership(samplers_, MakeUnique<DbgSampler>());
 }
 
 SamplerArray* DbgRenderSystem::CreateSamplerArray(unsigned int numSamplers, Sampler* const * samplerArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     AssertCreateSamplerArray(numSamplers, samplerArray);
     return instance_->CreateSamplerArray(numSamplers, samplerArray);
 }
 
 void DbgRenderSystem::Release(Sampler& sampler)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     instance_->Release(sampler);
     //RemoveFromUniqueSet(samplers_, &sampler);
 }
 
 void DbgRenderSystem::Release(SamplerArray& samplerArray)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     instance_->Release(samplerArray);
     //RemoveFromUniqueSet(samplerArrays_, &samplerArray);
 }
 
+/* ----- Resource Heaps ----- */
+
+ResourceHeap* DbgRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    AssertCreateResourceHeap(desc);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugResourceHeapDescriptor(desc);
+    }
+
+    /* Create temporary descriptor with buffer and texture instances */
+    auto instanceDesc = desc;
+
+    for (auto& resourceView : instanceDesc.resourceViews)
+    {
+        if (resourceView.buffer != nullptr)
+        {
+            auto bufferDbg = LLGL_CAST(DbgBuffer*, resourceView.buffer);
+            resourceView.buffer = &(bufferDbg->instance);
+        }
+        if (resourceView.texture != nullptr)
+        {
+            auto textureDbg = LLGL_CAST(DbgTexture*, resourceView.texture);
+            resourceView.texture = &(textureDbg->instance);
+        }
+    }
+
+    return instance_->CreateResourceHeap(instanceDesc);
+}
+
+void DbgRenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    instance_->Release(resourceHeap);
+}
+
 /* ----- Render Targets ----- */
 
 RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
 {
-    return TakeOwnership(renderTargets_, MakeUnique<DbgRenderTarget>(*instance_->CreateRenderTarget(desc), debugger_, desc));
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    return TakeOwnership(renderTargets_, MakeUnique<DbgRenderTarget>(*instance_->CreateRenderTarget(desc), profiler_, debugger_, desc));
 }
 
 void DbgRenderSystem::Release(RenderTarget& renderTarget)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
@@ -317,21 +768,25 @@ void DbgRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* DbgRenderSystem::CreateShader(const ShaderType type)
 {
-    return TakeOwnership(shaders_, MakeUnique<DbgShader>(*instance_->CreateShader(type), type, debugger_));
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    return TakeOwnership(shaders_, MakeUnique<DbgShader>(*instance_->CreateShader(type), type, debugger_, tracer_));
 }
 
 ShaderProgram* DbgRenderSystem::CreateShaderProgram()
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     return TakeOwnership(shaderPrograms_, MakeUnique<DbgShaderProgram>(*instance_->CreateShaderProgram(), debugger_));
 }
 
 void DbgRenderSystem::Release(Shader& shader)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     ReleaseDbg(shaders_, shader);
 }
 
 void DbgRenderSystem::Release(ShaderProgram& shaderProgram)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     ReleaseDbg(shaderPrograms_, shaderProgram);
 }
 
@@ -339,6 +794,7 @@ void DbgRenderSystem::Release(ShaderProgram& shaderProgram)
 
 GraphicsPipeline* DbgRenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     LLGL_DBG_SOURCE;
 
     if (debugger_)
@@ -347,6 +803,17 @@ GraphicsPipeline* DbgRenderSystem::CreateGraphicsPipeline(const GraphicsPipeline
             LLGL_DBG_ERROR_NOT_SUPPORTED("conservative rasterization");
         if (desc.blend.targets.size() > 8)
             LLGL_DBG_ERROR(ErrorType::InvalidArgument, "too many blend state targets (limit is 8)");
+        if (desc.pushConstants.size % 16 != 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "size of push constants must be a multiple of 16");
+        if (desc.pushConstants.size > GetRenderingCaps().maxPushConstantsSize)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "size of push constants exceeds limit (limit is " + std::to_string(GetRenderingCaps().maxPushConstantsSize) + " bytes)");
+        if (desc.viewMask != 0)
+        {
+            if (GetRenderingCaps().maxNumViews == 0)
+                LLGL_DBG_ERROR_NOT_SUPPORTED("multiview rendering");
+            else if (desc.viewMask >> GetRenderingCaps().maxNumViews != 0)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "view mask exceeds number of views (limit is " + std::to_string(GetRenderingCaps().maxNumViews) + ")");
+        }
 
         if (GetRendererID() != RendererID::OpenGL)
         {
@@ -381,6 +848,7 @@ GraphicsPipeline* DbgRenderSystem::CreateGraphicsPipeline(const GraphicsPipeline
 
 ComputePipeline* DbgRenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     if (desc.shaderProgram)
     {
         ComputePipelineDescriptor instanceDesc = desc;
@@ -398,27 +866,198 @@ ComputePipeline* DbgRenderSystem::CreateComputePipeline(const ComputePipelineDes
 
 void DbgRenderSystem::Release(GraphicsPipeline& graphicsPipeline)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     ReleaseDbg(graphicsPipelines_, graphicsPipeline);
 }
 
 void DbgRenderSystem::Release(ComputePipeline& computePipeline)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     instance_->Release(computePipeline);
     //RemoveFromUniqueSet(computePipelines_, &computePipeline);
 }
 
+bool DbgRenderSystem::LoadPipelineCache(const std::vector<char>& data)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    return instance_->LoadPipelineCache(data);
+}
+
+std::vector<char> DbgRenderSystem::SavePipelineCache()
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    return instance_->SavePipelineCache();
+}
+
 /* ----- Queries ----- */
 
 Query* DbgRenderSystem::CreateQuery(const QueryDescriptor& desc)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     return TakeOwnership(queries_, MakeUnique<DbgQuery>(*instance_->CreateQuery(desc), desc));
 }
 
+QueryArray* DbgRenderSystem::CreateQueryArray(unsigned int numQueries, Query* const * queryArray)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    AssertCreateQueryArray(numQueries, queryArray);
+
+    /* Create temporary query array with query instances */
+    std::vector<DbgQuery*> queriesDbg;
+    std::vector<Query*> queryInstanceArray;
+    for (unsigned int i = 0; i < numQueries; ++i)
+    {
+        auto queryDbg = LLGL_CAST(DbgQuery*, (*(queryArray++)));
+        queriesDbg.push_back(queryDbg);
+        queryInstanceArray.push_back(&(queryDbg->instance));
+    }
+
+    return TakeOwnership(
+        queryArrays_,
+        MakeUnique<DbgQueryArray>(*instance_->CreateQueryArray(numQueries, queryInstanceArray.data()), std::move(queriesDbg))
+    );
+}
+
 void DbgRenderSystem::Release(Query& query)
 {
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
     ReleaseDbg(queries_, query);
 }
 
+void DbgRenderSystem::Release(QueryArray& queryArray)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    ReleaseDbg(queryArrays_, queryArray);
+}
+
+/* ----- Readbacks ----- */
+
+Readback* DbgRenderSystem::ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& textureDbg = LLGL_CAST(const DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugMipLevelLimit(mipLevel, textureDbg.mipLevels);
+    }
+
+    return instance_->ReadTextureAsync(textureDbg.instance, mipLevel, imageFormat, dataType);
+}
+
+Readback* DbgRenderSystem::ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugBufferSize(bufferDbg.desc.size, dataSize, offset);
+    }
+
+    return instance_->ReadBufferAsync(bufferDbg.instance, offset, dataSize);
+}
+
+void DbgRenderSystem::Release(Readback& readback)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    instance_->Release(readback);
+}
+
+/* ----- Uploads ----- */
+
+Fence* DbgRenderSystem::WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+
+        /* Make a rough approximation if the buffer is now being initialized */
+        if (!bufferDbg.initialized)
+        {
+            if (offset == 0)
+                bufferDbg.initialized = true;
+        }
+
+        DebugBufferSize(bufferDbg.desc.size, dataSize, offset);
+    }
+
+    auto fence = instance_->WriteBufferAsync(bufferDbg.instance, data, dataSize, offset);
+
+    LLGL_DBG_PROFILER_DO(writeBuffer.Inc());
+
+    ProfileBufferWrite(bufferDbg, data, dataSize, offset, __FUNCTION__);
+
+    return fence;
+}
+
+Fence* DbgRenderSystem::WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugMipLevelLimit(subTextureDesc.mipLevel, textureDbg.mipLevels);
+    }
+
+    return instance_->WriteTextureAsync(textureDbg.instance, subTextureDesc, imageDesc);
+}
+
+/* ----- Fences ----- */
+
+Fence* DbgRenderSystem::CreateFence()
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    return instance_->CreateFence();
+}
+
+void DbgRenderSystem::Release(Fence& fence)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    instance_->Release(fence);
+}
+
+/* ----- Memory ----- */
+
+MemoryInfo DbgRenderSystem::QueryMemoryInfo()
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    return instance_->QueryMemoryInfo();
+}
+
+bool DbgRenderSystem::SetResidency(Buffer& buffer, bool resident)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+    return instance_->SetResidency(bufferDbg.instance, resident);
+}
+
+bool DbgRenderSystem::SetResidency(Texture& texture, bool resident)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+    return instance_->SetResidency(textureDbg.instance, resident);
+}
+
+bool DbgRenderSystem::QueryClockCalibration(ClockCalibration& calibration)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    return instance_->QueryClockCalibration(calibration);
+}
+
+bool DbgRenderSystem::ReportStateCacheStatistics(RenderingProfiler& profiler)
+{
+    LLGL_DBG_TRACE(TraceCategory::RenderSystem);
+    return instance_->ReportStateCacheStatistics(profiler);
+}
+
 
 /*
  * ======= Private: =======
@@ -442,6 +1081,101 @@ void DbgRenderSystem::DebugMipLevelLimit(int mipLevel, int mipLevelCount)
     }
 }
 
+// Returns the number of array layers of the specified texture, where cube faces are separate layers.
+static unsigned int GetArrayLayerCount(const TextureDescriptor& desc)
+{
+    switch (desc.type)
+    {
+        case TextureType::Texture1DArray:   return desc.texture1D.layers;
+        case TextureType::Texture2DArray:   return desc.texture2D.layers;
+        case TextureType::TextureCube:      return 6;
+        case TextureType::TextureCubeArray: return desc.textureCube.layers * 6;
+        case TextureType::Texture2DMSArray: return desc.texture2DMS.layers;
+        default:                            return 1;
+    }
+}
+
+void DbgRenderSystem::DebugTextureViewDescriptor(const DbgTexture& sharedTexture, const TextureViewDescriptor& desc)
+{
+    if (!GetRenderingCaps().hasTextureViews)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("texture views");
+
+    if (sharedTexture.sharedTexture != nullptr)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create texture view of another texture view");
+
+    if (desc.numMipLevels == 0 || desc.numArrayLayers == 0)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot create texture view without MIP-map levels or array layers");
+
+    /* Validate MIP-map range with the full MIP-map chain as upper bound */
+    const auto numMipLevels = GetFullMipLevelCount(sharedTexture.desc);
+    if (desc.firstMipLevel + desc.numMipLevels > numMipLevels)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "texture view MIP-map range out of bounds (" + std::to_string(desc.firstMipLevel + desc.numMipLevels) +
+            " levels specified but limit is " + std::to_string(numMipLevels) + ")"
+        );
+    }
+
+    const auto numArrayLayers = GetArrayLayerCount(sharedTexture.desc);
+    if (desc.firstArrayLayer + desc.numArrayLayers > numArrayLayers)
+    {
+        LLGL_DBG_ERROR(
+            ErrorType::InvalidArgument,
+            "texture view array layer range out of bounds (" + std::to_string(desc.firstArrayLayer + desc.numArrayLayers) +
+            " layers specified but limit is " + std::to_string(numArrayLayers) + ")"
+        );
+    }
+
+    if ((desc.type == TextureType::TextureCube && desc.numArrayLayers != 6) ||
+        (desc.type == TextureType::TextureCubeArray && desc.numArrayLayers % 6 != 0))
+    {
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "number of array layers for cube texture view must be a multiple of 6");
+    }
+}
+
+void DbgRenderSystem::DebugSparseTextureDescriptor(const TextureDescriptor& desc)
+{
+    if (!GetRenderingCaps().hasSparseTextures)
+        LLGL_DBG_ERROR_NOT_SUPPORTED("sparse textures");
+
+    switch (desc.type)
+    {
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+        case TextureType::Texture3D:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            break;
+        default:
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid texture type for sparse texture (1D and multi-sampled textures are not supported)");
+            break;
+    }
+
+    switch (desc.format)
+    {
+        case TextureFormat::Unknown:
+        case TextureFormat::DepthComponent:
+        case TextureFormat::DepthStencil:
+        case TextureFormat::R:
+        case TextureFormat::RG:
+        case TextureFormat::RGB:
+        case TextureFormat::RGBA:
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "invalid texture format for sparse texture (base formats without explicit size are not supported)");
+            break;
+        default:
+            break;
+    }
+
+    DebugTextureDescriptor(desc);
+}
+
+void DbgRenderSystem::DebugSparseTexture(const DbgTexture& textureDbg)
+{
+    if (!textureDbg.sparse)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "texture was not created as sparse texture");
+}
+
 void DbgRenderSystem::DebugTextureDescriptor(const TextureDescriptor& desc)
 {
     switch (desc.type)
@@ -516,8 +1250,55 @@ void DbgRenderSystem::ErrTextureLayersEqualZero()
     LLGL_DBG_ERROR(ErrorType::InvalidArgument, "number of texture layers must not be zero for array texutres");
 }
 
+void DbgRenderSystem::DebugResourceHeapDescriptor(const ResourceHeapDescriptor& desc)
+{
+    if (desc.resourceViews.empty())
+        LLGL_DBG_WARN(WarningType::PointlessOperation, "resource heap has no resource views");
+
+    for (std::size_t i = 0; i < desc.resourceViews.size(); ++i)
+    {
+        const auto& resourceView = desc.resourceViews[i];
+
+        /* Validate buffer type for buffer bindings */
+        if (resourceView.buffer != nullptr)
+        {
+            if (resourceView.type == ResourceType::ConstantBuffer && resourceView.buffer->GetType() != BufferType::Constant)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "resource view of type 'ResourceType::ConstantBuffer' must refer to a constant buffer");
+            if (resourceView.type == ResourceType::StorageBuffer && resourceView.buffer->GetType() != BufferType::Storage)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "resource view of type 'ResourceType::StorageBuffer' must refer to a storage buffer");
+        }
+
+        /* Validate that each slot is only used once per resource type */
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            if (desc.resourceViews[j].type == resourceView.type && desc.resourceViews[j].slot == resourceView.slot)
+            {
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "duplicate slot " + std::to_string(resourceView.slot) + " in resource heap");
+                break;
+            }
+        }
+    }
+}
+
+void DbgRenderSystem::ProfileBufferWrite(DbgBuffer& bufferDbg, const void* data, std::size_t dataSize, std::size_t offset, const char* source)
+{
+    if (profiler_ && offset + dataSize <= bufferDbg.shadowData.size())
+    {
+        /* Compare with previous contents, and extend the valid range of the copy if the write is adjacent */
+        auto shadow = bufferDbg.shadowData.data() + offset;
+        if (offset + dataSize <= bufferDbg.shadowSize && std::memcmp(shadow, data, dataSize) == 0)
+            profiler_->RecordWastedWork(RenderingProfiler::WastedWorkType::RedundantBufferWrite, source);
+        else
+        {
+            std::memcpy(shadow, data, dataSize);
+            if (offset <= bufferDbg.shadowSize)
+                bufferDbg.shadowSize = std::max(bufferDbg.shadowSize, offset + dataSize);
+        }
+    }
+}
+
 template <typename T, typename TBase>
-void DbgRenderSystem::ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry)
+void DbgRenderSystem::ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry)
 {
     auto& entryDbg = LLGL_CAST(T&, entry);
     instance_->Release(entryDbg.instance);
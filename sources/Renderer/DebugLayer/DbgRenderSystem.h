@@ -20,6 +20,8 @@
 #include "DbgShader.h"
 #include "DbgShaderProgram.h"
 #include "DbgQuery.h"
+#include "DbgQueryArray.h"
+#include "DbgCore.h"
 
 #include "../ContainerTypes.h"
 
@@ -35,7 +37,7 @@ class DbgRenderSystem : public RenderSystem
 
         /* ----- Common ----- */
 
-        DbgRenderSystem(const std::shared_ptr<RenderSystem>& instance, RenderingProfiler* profiler, RenderingDebugger* debugger);
+        DbgRenderSystem(const std::shared_ptr<RenderSystem>& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, RenderingTracer* tracer);
         ~DbgRenderSystem();
 
         void SetConfiguration(const RenderSystemConfiguration& config) override;
@@ -48,7 +50,9 @@ class DbgRenderSystem : public RenderSystem
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
+
+        void ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray) override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
@@ -63,12 +67,18 @@ class DbgRenderSystem : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const BufferCPUAccess access) override;
+        void* MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags = 0) override;
+        void FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        TransientBufferRange WriteTransientConstantBuffer(const void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc = nullptr) override;
         TextureArray* CreateTextureArray(unsigned int numTextures, Texture* const * textureArray) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
+        Texture* CreateSparseTexture(const TextureDescriptor& textureDesc) override;
 
         void Release(Texture& texture) override;
         void Release(TextureArray& textureArray) override;
@@ -81,6 +91,12 @@ class DbgRenderSystem : public RenderSystem
 
         void GenerateMips(Texture& texture) override;
 
+        std::uint64_t GetBindlessTextureHandle(Texture& texture, Sampler* sampler = nullptr) override;
+
+        void CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit) override;
+        bool IsSparseTextureResident(const Texture& texture, const TextureRegion& region) override;
+        Gs::Vector3ui QuerySparseTexturePageSize(const Texture& texture) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
@@ -89,6 +105,12 @@ class DbgRenderSystem : public RenderSystem
         void Release(Sampler& sampler) override;
         void Release(SamplerArray& samplerArray) override;
 
+        /* ----- Resource Heaps ----- */
+
+        ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
+
+        void Release(ResourceHeap& resourceHeap) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
@@ -111,11 +133,45 @@ class DbgRenderSystem : public RenderSystem
         void Release(GraphicsPipeline& graphicsPipeline) override;
         void Release(ComputePipeline& computePipeline) override;
 
+        bool LoadPipelineCache(const std::vector<char>& data) override;
+        std::vector<char> SavePipelineCache() override;
+
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
+        QueryArray* CreateQueryArray(unsigned int numQueries, Query* const * queryArray) override;
 
         void Release(Query& query) override;
+        void Release(QueryArray& queryArray) override;
+
+        /* ----- Readbacks ----- */
+
+        Readback* ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType) override;
+        Readback* ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize) override;
+
+        void Release(Readback& readback) override;
+
+        /* ----- Uploads ----- */
+
+        Fence* WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
+        Fence* WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc) override;
+
+        /* ----- Fences ----- */
+
+        Fence* CreateFence() override;
+
+        void Release(Fence& fence) override;
+
+        /* ----- Memory ----- */
+
+        MemoryInfo QueryMemoryInfo() override;
+
+        bool SetResidency(Buffer& buffer, bool resident) override;
+        bool SetResidency(Texture& texture, bool resident) override;
+
+        bool QueryClockCalibration(ClockCalibration& calibration) override;
+
+        bool ReportStateCacheStatistics(RenderingProfiler& profiler) override;
 
     private:
 
@@ -123,12 +179,20 @@ class DbgRenderSystem : public RenderSystem
         void DebugMipLevelLimit(int mipLevel, int mipLevelCount);
 
         void DebugTextureDescriptor(const TextureDescriptor& desc);
+        void DebugTextureViewDescriptor(const DbgTexture& sharedTexture, const TextureViewDescriptor& desc);
+        void DebugSparseTextureDescriptor(const TextureDescriptor& desc);
+        void DebugSparseTexture(const DbgTexture& textureDbg);
         void DebugTextureSize(unsigned int size);
         void WarnTextureLayersGreaterOne();
         void ErrTextureLayersEqualZero();
 
+        void DebugResourceHeapDescriptor(const ResourceHeapDescriptor& desc);
+
+        // Records a redundant buffer write with the profiler, if the data matches the shadow copy of the buffer, and updates the shadow copy otherwise.
+        void ProfileBufferWrite(DbgBuffer& bufferDbg, const void* data, std::size_t dataSize, std::size_t offset, const char* source);
+
         template <typename T, typename TBase>
-        void ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry);
+        void ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry);
 
         /* ----- Common objects ----- */
 
@@ -136,6 +200,7 @@ class DbgRenderSystem : public RenderSystem
 
         RenderingProfiler*                      profiler_   = nullptr;
         RenderingDebugger*                      debugger_   = nullptr;
+        RenderingTracer*                        tracer_     = nullptr;
 
         /* ----- Hardware object containers ----- */
 
@@ -150,6 +215,9 @@ class DbgRenderSystem : public RenderSystem
         //HWObjectContainer<DbgComputePipeline>   computePipelines_;
         //HWObjectContainer<DbgSampler>           samplers_;
         HWObjectContainer<DbgQuery>             queries_;
+        HWObjectContainer<DbgQueryArray>        queryArrays_;
+
+        std::unique_ptr<DbgBuffer>              transientConstantBuffer_;   // wrapper for the ring buffer of the instance
 
 };
 
@@ -15,26 +15,56 @@ namespace LLGL
 {
 
 
-DbgRenderTarget::DbgRenderTarget(RenderTarget& instance, RenderingDebugger* debugger, const RenderTargetDescriptor& desc) :
+DbgRenderTarget::DbgRenderTarget(RenderTarget& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, const RenderTargetDescriptor& desc) :
     instance  { instance },
+    profiler_ { profiler },
     debugger_ { debugger },
     desc_     { desc     }
 {
 }
 
+DbgRenderTarget::~DbgRenderTarget()
+{
+    ReleaseDepthBuffer();
+}
+
 void DbgRenderTarget::AttachDepthBuffer(const Gs::Vector2ui& size)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugDepthAttachment();
+        DebugLayeredAttachment(false);
+    }
+    hasDepthAttachment_ = true;
     instance.AttachDepthBuffer(size);
+    RecordDepthBuffer(TextureFormat::DepthComponent, size, 4);
 }
 
 void DbgRenderTarget::AttachStencilBuffer(const Gs::Vector2ui& size)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugDepthAttachment();
+        DebugLayeredAttachment(false);
+    }
+    hasDepthAttachment_ = true;
     instance.AttachStencilBuffer(size);
+    RecordDepthBuffer(TextureFormat::DepthStencil, size, 1);
 }
 
 void DbgRenderTarget::AttachDepthStencilBuffer(const Gs::Vector2ui& size)
 {
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        DebugDepthAttachment();
+        DebugLayeredAttachment(false);
+    }
+    hasDepthAttachment_ = true;
     instance.AttachDepthStencilBuffer(size);
+    RecordDepthBuffer(TextureFormat::DepthStencil, size, 4);
 }
 
 void DbgRenderTarget::AttachTexture(Texture& texture, const RenderTargetAttachmentDescriptor& attachmentDesc)
@@ -47,14 +77,93 @@ void DbgRenderTarget::AttachTexture(Texture& texture, const RenderTargetAttachme
 
         if (desc_.multiSampling.SampleCount() > 1 && desc_.customMultiSampling && !IsMultiSampleTexture(texture.GetType()))
             LLGL_DBG_ERROR(ErrorType::InvalidArgument, "attempt to attach non-multi-sample texture to render-target with custom multi-sampling");
+
+        if (IsDepthStencilFormat(textureDbg.desc.format))
+        {
+            if (texture.GetType() == TextureType::Texture3D)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "attempt to attach 3D texture as depth-stencil attachment to render-target");
+            DebugDepthAttachment();
+        }
+
+        DebugLayeredAttachment(attachmentDesc.layered);
+
+        if (attachmentDesc.layered)
+        {
+            const auto type = texture.GetType();
+            if (!IsArrayTexture(type) && type != TextureType::TextureCube && type != TextureType::Texture3D)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "attempt to attach layered texture to render-target that is neither an array, cube, nor 3D texture");
+        }
+        else if (attachmentDesc.numViews == 0)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "attempt to attach texture with zero views to render-target");
+        else if (attachmentDesc.numViews > 1)
+        {
+            if (texture.GetType() != TextureType::Texture2DArray)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "attempt to attach non-2D-array texture with multiple views to render-target");
+            else if (attachmentDesc.layer + attachmentDesc.numViews > textureDbg.desc.texture2D.layers)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "attempt to attach more views to render-target than the texture has array layers");
+        }
     }
 
+    if (IsDepthStencilFormat(textureDbg.desc.format))
+        hasDepthAttachment_ = true;
+
     instance.AttachTexture(textureDbg.instance, attachmentDesc);
 }
 
 void DbgRenderTarget::DetachAll()
 {
+    hasDepthAttachment_ = false;
+    hasLayered_         = false;
+    hasSingleLayer_     = false;
     instance.DetachAll();
+    ReleaseDepthBuffer();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void DbgRenderTarget::DebugDepthAttachment()
+{
+    if (hasDepthAttachment_)
+        LLGL_DBG_ERROR(ErrorType::InvalidState, "attempt to attach multiple depth-stencil attachments to render-target");
+}
+
+void DbgRenderTarget::DebugLayeredAttachment(bool layered)
+{
+    if (layered ? hasSingleLayer_ : hasLayered_)
+        LLGL_DBG_ERROR(ErrorType::InvalidArgument, "attempt to mix layered and single-layer attachments in render-target");
+    if (layered)
+        hasLayered_ = true;
+    else
+        hasSingleLayer_ = true;
+}
+
+void DbgRenderTarget::RecordDepthBuffer(const TextureFormat format, const Gs::Vector2ui& size, unsigned int bytesPerSample)
+{
+    if (profiler_)
+    {
+        /* Replace previous depth buffer, which is only possible if the debugger is disabled */
+        ReleaseDepthBuffer();
+
+        const auto numSamples = desc_.multiSampling.SampleCount();
+        depthBufferMemory_.type     = RenderingProfiler::MemoryType::RenderTarget;
+        depthBufferMemory_.format   = format;
+        depthBufferMemory_.size     = static_cast<std::uint64_t>(size.x) * size.y * bytesPerSample * numSamples;
+        depthBufferMemory_.tag      = DbgGetCallSiteTag();
+
+        profiler_->RecordAllocation(depthBufferMemory_);
+    }
+}
+
+void DbgRenderTarget::ReleaseDepthBuffer()
+{
+    if (profiler_ && depthBufferMemory_.size > 0)
+    {
+        profiler_->RecordRelease(depthBufferMemory_);
+        depthBufferMemory_.size = 0;
+    }
 }
 
 
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/RenderTarget.h>
+#include <LLGL/RenderingProfiler.h>
 
 
 namespace LLGL
@@ -23,7 +24,8 @@ class DbgRenderTarget : public RenderTarget
 
     public:
 
-        DbgRenderTarget(RenderTarget& instance, RenderingDebugger* debugger, const RenderTargetDescriptor& desc);
+        DbgRenderTarget(RenderTarget& instance, RenderingProfiler* profiler, RenderingDebugger* debugger, const RenderTargetDescriptor& desc);
+        ~DbgRenderTarget();
 
         void AttachDepthBuffer(const Gs::Vector2ui& size) override;
         void AttachStencilBuffer(const Gs::Vector2ui& size) override;
@@ -37,8 +39,20 @@ class DbgRenderTarget : public RenderTarget
 
     private:
 
-        RenderingDebugger*      debugger_   = nullptr;
+        void DebugDepthAttachment();
+        void DebugLayeredAttachment(bool layered);
+
+        void RecordDepthBuffer(const TextureFormat format, const Gs::Vector2ui& size, unsigned int bytesPerSample);
+        void ReleaseDepthBuffer();
+
+        RenderingProfiler*      profiler_           = nullptr;
+        RenderingDebugger*      debugger_           = nullptr;
         RenderTargetDescriptor  desc_;
+        bool                    hasDepthAttachment_ = false;
+        bool                    hasLayered_         = false; // Render target has layered attachments
+        bool                    hasSingleLayer_     = false; // Render target has single-layer attachments (including internal depth buffers)
+
+        RenderingProfiler::MemoryAllocation depthBufferMemory_; // Memory of the internal depth-stencil buffer
 
 };
 
@@ -13,21 +13,33 @@ namespace LLGL
 {
 
 
-DbgShader::DbgShader(Shader& instance, const ShaderType type, RenderingDebugger* debugger) :
+DbgShader::DbgShader(Shader& instance, const ShaderType type, RenderingDebugger* debugger, RenderingTracer* tracer) :
     Shader    { type     },
     instance  { instance },
-    debugger_ { debugger }
+    debugger_ { debugger },
+    tracer_   { tracer   }
 {
 }
 
 bool DbgShader::Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
 {
+    LLGL_DBG_TRACE(TraceCategory::Shader);
+    compileResult_ = {};
     compiled_ = instance.Compile(sourceCode, shaderDesc);
     return compiled_;
 }
 
+std::shared_future<bool> DbgShader::CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
+{
+    LLGL_DBG_TRACE(TraceCategory::Shader);
+    compiled_ = false;
+    compileResult_ = instance.CompileAsync(sourceCode, shaderDesc);
+    return compileResult_;
+}
+
 bool DbgShader::LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc)
 {
+    LLGL_DBG_TRACE(TraceCategory::Shader);
     return instance.LoadBinary(std::move(binaryCode), shaderDesc);
 }
 
@@ -46,6 +58,17 @@ std::string DbgShader::QueryInfoLog()
     return instance.QueryInfoLog();
 }
 
+bool DbgShader::IsCompiled()
+{
+    /* Resolve pending asynchronous compilation */
+    if (compileResult_.valid())
+    {
+        compiled_ = compileResult_.get();
+        compileResult_ = {};
+    }
+    return compiled_;
+}
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/Shader.h>
 #include <LLGL/RenderingDebugger.h>
+#include <LLGL/RenderingTracer.h>
 
 
 namespace LLGL
@@ -22,27 +23,29 @@ class DbgShader : public Shader
 
     public:
 
-        DbgShader(Shader& instance, const ShaderType type, RenderingDebugger* debugger);
+        DbgShader(Shader& instance, const ShaderType type, RenderingDebugger* debugger, RenderingTracer* tracer);
 
         bool Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
 
+        std::shared_future<bool> CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
+
         bool LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc = {}) override;
 
         std::string Disassemble(int flags = 0) override;
 
         std::string QueryInfoLog() override;
 
-        inline bool IsCompiled() const
-        {
-            return compiled_;
-        }
+        // Returns true if the shader has been compiled successfully. This waits for a pending asynchronous compilation.
+        bool IsCompiled();
 
         Shader& instance;
 
     private:
 
-        RenderingDebugger*  debugger_ = nullptr;
-        bool                compiled_ = false;
+        RenderingDebugger*          debugger_ = nullptr;
+        RenderingTracer*            tracer_   = nullptr;
+        bool                        compiled_ = false;
+        std::shared_future<bool>    compileResult_;
 
 };
 
@@ -42,7 +42,7 @@ void DbgShaderProgram::DetachAll()
     shaderAttachmentMask_   = 0;
     linked_                 = false;
     shaderTypes_.clear();
-    vertexLayout_.attributes.clear();
+    vertexLayout_.format = VertexFormat();
     vertexLayout_.bound = false;
 }
 
@@ -89,10 +89,22 @@ std::vector<UniformDescriptor> DbgShaderProgram::QueryUniforms() const
     return instance.QueryUniforms();
 }
 
+int DbgShaderProgram::QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name)
+{
+    return instance.QueryShaderInterfaceSlot(stage, name);
+}
+
+int DbgShaderProgram::QueryShaderClassInstance(const ShaderType stage, const std::string& name)
+{
+    return instance.QueryShaderClassInstance(stage, name);
+}
+
 void DbgShaderProgram::BuildInputLayout(const VertexFormat& vertexFormat)
 {
-    vertexLayout_.attributes    = vertexFormat.attributes;
+    /* Rebuild compact layout, since the attributes might have been modified without updating it */
+    vertexLayout_.format        = vertexFormat;
     vertexLayout_.bound         = true;
+    vertexLayout_.format.UpdateLayout();
 
     instance.BuildInputLayout(vertexFormat);
 }
@@ -137,6 +149,8 @@ void DbgShaderProgram::UnlockShaderUniform()
 #define LLGL_DS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::TessEvaluation)
 #define LLGL_GS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::Geometry)
 #define LLGL_CS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::Compute)
+#define LLGL_AS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::Amplification)
+#define LLGL_MS_MASK                LLGL_SHADERTYPE_MASK(ShaderType::Mesh)
 
 void DbgShaderProgram::DebugShaderAttachment(DbgShader& shaderDbg)
 {
@@ -172,6 +186,10 @@ void DbgShaderProgram::DebugShaderComposition()
         case ( LLGL_VS_MASK | LLGL_HS_MASK | LLGL_DS_MASK |                LLGL_PS_MASK ):
         case ( LLGL_VS_MASK | LLGL_HS_MASK | LLGL_DS_MASK | LLGL_GS_MASK | LLGL_PS_MASK ):
         case ( LLGL_CS_MASK ):
+        case (                LLGL_MS_MASK                ):
+        case (                LLGL_MS_MASK | LLGL_PS_MASK ):
+        case ( LLGL_AS_MASK | LLGL_MS_MASK                ):
+        case ( LLGL_AS_MASK | LLGL_MS_MASK | LLGL_PS_MASK ):
             break;
         default:
             LLGL_DBG_ERROR(ErrorType::InvalidState, "invalid shader composition");
@@ -186,6 +204,8 @@ void DbgShaderProgram::DebugShaderComposition()
 #undef LLGL_DS_MASK
 #undef LLGL_GS_MASK
 #undef LLGL_CS_MASK
+#undef LLGL_AS_MASK
+#undef LLGL_MS_MASK
 
 
 } // /namespace LLGL
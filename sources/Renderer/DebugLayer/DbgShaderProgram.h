@@ -11,6 +11,7 @@
 
 #include <LLGL/ShaderProgram.h>
 #include <LLGL/RenderingDebugger.h>
+#include <LLGL/VertexFormat.h>
 #include <vector>
 
 
@@ -27,7 +28,7 @@ class DbgShaderProgram : public ShaderProgram
 
         struct VertexLayout
         {
-            std::vector<VertexAttribute>    attributes;
+            VertexFormat                    format;     // copy with up-to-date compact layout
             bool                            bound       = false;
         };
 
@@ -45,6 +46,9 @@ class DbgShaderProgram : public ShaderProgram
         std::vector<StorageBufferViewDescriptor> QueryStorageBuffers() const override;
         std::vector<UniformDescriptor> QueryUniforms() const override;
 
+        int QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name) override;
+        int QueryShaderClassInstance(const ShaderType stage, const std::string& name) override;
+
         void BuildInputLayout(const VertexFormat& vertexFormat) override;
         void BindConstantBuffer(const std::string& name, unsigned int bindingIndex) override;
         void BindStorageBuffer(const std::string& name, unsigned int bindingIndex) override;
@@ -57,6 +61,12 @@ class DbgShaderProgram : public ShaderProgram
             return vertexLayout_;
         }
 
+        // Returns true if a shader of the specified type has been attached.
+        inline bool HasShaderType(const ShaderType type) const
+        {
+            return ((shaderAttachmentMask_ & (1 << static_cast<int>(type))) != 0);
+        }
+
         ShaderProgram& instance;
 
     private:
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Texture.h>
+#include <LLGL/RenderingProfiler.h>
 
 
 namespace LLGL
@@ -35,7 +36,12 @@ class DbgTexture : public Texture
 
         Texture&            instance;
         TextureDescriptor   desc;
-        int                 mipLevels   = 1;
+        int                 mipLevels       = 1;
+        DbgTexture*         sharedTexture   = nullptr; // Shared texture if this is a texture view
+        int                 numViews        = 0;
+        bool                sparse          = false;
+
+        RenderingProfiler::MemoryAllocation memory; // Memory allocation, which has been recorded by the profiler.
 
 };
 
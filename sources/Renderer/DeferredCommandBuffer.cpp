@@ -0,0 +1,1362 @@
+/*
+ * DeferredCommandBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DeferredCommandBuffer.h"
+#include "CheckedCast.h"
+#include <cstring>
+#include <new>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+enum class DeferredCommandBuffer::Opcode : std::uint32_t
+{
+    SetGraphicsAPIDependentState,
+    SetViewport,
+    SetViewportArray,
+    SetScissor,
+    SetScissorArray,
+    SetShadingRate,
+    SetShadingRateImage,
+    SetDepthBounds,
+    SetClearColor,
+    SetClearDepth,
+    SetClearStencil,
+    Clear,
+    ClearTarget,
+    SetVertexBuffer,
+    SetVertexBufferArray,
+    SetIndexBuffer,
+    SetConstantBuffer,
+    SetConstantBufferArray,
+    SetConstantBufferRange,
+    SetStorageBuffer,
+    SetStorageBufferArray,
+    ResetBufferCounter,
+    CopyBufferCounter,
+    SetStreamOutputBuffer,
+    SetStreamOutputBufferArray,
+    BeginStreamOutput,
+    EndStreamOutput,
+    PauseStreamOutput,
+    ResumeStreamOutput,
+    SetTexture,
+    SetTextureArray,
+    SetSampler,
+    SetSamplerArray,
+    SetResourceHeap,
+    SetRenderTarget,
+    SetRenderContext,
+    BeginRenderPass,
+    BeginRenderPassContext,
+    EndRenderPass,
+    SetGraphicsPipeline,
+    SetComputePipeline,
+    SetPushConstants,
+    SetShaderClassInstances,
+    BeginQuery,
+    EndQuery,
+    ResolveQueryData,
+    BeginRenderCondition,
+    EndRenderCondition,
+    CopyBuffer,
+    CopyTexture,
+    ResolveTexture,
+    CopyBufferToTexture,
+    Draw,
+    DrawIndexed,
+    DrawIndexedOffset,
+    DrawInstanced,
+    DrawInstancedOffset,
+    DrawIndexedInstanced,
+    DrawIndexedInstancedVertexOffset,
+    DrawIndexedInstancedOffset,
+    DrawIndirect,
+    DrawIndirectMulti,
+    DrawIndexedIndirect,
+    DrawIndexedIndirectMulti,
+    DrawStreamOutput,
+    DrawMeshTasks,
+    Dispatch,
+    DispatchIndirect,
+    Barrier,
+    StorageBarrier,
+    Execute,
+    Signal,
+    SyncGPU,
+};
+
+// Each command starts with this header; 'size' is the entire command size in bytes (including this header and the payload).
+struct DeferredCmdHeader
+{
+    std::uint32_t opcode;
+    std::uint32_t size;
+};
+
+// All commands are aligned to this number of bytes, so that pointers within the command stream are properly aligned.
+static const std::size_t g_deferredCmdAlignment = 8;
+
+struct DeferredCmdObject
+{
+    void*   object;
+};
+
+struct DeferredCmdObjectOffset
+{
+    void*           object;
+    unsigned int    offset;
+};
+
+struct DeferredCmdResource
+{
+    void*           object;
+    unsigned int    slot;
+    long            shaderStageFlags;
+};
+
+struct DeferredCmdResourceRange
+{
+    void*           object;
+    unsigned int    offset;
+    unsigned int    size;
+    unsigned int    slot;
+    long            shaderStageFlags;
+};
+
+struct DeferredCmdPushConstants
+{
+    unsigned int    offset;
+    unsigned int    size;
+};
+
+struct DeferredCmdCount
+{
+    unsigned int    count;
+};
+
+struct DeferredCmdClassInstances
+{
+    ShaderType      stage;
+    unsigned int    numSlots;
+};
+
+struct DeferredCmdColor
+{
+    ColorRGBAf      color;
+};
+
+struct DeferredCmdDepthBounds
+{
+    float           minDepth;
+    float           maxDepth;
+};
+
+struct DeferredCmdClearTarget
+{
+    unsigned int    targetIndex;
+    ColorRGBAf      color;
+};
+
+struct DeferredCmdValue
+{
+    union
+    {
+        long        flags;
+        float       depth;
+        int         stencil;
+        ShadingRate shadingRate;
+    };
+};
+
+struct DeferredCmdRenderCondition
+{
+    Query*              query;
+    RenderConditionMode mode;
+};
+
+// The operations of the color attachments follow as payload.
+struct DeferredCmdRenderPass
+{
+    void*                           object;
+    RenderPassAttachmentDescriptor  depthAttachment;
+    RenderPassAttachmentDescriptor  stencilAttachment;
+    unsigned int                    numColorAttachments;
+};
+
+struct DeferredCmdResolveQueryData
+{
+    QueryArray*     queryArray;
+    unsigned int    firstQuery;
+    unsigned int    numQueries;
+    Buffer*         dstBuffer;
+    unsigned int    dstOffset;
+};
+
+struct DeferredCmdCopyBuffer
+{
+    Buffer*         dstBuffer;
+    unsigned int    dstOffset;
+    Buffer*         srcBuffer;
+    unsigned int    srcOffset;
+    unsigned int    size;
+};
+
+struct DeferredCmdResetBufferCounter
+{
+    Buffer*         buffer;
+    unsigned int    value;
+};
+
+struct DeferredCmdCopyBufferCounter
+{
+    Buffer*         dstBuffer;
+    unsigned int    dstOffset;
+    Buffer*         srcBuffer;
+};
+
+struct DeferredCmdCopyTexture
+{
+    Texture*        dstTexture;
+    unsigned int    dstMipLevel;
+    Gs::Vector3ui   dstOffset;
+    Texture*        srcTexture;
+    TextureRegion   srcRegion;
+};
+
+struct DeferredCmdCopyBufferToTexture
+{
+    Texture*        dstTexture;
+    TextureRegion   dstRegion;
+    Buffer*         srcBuffer;
+    unsigned int    srcOffset;
+    ImageFormat     imageFormat;
+    DataType        dataType;
+};
+
+struct DeferredCmdDraw
+{
+    unsigned int    numVertices;
+    unsigned int    first;
+    unsigned int    numInstances;
+    int             vertexOffset;
+    unsigned int    instanceOffset;
+};
+
+struct DeferredCmdIndirect
+{
+    void*           object;
+    unsigned int    offset;
+    unsigned int    numCommands;
+    unsigned int    stride;
+};
+
+struct DeferredCmdDispatch
+{
+    unsigned int    groupSizeX;
+    unsigned int    groupSizeY;
+    unsigned int    groupSizeZ;
+};
+
+static std::size_t GetAlignedCommandSize(std::size_t size)
+{
+    return ((size + g_deferredCmdAlignment - 1) / g_deferredCmdAlignment) * g_deferredCmdAlignment;
+}
+
+template <typename TCommand>
+TCommand* DeferredCommandBuffer::AllocCommand(const Opcode opcode, std::size_t payloadSize)
+{
+    /* Resize command stream to fit the new command */
+    const auto offset   = buffer_.size();
+    const auto size     = GetAlignedCommandSize(sizeof(DeferredCmdHeader) + sizeof(TCommand) + payloadSize);
+
+    buffer_.resize(offset + size);
+
+    /* Write command header */
+    auto header = reinterpret_cast<DeferredCmdHeader*>(&buffer_[offset]);
+    {
+        header->opcode  = static_cast<std::uint32_t>(opcode);
+        header->size    = static_cast<std::uint32_t>(size);
+    }
+
+    return new (header + 1) TCommand();
+}
+
+void DeferredCommandBuffer::RecordIndirect(const Opcode opcode, Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    auto cmd = AllocCommand<DeferredCmdIndirect>(opcode);
+    cmd->object         = &buffer;
+    cmd->offset         = offset;
+    cmd->numCommands    = numCommands;
+    cmd->stride         = stride;
+}
+
+void DeferredCommandBuffer::RecordRenderPass(const Opcode opcode, void* object, const RenderPassDescriptor& renderPassDesc)
+{
+    const auto numColorAttachments = renderPassDesc.colorAttachments.size();
+    auto cmd = AllocCommand<DeferredCmdRenderPass>(opcode, sizeof(RenderPassAttachmentDescriptor) * numColorAttachments);
+    cmd->object                 = object;
+    cmd->depthAttachment        = renderPassDesc.depthAttachment;
+    cmd->stencilAttachment      = renderPassDesc.stencilAttachment;
+    cmd->numColorAttachments    = static_cast<unsigned int>(numColorAttachments);
+    std::uninitialized_copy(
+        renderPassDesc.colorAttachments.begin(),
+        renderPassDesc.colorAttachments.end(),
+        reinterpret_cast<RenderPassAttachmentDescriptor*>(cmd + 1)
+    );
+}
+
+// Returns the object of a command with an 'object' member (e.g. DeferredCmdObject or DeferredCmdResource).
+template <typename T, typename TCommand>
+static T& GetObjectRef(const TCommand* cmd)
+{
+    return *reinterpret_cast<T*>(cmd->object);
+}
+
+template <typename TCommand>
+static const void* GetCommandPayload(const TCommand* cmd)
+{
+    return (cmd + 1);
+}
+
+
+/* ----- Configuration ----- */
+
+void DeferredCommandBuffer::SetGraphicsAPIDependentState(const GraphicsAPIDependentStateDescriptor& state)
+{
+    auto cmd = AllocCommand<GraphicsAPIDependentStateDescriptor>(Opcode::SetGraphicsAPIDependentState);
+    *cmd = state;
+}
+
+void DeferredCommandBuffer::SetViewport(const Viewport& viewport)
+{
+    auto cmd = AllocCommand<Viewport>(Opcode::SetViewport);
+    *cmd = viewport;
+}
+
+void DeferredCommandBuffer::SetViewportArray(unsigned int numViewports, const Viewport* viewportArray)
+{
+    auto cmd = AllocCommand<DeferredCmdCount>(Opcode::SetViewportArray, sizeof(Viewport) * numViewports);
+    cmd->count = numViewports;
+    ::memcpy(cmd + 1, viewportArray, sizeof(Viewport) * numViewports);
+}
+
+void DeferredCommandBuffer::SetScissor(const Scissor& scissor)
+{
+    auto cmd = AllocCommand<Scissor>(Opcode::SetScissor);
+    *cmd = scissor;
+}
+
+void DeferredCommandBuffer::SetScissorArray(unsigned int numScissors, const Scissor* scissorArray)
+{
+    auto cmd = AllocCommand<DeferredCmdCount>(Opcode::SetScissorArray, sizeof(Scissor) * numScissors);
+    cmd->count = numScissors;
+    ::memcpy(cmd + 1, scissorArray, sizeof(Scissor) * numScissors);
+}
+
+void DeferredCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    auto cmd = AllocCommand<DeferredCmdValue>(Opcode::SetShadingRate);
+    cmd->shadingRate = rate;
+}
+
+void DeferredCommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetShadingRateImage);
+    cmd->object = texture;
+}
+
+void DeferredCommandBuffer::SetDepthBounds(float minDepth, float maxDepth)
+{
+    auto cmd = AllocCommand<DeferredCmdDepthBounds>(Opcode::SetDepthBounds);
+    cmd->minDepth = minDepth;
+    cmd->maxDepth = maxDepth;
+}
+
+void DeferredCommandBuffer::SetClearColor(const ColorRGBAf& color)
+{
+    auto cmd = AllocCommand<DeferredCmdColor>(Opcode::SetClearColor);
+    cmd->color = color;
+}
+
+void DeferredCommandBuffer::SetClearDepth(float depth)
+{
+    auto cmd = AllocCommand<DeferredCmdValue>(Opcode::SetClearDepth);
+    cmd->depth = depth;
+}
+
+void DeferredCommandBuffer::SetClearStencil(int stencil)
+{
+    auto cmd = AllocCommand<DeferredCmdValue>(Opcode::SetClearStencil);
+    cmd->stencil = stencil;
+}
+
+void DeferredCommandBuffer::Clear(long flags)
+{
+    auto cmd = AllocCommand<DeferredCmdValue>(Opcode::Clear);
+    cmd->flags = flags;
+}
+
+void DeferredCommandBuffer::ClearTarget(unsigned int targetIndex, const LLGL::ColorRGBAf& color)
+{
+    auto cmd = AllocCommand<DeferredCmdClearTarget>(Opcode::ClearTarget);
+    cmd->targetIndex    = targetIndex;
+    cmd->color          = color;
+}
+
+/* ----- Buffers ------ */
+
+void DeferredCommandBuffer::SetVertexBuffer(Buffer& buffer, unsigned int offset)
+{
+    auto cmd = AllocCommand<DeferredCmdObjectOffset>(Opcode::SetVertexBuffer);
+    cmd->object = &buffer;
+    cmd->offset = offset;
+}
+
+void DeferredCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetVertexBufferArray);
+    cmd->object = &bufferArray;
+}
+
+void DeferredCommandBuffer::SetIndexBuffer(Buffer& buffer, unsigned int offset)
+{
+    auto cmd = AllocCommand<DeferredCmdObjectOffset>(Opcode::SetIndexBuffer);
+    cmd->object = &buffer;
+    cmd->offset = offset;
+}
+
+void DeferredCommandBuffer::SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResource>(Opcode::SetConstantBuffer);
+    cmd->object             = &buffer;
+    cmd->slot               = slot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+void DeferredCommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResource>(Opcode::SetConstantBufferArray);
+    cmd->object             = &bufferArray;
+    cmd->slot               = startSlot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+void DeferredCommandBuffer::SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResourceRange>(Opcode::SetConstantBufferRange);
+    cmd->object             = &buffer;
+    cmd->offset             = offset;
+    cmd->size               = size;
+    cmd->slot               = slot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+void DeferredCommandBuffer::SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResource>(Opcode::SetStorageBuffer);
+    cmd->object             = &buffer;
+    cmd->slot               = slot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+void DeferredCommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResource>(Opcode::SetStorageBufferArray);
+    cmd->object             = &bufferArray;
+    cmd->slot               = startSlot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+void DeferredCommandBuffer::ResetBufferCounter(Buffer& buffer, unsigned int value)
+{
+    auto cmd = AllocCommand<DeferredCmdResetBufferCounter>(Opcode::ResetBufferCounter);
+    cmd->buffer = &buffer;
+    cmd->value  = value;
+}
+
+void DeferredCommandBuffer::CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer)
+{
+    auto cmd = AllocCommand<DeferredCmdCopyBufferCounter>(Opcode::CopyBufferCounter);
+    cmd->dstBuffer  = &dstBuffer;
+    cmd->dstOffset  = dstOffset;
+    cmd->srcBuffer  = &srcBuffer;
+}
+
+void DeferredCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetStreamOutputBuffer);
+    cmd->object = &buffer;
+}
+
+void DeferredCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetStreamOutputBufferArray);
+    cmd->object = &bufferArray;
+}
+
+void DeferredCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
+{
+    auto cmd = AllocCommand<PrimitiveType>(Opcode::BeginStreamOutput);
+    *cmd = primitiveType;
+}
+
+void DeferredCommandBuffer::EndStreamOutput()
+{
+    AllocCommand<DeferredCmdCount>(Opcode::EndStreamOutput);
+}
+
+void DeferredCommandBuffer::PauseStreamOutput()
+{
+    AllocCommand<DeferredCmdCount>(Opcode::PauseStreamOutput);
+}
+
+void DeferredCommandBuffer::ResumeStreamOutput()
+{
+    AllocCommand<DeferredCmdCount>(Opcode::ResumeStreamOutput);
+}
+
+/* ----- Textures ----- */
+
+void DeferredCommandBuffer::SetTexture(Texture& texture, unsigned int slot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResource>(Opcode::SetTexture);
+    cmd->object             = &texture;
+    cmd->slot               = slot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+void DeferredCommandBuffer::SetTextureArray(TextureArray& textureArray, unsigned int startSlot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResource>(Opcode::SetTextureArray);
+    cmd->object             = &textureArray;
+    cmd->slot               = startSlot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+/* ----- Sampler States ----- */
+
+void DeferredCommandBuffer::SetSampler(Sampler& sampler, unsigned int slot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResource>(Opcode::SetSampler);
+    cmd->object             = &sampler;
+    cmd->slot               = slot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+void DeferredCommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdResource>(Opcode::SetSamplerArray);
+    cmd->object             = &samplerArray;
+    cmd->slot               = startSlot;
+    cmd->shaderStageFlags   = shaderStageFlags;
+}
+
+/* ----- Resource Heaps ----- */
+
+void DeferredCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetResourceHeap);
+    cmd->object = &resourceHeap;
+}
+
+/* ----- Render Targets ----- */
+
+void DeferredCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetRenderTarget);
+    cmd->object = &renderTarget;
+}
+
+void DeferredCommandBuffer::SetRenderTarget(RenderContext& renderContext)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetRenderContext);
+    cmd->object = &renderContext;
+}
+
+/* ----- Render Passes ----- */
+
+void DeferredCommandBuffer::BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc)
+{
+    RecordRenderPass(Opcode::BeginRenderPass, &renderTarget, renderPassDesc);
+}
+
+void DeferredCommandBuffer::BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc)
+{
+    RecordRenderPass(Opcode::BeginRenderPassContext, &renderContext, renderPassDesc);
+}
+
+void DeferredCommandBuffer::EndRenderPass()
+{
+    AllocCommand<DeferredCmdCount>(Opcode::EndRenderPass);
+}
+
+/* ----- Pipeline States ----- */
+
+void DeferredCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetGraphicsPipeline);
+    cmd->object = &graphicsPipeline;
+}
+
+void DeferredCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::SetComputePipeline);
+    cmd->object = &computePipeline;
+}
+
+void DeferredCommandBuffer::SetPushConstants(unsigned int offset, unsigned int size, const void* data)
+{
+    auto cmd = AllocCommand<DeferredCmdPushConstants>(Opcode::SetPushConstants, size);
+    cmd->offset = offset;
+    cmd->size   = size;
+    ::memcpy(cmd + 1, data, size);
+}
+
+void DeferredCommandBuffer::SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances)
+{
+    auto cmd = AllocCommand<DeferredCmdClassInstances>(Opcode::SetShaderClassInstances, sizeof(int) * numSlots);
+    cmd->stage      = stage;
+    cmd->numSlots   = numSlots;
+    ::memcpy(cmd + 1, classInstances, sizeof(int) * numSlots);
+}
+
+/* ----- Queries ----- */
+
+void DeferredCommandBuffer::BeginQuery(Query& query)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::BeginQuery);
+    cmd->object = &query;
+}
+
+void DeferredCommandBuffer::EndQuery(Query& query)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::EndQuery);
+    cmd->object = &query;
+}
+
+// Query results cannot be recorded, so they are never available to deferred command buffers (see CommandBuffer::QueryResult)
+bool DeferredCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
+{
+    return false;
+}
+
+bool DeferredCommandBuffer::QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results)
+{
+    return false;
+}
+
+bool DeferredCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    return false;
+}
+
+void DeferredCommandBuffer::ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset)
+{
+    auto cmd = AllocCommand<DeferredCmdResolveQueryData>(Opcode::ResolveQueryData);
+    cmd->queryArray = &queryArray;
+    cmd->firstQuery = firstQuery;
+    cmd->numQueries = numQueries;
+    cmd->dstBuffer  = &dstBuffer;
+    cmd->dstOffset  = dstOffset;
+}
+
+void DeferredCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
+{
+    auto cmd = AllocCommand<DeferredCmdRenderCondition>(Opcode::BeginRenderCondition);
+    cmd->query  = &query;
+    cmd->mode   = mode;
+}
+
+void DeferredCommandBuffer::EndRenderCondition()
+{
+    AllocCommand<DeferredCmdCount>(Opcode::EndRenderCondition);
+}
+
+/* ----- Copy ----- */
+
+void DeferredCommandBuffer::CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size)
+{
+    auto cmd = AllocCommand<DeferredCmdCopyBuffer>(Opcode::CopyBuffer);
+    cmd->dstBuffer  = &dstBuffer;
+    cmd->dstOffset  = dstOffset;
+    cmd->srcBuffer  = &srcBuffer;
+    cmd->srcOffset  = srcOffset;
+    cmd->size       = size;
+}
+
+void DeferredCommandBuffer::CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto cmd = AllocCommand<DeferredCmdCopyTexture>(Opcode::CopyTexture);
+    cmd->dstTexture     = &dstTexture;
+    cmd->dstMipLevel    = dstMipLevel;
+    cmd->dstOffset      = dstOffset;
+    cmd->srcTexture     = &srcTexture;
+    cmd->srcRegion      = srcRegion;
+}
+
+void DeferredCommandBuffer::ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto cmd = AllocCommand<DeferredCmdCopyTexture>(Opcode::ResolveTexture);
+    cmd->dstTexture     = &dstTexture;
+    cmd->dstMipLevel    = dstMipLevel;
+    cmd->dstOffset      = dstOffset;
+    cmd->srcTexture     = &srcTexture;
+    cmd->srcRegion      = srcRegion;
+}
+
+void DeferredCommandBuffer::CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType)
+{
+    auto cmd = AllocCommand<DeferredCmdCopyBufferToTexture>(Opcode::CopyBufferToTexture);
+    cmd->dstTexture     = &dstTexture;
+    cmd->dstRegion      = dstRegion;
+    cmd->srcBuffer      = &srcBuffer;
+    cmd->srcOffset      = srcOffset;
+    cmd->imageFormat    = imageFormat;
+    cmd->dataType       = dataType;
+}
+
+/* ----- Drawing ----- */
+
+void DeferredCommandBuffer::Draw(unsigned int numVertices, unsigned int firstVertex)
+{
+    auto cmd = AllocCommand<DeferredCmdDraw>(Opcode::Draw);
+    cmd->numVertices    = numVertices;
+    cmd->first          = firstVertex;
+}
+
+void DeferredCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex)
+{
+    auto cmd = AllocCommand<DeferredCmdDraw>(Opcode::DrawIndexed);
+    cmd->numVertices    = numVertices;
+    cmd->first          = firstIndex;
+}
+
+void DeferredCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex, int vertexOffset)
+{
+    auto cmd = AllocCommand<DeferredCmdDraw>(Opcode::DrawIndexedOffset);
+    cmd->numVertices    = numVertices;
+    cmd->first          = firstIndex;
+    cmd->vertexOffset   = vertexOffset;
+}
+
+void DeferredCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances)
+{
+    auto cmd = AllocCommand<DeferredCmdDraw>(Opcode::DrawInstanced);
+    cmd->numVertices    = numVertices;
+    cmd->first          = firstVertex;
+    cmd->numInstances   = numInstances;
+}
+
+void DeferredCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset)
+{
+    auto cmd = AllocCommand<DeferredCmdDraw>(Opcode::DrawInstancedOffset);
+    cmd->numVertices    = numVertices;
+    cmd->first          = firstVertex;
+    cmd->numInstances   = numInstances;
+    cmd->instanceOffset = instanceOffset;
+}
+
+void DeferredCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex)
+{
+    auto cmd = AllocCommand<DeferredCmdDraw>(Opcode::DrawIndexedInstanced);
+    cmd->numVertices    = numVertices;
+    cmd->first          = firstIndex;
+    cmd->numInstances   = numInstances;
+}
+
+void DeferredCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset)
+{
+    auto cmd = AllocCommand<DeferredCmdDraw>(Opcode::DrawIndexedInstancedVertexOffset);
+    cmd->numVertices    = numVertices;
+    cmd->first          = firstIndex;
+    cmd->numInstances   = numInstances;
+    cmd->vertexOffset   = vertexOffset;
+}
+
+void DeferredCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset)
+{
+    auto cmd = AllocCommand<DeferredCmdDraw>(Opcode::DrawIndexedInstancedOffset);
+    cmd->numVertices    = numVertices;
+    cmd->first          = firstIndex;
+    cmd->numInstances   = numInstances;
+    cmd->vertexOffset   = vertexOffset;
+    cmd->instanceOffset = instanceOffset;
+}
+
+void DeferredCommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset)
+{
+    RecordIndirect(Opcode::DrawIndirect, buffer, offset, 1, 0);
+}
+
+void DeferredCommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    RecordIndirect(Opcode::DrawIndirectMulti, buffer, offset, numCommands, stride);
+}
+
+void DeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset)
+{
+    RecordIndirect(Opcode::DrawIndexedIndirect, buffer, offset, 1, 0);
+}
+
+void DeferredCommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    RecordIndirect(Opcode::DrawIndexedIndirectMulti, buffer, offset, numCommands, stride);
+}
+
+void DeferredCommandBuffer::DrawStreamOutput()
+{
+    AllocCommand<DeferredCmdCount>(Opcode::DrawStreamOutput);
+}
+
+void DeferredCommandBuffer::DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ)
+{
+    /* Mesh tasks share the payload layout of compute dispatches */
+    auto cmd = AllocCommand<DeferredCmdDispatch>(Opcode::DrawMeshTasks);
+    cmd->groupSizeX = numTasksX;
+    cmd->groupSizeY = numTasksY;
+    cmd->groupSizeZ = numTasksZ;
+}
+
+/* ----- Compute ----- */
+
+void DeferredCommandBuffer::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ)
+{
+    auto cmd = AllocCommand<DeferredCmdDispatch>(Opcode::Dispatch);
+    cmd->groupSizeX = groupSizeX;
+    cmd->groupSizeY = groupSizeY;
+    cmd->groupSizeZ = groupSizeZ;
+}
+
+void DeferredCommandBuffer::DispatchIndirect(Buffer& buffer, unsigned int offset)
+{
+    RecordIndirect(Opcode::DispatchIndirect, buffer, offset, 1, 0);
+}
+
+void DeferredCommandBuffer::Barrier(long barrierFlags)
+{
+    auto cmd = AllocCommand<DeferredCmdValue>(Opcode::Barrier);
+    cmd->flags = barrierFlags;
+}
+
+void DeferredCommandBuffer::StorageBarrier(Buffer& buffer)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::StorageBarrier);
+    cmd->object = &buffer;
+}
+
+/* ----- Command Recording ----- */
+
+void DeferredCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    if (&deferredCommandBuffer == this)
+        throw std::invalid_argument("cannot record execution of deferred command buffer into itself");
+
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::Execute);
+    cmd->object = LLGL_CAST(DeferredCommandBuffer*, &deferredCommandBuffer);
+}
+
+void DeferredCommandBuffer::Reset()
+{
+    /* Clear command stream but keep its capacity for the next recording */
+    buffer_.clear();
+}
+
+/* ----- Misc ----- */
+
+void DeferredCommandBuffer::Signal(Fence& fence)
+{
+    auto cmd = AllocCommand<DeferredCmdObject>(Opcode::Signal);
+    cmd->object = &fence;
+}
+
+void DeferredCommandBuffer::SyncGPU()
+{
+    AllocCommand<DeferredCmdCount>(Opcode::SyncGPU);
+}
+
+/* ----- Extended functions ----- */
+
+void DeferredCommandBuffer::Replay(CommandBuffer& commandBuffer) const
+{
+    auto byteCode       = buffer_.data();
+    auto byteCodeEnd    = byteCode + buffer_.size();
+
+    while (byteCode < byteCodeEnd)
+    {
+        auto header = reinterpret_cast<const DeferredCmdHeader*>(byteCode);
+        auto data   = reinterpret_cast<const void*>(header + 1);
+
+        switch (static_cast<Opcode>(header->opcode))
+        {
+            /* ----- Configuration ----- */
+
+            case Opcode::SetGraphicsAPIDependentState:
+                commandBuffer.SetGraphicsAPIDependentState(*reinterpret_cast<const GraphicsAPIDependentStateDescriptor*>(data));
+                break;
+
+            case Opcode::SetViewport:
+                commandBuffer.SetViewport(*reinterpret_cast<const Viewport*>(data));
+                break;
+
+            case Opcode::SetViewportArray:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdCount*>(data);
+                commandBuffer.SetViewportArray(cmd->count, reinterpret_cast<const Viewport*>(GetCommandPayload(cmd)));
+            }
+            break;
+
+            case Opcode::SetScissor:
+                commandBuffer.SetScissor(*reinterpret_cast<const Scissor*>(data));
+                break;
+
+            case Opcode::SetScissorArray:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdCount*>(data);
+                commandBuffer.SetScissorArray(cmd->count, reinterpret_cast<const Scissor*>(GetCommandPayload(cmd)));
+            }
+            break;
+
+            case Opcode::SetShadingRate:
+                commandBuffer.SetShadingRate(reinterpret_cast<const DeferredCmdValue*>(data)->shadingRate);
+                break;
+
+            case Opcode::SetShadingRateImage:
+                commandBuffer.SetShadingRateImage(reinterpret_cast<Texture*>(reinterpret_cast<const DeferredCmdObject*>(data)->object));
+                break;
+
+            case Opcode::SetDepthBounds:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDepthBounds*>(data);
+                commandBuffer.SetDepthBounds(cmd->minDepth, cmd->maxDepth);
+            }
+            break;
+
+            case Opcode::SetClearColor:
+                commandBuffer.SetClearColor(reinterpret_cast<const DeferredCmdColor*>(data)->color);
+                break;
+
+            case Opcode::SetClearDepth:
+                commandBuffer.SetClearDepth(reinterpret_cast<const DeferredCmdValue*>(data)->depth);
+                break;
+
+            case Opcode::SetClearStencil:
+                commandBuffer.SetClearStencil(reinterpret_cast<const DeferredCmdValue*>(data)->stencil);
+                break;
+
+            case Opcode::Clear:
+                commandBuffer.Clear(reinterpret_cast<const DeferredCmdValue*>(data)->flags);
+                break;
+
+            case Opcode::ClearTarget:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdClearTarget*>(data);
+                commandBuffer.ClearTarget(cmd->targetIndex, cmd->color);
+            }
+            break;
+
+            /* ----- Buffers ------ */
+
+            case Opcode::SetVertexBuffer:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdObjectOffset*>(data);
+                commandBuffer.SetVertexBuffer(GetObjectRef<Buffer>(cmd), cmd->offset);
+            }
+            break;
+
+            case Opcode::SetVertexBufferArray:
+                commandBuffer.SetVertexBufferArray(GetObjectRef<BufferArray>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::SetIndexBuffer:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdObjectOffset*>(data);
+                commandBuffer.SetIndexBuffer(GetObjectRef<Buffer>(cmd), cmd->offset);
+            }
+            break;
+
+            case Opcode::SetConstantBuffer:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResource*>(data);
+                commandBuffer.SetConstantBuffer(GetObjectRef<Buffer>(cmd), cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            case Opcode::SetConstantBufferArray:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResource*>(data);
+                commandBuffer.SetConstantBufferArray(GetObjectRef<BufferArray>(cmd), cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            case Opcode::SetConstantBufferRange:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResourceRange*>(data);
+                commandBuffer.SetConstantBufferRange(GetObjectRef<Buffer>(cmd), cmd->offset, cmd->size, cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            case Opcode::SetStorageBuffer:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResource*>(data);
+                commandBuffer.SetStorageBuffer(GetObjectRef<Buffer>(cmd), cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            case Opcode::SetStorageBufferArray:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResource*>(data);
+                commandBuffer.SetStorageBufferArray(GetObjectRef<BufferArray>(cmd), cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            case Opcode::ResetBufferCounter:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResetBufferCounter*>(data);
+                commandBuffer.ResetBufferCounter(*(cmd->buffer), cmd->value);
+            }
+            break;
+
+            case Opcode::CopyBufferCounter:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdCopyBufferCounter*>(data);
+                commandBuffer.CopyBufferCounter(*(cmd->dstBuffer), cmd->dstOffset, *(cmd->srcBuffer));
+            }
+            break;
+
+            case Opcode::SetStreamOutputBuffer:
+                commandBuffer.SetStreamOutputBuffer(GetObjectRef<Buffer>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::SetStreamOutputBufferArray:
+                commandBuffer.SetStreamOutputBufferArray(GetObjectRef<BufferArray>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::BeginStreamOutput:
+                commandBuffer.BeginStreamOutput(*reinterpret_cast<const PrimitiveType*>(data));
+                break;
+
+            case Opcode::EndStreamOutput:
+                commandBuffer.EndStreamOutput();
+                break;
+
+            case Opcode::PauseStreamOutput:
+                commandBuffer.PauseStreamOutput();
+                break;
+
+            case Opcode::ResumeStreamOutput:
+                commandBuffer.ResumeStreamOutput();
+                break;
+
+            /* ----- Textures ----- */
+
+            case Opcode::SetTexture:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResource*>(data);
+                commandBuffer.SetTexture(GetObjectRef<Texture>(cmd), cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            case Opcode::SetTextureArray:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResource*>(data);
+                commandBuffer.SetTextureArray(GetObjectRef<TextureArray>(cmd), cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            /* ----- Sampler States ----- */
+
+            case Opcode::SetSampler:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResource*>(data);
+                commandBuffer.SetSampler(GetObjectRef<Sampler>(cmd), cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            case Opcode::SetSamplerArray:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResource*>(data);
+                commandBuffer.SetSamplerArray(GetObjectRef<SamplerArray>(cmd), cmd->slot, cmd->shaderStageFlags);
+            }
+            break;
+
+            /* ----- Resource Heaps ----- */
+
+            case Opcode::SetResourceHeap:
+                commandBuffer.SetResourceHeap(GetObjectRef<ResourceHeap>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            /* ----- Render Targets ----- */
+
+            case Opcode::SetRenderTarget:
+                commandBuffer.SetRenderTarget(GetObjectRef<RenderTarget>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::SetRenderContext:
+                commandBuffer.SetRenderTarget(GetObjectRef<RenderContext>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            /* ----- Render Passes ----- */
+
+            case Opcode::BeginRenderPass:
+            case Opcode::BeginRenderPassContext:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdRenderPass*>(data);
+                auto colorAttachments = reinterpret_cast<const RenderPassAttachmentDescriptor*>(GetCommandPayload(cmd));
+
+                RenderPassDescriptor renderPassDesc;
+                {
+                    renderPassDesc.colorAttachments.assign(colorAttachments, colorAttachments + cmd->numColorAttachments);
+                    renderPassDesc.depthAttachment      = cmd->depthAttachment;
+                    renderPassDesc.stencilAttachment    = cmd->stencilAttachment;
+                }
+
+                if (static_cast<Opcode>(header->opcode) == Opcode::BeginRenderPass)
+                    commandBuffer.BeginRenderPass(GetObjectRef<RenderTarget>(cmd), renderPassDesc);
+                else
+                    commandBuffer.BeginRenderPass(GetObjectRef<RenderContext>(cmd), renderPassDesc);
+            }
+            break;
+
+            case Opcode::EndRenderPass:
+                commandBuffer.EndRenderPass();
+                break;
+
+            /* ----- Pipeline States ----- */
+
+            case Opcode::SetGraphicsPipeline:
+                commandBuffer.SetGraphicsPipeline(GetObjectRef<GraphicsPipeline>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::SetComputePipeline:
+                commandBuffer.SetComputePipeline(GetObjectRef<ComputePipeline>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::SetPushConstants:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdPushConstants*>(data);
+                commandBuffer.SetPushConstants(cmd->offset, cmd->size, GetCommandPayload(cmd));
+            }
+            break;
+
+            case Opcode::SetShaderClassInstances:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdClassInstances*>(data);
+                commandBuffer.SetShaderClassInstances(cmd->stage, cmd->numSlots, reinterpret_cast<const int*>(GetCommandPayload(cmd)));
+            }
+            break;
+
+            /* ----- Queries ----- */
+
+            case Opcode::BeginQuery:
+                commandBuffer.BeginQuery(GetObjectRef<Query>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::EndQuery:
+                commandBuffer.EndQuery(GetObjectRef<Query>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::ResolveQueryData:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdResolveQueryData*>(data);
+                commandBuffer.ResolveQueryData(*(cmd->queryArray), cmd->firstQuery, cmd->numQueries, *(cmd->dstBuffer), cmd->dstOffset);
+            }
+            break;
+
+            case Opcode::BeginRenderCondition:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdRenderCondition*>(data);
+                commandBuffer.BeginRenderCondition(*(cmd->query), cmd->mode);
+            }
+            break;
+
+            case Opcode::EndRenderCondition:
+                commandBuffer.EndRenderCondition();
+                break;
+
+            /* ----- Copy ----- */
+
+            case Opcode::CopyBuffer:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdCopyBuffer*>(data);
+                commandBuffer.CopyBuffer(*(cmd->dstBuffer), cmd->dstOffset, *(cmd->srcBuffer), cmd->srcOffset, cmd->size);
+            }
+            break;
+
+            case Opcode::CopyTexture:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdCopyTexture*>(data);
+                commandBuffer.CopyTexture(*(cmd->dstTexture), cmd->dstMipLevel, cmd->dstOffset, *(cmd->srcTexture), cmd->srcRegion);
+            }
+            break;
+
+            case Opcode::ResolveTexture:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdCopyTexture*>(data);
+                commandBuffer.ResolveTexture(*(cmd->dstTexture), cmd->dstMipLevel, cmd->dstOffset, *(cmd->srcTexture), cmd->srcRegion);
+            }
+            break;
+
+            case Opcode::CopyBufferToTexture:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdCopyBufferToTexture*>(data);
+                commandBuffer.CopyBufferToTexture(*(cmd->dstTexture), cmd->dstRegion, *(cmd->srcBuffer), cmd->srcOffset, cmd->imageFormat, cmd->dataType);
+            }
+            break;
+
+            /* ----- Drawing ----- */
+
+            case Opcode::Draw:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDraw*>(data);
+                commandBuffer.Draw(cmd->numVertices, cmd->first);
+            }
+            break;
+
+            case Opcode::DrawIndexed:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDraw*>(data);
+                commandBuffer.DrawIndexed(cmd->numVertices, cmd->first);
+            }
+            break;
+
+            case Opcode::DrawIndexedOffset:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDraw*>(data);
+                commandBuffer.DrawIndexed(cmd->numVertices, cmd->first, cmd->vertexOffset);
+            }
+            break;
+
+            case Opcode::DrawInstanced:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDraw*>(data);
+                commandBuffer.DrawInstanced(cmd->numVertices, cmd->first, cmd->numInstances);
+            }
+            break;
+
+            case Opcode::DrawInstancedOffset:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDraw*>(data);
+                commandBuffer.DrawInstanced(cmd->numVertices, cmd->first, cmd->numInstances, cmd->instanceOffset);
+            }
+            break;
+
+            case Opcode::DrawIndexedInstanced:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDraw*>(data);
+                commandBuffer.DrawIndexedInstanced(cmd->numVertices, cmd->numInstances, cmd->first);
+            }
+            break;
+
+            case Opcode::DrawIndexedInstancedVertexOffset:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDraw*>(data);
+                commandBuffer.DrawIndexedInstanced(cmd->numVertices, cmd->numInstances, cmd->first, cmd->vertexOffset);
+            }
+            break;
+
+            case Opcode::DrawIndexedInstancedOffset:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDraw*>(data);
+                commandBuffer.DrawIndexedInstanced(cmd->numVertices, cmd->numInstances, cmd->first, cmd->vertexOffset, cmd->instanceOffset);
+            }
+            break;
+
+            case Opcode::DrawIndirect:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdIndirect*>(data);
+                commandBuffer.DrawIndirect(GetObjectRef<Buffer>(cmd), cmd->offset);
+            }
+            break;
+
+            case Opcode::DrawIndirectMulti:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdIndirect*>(data);
+                commandBuffer.DrawIndirect(GetObjectRef<Buffer>(cmd), cmd->offset, cmd->numCommands, cmd->stride);
+            }
+            break;
+
+            case Opcode::DrawIndexedIndirect:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdIndirect*>(data);
+                commandBuffer.DrawIndexedIndirect(GetObjectRef<Buffer>(cmd), cmd->offset);
+            }
+            break;
+
+            case Opcode::DrawIndexedIndirectMulti:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdIndirect*>(data);
+                commandBuffer.DrawIndexedIndirect(GetObjectRef<Buffer>(cmd), cmd->offset, cmd->numCommands, cmd->stride);
+            }
+            break;
+
+            case Opcode::DrawStreamOutput:
+                commandBuffer.DrawStreamOutput();
+                break;
+
+            case Opcode::DrawMeshTasks:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDispatch*>(data);
+                commandBuffer.DrawMeshTasks(cmd->groupSizeX, cmd->groupSizeY, cmd->groupSizeZ);
+            }
+            break;
+
+            /* ----- Compute ----- */
+
+            case Opcode::Dispatch:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdDispatch*>(data);
+                commandBuffer.Dispatch(cmd->groupSizeX, cmd->groupSizeY, cmd->groupSizeZ);
+            }
+            break;
+
+            case Opcode::DispatchIndirect:
+            {
+                auto cmd = reinterpret_cast<const DeferredCmdIndirect*>(data);
+                commandBuffer.DispatchIndirect(GetObjectRef<Buffer>(cmd), cmd->offset);
+            }
+            break;
+
+            case Opcode::Barrier:
+                commandBuffer.Barrier(reinterpret_cast<const DeferredCmdValue*>(data)->flags);
+                break;
+
+            case Opcode::StorageBarrier:
+                commandBuffer.StorageBarrier(GetObjectRef<Buffer>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            /* ----- Command Recording ----- */
+
+            case Opcode::Execute:
+                commandBuffer.Execute(GetObjectRef<DeferredCommandBuffer>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            /* ----- Misc ----- */
+
+            case Opcode::Signal:
+                commandBuffer.Signal(GetObjectRef<Fence>(reinterpret_cast<const DeferredCmdObject*>(data)));
+                break;
+
+            case Opcode::SyncGPU:
+                commandBuffer.SyncGPU();
+                break;
+        }
+
+        byteCode += header->size;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
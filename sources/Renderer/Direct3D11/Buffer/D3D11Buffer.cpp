@@ -9,12 +9,16 @@
 #include "../D3D11Types.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../../Core/Helper.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+// Number of rotating staging buffers for deferred mappings, i.e. the maximum number of frames the CPU can run ahead of the copies
+static const std::size_t g_numStagingCopies = 3;
+
 D3D11Buffer::D3D11Buffer(const BufferType type) :
     Buffer { type }
 {
@@ -39,7 +43,7 @@ void D3D11Buffer::UpdateSubresource(ID3D11DeviceContext* context, const void* da
 
 static bool HasReadAccess(const BufferCPUAccess access)
 {
-    return (access != BufferCPUAccess::WriteOnly);
+    return (access == BufferCPUAccess::ReadOnly || access == BufferCPUAccess::ReadWrite);
 }
 
 static bool HasWriteAccess(const BufferCPUAccess access)
@@ -48,38 +52,127 @@ static bool HasWriteAccess(const BufferCPUAccess access)
 }
 
 void* D3D11Buffer::Map(ID3D11DeviceContext* context, const BufferCPUAccess access)
+{
+    return Map(context, access, 0, size_, false);
+}
+
+void* D3D11Buffer::Map(ID3D11DeviceContext* context, const BufferCPUAccess access, UINT offset, UINT size, bool flushExplicit)
 {
     HRESULT hr = 0;
     D3D11_MAPPED_SUBRESOURCE mapppedSubresource;
 
+    mappedOffset_   = offset;
+    mappedSize_     = size;
+    flushExplicit_  = flushExplicit;
+    flushBegin_     = 0;
+    flushEnd_       = 0;
+
     if (cpuAccessBuffer_)
     {
-        /* On read access -> copy storage buffer to CPU-access buffer */
+        /* On read access -> copy mapped range of storage buffer to CPU-access buffer */
         if (HasReadAccess(access))
-            context->CopyResource(cpuAccessBuffer_.Get(), Get());
+            CopyCPUAccessBufferRange(context, offset, size, true);
 
         /* Map CPU-access buffer */
         hr = context->Map(cpuAccessBuffer_.Get(), 0, D3D11Types::Map(access), 0, &mapppedSubresource);
     }
     else
     {
-        /* Map buffer */
+        /* Map buffer (D3D11 can only map entire buffers) */
         hr = context->Map(Get(), 0, D3D11Types::Map(access), 0, &mapppedSubresource);
     }
 
-    return (SUCCEEDED(hr) ? mapppedSubresource.pData : nullptr);
+    return (SUCCEEDED(hr) ? reinterpret_cast<char*>(mapppedSubresource.pData) + offset : nullptr);
+}
+
+void D3D11Buffer::FlushMappedRange(UINT offset, UINT size)
+{
+    /* Accumulate flushed ranges, which are written back to the storage buffer when it is unmapped */
+    auto begin  = mappedOffset_ + offset;
+    auto end    = begin + size;
+
+    if (flushBegin_ == flushEnd_)
+    {
+        flushBegin_ = begin;
+        flushEnd_   = end;
+    }
+    else
+    {
+        flushBegin_ = std::min(flushBegin_, begin);
+        flushEnd_   = std::max(flushEnd_, end);
+    }
+}
+
+// Returns true if the copy into the specified staging buffer has been completed, without flushing the command queue.
+static bool IsStagingCopyCompleted(ID3D11DeviceContext* context, ID3D11Query* event)
+{
+    return (context->GetData(event, nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK);
+}
+
+void* D3D11Buffer::MapDeferred(ID3D11DeviceContext* context, UINT offset)
+{
+    if (stagingRing_.empty() && !CreateStagingRing())
+        return nullptr;
+
+    /* Find the most recent copy that has been completed */
+    D3D11StagingCopy* latest = nullptr;
+    for (auto& staging : stagingRing_)
+    {
+        if (staging.copyIndex != 0 && (latest == nullptr || staging.copyIndex > latest->copyIndex))
+        {
+            if (IsStagingCopyCompleted(context, staging.event.Get()))
+                latest = &staging;
+        }
+    }
+
+    /*
+    Schedule a new copy into the next staging buffer, unless it holds the copy that is about to be mapped
+    or its previous copy is still in flight (the GPU is more than the entire ring behind)
+    */
+    auto& next = stagingRing_[stagingRingIndex_];
+    if (&next != latest && (next.copyIndex == 0 || IsStagingCopyCompleted(context, next.event.Get())))
+    {
+        context->CopyResource(next.buffer.Get(), Get());
+        context->End(next.event.Get());
+        next.copyIndex      = ++numStagingCopies_;
+        stagingRingIndex_   = (stagingRingIndex_ + 1) % stagingRing_.size();
+    }
+
+    if (latest == nullptr)
+        return nullptr;
+
+    /* Map completed copy, which does not wait for the GPU */
+    D3D11_MAPPED_SUBRESOURCE mapppedSubresource;
+    auto hr = context->Map(latest->buffer.Get(), 0, D3D11_MAP_READ, 0, &mapppedSubresource);
+    if (FAILED(hr))
+        return nullptr;
+
+    mappedStaging_ = latest->buffer.Get();
+
+    return (reinterpret_cast<char*>(mapppedSubresource.pData) + offset);
 }
 
 void D3D11Buffer::Unmap(ID3D11DeviceContext* context, const BufferCPUAccess access)
 {
-    if (cpuAccessBuffer_)
+    if (mappedStaging_ != nullptr)
+    {
+        /* Unmap staging buffer of a deferred mapping */
+        context->Unmap(mappedStaging_, 0);
+        mappedStaging_ = nullptr;
+    }
+    else if (cpuAccessBuffer_)
     {
         /* Unmap CPU-access buffer */
         context->Unmap(cpuAccessBuffer_.Get(), 0);
 
-        /* On write access -> copy CPU-access buffer to storage buffer */
+        /* On write access -> copy mapped range (or only the flushed ranges) of CPU-access buffer to storage buffer */
         if (HasWriteAccess(access))
-            context->CopyResource(Get(), cpuAccessBuffer_.Get());
+        {
+            if (!flushExplicit_)
+                CopyCPUAccessBufferRange(context, mappedOffset_, mappedSize_, false);
+            else if (flushBegin_ < flushEnd_)
+                CopyCPUAccessBufferRange(context, flushBegin_, flushEnd_ - flushBegin_, false);
+        }
     }
     else
     {
@@ -116,10 +209,18 @@ void D3D11Buffer::CreateResource(ID3D11Device* device, const D3D11_BUFFER_DESC&
         subresourceData.pSysMem = initialData;
     }
 
+    /* Allow buffer to be used for indirect arguments (if required) */
+    auto bufferDesc = desc;
+
+    if ((bufferFlags & BufferFlags::IndirectArguments) != 0)
+        bufferDesc.MiscFlags |= D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+
     /* Create new D3D11 hardware buffer */
-    auto hr = device->CreateBuffer(&desc, (initialData != nullptr ? &subresourceData : nullptr), buffer_.ReleaseAndGetAddressOf());
+    auto hr = device->CreateBuffer(&bufferDesc, (initialData != nullptr ? &subresourceData : nullptr), buffer_.ReleaseAndGetAddressOf());
     DXThrowIfFailed(hr, "failed to create D3D11 buffer");
 
+    size_ = bufferDesc.ByteWidth;
+
     /* Create CPU access buffer (if required) */
     auto cpuAccessFlags = GetCPUAccessFlags(bufferFlags);
     if (cpuAccessFlags != 0)
@@ -153,6 +254,71 @@ void D3D11Buffer::CreateCPUAccessBuffer(ID3D11Device* device, const D3D11_BUFFER
     DXThrowIfFailed(hr, "failed to create D3D11 CPU-access buffer for storage buffer");
 }
 
+bool D3D11Buffer::CreateStagingRing()
+{
+    ComPtr<ID3D11Device> device;
+    buffer_->GetDevice(device.GetAddressOf());
+
+    D3D11_BUFFER_DESC desc;
+    {
+        desc.ByteWidth              = size_;
+        desc.Usage                  = D3D11_USAGE_STAGING;
+        desc.BindFlags              = 0;
+        desc.CPUAccessFlags         = D3D11_CPU_ACCESS_READ;
+        desc.MiscFlags              = 0;
+        desc.StructureByteStride    = 0;
+    }
+
+    D3D11_QUERY_DESC queryDesc;
+    {
+        queryDesc.Query     = D3D11_QUERY_EVENT;
+        queryDesc.MiscFlags = 0;
+    }
+
+    stagingRing_.resize(g_numStagingCopies);
+
+    for (auto& staging : stagingRing_)
+    {
+        auto hr = device->CreateBuffer(&desc, nullptr, staging.buffer.ReleaseAndGetAddressOf());
+        if (DXReportIfFailed(hr, "failed to create D3D11 staging buffer for deferred mapping"))
+            break;
+
+        hr = device->CreateQuery(&queryDesc, staging.event.ReleaseAndGetAddressOf());
+        if (DXReportIfFailed(hr, "failed to create D3D11 event query for deferred mapping"))
+            break;
+    }
+
+    /* Try again with the next deferred mapping if the ring could not be created entirely */
+    if (!stagingRing_.back().event)
+    {
+        stagingRing_.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void D3D11Buffer::CopyCPUAccessBufferRange(ID3D11DeviceContext* context, UINT offset, UINT size, bool toCPUAccessBuffer)
+{
+    if (offset == 0 && size == size_)
+    {
+        /* Copy entire resource */
+        if (toCPUAccessBuffer)
+            context->CopyResource(cpuAccessBuffer_.Get(), Get());
+        else
+            context->CopyResource(Get(), cpuAccessBuffer_.Get());
+    }
+    else
+    {
+        /* Copy range only, which is at the same offset in both buffers */
+        CD3D11_BOX srcBox(offset, 0, 0, offset + size, 1, 1);
+        if (toCPUAccessBuffer)
+            context->CopySubresourceRegion(cpuAccessBuffer_.Get(), 0, offset, 0, 0, Get(), 0, &srcBox);
+        else
+            context->CopySubresourceRegion(Get(), 0, offset, 0, 0, cpuAccessBuffer_.Get(), 0, &srcBox);
+    }
+}
+
 
 } // /namespace LLGL
 
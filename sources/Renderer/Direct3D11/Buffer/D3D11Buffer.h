@@ -12,6 +12,7 @@
 #include <LLGL/Buffer.h>
 #include "../../DXCommon/ComPtr.h"
 #include <d3d11.h>
+#include <vector>
 
 
 namespace LLGL
@@ -30,8 +31,20 @@ class D3D11Buffer : public Buffer
         virtual void UpdateSubresource(ID3D11DeviceContext* context, const void* data);
 
         void* Map(ID3D11DeviceContext* context, const BufferCPUAccess access);
+        void* Map(ID3D11DeviceContext* context, const BufferCPUAccess access, UINT offset, UINT size, bool flushExplicit);
+        void FlushMappedRange(UINT offset, UINT size);
+
+        // Schedules a copy of the entire buffer into the next staging buffer and maps the most recent completed copy, or returns null if there is none yet.
+        void* MapDeferred(ID3D11DeviceContext* context, UINT offset);
+
         void Unmap(ID3D11DeviceContext* context, const BufferCPUAccess access);
 
+        //! Returns the size (in bytes) of the hardware buffer.
+        inline UINT GetSize() const
+        {
+            return size_;
+        }
+
         //! Returns the ID3D11Buffer object.
         inline ID3D11Buffer* Get() const
         {
@@ -46,8 +59,32 @@ class D3D11Buffer : public Buffer
 
         void CreateCPUAccessBuffer(ID3D11Device* device, const D3D11_BUFFER_DESC& gpuBufferDesc, UINT cpuAccessFlags);
 
-        ComPtr<ID3D11Buffer> buffer_;
-        ComPtr<ID3D11Buffer> cpuAccessBuffer_;
+        void CopyCPUAccessBufferRange(ID3D11DeviceContext* context, UINT offset, UINT size, bool toCPUAccessBuffer);
+
+        bool CreateStagingRing();
+
+        // Staging buffer for deferred mappings with the event query that is signaled when the copy has been completed.
+        struct D3D11StagingCopy
+        {
+            ComPtr<ID3D11Buffer>    buffer;
+            ComPtr<ID3D11Query>     event;
+            UINT64                  copyIndex   = 0; // 0 if the staging buffer has not received a copy yet
+        };
+
+        ComPtr<ID3D11Buffer>    buffer_;
+        ComPtr<ID3D11Buffer>    cpuAccessBuffer_;
+        UINT                    size_           = 0;
+
+        UINT                    mappedOffset_   = 0;
+        UINT                    mappedSize_     = 0;
+        bool                    flushExplicit_  = false;
+        UINT                    flushBegin_     = 0;
+        UINT                    flushEnd_       = 0;
+
+        std::vector<D3D11StagingCopy>   stagingRing_;               // only created with the first deferred mapping
+        std::size_t                     stagingRingIndex_   = 0;
+        UINT64                          numStagingCopies_   = 0;
+        ID3D11Buffer*                   mappedStaging_      = nullptr;
 
 };
 
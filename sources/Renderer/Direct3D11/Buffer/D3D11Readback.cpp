@@ -0,0 +1,188 @@
+/*
+ * D3D11Readback.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11Readback.h"
+#include "D3D11Buffer.h"
+#include "../D3D11Types.h"
+#include "../../DXCommon/DXCore.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+D3D11Readback::D3D11Readback(ID3D11Device* device, ID3D11DeviceContext* context, std::size_t dataSize) :
+    Readback { dataSize },
+    device_  { device   },
+    context_ { context  }
+{
+}
+
+bool D3D11Readback::IsReady()
+{
+    if (event_)
+    {
+        /* Poll event query without flushing the command queue */
+        return (context_->GetData(event_.Get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK);
+    }
+    return true;
+}
+
+void D3D11Readback::ReadData(void* buffer, std::size_t bufferSize)
+{
+    /* Map staging resource for reading (this blocks until the copy command has been completed) */
+    auto resource = (stagingBuffer_ ? static_cast<ID3D11Resource*>(stagingBuffer_.Get()) : stagingTexture_.resource.Get());
+
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+    auto hr = context_->Map(resource, 0, D3D11_MAP_READ, 0, &mappedSubresource);
+    DXThrowIfFailed(hr, "failed to map D3D11 readback resource");
+
+    if (stagingBuffer_)
+        ::memcpy(buffer, mappedSubresource.pData, std::min(bufferSize, GetDataSize()));
+    else
+        CopyTextureData(mappedSubresource, buffer, bufferSize);
+
+    context_->Unmap(resource, 0);
+}
+
+void D3D11Readback::ReadTexture(const D3D11Texture& textureD3D, int mipLevel, ImageFormat imageFormat, DataType dataType, std::size_t threadCount)
+{
+    /* Validate output format */
+    if (IsCompressedFormat(DXGetTextureFormatDesc(textureD3D.GetFormat()).format) && !IsCompressedFormat(imageFormat))
+        throw std::invalid_argument("can not read compressed texture into uncompressed image buffer");
+
+    /* Store settings for the image conversion after the data has been copied */
+    textureFormat_  = textureD3D.GetFormat();
+    extent_         = textureD3D.QueryMipLevelSize(static_cast<unsigned int>(mipLevel));
+    imageFormat_    = imageFormat;
+    dataType_       = dataType;
+    threadCount_    = threadCount;
+
+    /* Copy hardware texture into staging texture with CPU read access */
+    textureD3D.CreateSubresourceCopyWithCPUAccess(device_, context_, stagingTexture_, D3D11_CPU_ACCESS_READ, mipLevel);
+
+    InsertEvent();
+}
+
+void D3D11Readback::ReadBuffer(const D3D11Buffer& bufferD3D, std::size_t offset)
+{
+    /* Create staging buffer with CPU read access */
+    D3D11_BUFFER_DESC desc;
+    {
+        desc.ByteWidth              = static_cast<UINT>(GetDataSize());
+        desc.Usage                  = D3D11_USAGE_STAGING;
+        desc.BindFlags              = 0;
+        desc.CPUAccessFlags         = D3D11_CPU_ACCESS_READ;
+        desc.MiscFlags              = 0;
+        desc.StructureByteStride    = 0;
+    }
+    auto hr = device_->CreateBuffer(&desc, nullptr, stagingBuffer_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 staging buffer for readback");
+
+    /* Copy buffer range into staging buffer */
+    D3D11_BOX srcBox;
+    {
+        srcBox.left     = static_cast<UINT>(offset);
+        srcBox.top      = 0;
+        srcBox.front    = 0;
+        srcBox.right    = static_cast<UINT>(offset + GetDataSize());
+        srcBox.bottom   = 1;
+        srcBox.back     = 1;
+    }
+    context_->CopySubresourceRegion(stagingBuffer_.Get(), 0, 0, 0, 0, bufferD3D.Get(), 0, &srcBox);
+
+    InsertEvent();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D11Readback::InsertEvent()
+{
+    /* Create event query, which is signaled when all previous commands have been completed */
+    D3D11_QUERY_DESC queryDesc;
+    {
+        queryDesc.Query     = D3D11_QUERY_EVENT;
+        queryDesc.MiscFlags = 0;
+    }
+    auto hr = device_->CreateQuery(&queryDesc, event_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 event query for readback");
+
+    context_->End(event_.Get());
+}
+
+void D3D11Readback::CopyTextureData(const D3D11_MAPPED_SUBRESOURCE& mappedSubresource, void* buffer, std::size_t bufferSize)
+{
+    auto srcTexFormat   = DXGetTextureFormatDesc(textureFormat_);
+    auto src            = reinterpret_cast<const char*>(mappedSubresource.pData);
+    auto dst            = reinterpret_cast<char*>(buffer);
+
+    if (IsCompressedFormat(srcTexFormat.format))
+    {
+        /* Copy rows of blocks from the mapped data, which might be padded, into the tightly packed output buffer */
+        auto hwFormat       = D3D11Types::Unmap(textureFormat_);
+        auto dstRowPitch    = CompressedImageRowPitch(hwFormat, extent_.x);
+        auto numRows        = CompressedImageSize(hwFormat, extent_.x, extent_.y) / dstRowPitch;
+        auto end            = dst + bufferSize;
+
+        for (UINT z = 0; z < extent_.z; ++z)
+        {
+            for (UINT row = 0; row < numRows && dst + dstRowPitch <= end; ++row)
+            {
+                ::memcpy(dst, src + z * mappedSubresource.DepthPitch + row * mappedSubresource.RowPitch, dstRowPitch);
+                dst += dstRowPitch;
+            }
+        }
+    }
+    else
+    {
+        /*
+        Convert (or only copy) the rows of the mapped data, which might be padded, directly into the tightly packed output buffer.
+        The rows are distributed over the worker threads, and the number of rows is limited to the output buffer size.
+        */
+        auto dstRowPitch    = static_cast<std::size_t>(extent_.x) * ImageFormatSize(imageFormat_) * DataTypeSize(dataType_);
+        auto numRows        = std::min(static_cast<std::size_t>(extent_.y) * extent_.z, bufferSize / dstRowPitch);
+
+        if (extent_.z == 1 || mappedSubresource.DepthPitch == mappedSubresource.RowPitch * extent_.y)
+        {
+            /* Convert rows of all slices at once, since the slices are not padded */
+            ConvertImageBuffer(
+                srcTexFormat.format, srcTexFormat.dataType, src, mappedSubresource.RowPitch,
+                imageFormat_, dataType_, dst, dstRowPitch,
+                extent_.x, numRows, threadCount_
+            );
+        }
+        else
+        {
+            /* Convert rows of each slice separately */
+            for (UINT z = 0; z < extent_.z && numRows > 0; ++z)
+            {
+                auto numSliceRows = std::min(static_cast<std::size_t>(extent_.y), numRows);
+
+                ConvertImageBuffer(
+                    srcTexFormat.format, srcTexFormat.dataType, src + z * mappedSubresource.DepthPitch, mappedSubresource.RowPitch,
+                    imageFormat_, dataType_, dst, dstRowPitch,
+                    extent_.x, numSliceRows, threadCount_
+                );
+
+                dst     += numSliceRows * dstRowPitch;
+                numRows -= numSliceRows;
+            }
+        }
+    }
+}
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,76 @@
+/*
+ * D3D11Readback.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_READBACK_H
+#define LLGL_D3D11_READBACK_H
+
+
+#include <LLGL/Readback.h>
+#include <LLGL/Image.h>
+#include "../Texture/D3D11Texture.h"
+#include "../../DXCommon/ComPtr.h"
+#include <d3d11.h>
+
+
+namespace LLGL
+{
+
+
+class D3D11Buffer;
+
+/*
+Asynchronous readback into a staging resource.
+The copy command is followed by an event query, which can be polled without flushing the command queue.
+*/
+class D3D11Readback : public Readback
+{
+
+    public:
+
+        D3D11Readback(ID3D11Device* device, ID3D11DeviceContext* context, std::size_t dataSize);
+
+        bool IsReady() override;
+
+        void ReadData(void* buffer, std::size_t bufferSize) override;
+
+        // Schedules the copy of the specified texture MIP-level into a staging texture.
+        void ReadTexture(const D3D11Texture& textureD3D, int mipLevel, ImageFormat imageFormat, DataType dataType, std::size_t threadCount);
+
+        // Schedules the copy of the specified buffer range into a staging buffer.
+        void ReadBuffer(const D3D11Buffer& bufferD3D, std::size_t offset);
+
+    private:
+
+        void InsertEvent();
+
+        void CopyTextureData(const D3D11_MAPPED_SUBRESOURCE& mappedSubresource, void* buffer, std::size_t bufferSize);
+
+        ID3D11Device*           device_         = nullptr;
+        ID3D11DeviceContext*    context_        = nullptr;
+
+        D3D11HardwareTexture    stagingTexture_;
+        ComPtr<ID3D11Buffer>    stagingBuffer_;
+        ComPtr<ID3D11Query>     event_;
+
+        /* Texture readback settings */
+        DXGI_FORMAT             textureFormat_  = DXGI_FORMAT_UNKNOWN;
+        Gs::Vector3ui           extent_;
+        ImageFormat             imageFormat_    = ImageFormat::RGBA;
+        DataType                dataType_       = DataType::UInt8;
+        std::size_t             threadCount_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -72,6 +72,12 @@ bool D3D11StorageBuffer::IsByteAddressable() const
              storageType_ == StorageBufferType::RWByteAddressBuffer );
 }
 
+bool D3D11StorageBuffer::HasCounter() const
+{
+    return ( storageType_ == StorageBufferType::AppendStructuredBuffer ||
+             storageType_ == StorageBufferType::ConsumeStructuredBuffer );
+}
+
 
 /*
  * ======= Private: =======
@@ -101,10 +107,8 @@ UINT D3D11StorageBuffer::GetUAVFlags() const
 {
     if (IsByteAddressable())
         return D3D11_BUFFER_UAV_FLAG_RAW;
-    if (storageType_ == StorageBufferType::AppendStructuredBuffer)
+    if (HasCounter())
         return D3D11_BUFFER_UAV_FLAG_APPEND;
-    if (storageType_ == StorageBufferType::ConsumeStructuredBuffer)
-        return D3D11_BUFFER_UAV_FLAG_COUNTER;
     return 0;
 }
 
@@ -35,6 +35,15 @@ class D3D11StorageBuffer : public D3D11Buffer
         // True, if storage type is: ByteAddressBuffer or RWByteAddressBuffer.
         bool IsByteAddressable() const;
 
+        // True, if storage type is: AppendStructuredBuffer or ConsumeStructuredBuffer, i.e. the UAV has a hidden counter.
+        bool HasCounter() const;
+
+        // Sets the initial counter value, which is used the next time the UAV is bound (-1 keeps the current counter).
+        inline void SetInitialCount(UINT initialCount)
+        {
+            initialCount_ = initialCount;
+        }
+
         inline ID3D11ShaderResourceView* GetSRV() const
         {
             return srv_.Get();
@@ -15,7 +15,14 @@ namespace LLGL
 D3D11StreamOutputBuffer::D3D11StreamOutputBuffer(ID3D11Device* device, const BufferDescriptor& desc, const void* initialData) :
     D3D11Buffer { BufferType::StreamOutput }
 {
-    CreateResource(device, CD3D11_BUFFER_DESC(desc.size, D3D11_BIND_STREAM_OUTPUT), initialData, desc.flags);
+    stride_ = desc.vertexBuffer.format.stride;
+
+    /* Stream-output buffers with a vertex format can also be drawn as vertex buffers (see CommandBuffer::DrawStreamOutput) */
+    UINT bindFlags = D3D11_BIND_STREAM_OUTPUT;
+    if (stride_ > 0)
+        bindFlags |= D3D11_BIND_VERTEX_BUFFER;
+
+    CreateResource(device, CD3D11_BUFFER_DESC(desc.size, bindFlags), initialData, desc.flags);
 }
 
 
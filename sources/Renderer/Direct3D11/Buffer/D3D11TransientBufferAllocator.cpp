@@ -0,0 +1,68 @@
+/*
+ * D3D11TransientBufferAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11TransientBufferAllocator.h"
+#include "../../DXCommon/DXCore.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Direct3D 11.1 requires constant buffer offsets and sizes to be multiples of 16 constants (i.e. 256 bytes).
+static const unsigned int g_constantBufferOffsetAlignment = 256;
+
+static BufferDescriptor MakeTransientBufferDesc(unsigned int capacity)
+{
+    BufferDescriptor desc;
+    {
+        desc.type   = BufferType::Constant;
+        desc.size   = capacity;
+        desc.flags  = BufferFlags::DynamicUsage;
+    }
+    return desc;
+}
+
+D3D11TransientBufferAllocator::D3D11TransientBufferAllocator(ID3D11Device* device, ID3D11DeviceContext* context, unsigned int capacity) :
+    TransientBufferAllocator { capacity, g_constantBufferOffsetAlignment, numSegments      },
+    buffer_                  { device, MakeTransientBufferDesc(GetCapacity())              },
+    context_                 { context                                                     }
+{
+}
+
+Buffer& D3D11TransientBufferAllocator::GetBuffer()
+{
+    return buffer_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D11TransientBufferAllocator::WriteRange(const void* data, unsigned int size, unsigned int offset)
+{
+    /* Discard the previous buffer contents at the beginning of the ring buffer, otherwise never overwrite ranges that are in use */
+    auto mapType = (offset == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE);
+
+    D3D11_MAPPED_SUBRESOURCE subresource;
+    auto hr = context_->Map(buffer_.Get(), 0, mapType, 0, &subresource);
+    if (DXReportIfFailed(hr, "failed to map D3D11 transient constant buffer"))
+        return;
+    {
+        ::memcpy(reinterpret_cast<char*>(subresource.pData) + offset, data, size);
+    }
+    context_->Unmap(buffer_.Get(), 0);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,55 @@
+/*
+ * D3D11TransientBufferAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_TRANSIENT_BUFFER_ALLOCATOR_H
+#define LLGL_D3D11_TRANSIENT_BUFFER_ALLOCATOR_H
+
+
+#include "../../TransientBufferAllocator.h"
+#include "D3D11ConstantBuffer.h"
+#include <d3d11.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Ring buffer for transient constant buffer ranges.
+The buffer is mapped with D3D11_MAP_WRITE_NO_OVERWRITE for each range,
+and with D3D11_MAP_WRITE_DISCARD whenever the ring buffer wraps around,
+so the driver takes care of buffer renaming instead of explicit fences.
+*/
+class D3D11TransientBufferAllocator : public TransientBufferAllocator
+{
+
+    public:
+
+        D3D11TransientBufferAllocator(ID3D11Device* device, ID3D11DeviceContext* context, unsigned int capacity);
+
+        Buffer& GetBuffer() override;
+
+    private:
+
+        static const unsigned int numSegments = 4;
+
+        void WriteRange(const void* data, unsigned int size, unsigned int offset) override;
+
+        D3D11ConstantBuffer     buffer_;
+        ID3D11DeviceContext*    context_    = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -8,15 +8,23 @@
 #include "D3D11CommandBuffer.h"
 #include "D3D11RenderContext.h"
 #include "D3D11Types.h"
+#include "../DXCommon/DXCore.h"
 #include "../CheckedCast.h"
 #include <LLGL/Platform/NativeHandle.h>
+#include <LLGL/Image.h>
 #include "../../Core/Helper.h"
 #include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
 
 #include "RenderState/D3D11StateManager.h"
 #include "RenderState/D3D11GraphicsPipeline.h"
 #include "RenderState/D3D11ComputePipeline.h"
 #include "RenderState/D3D11Query.h"
+#include "RenderState/D3D11QueryArray.h"
+#include "RenderState/D3D11Fence.h"
+#include "RenderState/D3D11ResourceHeap.h"
 
 #include "Buffer/D3D11VertexBuffer.h"
 #include "Buffer/D3D11VertexBufferArray.h"
@@ -33,23 +41,31 @@
 #include "Texture/D3D11SamplerArray.h"
 #include "Texture/D3D11RenderTarget.h"
 
+#include "Shader/D3D11ShaderProgram.h"
+#include "Shader/D3D11Shader.h"
+
 
 namespace LLGL
 {
 
 
-#define VS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::VertexStage        ) != 0 )
-#define HS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::TessControlStage   ) != 0 )
-#define DS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::TessEvaluationStage) != 0 )
-#define GS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::GeometryStage      ) != 0 )
-#define PS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::FragmentStage      ) != 0 )
-#define CS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::ComputeStage       ) != 0 )
 #define SRV_STAGE(FLAG) ( ((FLAG) & ShaderStageFlags::ReadOnlyResource   ) != 0 )
 
 D3D11CommandBuffer::D3D11CommandBuffer(D3D11StateManager& stateMngr, const ComPtr<ID3D11DeviceContext>& context) :
     stateMngr_ { stateMngr },
     context_   { context   }
 {
+    context_.As(&context1_);
+    InitMemory(pushConstants_);
+}
+
+D3D11CommandBuffer::D3D11CommandBuffer(const ComPtr<ID3D11DeviceContext>& deferredContext) :
+    deferredStateMngr_ { MakeUnique<D3D11StateManager>(deferredContext) },
+    stateMngr_         { *deferredStateMngr_                             },
+    context_           { deferredContext                                 }
+{
+    context_.As(&context1_);
+    InitMemory(pushConstants_);
 }
 
 /* ----- Configuration ----- */
@@ -79,6 +95,21 @@ void D3D11CommandBuffer::SetScissorArray(unsigned int numScissors, const Scissor
     stateMngr_.SetScissors(numScissors, scissorArray);
 }
 
+void D3D11CommandBuffer::SetShadingRate(const ShadingRate /*rate*/)
+{
+    // dummy (variable-rate shading is not supported by Direct3D 11)
+}
+
+void D3D11CommandBuffer::SetShadingRateImage(Texture* /*texture*/)
+{
+    // dummy (variable-rate shading is not supported by Direct3D 11)
+}
+
+void D3D11CommandBuffer::SetDepthBounds(float /*minDepth*/, float /*maxDepth*/)
+{
+    // dummy (depth-bounds test is only available via vendor-specific driver APIs for Direct3D 11)
+}
+
 void D3D11CommandBuffer::SetClearColor(const ColorRGBAf& color)
 {
     clearState_.color = color;
@@ -124,22 +155,36 @@ void D3D11CommandBuffer::ClearTarget(unsigned int targetIndex, const LLGL::Color
 
 /* ----- Buffers ------ */
 
-void D3D11CommandBuffer::SetVertexBuffer(Buffer& buffer)
+void D3D11CommandBuffer::SetVertexBuffer(Buffer& buffer, unsigned int offset)
 {
-    auto& vertexBufferD3D = LLGL_CAST(D3D11VertexBuffer&, buffer);
+    if (buffer.GetType() == BufferType::StreamOutput)
+    {
+        /* Set stream-output buffer with the stride of its vertex format for "DrawStreamOutput" */
+        auto& streamOutputBufferD3D = LLGL_CAST(D3D11StreamOutputBuffer&, buffer);
 
-    ID3D11Buffer* buffers[] = { vertexBufferD3D.Get() };
-    UINT strides[] = { vertexBufferD3D.GetStride() };
-    UINT offsets[] = { 0 };
+        ID3D11Buffer* buffers[] = { streamOutputBufferD3D.Get() };
+        UINT strides[] = { streamOutputBufferD3D.GetStride() };
+        UINT offsets[] = { offset };
 
-    context_->IASetVertexBuffers(0, 1, buffers, strides, offsets);
+        stateMngr_.SetVertexBuffers(0, 1, buffers, strides, offsets);
+    }
+    else
+    {
+        auto& vertexBufferD3D = LLGL_CAST(D3D11VertexBuffer&, buffer);
+
+        ID3D11Buffer* buffers[] = { vertexBufferD3D.Get() };
+        UINT strides[] = { vertexBufferD3D.GetStride() };
+        UINT offsets[] = { offset };
+
+        stateMngr_.SetVertexBuffers(0, 1, buffers, strides, offsets);
+    }
 }
 
 void D3D11CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
     auto& vertexBufferArrayD3D = LLGL_CAST(D3D11VertexBufferArray&, bufferArray);
 
-    context_->IASetVertexBuffers(
+    stateMngr_.SetVertexBuffers(
         0,
         static_cast<UINT>(vertexBufferArrayD3D.GetBuffers().size()),
         vertexBufferArrayD3D.GetBuffers().data(),
@@ -148,10 +193,10 @@ void D3D11CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
     );
 }
 
-void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer)
+void D3D11CommandBuffer::SetIndexBuffer(Buffer& buffer, unsigned int offset)
 {
     auto& indexBufferD3D = LLGL_CAST(D3D11IndexBuffer&, buffer);
-    context_->IASetIndexBuffer(indexBufferD3D.Get(), indexBufferD3D.GetFormat(), 0);
+    stateMngr_.SetIndexBuffer(indexBufferD3D.Get(), indexBufferD3D.GetFormat(), offset);
 }
 
 void D3D11CommandBuffer::SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
@@ -159,14 +204,14 @@ void D3D11CommandBuffer::SetConstantBuffer(Buffer& buffer, unsigned int slot, lo
     /* Set constant buffer resource to all shader stages */
     auto& constantBufferD3D = LLGL_CAST(D3D11ConstantBuffer&, buffer);
     auto resource = constantBufferD3D.Get();
-    SetConstantBuffersOnStages(slot, 1, &resource, shaderStageFlags);
+    stateMngr_.SetConstantBuffers(slot, 1, &resource, shaderStageFlags);
 }
 
 void D3D11CommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags)
 {
     /* Set constant buffer resource to all shader stages */
     auto& bufferArrayD3D = LLGL_CAST(D3D11BufferArray&, bufferArray);
-    SetConstantBuffersOnStages(
+    stateMngr_.SetConstantBuffers(
         startSlot,
         static_cast<UINT>(bufferArrayD3D.GetBuffers().size()),
         bufferArrayD3D.GetBuffers().data(),
@@ -174,6 +219,16 @@ void D3D11CommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsign
     );
 }
 
+void D3D11CommandBuffer::SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags)
+{
+    /* Set constant buffer range (in units of shader constants, i.e. 16 bytes) to all shader stages */
+    auto& constantBufferD3D = LLGL_CAST(D3D11ConstantBuffer&, buffer);
+    auto resource = constantBufferD3D.Get();
+    UINT firstConstant  = offset / 16;
+    UINT numConstants   = size / 16;
+    stateMngr_.SetConstantBufferRanges(slot, 1, &resource, &firstConstant, &numConstants, shaderStageFlags);
+}
+
 void D3D11CommandBuffer::SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
 {
     auto& storageBufferD3D = LLGL_CAST(D3D11StorageBuffer&, buffer);
@@ -183,13 +238,16 @@ void D3D11CommandBuffer::SetStorageBuffer(Buffer& buffer, unsigned int slot, lon
         /* Set UAVs to specified shader stages */
         ID3D11UnorderedAccessView* uavList[] = { storageBufferD3D.GetUAV() };
         UINT auvCounts[] = { storageBufferD3D.GetInitialCount() };
-        SetUnorderedAccessViewsOnStages(slot, 1, uavList, auvCounts, shaderStageFlags);
+        stateMngr_.SetUnorderedAccessViews(slot, 1, uavList, auvCounts, shaderStageFlags);
+
+        /* Keep the current counter when the buffer is bound again (see ResetBufferCounter) */
+        storageBufferD3D.SetInitialCount(static_cast<UINT>(-1));
     }
     else
     {
         /* Set SRVs to specified shader stages */
         ID3D11ShaderResourceView* srvList[] = { storageBufferD3D.GetSRV() };
-        SetShaderResourcesOnStages(slot, 1, srvList, shaderStageFlags);
+        stateMngr_.SetShaderResources(slot, 1, srvList, shaderStageFlags);
     }
 }
 
@@ -200,7 +258,7 @@ void D3D11CommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigne
     if (stroageBufferArrayD3D.HasUAV() && !SRV_STAGE(shaderStageFlags))
     {
         /* Set UAVs to specified shader stages */
-        SetUnorderedAccessViewsOnStages(
+        stateMngr_.SetUnorderedAccessViews(
             startSlot,
             static_cast<UINT>(stroageBufferArrayD3D.GetUnorderedViews().size()),
             stroageBufferArrayD3D.GetUnorderedViews().data(),
@@ -211,7 +269,7 @@ void D3D11CommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigne
     else
     {
         /* Set SRVs to specified shader stages */
-        SetShaderResourcesOnStages(
+        stateMngr_.SetShaderResources(
             startSlot,
             static_cast<UINT>(stroageBufferArrayD3D.GetResourceViews().size()),
             stroageBufferArrayD3D.GetResourceViews().data(),
@@ -220,6 +278,21 @@ void D3D11CommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigne
     }
 }
 
+void D3D11CommandBuffer::ResetBufferCounter(Buffer& buffer, unsigned int value)
+{
+    /* Hidden UAV counters can only be set when the UAV is bound, so defer the value to the next call of "SetStorageBuffer" */
+    auto& storageBufferD3D = LLGL_CAST(D3D11StorageBuffer&, buffer);
+    if (storageBufferD3D.HasCounter())
+        storageBufferD3D.SetInitialCount(value);
+}
+
+void D3D11CommandBuffer::CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer)
+{
+    auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
+    auto& srcBufferD3D = LLGL_CAST(D3D11StorageBuffer&, srcBuffer);
+    context_->CopyStructureCount(dstBufferD3D.Get(), dstOffset, srcBufferD3D.GetUAV());
+}
+
 void D3D11CommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
     auto& streamOutputBufferD3D = LLGL_CAST(D3D11StreamOutputBuffer&, buffer);
@@ -227,18 +300,23 @@ void D3D11CommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
     ID3D11Buffer* buffers[] = { streamOutputBufferD3D.Get() };
     UINT offsets[] = { 0 };
 
-    context_->SOSetTargets(1, buffers, offsets);
+    stateMngr_.SetStreamOutputTargets(1, buffers, offsets);
+    StoreStreamOutputTargets(1, buffers);
 }
 
 void D3D11CommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
     auto& streamOutputBufferArrayD3D = LLGL_CAST(D3D11StreamOutputBufferArray&, bufferArray);
 
-    context_->SOSetTargets(
+    stateMngr_.SetStreamOutputTargets(
         static_cast<UINT>(streamOutputBufferArrayD3D.GetBuffers().size()),
         streamOutputBufferArrayD3D.GetBuffers().data(),
         streamOutputBufferArrayD3D.GetOffsets().data()
     );
+    StoreStreamOutputTargets(
+        static_cast<UINT>(streamOutputBufferArrayD3D.GetBuffers().size()),
+        streamOutputBufferArrayD3D.GetBuffers().data()
+    );
 }
 
 void D3D11CommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
@@ -251,6 +329,22 @@ void D3D11CommandBuffer::EndStreamOutput()
     // dummy
 }
 
+void D3D11CommandBuffer::PauseStreamOutput()
+{
+    /* Unbind stream-output targets, but keep their filled sizes */
+    ID3D11Buffer* buffers[] = { nullptr };
+    UINT offsets[] = { 0 };
+    stateMngr_.SetStreamOutputTargets(1, buffers, offsets);
+}
+
+void D3D11CommandBuffer::ResumeStreamOutput()
+{
+    /* Bind stream-output targets again and append to their current filled sizes (offset -1) */
+    UINT offsets[D3D11_SO_BUFFER_SLOT_COUNT];
+    std::fill(std::begin(offsets), std::end(offsets), static_cast<UINT>(-1));
+    stateMngr_.SetStreamOutputTargets(numStreamOutputTargets_, streamOutputTargets_.data(), offsets);
+}
+
 
 /* ----- Textures ----- */
 
@@ -259,14 +353,14 @@ void D3D11CommandBuffer::SetTexture(Texture& texture, unsigned int slot, long sh
     /* Set texture resource to all shader stages */
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     auto resource = textureD3D.GetSRV();
-    SetShaderResourcesOnStages(slot, 1, &resource, shaderStageFlags);
+    stateMngr_.SetShaderResources(slot, 1, &resource, shaderStageFlags);
 }
 
 void D3D11CommandBuffer::SetTextureArray(TextureArray& textureArray, unsigned int startSlot, long shaderStageFlags)
 {
     /* Set texture resource to all shader stages */
     auto& textureArrayD3D = LLGL_CAST(D3D11TextureArray&, textureArray);
-    SetShaderResourcesOnStages(
+    stateMngr_.SetShaderResources(
         startSlot,
         static_cast<UINT>(textureArrayD3D.GetResourceViews().size()),
         textureArrayD3D.GetResourceViews().data(),
@@ -281,14 +375,14 @@ void D3D11CommandBuffer::SetSampler(Sampler& sampler, unsigned int slot, long sh
     /* Set sampler state object to all shader stages */
     auto& samplerD3D = LLGL_CAST(D3D11Sampler&, sampler);
     auto resource = samplerD3D.GetSamplerState();
-    SetSamplersOnStages(slot, 1, &resource, shaderStageFlags);
+    stateMngr_.SetSamplers(slot, 1, &resource, shaderStageFlags);
 }
 
 void D3D11CommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags)
 {
     /* Set sampler state object to all shader stages */
     auto& samplerArrayD3D = LLGL_CAST(D3D11SamplerArray&, samplerArray);
-    SetSamplersOnStages(
+    stateMngr_.SetSamplers(
         startSlot,
         static_cast<UINT>(samplerArrayD3D.GetSamplerStates().size()),
         samplerArrayD3D.GetSamplerStates().data(),
@@ -296,6 +390,55 @@ void D3D11CommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned in
     );
 }
 
+/* ----- Resource Heaps ----- */
+
+void D3D11CommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap)
+{
+    auto& resourceHeapD3D = LLGL_CAST(D3D11ResourceHeap&, resourceHeap);
+
+    /* Set all pre-built segments of the resource heap to their shader stages */
+    for (const auto& segment : resourceHeapD3D.GetCBVSegments())
+    {
+        stateMngr_.SetConstantBuffers(
+            segment.startSlot,
+            segment.count,
+            &(resourceHeapD3D.GetConstantBuffers()[segment.offset]),
+            segment.shaderStageFlags
+        );
+    }
+
+    for (const auto& segment : resourceHeapD3D.GetSRVSegments())
+    {
+        stateMngr_.SetShaderResources(
+            segment.startSlot,
+            segment.count,
+            &(resourceHeapD3D.GetResourceViews()[segment.offset]),
+            segment.shaderStageFlags
+        );
+    }
+
+    for (const auto& segment : resourceHeapD3D.GetUAVSegments())
+    {
+        stateMngr_.SetUnorderedAccessViews(
+            segment.startSlot,
+            segment.count,
+            &(resourceHeapD3D.GetUnorderedViews()[segment.offset]),
+            &(resourceHeapD3D.GetInitialCounts()[segment.offset]),
+            segment.shaderStageFlags
+        );
+    }
+
+    for (const auto& segment : resourceHeapD3D.GetSamplerSegments())
+    {
+        stateMngr_.SetSamplers(
+            segment.startSlot,
+            segment.count,
+            &(resourceHeapD3D.GetSamplerStates()[segment.offset]),
+            segment.shaderStageFlags
+        );
+    }
+}
+
 /* ----- Render Targets ----- */
 
 //private
@@ -341,18 +484,95 @@ void D3D11CommandBuffer::SetRenderTarget(RenderContext& renderContext)
     boundRenderTarget_ = nullptr;
 }
 
+/* ----- Render Passes ----- */
+
+void D3D11CommandBuffer::BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc)
+{
+    SetRenderTarget(renderTarget);
+    LoadRenderPassAttachments(renderPassDesc);
+}
+
+void D3D11CommandBuffer::BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc)
+{
+    SetRenderTarget(renderContext);
+    LoadRenderPassAttachments(renderPassDesc);
+}
+
+void D3D11CommandBuffer::EndRenderPass()
+{
+    if (boundRenderTarget_ && boundRenderTarget_->HasResolveAttachments())
+    {
+        /* Resolve multi-sampled attachments unless all of them are discarded */
+        const auto& colorAttachments = renderPassDesc_.colorAttachments;
+
+        auto allDiscarded = (colorAttachments.size() >= framebufferView_.rtvList.size());
+        for (const auto& attachment : colorAttachments)
+        {
+            if (attachment.storeOp != AttachmentStoreOp::Discard)
+                allDiscarded = false;
+        }
+
+        if (!allDiscarded)
+            ResolveBoundRenderTarget();
+
+        /* Discard multi-sampled contents that are no longer needed after the resolve */
+        DiscardRenderPassAttachments(true);
+
+        /* Reset reference to render target, so it is not resolved again with the next render target */
+        boundRenderTarget_ = nullptr;
+    }
+    else
+        DiscardRenderPassAttachments(false);
+}
+
 /* ----- Pipeline States ----- */
 
 void D3D11CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
     auto& graphicsPipelineD3D = LLGL_CAST(D3D11GraphicsPipeline&, graphicsPipeline);
-    graphicsPipelineD3D.Bind(context_.Get());
+    graphicsPipelineD3D.Bind(stateMngr_);
+
+    /* Store push constants layout */
+    pushConstantsSize_ = std::min(graphicsPipelineD3D.GetPushConstantsSize(), maxPushConstantsSize);
+    pushConstantsSlot_ = graphicsPipelineD3D.GetPushConstantsSlot();
+
+    boundGraphicsProgram_ = graphicsPipelineD3D.GetShaderProgram();
 }
 
 void D3D11CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
     auto& computePipelineD3D = LLGL_CAST(D3D11ComputePipeline&, computePipeline);
-    computePipelineD3D.Bind(context_.Get());
+    computePipelineD3D.Bind(stateMngr_);
+    boundComputeProgram_ = computePipelineD3D.GetShaderProgram();
+}
+
+void D3D11CommandBuffer::SetPushConstants(unsigned int offset, unsigned int size, const void* data)
+{
+    /* Store push constants in the CPU shadow; they are written into a constant buffer with the next draw command */
+    if (offset < pushConstantsSize_)
+    {
+        ::memcpy(&pushConstants_[offset], data, std::min(size, pushConstantsSize_ - offset));
+        pushConstantsDirty_ = true;
+    }
+}
+
+void D3D11CommandBuffer::SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances)
+{
+    auto shaderProgramD3D = (stage == ShaderType::Compute ? boundComputeProgram_ : boundGraphicsProgram_);
+    if (shaderProgramD3D)
+    {
+        if (auto shaderD3D = shaderProgramD3D->GetShader(stage))
+        {
+            /* Resolve class instance IDs of the shader and bind the shader again with its class instances */
+            auto numClassInstances = std::min(static_cast<UINT>(numSlots), shaderD3D->GetNumInterfaceSlots());
+
+            classInstances_.resize(numClassInstances);
+            for (UINT i = 0; i < numClassInstances; ++i)
+                classInstances_[i] = shaderD3D->GetClassInstance(classInstances[i]);
+
+            stateMngr_.SetShaderClassInstances(stage, classInstances_.data(), numClassInstances);
+        }
+    }
 }
 
 /* ----- Queries ----- */
@@ -367,6 +587,10 @@ void D3D11CommandBuffer::BeginQuery(Query& query)
         context_->Begin(queryD3D.GetQueryObject());
         context_->End(queryD3D.GetTimeStampQueryBegin());
     }
+    else if (queryD3D.GetQueryObjectType() == D3D11_QUERY_TIMESTAMP)
+    {
+        /* Timestamp queries are only ended */
+    }
     else
     {
         /* Begin standard query */
@@ -384,6 +608,13 @@ void D3D11CommandBuffer::EndQuery(Query& query)
         context_->End(queryD3D.GetTimeStampQueryEnd());
         context_->End(queryD3D.GetQueryObject());
     }
+    else if (queryD3D.GetQueryObjectType() == D3D11_QUERY_TIMESTAMP)
+    {
+        /* Insert the timestamp query within its own disjoint query to determine the timestamp frequency */
+        context_->Begin(queryD3D.GetDisjointQuery());
+        context_->End(queryD3D.GetQueryObject());
+        context_->End(queryD3D.GetDisjointQuery());
+    }
     else
     {
         /* End standard query */
@@ -393,6 +624,10 @@ void D3D11CommandBuffer::EndQuery(Query& query)
 
 bool D3D11CommandBuffer::QueryResult(Query& query, std::uint64_t& result)
 {
+    /* Query data cannot be retrieved from a deferred context */
+    if (IsDeferred())
+        return false;
+
     auto& queryD3D = LLGL_CAST(D3D11Query&, query);
 
     switch (queryD3D.GetQueryObjectType())
@@ -441,6 +676,27 @@ bool D3D11CommandBuffer::QueryResult(Query& query, std::uint64_t& result)
         }
         break;
 
+        /* Query result from special case query type: Timestamp */
+        case D3D11_QUERY_TIMESTAMP:
+        {
+            UINT64 timestamp = 0;
+            if (context_->GetData(queryD3D.GetQueryObject(), &timestamp, sizeof(timestamp), 0) == S_OK)
+            {
+                D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
+                if (context_->GetData(queryD3D.GetDisjointQuery(), &disjointData, sizeof(disjointData), 0) == S_OK)
+                {
+                    /* Normalize timestamp to nanoseconds */
+                    static const double nanoseconds = 1000000000.0;
+
+                    auto scale = (nanoseconds / static_cast<double>(disjointData.Frequency));
+                    result = static_cast<std::uint64_t>(static_cast<double>(timestamp) * scale + 0.5);
+
+                    return true;
+                }
+            }
+        }
+        break;
+
         /* Query result from data of type: BOOL */
         case D3D11_QUERY_OCCLUSION_PREDICATE:
         case D3D11_QUERY_SO_OVERFLOW_PREDICATE:
@@ -522,6 +778,72 @@ bool D3D11CommandBuffer::QueryResult(Query& query, std::uint64_t& result)
     return false;
 }
 
+bool D3D11CommandBuffer::QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results)
+{
+    auto& queryArrayD3D = LLGL_CAST(D3D11QueryArray&, queryArray);
+    const auto& queries = queryArrayD3D.GetQueries();
+
+    /* Query results in reverse order, since the last query is most likely still pending */
+    for (auto i = numQueries; i > 0; --i)
+    {
+        if (!QueryResult(*queries[firstQuery + i - 1], results[i - 1]))
+            return false;
+    }
+
+    return true;
+}
+
+bool D3D11CommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    auto& queryD3D = LLGL_CAST(D3D11Query&, query);
+
+    if (!IsDeferred() && queryD3D.GetQueryObjectType() == D3D11_QUERY_PIPELINE_STATISTICS)
+    {
+        /* Query all counters of the pipeline statistics with a single call */
+        D3D11_QUERY_DATA_PIPELINE_STATISTICS data;
+        if (context_->GetData(queryD3D.GetQueryObject(), &data, sizeof(data), 0) == S_OK)
+        {
+            result.numPrimitivesGenerated               = data.CInvocations;
+            result.numVerticesSubmitted                 = data.IAVertices;
+            result.numPrimitivesSubmitted               = data.IAPrimitives;
+            result.numVertexShaderInvocations           = data.VSInvocations;
+            result.numTessControlShaderInvocations      = data.HSInvocations;
+            result.numTessEvaluationShaderInvocations   = data.DSInvocations;
+            result.numGeometryShaderInvocations         = data.GSInvocations;
+            result.numFragmentShaderInvocations         = data.PSInvocations;
+            result.numComputeShaderInvocations          = data.CSInvocations;
+            result.numGeometryPrimitivesGenerated       = data.GSPrimitives;
+            result.numClippingInputPrimitives           = data.CInvocations;
+            result.numClippingOutputPrimitives          = data.CPrimitives;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+Direct3D 11 can not write query results into a buffer on the GPU,
+so this waits for all results on the CPU and then updates the buffer with them.
+*/
+void D3D11CommandBuffer::ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset)
+{
+    if (IsDeferred())
+        throw std::runtime_error("cannot resolve query data within a deferred D3D11 command buffer");
+
+    auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
+
+    /* Wait until all query results are available */
+    std::vector<std::uint64_t> results(numQueries);
+    while (!QueryResult(queryArray, firstQuery, numQueries, results.data()))
+        std::this_thread::yield();
+
+    /* Write query results into destination buffer */
+    const auto dataSize = static_cast<UINT>(numQueries * sizeof(std::uint64_t));
+    D3D11_BOX dstBox { dstOffset, 0, 0, dstOffset + dataSize, 1, 1 };
+    context_->UpdateSubresource(dstBufferD3D.Get(), 0, &dstBox, results.data(), 0, 0);
+}
+
 void D3D11CommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
 {
     auto& queryD3D = LLGL_CAST(D3D11Query&, query);
@@ -533,60 +855,315 @@ void D3D11CommandBuffer::EndRenderCondition()
     context_->SetPredication(nullptr, FALSE);
 }
 
+/* ----- Copy ----- */
+
+void D3D11CommandBuffer::CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size)
+{
+    auto& dstBufferD3D = LLGL_CAST(D3D11Buffer&, dstBuffer);
+    auto& srcBufferD3D = LLGL_CAST(D3D11Buffer&, srcBuffer);
+
+    D3D11_BOX srcBox { srcOffset, 0, 0, srcOffset + size, 1, 1 };
+    context_->CopySubresourceRegion(dstBufferD3D.Get(), 0, dstOffset, 0, 0, srcBufferD3D.Get(), 0, &srcBox);
+}
+
+void D3D11CommandBuffer::CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto& dstTextureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
+    auto& srcTextureD3D = LLGL_CAST(D3D11Texture&, srcTexture);
+
+    auto dstRegionD3D = DXGetTextureRegion(dstTextureD3D.GetType(), dstOffset, srcRegion.extent);
+    auto srcRegionD3D = DXGetTextureRegion(srcTextureD3D.GetType(), srcRegion.offset, srcRegion.extent);
+
+    D3D11_BOX srcBox
+    {
+        srcRegionD3D.left, srcRegionD3D.top, srcRegionD3D.front,
+        srcRegionD3D.right, srcRegionD3D.bottom, srcRegionD3D.back
+    };
+
+    /* Copy each array layer separately, since each one is a separate subresource */
+    for (UINT i = 0; i < srcRegionD3D.numArrayLayers; ++i)
+    {
+        context_->CopySubresourceRegion(
+            dstTextureD3D.GetHardwareTexture().resource.Get(),
+            D3D11CalcSubresource(dstMipLevel, dstRegionD3D.firstArrayLayer + i, dstTextureD3D.GetNumMipLevels()),
+            dstRegionD3D.left, dstRegionD3D.top, dstRegionD3D.front,
+            srcTextureD3D.GetHardwareTexture().resource.Get(),
+            D3D11CalcSubresource(srcRegion.mipLevel, srcRegionD3D.firstArrayLayer + i, srcTextureD3D.GetNumMipLevels()),
+            &srcBox
+        );
+    }
+}
+
+void D3D11CommandBuffer::ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    auto& dstTextureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
+    auto& srcTextureD3D = LLGL_CAST(D3D11Texture&, srcTexture);
+
+    /* Resolve each array layer separately, since each one is a separate subresource (the region within a layer is ignored) */
+    const auto numLayers = std::max(1u, srcRegion.extent.z);
+
+    for (UINT i = 0; i < numLayers; ++i)
+    {
+        context_->ResolveSubresource(
+            dstTextureD3D.GetHardwareTexture().resource.Get(),
+            D3D11CalcSubresource(dstMipLevel, dstOffset.z + i, dstTextureD3D.GetNumMipLevels()),
+            srcTextureD3D.GetHardwareTexture().resource.Get(),
+            D3D11CalcSubresource(0, srcRegion.offset.z + i, 1),
+            dstTextureD3D.GetFormat()
+        );
+    }
+}
+
+/*
+Direct3D 11 can not copy between buffers and textures on the GPU,
+so the image data is copied through a staging buffer and written with "UpdateSubresource".
+*/
+void D3D11CommandBuffer::CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType)
+{
+    if (IsDeferred())
+        throw std::runtime_error("cannot copy buffer to texture within a deferred D3D11 command buffer");
+
+    auto& dstTextureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
+    auto& srcBufferD3D = LLGL_CAST(D3D11Buffer&, srcBuffer);
+
+    auto regionD3D = DXGetTextureRegion(dstTextureD3D.GetType(), dstRegion.offset, dstRegion.extent);
+
+    /* Determine size of the image data for each array layer */
+    auto width  = regionD3D.right - regionD3D.left;
+    auto height = regionD3D.bottom - regionD3D.top;
+    auto depth  = regionD3D.back - regionD3D.front;
+
+    const bool compressed = IsCompressedFormat(imageFormat);
+
+    UINT layerSize = 0;
+    if (compressed)
+        layerSize = CompressedImageSize(D3D11Types::Unmap(dstTextureD3D.GetFormat()), width, height, depth);
+    else
+        layerSize = width * height * depth * ImageFormatSize(imageFormat) * DataTypeSize(dataType);
+
+    auto dataSize = layerSize * regionD3D.numArrayLayers;
+
+    /* Create staging buffer with CPU read access */
+    ComPtr<ID3D11Device> device;
+    context_->GetDevice(&device);
+
+    D3D11_BUFFER_DESC stagingDesc;
+    {
+        stagingDesc.ByteWidth           = dataSize;
+        stagingDesc.Usage               = D3D11_USAGE_STAGING;
+        stagingDesc.BindFlags           = 0;
+        stagingDesc.CPUAccessFlags      = D3D11_CPU_ACCESS_READ;
+        stagingDesc.MiscFlags           = 0;
+        stagingDesc.StructureByteStride = 0;
+    }
+    ComPtr<ID3D11Buffer> stagingBuffer;
+    auto hr = device->CreateBuffer(&stagingDesc, nullptr, &stagingBuffer);
+    DXThrowIfFailed(hr, "failed to create D3D11 staging buffer for buffer-to-texture copy");
+
+    /* Copy buffer range into staging buffer */
+    D3D11_BOX srcBox { srcOffset, 0, 0, srcOffset + dataSize, 1, 1 };
+    context_->CopySubresourceRegion(stagingBuffer.Get(), 0, 0, 0, 0, srcBufferD3D.Get(), 0, &srcBox);
+
+    /* Map staging buffer (this waits until the copy has been completed) and write image data into each array layer */
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+    hr = context_->Map(stagingBuffer.Get(), 0, D3D11_MAP_READ, 0, &mappedSubresource);
+    DXThrowIfFailed(hr, "failed to map D3D11 staging buffer for buffer-to-texture copy");
+
+    D3D11_BOX dstBox
+    {
+        regionD3D.left, regionD3D.top, regionD3D.front,
+        regionD3D.right, regionD3D.bottom, regionD3D.back
+    };
+
+    for (UINT i = 0; i < regionD3D.numArrayLayers; ++i)
+    {
+        auto data = reinterpret_cast<const char*>(mappedSubresource.pData) + i * layerSize;
+
+        ImageDescriptor imageDesc { imageFormat, dataType, data };
+        if (compressed)
+            imageDesc = ImageDescriptor { imageFormat, data, layerSize };
+
+        dstTextureD3D.UpdateSubresource(context_.Get(), dstRegion.mipLevel, regionD3D.firstArrayLayer + i, dstBox, imageDesc, 0);
+    }
+
+    context_->Unmap(stagingBuffer.Get(), 0);
+}
+
 /* ----- Drawing ----- */
 
 void D3D11CommandBuffer::Draw(unsigned int numVertices, unsigned int firstVertex)
 {
+    FlushGraphicsResources();
     context_->Draw(numVertices, firstVertex);
 }
 
 void D3D11CommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex)
 {
+    FlushGraphicsResources();
     context_->DrawIndexed(numVertices, firstIndex, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex, int vertexOffset)
 {
+    FlushGraphicsResources();
     context_->DrawIndexed(numVertices, firstIndex, vertexOffset);
 }
 
 void D3D11CommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances)
 {
+    FlushGraphicsResources();
     context_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
 }
 
 void D3D11CommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset)
 {
+    FlushGraphicsResources();
     context_->DrawInstanced(numVertices, numInstances, firstVertex, instanceOffset);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex)
 {
+    FlushGraphicsResources();
     context_->DrawIndexedInstanced(numVertices, numInstances, firstIndex, 0, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset)
 {
+    FlushGraphicsResources();
     context_->DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void D3D11CommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset)
 {
+    FlushGraphicsResources();
     context_->DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset, instanceOffset);
 }
 
+void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset)
+{
+    FlushGraphicsResources();
+
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    context_->DrawInstancedIndirect(bufferD3D.Get(), offset);
+}
+
+void D3D11CommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    FlushGraphicsResources();
+
+    /* Emulate multi-draw command with a sequence of single indirect draw commands (not supported by D3D11) */
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    for (; numCommands-- > 0; offset += stride)
+        context_->DrawInstancedIndirect(bufferD3D.Get(), offset);
+}
+
+void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset)
+{
+    FlushGraphicsResources();
+
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    context_->DrawIndexedInstancedIndirect(bufferD3D.Get(), offset);
+}
+
+void D3D11CommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    FlushGraphicsResources();
+
+    /* Emulate multi-draw command with a sequence of single indirect draw commands (not supported by D3D11) */
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    for (; numCommands-- > 0; offset += stride)
+        context_->DrawIndexedInstancedIndirect(bufferD3D.Get(), offset);
+}
+
+void D3D11CommandBuffer::DrawStreamOutput()
+{
+    FlushGraphicsResources();
+    context_->DrawAuto();
+}
+
+void D3D11CommandBuffer::DrawMeshTasks(unsigned int /*numTasksX*/, unsigned int /*numTasksY*/, unsigned int /*numTasksZ*/)
+{
+    // dummy (mesh shaders are not supported by Direct3D 11)
+}
+
 /* ----- Compute ----- */
 
 void D3D11CommandBuffer::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ)
 {
+    stateMngr_.FlushComputeResources();
     context_->Dispatch(groupSizeX, groupSizeY, groupSizeZ);
 }
 
+void D3D11CommandBuffer::DispatchIndirect(Buffer& buffer, unsigned int offset)
+{
+    stateMngr_.FlushComputeResources();
+
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    context_->DispatchIndirect(bufferD3D.Get(), offset);
+}
+
+void D3D11CommandBuffer::Barrier(long /*barrierFlags*/)
+{
+    // dummy (Direct3D 11 resolves UAV hazards implicitly)
+}
+
+void D3D11CommandBuffer::StorageBarrier(Buffer& /*buffer*/)
+{
+    // dummy (Direct3D 11 resolves UAV hazards implicitly)
+}
+
+/* ----- Command Recording ----- */
+
+void D3D11CommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    auto& deferredCommandBufferD3D = LLGL_CAST(D3D11CommandBuffer&, deferredCommandBuffer);
+
+    /* Execute command list of deferred context and restore the state of this context afterwards */
+    if (auto commandList = deferredCommandBufferD3D.GetCommandList())
+        context_->ExecuteCommandList(commandList, TRUE);
+}
+
+void D3D11CommandBuffer::Reset()
+{
+    if (IsDeferred())
+    {
+        /* Discard all pending commands and release the finished command list */
+        commandList_.Reset();
+        GetCommandList();
+        commandList_.Reset();
+        boundRenderTarget_ = nullptr;
+    }
+}
+
 /* ----- Misc ----- */
 
+void D3D11CommandBuffer::Signal(Fence& fence)
+{
+    auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
+    fenceD3D.Signal(context_.Get());
+}
+
 void D3D11CommandBuffer::SyncGPU()
 {
-    context_->Flush();
+    /* Deferred contexts can not be flushed */
+    if (!IsDeferred())
+        context_->Flush();
+}
+
+/* ----- Extended functions ----- */
+
+ID3D11CommandList* D3D11CommandBuffer::GetCommandList()
+{
+    if (IsDeferred() && !commandList_)
+    {
+        /* Finish recording of deferred context and reset its state to default */
+        auto hr = context_->FinishCommandList(FALSE, commandList_.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to finish D3D11 command list of deferred context");
+
+        /* Deferred context has been reset to its default state, so reset the shadow state as well */
+        stateMngr_.Reset();
+    }
+    return commandList_.Get();
 }
 
 
@@ -596,68 +1173,155 @@ void D3D11CommandBuffer::SyncGPU()
 
 void D3D11CommandBuffer::SubmitFramebufferView()
 {
-    context_->OMSetRenderTargets(
+    stateMngr_.SetRenderTargets(
         static_cast<UINT>(framebufferView_.rtvList.size()),
         framebufferView_.rtvList.data(),
         framebufferView_.dsv
     );
 }
 
-void D3D11CommandBuffer::SetConstantBuffersOnStages(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long shaderStageFlags)
+void D3D11CommandBuffer::LoadRenderPassAttachments(const RenderPassDescriptor& renderPassDesc)
 {
-    if (VS_STAGE(shaderStageFlags)) { context_->VSSetConstantBuffers(startSlot, count, buffers); }
-    if (HS_STAGE(shaderStageFlags)) { context_->HSSetConstantBuffers(startSlot, count, buffers); }
-    if (DS_STAGE(shaderStageFlags)) { context_->DSSetConstantBuffers(startSlot, count, buffers); }
-    if (GS_STAGE(shaderStageFlags)) { context_->GSSetConstantBuffers(startSlot, count, buffers); }
-    if (PS_STAGE(shaderStageFlags)) { context_->PSSetConstantBuffers(startSlot, count, buffers); }
-    if (CS_STAGE(shaderStageFlags)) { context_->CSSetConstantBuffers(startSlot, count, buffers); }
+    renderPassDesc_ = renderPassDesc;
+
+    /* Clear or discard color attachments (clear values are taken from "SetClearColor", "SetClearDepth", and "SetClearStencil") */
+    const auto numColorAttachments = std::min(renderPassDesc.colorAttachments.size(), framebufferView_.rtvList.size());
+
+    for (std::size_t i = 0; i < numColorAttachments; ++i)
+    {
+        auto rtv = framebufferView_.rtvList[i];
+        switch (renderPassDesc.colorAttachments[i].loadOp)
+        {
+            case AttachmentLoadOp::Clear:
+                context_->ClearRenderTargetView(rtv, clearState_.color.Ptr());
+                break;
+            case AttachmentLoadOp::DontCare:
+                if (context1_)
+                    context1_->DiscardView(rtv);
+                break;
+            default:
+                break;
+        }
+    }
+
+    /* Clear or discard depth-stencil attachment */
+    if (framebufferView_.dsv != nullptr)
+    {
+        UINT dsvClearFlags = 0;
+
+        if (renderPassDesc.depthAttachment.loadOp == AttachmentLoadOp::Clear)
+            dsvClearFlags |= D3D11_CLEAR_DEPTH;
+        if (renderPassDesc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
+            dsvClearFlags |= D3D11_CLEAR_STENCIL;
+
+        if (dsvClearFlags)
+            context_->ClearDepthStencilView(framebufferView_.dsv, dsvClearFlags, clearState_.depth, clearState_.stencil);
+        else if (context1_ &&
+                 renderPassDesc.depthAttachment.loadOp   == AttachmentLoadOp::DontCare &&
+                 renderPassDesc.stencilAttachment.loadOp == AttachmentLoadOp::DontCare)
+        {
+            /* Depth and stencil share the same view, so it can only be discarded if both are undefined */
+            context1_->DiscardView(framebufferView_.dsv);
+        }
+    }
 }
 
-void D3D11CommandBuffer::SetShaderResourcesOnStages(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long shaderStageFlags)
+void D3D11CommandBuffer::DiscardRenderPassAttachments(bool discardResolvedAttachments)
 {
-    if (VS_STAGE(shaderStageFlags)) { context_->VSSetShaderResources(startSlot, count, views); }
-    if (HS_STAGE(shaderStageFlags)) { context_->HSSetShaderResources(startSlot, count, views); }
-    if (DS_STAGE(shaderStageFlags)) { context_->DSSetShaderResources(startSlot, count, views); }
-    if (GS_STAGE(shaderStageFlags)) { context_->GSSetShaderResources(startSlot, count, views); }
-    if (PS_STAGE(shaderStageFlags)) { context_->PSSetShaderResources(startSlot, count, views); }
-    if (CS_STAGE(shaderStageFlags)) { context_->CSSetShaderResources(startSlot, count, views); }
+    /* DiscardView requires the Direct3D 11.1 runtime; otherwise the attachments are simply stored */
+    if (!context1_)
+        return;
+
+    auto IsDiscarded = [discardResolvedAttachments](const RenderPassAttachmentDescriptor& attachment)
+    {
+        return (attachment.storeOp == AttachmentStoreOp::Discard || (discardResolvedAttachments && attachment.storeOp == AttachmentStoreOp::Resolve));
+    };
+
+    const auto numColorAttachments = std::min(renderPassDesc_.colorAttachments.size(), framebufferView_.rtvList.size());
+
+    for (std::size_t i = 0; i < numColorAttachments; ++i)
+    {
+        if (IsDiscarded(renderPassDesc_.colorAttachments[i]))
+            context1_->DiscardView(framebufferView_.rtvList[i]);
+    }
+
+    if (framebufferView_.dsv != nullptr && IsDiscarded(renderPassDesc_.depthAttachment) && IsDiscarded(renderPassDesc_.stencilAttachment))
+        context1_->DiscardView(framebufferView_.dsv);
+}
+
+void D3D11CommandBuffer::FlushGraphicsResources()
+{
+    FlushPushConstants();
+    stateMngr_.FlushGraphicsResources();
 }
 
-void D3D11CommandBuffer::SetSamplersOnStages(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long shaderStageFlags)
+// Size (in bytes) of the ring buffer for push constants; each draw command allocates one range of 256 bytes.
+static const unsigned int g_pushConstantsRingSize = (1u << 20);
+
+static ComPtr<ID3D11Device> GetContextDevice(ID3D11DeviceContext* context)
 {
-    if (VS_STAGE(shaderStageFlags)) { context_->VSSetSamplers(startSlot, count, samplers); }
-    if (HS_STAGE(shaderStageFlags)) { context_->HSSetSamplers(startSlot, count, samplers); }
-    if (DS_STAGE(shaderStageFlags)) { context_->DSSetSamplers(startSlot, count, samplers); }
-    if (GS_STAGE(shaderStageFlags)) { context_->GSSetSamplers(startSlot, count, samplers); }
-    if (PS_STAGE(shaderStageFlags)) { context_->PSSetSamplers(startSlot, count, samplers); }
-    if (CS_STAGE(shaderStageFlags)) { context_->CSSetSamplers(startSlot, count, samplers); }
+    ComPtr<ID3D11Device> device;
+    context->GetDevice(device.ReleaseAndGetAddressOf());
+    return device;
 }
 
-void D3D11CommandBuffer::SetUnorderedAccessViewsOnStages(
-    UINT startSlot, UINT count, ID3D11UnorderedAccessView* const* views, const UINT* initialCounts, long shaderStageFlags)
+static BufferDescriptor MakePushConstantsBufferDesc(unsigned int size)
 {
-    if (PS_STAGE(shaderStageFlags))
+    BufferDescriptor desc;
     {
-        /* Set UAVs for pixel shader stage */
-        context_->OMSetRenderTargetsAndUnorderedAccessViews(
-            D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr,
-            startSlot, count, views, initialCounts
-        );
+        desc.type   = BufferType::Constant;
+        desc.size   = size;
+        desc.flags  = BufferFlags::DynamicUsage;
     }
+    return desc;
+}
+
+void D3D11CommandBuffer::FlushPushConstants()
+{
+    if (!pushConstantsDirty_ || pushConstantsSize_ == 0)
+        return;
 
-    if (CS_STAGE(shaderStageFlags))
+    if (!IsDeferred() && stateMngr_.HasConstantBufferRanges())
     {
-        /* Set UAVs for compute shader stage */
-        context_->CSSetUnorderedAccessViews(startSlot, count, views, initialCounts);
+        /* Write push constants into a new range of the ring buffer, so previous draw commands can still read their ranges */
+        if (!pushConstantsRing_)
+        {
+            pushConstantsRing_ = MakeUnique<D3D11TransientBufferAllocator>(
+                GetContextDevice(context_.Get()).Get(), context_.Get(), g_pushConstantsRingSize
+            );
+        }
+
+        auto range          = pushConstantsRing_->Write(pushConstants_.data(), pushConstantsSize_);
+        auto resource       = LLGL_CAST(D3D11ConstantBuffer*, range.buffer)->Get();
+        UINT firstConstant  = range.offset / 16;
+        UINT numConstants   = range.size / 16;
+        stateMngr_.SetConstantBufferRanges(pushConstantsSlot_, 1, &resource, &firstConstant, &numConstants, ShaderStageFlags::AllGraphicsStages);
     }
+    else
+    {
+        /* Discard the entire push constants buffer, which is renamed by the driver (deferred contexts must always discard) */
+        if (!pushConstantsBuffer_)
+        {
+            pushConstantsBuffer_ = MakeUnique<D3D11ConstantBuffer>(
+                GetContextDevice(context_.Get()).Get(), MakePushConstantsBufferDesc(maxPushConstantsSize)
+            );
+        }
+
+        pushConstantsBuffer_->UpdateSubresource(context_.Get(), pushConstants_.data(), maxPushConstantsSize, 0);
+
+        ID3D11Buffer* buffers[] = { pushConstantsBuffer_->Get() };
+        stateMngr_.SetConstantBuffers(pushConstantsSlot_, 1, buffers, ShaderStageFlags::AllGraphicsStages);
+    }
+
+    pushConstantsDirty_ = false;
+}
+
+void D3D11CommandBuffer::StoreStreamOutputTargets(UINT numBuffers, ID3D11Buffer* const* buffers)
+{
+    numStreamOutputTargets_ = std::min(numBuffers, static_cast<UINT>(D3D11_SO_BUFFER_SLOT_COUNT));
+    std::copy(buffers, buffers + numStreamOutputTargets_, streamOutputTargets_.begin());
 }
 
-#undef VS_STAGE
-#undef HS_STAGE
-#undef DS_STAGE
-#undef GS_STAGE
-#undef PS_STAGE
-#undef CS_STAGE
 #undef SRV_STAGE
 
 
@@ -13,8 +13,14 @@
 #include <cstddef>
 #include "../DXCommon/ComPtr.h"
 #include "../DXCommon/DXCore.h"
+#include "RenderState/D3D11StateManager.h"
+#include "Buffer/D3D11TransientBufferAllocator.h"
+#include "Buffer/D3D11ConstantBuffer.h"
+#include <array>
 #include <vector>
+#include <memory>
 #include <d3d11.h>
+#include <d3d11_1.h>
 #include <dxgi.h>
 
 
@@ -22,18 +28,22 @@ namespace LLGL
 {
 
 
-class D3D11StateManager;
 class D3D11RenderTarget;
+class D3D11ShaderProgram;
 
-class D3D11CommandBuffer : public CommandBuffer
+class D3D11CommandBuffer final : public CommandBuffer
 {
 
     public:
 
         /* ----- Common ----- */
 
+        // Constructs an immediate command buffer for the specified immediate device context.
         D3D11CommandBuffer(D3D11StateManager& stateMngr, const ComPtr<ID3D11DeviceContext>& context);
 
+        // Constructs a deferred command buffer for the specified deferred device context.
+        D3D11CommandBuffer(const ComPtr<ID3D11DeviceContext>& deferredContext);
+
         /* ----- Configuration ----- */
 
         void SetGraphicsAPIDependentState(const GraphicsAPIDependentStateDescriptor& state) override;
@@ -44,6 +54,11 @@ class D3D11CommandBuffer : public CommandBuffer
         void SetScissor(const Scissor& scissor) override;
         void SetScissorArray(unsigned int numScissors, const Scissor* scissorArray) override;
 
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetDepthBounds(float minDepth, float maxDepth) override;
+
         void SetClearColor(const ColorRGBAf& color) override;
         void SetClearDepth(float depth) override;
         void SetClearStencil(int stencil) override;
@@ -53,23 +68,30 @@ class D3D11CommandBuffer : public CommandBuffer
 
         /* ----- Buffers ------ */
 
-        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer, unsigned int offset = 0) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
-        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer, unsigned int offset = 0) override;
         
         void SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         
         void SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
 
+        void ResetBufferCounter(Buffer& buffer, unsigned int value = 0) override;
+        void CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer) override;
+
         void SetStreamOutputBuffer(Buffer& buffer) override;
         void SetStreamOutputBufferArray(BufferArray& bufferArray) override;
 
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Textures ----- */
 
         void SetTexture(Texture& texture, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
@@ -80,26 +102,52 @@ class D3D11CommandBuffer : public CommandBuffer
         void SetSampler(Sampler& sampler, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
 
+        /* ----- Resource Heaps ----- */
+
+        void SetResourceHeap(ResourceHeap& resourceHeap) override;
+
         /* ----- Render Targets ----- */
 
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        /* ----- Render Passes ----- */
+
+        void BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc) override;
+        void BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc) override;
+
+        void EndRenderPass() override;
+
         /* ----- Pipeline States ----- */
 
         void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
         void SetComputePipeline(ComputePipeline& computePipeline) override;
 
+        void SetPushConstants(unsigned int offset, unsigned int size, const void* data) override;
+
+        void SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances) override;
+
         /* ----- Queries ----- */
 
         void BeginQuery(Query& query) override;
         void EndQuery(Query& query) override;
 
         bool QueryResult(Query& query, std::uint64_t& result) override;
+        bool QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results) override;
+        bool QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result) override;
+
+        void ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset) override;
 
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size) override;
+        void CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType) override;
+
         /* ----- Drawing ----- */
 
         void Draw(unsigned int numVertices, unsigned int firstVertex) override;
@@ -114,14 +162,52 @@ class D3D11CommandBuffer : public CommandBuffer
         void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset) override;
         void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset) override;
 
+        void DrawIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ) override;
+        void DispatchIndirect(Buffer& buffer, unsigned int offset) override;
+
+        void Barrier(long barrierFlags) override;
+        void StorageBarrier(Buffer& buffer) override;
+
+        /* ----- Command Recording ----- */
+
+        void Execute(CommandBuffer& deferredCommandBuffer) override;
+
+        void Reset() override;
 
         /* ----- Misc ----- */
 
+        void Signal(Fence& fence) override;
+
         void SyncGPU() override;
 
+        /* ----- Extended functions ----- */
+
+        /**
+        \brief Returns the command list of this deferred command buffer.
+        \remarks The first call to this function finishes the recording of the deferred context with "FinishCommandList".
+        Commands that are recorded afterwards are discarded by the next call to "Reset".
+        Returns null if this is an immediate command buffer.
+        */
+        ID3D11CommandList* GetCommandList();
+
+        // Returns true if this command buffer records into a deferred device context.
+        inline bool IsDeferred() const
+        {
+            return (deferredStateMngr_ != nullptr);
+        }
+
     private:
 
         struct D3D11FramebufferView
@@ -130,24 +216,52 @@ class D3D11CommandBuffer : public CommandBuffer
             ID3D11DepthStencilView*                 dsv = nullptr;
         };
 
+        // Maximum size (in bytes) of the push constants (see RenderingCaps::maxPushConstantsSize).
+        static const UINT maxPushConstantsSize = 128;
+
         void SubmitFramebufferView();
+        void ResolveBoundRenderTarget();
 
-        void SetConstantBuffersOnStages(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long shaderStageFlags);
-        void SetShaderResourcesOnStages(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long shaderStageFlags);
-        void SetSamplersOnStages(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long shaderStageFlags);
-        void SetUnorderedAccessViewsOnStages(UINT startSlot, UINT count, ID3D11UnorderedAccessView* const* views, const UINT* initialCounts, long shaderStageFlags);
+        void LoadRenderPassAttachments(const RenderPassDescriptor& renderPassDesc);
+        void DiscardRenderPassAttachments(bool discardResolvedAttachments);
 
-        void ResolveBoundRenderTarget();
+        // Writes the pending push constants into a constant buffer and submits all dirty graphics resources. Must be called before each draw command.
+        void FlushGraphicsResources();
 
-        D3D11StateManager&          stateMngr_;
-        
-        ComPtr<ID3D11DeviceContext> context_;
+        void FlushPushConstants();
+
+        // Stores the specified stream-output targets, so they can be bound again with "ResumeStreamOutput".
+        void StoreStreamOutputTargets(UINT numBuffers, ID3D11Buffer* const* buffers);
+
+        std::unique_ptr<D3D11StateManager>  deferredStateMngr_;
+        D3D11StateManager&                  stateMngr_;
+
+        ComPtr<ID3D11DeviceContext>         context_;
+        ComPtr<ID3D11DeviceContext1>        context1_;          // only available with Direct3D 11.1 runtime
+        ComPtr<ID3D11CommandList>           commandList_;
+
+        D3D11FramebufferView                framebufferView_;
+
+        D3DClearState                       clearState_;
+
+        D3D11RenderTarget*                  boundRenderTarget_  = nullptr;
+
+        RenderPassDescriptor                renderPassDesc_;
+
+        std::array<ID3D11Buffer*, D3D11_SO_BUFFER_SLOT_COUNT>   streamOutputTargets_;   // stream-output targets for "ResumeStreamOutput"
+        UINT                                                    numStreamOutputTargets_ = 0;
 
-        D3D11FramebufferView        framebufferView_;
+        std::array<char, maxPushConstantsSize>          pushConstants_;
+        UINT                                            pushConstantsSize_  = 0;
+        UINT                                            pushConstantsSlot_  = 0;
+        bool                                            pushConstantsDirty_ = false;
 
-        D3DClearState               clearState_;
+        D3D11ShaderProgram*                             boundGraphicsProgram_   = nullptr;
+        D3D11ShaderProgram*                             boundComputeProgram_    = nullptr;
+        std::vector<ID3D11ClassInstance*>               classInstances_;        // intermediate array for "SetShaderClassInstances"
 
-        D3D11RenderTarget*          boundRenderTarget_  = nullptr;
+        std::unique_ptr<D3D11TransientBufferAllocator>  pushConstantsRing_;     // only for immediate contexts with Direct3D 11.1 runtime
+        std::unique_ptr<D3D11ConstantBuffer>            pushConstantsBuffer_;   // fallback for deferred contexts and Direct3D 11.0 runtime
 
 };
 
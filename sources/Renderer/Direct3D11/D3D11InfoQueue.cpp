@@ -0,0 +1,79 @@
+/*
+ * D3D11InfoQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11InfoQueue.h"
+#include "../../Core/HelperMacros.h"
+
+
+namespace LLGL
+{
+
+
+D3D11InfoQueue::D3D11InfoQueue(ID3D11Device* device, RenderingDebugger* debugger, std::uint32_t messageLimit) :
+    driverMessages_ { debugger, messageLimit, "Direct3D11" }
+{
+    if (FAILED(device->QueryInterface(IID_PPV_ARGS(infoQueue_.ReleaseAndGetAddressOf()))))
+        LLGL_LOG(Warning, "failed to query D3D11 info queue (the debug layer requires the Windows SDK)");
+}
+
+// Determines the category of the specified D3D11 message, or returns false if the message is only informational.
+static bool D3D11GetDriverMessageCategory(const D3D11_MESSAGE& message, DriverMessageCategory& category)
+{
+    switch (message.Severity)
+    {
+        case D3D11_MESSAGE_SEVERITY_CORRUPTION:
+        case D3D11_MESSAGE_SEVERITY_ERROR:
+            category = DriverMessageCategory::Error;
+            return true;
+
+        case D3D11_MESSAGE_SEVERITY_WARNING:
+            /* Warnings about resource hazards and execution are hidden stalls, e.g. resources that are unbound because they are bound as output */
+            if (message.Category == D3D11_MESSAGE_CATEGORY_EXECUTION || message.Category == D3D11_MESSAGE_CATEGORY_RESOURCE_MANIPULATION)
+                category = DriverMessageCategory::Performance;
+            else
+                category = DriverMessageCategory::ImproperUsage;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void D3D11InfoQueue::PostStoredMessages()
+{
+    if (!infoQueue_)
+        return;
+
+    const auto numMessages = infoQueue_->GetNumStoredMessagesAllowedByRetrievalFilter();
+
+    for (UINT64 i = 0; i < numMessages; ++i)
+    {
+        /* Query size of the message, then read the message into the temporary buffer */
+        SIZE_T messageSize = 0;
+        if (FAILED(infoQueue_->GetMessage(i, nullptr, &messageSize)))
+            continue;
+
+        messageBuffer_.resize(messageSize);
+        auto message = reinterpret_cast<D3D11_MESSAGE*>(messageBuffer_.data());
+
+        if (SUCCEEDED(infoQueue_->GetMessage(i, message, &messageSize)))
+        {
+            DriverMessageCategory category;
+            if (D3D11GetDriverMessageCategory(*message, category))
+                driverMessages_.Post(category, static_cast<std::uint32_t>(message->ID), message->pDescription);
+        }
+    }
+
+    infoQueue_->ClearStoredMessages();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,50 @@
+/*
+ * D3D11InfoQueue.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_INFO_QUEUE_H
+#define LLGL_D3D11_INFO_QUEUE_H
+
+
+#include "../DriverMessageBridge.h"
+#include "../DXCommon/ComPtr.h"
+#include <d3d11.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Reads the messages of the D3D11 debug layer from the info queue of the device and posts them to the driver debugger.
+class D3D11InfoQueue
+{
+
+    public:
+
+        // Queries the info queue of the specified device, which is only available if the device has been created with D3D11_CREATE_DEVICE_DEBUG.
+        D3D11InfoQueue(ID3D11Device* device, RenderingDebugger* debugger, std::uint32_t messageLimit);
+
+        // Posts all stored messages to the driver debugger and clears the info queue.
+        void PostStoredMessages();
+
+    private:
+
+        ComPtr<ID3D11InfoQueue> infoQueue_;
+        DriverMessageBridge     driverMessages_;
+        std::vector<char>       messageBuffer_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
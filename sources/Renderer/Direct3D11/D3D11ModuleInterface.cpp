@@ -27,9 +27,9 @@ LLGL_EXPORT const char* LLGL_RenderSystem_Name()
     return "Direct3D 11";
 }
 
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc()
+LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const LLGL::RenderSystemDescriptor* renderSystemDesc)
 {
-    return new LLGL::D3D11RenderSystem();
+    return new LLGL::D3D11RenderSystem(*renderSystemDesc);
 }
 
 }
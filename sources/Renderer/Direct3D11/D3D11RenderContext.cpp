@@ -7,8 +7,13 @@
 
 #include "D3D11RenderContext.h"
 #include "D3D11RenderSystem.h"
+#include "Texture/D3D11Texture.h"
+#include "../CheckedCast.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include "../../Core/Helper.h"
+#include "../DXCommon/DXCore.h"
+#include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -20,25 +25,105 @@ D3D11RenderContext::D3D11RenderContext(
     const ComPtr<ID3D11Device>& device,
     const ComPtr<ID3D11DeviceContext>& context,
     const RenderContextDescriptor& desc,
-    const std::shared_ptr<Surface>& surface) :
-        device_  { device  },
-        context_ { context },
-        desc_    { desc    }
+    const std::shared_ptr<Surface>& surface,
+    D3D11InfoQueue* infoQueue) :
+        device_    { device    },
+        context_   { context   },
+        desc_      { desc      },
+        infoQueue_ { infoQueue }
 {
-    /* Setup surface for the render context */
-    SetOrCreateSurface(surface, desc_.videoMode, nullptr);
+    if (desc_.headless)
+    {
+        /* Setup surface without window, the back buffer is then an offscreen texture */
+        SetHeadlessSurface(desc_.videoMode);
+    }
+    else
+    {
+        /* Setup surface for the render context and create swap chain */
+        SetOrCreateSurface(surface, desc_.videoMode, nullptr);
+        CreateSwapChain(factory);
+    }
 
     /* Create D3D objects */
-    CreateSwapChain(factory);
     CreateBackBuffer(desc.videoMode.resolution.x, desc.videoMode.resolution.y);
 
     /* Initialize v-sync */
     SetVsync(desc_.vsync);
 }
 
+D3D11RenderContext::~D3D11RenderContext()
+{
+    /* Swap chain must be in windowed mode when it is released */
+    if (swapChain_)
+        swapChain_->SetFullscreenState(FALSE, nullptr);
+    if (frameLatencyObject_)
+        CloseHandle(frameLatencyObject_);
+}
+
 void D3D11RenderContext::Present()
 {
-    swapChain_->Present(swapChainInterval_, 0);
+    PresentWithInterval(swapChainInterval_);
+}
+
+void D3D11RenderContext::PresentWithoutVsync()
+{
+    PresentWithInterval(0);
+}
+
+void D3D11RenderContext::WaitForNextFrame()
+{
+    /* Pace frames to the target frame rate, then wait until the swap chain can queue another frame */
+    RenderContext::WaitForNextFrame();
+    if (frameLatencyObject_)
+        WaitForSingleObjectEx(frameLatencyObject_, 1000, TRUE);
+}
+
+bool D3D11RenderContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    return (swapChain_ ? DXGetFrameStatistics(swapChain_.Get(), stats) : false);
+}
+
+bool D3D11RenderContext::IsOccluded() const
+{
+    return (occluded_ || RenderContext::IsOccluded());
+}
+
+bool D3D11RenderContext::TestPresent()
+{
+    if (swapChain_)
+        occluded_ = (swapChain_->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED);
+    return !IsOccluded();
+}
+
+void D3D11RenderContext::CopyBackBuffer(Texture& dstTexture)
+{
+    auto& textureD3D = LLGL_CAST(D3D11Texture&, dstTexture);
+    if (textureD3D.GetType() != TextureType::Texture2D)
+        throw std::invalid_argument("back buffer can only be copied into a 2D texture");
+
+    auto dstResource = textureD3D.GetHardwareTexture().resource.Get();
+
+    if (backBuffer_.colorBufferMS)
+    {
+        /* Resolve multi-sampled back buffer directly into the destination texture (sizes must match) */
+        context_->ResolveSubresource(dstResource, 0, backBuffer_.colorBufferMS.Get(), 0, DXGI_FORMAT_R8G8B8A8_UNORM);
+    }
+    else
+    {
+        /* Copy region of the back buffer that is covered by the texture */
+        auto size = textureD3D.QueryMipLevelSize(0);
+
+        D3D11_BOX srcBox;
+        {
+            srcBox.left     = 0;
+            srcBox.top      = 0;
+            srcBox.front    = 0;
+            srcBox.right    = std::min(static_cast<UINT>(size.x), static_cast<UINT>(GetVideoMode().resolution.x));
+            srcBox.bottom   = std::min(static_cast<UINT>(size.y), static_cast<UINT>(GetVideoMode().resolution.y));
+            srcBox.back     = 1;
+        }
+        context_->CopySubresourceRegion(dstResource, 0, 0, 0, 0, backBuffer_.colorBuffer.Get(), 0, &srcBox);
+    }
 }
 
 /* ----- Configuration ----- */
@@ -60,7 +145,7 @@ void D3D11RenderContext::SetVideoMode(const VideoModeDescriptor& videoModeDesc)
         }
 
         /* Switch fullscreen mode */
-        if (prevVideoMode.fullscreen != videoModeDesc.fullscreen)
+        if (swapChain_ && prevVideoMode.fullscreen != videoModeDesc.fullscreen)
             swapChain_->SetFullscreenState(videoModeDesc.fullscreen ? TRUE : FALSE, nullptr);
     }
 }
@@ -76,42 +161,186 @@ void D3D11RenderContext::SetVsync(const VsyncDescriptor& vsyncDesc)
  * ======= Private: =======
  */
 
+void D3D11RenderContext::PresentWithInterval(UINT syncInterval)
+{
+    /* Resolve multi-sampled color buffer into the swap-chain buffer */
+    if (backBuffer_.colorBufferMS)
+        context_->ResolveSubresource(backBuffer_.colorBuffer.Get(), 0, backBuffer_.colorBufferMS.Get(), 0, DXGI_FORMAT_R8G8B8A8_UNORM);
+
+    if (swapChain_)
+    {
+        /* Allow tearing when Vsync is disabled (not allowed in exclusive fullscreen mode) */
+        UINT flags = 0;
+        if (swapChainInterval_ == 0 && tearingSupported_ && !GetVideoMode().fullscreen)
+            flags |= DXGI_PRESENT_ALLOW_TEARING;
+
+        occluded_ = (swapChain_->Present(syncInterval, flags) == DXGI_STATUS_OCCLUDED);
+    }
+    else
+        context_->Flush();
+
+    /* Post the driver messages of this frame */
+    if (infoQueue_ != nullptr)
+        infoQueue_->PostStoredMessages();
+}
+
 void D3D11RenderContext::CreateSwapChain(IDXGIFactory* factory)
 {
     /* Create swap chain for window handle */
     NativeHandle wndHandle;
     GetSurface().GetNativeHandle(&wndHandle);
 
-    DXGI_SWAP_CHAIN_DESC swapChainDesc;
+    ComPtr<IDXGIFactory2> factory2;
+    if (SUCCEEDED(factory->QueryInterface(IID_PPV_ARGS(&factory2))))
+    {
+        /* Create flip model swap chain (requires DXGI 1.2) */
+        CreateSwapChainFlipModel(factory2.Get(), wndHandle.window);
+    }
+    else
+    {
+        /* Create legacy blit model swap chain (multi-sampling is done with a separate color buffer for both models) */
+        DXGI_SWAP_CHAIN_DESC swapChainDesc;
+        InitMemory(swapChainDesc);
+        {
+            swapChainDesc.BufferDesc.Width                      = desc_.videoMode.resolution.x;
+            swapChainDesc.BufferDesc.Height                     = desc_.videoMode.resolution.y;
+            swapChainDesc.BufferDesc.Format                     = DXGI_FORMAT_R8G8B8A8_UNORM;
+            swapChainDesc.BufferDesc.RefreshRate.Numerator      = desc_.vsync.refreshRate;
+            swapChainDesc.BufferDesc.RefreshRate.Denominator    = desc_.vsync.interval;
+            swapChainDesc.SampleDesc.Count                      = 1;
+            swapChainDesc.SampleDesc.Quality                    = 0;
+            swapChainDesc.BufferUsage                           = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+            swapChainDesc.BufferCount                           = (desc_.videoMode.swapChainMode == SwapChainMode::TripleBuffering ? 2 : 1);
+            swapChainDesc.OutputWindow                          = wndHandle.window;
+            swapChainDesc.Windowed                              = (desc_.videoMode.fullscreen ? FALSE : TRUE);
+            swapChainDesc.SwapEffect                            = DXGI_SWAP_EFFECT_DISCARD;
+        }
+        auto hr = factory->CreateSwapChain(device_.Get(), &swapChainDesc, swapChain_.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create DXGI swap chain");
+    }
+
+    SetMaximumFrameLatency();
+}
+
+void D3D11RenderContext::CreateSwapChainFlipModel(IDXGIFactory2* factory, HWND wnd)
+{
+    /* Use flip-discard model if available (requires DXGI 1.4), otherwise flip-sequential model */
+    ComPtr<IDXGIFactory4> factory4;
+    const bool flipDiscard = SUCCEEDED(factory->QueryInterface(IID_PPV_ARGS(&factory4)));
+
+    /* Setup swap chain flags for tearing and frame latency waitable object (requires DXGI 1.3) */
+    tearingSupported_ = DXIsTearingSupported(factory);
+
+    if (tearingSupported_)
+        swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+
+    ComPtr<IDXGIFactory3> factory3;
+    if (desc_.maxFrameLatency > 0 && SUCCEEDED(factory->QueryInterface(IID_PPV_ARGS(&factory3))))
+        swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+
+    DXGI_SWAP_CHAIN_DESC1 swapChainDesc;
     InitMemory(swapChainDesc);
     {
-        swapChainDesc.BufferDesc.Width                      = desc_.videoMode.resolution.x;
-        swapChainDesc.BufferDesc.Height                     = desc_.videoMode.resolution.y;
-        swapChainDesc.BufferDesc.Format                     = DXGI_FORMAT_R8G8B8A8_UNORM;
-        swapChainDesc.BufferDesc.RefreshRate.Numerator      = desc_.vsync.refreshRate;
-        swapChainDesc.BufferDesc.RefreshRate.Denominator    = desc_.vsync.interval;
-        swapChainDesc.SampleDesc.Count                      = (desc_.multiSampling.enabled ? std::max(1u, desc_.multiSampling.samples) : 1);
-        swapChainDesc.SampleDesc.Quality                    = 0;
-        swapChainDesc.BufferUsage                           = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-        swapChainDesc.BufferCount                           = (desc_.videoMode.swapChainMode == SwapChainMode::TripleBuffering ? 2 : 1);
-        swapChainDesc.OutputWindow                          = wndHandle.window;
-        swapChainDesc.Windowed                              = (desc_.videoMode.fullscreen ? FALSE : TRUE);
-        swapChainDesc.SwapEffect                            = DXGI_SWAP_EFFECT_DISCARD;
-    }
-    auto hr = factory->CreateSwapChain(device_.Get(), &swapChainDesc, swapChain_.ReleaseAndGetAddressOf());
+        swapChainDesc.Width                 = desc_.videoMode.resolution.x;
+        swapChainDesc.Height                = desc_.videoMode.resolution.y;
+        swapChainDesc.Format                = DXGI_FORMAT_R8G8B8A8_UNORM;
+        swapChainDesc.Stereo                = FALSE;
+        swapChainDesc.SampleDesc.Count      = 1; // always 1 because flip model swap-chains can not be multi-sampled
+        swapChainDesc.SampleDesc.Quality    = 0;
+        swapChainDesc.BufferUsage           = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+        swapChainDesc.BufferCount           = std::max(2u, static_cast<UINT>(desc_.videoMode.swapChainMode));
+        swapChainDesc.Scaling               = DXGI_SCALING_STRETCH;
+        swapChainDesc.SwapEffect            = (flipDiscard ? DXGI_SWAP_EFFECT_FLIP_DISCARD : DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL);
+        swapChainDesc.AlphaMode             = DXGI_ALPHA_MODE_IGNORE;
+        swapChainDesc.Flags                 = swapChainFlags_;
+    }
+    ComPtr<IDXGISwapChain1> swapChain1;
+    auto hr = factory->CreateSwapChainForHwnd(device_.Get(), wnd, &swapChainDesc, nullptr, nullptr, swapChain1.ReleaseAndGetAddressOf());
     DXThrowIfFailed(hr, "failed to create DXGI swap chain");
+
+    swapChain1.As(&swapChain_);
+
+    if (desc_.videoMode.fullscreen)
+        swapChain_->SetFullscreenState(TRUE, nullptr);
+}
+
+void D3D11RenderContext::SetMaximumFrameLatency()
+{
+    if (desc_.maxFrameLatency == 0)
+        return;
+
+    const auto maxFrameLatency = std::min(desc_.maxFrameLatency, 16u);
+
+    if ((swapChainFlags_ & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) != 0)
+    {
+        /* Set frame latency for this swap chain and get its waitable object */
+        ComPtr<IDXGISwapChain2> swapChain2;
+        if (SUCCEEDED(swapChain_.As(&swapChain2)))
+        {
+            swapChain2->SetMaximumFrameLatency(maxFrameLatency);
+            frameLatencyObject_ = swapChain2->GetFrameLatencyWaitableObject();
+        }
+    }
+    else
+    {
+        /* Set frame latency for the entire device (Present blocks instead of a waitable object) */
+        ComPtr<IDXGIDevice1> dxgiDevice;
+        if (SUCCEEDED(device_.As(&dxgiDevice)))
+            dxgiDevice->SetMaximumFrameLatency(maxFrameLatency);
+    }
 }
 
 void D3D11RenderContext::CreateBackBuffer(UINT width, UINT height)
 {
     HRESULT hr = 0;
 
-    /* Get back buffer from swap chain */
-    hr = swapChain_->GetBuffer(0, IID_PPV_ARGS(backBuffer_.colorBuffer.ReleaseAndGetAddressOf()));
-    DXThrowIfFailed(hr, "failed to get D3D11 back buffer from swap chain");
+    if (swapChain_)
+    {
+        /* Get back buffer from swap chain */
+        hr = swapChain_->GetBuffer(0, IID_PPV_ARGS(backBuffer_.colorBuffer.ReleaseAndGetAddressOf()));
+        DXThrowIfFailed(hr, "failed to get D3D11 back buffer from swap chain");
+    }
+    else
+    {
+        /* Create offscreen back buffer for headless render context */
+        D3D11_TEXTURE2D_DESC colorDesc;
+        {
+            colorDesc.Width                 = width;
+            colorDesc.Height                = height;
+            colorDesc.MipLevels             = 1;
+            colorDesc.ArraySize             = 1;
+            colorDesc.Format                = DXGI_FORMAT_R8G8B8A8_UNORM;
+            colorDesc.SampleDesc.Count      = 1;
+            colorDesc.SampleDesc.Quality    = 0;
+            colorDesc.Usage                 = D3D11_USAGE_DEFAULT;
+            colorDesc.BindFlags             = D3D11_BIND_RENDER_TARGET;
+            colorDesc.CPUAccessFlags        = 0;
+            colorDesc.MiscFlags             = 0;
+        }
+        hr = device_->CreateTexture2D(&colorDesc, nullptr, backBuffer_.colorBuffer.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 offscreen back buffer for headless render context");
+    }
+
+    if (desc_.multiSampling.enabled && desc_.multiSampling.samples > 1)
+    {
+        /* Create multi-sampled color buffer, since the swap-chain buffers are never multi-sampled */
+        D3D11_TEXTURE2D_DESC colorDesc;
+        backBuffer_.colorBuffer->GetDesc(&colorDesc);
+        {
+            colorDesc.SampleDesc.Count      = desc_.multiSampling.samples;
+            colorDesc.SampleDesc.Quality    = 0;
+            colorDesc.Usage                 = D3D11_USAGE_DEFAULT;
+            colorDesc.BindFlags             = D3D11_BIND_RENDER_TARGET;
+            colorDesc.CPUAccessFlags        = 0;
+            colorDesc.MiscFlags             = 0;
+        }
+        hr = device_->CreateTexture2D(&colorDesc, nullptr, backBuffer_.colorBufferMS.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 multi-sampled color buffer for back buffer");
+    }
 
     /* Create back buffer RTV */
-    hr = device_->CreateRenderTargetView(backBuffer_.colorBuffer.Get(), nullptr, backBuffer_.rtv.ReleaseAndGetAddressOf());
+    auto renderTarget = (backBuffer_.colorBufferMS ? backBuffer_.colorBufferMS.Get() : backBuffer_.colorBuffer.Get());
+    hr = device_->CreateRenderTargetView(renderTarget, nullptr, backBuffer_.rtv.ReleaseAndGetAddressOf());
     DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) for back buffer");
 
     /* Create depth stencil texture */
@@ -156,13 +385,17 @@ void D3D11RenderContext::ResizeBackBuffer(UINT width, UINT height)
 
     /* Release buffers */
     backBuffer_.colorBuffer.Reset();
+    backBuffer_.colorBufferMS.Reset();
     backBuffer_.rtv.Reset();
     backBuffer_.depthStencil.Reset();
     backBuffer_.dsv.Reset();
 
-    /* Resize swap-chain buffers, let DXGI find out the client area, and preserve buffer count and format */
-    auto hr = swapChain_->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, 0);
-    DXThrowIfFailed(hr, "failed to resize DXGI swap-chain buffers");
+    if (swapChain_)
+    {
+        /* Resize swap-chain buffers, let DXGI find out the client area, and preserve buffer count, format, and flags */
+        auto hr = swapChain_->ResizeBuffers(0, 0, 0, DXGI_FORMAT_UNKNOWN, swapChainFlags_);
+        DXThrowIfFailed(hr, "failed to resize DXGI swap-chain buffers");
+    }
 
     /* Recreate back buffer and reset default render target */
     CreateBackBuffer(width, height);
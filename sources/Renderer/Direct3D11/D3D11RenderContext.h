@@ -11,8 +11,9 @@
 
 #include <LLGL/RenderContext.h>
 #include "../DXCommon/ComPtr.h"
+#include "D3D11InfoQueue.h"
 #include <d3d11.h>
-#include <dxgi.h>
+#include <dxgi1_5.h>
 
 
 namespace LLGL
@@ -23,13 +24,14 @@ namespace LLGL
 struct D3D11BackBuffer
 {
     ComPtr<ID3D11Texture2D>         colorBuffer;
+    ComPtr<ID3D11Texture2D>         colorBufferMS;  // multi-sampled color buffer, which is resolved into 'colorBuffer' on present
     ComPtr<ID3D11RenderTargetView>  rtv;
     ComPtr<ID3D11Texture2D>         depthStencil;
     ComPtr<ID3D11DepthStencilView>  dsv;
 };
 
 
-class D3D11RenderContext : public RenderContext
+class D3D11RenderContext final : public RenderContext
 {
 
     public:
@@ -41,10 +43,23 @@ class D3D11RenderContext : public RenderContext
             const ComPtr<ID3D11Device>& device,
             const ComPtr<ID3D11DeviceContext>& context,
             const RenderContextDescriptor& desc,
-            const std::shared_ptr<Surface>& surface
+            const std::shared_ptr<Surface>& surface,
+            D3D11InfoQueue* infoQueue = nullptr
         );
 
+        ~D3D11RenderContext();
+
         void Present() override;
+        void PresentWithoutVsync() override;
+
+        void WaitForNextFrame() override;
+
+        bool QueryFrameStatistics(FrameStatistics& stats) override;
+
+        bool IsOccluded() const override;
+        bool TestPresent() override;
+
+        void CopyBackBuffer(Texture& dstTexture) override;
 
         /* ----- Configuration ----- */
 
@@ -60,7 +75,12 @@ class D3D11RenderContext : public RenderContext
 
     private:
 
+        // Presents the swap-chain with the specified sync interval (0 for no Vsync).
+        void PresentWithInterval(UINT syncInterval);
+
         void CreateSwapChain(IDXGIFactory* factory);
+        void CreateSwapChainFlipModel(IDXGIFactory2* factory, HWND wnd);
+        void SetMaximumFrameLatency();
         void CreateBackBuffer(UINT width, UINT height);
         void ResizeBackBuffer(UINT width, UINT height);
 
@@ -71,9 +91,15 @@ class D3D11RenderContext : public RenderContext
 
         ComPtr<IDXGISwapChain>      swapChain_;
         UINT                        swapChainInterval_  = 0;
+        UINT                        swapChainFlags_     = 0;
+        HANDLE                      frameLatencyObject_ = nullptr;
+        bool                        tearingSupported_   = false;
+        bool                        occluded_           = false;    // DXGI_STATUS_OCCLUDED of the last presentation
 
         D3D11BackBuffer             backBuffer_;
 
+        D3D11InfoQueue*             infoQueue_          = nullptr; // only used if there is a driver debugger
+
 };
 
 
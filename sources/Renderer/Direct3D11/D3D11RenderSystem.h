@@ -14,14 +14,21 @@
 
 #include "D3D11CommandBuffer.h"
 #include "D3D11RenderContext.h"
+#include "D3D11InfoQueue.h"
 
 #include "Buffer/D3D11Buffer.h"
 #include "Buffer/D3D11BufferArray.h"
+#include "Buffer/D3D11TransientBufferAllocator.h"
+#include "Buffer/D3D11Readback.h"
 
 #include "RenderState/D3D11GraphicsPipeline.h"
 #include "RenderState/D3D11ComputePipeline.h"
 #include "RenderState/D3D11StateManager.h"
+#include "RenderState/D3D11RenderStateCache.h"
 #include "RenderState/D3D11Query.h"
+#include "RenderState/D3D11QueryArray.h"
+#include "RenderState/D3D11Fence.h"
+#include "RenderState/D3D11ResourceHeap.h"
 
 #include "Shader/D3D11Shader.h"
 #include "Shader/D3D11ShaderProgram.h"
@@ -31,9 +38,13 @@
 #include "Texture/D3D11Sampler.h"
 #include "Texture/D3D11SamplerArray.h"
 #include "Texture/D3D11RenderTarget.h"
+#include "Texture/D3D11ImageConverter.h"
 
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
 #include "../DXCommon/ComPtr.h"
+#include "../../Core/ThreadPool.h"
+#include <mutex>
 #include <d3d11.h>
 #include <dxgi.h>
 
@@ -42,14 +53,14 @@ namespace LLGL
 {
 
 
-class D3D11RenderSystem : public RenderSystem
+class D3D11RenderSystem final : public RenderSystem
 {
 
     public:
 
         /* ----- Common ----- */
 
-        D3D11RenderSystem();
+        D3D11RenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~D3D11RenderSystem();
 
         /* ----- Render Context ------ */
@@ -60,7 +71,9 @@ class D3D11RenderSystem : public RenderSystem
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
+
+        void ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray) override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
@@ -75,12 +88,18 @@ class D3D11RenderSystem : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const BufferCPUAccess access) override;
+        void* MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags = 0) override;
+        void FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        TransientBufferRange WriteTransientConstantBuffer(const void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc = nullptr) override;
         TextureArray* CreateTextureArray(unsigned int numTextures, Texture* const * textureArray) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
+        Texture* CreateSparseTexture(const TextureDescriptor& textureDesc) override;
 
         void Release(Texture& texture) override;
         void Release(TextureArray& textureArray) override;
@@ -93,6 +112,12 @@ class D3D11RenderSystem : public RenderSystem
 
         void GenerateMips(Texture& texture) override;
 
+        std::uint64_t GetBindlessTextureHandle(Texture& texture, Sampler* sampler = nullptr) override;
+
+        void CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit) override;
+        bool IsSparseTextureResident(const Texture& texture, const TextureRegion& region) override;
+        Gs::Vector3ui QuerySparseTexturePageSize(const Texture& texture) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
@@ -101,6 +126,12 @@ class D3D11RenderSystem : public RenderSystem
         void Release(Sampler& sampler) override;
         void Release(SamplerArray& samplerArray) override;
 
+        /* ----- Resource Heaps ----- */
+
+        ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
+
+        void Release(ResourceHeap& resourceHeap) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
@@ -118,6 +149,7 @@ class D3D11RenderSystem : public RenderSystem
         /* ----- Pipeline States ----- */
 
         GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) override;
+        std::shared_future<GraphicsPipeline*> CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc) override;
         ComputePipeline* CreateComputePipeline(const ComputePipelineDescriptor& desc) override;
         
         void Release(GraphicsPipeline& graphicsPipeline) override;
@@ -126,8 +158,32 @@ class D3D11RenderSystem : public RenderSystem
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
+        QueryArray* CreateQueryArray(unsigned int numQueries, Query* const * queryArray) override;
 
         void Release(Query& query) override;
+        void Release(QueryArray& queryArray) override;
+
+        /* ----- Readbacks ----- */
+
+        Readback* ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType) override;
+        Readback* ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize) override;
+
+        void Release(Readback& readback) override;
+
+        /* ----- Uploads ----- */
+
+        Fence* WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
+        Fence* WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc) override;
+
+        /* ----- Fences ----- */
+
+        Fence* CreateFence() override;
+
+        void Release(Fence& fence) override;
+
+        /* ----- Memory ----- */
+
+        MemoryInfo QueryMemoryInfo() override;
 
         /* ----- Extended internal functions ----- */
 
@@ -145,7 +201,8 @@ class D3D11RenderSystem : public RenderSystem
         
         void CreateFactory();
         void QueryVideoAdapters();
-        void CreateDevice(IDXGIAdapter* adapter);
+        void CreateDevice(const RenderSystemDescriptor& renderSystemDesc);
+        bool CreateDevice(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, bool debugDevice, HRESULT& hr);
         bool CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, UINT flags, HRESULT& hr);
         void InitStateManager();
 
@@ -156,6 +213,9 @@ class D3D11RenderSystem : public RenderSystem
         void BuildGenericTexture2D(D3D11Texture& textureD3D, const TextureDescriptor& descD3D, const ImageDescriptor* imageDesc, UINT miscFlags);
         void BuildGenericTexture3D(D3D11Texture& textureD3D, const TextureDescriptor& descD3D, const ImageDescriptor* imageDesc, UINT miscFlags);
         void BuildGenericTexture2DMS(D3D11Texture& textureD3D, const TextureDescriptor& descD3D);
+
+        // Clears the first MIP-map level of the specified texture on the GPU with the default image initialization (see RenderSystemConfiguration).
+        void InitializeGenericTexture(D3D11Texture& textureD3D, const TextureDescriptor& descD3D);
         
         void UpdateGenericTexture(
             Texture& texture, unsigned int mipLevel, unsigned int layer,
@@ -163,14 +223,26 @@ class D3D11RenderSystem : public RenderSystem
             const ImageDescriptor& imageDesc
         );
 
+        // Updates a subresource of the specified texture and converts the image on the GPU if possible (see D3D11ImageConverter), or on the CPU otherwise.
+        void UpdateTextureSubresource(D3D11Texture& textureD3D, UINT mipSlice, UINT arraySlice, const D3D11_BOX& dstBox, const ImageDescriptor& imageDesc);
+
+        // Creates a new fence and signals it on the immediate context after all commands that have been submitted so far.
+        Fence* SignalNewFence();
+
         /* ----- Common objects ----- */
 
         ComPtr<IDXGIFactory>                        factory_;
         ComPtr<ID3D11Device>                        device_;
         ComPtr<ID3D11DeviceContext>                 context_;
+        ComPtr<ID3D11Device2>                       device2_;       // only available with Direct3D 11.2 runtime
+        ComPtr<ID3D11DeviceContext2>                context2_;      // only available with Direct3D 11.2 runtime
         D3D_FEATURE_LEVEL                           featureLevel_ = D3D_FEATURE_LEVEL_9_1;
 
+        std::unique_ptr<D3D11InfoQueue>             infoQueue_;     // only created if there is a driver debugger
+
         std::unique_ptr<D3D11StateManager>          stateMngr_;
+        std::unique_ptr<D3D11RenderStateCache>      renderStateCache_;
+        std::unique_ptr<D3D11ImageConverter>        imageConverter_;    // created with the first GPU image conversion
 
         /* ----- Hardware object containers ----- */
 
@@ -180,14 +252,20 @@ class D3D11RenderSystem : public RenderSystem
         HWObjectContainer<D3D11BufferArray>         bufferArrays_;
         HWObjectContainer<D3D11Texture>             textures_;
         HWObjectContainer<D3D11TextureArray>        textureArrays_;
-        HWObjectContainer<D3D11Sampler>             samplers_;
+        SamplerCache<D3D11Sampler>                  samplers_;
         HWObjectContainer<D3D11SamplerArray>        samplerArrays_;
+        HWObjectContainer<D3D11ResourceHeap>        resourceHeaps_;
         HWObjectContainer<D3D11RenderTarget>        renderTargets_;
         HWObjectContainer<D3D11Shader>              shaders_;
         HWObjectContainer<D3D11ShaderProgram>       shaderPrograms_;
         HWObjectContainer<D3D11GraphicsPipeline>    graphicsPipelines_;
         HWObjectContainer<D3D11ComputePipeline>     computePipelines_;
         HWObjectContainer<D3D11Query>               queries_;
+        HWObjectContainer<D3D11QueryArray>          queryArrays_;
+        HWObjectContainer<D3D11Readback>            readbacks_;
+        HWObjectContainer<D3D11Fence>               fences_;
+
+        std::unique_ptr<D3D11TransientBufferAllocator> transientConstantBuffer_;
 
         /* ----- Other members ----- */
 
@@ -195,6 +273,9 @@ class D3D11RenderSystem : public RenderSystem
 
         BufferCPUAccess                             mappedBufferCPUAccess_  = BufferCPUAccess::ReadOnly;
 
+        std::mutex                                  pipelineMutex_;
+        std::mutex                                  contextMutex_;          // guards the immediate context while textures are created and updated
+
 };
 
 
@@ -11,6 +11,7 @@
 #include "../CheckedCast.h"
 #include "../Assertion.h"
 #include "../../Core/Helper.h"
+#include "../../Core/Exception.h"
 #include "../../Core/Vendor.h"
 #include <sstream>
 #include <iomanip>
@@ -29,12 +30,12 @@ namespace LLGL
 {
 
 
-D3D11RenderSystem::D3D11RenderSystem()
+D3D11RenderSystem::D3D11RenderSystem(const RenderSystemDescriptor& renderSystemDesc)
 {
     /* Create DXGU factory, query video adapters, and create D3D11 device */
     CreateFactory();
     QueryVideoAdapters();
-    CreateDevice(nullptr);
+    CreateDevice(renderSystemDesc);
 
     /* Initialize states and renderer information */
     InitStateManager();
@@ -44,6 +45,8 @@ D3D11RenderSystem::D3D11RenderSystem()
 
 D3D11RenderSystem::~D3D11RenderSystem()
 {
+    /* Finish all asynchronous tasks before the resources they might refer to are released */
+    GetSharedThreadPool()->WaitIdle();
 }
 
 /* ----- Render Context ----- */
@@ -52,7 +55,7 @@ RenderContext* D3D11RenderSystem::CreateRenderContext(const RenderContextDescrip
 {
     return TakeOwnership(
         renderContexts_,
-        MakeUnique<D3D11RenderContext>(factory_.Get(), device_, context_, desc, surface)
+        MakeUnique<D3D11RenderContext>(factory_.Get(), device_, context_, desc, surface, infoQueue_.get())
     );
 }
 
@@ -63,11 +66,34 @@ void D3D11RenderSystem::Release(RenderContext& renderContext)
 
 /* ----- Command buffers ----- */
 
-CommandBuffer* D3D11RenderSystem::CreateCommandBuffer()
+CommandBuffer* D3D11RenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
+    if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
+    {
+        /* Create deferred command buffer with its own deferred device context */
+        ComPtr<ID3D11DeviceContext> deferredContext;
+        auto hr = device_->CreateDeferredContext(0, deferredContext.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 deferred device context");
+
+        return TakeOwnership(commandBuffers_, MakeUnique<D3D11CommandBuffer>(deferredContext));
+    }
+
+    /* Create immediate command buffer */
     return TakeOwnership(commandBuffers_, MakeUnique<D3D11CommandBuffer>(*stateMngr_, context_));
 }
 
+void D3D11RenderSystem::ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray)
+{
+    LLGL_ASSERT_PTR(commandBufferArray);
+
+    /* Execute command lists of all deferred contexts on the immediate context */
+    while (auto commandBuffer = NextArrayResource<D3D11CommandBuffer>(numCommandBuffers, commandBufferArray))
+    {
+        if (auto commandList = commandBuffer->GetCommandList())
+            context_->ExecuteCommandList(commandList, TRUE);
+    }
+}
+
 void D3D11RenderSystem::Release(CommandBuffer& commandBuffer)
 {
     RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
@@ -92,7 +118,9 @@ static std::unique_ptr<D3D11Buffer> MakeD3D11Buffer(ID3D11Device* device, const
 Buffer* D3D11RenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
 {
     AssertCreateBuffer(desc);
-    return TakeOwnership(buffers_, MakeD3D11Buffer(device_.Get(), desc, initialData));
+    auto buffer = TakeOwnership(buffers_, MakeD3D11Buffer(device_.Get(), desc, initialData));
+    TrackMemory(*buffer, desc.size);
+    return buffer;
 }
 
 static std::unique_ptr<D3D11BufferArray> MakeD3D11BufferArray(unsigned int numBuffers, Buffer* const * bufferArray)
@@ -117,6 +145,7 @@ BufferArray* D3D11RenderSystem::CreateBufferArray(unsigned int numBuffers, Buffe
 
 void D3D11RenderSystem::Release(Buffer& buffer)
 {
+    UntrackMemory(buffer);
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
@@ -138,12 +167,67 @@ void* D3D11RenderSystem::MapBuffer(Buffer& buffer, const BufferCPUAccess access)
     return bufferD3D.Map(context_.Get(), mappedBufferCPUAccess_);
 }
 
+// Returns the CPU access for the specified mapping flags, since D3D11 can only discard or skip the synchronization for entire buffers.
+static BufferCPUAccess GetMapBufferRangeAccess(const BufferCPUAccess access, long mapFlags, bool entireBuffer)
+{
+    if ((mapFlags & BufferMapFlags::DiscardBuffer) != 0 || ((mapFlags & BufferMapFlags::DiscardRange) != 0 && entireBuffer))
+        return BufferCPUAccess::WriteDiscard;
+    if ((mapFlags & BufferMapFlags::Unsynchronized) != 0)
+        return BufferCPUAccess::WriteNoOverwrite;
+    return access;
+}
+
+void* D3D11RenderSystem::MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags)
+{
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+
+    /* Deferred read-only mappings go through the staging ring of the buffer instead of waiting for the GPU */
+    if ((mapFlags & BufferMapFlags::Deferred) != 0 && access == BufferCPUAccess::ReadOnly)
+    {
+        mappedBufferCPUAccess_ = BufferCPUAccess::ReadOnly;
+        return bufferD3D.MapDeferred(context_.Get(), static_cast<UINT>(offset));
+    }
+
+    mappedBufferCPUAccess_ = GetMapBufferRangeAccess(access, mapFlags, (offset == 0 && size == bufferD3D.GetSize()));
+    return bufferD3D.Map(
+        context_.Get(),
+        mappedBufferCPUAccess_,
+        static_cast<UINT>(offset),
+        static_cast<UINT>(size),
+        ((mapFlags & BufferMapFlags::FlushExplicit) != 0)
+    );
+}
+
+void D3D11RenderSystem::FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size)
+{
+    auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
+    bufferD3D.FlushMappedRange(static_cast<UINT>(offset), static_cast<UINT>(size));
+}
+
 void D3D11RenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferD3D = LLGL_CAST(D3D11Buffer&, buffer);
     bufferD3D.Unmap(context_.Get(), mappedBufferCPUAccess_);
 }
 
+// Size (in bytes) of the ring buffer for transient constant buffer ranges.
+static const unsigned int g_transientConstantBufferSize = (4u << 20);
+
+TransientBufferRange D3D11RenderSystem::WriteTransientConstantBuffer(const void* data, std::size_t dataSize)
+{
+    if (!GetRenderingCaps().hasConstantBufferRanges)
+        return {};
+
+    if (!transientConstantBuffer_)
+    {
+        transientConstantBuffer_ = MakeUnique<D3D11TransientBufferAllocator>(
+            device_.Get(), context_.Get(), g_transientConstantBufferSize
+        );
+    }
+
+    return transientConstantBuffer_->Write(data, dataSize);
+}
+
 /* ----- Textures ----- */
 
 // --> see "D3D11RenderSystem_Textures.cpp" file
@@ -152,7 +236,13 @@ void D3D11RenderSystem::UnmapBuffer(Buffer& buffer)
 
 Sampler* D3D11RenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return TakeOwnership(samplers_, MakeUnique<D3D11Sampler>(device_.Get(), desc));
+    return samplers_.Acquire(
+        desc,
+        [&]()
+        {
+            return MakeUnique<D3D11Sampler>(device_.Get(), desc);
+        }
+    );
 }
 
 SamplerArray* D3D11RenderSystem::CreateSamplerArray(unsigned int numSamplers, Sampler* const * samplerArray)
@@ -163,7 +253,7 @@ SamplerArray* D3D11RenderSystem::CreateSamplerArray(unsigned int numSamplers, Sa
 
 void D3D11RenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    samplers_.Release(&sampler);
 }
 
 void D3D11RenderSystem::Release(SamplerArray& samplerArray)
@@ -171,6 +261,19 @@ void D3D11RenderSystem::Release(SamplerArray& samplerArray)
     RemoveFromUniqueSet(samplerArrays_, &samplerArray);
 }
 
+/* ----- Resource Heaps ----- */
+
+ResourceHeap* D3D11RenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    AssertCreateResourceHeap(desc);
+    return TakeOwnership(resourceHeaps_, MakeUnique<D3D11ResourceHeap>(desc));
+}
+
+void D3D11RenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+}
+
 /* ----- Render Targets ----- */
 
 RenderTarget* D3D11RenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
@@ -187,12 +290,15 @@ void D3D11RenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* D3D11RenderSystem::CreateShader(const ShaderType type)
 {
-    return TakeOwnership(shaders_, MakeUnique<D3D11Shader>(device_.Get(), type));
+    if (type == ShaderType::Amplification || type == ShaderType::Mesh)
+        ThrowNotSupported("mesh shaders");
+
+    return TakeOwnership(shaders_, MakeUnique<D3D11Shader>(device_.Get(), type, GetSharedThreadPool().get()));
 }
 
 ShaderProgram* D3D11RenderSystem::CreateShaderProgram()
 {
-    return TakeOwnership(shaderPrograms_, MakeUnique<D3D11ShaderProgram>(device_.Get()));
+    return TakeOwnership(shaderPrograms_, MakeUnique<D3D11ShaderProgram>(*renderStateCache_));
 }
 
 void D3D11RenderSystem::Release(Shader& shader)
@@ -209,7 +315,18 @@ void D3D11RenderSystem::Release(ShaderProgram& shaderProgram)
 
 GraphicsPipeline* D3D11RenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
 {
-    return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline>(device_.Get(), desc));
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    return TakeOwnership(graphicsPipelines_, MakeUnique<D3D11GraphicsPipeline>(*renderStateCache_, desc));
+}
+
+std::shared_future<GraphicsPipeline*> D3D11RenderSystem::CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc)
+{
+    return GetSharedThreadPool()->Submit(
+        [this, desc]()
+        {
+            return CreateGraphicsPipeline(desc);
+        }
+    );
 }
 
 ComputePipeline* D3D11RenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
@@ -219,7 +336,9 @@ ComputePipeline* D3D11RenderSystem::CreateComputePipeline(const ComputePipelineD
 
 void D3D11RenderSystem::Release(GraphicsPipeline& graphicsPipeline)
 {
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
     RemoveFromUniqueSet(graphicsPipelines_, &graphicsPipeline);
+    renderStateCache_->ReleaseUnusedStates();
 }
 
 void D3D11RenderSystem::Release(ComputePipeline& computePipeline)
@@ -234,11 +353,97 @@ Query* D3D11RenderSystem::CreateQuery(const QueryDescriptor& desc)
     return TakeOwnership(queries_, MakeUnique<D3D11Query>(device_.Get(), desc));
 }
 
+QueryArray* D3D11RenderSystem::CreateQueryArray(unsigned int numQueries, Query* const * queryArray)
+{
+    AssertCreateQueryArray(numQueries, queryArray);
+    return TakeOwnership(queryArrays_, MakeUnique<D3D11QueryArray>(numQueries, queryArray));
+}
+
 void D3D11RenderSystem::Release(Query& query)
 {
     RemoveFromUniqueSet(queries_, &query);
 }
 
+void D3D11RenderSystem::Release(QueryArray& queryArray)
+{
+    RemoveFromUniqueSet(queryArrays_, &queryArray);
+}
+
+/* ----- Readbacks ----- */
+
+Readback* D3D11RenderSystem::ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType)
+{
+    auto& textureD3D = LLGL_CAST(const D3D11Texture&, texture);
+    auto readbackD3D = MakeUnique<D3D11Readback>(device_.Get(), context_.Get(), GetTextureReadbackSize(texture, mipLevel, imageFormat, dataType));
+    readbackD3D->ReadTexture(textureD3D, mipLevel, imageFormat, dataType, GetConfiguration().threadCount);
+    return TakeOwnership(readbacks_, std::move(readbackD3D));
+}
+
+Readback* D3D11RenderSystem::ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize)
+{
+    auto& bufferD3D = LLGL_CAST(const D3D11Buffer&, buffer);
+    auto readbackD3D = MakeUnique<D3D11Readback>(device_.Get(), context_.Get(), dataSize);
+    readbackD3D->ReadBuffer(bufferD3D, offset);
+    return TakeOwnership(readbacks_, std::move(readbackD3D));
+}
+
+void D3D11RenderSystem::Release(Readback& readback)
+{
+    RemoveFromUniqueSet(readbacks_, &readback);
+}
+
+/* ----- Uploads ----- */
+
+/*
+The driver copies the data into its own staging memory with UpdateSubresource,
+so only the fence is required to report when the GPU has finished the upload.
+*/
+
+Fence* D3D11RenderSystem::WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    WriteBuffer(buffer, data, dataSize, offset);
+    return SignalNewFence();
+}
+
+Fence* D3D11RenderSystem::WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    WriteTexture(texture, subTextureDesc, imageDesc);
+    return SignalNewFence();
+}
+
+/* ----- Fences ----- */
+
+Fence* D3D11RenderSystem::CreateFence()
+{
+    return TakeOwnership(fences_, MakeUnique<D3D11Fence>(device_.Get(), context_.Get()));
+}
+
+void D3D11RenderSystem::Release(Fence& fence)
+{
+    RemoveFromUniqueSet(fences_, &fence);
+}
+
+/* ----- Memory ----- */
+
+MemoryInfo D3D11RenderSystem::QueryMemoryInfo()
+{
+    MemoryInfo memoryInfo;
+
+    /* Accumulate memory the render system has allocated */
+    GetTrackedMemory(memoryInfo);
+
+    for (const auto& renderTarget : renderTargets_)
+        memoryInfo.renderTargetMemory += renderTarget->GetInternalMemory();
+
+    /* Query memory budget from the adapter of the device */
+    ComPtr<IDXGIDevice> dxgiDevice;
+    ComPtr<IDXGIAdapter> adapter;
+    if (SUCCEEDED(device_.As(&dxgiDevice)) && SUCCEEDED(dxgiDevice->GetAdapter(adapter.ReleaseAndGetAddressOf())))
+        DXQueryVideoMemoryInfo(adapter.Get(), memoryInfo);
+
+    return memoryInfo;
+}
+
 
 /*
  * ======= Private: =======
@@ -247,7 +452,7 @@ void D3D11RenderSystem::Release(Query& query)
 void D3D11RenderSystem::CreateFactory()
 {
     /* Create DXGI factory */
-    auto hr = CreateDXGIFactory(IID_PPV_ARGS(&factory_));
+    auto hr = CreateDXGIFactory1(IID_PPV_ARGS(&factory_));
     DXThrowIfFailed(hr, "failed to create DXGI factor");
 }
 
@@ -262,33 +467,66 @@ void D3D11RenderSystem::QueryVideoAdapters()
         videoAdatperDescs_.push_back(DXGetVideoAdapterDesc(adapter.Get()));
         adapter.Reset();
     }
+
+    SetVideoAdapters(videoAdatperDescs_);
 }
 
-void D3D11RenderSystem::CreateDevice(IDXGIAdapter* adapter)
+void D3D11RenderSystem::CreateDevice(const RenderSystemDescriptor& renderSystemDesc)
 {
-    /* Use default adapter (null) and try all feature levels */
     auto    featureLevels   = DXGetFeatureLevels(D3D_FEATURE_LEVEL_11_1);
     HRESULT hr              = 0;
+    bool    created         = false;
 
+    /* Driver messages are only generated by the debug layer */
     #ifdef LLGL_DEBUG
-
-    /* Try to create device with debug layer (only supported if Windows 8.1 SDK is installed) */
-    if (!CreateDeviceWithFlags(adapter, featureLevels, D3D11_CREATE_DEVICE_DEBUG, hr))
-        CreateDeviceWithFlags(adapter, featureLevels, 0, hr);
-    
+    const bool debugDevice = true;
     #else
-    
-    /* Create device without debug layer */
-    CreateDeviceWithFlags(adapter, featureLevels, 0, hr);
-
+    const bool debugDevice = (renderSystemDesc.driverDebugger != nullptr);
     #endif
 
-    DXThrowIfFailed(hr, "failed to create D3D11 device");
+    /* Try to create device with the hardware adapters in the order of preference */
+    for (const auto& adapter : DXGetPreferredAdapters(factory_.Get(), renderSystemDesc))
+    {
+        if (CreateDevice(adapter.Get(), featureLevels, debugDevice, hr))
+        {
+            created = true;
+            break;
+        }
+    }
+
+    /* Use default adapter (null) with hardware, WARP, and software drivers as fallback */
+    if (!created && !CreateDevice(nullptr, featureLevels, debugDevice, hr))
+        DXThrowIfFailed(hr, "failed to create D3D11 device");
+
+    /* Read the messages of the debug layer for the driver debugger */
+    if (renderSystemDesc.driverDebugger != nullptr)
+        infoQueue_ = MakeUnique<D3D11InfoQueue>(device_.Get(), renderSystemDesc.driverDebugger, renderSystemDesc.driverMessageLimit);
+
+    /* Query Direct3D 11.2 interfaces for tiled resources */
+    device_.As(&device2_);
+    context_.As(&context2_);
+}
+
+bool D3D11RenderSystem::CreateDevice(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, bool debugDevice, HRESULT& hr)
+{
+    /* Try to create device with debug layer (only supported if Windows 8.1 SDK is installed) */
+    if (debugDevice && CreateDeviceWithFlags(adapter, featureLevels, D3D11_CREATE_DEVICE_DEBUG, hr))
+        return true;
+
+    /* Create device without debug layer */
+    return CreateDeviceWithFlags(adapter, featureLevels, 0, hr);
 }
 
 bool D3D11RenderSystem::CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels, UINT flags, HRESULT& hr)
 {
-    for (D3D_DRIVER_TYPE driver : { D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP, D3D_DRIVER_TYPE_SOFTWARE })
+    /* An explicit adapter requires the unknown driver type, otherwise try the hardware and software drivers of the default adapter */
+    std::vector<D3D_DRIVER_TYPE> drivers;
+    if (adapter != nullptr)
+        drivers = { D3D_DRIVER_TYPE_UNKNOWN };
+    else
+        drivers = { D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP, D3D_DRIVER_TYPE_SOFTWARE };
+
+    for (D3D_DRIVER_TYPE driver : drivers)
     {
         hr = D3D11CreateDevice(
             adapter,                                    // Video adapter
@@ -312,8 +550,9 @@ bool D3D11RenderSystem::CreateDeviceWithFlags(IDXGIAdapter* adapter, const std::
 
 void D3D11RenderSystem::InitStateManager()
 {
-    /* Create state manager */
-    stateMngr_ = MakeUnique<D3D11StateManager>(context_);
+    /* Create state manager and render state cache */
+    stateMngr_          = MakeUnique<D3D11StateManager>(context_);
+    renderStateCache_   = MakeUnique<D3D11RenderStateCache>(device_.Get());
 }
 
 void D3D11RenderSystem::QueryRendererInfo()
@@ -323,9 +562,12 @@ void D3D11RenderSystem::QueryRendererInfo()
     info.rendererName           = "Direct3D " + DXFeatureLevelToVersion(GetFeatureLevel());
     info.shadingLanguageName    = "HLSL " + DXFeatureLevelToShaderModel(GetFeatureLevel());
 
-    if (!videoAdatperDescs_.empty())
+    /* Query name and vendor from the adapter the device has been created with */
+    ComPtr<IDXGIDevice> dxgiDevice;
+    ComPtr<IDXGIAdapter> adapter;
+    if (SUCCEEDED(device_.As(&dxgiDevice)) && SUCCEEDED(dxgiDevice->GetAdapter(adapter.ReleaseAndGetAddressOf())))
     {
-        const auto& videoAdapterDesc = videoAdatperDescs_.front();
+        auto videoAdapterDesc = DXGetVideoAdapterDesc(adapter.Get());
         info.deviceName = std::string(videoAdapterDesc.name.begin(), videoAdapterDesc.name.end());
         info.vendorName = videoAdapterDesc.vendor;
     }
@@ -339,9 +581,57 @@ void D3D11RenderSystem::QueryRenderingCaps()
 {
     RenderingCaps caps;
     DXGetRenderingCaps(caps, GetFeatureLevel());
+
+    /* Stream-outputs are paused by unbinding the targets, and drawn with "DrawAuto" */
+    caps.hasStreamOutputDraws = caps.hasStreamOutputs;
+
+    /* Class instances of dynamic shader linkage require shader model 5 */
+    caps.hasShaderClassInterfaces = (GetFeatureLevel() >= D3D_FEATURE_LEVEL_11_0);
+
+    /* Hidden UAV counters are reset when the UAV is bound, and copied with "CopyStructureCount" */
+    caps.hasBufferCounters = caps.hasStorageBuffers;
+
+    /* Constant buffer ranges require the Direct3D 11.1 runtime */
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options;
+    InitMemory(options);
+
+    if (SUCCEEDED(device_->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+        caps.hasConstantBufferRanges = (options.ConstantBufferOffsetting != FALSE && options.MapNoOverwriteOnDynamicConstantBuffer != FALSE);
+
+    /* Sparse textures are implemented with tiled resources, which require the Direct3D 11.2 runtime */
+    if (device2_ && context2_)
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS1 options1;
+        InitMemory(options1);
+
+        if (SUCCEEDED(device_->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS1, &options1, sizeof(options1))))
+            caps.hasSparseTextures = (options1.TiledResourcesTier != D3D11_TILED_RESOURCES_NOT_SUPPORTED);
+    }
+
+    /* Conservative rasterization requires the Direct3D 11.3 runtime */
+    D3D11_FEATURE_DATA_D3D11_OPTIONS2 options2;
+    InitMemory(options2);
+
+    if (SUCCEEDED(device_->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS2, &options2, sizeof(options2))))
+        caps.hasConservativeRasterization = (options2.ConservativeRasterizationTier != D3D11_CONSERVATIVE_RASTERIZATION_NOT_SUPPORTED);
+
+    /* Render target layer selection outside of the geometry shader requires the Direct3D 11.3 runtime as well */
+    D3D11_FEATURE_DATA_D3D11_OPTIONS3 options3;
+    InitMemory(options3);
+
+    if (SUCCEEDED(device_->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS3, &options3, sizeof(options3))))
+        caps.hasVertexShaderLayer = (options3.VPAndRTArrayIndexFromAnyShaderFeedingRasterizer != FALSE);
+
     SetRenderingCaps(caps);
 }
 
+Fence* D3D11RenderSystem::SignalNewFence()
+{
+    auto fenceD3D = MakeUnique<D3D11Fence>(device_.Get(), context_.Get());
+    fenceD3D->Signal(context_.Get());
+    return TakeOwnership(fences_, std::move(fenceD3D));
+}
+
 
 } // /namespace LLGL
 
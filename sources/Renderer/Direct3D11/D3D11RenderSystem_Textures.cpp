@@ -11,6 +11,7 @@
 #include "../CheckedCast.h"
 #include "../Assertion.h"
 #include "../../Core/Helper.h"
+#include "../../Core/Exception.h"
 
 
 namespace LLGL
@@ -19,6 +20,29 @@ namespace LLGL
 
 /* ----- Textures ----- */
 
+/*
+Returns the bind flags for a generic texture, since compressed formats can not be used as render targets,
+and depth-stencil formats can only be used as depth-stencil attachments.
+*/
+static UINT GetGenericTextureBindFlags(const TextureFormat format)
+{
+    if (IsCompressedFormat(format))
+        return D3D11_BIND_SHADER_RESOURCE;
+    else if (IsDepthStencilFormat(format))
+        return (D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_DEPTH_STENCIL);
+    else
+        return (D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET);
+}
+
+// Returns the size (in bytes) of a single array slice of the specified image.
+static std::size_t GetImageSliceSize(const TextureFormat format, unsigned int width, unsigned int height, const ImageDescriptor& imageDesc)
+{
+    if (IsCompressedFormat(imageDesc.format))
+        return CompressedImageSize(format, width, height);
+    else
+        return (width * height * imageDesc.GetElementSize());
+}
+
 Texture* D3D11RenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
 {
     /* Create texture object and store type */
@@ -48,23 +72,30 @@ Texture* D3D11RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
             break;
     }
 
+    /* MIP-maps can only be generated by the GPU for uncompressed color formats (they require a render target view) */
+    const bool canGenerateMips = (!IsCompressedFormat(descD3D.format) && !IsDepthStencilFormat(descD3D.format));
+    const UINT generateMipsFlag = (canGenerateMips ? D3D11_RESOURCE_MISC_GENERATE_MIPS : 0);
+
+    /* The device is free-threaded, but the initial image data is uploaded (or the texture is cleared) with the immediate context */
+    std::unique_lock<std::mutex> lock(contextMutex_);
+
     /* Bulid generic texture */
     switch (descD3D.type)
     {
         case TextureType::Texture1D:
         case TextureType::Texture1DArray:
-            BuildGenericTexture1D(*texture, descD3D, imageDesc, D3D11_RESOURCE_MISC_GENERATE_MIPS);
+            BuildGenericTexture1D(*texture, descD3D, imageDesc, generateMipsFlag);
             break;
         case TextureType::Texture2D:
         case TextureType::Texture2DArray:
-            BuildGenericTexture2D(*texture, descD3D, imageDesc, D3D11_RESOURCE_MISC_GENERATE_MIPS);
+            BuildGenericTexture2D(*texture, descD3D, imageDesc, generateMipsFlag);
             break;
         case TextureType::Texture3D:
-            BuildGenericTexture3D(*texture, descD3D, imageDesc, D3D11_RESOURCE_MISC_GENERATE_MIPS);
+            BuildGenericTexture3D(*texture, descD3D, imageDesc, generateMipsFlag);
             break;
         case TextureType::TextureCube:
         case TextureType::TextureCubeArray:
-            BuildGenericTexture2D(*texture, descD3D, imageDesc, D3D11_RESOURCE_MISC_GENERATE_MIPS | D3D11_RESOURCE_MISC_TEXTURECUBE);
+            BuildGenericTexture2D(*texture, descD3D, imageDesc, generateMipsFlag | D3D11_RESOURCE_MISC_TEXTURECUBE);
             break;
         case TextureType::Texture2DMS:
         case TextureType::Texture2DMSArray:
@@ -74,7 +105,68 @@ Texture* D3D11RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
             throw std::invalid_argument("failed to create texture with invalid texture type");
             break;
     }
-    
+
+    lock.unlock();
+
+    TrackMemory(*texture, textureDesc);
+
+    return TakeOwnership(textures_, std::move(texture));
+}
+
+Texture* D3D11RenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto& sharedTextureD3D = LLGL_CAST(D3D11Texture&, sharedTexture);
+    auto texture = MakeUnique<D3D11Texture>(textureViewDesc.type);
+    texture->CreateTextureView(device_.Get(), sharedTextureD3D, textureViewDesc);
+    return TakeOwnership(textures_, std::move(texture));
+}
+
+Texture* D3D11RenderSystem::CreateSparseTexture(const TextureDescriptor& textureDesc)
+{
+    LLGL_ASSERT_CAP(hasSparseTextures);
+
+    auto texture = MakeUnique<D3D11Texture>(textureDesc.type);
+
+    /* Create tiled 2D texture, since 3D tiled resources are not supported before Direct3D 11.3 */
+    UINT layers = 1;
+
+    switch (textureDesc.type)
+    {
+        case TextureType::Texture2D:        layers = 1;                                     break;
+        case TextureType::Texture2DArray:   layers = textureDesc.texture2D.layers;          break;
+        case TextureType::TextureCube:      layers = 6;                                     break;
+        case TextureType::TextureCubeArray: layers = textureDesc.textureCube.layers * 6;    break;
+        default:
+            throw std::invalid_argument("cannot create sparse texture with texture type other than 2D, 2D-array, cube, or cube-array for D3D11");
+    }
+
+    D3D11_TEXTURE2D_DESC texDesc;
+    {
+        texDesc.Width               = textureDesc.texture2D.width;
+        texDesc.Height              = textureDesc.texture2D.height;
+        texDesc.MipLevels           = 0;
+        texDesc.ArraySize           = layers;
+        texDesc.Format              = D3D11Types::Map(textureDesc.format);
+        texDesc.SampleDesc.Count    = 1;
+        texDesc.SampleDesc.Quality  = 0;
+        texDesc.Usage               = D3D11_USAGE_DEFAULT;
+        texDesc.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
+        texDesc.CPUAccessFlags      = 0;
+        texDesc.MiscFlags           = D3D11_RESOURCE_MISC_TILED;
+
+        if (textureDesc.type == TextureType::TextureCube || textureDesc.type == TextureType::TextureCubeArray)
+            texDesc.MiscFlags |= D3D11_RESOURCE_MISC_TEXTURECUBE;
+    }
+    texture->CreateTexture2D(device_.Get(), texDesc);
+
+    /* Initialize tile mappings with an empty tile pool */
+    texture->InitTileMappings(
+        device2_.Get(),
+        context2_.Get(),
+        { textureDesc.texture2D.width, textureDesc.texture2D.height, layers },
+        (textureDesc.type != TextureType::Texture2D)
+    );
+
     return TakeOwnership(textures_, std::move(texture));
 }
 
@@ -86,6 +178,7 @@ TextureArray* D3D11RenderSystem::CreateTextureArray(unsigned int numTextures, Te
 
 void D3D11RenderSystem::Release(Texture& texture)
 {
+    UntrackMemory(texture);
     RemoveFromUniqueSet(textures_, &texture);
 }
 
@@ -231,6 +324,7 @@ void D3D11RenderSystem::WriteTexture(Texture& texture, const SubTextureDescripto
     }
 
     /* Update generic texture at determined region */
+    std::lock_guard<std::mutex> lock(contextMutex_);
     UpdateGenericTexture(texture, subTextureDesc.mipLevel, 0, position, size, imageDesc);
 }
 
@@ -239,55 +333,53 @@ void D3D11RenderSystem::ReadTexture(const Texture& texture, int mipLevel, ImageF
     LLGL_ASSERT_PTR(buffer);
     auto& textureD3D = LLGL_CAST(const D3D11Texture&, texture);
 
-    /* Create a copy of the hardware texture with CPU read access */
-    D3D11HardwareTexture hwTextureCopy;
-    textureD3D.CreateSubresourceCopyWithCPUAccess(device_.Get(), context_.Get(), hwTextureCopy, D3D11_CPU_ACCESS_READ, mipLevel);
-    
-    /* Map subresource for reading */
-    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
-    auto hr = context_->Map(hwTextureCopy.resource.Get(), 0, D3D11_MAP_READ, 0, &mappedSubresource);
-    DXThrowIfFailed(hr, "failed to map D3D11 texture copy resource");
-
-    /* Query MIP-level size to determine image buffer size */
-    auto size = texture.QueryMipLevelSize(mipLevel);
-
-    /* Check if image buffer must be converted */
-    auto srcTexFormat   = DXGetTextureFormatDesc(textureD3D.GetFormat());
-    auto srcPitch       = DataTypeSize(srcTexFormat.dataType) * ImageFormatSize(srcTexFormat.format);
-    auto srcImageSize   = (size.x*size.y*size.z * srcPitch);
-
-    if (srcTexFormat.format != imageFormat || srcTexFormat.dataType != dataType)
-    {
-        /* Convert mapped data into requested format */
-        auto tempData = ConvertImageBuffer(
-            srcTexFormat.format, srcTexFormat.dataType,
-            mappedSubresource.pData, srcImageSize,
-            imageFormat, dataType,
-            GetConfiguration().threadCount
-        );
+    /* Copy texture into staging texture and read its data immediately */
+    auto dataSize = GetTextureReadbackSize(texture, mipLevel, imageFormat, dataType);
 
-        /* Copy temporary data into output buffer */
-        auto dstPitch       = DataTypeSize(dataType) * ImageFormatSize(imageFormat);
-        auto dstImageSize   = (size.x*size.y*size.z * dstPitch);
-        ::memcpy(buffer, tempData.get(), dstImageSize);
-    }
-    else
-    {
-        /* Copy mapped data directly into the output buffer */
-        ::memcpy(buffer, mappedSubresource.pData, srcImageSize);
-    }
-
-    /* Unmap resource */
-    context_->Unmap(hwTextureCopy.resource.Get(), 0);
+    D3D11Readback readback { device_.Get(), context_.Get(), dataSize };
+    readback.ReadTexture(textureD3D, mipLevel, imageFormat, dataType, GetConfiguration().threadCount);
+    readback.ReadData(buffer, dataSize);
 }
 
 void D3D11RenderSystem::GenerateMips(Texture& texture)
 {
     /* Generate MIP-maps for SRV of specified texture */
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
+    std::lock_guard<std::mutex> lock(contextMutex_);
     context_->GenerateMips(textureD3D.GetSRV());
 }
 
+std::uint64_t D3D11RenderSystem::GetBindlessTextureHandle(Texture& texture, Sampler* sampler)
+{
+    ThrowNotSupported("bindless textures");
+}
+
+static const SparsePageTable& GetSparsePageTable(const D3D11Texture& textureD3D)
+{
+    if (auto pageTable = textureD3D.GetSparsePageTable())
+        return *pageTable;
+    throw std::invalid_argument("texture was not created as sparse texture");
+}
+
+void D3D11RenderSystem::CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit)
+{
+    auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
+    GetSparsePageTable(textureD3D);
+    textureD3D.CommitTiles(context2_.Get(), region, commit);
+}
+
+bool D3D11RenderSystem::IsSparseTextureResident(const Texture& texture, const TextureRegion& region)
+{
+    auto& textureD3D = LLGL_CAST(const D3D11Texture&, texture);
+    return GetSparsePageTable(textureD3D).IsResident(region);
+}
+
+Gs::Vector3ui D3D11RenderSystem::QuerySparseTexturePageSize(const Texture& texture)
+{
+    auto& textureD3D = LLGL_CAST(const D3D11Texture&, texture);
+    return GetSparsePageTable(textureD3D).GetPageSize();
+}
+
 
 /*
  * ======= Private: =======
@@ -304,7 +396,7 @@ void D3D11RenderSystem::BuildGenericTexture1D(
         texDesc.ArraySize       = descD3D.texture1D.layers;
         texDesc.Format          = D3D11Types::Map(descD3D.format);
         texDesc.Usage           = D3D11_USAGE_DEFAULT;
-        texDesc.BindFlags       = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+        texDesc.BindFlags       = GetGenericTextureBindFlags(descD3D.format);
         texDesc.CPUAccessFlags  = 0;
         texDesc.MiscFlags       = miscFlags;
     }
@@ -316,7 +408,7 @@ void D3D11RenderSystem::BuildGenericTexture1D(
     {
         /* Update only the first MIP-map level for each array slice */
         auto subImageDesc = *imageDesc;
-        auto subImageStride = descD3D.texture1D.width * ImageFormatSize(subImageDesc.format) * DataTypeSize(subImageDesc.dataType);
+        auto subImageStride = GetImageSliceSize(descD3D.format, descD3D.texture1D.width, 1, subImageDesc);
 
         for (unsigned int arraySlice = 0; arraySlice < descD3D.texture1D.layers; ++arraySlice)
         {
@@ -330,9 +422,7 @@ void D3D11RenderSystem::BuildGenericTexture1D(
         }
     }
     else
-    {
-        //TODO -> fill texture with default data
-    }
+        InitializeGenericTexture(textureD3D, descD3D);
 }
 
 void D3D11RenderSystem::BuildGenericTexture2D(
@@ -349,7 +439,7 @@ void D3D11RenderSystem::BuildGenericTexture2D(
         texDesc.SampleDesc.Count    = 1;
         texDesc.SampleDesc.Quality  = 0;
         texDesc.Usage               = D3D11_USAGE_DEFAULT;
-        texDesc.BindFlags           = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+        texDesc.BindFlags           = GetGenericTextureBindFlags(descD3D.format);
         texDesc.CPUAccessFlags      = 0;
         texDesc.MiscFlags           = miscFlags;
     }
@@ -359,32 +449,21 @@ void D3D11RenderSystem::BuildGenericTexture2D(
     {
         /* Update only the first MIP-map level for each array slice */
         auto subImageDesc = *imageDesc;
-        auto subImageStride = descD3D.texture2D.width * descD3D.texture2D.height * subImageDesc.GetElementSize();
+        auto subImageStride = GetImageSliceSize(descD3D.format, descD3D.texture2D.width, descD3D.texture2D.height, subImageDesc);
 
         for (unsigned int arraySlice = 0; arraySlice < descD3D.texture2D.layers; ++arraySlice)
         {
-            textureD3D.UpdateSubresource(
-                context_.Get(), 0, arraySlice,
+            UpdateTextureSubresource(
+                textureD3D, 0, arraySlice,
                 CD3D11_BOX(0, 0, 0, descD3D.texture2D.width, descD3D.texture2D.height, 1),
-                subImageDesc, GetConfiguration().threadCount
+                subImageDesc
             );
 
             subImageDesc.buffer = reinterpret_cast<const char*>(subImageDesc.buffer) + subImageStride;
         }
     }
-    else if (GetConfiguration().imageInitialization.enabled)
-    {
-        if (IsDepthStencilFormat(descD3D.format))
-        {
-            //TODO -> fill texture with default depth
-            //GetConfiguration().defaultImageColor
-        }
-        else
-        {
-            //TODO -> fill texture with default color
-            //GetConfiguration().defaultImageDepth
-        }
-    }
+    else
+        InitializeGenericTexture(textureD3D, descD3D);
 }
 
 void D3D11RenderSystem::BuildGenericTexture3D(
@@ -399,7 +478,7 @@ void D3D11RenderSystem::BuildGenericTexture3D(
         texDesc.MipLevels       = 0;
         texDesc.Format          = D3D11Types::Map(descD3D.format);
         texDesc.Usage           = D3D11_USAGE_DEFAULT;
-        texDesc.BindFlags       = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+        texDesc.BindFlags       = GetGenericTextureBindFlags(descD3D.format);
         texDesc.CPUAccessFlags  = 0;
         texDesc.MiscFlags       = miscFlags;
     }
@@ -414,9 +493,7 @@ void D3D11RenderSystem::BuildGenericTexture3D(
         );
     }
     else
-    {
-        //TODO -> fill texture with default data
-    }
+        InitializeGenericTexture(textureD3D, descD3D);
 }
 
 void D3D11RenderSystem::BuildGenericTexture2DMS(D3D11Texture& textureD3D, const TextureDescriptor& descD3D)
@@ -432,29 +509,97 @@ void D3D11RenderSystem::BuildGenericTexture2DMS(D3D11Texture& textureD3D, const
         texDesc.SampleDesc.Count    = descD3D.texture2DMS.samples;
         texDesc.SampleDesc.Quality  = 0;
         texDesc.Usage               = D3D11_USAGE_DEFAULT;
-        texDesc.BindFlags           = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+        texDesc.BindFlags           = GetGenericTextureBindFlags(descD3D.format);
         texDesc.CPUAccessFlags      = 0;
         texDesc.MiscFlags           = 0;
     }
     textureD3D.CreateTexture2D(device_.Get(), texDesc);
 }
 
+/*
+Textures without initial image data are cleared through a temporary RTV or DSV,
+instead of uploading a CPU generated image with the default color or depth.
+The views are created without a descriptor, so they cover all array layers (or depth slices) of the first MIP-map level.
+*/
+void D3D11RenderSystem::InitializeGenericTexture(D3D11Texture& textureD3D, const TextureDescriptor& descD3D)
+{
+    const auto& imageInitialization = GetConfiguration().imageInitialization;
+
+    /* Compressed textures can not be bound as render target, and initialization can be disabled by the configuration */
+    if (!imageInitialization.enabled || IsCompressedFormat(descD3D.format))
+        return;
+
+    auto resource = textureD3D.GetHardwareTexture().resource.Get();
+
+    if (IsDepthStencilFormat(descD3D.format))
+    {
+        ComPtr<ID3D11DepthStencilView> dsv;
+        auto hr = device_->CreateDepthStencilView(resource, nullptr, dsv.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil-view (DSV) for texture initialization");
+
+        context_->ClearDepthStencilView(dsv.Get(), (D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL), imageInitialization.depth, 0);
+    }
+    else
+    {
+        ComPtr<ID3D11RenderTargetView> rtv;
+        auto hr = device_->CreateRenderTargetView(resource, nullptr, rtv.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 render-target-view (RTV) for texture initialization");
+
+        const auto color = imageInitialization.color.Cast<float>();
+        context_->ClearRenderTargetView(rtv.Get(), color.Ptr());
+    }
+}
+
 void D3D11RenderSystem::UpdateGenericTexture(
     Texture& texture, unsigned int mipLevel, unsigned int layer,
     const Gs::Vector3ui& position, const Gs::Vector3ui& size, const ImageDescriptor& imageDesc)
 {
     /* Get D3D texture and update subresource */
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
-    textureD3D.UpdateSubresource(
-        context_.Get(), static_cast<UINT>(mipLevel), layer,
+    UpdateTextureSubresource(
+        textureD3D, static_cast<UINT>(mipLevel), layer,
         CD3D11_BOX(
             position.x, position.y, position.z,
             position.x + size.x, position.y + size.y, position.z + size.z
         ),
-        imageDesc, GetConfiguration().threadCount
+        imageDesc
     );
 }
 
+void D3D11RenderSystem::UpdateTextureSubresource(
+    D3D11Texture& textureD3D, UINT mipSlice, UINT arraySlice, const D3D11_BOX& dstBox, const ImageDescriptor& imageDesc)
+{
+    /* Expand non-native image formats with a compute shader (requires feature level 11.0), but only for a single slice of a 2D texture */
+    const auto type     = textureD3D.GetType();
+    const auto width    = dstBox.right - dstBox.left;
+    const auto height   = dstBox.bottom - dstBox.top;
+
+    const bool gpuConversion =
+    (
+        featureLevel_ >= D3D_FEATURE_LEVEL_11_0 &&
+        dstBox.back - dstBox.front == 1         &&
+        (
+            type == TextureType::Texture2D      ||
+            type == TextureType::Texture2DArray ||
+            type == TextureType::TextureCube    ||
+            type == TextureType::TextureCubeArray
+        ) &&
+        D3D11ImageConverter::IsConversionSupported(textureD3D, imageDesc, width, height)
+    );
+
+    if (gpuConversion)
+    {
+        if (!imageConverter_)
+            imageConverter_ = MakeUnique<D3D11ImageConverter>(device_.Get(), context_.Get());
+
+        /* Array layers of 2D textures are passed as Z coordinate by "WriteTexture" */
+        const auto dstSubresource = D3D11CalcSubresource(mipSlice, arraySlice + dstBox.front, textureD3D.GetNumMipLevels());
+        imageConverter_->WriteTexture(textureD3D, dstSubresource, dstBox.left, dstBox.top, width, height, imageDesc);
+    }
+    else
+        textureD3D.UpdateSubresource(context_.Get(), mipSlice, arraySlice, dstBox, imageDesc, GetConfiguration().threadCount);
+}
+
 
 } // /namespace LLGL
 
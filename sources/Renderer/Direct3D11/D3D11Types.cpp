@@ -230,6 +230,7 @@ D3D11_QUERY Map(const QueryDescriptor& queryDesc)
             case QueryType::AnySamplesPassed:                   /* pass */
             case QueryType::AnySamplesPassedConservative:       return D3D11_QUERY_OCCLUSION;
             case QueryType::TimeElapsed:                        return D3D11_QUERY_TIMESTAMP_DISJOINT;
+            case QueryType::Timestamp:                          return D3D11_QUERY_TIMESTAMP;
             case QueryType::StreamOutOverflow:                  break;
             case QueryType::StreamOutPrimitivesWritten:         return D3D11_QUERY_SO_STATISTICS;
             case QueryType::PrimitivesGenerated:                /* pass */
@@ -243,7 +244,8 @@ D3D11_QUERY Map(const QueryDescriptor& queryDesc)
             case QueryType::ComputeShaderInvocations:           /* pass */
             case QueryType::GeometryPrimitivesGenerated:        /* pass */
             case QueryType::ClippingInputPrimitives:            /* pass */
-            case QueryType::ClippingOutputPrimitives:           return D3D11_QUERY_PIPELINE_STATISTICS;
+            case QueryType::ClippingOutputPrimitives:           /* pass */
+            case QueryType::PipelineStatistics:                 return D3D11_QUERY_PIPELINE_STATISTICS;
         }
     }
     DXTypes::MapFailed("QueryType", "D3D11_QUERY");
@@ -253,11 +255,11 @@ D3D11_MAP Map(const BufferCPUAccess cpuAccess)
 {
     switch (cpuAccess)
     {
-        case BufferCPUAccess::ReadOnly:     return D3D11_MAP_READ;
-        case BufferCPUAccess::WriteOnly:    return D3D11_MAP_WRITE;
-        case BufferCPUAccess::ReadWrite:    return D3D11_MAP_READ_WRITE;
-                                          /*return D3D11_MAP_WRITE_DISCARD;
-                                            return D3D11_MAP_WRITE_NO_OVERWRITE;*/
+        case BufferCPUAccess::ReadOnly:         return D3D11_MAP_READ;
+        case BufferCPUAccess::WriteOnly:        return D3D11_MAP_WRITE;
+        case BufferCPUAccess::ReadWrite:        return D3D11_MAP_READ_WRITE;
+        case BufferCPUAccess::WriteDiscard:     return D3D11_MAP_WRITE_DISCARD;
+        case BufferCPUAccess::WriteNoOverwrite: return D3D11_MAP_WRITE_NO_OVERWRITE;
     }
     DXTypes::MapFailed("BufferCPUAccess", "D3D11_MAP");
 }
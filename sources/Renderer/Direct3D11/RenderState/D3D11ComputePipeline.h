@@ -18,6 +18,9 @@ namespace LLGL
 {
 
 
+class D3D11StateManager;
+class D3D11ShaderProgram;
+
 class D3D11ComputePipeline : public ComputePipeline
 {
 
@@ -25,11 +28,19 @@ class D3D11ComputePipeline : public ComputePipeline
 
         D3D11ComputePipeline(const ComputePipelineDescriptor& desc);
 
-        void Bind(ID3D11DeviceContext* context);
+        void Bind(D3D11StateManager& stateMngr);
+
+        // Returns the shader program of this pipeline, which is used to look up the class instances of its compute shader.
+        inline D3D11ShaderProgram* GetShaderProgram() const
+        {
+            return shaderProgram_;
+        }
 
     private:
 
+        D3D11ShaderProgram*         shaderProgram_  = nullptr;
         ComPtr<ID3D11ComputeShader> cs_;
+        long                        bindingFlags_   = 0;    // binding tables read by the compute shader (see D3D11BindingFlags)
 
 };
 
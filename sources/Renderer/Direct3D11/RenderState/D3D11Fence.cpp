@@ -0,0 +1,77 @@
+/*
+ * D3D11Fence.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11Fence.h"
+#include "../../DXCommon/DXCore.h"
+#include <chrono>
+#include <thread>
+
+
+namespace LLGL
+{
+
+
+D3D11Fence::D3D11Fence(ID3D11Device* device, ID3D11DeviceContext* immediateContext) :
+    context_ { immediateContext }
+{
+    /* Create event query, which is signaled when all previous commands have been completed */
+    D3D11_QUERY_DESC queryDesc;
+    {
+        queryDesc.Query     = D3D11_QUERY_EVENT;
+        queryDesc.MiscFlags = 0;
+    }
+    auto hr = device->CreateQuery(&queryDesc, event_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 event query for fence");
+}
+
+bool D3D11Fence::IsSignaled()
+{
+    if (pending_)
+    {
+        /* Poll event query without flushing the command queue */
+        if (context_->GetData(event_.Get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+            return false;
+        pending_ = false;
+    }
+    return true;
+}
+
+bool D3D11Fence::Wait(std::uint64_t timeout)
+{
+    if (pending_)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+
+        /* Poll event query and flush the command queue, otherwise the query might never be signaled */
+        while (context_->GetData(event_.Get(), nullptr, 0, 0) != S_OK)
+        {
+            if (timeout != ~0ull)
+            {
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+                if (static_cast<std::uint64_t>(elapsed.count()) >= timeout)
+                    return false;
+            }
+            std::this_thread::yield();
+        }
+
+        pending_ = false;
+    }
+    return true;
+}
+
+void D3D11Fence::Signal(ID3D11DeviceContext* context)
+{
+    context->End(event_.Get());
+    pending_ = true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
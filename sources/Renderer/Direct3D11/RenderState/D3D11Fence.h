@@ -0,0 +1,54 @@
+/*
+ * D3D11Fence.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_FENCE_H
+#define LLGL_D3D11_FENCE_H
+
+
+#include <LLGL/Fence.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d11.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Fence object based on a D3D11 event query.
+The query can be ended on a deferred context, but its state is always polled on the immediate context.
+*/
+class D3D11Fence : public Fence
+{
+
+    public:
+
+        D3D11Fence(ID3D11Device* device, ID3D11DeviceContext* immediateContext);
+
+        bool IsSignaled() override;
+        bool Wait(std::uint64_t timeout) override;
+
+        // Ends the event query on the specified (immediate or deferred) device context.
+        void Signal(ID3D11DeviceContext* context);
+
+    private:
+
+        ComPtr<ID3D11DeviceContext> context_;
+        ComPtr<ID3D11Query>         event_;
+        bool                        pending_    = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,6 +6,8 @@
  */
 
 #include "D3D11GraphicsPipeline.h"
+#include "D3D11StateManager.h"
+#include "D3D11RenderStateCache.h"
 #include "../D3D11RenderSystem.h"
 #include "../D3D11Types.h"
 #include "../Shader/D3D11ShaderProgram.h"
@@ -14,7 +16,9 @@
 #include "../../CheckedCast.h"
 #include "../../Assertion.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/Exception.h"
 #include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
@@ -22,13 +26,18 @@ namespace LLGL
 
 
 D3D11GraphicsPipeline::D3D11GraphicsPipeline(
-    ID3D11Device* device, const GraphicsPipelineDescriptor& desc)
+    D3D11RenderStateCache& stateCache, const GraphicsPipelineDescriptor& desc)
 {
+    /* Multiview rendering (view instancing) is only implemented for OpenGL */
+    if (desc.viewMask != 0)
+        ThrowNotSupported("multiview rendering");
+
     /* Validate pointers and get D3D shader objects */
     LLGL_ASSERT_PTR(desc.shaderProgram);
 
     auto shaderProgramD3D = LLGL_CAST(D3D11ShaderProgram*, desc.shaderProgram);
     GetShaderObjects(*shaderProgramD3D);
+    shaderProgram_ = shaderProgramD3D;
 
     //if (!shaderProgramD3D->GetInputLayout())
     //    throw std::runtime_error("can not create graphics pipeline while shader program has no D3D11 input layout");
@@ -44,29 +53,34 @@ D3D11GraphicsPipeline::D3D11GraphicsPipeline(
     /* Store blend factor */
     blendFactor_ = desc.blend.blendFactor;
 
+    /* Store push constants layout */
+    pushConstantsSize_ = desc.pushConstants.size;
+    pushConstantsSlot_ = desc.pushConstants.slot;
+
     /* Create D3D11 render state objects */
-    CreateDepthStencilState(device, desc.depth, desc.stencil);
-    CreateRasterizerState(device, desc.rasterizer);
-    CreateBlendState(device, desc.blend);
+    CreateDepthStencilState(stateCache, desc.depth, desc.stencil);
+    CreateRasterizerState(stateCache, desc.rasterizer);
+    CreateBlendState(stateCache, desc.blend);
 }
 
-void D3D11GraphicsPipeline::Bind(ID3D11DeviceContext* context)
+void D3D11GraphicsPipeline::Bind(D3D11StateManager& stateMngr)
 {
     /* Setup input-assembly states */
-    context->IASetPrimitiveTopology(primitiveTopology_);
-    context->IASetInputLayout(inputLayout_.Get());
+    stateMngr.SetPrimitiveTopology(primitiveTopology_);
+    stateMngr.SetInputLayout(inputLayout_.Get());
 
     /* Setup shader states */
-    context->VSSetShader(vs_.Get(), nullptr, 0);
-    context->HSSetShader(hs_.Get(), nullptr, 0);
-    context->DSSetShader(ds_.Get(), nullptr, 0);
-    context->GSSetShader(gs_.Get(), nullptr, 0);
-    context->PSSetShader(ps_.Get(), nullptr, 0);
+    stateMngr.SetVertexShader(vs_.Get());
+    stateMngr.SetHullShader(hs_.Get());
+    stateMngr.SetDomainShader(ds_.Get());
+    stateMngr.SetGeometryShader(gs_.Get());
+    stateMngr.SetPixelShader(ps_.Get());
+    stateMngr.SetGraphicsBindingUsage(stageBindingFlags_);
 
     /* Setup render states */
-    context->RSSetState(rasterizerState_.Get());
-    context->OMSetDepthStencilState(depthStencilState_.Get(), stencilRef_);
-    context->OMSetBlendState(blendState_.Get(), blendFactor_.Ptr(), sampleMask_);
+    stateMngr.SetRasterizerState(rasterizerState_.Get());
+    stateMngr.SetDepthStencilState(depthStencilState_.Get(), stencilRef_);
+    stateMngr.SetBlendState(blendState_.Get(), blendFactor_.Ptr(), sampleMask_);
 }
 
 
@@ -81,6 +95,19 @@ void D3D11GraphicsPipeline::GetShaderObjects(D3D11ShaderProgram& shaderProgramD3
     if (shaderProgramD3D.GetDS()) { ds_ = shaderProgramD3D.GetDS()->GetHardwareShader().ds; }
     if (shaderProgramD3D.GetGS()) { gs_ = shaderProgramD3D.GetGS()->GetHardwareShader().gs; }
     if (shaderProgramD3D.GetPS()) { ps_ = shaderProgramD3D.GetPS()->GetHardwareShader().ps; }
+
+    /* Store reflected binding tables of each stage; stages without shader read no bindings at all */
+    const D3D11Shader* shaders[] =
+    {
+        shaderProgramD3D.GetVS(),
+        shaderProgramD3D.GetHS(),
+        shaderProgramD3D.GetDS(),
+        shaderProgramD3D.GetGS(),
+        shaderProgramD3D.GetPS(),
+    };
+
+    for (std::size_t i = 0; i < numGraphicsStages; ++i)
+        stageBindingFlags_[i] = (shaders[i] != nullptr ? shaders[i]->GetBindingFlags() : 0);
 }
 
 static void Convert(D3D11_DEPTH_STENCILOP_DESC& to, const StencilFaceDescriptor& from)
@@ -91,9 +118,10 @@ static void Convert(D3D11_DEPTH_STENCILOP_DESC& to, const StencilFaceDescriptor&
     to.StencilFunc          = D3D11Types::Map(from.compareOp);
 }
 
-void D3D11GraphicsPipeline::CreateDepthStencilState(ID3D11Device* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
+void D3D11GraphicsPipeline::CreateDepthStencilState(D3D11RenderStateCache& stateCache, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
 {
     D3D11_DEPTH_STENCIL_DESC stateDesc;
+    ::memset(&stateDesc, 0, sizeof(stateDesc));
     {
         stateDesc.DepthEnable       = (depthDesc.testEnabled ? TRUE : FALSE);
         stateDesc.DepthWriteMask    = (depthDesc.writeEnabled ? D3D11_DEPTH_WRITE_MASK_ALL : D3D11_DEPTH_WRITE_MASK_ZERO);
@@ -105,13 +133,13 @@ void D3D11GraphicsPipeline::CreateDepthStencilState(ID3D11Device* device, const
         Convert(stateDesc.FrontFace, stencilDesc.front);
         Convert(stateDesc.BackFace, stencilDesc.back);
     }
-    auto hr = device->CreateDepthStencilState(&stateDesc, &depthStencilState_);
-    DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil state");
+    depthStencilState_ = stateCache.GetDepthStencilState(stateDesc);
 }
 
-void D3D11GraphicsPipeline::CreateRasterizerState(ID3D11Device* device, const RasterizerDescriptor& desc)
+void D3D11GraphicsPipeline::CreateRasterizerState(D3D11RenderStateCache& stateCache, const RasterizerDescriptor& desc)
 {
-    D3D11_RASTERIZER_DESC stateDesc;
+    D3D11_RASTERIZER_DESC2 stateDesc;
+    ::memset(&stateDesc, 0, sizeof(stateDesc));
     {
         stateDesc.FillMode              = D3D11Types::Map(desc.polygonMode);
         stateDesc.CullMode              = D3D11Types::Map(desc.cullMode);
@@ -123,9 +151,10 @@ void D3D11GraphicsPipeline::CreateRasterizerState(ID3D11Device* device, const Ra
         stateDesc.ScissorEnable         = (desc.scissorTestEnabled ? TRUE : FALSE);
         stateDesc.MultisampleEnable     = (desc.multiSampling.enabled ? TRUE : FALSE);
         stateDesc.AntialiasedLineEnable = (desc.antiAliasedLineEnabled ? TRUE : FALSE);
+        stateDesc.ForcedSampleCount     = 0;
+        stateDesc.ConservativeRaster    = (desc.conservativeRasterization ? D3D11_CONSERVATIVE_RASTERIZATION_MODE_ON : D3D11_CONSERVATIVE_RASTERIZATION_MODE_OFF);
     }
-    auto hr = device->CreateRasterizerState(&stateDesc, &rasterizerState_);
-    DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+    rasterizerState_ = stateCache.GetRasterizerState(stateDesc);
 }
 
 static UINT8 GetColorWriteMask(const ColorRGBAb& color)
@@ -140,9 +169,10 @@ static UINT8 GetColorWriteMask(const ColorRGBAb& color)
     return mask;
 }
 
-void D3D11GraphicsPipeline::CreateBlendState(ID3D11Device* device, const BlendDescriptor& desc)
+void D3D11GraphicsPipeline::CreateBlendState(D3D11RenderStateCache& stateCache, const BlendDescriptor& desc)
 {
     D3D11_BLEND_DESC stateDesc;
+    ::memset(&stateDesc, 0, sizeof(stateDesc));
     {
         stateDesc.AlphaToCoverageEnable  = FALSE;
         stateDesc.IndependentBlendEnable = (desc.targets.size() > 1 ? TRUE : FALSE);
@@ -177,8 +207,7 @@ void D3D11GraphicsPipeline::CreateBlendState(ID3D11Device* device, const BlendDe
             }
         }
     }
-    auto hr = device->CreateBlendState(&stateDesc, &blendState_);
-    DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+    blendState_ = stateCache.GetBlendState(stateDesc);
 }
 
 
@@ -20,6 +20,8 @@ namespace LLGL
 
 
 class D3D11ShaderProgram;
+class D3D11StateManager;
+class D3D11RenderStateCache;
 
 class D3D11GraphicsPipeline : public GraphicsPipeline
 {
@@ -27,20 +29,41 @@ class D3D11GraphicsPipeline : public GraphicsPipeline
     public:
 
         D3D11GraphicsPipeline(
-            ID3D11Device* device,
+            D3D11RenderStateCache& stateCache,
             const GraphicsPipelineDescriptor& desc
         );
 
-        void Bind(ID3D11DeviceContext* context);
+        void Bind(D3D11StateManager& stateMngr);
+
+        // Returns the size (in bytes) of the push constants, or 0 if this pipeline has no push constants.
+        inline UINT GetPushConstantsSize() const
+        {
+            return pushConstantsSize_;
+        }
+
+        // Returns the constant buffer slot of the push constants.
+        inline UINT GetPushConstantsSlot() const
+        {
+            return pushConstantsSlot_;
+        }
+
+        // Returns the shader program of this pipeline, which is used to look up the class instances of its shaders.
+        inline D3D11ShaderProgram* GetShaderProgram() const
+        {
+            return shaderProgram_;
+        }
 
     private:
 
+        static const std::size_t numGraphicsStages = 5;
+
         void GetShaderObjects(D3D11ShaderProgram& shaderProgramD3D);
 
-        void CreateDepthStencilState(ID3D11Device* device, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
-        void CreateRasterizerState(ID3D11Device* device, const RasterizerDescriptor& desc);
-        void CreateBlendState(ID3D11Device* device, const BlendDescriptor& desc);
+        void CreateDepthStencilState(D3D11RenderStateCache& stateCache, const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
+        void CreateRasterizerState(D3D11RenderStateCache& stateCache, const RasterizerDescriptor& desc);
+        void CreateBlendState(D3D11RenderStateCache& stateCache, const BlendDescriptor& desc);
 
+        D3D11ShaderProgram*             shaderProgram_      = nullptr;
         ComPtr<ID3D11InputLayout>       inputLayout_;
 
         ComPtr<ID3D11VertexShader>      vs_;
@@ -48,7 +71,9 @@ class D3D11GraphicsPipeline : public GraphicsPipeline
         ComPtr<ID3D11DomainShader>      ds_;
         ComPtr<ID3D11GeometryShader>    gs_;
         ComPtr<ID3D11PixelShader>       ps_;
+        long                            stageBindingFlags_[numGraphicsStages] = {}; // binding tables read by each stage (see D3D11BindingFlags)
 
+        // Render states are shared with all pipelines of equal state descriptors (see D3D11RenderStateCache)
         ComPtr<ID3D11DepthStencilState> depthStencilState_;
         ComPtr<ID3D11RasterizerState>   rasterizerState_;
         ComPtr<ID3D11BlendState>        blendState_;
@@ -58,6 +83,9 @@ class D3D11GraphicsPipeline : public GraphicsPipeline
         ColorRGBAf                      blendFactor_ { 0.0f, 0.0f, 0.0f, 0.0f };
         UINT                            sampleMask_         = ~0;
 
+        UINT                            pushConstantsSize_  = 0;
+        UINT                            pushConstantsSlot_  = 0;
+
 };
 
 
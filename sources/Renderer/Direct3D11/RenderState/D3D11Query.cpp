@@ -52,6 +52,11 @@ D3D11Query::D3D11Query(ID3D11Device* device, const QueryDescriptor& desc) :
         timeStampQueryBegin_    = DXCreateQuery(device, queryDesc);
         timeStampQueryEnd_      = DXCreateQuery(device, queryDesc);
     }
+    else if (queryObjectType_ == D3D11_QUERY_TIMESTAMP)
+    {
+        queryDesc.Query         = D3D11_QUERY_TIMESTAMP_DISJOINT;
+        disjointQuery_          = DXCreateQuery(device, queryDesc);
+    }
 }
 
 
@@ -64,6 +64,12 @@ class D3D11Query : public Query
             return timeStampQueryEnd_.Get();
         }
 
+        // Returns the disjoint query, which provides the frequency for the special query type: Timestamp
+        inline ID3D11Query* GetDisjointQuery() const
+        {
+            return disjointQuery_.Get();
+        }
+
     private:
 
         D3D11_QUERY         queryObjectType_ = D3D11_QUERY_EVENT;
@@ -74,6 +80,9 @@ class D3D11Query : public Query
         ComPtr<ID3D11Query> timeStampQueryBegin_;
         ComPtr<ID3D11Query> timeStampQueryEnd_;
 
+        // Query object for the special query type: Timestamp
+        ComPtr<ID3D11Query> disjointQuery_;
+
 };
 
 
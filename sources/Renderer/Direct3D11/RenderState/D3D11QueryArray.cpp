@@ -0,0 +1,31 @@
+/*
+ * D3D11QueryArray.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11QueryArray.h"
+#include "D3D11Query.h"
+#include "../../../Core/Helper.h"
+
+
+namespace LLGL
+{
+
+
+D3D11QueryArray::D3D11QueryArray(unsigned int numQueries, Query* const * queryArray) :
+    QueryArray { (*queryArray)->GetType(), numQueries }
+{
+    /* Store the pointer of each D3D11Query inside the array */
+    queries_.reserve(numQueries);
+    while (auto next = NextArrayResource<D3D11Query>(numQueries, queryArray))
+        queries_.push_back(next);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,50 @@
+/*
+ * D3D11QueryArray.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_QUERY_ARRAY_H
+#define LLGL_D3D11_QUERY_ARRAY_H
+
+
+#include <LLGL/QueryArray.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class Query;
+class D3D11Query;
+
+class D3D11QueryArray : public QueryArray
+{
+
+    public:
+
+        D3D11QueryArray(unsigned int numQueries, Query* const * queryArray);
+
+        // Returns the array of query objects.
+        inline const std::vector<D3D11Query*>& GetQueries() const
+        {
+            return queries_;
+        }
+
+    private:
+
+        std::vector<D3D11Query*> queries_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
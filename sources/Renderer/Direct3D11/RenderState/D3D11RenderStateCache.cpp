@@ -0,0 +1,179 @@
+/*
+ * D3D11RenderStateCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11RenderStateCache.h"
+#include "../../DXCommon/DXCore.h"
+
+
+namespace LLGL
+{
+
+
+D3D11RenderStateCache::D3D11RenderStateCache(ID3D11Device* device) :
+    device_ { device }
+{
+    device_.As(&device3_);
+}
+
+ComPtr<ID3D11RasterizerState> D3D11RenderStateCache::GetRasterizerState(const D3D11_RASTERIZER_DESC2& desc)
+{
+    auto& state = rasterizerStates_[desc];
+    if (!state)
+    {
+        HRESULT hr = S_OK;
+
+        if (device3_)
+        {
+            ComPtr<ID3D11RasterizerState2> state2;
+            hr = device3_->CreateRasterizerState2(&desc, state2.GetAddressOf());
+            state = state2;
+        }
+        else if (desc.ForcedSampleCount != 0 || desc.ConservativeRaster != D3D11_CONSERVATIVE_RASTERIZATION_MODE_OFF)
+            hr = E_NOTIMPL;
+        else
+        {
+            /* Leading members of D3D11_RASTERIZER_DESC2 match D3D11_RASTERIZER_DESC */
+            D3D11_RASTERIZER_DESC desc0;
+            {
+                desc0.FillMode              = desc.FillMode;
+                desc0.CullMode              = desc.CullMode;
+                desc0.FrontCounterClockwise = desc.FrontCounterClockwise;
+                desc0.DepthBias             = desc.DepthBias;
+                desc0.DepthBiasClamp        = desc.DepthBiasClamp;
+                desc0.SlopeScaledDepthBias  = desc.SlopeScaledDepthBias;
+                desc0.DepthClipEnable       = desc.DepthClipEnable;
+                desc0.ScissorEnable         = desc.ScissorEnable;
+                desc0.MultisampleEnable     = desc.MultisampleEnable;
+                desc0.AntialiasedLineEnable = desc.AntialiasedLineEnable;
+            }
+            hr = device_->CreateRasterizerState(&desc0, state.ReleaseAndGetAddressOf());
+        }
+
+        if (FAILED(hr))
+        {
+            rasterizerStates_.erase(desc);
+            DXThrowIfFailed(hr, "failed to create D3D11 rasterizer state");
+        }
+    }
+    return state;
+}
+
+ComPtr<ID3D11DepthStencilState> D3D11RenderStateCache::GetDepthStencilState(const D3D11_DEPTH_STENCIL_DESC& desc)
+{
+    auto& state = depthStencilStates_[desc];
+    if (!state)
+    {
+        auto hr = device_->CreateDepthStencilState(&desc, state.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            depthStencilStates_.erase(desc);
+            DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil state");
+        }
+    }
+    return state;
+}
+
+ComPtr<ID3D11BlendState> D3D11RenderStateCache::GetBlendState(const D3D11_BLEND_DESC& desc)
+{
+    auto& state = blendStates_[desc];
+    if (!state)
+    {
+        auto hr = device_->CreateBlendState(&desc, state.ReleaseAndGetAddressOf());
+        if (FAILED(hr))
+        {
+            blendStates_.erase(desc);
+            DXThrowIfFailed(hr, "failed to create D3D11 blend state");
+        }
+    }
+    return state;
+}
+
+template <typename T>
+static void AppendKeyBytes(std::string& key, const T& value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Serializes the input elements and the input signature into a key; semantic names are copied, since their pointers differ between shader programs.
+static std::string MakeInputLayoutKey(const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElements, ID3DBlob* inputSignature)
+{
+    std::string key;
+
+    AppendKeyBytes(key, static_cast<UINT>(inputElements.size()));
+    for (const auto& elementDesc : inputElements)
+    {
+        key.append(elementDesc.SemanticName);
+        key.push_back('\0');
+        AppendKeyBytes(key, elementDesc.SemanticIndex);
+        AppendKeyBytes(key, elementDesc.Format);
+        AppendKeyBytes(key, elementDesc.InputSlot);
+        AppendKeyBytes(key, elementDesc.AlignedByteOffset);
+        AppendKeyBytes(key, elementDesc.InputSlotClass);
+        AppendKeyBytes(key, elementDesc.InstanceDataStepRate);
+    }
+
+    key.append(static_cast<const char*>(inputSignature->GetBufferPointer()), inputSignature->GetBufferSize());
+
+    return key;
+}
+
+ComPtr<ID3D11InputLayout> D3D11RenderStateCache::GetInputLayout(const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElements, ID3DBlob* inputSignature)
+{
+    auto key = MakeInputLayoutKey(inputElements, inputSignature);
+
+    std::lock_guard<std::mutex> guard { inputLayoutsMutex_ };
+
+    auto& inputLayout = inputLayouts_[key];
+    if (!inputLayout)
+    {
+        auto hr = device_->CreateInputLayout(
+            inputElements.data(),
+            static_cast<UINT>(inputElements.size()),
+            inputSignature->GetBufferPointer(),
+            inputSignature->GetBufferSize(),
+            inputLayout.ReleaseAndGetAddressOf()
+        );
+        if (FAILED(hr))
+        {
+            inputLayouts_.erase(key);
+            DXThrowIfFailed(hr, "failed to create D3D11 input layout");
+        }
+    }
+    return inputLayout;
+}
+
+template <typename TMap>
+static void ReleaseUnusedEntries(TMap& stateMap)
+{
+    for (auto it = stateMap.begin(); it != stateMap.end();)
+    {
+        /* Query reference count of the state object, which is 1 if only this cache holds it */
+        auto state = it->second.Get();
+        state->AddRef();
+        if (state->Release() == 1)
+            it = stateMap.erase(it);
+        else
+            ++it;
+    }
+}
+
+void D3D11RenderStateCache::ReleaseUnusedStates()
+{
+    ReleaseUnusedEntries(rasterizerStates_);
+    ReleaseUnusedEntries(depthStencilStates_);
+    ReleaseUnusedEntries(blendStates_);
+
+    std::lock_guard<std::mutex> guard { inputLayoutsMutex_ };
+    ReleaseUnusedEntries(inputLayouts_);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,105 @@
+/*
+ * D3D11RenderStateCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_RENDER_STATE_CACHE_H
+#define LLGL_D3D11_RENDER_STATE_CACHE_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include "../../../Core/Hash.h"
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+#include <cstring>
+#include <d3d11_3.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Cache of D3D11 rasterizer, depth-stencil, and blend states, which are shared across all graphics pipelines,
+and of input layouts, which are shared across all shader programs.
+Pipelines with equal state descriptors get the same state object, so the D3D11StateManager can filter
+redundant state changes between such pipelines by pointer comparison.
+State descriptors are hashed and compared by their bytes, so they must be zero initialized before they are filled.
+The render states are not thread safe; the render system creates all graphics pipelines under its pipeline mutex.
+Input layouts are guarded by their own mutex, since shader programs can build their input layouts on any thread.
+*/
+class D3D11RenderStateCache
+{
+
+    public:
+
+        // Queries the Direct3D 11.3 device interface, which is required for conservative rasterization.
+        D3D11RenderStateCache(ID3D11Device* device);
+
+        D3D11RenderStateCache(const D3D11RenderStateCache&) = delete;
+        D3D11RenderStateCache& operator = (const D3D11RenderStateCache&) = delete;
+
+        // Returns the rasterizer state for the extended descriptor. Without the Direct3D 11.3 runtime, the extended members must be zero.
+        ComPtr<ID3D11RasterizerState> GetRasterizerState(const D3D11_RASTERIZER_DESC2& desc);
+        ComPtr<ID3D11DepthStencilState> GetDepthStencilState(const D3D11_DEPTH_STENCIL_DESC& desc);
+        ComPtr<ID3D11BlendState> GetBlendState(const D3D11_BLEND_DESC& desc);
+
+        // Returns the input layout for the specified input elements and vertex shader input signature.
+        ComPtr<ID3D11InputLayout> GetInputLayout(const std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElements, ID3DBlob* inputSignature);
+
+        // Releases all state objects that are no longer used by any graphics pipeline.
+        void ReleaseUnusedStates();
+
+    private:
+
+        // Hash function object for D3D11 state descriptors (over the descriptor bytes).
+        template <typename T>
+        struct DescHash
+        {
+            std::size_t operator () (const T& desc) const
+            {
+                auto hash = HashInitValue();
+                HashValue(hash, desc);
+                return static_cast<std::size_t>(hash);
+            }
+        };
+
+        template <typename T>
+        struct DescEqual
+        {
+            bool operator () (const T& lhs, const T& rhs) const
+            {
+                return (std::memcmp(&lhs, &rhs, sizeof(T)) == 0);
+            }
+        };
+
+        template <typename TDesc, typename TState>
+        using StateMap = std::unordered_map<TDesc, ComPtr<TState>, DescHash<TDesc>, DescEqual<TDesc>>;
+
+        ComPtr<ID3D11Device>                                                device_;
+        ComPtr<ID3D11Device3>                                               device3_;   // only available with Direct3D 11.3 runtime
+
+        StateMap<D3D11_RASTERIZER_DESC2, ID3D11RasterizerState>             rasterizerStates_;
+        StateMap<D3D11_DEPTH_STENCIL_DESC, ID3D11DepthStencilState>         depthStencilStates_;
+        StateMap<D3D11_BLEND_DESC, ID3D11BlendState>                        blendStates_;
+
+        // Input layouts with the serialized input elements and input signature as key.
+        std::unordered_map<std::string, ComPtr<ID3D11InputLayout>>          inputLayouts_;
+        std::mutex                                                          inputLayoutsMutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
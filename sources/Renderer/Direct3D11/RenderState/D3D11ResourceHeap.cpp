@@ -0,0 +1,165 @@
+/*
+ * D3D11ResourceHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11ResourceHeap.h"
+#include "../Buffer/D3D11ConstantBuffer.h"
+#include "../Buffer/D3D11StorageBuffer.h"
+#include "../Texture/D3D11Texture.h"
+#include "../Texture/D3D11Sampler.h"
+#include "../../CheckedCast.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Returns true if the specified resource view binds the UAV of a storage buffer.
+static bool IsUAVResourceView(const ResourceViewDescriptor& resourceView)
+{
+    if (resourceView.type == ResourceType::StorageBuffer && (resourceView.shaderStageFlags & ShaderStageFlags::ReadOnlyResource) == 0)
+    {
+        auto storageBufferD3D = LLGL_CAST(D3D11StorageBuffer*, resourceView.buffer);
+        return storageBufferD3D->HasUAV();
+    }
+    return false;
+}
+
+/*
+Collects all resource views that match the specified predicate sorted by their shader stages and slot index,
+and merges consecutive slots with the same shader stages into segments, so each segment can be bound with a single call per shader stage.
+*/
+template <typename TPredicate, typename TAppendFunc>
+static void BuildSegments(
+    const ResourceHeapDescriptor&               desc,
+    std::vector<D3D11ResourceBindingSegment>&   segments,
+    TPredicate                                  predicate,
+    TAppendFunc                                 appendResource)
+{
+    std::vector<const ResourceViewDescriptor*> resourceViews;
+
+    for (const auto& resourceView : desc.resourceViews)
+    {
+        if (predicate(resourceView))
+            resourceViews.push_back(&resourceView);
+    }
+
+    auto GetStageFlags = [](const ResourceViewDescriptor* resourceView)
+    {
+        return (resourceView->shaderStageFlags & ShaderStageFlags::AllStages);
+    };
+
+    std::stable_sort(
+        resourceViews.begin(), resourceViews.end(),
+        [&](const ResourceViewDescriptor* lhs, const ResourceViewDescriptor* rhs)
+        {
+            if (GetStageFlags(lhs) != GetStageFlags(rhs))
+                return (GetStageFlags(lhs) < GetStageFlags(rhs));
+            return (lhs->slot < rhs->slot);
+        }
+    );
+
+    std::size_t offset = 0;
+
+    for (auto resourceView : resourceViews)
+    {
+        const auto slot         = static_cast<UINT>(resourceView->slot);
+        const auto stageFlags   = GetStageFlags(resourceView);
+
+        if ( !segments.empty()                                          &&
+             segments.back().shaderStageFlags == stageFlags             &&
+             segments.back().startSlot + segments.back().count == slot )
+        {
+            /* Append resource to previous segment */
+            ++segments.back().count;
+        }
+        else
+        {
+            /* Start new segment */
+            segments.push_back({ slot, 1, stageFlags, offset });
+        }
+
+        appendResource(*resourceView);
+        ++offset;
+    }
+}
+
+D3D11ResourceHeap::D3D11ResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    /* Build segments for constant buffers */
+    BuildSegments(
+        desc, cbvSegments_,
+        [](const ResourceViewDescriptor& resourceView)
+        {
+            return (resourceView.type == ResourceType::ConstantBuffer);
+        },
+        [&](const ResourceViewDescriptor& resourceView)
+        {
+            auto constantBufferD3D = LLGL_CAST(D3D11ConstantBuffer*, resourceView.buffer);
+            constantBuffers_.push_back(constantBufferD3D->Get());
+        }
+    );
+
+    /* Build segments for SRVs of textures and storage buffers */
+    BuildSegments(
+        desc, srvSegments_,
+        [](const ResourceViewDescriptor& resourceView)
+        {
+            return
+            (
+                resourceView.type == ResourceType::Texture ||
+                (resourceView.type == ResourceType::StorageBuffer && !IsUAVResourceView(resourceView))
+            );
+        },
+        [&](const ResourceViewDescriptor& resourceView)
+        {
+            if (resourceView.type == ResourceType::Texture)
+            {
+                auto textureD3D = LLGL_CAST(D3D11Texture*, resourceView.texture);
+                resourceViews_.push_back(textureD3D->GetSRV());
+            }
+            else
+            {
+                auto storageBufferD3D = LLGL_CAST(D3D11StorageBuffer*, resourceView.buffer);
+                resourceViews_.push_back(storageBufferD3D->GetSRV());
+            }
+        }
+    );
+
+    /* Build segments for UAVs of storage buffers */
+    BuildSegments(
+        desc, uavSegments_,
+        IsUAVResourceView,
+        [&](const ResourceViewDescriptor& resourceView)
+        {
+            auto storageBufferD3D = LLGL_CAST(D3D11StorageBuffer*, resourceView.buffer);
+            unorderedViews_.push_back(storageBufferD3D->GetUAV());
+            initialCounts_.push_back(storageBufferD3D->GetInitialCount());
+        }
+    );
+
+    /* Build segments for sampler states */
+    BuildSegments(
+        desc, samplerSegments_,
+        [](const ResourceViewDescriptor& resourceView)
+        {
+            return (resourceView.type == ResourceType::Sampler);
+        },
+        [&](const ResourceViewDescriptor& resourceView)
+        {
+            auto samplerD3D = LLGL_CAST(D3D11Sampler*, resourceView.sampler);
+            samplerStates_.push_back(samplerD3D->GetSamplerState());
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
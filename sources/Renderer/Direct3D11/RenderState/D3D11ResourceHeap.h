@@ -0,0 +1,109 @@
+/*
+ * D3D11ResourceHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_RESOURCE_HEAP_H
+#define LLGL_D3D11_RESOURCE_HEAP_H
+
+
+#include <LLGL/ResourceHeap.h>
+#include <d3d11.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Range of consecutive binding slots for the same shader stages, whose resources are stored at 'offset' in the respective array.
+struct D3D11ResourceBindingSegment
+{
+    UINT        startSlot;
+    UINT        count;
+    long        shaderStageFlags;
+    std::size_t offset;
+};
+
+class D3D11ResourceHeap : public ResourceHeap
+{
+
+    public:
+
+        D3D11ResourceHeap(const ResourceHeapDescriptor& desc);
+
+        // Returns the segments for the constant buffers.
+        inline const std::vector<D3D11ResourceBindingSegment>& GetCBVSegments() const
+        {
+            return cbvSegments_;
+        }
+
+        // Returns the segments for the shader resource views of textures and read-only storage buffers.
+        inline const std::vector<D3D11ResourceBindingSegment>& GetSRVSegments() const
+        {
+            return srvSegments_;
+        }
+
+        // Returns the segments for the unordered access views of storage buffers.
+        inline const std::vector<D3D11ResourceBindingSegment>& GetUAVSegments() const
+        {
+            return uavSegments_;
+        }
+
+        // Returns the segments for the sampler states.
+        inline const std::vector<D3D11ResourceBindingSegment>& GetSamplerSegments() const
+        {
+            return samplerSegments_;
+        }
+
+        inline const std::vector<ID3D11Buffer*>& GetConstantBuffers() const
+        {
+            return constantBuffers_;
+        }
+
+        inline const std::vector<ID3D11ShaderResourceView*>& GetResourceViews() const
+        {
+            return resourceViews_;
+        }
+
+        inline const std::vector<ID3D11UnorderedAccessView*>& GetUnorderedViews() const
+        {
+            return unorderedViews_;
+        }
+
+        inline const std::vector<UINT>& GetInitialCounts() const
+        {
+            return initialCounts_;
+        }
+
+        inline const std::vector<ID3D11SamplerState*>& GetSamplerStates() const
+        {
+            return samplerStates_;
+        }
+
+    private:
+
+        std::vector<D3D11ResourceBindingSegment>    cbvSegments_;
+        std::vector<D3D11ResourceBindingSegment>    srvSegments_;
+        std::vector<D3D11ResourceBindingSegment>    uavSegments_;
+        std::vector<D3D11ResourceBindingSegment>    samplerSegments_;
+
+        std::vector<ID3D11Buffer*>                  constantBuffers_;
+        std::vector<ID3D11ShaderResourceView*>      resourceViews_;
+        std::vector<ID3D11UnorderedAccessView*>     unorderedViews_;
+        std::vector<UINT>                           initialCounts_;
+        std::vector<ID3D11SamplerState*>            samplerStates_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,18 +6,47 @@
  */
 
 #include "D3D11StateManager.h"
-#include <cstddef>
+#include <LLGL/ShaderFlags.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
 
 
 namespace LLGL
 {
 
 
-D3D11StateManager::D3D11StateManager(ComPtr<ID3D11DeviceContext>& context) :
+#define VS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::VertexStage        ) != 0 )
+#define HS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::TessControlStage   ) != 0 )
+#define DS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::TessEvaluationStage) != 0 )
+#define GS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::GeometryStage      ) != 0 )
+#define PS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::FragmentStage      ) != 0 )
+#define CS_STAGE(FLAG)  ( ((FLAG) & ShaderStageFlags::ComputeStage       ) != 0 )
+
+// Returns true if the shader stage with the specified index (in the order VS, HS, DS, GS, PS, CS) is included in the shader stage flags.
+static bool IsShaderStageEnabled(std::size_t stage, long shaderStageFlags)
+{
+    switch (stage)
+    {
+        case 0: return VS_STAGE(shaderStageFlags);
+        case 1: return HS_STAGE(shaderStageFlags);
+        case 2: return DS_STAGE(shaderStageFlags);
+        case 3: return GS_STAGE(shaderStageFlags);
+        case 4: return PS_STAGE(shaderStageFlags);
+        case 5: return CS_STAGE(shaderStageFlags);
+        default: return false;
+    }
+}
+
+D3D11StateManager::D3D11StateManager(const ComPtr<ID3D11DeviceContext>& context) :
     context_ { context }
 {
+    context_.As(&context1_);
+    stageBindingUsage_.fill(D3D11BindingFlags::All);
 }
 
+/* ----- Rasterizer and output-merger ----- */
+
 void D3D11StateManager::SetViewports(unsigned int numViewports, const Viewport* viewportArray)
 {
     /* Check (at compile time) if D3D11_VIEWPORT and Viewport structures can be safly reinterpret-casted */
@@ -34,8 +63,9 @@ void D3D11StateManager::SetViewports(unsigned int numViewports, const Viewport*
     }
     else
     {
-        /* Convert viewport into D3D viewport */
-        std::vector<D3D11_VIEWPORT> viewportsD3D(numViewports);
+        /* Convert viewport into D3D viewport (in a fixed-size array to avoid heap allocations) */
+        D3D11_VIEWPORT viewportsD3D[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+        numViewports = std::min(numViewports, static_cast<unsigned int>(D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE));
 
         for (unsigned int i = 0; i < numViewports; ++i)
         {
@@ -50,14 +80,16 @@ void D3D11StateManager::SetViewports(unsigned int numViewports, const Viewport*
             dest.MaxDepth   = src.maxDepth;
         }
 
-        context_->RSSetViewports(numViewports, viewportsD3D.data());
+        context_->RSSetViewports(numViewports, viewportsD3D);
     }
 }
 
 void D3D11StateManager::SetScissors(unsigned int numScissors, const Scissor* scissorArray)
 {
-    std::vector<D3D11_RECT> scissorsD3D(numScissors);
-    
+    /* Convert scissors into D3D rectangles (in a fixed-size array to avoid heap allocations) */
+    D3D11_RECT scissorsD3D[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+    numScissors = std::min(numScissors, static_cast<unsigned int>(D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE));
+
     for (unsigned int i = 0; i < numScissors; ++i)
     {
         const auto& src = scissorArray[i];
@@ -69,9 +101,499 @@ void D3D11StateManager::SetScissors(unsigned int numScissors, const Scissor* sci
         dest.bottom = src.y + src.height;
     }
 
-    context_->RSSetScissorRects(numScissors, scissorsD3D.data());
+    context_->RSSetScissorRects(numScissors, scissorsD3D);
+}
+
+
+void D3D11StateManager::SetRasterizerState(ID3D11RasterizerState* rasterizerState)
+{
+    if (outputMerger_.rasterizerState != rasterizerState)
+    {
+        outputMerger_.rasterizerState = rasterizerState;
+        context_->RSSetState(rasterizerState);
+    }
+}
+
+void D3D11StateManager::SetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef)
+{
+    if (outputMerger_.depthStencilState != depthStencilState || outputMerger_.stencilRef != stencilRef)
+    {
+        outputMerger_.depthStencilState = depthStencilState;
+        outputMerger_.stencilRef        = stencilRef;
+        context_->OMSetDepthStencilState(depthStencilState, stencilRef);
+    }
+}
+
+void D3D11StateManager::SetBlendState(ID3D11BlendState* blendState, const FLOAT* blendFactor, UINT sampleMask)
+{
+    if ( outputMerger_.blendState != blendState ||
+         outputMerger_.sampleMask != sampleMask ||
+         std::memcmp(outputMerger_.blendFactor.Ptr(), blendFactor, sizeof(FLOAT) * 4) != 0 )
+    {
+        outputMerger_.blendState    = blendState;
+        outputMerger_.sampleMask    = sampleMask;
+        outputMerger_.blendFactor   = ColorRGBAf { blendFactor[0], blendFactor[1], blendFactor[2], blendFactor[3] };
+        context_->OMSetBlendState(blendState, blendFactor, sampleMask);
+    }
+}
+
+void D3D11StateManager::SetRenderTargets(UINT numRenderTargets, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView)
+{
+    /* Submit pending input views before the runtime resolves the input/output hazards */
+    FlushAllShaderResources();
+    context_->OMSetRenderTargets(numRenderTargets, renderTargetViews, depthStencilView);
+    InvalidateShaderResources();
+}
+
+/* ----- Input-assembler ----- */
+
+void D3D11StateManager::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+    if (inputAssembler_.primitiveTopology != primitiveTopology)
+    {
+        inputAssembler_.primitiveTopology = primitiveTopology;
+        context_->IASetPrimitiveTopology(primitiveTopology);
+    }
+}
+
+void D3D11StateManager::SetInputLayout(ID3D11InputLayout* inputLayout)
+{
+    if (inputAssembler_.inputLayout != inputLayout)
+    {
+        inputAssembler_.inputLayout = inputLayout;
+        context_->IASetInputLayout(inputLayout);
+    }
+}
+
+void D3D11StateManager::SetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers, const UINT* strides, const UINT* offsets)
+{
+    auto& state = vertexBuffers_;
+
+    if (startSlot + numBuffers > state.buffers.size())
+    {
+        /* Submit out-of-range bindings directly and let the runtime report the error */
+        context_->IASetVertexBuffers(startSlot, numBuffers, buffers, strides, offsets);
+        return;
+    }
+
+    for (UINT i = 0; i < numBuffers; ++i)
+    {
+        auto slot = startSlot + i;
+
+        /* Null bindings are never filtered, since an invalidated slot is also reset to null */
+        if ( buffers[i] == nullptr            ||
+             state.buffers[slot] != buffers[i] ||
+             state.strides[slot] != strides[i] ||
+             state.offsets[slot] != offsets[i] )
+        {
+            state.buffers[slot] = buffers[i];
+            state.strides[slot] = strides[i];
+            state.offsets[slot] = offsets[i];
+            state.dirtyBegin    = std::min(state.dirtyBegin, slot);
+            state.dirtyEnd      = std::max(state.dirtyEnd, slot + 1);
+        }
+    }
+}
+
+void D3D11StateManager::SetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset)
+{
+    if ( buffer == nullptr                          ||
+         inputAssembler_.indexBuffer != buffer      ||
+         inputAssembler_.indexFormat != format      ||
+         inputAssembler_.indexOffset != offset )
+    {
+        inputAssembler_.indexBuffer = buffer;
+        inputAssembler_.indexFormat = format;
+        inputAssembler_.indexOffset = offset;
+        context_->IASetIndexBuffer(buffer, format, offset);
+    }
+}
+
+void D3D11StateManager::SetStreamOutputTargets(UINT numBuffers, ID3D11Buffer* const* buffers, const UINT* offsets)
+{
+    /* Submit pending vertex buffers before the runtime resolves the input/output hazards */
+    FlushVertexBuffers();
+    context_->SOSetTargets(numBuffers, buffers, offsets);
+
+    std::fill(vertexBuffers_.buffers.begin(), vertexBuffers_.buffers.end(), nullptr);
+    inputAssembler_.indexBuffer = nullptr;
+}
+
+/* ----- Shaders ----- */
+
+void D3D11StateManager::SetVertexShader(ID3D11VertexShader* shader)
+{
+    if (shaders_.vs != shader)
+    {
+        shaders_.vs = shader;
+        context_->VSSetShader(shader, nullptr, 0);
+    }
+}
+
+void D3D11StateManager::SetHullShader(ID3D11HullShader* shader)
+{
+    if (shaders_.hs != shader)
+    {
+        shaders_.hs = shader;
+        context_->HSSetShader(shader, nullptr, 0);
+    }
+}
+
+void D3D11StateManager::SetDomainShader(ID3D11DomainShader* shader)
+{
+    if (shaders_.ds != shader)
+    {
+        shaders_.ds = shader;
+        context_->DSSetShader(shader, nullptr, 0);
+    }
+}
+
+void D3D11StateManager::SetGeometryShader(ID3D11GeometryShader* shader)
+{
+    if (shaders_.gs != shader)
+    {
+        shaders_.gs = shader;
+        context_->GSSetShader(shader, nullptr, 0);
+    }
+}
+
+void D3D11StateManager::SetPixelShader(ID3D11PixelShader* shader)
+{
+    if (shaders_.ps != shader)
+    {
+        shaders_.ps = shader;
+        context_->PSSetShader(shader, nullptr, 0);
+    }
+}
+
+void D3D11StateManager::SetComputeShader(ID3D11ComputeShader* shader)
+{
+    if (shaders_.cs != shader)
+    {
+        shaders_.cs = shader;
+        context_->CSSetShader(shader, nullptr, 0);
+    }
+}
+
+void D3D11StateManager::SetShaderClassInstances(const ShaderType stage, ID3D11ClassInstance* const* classInstances, UINT numClassInstances)
+{
+    /* Class instances can only be set together with their shader, so the shader cache remains valid */
+    switch (stage)
+    {
+        case ShaderType::Vertex:
+            context_->VSSetShader(shaders_.vs, classInstances, numClassInstances);
+            break;
+        case ShaderType::TessControl:
+            context_->HSSetShader(shaders_.hs, classInstances, numClassInstances);
+            break;
+        case ShaderType::TessEvaluation:
+            context_->DSSetShader(shaders_.ds, classInstances, numClassInstances);
+            break;
+        case ShaderType::Geometry:
+            context_->GSSetShader(shaders_.gs, classInstances, numClassInstances);
+            break;
+        case ShaderType::Fragment:
+            context_->PSSetShader(shaders_.ps, classInstances, numClassInstances);
+            break;
+        case ShaderType::Compute:
+            context_->CSSetShader(shaders_.cs, classInstances, numClassInstances);
+            break;
+        default:
+            break;
+    }
+}
+
+/* ----- Shader resources ----- */
+
+void D3D11StateManager::SetConstantBuffers(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long shaderStageFlags)
+{
+    for (std::size_t stage = 0; stage < NumShaderStages; ++stage)
+    {
+        if (IsShaderStageEnabled(stage, shaderStageFlags))
+        {
+            if (!stages_[stage].constantBuffers.Set(startSlot, count, buffers))
+                SubmitConstantBuffers(stage, startSlot, count, buffers);
+        }
+    }
+}
+
+void D3D11StateManager::SetShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long shaderStageFlags)
+{
+    for (std::size_t stage = 0; stage < NumShaderStages; ++stage)
+    {
+        if (IsShaderStageEnabled(stage, shaderStageFlags))
+        {
+            if (!stages_[stage].shaderResources.Set(startSlot, count, views))
+                SubmitShaderResources(stage, startSlot, count, views);
+        }
+    }
 }
 
+void D3D11StateManager::SetSamplers(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long shaderStageFlags)
+{
+    for (std::size_t stage = 0; stage < NumShaderStages; ++stage)
+    {
+        if (IsShaderStageEnabled(stage, shaderStageFlags))
+        {
+            if (!stages_[stage].samplers.Set(startSlot, count, samplers))
+                SubmitSamplers(stage, startSlot, count, samplers);
+        }
+    }
+}
+
+void D3D11StateManager::SetConstantBufferRanges(
+    UINT startSlot, UINT count, ID3D11Buffer* const* buffers, const UINT* firstConstants, const UINT* numConstants, long shaderStageFlags)
+{
+    if (!context1_)
+        throw std::runtime_error("constant buffer ranges require the Direct3D 11.1 runtime");
+
+    for (std::size_t stage = 0; stage < NumShaderStages; ++stage)
+    {
+        if (IsShaderStageEnabled(stage, shaderStageFlags))
+        {
+            /* Submit pending constant buffers first, then reset the shadow state of the overridden slots */
+            auto& table = stages_[stage].constantBuffers;
+            if (table.IsDirty())
+            {
+                SubmitConstantBuffers(stage, table.dirtyBegin, table.dirtyEnd - table.dirtyBegin, &(table.slots[table.dirtyBegin]));
+                table.ClearDirtyRange();
+            }
+            for (UINT i = startSlot; i < startSlot + count && i < table.slots.size(); ++i)
+                table.slots[i] = nullptr;
+        }
+    }
+
+    if (VS_STAGE(shaderStageFlags)) { context1_->VSSetConstantBuffers1(startSlot, count, buffers, firstConstants, numConstants); }
+    if (HS_STAGE(shaderStageFlags)) { context1_->HSSetConstantBuffers1(startSlot, count, buffers, firstConstants, numConstants); }
+    if (DS_STAGE(shaderStageFlags)) { context1_->DSSetConstantBuffers1(startSlot, count, buffers, firstConstants, numConstants); }
+    if (GS_STAGE(shaderStageFlags)) { context1_->GSSetConstantBuffers1(startSlot, count, buffers, firstConstants, numConstants); }
+    if (PS_STAGE(shaderStageFlags)) { context1_->PSSetConstantBuffers1(startSlot, count, buffers, firstConstants, numConstants); }
+    if (CS_STAGE(shaderStageFlags)) { context1_->CSSetConstantBuffers1(startSlot, count, buffers, firstConstants, numConstants); }
+}
+
+void D3D11StateManager::SetUnorderedAccessViews(
+    UINT startSlot, UINT count, ID3D11UnorderedAccessView* const* views, const UINT* initialCounts, long shaderStageFlags)
+{
+    /* Submit pending input views before the runtime resolves the input/output hazards */
+    FlushAllShaderResources();
+    FlushVertexBuffers();
+
+    if (PS_STAGE(shaderStageFlags))
+    {
+        /* Set UAVs for pixel shader stage */
+        context_->OMSetRenderTargetsAndUnorderedAccessViews(
+            D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr,
+            startSlot, count, views, initialCounts
+        );
+    }
+
+    if (CS_STAGE(shaderStageFlags))
+    {
+        /* Set UAVs for compute shader stage */
+        context_->CSSetUnorderedAccessViews(startSlot, count, views, initialCounts);
+    }
+
+    InvalidateShaderResources();
+    std::fill(vertexBuffers_.buffers.begin(), vertexBuffers_.buffers.end(), nullptr);
+    inputAssembler_.indexBuffer = nullptr;
+}
+
+void D3D11StateManager::SetGraphicsBindingUsage(const long* stageBindingFlags)
+{
+    for (std::size_t stage = StageVS; stage <= StagePS; ++stage)
+        stageBindingUsage_[stage] = stageBindingFlags[stage - StageVS];
+}
+
+void D3D11StateManager::SetComputeBindingUsage(long bindingFlags)
+{
+    stageBindingUsage_[StageCS] = bindingFlags;
+}
+
+void D3D11StateManager::FlushGraphicsResources()
+{
+    FlushVertexBuffers();
+    for (std::size_t stage = StageVS; stage <= StagePS; ++stage)
+        FlushShaderStage(stage);
+}
+
+void D3D11StateManager::FlushComputeResources()
+{
+    FlushShaderStage(StageCS);
+}
+
+void D3D11StateManager::Reset()
+{
+    for (auto& stage : stages_)
+    {
+        stage.constantBuffers   = D3D11ConstantBufferTable();
+        stage.shaderResources   = D3D11ShaderResourceTable();
+        stage.samplers          = D3D11SamplerTable();
+    }
+    stageBindingUsage_.fill(D3D11BindingFlags::All);
+    vertexBuffers_  = D3D11VertexBufferState();
+    inputAssembler_ = D3D11InputAssemblerState();
+    shaders_        = D3D11ShaderState();
+    outputMerger_   = D3D11OutputMergerState();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+template <typename T, std::size_t N>
+D3D11StateManager::D3D11BindingTable<T, N>::D3D11BindingTable()
+{
+    slots.fill(nullptr);
+}
+
+template <typename T, std::size_t N>
+bool D3D11StateManager::D3D11BindingTable<T, N>::Set(UINT startSlot, UINT count, T* const* objects)
+{
+    if (startSlot + count > N)
+        return false;
+
+    for (UINT i = 0; i < count; ++i)
+    {
+        auto slot = startSlot + i;
+
+        /* Null bindings are never filtered, since an invalidated slot is also reset to null */
+        if (objects[i] == nullptr || slots[slot] != objects[i])
+        {
+            slots[slot] = objects[i];
+            dirtyBegin  = std::min(dirtyBegin, slot);
+            dirtyEnd    = std::max(dirtyEnd, slot + 1);
+        }
+    }
+
+    return true;
+}
+
+template <typename T, std::size_t N>
+void D3D11StateManager::D3D11BindingTable<T, N>::Invalidate()
+{
+    slots.fill(nullptr);
+    ClearDirtyRange();
+}
+
+D3D11StateManager::D3D11VertexBufferState::D3D11VertexBufferState()
+{
+    buffers.fill(nullptr);
+    strides.fill(0);
+    offsets.fill(0);
+}
+
+void D3D11StateManager::FlushShaderStage(std::size_t stage)
+{
+    auto& state = stages_[stage];
+    auto usage  = stageBindingUsage_[stage];
+
+    /* Only submit the binding tables the shader of this stage reads */
+    if ((usage & D3D11BindingFlags::ConstantBuffers) != 0 && state.constantBuffers.IsDirty())
+    {
+        auto& table = state.constantBuffers;
+        SubmitConstantBuffers(stage, table.dirtyBegin, table.dirtyEnd - table.dirtyBegin, &(table.slots[table.dirtyBegin]));
+        table.ClearDirtyRange();
+    }
+
+    if ((usage & D3D11BindingFlags::ShaderResources) != 0 && state.shaderResources.IsDirty())
+    {
+        auto& table = state.shaderResources;
+        SubmitShaderResources(stage, table.dirtyBegin, table.dirtyEnd - table.dirtyBegin, &(table.slots[table.dirtyBegin]));
+        table.ClearDirtyRange();
+    }
+
+    if ((usage & D3D11BindingFlags::Samplers) != 0 && state.samplers.IsDirty())
+    {
+        auto& table = state.samplers;
+        SubmitSamplers(stage, table.dirtyBegin, table.dirtyEnd - table.dirtyBegin, &(table.slots[table.dirtyBegin]));
+        table.ClearDirtyRange();
+    }
+}
+
+void D3D11StateManager::FlushVertexBuffers()
+{
+    auto& state = vertexBuffers_;
+    if (state.dirtyBegin < state.dirtyEnd)
+    {
+        context_->IASetVertexBuffers(
+            state.dirtyBegin,
+            state.dirtyEnd - state.dirtyBegin,
+            &(state.buffers[state.dirtyBegin]),
+            &(state.strides[state.dirtyBegin]),
+            &(state.offsets[state.dirtyBegin])
+        );
+        state.dirtyBegin    = D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT;
+        state.dirtyEnd      = 0;
+    }
+}
+
+void D3D11StateManager::SubmitConstantBuffers(std::size_t stage, UINT startSlot, UINT count, ID3D11Buffer* const* buffers)
+{
+    switch (stage)
+    {
+        case StageVS: context_->VSSetConstantBuffers(startSlot, count, buffers); break;
+        case StageHS: context_->HSSetConstantBuffers(startSlot, count, buffers); break;
+        case StageDS: context_->DSSetConstantBuffers(startSlot, count, buffers); break;
+        case StageGS: context_->GSSetConstantBuffers(startSlot, count, buffers); break;
+        case StagePS: context_->PSSetConstantBuffers(startSlot, count, buffers); break;
+        case StageCS: context_->CSSetConstantBuffers(startSlot, count, buffers); break;
+    }
+}
+
+void D3D11StateManager::SubmitShaderResources(std::size_t stage, UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views)
+{
+    switch (stage)
+    {
+        case StageVS: context_->VSSetShaderResources(startSlot, count, views); break;
+        case StageHS: context_->HSSetShaderResources(startSlot, count, views); break;
+        case StageDS: context_->DSSetShaderResources(startSlot, count, views); break;
+        case StageGS: context_->GSSetShaderResources(startSlot, count, views); break;
+        case StagePS: context_->PSSetShaderResources(startSlot, count, views); break;
+        case StageCS: context_->CSSetShaderResources(startSlot, count, views); break;
+    }
+}
+
+void D3D11StateManager::SubmitSamplers(std::size_t stage, UINT startSlot, UINT count, ID3D11SamplerState* const* samplers)
+{
+    switch (stage)
+    {
+        case StageVS: context_->VSSetSamplers(startSlot, count, samplers); break;
+        case StageHS: context_->HSSetSamplers(startSlot, count, samplers); break;
+        case StageDS: context_->DSSetSamplers(startSlot, count, samplers); break;
+        case StageGS: context_->GSSetSamplers(startSlot, count, samplers); break;
+        case StagePS: context_->PSSetSamplers(startSlot, count, samplers); break;
+        case StageCS: context_->CSSetSamplers(startSlot, count, samplers); break;
+    }
+}
+
+void D3D11StateManager::FlushAllShaderResources()
+{
+    for (std::size_t stage = 0; stage < NumShaderStages; ++stage)
+    {
+        auto& table = stages_[stage].shaderResources;
+        if (table.IsDirty())
+        {
+            SubmitShaderResources(stage, table.dirtyBegin, table.dirtyEnd - table.dirtyBegin, &(table.slots[table.dirtyBegin]));
+            table.ClearDirtyRange();
+        }
+    }
+}
+
+void D3D11StateManager::InvalidateShaderResources()
+{
+    /* The runtime may have unbound any of the input views, so they can no longer be filtered */
+    for (auto& stage : stages_)
+        stage.shaderResources.Invalidate();
+}
+
+#undef VS_STAGE
+#undef HS_STAGE
+#undef DS_STAGE
+#undef GS_STAGE
+#undef PS_STAGE
+#undef CS_STAGE
+
 
 } // /namespace LLGL
 
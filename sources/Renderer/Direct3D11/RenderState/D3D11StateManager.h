@@ -11,27 +11,239 @@
 
 #include "../../DXCommon/ComPtr.h"
 #include <LLGL/RenderContextFlags.h>
+#include <LLGL/ShaderFlags.h>
+#include <LLGL/ColorRGBA.h>
+#include <array>
 #include <vector>
+#include <cstddef>
 #include <d3d11.h>
+#include <d3d11_1.h>
 
 
 namespace LLGL
 {
 
 
+// Binding tables of a shader stage, which are submitted by the state manager.
+struct D3D11BindingFlags
+{
+    enum
+    {
+        ConstantBuffers = (1 << 0),
+        ShaderResources = (1 << 1),
+        Samplers        = (1 << 2),
+
+        All             = (ConstantBuffers | ShaderResources | Samplers),
+    };
+};
+
+/*
+D3D11 device context state manager that filters redundant state changes (similar to the GLStateManager).
+Shader resources, constant buffers, samplers, and vertex buffers are stored in a shadow state per shader stage and slot,
+and only the dirty range of each binding table is submitted lazily with "FlushGraphicsResources" or "FlushComputeResources".
+*/
 class D3D11StateManager
 {
 
     public:
 
-        D3D11StateManager(ComPtr<ID3D11DeviceContext>& context);
+        D3D11StateManager(const ComPtr<ID3D11DeviceContext>& context);
+
+        /* ----- Rasterizer and output-merger ----- */
 
         void SetViewports(unsigned int numViewports, const Viewport* viewportArray);
         void SetScissors(unsigned int numScissors, const Scissor* scissorArray);
 
+        void SetRasterizerState(ID3D11RasterizerState* rasterizerState);
+        void SetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef);
+        void SetBlendState(ID3D11BlendState* blendState, const FLOAT* blendFactor, UINT sampleMask);
+
+        /*
+        Binds the specified render targets. Pending shader resources are flushed first and their shadow state is invalidated,
+        because the D3D runtime unbinds all input views whose resources are bound as output.
+        */
+        void SetRenderTargets(UINT numRenderTargets, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView);
+
+        /* ----- Input-assembler ----- */
+
+        void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY primitiveTopology);
+        void SetInputLayout(ID3D11InputLayout* inputLayout);
+
+        void SetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers, const UINT* strides, const UINT* offsets);
+        void SetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, UINT offset);
+
+        // Binds the specified stream-output targets and invalidates the vertex buffer shadow state (see SetRenderTargets).
+        void SetStreamOutputTargets(UINT numBuffers, ID3D11Buffer* const* buffers, const UINT* offsets);
+
+        /* ----- Shaders ----- */
+
+        void SetVertexShader(ID3D11VertexShader* shader);
+        void SetHullShader(ID3D11HullShader* shader);
+        void SetDomainShader(ID3D11DomainShader* shader);
+        void SetGeometryShader(ID3D11GeometryShader* shader);
+        void SetPixelShader(ID3D11PixelShader* shader);
+        void SetComputeShader(ID3D11ComputeShader* shader);
+
+        // Binds the active shader of the specified stage again with the specified class instances for its interface slots.
+        void SetShaderClassInstances(const ShaderType stage, ID3D11ClassInstance* const* classInstances, UINT numClassInstances);
+
+        /* ----- Shader resources ----- */
+
+        void SetConstantBuffers(UINT startSlot, UINT count, ID3D11Buffer* const* buffers, long shaderStageFlags);
+        void SetShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views, long shaderStageFlags);
+        void SetSamplers(UINT startSlot, UINT count, ID3D11SamplerState* const* samplers, long shaderStageFlags);
+
+        // Returns true if constant buffer ranges are supported, i.e. the Direct3D 11.1 runtime is available.
+        inline bool HasConstantBufferRanges() const
+        {
+            return (context1_ != nullptr);
+        }
+
+        // Binds constant buffer ranges immediately (requires the Direct3D 11.1 runtime), which bypasses the shadow state.
+        void SetConstantBufferRanges(
+            UINT startSlot, UINT count, ID3D11Buffer* const* buffers,
+            const UINT* firstConstants, const UINT* numConstants, long shaderStageFlags
+        );
+
+        // Binds unordered access views immediately and invalidates the shader resource and vertex buffer shadow state (see SetRenderTargets).
+        void SetUnorderedAccessViews(
+            UINT startSlot, UINT count, ID3D11UnorderedAccessView* const* views,
+            const UINT* initialCounts, long shaderStageFlags
+        );
+
+        /*
+        Sets the binding tables (see D3D11BindingFlags) that are read by the shaders of the bound graphics pipeline,
+        one entry for each stage in the order VS, HS, DS, GS, PS. Dirty ranges of all other tables are not submitted,
+        but remain pending until a pipeline is bound whose shaders read them.
+        */
+        void SetGraphicsBindingUsage(const long* stageBindingFlags);
+
+        // Sets the binding tables that are read by the compute shader of the bound compute pipeline (see SetGraphicsBindingUsage).
+        void SetComputeBindingUsage(long bindingFlags);
+
+        // Submits all dirty binding ranges of the graphics shader stages and the input-assembler. Must be called before each draw command.
+        void FlushGraphicsResources();
+
+        // Submits all dirty binding ranges of the compute shader stage. Must be called before each dispatch command.
+        void FlushComputeResources();
+
+        /*
+        Resets the shadow state to the default state of a device context and discards pending bindings.
+        This must be called after the device context has been cleared, e.g. by "FinishCommandList" of a deferred context.
+        */
+        void Reset();
+
     private:
 
-        ComPtr<ID3D11DeviceContext> context_;
+        // Shadow state of a single binding table with the dirty range that has not been submitted yet.
+        template <typename T, std::size_t N>
+        struct D3D11BindingTable
+        {
+            D3D11BindingTable();
+
+            // Stores the specified objects and returns false if the range exceeds the table and must be submitted directly.
+            bool Set(UINT startSlot, UINT count, T* const* objects);
+
+            void Invalidate();
+
+            inline bool IsDirty() const
+            {
+                return (dirtyBegin < dirtyEnd);
+            }
+
+            inline void ClearDirtyRange()
+            {
+                dirtyBegin  = N;
+                dirtyEnd    = 0;
+            }
+
+            std::array<T*, N>   slots;
+            UINT                dirtyBegin  = N;
+            UINT                dirtyEnd    = 0;
+        };
+
+        using D3D11ConstantBufferTable  = D3D11BindingTable<ID3D11Buffer, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT>;
+        using D3D11ShaderResourceTable  = D3D11BindingTable<ID3D11ShaderResourceView, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT>;
+        using D3D11SamplerTable         = D3D11BindingTable<ID3D11SamplerState, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT>;
+
+        struct D3D11ShaderStageState
+        {
+            D3D11ConstantBufferTable    constantBuffers;
+            D3D11ShaderResourceTable    shaderResources;
+            D3D11SamplerTable           samplers;
+        };
+
+        struct D3D11VertexBufferState
+        {
+            D3D11VertexBufferState();
+
+            std::array<ID3D11Buffer*, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT>    buffers;
+            std::array<UINT, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT>             strides;
+            std::array<UINT, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT>             offsets;
+            UINT                                                                    dirtyBegin  = D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT;
+            UINT                                                                    dirtyEnd    = 0;
+        };
+
+        struct D3D11InputAssemblerState
+        {
+            D3D11_PRIMITIVE_TOPOLOGY    primitiveTopology   = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+            ID3D11InputLayout*          inputLayout         = nullptr;
+            ID3D11Buffer*               indexBuffer         = nullptr;
+            DXGI_FORMAT                 indexFormat         = DXGI_FORMAT_UNKNOWN;
+            UINT                        indexOffset         = 0;
+        };
+
+        struct D3D11ShaderState
+        {
+            ID3D11VertexShader*     vs = nullptr;
+            ID3D11HullShader*       hs = nullptr;
+            ID3D11DomainShader*     ds = nullptr;
+            ID3D11GeometryShader*   gs = nullptr;
+            ID3D11PixelShader*      ps = nullptr;
+            ID3D11ComputeShader*    cs = nullptr;
+        };
+
+        struct D3D11OutputMergerState
+        {
+            ID3D11RasterizerState*      rasterizerState     = nullptr;
+            ID3D11DepthStencilState*    depthStencilState   = nullptr;
+            UINT                        stencilRef          = 0;
+            ID3D11BlendState*           blendState          = nullptr;
+            ColorRGBAf                  blendFactor         { 1.0f, 1.0f, 1.0f, 1.0f };
+            UINT                        sampleMask          = ~0u;
+        };
+
+        enum ShaderStage
+        {
+            StageVS = 0,
+            StageHS,
+            StageDS,
+            StageGS,
+            StagePS,
+            StageCS,
+
+            NumShaderStages,
+        };
+
+        void FlushShaderStage(std::size_t stage);
+        void FlushVertexBuffers();
+
+        void SubmitConstantBuffers(std::size_t stage, UINT startSlot, UINT count, ID3D11Buffer* const* buffers);
+        void SubmitShaderResources(std::size_t stage, UINT startSlot, UINT count, ID3D11ShaderResourceView* const* views);
+        void SubmitSamplers(std::size_t stage, UINT startSlot, UINT count, ID3D11SamplerState* const* samplers);
+
+        void FlushAllShaderResources();
+        void InvalidateShaderResources();
+
+        ComPtr<ID3D11DeviceContext>                         context_;
+        ComPtr<ID3D11DeviceContext1>                        context1_;  // only available with Direct3D 11.1 runtime
+
+        std::array<D3D11ShaderStageState, NumShaderStages>  stages_;
+        std::array<long, NumShaderStages>                   stageBindingUsage_;
+        D3D11VertexBufferState                              vertexBuffers_;
+        D3D11InputAssemblerState                            inputAssembler_;
+        D3D11ShaderState                                    shaders_;
+        D3D11OutputMergerState                              outputMerger_;
 
 };
 
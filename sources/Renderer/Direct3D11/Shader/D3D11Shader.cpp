@@ -6,7 +6,9 @@
  */
 
 #include "D3D11Shader.h"
+#include "../RenderState/D3D11StateManager.h"
 #include "../../DXCommon/DXCore.h"
+#include "../../DXCommon/DXShaderReflection.h"
 #include <algorithm>
 #include <stdexcept>
 #include <d3dcompiler.h>
@@ -16,9 +18,10 @@ namespace LLGL
 {
 
 
-D3D11Shader::D3D11Shader(ID3D11Device* device, const ShaderType type) :
-    Shader  { type   },
-    device_ { device }
+D3D11Shader::D3D11Shader(ID3D11Device* device, const ShaderType type, ThreadPool* workerPool) :
+    Shader      { type       },
+    device_     { device     },
+    workerPool_ { workerPool }
 {
 }
 
@@ -47,30 +50,39 @@ bool D3D11Shader::Compile(const std::string& sourceCode, const ShaderDescriptor&
         errors_.ReleaseAndGetAddressOf()            // ID3DBlob**           ppErrorMsgs
     );
 
-    /* Get byte code from blob */
-    if (code)
-    {
-        byteCode_ = DXGetBlobData(code.Get());
-        CreateHardwareShader(shaderDesc.streamOutput, nullptr);
-    }
-
-    if (FAILED(hr))
+    if (FAILED(hr) || !code)
         return false;
 
-    /* Get shader reflection */
+    /* Get byte code from blob, perform code reflection, and create hardware shader (with class linkage for interface slots) */
+    byteCode_ = DXGetBlobData(code.Get());
     ReflectShader();
+    CreateHardwareShader(shaderDesc.streamOutput, classLinkage_.Get());
 
     return true;
 }
 
+std::shared_future<bool> D3D11Shader::CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
+{
+    if (!workerPool_)
+        return Shader::CompileAsync(sourceCode, shaderDesc);
+
+    /* Compile shader on worker thread (D3DCompile and the D3D11 device are thread-safe) */
+    return workerPool_->Submit(
+        [this, sourceCode, shaderDesc]()
+        {
+            return Compile(sourceCode, shaderDesc);
+        }
+    );
+}
+
 bool D3D11Shader::LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc)
 {
     if (!binaryCode.empty())
     {
-        /* Move binary code into byte code container, create hardware shader, and perform code reflection */
+        /* Move binary code into byte code container, perform code reflection, and create hardware shader */
         byteCode_ = std::move(binaryCode);
-        CreateHardwareShader(shaderDesc.streamOutput, nullptr);
         ReflectShader();
+        CreateHardwareShader(shaderDesc.streamOutput, classLinkage_.Get());
         return true;
     }
     return false;
@@ -95,6 +107,49 @@ std::string D3D11Shader::QueryInfoLog()
     return (errors_.Get() != nullptr ? DXGetBlobString(errors_.Get()) : "");
 }
 
+int D3D11Shader::FindInterfaceSlot(const std::string& name) const
+{
+    for (const auto& entry : interfaceSlots_)
+    {
+        if (entry.first == name)
+            return static_cast<int>(entry.second);
+    }
+    return -1;
+}
+
+int D3D11Shader::FindClassInstance(const std::string& name)
+{
+    /* Find class instance that has already been retrieved */
+    for (std::size_t i = 0; i < classInstances_.size(); ++i)
+    {
+        if (classInstances_[i].name == name)
+            return static_cast<int>(i);
+    }
+
+    /* Retrieve class instance that is declared in the shader from the class linkage */
+    if (classLinkage_)
+    {
+        D3D11ClassInstance entry;
+        entry.name = name;
+
+        auto hr = classLinkage_->GetClassInstance(name.c_str(), 0, entry.instance.ReleaseAndGetAddressOf());
+        if (SUCCEEDED(hr) && entry.instance)
+        {
+            classInstances_.push_back(std::move(entry));
+            return static_cast<int>(classInstances_.size() - 1);
+        }
+    }
+
+    return -1;
+}
+
+ID3D11ClassInstance* D3D11Shader::GetClassInstance(int id) const
+{
+    if (id >= 0 && static_cast<std::size_t>(id) < classInstances_.size())
+        return classInstances_[id].instance.Get();
+    return nullptr;
+}
+
 
 /*
  * ======= Private: =======
@@ -112,6 +167,10 @@ void D3D11Shader::CreateHardwareShader(const ShaderDescriptor::StreamOutput& str
         {
             hr = device_->CreateVertexShader(byteCode_.data(), byteCode_.size(), classLinkage, hardwareShader_.vs.ReleaseAndGetAddressOf());
             DXThrowIfFailed(hr, "failed to create D3D11 vertex shader");
+
+            /* Extract input signature, which is shared by all vertex shader permutations with the same inputs */
+            hr = D3DGetInputSignatureBlob(byteCode_.data(), byteCode_.size(), inputSignature_.ReleaseAndGetAddressOf());
+            DXThrowIfFailed(hr, "failed to retrieve D3D11 vertex shader input signature");
         }
         break;
 
@@ -179,6 +238,9 @@ void D3D11Shader::CreateHardwareShader(const ShaderDescriptor::StreamOutput& str
             DXThrowIfFailed(hr, "failed to create D3D11 compute shader");
         }
         break;
+
+        default:
+        break;
     }
 }
 
@@ -195,9 +257,32 @@ void D3D11Shader::ReflectShader()
     hr = reflection->GetDesc(&shaderDesc);
     DXThrowIfFailed(hr, "failed to retrieve D3D11 shader descriptor");
 
+    /* Replace the previous reflection (e.g. after re-compiling) and reserve all lists at once */
+    vertexAttributes_.clear();
+    constantBufferDescs_.clear();
+    storageBufferDescs_.clear();
+    bindingFlags_ = 0;
+
+    constantBufferDescs_.reserve(shaderDesc.ConstantBuffers);
+    storageBufferDescs_.reserve(shaderDesc.BoundResources);
+
+    /* Shaders with interface slots (dynamic shader linkage) require their own class linkage to retrieve the class instances */
+    interfaceSlots_.clear();
+    classInstances_.clear();
+    classLinkage_.Reset();
+
+    numInterfaceSlots_ = reflection->GetNumInterfaceSlots();
+    if (numInterfaceSlots_ > 0)
+    {
+        hr = device_->CreateClassLinkage(classLinkage_.ReleaseAndGetAddressOf());
+        DXThrowIfFailed(hr, "failed to create D3D11 class linkage");
+    }
+
     /* Get input parameter descriptors */
     if (GetType() == ShaderType::Vertex)
     {
+        vertexAttributes_.reserve(shaderDesc.InputParameters);
+
         for (UINT i = 0; i < shaderDesc.InputParameters; ++i)
         {
             /* Get signature parameter descriptor */
@@ -238,8 +323,34 @@ void D3D11Shader::ReflectShader()
                 constBufferDesc.index   = bufferIdx++;
                 constBufferDesc.size    = shaderBufferDesc.Size;
             }
+
+            /* Reflect field layout of all variables */
+            DXReflectConstantBufferFields<D3D11_SHADER_VARIABLE_DESC, D3D11_SHADER_TYPE_DESC>(
+                constBufferReflection, shaderBufferDesc.Variables, constBufferDesc.fields
+            );
+
+            std::sort(
+                constBufferDesc.fields.begin(), constBufferDesc.fields.end(),
+                [](const ConstantBufferFieldDescriptor& lhs, const ConstantBufferFieldDescriptor& rhs)
+                {
+                    return (lhs.offset < rhs.offset);
+                }
+            );
+
             constantBufferDescs_.push_back(constBufferDesc);
         }
+        else if (shaderBufferDesc.Type == D3D_CT_INTERFACE_POINTERS)
+        {
+            /* Get interface variables with their slots */
+            for (UINT j = 0; j < shaderBufferDesc.Variables; ++j)
+            {
+                auto varReflection = constBufferReflection->GetVariableByIndex(j);
+
+                D3D11_SHADER_VARIABLE_DESC varDesc;
+                if (SUCCEEDED(varReflection->GetDesc(&varDesc)))
+                    interfaceSlots_.push_back({ std::string(varDesc.Name), varReflection->GetInterfaceSlot(0) });
+            }
+        }
     }
 
     /* Get storage buffer descriptors */
@@ -251,6 +362,25 @@ void D3D11Shader::ReflectShader()
         hr = reflection->GetResourceBindingDesc(i, &inputBindDesc);
         DXThrowIfFailed(hr, "failed to retrieve D3D11 shader input binding descriptor");
 
+        /* Accumulate the binding tables this shader reads, so the state manager can skip the others */
+        switch (inputBindDesc.Type)
+        {
+            case D3D_SIT_CBUFFER:
+                bindingFlags_ |= D3D11BindingFlags::ConstantBuffers;
+                break;
+            case D3D_SIT_TBUFFER:
+            case D3D_SIT_TEXTURE:
+            case D3D_SIT_STRUCTURED:
+            case D3D_SIT_BYTEADDRESS:
+                bindingFlags_ |= D3D11BindingFlags::ShaderResources;
+                break;
+            case D3D_SIT_SAMPLER:
+                bindingFlags_ |= D3D11BindingFlags::Samplers;
+                break;
+            default:
+                break;
+        }
+
         if ( inputBindDesc.Type >= D3D_SIT_UAV_RWTYPED &&
              inputBindDesc.Type <= D3D_SIT_UAV_RWSTRUCTURED_WITH_COUNTER )
         {
@@ -13,6 +13,7 @@
 #include <LLGL/VertexAttribute.h>
 #include <LLGL/BufferFlags.h>
 #include "../../DXCommon/ComPtr.h"
+#include "../../../Core/ThreadPool.h"
 #include <vector>
 #include <string>
 #include <d3d11.h>
@@ -46,10 +47,12 @@ class D3D11Shader : public Shader
 
     public:
 
-        D3D11Shader(ID3D11Device* device, const ShaderType type);
+        D3D11Shader(ID3D11Device* device, const ShaderType type, ThreadPool* workerPool = nullptr);
 
         bool Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
 
+        std::shared_future<bool> CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
+
         bool LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc = {}) override;
 
         std::string Disassemble(int flags = 0) override;
@@ -68,6 +71,12 @@ class D3D11Shader : public Shader
             return byteCode_;
         }
 
+        // Returns the input signature of this vertex shader, or null if this is not a vertex shader.
+        inline ID3DBlob* GetInputSignature() const
+        {
+            return inputSignature_.Get();
+        }
+
         inline const std::vector<VertexAttribute>& GetVertexAttributes() const
         {
             return vertexAttributes_;
@@ -83,21 +92,56 @@ class D3D11Shader : public Shader
             return storageBufferDescs_;
         }
 
+        // Returns the binding tables this shader reads (see D3D11BindingFlags), which are determined by the shader reflection.
+        inline long GetBindingFlags() const
+        {
+            return bindingFlags_;
+        }
+
+        // Returns the interface slot of the specified interface variable, or -1 if there is no such interface.
+        int FindInterfaceSlot(const std::string& name) const;
+
+        // Returns the ID of the specified class instance, which is retrieved from the class linkage on first use, or -1 if there is no such class instance.
+        int FindClassInstance(const std::string& name);
+
+        // Returns the class instance with the specified ID (see FindClassInstance), or null if the ID is invalid.
+        ID3D11ClassInstance* GetClassInstance(int id) const;
+
+        // Returns the number of interface slots of this shader.
+        inline UINT GetNumInterfaceSlots() const
+        {
+            return numInterfaceSlots_;
+        }
+
     private:
 
+        struct D3D11ClassInstance
+        {
+            std::string                 name;
+            ComPtr<ID3D11ClassInstance> instance;
+        };
+
         void CreateHardwareShader(const ShaderDescriptor::StreamOutput& streamOutputDesc, ID3D11ClassLinkage* classLinkage);
         void ReflectShader();
 
         ID3D11Device*                               device_             = nullptr;
+        ThreadPool*                                 workerPool_         = nullptr;
 
         D3D11HardwareShader                         hardwareShader_;
 
         std::vector<char>                           byteCode_;
         ComPtr<ID3DBlob>                            errors_;
+        ComPtr<ID3DBlob>                            inputSignature_;    // only for vertex shaders
 
         std::vector<VertexAttribute>                vertexAttributes_;
         std::vector<ConstantBufferViewDescriptor>   constantBufferDescs_;
         std::vector<StorageBufferViewDescriptor>    storageBufferDescs_;
+        long                                        bindingFlags_       = 0;
+
+        ComPtr<ID3D11ClassLinkage>                  classLinkage_;      // only for shaders with interface slots
+        UINT                                        numInterfaceSlots_  = 0;
+        std::vector<std::pair<std::string, UINT>>   interfaceSlots_;    // interface variables with their first slot
+        std::vector<D3D11ClassInstance>             classInstances_;
 
 };
 
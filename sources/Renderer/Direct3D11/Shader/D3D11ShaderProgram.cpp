@@ -8,20 +8,22 @@
 #include "D3D11ShaderProgram.h"
 #include "D3D11Shader.h"
 #include "../D3D11Types.h"
+#include "../RenderState/D3D11RenderStateCache.h"
 #include "../../CheckedCast.h"
 #include "../../DXCommon/DXCore.h"
 #include <LLGL/Log.h>
 #include <LLGL/VertexFormat.h>
 #include <algorithm>
 #include <stdexcept>
+#include <initializer_list>
 
 
 namespace LLGL
 {
 
 
-D3D11ShaderProgram::D3D11ShaderProgram(ID3D11Device* device) :
-    device_ { device }
+D3D11ShaderProgram::D3D11ShaderProgram(D3D11RenderStateCache& stateCache) :
+    stateCache_ { stateCache }
 {
 }
 
@@ -68,6 +70,8 @@ void D3D11ShaderProgram::AttachShader(Shader& shader)
         case ShaderType::Compute:
             cs_ = shaderD3D;
             break;
+        default:
+            break;
     }
 
     /* Add constant- and storage buffer descriptors */
@@ -196,6 +200,30 @@ std::vector<UniformDescriptor> D3D11ShaderProgram::QueryUniforms() const
     return {}; // dummy
 }
 
+int D3D11ShaderProgram::QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name)
+{
+    if (auto shader = GetShader(stage))
+        return shader->FindInterfaceSlot(name);
+    return -1;
+}
+
+int D3D11ShaderProgram::QueryShaderClassInstance(const ShaderType stage, const std::string& name)
+{
+    if (auto shader = GetShader(stage))
+        return shader->FindClassInstance(name);
+    return -1;
+}
+
+D3D11Shader* D3D11ShaderProgram::GetShader(const ShaderType stage) const
+{
+    for (auto shader : { vs_, ds_, hs_, gs_, ps_, cs_ })
+    {
+        if (shader != nullptr && shader->GetType() == stage)
+            return shader;
+    }
+    return nullptr;
+}
+
 static DXGI_FORMAT GetInputElementFormat(const VertexAttribute& attrib)
 {
     try
@@ -210,7 +238,7 @@ static DXGI_FORMAT GetInputElementFormat(const VertexAttribute& attrib)
 
 void D3D11ShaderProgram::BuildInputLayout(const VertexFormat& vertexFormat)
 {
-    if (!vs_ || vs_->GetByteCode().empty())
+    if (!vs_ || !vs_->GetInputSignature())
         throw std::runtime_error("can not bind vertex attributes without valid vertex shader");
 
     /* Setup input element descriptors */
@@ -232,16 +260,8 @@ void D3D11ShaderProgram::BuildInputLayout(const VertexFormat& vertexFormat)
         inputElements.push_back(elementDesc);
     }
 
-    /* Create input layout */
-    inputLayout_.Reset();
-    auto hr = device_->CreateInputLayout(
-        inputElements.data(),
-        static_cast<UINT>(inputElements.size()),
-        vs_->GetByteCode().data(),
-        vs_->GetByteCode().size(),
-        &inputLayout_
-    );
-    DXThrowIfFailed(hr, "failed to create D3D11 input layout");
+    /* Get input layout from the cache, so programs with the same vertex format and input signature share the same layout object */
+    inputLayout_ = stateCache_.GetInputLayout(inputElements, vs_->GetInputSignature());
 }
 
 void D3D11ShaderProgram::BindConstantBuffer(const std::string& name, unsigned int bindingIndex)
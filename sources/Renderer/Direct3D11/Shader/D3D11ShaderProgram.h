@@ -20,13 +20,14 @@ namespace LLGL
 
 
 class D3D11Shader;
+class D3D11RenderStateCache;
 
 class D3D11ShaderProgram : public ShaderProgram
 {
 
     public:
 
-        D3D11ShaderProgram(ID3D11Device* device);
+        D3D11ShaderProgram(D3D11RenderStateCache& stateCache);
 
         void AttachShader(Shader& shader) override;
         void DetachAll() override;
@@ -41,6 +42,9 @@ class D3D11ShaderProgram : public ShaderProgram
         std::vector<StorageBufferViewDescriptor> QueryStorageBuffers() const override;
         std::vector<UniformDescriptor> QueryUniforms() const override;
 
+        int QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name) override;
+        int QueryShaderClassInstance(const ShaderType stage, const std::string& name) override;
+
         void BuildInputLayout(const VertexFormat& vertexFormat) override;
         void BindConstantBuffer(const std::string& name, unsigned int bindingIndex) override;
         void BindStorageBuffer(const std::string& name, unsigned int bindingIndex) override;
@@ -62,6 +66,9 @@ class D3D11ShaderProgram : public ShaderProgram
         inline D3D11Shader* GetPS() const { return ps_; }
         inline D3D11Shader* GetCS() const { return cs_; }
 
+        // Returns the attached shader of the specified stage, or null if there is no such shader.
+        D3D11Shader* GetShader(const ShaderType stage) const;
+
     private:
 
         enum class LinkError
@@ -71,7 +78,7 @@ class D3D11ShaderProgram : public ShaderProgram
             ByteCode,
         };
 
-        ID3D11Device*                               device_                 = nullptr;
+        D3D11RenderStateCache&                      stateCache_;
 
         ComPtr<ID3D11InputLayout>                   inputLayout_;
 
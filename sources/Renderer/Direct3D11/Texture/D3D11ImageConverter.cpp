@@ -0,0 +1,305 @@
+/*
+ * D3D11ImageConverter.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D11ImageConverter.h"
+#include "D3D11Texture.h"
+#include "../../DXCommon/DXCore.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <string>
+#include <d3dcompiler.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Each thread reads the bytes of one source pixel from the raw buffer and writes the swizzled RGBA color into the scratch texture.
+Missing components get the default value (0, 0, 0, 255) like the CPU conversion with "ConvertImageBuffer".
+*/
+static const char* g_imageConverterShaderSource =
+    "cbuffer ConversionConstants : register(b0)\n"
+    "{\n"
+    "    uint2 extent;\n"
+    "    uint  srcComponents;\n"
+    "    uint  srcRowPitch;\n"
+    "    uint4 swizzle;\n"
+    "};\n"
+    "ByteAddressBuffer srcImage : register(t0);\n"
+    "RWTexture2D<unorm float4> dstImage : register(u0);\n"
+    "uint LoadByte(uint offset)\n"
+    "{\n"
+    "    return (srcImage.Load(offset & ~3u) >> ((offset & 3u) * 8u)) & 0xFFu;\n"
+    "}\n"
+    "[numthreads(8, 8, 1)]\n"
+    "void CS(uint3 threadID : SV_DispatchThreadID)\n"
+    "{\n"
+    "    if (threadID.x >= extent.x || threadID.y >= extent.y)\n"
+    "        return;\n"
+    "    uint offset = threadID.y * srcRowPitch + threadID.x * srcComponents;\n"
+    "    uint src[6] = { LoadByte(offset), LoadByte(offset + 1u), LoadByte(offset + 2u), 0u, 0u, 255u };\n"
+    "    if (srcComponents == 4u)\n"
+    "        src[3] = LoadByte(offset + 3u);\n"
+    "    dstImage[threadID.xy] = float4(src[swizzle.x], src[swizzle.y], src[swizzle.z], src[swizzle.w]) / 255.0;\n"
+    "}\n";
+
+// Layout of the constant buffer (register b0).
+struct D3D11ConversionConstants
+{
+    UINT extent[2];
+    UINT srcComponents;
+    UINT srcRowPitch;
+    UINT swizzle[4];
+};
+
+// Index of the zero and the maximum value in the 'src' array of the shader.
+static const UINT g_swizzleZero = 4;
+static const UINT g_swizzleOne  = 5;
+
+// Minimal number of texels for the GPU conversion; smaller images are converted on the CPU, which is cheaper than a dispatch.
+static const UINT g_minConversionTexels = 4096;
+
+// Stores the source component index for each destination component (RGBA), and returns the number of source components.
+static UINT GetSourceSwizzle(const ImageFormat format, UINT (&swizzle)[4])
+{
+    switch (format)
+    {
+        case ImageFormat::RGB:
+            swizzle[0] = 0; swizzle[1] = 1; swizzle[2] = 2; swizzle[3] = g_swizzleOne;
+            return 3;
+        case ImageFormat::BGR:
+            swizzle[0] = 2; swizzle[1] = 1; swizzle[2] = 0; swizzle[3] = g_swizzleOne;
+            return 3;
+        case ImageFormat::BGRA:
+            swizzle[0] = 2; swizzle[1] = 1; swizzle[2] = 0; swizzle[3] = 3;
+            return 4;
+        case ImageFormat::ARGB:
+            swizzle[0] = 1; swizzle[1] = 2; swizzle[2] = 3; swizzle[3] = 0;
+            return 4;
+        case ImageFormat::ABGR:
+            swizzle[0] = 3; swizzle[1] = 2; swizzle[2] = 1; swizzle[3] = 0;
+            return 4;
+        default:
+            swizzle[0] = g_swizzleZero; swizzle[1] = g_swizzleZero; swizzle[2] = g_swizzleZero; swizzle[3] = g_swizzleOne;
+            return 0;
+    }
+}
+
+D3D11ImageConverter::D3D11ImageConverter(ID3D11Device* device, ID3D11DeviceContext* context) :
+    device_  { device  },
+    context_ { context }
+{
+    CreateComputeShader();
+    CreateConstantBuffer();
+}
+
+bool D3D11ImageConverter::IsConversionSupported(const D3D11Texture& textureD3D, const ImageDescriptor& imageDesc, UINT width, UINT height)
+{
+    if (imageDesc.dataType != DataType::UInt8 || width * height < g_minConversionTexels)
+        return false;
+
+    /* Only RGBA8 textures support typed UAV stores for all Direct3D 11 hardware */
+    const auto format = textureD3D.GetFormat();
+    if (format != DXGI_FORMAT_R8G8B8A8_UNORM && format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
+        return false;
+
+    UINT swizzle[4];
+    return (GetSourceSwizzle(imageDesc.format, swizzle) != 0);
+}
+
+void D3D11ImageConverter::WriteTexture(
+    D3D11Texture& textureD3D, UINT dstSubresource, UINT dstX, UINT dstY, UINT width, UINT height, const ImageDescriptor& imageDesc)
+{
+    D3D11ConversionConstants constants;
+    {
+        constants.extent[0]     = width;
+        constants.extent[1]     = height;
+        constants.srcComponents = GetSourceSwizzle(imageDesc.format, constants.swizzle);
+        constants.srcRowPitch   = width * constants.srcComponents;
+    }
+
+    /* Upload raw image bytes; the size of raw buffers must be a multiple of 4 */
+    const auto imageSize = constants.srcRowPitch * height;
+
+    ReserveSourceBuffer((imageSize + 3u) & ~3u);
+    ReserveScratchTexture(width, height);
+
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+
+    auto hr = context_->Map(srcBuffer_.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+    DXThrowIfFailed(hr, "failed to map D3D11 buffer for image conversion");
+    std::memcpy(mappedSubresource.pData, imageDesc.buffer, imageSize);
+    context_->Unmap(srcBuffer_.Get(), 0);
+
+    hr = context_->Map(constantBuffer_.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+    DXThrowIfFailed(hr, "failed to map D3D11 constant buffer for image conversion");
+    std::memcpy(mappedSubresource.pData, &constants, sizeof(constants));
+    context_->Unmap(constantBuffer_.Get(), 0);
+
+    /* Store previous bindings of the compute shader stage to restore them afterwards */
+    ComPtr<ID3D11ComputeShader>         prevShader;
+    ComPtr<ID3D11Buffer>                prevConstantBuffer;
+    ComPtr<ID3D11ShaderResourceView>    prevSRV;
+    ComPtr<ID3D11UnorderedAccessView>   prevUAV;
+
+    context_->CSGetShader(prevShader.GetAddressOf(), nullptr, nullptr);
+    context_->CSGetConstantBuffers(0, 1, prevConstantBuffer.GetAddressOf());
+    context_->CSGetShaderResources(0, 1, prevSRV.GetAddressOf());
+    context_->CSGetUnorderedAccessViews(0, 1, prevUAV.GetAddressOf());
+
+    /* Expand image into the scratch texture */
+    context_->CSSetShader(computeShader_.Get(), nullptr, 0);
+    context_->CSSetConstantBuffers(0, 1, constantBuffer_.GetAddressOf());
+    context_->CSSetShaderResources(0, 1, srcBufferSRV_.GetAddressOf());
+    context_->CSSetUnorderedAccessViews(0, 1, scratchTextureUAV_.GetAddressOf(), nullptr);
+    context_->Dispatch((width + 7) / 8, (height + 7) / 8, 1);
+
+    /* Restore previous bindings (an initial count of -1 keeps the current counter of append/consume buffers) */
+    const UINT keepCounter = ~0u;
+    context_->CSSetShader(prevShader.Get(), nullptr, 0);
+    context_->CSSetConstantBuffers(0, 1, prevConstantBuffer.GetAddressOf());
+    context_->CSSetShaderResources(0, 1, prevSRV.GetAddressOf());
+    context_->CSSetUnorderedAccessViews(0, 1, prevUAV.GetAddressOf(), &keepCounter);
+
+    /* Copy expanded region into the destination subresource (both formats are in the R8G8B8A8 type group) */
+    const D3D11_BOX srcBox = { 0, 0, 0, width, height, 1 };
+    context_->CopySubresourceRegion(
+        textureD3D.GetHardwareTexture().resource.Get(), dstSubresource, dstX, dstY, 0,
+        scratchTexture_.Get(), 0, &srcBox
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D11ImageConverter::CreateComputeShader()
+{
+    /* Compile compute shader from the built-in source */
+    ComPtr<ID3DBlob> code;
+    ComPtr<ID3DBlob> errors;
+
+    const std::string sourceCode = g_imageConverterShaderSource;
+
+    auto hr = D3DCompile(
+        sourceCode.data(),
+        sourceCode.size(),
+        nullptr,                        // LPCSTR               pSourceName
+        nullptr,                        // D3D_SHADER_MACRO*    pDefines
+        nullptr,                        // ID3DInclude*         pInclude
+        "CS",                           // LPCSTR               pEntrypoint
+        "cs_5_0",                       // LPCSTR               pTarget
+        D3DCOMPILE_OPTIMIZATION_LEVEL3, // UINT                 Flags1
+        0,                              // UINT                 Flags2 (recommended to always be 0)
+        code.ReleaseAndGetAddressOf(),  // ID3DBlob**           ppCode
+        errors.ReleaseAndGetAddressOf() // ID3DBlob**           ppErrorMsgs
+    );
+
+    if (FAILED(hr) && errors)
+    {
+        auto errorStr = DXGetBlobString(errors.Get());
+        throw std::runtime_error("failed to compile D3D11 compute shader for image conversion: " + errorStr);
+    }
+
+    DXThrowIfFailed(hr, "failed to compile D3D11 compute shader for image conversion");
+
+    hr = device_->CreateComputeShader(code->GetBufferPointer(), code->GetBufferSize(), nullptr, computeShader_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 compute shader for image conversion");
+}
+
+void D3D11ImageConverter::CreateConstantBuffer()
+{
+    D3D11_BUFFER_DESC desc;
+    {
+        desc.ByteWidth              = sizeof(D3D11ConversionConstants);
+        desc.Usage                  = D3D11_USAGE_DYNAMIC;
+        desc.BindFlags              = D3D11_BIND_CONSTANT_BUFFER;
+        desc.CPUAccessFlags         = D3D11_CPU_ACCESS_WRITE;
+        desc.MiscFlags              = 0;
+        desc.StructureByteStride    = 0;
+    }
+    auto hr = device_->CreateBuffer(&desc, nullptr, constantBuffer_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 constant buffer for image conversion");
+}
+
+void D3D11ImageConverter::ReserveSourceBuffer(UINT size)
+{
+    if (size <= srcBufferSize_)
+        return;
+
+    /* Grow in 64 KB steps to avoid recreating the buffer for slightly larger images */
+    srcBufferSize_ = (size + 0xFFFFu) & ~0xFFFFu;
+
+    D3D11_BUFFER_DESC desc;
+    {
+        desc.ByteWidth              = srcBufferSize_;
+        desc.Usage                  = D3D11_USAGE_DYNAMIC;
+        desc.BindFlags              = D3D11_BIND_SHADER_RESOURCE;
+        desc.CPUAccessFlags         = D3D11_CPU_ACCESS_WRITE;
+        desc.MiscFlags              = D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+        desc.StructureByteStride    = 0;
+    }
+    auto hr = device_->CreateBuffer(&desc, nullptr, srcBuffer_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 buffer for image conversion");
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    {
+        srvDesc.Format                  = DXGI_FORMAT_R32_TYPELESS;
+        srvDesc.ViewDimension           = D3D11_SRV_DIMENSION_BUFFEREX;
+        srvDesc.BufferEx.FirstElement   = 0;
+        srvDesc.BufferEx.NumElements    = srcBufferSize_ / 4;
+        srvDesc.BufferEx.Flags          = D3D11_BUFFEREX_SRV_FLAG_RAW;
+    }
+    hr = device_->CreateShaderResourceView(srcBuffer_.Get(), &srvDesc, srcBufferSRV_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 shader-resource-view for image conversion");
+}
+
+void D3D11ImageConverter::ReserveScratchTexture(UINT width, UINT height)
+{
+    if (width <= scratchWidth_ && height <= scratchHeight_)
+        return;
+
+    scratchWidth_   = std::max(scratchWidth_, width);
+    scratchHeight_  = std::max(scratchHeight_, height);
+
+    /* Create typeless texture, so it can be copied into both UNORM and UNORM_SRGB textures */
+    D3D11_TEXTURE2D_DESC desc;
+    {
+        desc.Width              = scratchWidth_;
+        desc.Height             = scratchHeight_;
+        desc.MipLevels          = 1;
+        desc.ArraySize          = 1;
+        desc.Format             = DXGI_FORMAT_R8G8B8A8_TYPELESS;
+        desc.SampleDesc.Count   = 1;
+        desc.SampleDesc.Quality = 0;
+        desc.Usage              = D3D11_USAGE_DEFAULT;
+        desc.BindFlags          = D3D11_BIND_UNORDERED_ACCESS;
+        desc.CPUAccessFlags     = 0;
+        desc.MiscFlags          = 0;
+    }
+    auto hr = device_->CreateTexture2D(&desc, nullptr, scratchTexture_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 scratch texture for image conversion");
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc;
+    {
+        uavDesc.Format              = DXGI_FORMAT_R8G8B8A8_UNORM;
+        uavDesc.ViewDimension       = D3D11_UAV_DIMENSION_TEXTURE2D;
+        uavDesc.Texture2D.MipSlice  = 0;
+    }
+    hr = device_->CreateUnorderedAccessView(scratchTexture_.Get(), &uavDesc, scratchTextureUAV_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 unordered-access-view for image conversion");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
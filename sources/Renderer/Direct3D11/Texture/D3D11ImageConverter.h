@@ -0,0 +1,75 @@
+/*
+ * D3D11ImageConverter.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D11_IMAGE_CONVERTER_H
+#define LLGL_D3D11_IMAGE_CONVERTER_H
+
+
+#include <LLGL/Image.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d11.h>
+
+
+namespace LLGL
+{
+
+
+class D3D11Texture;
+
+/*
+Expands 8-bit color images with a non-native component layout (e.g. RGB or BGR) into RGBA textures with a compute shader.
+The raw image bytes are uploaded into a raw buffer, expanded into a scratch texture, and then copied into the destination subresource,
+so the CPU neither converts the image nor keeps a second, larger copy of it in flight.
+All bindings of the compute shader stage that are used by the converter are restored afterwards, so the state manager remains valid.
+*/
+class D3D11ImageConverter
+{
+
+    public:
+
+        D3D11ImageConverter(ID3D11Device* device, ID3D11DeviceContext* context);
+
+        // Returns true if the specified image can be converted for the 2D region with the specified size of the texture.
+        static bool IsConversionSupported(const D3D11Texture& textureD3D, const ImageDescriptor& imageDesc, UINT width, UINT height);
+
+        // Converts the specified image and writes it into the 2D region of the destination subresource.
+        void WriteTexture(D3D11Texture& textureD3D, UINT dstSubresource, UINT dstX, UINT dstY, UINT width, UINT height, const ImageDescriptor& imageDesc);
+
+    private:
+
+        void CreateComputeShader();
+        void CreateConstantBuffer();
+
+        void ReserveSourceBuffer(UINT size);
+        void ReserveScratchTexture(UINT width, UINT height);
+
+        ID3D11Device*                       device_                 = nullptr;
+        ID3D11DeviceContext*                context_                = nullptr;
+
+        ComPtr<ID3D11ComputeShader>         computeShader_;
+        ComPtr<ID3D11Buffer>                constantBuffer_;
+
+        ComPtr<ID3D11Buffer>                srcBuffer_;             // dynamic raw buffer for the image bytes
+        ComPtr<ID3D11ShaderResourceView>    srcBufferSRV_;
+        UINT                                srcBufferSize_          = 0;
+
+        ComPtr<ID3D11Texture2D>             scratchTexture_;        // RGBA8 texture with typed UAV stores
+        ComPtr<ID3D11UnorderedAccessView>   scratchTextureUAV_;
+        UINT                                scratchWidth_           = 0;
+        UINT                                scratchHeight_          = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
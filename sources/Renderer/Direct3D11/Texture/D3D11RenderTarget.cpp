@@ -7,9 +7,11 @@
 
 #include "D3D11RenderTarget.h"
 #include "../D3D11RenderSystem.h"
+#include "../D3D11Types.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Helper.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -78,7 +80,7 @@ static void FillViewDescForTexture2DArray(const RenderTargetAttachmentDescriptor
     viewDesc.ViewDimension                  = D3D11_RTV_DIMENSION_TEXTURE2DARRAY;
     viewDesc.Texture2DArray.MipSlice        = attachmentDesc.mipLevel;
     viewDesc.Texture2DArray.FirstArraySlice = attachmentDesc.layer;
-    viewDesc.Texture2DArray.ArraySize       = 1;
+    viewDesc.Texture2DArray.ArraySize       = (std::max)(1u, attachmentDesc.numViews);
 }
 
 static void FillViewDescForTextureCubeArray(const RenderTargetAttachmentDescriptor& attachmentDesc, D3D11_RENDER_TARGET_VIEW_DESC& viewDesc)
@@ -105,7 +107,7 @@ static void FillViewDescForTexture2DArrayMS(const RenderTargetAttachmentDescript
 {
     viewDesc.ViewDimension                      = D3D11_RTV_DIMENSION_TEXTURE2DMSARRAY;
     viewDesc.Texture2DMSArray.FirstArraySlice   = attachmentDesc.layer;
-    viewDesc.Texture2DMSArray.ArraySize         = 1;
+    viewDesc.Texture2DMSArray.ArraySize         = (std::max)(1u, attachmentDesc.numViews);
 }
 
 static void FillViewDescForTextureCubeArrayMS(const RenderTargetAttachmentDescriptor& attachmentDesc, D3D11_RENDER_TARGET_VIEW_DESC& viewDesc)
@@ -115,12 +117,86 @@ static void FillViewDescForTextureCubeArrayMS(const RenderTargetAttachmentDescri
     viewDesc.Texture2DMSArray.ArraySize         = 1;
 }
 
+// Returns the number of array layers of the specified 1D, 2D, or cube texture (cube faces are array layers).
+static UINT GetTextureArraySize(D3D11Texture& textureD3D)
+{
+    if (textureD3D.GetType() == TextureType::Texture1DArray)
+    {
+        D3D11_TEXTURE1D_DESC texDesc;
+        textureD3D.GetHardwareTexture().tex1D->GetDesc(&texDesc);
+        return texDesc.ArraySize;
+    }
+    else
+    {
+        D3D11_TEXTURE2D_DESC texDesc;
+        textureD3D.GetHardwareTexture().tex2D->GetDesc(&texDesc);
+        return texDesc.ArraySize;
+    }
+}
+
+// Extends the specified RTV descriptor to all array layers (or all depth slices) of its texture for a layered attachment.
+static void ExtendViewDescToAllLayers(D3D11_RENDER_TARGET_VIEW_DESC& viewDesc, UINT arraySize)
+{
+    switch (viewDesc.ViewDimension)
+    {
+        case D3D11_RTV_DIMENSION_TEXTURE1DARRAY:
+            viewDesc.Texture1DArray.FirstArraySlice     = 0;
+            viewDesc.Texture1DArray.ArraySize           = arraySize;
+            break;
+        case D3D11_RTV_DIMENSION_TEXTURE2DARRAY:
+            viewDesc.Texture2DArray.FirstArraySlice     = 0;
+            viewDesc.Texture2DArray.ArraySize           = arraySize;
+            break;
+        case D3D11_RTV_DIMENSION_TEXTURE2DMSARRAY:
+            viewDesc.Texture2DMSArray.FirstArraySlice   = 0;
+            viewDesc.Texture2DMSArray.ArraySize         = arraySize;
+            break;
+        case D3D11_RTV_DIMENSION_TEXTURE3D:
+            viewDesc.Texture3D.FirstWSlice              = 0;
+            viewDesc.Texture3D.WSize                    = static_cast<UINT>(-1);
+            break;
+        default:
+            throw std::invalid_argument("layered render target attachments must be array, cube, or 3D textures");
+            break;
+    }
+}
+
+// Extends the specified DSV descriptor to all array layers of its texture for a layered attachment.
+static void ExtendViewDescToAllLayers(D3D11_DEPTH_STENCIL_VIEW_DESC& viewDesc, UINT arraySize)
+{
+    switch (viewDesc.ViewDimension)
+    {
+        case D3D11_DSV_DIMENSION_TEXTURE1DARRAY:
+            viewDesc.Texture1DArray.FirstArraySlice     = 0;
+            viewDesc.Texture1DArray.ArraySize           = arraySize;
+            break;
+        case D3D11_DSV_DIMENSION_TEXTURE2DARRAY:
+            viewDesc.Texture2DArray.FirstArraySlice     = 0;
+            viewDesc.Texture2DArray.ArraySize           = arraySize;
+            break;
+        case D3D11_DSV_DIMENSION_TEXTURE2DMSARRAY:
+            viewDesc.Texture2DMSArray.FirstArraySlice   = 0;
+            viewDesc.Texture2DMSArray.ArraySize         = arraySize;
+            break;
+        default:
+            throw std::invalid_argument("layered depth-stencil attachments must be array or cube textures");
+            break;
+    }
+}
+
 void D3D11RenderTarget::AttachTexture(Texture& texture, const RenderTargetAttachmentDescriptor& attachmentDesc)
 {
     /* Get D3D texture object and apply resolution for MIP-map level */
     auto& textureD3D = LLGL_CAST(D3D11Texture&, texture);
     ApplyMipResolution(texture, attachmentDesc.mipLevel);
 
+    /* Depth-stencil textures are attached with a DSV instead of an RTV */
+    if (DXIsDepthStencilFormat(textureD3D.GetFormat()))
+    {
+        CreateDSVForTexture(textureD3D, attachmentDesc);
+        return;
+    }
+
     /* Initialize RTV descriptor with attachment procedure and create RTV */
     D3D11_RENDER_TARGET_VIEW_DESC rtvDesc;
     InitMemory(rtvDesc);
@@ -133,6 +209,9 @@ void D3D11RenderTarget::AttachTexture(Texture& texture, const RenderTargetAttach
     */
     if (HasMultiSampling() && !IsMultiSampleTexture(texture.GetType()))
     {
+        if (attachmentDesc.layered)
+            throw std::invalid_argument("layered render target attachments cannot be resolved from a multi-sample texture (requires custom multi-sampling)");
+
         /* Get RTV descriptor for intermediate multi-sample texture */
         switch (texture.GetType())
         {
@@ -213,6 +292,10 @@ void D3D11RenderTarget::AttachTexture(Texture& texture, const RenderTargetAttach
                 FillViewDescForTexture2DArrayMS(attachmentDesc, rtvDesc);
                 break;
         }
+
+        /* Attach all layers (or cube faces, or depth slices), which are selected per primitive in the shader */
+        if (attachmentDesc.layered)
+            ExtendViewDescToAllLayers(rtvDesc, (texture.GetType() == TextureType::Texture3D ? 1 : GetTextureArraySize(textureD3D)));
     
         /* Create RTV for target texture */
         CreateAndAppendRTV(textureD3D.GetHardwareTexture().resource.Get(), rtvDesc);
@@ -249,6 +332,31 @@ void D3D11RenderTarget::ResolveSubresources(ID3D11DeviceContext* context)
     }
 }
 
+// Returns the estimated size (in bytes) of the specified 2D-texture with a single MIP-map level.
+static std::uint64_t GetTexture2DMemory(ID3D11Texture2D* texture)
+{
+    D3D11_TEXTURE2D_DESC texDesc;
+    texture->GetDesc(&texDesc);
+    return
+    (
+        static_cast<std::uint64_t>(texDesc.Width) * texDesc.Height * texDesc.ArraySize *
+        std::max(1u, texDesc.SampleDesc.Count) * TextureFormatSize(D3D11Types::Unmap(texDesc.Format))
+    );
+}
+
+std::uint64_t D3D11RenderTarget::GetInternalMemory() const
+{
+    std::uint64_t size = 0;
+
+    if (depthStencil_)
+        size += GetTexture2DMemory(depthStencil_.Get());
+
+    for (const auto& attachment : multiSampledAttachments_)
+        size += GetTexture2DMemory(attachment.texture2DMS.Get());
+
+    return size;
+}
+
 
 /*
  * ======= Private: =======
@@ -258,6 +366,9 @@ void D3D11RenderTarget::CreateDepthStencilAndDSV(const Gs::Vector2ui& size, DXGI
 {
     HRESULT hr = 0;
 
+    if (depthStencilView_)
+        throw std::runtime_error("attachment to render target failed, because render target already has a depth- or depth-stencil buffer");
+
     /* Apply size to render target resolution, and create depth-stencil */
     ApplyResolution(size);
 
@@ -284,6 +395,79 @@ void D3D11RenderTarget::CreateDepthStencilAndDSV(const Gs::Vector2ui& size, DXGI
     DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil-view (DSV) for render-target");
 }
 
+void D3D11RenderTarget::CreateDSVForTexture(D3D11Texture& textureD3D, const RenderTargetAttachmentDescriptor& attachmentDesc)
+{
+    if (depthStencilView_)
+        throw std::runtime_error("attachment to render target failed, because render target already has a depth- or depth-stencil buffer");
+
+    /*
+    Multi-sampled depth-stencil textures can not be resolved with "ResolveSubresource",
+    so a depth texture must have the same sample count as the render target.
+    */
+    if (HasMultiSampling() && !IsMultiSampleTexture(textureD3D.GetType()))
+        throw std::invalid_argument("failed to attach non-multi-sample D3D11 depth texture to multi-sample render-target");
+
+    /* Initialize DSV descriptor with attachment procedure */
+    D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc;
+    InitMemory(dsvDesc);
+
+    dsvDesc.Format = textureD3D.GetFormat();
+
+    switch (textureD3D.GetType())
+    {
+        case TextureType::Texture1D:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE1D;
+            dsvDesc.Texture1D.MipSlice                  = attachmentDesc.mipLevel;
+            break;
+        case TextureType::Texture1DArray:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE1DARRAY;
+            dsvDesc.Texture1DArray.MipSlice             = attachmentDesc.mipLevel;
+            dsvDesc.Texture1DArray.FirstArraySlice      = attachmentDesc.layer;
+            dsvDesc.Texture1DArray.ArraySize            = 1;
+            break;
+        case TextureType::Texture2D:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE2D;
+            dsvDesc.Texture2D.MipSlice                  = attachmentDesc.mipLevel;
+            break;
+        case TextureType::TextureCube:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+            dsvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            dsvDesc.Texture2DArray.FirstArraySlice      = static_cast<UINT>(attachmentDesc.cubeFace);
+            dsvDesc.Texture2DArray.ArraySize            = 1;
+            break;
+        case TextureType::Texture2DArray:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+            dsvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            dsvDesc.Texture2DArray.FirstArraySlice      = attachmentDesc.layer;
+            dsvDesc.Texture2DArray.ArraySize            = (std::max)(1u, attachmentDesc.numViews);
+            break;
+        case TextureType::TextureCubeArray:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+            dsvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            dsvDesc.Texture2DArray.FirstArraySlice      = attachmentDesc.layer * 6 + static_cast<UINT>(attachmentDesc.cubeFace);
+            dsvDesc.Texture2DArray.ArraySize            = 1;
+            break;
+        case TextureType::Texture2DMS:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE2DMS;
+            break;
+        case TextureType::Texture2DMSArray:
+            dsvDesc.ViewDimension                       = D3D11_DSV_DIMENSION_TEXTURE2DMSARRAY;
+            dsvDesc.Texture2DMSArray.FirstArraySlice    = attachmentDesc.layer;
+            dsvDesc.Texture2DMSArray.ArraySize          = 1;
+            break;
+        default:
+            throw std::invalid_argument("failed to attach D3D11 depth texture with invalid texture type to render-target");
+            break;
+    }
+
+    if (attachmentDesc.layered)
+        ExtendViewDescToAllLayers(dsvDesc, GetTextureArraySize(textureD3D));
+
+    /* Create DSV for the depth texture (the texture itself is owned by the client programmer) */
+    auto hr = device_->CreateDepthStencilView(textureD3D.GetHardwareTexture().resource.Get(), &dsvDesc, depthStencilView_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 depth-stencil-view (DSV) for depth texture attachment");
+}
+
 void D3D11RenderTarget::CreateAndAppendRTV(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC& rtvDesc)
 {
     ComPtr<ID3D11RenderTargetView> rtv;
@@ -13,6 +13,7 @@
 #include "../../DXCommon/ComPtr.h"
 #include <vector>
 #include <functional>
+#include <cstdint>
 #include <d3d11.h>
 
 
@@ -43,6 +44,12 @@ class D3D11RenderTarget : public RenderTarget
         // Resolves all multi-sampled subresources.
         void ResolveSubresources(ID3D11DeviceContext* context);
 
+        // Returns true if this render target has multi-sampled attachments that are resolved with "ResolveSubresources".
+        inline bool HasResolveAttachments() const
+        {
+            return !multiSampledAttachments_.empty();
+        }
+
         inline const std::vector<ID3D11RenderTargetView*>& GetRenderTargetViews() const
         {
             return renderTargetViewsRef_;
@@ -53,9 +60,13 @@ class D3D11RenderTarget : public RenderTarget
             return depthStencilView_.Get();
         }
 
+        // Returns the estimated size (in bytes) of the depth-stencil and multi-sampled textures this render target has created internally.
+        std::uint64_t GetInternalMemory() const;
+
     private:
 
         void CreateDepthStencilAndDSV(const Gs::Vector2ui& size, DXGI_FORMAT format);
+        void CreateDSVForTexture(D3D11Texture& textureD3D, const RenderTargetAttachmentDescriptor& attachmentDesc);
         void CreateAndAppendRTV(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC& rtvDesc);
 
         bool HasMultiSampling() const;
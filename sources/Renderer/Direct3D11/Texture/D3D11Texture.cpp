@@ -6,7 +6,9 @@
  */
 
 #include "D3D11Texture.h"
+#include "../D3D11Types.h"
 #include "../../DXCommon/DXCore.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -22,6 +24,8 @@ Gs::Vector3ui D3D11Texture::QueryMipLevelSize(unsigned int mipLevel) const
 {
     Gs::Vector3ui size;
 
+    mipLevel += baseMipLevel_;
+
     if (hardwareTexture_.resource)
     {
         D3D11_RESOURCE_DIMENSION dimension;
@@ -94,18 +98,125 @@ static ComPtr<ID3D11Texture3D> DXCreateTexture3D(
     return tex3D;
 }
 
+// Returns true if the specified texture is a depth-stencil texture which can also be sampled in a shader.
+static bool IsSampledDepthStencil(DXGI_FORMAT format, UINT bindFlags)
+{
+    return (DXIsDepthStencilFormat(format) && (bindFlags & D3D11_BIND_SHADER_RESOURCE) != 0);
+}
+
+static void FillDepthSRVDesc1D(const TextureType type, const D3D11_TEXTURE1D_DESC& desc, D3D11_SHADER_RESOURCE_VIEW_DESC& srvDesc)
+{
+    srvDesc.Format = DXGetDepthSRVFormat(desc.Format);
+
+    if (type == TextureType::Texture1DArray)
+    {
+        srvDesc.ViewDimension                   = D3D11_SRV_DIMENSION_TEXTURE1DARRAY;
+        srvDesc.Texture1DArray.MostDetailedMip  = 0;
+        srvDesc.Texture1DArray.MipLevels        = -1;
+        srvDesc.Texture1DArray.FirstArraySlice  = 0;
+        srvDesc.Texture1DArray.ArraySize        = desc.ArraySize;
+    }
+    else
+    {
+        srvDesc.ViewDimension                   = D3D11_SRV_DIMENSION_TEXTURE1D;
+        srvDesc.Texture1D.MostDetailedMip       = 0;
+        srvDesc.Texture1D.MipLevels             = -1;
+    }
+}
+
+static void FillDepthSRVDesc2D(const TextureType type, const D3D11_TEXTURE2D_DESC& desc, D3D11_SHADER_RESOURCE_VIEW_DESC& srvDesc)
+{
+    srvDesc.Format = DXGetDepthSRVFormat(desc.Format);
+
+    switch (type)
+    {
+        case TextureType::Texture2DArray:
+            srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+            srvDesc.Texture2DArray.MostDetailedMip      = 0;
+            srvDesc.Texture2DArray.MipLevels            = -1;
+            srvDesc.Texture2DArray.FirstArraySlice      = 0;
+            srvDesc.Texture2DArray.ArraySize            = desc.ArraySize;
+            break;
+        case TextureType::TextureCube:
+            srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURECUBE;
+            srvDesc.TextureCube.MostDetailedMip         = 0;
+            srvDesc.TextureCube.MipLevels               = -1;
+            break;
+        case TextureType::TextureCubeArray:
+            srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+            srvDesc.TextureCubeArray.MostDetailedMip    = 0;
+            srvDesc.TextureCubeArray.MipLevels          = -1;
+            srvDesc.TextureCubeArray.First2DArrayFace   = 0;
+            srvDesc.TextureCubeArray.NumCubes           = desc.ArraySize / 6;
+            break;
+        case TextureType::Texture2DMS:
+            srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURE2DMS;
+            break;
+        case TextureType::Texture2DMSArray:
+            srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURE2DMSARRAY;
+            srvDesc.Texture2DMSArray.FirstArraySlice    = 0;
+            srvDesc.Texture2DMSArray.ArraySize          = desc.ArraySize;
+            break;
+        default:
+            srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURE2D;
+            srvDesc.Texture2D.MostDetailedMip           = 0;
+            srvDesc.Texture2D.MipLevels                 = -1;
+            break;
+    }
+}
+
+/*
+Depth-stencil textures, which are also bound as shader resource, are created with a typeless resource format,
+since the depth-stencil-view (DSV) and shader-resource-view (SRV) require different formats.
+The stored format remains the depth-stencil format, which is used for the DSV.
+*/
+
 void D3D11Texture::CreateTexture1D(
     ID3D11Device* device, const D3D11_TEXTURE1D_DESC& desc, const D3D11_SUBRESOURCE_DATA* initialData, const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc)
 {
-    hardwareTexture_.tex1D = DXCreateTexture1D(device, desc, initialData);
-    CreateSRVAndStoreSettings(device, desc.Format, { desc.Width, 1, 1 }, srvDesc);
+    if (IsSampledDepthStencil(desc.Format, desc.BindFlags))
+    {
+        auto typelessDesc = desc;
+        typelessDesc.Format = DXGetTypelessDepthStencilFormat(desc.Format);
+        hardwareTexture_.tex1D = DXCreateTexture1D(device, typelessDesc, initialData);
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC depthSRVDesc;
+        if (!srvDesc)
+        {
+            FillDepthSRVDesc1D(GetType(), desc, depthSRVDesc);
+            srvDesc = &depthSRVDesc;
+        }
+        CreateSRVAndStoreSettings(device, desc.Format, { desc.Width, 1, 1 }, srvDesc);
+    }
+    else
+    {
+        hardwareTexture_.tex1D = DXCreateTexture1D(device, desc, initialData);
+        CreateSRVAndStoreSettings(device, desc.Format, { desc.Width, 1, 1 }, srvDesc);
+    }
 }
 
 void D3D11Texture::CreateTexture2D(
     ID3D11Device* device, const D3D11_TEXTURE2D_DESC& desc, const D3D11_SUBRESOURCE_DATA* initialData, const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc)
 {
-    hardwareTexture_.tex2D = DXCreateTexture2D(device, desc, initialData);
-    CreateSRVAndStoreSettings(device, desc.Format, { desc.Width, desc.Height, 1 }, srvDesc);
+    if (IsSampledDepthStencil(desc.Format, desc.BindFlags))
+    {
+        auto typelessDesc = desc;
+        typelessDesc.Format = DXGetTypelessDepthStencilFormat(desc.Format);
+        hardwareTexture_.tex2D = DXCreateTexture2D(device, typelessDesc, initialData);
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC depthSRVDesc;
+        if (!srvDesc)
+        {
+            FillDepthSRVDesc2D(GetType(), desc, depthSRVDesc);
+            srvDesc = &depthSRVDesc;
+        }
+        CreateSRVAndStoreSettings(device, desc.Format, { desc.Width, desc.Height, 1 }, srvDesc);
+    }
+    else
+    {
+        hardwareTexture_.tex2D = DXCreateTexture2D(device, desc, initialData);
+        CreateSRVAndStoreSettings(device, desc.Format, { desc.Width, desc.Height, 1 }, srvDesc);
+    }
 }
 
 void D3D11Texture::CreateTexture3D(
@@ -115,13 +226,290 @@ void D3D11Texture::CreateTexture3D(
     CreateSRVAndStoreSettings(device, desc.Format, { desc.Width, desc.Height, desc.Depth }, srvDesc);
 }
 
+/*
+A view of a single array layer other than the first one is created with an array dimension,
+since the non-array dimensions of a shader-resource-view (SRV) cannot select an array layer.
+*/
+static void FillViewSRVDesc(const TextureViewDescriptor& desc, D3D11_SHADER_RESOURCE_VIEW_DESC& srvDesc)
+{
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            if (desc.type == TextureType::Texture1D && desc.firstArrayLayer == 0)
+            {
+                srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURE1D;
+                srvDesc.Texture1D.MostDetailedMip           = desc.firstMipLevel;
+                srvDesc.Texture1D.MipLevels                 = desc.numMipLevels;
+            }
+            else
+            {
+                srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURE1DARRAY;
+                srvDesc.Texture1DArray.MostDetailedMip      = desc.firstMipLevel;
+                srvDesc.Texture1DArray.MipLevels            = desc.numMipLevels;
+                srvDesc.Texture1DArray.FirstArraySlice      = desc.firstArrayLayer;
+                srvDesc.Texture1DArray.ArraySize            = desc.numArrayLayers;
+            }
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+            if (desc.type == TextureType::Texture2D && desc.firstArrayLayer == 0)
+            {
+                srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURE2D;
+                srvDesc.Texture2D.MostDetailedMip           = desc.firstMipLevel;
+                srvDesc.Texture2D.MipLevels                 = desc.numMipLevels;
+            }
+            else
+            {
+                srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+                srvDesc.Texture2DArray.MostDetailedMip      = desc.firstMipLevel;
+                srvDesc.Texture2DArray.MipLevels            = desc.numMipLevels;
+                srvDesc.Texture2DArray.FirstArraySlice      = desc.firstArrayLayer;
+                srvDesc.Texture2DArray.ArraySize            = desc.numArrayLayers;
+            }
+            break;
+
+        case TextureType::Texture3D:
+            srvDesc.ViewDimension                           = D3D11_SRV_DIMENSION_TEXTURE3D;
+            srvDesc.Texture3D.MostDetailedMip               = desc.firstMipLevel;
+            srvDesc.Texture3D.MipLevels                     = desc.numMipLevels;
+            break;
+
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            if (desc.type == TextureType::TextureCube && desc.firstArrayLayer == 0)
+            {
+                srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURECUBE;
+                srvDesc.TextureCube.MostDetailedMip         = desc.firstMipLevel;
+                srvDesc.TextureCube.MipLevels               = desc.numMipLevels;
+            }
+            else
+            {
+                srvDesc.ViewDimension                       = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+                srvDesc.TextureCubeArray.MostDetailedMip    = desc.firstMipLevel;
+                srvDesc.TextureCubeArray.MipLevels          = desc.numMipLevels;
+                srvDesc.TextureCubeArray.First2DArrayFace   = desc.firstArrayLayer;
+                srvDesc.TextureCubeArray.NumCubes           = desc.numArrayLayers / 6;
+            }
+            break;
+
+        case TextureType::Texture2DMS:
+            srvDesc.ViewDimension                           = D3D11_SRV_DIMENSION_TEXTURE2DMS;
+            break;
+
+        case TextureType::Texture2DMSArray:
+            srvDesc.ViewDimension                           = D3D11_SRV_DIMENSION_TEXTURE2DMSARRAY;
+            srvDesc.Texture2DMSArray.FirstArraySlice        = desc.firstArrayLayer;
+            srvDesc.Texture2DMSArray.ArraySize              = desc.numArrayLayers;
+            break;
+    }
+}
+
+void D3D11Texture::CreateTextureView(ID3D11Device* device, const D3D11Texture& sharedTexture, const TextureViewDescriptor& desc)
+{
+    /* Share hardware resource and keep the number of MIP-maps of the shared texture to address its subresources */
+    hardwareTexture_.resource   = sharedTexture.hardwareTexture_.resource;
+    format_                     = (desc.format != TextureFormat::Unknown ? D3D11Types::Map(desc.format) : sharedTexture.GetFormat());
+    numMipLevels_               = sharedTexture.GetNumMipLevels();
+    baseMipLevel_               = desc.firstMipLevel;
+
+    /* Create SRV for the range of subresources */
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    {
+        srvDesc.Format = (DXIsDepthStencilFormat(format_) ? DXGetDepthSRVFormat(format_) : format_);
+        FillViewSRVDesc(desc, srvDesc);
+    }
+    CreateSRV(device, &srvDesc);
+}
+
+void D3D11Texture::InitTileMappings(ID3D11Device2* device, ID3D11DeviceContext2* context, const Gs::Vector3ui& extent, bool layered)
+{
+    /* Query tile shape and packed MIP-maps of the tiled resource */
+    UINT                    numTiles                = 0;
+    D3D11_PACKED_MIP_DESC   packedMipDesc;
+    D3D11_TILE_SHAPE        tileShape;
+    UINT                    numSubresourceTilings   = 0;
+
+    device->GetResourceTiling(
+        hardwareTexture_.resource.Get(), &numTiles, &packedMipDesc, &tileShape, &numSubresourceTilings, 0, nullptr
+    );
+
+    sparsePageTable_ = std::unique_ptr<SparsePageTable>(
+        new SparsePageTable(
+            extent,
+            layered,
+            Gs::Vector3ui { tileShape.WidthInTexels, tileShape.HeightInTexels, (layered ? 1u : tileShape.DepthInTexels) },
+            packedMipDesc.NumStandardMips
+        )
+    );
+
+    /* Create tile pool with enough tiles for the packed MIP-maps of each array layer */
+    const UINT numLayers = (layered ? extent.z : 1);
+
+    numPoolTiles_ = std::max(1u, packedMipDesc.NumTilesForPackedMips * numLayers);
+
+    D3D11_BUFFER_DESC poolDesc;
+    {
+        poolDesc.ByteWidth              = numPoolTiles_ * D3D11_2_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        poolDesc.Usage                  = D3D11_USAGE_DEFAULT;
+        poolDesc.BindFlags              = 0;
+        poolDesc.CPUAccessFlags         = 0;
+        poolDesc.MiscFlags              = D3D11_RESOURCE_MISC_TILE_POOL;
+        poolDesc.StructureByteStride    = 0;
+    }
+    auto hr = device->CreateBuffer(&poolDesc, nullptr, tilePool_.ReleaseAndGetAddressOf());
+    DXThrowIfFailed(hr, "failed to create D3D11 tile pool for sparse texture");
+
+    /* Map packed MIP-maps of each array layer, which are always resident */
+    if (packedMipDesc.NumTilesForPackedMips > 0)
+    {
+        for (UINT layer = 0; layer < numLayers; ++layer)
+        {
+            D3D11_TILED_RESOURCE_COORDINATE coord;
+            {
+                coord.X             = 0;
+                coord.Y             = 0;
+                coord.Z             = 0;
+                coord.Subresource   = D3D11CalcSubresource(packedMipDesc.NumStandardMips, layer, numMipLevels_);
+            }
+
+            D3D11_TILE_REGION_SIZE regionSize;
+            {
+                regionSize.NumTiles = packedMipDesc.NumTilesForPackedMips;
+                regionSize.bUseBox  = FALSE;
+                regionSize.Width    = 0;
+                regionSize.Height   = 0;
+                regionSize.Depth    = 0;
+            }
+
+            /* Packed MIP-maps of each layer occupy consecutive tiles at the beginning of the tile pool */
+            const UINT rangeFlags       = 0;
+            const UINT poolStartOffset  = layer * packedMipDesc.NumTilesForPackedMips;
+            const UINT rangeTileCount   = packedMipDesc.NumTilesForPackedMips;
+
+            hr = context->UpdateTileMappings(
+                hardwareTexture_.resource.Get(), 1, &coord, &regionSize, tilePool_.Get(), 1, &rangeFlags, &poolStartOffset, &rangeTileCount, 0
+            );
+            DXThrowIfFailed(hr, "failed to map packed MIP-maps of D3D11 sparse texture");
+        }
+        numUsedPoolTiles_ = packedMipDesc.NumTilesForPackedMips * numLayers;
+    }
+}
+
+// Returns the key of the specified tile for the map of tile pool offsets.
+static std::uint64_t GetTileKey(const D3D11_TILED_RESOURCE_COORDINATE& coord)
+{
+    return
+    (
+        (static_cast<std::uint64_t>(coord.Subresource) << 48) |
+        (static_cast<std::uint64_t>(coord.Z          ) << 32) |
+        (static_cast<std::uint64_t>(coord.Y          ) << 16) |
+        (static_cast<std::uint64_t>(coord.X          )      )
+    );
+}
+
+void D3D11Texture::CommitTiles(ID3D11DeviceContext2* context, const TextureRegion& region, bool commit)
+{
+    if (!sparsePageTable_)
+        return;
+
+    std::vector<D3D11_TILED_RESOURCE_COORDINATE>    coords;
+    std::vector<UINT>                               poolStartOffsets;
+
+    /* Gather all tiles whose mapping changes */
+    const bool layered = (GetType() != TextureType::Texture2D && GetType() != TextureType::Texture3D);
+
+    sparsePageTable_->Commit(
+        region,
+        commit,
+        [&](unsigned int mipLevel, const Gs::Vector3ui& page)
+        {
+            D3D11_TILED_RESOURCE_COORDINATE coord;
+            {
+                coord.X             = page.x;
+                coord.Y             = page.y;
+                coord.Z             = (layered ? 0 : page.z);
+                coord.Subresource   = (layered ? D3D11CalcSubresource(mipLevel, page.z, numMipLevels_) : mipLevel);
+            }
+            coords.push_back(coord);
+
+            auto key = GetTileKey(coord);
+            if (commit)
+            {
+                auto tile = AllocTile(context);
+                mappedTiles_[key] = tile;
+                poolStartOffsets.push_back(tile);
+            }
+            else
+            {
+                auto it = mappedTiles_.find(key);
+                if (it != mappedTiles_.end())
+                {
+                    freeTiles_.push_back(it->second);
+                    mappedTiles_.erase(it);
+                }
+                poolStartOffsets.push_back(0);
+            }
+        }
+    );
+
+    if (coords.empty())
+        return;
+
+    /* Update all tile mappings with a single command, where each tile is a separate region and range */
+    const auto numTiles = static_cast<UINT>(coords.size());
+
+    D3D11_TILE_REGION_SIZE regionSize;
+    {
+        regionSize.NumTiles = 1;
+        regionSize.bUseBox  = FALSE;
+        regionSize.Width    = 0;
+        regionSize.Height   = 0;
+        regionSize.Depth    = 0;
+    }
+    std::vector<D3D11_TILE_REGION_SIZE> regionSizes(numTiles, regionSize);
+    std::vector<UINT>                   rangeFlags(numTiles, (commit ? 0 : D3D11_TILE_RANGE_NULL));
+    std::vector<UINT>                   rangeTileCounts(numTiles, 1);
+
+    auto hr = context->UpdateTileMappings(
+        hardwareTexture_.resource.Get(),
+        numTiles,
+        coords.data(),
+        regionSizes.data(),
+        tilePool_.Get(),
+        numTiles,
+        rangeFlags.data(),
+        poolStartOffsets.data(),
+        rangeTileCounts.data(),
+        0
+    );
+    DXThrowIfFailed(hr, "failed to update tile mappings of D3D11 sparse texture");
+}
+
 void D3D11Texture::UpdateSubresource(
     ID3D11DeviceContext* context, UINT mipSlice, UINT arraySlice, const D3D11_BOX& dstBox,
     const ImageDescriptor& imageDesc, std::size_t threadCount)
 {
     /* Get destination subresource index */
     auto dstSubresource = D3D11CalcSubresource(mipSlice, arraySlice, numMipLevels_);
-    auto srcPitch       = DataTypeSize(imageDesc.dataType) * ImageFormatSize(imageDesc.format);
+
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        /* Get source data stride from the rows of blocks of the compressed hardware format */
+        auto texFormat      = D3D11Types::Unmap(format_);
+        auto srcRowPitch    = CompressedImageRowPitch(texFormat, dstBox.right - dstBox.left);
+        auto srcDepthPitch  = CompressedImageSize(texFormat, dstBox.right - dstBox.left, dstBox.bottom - dstBox.top);
+
+        /* Update subresource with compressed image data (region must be aligned to the block size) */
+        context->UpdateSubresource(
+            hardwareTexture_.resource.Get(), dstSubresource,
+            &dstBox, imageDesc.buffer, srcRowPitch, srcDepthPitch
+        );
+        return;
+    }
+
+    auto srcPitch = DataTypeSize(imageDesc.dataType) * ImageFormatSize(imageDesc.format);
 
     /* Check if source image must be converted */
     auto dstTexFormat = DXGetTextureFormatDesc(format_);
@@ -263,6 +651,27 @@ void D3D11Texture::CreateSRVAndStoreSettings(
     numMipLevels_   = NumMipLevels(size.x, size.y, size.z);
 }
 
+UINT D3D11Texture::AllocTile(ID3D11DeviceContext2* context)
+{
+    /* Reuse tiles of decommitted pages first */
+    if (!freeTiles_.empty())
+    {
+        auto tile = freeTiles_.back();
+        freeTiles_.pop_back();
+        return tile;
+    }
+
+    /* Double the size of the tile pool if all tiles are in use */
+    if (numUsedPoolTiles_ >= numPoolTiles_)
+    {
+        numPoolTiles_ *= 2;
+        auto hr = context->ResizeTilePool(tilePool_.Get(), static_cast<UINT64>(numPoolTiles_) * D3D11_2_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
+        DXThrowIfFailed(hr, "failed to resize D3D11 tile pool for sparse texture");
+    }
+
+    return numUsedPoolTiles_++;
+}
+
 
 } // /namespace LLGL
 
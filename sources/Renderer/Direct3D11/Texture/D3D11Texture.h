@@ -10,8 +10,12 @@
 
 
 #include <LLGL/Texture.h>
-#include <d3d11.h>
+#include <d3d11_2.h>
 #include "../../DXCommon/ComPtr.h"
+#include "../../SparsePageTable.h"
+#include <memory>
+#include <vector>
+#include <map>
 
 
 namespace LLGL
@@ -67,6 +71,18 @@ class D3D11Texture : public Texture
             const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc = nullptr
         );
 
+        // Initializes this texture as view of the specified texture, which shares its hardware resource with a new SRV.
+        void CreateTextureView(ID3D11Device* device, const D3D11Texture& sharedTexture, const TextureViewDescriptor& desc);
+
+        /**
+        Initializes the page table and tile pool of this tiled texture and maps its packed MIP-maps (requires Direct3D 11.2).
+        The hardware texture must have been created with the D3D11_RESOURCE_MISC_TILED flag.
+        */
+        void InitTileMappings(ID3D11Device2* device, ID3D11DeviceContext2* context, const Gs::Vector3ui& extent, bool layered);
+
+        // Maps (or unmaps) the tiles, which the specified region overlaps with, to (or from) the tile pool.
+        void CommitTiles(ID3D11DeviceContext2* context, const TextureRegion& region, bool commit);
+
         void UpdateSubresource(
             ID3D11DeviceContext* context,
             UINT mipSlice, UINT arraySlice, const D3D11_BOX& dstBox,
@@ -105,6 +121,12 @@ class D3D11Texture : public Texture
             return numMipLevels_;
         }
 
+        // Returns the page table if this is a tiled texture, or null otherwise.
+        inline const SparsePageTable* GetSparsePageTable() const
+        {
+            return sparsePageTable_.get();
+        }
+
     private:
 
         void CreateSRV(ID3D11Device* device, const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc = nullptr);
@@ -114,11 +136,22 @@ class D3D11Texture : public Texture
             const D3D11_SHADER_RESOURCE_VIEW_DESC* srvDesc = nullptr
         );
 
+        // Returns the offset of a free tile in the tile pool, which is resized if all tiles are in use.
+        UINT AllocTile(ID3D11DeviceContext2* context);
+
         D3D11HardwareTexture                hardwareTexture_;//hwTexture_
         ComPtr<ID3D11ShaderResourceView>    srv_;
 
         DXGI_FORMAT                         format_             = DXGI_FORMAT_UNKNOWN;
         UINT                                numMipLevels_       = 0;
+        UINT                                baseMipLevel_       = 0; // First MIP-map level if this is a texture view
+
+        std::unique_ptr<SparsePageTable>    sparsePageTable_;
+        ComPtr<ID3D11Buffer>                tilePool_;
+        UINT                                numPoolTiles_       = 0;
+        UINT                                numUsedPoolTiles_   = 0;
+        std::vector<UINT>                   freeTiles_;
+        std::map<std::uint64_t, UINT>       mappedTiles_;       // Tile pool offsets of the mapped pages, keyed by subresource and tile coordinate
 
 };
 
@@ -8,8 +8,10 @@
 #include "D3D12Buffer.h"
 #include "../../Assertion.h"
 #include "../../DXCommon/DXCore.h"
+#include "../../../Core/Exception.h"
 #include "../D3DX12/d3dx12.h"
 #include <stdexcept>
+#include <algorithm>
 
 
 namespace LLGL
@@ -22,45 +24,22 @@ D3D12Buffer::D3D12Buffer(const BufferType type) :
 }
 
 void D3D12Buffer::UpdateStaticSubresource(
-    ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ComPtr<ID3D12Resource>& uploadBuffer,
+    ID3D12GraphicsCommandList* commandList, D3D12StagingBufferPool& stagingBufferPool,
     const void* data, UINT bufferSize, UINT64 offset, D3D12_RESOURCE_STATES uploadState)
 {
     if (offset + bufferSize > bufferSize_)
         throw std::out_of_range(LLGL_ASSERT_INFO("'bufferSize' and/or 'offset' are out of range"));
 
-    /* Create resource to upload memory from CPU to GPU */
-    CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
-    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
-
-    auto hr = device->CreateCommittedResource(
-        &uploadHeapProperties,
-        D3D12_HEAP_FLAG_NONE,
-        &bufferDesc,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(uploadBuffer.ReleaseAndGetAddressOf())
-    );
-
-    DXThrowIfFailed(hr, "failed to create D3D12 committed resource for upload buffer");
-
-    /* Copy data into upload buffer */
-    void* dest = nullptr;
-    
-    hr = uploadBuffer->Map(0, nullptr, &dest);
-    DXThrowIfFailed(hr, "failed to map D3D12 resource");
-    {
-        ::memcpy(dest, data, bufferSize);
-    }
-    uploadBuffer->Unmap(0, nullptr);
-
-    /* Upload memory to GPU */
-    commandList->CopyBufferRegion(resource_.Get(), 0, uploadBuffer.Get(), 0, bufferSize);
+    /* Copy data into staging memory and upload it to GPU */
+    stagingBufferPool.WriteBuffer(commandList, resource_.Get(), offset, data, bufferSize);
     
     auto resourceBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
         resource_.Get(), D3D12_RESOURCE_STATE_COPY_DEST, uploadState
     );
     
     commandList->ResourceBarrier(1, &resourceBarrier);
+
+    usageState_ = uploadState;
 }
 
 void D3D12Buffer::UpdateDynamicSubresource(const void* data, UINT bufferSize, UINT64 offset)
@@ -68,24 +47,82 @@ void D3D12Buffer::UpdateDynamicSubresource(const void* data, UINT bufferSize, UI
     void* dest = nullptr;
     
     auto hr = resource_->Map(0, nullptr, &dest);
-    DXThrowIfFailed(hr, "failed to map D3D12 resource");
+    if (DXReportIfFailed(hr, "failed to map D3D12 resource"))
+        return;
     {
         ::memcpy((reinterpret_cast<char*>(dest) + offset), data, bufferSize);
     }
     resource_->Unmap(0, nullptr);
 }
 
+void* D3D12Buffer::Map(UINT64 offset, UINT64 size, bool readAccess, bool writeAccess, bool flushExplicit)
+{
+    if (heapType_ != D3D12_HEAP_TYPE_UPLOAD && heapType_ != D3D12_HEAP_TYPE_READBACK)
+    {
+        ReportRuntimeError("cannot map D3D12 buffer that is neither in an upload heap nor in a readback heap");
+        return nullptr;
+    }
+    if (offset + size > bufferSize_)
+        throw std::out_of_range(LLGL_ASSERT_INFO("'size' and/or 'offset' are out of range"));
+
+    /* Only the mapped range is read by the CPU, and an empty range tells the driver the CPU does not read at all */
+    mappedRange_.Begin  = static_cast<SIZE_T>(offset);
+    mappedRange_.End    = static_cast<SIZE_T>(offset + size);
+    flushExplicit_      = flushExplicit;
+
+    if (writeAccess && !flushExplicit)
+        writtenRange_ = mappedRange_;
+    else
+        writtenRange_ = { 0, 0 };
+
+    const D3D12_RANGE emptyRange = { 0, 0 };
+
+    void* data = nullptr;
+    auto hr = resource_->Map(0, (readAccess ? &mappedRange_ : &emptyRange), &data);
+    if (DXReportIfFailed(hr, "failed to map D3D12 resource"))
+        return nullptr;
+
+    return (reinterpret_cast<char*>(data) + offset);
+}
+
+void D3D12Buffer::FlushMappedRange(UINT64 offset, UINT64 size)
+{
+    /* Accumulate flushed ranges, which are passed to the driver as written range when the buffer is unmapped */
+    auto begin  = mappedRange_.Begin + static_cast<SIZE_T>(offset);
+    auto end    = begin + static_cast<SIZE_T>(size);
+
+    if (writtenRange_.Begin == writtenRange_.End)
+    {
+        writtenRange_.Begin = begin;
+        writtenRange_.End   = end;
+    }
+    else
+    {
+        writtenRange_.Begin = std::min(writtenRange_.Begin, begin);
+        writtenRange_.End   = std::max(writtenRange_.End, end);
+    }
+}
+
+void D3D12Buffer::Unmap()
+{
+    resource_->Unmap(0, &writtenRange_);
+    mappedRange_    = { 0, 0 };
+    writtenRange_   = { 0, 0 };
+}
+
 
 /*
  * ======= Protected: =======
  */
 
-void D3D12Buffer::CreateResource(ID3D12Device* device, UINT bufferSize, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES resourceState)
+void D3D12Buffer::CreateResource(ID3D12Device* device, UINT bufferSize, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES resourceState, UINT visibleNodeMask)
 {
     bufferSize_ = bufferSize;
+    usageState_ = resourceState;
+    heapType_   = heapType;
 
-    /* Create generic buffer resource */
-    CD3DX12_HEAP_PROPERTIES heapProperties(heapType);
+    /* Create generic buffer resource on GPU node 0 */
+    CD3DX12_HEAP_PROPERTIES heapProperties(heapType, 1, visibleNodeMask);
     auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize_);
 
     auto hr = device->CreateCommittedResource(
@@ -100,9 +137,18 @@ void D3D12Buffer::CreateResource(ID3D12Device* device, UINT bufferSize, D3D12_HE
     DXThrowIfFailed(hr, "failed to create comitted resource for D3D12 hardware buffer");
 }
 
-void D3D12Buffer::CreateResource(ID3D12Device* device, UINT bufferSize)
+void D3D12Buffer::CreateResource(D3D12MemoryAllocator& memoryAllocator, UINT bufferSize)
 {
-    CreateResource(device, bufferSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_COPY_DEST);
+    bufferSize_ = bufferSize;
+    usageState_ = D3D12_RESOURCE_STATE_COPY_DEST;
+
+    /* Create buffer resource in the default heap (placed within a pooled heap block) */
+    resource_ = memoryAllocator.CreateResource(
+        CD3DX12_RESOURCE_DESC::Buffer(bufferSize_),
+        usageState_, // initial resource state
+        nullptr,
+        memoryRegion_
+    );
 }
 
 
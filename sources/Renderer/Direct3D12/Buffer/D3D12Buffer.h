@@ -10,6 +10,8 @@
 
 
 #include <LLGL/Buffer.h>
+#include "D3D12StagingBufferPool.h"
+#include "../D3D12MemoryAllocator.h"
 #include "../../DXCommon/ComPtr.h"
 #include <d3d12.h>
 
@@ -24,12 +26,16 @@ class D3D12Buffer : public Buffer
     public:
 
         void UpdateStaticSubresource(
-            ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ComPtr<ID3D12Resource>& uploadBuffer,
+            ID3D12GraphicsCommandList* commandList, D3D12StagingBufferPool& stagingBufferPool,
             const void* data, UINT bufferSize, UINT64 offset, D3D12_RESOURCE_STATES uploadState
         );
 
         void UpdateDynamicSubresource(const void* data, UINT bufferSize, UINT64 offset);
 
+        void* Map(UINT64 offset, UINT64 size, bool readAccess, bool writeAccess, bool flushExplicit);
+        void FlushMappedRange(UINT64 offset, UINT64 size);
+        void Unmap();
+
         //! Returns the ID3D12Resource object.
         inline ID3D12Resource* Get() const
         {
@@ -42,17 +48,36 @@ class D3D12Buffer : public Buffer
             return bufferSize_;
         }
 
+        //! Returns the resource state this buffer is in while it is used by the pipeline.
+        inline D3D12_RESOURCE_STATES GetUsageState() const
+        {
+            return usageState_;
+        }
+
+        // Returns the memory region this buffer has been placed in (no heap if it is a committed resource).
+        inline const D3D12MemoryRegion& GetMemoryRegion() const
+        {
+            return memoryRegion_;
+        }
+
     protected:
 
         D3D12Buffer(const BufferType type);
 
-        void CreateResource(ID3D12Device* device, UINT bufferSize, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES resourceState);
-        void CreateResource(ID3D12Device* device, UINT bufferSize);
+        void CreateResource(ID3D12Device* device, UINT bufferSize, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES resourceState, UINT visibleNodeMask = 1);
+        void CreateResource(D3D12MemoryAllocator& memoryAllocator, UINT bufferSize);
 
     private:
 
         ComPtr<ID3D12Resource>  resource_;
-        UINT                    bufferSize_ = 0;
+        UINT                    bufferSize_     = 0;
+        D3D12_RESOURCE_STATES   usageState_     = D3D12_RESOURCE_STATE_COMMON;
+        D3D12_HEAP_TYPE         heapType_       = D3D12_HEAP_TYPE_DEFAULT;
+        D3D12MemoryRegion       memoryRegion_;
+
+        D3D12_RANGE             mappedRange_    = { 0, 0 };
+        D3D12_RANGE             writtenRange_   = { 0, 0 };
+        bool                    flushExplicit_  = false;
 
 };
 
@@ -7,34 +7,103 @@
 
 #include "D3D12ConstantBuffer.h"
 #include "../../../Core/Helper.h"
+#include "../../Assertion.h"
 #include "../../DXCommon/DXCore.h"
+#include "../D3DX12/d3dx12.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
 
 
 namespace LLGL
 {
 
 
-D3D12ConstantBuffer::D3D12ConstantBuffer(ID3D12Device* device, const BufferDescriptor& desc) :
-    D3D12Buffer { BufferType::Constant }
+// Number of version slices of the first upload page of a dynamic constant buffer; each further page doubles this number
+static const std::size_t g_numInitialVersions = 4;
+
+D3D12ConstantBuffer::D3D12ConstantBuffer(ID3D12Device* device, const BufferDescriptor& desc, UINT visibleNodeMask) :
+    D3D12Buffer      { BufferType::Constant                             },
+    device_          { device                                           },
+    visibleNodeMask_ { visibleNodeMask                                  },
+    dynamic_         { ((desc.flags & BufferFlags::DynamicUsage) != 0)  }
 {
-    /* Create descriptor heap for constant buffer */
+    /* Create non-shader-visible descriptor heap for constant buffer (only used as source to copy descriptors) */
     D3D12_DESCRIPTOR_HEAP_DESC cbvHeapDesc;
     {
         cbvHeapDesc.Type            = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
         cbvHeapDesc.NumDescriptors  = 1;
-        cbvHeapDesc.Flags           = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        cbvHeapDesc.Flags           = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
         cbvHeapDesc.NodeMask        = 0;
     }
     auto hr = device->CreateDescriptorHeap(&cbvHeapDesc, IID_PPV_ARGS(descHeap_.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 descriptor heap for constant-buffer-view (CBV)");
 
     /* Create resource and put view */
-    CreateResourceAndPutView(device, desc.size);
+    CreateResourceAndPutView(device, desc.size, visibleNodeMask);
+
+    if (dynamic_)
+        shadowData_.resize(GetBufferSize(), 0);
+}
+
+void D3D12ConstantBuffer::UpdateSubresource(const void* data, UINT bufferSize, UINT64 offset, UINT64 nextFenceValue, UINT64 completedFenceValue)
+{
+    if (!dynamic_)
+    {
+        UpdateDynamicSubresource(data, bufferSize, offset);
+        return;
+    }
+
+    if (offset + bufferSize > GetBufferSize())
+        throw std::out_of_range(LLGL_ASSERT_INFO("'bufferSize' and/or 'offset' are out of range"));
+
+    /* Recycle all slices the GPU is done with */
+    while (!pendingVersions_.empty() && pendingVersions_.front().fenceValue <= completedFenceValue)
+    {
+        freeVersions_.push_back(pendingVersions_.front());
+        pendingVersions_.pop_front();
+    }
+
+    if (freeVersions_.empty() && !CreateVersionPage())
+        return;
+
+    auto version = freeVersions_.back();
+    freeVersions_.pop_back();
+
+    /* Write entire contents into the new slice, so partial updates keep the remaining contents of the previous version */
+    ::memcpy(shadowData_.data() + offset, data, bufferSize);
+    ::memcpy(version.cpuAddress, shadowData_.data(), shadowData_.size());
+
+    SetCurrentVersion(version, nextFenceValue);
+}
+
+void D3D12ConstantBuffer::RestoreBaseVersion(UINT64 nextFenceValue)
+{
+    if (dynamic_ && current_.cpuAddress != nullptr)
+    {
+        UpdateDynamicSubresource(shadowData_.data(), static_cast<UINT>(shadowData_.size()), 0);
+
+        D3D12ConstantBufferVersion baseVersion;
+        baseVersion.gpuAddress = Get()->GetGPUVirtualAddress();
+        SetCurrentVersion(baseVersion, nextFenceValue);
+    }
 }
 
-void D3D12ConstantBuffer::UpdateSubresource(const void* data, UINT bufferSize, UINT64 offset)
+void D3D12ConstantBuffer::SyncWithBaseVersion()
 {
-    UpdateDynamicSubresource(data, bufferSize, offset);
+    if (dynamic_)
+    {
+        void* data = nullptr;
+
+        auto hr = Get()->Map(0, nullptr, &data);
+        if (DXReportIfFailed(hr, "failed to map D3D12 resource"))
+            return;
+        {
+            ::memcpy(shadowData_.data(), data, shadowData_.size());
+        }
+        const D3D12_RANGE emptyRange = { 0, 0 };
+        Get()->Unmap(0, &emptyRange);
+    }
 }
 
 
@@ -42,22 +111,86 @@ void D3D12ConstantBuffer::UpdateSubresource(const void* data, UINT bufferSize, U
  * ======= Private: =======
  */
 
-void D3D12ConstantBuffer::CreateResourceAndPutView(ID3D12Device* device, UINT bufferSize)
+void D3D12ConstantBuffer::CreateResourceAndPutView(ID3D12Device* device, UINT bufferSize, UINT visibleNodeMask)
 {
     /* Constant buffers are required to be 256-byte aligned */
     static const UINT alignment = 255;
     bufferSize = (bufferSize + alignment) & ~alignment;
 
     /* Create hardware resource */
-    CreateResource(device, bufferSize, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+    CreateResource(device, bufferSize, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ, visibleNodeMask);
+
+    /* Create constant buffer view (CBV) for the base resource */
+    current_.gpuAddress = Get()->GetGPUVirtualAddress();
+    PutView(current_.gpuAddress);
+}
+
+bool D3D12ConstantBuffer::CreateVersionPage()
+{
+    /* Create persistently mapped upload resource, which is twice as large as the previous page */
+    const auto numVersions  = (g_numInitialVersions << versionPages_.size());
+    const auto sliceSize    = static_cast<UINT64>(GetBufferSize());
+
+    CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD, 1, visibleNodeMask_);
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(sliceSize * numVersions);
+
+    ComPtr<ID3D12Resource> page;
+    auto hr = device_->CreateCommittedResource(
+        &heapProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(page.ReleaseAndGetAddressOf())
+    );
+    if (DXReportIfFailed(hr, "failed to create D3D12 upload resource for versions of dynamic constant buffer"))
+        return false;
+
+    const D3D12_RANGE emptyRange = { 0, 0 };
+    void* cpuAddress = nullptr;
+    hr = page->Map(0, &emptyRange, &cpuAddress);
+    if (DXReportIfFailed(hr, "failed to map D3D12 upload resource for versions of dynamic constant buffer"))
+        return false;
+
+    /* Add all slices of the new page to the free versions */
+    for (std::size_t i = 0; i < numVersions; ++i)
+    {
+        D3D12ConstantBufferVersion version;
+        {
+            version.gpuAddress  = page->GetGPUVirtualAddress() + sliceSize * i;
+            version.cpuAddress  = reinterpret_cast<char*>(cpuAddress) + sliceSize * i;
+        }
+        freeVersions_.push_back(version);
+    }
+
+    versionPages_.push_back(std::move(page));
 
-    /* Create constant buffer view (CBV) */
+    return true;
+}
+
+void D3D12ConstantBuffer::SetCurrentVersion(const D3D12ConstantBufferVersion& version, UINT64 nextFenceValue)
+{
+    /* Replaced slice might still be read by command lists up to the next fence value; the base resource is never recycled */
+    if (current_.cpuAddress != nullptr)
+    {
+        current_.fenceValue = nextFenceValue;
+        pendingVersions_.push_back(current_);
+    }
+
+    current_ = version;
+    ++version_;
+
+    PutView(current_.gpuAddress);
+}
+
+void D3D12ConstantBuffer::PutView(D3D12_GPU_VIRTUAL_ADDRESS gpuAddress)
+{
     D3D12_CONSTANT_BUFFER_VIEW_DESC viewDesc;
     {
-        viewDesc.BufferLocation = Get()->GetGPUVirtualAddress();
-        viewDesc.SizeInBytes    = bufferSize;
+        viewDesc.BufferLocation = gpuAddress;
+        viewDesc.SizeInBytes    = GetBufferSize();
     }
-    device->CreateConstantBufferView(&viewDesc, descHeap_->GetCPUDescriptorHandleForHeapStart());
+    device_->CreateConstantBufferView(&viewDesc, descHeap_->GetCPUDescriptorHandleForHeapStart());
 }
 
 
@@ -10,31 +10,86 @@
 
 
 #include "D3D12Buffer.h"
+#include <vector>
+#include <deque>
 
 
 namespace LLGL
 {
 
 
+/*
+Constant buffer in an upload heap. Constant buffers with BufferFlags::DynamicUsage are versioned:
+each update writes the entire buffer into a new slice of upload memory and re-points the CBV and the GPU virtual address to that slice,
+so command lists that have been recorded or submitted before the update keep reading the previous contents.
+Replaced slices are tagged with the next fence value of the render system and recycled once the GPU has crossed it.
+*/
 class D3D12ConstantBuffer : public D3D12Buffer
 {
 
     public:
 
-        D3D12ConstantBuffer(ID3D12Device* device, const BufferDescriptor& desc);
+        D3D12ConstantBuffer(ID3D12Device* device, const BufferDescriptor& desc, UINT visibleNodeMask = 1);
+
+        // Writes the data into the buffer; dynamic buffers allocate a new version (see class description), all others write into the same memory.
+        void UpdateSubresource(const void* data, UINT bufferSize, UINT64 offset = 0, UINT64 nextFenceValue = 0, UINT64 completedFenceValue = 0);
 
-        void UpdateSubresource(const void* data, UINT bufferSize, UINT64 offset = 0);
+        // Re-points a dynamic buffer to its base resource with the current contents, since "Map" always refers to the base resource.
+        void RestoreBaseVersion(UINT64 nextFenceValue);
 
-        inline ID3D12DescriptorHeap* GetDescriptorHeap() const
+        // Reads back the contents of the base resource after it has been written by "Map", so the next update of a dynamic buffer keeps them.
+        void SyncWithBaseVersion();
+
+        // Returns the upload resources of all versions, which must be released deferred together with the base resource.
+        inline const std::vector<ComPtr<ID3D12Resource>>& GetVersionPages() const
         {
-            return descHeap_.Get();
+            return versionPages_;
         }
 
-    private:
+        // Returns the CPU descriptor handle of the constant-buffer-view (CBV), which is copied into the shader-visible descriptor heap of a command buffer.
+        inline D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandle() const
+        {
+            return descHeap_->GetCPUDescriptorHandleForHeapStart();
+        }
+
+        // Returns the GPU virtual address of the current version.
+        inline D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const
+        {
+            return current_.gpuAddress;
+        }
 
-        void CreateResourceAndPutView(ID3D12Device* device, UINT bufferSize);
+        // Returns the version counter, which is incremented whenever the GPU virtual address of the buffer changes.
+        inline UINT64 GetVersion() const
+        {
+            return version_;
+        }
 
-        ComPtr<ID3D12DescriptorHeap> descHeap_; // descriptor heap for constant buffer views (CBV)
+    private:
+
+        // Slice of upload memory with one version of the buffer contents.
+        struct D3D12ConstantBufferVersion
+        {
+            D3D12_GPU_VIRTUAL_ADDRESS   gpuAddress  = 0;
+            char*                       cpuAddress  = nullptr;  // null for the base resource, which is only mapped on demand
+            UINT64                      fenceValue  = 0;        // fence value after which the slice can be reused
+        };
+
+        void CreateResourceAndPutView(ID3D12Device* device, UINT bufferSize, UINT visibleNodeMask);
+        bool CreateVersionPage();
+        void SetCurrentVersion(const D3D12ConstantBufferVersion& version, UINT64 nextFenceValue);
+        void PutView(D3D12_GPU_VIRTUAL_ADDRESS gpuAddress);
+
+        ID3D12Device*                           device_             = nullptr;
+        UINT                                    visibleNodeMask_    = 1;
+        ComPtr<ID3D12DescriptorHeap>            descHeap_;          // non-shader-visible descriptor heap for constant buffer views (CBV)
+
+        bool                                    dynamic_            = false;
+        UINT64                                  version_            = 0;
+        D3D12ConstantBufferVersion              current_;
+        std::vector<char>                       shadowData_;        // CPU copy of the contents, since partial updates must not read back upload memory
+        std::vector<ComPtr<ID3D12Resource>>     versionPages_;      // persistently mapped upload resources with several slices each
+        std::deque<D3D12ConstantBufferVersion>  pendingVersions_;   // replaced slices, ordered by their fence values
+        std::vector<D3D12ConstantBufferVersion> freeVersions_;
 
 };
 
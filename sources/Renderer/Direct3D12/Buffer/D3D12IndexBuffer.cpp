@@ -14,11 +14,11 @@ namespace LLGL
 {
 
 
-D3D12IndexBuffer::D3D12IndexBuffer(ID3D12Device* device, const BufferDescriptor& desc) :
+D3D12IndexBuffer::D3D12IndexBuffer(D3D12MemoryAllocator& memoryAllocator, const BufferDescriptor& desc) :
     D3D12Buffer { BufferType::Index }
 {
     /* Create resource and initialize buffer view */
-    CreateResource(device, desc.size);
+    CreateResource(memoryAllocator, desc.size);
 
     view_.BufferLocation    = Get()->GetGPUVirtualAddress();
     view_.SizeInBytes       = GetBufferSize();
@@ -26,11 +26,11 @@ D3D12IndexBuffer::D3D12IndexBuffer(ID3D12Device* device, const BufferDescriptor&
 }
 
 void D3D12IndexBuffer::UpdateSubresource(
-    ID3D12Device* device, ID3D12GraphicsCommandList* gfxCommandList, ComPtr<ID3D12Resource>& bufferUpload,
+    ID3D12GraphicsCommandList* gfxCommandList, D3D12StagingBufferPool& stagingBufferPool,
     const void* data, UINT bufferSize, UINT64 offset)
 {
     UpdateStaticSubresource(
-        device, gfxCommandList, bufferUpload,
+        gfxCommandList, stagingBufferPool,
         data, bufferSize, offset,
         D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE
     );
@@ -21,10 +21,10 @@ class D3D12IndexBuffer : public D3D12Buffer
 
     public:
 
-        D3D12IndexBuffer(ID3D12Device* device, const BufferDescriptor& desc);
+        D3D12IndexBuffer(D3D12MemoryAllocator& memoryAllocator, const BufferDescriptor& desc);
 
         void UpdateSubresource(
-            ID3D12Device* device, ID3D12GraphicsCommandList* gfxCommandList, ComPtr<ID3D12Resource>& bufferUpload,
+            ID3D12GraphicsCommandList* gfxCommandList, D3D12StagingBufferPool& stagingBufferPool,
             const void* data, UINT bufferSize, UINT64 offset = 0
         );
 
@@ -0,0 +1,142 @@
+/*
+ * D3D12StagingBufferPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12StagingBufferPool.h"
+#include "../../DXCommon/DXCore.h"
+#include "../D3DX12/d3dx12.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+static UINT64 AlignOffset(UINT64 offset, UINT64 alignment)
+{
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+D3D12StagingBufferPool::D3D12StagingBufferPool(ID3D12Device* device, UINT64 pageSize) :
+    device_   { device   },
+    pageSize_ { pageSize }
+{
+}
+
+D3D12StagingRange D3D12StagingBufferPool::Allocate(UINT64 size, UINT64 alignment)
+{
+    /* Find page with enough space left, either the current page or the next free page */
+    D3D12StagingPage* page = nullptr;
+
+    if (!activePages_.empty())
+    {
+        auto& currentPage = activePages_.back();
+        if (currentPage.size == pageSize_ && AlignOffset(currentPage.offset, alignment) + size <= currentPage.size)
+            page = &currentPage;
+    }
+
+    if (!page)
+        page = &AcquirePage(size);
+
+    /* Suballocate range from page */
+    auto offset = AlignOffset(page->offset, alignment);
+    page->offset = offset + size;
+
+    return { page->resource.Get(), offset, page->cpuAddress + offset };
+}
+
+void D3D12StagingBufferPool::WriteBuffer(
+    ID3D12GraphicsCommandList* commandList, ID3D12Resource* dstBuffer, UINT64 dstOffset,
+    const void* data, UINT64 dataSize)
+{
+    auto range = Allocate(dataSize);
+    ::memcpy(range.cpuAddress, data, static_cast<std::size_t>(dataSize));
+    commandList->CopyBufferRegion(dstBuffer, dstOffset, range.resource, range.offset, dataSize);
+}
+
+void D3D12StagingBufferPool::Submit(UINT64 fenceValue)
+{
+    for (auto& page : activePages_)
+    {
+        page.fenceValue = fenceValue;
+        pendingPages_.push_back(std::move(page));
+    }
+    activePages_.clear();
+}
+
+void D3D12StagingBufferPool::Reclaim(UINT64 completedFenceValue)
+{
+    while (!pendingPages_.empty() && pendingPages_.front().fenceValue <= completedFenceValue)
+    {
+        /* Recycle regular pages and release dedicated pages */
+        auto& page = pendingPages_.front();
+        if (page.size == pageSize_)
+        {
+            page.offset = 0;
+            freePages_.push_back(std::move(page));
+        }
+        pendingPages_.pop_front();
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+D3D12StagingBufferPool::D3D12StagingPage D3D12StagingBufferPool::CreatePage(UINT64 size)
+{
+    D3D12StagingPage page;
+
+    /* Create upload resource for the page */
+    CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+    auto hr = device_->CreateCommittedResource(
+        &uploadHeapProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(page.resource.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 committed resource for staging buffer page");
+
+    /* Map page persistently (upload heaps can stay mapped while the GPU reads from them) */
+    CD3DX12_RANGE readRange(0, 0);
+    hr = page.resource->Map(0, &readRange, reinterpret_cast<void**>(&page.cpuAddress));
+    DXThrowIfFailed(hr, "failed to map D3D12 staging buffer page");
+
+    page.size = size;
+
+    return page;
+}
+
+D3D12StagingBufferPool::D3D12StagingPage& D3D12StagingBufferPool::AcquirePage(UINT64 size)
+{
+    if (size > pageSize_)
+    {
+        /* Create dedicated page for large allocations */
+        activePages_.push_back(CreatePage(size));
+    }
+    else if (!freePages_.empty())
+    {
+        /* Reuse page the GPU has finished with */
+        activePages_.push_back(std::move(freePages_.back()));
+        freePages_.pop_back();
+    }
+    else
+        activePages_.push_back(CreatePage(pageSize_));
+
+    return activePages_.back();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,93 @@
+/*
+ * D3D12StagingBufferPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_STAGING_BUFFER_POOL_H
+#define LLGL_D3D12_STAGING_BUFFER_POOL_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <vector>
+#include <deque>
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+// Range of upload memory within a staging page.
+struct D3D12StagingRange
+{
+    ID3D12Resource* resource;   // Upload resource of the staging page.
+    UINT64          offset;     // Offset (in bytes) of the range within the upload resource.
+    char*           cpuAddress; // Persistently mapped CPU address of the range.
+};
+
+/*
+Linear allocator for upload memory that is used to copy data from the CPU to GPU resources.
+Ranges are suballocated from large, persistently mapped upload pages instead of creating one committed resource per upload.
+All pages that have been used since the previous call to "Submit" are tagged with its fence value,
+and they are recycled by "Reclaim" once the GPU has crossed that fence value.
+Allocations larger than the page size get a dedicated page that is released after the GPU is done with it.
+*/
+class D3D12StagingBufferPool
+{
+
+    public:
+
+        D3D12StagingBufferPool(ID3D12Device* device, UINT64 pageSize);
+
+        D3D12StagingBufferPool(const D3D12StagingBufferPool&) = delete;
+        D3D12StagingBufferPool& operator = (const D3D12StagingBufferPool&) = delete;
+
+        // Allocates a range of upload memory. The range must not be written after the command list that reads from it has been submitted.
+        D3D12StagingRange Allocate(UINT64 size, UINT64 alignment = 1);
+
+        // Copies the data into a staging range and records a copy command from that range into the destination buffer.
+        void WriteBuffer(
+            ID3D12GraphicsCommandList* commandList, ID3D12Resource* dstBuffer, UINT64 dstOffset,
+            const void* data, UINT64 dataSize
+        );
+
+        // Tags all pages that have been used since the previous call with the specified fence value.
+        void Submit(UINT64 fenceValue);
+
+        // Recycles all pages whose fence value has been completed by the GPU.
+        void Reclaim(UINT64 completedFenceValue);
+
+    private:
+
+        struct D3D12StagingPage
+        {
+            ComPtr<ID3D12Resource>  resource;
+            char*                   cpuAddress  = nullptr;
+            UINT64                  size        = 0;
+            UINT64                  offset      = 0;
+            UINT64                  fenceValue  = 0;
+        };
+
+        D3D12StagingPage CreatePage(UINT64 size);
+        D3D12StagingPage& AcquirePage(UINT64 size);
+
+        ID3D12Device*                   device_     = nullptr;
+        UINT64                          pageSize_   = 0;
+
+        std::vector<D3D12StagingPage>   activePages_;   // Pages used since the previous submit; the last one is the current page.
+        std::deque<D3D12StagingPage>    pendingPages_;  // Pages in flight, ordered by their fence values.
+        std::vector<D3D12StagingPage>   freePages_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
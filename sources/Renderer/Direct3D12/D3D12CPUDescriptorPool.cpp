@@ -0,0 +1,80 @@
+/*
+ * D3D12CPUDescriptorPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12CPUDescriptorPool.h"
+#include "../DXCommon/DXCore.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+D3D12CPUDescriptorPool::D3D12CPUDescriptorPool(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT numDescriptorsPerHeap) :
+    device_                 { device                                                },
+    type_                   { type                                                  },
+    descSize_               { device->GetDescriptorHandleIncrementSize(type)        },
+    numDescriptorsPerHeap_  { (std::max)(1u, numDescriptorsPerHeap)                 }
+{
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12CPUDescriptorPool::Allocate()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    if (freeDescHandles_.empty())
+        AllocHeap();
+
+    auto descHandle = freeDescHandles_.back();
+    freeDescHandles_.pop_back();
+
+    return descHandle;
+}
+
+void D3D12CPUDescriptorPool::Free(D3D12_CPU_DESCRIPTOR_HANDLE descHandle)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    freeDescHandles_.push_back(descHandle);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12CPUDescriptorPool::AllocHeap()
+{
+    /* Create non-shader-visible descriptor heap */
+    ComPtr<ID3D12DescriptorHeap> heap;
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
+    {
+        heapDesc.Type           = type_;
+        heapDesc.NumDescriptors = numDescriptorsPerHeap_;
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        heapDesc.NodeMask       = 0;
+    }
+    auto hr = device_->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(heap.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 descriptor heap for descriptor pool");
+
+    /* Add all descriptors in reverse order, so they are allocated from the start of the heap */
+    const auto heapStart = heap->GetCPUDescriptorHandleForHeapStart();
+    for (auto i = numDescriptorsPerHeap_; i > 0; --i)
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE descHandle;
+        descHandle.ptr = heapStart.ptr + static_cast<SIZE_T>(i - 1) * descSize_;
+        freeDescHandles_.push_back(descHandle);
+    }
+
+    heaps_.push_back(heap);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,67 @@
+/*
+ * D3D12CPUDescriptorPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_CPU_DESCRIPTOR_POOL_H
+#define LLGL_D3D12_CPU_DESCRIPTOR_POOL_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Pool of single descriptors in non-shader-visible descriptor heaps, e.g. for render-target-views (RTV) and depth-stencil-views (DSV).
+The descriptors are taken from heaps of a fixed size, which are only created when all previous heaps are in use,
+so render targets do not create a descriptor heap of their own. Freed descriptors are reused by subsequent allocations.
+RTV and DSV descriptors are read when "OMSetRenderTargets" is recorded, so they can be freed while the GPU is still using the views.
+*/
+class D3D12CPUDescriptorPool
+{
+
+    public:
+
+        D3D12CPUDescriptorPool(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT numDescriptorsPerHeap = 256);
+
+        D3D12CPUDescriptorPool(const D3D12CPUDescriptorPool&) = delete;
+        D3D12CPUDescriptorPool& operator = (const D3D12CPUDescriptorPool&) = delete;
+
+        // Allocates a single descriptor and returns its CPU handle. This function is thread-safe.
+        D3D12_CPU_DESCRIPTOR_HANDLE Allocate();
+
+        // Returns the specified descriptor to the pool. This function is thread-safe.
+        void Free(D3D12_CPU_DESCRIPTOR_HANDLE descHandle);
+
+    private:
+
+        void AllocHeap();
+
+        ID3D12Device*                               device_                 = nullptr;
+        D3D12_DESCRIPTOR_HEAP_TYPE                  type_                   = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+        UINT                                        descSize_               = 0;
+        UINT                                        numDescriptorsPerHeap_  = 0;
+
+        std::vector<ComPtr<ID3D12DescriptorHeap>>   heaps_;
+        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>    freeDescHandles_;
+        std::mutex                                  mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
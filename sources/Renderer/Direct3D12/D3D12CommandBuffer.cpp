@@ -10,8 +10,11 @@
 #include "D3D12RenderSystem.h"
 #include "D3D12Types.h"
 #include "../CheckedCast.h"
+#include <LLGL/Image.h>
 #include "../../Core/Helper.h"
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 #include "D3DX12/d3dx12.h"
 
 #include "Buffer/D3D12VertexBuffer.h"
@@ -21,14 +24,39 @@
 #include "Buffer/D3D12StorageBuffer.h"
 
 #include "Texture/D3D12Texture.h"
+#include "Texture/D3D12RenderTarget.h"
+
+#include "RenderState/D3D12ResourceHeap.h"
+#include "RenderState/D3D12ComputePipeline.h"
+#include "RenderState/D3D12Fence.h"
+#include "RenderState/D3D12Query.h"
+#include "RenderState/D3D12QueryArray.h"
 
 
 namespace LLGL
 {
 
 
-D3D12CommandBuffer::D3D12CommandBuffer(D3D12RenderSystem& renderSystem)
+// Number of descriptors in the shader-visible heaps for each frame in flight
+static const UINT g_numCbvSrvUavDescriptorsPerFrame = 4096;
+static const UINT g_numSamplerDescriptorsPerFrame   = 256;
+
+D3D12CommandBuffer::D3D12CommandBuffer(D3D12RenderSystem& renderSystem, const CommandBufferDescriptor& desc) :
+    renderSystem_ { renderSystem                                             },
+    deferred_     { ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0) },
+    asyncCompute_ { ((desc.flags & CommandBufferFlags::AsyncCompute) != 0)   },
+    bundle_       { ((desc.flags & CommandBufferFlags::Bundle) != 0)         },
+    nodeIndex_    { desc.nodeIndex                                           }
 {
+    if (asyncCompute_ && !deferred_)
+        throw std::invalid_argument("D3D12 command buffer with 'CommandBufferFlags::AsyncCompute' requires 'CommandBufferFlags::DeferredSubmit'");
+    if (bundle_ && (!deferred_ || asyncCompute_))
+        throw std::invalid_argument("D3D12 command buffer with 'CommandBufferFlags::Bundle' requires 'CommandBufferFlags::DeferredSubmit' without 'CommandBufferFlags::AsyncCompute'");
+    if (nodeIndex_ >= renderSystem.GetNumNodes())
+        throw std::out_of_range("D3D12 command buffer node index exceeds the number of GPU nodes");
+    if (nodeIndex_ > 0 && (!deferred_ || asyncCompute_))
+        throw std::invalid_argument("D3D12 command buffer for GPU node other than 0 requires 'CommandBufferFlags::DeferredSubmit' without 'CommandBufferFlags::AsyncCompute'");
+
     CreateDevices(renderSystem);
     //InitStateManager();
 }
@@ -42,26 +70,64 @@ void D3D12CommandBuffer::SetGraphicsAPIDependentState(const GraphicsAPIDependent
 
 void D3D12CommandBuffer::SetViewport(const Viewport& viewport)
 {
+    AssertNotBundle("SetViewport");
     stateMngr_.SetViewports(1, &viewport);
-    stateMngr_.SubmitViewports(commandList_.Get());
 }
 
 void D3D12CommandBuffer::SetViewportArray(unsigned int numViewports, const Viewport* viewportArray)
 {
+    AssertNotBundle("SetViewportArray");
     stateMngr_.SetViewports(numViewports, viewportArray);
-    stateMngr_.SubmitViewports(commandList_.Get());
 }
 
 void D3D12CommandBuffer::SetScissor(const Scissor& scissor)
 {
+    AssertNotBundle("SetScissor");
     stateMngr_.SetScissors(1, &scissor);
-    stateMngr_.SubmitScissors(commandList_.Get());
 }
 
 void D3D12CommandBuffer::SetScissorArray(unsigned int numScissors, const Scissor* scissorArray)
 {
+    AssertNotBundle("SetScissorArray");
     stateMngr_.SetScissors(numScissors, scissorArray);
-    stateMngr_.SubmitScissors(commandList_.Get());
+}
+
+void D3D12CommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    AssertNotBundle("SetShadingRate");
+    if (commandList5_)
+    {
+        shadingRate_ = static_cast<D3D12_SHADING_RATE>(rate);
+        SubmitShadingRate();
+    }
+}
+
+void D3D12CommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    AssertNotBundle("SetShadingRateImage");
+    if (!hasShadingRateImage_)
+        return;
+
+    auto resource = (texture != nullptr ? LLGL_CAST(D3D12Texture*, texture)->Get() : nullptr);
+    if (shadingRateImage_ != resource)
+    {
+        /* Textures are in the shader resource state outside of their use as shading rate image */
+        if (shadingRateImage_)
+            barrierBatch_.Transition(shadingRateImage_, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        shadingRateImage_ = resource;
+        SubmitShadingRateImage();
+    }
+}
+
+void D3D12CommandBuffer::SetDepthBounds(float minDepth, float maxDepth)
+{
+    AssertNotBundle("SetDepthBounds");
+    if (commandList1_)
+    {
+        depthBounds_[0] = minDepth;
+        depthBounds_[1] = maxDepth;
+        commandList1_->OMSetDepthBounds(minDepth, maxDepth);
+    }
 }
 
 void D3D12CommandBuffer::SetClearColor(const ColorRGBAf& color)
@@ -81,65 +147,108 @@ void D3D12CommandBuffer::SetClearStencil(int stencil)
 
 void D3D12CommandBuffer::Clear(long flags)
 {
-    /* Clear color buffer */
+    AssertNotBundle("Clear");
+    barrierBatch_.Flush(commandList_.Get());
+
+    /* Clear color buffers */
     if ((flags & ClearFlags::Color) != 0)
-        commandList_->ClearRenderTargetView(rtvDescHandle_, clearState_.color.Ptr(), 0, nullptr);
-    
-    /* Clear depth-stencil buffer */
+    {
+        if (boundRenderTarget_)
+        {
+            for (const auto& rtvDescHandle : boundRenderTarget_->GetRTVDescHandles())
+                commandList_->ClearRenderTargetView(rtvDescHandle, clearState_.color.Ptr(), 0, nullptr);
+        }
+        else
+            commandList_->ClearRenderTargetView(rtvDescHandle_, clearState_.color.Ptr(), 0, nullptr);
+    }
+
+    /* Clear depth-stencil buffer (the back buffer of a render context has no DSV) */
     int dsvClearFlags = 0;
 
     if ((flags & ClearFlags::Depth) != 0)
         dsvClearFlags |= D3D12_CLEAR_FLAG_DEPTH;
     if ((flags & ClearFlags::Stencil) != 0)
         dsvClearFlags |= D3D12_CLEAR_FLAG_STENCIL;
-        
-    if (dsvClearFlags)
+
+    if (dsvClearFlags && boundRenderTarget_)
     {
-        commandList_->ClearDepthStencilView(
-            rtvDescHandle_, static_cast<D3D12_CLEAR_FLAGS>(dsvClearFlags), clearState_.depth, clearState_.stencil, 0, nullptr
-        );
+        if (auto dsvDescHandle = boundRenderTarget_->GetDSVDescHandle())
+        {
+            commandList_->ClearDepthStencilView(
+                *dsvDescHandle, static_cast<D3D12_CLEAR_FLAGS>(dsvClearFlags), clearState_.depth, clearState_.stencil, 0, nullptr
+            );
+        }
     }
 }
 
 void D3D12CommandBuffer::ClearTarget(unsigned int targetIndex, const LLGL::ColorRGBAf& color)
 {
-    //TODO...
-    //CD3DX12_CPU_DESCRIPTOR_HANDLE rtvHandle(rtvDescHandle_, targetIndex, rtvDescHandleSize_);
-    //commandList_->ClearRenderTargetView(rtvDescHandle_, clearState_.color.Ptr(), 0, nullptr);
+    AssertNotBundle("ClearTarget");
+    barrierBatch_.Flush(commandList_.Get());
+
+    if (boundRenderTarget_)
+    {
+        const auto& rtvDescHandles = boundRenderTarget_->GetRTVDescHandles();
+        if (targetIndex < rtvDescHandles.size())
+            commandList_->ClearRenderTargetView(rtvDescHandles[targetIndex], color.Ptr(), 0, nullptr);
+    }
+    else if (targetIndex == 0)
+        commandList_->ClearRenderTargetView(rtvDescHandle_, color.Ptr(), 0, nullptr);
 }
 
 /* ----- Buffers ------ */
 
-void D3D12CommandBuffer::SetVertexBuffer(Buffer& buffer)
+void D3D12CommandBuffer::SetVertexBuffer(Buffer& buffer, unsigned int offset)
 {
     auto& vertexBufferD3D = LLGL_CAST(D3D12VertexBuffer&, buffer);
-    commandList_->IASetVertexBuffers(0, 1, &(vertexBufferD3D.GetView()));
+
+    /* Move start of the view to the suballocated range */
+    auto view = vertexBufferD3D.GetView();
+    view.BufferLocation += offset;
+    view.SizeInBytes    -= offset;
+
+    stateMngr_.SetVertexBuffers(0, 1, &view);
 }
 
 void D3D12CommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
     auto& vertexBufferArrayD3D = LLGL_CAST(D3D12VertexBufferArray&, bufferArray);
-    commandList_->IASetVertexBuffers(
+    stateMngr_.SetVertexBuffers(
         0,
         static_cast<UINT>(vertexBufferArrayD3D.GetViews().size()),
         vertexBufferArrayD3D.GetViews().data()
     );
 }
 
-void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer)
+void D3D12CommandBuffer::SetIndexBuffer(Buffer& buffer, unsigned int offset)
 {
     auto& indexBufferD3D = LLGL_CAST(D3D12IndexBuffer&, buffer);
-    commandList_->IASetIndexBuffer(&(indexBufferD3D.GetView()));
+
+    /* Move start of the view to the suballocated range */
+    auto view = indexBufferD3D.GetView();
+    view.BufferLocation += offset;
+    view.SizeInBytes    -= offset;
+
+    stateMngr_.SetIndexBuffer(view);
 }
 
 void D3D12CommandBuffer::SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
 {
     auto& constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer&, buffer);
 
-    /* Set CBV descriptor heap */
-    ID3D12DescriptorHeap* descHeaps[1] = { constantBufferD3D.GetDescriptorHeap() };
-    commandList_->SetDescriptorHeaps(1, descHeaps);
-    commandList_->SetGraphicsRootDescriptorTable(0, descHeaps[0]->GetGPUDescriptorHandleForHeapStart());
+    /* Store CBV descriptor and address; it is copied into the descriptor table or bound as root CBV with the next draw command */
+    if (slot < maxNumCBVSlots)
+    {
+        cbvDescHandles_[slot]               = constantBufferD3D.GetCPUDescriptorHandle();
+        cbvRangeDescs_[slot].SizeInBytes    = 0;
+        cbvAddresses_[slot]                 = constantBufferD3D.GetGPUVirtualAddress();
+        cbvBuffers_[slot]                   = &constantBufferD3D;
+        cbvVersions_[slot]                  = constantBufferD3D.GetVersion();
+        if (slot < numRootCBV_)
+            rootCBVsDirty_ = true;
+        else
+            descTableDirty_ = true;
+    }
 }
 
 void D3D12CommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags)
@@ -147,6 +256,25 @@ void D3D12CommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsign
     //todo...
 }
 
+void D3D12CommandBuffer::SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags)
+{
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+
+    /* Store CBV for the buffer range; it is created inside the descriptor table with the next draw command */
+    if (slot < maxNumCBVSlots)
+    {
+        cbvDescHandles_[slot].ptr               = 0;
+        cbvRangeDescs_[slot].BufferLocation     = bufferD3D.Get()->GetGPUVirtualAddress() + offset;
+        cbvRangeDescs_[slot].SizeInBytes        = ((size + 255u) & ~255u);
+        cbvAddresses_[slot]                     = cbvRangeDescs_[slot].BufferLocation;
+        cbvBuffers_[slot]                       = nullptr;
+        if (slot < numRootCBV_)
+            rootCBVsDirty_ = true;
+        else
+            descTableDirty_ = true;
+    }
+}
+
 void D3D12CommandBuffer::SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags)
 {
     //todo...
@@ -157,6 +285,16 @@ void D3D12CommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigne
     //todo...
 }
 
+void D3D12CommandBuffer::ResetBufferCounter(Buffer& buffer, unsigned int value)
+{
+    //todo...
+}
+
+void D3D12CommandBuffer::CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer)
+{
+    //todo...
+}
+
 void D3D12CommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
     //todo...
@@ -177,16 +315,28 @@ void D3D12CommandBuffer::EndStreamOutput()
     // dummy
 }
 
+void D3D12CommandBuffer::PauseStreamOutput()
+{
+    //todo...
+}
+
+void D3D12CommandBuffer::ResumeStreamOutput()
+{
+    //todo...
+}
+
 /* ----- Textures ----- */
 
 void D3D12CommandBuffer::SetTexture(Texture& texture, unsigned int slot, long shaderStageFlags)
 {
     auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
 
-    /* Set SRV descriptor heap */
-    ID3D12DescriptorHeap* descHeaps[1] = { textureD3D.GetDescriptorHeap() };
-    commandList_->SetDescriptorHeaps(1, descHeaps);
-    commandList_->SetGraphicsRootDescriptorTable(0, descHeaps[0]->GetGPUDescriptorHandleForHeapStart());
+    /* Store SRV descriptor; it is copied into the descriptor table with the next draw command */
+    if (slot < maxNumSRVSlots)
+    {
+        srvDescHandles_[slot] = textureD3D.GetCPUDescriptorHandle();
+        descTableDirty_ = true;
+    }
 }
 
 void D3D12CommandBuffer::SetTextureArray(TextureArray& textureArray, unsigned int startSlot, long shaderStageFlags)
@@ -206,53 +356,484 @@ void D3D12CommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned in
     //todo
 }
 
+/* ----- Resource Heaps ----- */
+
+void D3D12CommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap)
+{
+    auto& resourceHeapD3D = LLGL_CAST(D3D12ResourceHeap&, resourceHeap);
+
+    /* Store pre-resolved descriptors; they are copied into the descriptor table with the next draw command */
+    for (const auto& binding : resourceHeapD3D.GetSRVBindings())
+    {
+        if (binding.slot < maxNumSRVSlots)
+            srvDescHandles_[binding.slot] = binding.descHandle;
+    }
+
+    for (const auto& binding : resourceHeapD3D.GetCBVBindings())
+    {
+        if (binding.slot < maxNumCBVSlots)
+        {
+            cbvDescHandles_[binding.slot]               = binding.descHandle;
+            cbvRangeDescs_[binding.slot].SizeInBytes    = 0;
+            cbvAddresses_[binding.slot]                 = binding.constantBuffer->GetGPUVirtualAddress();
+            cbvBuffers_[binding.slot]                   = binding.constantBuffer;
+            cbvVersions_[binding.slot]                  = binding.constantBuffer->GetVersion();
+        }
+    }
+
+    descTableDirty_ = true;
+    rootCBVsDirty_  = true;
+}
+
 /* ----- Render Targets ----- */
 
 void D3D12CommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 {
-    //todo
+    AssertNotBundle("SetRenderTarget");
+    auto& renderTargetD3D = LLGL_CAST(D3D12RenderTarget&, renderTarget);
+
+    /* Textures are in the shader resource state outside of their use as render target attachments */
+    if (boundRenderTarget_ != &renderTargetD3D)
+    {
+        UnbindRenderTarget();
+        boundRenderTarget_ = &renderTargetD3D;
+        SubmitRenderTarget();
+    }
 }
 
 void D3D12CommandBuffer::SetRenderTarget(RenderContext& renderContext)
 {
+    AssertNotBundle("SetRenderTarget");
     auto& renderContextD3D = LLGL_CAST(D3D12RenderContext&, renderContext);
 
+    UnbindRenderTarget();
+
     renderContextD3D.SetCommandBuffer(this);
 
     SetBackBufferRTV(renderContextD3D);
 }
 
+/* ----- Render Passes ----- */
+
+/*
+The render passes are mapped onto clear and discard commands of the base command list,
+because the render pass commands require ID3D12GraphicsCommandList4.
+*/
+
+void D3D12CommandBuffer::BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc)
+{
+    AssertNotBundle("BeginRenderPass");
+    SetRenderTarget(renderTarget);
+
+    renderPassTarget_   = boundRenderTarget_;
+    renderPassDesc_     = renderPassDesc;
+
+    /* Submit attachment transitions before the render target is written */
+    barrierBatch_.Flush(commandList_.Get());
+
+    /* Clear or discard color attachments (clear values are taken from "SetClearColor", "SetClearDepth", and "SetClearStencil") */
+    const auto& rtvDescHandles = renderPassTarget_->GetRTVDescHandles();
+    const auto numColorAttachments = std::min(renderPassDesc.colorAttachments.size(), rtvDescHandles.size());
+
+    for (std::size_t i = 0; i < numColorAttachments; ++i)
+    {
+        switch (renderPassDesc.colorAttachments[i].loadOp)
+        {
+            case AttachmentLoadOp::Clear:
+                commandList_->ClearRenderTargetView(rtvDescHandles[i], clearState_.color.Ptr(), 0, nullptr);
+                break;
+            case AttachmentLoadOp::DontCare:
+                renderPassTarget_->DiscardColorAttachment(commandList_.Get(), i);
+                break;
+            default:
+                break;
+        }
+    }
+
+    /* Clear or discard depth-stencil attachment */
+    if (auto dsvDescHandle = renderPassTarget_->GetDSVDescHandle())
+    {
+        UINT dsvClearFlags = 0;
+
+        if (renderPassDesc.depthAttachment.loadOp == AttachmentLoadOp::Clear)
+            dsvClearFlags |= D3D12_CLEAR_FLAG_DEPTH;
+        if (renderPassDesc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
+            dsvClearFlags |= D3D12_CLEAR_FLAG_STENCIL;
+
+        if (dsvClearFlags)
+        {
+            commandList_->ClearDepthStencilView(
+                *dsvDescHandle, static_cast<D3D12_CLEAR_FLAGS>(dsvClearFlags), clearState_.depth, clearState_.stencil, 0, nullptr
+            );
+        }
+        else if (renderPassDesc.depthAttachment.loadOp   == AttachmentLoadOp::DontCare &&
+                 renderPassDesc.stencilAttachment.loadOp == AttachmentLoadOp::DontCare)
+        {
+            /* Depth and stencil share the same view, so it can only be discarded if both are undefined */
+            renderPassTarget_->DiscardDepthStencilAttachment(commandList_.Get());
+        }
+    }
+}
+
+void D3D12CommandBuffer::BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc)
+{
+    AssertNotBundle("BeginRenderPass");
+    auto& renderContextD3D = LLGL_CAST(D3D12RenderContext&, renderContext);
+
+    SetRenderTarget(renderContext);
+
+    /* Render context only has a single color buffer; clear values are taken from "SetClearColor" */
+    renderPassColorBuffer_  = renderContextD3D.GetCurrentRenderTarget();
+    renderPassColorStoreOp_ = AttachmentStoreOp::Store;
+
+    if (!renderPassDesc.colorAttachments.empty())
+    {
+        const auto& colorAttachment = renderPassDesc.colorAttachments.front();
+
+        renderPassColorStoreOp_ = colorAttachment.storeOp;
+
+        if (colorAttachment.loadOp != AttachmentLoadOp::Load)
+        {
+            /* Submit back buffer transition before the render target is written */
+            barrierBatch_.Flush(commandList_.Get());
+
+            if (colorAttachment.loadOp == AttachmentLoadOp::Clear)
+                commandList_->ClearRenderTargetView(rtvDescHandle_, clearState_.color.Ptr(), 0, nullptr);
+            else
+                commandList_->DiscardResource(renderPassColorBuffer_, nullptr);
+        }
+    }
+}
+
+void D3D12CommandBuffer::EndRenderPass()
+{
+    AssertNotBundle("EndRenderPass");
+    if (renderPassColorBuffer_ != nullptr && renderPassColorStoreOp_ == AttachmentStoreOp::Discard)
+    {
+        barrierBatch_.Flush(commandList_.Get());
+        commandList_->DiscardResource(renderPassColorBuffer_, nullptr);
+    }
+    renderPassColorBuffer_ = nullptr;
+
+    if (renderPassTarget_ != nullptr)
+    {
+        barrierBatch_.Flush(commandList_.Get());
+
+        const auto numColorAttachments = std::min(renderPassDesc_.colorAttachments.size(), renderPassTarget_->GetRTVDescHandles().size());
+
+        for (std::size_t i = 0; i < numColorAttachments; ++i)
+        {
+            if (renderPassDesc_.colorAttachments[i].storeOp == AttachmentStoreOp::Discard)
+                renderPassTarget_->DiscardColorAttachment(commandList_.Get(), i);
+        }
+
+        if (renderPassTarget_->GetDSVDescHandle() != nullptr &&
+            renderPassDesc_.depthAttachment.storeOp   == AttachmentStoreOp::Discard &&
+            renderPassDesc_.stencilAttachment.storeOp == AttachmentStoreOp::Discard)
+        {
+            renderPassTarget_->DiscardDepthStencilAttachment(commandList_.Get());
+        }
+
+        renderPassTarget_ = nullptr;
+    }
+}
+
 /* ----- Pipeline States ----- */
 
 void D3D12CommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
-    /* Set graphics root signature, graphics pipeline state, and primitive topology */
+    /* Record graphics root signature, graphics pipeline state, and primitive topology; they are submitted with the next draw command */
     auto& graphicsPipelineD3D = LLGL_CAST(D3D12GraphicsPipeline&, graphicsPipeline);
-    commandList_->SetGraphicsRootSignature(graphicsPipelineD3D.GetRootSignature());
-    commandList_->SetPipelineState(graphicsPipelineD3D.GetPipelineState());
-    commandList_->IASetPrimitiveTopology(graphicsPipelineD3D.GetPrimitiveTopology());
+    stateMngr_.SetGraphicsRootSignature(graphicsPipelineD3D.GetRootSignature());
+    stateMngr_.SetPipelineState(graphicsPipelineD3D.GetPipelineState());
+    stateMngr_.SetPrimitiveTopology(graphicsPipelineD3D.GetPrimitiveTopology());
+    SetPipelineLayout(graphicsPipelineD3D.GetLayout(), false);
 }
 
 void D3D12CommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
-    //todo
+    /* Record compute root signature and compute pipeline state; they are submitted with the next dispatch command */
+    auto& computePipelineD3D = LLGL_CAST(D3D12ComputePipeline&, computePipeline);
+    stateMngr_.SetComputeRootSignature(computePipelineD3D.GetRootSignature());
+    stateMngr_.SetPipelineState(computePipelineD3D.GetPipelineState());
+    SetPipelineLayout(computePipelineD3D.GetLayout(), true);
+}
+
+void D3D12CommandBuffer::SetPushConstants(unsigned int offset, unsigned int size, const void* data)
+{
+    /* Record push constants as root constants (in units of 32-bit values); they are submitted with the next draw command */
+    auto destOffset = offset / 4;
+    if (destOffset < numPushConstants_)
+    {
+        auto num32BitValues = std::min(size / 4, numPushConstants_ - destOffset);
+        stateMngr_.SetGraphicsRoot32BitConstants(pushConstantsParameter_, num32BitValues, data, destOffset);
+    }
+}
+
+void D3D12CommandBuffer::SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances)
+{
+    // dummy (dynamic shader linkage is not supported with Direct3D 12)
 }
 
 /* ----- Queries ----- */
 
+/*
+Queries are suballocated from the query heaps of the render system. The results of all queries that have been ended
+are resolved into the readback buffers of their query heaps right before the command list is closed, with one resolve command
+for each range of consecutive queries. The results are available once the GPU has crossed the fence value that is signaled
+after the command list has been submitted.
+*/
+
 void D3D12CommandBuffer::BeginQuery(Query& query)
 {
-    //todo
+    AssertNotBundle("BeginQuery");
+    auto& queryD3D = LLGL_CAST(D3D12Query&, query);
+
+    if (nodeIndex_ > 0)
+        throw std::invalid_argument("cannot record D3D12 queries in a command buffer of a GPU node other than 0");
+
+    const auto& slot = queryD3D.GetSlot();
+
+    if (queryD3D.GetType() == QueryType::TimeElapsed)
+    {
+        /* Insert the beginning timestamp query */
+        commandList_->EndQuery(slot.block->queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, slot.index);
+    }
+    else if (queryD3D.GetType() == QueryType::Timestamp)
+    {
+        /* Timestamp queries are only ended */
+    }
+    else
+    {
+        /* Begin standard query */
+        commandList_->BeginQuery(slot.block->queryHeap.Get(), queryD3D.GetNativeType(), slot.index);
+    }
 }
 
 void D3D12CommandBuffer::EndQuery(Query& query)
 {
-    //todo
+    AssertNotBundle("EndQuery");
+    auto& queryD3D = LLGL_CAST(D3D12Query&, query);
+
+    if (nodeIndex_ > 0)
+        throw std::invalid_argument("cannot record D3D12 queries in a command buffer of a GPU node other than 0");
+
+    const auto& slot = queryD3D.GetSlot();
+
+    /* Insert the ending timestamp query for TimeElapsed (second native query), or end the standard query */
+    auto queryIndex = (queryD3D.GetType() == QueryType::TimeElapsed ? slot.index + 1 : slot.index);
+    commandList_->EndQuery(slot.block->queryHeap.Get(), queryD3D.GetNativeType(), queryIndex);
+
+    /* Result is pending until this command list has been submitted */
+    queryD3D.SetPending();
+    pendingQueries_.push_back(&queryD3D);
+}
+
+// Converts the specified GPU timestamp ticks to nanoseconds.
+static std::uint64_t TimestampToNanoseconds(UINT64 ticks, UINT64 frequency)
+{
+    static const double nanoseconds = 1000000000.0;
+
+    if (frequency == 0)
+        return 0;
+
+    auto scale = (nanoseconds / static_cast<double>(frequency));
+    return static_cast<std::uint64_t>(static_cast<double>(ticks) * scale + 0.5);
 }
 
 bool D3D12CommandBuffer::QueryResult(Query& query, std::uint64_t& result)
 {
-    return false; //todo
+    auto& queryD3D = LLGL_CAST(D3D12Query&, query);
+
+    /* Query results are not available to deferred command buffers (see CommandBuffer::QueryResult) */
+    if (deferred_ || !IsQueryResultAvailable(queryD3D))
+        return false;
+
+    switch (queryD3D.GetNativeType())
+    {
+        /* Query result from data of type: UINT64 */
+        case D3D12_QUERY_TYPE_OCCLUSION:
+        case D3D12_QUERY_TYPE_BINARY_OCCLUSION:
+        {
+            result = *reinterpret_cast<const UINT64*>(queryD3D.GetResultData());
+        }
+        break;
+
+        /* Query result from special case query types: TimeElapsed and Timestamp */
+        case D3D12_QUERY_TYPE_TIMESTAMP:
+        {
+            auto timestamp = *reinterpret_cast<const UINT64*>(queryD3D.GetResultData(0));
+            if (queryD3D.GetType() == QueryType::TimeElapsed)
+            {
+                auto endTime = *reinterpret_cast<const UINT64*>(queryD3D.GetResultData(1));
+                timestamp = endTime - timestamp;
+            }
+            result = TimestampToNanoseconds(timestamp, queryD3D.GetTimestampFrequency());
+        }
+        break;
+
+        /* Query result from data of type: D3D12_QUERY_DATA_PIPELINE_STATISTICS */
+        case D3D12_QUERY_TYPE_PIPELINE_STATISTICS:
+        {
+            const auto& data = *reinterpret_cast<const D3D12_QUERY_DATA_PIPELINE_STATISTICS*>(queryD3D.GetResultData());
+            switch (queryD3D.GetType())
+            {
+                case QueryType::PrimitivesGenerated:
+                    result = data.CInvocations;
+                    break;
+                case QueryType::VerticesSubmitted:
+                    result = data.IAVertices;
+                    break;
+                case QueryType::PrimitivesSubmitted:
+                    result = data.IAPrimitives;
+                    break;
+                case QueryType::VertexShaderInvocations:
+                    result = data.VSInvocations;
+                    break;
+                case QueryType::TessControlShaderInvocations:
+                    result = data.HSInvocations;
+                    break;
+                case QueryType::TessEvaluationShaderInvocations:
+                    result = data.DSInvocations;
+                    break;
+                case QueryType::GeometryShaderInvocations:
+                    result = data.GSInvocations;
+                    break;
+                case QueryType::FragmentShaderInvocations:
+                    result = data.PSInvocations;
+                    break;
+                case QueryType::ComputeShaderInvocations:
+                    result = data.CSInvocations;
+                    break;
+                case QueryType::GeometryPrimitivesGenerated:
+                    result = data.GSPrimitives;
+                    break;
+                case QueryType::ClippingInputPrimitives:
+                    result = data.CInvocations;
+                    break;
+                case QueryType::ClippingOutputPrimitives:
+                    result = data.CPrimitives;
+                    break;
+                default:
+                    return false;
+            }
+        }
+        break;
+
+        /* Query result from data of type: D3D12_QUERY_DATA_SO_STATISTICS */
+        case D3D12_QUERY_TYPE_SO_STATISTICS_STREAM0:
+        {
+            const auto& data = *reinterpret_cast<const D3D12_QUERY_DATA_SO_STATISTICS*>(queryD3D.GetResultData());
+            if (queryD3D.GetType() == QueryType::StreamOutOverflow)
+                result = (data.PrimitivesStorageNeeded > data.NumPrimitivesWritten ? 1 : 0);
+            else
+                result = data.NumPrimitivesWritten;
+        }
+        break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+bool D3D12CommandBuffer::QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results)
+{
+    auto& queryArrayD3D = LLGL_CAST(D3D12QueryArray&, queryArray);
+    const auto& queries = queryArrayD3D.GetQueries();
+
+    /* Query results in reverse order, since the last query is most likely still pending */
+    for (auto i = numQueries; i > 0; --i)
+    {
+        if (!QueryResult(*queries[firstQuery + i - 1], results[i - 1]))
+            return false;
+    }
+
+    return true;
+}
+
+bool D3D12CommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    auto& queryD3D = LLGL_CAST(D3D12Query&, query);
+
+    if (!deferred_ && queryD3D.GetNativeType() == D3D12_QUERY_TYPE_PIPELINE_STATISTICS && IsQueryResultAvailable(queryD3D))
+    {
+        /* Read all counters of the pipeline statistics at once */
+        const auto& data = *reinterpret_cast<const D3D12_QUERY_DATA_PIPELINE_STATISTICS*>(queryD3D.GetResultData());
+        {
+            result.numPrimitivesGenerated               = data.CInvocations;
+            result.numVerticesSubmitted                 = data.IAVertices;
+            result.numPrimitivesSubmitted               = data.IAPrimitives;
+            result.numVertexShaderInvocations           = data.VSInvocations;
+            result.numTessControlShaderInvocations      = data.HSInvocations;
+            result.numTessEvaluationShaderInvocations   = data.DSInvocations;
+            result.numGeometryShaderInvocations         = data.GSInvocations;
+            result.numFragmentShaderInvocations         = data.PSInvocations;
+            result.numComputeShaderInvocations          = data.CSInvocations;
+            result.numGeometryPrimitivesGenerated       = data.GSPrimitives;
+            result.numClippingInputPrimitives           = data.CInvocations;
+            result.numClippingOutputPrimitives          = data.CPrimitives;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/*
+Only occlusion queries are resolved on the GPU, since their native results are 64-bit integers just like the results of "QueryResult".
+The results of all other query types must be converted (e.g. timestamps into nanoseconds), which can only be done on the CPU.
+*/
+void D3D12CommandBuffer::ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset)
+{
+    AssertNotBundle("ResolveQueryData");
+    auto& queryArrayD3D = LLGL_CAST(D3D12QueryArray&, queryArray);
+    auto& dstBufferD3D  = LLGL_CAST(D3D12Buffer&, dstBuffer);
+
+    if (queryArray.GetType() != QueryType::SamplesPassed &&
+        queryArray.GetType() != QueryType::AnySamplesPassed &&
+        queryArray.GetType() != QueryType::AnySamplesPassedConservative)
+    {
+        throw std::invalid_argument("cannot resolve D3D12 query data other than occlusion queries into a buffer");
+    }
+    if (dstBufferD3D.GetUsageState() == D3D12_RESOURCE_STATE_GENERIC_READ)
+        throw std::invalid_argument("cannot resolve D3D12 query data into buffer that resides in the upload heap (e.g. constant buffers)");
+    if (dstOffset % sizeof(UINT64) != 0)
+        throw std::invalid_argument("cannot resolve D3D12 query data into buffer at an offset that is not a multiple of 8");
+
+    const auto& queries = queryArrayD3D.GetQueries();
+
+    barrierBatch_.Transition(dstBufferD3D.Get(), dstBufferD3D.GetUsageState(), D3D12_RESOURCE_STATE_COPY_DEST);
+    barrierBatch_.Flush(commandList_.Get());
+
+    /* Resolve each range of consecutive queries within the same query heap with a single command */
+    for (unsigned int i = 0; i < numQueries;)
+    {
+        const auto& slot = queries[firstQuery + i]->GetSlot();
+
+        unsigned int count = 1;
+        while (i + count < numQueries)
+        {
+            const auto& nextSlot = queries[firstQuery + i + count]->GetSlot();
+            if (nextSlot.block != slot.block || nextSlot.index != slot.index + count)
+                break;
+            ++count;
+        }
+
+        commandList_->ResolveQueryData(
+            slot.block->queryHeap.Get(),
+            queries[firstQuery + i]->GetNativeType(),
+            slot.index,
+            count,
+            dstBufferD3D.Get(),
+            dstOffset + i * sizeof(UINT64)
+        );
+
+        i += count;
+    }
+
+    barrierBatch_.Transition(dstBufferD3D.Get(), D3D12_RESOURCE_STATE_COPY_DEST, dstBufferD3D.GetUsageState());
 }
 
 void D3D12CommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
@@ -268,73 +849,599 @@ void D3D12CommandBuffer::EndRenderCondition()
     //todo...
 }
 
+/* ----- Copy ----- */
+
+/*
+Resources are transitioned into the copy states and back into their usage states around each copy command,
+since no resource state tracking is done so far. Buffers within the upload heap are always readable by the copy engine.
+The transitions back into the usage states are split barriers, which end with the next command that flushes the barrier batch.
+*/
+
+void D3D12CommandBuffer::CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size)
+{
+    AssertNotBundle("CopyBuffer");
+    auto& dstBufferD3D = LLGL_CAST(D3D12Buffer&, dstBuffer);
+    auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
+
+    if (dstBufferD3D.GetUsageState() == D3D12_RESOURCE_STATE_GENERIC_READ)
+        throw std::invalid_argument("cannot copy into D3D12 buffer that resides in the upload heap (e.g. constant buffers)");
+
+    const bool transitionSrc = (srcBufferD3D.GetUsageState() != D3D12_RESOURCE_STATE_GENERIC_READ);
+
+    /* Transition resources into copy states */
+    barrierBatch_.Transition(dstBufferD3D.Get(), dstBufferD3D.GetUsageState(), D3D12_RESOURCE_STATE_COPY_DEST);
+
+    if (transitionSrc)
+        barrierBatch_.Transition(srcBufferD3D.Get(), srcBufferD3D.GetUsageState(), D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+    barrierBatch_.Flush(commandList_.Get());
+
+    /* Copy buffer region */
+    commandList_->CopyBufferRegion(dstBufferD3D.Get(), dstOffset, srcBufferD3D.Get(), srcOffset, size);
+
+    /* Transition resources back into usage states */
+    barrierBatch_.SplitTransition(dstBufferD3D.Get(), D3D12_RESOURCE_STATE_COPY_DEST, dstBufferD3D.GetUsageState());
+
+    if (transitionSrc)
+        barrierBatch_.SplitTransition(srcBufferD3D.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, srcBufferD3D.GetUsageState());
+
+    barrierBatch_.Flush(commandList_.Get());
+}
+
+void D3D12CommandBuffer::CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    AssertNotBundle("CopyTexture");
+    auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
+    auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
+
+    auto dstRegionD3D = DXGetTextureRegion(dstTextureD3D.GetType(), dstOffset, srcRegion.extent);
+    auto srcRegionD3D = DXGetTextureRegion(srcTextureD3D.GetType(), srcRegion.offset, srcRegion.extent);
+
+    /* Transition textures into copy states */
+    barrierBatch_.Transition(dstTextureD3D.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_DEST);
+    barrierBatch_.Transition(srcTextureD3D.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    barrierBatch_.Flush(commandList_.Get());
+
+    /* Copy each array layer separately, since each one is a separate subresource */
+    D3D12_BOX srcBox
+    {
+        srcRegionD3D.left, srcRegionD3D.top, srcRegionD3D.front,
+        srcRegionD3D.right, srcRegionD3D.bottom, srcRegionD3D.back
+    };
+
+    for (UINT i = 0; i < srcRegionD3D.numArrayLayers; ++i)
+    {
+        CD3DX12_TEXTURE_COPY_LOCATION dstLocation(
+            dstTextureD3D.Get(),
+            D3D12CalcSubresource(dstMipLevel, dstRegionD3D.firstArrayLayer + i, 0, dstTextureD3D.GetNumMipLevels(), 1)
+        );
+
+        CD3DX12_TEXTURE_COPY_LOCATION srcLocation(
+            srcTextureD3D.Get(),
+            D3D12CalcSubresource(srcRegion.mipLevel, srcRegionD3D.firstArrayLayer + i, 0, srcTextureD3D.GetNumMipLevels(), 1)
+        );
+
+        commandList_->CopyTextureRegion(&dstLocation, dstRegionD3D.left, dstRegionD3D.top, dstRegionD3D.front, &srcLocation, &srcBox);
+    }
+
+    /* Transition textures back into usage states */
+    barrierBatch_.SplitTransition(dstTextureD3D.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    barrierBatch_.SplitTransition(srcTextureD3D.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    barrierBatch_.Flush(commandList_.Get());
+}
+
+void D3D12CommandBuffer::ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    AssertNotBundle("ResolveTexture");
+    auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
+    auto& srcTextureD3D = LLGL_CAST(D3D12Texture&, srcTexture);
+
+    /* Transition textures into resolve states */
+    barrierBatch_.Transition(dstTextureD3D.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RESOLVE_DEST);
+    barrierBatch_.Transition(srcTextureD3D.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RESOLVE_SOURCE);
+    barrierBatch_.Flush(commandList_.Get());
+
+    /*
+    Resolve each array layer separately, since each one is a separate subresource.
+    The region within a layer is ignored, because "ResolveSubresourceRegion" requires ID3D12GraphicsCommandList1.
+    */
+    const auto numLayers = std::max(1u, srcRegion.extent.z);
+
+    for (UINT i = 0; i < numLayers; ++i)
+    {
+        commandList_->ResolveSubresource(
+            dstTextureD3D.Get(),
+            D3D12CalcSubresource(dstMipLevel, dstOffset.z + i, 0, dstTextureD3D.GetNumMipLevels(), 1),
+            srcTextureD3D.Get(),
+            D3D12CalcSubresource(0, srcRegion.offset.z + i, 0, 1, 1),
+            dstTextureD3D.GetFormat()
+        );
+    }
+
+    /* Transition textures back into usage states */
+    barrierBatch_.SplitTransition(dstTextureD3D.Get(), D3D12_RESOURCE_STATE_RESOLVE_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    barrierBatch_.SplitTransition(srcTextureD3D.Get(), D3D12_RESOURCE_STATE_RESOLVE_SOURCE, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    barrierBatch_.Flush(commandList_.Get());
+}
+
+void D3D12CommandBuffer::CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType)
+{
+    AssertNotBundle("CopyBufferToTexture");
+    auto& dstTextureD3D = LLGL_CAST(D3D12Texture&, dstTexture);
+    auto& srcBufferD3D = LLGL_CAST(D3D12Buffer&, srcBuffer);
+
+    /* Validate image format and alignment, since the copy engine can not convert or realign the image data */
+    const bool compressed = IsCompressedFormat(imageFormat);
+
+    if (!compressed)
+    {
+        auto formatDesc = DXGetTextureFormatDesc(dstTextureD3D.GetFormat());
+        if (formatDesc.format != imageFormat || formatDesc.dataType != dataType)
+            throw std::invalid_argument("image format of buffer-to-texture copy does not match the D3D12 texture format");
+    }
+
+    if (srcOffset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT != 0)
+        throw std::invalid_argument("source offset of buffer-to-texture copy must be a multiple of 512 for D3D12");
+
+    auto regionD3D = DXGetTextureRegion(dstTextureD3D.GetType(), dstRegion.offset, dstRegion.extent);
+
+    auto width  = regionD3D.right - regionD3D.left;
+    auto height = regionD3D.bottom - regionD3D.top;
+    auto depth  = regionD3D.back - regionD3D.front;
+
+    /* Determine row pitch and size of each array layer */
+    UINT rowPitch = 0, numRows = height;
+    if (compressed)
+    {
+        /* Compressed formats are stored in rows of 4x4 blocks */
+        auto blockRowSize = CompressedImageSize(D3D12Types::Unmap(dstTextureD3D.GetFormat()), width, 4);
+        rowPitch    = blockRowSize;
+        numRows     = (height + 3) / 4;
+    }
+    else
+        rowPitch = width * ImageFormatSize(imageFormat) * DataTypeSize(dataType);
+
+    if (rowPitch % D3D12_TEXTURE_DATA_PITCH_ALIGNMENT != 0)
+        throw std::invalid_argument("row size of buffer-to-texture copy must be a multiple of 256 for D3D12");
+
+    const UINT64 layerSize = static_cast<UINT64>(rowPitch) * numRows * depth;
+
+    /* Transition resources into copy states */
+    const bool transitionSrc = (srcBufferD3D.GetUsageState() != D3D12_RESOURCE_STATE_GENERIC_READ);
+
+    barrierBatch_.Transition(dstTextureD3D.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_DEST);
+
+    if (transitionSrc)
+        barrierBatch_.Transition(srcBufferD3D.Get(), srcBufferD3D.GetUsageState(), D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+    barrierBatch_.Flush(commandList_.Get());
+
+    /* Copy image data into each array layer */
+    D3D12_BOX srcBox { 0, 0, 0, width, height, depth };
+
+    for (UINT i = 0; i < regionD3D.numArrayLayers; ++i)
+    {
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
+        {
+            footprint.Offset                = srcOffset + layerSize * i;
+            footprint.Footprint.Format      = dstTextureD3D.GetFormat();
+            footprint.Footprint.Width       = width;
+            footprint.Footprint.Height      = height;
+            footprint.Footprint.Depth       = depth;
+            footprint.Footprint.RowPitch    = rowPitch;
+        }
+
+        CD3DX12_TEXTURE_COPY_LOCATION dstLocation(
+            dstTextureD3D.Get(),
+            D3D12CalcSubresource(dstRegion.mipLevel, regionD3D.firstArrayLayer + i, 0, dstTextureD3D.GetNumMipLevels(), 1)
+        );
+
+        CD3DX12_TEXTURE_COPY_LOCATION srcLocation(srcBufferD3D.Get(), footprint);
+
+        commandList_->CopyTextureRegion(&dstLocation, regionD3D.left, regionD3D.top, regionD3D.front, &srcLocation, &srcBox);
+    }
+
+    /* Transition resources back into usage states */
+    barrierBatch_.SplitTransition(dstTextureD3D.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    if (transitionSrc)
+        barrierBatch_.SplitTransition(srcBufferD3D.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, srcBufferD3D.GetUsageState());
+
+    barrierBatch_.Flush(commandList_.Get());
+}
+
 /* ----- Drawing ----- */
 
 void D3D12CommandBuffer::Draw(unsigned int numVertices, unsigned int firstVertex)
 {
+    FlushGraphicsState();
     commandList_->DrawInstanced(numVertices, 1, firstVertex, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex)
 {
+    FlushGraphicsState();
     commandList_->DrawIndexedInstanced(numVertices, 1, firstIndex, 0, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex, int vertexOffset)
 {
+    FlushGraphicsState();
     commandList_->DrawIndexedInstanced(numVertices, 1, firstIndex, vertexOffset, 0);
 }
 
 void D3D12CommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances)
 {
+    FlushGraphicsState();
     commandList_->DrawInstanced(numVertices, numInstances, firstVertex, 0);
 }
 
 void D3D12CommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset)
 {
+    FlushGraphicsState();
     commandList_->DrawInstanced(numVertices, numInstances, firstVertex, instanceOffset);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex)
 {
+    FlushGraphicsState();
     commandList_->DrawIndexedInstanced(numVertices, numInstances, firstIndex, 0, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset)
 {
+    FlushGraphicsState();
     commandList_->DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void D3D12CommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset)
 {
+    FlushGraphicsState();
     commandList_->DrawIndexedInstanced(numVertices, numInstances, firstIndex, vertexOffset, instanceOffset);
 }
 
+void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset)
+{
+    FlushGraphicsState();
+    ExecuteIndirect(renderSystem_.GetDrawIndirectSignature(), sizeof(D3D12_DRAW_ARGUMENTS), buffer, offset, 1, sizeof(D3D12_DRAW_ARGUMENTS));
+}
+
+void D3D12CommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    FlushGraphicsState();
+    ExecuteIndirect(renderSystem_.GetDrawIndirectSignature(), sizeof(D3D12_DRAW_ARGUMENTS), buffer, offset, numCommands, stride);
+}
+
+void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset)
+{
+    FlushGraphicsState();
+    ExecuteIndirect(renderSystem_.GetDrawIndexedIndirectSignature(), sizeof(D3D12_DRAW_INDEXED_ARGUMENTS), buffer, offset, 1, sizeof(D3D12_DRAW_INDEXED_ARGUMENTS));
+}
+
+void D3D12CommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    FlushGraphicsState();
+    ExecuteIndirect(renderSystem_.GetDrawIndexedIndirectSignature(), sizeof(D3D12_DRAW_INDEXED_ARGUMENTS), buffer, offset, numCommands, stride);
+}
+
+void D3D12CommandBuffer::DrawStreamOutput()
+{
+    //todo...
+}
+
+void D3D12CommandBuffer::DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ)
+{
+    if (commandList6_)
+    {
+        FlushGraphicsState();
+        commandList6_->DispatchMesh(numTasksX, numTasksY, numTasksZ);
+    }
+}
+
 /* ----- Compute ----- */
 
 void D3D12CommandBuffer::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ)
 {
+    FlushComputeState();
     commandList_->Dispatch(groupSizeX, groupSizeY, groupSizeZ);
 }
 
+void D3D12CommandBuffer::DispatchIndirect(Buffer& buffer, unsigned int offset)
+{
+    FlushComputeState();
+    ExecuteIndirect(renderSystem_.GetDispatchIndirectSignature(), sizeof(D3D12_DISPATCH_ARGUMENTS), buffer, offset, 1, sizeof(D3D12_DISPATCH_ARGUMENTS));
+}
+
+void D3D12CommandBuffer::Barrier(long /*barrierFlags*/)
+{
+    AssertNotBundle("Barrier");
+    /* UAV barriers cannot be restricted to certain kinds of memory access, so synchronize all UAV accesses */
+    barrierBatch_.UAV(nullptr);
+}
+
+void D3D12CommandBuffer::StorageBarrier(Buffer& buffer)
+{
+    AssertNotBundle("StorageBarrier");
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    barrierBatch_.UAV(bufferD3D.Get());
+}
+
+/* ----- Command Recording ----- */
+
+void D3D12CommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    AssertNotBundle("Execute");
+    auto& deferredCommandBufferD3D = LLGL_CAST(D3D12CommandBuffer&, deferredCommandBuffer);
+
+    if (deferredCommandBufferD3D.IsBundle())
+    {
+        /* Bundles are executed within this command list, so they can also be recorded into deferred command buffers */
+        ExecuteBundle(deferredCommandBufferD3D);
+        return;
+    }
+
+    if (deferred_)
+        throw std::runtime_error("cannot execute D3D12 command buffer within a deferred command buffer");
+    if (deferredCommandBufferD3D.IsAsyncCompute())
+        throw std::invalid_argument("cannot execute D3D12 async compute command buffer within another command buffer");
+    if (deferredCommandBufferD3D.GetNodeIndex() != nodeIndex_)
+        throw std::invalid_argument("cannot execute D3D12 command buffer within a command buffer of another GPU node");
+
+    if (auto commandList = deferredCommandBufferD3D.FinishCommandList())
+    {
+        /* Submit pending commands of this command list first to keep the order of commands */
+        FinishQueries();
+        RestoreResourceStates();
+        barrierBatch_.Finish(commandList_.Get());
+        renderSystem_.CloseAndExecuteCommandList(commandList_.Get());
+        SignalQueries();
+
+        /* Submit command list of deferred command buffer */
+        ID3D12CommandList* cmdLists[] = { commandList };
+        renderSystem_.ExecuteCommandLists(1, cmdLists);
+        deferredCommandBufferD3D.SignalFences();
+
+        ID3D12Fence* fence = nullptr;
+        auto fenceValue = renderSystem_.SignalQueueFence(false, 0, fence);
+        deferredCommandBufferD3D.SetSubmitFence(fence, fenceValue);
+
+        /* Continue recording with the current command allocator */
+        ResetCommandList(commandAllocCurrent_, nullptr);
+    }
+}
+
+// Bundles inherit the viewports, scissors, and render target of this command list, but they leave their pipeline states and root arguments behind.
+void D3D12CommandBuffer::ExecuteBundle(D3D12CommandBuffer& bundleCommandBuffer)
+{
+    if (asyncCompute_)
+        throw std::invalid_argument("cannot execute D3D12 bundle within an async compute command buffer");
+    if (bundleCommandBuffer.GetNodeIndex() != nodeIndex_)
+        throw std::invalid_argument("cannot execute D3D12 command buffer within a command buffer of another GPU node");
+
+    auto bundle = bundleCommandBuffer.FinishCommandList();
+
+    /* Submit pending barriers and the persistent states the bundle inherits */
+    barrierBatch_.Flush(commandList_.Get());
+    stateMngr_.FlushGraphicsState(commandList_.Get());
+
+    /* Bundles can only use the descriptor heaps that are bound to the executing command list */
+    bundleCommandBuffer.SetDescriptorHeaps(commandList_.Get());
+    commandList_->ExecuteBundle(bundle);
+    SetDescriptorHeaps(commandList_.Get());
+
+    /* Pipeline states and root arguments of the bundle remain bound, so all states must be submitted again */
+    stateMngr_.Reset(true);
+    descTableDirty_ = true;
+    rootCBVsDirty_  = true;
+}
+
+void D3D12CommandBuffer::Reset()
+{
+    if (deferred_)
+    {
+        /* Close command list if it's still open */
+        FinishCommandList();
+
+        /* Wait until the GPU is no longer referencing the command allocator, i.e. only for the last submission of this command buffer */
+        if (submitFence_ != nullptr)
+        {
+            renderSystem_.WaitForQueueFence(submitFence_, submitFenceValue_);
+            submitFence_ = nullptr;
+        }
+
+        auto hr = commandAlloc_->Reset();
+        DXThrowIfFailed(hr, "failed to reset D3D12 command allocator");
+
+        ResetDescriptorHeaps(0);
+        boundRenderTarget_ = nullptr;
+        ResetCommandList(commandAlloc_.Get(), nullptr);
+        signalFences_.clear();
+        pendingQueries_.clear();
+        closed_ = false;
+    }
+}
+
 /* ----- Misc ----- */
 
+void D3D12CommandBuffer::Signal(Fence& fence)
+{
+    AssertNotBundle("Signal");
+    auto& fenceD3D = LLGL_CAST(D3D12Fence&, fence);
+
+    if (deferred_)
+    {
+        /* Fences can only be signaled by the command queue, so they are signaled when this command buffer is executed */
+        signalFences_.push_back(&fenceD3D);
+    }
+    else
+    {
+        /* Submit pending commands, so that the fence is signaled after all commands recorded so far */
+        FinishQueries();
+        RestoreResourceStates();
+        barrierBatch_.Finish(commandList_.Get());
+        renderSystem_.CloseAndExecuteCommandList(commandList_.Get());
+        fenceD3D.Signal(renderSystem_.GetCommandQueue());
+        SignalQueries();
+
+        /* Continue recording with the current command allocator */
+        ResetCommandList(commandAllocCurrent_, nullptr);
+    }
+}
+
 void D3D12CommandBuffer::SyncGPU()
 {
-    //renderSystem_.SyncGPU(fenceValues_[currentFrame_]);
+    renderSystem_.SyncGPU();
 }
 
 /* ----- Extended functions ----- */
 
+void D3D12CommandBuffer::ResetDescriptorHeaps(UINT frameInFlight)
+{
+    cbvSrvUavHeapAlloc_->Reset(frameInFlight);
+    samplerHeapAlloc_->Reset(frameInFlight);
+}
+
 void D3D12CommandBuffer::ResetCommandList(ID3D12CommandAllocator* commandAlloc, ID3D12PipelineState* pipelineState)
 {
     /* Reset commanb list with command allocator and pipeline state */
     auto hr = commandList_->Reset(commandAlloc, pipelineState);
     DXThrowIfFailed(hr, "failed to reset D3D12 command list");
 
-    /* If not disabled, re-submit persistent states (viewport and scissor) */
-    if (!disableAutoStateSubmission_)
-        SubmitPersistentStates();
+    commandAllocCurrent_ = commandAlloc;
+
+    /* Pending barriers have been submitted before the command list was closed */
+    barrierBatch_.Clear();
+
+    /* Re-bind shader-visible descriptor heaps and rebuild descriptor table with the next draw command */
+    SetDescriptorHeaps(commandList_.Get());
+    descTableDirty_ = true;
+    rootCBVsDirty_  = true;
+
+    /* Reset recorded states; if not disabled, persistent states (viewport and scissor) are re-submitted with the next draw command */
+    stateMngr_.Reset(!disableAutoStateSubmission_);
+
+    /* Re-submit persistent shading rate states, which are reset with the command list */
+    if (commandList5_)
+    {
+        SubmitShadingRate();
+        SubmitShadingRateImage();
+    }
+
+    /* Re-submit persistent depth bounds, which are reset with the command list */
+    if (commandList1_)
+        commandList1_->OMSetDepthBounds(depthBounds_[0], depthBounds_[1]);
+
+    /* Re-bind render target, whose attachments have been transitioned back to the shader resource state */
+    if (boundRenderTarget_)
+        SubmitRenderTarget();
+}
+
+void D3D12CommandBuffer::TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter)
+{
+    barrierBatch_.Transition(resource, stateBefore, stateAfter);
+}
+
+void D3D12CommandBuffer::FlushResourceBarriers()
+{
+    barrierBatch_.Finish(commandList_.Get());
+}
+
+void D3D12CommandBuffer::RestoreResourceStates()
+{
+    if (shadingRateImage_)
+        barrierBatch_.Transition(shadingRateImage_, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    if (boundRenderTarget_)
+        boundRenderTarget_->TransitionAttachments(barrierBatch_, false);
+}
+
+void D3D12CommandBuffer::SignalFences()
+{
+    auto commandQueue = (asyncCompute_ ? renderSystem_.GetComputeQueue() : renderSystem_.GetNodeQueue(nodeIndex_));
+    for (auto fence : signalFences_)
+        fence->Signal(commandQueue);
+    SignalQueries();
+}
+
+void D3D12CommandBuffer::FinishQueries()
+{
+    if (pendingQueries_.empty())
+        return;
+
+    /* Sort queries by query heap and index to find ranges of consecutive queries (a query might have been ended several times) */
+    std::vector<D3D12Query*> queries = pendingQueries_;
+
+    std::sort(
+        queries.begin(), queries.end(),
+        [](const D3D12Query* lhs, const D3D12Query* rhs)
+        {
+            if (lhs->GetSlot().block != rhs->GetSlot().block)
+                return (lhs->GetSlot().block < rhs->GetSlot().block);
+            return (lhs->GetSlot().index < rhs->GetSlot().index);
+        }
+    );
+    queries.erase(std::unique(queries.begin(), queries.end()), queries.end());
+
+    /* Resolve each range of consecutive queries with the same native type into the readback buffer of their query heap */
+    for (std::size_t i = 0, n = queries.size(); i < n;)
+    {
+        const auto& slot        = queries[i]->GetSlot();
+        const auto  nativeType  = queries[i]->GetNativeType();
+        auto        numQueries  = slot.count;
+
+        std::size_t next = i + 1;
+        for (; next < n; ++next)
+        {
+            const auto& nextSlot = queries[next]->GetSlot();
+            if (nextSlot.block != slot.block || nextSlot.index != slot.index + numQueries || queries[next]->GetNativeType() != nativeType)
+                break;
+            numQueries += nextSlot.count;
+        }
+
+        commandList_->ResolveQueryData(
+            slot.block->queryHeap.Get(),
+            nativeType,
+            slot.index,
+            numQueries,
+            slot.block->readbackBuffer.Get(),
+            static_cast<UINT64>(slot.index) * slot.block->resultSize
+        );
+
+        i = next;
+    }
+}
+
+void D3D12CommandBuffer::SignalQueries()
+{
+    if (pendingQueries_.empty())
+        return;
+
+    /* Results are available once the GPU has crossed the next fence value, which also waits for the compute and GPU node queues */
+    auto fenceValue = renderSystem_.SignalFenceValue();
+    for (auto query : pendingQueries_)
+        query->SetSubmitted(fenceValue, timestampFrequency_);
+
+    /* Deferred command buffers keep their queries until they are reset, since they can be submitted several times */
+    if (!deferred_)
+        pendingQueries_.clear();
+}
+
+ID3D12GraphicsCommandList* D3D12CommandBuffer::FinishCommandList()
+{
+    if (!deferred_)
+        return nullptr;
+
+    if (!closed_)
+    {
+        /* Close graphics command list, so it can be executed */
+        FinishQueries();
+        RestoreResourceStates();
+        barrierBatch_.Finish(commandList_.Get());
+        auto hr = commandList_->Close();
+        DXThrowIfFailed(hr, "failed to close D3D12 command list");
+        closed_ = true;
+    }
+
+    return commandList_.Get();
 }
 
 
@@ -342,11 +1449,66 @@ void D3D12CommandBuffer::ResetCommandList(ID3D12CommandAllocator* commandAlloc,
  * ======= Private: =======
  */
 
+void D3D12CommandBuffer::AssertNotBundle(const char* command) const
+{
+    if (bundle_)
+        throw std::runtime_error(std::string("cannot record command '") + command + "' in D3D12 command buffer with 'CommandBufferFlags::Bundle'");
+}
+
+bool D3D12CommandBuffer::IsQueryResultAvailable(const D3D12Query& query) const
+{
+    return (query.GetFenceValue() != 0 && renderSystem_.IsFenceValueCompleted(query.GetFenceValue()));
+}
+
 void D3D12CommandBuffer::CreateDevices(D3D12RenderSystem& renderSystem)
 {
-    /* Create command allocator and graphics command list */
-    commandAlloc_   = renderSystem.CreateDXCommandAllocator();
-    commandList_    = renderSystem.CreateDXCommandList(commandAlloc_.Get());
+    /* Create command allocator and command list (compute command list for the compute queue, or bundle) for the GPU node */
+    auto commandListType    = (bundle_ ? D3D12_COMMAND_LIST_TYPE_BUNDLE : asyncCompute_ ? D3D12_COMMAND_LIST_TYPE_COMPUTE : D3D12_COMMAND_LIST_TYPE_DIRECT);
+    auto nodeMask           = renderSystem.GetNodeMask(nodeIndex_);
+    commandAlloc_           = renderSystem.CreateDXCommandAllocator(commandListType);
+    commandList_            = renderSystem.CreateDXCommandList(commandAlloc_.Get(), commandListType, nodeMask);
+    commandAllocCurrent_    = commandAlloc_.Get();
+
+    /* Store timestamp frequency of the command queue this command buffer is executed on (fails if timestamps are not supported by the queue) */
+    auto commandQueue = (asyncCompute_ ? renderSystem.GetComputeQueue() : renderSystem.GetNodeQueue(nodeIndex_));
+    if (FAILED(commandQueue->GetTimestampFrequency(&timestampFrequency_)))
+        timestampFrequency_ = 0;
+
+    /* Query command list interface for variable-rate shading (not available for compute command lists and bundles) */
+    const auto& caps = renderSystem.GetRenderingCaps();
+    if (caps.hasVariableRateShading && !asyncCompute_ && !bundle_)
+    {
+        if (SUCCEEDED(commandList_.As(&commandList5_)))
+            hasShadingRateImage_ = caps.hasShadingRateImage;
+    }
+
+    /* Query command list interface for the depth-bounds test (not available for compute command lists and bundles) */
+    if (caps.hasDepthBoundsTest && !asyncCompute_ && !bundle_)
+        commandList_.As(&commandList1_);
+
+    /* Query command list interface for mesh shaders (not available for compute command lists) */
+    if (caps.hasMeshShaders && !asyncCompute_)
+        commandList_.As(&commandList6_);
+
+    /* Create shader-visible descriptor heaps with one segment per frame in flight (these can only be used by a single node) */
+    auto device = renderSystem.GetDevice();
+
+    cbvSrvUavHeapAlloc_ = MakeUnique<D3D12DescriptorHeapAllocator>(
+        device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, g_numCbvSrvUavDescriptorsPerFrame, maxNumDescriptorFrames, nodeMask
+    );
+    samplerHeapAlloc_ = MakeUnique<D3D12DescriptorHeapAllocator>(
+        device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, g_numSamplerDescriptorsPerFrame, maxNumDescriptorFrames, nodeMask
+    );
+
+    InitMemory(srvDescHandles_);
+    InitMemory(cbvDescHandles_);
+    InitMemory(cbvRangeDescs_);
+    InitMemory(cbvAddresses_);
+    InitMemory(cbvBuffers_);
+    InitMemory(cbvVersions_);
+    InitMemory(uavDescHandles_);
+
+    SetDescriptorHeaps(commandList_.Get());
 }
 
 void D3D12CommandBuffer::InitStateManager(int initialViewportWidth, int initialViewportHeight)
@@ -376,11 +1538,250 @@ void D3D12CommandBuffer::SetBackBufferRTV(D3D12RenderContext& renderContextD3D)
     commandList_->OMSetRenderTargets(1, &rtvDescHandle_, FALSE, nullptr);
 }
 
-void D3D12CommandBuffer::SubmitPersistentStates()
+void D3D12CommandBuffer::SubmitRenderTarget()
+{
+    boundRenderTarget_->TransitionAttachments(barrierBatch_, true);
+
+    const auto& rtvDescHandles = boundRenderTarget_->GetRTVDescHandles();
+    commandList_->OMSetRenderTargets(
+        static_cast<UINT>(rtvDescHandles.size()),
+        rtvDescHandles.data(),
+        FALSE,
+        boundRenderTarget_->GetDSVDescHandle()
+    );
+}
+
+void D3D12CommandBuffer::UnbindRenderTarget()
+{
+    if (boundRenderTarget_)
+    {
+        boundRenderTarget_->TransitionAttachments(barrierBatch_, false);
+        boundRenderTarget_ = nullptr;
+    }
+}
+
+void D3D12CommandBuffer::FlushGraphicsState()
+{
+    barrierBatch_.Flush(commandList_.Get());
+
+    /* Submit all dirty states; a new root signature invalidates all root arguments, so root CBVs and descriptor table must be submitted again */
+    if (stateMngr_.FlushGraphicsState(commandList_.Get()))
+    {
+        descTableDirty_ = true;
+        rootCBVsDirty_  = true;
+    }
+    UpdateConstantBufferVersions();
+    SubmitRootConstantBuffers();
+    SubmitDescriptorTable();
+}
+
+void D3D12CommandBuffer::FlushComputeState()
+{
+    barrierBatch_.Flush(commandList_.Get());
+
+    /* A new compute root signature invalidates all compute root arguments */
+    if (stateMngr_.FlushComputeState(commandList_.Get()))
+    {
+        descTableDirty_ = true;
+        rootCBVsDirty_  = true;
+    }
+    UpdateConstantBufferVersions();
+    SubmitRootConstantBuffers();
+    SubmitDescriptorTable();
+}
+
+void D3D12CommandBuffer::SetPipelineLayout(const D3D12PipelineLayout& layout, bool compute)
+{
+    /* Store descriptor table layout of the new root signature */
+    auto numSRV = std::min(layout.GetNumSRV(), static_cast<UINT>(maxNumSRVSlots));
+    auto numCBV = std::min(layout.GetNumCBV(), static_cast<UINT>(maxNumCBVSlots));
+    auto numUAV = std::min(layout.GetNumUAV(), static_cast<UINT>(maxNumUAVSlots));
+
+    auto numRootCBV         = std::min(layout.GetNumRootCBV(), static_cast<UINT>(maxNumCBVSlots));
+    auto rootCBVParameter   = layout.GetRootCBVParameter();
+    auto descTableParameter = layout.GetDescriptorTableParameter();
+
+    /* Graphics and compute root arguments are separate states, so all root arguments must be submitted again when the pipeline type changes */
+    if (numSRV_ != numSRV || numCBV_ != numCBV || numUAV_ != numUAV || descTableParameter_ != descTableParameter || computeLayout_ != compute)
+    {
+        numSRV_             = numSRV;
+        numCBV_             = numCBV;
+        numUAV_             = numUAV;
+        descTableParameter_ = descTableParameter;
+        descTableDirty_     = true;
+    }
+
+    if (numRootCBV_ != numRootCBV || rootCBVParameter_ != rootCBVParameter || computeLayout_ != compute)
+    {
+        numRootCBV_         = numRootCBV;
+        rootCBVParameter_   = rootCBVParameter;
+        rootCBVsDirty_      = true;
+    }
+
+    computeLayout_ = compute;
+
+    /* Store root constants layout for the push constants */
+    pushConstantsParameter_ = layout.GetPushConstantsParameter();
+    numPushConstants_       = layout.GetNumPushConstants();
+}
+
+void D3D12CommandBuffer::SetDescriptorHeaps(ID3D12GraphicsCommandList* commandList)
+{
+    ID3D12DescriptorHeap* descHeaps[2] =
+    {
+        cbvSrvUavHeapAlloc_->GetDescriptorHeap(),
+        samplerHeapAlloc_->GetDescriptorHeap(),
+    };
+    commandList->SetDescriptorHeaps(2, descHeaps);
+}
+
+void D3D12CommandBuffer::SubmitShadingRate()
+{
+    const D3D12_SHADING_RATE_COMBINER combiners[D3D12_RS_SET_SHADING_RATE_COMBINER_COUNT] =
+    {
+        D3D12_SHADING_RATE_COMBINER_PASSTHROUGH,    // per-primitive rate is not used
+        D3D12_SHADING_RATE_COMBINER_MAX,            // coarser rate of per-draw rate and shading rate image
+    };
+    commandList5_->RSSetShadingRate(shadingRate_, combiners);
+}
+
+void D3D12CommandBuffer::SubmitShadingRateImage()
 {
-    /* Submit all constistent states: viewports, scissors */
-    stateMngr_.SubmitViewports(commandList_.Get());
-    stateMngr_.SubmitScissors(commandList_.Get());
+    if (shadingRateImage_)
+        barrierBatch_.Transition(shadingRateImage_, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
+    if (hasShadingRateImage_)
+        commandList5_->RSSetShadingRateImage(shadingRateImage_);
+}
+
+void D3D12CommandBuffer::SubmitDescriptorTable()
+{
+    if (!descTableDirty_)
+        return;
+
+    descTableDirty_ = false;
+
+    const auto numDescriptors = numSRV_ + numCBV_ + numUAV_;
+    if (numDescriptors == 0)
+        return;
+
+    /* Allocate new descriptor table in the shader-visible heap */
+    D3D12_CPU_DESCRIPTOR_HANDLE cpuDescHandle;
+    D3D12_GPU_DESCRIPTOR_HANDLE gpuDescHandle;
+    cbvSrvUavHeapAlloc_->Allocate(numDescriptors, cpuDescHandle, gpuDescHandle);
+
+    /* Copy all bound descriptors in the order of the root signature ranges: SRVs, CBVs, UAVs */
+    auto device     = renderSystem_.GetDevice();
+    auto descSize   = cbvSrvUavHeapAlloc_->GetDescriptorSize();
+
+    auto CopyDescriptors = [&](const D3D12_CPU_DESCRIPTOR_HANDLE* srcDescHandles, UINT count)
+    {
+        for (UINT i = 0; i < count; ++i)
+        {
+            if (srcDescHandles[i].ptr != 0)
+                device->CopyDescriptorsSimple(1, cpuDescHandle, srcDescHandles[i], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+            cpuDescHandle.ptr += descSize;
+        }
+    };
+
+    CopyDescriptors(srvDescHandles_, numSRV_);
+
+    /* Constant buffer ranges have no pre-resolved descriptor, so their CBVs are created in place */
+    for (UINT i = 0; i < numCBV_; ++i)
+    {
+        if (cbvRangeDescs_[i].SizeInBytes != 0)
+            device->CreateConstantBufferView(&cbvRangeDescs_[i], cpuDescHandle);
+        else if (cbvDescHandles_[i].ptr != 0)
+            device->CopyDescriptorsSimple(1, cpuDescHandle, cbvDescHandles_[i], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        cpuDescHandle.ptr += descSize;
+    }
+
+    CopyDescriptors(uavDescHandles_, numUAV_);
+
+    if (computeLayout_)
+        commandList_->SetComputeRootDescriptorTable(descTableParameter_, gpuDescHandle);
+    else
+        commandList_->SetGraphicsRootDescriptorTable(descTableParameter_, gpuDescHandle);
+}
+
+void D3D12CommandBuffer::SubmitRootConstantBuffers()
+{
+    if (!rootCBVsDirty_)
+        return;
+
+    rootCBVsDirty_ = false;
+
+    /* Root CBVs only take the GPU virtual address, so no descriptors must be copied */
+    for (UINT i = 0; i < numRootCBV_; ++i)
+    {
+        if (cbvAddresses_[i] == 0)
+            continue;
+        if (computeLayout_)
+            commandList_->SetComputeRootConstantBufferView(rootCBVParameter_ + i, cbvAddresses_[i]);
+        else
+            commandList_->SetGraphicsRootConstantBufferView(rootCBVParameter_ + i, cbvAddresses_[i]);
+    }
+}
+
+void D3D12CommandBuffer::UpdateConstantBufferVersions()
+{
+    /*
+    Dynamic constant buffers move to a new version with every update, so a buffer that has been bound before it was updated
+    must refer to the new version from now on; previous draw commands keep referring to the previous version
+    */
+    const auto numSlots = std::max(numRootCBV_, numCBV_);
+    for (UINT i = 0; i < numSlots; ++i)
+    {
+        auto constantBuffer = cbvBuffers_[i];
+        if (constantBuffer != nullptr && cbvVersions_[i] != constantBuffer->GetVersion())
+        {
+            cbvAddresses_[i] = constantBuffer->GetGPUVirtualAddress();
+            cbvVersions_[i] = constantBuffer->GetVersion();
+            if (i < numRootCBV_)
+                rootCBVsDirty_ = true;
+            else
+                descTableDirty_ = true;
+        }
+    }
+}
+
+void D3D12CommandBuffer::ExecuteIndirect(
+    ID3D12CommandSignature* cmdSignature,
+    UINT                    signatureStride,
+    Buffer&                 buffer,
+    unsigned int            offset,
+    unsigned int            numCommands,
+    unsigned int            stride)
+{
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+
+    /*
+    Transition argument buffer into the indirect argument state, unless its usage state already includes it (e.g. buffers in the upload heap).
+    The transition back is kept in the batch, so it is merged with the transition of a following indirect command on the same buffer.
+    Bundles cannot record barriers, so the argument buffer must already be in a suitable state when a bundle is executed.
+    */
+    const auto usageState = bufferD3D.GetUsageState();
+    const bool transitionBuffer = (!bundle_ && (usageState & D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT) == 0);
+
+    if (transitionBuffer)
+    {
+        barrierBatch_.Transition(bufferD3D.Get(), usageState, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT);
+        barrierBatch_.Flush(commandList_.Get());
+    }
+
+    if (stride == signatureStride)
+    {
+        /* Submit all commands at once */
+        commandList_->ExecuteIndirect(cmdSignature, numCommands, bufferD3D.Get(), offset, nullptr, 0);
+    }
+    else
+    {
+        /* Submit each command separately, since the stride of a command signature is immutable */
+        for (; numCommands-- > 0; offset += stride)
+            commandList_->ExecuteIndirect(cmdSignature, 1, bufferD3D.Get(), offset, nullptr, 0);
+    }
+
+    if (transitionBuffer)
+        barrierBatch_.Transition(bufferD3D.Get(), D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT, usageState);
 }
 
 
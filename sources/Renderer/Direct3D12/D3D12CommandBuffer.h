@@ -14,6 +14,10 @@
 #include "../DXCommon/ComPtr.h"
 #include "../DXCommon/DXCore.h"
 #include "RenderState/D3D12StateManager.h"
+#include "D3D12DescriptorHeapAllocator.h"
+#include "D3D12ResourceBarrierBatch.h"
+#include <memory>
+#include <vector>
 
 #include <d3d12.h>
 #include <dxgi1_4.h>
@@ -25,15 +29,20 @@ namespace LLGL
 
 class D3D12RenderSystem;
 class D3D12RenderContext;
+class D3D12RenderTarget;
+class D3D12Fence;
+class D3D12PipelineLayout;
+class D3D12ConstantBuffer;
+class D3D12Query;
 
-class D3D12CommandBuffer : public CommandBuffer
+class D3D12CommandBuffer final : public CommandBuffer
 {
 
     public:
 
         /* ----- Common ----- */
 
-        D3D12CommandBuffer(D3D12RenderSystem& renderSystem);
+        D3D12CommandBuffer(D3D12RenderSystem& renderSystem, const CommandBufferDescriptor& desc);
 
         /* ----- Configuration ----- */
 
@@ -45,6 +54,11 @@ class D3D12CommandBuffer : public CommandBuffer
         void SetScissor(const Scissor& scissor) override;
         void SetScissorArray(unsigned int numScissors, const Scissor* scissorArray) override;
 
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetDepthBounds(float minDepth, float maxDepth) override;
+
         void SetClearColor(const ColorRGBAf& color) override;
         void SetClearDepth(float depth) override;
         void SetClearStencil(int stencil) override;
@@ -54,23 +68,30 @@ class D3D12CommandBuffer : public CommandBuffer
 
         /* ----- Buffers ------ */
 
-        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer, unsigned int offset = 0) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
-        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer, unsigned int offset = 0) override;
         
         void SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         
         void SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
 
+        void ResetBufferCounter(Buffer& buffer, unsigned int value = 0) override;
+        void CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer) override;
+
         void SetStreamOutputBuffer(Buffer& buffer) override;
         void SetStreamOutputBufferArray(BufferArray& bufferArray) override;
 
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Textures ----- */
 
         void SetTexture(Texture& texture, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
@@ -81,6 +102,10 @@ class D3D12CommandBuffer : public CommandBuffer
         void SetSampler(Sampler& sampler, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
 
+        /* ----- Resource Heaps ----- */
+
+        void SetResourceHeap(ResourceHeap& resourceHeap) override;
+
         /* ----- Resource Views ----- */
 
         //void SetResourceViewHeaps(unsigned int numHeaps, ResourceViewHeap* const * heapArray);
@@ -90,21 +115,43 @@ class D3D12CommandBuffer : public CommandBuffer
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        /* ----- Render Passes ----- */
+
+        void BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc) override;
+        void BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc) override;
+
+        void EndRenderPass() override;
+
         /* ----- Pipeline States ----- */
 
         void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
         void SetComputePipeline(ComputePipeline& computePipeline) override;
 
+        void SetPushConstants(unsigned int offset, unsigned int size, const void* data) override;
+
+        void SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances) override;
+
         /* ----- Queries ----- */
 
         void BeginQuery(Query& query) override;
         void EndQuery(Query& query) override;
 
         bool QueryResult(Query& query, std::uint64_t& result) override;
+        bool QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results) override;
+        bool QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result) override;
+
+        void ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset) override;
 
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size) override;
+        void CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType) override;
+
         /* ----- Drawing ----- */
 
         void Draw(unsigned int numVertices, unsigned int firstVertex) override;
@@ -119,12 +166,34 @@ class D3D12CommandBuffer : public CommandBuffer
         void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset) override;
         void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset) override;
 
+        void DrawIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ) override;
+        void DispatchIndirect(Buffer& buffer, unsigned int offset) override;
+
+        void Barrier(long barrierFlags) override;
+        void StorageBarrier(Buffer& buffer) override;
+
+        /* ----- Command Recording ----- */
+
+        void Execute(CommandBuffer& deferredCommandBuffer) override;
+
+        void Reset() override;
 
         /* ----- Misc ----- */
 
+        void Signal(Fence& fence) override;
+
         void SyncGPU() override;
 
         /* ----- Extended functions ----- */
@@ -136,9 +205,83 @@ class D3D12CommandBuffer : public CommandBuffer
 
         void ResetCommandList(ID3D12CommandAllocator* commandAlloc, ID3D12PipelineState* pipelineState);
 
+        // Adds a resource transition to the barrier batch, which is submitted before the next command that depends on it.
+        void TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter);
+
+        // Submits all pending resource barriers. Must be called before the command list is closed or a command depends on the barriers.
+        void FlushResourceBarriers();
+
+        // Transitions the resources that are bound as command list state (i.e. the shading rate image and render target attachments) back to their default states. Must be called before the command list is closed.
+        void RestoreResourceStates();
+
+        // Resets the shader-visible descriptor heaps to the segment of the specified frame in flight. The GPU must have finished that frame.
+        void ResetDescriptorHeaps(UINT frameInFlight);
+
+        /**
+        \brief Closes the command list of this deferred command buffer and returns it.
+        \remarks The command list is only closed once, so it can be executed several times until "Reset" is called.
+        Returns null if this is an immediate command buffer.
+        */
+        ID3D12GraphicsCommandList* FinishCommandList();
+
+        // Returns true if fences have been signaled or queries have been ended in this deferred command buffer since the last reset.
+        inline bool HasSignalFences() const
+        {
+            return (!signalFences_.empty() || !pendingQueries_.empty());
+        }
+
+        /*
+        Signals all fences of this deferred command buffer on the command queue this command buffer is executed on.
+        Must be called each time the command list has been executed, i.e. the fences are signaled after the entire command list.
+        This also signals the fence value the results of all queries of this command list are available with.
+        */
+        void SignalFences();
+
+        // Stores the fence value of the last submission of this deferred command buffer, which "Reset" waits for before the command allocator is reset.
+        inline void SetSubmitFence(ID3D12Fence* fence, UINT64 fenceValue)
+        {
+            submitFence_        = fence;
+            submitFenceValue_   = fenceValue;
+        }
+
+        // Resolves the results of all queries that have been ended in this command list into their readback buffers. Must be called before the command list is closed.
+        void FinishQueries();
+
+        // Signals the fence value the results of all queries of the submitted command list are available with. Must be called after the command list has been executed.
+        void SignalQueries();
+
+        // Returns true if this command buffer was created with the CommandBufferFlags::DeferredSubmit flag.
+        inline bool IsDeferred() const
+        {
+            return deferred_;
+        }
+
+        // Returns true if this command buffer records a compute command list for the compute queue (see CommandBufferFlags::AsyncCompute).
+        inline bool IsAsyncCompute() const
+        {
+            return asyncCompute_;
+        }
+
+        // Returns true if this command buffer records a bundle that is executed within other command lists (see CommandBufferFlags::Bundle).
+        inline bool IsBundle() const
+        {
+            return bundle_;
+        }
+
+        // Returns the index of the GPU node this command buffer is executed on (see CommandBufferDescriptor::nodeIndex).
+        inline UINT GetNodeIndex() const
+        {
+            return nodeIndex_;
+        }
+
     private:
 
-        static const UINT maxNumBuffers = 3;
+        static const UINT maxNumBuffers             = 3;
+
+        static const UINT maxNumDescriptorFrames    = 3;
+        static const UINT maxNumSRVSlots            = 32;
+        static const UINT maxNumCBVSlots            = 14;
+        static const UINT maxNumUAVSlots            = 8;
 
         void CreateDevices(D3D12RenderSystem& renderSystem);
         void InitStateManager(int initialViewportWidth, int initialViewportHeight);
@@ -146,20 +289,123 @@ class D3D12CommandBuffer : public CommandBuffer
         // Sets the current back buffer as render target view.
         void SetBackBufferRTV(D3D12RenderContext& renderContextD3D);
 
-        void SubmitPersistentStates();
+        // Transitions the attachments of the bound render target into their output-merger states and binds its views to the command list.
+        void SubmitRenderTarget();
 
-        ComPtr<ID3D12CommandAllocator>      commandAlloc_;
-        ComPtr<ID3D12GraphicsCommandList>   commandList_;
+        // Transitions the attachments of the bound render target back into the shader-resource state and unbinds it.
+        void UnbindRenderTarget();
+
+        // Records the bundle of the specified command buffer into this command list.
+        void ExecuteBundle(D3D12CommandBuffer& bundleCommandBuffer);
+
+        // Throws an exception if this command buffer records a bundle, in which the specified command is not allowed.
+        void AssertNotBundle(const char* command) const;
 
-        D3D12_CPU_DESCRIPTOR_HANDLE         rtvDescHandle_;
+        // Returns true if the GPU has crossed the fence value the resolved result of the specified query is available with.
+        bool IsQueryResultAvailable(const D3D12Query& query) const;
 
-        //UINT64                              fenceValues_[maxNumBuffers] = { 0 };
+        // Submits all dirty states of the state manager, the root CBVs, and the descriptor table before a draw command.
+        void FlushGraphicsState();
+
+        // Submits the compute root signature, pipeline state, root CBVs, and descriptor table before a dispatch command.
+        void FlushComputeState();
+
+        // Stores the descriptor table, root CBVs, and root constants layout of the specified graphics or compute pipeline.
+        void SetPipelineLayout(const D3D12PipelineLayout& layout, bool compute);
+
+        // Binds the shader-visible descriptor heaps of this command buffer to the specified command list.
+        void SetDescriptorHeaps(ID3D12GraphicsCommandList* commandList);
+
+        // Submits the per-draw shading rate, which is combined with the shading rate image by taking the coarser rate.
+        void SubmitShadingRate();
+
+        // Transitions the shading rate image into its source state and binds it to the command list.
+        void SubmitShadingRateImage();
+
+        // Copies all bound descriptors into a new descriptor table and binds it to the graphics or compute root signature (if the bindings have changed).
+        void SubmitDescriptorTable();
+
+        // Binds the GPU virtual addresses of all constant buffers that are bound as root CBVs (if the bindings have changed).
+        void SubmitRootConstantBuffers();
+
+        // Re-reads the GPU virtual addresses of all bound constant buffers that have been updated with a new version since they were bound.
+        void UpdateConstantBufferVersions();
+
+        // Executes indirect commands with the specified command signature and falls back to single commands if the stride does not match the signature.
+        void ExecuteIndirect(
+            ID3D12CommandSignature* cmdSignature,
+            UINT                    signatureStride,
+            Buffer&                 buffer,
+            unsigned int            offset,
+            unsigned int            numCommands,
+            unsigned int            stride
+        );
+
+        D3D12RenderSystem&                  renderSystem_;
+
+        ComPtr<ID3D12CommandAllocator>      commandAlloc_;
+        ComPtr<ID3D12GraphicsCommandList>   commandList_;
+        ComPtr<ID3D12GraphicsCommandList1>  commandList1_;              // only if the depth-bounds test is supported
+        ComPtr<ID3D12GraphicsCommandList5>  commandList5_;              // only if variable-rate shading is supported
+        ComPtr<ID3D12GraphicsCommandList6>  commandList6_;              // only if mesh shaders are supported
+        ID3D12CommandAllocator*             commandAllocCurrent_        = nullptr;
+
+        D3D12_CPU_DESCRIPTOR_HANDLE         rtvDescHandle_;             // back buffer RTV of the bound render context
+        D3D12RenderTarget*                  boundRenderTarget_          = nullptr;
+        ID3D12Resource*                     renderPassColorBuffer_      = nullptr;
+        AttachmentStoreOp                   renderPassColorStoreOp_     = AttachmentStoreOp::Store;
+        D3D12RenderTarget*                  renderPassTarget_           = nullptr;
+        RenderPassDescriptor                renderPassDesc_;            // operations of the render pass with "renderPassTarget_"
+
+        std::unique_ptr<D3D12DescriptorHeapAllocator> cbvSrvUavHeapAlloc_;
+        std::unique_ptr<D3D12DescriptorHeapAllocator> samplerHeapAlloc_;
+
+        D3D12_CPU_DESCRIPTOR_HANDLE         srvDescHandles_[maxNumSRVSlots];
+        D3D12_CPU_DESCRIPTOR_HANDLE         cbvDescHandles_[maxNumCBVSlots];
+        D3D12_CONSTANT_BUFFER_VIEW_DESC     cbvRangeDescs_[maxNumCBVSlots];
+        D3D12_GPU_VIRTUAL_ADDRESS           cbvAddresses_[maxNumCBVSlots];
+        const D3D12ConstantBuffer*          cbvBuffers_[maxNumCBVSlots];        // null for constant buffer ranges, which are not versioned
+        UINT64                              cbvVersions_[maxNumCBVSlots];
+        D3D12_CPU_DESCRIPTOR_HANDLE         uavDescHandles_[maxNumUAVSlots];
+
+        UINT                                numSRV_                     = 0;
+        UINT                                numCBV_                     = 0;
+        UINT                                numUAV_                     = 0;
+        UINT                                numRootCBV_                 = 0;
+        UINT                                rootCBVParameter_           = 0;
+        UINT                                descTableParameter_         = 0;
+        bool                                descTableDirty_             = false;
+        bool                                rootCBVsDirty_              = false;
+        bool                                computeLayout_              = false;    // descriptor table and root CBVs are bound to the compute root signature
+
+        UINT                                pushConstantsParameter_     = 0;
+        UINT                                numPushConstants_           = 0;
 
         D3D12StateManager                   stateMngr_;
+        D3D12ResourceBarrierBatch           barrierBatch_;
         D3DClearState                       clearState_;
 
+        D3D12_SHADING_RATE                  shadingRate_                = D3D12_SHADING_RATE_1X1;
+        ID3D12Resource*                     shadingRateImage_           = nullptr;
+        bool                                hasShadingRateImage_        = false;
+
+        FLOAT                               depthBounds_[2]             = { 0.0f, 1.0f };
+
         bool                                disableAutoStateSubmission_ = false;
 
+        std::vector<D3D12Fence*>            signalFences_;              // only for deferred command buffers
+        ID3D12Fence*                        submitFence_                = nullptr; // fence of the command queue of the last submission (only for deferred command buffers)
+        UINT64                              submitFenceValue_           = 0;
+
+        std::vector<D3D12Query*>            pendingQueries_;            // queries that have been ended since the last submission (or reset for deferred command buffers)
+        UINT64                              timestampFrequency_         = 0;
+
+        bool                                deferred_                   = false;
+        bool                                asyncCompute_               = false;
+        bool                                bundle_                     = false;
+        bool                                closed_                     = false;
+        UINT                                nodeIndex_                  = 0;
+
 };
 
 
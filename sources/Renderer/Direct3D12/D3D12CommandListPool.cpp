@@ -0,0 +1,105 @@
+/*
+ * D3D12CommandListPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12CommandListPool.h"
+#include "../DXCommon/DXCore.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+D3D12CommandListPool::D3D12CommandListPool(ID3D12Device* device) :
+    device_ { device }
+{
+}
+
+D3D12CommandContext D3D12CommandListPool::AcquireCommandList(D3D12_COMMAND_LIST_TYPE type)
+{
+    if (static_cast<UINT>(type) >= numCommandListTypes)
+        throw std::invalid_argument("cannot acquire D3D12 command list of unknown type");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto& freeLists = freeLists_[type];
+    if (freeLists.empty())
+    {
+        /* Create new command allocator and command list outside the lock, which is the expensive part */
+        lock.unlock();
+        return CreateCommandList(type);
+    }
+
+    /* Reuse command list whose allocator has already been reset */
+    auto context = std::move(freeLists.back());
+    freeLists.pop_back();
+    lock.unlock();
+
+    auto hr = context.commandList->Reset(context.commandAlloc.Get(), nullptr);
+    DXThrowIfFailed(hr, "failed to reset D3D12 command list");
+
+    return context;
+}
+
+void D3D12CommandListPool::ReleaseCommandList(D3D12_COMMAND_LIST_TYPE type, D3D12CommandContext&& context)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    releasedLists_.push_back({ std::move(context), type, 0 });
+}
+
+void D3D12CommandListPool::Submit(UINT64 fenceValue)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : releasedLists_)
+    {
+        entry.fenceValue = fenceValue;
+        pendingLists_.push_back(std::move(entry));
+    }
+    releasedLists_.clear();
+}
+
+void D3D12CommandListPool::Reclaim(UINT64 completedFenceValue)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!pendingLists_.empty() && pendingLists_.front().fenceValue <= completedFenceValue)
+    {
+        /* Reset command allocator, now that the GPU no longer executes the commands it holds */
+        auto& entry = pendingLists_.front();
+
+        auto hr = entry.context.commandAlloc->Reset();
+        DXThrowIfFailed(hr, "failed to reset D3D12 command allocator");
+
+        freeLists_[entry.type].push_back(std::move(entry.context));
+        pendingLists_.pop_front();
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+D3D12CommandContext D3D12CommandListPool::CreateCommandList(D3D12_COMMAND_LIST_TYPE type)
+{
+    D3D12CommandContext context;
+
+    auto hr = device_->CreateCommandAllocator(type, IID_PPV_ARGS(context.commandAlloc.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 command allocator");
+
+    /* Command lists are created in the recording state */
+    hr = device_->CreateCommandList(0, type, context.commandAlloc.Get(), nullptr, IID_PPV_ARGS(context.commandList.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 graphics command list");
+
+    return context;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
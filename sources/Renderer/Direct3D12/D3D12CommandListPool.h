@@ -0,0 +1,90 @@
+/*
+ * D3D12CommandListPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_COMMAND_LIST_POOL_H
+#define LLGL_D3D12_COMMAND_LIST_POOL_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+// Command list together with the command allocator it records into.
+struct D3D12CommandContext
+{
+    ComPtr<ID3D12CommandAllocator>      commandAlloc;
+    ComPtr<ID3D12GraphicsCommandList>   commandList;
+};
+
+/*
+Pool of command allocators and command lists for one-shot commands, e.g. the upload commands of the render system.
+Command lists are released right after they have been submitted. All command lists released since the previous call to "Submit"
+are tagged with its fence value, and "Reclaim" resets their allocators once the GPU has crossed that fence value,
+so they can be reused instead of creating new command allocators. There is a separate free list for each command list type.
+All functions are thread safe.
+*/
+class D3D12CommandListPool
+{
+
+    public:
+
+        D3D12CommandListPool(ID3D12Device* device);
+
+        D3D12CommandListPool(const D3D12CommandListPool&) = delete;
+        D3D12CommandListPool& operator = (const D3D12CommandListPool&) = delete;
+
+        // Returns a command list of the specified type in the recording state, whose allocator is no longer in use by the GPU.
+        D3D12CommandContext AcquireCommandList(D3D12_COMMAND_LIST_TYPE type);
+
+        // Returns a command list to the pool. It must have been closed and must not be recorded anymore.
+        void ReleaseCommandList(D3D12_COMMAND_LIST_TYPE type, D3D12CommandContext&& context);
+
+        // Tags all command lists that have been released since the previous call with the specified fence value.
+        void Submit(UINT64 fenceValue);
+
+        // Resets the command allocators of all command lists whose fence value has been completed by the GPU and makes them available again.
+        void Reclaim(UINT64 completedFenceValue);
+
+    private:
+
+        static const UINT numCommandListTypes = 4;
+
+        struct D3D12PendingCommandList
+        {
+            D3D12CommandContext     context;
+            D3D12_COMMAND_LIST_TYPE type;
+            UINT64                  fenceValue;
+        };
+
+        D3D12CommandContext CreateCommandList(D3D12_COMMAND_LIST_TYPE type);
+
+        ID3D12Device*                           device_             = nullptr;
+
+        std::vector<D3D12PendingCommandList>    releasedLists_;     // Released since the previous submit.
+        std::deque<D3D12PendingCommandList>     pendingLists_;      // In flight, ordered by their fence values.
+        std::vector<D3D12CommandContext>        freeLists_[numCommandListTypes];
+
+        std::mutex                              mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,65 @@
+/*
+ * D3D12DescriptorHeapAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12DescriptorHeapAllocator.h"
+#include "../DXCommon/DXCore.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+D3D12DescriptorHeapAllocator::D3D12DescriptorHeapAllocator(
+    ID3D12Device*               device,
+    D3D12_DESCRIPTOR_HEAP_TYPE  type,
+    UINT                        numDescriptorsPerFrame,
+    UINT                        numFrames,
+    UINT                        nodeMask) :
+        numDescriptorsPerFrame_ { numDescriptorsPerFrame },
+        numFrames_              { numFrames              }
+{
+    /* Create shader-visible descriptor heap for all frame segments */
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
+    {
+        heapDesc.Type           = type;
+        heapDesc.NumDescriptors = numDescriptorsPerFrame * numFrames;
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        heapDesc.NodeMask       = nodeMask;
+    }
+    auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(descHeap_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create shader-visible D3D12 descriptor heap");
+
+    descSize_       = device->GetDescriptorHandleIncrementSize(type);
+    cpuHeapStart_   = descHeap_->GetCPUDescriptorHandleForHeapStart();
+    gpuHeapStart_   = descHeap_->GetGPUDescriptorHandleForHeapStart();
+}
+
+void D3D12DescriptorHeapAllocator::Reset(UINT frameIndex)
+{
+    segmentStart_   = (frameIndex % numFrames_) * numDescriptorsPerFrame_;
+    segmentOffset_  = 0;
+}
+
+void D3D12DescriptorHeapAllocator::Allocate(UINT numDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, D3D12_GPU_DESCRIPTOR_HANDLE& gpuDescHandle)
+{
+    if (segmentOffset_ + numDescriptors > numDescriptorsPerFrame_)
+        throw std::runtime_error("out of descriptors in shader-visible D3D12 descriptor heap for the current frame");
+
+    const auto index = segmentStart_ + segmentOffset_;
+    segmentOffset_ += numDescriptors;
+
+    cpuDescHandle.ptr = cpuHeapStart_.ptr + static_cast<SIZE_T>(index) * descSize_;
+    gpuDescHandle.ptr = gpuHeapStart_.ptr + static_cast<UINT64>(index) * descSize_;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,80 @@
+/*
+ * D3D12DescriptorHeapAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_DESCRIPTOR_HEAP_ALLOCATOR_H
+#define LLGL_D3D12_DESCRIPTOR_HEAP_ALLOCATOR_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Linear allocator for descriptor tables within a single shader-visible descriptor heap.
+The heap is divided into one segment per frame in flight, and each segment is reset
+when the GPU has finished the frame that previously used it.
+*/
+class D3D12DescriptorHeapAllocator
+{
+
+    public:
+
+        D3D12DescriptorHeapAllocator(
+            ID3D12Device*               device,
+            D3D12_DESCRIPTOR_HEAP_TYPE  type,
+            UINT                        numDescriptorsPerFrame,
+            UINT                        numFrames,
+            UINT                        nodeMask = 0
+        );
+
+        // Resets the allocator to the segment of the specified frame. All descriptors of that segment must no longer be in use by the GPU.
+        void Reset(UINT frameIndex);
+
+        // Allocates the specified number of contiguous descriptors and returns the CPU and GPU handles to the first one.
+        void Allocate(UINT numDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE& cpuDescHandle, D3D12_GPU_DESCRIPTOR_HANDLE& gpuDescHandle);
+
+        // Returns the shader-visible descriptor heap.
+        inline ID3D12DescriptorHeap* GetDescriptorHeap() const
+        {
+            return descHeap_.Get();
+        }
+
+        // Returns the size (in bytes) of each descriptor within the heap.
+        inline UINT GetDescriptorSize() const
+        {
+            return descSize_;
+        }
+
+    private:
+
+        ComPtr<ID3D12DescriptorHeap>    descHeap_;
+        UINT                            descSize_               = 0;
+
+        D3D12_CPU_DESCRIPTOR_HANDLE     cpuHeapStart_;
+        D3D12_GPU_DESCRIPTOR_HANDLE     gpuHeapStart_;
+
+        UINT                            numDescriptorsPerFrame_ = 0;
+        UINT                            numFrames_              = 0;
+
+        UINT                            segmentStart_           = 0;
+        UINT                            segmentOffset_          = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,79 @@
+/*
+ * D3D12InfoQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12InfoQueue.h"
+#include "../../Core/HelperMacros.h"
+
+
+namespace LLGL
+{
+
+
+D3D12InfoQueue::D3D12InfoQueue(ID3D12Device* device, RenderingDebugger* debugger, std::uint32_t messageLimit) :
+    driverMessages_ { debugger, messageLimit, "Direct3D12" }
+{
+    if (FAILED(device->QueryInterface(IID_PPV_ARGS(infoQueue_.ReleaseAndGetAddressOf()))))
+        LLGL_LOG(Warning, "failed to query D3D12 info queue (the debug layer requires the Graphics Tools of Windows)");
+}
+
+// Determines the category of the specified D3D12 message, or returns false if the message is only informational.
+static bool D3D12GetDriverMessageCategory(const D3D12_MESSAGE& message, DriverMessageCategory& category)
+{
+    switch (message.Severity)
+    {
+        case D3D12_MESSAGE_SEVERITY_CORRUPTION:
+        case D3D12_MESSAGE_SEVERITY_ERROR:
+            category = DriverMessageCategory::Error;
+            return true;
+
+        case D3D12_MESSAGE_SEVERITY_WARNING:
+            /* Warnings about resource hazards and execution are hidden stalls, e.g. resources that are unbound because they are bound as output */
+            if (message.Category == D3D12_MESSAGE_CATEGORY_EXECUTION || message.Category == D3D12_MESSAGE_CATEGORY_RESOURCE_MANIPULATION)
+                category = DriverMessageCategory::Performance;
+            else
+                category = DriverMessageCategory::ImproperUsage;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void D3D12InfoQueue::PostStoredMessages()
+{
+    if (!infoQueue_)
+        return;
+
+    const auto numMessages = infoQueue_->GetNumStoredMessagesAllowedByRetrievalFilter();
+
+    for (UINT64 i = 0; i < numMessages; ++i)
+    {
+        /* Query size of the message, then read the message into the temporary buffer */
+        SIZE_T messageSize = 0;
+        if (FAILED(infoQueue_->GetMessage(i, nullptr, &messageSize)))
+            continue;
+
+        messageBuffer_.resize(messageSize);
+        auto message = reinterpret_cast<D3D12_MESSAGE*>(messageBuffer_.data());
+
+        if (SUCCEEDED(infoQueue_->GetMessage(i, message, &messageSize)))
+        {
+            DriverMessageCategory category;
+            if (D3D12GetDriverMessageCategory(*message, category))
+                driverMessages_.Post(category, static_cast<std::uint32_t>(message->ID), message->pDescription);
+        }
+    }
+
+    infoQueue_->ClearStoredMessages();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,274 @@
+/*
+ * D3D12MemoryAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12MemoryAllocator.h"
+#include "../DXCommon/DXCore.h"
+#include "D3DX12/d3dx12.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+static UINT64 RoundUpToPowerOfTwo(UINT64 x)
+{
+    UINT64 result = 1;
+    while (result < x)
+        result <<= 1;
+    return result;
+}
+
+static UINT Log2(UINT64 x)
+{
+    UINT result = 0;
+    while (x > 1)
+    {
+        x >>= 1;
+        ++result;
+    }
+    return result;
+}
+
+D3D12MemoryAllocator::D3D12MemoryAllocator(ID3D12Device* device, UINT64 blockSize, UINT visibleNodeMask) :
+    device_          { device          },
+    blockSize_       { blockSize       },
+    visibleNodeMask_ { visibleNodeMask }
+{
+    /* Initialize pools for each resource category (MSAA render targets require 4 MB alignment) */
+    pools_[PoolBuffers].heapFlags           = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    pools_[PoolBuffers].heapAlignment       = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    pools_[PoolBuffers].minBlockSize        = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+    pools_[PoolRTDSTextures].heapFlags      = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+    pools_[PoolRTDSTextures].heapAlignment  = D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+    pools_[PoolRTDSTextures].minBlockSize   = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+    pools_[PoolTextures].heapFlags          = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+    pools_[PoolTextures].heapAlignment      = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    pools_[PoolTextures].minBlockSize       = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+}
+
+ComPtr<ID3D12Resource> D3D12MemoryAllocator::CreateResource(
+    const D3D12_RESOURCE_DESC&  desc,
+    D3D12_RESOURCE_STATES       initialState,
+    const D3D12_CLEAR_VALUE*    clearValue,
+    D3D12MemoryRegion&          region)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    ComPtr<ID3D12Resource> resource;
+    region = D3D12MemoryRegion();
+
+    /* Select pool by resource category */
+    UINT poolIndex = PoolTextures;
+    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        poolIndex = PoolBuffers;
+    else if ((desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0)
+        poolIndex = PoolRTDSTextures;
+
+    auto& pool = pools_[poolIndex];
+
+    /* Query allocation size; small textures can be placed with 4 KB instead of 64 KB alignment */
+    auto resDesc = desc;
+    D3D12_RESOURCE_ALLOCATION_INFO allocInfo;
+
+    if (poolIndex == PoolTextures && resDesc.SampleDesc.Count <= 1)
+    {
+        resDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+        allocInfo = device_->GetResourceAllocationInfo(0, 1, &resDesc);
+        if (allocInfo.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+        {
+            resDesc.Alignment = 0;
+            allocInfo = device_->GetResourceAllocationInfo(0, 1, &resDesc);
+        }
+    }
+    else
+        allocInfo = device_->GetResourceAllocationInfo(0, 1, &resDesc);
+
+    /* Buddies are aligned to their size, so the region size also covers the alignment */
+    auto size = RoundUpToPowerOfTwo(std::max({ allocInfo.SizeInBytes, allocInfo.Alignment, pool.minBlockSize }));
+
+    if (size <= blockSize_)
+    {
+        auto order = Log2(size / pool.minBlockSize);
+
+        /* Find heap block with a free buddy of the required order, or allocate a new block */
+        D3D12HeapBlock* block = nullptr;
+        UINT64 offset = 0;
+
+        for (auto& blk : pool.blocks)
+        {
+            if (AllocRegion(*blk, pool, order, offset))
+            {
+                block = blk.get();
+                break;
+            }
+        }
+
+        if (!block)
+        {
+            block = AllocBlock(pool);
+            AllocRegion(*block, pool, order, offset);
+        }
+
+        /* Create placed resource within the region */
+        auto hr = device_->CreatePlacedResource(
+            block->heap.Get(),
+            offset,
+            &resDesc,
+            initialState,
+            clearValue,
+            IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+        );
+
+        if (FAILED(hr))
+            FreeRegion(*block, pool, order, offset);
+
+        DXThrowIfFailed(hr, "failed to create D3D12 placed resource");
+
+        block->allocatedSize += size;
+
+        region.heap     = block->heap.Get();
+        region.offset   = offset;
+        region.size     = size;
+        region.pool     = poolIndex;
+    }
+    else
+    {
+        /* Create committed resource with an implicit heap */
+        CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT, 1, visibleNodeMask_);
+
+        auto hr = device_->CreateCommittedResource(
+            &heapProperties,
+            D3D12_HEAP_FLAG_NONE,
+            &desc,
+            initialState,
+            clearValue,
+            IID_PPV_ARGS(resource.ReleaseAndGetAddressOf())
+        );
+        DXThrowIfFailed(hr, "failed to create D3D12 committed resource");
+    }
+
+    return resource;
+}
+
+void D3D12MemoryAllocator::Free(const D3D12MemoryRegion& region)
+{
+    if (!region.heap)
+        return;
+
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    auto& pool = pools_[region.pool];
+
+    for (auto it = pool.blocks.begin(); it != pool.blocks.end(); ++it)
+    {
+        auto& block = **it;
+        if (block.heap.Get() == region.heap)
+        {
+            FreeRegion(block, pool, Log2(region.size / pool.minBlockSize), region.offset);
+            block.allocatedSize -= region.size;
+
+            /* Release empty heap block, but keep the last one to avoid creating heaps back and forth */
+            if (block.allocatedSize == 0 && pool.blocks.size() > 1)
+                pool.blocks.erase(it);
+
+            break;
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+UINT D3D12MemoryAllocator::GetNumOrders(const D3D12MemoryPool& pool) const
+{
+    return Log2(blockSize_ / pool.minBlockSize) + 1;
+}
+
+D3D12MemoryAllocator::D3D12HeapBlock* D3D12MemoryAllocator::AllocBlock(D3D12MemoryPool& pool)
+{
+    auto block = std::unique_ptr<D3D12HeapBlock>(new D3D12HeapBlock());
+
+    /* Create heap for the entire block */
+    D3D12_HEAP_DESC heapDesc;
+    {
+        heapDesc.SizeInBytes    = blockSize_;
+        heapDesc.Properties     = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT, 1, visibleNodeMask_);
+        heapDesc.Alignment      = pool.heapAlignment;
+        heapDesc.Flags          = pool.heapFlags;
+    }
+    auto hr = device_->CreateHeap(&heapDesc, IID_PPV_ARGS(block->heap.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 heap block");
+
+    /* Initialize free lists with a single buddy of the highest order */
+    block->freeLists.resize(GetNumOrders(pool));
+    block->freeLists.back().insert(0);
+
+    pool.blocks.emplace_back(std::move(block));
+
+    return pool.blocks.back().get();
+}
+
+bool D3D12MemoryAllocator::AllocRegion(D3D12HeapBlock& block, const D3D12MemoryPool& pool, UINT order, UINT64& offset)
+{
+    /* Find smallest free buddy of at least the requested order */
+    auto numOrders = static_cast<UINT>(block.freeLists.size());
+
+    for (auto k = order; k < numOrders; ++k)
+    {
+        auto& freeList = block.freeLists[k];
+        if (!freeList.empty())
+        {
+            offset = *freeList.begin();
+            freeList.erase(freeList.begin());
+
+            /* Split buddy until it has the requested order; the upper halves remain free */
+            while (k > order)
+            {
+                --k;
+                block.freeLists[k].insert(offset + (pool.minBlockSize << k));
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void D3D12MemoryAllocator::FreeRegion(D3D12HeapBlock& block, const D3D12MemoryPool& pool, UINT order, UINT64 offset)
+{
+    auto numOrders = static_cast<UINT>(block.freeLists.size());
+
+    /* Merge with free buddies as long as possible */
+    while (order + 1 < numOrders)
+    {
+        auto buddyOffset = offset ^ (pool.minBlockSize << order);
+
+        auto& freeList = block.freeLists[order];
+        auto it = freeList.find(buddyOffset);
+        if (it == freeList.end())
+            break;
+
+        freeList.erase(it);
+        offset = std::min(offset, buddyOffset);
+        ++order;
+    }
+
+    block.freeLists[order].insert(offset);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
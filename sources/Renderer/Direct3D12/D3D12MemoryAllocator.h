@@ -0,0 +1,116 @@
+/*
+ * D3D12MemoryAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_MEMORY_ALLOCATOR_H
+#define LLGL_D3D12_MEMORY_ALLOCATOR_H
+
+
+#include "../DXCommon/ComPtr.h"
+#include <vector>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+// Region of GPU memory a placed resource has been created in. A region without heap belongs to a committed resource.
+struct D3D12MemoryRegion
+{
+    ID3D12Heap* heap    = nullptr;
+    UINT64      offset  = 0;
+    UINT64      size    = 0;
+    UINT        pool    = 0;
+};
+
+/*
+GPU memory allocator for resources in the default heap.
+Resources are created with "CreatePlacedResource" in large ID3D12Heap blocks, which are suballocated with a buddy allocator.
+Buffers, render-target/depth-stencil textures, and all other textures are allocated from separate pools,
+because heaps of resource heap tier 1 can only hold one of these resource categories.
+Resources that are larger than a heap block are created as committed resources.
+All heaps are created on GPU node 0 and are visible to the GPU nodes of the specified node mask.
+Allocating and freeing memory is synchronized, so resources can be created by several threads.
+*/
+class D3D12MemoryAllocator
+{
+
+    public:
+
+        D3D12MemoryAllocator(ID3D12Device* device, UINT64 blockSize, UINT visibleNodeMask = 1);
+
+        D3D12MemoryAllocator(const D3D12MemoryAllocator&) = delete;
+        D3D12MemoryAllocator& operator = (const D3D12MemoryAllocator&) = delete;
+
+        /*
+        Creates a resource in the default heap and stores the memory region it has been placed in.
+        The region must be passed to "Free" after the resource has been released and the GPU no longer refers to it.
+        */
+        ComPtr<ID3D12Resource> CreateResource(
+            const D3D12_RESOURCE_DESC&  desc,
+            D3D12_RESOURCE_STATES       initialState,
+            const D3D12_CLEAR_VALUE*    clearValue,
+            D3D12MemoryRegion&          region
+        );
+
+        // Returns the specified memory region to its heap block. Empty heap blocks are released, except the last one of each pool.
+        void Free(const D3D12MemoryRegion& region);
+
+    private:
+
+        enum PoolIndex
+        {
+            PoolBuffers = 0,
+            PoolRTDSTextures,
+            PoolTextures,
+
+            NumPools,
+        };
+
+        // Heap block with the free lists of the buddy allocator (one list of offsets per order).
+        struct D3D12HeapBlock
+        {
+            ComPtr<ID3D12Heap>              heap;
+            std::vector<std::set<UINT64>>   freeLists;
+            UINT64                          allocatedSize   = 0;
+        };
+
+        struct D3D12MemoryPool
+        {
+            D3D12_HEAP_FLAGS                                heapFlags       = D3D12_HEAP_FLAG_NONE;
+            UINT64                                          heapAlignment   = 0;
+            UINT64                                          minBlockSize    = 0; // size of the smallest buddy (order 0)
+            std::vector<std::unique_ptr<D3D12HeapBlock>>    blocks;
+        };
+
+        UINT GetNumOrders(const D3D12MemoryPool& pool) const;
+
+        D3D12HeapBlock* AllocBlock(D3D12MemoryPool& pool);
+
+        bool AllocRegion(D3D12HeapBlock& block, const D3D12MemoryPool& pool, UINT order, UINT64& offset);
+        void FreeRegion(D3D12HeapBlock& block, const D3D12MemoryPool& pool, UINT order, UINT64 offset);
+
+        ID3D12Device*   device_             = nullptr;
+        UINT64          blockSize_          = 0;
+        UINT            visibleNodeMask_    = 1;
+        D3D12MemoryPool pools_[NumPools];
+        std::mutex      mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
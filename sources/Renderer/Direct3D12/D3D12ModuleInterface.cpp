@@ -27,9 +27,9 @@ LLGL_EXPORT const char* LLGL_RenderSystem_Name()
     return "Direct3D 12";
 }
 
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc()
+LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const LLGL::RenderSystemDescriptor* renderSystemDesc)
 {
-    return new LLGL::D3D12RenderSystem();
+    return new LLGL::D3D12RenderSystem(*renderSystemDesc);
 }
 
 } // /extern "C"
@@ -36,8 +36,15 @@ D3D12RenderContext::D3D12RenderContext(
     desc_.multiSampling.samples = 1;
     #endif
 
-    /* Setup surface for the render context */
-    SetOrCreateSurface(surface, desc_.videoMode, nullptr);
+    /* Clamp number of frames in flight to the supported range */
+    numFramesInFlight_ = std::max(1u, std::min(desc_.framesInFlight, static_cast<UINT>(maxNumFramesInFlight)));
+
+    /* Setup surface for the render context (without window for a headless render context) */
+    if (desc_.headless)
+        SetHeadlessSurface(desc_.videoMode);
+    else
+        SetOrCreateSurface(surface, desc_.videoMode, nullptr);
+
     CreateWindowSizeDependentResources();
     CreateDeviceResources();
 
@@ -48,46 +55,48 @@ D3D12RenderContext::D3D12RenderContext(
 D3D12RenderContext::~D3D12RenderContext()
 {
     /* Ensure the GPU is no longer referencing resources that are about to be released */
-    MoveToNextFrame();
+    SyncGPU();
+
+    /* Swap chain must be in windowed mode when it is released */
+    if (swapChain_)
+        swapChain_->SetFullscreenState(FALSE, nullptr);
+    if (frameLatencyObject_)
+        CloseHandle(frameLatencyObject_);
 }
 
 void D3D12RenderContext::Present()
 {
-    /* Get command list from command buffer object */
-    if (!commandBuffer_)
-        throw std::runtime_error("can not present framebuffer without D3D12 command allocator and/or command list");
-
-    auto commandList = commandBuffer_->GetCommandList();
-
-    /* Resolve current render target if multi-sampling is used */
-    if (desc_.multiSampling.enabled)
-        ResolveRenderTarget(commandList);
-    else
-    {
-        /* Indicate that the render target will now be used to present when the command list is done executing */
-        TransitionRenderTarget(
-            D3D12_RESOURCE_STATE_RENDER_TARGET,
-            D3D12_RESOURCE_STATE_PRESENT
-        );
-    }
-
-    /* Execute pending command list */
-    renderSystem_.CloseAndExecuteCommandList(commandList);
+    PresentWithInterval(swapChainInterval_);
+}
 
-    /* Present swap-chain with vsync interval */
-    auto hr = swapChain_->Present(swapChainInterval_, 0);
-    DXThrowIfFailed(hr, "failed to present DXGI swap chain");
+void D3D12RenderContext::PresentWithoutVsync()
+{
+    PresentWithInterval(0);
+}
 
-    /* Advance frame counter */
-    MoveToNextFrame();
+void D3D12RenderContext::WaitForNextFrame()
+{
+    /* Pace frames to the target frame rate, then wait until the swap chain can queue another frame */
+    RenderContext::WaitForNextFrame();
+    if (frameLatencyObject_)
+        WaitForSingleObjectEx(frameLatencyObject_, 1000, TRUE);
+}
 
-    /* Reset command allocator and command list*/
-    auto commandAlloc = commandAllocs_[currentFrame_].Get();
+bool D3D12RenderContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    return (swapChain_ ? DXGetFrameStatistics(swapChain_.Get(), stats) : false);
+}
 
-    hr = commandAlloc->Reset();
-    DXThrowIfFailed(hr, "failed to reset D3D12 command allocator");
+bool D3D12RenderContext::IsOccluded() const
+{
+    return (occluded_ || RenderContext::IsOccluded());
+}
 
-    commandBuffer_->ResetCommandList(commandAlloc, nullptr);
+bool D3D12RenderContext::TestPresent()
+{
+    if (swapChain_)
+        occluded_ = (swapChain_->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED);
+    return !IsOccluded();
 }
 
 void D3D12RenderContext::SetVideoMode(const VideoModeDescriptor& videoModeDesc)
@@ -104,7 +113,7 @@ void D3D12RenderContext::SetVideoMode(const VideoModeDescriptor& videoModeDesc)
             CreateWindowSizeDependentResources();
 
         /* Switch fullscreen mode */
-        if (prevVideoMode.fullscreen != videoModeDesc.fullscreen)
+        if (swapChain_ && prevVideoMode.fullscreen != videoModeDesc.fullscreen)
             swapChain_->SetFullscreenState(videoModeDesc.fullscreen ? TRUE : FALSE, nullptr);
     }
 }
@@ -141,12 +150,8 @@ void D3D12RenderContext::SetCommandBuffer(D3D12CommandBuffer* commandBuffer)
 
 void D3D12RenderContext::TransitionRenderTarget(D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter)
 {
-    /* Indicate a transition in the render-target usage and synchronize with the resource barrier */
-    auto resourceBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-        renderTargets_[currentFrame_].Get(),
-        stateBefore, stateAfter
-    );
-    commandBuffer_->GetCommandList()->ResourceBarrier(1, &resourceBarrier);
+    /* Indicate a transition in the render-target usage (submitted with the next batch of resource barriers) */
+    commandBuffer_->TransitionResource(renderTargets_[currentFrame_].Get(), stateBefore, stateAfter);
 }
 
 bool D3D12RenderContext::HasMultiSampling() const
@@ -156,7 +161,7 @@ bool D3D12RenderContext::HasMultiSampling() const
 
 void D3D12RenderContext::SyncGPU()
 {
-    renderSystem_.SyncGPU(fenceValues_[currentFrame_]);
+    renderSystem_.SyncGPU();
 }
 
 
@@ -164,6 +169,65 @@ void D3D12RenderContext::SyncGPU()
  * ======= Private: =======
  */
 
+void D3D12RenderContext::PresentWithInterval(UINT syncInterval)
+{
+    /* Get command list from command buffer object */
+    if (!commandBuffer_)
+        throw std::runtime_error("can not present framebuffer without D3D12 command allocator and/or command list");
+
+    auto commandList = commandBuffer_->GetCommandList();
+
+    /* Resolve current render target if multi-sampling is used */
+    if (desc_.multiSampling.enabled)
+        ResolveRenderTarget(commandList);
+    else
+    {
+        /* Indicate that the render target will now be used to present when the command list is done executing */
+        TransitionRenderTarget(
+            D3D12_RESOURCE_STATE_RENDER_TARGET,
+            D3D12_RESOURCE_STATE_PRESENT
+        );
+    }
+
+    /* Execute pending command list */
+    commandBuffer_->FinishQueries();
+    commandBuffer_->RestoreResourceStates();
+    commandBuffer_->FlushResourceBarriers();
+    renderSystem_.CloseAndExecuteCommandList(commandList);
+    commandBuffer_->SignalQueries();
+
+    /* Present swap-chain with vsync interval */
+    HRESULT hr = 0;
+
+    if (swapChain_)
+    {
+        /* Allow tearing when Vsync is disabled (not allowed in exclusive fullscreen mode) */
+        UINT flags = 0;
+        if (swapChainInterval_ == 0 && tearingSupported_ && !GetVideoMode().fullscreen)
+            flags |= DXGI_PRESENT_ALLOW_TEARING;
+
+        hr = swapChain_->Present(syncInterval, flags);
+        DXThrowIfFailed(hr, "failed to present DXGI swap chain");
+        occluded_ = (hr == DXGI_STATUS_OCCLUDED);
+    }
+
+    /* Post the driver messages of this frame */
+    if (auto infoQueue = renderSystem_.GetInfoQueue())
+        infoQueue->PostStoredMessages();
+
+    /* Advance frame counter */
+    MoveToNextFrame();
+
+    /* Reset command allocator and command list*/
+    auto commandAlloc = commandAllocs_[currentFrameInFlight_].Get();
+
+    hr = commandAlloc->Reset();
+    DXThrowIfFailed(hr, "failed to reset D3D12 command allocator");
+
+    commandBuffer_->ResetDescriptorHeaps(currentFrameInFlight_);
+    commandBuffer_->ResetCommandList(commandAlloc, nullptr);
+}
+
 void D3D12RenderContext::CreateWindowSizeDependentResources()
 {
     /* Wait until all previous GPU work is complete */
@@ -185,7 +249,7 @@ void D3D12RenderContext::CreateWindowSizeDependentResources()
     if (swapChain_)
     {
         /* Resize swap chain */
-        auto hr = swapChain_->ResizeBuffers(numFrames_, framebufferWidth, framebufferHeight, DXGI_FORMAT_B8G8R8A8_UNORM, 0);
+        auto hr = swapChain_->ResizeBuffers(numFrames_, framebufferWidth, framebufferHeight, DXGI_FORMAT_B8G8R8A8_UNORM, swapChainFlags_);
 
         if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
         {
@@ -195,6 +259,11 @@ void D3D12RenderContext::CreateWindowSizeDependentResources()
         else
             DXThrowIfFailed(hr, "failed to resize DXGI swap chain buffers");
     }
+    else if (desc_.headless)
+    {
+        /* Headless render contexts have offscreen render targets instead of a swap chain */
+        numFrames_ = static_cast<UINT>(desc_.videoMode.swapChainMode);
+    }
     else
     {
         /* Setup swap chain meta data */
@@ -204,6 +273,14 @@ void D3D12RenderContext::CreateWindowSizeDependentResources()
         NativeHandle wndHandle;
         GetSurface().GetNativeHandle(&wndHandle);
 
+        /* Setup swap chain flags for tearing and frame latency waitable object */
+        tearingSupported_ = DXIsTearingSupported(renderSystem_.GetDXGIFactory());
+
+        if (tearingSupported_)
+            swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+        if (desc_.maxFrameLatency > 0)
+            swapChainFlags_ |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+
         DXGI_SWAP_CHAIN_DESC1 swapChainDesc;
         InitMemory(swapChainDesc);
         {
@@ -216,13 +293,15 @@ void D3D12RenderContext::CreateWindowSizeDependentResources()
             swapChainDesc.BufferUsage           = DXGI_USAGE_RENDER_TARGET_OUTPUT;
             swapChainDesc.BufferCount           = numFrames_;
             swapChainDesc.SwapEffect            = DXGI_SWAP_EFFECT_FLIP_DISCARD;
-            swapChainDesc.Flags                 = 0;
+            swapChainDesc.Flags                 = swapChainFlags_;
             swapChainDesc.Scaling               = DXGI_SCALING_NONE;
             swapChainDesc.AlphaMode             = DXGI_ALPHA_MODE_IGNORE;
         }
         auto swapChain = renderSystem_.CreateDXSwapChain(swapChainDesc, wndHandle.window);
 
         swapChain.As(&swapChain_);
+
+        SetMaximumFrameLatency();
     }
 
     /* Create RTV descriptor heap */
@@ -246,11 +325,38 @@ void D3D12RenderContext::CreateWindowSizeDependentResources()
     /* Create render targets */
     CD3DX12_CPU_DESCRIPTOR_HANDLE rtvDescHandle(rtvDescHeap_->GetCPUDescriptorHandleForHeapStart());
 
+    auto texture2DDesc = CD3DX12_RESOURCE_DESC::Tex2D(
+        DXGI_FORMAT_B8G8R8A8_UNORM,
+        framebufferWidth,
+        framebufferHeight,
+        1, // arraySize
+        1, // mipLevels
+        1, // sampleCount
+        0,
+        D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET
+    );
+
     for (UINT i = 0; i < numFrames_; ++i)
     {
-        /* Get render target resource from swap-chain buffer */
-        auto hr = swapChain_->GetBuffer(i, IID_PPV_ARGS(renderTargets_[i].ReleaseAndGetAddressOf()));
-        DXThrowIfFailed(hr, "failed to get D3D12 render target " + std::to_string(i) + "/" + std::to_string(numFrames_) + " from swap chain");
+        if (swapChain_)
+        {
+            /* Get render target resource from swap-chain buffer */
+            auto hr = swapChain_->GetBuffer(i, IID_PPV_ARGS(renderTargets_[i].ReleaseAndGetAddressOf()));
+            DXThrowIfFailed(hr, "failed to get D3D12 render target " + std::to_string(i) + "/" + std::to_string(numFrames_) + " from swap chain");
+        }
+        else
+        {
+            /* Create offscreen render target resource, which starts in the same state as a swap-chain buffer */
+            auto hr = device->CreateCommittedResource(
+                &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+                D3D12_HEAP_FLAG_NONE,
+                &texture2DDesc,
+                D3D12_RESOURCE_STATE_PRESENT,
+                nullptr,
+                IID_PPV_ARGS(renderTargets_[i].ReleaseAndGetAddressOf())
+            );
+            DXThrowIfFailed(hr, "failed to create D3D12 offscreen render target " + std::to_string(i) + "/" + std::to_string(numFrames_) + " for headless render context");
+        }
 
         /* Create render target view (RTV) */
         device->CreateRenderTargetView(renderTargets_[i].Get(), nullptr, rtvDescHandle);
@@ -297,58 +403,56 @@ void D3D12RenderContext::CreateWindowSizeDependentResources()
         }
     }
 
-    /*
-    All pending GPU work was already finished;
-    now update tracked fence values to the last value signaled
-    */
-    UpdateFenceValues();
+    /* Buffer indices of the swap-chain start from the beginning after it has been resized */
+    currentFrame_ = (swapChain_ ? swapChain_->GetCurrentBackBufferIndex() : 0);
 }
 
 void D3D12RenderContext::CreateDeviceResources()
 {
-    /* Create command allocators */
-    for (UINT i = 0; i < numFrames_; ++i)
+    /* Create command allocators (one for each frame in flight) */
+    for (UINT i = 0; i < numFramesInFlight_; ++i)
         commandAllocs_[i] = renderSystem_.CreateDXCommandAllocator();
 }
 
-void D3D12RenderContext::UpdateFenceValues()
+void D3D12RenderContext::SetMaximumFrameLatency()
 {
-    /* Update tracked fence values to the last value signaled */
-    for (UINT i = 0; i < numFrames_; ++i)
-        fenceValues_[i] = fenceValues_[currentFrame_];
+    if ((swapChainFlags_ & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) != 0)
+    {
+        /* Set frame latency for this swap chain and get its waitable object */
+        auto hr = swapChain_->SetMaximumFrameLatency(std::min(desc_.maxFrameLatency, 16u));
+        DXThrowIfFailed(hr, "failed to set maximum frame latency of DXGI swap chain");
+        frameLatencyObject_ = swapChain_->GetFrameLatencyWaitableObject();
+    }
 }
 
 void D3D12RenderContext::MoveToNextFrame()
 {
-    /* Schedule signal command into the qeue */
-    auto currentFenceValue = fenceValues_[currentFrame_];
-    renderSystem_.SignalFenceValue(currentFenceValue);
+    /* Schedule signal command into the queue to track when the GPU has finished the current frame */
+    fenceValues_[currentFrameInFlight_] = renderSystem_.SignalFenceValue();
 
-    /* Advance frame index */
-    currentFrame_ = swapChain_->GetCurrentBackBufferIndex();
+    /* Advance frame indices */
+    currentFrameInFlight_   = (currentFrameInFlight_ + 1) % numFramesInFlight_;
+    currentFrame_           = (swapChain_ ? swapChain_->GetCurrentBackBufferIndex() : (currentFrame_ + 1) % numFrames_);
 
-    /* Check to see if the next frame is ready to start */
-    renderSystem_.WaitForFenceValue(fenceValues_[currentFrame_]);
-
-    /* Set fence value for next frame */
-    fenceValues_[currentFrame_] = currentFenceValue + 1;
+    /*
+    Only wait if the GPU is still processing the frame that previously used this slot,
+    i.e. the CPU is already "numFramesInFlight_" frames ahead of the GPU
+    */
+    renderSystem_.WaitForFenceValue(fenceValues_[currentFrameInFlight_]);
 }
 
 void D3D12RenderContext::ResolveRenderTarget(ID3D12GraphicsCommandList* commandList)
 {
     /* Prepare render-target for resolving */
-    D3D12_RESOURCE_BARRIER resourceBarriersBefore[2] =
-    {
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            renderTargets_[currentFrame_].Get(),
-            D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RESOLVE_DEST
-        ),
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            renderTargetsMS_[currentFrame_].Get(),
-            D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_RESOLVE_SOURCE
-        ),
-    };
-    commandList->ResourceBarrier(2, resourceBarriersBefore);
+    commandBuffer_->TransitionResource(
+        renderTargets_[currentFrame_].Get(),
+        D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RESOLVE_DEST
+    );
+    commandBuffer_->TransitionResource(
+        renderTargetsMS_[currentFrame_].Get(),
+        D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_RESOLVE_SOURCE
+    );
+    commandBuffer_->FlushResourceBarriers();
 
     /* Resolve multi-sampled render targets */
     commandList->ResolveSubresource(
@@ -357,19 +461,15 @@ void D3D12RenderContext::ResolveRenderTarget(ID3D12GraphicsCommandList* commandL
         DXGI_FORMAT_R8G8B8A8_UNORM
     );
 
-    /* Prepare render-targets for presenting */
-    D3D12_RESOURCE_BARRIER resourceBarriersAfter[2] =
-    {
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            renderTargets_[currentFrame_].Get(),
-            D3D12_RESOURCE_STATE_RESOLVE_DEST, D3D12_RESOURCE_STATE_PRESENT
-        ),
-        CD3DX12_RESOURCE_BARRIER::Transition(
-            renderTargetsMS_[currentFrame_].Get(),
-            D3D12_RESOURCE_STATE_RESOLVE_SOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET
-        ),
-    };
-    commandList->ResourceBarrier(2, resourceBarriersAfter);
+    /* Prepare render-targets for presenting (submitted before the command list is closed) */
+    commandBuffer_->TransitionResource(
+        renderTargets_[currentFrame_].Get(),
+        D3D12_RESOURCE_STATE_RESOLVE_DEST, D3D12_RESOURCE_STATE_PRESENT
+    );
+    commandBuffer_->TransitionResource(
+        renderTargetsMS_[currentFrame_].Get(),
+        D3D12_RESOURCE_STATE_RESOLVE_SOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET
+    );
 }
 
 
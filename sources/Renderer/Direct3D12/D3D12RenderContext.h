@@ -18,7 +18,7 @@
 #include "RenderState/D3D12StateManager.h"
 
 #include <d3d12.h>
-#include <dxgi1_4.h>
+#include <dxgi1_5.h>
 
 
 namespace LLGL
@@ -28,7 +28,7 @@ namespace LLGL
 class D3D12RenderSystem;
 class D3D12CommandBuffer;
 
-class D3D12RenderContext : public RenderContext
+class D3D12RenderContext final : public RenderContext
 {
 
     public:
@@ -42,6 +42,14 @@ class D3D12RenderContext : public RenderContext
         ~D3D12RenderContext();
 
         void Present() override;
+        void PresentWithoutVsync() override;
+
+        void WaitForNextFrame() override;
+
+        bool QueryFrameStatistics(FrameStatistics& stats) override;
+
+        bool IsOccluded() const override;
+        bool TestPresent() override;
 
         void SetVideoMode(const VideoModeDescriptor& videoModeDesc) override;
         void SetVsync(const VsyncDescriptor& vsyncDesc) override;
@@ -62,35 +70,46 @@ class D3D12RenderContext : public RenderContext
 
     private:
 
-        static const UINT maxNumBuffers = 3;
+        static const UINT maxNumBuffers         = 3;
+        static const UINT maxNumFramesInFlight  = 3;
+
+        // Presents the swap-chain with the specified sync interval (0 for no Vsync).
+        void PresentWithInterval(UINT syncInterval);
 
         void CreateWindowSizeDependentResources();
         void CreateDeviceResources();
-        void UpdateFenceValues();
+        void SetMaximumFrameLatency();
 
         void MoveToNextFrame();
 
         void ResolveRenderTarget(ID3D12GraphicsCommandList* commandList);
         
         D3D12RenderSystem&                  renderSystem_;  // reference to its render system
-        D3D12CommandBuffer*                 commandBuffer_                  = nullptr;
+        D3D12CommandBuffer*                 commandBuffer_                      = nullptr;
 
         RenderContextDescriptor             desc_;
 
         ComPtr<IDXGISwapChain3>             swapChain_;
-        UINT                                swapChainInterval_              = 0;
+        UINT                                swapChainInterval_                  = 0;
+        UINT                                swapChainFlags_                     = 0;
+        HANDLE                              frameLatencyObject_                 = nullptr;
+        bool                                tearingSupported_                   = false;
+        bool                                occluded_                           = false;    // DXGI_STATUS_OCCLUDED of the last presentation
 
         ComPtr<ID3D12DescriptorHeap>        rtvDescHeap_;
-        UINT                                rtvDescSize_                    = 0;
+        UINT                                rtvDescSize_                        = 0;
 
         ComPtr<ID3D12Resource>              renderTargets_[maxNumBuffers];
         ComPtr<ID3D12Resource>              renderTargetsMS_[maxNumBuffers];
 
-        ComPtr<ID3D12CommandAllocator>      commandAllocs_[maxNumBuffers];
-        UINT64                              fenceValues_[maxNumBuffers]     = { 0 };
+        ComPtr<ID3D12CommandAllocator>      commandAllocs_[maxNumFramesInFlight];
+        UINT64                              fenceValues_[maxNumFramesInFlight]  = { 0 };
+
+        UINT                                numFrames_                          = 0; // number of swap-chain buffers
+        UINT                                currentFrame_                       = 0; // index of the current swap-chain buffer
 
-        UINT                                numFrames_                      = 0;
-        UINT                                currentFrame_                   = 0;
+        UINT                                numFramesInFlight_                  = 1;
+        UINT                                currentFrameInFlight_               = 0;
 
 };
 
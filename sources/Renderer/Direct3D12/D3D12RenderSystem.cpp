@@ -11,6 +11,7 @@
 #include "../CheckedCast.h"
 #include "../Assertion.h"
 #include "../../Core/Helper.h"
+#include "../../Core/Exception.h"
 #include "../../Core/Vendor.h"
 #include "D3DX12/d3dx12.h"
 //#include "RenderState/D3D12StateManager.h"
@@ -20,28 +21,96 @@
 #include "Buffer/D3D12IndexBuffer.h"
 #include "Buffer/D3D12ConstantBuffer.h"
 #include "Buffer/D3D12StorageBuffer.h"
+#include <algorithm>
+#include <chrono>
 
 
 namespace LLGL
 {
 
 
-D3D12RenderSystem::D3D12RenderSystem()
+// Size (in bytes) of each page in the staging buffer pool; larger uploads get a dedicated page.
+static const UINT64 g_stagingBufferPageSize = 4 * 1024 * 1024;
+
+// Size (in bytes) of each heap block of the GPU memory allocator; larger resources are created as committed resources.
+static const UINT64 g_memoryHeapBlockSize = 64 * 1024 * 1024;
+
+// Number of queries in each query heap of the query heap pool.
+static const UINT g_queriesPerHeap = 256;
+
+// Win32 event of the calling thread to wait for fences.
+struct D3D12ThreadFenceEvent
+{
+    D3D12ThreadFenceEvent() :
+        handle { CreateEventEx(nullptr, nullptr, 0, EVENT_ALL_ACCESS) }
+    {
+    }
+    ~D3D12ThreadFenceEvent()
+    {
+        CloseHandle(handle);
+    }
+    HANDLE handle;
+};
+
+/*
+Waits until the specified fence has reached the specified value. Each thread waits with its own event,
+since the signal of an auto-reset event that is shared between threads could wake up and be consumed by another waiter.
+*/
+static void WaitForD3D12Fence(ID3D12Fence* fence, UINT64 fenceValue, const char* errorInfo)
+{
+    if (fence->GetCompletedValue() < fenceValue)
+    {
+        static thread_local D3D12ThreadFenceEvent threadEvent;
+        auto hr = fence->SetEventOnCompletion(fenceValue, threadEvent.handle);
+        DXThrowIfFailed(hr, errorInfo);
+        WaitForSingleObjectEx(threadEvent.handle, INFINITE, FALSE);
+    }
+}
+
+D3D12RenderSystem::D3D12RenderSystem(const RenderSystemDescriptor& renderSystemDesc)
 {
+    /* Enable debug layer in debug builds, and for the messages of the driver debugger */
     #ifdef LLGL_DEBUG
-    EnableDebugLayer();
+    EnableDebugLayer(true);
+    #else
+    if (renderSystemDesc.driverDebugger != nullptr)
+        EnableDebugLayer(false);
     #endif
 
     /* Create DXGU factory 1.4, query video adapters, and create D3D12 device */
     CreateFactory();
     QueryVideoAdapters();
-    CreateDevice();
+    CreateDevice(renderSystemDesc);
+
+    /* Read the messages of the debug layer for the driver debugger */
+    if (renderSystemDesc.driverDebugger != nullptr)
+        infoQueue_ = MakeUnique<D3D12InfoQueue>(device_.Get(), renderSystemDesc.driverDebugger, renderSystemDesc.driverMessageLimit);
     CreateGPUSynchObjects();
 
-    /* Create command queue, command allocator, and graphics command list */
-    commandQueue_   = CreateDXCommandQueue();
-    commandAlloc_   = CreateDXCommandAllocator();
-    commandList_    = CreateDXCommandList();
+    /* Create command queue, and pool for one-shot command lists with the first upload command list */
+    commandQueue_       = CreateDXCommandQueue();
+    commandListPool_    = MakeUnique<D3D12CommandListPool>(device_.Get());
+    uploadCommands_     = commandListPool_->AcquireCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+    /* Create command queue for async compute command buffers */
+    computeQueue_   = CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE_COMPUTE);
+
+    /* Create command queues for all other GPU nodes of a linked adapter */
+    CreateNodeQueues();
+
+    /* Create pool for upload memory and allocator for GPU memory */
+    stagingBufferPool_  = MakeUnique<D3D12StagingBufferPool>(device_.Get(), g_stagingBufferPageSize);
+    memoryAllocator_    = MakeUnique<D3D12MemoryAllocator>(device_.Get(), g_memoryHeapBlockSize, GetAllNodesMask());
+
+    /* Create pools for the RTV and DSV descriptors of render targets */
+    rtvDescPool_        = MakeUnique<D3D12CPUDescriptorPool>(device_.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+    dsvDescPool_        = MakeUnique<D3D12CPUDescriptorPool>(device_.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
+
+    /* Create pool for query heaps, so queries are suballocated instead of creating one query heap per query */
+    queryHeapPool_      = MakeUnique<D3D12QueryHeapPool>(device_.Get(), g_queriesPerHeap);
+
+    /* Create command signatures for indirect commands */
+    CreateCommandSignatures();
 
     /* Initialize renderer information */
     QueryRendererInfo();
@@ -50,13 +119,18 @@ D3D12RenderSystem::D3D12RenderSystem()
 
 D3D12RenderSystem::~D3D12RenderSystem()
 {
+    /* Finish all asynchronous tasks before the resources they might refer to are released */
+    GetSharedThreadPool()->WaitIdle();
+
+    /* Wait for pending upload commands that still read from the staging buffer pool */
+    SyncGPU();
+
     /*
     Release render targets first, to ensure the GPU is no longer
     referencing resources that are about to be released
     */
     renderContexts_.clear();
-
-    CloseHandle(fenceEvent_);
+    renderTargets_.clear();
 }
 
 /* ----- Render Context ----- */
@@ -73,9 +147,72 @@ void D3D12RenderSystem::Release(RenderContext& renderContext)
 
 /* ----- Command buffers ----- */
 
-CommandBuffer* D3D12RenderSystem::CreateCommandBuffer()
+CommandBuffer* D3D12RenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
-    return TakeOwnership(commandBuffers_, MakeUnique<D3D12CommandBuffer>(*this));
+    /* Create command buffer (each command buffer has its own command allocator) */
+    return TakeOwnership(commandBuffers_, MakeUnique<D3D12CommandBuffer>(*this, desc));
+}
+
+void D3D12RenderSystem::ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray)
+{
+    LLGL_ASSERT_PTR(commandBufferArray);
+
+    /* Gather command lists of all deferred command buffers */
+    std::vector<ID3D12CommandList*> commandLists;
+    commandLists.reserve(numCommandBuffers);
+
+    std::vector<D3D12CommandBuffer*> submittedCommandBuffers;
+    submittedCommandBuffers.reserve(numCommandBuffers);
+
+    bool computeCommandLists = false;
+    UINT nodeIndex = 0;
+
+    auto SubmitCommandLists = [&]()
+    {
+        if (!commandLists.empty())
+        {
+            if (computeCommandLists)
+                ExecuteComputeCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
+            else
+                ExecuteNodeCommandLists(nodeIndex, static_cast<UINT>(commandLists.size()), commandLists.data());
+            commandLists.clear();
+
+            /* Store the fence value of this submission, so each command buffer only waits for its own command list when it's reset */
+            ID3D12Fence* fence = nullptr;
+            auto fenceValue = SignalQueueFence(computeCommandLists, nodeIndex, fence);
+            for (auto commandBuffer : submittedCommandBuffers)
+                commandBuffer->SetSubmitFence(fence, fenceValue);
+            submittedCommandBuffers.clear();
+        }
+    };
+
+    while (auto commandBuffer = NextArrayResource<D3D12CommandBuffer>(numCommandBuffers, commandBufferArray))
+    {
+        if (commandBuffer->IsBundle())
+            throw std::invalid_argument("cannot submit D3D12 bundle to a command queue; it can only be executed within another command buffer");
+
+        if (auto commandList = commandBuffer->FinishCommandList())
+        {
+            /* Submit consecutive command lists of the same queue with a single call */
+            if (computeCommandLists != commandBuffer->IsAsyncCompute() || nodeIndex != commandBuffer->GetNodeIndex())
+            {
+                SubmitCommandLists();
+                computeCommandLists = commandBuffer->IsAsyncCompute();
+                nodeIndex           = commandBuffer->GetNodeIndex();
+            }
+            commandLists.push_back(commandList);
+            submittedCommandBuffers.push_back(commandBuffer);
+
+            /* Fences of this command buffer must be signaled right after its command list has been executed */
+            if (commandBuffer->HasSignalFences())
+            {
+                SubmitCommandLists();
+                commandBuffer->SignalFences();
+            }
+        }
+    }
+
+    SubmitCommandLists();
 }
 
 void D3D12RenderSystem::Release(CommandBuffer& commandBuffer)
@@ -86,34 +223,34 @@ void D3D12RenderSystem::Release(CommandBuffer& commandBuffer)
 /* ----- Buffers ------ */
 
 // private
-std::unique_ptr<D3D12Buffer> D3D12RenderSystem::MakeBufferAndInitialize(const BufferDescriptor& desc, const void* initialData)
+std::unique_ptr<D3D12Buffer> D3D12RenderSystem::MakeBufferAndRecordUpload(const BufferDescriptor& desc, const void* initialData)
 {
     std::unique_ptr<D3D12Buffer> buffer;
-    ComPtr<ID3D12Resource> uploadBuffer;
 
     /* Create buffer and upload data to GPU */
     switch (desc.type)
     {
         case BufferType::Vertex:
         {
-            auto vertexBufferD3D = MakeUnique<D3D12VertexBuffer>(device_.Get(), desc);
-            vertexBufferD3D->UpdateSubresource(device_.Get(), commandList_.Get(), uploadBuffer, initialData, desc.size);
+            auto vertexBufferD3D = MakeUnique<D3D12VertexBuffer>(*memoryAllocator_, desc);
+            vertexBufferD3D->UpdateSubresource(uploadCommands_.commandList.Get(), *stagingBufferPool_, initialData, desc.size);
             buffer = std::move(vertexBufferD3D);
         }
         break;
 
         case BufferType::Index:
         {
-            auto indexBufferD3D = MakeUnique<D3D12IndexBuffer>(device_.Get(), desc);
-            indexBufferD3D->UpdateSubresource(device_.Get(), commandList_.Get(), uploadBuffer, initialData, desc.size);
+            auto indexBufferD3D = MakeUnique<D3D12IndexBuffer>(*memoryAllocator_, desc);
+            indexBufferD3D->UpdateSubresource(uploadCommands_.commandList.Get(), *stagingBufferPool_, initialData, desc.size);
             buffer = std::move(indexBufferD3D);
         }
         break;
 
         case BufferType::Constant:
         {
-            auto constantBufferD3D = MakeUnique<D3D12ConstantBuffer>(device_.Get(), desc);
-            constantBufferD3D->UpdateSubresource(initialData, desc.size);
+            auto constantBufferD3D = MakeUnique<D3D12ConstantBuffer>(device_.Get(), desc, GetAllNodesMask());
+            if (initialData != nullptr)
+                constantBufferD3D->UpdateSubresource(initialData, desc.size);
             buffer = std::move(constantBufferD3D);
         }
         break;
@@ -127,17 +264,54 @@ std::unique_ptr<D3D12Buffer> D3D12RenderSystem::MakeBufferAndInitialize(const Bu
         break;
     }
 
-    /* Execute upload commands and wait for GPU to finish execution */
-    ExecuteCommandList();
-    SyncGPU();
-
     return buffer;
 }
 
 Buffer* D3D12RenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
 {
     AssertCreateBuffer(desc);
-    return TakeOwnership(buffers_, MakeBufferAndInitialize(desc, initialData));
+
+    std::unique_ptr<D3D12Buffer> bufferD3D;
+    {
+        /* Buffers can be created by several threads, but they all share the same upload command list */
+        std::lock_guard<std::mutex> lock(uploadMutex_);
+        bufferD3D = MakeBufferAndRecordUpload(desc, initialData);
+
+        /* Execute upload commands (the staging memory is recycled once the GPU has crossed the fence) */
+        SubmitUploadCommands();
+    }
+
+    auto buffer = TakeOwnership(buffers_, std::move(bufferD3D));
+    TrackMemory(*buffer, desc.size);
+    return buffer;
+}
+
+std::vector<Buffer*> D3D12RenderSystem::CreateBuffers(unsigned int numBuffers, const BufferDescriptor* descArray, const void* const * initialDataArray)
+{
+    for (unsigned int i = 0; i < numBuffers; ++i)
+        AssertCreateBuffer(descArray[i]);
+
+    std::vector<std::unique_ptr<D3D12Buffer>> buffersD3D;
+    buffersD3D.reserve(numBuffers);
+    {
+        /* Record the initial data of all buffers into the same upload command list, and submit it only once */
+        std::lock_guard<std::mutex> lock(uploadMutex_);
+        for (unsigned int i = 0; i < numBuffers; ++i)
+            buffersD3D.push_back(MakeBufferAndRecordUpload(descArray[i], (initialDataArray != nullptr ? initialDataArray[i] : nullptr)));
+        SubmitUploadCommands();
+    }
+
+    std::vector<Buffer*> buffers;
+    buffers.reserve(numBuffers);
+
+    for (unsigned int i = 0; i < numBuffers; ++i)
+    {
+        auto buffer = TakeOwnership(buffers_, std::move(buffersD3D[i]));
+        TrackMemory(*buffer, descArray[i].size);
+        buffers.push_back(buffer);
+    }
+
+    return buffers;
 }
 
 static std::unique_ptr<BufferArray> MakeD3D12BufferArray(unsigned int numBuffers, Buffer* const * bufferArray)
@@ -162,6 +336,19 @@ BufferArray* D3D12RenderSystem::CreateBufferArray(unsigned int numBuffers, Buffe
 
 void D3D12RenderSystem::Release(Buffer& buffer)
 {
+    /* Keep native resource alive until the GPU is done with the current frame */
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    ReleaseDeferred(bufferD3D.Get(), bufferD3D.GetMemoryRegion());
+
+    /* Previous versions of dynamic constant buffers might be referenced by the same command lists */
+    if (buffer.GetType() == BufferType::Constant)
+    {
+        auto& constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer&, buffer);
+        for (const auto& page : constantBufferD3D.GetVersionPages())
+            ReleaseDeferred(page.Get());
+    }
+
+    UntrackMemory(buffer);
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
@@ -172,28 +359,119 @@ void D3D12RenderSystem::Release(BufferArray& bufferArray)
 
 void D3D12RenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
 {
-    //todo...
+    if (buffer.GetType() == BufferType::Constant)
+    {
+        /* Dynamic constant buffers get a new version, so command lists recorded before this call keep their contents */
+        auto& constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer&, buffer);
+        constantBufferD3D.UpdateSubresource(
+            data,
+            static_cast<UINT>(dataSize),
+            static_cast<UINT64>(offset),
+            GetNextFenceValue(),
+            fence_->GetCompletedValue()
+        );
+    }
 }
 
 void* D3D12RenderSystem::MapBuffer(Buffer& buffer, const BufferCPUAccess access)
 {
-    return nullptr;//todo...
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    return MapBufferRange(buffer, 0, bufferD3D.GetBufferSize(), access);
+}
+
+void* D3D12RenderSystem::MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags)
+{
+    /* Discard and unsynchronized mappings need no special treatment, since D3D12 never synchronizes mapped memory with the GPU */
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+
+    /* Mapping always refers to the base resource of a constant buffer */
+    if (buffer.GetType() == BufferType::Constant)
+    {
+        auto& constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer&, buffer);
+        constantBufferD3D.RestoreBaseVersion(GetNextFenceValue());
+    }
+
+    return bufferD3D.Map(
+        offset,
+        size,
+        (access == BufferCPUAccess::ReadOnly || access == BufferCPUAccess::ReadWrite),
+        (access != BufferCPUAccess::ReadOnly),
+        ((mapFlags & BufferMapFlags::FlushExplicit) != 0)
+    );
+}
+
+void D3D12RenderSystem::FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size)
+{
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    bufferD3D.FlushMappedRange(offset, size);
 }
 
 void D3D12RenderSystem::UnmapBuffer(Buffer& buffer)
 {
-    //todo...
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    bufferD3D.Unmap();
+
+    if (buffer.GetType() == BufferType::Constant)
+    {
+        auto& constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer&, buffer);
+        constantBufferD3D.SyncWithBaseVersion();
+    }
+}
+
+TransientBufferRange D3D12RenderSystem::WriteTransientConstantBuffer(const void* data, std::size_t dataSize)
+{
+    return {};//todo...
 }
 
 /* ----- Textures ----- */
 
 Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
 {
-    auto textureD3D = MakeUnique<D3D12Texture>(device_.Get(), textureDesc);
+    std::unique_ptr<D3D12Texture> textureD3D;
+    {
+        /* Textures can be created by several threads, but they all share the same upload command list */
+        std::lock_guard<std::mutex> lock(uploadMutex_);
+        textureD3D = MakeTextureAndRecordUpload(textureDesc, imageDesc);
 
-    /* Upload image data */
-    ComPtr<ID3D12Resource> uploadBuffer;
+        /* Execute upload commands (the staging memory is recycled once the GPU has crossed the fence) */
+        SubmitUploadCommands();
+    }
+
+    TrackMemory(*textureD3D, textureDesc);
+
+    return TakeOwnership(textures_, std::move(textureD3D));
+}
+
+std::vector<Texture*> D3D12RenderSystem::CreateTextures(unsigned int numTextures, const TextureDescriptor* textureDescArray, const ImageDescriptor* const * imageDescArray)
+{
+    std::vector<std::unique_ptr<D3D12Texture>> texturesD3D;
+    texturesD3D.reserve(numTextures);
+    {
+        /* Record the image data of all textures into the same upload command list, and submit it only once */
+        std::lock_guard<std::mutex> lock(uploadMutex_);
+        for (unsigned int i = 0; i < numTextures; ++i)
+            texturesD3D.push_back(MakeTextureAndRecordUpload(textureDescArray[i], (imageDescArray != nullptr ? imageDescArray[i] : nullptr)));
+        SubmitUploadCommands();
+    }
+
+    std::vector<Texture*> textures;
+    textures.reserve(numTextures);
+
+    for (unsigned int i = 0; i < numTextures; ++i)
+    {
+        TrackMemory(*texturesD3D[i], textureDescArray[i]);
+        textures.push_back(TakeOwnership(textures_, std::move(texturesD3D[i])));
+    }
+
+    return textures;
+}
 
+// private
+std::unique_ptr<D3D12Texture> D3D12RenderSystem::MakeTextureAndRecordUpload(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
+{
+    auto textureD3D = MakeUnique<D3D12Texture>(device_.Get(), *memoryAllocator_, textureDesc);
+
+    /* Upload image data */
     if (imageDesc)
     {
         auto texWidth   = textureDesc.texture1D.width;
@@ -205,14 +483,24 @@ Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
             subresourceData.RowPitch    = ImageFormatSize(imageDesc->format) * DataTypeSize(imageDesc->dataType) * texWidth;
             subresourceData.SlicePitch  = subresourceData.RowPitch * texHeight;
         }
-        textureD3D->UpdateSubresource(device_.Get(), commandList_.Get(), uploadBuffer, subresourceData);
+        textureD3D->UpdateSubresource(uploadCommands_.commandList.Get(), *stagingBufferPool_, subresourceData);
+    }
+    else
+    {
+        /* Transition texture into its usage state, which all command buffers expect */
+        auto resourceBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+            textureD3D->Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
+        );
+        uploadCommands_.commandList->ResourceBarrier(1, &resourceBarrier);
     }
 
-    /* Execute upload commands and wait for GPU to finish execution */
-    ExecuteCommandList();
-    SyncGPU();
+    return textureD3D;
+}
 
-    return TakeOwnership(textures_, std::move(textureD3D));
+Texture* D3D12RenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    auto& sharedTextureD3D = LLGL_CAST(D3D12Texture&, sharedTexture);
+    return TakeOwnership(textures_, MakeUnique<D3D12Texture>(device_.Get(), sharedTextureD3D, textureViewDesc));
 }
 
 TextureArray* D3D12RenderSystem::CreateTextureArray(unsigned int numTextures, Texture* const * textureArray)
@@ -220,9 +508,21 @@ TextureArray* D3D12RenderSystem::CreateTextureArray(unsigned int numTextures, Te
     return nullptr;//todo...
 }
 
+Texture* D3D12RenderSystem::CreateSparseTexture(const TextureDescriptor& textureDesc)
+{
+    LLGL_ASSERT_CAP(hasSparseTextures);
+    return TakeOwnership(textures_, MakeUnique<D3D12Texture>(device_.Get(), commandQueue_.Get(), textureDesc));
+}
+
 void D3D12RenderSystem::Release(Texture& texture)
 {
-    //RemoveFromUniqueSet(textures_, &texture);
+    /* Keep native resource and its tile heaps alive until the GPU is done with the current frame */
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+    ReleaseDeferred(textureD3D.Get(), textureD3D.GetMemoryRegion());
+    for (const auto& heap : textureD3D.GetTileHeaps())
+        ReleaseDeferred(heap.Get());
+    UntrackMemory(texture);
+    RemoveFromUniqueSet(textures_, &texture);
 }
 
 void D3D12RenderSystem::Release(TextureArray& textureArray)
@@ -254,7 +554,52 @@ void D3D12RenderSystem::ReadTexture(const Texture& texture, int mipLevel, ImageF
 
 void D3D12RenderSystem::GenerateMips(Texture& texture)
 {
-    //todo
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+
+    /* Only textures, which have been created with UAV support, can be written by the compute shader */
+    if ((textureD3D.Get()->GetDesc().Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS) == 0)
+        return;
+
+    /* Record dispatches into the upload command list, and keep the descriptor heap alive until the GPU is done */
+    ComPtr<ID3D12DescriptorHeap> descHeap;
+    {
+        std::lock_guard<std::mutex> lock(uploadMutex_);
+        descHeap = mipGenerator_.GenerateMips(device_.Get(), uploadCommands_.commandList.Get(), textureD3D);
+        SubmitUploadCommands();
+    }
+    ReleaseDeferred(descHeap.Get());
+}
+
+std::uint64_t D3D12RenderSystem::GetBindlessTextureHandle(Texture& texture, Sampler* sampler)
+{
+    //todo: requires a global shader-visible descriptor heap and unbounded descriptor ranges in the root signature
+    ThrowNotSupported("bindless textures");
+}
+
+static const SparsePageTable& GetSparsePageTable(const D3D12Texture& textureD3D)
+{
+    if (auto pageTable = textureD3D.GetSparsePageTable())
+        return *pageTable;
+    throw std::invalid_argument("texture was not created as sparse texture");
+}
+
+void D3D12RenderSystem::CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit)
+{
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+    GetSparsePageTable(textureD3D);
+    textureD3D.CommitTiles(device_.Get(), commandQueue_.Get(), region, commit);
+}
+
+bool D3D12RenderSystem::IsSparseTextureResident(const Texture& texture, const TextureRegion& region)
+{
+    auto& textureD3D = LLGL_CAST(const D3D12Texture&, texture);
+    return GetSparsePageTable(textureD3D).IsResident(region);
+}
+
+Gs::Vector3ui D3D12RenderSystem::QuerySparseTexturePageSize(const Texture& texture)
+{
+    auto& textureD3D = LLGL_CAST(const D3D12Texture&, texture);
+    return GetSparsePageTable(textureD3D).GetPageSize();
 }
 
 /* ----- Sampler States ---- */
@@ -279,23 +624,36 @@ void D3D12RenderSystem::Release(SamplerArray& samplerArray)
     //RemoveFromUniqueSet(samplerArrays_, &samplerArray);
 }
 
+/* ----- Resource Heaps ----- */
+
+ResourceHeap* D3D12RenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    AssertCreateResourceHeap(desc);
+    return TakeOwnership(resourceHeaps_, MakeUnique<D3D12ResourceHeap>(desc));
+}
+
+void D3D12RenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+}
+
 /* ----- Render Targets ----- */
 
 RenderTarget* D3D12RenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
 {
-    return nullptr;//TakeOwnership(renderTargets_, MakeUnique<D3D12RenderTarget>(desc));
+    return TakeOwnership(renderTargets_, MakeUnique<D3D12RenderTarget>(*this, desc));
 }
 
 void D3D12RenderSystem::Release(RenderTarget& renderTarget)
 {
-    //RemoveFromUniqueSet(renderTargets_, &renderTarget);
+    RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
 /* ----- Shader ----- */
 
 Shader* D3D12RenderSystem::CreateShader(const ShaderType type)
 {
-    return TakeOwnership(shaders_, MakeUnique<D3D12Shader>(type));
+    return TakeOwnership(shaders_, MakeUnique<D3D12Shader>(type, GetSharedThreadPool().get()));
 }
 
 ShaderProgram* D3D12RenderSystem::CreateShaderProgram()
@@ -317,34 +675,166 @@ void D3D12RenderSystem::Release(ShaderProgram& shaderProgram)
 
 GraphicsPipeline* D3D12RenderSystem::CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
 {
+    /* Lock pipeline cache and container, since this may be called by worker threads */
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
     return TakeOwnership(graphicsPipelines_, MakeUnique<D3D12GraphicsPipeline>(*this, desc));
 }
 
+std::shared_future<GraphicsPipeline*> D3D12RenderSystem::CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc)
+{
+    return GetSharedThreadPool()->Submit(
+        [this, desc]()
+        {
+            return CreateGraphicsPipeline(desc);
+        }
+    );
+}
+
 ComputePipeline* D3D12RenderSystem::CreateComputePipeline(const ComputePipelineDescriptor& desc)
 {
-    return nullptr;//todo...
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    return TakeOwnership(computePipelines_, MakeUnique<D3D12ComputePipeline>(*this, desc));
 }
 
 void D3D12RenderSystem::Release(GraphicsPipeline& graphicsPipeline)
 {
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
     RemoveFromUniqueSet(graphicsPipelines_, &graphicsPipeline);
 }
 
 void D3D12RenderSystem::Release(ComputePipeline& computePipeline)
 {
-    //RemoveFromUniqueSet(computePipelines_, &computePipeline);
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    RemoveFromUniqueSet(computePipelines_, &computePipeline);
+}
+
+bool D3D12RenderSystem::LoadPipelineCache(const std::vector<char>& data)
+{
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    return pipelineCache_.Load(data);
+}
+
+std::vector<char> D3D12RenderSystem::SavePipelineCache()
+{
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    return pipelineCache_.Save();
 }
 
 /* ----- Queries ----- */
 
 Query* D3D12RenderSystem::CreateQuery(const QueryDescriptor& desc)
 {
-    return nullptr;//todo...
+    return TakeOwnership(queries_, MakeUnique<D3D12Query>(*queryHeapPool_, desc));
+}
+
+QueryArray* D3D12RenderSystem::CreateQueryArray(unsigned int numQueries, Query* const * queryArray)
+{
+    AssertCreateQueryArray(numQueries, queryArray);
+    return TakeOwnership(queryArrays_, MakeUnique<D3D12QueryArray>(numQueries, queryArray));
 }
 
 void D3D12RenderSystem::Release(Query& query)
 {
-    //todo...
+    RemoveFromUniqueSet(queries_, &query);
+}
+
+void D3D12RenderSystem::Release(QueryArray& queryArray)
+{
+    RemoveFromUniqueSet(queryArrays_, &queryArray);
+}
+
+/* ----- Fences ----- */
+
+Fence* D3D12RenderSystem::CreateFence()
+{
+    return TakeOwnership(fences_, MakeUnique<D3D12Fence>(device_.Get()));
+}
+
+void D3D12RenderSystem::Release(Fence& fence)
+{
+    RemoveFromUniqueSet(fences_, &fence);
+}
+
+/* ----- Memory ----- */
+
+MemoryInfo D3D12RenderSystem::QueryMemoryInfo()
+{
+    MemoryInfo memoryInfo;
+
+    /* Accumulate memory the render system has allocated */
+    GetTrackedMemory(memoryInfo);
+
+    for (const auto& renderTarget : renderTargets_)
+        memoryInfo.renderTargetMemory += renderTarget->GetInternalMemory();
+
+    /* Query memory budget from the adapter of the device */
+    ComPtr<IDXGIAdapter> adapter;
+    if (SUCCEEDED(factory_->EnumAdapterByLuid(device_->GetAdapterLuid(), IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()))))
+        DXQueryVideoMemoryInfo(adapter.Get(), memoryInfo);
+
+    return memoryInfo;
+}
+
+// Makes the specified committed resource resident or evicts it. Placed resources share their heap with other resources, so they keep their residency.
+static bool SetD3D12Residency(ID3D12Device* device, ID3D12Pageable* object, const D3D12MemoryRegion& memoryRegion, bool resident)
+{
+    if (object == nullptr || memoryRegion.heap != nullptr)
+        return false;
+
+    HRESULT hr = (resident ? device->MakeResident(1, &object) : device->Evict(1, &object));
+    DXThrowIfFailed(hr, (resident ? "failed to make D3D12 resource resident" : "failed to evict D3D12 resource"));
+
+    return true;
+}
+
+bool D3D12RenderSystem::SetResidency(Buffer& buffer, bool resident)
+{
+    auto& bufferD3D = LLGL_CAST(D3D12Buffer&, buffer);
+    return SetD3D12Residency(device_.Get(), bufferD3D.Get(), bufferD3D.GetMemoryRegion(), resident);
+}
+
+bool D3D12RenderSystem::SetResidency(Texture& texture, bool resident)
+{
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+
+    /* Reserved resources are backed by their tile heaps, which are committed and decommitted page by page */
+    if (textureD3D.GetSparsePageTable() != nullptr)
+        return false;
+
+    return SetD3D12Residency(device_.Get(), textureD3D.Get(), textureD3D.GetMemoryRegion(), resident);
+}
+
+bool D3D12RenderSystem::QueryClockCalibration(ClockCalibration& calibration)
+{
+    static const double nanoseconds = 1000000000.0;
+
+    UINT64 timestampFrequency = 0;
+    if (FAILED(commandQueue_->GetTimestampFrequency(&timestampFrequency)) || timestampFrequency == 0)
+        return false;
+
+    /* Sample GPU timestamp and QPC value at the same moment */
+    UINT64 gpuTimestamp = 0, cpuTimestamp = 0;
+    if (FAILED(commandQueue_->GetClockCalibration(&gpuTimestamp, &cpuTimestamp)))
+        return false;
+
+    /* Map QPC value onto the steady clock by measuring how long ago it was sampled */
+    LARGE_INTEGER qpcFrequency, qpcNow;
+    if (!QueryPerformanceFrequency(&qpcFrequency) || !QueryPerformanceCounter(&qpcNow) || qpcFrequency.QuadPart == 0)
+        return false;
+
+    auto steadyNow = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+
+    auto qpcElapsed = static_cast<double>(static_cast<UINT64>(qpcNow.QuadPart) - cpuTimestamp);
+    auto qpcScale   = (nanoseconds / static_cast<double>(qpcFrequency.QuadPart));
+    auto gpuScale   = (nanoseconds / static_cast<double>(timestampFrequency));
+
+    /* Convert GPU ticks into nanoseconds the same way as the results of timestamp queries */
+    calibration.gpuTime = static_cast<std::uint64_t>(static_cast<double>(gpuTimestamp) * gpuScale + 0.5);
+    calibration.cpuTime = static_cast<std::uint64_t>(steadyNow) - static_cast<std::uint64_t>(qpcElapsed * qpcScale + 0.5);
+
+    return true;
 }
 
 
@@ -360,14 +850,15 @@ ComPtr<IDXGISwapChain1> D3D12RenderSystem::CreateDXSwapChain(const DXGI_SWAP_CHA
     return swapChain;
 }
 
-ComPtr<ID3D12CommandQueue> D3D12RenderSystem::CreateDXCommandQueue()
+ComPtr<ID3D12CommandQueue> D3D12RenderSystem::CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE type, UINT nodeMask)
 {
     ComPtr<ID3D12CommandQueue> cmdQueue;
 
     D3D12_COMMAND_QUEUE_DESC queueDesc = {};
     {
-        queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
-        queueDesc.Type  = D3D12_COMMAND_LIST_TYPE_DIRECT;
+        queueDesc.Flags     = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        queueDesc.Type      = type;
+        queueDesc.NodeMask  = nodeMask;
     }
     auto hr = device_->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(cmdQueue.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 command queue");
@@ -375,24 +866,21 @@ ComPtr<ID3D12CommandQueue> D3D12RenderSystem::CreateDXCommandQueue()
     return cmdQueue;
 }
 
-ComPtr<ID3D12CommandAllocator> D3D12RenderSystem::CreateDXCommandAllocator()
+ComPtr<ID3D12CommandAllocator> D3D12RenderSystem::CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE type)
 {
     ComPtr<ID3D12CommandAllocator> commandAlloc;
 
-    auto hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(commandAlloc.ReleaseAndGetAddressOf()));
+    auto hr = device_->CreateCommandAllocator(type, IID_PPV_ARGS(commandAlloc.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 command allocator");
 
     return commandAlloc;
 }
 
-ComPtr<ID3D12GraphicsCommandList> D3D12RenderSystem::CreateDXCommandList(ID3D12CommandAllocator* commandAlloc)
+ComPtr<ID3D12GraphicsCommandList> D3D12RenderSystem::CreateDXCommandList(ID3D12CommandAllocator* commandAlloc, D3D12_COMMAND_LIST_TYPE type, UINT nodeMask)
 {
-    if (!commandAlloc)
-        commandAlloc = commandAlloc_.Get();
-
     ComPtr<ID3D12GraphicsCommandList> commandList;
 
-    auto hr = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAlloc, nullptr, IID_PPV_ARGS(commandList.ReleaseAndGetAddressOf()));
+    auto hr = device_->CreateCommandList(nodeMask, type, commandAlloc, nullptr, IID_PPV_ARGS(commandList.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 graphics command list");
 
     return commandList;
@@ -422,11 +910,95 @@ ComPtr<ID3D12DescriptorHeap> D3D12RenderSystem::CreateDXDescriptorHeap(const D3D
 void D3D12RenderSystem::ExecuteCommandList()
 {
     /* Close and execute command list */
-    CloseAndExecuteCommandList(commandList_.Get());
+    CloseAndExecuteCommandList(uploadCommands_.commandList.Get());
+
+    /* Continue with another command list, since the allocator of this one can only be reset when the GPU is done with it */
+    commandListPool_->ReleaseCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT, std::move(uploadCommands_));
+    uploadCommands_ = commandListPool_->AcquireCommandList(D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+    /* Other GPU nodes must wait for these commands, since they initialize the shared resources */
+    uploadPending_ = true;
+}
+
+void D3D12RenderSystem::ExecuteCommandLists(UINT numCommandLists, ID3D12CommandList* const* commandLists)
+{
+    WaitForSecondaryQueues();
+    commandQueue_->ExecuteCommandLists(numCommandLists, commandLists);
+}
+
+void D3D12RenderSystem::ExecuteNodeCommandLists(UINT nodeIndex, UINT numCommandLists, ID3D12CommandList* const* commandLists)
+{
+    if (nodeIndex == 0)
+    {
+        ExecuteCommandLists(numCommandLists, commandLists);
+        return;
+    }
+
+    auto& nodeQueue = nodeQueues_[nodeIndex - 1];
+
+    /* Wait for the upload commands of the primary command queue, but not for its other commands to let the nodes run concurrently */
+    if (uploadPending_)
+        SignalFenceValue();
+
+    UINT64 uploadFenceValue = 0;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        uploadFenceValue = uploadFenceValue_;
+    }
+
+    if (nodeQueue.uploadWaited < uploadFenceValue)
+    {
+        auto hr = nodeQueue.queue->Wait(fence_.Get(), uploadFenceValue);
+        DXThrowIfFailed(hr, "failed to wait for D3D12 upload commands on GPU node");
+        nodeQueue.uploadWaited = uploadFenceValue;
+    }
+
+    nodeQueue.queue->ExecuteCommandLists(numCommandLists, commandLists);
+
+    /* Signal node fence, so the primary command queue can wait for these command lists */
+    auto hr = nodeQueue.queue->Signal(nodeQueue.fence.Get(), ++nodeQueue.fenceValue);
+    DXThrowIfFailed(hr, "failed to signal D3D12 fence into command queue of GPU node");
+}
+
+UINT64 D3D12RenderSystem::SignalQueueFence(bool asyncCompute, UINT nodeIndex, ID3D12Fence*& fence)
+{
+    if (asyncCompute)
+    {
+        fence = computeFence_.Get();
+        return computeFenceValue_;
+    }
+
+    if (nodeIndex > 0)
+    {
+        const auto& nodeQueue = nodeQueues_[nodeIndex - 1];
+        fence = nodeQueue.fence.Get();
+        return nodeQueue.fenceValue;
+    }
 
-    /* Reset command list */
-    auto hr = commandList_->Reset(commandAlloc_.Get(), nullptr);
-    DXThrowIfFailed(hr, "failed to reset D3D12 graphics command list");
+    fence = fence_.Get();
+    return SignalFenceValue();
+}
+
+void D3D12RenderSystem::WaitForQueueFence(ID3D12Fence* fence, UINT64 fenceValue)
+{
+    if (fence == fence_.Get())
+        WaitForFenceValue(fenceValue);
+    else
+        WaitForD3D12Fence(fence, fenceValue, "failed to set 'on completion'-event for D3D12 fence of secondary command queue");
+}
+
+ID3D12CommandQueue* D3D12RenderSystem::GetNodeQueue(UINT nodeIndex) const
+{
+    return (nodeIndex == 0 ? commandQueue_.Get() : nodeQueues_[nodeIndex - 1].queue.Get());
+}
+
+void D3D12RenderSystem::ExecuteComputeCommandLists(UINT numCommandLists, ID3D12CommandList* const* commandLists)
+{
+    computeQueue_->ExecuteCommandLists(numCommandLists, commandLists);
+
+    /* Signal compute fence, so the command queue can wait for these command lists */
+    auto hr = computeQueue_->Signal(computeFence_.Get(), ++computeFenceValue_);
+    DXThrowIfFailed(hr, "failed to signal D3D12 fence into compute queue");
 }
 
 void D3D12RenderSystem::CloseAndExecuteCommandList(ID3D12GraphicsCommandList* commandList)
@@ -437,43 +1009,62 @@ void D3D12RenderSystem::CloseAndExecuteCommandList(ID3D12GraphicsCommandList* co
 
     /* Execute command list */
     ID3D12CommandList* cmdLists[] = { commandList };
-    commandQueue_->ExecuteCommandLists(1, cmdLists);
+    ExecuteCommandLists(1, cmdLists);
 }
 
-void D3D12RenderSystem::SyncGPU(UINT64& fenceValue)
+void D3D12RenderSystem::SyncGPU()
 {
-    /* Schedule signal command into the qeue */
-    SignalFenceValue(fenceValue);
+    WaitForFenceValue(SignalFenceValue());
+}
+
+UINT64 D3D12RenderSystem::SignalFenceValue()
+{
+    std::lock_guard<std::mutex> lock(queueMutex_);
+
+    /* Include pending compute and GPU node commands, so the fence value covers all submitted work */
+    WaitForSecondaryQueues();
 
+    /* Schedule signal command into the qeue with the next fence value */
+    auto hr = commandQueue_->Signal(fence_.Get(), ++fenceValue_);
+    DXThrowIfFailed(hr, "failed to signal D3D12 fence into command queue");
+
+    if (uploadPending_.exchange(false))
+        uploadFenceValue_ = fenceValue_;
+
+    /* Destroy objects of previous frames the GPU has finished meanwhile */
+    RetireDeferredReleases();
+
+    return fenceValue_;
+}
+
+void D3D12RenderSystem::WaitForFenceValue(UINT64 fenceValue)
+{
     /* Wait until the fence has been crossed */
-    auto hr = fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
-    DXThrowIfFailed(hr, "failed to set 'on completion'-event for D3D12 fence");
-    WaitForSingleObjectEx(fenceEvent_, INFINITE, FALSE);
+    WaitForD3D12Fence(fence_.Get(), fenceValue, "failed to set 'on completion'-event for D3D12 fence");
 
-    /* Increment fence value */
-    ++fenceValue;
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    RetireDeferredReleases();
 }
 
-void D3D12RenderSystem::SyncGPU()
+bool D3D12RenderSystem::IsFenceValueCompleted(UINT64 fenceValue) const
 {
-    SyncGPU(fenceValue_);
+    return (fence_->GetCompletedValue() >= fenceValue);
 }
 
-void D3D12RenderSystem::SignalFenceValue(UINT64 fenceValue)
+UINT64 D3D12RenderSystem::GetNextFenceValue()
 {
-    /* Schedule signal command into the qeue */
-    auto hr = commandQueue_->Signal(fence_.Get(), fenceValue);
-    DXThrowIfFailed(hr, "failed to signal D3D12 fence into command queue");
+    /* Any command list recorded so far is submitted before the next fence value is signaled (same convention as for deferred releases) */
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    return fenceValue_ + 1;
 }
 
-void D3D12RenderSystem::WaitForFenceValue(UINT64 fenceValue)
+void D3D12RenderSystem::ReleaseDeferred(ID3D12Pageable* object, const D3D12MemoryRegion& memoryRegion)
 {
-    /* Wait until the fence has been crossed */
-    if (fence_->GetCompletedValue() < fenceValue)
+    /* Any command list that refers to the object is submitted before the next fence value is signaled (at the latest with the next frame) */
+    if (object != nullptr)
     {
-        auto hr = fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
-        DXThrowIfFailed(hr, "failed to set 'on completion'-event for D3D12 fence");
-        WaitForSingleObjectEx(fenceEvent_, INFINITE, FALSE);
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        deferredReleases_.push_back({ fenceValue_ + 1, object, memoryRegion });
     }
 }
 
@@ -482,9 +1073,7 @@ void D3D12RenderSystem::WaitForFenceValue(UINT64 fenceValue)
  * ======= Private: =======
  */
 
-#ifdef LLGL_DEBUG
-
-void D3D12RenderSystem::EnableDebugLayer()
+void D3D12RenderSystem::EnableDebugLayer(bool gpuBasedValidation)
 {
     ComPtr<ID3D12Debug> debugController0;
     if (SUCCEEDED(D3D12GetDebugInterface(IID_PPV_ARGS(debugController0.ReleaseAndGetAddressOf()))))
@@ -492,13 +1081,11 @@ void D3D12RenderSystem::EnableDebugLayer()
         debugController0->EnableDebugLayer();
 
         ComPtr<ID3D12Debug1> debugController1;
-        if (SUCCEEDED(debugController0->QueryInterface(IID_PPV_ARGS(debugController1.ReleaseAndGetAddressOf()))))
+        if (gpuBasedValidation && SUCCEEDED(debugController0->QueryInterface(IID_PPV_ARGS(debugController1.ReleaseAndGetAddressOf()))))
             debugController1->SetEnableGPUBasedValidation(TRUE);
     }
 }
 
-#endif
-
 void D3D12RenderSystem::CreateFactory()
 {
     /* Create DXGI factory 1.4 */
@@ -522,23 +1109,27 @@ void D3D12RenderSystem::QueryVideoAdapters()
         videoAdatperDescs_.push_back(DXGetVideoAdapterDesc(adapter.Get()));
         adapter.Reset();
     }
+
+    SetVideoAdapters(videoAdatperDescs_);
 }
 
-void D3D12RenderSystem::CreateDevice()
+void D3D12RenderSystem::CreateDevice(const RenderSystemDescriptor& renderSystemDesc)
 {
-    /* Use default adapter (null) and try all feature levels */
-    ComPtr<IDXGIAdapter> adapter;
     auto featureLevels = DXGetFeatureLevels(D3D_FEATURE_LEVEL_12_1);
-
-    /* Try to create a feature level with an hardware adapter */
     HRESULT hr = 0;
-    if (!CreateDevice(hr, adapter.Get(), featureLevels))
+
+    /* Try to create device with the hardware adapters in the order of preference */
+    for (const auto& adapter : DXGetPreferredAdapters(factory_.Get(), renderSystemDesc))
     {
-        /* Use software adapter as fallback */
-        factory_->EnumWarpAdapter(IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()));
-        if (!CreateDevice(hr, adapter.Get(), featureLevels))
-            DXThrowIfFailed(hr, "failed to create D3D12 device");
+        if (CreateDevice(hr, adapter.Get(), featureLevels))
+            return;
     }
+
+    /* Use software adapter as fallback */
+    ComPtr<IDXGIAdapter> adapter;
+    factory_->EnumWarpAdapter(IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()));
+    if (!CreateDevice(hr, adapter.Get(), featureLevels))
+        DXThrowIfFailed(hr, "failed to create D3D12 device");
 }
 
 bool D3D12RenderSystem::CreateDevice(HRESULT& hr, IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels)
@@ -564,8 +1155,57 @@ void D3D12RenderSystem::CreateGPUSynchObjects()
     auto hr = device_->CreateFence(initialFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence_.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 fence");
     
-    /* Create Win32 event */
-    fenceEvent_ = CreateEventEx(nullptr, nullptr, 0, EVENT_ALL_ACCESS);
+    /* Create D3D12 fence for the compute queue */
+    hr = device_->CreateFence(initialFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(computeFence_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 fence for compute queue");
+}
+
+void D3D12RenderSystem::CreateNodeQueues()
+{
+    numNodes_ = std::max(1u, device_->GetNodeCount());
+
+    /* Create command queue and fence for each GPU node except node 0, which uses the primary command queue */
+    nodeQueues_.resize(numNodes_ - 1);
+
+    for (UINT nodeIndex = 1; nodeIndex < numNodes_; ++nodeIndex)
+    {
+        auto& nodeQueue = nodeQueues_[nodeIndex - 1];
+
+        nodeQueue.queue = CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT, GetNodeMask(nodeIndex));
+
+        auto hr = device_->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(nodeQueue.fence.ReleaseAndGetAddressOf()));
+        DXThrowIfFailed(hr, "failed to create D3D12 fence for GPU node");
+    }
+}
+
+void D3D12RenderSystem::CreateCommandSignatures()
+{
+    drawIndirectSignature_          = CreateDXCommandSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW, sizeof(D3D12_DRAW_ARGUMENTS));
+    drawIndexedIndirectSignature_   = CreateDXCommandSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, sizeof(D3D12_DRAW_INDEXED_ARGUMENTS));
+    dispatchIndirectSignature_      = CreateDXCommandSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH, sizeof(D3D12_DISPATCH_ARGUMENTS));
+}
+
+ComPtr<ID3D12CommandSignature> D3D12RenderSystem::CreateDXCommandSignature(const D3D12_INDIRECT_ARGUMENT_TYPE argumentType, UINT byteStride)
+{
+    ComPtr<ID3D12CommandSignature> cmdSignature;
+
+    /* Setup command signature with a single argument (no root signature is required for draw and dispatch arguments only) */
+    D3D12_INDIRECT_ARGUMENT_DESC argDesc;
+    {
+        InitMemory(argDesc);
+        argDesc.Type = argumentType;
+    }
+    D3D12_COMMAND_SIGNATURE_DESC desc;
+    {
+        desc.ByteStride         = byteStride;
+        desc.NumArgumentDescs   = 1;
+        desc.pArgumentDescs     = (&argDesc);
+        desc.NodeMask           = GetAllNodesMask();
+    }
+    auto hr = device_->CreateCommandSignature(&desc, nullptr, IID_PPV_ARGS(cmdSignature.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 command signature");
+
+    return cmdSignature;
 }
 
 void D3D12RenderSystem::QueryRendererInfo()
@@ -575,9 +1215,11 @@ void D3D12RenderSystem::QueryRendererInfo()
     info.rendererName           = "Direct3D " + DXFeatureLevelToVersion(GetFeatureLevel());
     info.shadingLanguageName    = "HLSL " + DXFeatureLevelToShaderModel(GetFeatureLevel());
 
-    if (!videoAdatperDescs_.empty())
+    /* Query name and vendor from the adapter the device has been created with */
+    ComPtr<IDXGIAdapter> adapter;
+    if (SUCCEEDED(factory_->EnumAdapterByLuid(device_->GetAdapterLuid(), IID_PPV_ARGS(adapter.ReleaseAndGetAddressOf()))))
     {
-        const auto& videoAdapterDesc = videoAdatperDescs_.front();
+        auto videoAdapterDesc = DXGetVideoAdapterDesc(adapter.Get());
         info.deviceName = std::string(videoAdapterDesc.name.begin(), videoAdapterDesc.name.end());
         info.vendorName = videoAdapterDesc.vendor;
     }
@@ -591,9 +1233,107 @@ void D3D12RenderSystem::QueryRenderingCaps()
 {
     RenderingCaps caps;
     DXGetRenderingCaps(caps, GetFeatureLevel());
+
+    /* Sparse textures are implemented with reserved resources */
+    D3D12_FEATURE_DATA_D3D12_OPTIONS options;
+    InitMemory(options);
+
+    if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))))
+    {
+        caps.hasSparseTextures              = (options.TiledResourcesTier != D3D12_TILED_RESOURCES_TIER_NOT_SUPPORTED);
+        caps.hasConservativeRasterization   = (options.ConservativeRasterizationTier != D3D12_CONSERVATIVE_RASTERIZATION_TIER_NOT_SUPPORTED);
+        caps.hasVertexShaderLayer           = (options.VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation != FALSE);
+    }
+
+    caps.numGPUNodes = numNodes_;
+
+    /* Wave size can vary between shaders, so report the minimal number of lanes */
+    D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1;
+    InitMemory(options1);
+
+    if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) && options1.WaveOps != FALSE)
+        caps.waveSize = options1.WaveLaneCountMin;
+
+    /* Depth-bounds test is an optional feature */
+    D3D12_FEATURE_DATA_D3D12_OPTIONS2 options2;
+    InitMemory(options2);
+
+    if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS2, &options2, sizeof(options2))))
+        caps.hasDepthBoundsTest = (options2.DepthBoundsTestSupported != FALSE);
+
+    /* Variable-rate shading requires tier 1 for per-draw rates and tier 2 for shading rate images */
+    D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6;
+    InitMemory(options6);
+
+    if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))))
+    {
+        caps.hasVariableRateShading         = (options6.VariableShadingRateTier != D3D12_VARIABLE_SHADING_RATE_TIER_NOT_SUPPORTED);
+        if (options6.VariableShadingRateTier == D3D12_VARIABLE_SHADING_RATE_TIER_2)
+        {
+            caps.hasShadingRateImage        = true;
+            caps.shadingRateImageTileSize   = options6.ShadingRateImageTileSize;
+        }
+    }
+
+    /* Mesh and amplification shaders require mesh shader tier 1 */
+    D3D12_FEATURE_DATA_D3D12_OPTIONS7 options7;
+    InitMemory(options7);
+
+    if (SUCCEEDED(device_->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &options7, sizeof(options7))))
+        caps.hasMeshShaders = (options7.MeshShaderTier != D3D12_MESH_SHADER_TIER_NOT_SUPPORTED);
+
     SetRenderingCaps(caps);
 }
 
+void D3D12RenderSystem::RetireDeferredReleases()
+{
+    /* Deferred objects are ordered by their fence values */
+    auto completedValue = fence_->GetCompletedValue();
+    while (!deferredReleases_.empty() && deferredReleases_.front().fenceValue <= completedValue)
+    {
+        /* Release native object before its memory region can be reused by another placed resource */
+        auto& entry = deferredReleases_.front();
+        entry.object.Reset();
+        memoryAllocator_->Free(entry.memoryRegion);
+        deferredReleases_.pop_front();
+    }
+
+    if (commandListPool_)
+        commandListPool_->Reclaim(completedValue);
+}
+
+void D3D12RenderSystem::SubmitUploadCommands()
+{
+    ExecuteCommandList();
+
+    auto fenceValue = SignalFenceValue();
+    stagingBufferPool_->Submit(fenceValue);
+    commandListPool_->Submit(fenceValue);
+
+    /* Staging pages are only recycled here, since the staging buffer pool is guarded by the upload mutex rather than the queue mutex */
+    stagingBufferPool_->Reclaim(fence_->GetCompletedValue());
+}
+
+void D3D12RenderSystem::WaitForSecondaryQueues()
+{
+    if (computeFenceWaited_ < computeFenceValue_)
+    {
+        auto hr = commandQueue_->Wait(computeFence_.Get(), computeFenceValue_);
+        DXThrowIfFailed(hr, "failed to wait for D3D12 compute queue");
+        computeFenceWaited_ = computeFenceValue_;
+    }
+
+    for (auto& nodeQueue : nodeQueues_)
+    {
+        if (nodeQueue.fenceWaited < nodeQueue.fenceValue)
+        {
+            auto hr = commandQueue_->Wait(nodeQueue.fence.Get(), nodeQueue.fenceValue);
+            DXThrowIfFailed(hr, "failed to wait for D3D12 command queue of GPU node");
+            nodeQueue.fenceWaited = nodeQueue.fenceValue;
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -14,17 +14,36 @@
 
 #include "D3D12CommandBuffer.h"
 #include "D3D12RenderContext.h"
+#include "D3D12InfoQueue.h"
 
 #include "Buffer/D3D12Buffer.h"
+#include "Buffer/D3D12StagingBufferPool.h"
+#include "D3D12MemoryAllocator.h"
 #include "Texture/D3D12Texture.h"
+#include "Texture/D3D12MipGenerator.h"
+#include "Texture/D3D12RenderTarget.h"
+#include "D3D12CPUDescriptorPool.h"
+#include "D3D12CommandListPool.h"
 
 #include "RenderState/D3D12GraphicsPipeline.h"
+#include "RenderState/D3D12ComputePipeline.h"
+#include "RenderState/D3D12PipelineCache.h"
+#include "RenderState/D3D12ResourceHeap.h"
+#include "RenderState/D3D12Fence.h"
+#include "RenderState/D3D12Query.h"
+#include "RenderState/D3D12QueryArray.h"
+#include "RenderState/D3D12QueryHeapPool.h"
 
 #include "Shader/D3D12Shader.h"
 #include "Shader/D3D12ShaderProgram.h"
 
 #include "../ContainerTypes.h"
 #include "../DXCommon/ComPtr.h"
+#include "../../Core/ThreadPool.h"
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
 #include <d3d12.h>
 #include <dxgi1_4.h>
 
@@ -33,14 +52,14 @@ namespace LLGL
 {
 
 
-class D3D12RenderSystem : public RenderSystem
+class D3D12RenderSystem final : public RenderSystem
 {
 
     public:
 
         /* ----- Common ----- */
 
-        D3D12RenderSystem();
+        D3D12RenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~D3D12RenderSystem();
 
         /* ----- Render Context ------ */
@@ -51,13 +70,16 @@ class D3D12RenderSystem : public RenderSystem
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
+
+        void ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray) override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& desc, const void* initialData = nullptr) override;
+        std::vector<Buffer*> CreateBuffers(unsigned int numBuffers, const BufferDescriptor* descArray, const void* const * initialDataArray = nullptr) override;
         BufferArray* CreateBufferArray(unsigned int numBuffers, Buffer* const * bufferArray) override;
 
         void Release(Buffer& buffer) override;
@@ -66,12 +88,19 @@ class D3D12RenderSystem : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const BufferCPUAccess access) override;
+        void* MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags = 0) override;
+        void FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        TransientBufferRange WriteTransientConstantBuffer(const void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc = nullptr) override;
+        std::vector<Texture*> CreateTextures(unsigned int numTextures, const TextureDescriptor* textureDescArray, const ImageDescriptor* const * imageDescArray = nullptr) override;
         TextureArray* CreateTextureArray(unsigned int numTextures, Texture* const * textureArray) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
+        Texture* CreateSparseTexture(const TextureDescriptor& textureDesc) override;
 
         void Release(Texture& texture) override;
         void Release(TextureArray& textureArray) override;
@@ -84,6 +113,12 @@ class D3D12RenderSystem : public RenderSystem
 
         void GenerateMips(Texture& texture) override;
 
+        std::uint64_t GetBindlessTextureHandle(Texture& texture, Sampler* sampler = nullptr) override;
+
+        void CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit) override;
+        bool IsSparseTextureResident(const Texture& texture, const TextureRegion& region) override;
+        Gs::Vector3ui QuerySparseTexturePageSize(const Texture& texture) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
@@ -92,6 +127,12 @@ class D3D12RenderSystem : public RenderSystem
         void Release(Sampler& sampler) override;
         void Release(SamplerArray& samplerArray) override;
 
+        /* ----- Resource Heaps ----- */
+
+        ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
+
+        void Release(ResourceHeap& resourceHeap) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
@@ -109,41 +150,107 @@ class D3D12RenderSystem : public RenderSystem
         /* ----- Pipeline States ----- */
 
         GraphicsPipeline* CreateGraphicsPipeline(const GraphicsPipelineDescriptor& desc) override;
+        std::shared_future<GraphicsPipeline*> CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc) override;
         ComputePipeline* CreateComputePipeline(const ComputePipelineDescriptor& desc) override;
         
         void Release(GraphicsPipeline& graphicsPipeline) override;
         void Release(ComputePipeline& computePipeline) override;
 
+        bool LoadPipelineCache(const std::vector<char>& data) override;
+        std::vector<char> SavePipelineCache() override;
+
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
+        QueryArray* CreateQueryArray(unsigned int numQueries, Query* const * queryArray) override;
 
         void Release(Query& query) override;
+        void Release(QueryArray& queryArray) override;
+
+        /* ----- Fences ----- */
+
+        Fence* CreateFence() override;
+
+        void Release(Fence& fence) override;
+
+        /* ----- Memory ----- */
+
+        MemoryInfo QueryMemoryInfo() override;
+
+        bool SetResidency(Buffer& buffer, bool resident) override;
+        bool SetResidency(Texture& texture, bool resident) override;
+
+        bool QueryClockCalibration(ClockCalibration& calibration) override;
 
         /* ----- Extended internal functions ----- */
 
         ComPtr<IDXGISwapChain1> CreateDXSwapChain(const DXGI_SWAP_CHAIN_DESC1& desc, HWND wnd);
-        ComPtr<ID3D12CommandQueue> CreateDXCommandQueue();
-        ComPtr<ID3D12CommandAllocator> CreateDXCommandAllocator();
-        ComPtr<ID3D12GraphicsCommandList> CreateDXCommandList(ID3D12CommandAllocator* commandAlloc = nullptr);
+        ComPtr<ID3D12CommandQueue> CreateDXCommandQueue(D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT, UINT nodeMask = 0);
+        ComPtr<ID3D12CommandAllocator> CreateDXCommandAllocator(D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
+        ComPtr<ID3D12GraphicsCommandList> CreateDXCommandList(ID3D12CommandAllocator* commandAlloc, D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT, UINT nodeMask = 0);
         ComPtr<ID3D12PipelineState> CreateDXGfxPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
         ComPtr<ID3D12DescriptorHeap> CreateDXDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC& desc);
 
+        // Executes the specified (already closed) command lists on the command queue.
+        void ExecuteCommandLists(UINT numCommandLists, ID3D12CommandList* const* commandLists);
+
+        // Executes the specified (already closed) compute command lists on the compute queue. All graphics commands submitted afterwards wait for them.
+        void ExecuteComputeCommandLists(UINT numCommandLists, ID3D12CommandList* const* commandLists);
+
+        /*
+        Executes the specified (already closed) command lists on the command queue of the specified GPU node.
+        The node only waits for the upload commands of the primary command queue, so nodes can run concurrently,
+        but all commands submitted to the primary command queue afterwards wait on the GPU until these command lists are done.
+        */
+        void ExecuteNodeCommandLists(UINT nodeIndex, UINT numCommandLists, ID3D12CommandList* const* commandLists);
+
+        /*
+        Returns the fence of the specified command queue and the fence value, after which all command lists submitted to that queue so far are done.
+        Only the primary command queue is signaled for this, since the compute queue and the queues of the GPU nodes are signaled after each submission.
+        */
+        UINT64 SignalQueueFence(bool asyncCompute, UINT nodeIndex, ID3D12Fence*& fence);
+
+        // Waits until the specified fence (see SignalQueueFence) has crossed the specified fence value.
+        void WaitForQueueFence(ID3D12Fence* fence, UINT64 fenceValue);
+
+        // Returns the command queue of the specified GPU node, i.e. the primary command queue for node 0.
+        ID3D12CommandQueue* GetNodeQueue(UINT nodeIndex) const;
+
         // Close and execute command list.
         void CloseAndExecuteCommandList(ID3D12GraphicsCommandList* commandList);
 
         // Waits until the GPU has done all previous work.
-        void SyncGPU(UINT64& fenceValue);
         void SyncGPU();
 
-        void SignalFenceValue(UINT64 fenceValue);
+        // Schedules a signal command into the command queue and returns the new fence value.
+        UINT64 SignalFenceValue();
+
+        // Waits until the GPU has crossed the specified fence value. Returns immediately if the fence value is already completed.
         void WaitForFenceValue(UINT64 fenceValue);
 
+        // Returns true if the GPU has crossed the specified fence value.
+        bool IsFenceValueCompleted(UINT64 fenceValue) const;
+
+        // Returns the fence value that will be signaled next, i.e. the fence value after which all currently recorded command lists are done.
+        UINT64 GetNextFenceValue();
+
+        /*
+        Keeps the specified native object alive until the GPU has crossed the next fence value, i.e. the end of the current frame.
+        This allows to release resources while they might still be referenced by submitted or pending command lists.
+        The memory region of a placed resource is returned to the memory allocator at the same time.
+        */
+        void ReleaseDeferred(ID3D12Pageable* object, const D3D12MemoryRegion& memoryRegion = {});
+
         inline D3D_FEATURE_LEVEL GetFeatureLevel() const
         {
             return featureLevel_;
         }
 
+        inline IDXGIFactory4* GetDXGIFactory() const
+        {
+            return factory_.Get();
+        }
+
         inline ID3D12Device* GetDevice() const
         {
             return device_.Get();
@@ -154,25 +261,117 @@ class D3D12RenderSystem : public RenderSystem
             return commandQueue_.Get();
         }
 
+        inline ID3D12CommandQueue* GetComputeQueue() const
+        {
+            return computeQueue_.Get();
+        }
+
+        // Returns the allocator for placed resources in the default heap.
+        inline D3D12MemoryAllocator& GetMemoryAllocator()
+        {
+            return *memoryAllocator_;
+        }
+
+        // Returns the descriptor pool for render-target-views (RTV).
+        inline D3D12CPUDescriptorPool& GetRTVDescriptorPool()
+        {
+            return *rtvDescPool_;
+        }
+
+        // Returns the descriptor pool for depth-stencil-views (DSV).
+        inline D3D12CPUDescriptorPool& GetDSVDescriptorPool()
+        {
+            return *dsvDescPool_;
+        }
+
+        // Returns the pool for the query heaps of all queries.
+        inline D3D12QueryHeapPool& GetQueryHeapPool()
+        {
+            return *queryHeapPool_;
+        }
+
+        // Returns the command signature for indirect draw commands with tightly packed arguments.
+        inline ID3D12CommandSignature* GetDrawIndirectSignature() const
+        {
+            return drawIndirectSignature_.Get();
+        }
+
+        // Returns the command signature for indirect indexed draw commands with tightly packed arguments.
+        inline ID3D12CommandSignature* GetDrawIndexedIndirectSignature() const
+        {
+            return drawIndexedIndirectSignature_.Get();
+        }
+
+        // Returns the command signature for indirect dispatch commands.
+        inline ID3D12CommandSignature* GetDispatchIndirectSignature() const
+        {
+            return dispatchIndirectSignature_.Get();
+        }
+
+        // Returns the number of GPU nodes of the linked adapter the device has been created with.
+        inline UINT GetNumNodes() const
+        {
+            return numNodes_;
+        }
+
+        // Returns the node mask for objects that are created for the specified GPU node only, e.g. command lists and shader-visible descriptor heaps.
+        inline UINT GetNodeMask(UINT nodeIndex) const
+        {
+            return (1u << nodeIndex);
+        }
+
+        // Returns the node mask for objects that are shared between all GPU nodes, e.g. pipeline states and the visibility of resources.
+        inline UINT GetAllNodesMask() const
+        {
+            return ((1u << numNodes_) - 1u);
+        }
+
+        // Returns the cache for root signatures, and graphics and compute pipeline states.
+        inline D3D12PipelineCache& GetPipelineCache()
+        {
+            return pipelineCache_;
+        }
+
+        // Returns the info queue for the driver debugger, or null if there is no driver debugger.
+        inline D3D12InfoQueue* GetInfoQueue() const
+        {
+            return infoQueue_.get();
+        }
+
     private:
         
-        #ifdef LLGL_DEBUG
-        void EnableDebugLayer();
-        #endif
+        void EnableDebugLayer(bool gpuBasedValidation);
 
         void CreateFactory();
         void QueryVideoAdapters();
-        void CreateDevice();
+        void CreateDevice(const RenderSystemDescriptor& renderSystemDesc);
         bool CreateDevice(HRESULT& hr, IDXGIAdapter* adapter, const std::vector<D3D_FEATURE_LEVEL>& featureLevels);
         void CreateGPUSynchObjects();
+        void CreateNodeQueues();
+        void CreateCommandSignatures();
+
+        ComPtr<ID3D12CommandSignature> CreateDXCommandSignature(const D3D12_INDIRECT_ARGUMENT_TYPE argumentType, UINT byteStride);
 
         void QueryRendererInfo();
         void QueryRenderingCaps();
 
-        // Close, execute, and reset command list.
+        // Closes and executes the upload command list, returns it to the command list pool, and continues with another one.
         void ExecuteCommandList();
 
-        std::unique_ptr<D3D12Buffer> MakeBufferAndInitialize(const BufferDescriptor& desc, const void* initialData);
+        // Destroys all deferred native objects and recycles all command lists whose fence value has been completed by the GPU. Requires the queue mutex to be locked.
+        void RetireDeferredReleases();
+
+        // Executes the upload commands and tags the used staging memory with the next fence value, without waiting for the GPU. Requires the upload mutex to be locked.
+        void SubmitUploadCommands();
+
+        // Lets the command queue wait on the GPU until all compute and GPU node commands that have been submitted so far are done.
+        void WaitForSecondaryQueues();
+
+        // Creates a buffer and records the upload of its initial data into the upload command list. Requires the upload mutex to be locked.
+        std::unique_ptr<D3D12Buffer> MakeBufferAndRecordUpload(const BufferDescriptor& desc, const void* initialData);
+
+        // Creates a texture and records the upload of its initial image (or its initial transition) into the upload command list. Requires the upload mutex to be locked.
+        std::unique_ptr<D3D12Texture> MakeTextureAndRecordUpload(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc);
 
         /* ----- Common objects ----- */
 
@@ -181,17 +380,61 @@ class D3D12RenderSystem : public RenderSystem
         D3D_FEATURE_LEVEL                           featureLevel_           = D3D_FEATURE_LEVEL_9_1;
 
         ComPtr<ID3D12CommandQueue>                  commandQueue_;
-        ComPtr<ID3D12CommandAllocator>              commandAlloc_;
-        ComPtr<ID3D12GraphicsCommandList>           commandList_; // graphics command list to upload data to the GPU
+
+        std::unique_ptr<D3D12CommandListPool>       commandListPool_;   // recycles the command allocators of one-shot command lists
+        D3D12CommandContext                         uploadCommands_;    // graphics command list to upload data to the GPU
 
         ComPtr<ID3D12Fence>                         fence_;
-        HANDLE                                      fenceEvent_             = 0;
         UINT64                                      fenceValue_             = 0;
 
-        #ifdef LLGL_DEBUG
-        //ComPtr<ID3D12Debug>                         debugDevice_;
-        //ComPtr<ID3D12InfoQueue>                     debugInfoQueue_;
-        #endif
+        ComPtr<ID3D12CommandQueue>                  computeQueue_;          // dedicated queue for async compute command buffers
+        ComPtr<ID3D12Fence>                         computeFence_;
+        UINT64                                      computeFenceValue_      = 0;
+        UINT64                                      computeFenceWaited_     = 0; // last compute fence value the command queue waits for
+
+        // Command queue of a GPU node other than node 0 (see CommandBufferDescriptor::nodeIndex).
+        struct D3D12NodeQueue
+        {
+            ComPtr<ID3D12CommandQueue>  queue;
+            ComPtr<ID3D12Fence>         fence;
+            UINT64                      fenceValue      = 0;
+            UINT64                      fenceWaited     = 0; // last node fence value the command queue waits for
+            UINT64                      uploadWaited    = 0; // last upload fence value this node waits for
+        };
+
+        UINT                                        numNodes_               = 1;
+        std::vector<D3D12NodeQueue>                 nodeQueues_;            // command queues of the GPU nodes 1 to N-1
+        UINT64                                      uploadFenceValue_       = 0; // fence value of the most recent upload commands (guarded by queueMutex_)
+        std::atomic<bool>                           uploadPending_          { false };
+
+        // Native object that is destroyed when the GPU has crossed the fence value.
+        struct D3D12DeferredRelease
+        {
+            UINT64                  fenceValue;
+            ComPtr<ID3D12Pageable>  object;
+            D3D12MemoryRegion       memoryRegion;
+        };
+
+        std::unique_ptr<D3D12MemoryAllocator>       memoryAllocator_;   // must outlive the deferred releases
+
+        std::deque<D3D12DeferredRelease>            deferredReleases_;
+
+        std::unique_ptr<D3D12StagingBufferPool>     stagingBufferPool_; // upload memory for initial buffer and texture data
+
+        ComPtr<ID3D12CommandSignature>              drawIndirectSignature_;
+        ComPtr<ID3D12CommandSignature>              drawIndexedIndirectSignature_;
+        ComPtr<ID3D12CommandSignature>              dispatchIndirectSignature_;
+
+        D3D12PipelineCache                          pipelineCache_;
+
+        D3D12MipGenerator                           mipGenerator_;      // compute shader for "GenerateMips"
+
+        std::unique_ptr<D3D12CPUDescriptorPool>     rtvDescPool_;       // RTV descriptors of all render targets
+        std::unique_ptr<D3D12CPUDescriptorPool>     dsvDescPool_;       // DSV descriptors of all render targets
+
+        std::unique_ptr<D3D12QueryHeapPool>         queryHeapPool_;     // query heaps and readback buffers of all queries
+
+        std::unique_ptr<D3D12InfoQueue>             infoQueue_;         // only created if there is a driver debugger
 
         /* ----- Hardware object containers ----- */
 
@@ -200,16 +443,25 @@ class D3D12RenderSystem : public RenderSystem
         HWObjectContainer<D3D12Buffer>              buffers_;
         HWObjectContainer<BufferArray>              bufferArrays_;
         HWObjectContainer<D3D12Texture>             textures_;
-        //HWObjectContainer<D3D12RenderTarget>        renderTargets_;
+        HWObjectContainer<D3D12RenderTarget>        renderTargets_;
         HWObjectContainer<D3D12Shader>              shaders_;
         HWObjectContainer<D3D12ShaderProgram>       shaderPrograms_;
         HWObjectContainer<D3D12GraphicsPipeline>    graphicsPipelines_;
+        HWObjectContainer<D3D12ComputePipeline>     computePipelines_;
         //HWObjectContainer<D3D12Sampler>             samplers_;
+        HWObjectContainer<D3D12ResourceHeap>        resourceHeaps_;
+        HWObjectContainer<D3D12Query>               queries_;
+        HWObjectContainer<D3D12QueryArray>          queryArrays_;
+        HWObjectContainer<D3D12Fence>               fences_;
 
         /* ----- Other members ----- */
 
         std::vector<VideoAdapterDescriptor>         videoAdatperDescs_;
 
+        std::mutex                                  pipelineMutex_;
+        std::mutex                                  uploadMutex_;       // guards the upload command list and the staging buffer pool
+        std::mutex                                  queueMutex_;        // guards the fence values and the deferred releases
+
 };
 
 
@@ -0,0 +1,103 @@
+/*
+ * D3D12ResourceBarrierBatch.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12ResourceBarrierBatch.h"
+#include "D3DX12/d3dx12.h"
+
+
+namespace LLGL
+{
+
+
+void D3D12ResourceBarrierBatch::Transition(
+    ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter, UINT subresource)
+{
+    if (stateBefore == stateAfter)
+        return;
+
+    /* Merge with a pending (non-split) transition of the same subresource */
+    for (auto it = barriers_.begin(); it != barriers_.end(); ++it)
+    {
+        auto& transition = it->Transition;
+        if (it->Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && it->Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+            transition.pResource == resource && transition.Subresource == subresource && transition.StateAfter == stateBefore)
+        {
+            if (transition.StateBefore == stateAfter)
+                barriers_.erase(it);
+            else
+                transition.StateAfter = stateAfter;
+            return;
+        }
+    }
+
+    barriers_.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource, stateBefore, stateAfter, subresource));
+}
+
+void D3D12ResourceBarrierBatch::SplitTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter)
+{
+    if (stateBefore == stateAfter)
+        return;
+
+    barriers_.push_back(
+        CD3DX12_RESOURCE_BARRIER::Transition(
+            resource, stateBefore, stateAfter,
+            D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY
+        )
+    );
+    splitEndBarriers_.push_back(
+        CD3DX12_RESOURCE_BARRIER::Transition(
+            resource, stateBefore, stateAfter,
+            D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY
+        )
+    );
+}
+
+void D3D12ResourceBarrierBatch::UAV(ID3D12Resource* resource)
+{
+    /* Skip barrier if a pending UAV barrier already covers this resource */
+    for (const auto& barrier : barriers_)
+    {
+        if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV &&
+            (barrier.UAV.pResource == nullptr || barrier.UAV.pResource == resource))
+        {
+            return;
+        }
+    }
+
+    barriers_.push_back(CD3DX12_RESOURCE_BARRIER::UAV(resource));
+}
+
+void D3D12ResourceBarrierBatch::Flush(ID3D12GraphicsCommandList* commandList)
+{
+    if (!barriers_.empty())
+    {
+        commandList->ResourceBarrier(static_cast<UINT>(barriers_.size()), barriers_.data());
+        barriers_.clear();
+    }
+
+    /* End barriers of split transitions are submitted with the next flush */
+    barriers_.swap(splitEndBarriers_);
+}
+
+void D3D12ResourceBarrierBatch::Finish(ID3D12GraphicsCommandList* commandList)
+{
+    Flush(commandList);
+    Flush(commandList);
+}
+
+void D3D12ResourceBarrierBatch::Clear()
+{
+    barriers_.clear();
+    splitEndBarriers_.clear();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,72 @@
+/*
+ * D3D12ResourceBarrierBatch.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_RESOURCE_BARRIER_BATCH_H
+#define LLGL_D3D12_RESOURCE_BARRIER_BATCH_H
+
+
+#include <vector>
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Collects resource transition barriers of a command list and submits them with a single "ResourceBarrier" call,
+right before the next command that depends on them (e.g. draw, dispatch, clear, or copy commands).
+A transition that continues a pending transition of the same resource is merged with it,
+and both are dropped if the resource ends up in its previous state.
+*/
+class D3D12ResourceBarrierBatch
+{
+
+    public:
+
+        // Adds a transition barrier for the specified subresource, or for all subresources of the specified resource by default.
+        void Transition(
+            ID3D12Resource*         resource,
+            D3D12_RESOURCE_STATES   stateBefore,
+            D3D12_RESOURCE_STATES   stateAfter,
+            UINT                    subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+        );
+
+        /*
+        Adds a split transition barrier: the begin barrier is submitted with the next flush and the end barrier with the flush after that.
+        This allows the GPU to perform the transition while the commands in between are executed.
+        */
+        void SplitTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter);
+
+        // Adds a UAV barrier for the specified resource, or for all resources if 'resource' is null. Duplicate UAV barriers are dropped.
+        void UAV(ID3D12Resource* resource);
+
+        // Submits all pending barriers to the specified command list. The end barriers of split transitions are kept for the next flush.
+        void Flush(ID3D12GraphicsCommandList* commandList);
+
+        // Submits all pending barriers including the end barriers of split transitions. Must be called before the command list is closed.
+        void Finish(ID3D12GraphicsCommandList* commandList);
+
+        // Discards all pending barriers, e.g. after the command list has been reset.
+        void Clear();
+
+    private:
+
+        std::vector<D3D12_RESOURCE_BARRIER> barriers_;
+        std::vector<D3D12_RESOURCE_BARRIER> splitEndBarriers_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
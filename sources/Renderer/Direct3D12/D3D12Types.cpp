@@ -131,6 +131,34 @@ D3D12_STENCIL_OP Map(const StencilOp stencilOp)
     DXTypes::MapFailed("StencilOp", "D3D12_STENCIL_OP");
 }
 
+D3D12_QUERY_TYPE Map(const QueryType queryType)
+{
+    switch (queryType)
+    {
+        case QueryType::SamplesPassed:                      return D3D12_QUERY_TYPE_OCCLUSION;
+        case QueryType::AnySamplesPassed:                   /* pass */
+        case QueryType::AnySamplesPassedConservative:       return D3D12_QUERY_TYPE_BINARY_OCCLUSION;
+        case QueryType::TimeElapsed:                        /* pass */
+        case QueryType::Timestamp:                          return D3D12_QUERY_TYPE_TIMESTAMP;
+        case QueryType::StreamOutOverflow:                  /* pass */
+        case QueryType::StreamOutPrimitivesWritten:         return D3D12_QUERY_TYPE_SO_STATISTICS_STREAM0;
+        case QueryType::PrimitivesGenerated:                /* pass */
+        case QueryType::VerticesSubmitted:                  /* pass */
+        case QueryType::PrimitivesSubmitted:                /* pass */
+        case QueryType::VertexShaderInvocations:            /* pass */
+        case QueryType::TessControlShaderInvocations:       /* pass */
+        case QueryType::TessEvaluationShaderInvocations:    /* pass */
+        case QueryType::GeometryShaderInvocations:          /* pass */
+        case QueryType::FragmentShaderInvocations:          /* pass */
+        case QueryType::ComputeShaderInvocations:           /* pass */
+        case QueryType::GeometryPrimitivesGenerated:        /* pass */
+        case QueryType::ClippingInputPrimitives:            /* pass */
+        case QueryType::ClippingOutputPrimitives:           /* pass */
+        case QueryType::PipelineStatistics:                 return D3D12_QUERY_TYPE_PIPELINE_STATISTICS;
+    }
+    DXTypes::MapFailed("QueryType", "D3D12_QUERY_TYPE");
+}
+
 TextureFormat Unmap(const DXGI_FORMAT format)
 {
     return DXTypes::Unmap(format);
@@ -13,6 +13,7 @@
 #include <LLGL/GraphicsPipelineFlags.h>
 #include <LLGL/RenderContextFlags.h>
 #include <LLGL/TextureFlags.h>
+#include <LLGL/QueryFlags.h>
 #include <d3d12.h>
 
 
@@ -33,6 +34,7 @@ D3D12_BLEND                 Map( const BlendOp              blendOp         );
 D3D12_BLEND_OP              Map( const BlendArithmetic      blendArithmetic );
 D3D12_COMPARISON_FUNC       Map( const CompareOp            compareOp       );
 D3D12_STENCIL_OP            Map( const StencilOp            stencilOp       );
+D3D12_QUERY_TYPE            Map( const QueryType            queryType       );
 
 TextureFormat               Unmap( const DXGI_FORMAT format );
 
@@ -0,0 +1,55 @@
+/*
+ * D3D12ComputePipeline.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12ComputePipeline.h"
+#include "../D3D12RenderSystem.h"
+#include "../Shader/D3D12ShaderProgram.h"
+#include "../Shader/D3D12Shader.h"
+#include "../../CheckedCast.h"
+#include "../../Assertion.h"
+#include "../../../Core/Helper.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+D3D12ComputePipeline::D3D12ComputePipeline(D3D12RenderSystem& renderSystem, const ComputePipelineDescriptor& desc)
+{
+    /* Validate pointers and get D3D shader program */
+    LLGL_ASSERT_PTR(desc.shaderProgram);
+
+    auto shaderProgramD3D = LLGL_CAST(D3D12ShaderProgram*, desc.shaderProgram);
+
+    auto computeShader = shaderProgramD3D->GetCS();
+    if (!computeShader)
+        throw std::invalid_argument("cannot create D3D12 compute pipeline without compute shader");
+
+    /* Create root signature without input assembler (compute pipelines have no push constants) */
+    layout_.Create(renderSystem, *shaderProgramD3D, PushConstantsDescriptor{}, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+    /* Get compute pipeline state from the pipeline cache */
+    D3D12_COMPUTE_PIPELINE_STATE_DESC stateDesc;
+    InitMemory(stateDesc);
+    {
+        stateDesc.pRootSignature    = layout_.GetRootSignature();
+        stateDesc.CS                = computeShader->GetByteCode();
+        stateDesc.NodeMask          = renderSystem.GetAllNodesMask();
+        stateDesc.Flags             = D3D12_PIPELINE_STATE_FLAG_NONE;
+    }
+    pipelineState_ = renderSystem.GetPipelineCache().GetOrCreateComputePipelineState(
+        renderSystem.GetDevice(), stateDesc, layout_.GetRootSignatureHash()
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,62 @@
+/*
+ * D3D12ComputePipeline.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_COMPUTE_PIPELINE_H
+#define LLGL_D3D12_COMPUTE_PIPELINE_H
+
+
+#include <LLGL/ComputePipeline.h>
+#include "../../DXCommon/ComPtr.h"
+#include "D3D12PipelineLayout.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+
+class D3D12ComputePipeline : public ComputePipeline
+{
+
+    public:
+
+        D3D12ComputePipeline(D3D12RenderSystem& renderSystem, const ComputePipelineDescriptor& desc);
+
+        inline ID3D12RootSignature* GetRootSignature() const
+        {
+            return layout_.GetRootSignature();
+        }
+
+        inline ID3D12PipelineState* GetPipelineState() const
+        {
+            return pipelineState_.Get();
+        }
+
+        // Returns the layout of the root signature.
+        inline const D3D12PipelineLayout& GetLayout() const
+        {
+            return layout_;
+        }
+
+    private:
+
+        D3D12PipelineLayout         layout_;
+        ComPtr<ID3D12PipelineState> pipelineState_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,66 @@
+/*
+ * D3D12Fence.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12Fence.h"
+#include "../../DXCommon/DXCore.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+D3D12Fence::D3D12Fence(ID3D12Device* device)
+{
+    auto hr = device->CreateFence(value_, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(fence_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 fence");
+
+    event_ = CreateEventEx(nullptr, nullptr, 0, EVENT_ALL_ACCESS);
+}
+
+D3D12Fence::~D3D12Fence()
+{
+    CloseHandle(event_);
+}
+
+bool D3D12Fence::IsSignaled()
+{
+    return (fence_->GetCompletedValue() >= value_);
+}
+
+// Converts the specified timeout (in nanoseconds) to milliseconds for WaitForSingleObjectEx, rounded up.
+static DWORD GetWaitTimeoutMilliseconds(std::uint64_t timeout)
+{
+    if (timeout == ~0ull)
+        return INFINITE;
+    auto milliseconds = (timeout + 999999ull) / 1000000ull;
+    return static_cast<DWORD>(std::min<std::uint64_t>(milliseconds, INFINITE - 1));
+}
+
+bool D3D12Fence::Wait(std::uint64_t timeout)
+{
+    if (fence_->GetCompletedValue() < value_)
+    {
+        auto hr = fence_->SetEventOnCompletion(value_, event_);
+        DXThrowIfFailed(hr, "failed to set 'on completion'-event for D3D12 fence");
+        return (WaitForSingleObjectEx(event_, GetWaitTimeoutMilliseconds(timeout), FALSE) == WAIT_OBJECT_0);
+    }
+    return true;
+}
+
+void D3D12Fence::Signal(ID3D12CommandQueue* commandQueue)
+{
+    auto hr = commandQueue->Signal(fence_.Get(), ++value_);
+    DXThrowIfFailed(hr, "failed to signal D3D12 fence");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,52 @@
+/*
+ * D3D12Fence.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_FENCE_H
+#define LLGL_D3D12_FENCE_H
+
+
+#include <LLGL/Fence.h>
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+// Fence object with its own D3D12 fence, which is signaled with an increasing value on either the graphics or the compute queue.
+class D3D12Fence : public Fence
+{
+
+    public:
+
+        D3D12Fence(ID3D12Device* device);
+        ~D3D12Fence();
+
+        bool IsSignaled() override;
+        bool Wait(std::uint64_t timeout) override;
+
+        // Schedules a signal command with the next fence value into the specified command queue.
+        void Signal(ID3D12CommandQueue* commandQueue);
+
+    private:
+
+        ComPtr<ID3D12Fence> fence_;
+        HANDLE              event_  = 0;
+        UINT64              value_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -15,6 +15,7 @@
 #include "../../CheckedCast.h"
 #include "../../Assertion.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/Exception.h"
 #include <algorithm>
 
 
@@ -26,6 +27,10 @@ namespace LLGL
 D3D12GraphicsPipeline::D3D12GraphicsPipeline(
     D3D12RenderSystem& renderSystem, const GraphicsPipelineDescriptor& desc)
 {
+    /* Multiview rendering (view instancing) is only implemented for OpenGL */
+    if (desc.viewMask != 0)
+        ThrowNotSupported("multiview rendering");
+
     /* Validate pointers and get D3D shader program */
     LLGL_ASSERT_PTR(desc.shaderProgram);
 
@@ -40,75 +45,9 @@ D3D12GraphicsPipeline::D3D12GraphicsPipeline(
 }
 
 void D3D12GraphicsPipeline::CreateRootSignature(
-    D3D12RenderSystem& renderSystem, D3D12ShaderProgram& shaderProgram, const GraphicsPipelineDescriptor& /*desc*/)
+    D3D12RenderSystem& renderSystem, D3D12ShaderProgram& shaderProgram, const GraphicsPipelineDescriptor& desc)
 {
-    /* Setup root signature flags */
-    D3D12_ROOT_SIGNATURE_FLAGS signatureFlags =
-    (
-        D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT/* |
-        D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS     |
-        D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS   |
-        D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS       |
-        D3D12_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS*/
-    );
-
-    /* Setup descritpor structures for root signature */
-    std::vector<CD3DX12_DESCRIPTOR_RANGE> signatureRange;
-
-    auto AddSignatureRange = [&](D3D12_DESCRIPTOR_RANGE_TYPE type, UINT count)
-    {
-        if (count > 0)
-        {
-            CD3DX12_DESCRIPTOR_RANGE rangeDesc;
-            rangeDesc.Init(type, count, 0);
-            signatureRange.push_back(rangeDesc);
-        }
-    };
-
-    AddSignatureRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, shaderProgram.GetNumSRV());
-    AddSignatureRange(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, shaderProgram.GetNumCBV());
-    AddSignatureRange(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, shaderProgram.GetNumUAV());
-
-    CD3DX12_ROOT_SIGNATURE_DESC signatureDesc;
-    if (!signatureRange.empty())
-    {
-        CD3DX12_ROOT_PARAMETER signatureParam;
-        signatureParam.InitAsDescriptorTable(static_cast<UINT>(signatureRange.size()), signatureRange.data(), D3D12_SHADER_VISIBILITY_ALL);
-
-        signatureDesc.Init(1, &signatureParam, 0, nullptr, signatureFlags);
-    }
-    else
-        signatureDesc.Init(0, nullptr, 0, nullptr, signatureFlags);
-
-    /* Create serialized root signature */
-    HRESULT             hr          = 0;
-    ComPtr<ID3DBlob>    signature;
-    ComPtr<ID3DBlob>    error;
-
-    hr = D3D12SerializeRootSignature(
-        &signatureDesc,
-        D3D_ROOT_SIGNATURE_VERSION_1,
-        signature.ReleaseAndGetAddressOf(),
-        error.ReleaseAndGetAddressOf()
-    );
-    
-    if (FAILED(hr) && error)
-    {
-        auto errorStr = DXGetBlobString(error.Get());
-        throw std::runtime_error("failed to serialize D3D12 root signature: " + errorStr);
-    }
-
-    DXThrowIfFailed(hr, "failed to serialize D3D12 root signature");
-
-    /* Create actual root signature */
-    hr = renderSystem.GetDevice()->CreateRootSignature(
-        0,
-        signature->GetBufferPointer(),
-        signature->GetBufferSize(),
-        IID_PPV_ARGS(rootSignature_.ReleaseAndGetAddressOf())
-    );
-
-    DXThrowIfFailed(hr, "failed to create D3D12 root signature");
+    layout_.Create(renderSystem, shaderProgram, desc.pushConstants, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
 }
 
 static D3D12_CONSERVATIVE_RASTERIZATION_MODE GetConservativeRaster(bool enabled)
@@ -174,10 +113,11 @@ void D3D12GraphicsPipeline::CreatePipelineState(
     D3D12RenderSystem& renderSystem, D3D12ShaderProgram& shaderProgram, const GraphicsPipelineDescriptor& desc)
 {
     /* Setup D3D12 graphics pipeline descriptor */
-    D3D12_GRAPHICS_PIPELINE_STATE_DESC stateDesc;
+    D3D12GraphicsPipelineStateDesc stateDesc;
     InitMemory(stateDesc);
 
-    stateDesc.pRootSignature = rootSignature_.Get();
+    stateDesc.pRootSignature = layout_.GetRootSignature();
+    stateDesc.NodeMask       = renderSystem.GetAllNodesMask();
 
     /* Get shader byte codes */
     stateDesc.VS = GetShaderByteCode(shaderProgram.GetVS());
@@ -252,6 +192,9 @@ void D3D12GraphicsPipeline::CreatePipelineState(
     Convert(stateDesc.DepthStencilState.FrontFace, desc.stencil.front);
     Convert(stateDesc.DepthStencilState.BackFace, desc.stencil.back);
 
+    /* Depth-bounds test is ignored if not supported, because the bounds can only be set with ID3D12GraphicsCommandList1 */
+    stateDesc.DepthBoundsTestEnable = (desc.depth.boundsTestEnabled && renderSystem.GetRenderingCaps().hasDepthBoundsTest ? TRUE : FALSE);
+
     /* Convert other states */
     stateDesc.InputLayout           = shaderProgram.GetInputLayoutDesc();
     stateDesc.IBStripCutValue       = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
@@ -267,8 +210,46 @@ void D3D12GraphicsPipeline::CreatePipelineState(
     for (UINT i = 0; i < 8u; ++i)
         stateDesc.RTVFormats[i] = (i < stateDesc.NumRenderTargets ? DXGI_FORMAT_B8G8R8A8_UNORM : DXGI_FORMAT_UNKNOWN);
 
-    /* Create graphics pipeline state and graphics command list */
-    pipelineState_ = renderSystem.CreateDXGfxPipelineState(stateDesc);
+    /* Get graphics pipeline state from the pipeline cache */
+    if (shaderProgram.GetMS() != nullptr)
+        CreateMeshPipelineState(renderSystem, shaderProgram, stateDesc);
+    else
+    {
+        pipelineState_ = renderSystem.GetPipelineCache().GetOrCreateGraphicsPipelineState(
+            renderSystem.GetDevice(), stateDesc, layout_.GetRootSignatureHash()
+        );
+    }
+}
+
+void D3D12GraphicsPipeline::CreateMeshPipelineState(
+    D3D12RenderSystem& renderSystem, D3D12ShaderProgram& shaderProgram, const D3D12GraphicsPipelineStateDesc& graphicsStateDesc)
+{
+    /* Take over all render states, but replace the vertex processing stages by the amplification and mesh shaders */
+    D3D12MeshPipelineStateDesc stateDesc;
+    InitMemory(stateDesc);
+
+    stateDesc.pRootSignature        = graphicsStateDesc.pRootSignature;
+    stateDesc.AS                    = GetShaderByteCode(shaderProgram.GetAS());
+    stateDesc.MS                    = GetShaderByteCode(shaderProgram.GetMS());
+    stateDesc.PS                    = graphicsStateDesc.PS;
+    stateDesc.BlendState            = graphicsStateDesc.BlendState;
+    stateDesc.SampleMask            = graphicsStateDesc.SampleMask;
+    stateDesc.RasterizerState       = graphicsStateDesc.RasterizerState;
+    stateDesc.DepthStencilState     = graphicsStateDesc.DepthStencilState;
+    stateDesc.PrimitiveTopologyType = graphicsStateDesc.PrimitiveTopologyType;
+    stateDesc.NumRenderTargets      = graphicsStateDesc.NumRenderTargets;
+    stateDesc.DSVFormat             = graphicsStateDesc.DSVFormat;
+    stateDesc.SampleDesc            = graphicsStateDesc.SampleDesc;
+    stateDesc.NodeMask              = graphicsStateDesc.NodeMask;
+    stateDesc.Flags                 = graphicsStateDesc.Flags;
+    stateDesc.DepthBoundsTestEnable = graphicsStateDesc.DepthBoundsTestEnable;
+
+    for (UINT i = 0; i < 8u; ++i)
+        stateDesc.RTVFormats[i] = graphicsStateDesc.RTVFormats[i];
+
+    pipelineState_ = renderSystem.GetPipelineCache().GetOrCreateMeshPipelineState(
+        renderSystem.GetDevice(), stateDesc, layout_.GetRootSignatureHash()
+    );
 }
 
 
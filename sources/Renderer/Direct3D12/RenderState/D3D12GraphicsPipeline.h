@@ -11,7 +11,10 @@
 
 #include <LLGL/GraphicsPipeline.h>
 #include "../../DXCommon/ComPtr.h"
+#include "D3D12PipelineLayout.h"
+#include "D3D12PipelineCache.h"
 #include <vector>
+#include <cstdint>
 #include <d3d12.h>
 
 
@@ -35,7 +38,7 @@ class D3D12GraphicsPipeline : public GraphicsPipeline
 
         inline ID3D12RootSignature* GetRootSignature() const
         {
-            return rootSignature_.Get();
+            return layout_.GetRootSignature();
         }
 
         inline ID3D12PipelineState* GetPipelineState() const
@@ -48,12 +51,19 @@ class D3D12GraphicsPipeline : public GraphicsPipeline
             return primitiveTopology_;
         }
 
+        // Returns the layout of the root signature.
+        inline const D3D12PipelineLayout& GetLayout() const
+        {
+            return layout_;
+        }
+
     private:
 
         void CreateRootSignature(D3D12RenderSystem& renderSystem, D3D12ShaderProgram& shaderProgram, const GraphicsPipelineDescriptor& desc);
         void CreatePipelineState(D3D12RenderSystem& renderSystem, D3D12ShaderProgram& shaderProgram, const GraphicsPipelineDescriptor& desc);
+        void CreateMeshPipelineState(D3D12RenderSystem& renderSystem, D3D12ShaderProgram& shaderProgram, const D3D12GraphicsPipelineStateDesc& graphicsStateDesc);
 
-        ComPtr<ID3D12RootSignature> rootSignature_;
+        D3D12PipelineLayout         layout_;
         ComPtr<ID3D12PipelineState> pipelineState_;
 
         D3D12_PRIMITIVE_TOPOLOGY    primitiveTopology_ = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
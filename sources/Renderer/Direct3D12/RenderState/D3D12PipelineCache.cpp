@@ -0,0 +1,489 @@
+/*
+ * D3D12PipelineCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12PipelineCache.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../../Core/Hash.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- Hashing ----- */
+
+static void HashString(std::uint64_t& hash, const char* str)
+{
+    if (str)
+        HashBytes(hash, str, std::strlen(str) + 1);
+    else
+        HashValue(hash, '\0');
+}
+
+static void HashByteCode(std::uint64_t& hash, const D3D12_SHADER_BYTECODE& byteCode)
+{
+    HashValue(hash, byteCode.BytecodeLength);
+    if (byteCode.pShaderBytecode)
+        HashBytes(hash, byteCode.pShaderBytecode, byteCode.BytecodeLength);
+}
+
+static void HashInputLayout(std::uint64_t& hash, const D3D12_INPUT_LAYOUT_DESC& inputLayout)
+{
+    HashValue(hash, inputLayout.NumElements);
+    for (UINT i = 0; i < inputLayout.NumElements; ++i)
+    {
+        const auto& element = inputLayout.pInputElementDescs[i];
+        HashString(hash, element.SemanticName);
+        HashValue(hash, element.SemanticIndex);
+        HashValue(hash, element.Format);
+        HashValue(hash, element.InputSlot);
+        HashValue(hash, element.AlignedByteOffset);
+        HashValue(hash, element.InputSlotClass);
+        HashValue(hash, element.InstanceDataStepRate);
+    }
+}
+
+/*
+The render states are hashed member-wise by their POD structures,
+which is only valid because the pipeline descriptor has been zero-initialized (including padding).
+*/
+static std::uint64_t HashGraphicsPipelineStateDesc(const D3D12GraphicsPipelineStateDesc& desc, std::uint64_t rootSignatureHash)
+{
+    auto hash = HashInitValue();
+
+    HashValue(hash, rootSignatureHash);
+
+    HashByteCode(hash, desc.VS);
+    HashByteCode(hash, desc.PS);
+    HashByteCode(hash, desc.DS);
+    HashByteCode(hash, desc.HS);
+    HashByteCode(hash, desc.GS);
+
+    HashValue(hash, desc.BlendState);
+    HashValue(hash, desc.SampleMask);
+    HashValue(hash, desc.RasterizerState);
+    HashValue(hash, desc.DepthStencilState);
+    HashInputLayout(hash, desc.InputLayout);
+    HashValue(hash, desc.IBStripCutValue);
+    HashValue(hash, desc.PrimitiveTopologyType);
+    HashValue(hash, desc.NumRenderTargets);
+    HashValue(hash, desc.RTVFormats);
+    HashValue(hash, desc.DSVFormat);
+    HashValue(hash, desc.SampleDesc);
+    HashValue(hash, desc.NodeMask);
+    HashValue(hash, desc.Flags);
+    HashValue(hash, desc.DepthBoundsTestEnable);
+
+    return hash;
+}
+
+static std::uint64_t HashMeshPipelineStateDesc(const D3D12MeshPipelineStateDesc& desc, std::uint64_t rootSignatureHash)
+{
+    auto hash = HashInitValue();
+
+    HashValue(hash, rootSignatureHash);
+
+    HashByteCode(hash, desc.AS);
+    HashByteCode(hash, desc.MS);
+    HashByteCode(hash, desc.PS);
+
+    HashValue(hash, desc.BlendState);
+    HashValue(hash, desc.SampleMask);
+    HashValue(hash, desc.RasterizerState);
+    HashValue(hash, desc.DepthStencilState);
+    HashValue(hash, desc.PrimitiveTopologyType);
+    HashValue(hash, desc.NumRenderTargets);
+    HashValue(hash, desc.RTVFormats);
+    HashValue(hash, desc.DSVFormat);
+    HashValue(hash, desc.SampleDesc);
+    HashValue(hash, desc.NodeMask);
+    HashValue(hash, desc.Flags);
+    HashValue(hash, desc.DepthBoundsTestEnable);
+
+    return hash;
+}
+
+static std::uint64_t HashComputePipelineStateDesc(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, std::uint64_t rootSignatureHash)
+{
+    auto hash = HashInitValue();
+
+    HashValue(hash, rootSignatureHash);
+    HashByteCode(hash, desc.CS);
+    HashValue(hash, desc.NodeMask);
+    HashValue(hash, desc.Flags);
+
+    return hash;
+}
+
+
+/* ----- Serialization ----- */
+
+static const std::uint32_t g_cacheMagic     = 0x4350534C; // "LSPC"
+static const std::uint32_t g_cacheVersion   = 2;
+
+struct PipelineCacheHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t numEntries;
+};
+
+struct PipelineCacheEntryHeader
+{
+    std::uint64_t hash;
+    std::uint64_t size;
+};
+
+template <typename T>
+void WriteValue(std::vector<char>& data, const T& value)
+{
+    auto bytes = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(const std::vector<char>& data, std::size_t& offset, T& value)
+{
+    if (offset + sizeof(T) > data.size())
+        return false;
+    std::memcpy(&value, &data[offset], sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+
+static HRESULT CreatePipelineState(ID3D12Device* device, const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, ComPtr<ID3D12PipelineState>& pipelineState)
+{
+    return device->CreateComputePipelineState(&desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+}
+
+
+// Subobject of a pipeline state stream; each subobject must be aligned to the size of a pointer.
+template <typename T>
+struct alignas(void*) D3D12StreamSubobject
+{
+    D3D12_PIPELINE_STATE_SUBOBJECT_TYPE type;
+    T                                   value;
+};
+
+// Returns the depth-stencil state with the depth-bounds test state, which is only available as pipeline state stream subobject.
+static D3D12_DEPTH_STENCIL_DESC1 GetDepthStencilDesc1(const D3D12_DEPTH_STENCIL_DESC& desc, BOOL depthBoundsTestEnable)
+{
+    D3D12_DEPTH_STENCIL_DESC1 desc1;
+    {
+        desc1.DepthEnable           = desc.DepthEnable;
+        desc1.DepthWriteMask        = desc.DepthWriteMask;
+        desc1.DepthFunc             = desc.DepthFunc;
+        desc1.StencilEnable         = desc.StencilEnable;
+        desc1.StencilReadMask       = desc.StencilReadMask;
+        desc1.StencilWriteMask      = desc.StencilWriteMask;
+        desc1.FrontFace             = desc.FrontFace;
+        desc1.BackFace              = desc.BackFace;
+        desc1.DepthBoundsTestEnable = depthBoundsTestEnable;
+    }
+    return desc1;
+}
+
+struct D3D12GraphicsPipelineStateStream
+{
+    D3D12StreamSubobject<ID3D12RootSignature*>               rootSignature;
+    D3D12StreamSubobject<D3D12_SHADER_BYTECODE>              vs;
+    D3D12StreamSubobject<D3D12_SHADER_BYTECODE>              ps;
+    D3D12StreamSubobject<D3D12_SHADER_BYTECODE>              ds;
+    D3D12StreamSubobject<D3D12_SHADER_BYTECODE>              hs;
+    D3D12StreamSubobject<D3D12_SHADER_BYTECODE>              gs;
+    D3D12StreamSubobject<D3D12_STREAM_OUTPUT_DESC>           streamOutput;
+    D3D12StreamSubobject<D3D12_BLEND_DESC>                   blendState;
+    D3D12StreamSubobject<UINT>                               sampleMask;
+    D3D12StreamSubobject<D3D12_RASTERIZER_DESC>              rasterizerState;
+    D3D12StreamSubobject<D3D12_DEPTH_STENCIL_DESC1>          depthStencilState;
+    D3D12StreamSubobject<D3D12_INPUT_LAYOUT_DESC>            inputLayout;
+    D3D12StreamSubobject<D3D12_INDEX_BUFFER_STRIP_CUT_VALUE> ibStripCutValue;
+    D3D12StreamSubobject<D3D12_PRIMITIVE_TOPOLOGY_TYPE>      primitiveTopologyType;
+    D3D12StreamSubobject<D3D12_RT_FORMAT_ARRAY>              rtvFormats;
+    D3D12StreamSubobject<DXGI_FORMAT>                        dsvFormat;
+    D3D12StreamSubobject<DXGI_SAMPLE_DESC>                   sampleDesc;
+    D3D12StreamSubobject<UINT>                               nodeMask;
+    D3D12StreamSubobject<D3D12_CACHED_PIPELINE_STATE>        cachedPSO;
+    D3D12StreamSubobject<D3D12_PIPELINE_STATE_FLAGS>         flags;
+};
+
+static HRESULT CreatePipelineState(ID3D12Device* device, const D3D12GraphicsPipelineStateDesc& desc, ComPtr<ID3D12PipelineState>& pipelineState)
+{
+    /* Only use a pipeline state stream if the depth-bounds test is enabled, since this requires ID3D12Device2 */
+    if (!desc.DepthBoundsTestEnable)
+        return device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+
+    ComPtr<ID3D12Device2> device2;
+    auto hr = device->QueryInterface(IID_PPV_ARGS(device2.GetAddressOf()));
+    if (FAILED(hr))
+        return hr;
+
+    D3D12_RT_FORMAT_ARRAY rtvFormats;
+    {
+        rtvFormats.NumRenderTargets = desc.NumRenderTargets;
+        std::memcpy(rtvFormats.RTFormats, desc.RTVFormats, sizeof(desc.RTVFormats));
+    }
+
+    auto depthStencilState = GetDepthStencilDesc1(desc.DepthStencilState, TRUE);
+
+    D3D12GraphicsPipelineStateStream stream =
+    {
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE,          desc.pRootSignature        },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VS,                      desc.VS                    },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS,                      desc.PS                    },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DS,                      desc.DS                    },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_HS,                      desc.HS                    },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_GS,                      desc.GS                    },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_STREAM_OUTPUT,           desc.StreamOutput          },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND,                   desc.BlendState            },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK,             desc.SampleMask            },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER,              desc.RasterizerState       },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL1,          depthStencilState          },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_INPUT_LAYOUT,            desc.InputLayout           },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_IB_STRIP_CUT_VALUE,      desc.IBStripCutValue       },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY,      desc.PrimitiveTopologyType },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS,   rtvFormats                 },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT,    desc.DSVFormat             },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC,             desc.SampleDesc            },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK,               desc.NodeMask              },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO,              desc.CachedPSO             },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS,                   desc.Flags                 },
+    };
+
+    D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+    {
+        streamDesc.SizeInBytes                      = sizeof(stream);
+        streamDesc.pPipelineStateSubobjectStream    = &stream;
+    }
+    return device2->CreatePipelineState(&streamDesc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+}
+
+struct D3D12MeshPipelineStateStream
+{
+    D3D12StreamSubobject<ID3D12RootSignature*>          rootSignature;
+    D3D12StreamSubobject<D3D12_SHADER_BYTECODE>         as;
+    D3D12StreamSubobject<D3D12_SHADER_BYTECODE>         ms;
+    D3D12StreamSubobject<D3D12_SHADER_BYTECODE>         ps;
+    D3D12StreamSubobject<D3D12_BLEND_DESC>              blendState;
+    D3D12StreamSubobject<UINT>                          sampleMask;
+    D3D12StreamSubobject<D3D12_RASTERIZER_DESC>         rasterizerState;
+    D3D12StreamSubobject<D3D12_DEPTH_STENCIL_DESC1>     depthStencilState;
+    D3D12StreamSubobject<D3D12_PRIMITIVE_TOPOLOGY_TYPE> primitiveTopologyType;
+    D3D12StreamSubobject<D3D12_RT_FORMAT_ARRAY>         rtvFormats;
+    D3D12StreamSubobject<DXGI_FORMAT>                   dsvFormat;
+    D3D12StreamSubobject<DXGI_SAMPLE_DESC>              sampleDesc;
+    D3D12StreamSubobject<UINT>                          nodeMask;
+    D3D12StreamSubobject<D3D12_CACHED_PIPELINE_STATE>   cachedPSO;
+    D3D12StreamSubobject<D3D12_PIPELINE_STATE_FLAGS>    flags;
+};
+
+static HRESULT CreatePipelineState(ID3D12Device* device, const D3D12MeshPipelineStateDesc& desc, ComPtr<ID3D12PipelineState>& pipelineState)
+{
+    /* Pipeline state streams require ID3D12Device2 */
+    ComPtr<ID3D12Device2> device2;
+    auto hr = device->QueryInterface(IID_PPV_ARGS(device2.GetAddressOf()));
+    if (FAILED(hr))
+        return hr;
+
+    D3D12_RT_FORMAT_ARRAY rtvFormats;
+    {
+        rtvFormats.NumRenderTargets = desc.NumRenderTargets;
+        std::memcpy(rtvFormats.RTFormats, desc.RTVFormats, sizeof(desc.RTVFormats));
+    }
+
+    auto depthStencilState = GetDepthStencilDesc1(desc.DepthStencilState, desc.DepthBoundsTestEnable);
+
+    D3D12MeshPipelineStateStream stream =
+    {
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE,       desc.pRootSignature        },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS,                   desc.AS                    },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS,                   desc.MS                    },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS,                   desc.PS                    },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND,                desc.BlendState            },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK,          desc.SampleMask            },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER,           desc.RasterizerState       },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL1,       depthStencilState          },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY,   desc.PrimitiveTopologyType },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS, rtvFormats                },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT, desc.DSVFormat             },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC,          desc.SampleDesc            },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK,            desc.NodeMask              },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO,           desc.CachedPSO             },
+        { D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS,                desc.Flags                 },
+    };
+
+    D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+    {
+        streamDesc.SizeInBytes                      = sizeof(stream);
+        streamDesc.pPipelineStateSubobjectStream    = &stream;
+    }
+    return device2->CreatePipelineState(&streamDesc, IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf()));
+}
+
+
+/* ----- D3D12PipelineCache class ----- */
+
+ComPtr<ID3D12RootSignature> D3D12PipelineCache::GetOrCreateRootSignature(ID3D12Device* device, ID3DBlob* serializedSignature, std::uint64_t& hash, UINT nodeMask)
+{
+    /* Find root signature by its serialized data */
+    hash = HashInitValue();
+    HashBytes(hash, serializedSignature->GetBufferPointer(), serializedSignature->GetBufferSize());
+
+    auto it = rootSignatures_.find(hash);
+    if (it != rootSignatures_.end())
+        return it->second;
+
+    /* Create new root signature */
+    ComPtr<ID3D12RootSignature> rootSignature;
+
+    auto hr = device->CreateRootSignature(
+        nodeMask,
+        serializedSignature->GetBufferPointer(),
+        serializedSignature->GetBufferSize(),
+        IID_PPV_ARGS(rootSignature.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 root signature");
+
+    rootSignatures_[hash] = rootSignature;
+
+    return rootSignature;
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineCache::GetOrCreateGraphicsPipelineState(
+    ID3D12Device* device, const D3D12GraphicsPipelineStateDesc& desc, std::uint64_t rootSignatureHash)
+{
+    return GetOrCreatePipelineState(device, desc, HashGraphicsPipelineStateDesc(desc, rootSignatureHash));
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineCache::GetOrCreateComputePipelineState(
+    ID3D12Device* device, const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, std::uint64_t rootSignatureHash)
+{
+    return GetOrCreatePipelineState(device, desc, HashComputePipelineStateDesc(desc, rootSignatureHash));
+}
+
+ComPtr<ID3D12PipelineState> D3D12PipelineCache::GetOrCreateMeshPipelineState(
+    ID3D12Device* device, const D3D12MeshPipelineStateDesc& desc, std::uint64_t rootSignatureHash)
+{
+    return GetOrCreatePipelineState(device, desc, HashMeshPipelineStateDesc(desc, rootSignatureHash));
+}
+
+bool D3D12PipelineCache::Load(const std::vector<char>& data)
+{
+    std::size_t offset = 0;
+
+    /* Read and validate header */
+    PipelineCacheHeader header;
+    if (!ReadValue(data, offset, header) || header.magic != g_cacheMagic || header.version != g_cacheVersion)
+        return false;
+
+    /* Read all entries into a temporary container first, so invalid data leaves the cache untouched */
+    std::map<std::uint64_t, std::vector<char>> blobs;
+
+    for (std::uint32_t i = 0; i < header.numEntries; ++i)
+    {
+        PipelineCacheEntryHeader entry;
+        if (!ReadValue(data, offset, entry) || entry.size > data.size() - offset)
+            return false;
+
+        auto blobData = &data[offset];
+        blobs[entry.hash] = std::vector<char>(blobData, blobData + static_cast<std::size_t>(entry.size));
+        offset += static_cast<std::size_t>(entry.size);
+    }
+
+    for (auto& blob : blobs)
+        cachedBlobs_[blob.first] = std::move(blob.second);
+
+    return true;
+}
+
+std::vector<char> D3D12PipelineCache::Save() const
+{
+    std::vector<char> data;
+
+    /* Write header */
+    PipelineCacheHeader header;
+    {
+        header.magic        = g_cacheMagic;
+        header.version      = g_cacheVersion;
+        header.numEntries   = static_cast<std::uint32_t>(cachedBlobs_.size());
+    }
+    WriteValue(data, header);
+
+    /* Write all cached blobs */
+    for (const auto& blob : cachedBlobs_)
+    {
+        PipelineCacheEntryHeader entry;
+        {
+            entry.hash = blob.first;
+            entry.size = blob.second.size();
+        }
+        WriteValue(data, entry);
+        data.insert(data.end(), blob.second.begin(), blob.second.end());
+    }
+
+    return data;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+template <typename TPipelineStateDesc>
+ComPtr<ID3D12PipelineState> D3D12PipelineCache::GetOrCreatePipelineState(ID3D12Device* device, const TPipelineStateDesc& desc, std::uint64_t hash)
+{
+    /* Find PSO for an identical descriptor */
+    auto it = pipelineStates_.find(hash);
+    if (it != pipelineStates_.end())
+        return it->second;
+
+    ComPtr<ID3D12PipelineState> pipelineState;
+    HRESULT hr = E_FAIL;
+
+    /* Try to create PSO from cached blob (may fail if the driver or adapter has changed) */
+    auto itBlob = cachedBlobs_.find(hash);
+    if (itBlob != cachedBlobs_.end())
+    {
+        auto cachedDesc = desc;
+        {
+            cachedDesc.CachedPSO.pCachedBlob            = itBlob->second.data();
+            cachedDesc.CachedPSO.CachedBlobSizeInBytes  = itBlob->second.size();
+        }
+        hr = CreatePipelineState(device, cachedDesc, pipelineState);
+
+        if (FAILED(hr))
+            cachedBlobs_.erase(itBlob);
+    }
+
+    /* Create PSO from scratch */
+    if (FAILED(hr))
+    {
+        hr = CreatePipelineState(device, desc, pipelineState);
+        DXThrowIfFailed(hr, "failed to create D3D12 pipeline state");
+
+        /* Store cached blob for serialization */
+        ComPtr<ID3DBlob> blob;
+        if (SUCCEEDED(pipelineState->GetCachedBlob(blob.ReleaseAndGetAddressOf())) && blob)
+        {
+            auto blobData = reinterpret_cast<const char*>(blob->GetBufferPointer());
+            cachedBlobs_[hash] = std::vector<char>(blobData, blobData + blob->GetBufferSize());
+        }
+    }
+
+    pipelineStates_[hash] = pipelineState;
+
+    return pipelineState;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,118 @@
+/*
+ * D3D12PipelineCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_PIPELINE_CACHE_H
+#define LLGL_D3D12_PIPELINE_CACHE_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Descriptor of a graphics PSO with the additional depth-bounds test state, which is not part of D3D12_GRAPHICS_PIPELINE_STATE_DESC.
+PSOs with enabled depth-bounds test can only be created as pipeline state stream.
+*/
+struct D3D12GraphicsPipelineStateDesc : D3D12_GRAPHICS_PIPELINE_STATE_DESC
+{
+    BOOL                            DepthBoundsTestEnable;
+};
+
+/*
+Descriptor of a mesh shader PSO with the same members as D3D12GraphicsPipelineStateDesc, but with amplification and mesh shaders
+instead of the vertex processing stages and without input layout. Mesh shader PSOs can only be created as pipeline state stream.
+*/
+struct D3D12MeshPipelineStateDesc
+{
+    ID3D12RootSignature*            pRootSignature;
+    D3D12_SHADER_BYTECODE           AS;
+    D3D12_SHADER_BYTECODE           MS;
+    D3D12_SHADER_BYTECODE           PS;
+    D3D12_BLEND_DESC                BlendState;
+    UINT                            SampleMask;
+    D3D12_RASTERIZER_DESC           RasterizerState;
+    D3D12_DEPTH_STENCIL_DESC        DepthStencilState;
+    D3D12_PRIMITIVE_TOPOLOGY_TYPE   PrimitiveTopologyType;
+    UINT                            NumRenderTargets;
+    DXGI_FORMAT                     RTVFormats[8];
+    DXGI_FORMAT                     DSVFormat;
+    DXGI_SAMPLE_DESC                SampleDesc;
+    UINT                            NodeMask;
+    D3D12_CACHED_PIPELINE_STATE     CachedPSO;
+    D3D12_PIPELINE_STATE_FLAGS      Flags;
+    BOOL                            DepthBoundsTestEnable;
+};
+
+/*
+Cache for root signatures and graphics and compute pipeline state objects (PSO).
+PSOs are keyed by a hash over their entire description (shader byte codes, input layout, and all render states),
+so identical pipeline descriptors share the same PSO. The cached blobs of all PSOs can be serialized
+and passed back into the D3D12 runtime with the next run of the application to skip the driver compilation.
+*/
+class D3D12PipelineCache
+{
+
+    public:
+
+        // Returns the root signature for the specified serialized root signature, and its hash. The root signature is created for all GPU nodes of the node mask.
+        ComPtr<ID3D12RootSignature> GetOrCreateRootSignature(ID3D12Device* device, ID3DBlob* serializedSignature, std::uint64_t& hash, UINT nodeMask = 0);
+
+        // Returns the graphics PSO for the specified descriptor. The root signature is identified by its hash rather than its pointer.
+        ComPtr<ID3D12PipelineState> GetOrCreateGraphicsPipelineState(
+            ID3D12Device*                               device,
+            const D3D12GraphicsPipelineStateDesc&       desc,
+            std::uint64_t                               rootSignatureHash
+        );
+
+        // Returns the compute PSO for the specified descriptor. The root signature is identified by its hash rather than its pointer.
+        ComPtr<ID3D12PipelineState> GetOrCreateComputePipelineState(
+            ID3D12Device*                               device,
+            const D3D12_COMPUTE_PIPELINE_STATE_DESC&    desc,
+            std::uint64_t                               rootSignatureHash
+        );
+
+        // Returns the mesh shader PSO for the specified descriptor. The root signature is identified by its hash rather than its pointer.
+        ComPtr<ID3D12PipelineState> GetOrCreateMeshPipelineState(
+            ID3D12Device*                               device,
+            const D3D12MeshPipelineStateDesc&           desc,
+            std::uint64_t                               rootSignatureHash
+        );
+
+        // Loads the cached PSO blobs from the specified serialized data. Returns false if the data is invalid.
+        bool Load(const std::vector<char>& data);
+
+        // Serializes the cached PSO blobs of all PSOs.
+        std::vector<char> Save() const;
+
+    private:
+
+        // Returns the PSO with the specified hash, or creates it (from the cached blob if there is one).
+        template <typename TPipelineStateDesc>
+        ComPtr<ID3D12PipelineState> GetOrCreatePipelineState(ID3D12Device* device, const TPipelineStateDesc& desc, std::uint64_t hash);
+
+        std::map<std::uint64_t, ComPtr<ID3D12RootSignature>>    rootSignatures_;
+        std::map<std::uint64_t, ComPtr<ID3D12PipelineState>>    pipelineStates_;
+        std::map<std::uint64_t, std::vector<char>>              cachedBlobs_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
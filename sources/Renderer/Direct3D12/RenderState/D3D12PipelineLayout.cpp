@@ -0,0 +1,150 @@
+/*
+ * D3D12PipelineLayout.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12PipelineLayout.h"
+#include "../D3D12RenderSystem.h"
+#include "../Shader/D3D12ShaderProgram.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Maximum number of constant buffers that are bound as root CBVs (each root CBV takes 2 DWORDs of the root signature).
+static const UINT g_maxNumRootCBVs = 4;
+
+// Returns the number of constant buffers that are bound with the descriptor table, i.e. excluding the push constants.
+static UINT GetNumDescriptorTableCBVs(D3D12ShaderProgram& shaderProgram, const PushConstantsDescriptor& pushConstants)
+{
+    if (pushConstants.size == 0)
+        return shaderProgram.GetNumCBV();
+
+    auto constantBuffers = shaderProgram.QueryConstantBuffers();
+    return static_cast<UINT>(
+        std::count_if(
+            constantBuffers.begin(), constantBuffers.end(),
+            [](const ConstantBufferViewDescriptor& cbv)
+            {
+                return (cbv.name != "PushConstants");
+            }
+        )
+    );
+}
+
+void D3D12PipelineLayout::Create(
+    D3D12RenderSystem&              renderSystem,
+    D3D12ShaderProgram&             shaderProgram,
+    const PushConstantsDescriptor&  pushConstants,
+    D3D12_ROOT_SIGNATURE_FLAGS      signatureFlags)
+{
+    /* Setup descritpor structures for root signature */
+    std::vector<CD3DX12_DESCRIPTOR_RANGE> signatureRange;
+
+    auto AddSignatureRange = [&](D3D12_DESCRIPTOR_RANGE_TYPE type, UINT count)
+    {
+        if (count > 0)
+        {
+            CD3DX12_DESCRIPTOR_RANGE rangeDesc;
+            rangeDesc.Init(type, count, 0);
+            signatureRange.push_back(rangeDesc);
+        }
+    };
+
+    /* Store descriptor table layout: all SRVs first, then all CBVs, then all UAVs */
+    numSRV_ = shaderProgram.GetNumSRV();
+    numCBV_ = GetNumDescriptorTableCBVs(shaderProgram, pushConstants);
+    numUAV_ = shaderProgram.GetNumUAV();
+
+    numPushConstants_ = pushConstants.size / 4;
+
+    /*
+    Constant buffers typically change between draw commands, so bind them as root CBVs if they fit into the root signature;
+    this avoids rebuilding the descriptor table when only constant buffers change (root constants, root CBVs, and one table)
+    */
+    const UINT numRootDWords = numPushConstants_ + numCBV_ * 2 + 1;
+    if (numCBV_ <= g_maxNumRootCBVs && numRootDWords <= D3D12_MAX_ROOT_COST)
+    {
+        numRootCBV_ = numCBV_;
+        numCBV_     = 0;
+    }
+    else
+        numRootCBV_ = 0;
+
+    AddSignatureRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, numSRV_);
+    AddSignatureRange(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, numCBV_);
+    AddSignatureRange(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, numUAV_);
+
+    /* Order root parameters from the most to the least frequently changing: root constants, root CBVs, descriptor table */
+    std::vector<CD3DX12_ROOT_PARAMETER> signatureParams;
+
+    if (numPushConstants_ > 0)
+    {
+        pushConstantsParameter_ = static_cast<UINT>(signatureParams.size());
+
+        CD3DX12_ROOT_PARAMETER signatureParam;
+        signatureParam.InitAsConstants(numPushConstants_, pushConstants.slot, 0, D3D12_SHADER_VISIBILITY_ALL);
+        signatureParams.push_back(signatureParam);
+    }
+
+    rootCBVParameter_ = static_cast<UINT>(signatureParams.size());
+
+    for (UINT i = 0; i < numRootCBV_; ++i)
+    {
+        CD3DX12_ROOT_PARAMETER signatureParam;
+        signatureParam.InitAsConstantBufferView(i, 0, D3D12_SHADER_VISIBILITY_ALL);
+        signatureParams.push_back(signatureParam);
+    }
+
+    descTableParameter_ = static_cast<UINT>(signatureParams.size());
+
+    if (!signatureRange.empty())
+    {
+        CD3DX12_ROOT_PARAMETER signatureParam;
+        signatureParam.InitAsDescriptorTable(static_cast<UINT>(signatureRange.size()), signatureRange.data(), D3D12_SHADER_VISIBILITY_ALL);
+        signatureParams.push_back(signatureParam);
+    }
+
+    CD3DX12_ROOT_SIGNATURE_DESC signatureDesc;
+    signatureDesc.Init(static_cast<UINT>(signatureParams.size()), signatureParams.data(), 0, nullptr, signatureFlags);
+
+    /* Create serialized root signature */
+    HRESULT             hr          = 0;
+    ComPtr<ID3DBlob>    signature;
+    ComPtr<ID3DBlob>    error;
+
+    hr = D3D12SerializeRootSignature(
+        &signatureDesc,
+        D3D_ROOT_SIGNATURE_VERSION_1,
+        signature.ReleaseAndGetAddressOf(),
+        error.ReleaseAndGetAddressOf()
+    );
+
+    if (FAILED(hr) && error)
+    {
+        auto errorStr = DXGetBlobString(error.Get());
+        throw std::runtime_error("failed to serialize D3D12 root signature: " + errorStr);
+    }
+
+    DXThrowIfFailed(hr, "failed to serialize D3D12 root signature");
+
+    /* Get actual root signature from the pipeline cache (shared between pipelines with the same layout) */
+    rootSignature_ = renderSystem.GetPipelineCache().GetOrCreateRootSignature(
+        renderSystem.GetDevice(), signature.Get(), rootSignatureHash_, renderSystem.GetAllNodesMask()
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,127 @@
+/*
+ * D3D12PipelineLayout.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_PIPELINE_LAYOUT_H
+#define LLGL_D3D12_PIPELINE_LAYOUT_H
+
+
+#include <LLGL/GraphicsPipelineFlags.h>
+#include "../../DXCommon/ComPtr.h"
+#include <cstdint>
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+class D3D12ShaderProgram;
+
+/*
+Root signature of a graphics or compute pipeline, derived from the reflection of the shader program. Root parameters are ordered by their update frequency:
+the root constants for the push constants, then one root CBV per constant buffer (if they fit into the root signature), and finally a single descriptor table
+with all SRVs, then all CBVs (only if they are not bound as root CBVs), then all UAVs. Root signatures are shared between pipelines via the pipeline cache.
+*/
+class D3D12PipelineLayout
+{
+
+    public:
+
+        // Creates the root signature for the resources of the specified shader program.
+        void Create(
+            D3D12RenderSystem&              renderSystem,
+            D3D12ShaderProgram&             shaderProgram,
+            const PushConstantsDescriptor&  pushConstants,
+            D3D12_ROOT_SIGNATURE_FLAGS      signatureFlags
+        );
+
+        inline ID3D12RootSignature* GetRootSignature() const
+        {
+            return rootSignature_.Get();
+        }
+
+        // Returns the hash of the serialized root signature, which identifies the root signature in the pipeline cache.
+        inline std::uint64_t GetRootSignatureHash() const
+        {
+            return rootSignatureHash_;
+        }
+
+        // Returns the number of shader-resource-views (SRV) in the descriptor table of the root signature.
+        inline UINT GetNumSRV() const
+        {
+            return numSRV_;
+        }
+
+        // Returns the number of constant-buffer-views (CBV) in the descriptor table of the root signature.
+        inline UINT GetNumCBV() const
+        {
+            return numCBV_;
+        }
+
+        // Returns the number of constant buffers that are bound as root CBVs, i.e. without descriptor table.
+        inline UINT GetNumRootCBV() const
+        {
+            return numRootCBV_;
+        }
+
+        // Returns the index of the root parameter for the first root CBV; the root CBVs for all following slots are consecutive.
+        inline UINT GetRootCBVParameter() const
+        {
+            return rootCBVParameter_;
+        }
+
+        // Returns the number of unordered-access-views (UAV) in the descriptor table of the root signature.
+        inline UINT GetNumUAV() const
+        {
+            return numUAV_;
+        }
+
+        // Returns the index of the root parameter for the descriptor table.
+        inline UINT GetDescriptorTableParameter() const
+        {
+            return descTableParameter_;
+        }
+
+        // Returns the index of the root parameter for the push constants.
+        inline UINT GetPushConstantsParameter() const
+        {
+            return pushConstantsParameter_;
+        }
+
+        // Returns the number of 32-bit root constants for the push constants, or 0 if there are no push constants.
+        inline UINT GetNumPushConstants() const
+        {
+            return numPushConstants_;
+        }
+
+    private:
+
+        ComPtr<ID3D12RootSignature> rootSignature_;
+        std::uint64_t               rootSignatureHash_      = 0;
+
+        UINT                        numSRV_                 = 0;
+        UINT                        numCBV_                 = 0;
+        UINT                        numUAV_                 = 0;
+        UINT                        numRootCBV_             = 0;
+
+        UINT                        rootCBVParameter_       = 0;
+        UINT                        descTableParameter_     = 0;
+        UINT                        pushConstantsParameter_ = 0;
+        UINT                        numPushConstants_       = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,62 @@
+/*
+ * D3D12Query.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12Query.h"
+#include "../D3D12Types.h"
+#include "../../../Core/Exception.h"
+
+
+namespace LLGL
+{
+
+
+static D3D12_QUERY_HEAP_TYPE GetQueryHeapType(D3D12_QUERY_TYPE type)
+{
+    switch (type)
+    {
+        case D3D12_QUERY_TYPE_TIMESTAMP:                return D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        case D3D12_QUERY_TYPE_PIPELINE_STATISTICS:      return D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+        case D3D12_QUERY_TYPE_SO_STATISTICS_STREAM0:    return D3D12_QUERY_HEAP_TYPE_SO_STATISTICS;
+        default:                                        return D3D12_QUERY_HEAP_TYPE_OCCLUSION;
+    }
+}
+
+D3D12Query::D3D12Query(D3D12QueryHeapPool& queryHeapPool, const QueryDescriptor& desc) :
+    Query           { desc.type                  },
+    queryHeapPool_  { queryHeapPool              },
+    nativeType_     { D3D12Types::Map(desc.type) }
+{
+    if (desc.renderCondition)
+        ThrowNotSupported("render conditions with Direct3D 12");
+
+    /* Allocate native queries; TimeElapsed requires a timestamp for the begin and end of the time range */
+    auto numQueries = (desc.type == QueryType::TimeElapsed ? 2u : 1u);
+    slot_ = queryHeapPool_.Allocate(GetQueryHeapType(nativeType_), numQueries);
+}
+
+D3D12Query::~D3D12Query()
+{
+    queryHeapPool_.Free(slot_);
+}
+
+void D3D12Query::SetPending()
+{
+    fenceValue_ = 0;
+}
+
+void D3D12Query::SetSubmitted(UINT64 fenceValue, UINT64 timestampFrequency)
+{
+    fenceValue_         = fenceValue;
+    timestampFrequency_ = timestampFrequency;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,84 @@
+/*
+ * D3D12Query.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_QUERY_H
+#define LLGL_D3D12_QUERY_H
+
+
+#include <LLGL/Query.h>
+#include "D3D12QueryHeapPool.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+class D3D12Query : public Query
+{
+
+    public:
+
+        D3D12Query(D3D12QueryHeapPool& queryHeapPool, const QueryDescriptor& desc);
+        ~D3D12Query();
+
+        // Marks the result of this query as pending, i.e. the query has been ended in a command list that has not been submitted yet.
+        void SetPending();
+
+        // Stores the fence value the resolved result of this query is available with, and the timestamp frequency of the command queue.
+        void SetSubmitted(UINT64 fenceValue, UINT64 timestampFrequency);
+
+        // Returns the native query type. For the special query type TimeElapsed, this is the type of both timestamp queries.
+        inline D3D12_QUERY_TYPE GetNativeType() const
+        {
+            return nativeType_;
+        }
+
+        // Returns the query heap and index of the first query (the begin timestamp for TimeElapsed).
+        inline const D3D12QuerySlot& GetSlot() const
+        {
+            return slot_;
+        }
+
+        // Returns the fence value the result is available with, or 0 if the result is still pending.
+        inline UINT64 GetFenceValue() const
+        {
+            return fenceValue_;
+        }
+
+        // Returns the timestamp frequency of the command queue the query has been submitted to.
+        inline UINT64 GetTimestampFrequency() const
+        {
+            return timestampFrequency_;
+        }
+
+        // Returns the resolved result of the specified native query in the readback buffer.
+        inline const void* GetResultData(UINT index = 0) const
+        {
+            return (slot_.block->cpuAddress + (slot_.index + index) * slot_.block->resultSize);
+        }
+
+    private:
+
+        D3D12QueryHeapPool& queryHeapPool_;
+        D3D12_QUERY_TYPE    nativeType_         = D3D12_QUERY_TYPE_OCCLUSION;
+        D3D12QuerySlot      slot_;
+
+        UINT64              fenceValue_         = 0;
+        UINT64              timestampFrequency_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,146 @@
+/*
+ * D3D12QueryHeapPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12QueryHeapPool.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static UINT GetQueryResultSize(D3D12_QUERY_HEAP_TYPE type)
+{
+    switch (type)
+    {
+        case D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS: return sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
+        case D3D12_QUERY_HEAP_TYPE_SO_STATISTICS:       return sizeof(D3D12_QUERY_DATA_SO_STATISTICS);
+        default:                                        return sizeof(UINT64);
+    }
+}
+
+D3D12QueryHeapPool::D3D12QueryHeapPool(ID3D12Device* device, UINT queriesPerHeap) :
+    device_         { device         },
+    queriesPerHeap_ { queriesPerHeap }
+{
+}
+
+D3D12QuerySlot D3D12QueryHeapPool::Allocate(D3D12_QUERY_HEAP_TYPE type, UINT count)
+{
+    if (static_cast<UINT>(type) >= numHeapTypes)
+        throw std::invalid_argument("cannot allocate D3D12 queries of unsupported query heap type");
+    if (count == 0 || count > queriesPerHeap_)
+        throw std::invalid_argument("cannot allocate more D3D12 queries at once than a query heap can hold");
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& blocks = blocks_[type];
+
+    auto FindFreeRange = [this, count](const D3D12QueryHeapBlock& block, UINT& index) -> bool
+    {
+        /* Find first range of consecutive free queries */
+        for (UINT begin = 0, end = 0; end < queriesPerHeap_; ++end)
+        {
+            if (block.allocated[end])
+                begin = end + 1;
+            else if (end + 1 - begin == count)
+            {
+                index = begin;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    /* Find block with enough consecutive free queries or create a new one */
+    D3D12QuerySlot slot = { nullptr, 0, count };
+
+    for (const auto& block : blocks)
+    {
+        if (FindFreeRange(*block, slot.index))
+        {
+            slot.block = block.get();
+            break;
+        }
+    }
+
+    if (!slot.block)
+    {
+        blocks.push_back(CreateBlock(type));
+        slot.block = blocks.back().get();
+    }
+
+    std::fill_n(slot.block->allocated.begin() + slot.index, count, true);
+
+    return slot;
+}
+
+void D3D12QueryHeapPool::Free(const D3D12QuerySlot& slot)
+{
+    if (slot.block)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fill_n(slot.block->allocated.begin() + slot.index, slot.count, false);
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::unique_ptr<D3D12QueryHeapBlock> D3D12QueryHeapPool::CreateBlock(D3D12_QUERY_HEAP_TYPE type)
+{
+    auto block = MakeUnique<D3D12QueryHeapBlock>();
+
+    block->resultSize = GetQueryResultSize(type);
+    block->allocated.resize(queriesPerHeap_, false);
+
+    /* Create query heap */
+    D3D12_QUERY_HEAP_DESC queryHeapDesc;
+    {
+        queryHeapDesc.Type      = type;
+        queryHeapDesc.Count     = queriesPerHeap_;
+        queryHeapDesc.NodeMask  = 0;
+    }
+    auto hr = device_->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(block->queryHeap.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 query heap");
+
+    /* Create readback buffer (resources in the readback heap must stay in the copy-destination state) */
+    CD3DX12_HEAP_PROPERTIES readbackHeapProperties(D3D12_HEAP_TYPE_READBACK);
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(static_cast<UINT64>(block->resultSize) * queriesPerHeap_);
+
+    hr = device_->CreateCommittedResource(
+        &readbackHeapProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr,
+        IID_PPV_ARGS(block->readbackBuffer.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 committed resource for query results");
+
+    /* Map readback buffer persistently; results are only read after the GPU has crossed the fence value of the resolve command */
+    void* cpuAddress = nullptr;
+    hr = block->readbackBuffer->Map(0, nullptr, &cpuAddress);
+    DXThrowIfFailed(hr, "failed to map D3D12 readback buffer for query results");
+
+    block->cpuAddress = reinterpret_cast<const char*>(cpuAddress);
+
+    return block;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
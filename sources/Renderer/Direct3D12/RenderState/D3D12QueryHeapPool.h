@@ -0,0 +1,83 @@
+/*
+ * D3D12QueryHeapPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_QUERY_HEAP_POOL_H
+#define LLGL_D3D12_QUERY_HEAP_POOL_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Query heap with a persistently mapped readback buffer the query results are resolved into.
+struct D3D12QueryHeapBlock
+{
+    ComPtr<ID3D12QueryHeap> queryHeap;
+    ComPtr<ID3D12Resource>  readbackBuffer; // one result per query at offset "index * resultSize"
+    const char*             cpuAddress;     // mapped CPU address of the readback buffer
+    UINT                    resultSize;     // size (in bytes) of a single query result
+    std::vector<bool>       allocated;
+};
+
+// Consecutive queries within a query heap block.
+struct D3D12QuerySlot
+{
+    D3D12QueryHeapBlock*    block;
+    UINT                    index;
+    UINT                    count;
+};
+
+/*
+Suballocates queries from a small number of large query heaps, since each query heap is a separate native object.
+There is one list of query heap blocks for each query heap type. All functions are thread safe.
+*/
+class D3D12QueryHeapPool
+{
+
+    public:
+
+        D3D12QueryHeapPool(ID3D12Device* device, UINT queriesPerHeap);
+
+        D3D12QueryHeapPool(const D3D12QueryHeapPool&) = delete;
+        D3D12QueryHeapPool& operator = (const D3D12QueryHeapPool&) = delete;
+
+        // Allocates the specified number of consecutive queries of the specified query heap type.
+        D3D12QuerySlot Allocate(D3D12_QUERY_HEAP_TYPE type, UINT count);
+
+        // Returns the queries to the pool. Query heaps are never released before the pool, so pending commands that still reference the queries remain valid.
+        void Free(const D3D12QuerySlot& slot);
+
+    private:
+
+        static const UINT numHeapTypes = 4;
+
+        std::unique_ptr<D3D12QueryHeapBlock> CreateBlock(D3D12_QUERY_HEAP_TYPE type);
+
+        ID3D12Device*                                       device_         = nullptr;
+        UINT                                                queriesPerHeap_ = 0;
+
+        std::vector<std::unique_ptr<D3D12QueryHeapBlock>>   blocks_[numHeapTypes];
+        std::mutex                                          mutex_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,51 @@
+/*
+ * D3D12ResourceHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12ResourceHeap.h"
+#include "../Buffer/D3D12ConstantBuffer.h"
+#include "../Texture/D3D12Texture.h"
+#include "../../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+D3D12ResourceHeap::D3D12ResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    /* Resolve the CPU descriptor handles of all resources once, so binding the heap only copies the handles */
+    for (const auto& resourceView : desc.resourceViews)
+    {
+        switch (resourceView.type)
+        {
+            case ResourceType::ConstantBuffer:
+            {
+                auto constantBufferD3D = LLGL_CAST(D3D12ConstantBuffer*, resourceView.buffer);
+                cbvBindings_.push_back({ resourceView.slot, constantBufferD3D->GetCPUDescriptorHandle(), constantBufferD3D });
+            }
+            break;
+
+            case ResourceType::Texture:
+            {
+                auto textureD3D = LLGL_CAST(D3D12Texture*, resourceView.texture);
+                srvBindings_.push_back({ resourceView.slot, textureD3D->GetCPUDescriptorHandle(), nullptr });
+            }
+            break;
+
+            default:
+                //todo: storage buffers and samplers are not supported by the D3D12 command buffer yet
+                break;
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,65 @@
+/*
+ * D3D12ResourceHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_RESOURCE_HEAP_H
+#define LLGL_D3D12_RESOURCE_HEAP_H
+
+
+#include <LLGL/ResourceHeap.h>
+#include <d3d12.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class D3D12ConstantBuffer;
+
+// CPU descriptor handle of a resource and the slot in the descriptor table of the root signature.
+struct D3D12ResourceBinding
+{
+    UINT                        slot;
+    D3D12_CPU_DESCRIPTOR_HANDLE descHandle;
+    const D3D12ConstantBuffer*  constantBuffer; // only for constant buffers, whose GPU virtual address changes with every version
+};
+
+class D3D12ResourceHeap : public ResourceHeap
+{
+
+    public:
+
+        D3D12ResourceHeap(const ResourceHeapDescriptor& desc);
+
+        // Returns the SRV descriptor handles of all textures.
+        inline const std::vector<D3D12ResourceBinding>& GetSRVBindings() const
+        {
+            return srvBindings_;
+        }
+
+        // Returns the CBV descriptor handles of all constant buffers.
+        inline const std::vector<D3D12ResourceBinding>& GetCBVBindings() const
+        {
+            return cbvBindings_;
+        }
+
+    private:
+
+        std::vector<D3D12ResourceBinding> srvBindings_;
+        std::vector<D3D12ResourceBinding> cbvBindings_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
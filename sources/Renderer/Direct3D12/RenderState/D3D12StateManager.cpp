@@ -6,37 +6,36 @@
  */
 
 #include "D3D12StateManager.h"
+#include "../../../Core/Helper.h"
 #include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
 {
 
 
+D3D12StateManager::D3D12StateManager()
+{
+    InitMemory(vertexBufferViews_);
+    InitMemory(indexBufferView_);
+    InitMemory(rootConstants_);
+}
+
 void D3D12StateManager::SetViewports(unsigned int numViewports, const Viewport* viewportArray)
 {
-    viewports_.resize(numViewports);
-    
-    /* Check (at compile time) if D3D12_VIEWPORT and Viewport structures can be safely reinterpret-casted */
-    if ( sizeof(D3D12_VIEWPORT)             == sizeof(Viewport)             &&
-         offsetof(D3D12_VIEWPORT, TopLeftX) == offsetof(Viewport, x       ) &&
-         offsetof(D3D12_VIEWPORT, TopLeftY) == offsetof(Viewport, y       ) &&
-         offsetof(D3D12_VIEWPORT, Width   ) == offsetof(Viewport, width   ) &&
-         offsetof(D3D12_VIEWPORT, Height  ) == offsetof(Viewport, height  ) &&
-         offsetof(D3D12_VIEWPORT, MinDepth) == offsetof(Viewport, minDepth) &&
-         offsetof(D3D12_VIEWPORT, MaxDepth) == offsetof(Viewport, maxDepth) )
-    {
-        /* Now it's safe to reinterpret cast the viewports into D3D viewports */
-        auto viewportsD3D = reinterpret_cast<const D3D12_VIEWPORT*>(viewportArray);
-        std::copy(viewportsD3D, viewportsD3D + numViewports, viewports_.data());
+    if (viewports_.size() != numViewports)
+    {
+        viewports_.resize(numViewports);
+        dirtyBits_ |= DirtyViewports;
     }
-    else
+
+    for (unsigned int i = 0; i < numViewports; ++i)
     {
-        for (unsigned int i = 0; i < numViewports; ++i)
-        {
-            const auto& src = viewportArray[i];
-            auto& dest = viewports_[i];
+        const auto& src = viewportArray[i];
 
+        D3D12_VIEWPORT dest;
+        {
             dest.TopLeftX   = src.x;
             dest.TopLeftY   = src.y;
             dest.Width      = src.width;
@@ -44,35 +43,251 @@ void D3D12StateManager::SetViewports(unsigned int numViewports, const Viewport*
             dest.MinDepth   = src.minDepth;
             dest.MaxDepth   = src.maxDepth;
         }
-    }
-}
 
-void D3D12StateManager::SubmitViewports(ID3D12GraphicsCommandList* commandList)
-{
-    if (!viewports_.empty())
-        commandList->RSSetViewports(static_cast<UINT>(viewports_.size()), viewports_.data());
+        /* Only mark viewports as dirty if they have changed */
+        if (std::memcmp(&viewports_[i], &dest, sizeof(dest)) != 0)
+        {
+            viewports_[i] = dest;
+            dirtyBits_ |= DirtyViewports;
+        }
+    }
 }
 
 void D3D12StateManager::SetScissors(unsigned int numScissors, const Scissor* scissorArray)
 {
-    scissors_.resize(numScissors);
-    
+    if (scissors_.size() != numScissors)
+    {
+        scissors_.resize(numScissors);
+        dirtyBits_ |= DirtyScissors;
+    }
+
     for (unsigned int i = 0; i < numScissors; ++i)
     {
         const auto& src = scissorArray[i];
-        auto& dest = scissors_[i];
 
-        dest.left   = src.x;
-        dest.top    = src.y;
-        dest.right  = src.x + src.width;
-        dest.bottom = src.y + src.height;
+        D3D12_RECT dest;
+        {
+            dest.left   = src.x;
+            dest.top    = src.y;
+            dest.right  = src.x + src.width;
+            dest.bottom = src.y + src.height;
+        }
+
+        /* Only mark scissors as dirty if they have changed */
+        if (std::memcmp(&scissors_[i], &dest, sizeof(dest)) != 0)
+        {
+            scissors_[i] = dest;
+            dirtyBits_ |= DirtyScissors;
+        }
+    }
+}
+
+void D3D12StateManager::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature)
+{
+    if (rootSignature_ != rootSignature)
+    {
+        rootSignature_ = rootSignature;
+        dirtyBits_ |= DirtyRootSignature;
+
+        /* Root constants are undefined after the root signature has changed */
+        ClearRootConstantsDirtyRange();
+    }
+}
+
+void D3D12StateManager::SetComputeRootSignature(ID3D12RootSignature* rootSignature)
+{
+    if (computeRootSignature_ != rootSignature)
+    {
+        computeRootSignature_ = rootSignature;
+        dirtyBits_ |= DirtyComputeRootSig;
+    }
+}
+
+void D3D12StateManager::SetPipelineState(ID3D12PipelineState* pipelineState)
+{
+    if (pipelineState_ != pipelineState)
+    {
+        pipelineState_ = pipelineState;
+        dirtyBits_ |= DirtyPipelineState;
+    }
+}
+
+void D3D12StateManager::SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+    if (primitiveTopology_ != primitiveTopology)
+    {
+        primitiveTopology_ = primitiveTopology;
+        dirtyBits_ |= DirtyPrimitiveTopology;
+    }
+}
+
+void D3D12StateManager::SetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views)
+{
+    for (UINT i = 0; i < numViews && startSlot + i < vertexBufferViews_.size(); ++i)
+    {
+        auto slot = startSlot + i;
+        if (std::memcmp(&vertexBufferViews_[slot], &views[i], sizeof(D3D12_VERTEX_BUFFER_VIEW)) != 0)
+        {
+            /* Store view and extend the dirty range */
+            vertexBufferViews_[slot]    = views[i];
+            vertexBuffersDirtyBegin_    = std::min(vertexBuffersDirtyBegin_, slot);
+            vertexBuffersDirtyEnd_      = std::max(vertexBuffersDirtyEnd_, slot + 1);
+            dirtyBits_ |= DirtyVertexBuffers;
+        }
+    }
+}
+
+void D3D12StateManager::SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view)
+{
+    if (std::memcmp(&indexBufferView_, &view, sizeof(view)) != 0)
+    {
+        indexBufferView_ = view;
+        dirtyBits_ |= DirtyIndexBuffer;
     }
 }
 
-void D3D12StateManager::SubmitScissors(ID3D12GraphicsCommandList* commandList)
+void D3D12StateManager::SetGraphicsRoot32BitConstants(UINT rootParameterIndex, UINT num32BitValues, const void* data, UINT destOffset)
 {
-    if (!scissors_.empty())
+    if (destOffset >= maxNumRootConstants)
+        return;
+
+    num32BitValues = std::min(num32BitValues, maxNumRootConstants - destOffset);
+
+    if (rootConstantsParameter_ != rootParameterIndex)
+    {
+        rootConstantsParameter_ = rootParameterIndex;
+        ClearRootConstantsDirtyRange();
+    }
+
+    /* Store constants and extend the dirty range; root constants are not compared, because they typically change with every draw command */
+    ::memcpy(&rootConstants_[destOffset], data, num32BitValues * sizeof(UINT));
+    rootConstantsDirtyBegin_    = std::min(rootConstantsDirtyBegin_, destOffset);
+    rootConstantsDirtyEnd_      = std::max(rootConstantsDirtyEnd_, destOffset + num32BitValues);
+    dirtyBits_ |= DirtyRootConstants;
+}
+
+bool D3D12StateManager::FlushGraphicsState(ID3D12GraphicsCommandList* commandList)
+{
+    if (dirtyBits_ == 0)
+        return false;
+
+    bool rootSignatureChanged = false;
+
+    if ((dirtyBits_ & DirtyRootSignature) != 0 && rootSignature_ != nullptr)
+    {
+        commandList->SetGraphicsRootSignature(rootSignature_);
+        rootSignatureChanged = true;
+    }
+
+    if ((dirtyBits_ & DirtyRootConstants) != 0 && rootConstantsDirtyBegin_ < rootConstantsDirtyEnd_)
+    {
+        /* Submit only the range of root constants that has been written */
+        commandList->SetGraphicsRoot32BitConstants(
+            rootConstantsParameter_,
+            rootConstantsDirtyEnd_ - rootConstantsDirtyBegin_,
+            &rootConstants_[rootConstantsDirtyBegin_],
+            rootConstantsDirtyBegin_
+        );
+        ClearRootConstantsDirtyRange();
+    }
+
+    if ((dirtyBits_ & DirtyPipelineState) != 0 && pipelineState_ != nullptr)
+        commandList->SetPipelineState(pipelineState_);
+
+    if ((dirtyBits_ & DirtyPrimitiveTopology) != 0)
+        commandList->IASetPrimitiveTopology(primitiveTopology_);
+
+    if ((dirtyBits_ & DirtyViewports) != 0 && !viewports_.empty())
+        commandList->RSSetViewports(static_cast<UINT>(viewports_.size()), viewports_.data());
+
+    if ((dirtyBits_ & DirtyScissors) != 0 && !scissors_.empty())
         commandList->RSSetScissorRects(static_cast<UINT>(scissors_.size()), scissors_.data());
+
+    if ((dirtyBits_ & DirtyVertexBuffers) != 0)
+    {
+        /* Submit only the range of vertex buffer views that has changed */
+        commandList->IASetVertexBuffers(
+            vertexBuffersDirtyBegin_,
+            vertexBuffersDirtyEnd_ - vertexBuffersDirtyBegin_,
+            &vertexBufferViews_[vertexBuffersDirtyBegin_]
+        );
+        vertexBuffersDirtyBegin_    = D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT;
+        vertexBuffersDirtyEnd_      = 0;
+    }
+
+    if ((dirtyBits_ & DirtyIndexBuffer) != 0)
+        commandList->IASetIndexBuffer(&indexBufferView_);
+
+    /* Keep compute root signature dirty for the next dispatch command */
+    dirtyBits_ &= DirtyComputeRootSig;
+
+    return rootSignatureChanged;
+}
+
+bool D3D12StateManager::FlushComputeState(ID3D12GraphicsCommandList* commandList)
+{
+    bool rootSignatureChanged = false;
+
+    /* Compute and graphics root signatures are independent command list states */
+    if ((dirtyBits_ & DirtyComputeRootSig) != 0 && computeRootSignature_ != nullptr)
+    {
+        commandList->SetComputeRootSignature(computeRootSignature_);
+        dirtyBits_ &= ~DirtyComputeRootSig;
+        rootSignatureChanged = true;
+    }
+
+    /* Only the pipeline state is shared with compute commands; all other states remain dirty for the next draw command */
+    if ((dirtyBits_ & DirtyPipelineState) != 0 && pipelineState_ != nullptr)
+    {
+        commandList->SetPipelineState(pipelineState_);
+        dirtyBits_ &= ~DirtyPipelineState;
+    }
+
+    return rootSignatureChanged;
+}
+
+void D3D12StateManager::Reset(bool keepPersistentStates)
+{
+    /* Command list starts with default states, so only keep what must be submitted again */
+    rootSignature_          = nullptr;
+    computeRootSignature_   = nullptr;
+    pipelineState_          = nullptr;
+    primitiveTopology_      = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+    InitMemory(vertexBufferViews_);
+    InitMemory(indexBufferView_);
+    vertexBuffersDirtyBegin_    = D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT;
+    vertexBuffersDirtyEnd_      = 0;
+
+    ClearRootConstantsDirtyRange();
+
+    dirtyBits_ = 0;
+
+    if (keepPersistentStates)
+    {
+        /* Re-submit persistent states (viewports and scissors) with the next flush */
+        if (!viewports_.empty())
+            dirtyBits_ |= DirtyViewports;
+        if (!scissors_.empty())
+            dirtyBits_ |= DirtyScissors;
+    }
+    else
+    {
+        /* Persistent states must be set again by the client */
+        viewports_.clear();
+        scissors_.clear();
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12StateManager::ClearRootConstantsDirtyRange()
+{
+    rootConstantsDirtyBegin_    = maxNumRootConstants;
+    rootConstantsDirtyEnd_      = 0;
 }
 
 
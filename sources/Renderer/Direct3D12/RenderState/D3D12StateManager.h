@@ -11,6 +11,7 @@
 
 #include "../../DXCommon/ComPtr.h"
 #include <LLGL/RenderContextFlags.h>
+#include <array>
 #include <vector>
 #include <d3d12.h>
 
@@ -19,21 +20,91 @@ namespace LLGL
 {
 
 
+/*
+D3D12 command list state block: all states are only recorded here and marked as dirty if they have changed.
+The dirty states are submitted to the command list once with "FlushGraphicsState" or "FlushComputeState" before the next draw or dispatch command.
+*/
 class D3D12StateManager
 {
 
     public:
 
-        void SetViewports(unsigned int numViewports, const Viewport* viewportArray);
-        void SubmitViewports(ID3D12GraphicsCommandList* commandList);
+        D3D12StateManager();
 
+        void SetViewports(unsigned int numViewports, const Viewport* viewportArray);
         void SetScissors(unsigned int numScissors, const Scissor* scissorArray);
-        void SubmitScissors(ID3D12GraphicsCommandList* commandList);
+
+        void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature);
+        void SetComputeRootSignature(ID3D12RootSignature* rootSignature);
+        void SetPipelineState(ID3D12PipelineState* pipelineState);
+        void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology);
+
+        void SetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views);
+        void SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& view);
+
+        /*
+        Stores the specified 32-bit values in the root constants of the graphics root signature.
+        The root constants are submitted with the next flush, after the root signature, and they are discarded when the root signature changes.
+        */
+        void SetGraphicsRoot32BitConstants(UINT rootParameterIndex, UINT num32BitValues, const void* data, UINT destOffset);
+
+        /*
+        Submits all dirty graphics states to the specified command list.
+        Returns true if the graphics root signature has been submitted, i.e. all root arguments must be submitted again.
+        */
+        bool FlushGraphicsState(ID3D12GraphicsCommandList* commandList);
+
+        /*
+        Submits all dirty compute states to the specified command list.
+        Returns true if the compute root signature has been submitted, i.e. all root arguments must be submitted again.
+        */
+        bool FlushComputeState(ID3D12GraphicsCommandList* commandList);
+
+        /*
+        Resets the state block after the command list has been reset, which resets all command list states to their default values.
+        If 'keepPersistentStates' is true, the viewports and scissors are kept and submitted again with the next flush.
+        */
+        void Reset(bool keepPersistentStates);
 
     private:
 
-        std::vector<D3D12_VIEWPORT> viewports_;
-        std::vector<D3D12_RECT>     scissors_;
+        enum DirtyBits
+        {
+            DirtyViewports          = (1 << 0),
+            DirtyScissors           = (1 << 1),
+            DirtyRootSignature      = (1 << 2),
+            DirtyPipelineState      = (1 << 3),
+            DirtyPrimitiveTopology  = (1 << 4),
+            DirtyVertexBuffers      = (1 << 5),
+            DirtyIndexBuffer        = (1 << 6),
+            DirtyRootConstants      = (1 << 7),
+            DirtyComputeRootSig     = (1 << 8),
+        };
+
+        // Maximum number of 32-bit values in a root signature (a root constant costs one 32-bit value).
+        static const UINT maxNumRootConstants = 64;
+
+        void ClearRootConstantsDirtyRange();
+
+        std::vector<D3D12_VIEWPORT>                                                         viewports_;
+        std::vector<D3D12_RECT>                                                             scissors_;
+
+        ID3D12RootSignature*                                                                rootSignature_         = nullptr;
+        ID3D12RootSignature*                                                                computeRootSignature_  = nullptr;
+        ID3D12PipelineState*                                                                pipelineState_         = nullptr;
+        D3D12_PRIMITIVE_TOPOLOGY                                                            primitiveTopology_     = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+        std::array<D3D12_VERTEX_BUFFER_VIEW, D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT>     vertexBufferViews_;
+        UINT                                                                                vertexBuffersDirtyBegin_    = D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT;
+        UINT                                                                                vertexBuffersDirtyEnd_      = 0;
+        D3D12_INDEX_BUFFER_VIEW                                                             indexBufferView_;
+
+        std::array<UINT, maxNumRootConstants>                                               rootConstants_;
+        UINT                                                                                rootConstantsParameter_     = 0;
+        UINT                                                                                rootConstantsDirtyBegin_    = maxNumRootConstants;
+        UINT                                                                                rootConstantsDirtyEnd_      = 0;
+
+        unsigned int                                                                        dirtyBits_          = 0;
 
 };
 
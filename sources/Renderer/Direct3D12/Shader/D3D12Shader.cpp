@@ -7,6 +7,7 @@
 
 #include "D3D12Shader.h"
 #include "../../DXCommon/DXCore.h"
+#include "../../DXCommon/DXShaderReflection.h"
 #include <algorithm>
 #include <stdexcept>
 #include <d3dcompiler.h>
@@ -16,8 +17,9 @@ namespace LLGL
 {
 
 
-D3D12Shader::D3D12Shader(const ShaderType type) :
-    Shader { type }
+D3D12Shader::D3D12Shader(const ShaderType type, ThreadPool* workerPool) :
+    Shader      { type       },
+    workerPool_ { workerPool }
 {
 }
 
@@ -59,6 +61,20 @@ bool D3D12Shader::Compile(const std::string& sourceCode, const ShaderDescriptor&
     return true;
 }
 
+std::shared_future<bool> D3D12Shader::CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
+{
+    if (!workerPool_)
+        return Shader::CompileAsync(sourceCode, shaderDesc);
+
+    /* Compile shader on worker thread (D3DCompile is thread-safe) */
+    return workerPool_->Submit(
+        [this, sourceCode, shaderDesc]()
+        {
+            return Compile(sourceCode, shaderDesc);
+        }
+    );
+}
+
 bool D3D12Shader::LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc)
 {
     if (!binaryCode.empty())
@@ -112,6 +128,14 @@ void D3D12Shader::ReflectShader()
     /* Get shader reflection */
     ComPtr<ID3D12ShaderReflection> reflection;
     hr = D3DReflect(byteCode_.data(), byteCode_.size(), IID_PPV_ARGS(&reflection));
+
+    /*
+    Mesh and amplification shaders require shader model 6.5, i.e. DXIL that can only be loaded as binary,
+    and D3DReflect cannot reflect DXIL, so these shaders only have the resources of the other attached shaders
+    */
+    if (FAILED(hr) && (GetType() == ShaderType::Mesh || GetType() == ShaderType::Amplification))
+        return;
+
     DXThrowIfFailed(hr, "failed to retrieve D3D12 shader reflection");
 
     D3D12_SHADER_DESC shaderDesc;
@@ -161,6 +185,20 @@ void D3D12Shader::ReflectShader()
                 constBufferDesc.index   = bufferIdx++;
                 constBufferDesc.size    = shaderBufferDesc.Size;
             }
+
+            /* Reflect field layout of all variables */
+            DXReflectConstantBufferFields<D3D12_SHADER_VARIABLE_DESC, D3D12_SHADER_TYPE_DESC>(
+                constBufferReflection, shaderBufferDesc.Variables, constBufferDesc.fields
+            );
+
+            std::sort(
+                constBufferDesc.fields.begin(), constBufferDesc.fields.end(),
+                [](const ConstantBufferFieldDescriptor& lhs, const ConstantBufferFieldDescriptor& rhs)
+                {
+                    return (lhs.offset < rhs.offset);
+                }
+            );
+
             constantBufferDescs_.push_back(constBufferDesc);
         }
     }
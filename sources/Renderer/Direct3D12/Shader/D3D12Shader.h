@@ -13,6 +13,7 @@
 #include <LLGL/VertexAttribute.h>
 #include <LLGL/BufferFlags.h>
 #include "../../DXCommon/ComPtr.h"
+#include "../../../Core/ThreadPool.h"
 #include <vector>
 #include <d3d12.h>
 
@@ -29,10 +30,12 @@ class D3D12Shader : public Shader
         D3D12Shader(const D3D12Shader&) = delete;
         D3D12Shader& operator = (const D3D12Shader&) = delete;
 
-        D3D12Shader(const ShaderType type);
+        D3D12Shader(const ShaderType type, ThreadPool* workerPool = nullptr);
 
         bool Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
 
+        std::shared_future<bool> CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
+
         bool LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc = {}) override;
 
         std::string Disassemble(int flags = 0) override;
@@ -62,6 +65,8 @@ class D3D12Shader : public Shader
 
         void ReflectShader();
 
+        ThreadPool*                                 workerPool_         = nullptr;
+
         std::vector<char>                           byteCode_;
         ComPtr<ID3DBlob>                            errors_;
 
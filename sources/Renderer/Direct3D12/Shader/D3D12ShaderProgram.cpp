@@ -66,6 +66,12 @@ void D3D12ShaderProgram::AttachShader(Shader& shader)
         case ShaderType::Compute:
             cs_ = shaderD3D;
             break;
+        case ShaderType::Amplification:
+            as_ = shaderD3D;
+            break;
+        case ShaderType::Mesh:
+            ms_ = shaderD3D;
+            break;
     }
 
     /* Add constant- and storage buffer descriptors */
@@ -84,6 +90,8 @@ void D3D12ShaderProgram::DetachAll()
     gs_ = nullptr;
     ps_ = nullptr;
     cs_ = nullptr;
+    as_ = nullptr;
+    ms_ = nullptr;
 
     vertexAttributes_.clear();
     constantBufferDescs_.clear();
@@ -102,6 +110,8 @@ bool D3D12ShaderProgram::LinkShaders()
         MaskHS = (1 << 3),
         MaskGS = (1 << 4),
         MaskCS = (1 << 5),
+        MaskAS = (1 << 6),
+        MaskMS = (1 << 7),
     };
 
     /* Validate shader composition */
@@ -125,6 +135,8 @@ bool D3D12ShaderProgram::LinkShaders()
     MarkShader(hs_, MaskHS);
     MarkShader(gs_, MaskGS);
     MarkShader(cs_, MaskCS);
+    MarkShader(as_, MaskAS);
+    MarkShader(ms_, MaskMS);
 
     switch (flags)
     {
@@ -133,6 +145,8 @@ bool D3D12ShaderProgram::LinkShaders()
         case (MaskVS | MaskPS | MaskDS | MaskHS):
         case (MaskVS | MaskPS | MaskDS | MaskHS | MaskGS):
         case (MaskCS):
+        case (MaskMS | MaskPS):
+        case (MaskAS | MaskMS | MaskPS):
             break;
         default:
             linkError_ = LinkError::Composition;
@@ -181,6 +195,16 @@ std::vector<UniformDescriptor> D3D12ShaderProgram::QueryUniforms() const
     return {}; // dummy
 }
 
+int D3D12ShaderProgram::QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name)
+{
+    return -1; // dummy (dynamic shader linkage is not supported with Direct3D 12)
+}
+
+int D3D12ShaderProgram::QueryShaderClassInstance(const ShaderType stage, const std::string& name)
+{
+    return -1; // dummy
+}
+
 static DXGI_FORMAT GetInputElementFormat(const VertexAttribute& attrib)
 {
     try
@@ -41,6 +41,9 @@ class D3D12ShaderProgram : public ShaderProgram
         std::vector<StorageBufferViewDescriptor> QueryStorageBuffers() const override;
         std::vector<UniformDescriptor> QueryUniforms() const override;
 
+        int QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name) override;
+        int QueryShaderClassInstance(const ShaderType stage, const std::string& name) override;
+
         void BuildInputLayout(const VertexFormat& vertexFormat) override;
         void BindConstantBuffer(const std::string& name, unsigned int bindingIndex) override;
         void BindStorageBuffer(const std::string& name, unsigned int bindingIndex) override;
@@ -58,6 +61,8 @@ class D3D12ShaderProgram : public ShaderProgram
         inline D3D12Shader* GetHS() const { return hs_; }
         inline D3D12Shader* GetGS() const { return gs_; }
         inline D3D12Shader* GetCS() const { return cs_; }
+        inline D3D12Shader* GetAS() const { return as_; }
+        inline D3D12Shader* GetMS() const { return ms_; }
 
         inline UINT GetNumSRV() const
         {
@@ -91,6 +96,8 @@ class D3D12ShaderProgram : public ShaderProgram
         D3D12Shader*                                hs_                     = nullptr;
         D3D12Shader*                                gs_                     = nullptr;
         D3D12Shader*                                cs_                     = nullptr;
+        D3D12Shader*                                as_                     = nullptr;
+        D3D12Shader*                                ms_                     = nullptr;
 
         std::vector<VertexAttribute>                vertexAttributes_;
         std::vector<ConstantBufferViewDescriptor>   constantBufferDescs_;
@@ -0,0 +1,381 @@
+/*
+ * D3D12MipGenerator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12MipGenerator.h"
+#include "D3D12Texture.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include <d3dcompiler.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Each thread samples the source level at the center of its 2x2 texel quad (a box filter with the bilinear sampler),
+and the thread group reduces its 8x8 results in group-shared memory for the subsequent levels.
+The levels are written to all array layers at once (SV_DispatchThreadID.z is the array layer).
+*/
+static const char* g_mipGeneratorShaderSource =
+    "cbuffer MipConstants : register(b0)\n"
+    "{\n"
+    "    uint   numMips;\n"
+    "    float2 texelSize;\n"
+    "};\n"
+    "Texture2DArray<float4>   srcMip  : register(t0);\n"
+    "RWTexture2DArray<float4> dstMip1 : register(u0);\n"
+    "RWTexture2DArray<float4> dstMip2 : register(u1);\n"
+    "RWTexture2DArray<float4> dstMip3 : register(u2);\n"
+    "RWTexture2DArray<float4> dstMip4 : register(u3);\n"
+    "SamplerState linearClamp : register(s0);\n"
+    "groupshared float4 tile[64];\n"
+    "[numthreads(8, 8, 1)]\n"
+    "void CS(uint groupIndex : SV_GroupIndex, uint3 threadID : SV_DispatchThreadID)\n"
+    "{\n"
+    "    float2 uv = texelSize * (threadID.xy + 0.5);\n"
+    "    float4 color = srcMip.SampleLevel(linearClamp, float3(uv, threadID.z), 0);\n"
+    "    dstMip1[threadID] = color;\n"
+    "    if (numMips == 1)\n"
+    "        return;\n"
+    "    tile[groupIndex] = color;\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    if ((groupIndex & 0x09) == 0)\n"
+    "    {\n"
+    "        color = 0.25 * (color + tile[groupIndex + 1] + tile[groupIndex + 8] + tile[groupIndex + 9]);\n"
+    "        dstMip2[uint3(threadID.xy / 2, threadID.z)] = color;\n"
+    "        tile[groupIndex] = color;\n"
+    "    }\n"
+    "    if (numMips == 2)\n"
+    "        return;\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    if ((groupIndex & 0x1B) == 0)\n"
+    "    {\n"
+    "        color = 0.25 * (color + tile[groupIndex + 2] + tile[groupIndex + 16] + tile[groupIndex + 18]);\n"
+    "        dstMip3[uint3(threadID.xy / 4, threadID.z)] = color;\n"
+    "        tile[groupIndex] = color;\n"
+    "    }\n"
+    "    if (numMips == 3)\n"
+    "        return;\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    if (groupIndex == 0)\n"
+    "    {\n"
+    "        color = 0.25 * (color + tile[groupIndex + 4] + tile[groupIndex + 32] + tile[groupIndex + 36]);\n"
+    "        dstMip4[uint3(threadID.xy / 8, threadID.z)] = color;\n"
+    "    }\n"
+    "}\n";
+
+// Layout of the root constants (register b0).
+struct D3D12MipConstants
+{
+    UINT    numMips;
+    float   texelSize[2];
+    UINT    padding;
+};
+
+// Only non-integral and non-sRGB color formats can be written through RWTexture2DArray<float4>.
+static bool IsMipGeneratorFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_R8_UNORM:
+        case DXGI_FORMAT_R8_SNORM:
+        case DXGI_FORMAT_R8G8_UNORM:
+        case DXGI_FORMAT_R8G8_SNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_SNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_R16_UNORM:
+        case DXGI_FORMAT_R16_SNORM:
+        case DXGI_FORMAT_R16_FLOAT:
+        case DXGI_FORMAT_R16G16_UNORM:
+        case DXGI_FORMAT_R16G16_SNORM:
+        case DXGI_FORMAT_R16G16_FLOAT:
+        case DXGI_FORMAT_R16G16B16A16_UNORM:
+        case DXGI_FORMAT_R16G16B16A16_SNORM:
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R32_FLOAT:
+        case DXGI_FORMAT_R32G32_FLOAT:
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+        case DXGI_FORMAT_R10G10B10A2_UNORM:
+        case DXGI_FORMAT_R11G11B10_FLOAT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool D3D12MipGenerator::IsFormatSupported(ID3D12Device* device, DXGI_FORMAT format)
+{
+    if (!IsMipGeneratorFormat(format))
+        return false;
+
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = { format, D3D12_FORMAT_SUPPORT1_NONE, D3D12_FORMAT_SUPPORT2_NONE };
+    if (FAILED(device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, sizeof(formatSupport))))
+        return false;
+
+    return
+    (
+        (formatSupport.Support1 & D3D12_FORMAT_SUPPORT1_TYPED_UNORDERED_ACCESS_VIEW) != 0 &&
+        (formatSupport.Support1 & D3D12_FORMAT_SUPPORT1_SHADER_SAMPLE              ) != 0 &&
+        (formatSupport.Support2 & D3D12_FORMAT_SUPPORT2_UAV_TYPED_STORE            ) != 0
+    );
+}
+
+// Returns the number of levels the next dispatch can generate, so that each level has exactly half the size of its previous level.
+static UINT GetNumDispatchMips(UINT numRemainingMips, UINT dstWidth, UINT dstHeight)
+{
+    UINT numMips = std::min(numRemainingMips, UINT(D3D12MipGenerator::maxMipsPerDispatch));
+    while (numMips > 1 && ((dstWidth | dstHeight) & ((1u << (numMips - 1)) - 1u)) != 0)
+        --numMips;
+    return numMips;
+}
+
+ComPtr<ID3D12DescriptorHeap> D3D12MipGenerator::GenerateMips(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, D3D12Texture& texture)
+{
+    /* Create pipeline with the first use */
+    if (!pipelineState_)
+    {
+        CreateRootSignature(device);
+        CreatePipelineState(device);
+    }
+
+    auto resource = texture.Get();
+    const auto resDesc = resource->GetDesc();
+
+    const UINT  numMips     = resDesc.MipLevels;
+    const UINT  numLayers   = resDesc.DepthOrArraySize;
+    const UINT  width       = static_cast<UINT>(resDesc.Width);
+    const UINT  height      = resDesc.Height;
+
+    if (numMips < 2)
+        return nullptr;
+
+    /* Create shader-visible descriptor heap with one SRV and all UAVs for each dispatch */
+    const UINT numDescriptorsPerDispatch = 1 + maxMipsPerDispatch;
+
+    ComPtr<ID3D12DescriptorHeap> descHeap;
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc;
+    {
+        heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        heapDesc.NumDescriptors = numDescriptorsPerDispatch * (numMips - 1);
+        heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        heapDesc.NodeMask       = 0;
+    }
+    auto hr = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(descHeap.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 descriptor heap for MIP-map generation");
+
+    const UINT descSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    CD3DX12_CPU_DESCRIPTOR_HANDLE cpuHandle { descHeap->GetCPUDescriptorHandleForHeapStart() };
+    CD3DX12_GPU_DESCRIPTOR_HANDLE gpuHandle { descHeap->GetGPUDescriptorHandleForHeapStart() };
+
+    ID3D12DescriptorHeap* descHeaps[] = { descHeap.Get() };
+    commandList->SetDescriptorHeaps(1, descHeaps);
+    commandList->SetComputeRootSignature(rootSignature_.Get());
+    commandList->SetPipelineState(pipelineState_.Get());
+
+    /* All levels are written as UAV, except the source level of the current dispatch */
+    std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+    auto TransitionMip = [&](UINT mipLevel, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter)
+    {
+        for (UINT layer = 0; layer < numLayers; ++layer)
+        {
+            barriers.push_back(
+                CD3DX12_RESOURCE_BARRIER::Transition(
+                    resource, stateBefore, stateAfter, D3D12CalcSubresource(mipLevel, layer, 0, numMips, numLayers)
+                )
+            );
+        }
+    };
+
+    auto FlushBarriers = [&]()
+    {
+        commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+        barriers.clear();
+    };
+
+    barriers.push_back(
+        CD3DX12_RESOURCE_BARRIER::Transition(resource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+    );
+    FlushBarriers();
+
+    for (UINT srcMip = 0; srcMip + 1 < numMips;)
+    {
+        const UINT dstWidth         = std::max(1u, width  >> (srcMip + 1));
+        const UINT dstHeight        = std::max(1u, height >> (srcMip + 1));
+        const UINT numDispatchMips  = GetNumDispatchMips(numMips - 1 - srcMip, dstWidth, dstHeight);
+
+        /* Create SRV for the source level */
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+        {
+            srvDesc.Format                                  = resDesc.Format;
+            srvDesc.ViewDimension                           = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+            srvDesc.Shader4ComponentMapping                 = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.Texture2DArray.MostDetailedMip          = srcMip;
+            srvDesc.Texture2DArray.MipLevels                = 1;
+            srvDesc.Texture2DArray.FirstArraySlice          = 0;
+            srvDesc.Texture2DArray.ArraySize                = numLayers;
+            srvDesc.Texture2DArray.PlaneSlice               = 0;
+            srvDesc.Texture2DArray.ResourceMinLODClamp      = 0.0f;
+        }
+        device->CreateShaderResourceView(resource, &srvDesc, cpuHandle);
+
+        /* Create UAVs for the destination levels, and null descriptors for the unused ones */
+        for (UINT i = 0; i < maxMipsPerDispatch; ++i)
+        {
+            D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc;
+            {
+                uavDesc.Format                          = resDesc.Format;
+                uavDesc.ViewDimension                   = D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
+                uavDesc.Texture2DArray.MipSlice         = (i < numDispatchMips ? srcMip + 1 + i : 0);
+                uavDesc.Texture2DArray.FirstArraySlice  = 0;
+                uavDesc.Texture2DArray.ArraySize        = numLayers;
+                uavDesc.Texture2DArray.PlaneSlice       = 0;
+            }
+            device->CreateUnorderedAccessView(
+                (i < numDispatchMips ? resource : nullptr), nullptr, &uavDesc, CD3DX12_CPU_DESCRIPTOR_HANDLE(cpuHandle, 1 + i, descSize)
+            );
+        }
+
+        /* Read the source level, which has been written by the previous dispatch */
+        TransitionMip(srcMip, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+        FlushBarriers();
+
+        D3D12MipConstants constants;
+        {
+            constants.numMips       = numDispatchMips;
+            constants.texelSize[0]  = 1.0f / static_cast<float>(dstWidth);
+            constants.texelSize[1]  = 1.0f / static_cast<float>(dstHeight);
+            constants.padding       = 0;
+        }
+        commandList->SetComputeRoot32BitConstants(0, sizeof(constants) / 4, &constants, 0);
+        commandList->SetComputeRootDescriptorTable(1, gpuHandle);
+        commandList->Dispatch((dstWidth + 7) / 8, (dstHeight + 7) / 8, numLayers);
+
+        /* The source level is done, so it can be transitioned into its final state */
+        TransitionMip(srcMip, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+        cpuHandle.Offset(numDescriptorsPerDispatch, descSize);
+        gpuHandle.Offset(numDescriptorsPerDispatch, descSize);
+        srcMip += numDispatchMips;
+    }
+
+    /* The last level has only been written by the last dispatch */
+    TransitionMip(numMips - 1, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    FlushBarriers();
+
+    return descHeap;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void D3D12MipGenerator::CreateRootSignature(ID3D12Device* device)
+{
+    /* Root constants (b0), and one descriptor table with the SRV (t0) and the UAVs (u0-u3) */
+    CD3DX12_DESCRIPTOR_RANGE ranges[2];
+    ranges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+    ranges[1].Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, maxMipsPerDispatch, 0);
+
+    CD3DX12_ROOT_PARAMETER params[2];
+    params[0].InitAsConstants(sizeof(D3D12MipConstants) / 4, 0);
+    params[1].InitAsDescriptorTable(2, ranges);
+
+    CD3DX12_STATIC_SAMPLER_DESC samplerDesc(
+        0,
+        D3D12_FILTER_MIN_MAG_MIP_LINEAR,
+        D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+        D3D12_TEXTURE_ADDRESS_MODE_CLAMP
+    );
+
+    CD3DX12_ROOT_SIGNATURE_DESC signatureDesc;
+    signatureDesc.Init(2, params, 1, &samplerDesc, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+
+    /* Create serialized root signature */
+    ComPtr<ID3DBlob> signature;
+    ComPtr<ID3DBlob> error;
+
+    auto hr = D3D12SerializeRootSignature(
+        &signatureDesc,
+        D3D_ROOT_SIGNATURE_VERSION_1,
+        signature.ReleaseAndGetAddressOf(),
+        error.ReleaseAndGetAddressOf()
+    );
+
+    if (FAILED(hr) && error)
+    {
+        auto errorStr = DXGetBlobString(error.Get());
+        throw std::runtime_error("failed to serialize D3D12 root signature for MIP-map generation: " + errorStr);
+    }
+
+    DXThrowIfFailed(hr, "failed to serialize D3D12 root signature for MIP-map generation");
+
+    hr = device->CreateRootSignature(
+        0,
+        signature->GetBufferPointer(),
+        signature->GetBufferSize(),
+        IID_PPV_ARGS(rootSignature_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 root signature for MIP-map generation");
+}
+
+void D3D12MipGenerator::CreatePipelineState(ID3D12Device* device)
+{
+    /* Compile compute shader from the built-in source */
+    ComPtr<ID3DBlob> code;
+    ComPtr<ID3DBlob> errors;
+
+    const std::string sourceCode = g_mipGeneratorShaderSource;
+
+    auto hr = D3DCompile(
+        sourceCode.data(),
+        sourceCode.size(),
+        nullptr,                        // LPCSTR               pSourceName
+        nullptr,                        // D3D_SHADER_MACRO*    pDefines
+        nullptr,                        // ID3DInclude*         pInclude
+        "CS",                           // LPCSTR               pEntrypoint
+        "cs_5_0",                       // LPCSTR               pTarget
+        D3DCOMPILE_OPTIMIZATION_LEVEL3, // UINT                 Flags1
+        0,                              // UINT                 Flags2 (recommended to always be 0)
+        code.ReleaseAndGetAddressOf(),  // ID3DBlob**           ppCode
+        errors.ReleaseAndGetAddressOf() // ID3DBlob**           ppErrorMsgs
+    );
+
+    if (FAILED(hr) && errors)
+    {
+        auto errorStr = DXGetBlobString(errors.Get());
+        throw std::runtime_error("failed to compile D3D12 compute shader for MIP-map generation: " + errorStr);
+    }
+
+    DXThrowIfFailed(hr, "failed to compile D3D12 compute shader for MIP-map generation");
+
+    /* Create compute pipeline state */
+    D3D12_COMPUTE_PIPELINE_STATE_DESC stateDesc = {};
+    {
+        stateDesc.pRootSignature        = rootSignature_.Get();
+        stateDesc.CS.pShaderBytecode    = code->GetBufferPointer();
+        stateDesc.CS.BytecodeLength     = code->GetBufferSize();
+        stateDesc.NodeMask              = 0;
+        stateDesc.Flags                 = D3D12_PIPELINE_STATE_FLAG_NONE;
+    }
+    hr = device->CreateComputePipelineState(&stateDesc, IID_PPV_ARGS(pipelineState_.ReleaseAndGetAddressOf()));
+    DXThrowIfFailed(hr, "failed to create D3D12 compute pipeline state for MIP-map generation");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,64 @@
+/*
+ * D3D12MipGenerator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_MIP_GENERATOR_H
+#define LLGL_D3D12_MIP_GENERATOR_H
+
+
+#include "../../DXCommon/ComPtr.h"
+#include <d3d12.h>
+
+
+namespace LLGL
+{
+
+
+class D3D12Texture;
+
+/*
+Generates the MIP-map chain of 2D textures (including arrays and cube maps) with a compute shader,
+since Direct3D 12 has no equivalent to "ID3D11DeviceContext::GenerateMips".
+Each dispatch downsamples up to four MIP-map levels at once: every thread group reduces an 8x8 tile of the first level in group-shared memory,
+so only the last level of each dispatch needs to be read back from the texture by the next dispatch.
+*/
+class D3D12MipGenerator
+{
+
+    public:
+
+        // Maximal number of MIP-map levels that are generated by a single dispatch.
+        static const UINT maxMipsPerDispatch = 4;
+
+        // Returns true if the specified format can be written by the compute shader, i.e. it is a non-integral color format with typed UAV stores.
+        static bool IsFormatSupported(ID3D12Device* device, DXGI_FORMAT format);
+
+        /*
+        Records the dispatches to generate all MIP-map levels of the specified texture from its first level.
+        The texture must have been created with the D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS flag and must be in the pixel-shader-resource state.
+        Returns the descriptor heap of the dispatches, which must be kept alive until the GPU has executed the command list.
+        */
+        ComPtr<ID3D12DescriptorHeap> GenerateMips(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, D3D12Texture& texture);
+
+    private:
+
+        void CreateRootSignature(ID3D12Device* device);
+        void CreatePipelineState(ID3D12Device* device);
+
+        ComPtr<ID3D12RootSignature> rootSignature_;
+        ComPtr<ID3D12PipelineState> pipelineState_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,486 @@
+/*
+ * D3D12RenderTarget.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "D3D12RenderTarget.h"
+#include "D3D12Texture.h"
+#include "../D3D12RenderSystem.h"
+#include "../D3D12ResourceBarrierBatch.h"
+#include "../D3DX12/d3dx12.h"
+#include "../../DXCommon/DXCore.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+D3D12RenderTarget::D3D12RenderTarget(D3D12RenderSystem& renderSystem, const RenderTargetDescriptor& desc) :
+    renderSystem_ { renderSystem                     },
+    multiSamples_ { desc.multiSampling.SampleCount() }
+{
+}
+
+D3D12RenderTarget::~D3D12RenderTarget()
+{
+    DetachAll();
+}
+
+void D3D12RenderTarget::AttachDepthBuffer(const Gs::Vector2ui& size)
+{
+    CreateDepthStencilAndDSV(size, DXGI_FORMAT_D24_UNORM_S8_UINT);
+}
+
+void D3D12RenderTarget::AttachStencilBuffer(const Gs::Vector2ui& size)
+{
+    CreateDepthStencilAndDSV(size, DXGI_FORMAT_D24_UNORM_S8_UINT);
+}
+
+void D3D12RenderTarget::AttachDepthStencilBuffer(const Gs::Vector2ui& size)
+{
+    CreateDepthStencilAndDSV(size, DXGI_FORMAT_D24_UNORM_S8_UINT);
+}
+
+void D3D12RenderTarget::AttachTexture(Texture& texture, const RenderTargetAttachmentDescriptor& attachmentDesc)
+{
+    /* Get D3D texture object and apply resolution for MIP-map level */
+    auto& textureD3D = LLGL_CAST(D3D12Texture&, texture);
+
+    /*
+    Multi-sampled render targets require a multi-sample texture, since D3D12 has no implicit resolve
+    and intermediate multi-sample textures are not supported yet.
+    */
+    if (HasMultiSampling() && !IsMultiSampleTexture(texture.GetType()))
+        throw std::invalid_argument("failed to attach non-multi-sample D3D12 texture to multi-sample render-target");
+
+    ApplyMipResolution(texture, attachmentDesc.mipLevel);
+
+    /* Depth-stencil textures are attached with a DSV instead of an RTV */
+    if (DXIsDepthStencilFormat(textureD3D.GetFormat()))
+        CreateDSVForTexture(textureD3D, attachmentDesc);
+    else
+        CreateRTVForTexture(textureD3D, attachmentDesc);
+}
+
+void D3D12RenderTarget::DetachAll()
+{
+    ResetResolution();
+
+    /* Return all descriptors to the pools of the render system */
+    for (const auto& descHandle : rtvDescHandles_)
+        renderSystem_.GetRTVDescriptorPool().Free(descHandle);
+
+    rtvDescHandles_.clear();
+    colorAttachments_.clear();
+
+    if (hasDSV_)
+    {
+        renderSystem_.GetDSVDescriptorPool().Free(dsvDescHandle_);
+        hasDSV_ = false;
+    }
+
+    depthAttachment_ = { nullptr, {} };
+
+    /* Keep internal depth-stencil buffer alive until the GPU is done with it */
+    if (depthStencil_)
+    {
+        renderSystem_.ReleaseDeferred(depthStencil_.Get(), depthStencilRegion_);
+        depthStencil_.Reset();
+        depthStencilRegion_ = {};
+    }
+}
+
+/* ----- Extended Internal Functions ----- */
+
+void D3D12RenderTarget::TransitionAttachments(D3D12ResourceBarrierBatch& barrierBatch, bool outputMerger) const
+{
+    const auto srvState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+
+    for (const auto& attachment : colorAttachments_)
+    {
+        for (auto subresource : attachment.subresources)
+        {
+            if (outputMerger)
+                barrierBatch.Transition(attachment.resource, srvState, D3D12_RESOURCE_STATE_RENDER_TARGET, subresource);
+            else
+                barrierBatch.Transition(attachment.resource, D3D12_RESOURCE_STATE_RENDER_TARGET, srvState, subresource);
+        }
+    }
+
+    if (depthAttachment_.resource != nullptr)
+    {
+        for (auto subresource : depthAttachment_.subresources)
+        {
+            if (outputMerger)
+                barrierBatch.Transition(depthAttachment_.resource, srvState, D3D12_RESOURCE_STATE_DEPTH_WRITE, subresource);
+            else
+                barrierBatch.Transition(depthAttachment_.resource, D3D12_RESOURCE_STATE_DEPTH_WRITE, srvState, subresource);
+        }
+    }
+}
+
+void D3D12RenderTarget::DiscardColorAttachment(ID3D12GraphicsCommandList* commandList, std::size_t index) const
+{
+    if (index < colorAttachments_.size())
+        Discard(commandList, colorAttachments_[index]);
+}
+
+void D3D12RenderTarget::DiscardDepthStencilAttachment(ID3D12GraphicsCommandList* commandList) const
+{
+    if (depthStencil_)
+        commandList->DiscardResource(depthStencil_.Get(), nullptr);
+    else if (depthAttachment_.resource != nullptr)
+        Discard(commandList, depthAttachment_);
+}
+
+std::uint64_t D3D12RenderTarget::GetInternalMemory() const
+{
+    if (depthStencil_)
+    {
+        auto resDesc = depthStencil_->GetDesc();
+        return (resDesc.Width * resDesc.Height * (std::max)(1u, resDesc.SampleDesc.Count) * 4);
+    }
+    return 0;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Returns the number of planes of the specified format, i.e. 2 for depth-stencil formats with a separate stencil plane.
+static UINT GetNumPlanes(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_D24_UNORM_S8_UINT:
+        case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+// Returns the subresource indices of the specified array slices of a MIP-map level, for all planes of the resource.
+static std::vector<UINT> GetSubresources(ID3D12Resource* resource, UINT mipLevel, UINT firstSlice, UINT numSlices, UINT numPlanes)
+{
+    auto resDesc = resource->GetDesc();
+    const UINT arraySize = (resDesc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1u : resDesc.DepthOrArraySize);
+
+    std::vector<UINT> subresources;
+    subresources.reserve(numSlices * numPlanes);
+
+    for (UINT plane = 0; plane < numPlanes; ++plane)
+    {
+        for (UINT slice = firstSlice; slice < firstSlice + numSlices; ++slice)
+            subresources.push_back(D3D12CalcSubresource(mipLevel, slice, plane, resDesc.MipLevels, arraySize));
+    }
+
+    return subresources;
+}
+
+/*
+Extends the specified RTV descriptor to all array slices (or all depth slices) of the resource for a layered attachment,
+and returns the number of array slices the view covers (a 3D texture has no array slices).
+*/
+static UINT ExtendViewDescToAllLayers(D3D12_RENDER_TARGET_VIEW_DESC& viewDesc, ID3D12Resource* resource)
+{
+    const UINT arraySize = resource->GetDesc().DepthOrArraySize;
+
+    switch (viewDesc.ViewDimension)
+    {
+        case D3D12_RTV_DIMENSION_TEXTURE1DARRAY:
+            viewDesc.Texture1DArray.FirstArraySlice     = 0;
+            viewDesc.Texture1DArray.ArraySize           = arraySize;
+            return arraySize;
+        case D3D12_RTV_DIMENSION_TEXTURE2DARRAY:
+            viewDesc.Texture2DArray.FirstArraySlice     = 0;
+            viewDesc.Texture2DArray.ArraySize           = arraySize;
+            return arraySize;
+        case D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY:
+            viewDesc.Texture2DMSArray.FirstArraySlice   = 0;
+            viewDesc.Texture2DMSArray.ArraySize         = arraySize;
+            return arraySize;
+        case D3D12_RTV_DIMENSION_TEXTURE3D:
+            viewDesc.Texture3D.FirstWSlice              = 0;
+            viewDesc.Texture3D.WSize                    = static_cast<UINT>(-1);
+            return 1;
+        default:
+            throw std::invalid_argument("layered render target attachments must be array, cube, or 3D textures");
+    }
+}
+
+// Extends the specified DSV descriptor to all array slices of the resource for a layered attachment, and returns the number of array slices.
+static UINT ExtendViewDescToAllLayers(D3D12_DEPTH_STENCIL_VIEW_DESC& viewDesc, ID3D12Resource* resource)
+{
+    const UINT arraySize = resource->GetDesc().DepthOrArraySize;
+
+    switch (viewDesc.ViewDimension)
+    {
+        case D3D12_DSV_DIMENSION_TEXTURE1DARRAY:
+            viewDesc.Texture1DArray.FirstArraySlice     = 0;
+            viewDesc.Texture1DArray.ArraySize           = arraySize;
+            return arraySize;
+        case D3D12_DSV_DIMENSION_TEXTURE2DARRAY:
+            viewDesc.Texture2DArray.FirstArraySlice     = 0;
+            viewDesc.Texture2DArray.ArraySize           = arraySize;
+            return arraySize;
+        case D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY:
+            viewDesc.Texture2DMSArray.FirstArraySlice   = 0;
+            viewDesc.Texture2DMSArray.ArraySize         = arraySize;
+            return arraySize;
+        default:
+            throw std::invalid_argument("layered depth-stencil attachments must be array or cube textures");
+    }
+}
+
+void D3D12RenderTarget::CreateDepthStencilAndDSV(const Gs::Vector2ui& size, DXGI_FORMAT format)
+{
+    if (hasDSV_)
+        throw std::runtime_error("attachment to render target failed, because render target already has a depth- or depth-stencil buffer");
+
+    /* Apply size to render target resolution, and create depth-stencil */
+    ApplyResolution(size);
+
+    /* Create depth stencil buffer, which remains in the depth-write state for its entire lifetime */
+    D3D12_RESOURCE_DESC resDesc;
+    {
+        resDesc.Dimension           = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        resDesc.Alignment           = 0;
+        resDesc.Width               = size.x;
+        resDesc.Height              = size.y;
+        resDesc.DepthOrArraySize    = 1;
+        resDesc.MipLevels           = 1;
+        resDesc.Format              = format;
+        resDesc.SampleDesc.Count    = (std::max)(1u, multiSamples_);
+        resDesc.SampleDesc.Quality  = 0;
+        resDesc.Layout              = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+        resDesc.Flags               = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL | D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
+    }
+    D3D12_CLEAR_VALUE clearValue;
+    {
+        clearValue.Format               = format;
+        clearValue.DepthStencil.Depth   = 1.0f;
+        clearValue.DepthStencil.Stencil = 0;
+    }
+    depthStencil_ = renderSystem_.GetMemoryAllocator().CreateResource(
+        resDesc, D3D12_RESOURCE_STATE_DEPTH_WRITE, &clearValue, depthStencilRegion_
+    );
+
+    /* Create DSV */
+    dsvDescHandle_  = renderSystem_.GetDSVDescriptorPool().Allocate();
+    hasDSV_         = true;
+    renderSystem_.GetDevice()->CreateDepthStencilView(depthStencil_.Get(), nullptr, dsvDescHandle_);
+}
+
+void D3D12RenderTarget::CreateDSVForTexture(D3D12Texture& textureD3D, const RenderTargetAttachmentDescriptor& attachmentDesc)
+{
+    if (hasDSV_)
+        throw std::runtime_error("attachment to render target failed, because render target already has a depth- or depth-stencil buffer");
+
+    /* Initialize DSV descriptor with attachment procedure */
+    D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc;
+    InitMemory(dsvDesc);
+
+    dsvDesc.Format = textureD3D.GetFormat();
+
+    UINT firstSlice = 0, numSlices = 1;
+
+    switch (textureD3D.GetType())
+    {
+        case TextureType::Texture1D:
+            dsvDesc.ViewDimension                       = D3D12_DSV_DIMENSION_TEXTURE1D;
+            dsvDesc.Texture1D.MipSlice                  = attachmentDesc.mipLevel;
+            break;
+        case TextureType::Texture1DArray:
+            firstSlice                                  = attachmentDesc.layer;
+            dsvDesc.ViewDimension                       = D3D12_DSV_DIMENSION_TEXTURE1DARRAY;
+            dsvDesc.Texture1DArray.MipSlice             = attachmentDesc.mipLevel;
+            dsvDesc.Texture1DArray.FirstArraySlice      = firstSlice;
+            dsvDesc.Texture1DArray.ArraySize            = numSlices;
+            break;
+        case TextureType::Texture2D:
+            dsvDesc.ViewDimension                       = D3D12_DSV_DIMENSION_TEXTURE2D;
+            dsvDesc.Texture2D.MipSlice                  = attachmentDesc.mipLevel;
+            break;
+        case TextureType::TextureCube:
+            firstSlice                                  = static_cast<UINT>(attachmentDesc.cubeFace);
+            dsvDesc.ViewDimension                       = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
+            dsvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            dsvDesc.Texture2DArray.FirstArraySlice      = firstSlice;
+            dsvDesc.Texture2DArray.ArraySize            = numSlices;
+            break;
+        case TextureType::Texture2DArray:
+            firstSlice                                  = attachmentDesc.layer;
+            numSlices                                   = (std::max)(1u, attachmentDesc.numViews);
+            dsvDesc.ViewDimension                       = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
+            dsvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            dsvDesc.Texture2DArray.FirstArraySlice      = firstSlice;
+            dsvDesc.Texture2DArray.ArraySize            = numSlices;
+            break;
+        case TextureType::TextureCubeArray:
+            firstSlice                                  = attachmentDesc.layer * 6 + static_cast<UINT>(attachmentDesc.cubeFace);
+            dsvDesc.ViewDimension                       = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
+            dsvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            dsvDesc.Texture2DArray.FirstArraySlice      = firstSlice;
+            dsvDesc.Texture2DArray.ArraySize            = numSlices;
+            break;
+        case TextureType::Texture2DMS:
+            dsvDesc.ViewDimension                       = D3D12_DSV_DIMENSION_TEXTURE2DMS;
+            break;
+        case TextureType::Texture2DMSArray:
+            firstSlice                                  = attachmentDesc.layer;
+            dsvDesc.ViewDimension                       = D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY;
+            dsvDesc.Texture2DMSArray.FirstArraySlice    = firstSlice;
+            dsvDesc.Texture2DMSArray.ArraySize          = numSlices;
+            break;
+        default:
+            throw std::invalid_argument("failed to attach D3D12 depth texture with invalid texture type to render-target");
+            break;
+    }
+
+    /* Attach all layers, which are selected per primitive in the shader */
+    if (attachmentDesc.layered)
+    {
+        firstSlice  = 0;
+        numSlices   = ExtendViewDescToAllLayers(dsvDesc, textureD3D.Get());
+    }
+
+    /* Create DSV for the depth texture (the texture itself is owned by the client programmer) */
+    auto resource = textureD3D.Get();
+
+    dsvDescHandle_  = renderSystem_.GetDSVDescriptorPool().Allocate();
+    hasDSV_         = true;
+    renderSystem_.GetDevice()->CreateDepthStencilView(resource, &dsvDesc, dsvDescHandle_);
+
+    depthAttachment_ =
+    {
+        resource,
+        GetSubresources(resource, attachmentDesc.mipLevel, firstSlice, numSlices, GetNumPlanes(textureD3D.GetFormat()))
+    };
+}
+
+void D3D12RenderTarget::CreateRTVForTexture(D3D12Texture& textureD3D, const RenderTargetAttachmentDescriptor& attachmentDesc)
+{
+    /* Initialize RTV descriptor with attachment procedure */
+    D3D12_RENDER_TARGET_VIEW_DESC rtvDesc;
+    InitMemory(rtvDesc);
+
+    rtvDesc.Format = textureD3D.GetFormat();
+
+    UINT firstSlice = 0, numSlices = 1;
+
+    switch (textureD3D.GetType())
+    {
+        case TextureType::Texture1D:
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE1D;
+            rtvDesc.Texture1D.MipSlice                  = attachmentDesc.mipLevel;
+            break;
+        case TextureType::Texture2D:
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE2D;
+            rtvDesc.Texture2D.MipSlice                  = attachmentDesc.mipLevel;
+            break;
+        case TextureType::Texture3D:
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE3D;
+            rtvDesc.Texture3D.MipSlice                  = attachmentDesc.mipLevel;
+            rtvDesc.Texture3D.FirstWSlice               = attachmentDesc.layer;
+            rtvDesc.Texture3D.WSize                     = 1;
+            break;
+        case TextureType::TextureCube:
+            firstSlice                                  = static_cast<UINT>(attachmentDesc.cubeFace);
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+            rtvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            rtvDesc.Texture2DArray.FirstArraySlice      = firstSlice;
+            rtvDesc.Texture2DArray.ArraySize            = numSlices;
+            break;
+        case TextureType::Texture1DArray:
+            firstSlice                                  = attachmentDesc.layer;
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE1DARRAY;
+            rtvDesc.Texture1DArray.MipSlice             = attachmentDesc.mipLevel;
+            rtvDesc.Texture1DArray.FirstArraySlice      = firstSlice;
+            rtvDesc.Texture1DArray.ArraySize            = numSlices;
+            break;
+        case TextureType::Texture2DArray:
+            firstSlice                                  = attachmentDesc.layer;
+            numSlices                                   = (std::max)(1u, attachmentDesc.numViews);
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+            rtvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            rtvDesc.Texture2DArray.FirstArraySlice      = firstSlice;
+            rtvDesc.Texture2DArray.ArraySize            = numSlices;
+            break;
+        case TextureType::TextureCubeArray:
+            firstSlice                                  = attachmentDesc.layer * 6 + static_cast<UINT>(attachmentDesc.cubeFace);
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+            rtvDesc.Texture2DArray.MipSlice             = attachmentDesc.mipLevel;
+            rtvDesc.Texture2DArray.FirstArraySlice      = firstSlice;
+            rtvDesc.Texture2DArray.ArraySize            = numSlices;
+            break;
+        case TextureType::Texture2DMS:
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE2DMS;
+            break;
+        case TextureType::Texture2DMSArray:
+            firstSlice                                  = attachmentDesc.layer;
+            numSlices                                   = (std::max)(1u, attachmentDesc.numViews);
+            rtvDesc.ViewDimension                       = D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY;
+            rtvDesc.Texture2DMSArray.FirstArraySlice    = firstSlice;
+            rtvDesc.Texture2DMSArray.ArraySize          = numSlices;
+            break;
+    }
+
+    /* Attach all layers (or cube faces, or depth slices), which are selected per primitive in the shader */
+    if (attachmentDesc.layered)
+    {
+        firstSlice  = 0;
+        numSlices   = ExtendViewDescToAllLayers(rtvDesc, textureD3D.Get());
+    }
+
+    /* Create RTV for target texture (a 3D texture has no array slices, so its subresource is determined by the MIP-map level only) */
+    auto resource = textureD3D.Get();
+
+    auto descHandle = renderSystem_.GetRTVDescriptorPool().Allocate();
+    renderSystem_.GetDevice()->CreateRenderTargetView(resource, &rtvDesc, descHandle);
+    rtvDescHandles_.push_back(descHandle);
+
+    if (textureD3D.GetType() == TextureType::Texture3D)
+        firstSlice = 0;
+
+    colorAttachments_.push_back(
+        {
+            resource,
+            GetSubresources(resource, attachmentDesc.mipLevel, firstSlice, numSlices, 1)
+        }
+    );
+}
+
+void D3D12RenderTarget::Discard(ID3D12GraphicsCommandList* commandList, const D3D12Attachment& attachment) const
+{
+    for (auto subresource : attachment.subresources)
+    {
+        D3D12_DISCARD_REGION region;
+        {
+            region.NumRects         = 0;
+            region.pRects           = nullptr;
+            region.FirstSubresource = subresource;
+            region.NumSubresources  = 1;
+        }
+        commandList->DiscardResource(attachment.resource, &region);
+    }
+}
+
+bool D3D12RenderTarget::HasMultiSampling() const
+{
+    return (multiSamples_ > 1);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,112 @@
+/*
+ * D3D12RenderTarget.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_D3D12_RENDER_TARGET_H
+#define LLGL_D3D12_RENDER_TARGET_H
+
+
+#include <LLGL/RenderTarget.h>
+#include "../../DXCommon/ComPtr.h"
+#include "../D3D12MemoryAllocator.h"
+#include <d3d12.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class D3D12RenderSystem;
+class D3D12Texture;
+class D3D12ResourceBarrierBatch;
+
+class D3D12RenderTarget : public RenderTarget
+{
+
+    public:
+
+        D3D12RenderTarget(D3D12RenderSystem& renderSystem, const RenderTargetDescriptor& desc);
+        ~D3D12RenderTarget();
+
+        void AttachDepthBuffer(const Gs::Vector2ui& size) override;
+        void AttachStencilBuffer(const Gs::Vector2ui& size) override;
+        void AttachDepthStencilBuffer(const Gs::Vector2ui& size) override;
+
+        void AttachTexture(Texture& texture, const RenderTargetAttachmentDescriptor& attachmentDesc) override;
+
+        void DetachAll() override;
+
+        /* ----- Extended Internal Functions ----- */
+
+        /*
+        Adds the transitions of all attached subresources from the shader-resource state into their output-merger states,
+        or back into the shader-resource state if 'outputMerger' is false. The internal depth-stencil buffer always remains in the depth-write state.
+        */
+        void TransitionAttachments(D3D12ResourceBarrierBatch& barrierBatch, bool outputMerger) const;
+
+        // Discards the contents of the specified color attachment.
+        void DiscardColorAttachment(ID3D12GraphicsCommandList* commandList, std::size_t index) const;
+
+        // Discards the contents of the depth-stencil attachment.
+        void DiscardDepthStencilAttachment(ID3D12GraphicsCommandList* commandList) const;
+
+        // Returns the size (in bytes) of the internal depth-stencil buffer.
+        std::uint64_t GetInternalMemory() const;
+
+        // Returns the CPU descriptor handles of the render-target-views (RTV) of all color attachments.
+        inline const std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>& GetRTVDescHandles() const
+        {
+            return rtvDescHandles_;
+        }
+
+        // Returns the CPU descriptor handle of the depth-stencil-view (DSV), or null if there is no depth-stencil attachment.
+        inline const D3D12_CPU_DESCRIPTOR_HANDLE* GetDSVDescHandle() const
+        {
+            return (hasDSV_ ? &dsvDescHandle_ : nullptr);
+        }
+
+    private:
+
+        // Attached texture with the subresources its view refers to.
+        struct D3D12Attachment
+        {
+            ID3D12Resource*     resource;
+            std::vector<UINT>   subresources;
+        };
+
+        void CreateDepthStencilAndDSV(const Gs::Vector2ui& size, DXGI_FORMAT format);
+        void CreateDSVForTexture(D3D12Texture& textureD3D, const RenderTargetAttachmentDescriptor& attachmentDesc);
+        void CreateRTVForTexture(D3D12Texture& textureD3D, const RenderTargetAttachmentDescriptor& attachmentDesc);
+
+        void Discard(ID3D12GraphicsCommandList* commandList, const D3D12Attachment& attachment) const;
+
+        bool HasMultiSampling() const;
+
+        D3D12RenderSystem&                          renderSystem_;
+        UINT                                        multiSamples_       = 0;
+
+        std::vector<D3D12_CPU_DESCRIPTOR_HANDLE>    rtvDescHandles_;    // allocated from the RTV pool of the render system
+        std::vector<D3D12Attachment>                colorAttachments_;
+
+        D3D12_CPU_DESCRIPTOR_HANDLE                 dsvDescHandle_;     // allocated from the DSV pool of the render system
+        bool                                        hasDSV_             = false;
+        D3D12Attachment                             depthAttachment_    = { nullptr, {} }; // null resource for the internal depth-stencil buffer
+
+        ComPtr<ID3D12Resource>                      depthStencil_;      // internal depth-stencil buffer
+        D3D12MemoryRegion                           depthStencilRegion_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,10 +6,13 @@
  */
 
 #include "D3D12Texture.h"
+#include "D3D12MipGenerator.h"
 #include "../D3DX12/d3dx12.h"
 #include "../../DXCommon/DXCore.h"
 #include "../../DXCommon/DXTypes.h"
 #include "../D3D12Types.h"
+#include <algorithm>
+#include <stdexcept>
 
 
 namespace LLGL
@@ -33,7 +36,18 @@ static D3D12_RESOURCE_DIMENSION GetResourceDimension(const TextureType type)
     DXTypes::MapFailed("TextureType", "D3D12_RESOURCE_DIMENSION");
 }
 
-D3D12Texture::D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc) :
+// Returns true if the specified color format can be used as render-target-view (RTV).
+static bool IsRenderTargetFormat(ID3D12Device* device, DXGI_FORMAT format)
+{
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = { format, D3D12_FORMAT_SUPPORT1_NONE, D3D12_FORMAT_SUPPORT2_NONE };
+    if (FAILED(device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, sizeof(formatSupport))))
+        return false;
+    return ((formatSupport.Support1 & D3D12_FORMAT_SUPPORT1_RENDER_TARGET) != 0);
+}
+
+static void FillViewSRVDesc(const TextureViewDescriptor& desc, D3D12_SHADER_RESOURCE_VIEW_DESC& srvDesc);
+
+D3D12Texture::D3D12Texture(ID3D12Device* device, D3D12MemoryAllocator& memoryAllocator, const TextureDescriptor& desc) :
     Texture { desc.type }
 {
     /* Setup resource descriptor by texture descriptor */
@@ -70,8 +84,256 @@ D3D12Texture::D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc)
         }
     }
 
-    /* Create hardware resource */
-    CreateResource(device, resDesc);
+    /* Allocate a full MIP-map chain like the other render systems (multi-sampled textures have no MIP-maps) */
+    const bool multiSampled = (desc.type == TextureType::Texture2DMS || desc.type == TextureType::Texture2DMSArray);
+
+    if (!multiSampled)
+    {
+        if (resDesc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
+            resDesc.MipLevels = static_cast<UINT16>(NumMipLevels(static_cast<unsigned int>(resDesc.Width), resDesc.Height, resDesc.DepthOrArraySize));
+        else
+            resDesc.MipLevels = static_cast<UINT16>(NumMipLevels(static_cast<unsigned int>(resDesc.Width), resDesc.Height));
+    }
+    else
+        resDesc.SampleDesc.Count = (std::max)(1u, desc.texture2DMS.samples);
+
+    format_         = resDesc.Format;
+    numMipLevels_   = resDesc.MipLevels;
+
+    /* Allow UAVs for the MIP-map levels, which are generated by a compute shader */
+    if (resDesc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE2D && resDesc.MipLevels > 1 && D3D12MipGenerator::IsFormatSupported(device, resDesc.Format))
+        resDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
+    if (DXIsDepthStencilFormat(format_) && resDesc.Dimension != D3D12_RESOURCE_DIMENSION_TEXTURE3D)
+    {
+        /* Create depth-stencil textures with a typeless format, so they can be attached as depth-stencil-view (DSV) and sampled as well */
+        resDesc.Format  = DXGetTypelessDepthStencilFormat(format_);
+        resDesc.Flags   |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+        TextureViewDescriptor viewDesc;
+        {
+            viewDesc.type               = desc.type;
+            viewDesc.firstMipLevel      = 0;
+            viewDesc.numMipLevels       = resDesc.MipLevels;
+            viewDesc.firstArrayLayer    = 0;
+            viewDesc.numArrayLayers     = resDesc.DepthOrArraySize;
+        }
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+        {
+            srvDesc.Format                  = DXGetDepthSRVFormat(format_);
+            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            FillViewSRVDesc(viewDesc, srvDesc);
+        }
+        CreateResource(device, memoryAllocator, resDesc, &srvDesc);
+    }
+    else
+    {
+        /* Allow color textures to be attached to render targets */
+        if (IsRenderTargetFormat(device, resDesc.Format))
+            resDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+        CreateResource(device, memoryAllocator, resDesc);
+    }
+}
+
+/*
+A view of a single array layer other than the first one is created with an array dimension,
+since the non-array dimensions of a shader-resource-view (SRV) cannot select an array layer.
+*/
+static void FillViewSRVDesc(const TextureViewDescriptor& desc, D3D12_SHADER_RESOURCE_VIEW_DESC& srvDesc)
+{
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            if (desc.type == TextureType::Texture1D && desc.firstArrayLayer == 0)
+            {
+                srvDesc.ViewDimension                               = D3D12_SRV_DIMENSION_TEXTURE1D;
+                srvDesc.Texture1D.MostDetailedMip                   = desc.firstMipLevel;
+                srvDesc.Texture1D.MipLevels                         = desc.numMipLevels;
+                srvDesc.Texture1D.ResourceMinLODClamp               = 0.0f;
+            }
+            else
+            {
+                srvDesc.ViewDimension                               = D3D12_SRV_DIMENSION_TEXTURE1DARRAY;
+                srvDesc.Texture1DArray.MostDetailedMip              = desc.firstMipLevel;
+                srvDesc.Texture1DArray.MipLevels                    = desc.numMipLevels;
+                srvDesc.Texture1DArray.FirstArraySlice              = desc.firstArrayLayer;
+                srvDesc.Texture1DArray.ArraySize                    = desc.numArrayLayers;
+                srvDesc.Texture1DArray.ResourceMinLODClamp          = 0.0f;
+            }
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+            if (desc.type == TextureType::Texture2D && desc.firstArrayLayer == 0)
+            {
+                srvDesc.ViewDimension                               = D3D12_SRV_DIMENSION_TEXTURE2D;
+                srvDesc.Texture2D.MostDetailedMip                   = desc.firstMipLevel;
+                srvDesc.Texture2D.MipLevels                         = desc.numMipLevels;
+                srvDesc.Texture2D.PlaneSlice                        = 0;
+                srvDesc.Texture2D.ResourceMinLODClamp               = 0.0f;
+            }
+            else
+            {
+                srvDesc.ViewDimension                               = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+                srvDesc.Texture2DArray.MostDetailedMip              = desc.firstMipLevel;
+                srvDesc.Texture2DArray.MipLevels                    = desc.numMipLevels;
+                srvDesc.Texture2DArray.FirstArraySlice              = desc.firstArrayLayer;
+                srvDesc.Texture2DArray.ArraySize                    = desc.numArrayLayers;
+                srvDesc.Texture2DArray.PlaneSlice                   = 0;
+                srvDesc.Texture2DArray.ResourceMinLODClamp          = 0.0f;
+            }
+            break;
+
+        case TextureType::Texture3D:
+            srvDesc.ViewDimension                                   = D3D12_SRV_DIMENSION_TEXTURE3D;
+            srvDesc.Texture3D.MostDetailedMip                       = desc.firstMipLevel;
+            srvDesc.Texture3D.MipLevels                             = desc.numMipLevels;
+            srvDesc.Texture3D.ResourceMinLODClamp                   = 0.0f;
+            break;
+
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            if (desc.type == TextureType::TextureCube && desc.firstArrayLayer == 0)
+            {
+                srvDesc.ViewDimension                               = D3D12_SRV_DIMENSION_TEXTURECUBE;
+                srvDesc.TextureCube.MostDetailedMip                 = desc.firstMipLevel;
+                srvDesc.TextureCube.MipLevels                       = desc.numMipLevels;
+                srvDesc.TextureCube.ResourceMinLODClamp             = 0.0f;
+            }
+            else
+            {
+                srvDesc.ViewDimension                               = D3D12_SRV_DIMENSION_TEXTURECUBEARRAY;
+                srvDesc.TextureCubeArray.MostDetailedMip            = desc.firstMipLevel;
+                srvDesc.TextureCubeArray.MipLevels                  = desc.numMipLevels;
+                srvDesc.TextureCubeArray.First2DArrayFace           = desc.firstArrayLayer;
+                srvDesc.TextureCubeArray.NumCubes                   = desc.numArrayLayers / 6;
+                srvDesc.TextureCubeArray.ResourceMinLODClamp        = 0.0f;
+            }
+            break;
+
+        case TextureType::Texture2DMS:
+            srvDesc.ViewDimension                                   = D3D12_SRV_DIMENSION_TEXTURE2DMS;
+            break;
+
+        case TextureType::Texture2DMSArray:
+            srvDesc.ViewDimension                                   = D3D12_SRV_DIMENSION_TEXTURE2DMSARRAY;
+            srvDesc.Texture2DMSArray.FirstArraySlice                = desc.firstArrayLayer;
+            srvDesc.Texture2DMSArray.ArraySize                      = desc.numArrayLayers;
+            break;
+    }
+}
+
+D3D12Texture::D3D12Texture(ID3D12Device* device, const D3D12Texture& sharedTexture, const TextureViewDescriptor& desc) :
+    Texture         { desc.type                  },
+    resource_       { sharedTexture.resource_    },
+    numMipLevels_   { sharedTexture.numMipLevels_ }
+{
+    format_ = (desc.format != TextureFormat::Unknown ? D3D12Types::Map(desc.format) : sharedTexture.format_);
+
+    /* Create SRV for the range of subresources (the memory region remains with the shared texture) */
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
+    {
+        srvDesc.Format                  = (DXIsDepthStencilFormat(format_) ? DXGetDepthSRVFormat(format_) : format_);
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        FillViewSRVDesc(desc, srvDesc);
+    }
+    CreateSRV(device, &srvDesc);
+}
+
+// Number of 64 KB tiles per tile heap of reserved textures, i.e. 16 MB heaps.
+static const UINT g_numTilesPerHeap = 256;
+
+D3D12Texture::D3D12Texture(ID3D12Device* device, ID3D12CommandQueue* commandQueue, const TextureDescriptor& desc) :
+    Texture { desc.type }
+{
+    /* Determine extent of the first MIP-map level, where the array layers (and cube faces) are the last component */
+    Gs::Vector3ui extent;
+    bool layered = true;
+
+    switch (desc.type)
+    {
+        case TextureType::Texture2D:
+            extent  = { desc.texture2D.width, desc.texture2D.height, 1 };
+            layered = false;
+            break;
+        case TextureType::Texture2DArray:
+            extent  = { desc.texture2D.width, desc.texture2D.height, desc.texture2D.layers };
+            break;
+        case TextureType::Texture3D:
+            extent  = { desc.texture3D.width, desc.texture3D.height, desc.texture3D.depth };
+            layered = false;
+            break;
+        case TextureType::TextureCube:
+            extent  = { desc.textureCube.width, desc.textureCube.height, 6 };
+            break;
+        case TextureType::TextureCubeArray:
+            extent  = { desc.textureCube.width, desc.textureCube.height, desc.textureCube.layers * 6 };
+            break;
+        default:
+            throw std::invalid_argument("cannot create sparse texture with 1D or multi-sampled texture type");
+    }
+
+    /* Create reserved resource with a full MIP-map chain, which has no memory until its tiles are mapped */
+    format_         = D3D12Types::Map(desc.format);
+    numMipLevels_   = NumMipLevels(extent.x, extent.y, (layered ? 1 : extent.z));
+
+    D3D12_RESOURCE_DESC resDesc;
+    {
+        resDesc.Dimension           = GetResourceDimension(desc.type);
+        resDesc.Alignment           = 0;
+        resDesc.Width               = extent.x;
+        resDesc.Height              = extent.y;
+        resDesc.DepthOrArraySize    = static_cast<UINT16>(extent.z);
+        resDesc.MipLevels           = static_cast<UINT16>(numMipLevels_);
+        resDesc.Format              = format_;
+        resDesc.SampleDesc.Count    = 1;
+        resDesc.SampleDesc.Quality  = 0;
+        resDesc.Layout              = D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE;
+        resDesc.Flags               = D3D12_RESOURCE_FLAG_NONE;
+    }
+    auto hr = device->CreateReservedResource(
+        &resDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(resource_.ReleaseAndGetAddressOf())
+    );
+    DXThrowIfFailed(hr, "failed to create D3D12 reserved resource for sparse texture");
+
+    CreateSRV(device, nullptr);
+
+    /* Query tile shape and packed MIP-maps */
+    UINT                    numTiles                = 0;
+    D3D12_PACKED_MIP_INFO   packedMipInfo;
+    D3D12_TILE_SHAPE        tileShape;
+    UINT                    numSubresourceTilings   = 0;
+
+    device->GetResourceTiling(resource_.Get(), &numTiles, &packedMipInfo, &tileShape, &numSubresourceTilings, 0, nullptr);
+
+    sparsePageTable_ = std::unique_ptr<SparsePageTable>(
+        new SparsePageTable(
+            extent,
+            layered,
+            Gs::Vector3ui { tileShape.WidthInTexels, tileShape.HeightInTexels, (layered ? 1u : tileShape.DepthInTexels) },
+            packedMipInfo.NumStandardMips
+        )
+    );
+
+    /* Map packed MIP-maps of each array layer, which are always resident (X addresses the tiles within the packed MIP-maps) */
+    std::vector<D3D12_TILED_RESOURCE_COORDINATE>    coords;
+    std::vector<UINT>                               tiles;
+
+    const UINT numLayers = (layered ? extent.z : 1);
+
+    for (UINT layer = 0; layer < numLayers; ++layer)
+    {
+        for (UINT i = 0; i < packedMipInfo.NumTilesForPackedMips; ++i)
+        {
+            coords.push_back({ i, 0, 0, D3D12CalcSubresource(packedMipInfo.NumStandardMips, layer, 0, numMipLevels_, numLayers) });
+            tiles.push_back(AllocTile(device));
+        }
+    }
+
+    if (!coords.empty())
+        UpdateTileMappings(commandQueue, coords, tiles);
 }
 
 Gs::Vector3ui D3D12Texture::QueryMipLevelSize(unsigned int mipLevel) const
@@ -84,21 +346,13 @@ Gs::Vector3ui D3D12Texture::QueryMipLevelSize(unsigned int mipLevel) const
 }
 
 void D3D12Texture::UpdateSubresource(
-    ID3D12Device* device, ID3D12GraphicsCommandList* commandList, ComPtr<ID3D12Resource>& uploadBuffer, D3D12_SUBRESOURCE_DATA& subresourceData)
+    ID3D12GraphicsCommandList* commandList, D3D12StagingBufferPool& stagingBufferPool, D3D12_SUBRESOURCE_DATA& subresourceData)
 {
-    /* Create the GPU upload buffer */
+    /* Allocate staging memory with the placement alignment for texture data */
     auto uploadBufferSize = GetRequiredIntermediateSize(resource_.Get(), 0, 1);
+    auto range = stagingBufferPool.Allocate(uploadBufferSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
 
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize),
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(uploadBuffer.ReleaseAndGetAddressOf())
-    );
-
-    UpdateSubresources(commandList, resource_.Get(), uploadBuffer.Get(), 0, 0, 1, &subresourceData);
+    UpdateSubresources(commandList, resource_.Get(), range.resource, range.offset, 0, 1, &subresourceData);
 
     auto resourceBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
         resource_.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
@@ -107,40 +361,189 @@ void D3D12Texture::UpdateSubresource(
     commandList->ResourceBarrier(1, &resourceBarrier);
 }
 
+// Returns the key of the specified tile for the map of tile indices.
+static std::uint64_t GetTileKey(const D3D12_TILED_RESOURCE_COORDINATE& coord)
+{
+    return
+    (
+        (static_cast<std::uint64_t>(coord.Subresource) << 48) |
+        (static_cast<std::uint64_t>(coord.Z          ) << 32) |
+        (static_cast<std::uint64_t>(coord.Y          ) << 16) |
+        (static_cast<std::uint64_t>(coord.X          )      )
+    );
+}
+
+void D3D12Texture::CommitTiles(ID3D12Device* device, ID3D12CommandQueue* commandQueue, const TextureRegion& region, bool commit)
+{
+    if (!sparsePageTable_)
+        return;
+
+    std::vector<D3D12_TILED_RESOURCE_COORDINATE>    coords;
+    std::vector<UINT>                               tiles;
+
+    /* Gather all tiles whose mapping changes */
+    const bool layered = (GetType() != TextureType::Texture2D && GetType() != TextureType::Texture3D);
+
+    sparsePageTable_->Commit(
+        region,
+        commit,
+        [&](unsigned int mipLevel, const Gs::Vector3ui& page)
+        {
+            D3D12_TILED_RESOURCE_COORDINATE coord;
+            {
+                coord.X             = page.x;
+                coord.Y             = page.y;
+                coord.Z             = (layered ? 0 : page.z);
+                coord.Subresource   = (layered ? D3D12CalcSubresource(mipLevel, page.z, 0, numMipLevels_, 0) : mipLevel);
+            }
+            coords.push_back(coord);
+
+            auto key = GetTileKey(coord);
+            if (commit)
+            {
+                auto tile = AllocTile(device);
+                mappedTiles_[key] = tile;
+                tiles.push_back(tile);
+            }
+            else
+            {
+                auto it = mappedTiles_.find(key);
+                if (it != mappedTiles_.end())
+                {
+                    freeTiles_.push_back(it->second);
+                    mappedTiles_.erase(it);
+                }
+            }
+        }
+    );
+
+    if (!coords.empty())
+        UpdateTileMappings(commandQueue, coords, tiles);
+}
+
 
 /*
  * ======= Private: =======
  */
 
 void D3D12Texture::CreateResource(
-    ID3D12Device* device, const D3D12_RESOURCE_DESC& desc, const D3D12_SHADER_RESOURCE_VIEW_DESC* srvDesc)
+    ID3D12Device* device, D3D12MemoryAllocator& memoryAllocator,
+    const D3D12_RESOURCE_DESC& desc, const D3D12_SHADER_RESOURCE_VIEW_DESC* srvDesc)
 {
-    /* Create hardware resource for the texture */
-    auto hr = device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-        D3D12_HEAP_FLAG_NONE,
-        &desc,
-        D3D12_RESOURCE_STATE_COPY_DEST,
-        nullptr,
-        IID_PPV_ARGS(resource_.ReleaseAndGetAddressOf())
-    );
-    DXThrowIfFailed(hr, "failed to create D3D12 committed resource for texture");
+    /* Create hardware resource for the texture (placed within a pooled heap block) */
+    resource_ = memoryAllocator.CreateResource(desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, memoryRegion_);
 
-    /* Create descriptor heap */
+    /* Create SRV for the entire texture */
+    CreateSRV(device, srvDesc);
+}
+
+void D3D12Texture::CreateSRV(ID3D12Device* device, const D3D12_SHADER_RESOURCE_VIEW_DESC* srvDesc)
+{
+    /* Create non-shader-visible descriptor heap (only used as source to copy descriptors) */
     D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc;
     {
         srvHeapDesc.Type            = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
         srvHeapDesc.NumDescriptors  = 1;
-        srvHeapDesc.Flags           = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        srvHeapDesc.Flags           = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
         srvHeapDesc.NodeMask        = 0;
     }
-    hr = device->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(descHeap_.ReleaseAndGetAddressOf()));
+    auto hr = device->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(descHeap_.ReleaseAndGetAddressOf()));
     DXThrowIfFailed(hr, "failed to create D3D12 descriptor heap for texture");
 
     /* Create SRV in the descriptor heap for the texture */
     device->CreateShaderResourceView(resource_.Get(), srvDesc, descHeap_->GetCPUDescriptorHandleForHeapStart());
 }
 
+UINT D3D12Texture::AllocTile(ID3D12Device* device)
+{
+    /* Reuse tiles of decommitted pages first */
+    if (!freeTiles_.empty())
+    {
+        auto tile = freeTiles_.back();
+        freeTiles_.pop_back();
+        return tile;
+    }
+
+    /* Create new tile heap if all tiles are in use */
+    if (numUsedTiles_ >= static_cast<UINT>(tileHeaps_.size()) * g_numTilesPerHeap)
+    {
+        D3D12_HEAP_DESC heapDesc;
+        {
+            heapDesc.SizeInBytes                        = static_cast<UINT64>(g_numTilesPerHeap) * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+            heapDesc.Properties.Type                    = D3D12_HEAP_TYPE_DEFAULT;
+            heapDesc.Properties.CPUPageProperty         = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+            heapDesc.Properties.MemoryPoolPreference    = D3D12_MEMORY_POOL_UNKNOWN;
+            heapDesc.Properties.CreationNodeMask        = 1;
+            heapDesc.Properties.VisibleNodeMask         = 1;
+            heapDesc.Alignment                          = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            heapDesc.Flags                              = D3D12_HEAP_FLAG_DENY_BUFFERS | D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES;
+        }
+        ComPtr<ID3D12Heap> heap;
+        auto hr = device->CreateHeap(&heapDesc, IID_PPV_ARGS(heap.ReleaseAndGetAddressOf()));
+        DXThrowIfFailed(hr, "failed to create D3D12 tile heap for sparse texture");
+        tileHeaps_.push_back(heap);
+    }
+
+    return numUsedTiles_++;
+}
+
+void D3D12Texture::UpdateTileMappings(
+    ID3D12CommandQueue*                                 commandQueue,
+    const std::vector<D3D12_TILED_RESOURCE_COORDINATE>& coords,
+    const std::vector<UINT>&                            tiles)
+{
+    const auto numTiles = static_cast<UINT>(coords.size());
+
+    D3D12_TILE_REGION_SIZE regionSize;
+    {
+        regionSize.NumTiles = 1;
+        regionSize.UseBox   = FALSE;
+        regionSize.Width    = 0;
+        regionSize.Height   = 0;
+        regionSize.Depth    = 0;
+    }
+    std::vector<D3D12_TILE_REGION_SIZE> regionSizes(numTiles, regionSize);
+    std::vector<UINT>                   rangeTileCounts(numTiles, 1);
+
+    if (tiles.empty())
+    {
+        /* Unmap all tiles with a single command */
+        std::vector<D3D12_TILE_RANGE_FLAGS> rangeFlags(numTiles, D3D12_TILE_RANGE_FLAG_NULL);
+        commandQueue->UpdateTileMappings(
+            resource_.Get(), numTiles, coords.data(), regionSizes.data(), nullptr,
+            numTiles, rangeFlags.data(), nullptr, rangeTileCounts.data(), D3D12_TILE_MAPPING_FLAG_NONE
+        );
+    }
+    else
+    {
+        /* Map tiles with one command per heap, since each command can only refer to a single heap */
+        for (UINT heapIndex = 0; heapIndex < static_cast<UINT>(tileHeaps_.size()); ++heapIndex)
+        {
+            std::vector<D3D12_TILED_RESOURCE_COORDINATE>    heapCoords;
+            std::vector<UINT>                               heapStartOffsets;
+
+            for (UINT i = 0; i < numTiles; ++i)
+            {
+                if (tiles[i] / g_numTilesPerHeap == heapIndex)
+                {
+                    heapCoords.push_back(coords[i]);
+                    heapStartOffsets.push_back(tiles[i] % g_numTilesPerHeap);
+                }
+            }
+
+            if (!heapCoords.empty())
+            {
+                const auto numHeapTiles = static_cast<UINT>(heapCoords.size());
+                std::vector<D3D12_TILE_RANGE_FLAGS> rangeFlags(numHeapTiles, D3D12_TILE_RANGE_FLAG_NONE);
+                commandQueue->UpdateTileMappings(
+                    resource_.Get(), numHeapTiles, heapCoords.data(), regionSizes.data(), tileHeaps_[heapIndex].Get(),
+                    numHeapTiles, rangeFlags.data(), heapStartOffsets.data(), rangeTileCounts.data(), D3D12_TILE_MAPPING_FLAG_NONE
+                );
+            }
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -12,6 +12,12 @@
 #include <LLGL/Texture.h>
 #include <d3d12.h>
 #include "../../DXCommon/ComPtr.h"
+#include "../Buffer/D3D12StagingBufferPool.h"
+#include "../D3D12MemoryAllocator.h"
+#include "../../SparsePageTable.h"
+#include <memory>
+#include <vector>
+#include <map>
 
 
 namespace LLGL
@@ -23,27 +29,36 @@ class D3D12Texture : public Texture
 
     public:
 
-        D3D12Texture(ID3D12Device* device, const TextureDescriptor& desc);
+        D3D12Texture(ID3D12Device* device, D3D12MemoryAllocator& memoryAllocator, const TextureDescriptor& desc);
+
+        // Initializes this texture as view of the specified texture, which shares its hardware resource but not its memory region.
+        D3D12Texture(ID3D12Device* device, const D3D12Texture& sharedTexture, const TextureViewDescriptor& desc);
+
+        // Initializes this texture as reserved (sparse) resource, whose tiles are mapped to tile heaps with "CommitTiles".
+        D3D12Texture(ID3D12Device* device, ID3D12CommandQueue* commandQueue, const TextureDescriptor& desc);
 
         Gs::Vector3ui QueryMipLevelSize(unsigned int mipLevel) const override;
 
         /* ----- Extended internal functions ---- */
 
         void UpdateSubresource(
-            ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
-            ComPtr<ID3D12Resource>& uploadBuffer, D3D12_SUBRESOURCE_DATA& subresourceData
+            ID3D12GraphicsCommandList* commandList, D3D12StagingBufferPool& stagingBufferPool,
+            D3D12_SUBRESOURCE_DATA& subresourceData
         );
 
+        // Maps (or unmaps) the tiles of this reserved texture, which the specified region overlaps with.
+        void CommitTiles(ID3D12Device* device, ID3D12CommandQueue* commandQueue, const TextureRegion& region, bool commit);
+
         //! Returns the ID3D12Resource object.
         inline ID3D12Resource* Get() const
         {
             return resource_.Get();
         }
 
-        // Returns the descriptor heap for shader-resource-views (SRV).
-        inline ID3D12DescriptorHeap* GetDescriptorHeap() const
+        // Returns the CPU descriptor handle of the shader-resource-view (SRV), which is copied into the shader-visible descriptor heap of a command buffer.
+        inline D3D12_CPU_DESCRIPTOR_HANDLE GetCPUDescriptorHandle() const
         {
-            return descHeap_.Get();
+            return descHeap_->GetCPUDescriptorHandleForHeapStart();
         }
 
         // Returns the hardware resource format.
@@ -58,17 +73,55 @@ class D3D12Texture : public Texture
             return numMipLevels_;
         }
 
+        // Returns the memory region this texture has been placed in (no heap if it is a committed resource).
+        inline const D3D12MemoryRegion& GetMemoryRegion() const
+        {
+            return memoryRegion_;
+        }
+
+        // Returns the page table if this is a reserved texture, or null otherwise.
+        inline const SparsePageTable* GetSparsePageTable() const
+        {
+            return sparsePageTable_.get();
+        }
+
+        // Returns the heaps the tiles of this reserved texture are mapped to.
+        inline const std::vector<ComPtr<ID3D12Heap>>& GetTileHeaps() const
+        {
+            return tileHeaps_;
+        }
+
     private:
 
         void CreateResource(
-            ID3D12Device* device, const D3D12_RESOURCE_DESC& desc, const D3D12_SHADER_RESOURCE_VIEW_DESC* srvDesc = nullptr
+            ID3D12Device* device, D3D12MemoryAllocator& memoryAllocator,
+            const D3D12_RESOURCE_DESC& desc, const D3D12_SHADER_RESOURCE_VIEW_DESC* srvDesc = nullptr
+        );
+
+        void CreateSRV(ID3D12Device* device, const D3D12_SHADER_RESOURCE_VIEW_DESC* srvDesc);
+
+        // Returns the index of a free tile, where a new tile heap is created if all tiles are in use.
+        UINT AllocTile(ID3D12Device* device);
+
+        // Maps the specified tiles to the tile indices (grouped by their heaps), or unmaps them if 'tiles' is empty.
+        void UpdateTileMappings(
+            ID3D12CommandQueue*                                 commandQueue,
+            const std::vector<D3D12_TILED_RESOURCE_COORDINATE>& coords,
+            const std::vector<UINT>&                            tiles
         );
 
-        ComPtr<ID3D12Resource>          resource_;
-        ComPtr<ID3D12DescriptorHeap>    descHeap_; // descriptor heap for shader resource views (SRV)
+        ComPtr<ID3D12Resource>              resource_;
+        ComPtr<ID3D12DescriptorHeap>        descHeap_; // non-shader-visible descriptor heap for shader resource views (SRV)
+        D3D12MemoryRegion                   memoryRegion_;
+
+        DXGI_FORMAT                         format_             = DXGI_FORMAT_UNKNOWN;
+        UINT                                numMipLevels_       = 0;
 
-        DXGI_FORMAT                     format_         = DXGI_FORMAT_UNKNOWN;
-        UINT                            numMipLevels_   = 0;
+        std::unique_ptr<SparsePageTable>    sparsePageTable_;
+        std::vector<ComPtr<ID3D12Heap>>     tileHeaps_;
+        UINT                                numUsedTiles_       = 0;
+        std::vector<UINT>                   freeTiles_;
+        std::map<std::uint64_t, UINT>       mappedTiles_;       // Tile indices of the mapped pages, keyed by subresource and tile coordinate
 
 };
 
@@ -0,0 +1,250 @@
+/*
+ * DrawBatcher.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/DrawBatcher.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+/*
+Sort key layout (from most to least significant bits):
+- DrawSortMode::StateFrontToBack:   pass (8) | pipeline (12) | texture (12) | vertex buffer (8) | index buffer (8) | depth (16)
+- DrawSortMode::BackToFront:        pass (8) | inverted depth (24) | pipeline (12) | texture (12) | vertex buffer (8)
+*/
+
+static std::uint64_t QuantizeDepth(float depth, int bits)
+{
+    const auto maxValue = (std::uint64_t(1) << bits) - 1;
+    depth = std::max(0.0f, std::min(depth, 1.0f));
+    return static_cast<std::uint64_t>(depth * static_cast<float>(maxValue));
+}
+
+void DrawBatcher::SetPassSortMode(std::uint8_t pass, const DrawSortMode mode)
+{
+    passSortModes_[pass] = mode;
+}
+
+void DrawBatcher::Submit(const DrawPacket& packet)
+{
+    if (packet.graphicsPipeline)
+    {
+        entries_.push_back({ MakeSortKey(packet), static_cast<std::uint32_t>(packets_.size()) });
+        packets_.push_back(packet);
+    }
+}
+
+void DrawBatcher::Flush(CommandBuffer& commandBuffer)
+{
+    SortEntries();
+
+    /* Keep track of bound resources to only emit state changes */
+    GraphicsPipeline*   boundPipeline       = nullptr;
+    Buffer*             boundVertexBuffer   = nullptr;
+    Buffer*             boundIndexBuffer    = nullptr;
+    const void*         boundTexture        = nullptr;
+    unsigned int        boundTextureSlot    = 0;
+    long                boundTextureStages  = 0;
+    TransientBufferRange boundConstantBuffer;
+    unsigned int        boundConstantSlot   = 0;
+    long                boundConstantStages = 0;
+
+    for (const auto& entry : entries_)
+    {
+        const auto& packet = packets_[entry.index];
+
+        /* Set graphics pipeline */
+        if (boundPipeline != packet.graphicsPipeline)
+        {
+            commandBuffer.SetGraphicsPipeline(*packet.graphicsPipeline);
+            boundPipeline = packet.graphicsPipeline;
+        }
+
+        /* Set vertex and index buffers */
+        if (packet.vertexBuffer && boundVertexBuffer != packet.vertexBuffer)
+        {
+            commandBuffer.SetVertexBuffer(*packet.vertexBuffer);
+            boundVertexBuffer = packet.vertexBuffer;
+        }
+
+        if (packet.indexBuffer && boundIndexBuffer != packet.indexBuffer)
+        {
+            commandBuffer.SetIndexBuffer(*packet.indexBuffer);
+            boundIndexBuffer = packet.indexBuffer;
+        }
+
+        /* Set texture or texture array */
+        const void* texture = (packet.textureArray != nullptr ? static_cast<const void*>(packet.textureArray) : static_cast<const void*>(packet.texture));
+
+        if (texture && (boundTexture != texture || boundTextureSlot != packet.textureSlot || boundTextureStages != packet.shaderStageFlags))
+        {
+            if (packet.textureArray)
+                commandBuffer.SetTextureArray(*packet.textureArray, packet.textureSlot, packet.shaderStageFlags);
+            else
+                commandBuffer.SetTexture(*packet.texture, packet.textureSlot, packet.shaderStageFlags);
+
+            boundTexture        = texture;
+            boundTextureSlot    = packet.textureSlot;
+            boundTextureStages  = packet.shaderStageFlags;
+        }
+
+        /* Set constant buffer range */
+        const auto& cbuffer = packet.constantBuffer;
+
+        if ( cbuffer.buffer != nullptr &&
+             ( boundConstantBuffer.buffer != cbuffer.buffer   ||
+               boundConstantBuffer.offset != cbuffer.offset   ||
+               boundConstantBuffer.size   != cbuffer.size     ||
+               boundConstantSlot          != packet.constantBufferSlot ||
+               boundConstantStages        != packet.shaderStageFlags ) )
+        {
+            commandBuffer.SetConstantBufferRange(*cbuffer.buffer, cbuffer.offset, cbuffer.size, packet.constantBufferSlot, packet.shaderStageFlags);
+            boundConstantBuffer = cbuffer;
+            boundConstantSlot   = packet.constantBufferSlot;
+            boundConstantStages = packet.shaderStageFlags;
+        }
+
+        /* Generate draw command */
+        const bool instanced = (packet.numInstances != 1 || packet.instanceOffset != 0);
+
+        if (packet.indexBuffer)
+        {
+            if (instanced)
+                commandBuffer.DrawIndexedInstanced(packet.numVertices, packet.numInstances, packet.firstVertex, packet.vertexOffset, packet.instanceOffset);
+            else
+                commandBuffer.DrawIndexed(packet.numVertices, packet.firstVertex, packet.vertexOffset);
+        }
+        else
+        {
+            if (instanced)
+                commandBuffer.DrawInstanced(packet.numVertices, packet.firstVertex, packet.numInstances, packet.instanceOffset);
+            else
+                commandBuffer.Draw(packet.numVertices, packet.firstVertex);
+        }
+    }
+
+    /* Remove all draw packets but keep the memory for the next batch */
+    packets_.clear();
+    entries_.clear();
+}
+
+void DrawBatcher::Clear()
+{
+    packets_.clear();
+    entries_.clear();
+    resourceIDs_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint64_t DrawBatcher::MakeSortKey(const DrawPacket& packet)
+{
+    /* Get resource identifiers */
+    const void* texture = (packet.textureArray != nullptr ? static_cast<const void*>(packet.textureArray) : static_cast<const void*>(packet.texture));
+
+    auto pipelineID     = GetResourceID(packet.graphicsPipeline, 0xfff);
+    auto textureID      = GetResourceID(texture, 0xfff);
+    auto vertexBufferID = GetResourceID(packet.vertexBuffer, 0xff);
+    auto indexBufferID  = GetResourceID(packet.indexBuffer, 0xff);
+
+    /* Build sort key by the sorting mode of the pass */
+    auto key = (static_cast<std::uint64_t>(packet.pass) << 56);
+
+    auto it = passSortModes_.find(packet.pass);
+    if (it != passSortModes_.end() && it->second == DrawSortMode::BackToFront)
+    {
+        const auto depthMask = (std::uint64_t(1) << 24) - 1;
+        key |= ((depthMask - QuantizeDepth(packet.depth, 24)) << 32);
+        key |= (pipelineID      << 20);
+        key |= (textureID       <<  8);
+        key |= (vertexBufferID       );
+    }
+    else
+    {
+        key |= (pipelineID      << 44);
+        key |= (textureID       << 32);
+        key |= (vertexBufferID  << 24);
+        key |= (indexBufferID   << 16);
+        key |= QuantizeDepth(packet.depth, 16);
+    }
+
+    return key;
+}
+
+/*
+Returns the identifier of the specified resource. Identifiers are assigned in the order of the first submission
+and wrap around at the specified maximum, which only reduces the quality of the batching but never its correctness,
+since state changes are detected by the actual resource objects.
+*/
+std::uint64_t DrawBatcher::GetResourceID(const void* resource, std::uint64_t maxID)
+{
+    if (!resource)
+        return 0;
+
+    auto it = resourceIDs_.find(resource);
+    if (it == resourceIDs_.end())
+        it = resourceIDs_.insert({ resource, static_cast<std::uint64_t>(resourceIDs_.size() + 1) }).first;
+
+    return (it->second & maxID);
+}
+
+// Sorts all entries by their keys with a stable LSD radix sort (8 bits per pass).
+void DrawBatcher::SortEntries()
+{
+    const auto numEntries = entries_.size();
+    if (numEntries < 2)
+        return;
+
+    entriesTemp_.resize(numEntries);
+
+    auto src = entries_.data();
+    auto dst = entriesTemp_.data();
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        /* Build histogram for the current byte of all keys */
+        std::size_t counts[256] = {};
+
+        for (std::size_t i = 0; i < numEntries; ++i)
+            ++counts[(src[i].key >> shift) & 0xff];
+
+        /* Skip this pass if all keys have the same value for the current byte */
+        if (counts[(src[0].key >> shift) & 0xff] == numEntries)
+            continue;
+
+        /* Convert histogram into offsets */
+        std::size_t offset = 0;
+        for (auto& count : counts)
+        {
+            auto n = count;
+            count = offset;
+            offset += n;
+        }
+
+        /* Scatter entries into destination */
+        for (std::size_t i = 0; i < numEntries; ++i)
+            dst[counts[(src[i].key >> shift) & 0xff]++] = src[i];
+
+        std::swap(src, dst);
+    }
+
+    /* Copy result back if the last pass wrote into the temporary buffer */
+    if (src != entries_.data())
+        std::copy(src, src + numEntries, entries_.data());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,60 @@
+/*
+ * DriverMessageBridge.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DriverMessageBridge.h"
+#include <string>
+
+
+namespace LLGL
+{
+
+
+DriverMessageBridge::DriverMessageBridge(RenderingDebugger* debugger, std::uint32_t messageLimit, const char* apiName) :
+    debugger_     { debugger     },
+    messageLimit_ { messageLimit },
+    apiName_      { apiName      }
+{
+}
+
+void DriverMessageBridge::Post(const DriverMessageCategory category, std::uint32_t id, const char* message)
+{
+    if (debugger_ == nullptr)
+        return;
+
+    /* Drop further occurrences of this message once it has reached the limit */
+    auto& occurrences = occurrences_[id];
+    if (messageLimit_ > 0 && occurrences >= messageLimit_)
+        return;
+    ++occurrences;
+
+    /* Post message with an ID that is unique per API and driver message ID */
+    const auto messageID    = RenderingDebugger::MakeMessageID(apiName_, id);
+    const auto formatText   = [message]() { return std::string(message != nullptr ? message : ""); };
+
+    switch (category)
+    {
+        case DriverMessageCategory::Error:
+            debugger_->PostError(ErrorType::InvalidState, messageID, formatText);
+            break;
+        case DriverMessageCategory::Performance:
+            debugger_->PostWarning(WarningType::PerformanceHint, messageID, formatText);
+            break;
+        case DriverMessageCategory::ImproperUsage:
+            debugger_->PostWarning(WarningType::ImproperState, messageID, formatText);
+            break;
+        case DriverMessageCategory::UndefinedBehavior:
+            debugger_->PostWarning(WarningType::ImproperArgument, messageID, formatText);
+            break;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
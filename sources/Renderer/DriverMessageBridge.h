@@ -0,0 +1,72 @@
+/*
+ * DriverMessageBridge.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DRIVER_MESSAGE_BRIDGE_H
+#define LLGL_DRIVER_MESSAGE_BRIDGE_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/RenderingDebugger.h>
+#include <unordered_map>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Category of a message that is reported by the driver.
+enum class DriverMessageCategory
+{
+    Error,              // Invalid API usage, posted as ErrorType::InvalidState.
+    Performance,        // Slow operation, posted as WarningType::PerformanceHint.
+    ImproperUsage,      // Deprecated, non-portable, or improper usage, posted as WarningType::ImproperState.
+    UndefinedBehavior,  // Undefined behavior, posted as WarningType::ImproperArgument.
+};
+
+/**
+\brief Backend independent bridge that posts the messages of the driver (e.g. from GL_KHR_debug or ID3D11InfoQueue) to a rendering debugger.
+\remarks Each message is identified by the message ID of the driver, and it is only posted for a limited number of occurrences,
+since drivers tend to report the same performance warning for every draw call.
+*/
+class LLGL_EXPORT DriverMessageBridge
+{
+
+    public:
+
+        DriverMessageBridge() = default;
+
+        // Initializes the bridge with the specified debugger (may be null), the limit of occurrences per message (0 for no limit), and the API name that identifies the messages.
+        DriverMessageBridge(RenderingDebugger* debugger, std::uint32_t messageLimit, const char* apiName);
+
+        // Posts the specified driver message to the debugger, unless it has reached the limit of occurrences.
+        void Post(const DriverMessageCategory category, std::uint32_t id, const char* message);
+
+        // Returns true if this bridge has a debugger.
+        inline bool IsEnabled() const
+        {
+            return (debugger_ != nullptr);
+        }
+
+    private:
+
+        RenderingDebugger*                                  debugger_       = nullptr;
+        std::uint32_t                                       messageLimit_   = 0;
+        const char*                                         apiName_        = "";
+        std::unordered_map<std::uint32_t, std::uint32_t>    occurrences_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
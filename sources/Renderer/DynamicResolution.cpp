@@ -0,0 +1,115 @@
+/*
+ * DynamicResolution.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/DynamicResolution.h>
+#include <algorithm>
+#include <cmath>
+
+
+namespace LLGL
+{
+
+
+DynamicResolution::DynamicResolution(const DynamicResolutionDescriptor& desc) :
+    desc_  { desc          },
+    scale_ { desc.maxScale }
+{
+}
+
+bool DynamicResolution::Update(std::uint64_t gpuFrameTime)
+{
+    if (gpuFrameTime == 0 || desc_.targetFrameTime == 0)
+        return false;
+
+    /* Update exponential moving average of the frame time */
+    if (smoothedFrameTime_ == 0.0)
+        smoothedFrameTime_ = static_cast<double>(gpuFrameTime);
+    else
+        smoothedFrameTime_ += (static_cast<double>(gpuFrameTime) - smoothedFrameTime_) * desc_.smoothing;
+
+    /* Keep scale while the frame time is within the tolerance around its target */
+    auto ratio = static_cast<double>(desc_.targetFrameTime) / smoothedFrameTime_;
+    if (std::abs(ratio - 1.0) <= desc_.tolerance)
+        return false;
+
+    /* Scale the number of pixels (i.e. the squared scale) by the ratio, but limit the change per update */
+    auto prevResolution = GetResolution();
+
+    auto scale = static_cast<float>(scale_ * std::sqrt(ratio));
+    scale = std::max(scale_ - desc_.maxScaleStep, std::min(scale, scale_ + desc_.maxScaleStep));
+    scale_ = std::max(desc_.minScale, std::min(scale, desc_.maxScale));
+
+    return (GetResolution() != prevResolution);
+}
+
+bool DynamicResolution::Update(const GPUProfiler& profiler)
+{
+    if (!profiler.HasResolvedFrame())
+        return false;
+
+    /* Ignore frames that have already been used */
+    const auto& frame = profiler.GetResolvedFrame();
+    if (hasProfilerFrame_ && frame.frameIndex <= lastFrameIndex_)
+        return false;
+
+    hasProfilerFrame_   = true;
+    lastFrameIndex_     = frame.frameIndex;
+
+    return Update(frame.elapsedTime);
+}
+
+void DynamicResolution::SetScale(float scale)
+{
+    scale_              = std::max(desc_.minScale, std::min(scale, desc_.maxScale));
+    smoothedFrameTime_  = 0.0;
+}
+
+void DynamicResolution::SetMaxResolution(const Gs::Vector2ui& maxResolution)
+{
+    desc_.maxResolution = maxResolution;
+}
+
+Gs::Vector2ui DynamicResolution::GetResolution() const
+{
+    return
+    {
+        std::max(1u, std::min(desc_.maxResolution.x, static_cast<unsigned int>(static_cast<float>(desc_.maxResolution.x) * scale_ + 0.5f))),
+        std::max(1u, std::min(desc_.maxResolution.y, static_cast<unsigned int>(static_cast<float>(desc_.maxResolution.y) * scale_ + 0.5f)))
+    };
+}
+
+Viewport DynamicResolution::GetViewport() const
+{
+    auto resolution = GetResolution();
+    return Viewport(0.0f, 0.0f, static_cast<float>(resolution.x), static_cast<float>(resolution.y));
+}
+
+Scissor DynamicResolution::GetScissor() const
+{
+    auto resolution = GetResolution();
+    return Scissor(0, 0, static_cast<int>(resolution.x), static_cast<int>(resolution.y));
+}
+
+Gs::Vector2f DynamicResolution::GetUVScale() const
+{
+    if (desc_.maxResolution.x == 0 || desc_.maxResolution.y == 0)
+        return { 1.0f, 1.0f };
+
+    auto resolution = GetResolution();
+    return
+    {
+        static_cast<float>(resolution.x) / static_cast<float>(desc_.maxResolution.x),
+        static_cast<float>(resolution.y) / static_cast<float>(desc_.maxResolution.y)
+    };
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
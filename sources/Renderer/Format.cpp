@@ -21,6 +21,7 @@ LLGL_EXPORT unsigned int DataTypeSize(const DataType dataType)
             return 1;
         case DataType::Int16:
         case DataType::UInt16:
+        case DataType::Float16:
             return 2;
         case DataType::Int32:
         case DataType::UInt32:
@@ -34,6 +35,10 @@ LLGL_EXPORT unsigned int DataTypeSize(const DataType dataType)
 
 LLGL_EXPORT unsigned int VectorTypeSize(const VectorType vectorType)
 {
+    /* Packed vector type stores all components in a single 32-bit word */
+    if (vectorType == VectorType::UInt1010102Norm)
+        return 4;
+
     DataType        dataType    = DataType::Float;
     unsigned int    components  = 0;
     VectorTypeFormat(vectorType, dataType, components);
@@ -54,6 +59,28 @@ LLGL_EXPORT void VectorTypeFormat(const VectorType vectorType, DataType& dataTyp
         dataType    = vecDataTypes[vectorTypeIdx];
         components  = (componentsIdx + 1);
     }
+    else
+    {
+        /* Get integral storage type and components of compact vector type */
+        switch (vectorType)
+        {
+            case VectorType::Half2:             dataType = DataType::UInt16; components = 2; break;
+            case VectorType::Half4:             dataType = DataType::UInt16; components = 4; break;
+            case VectorType::Byte4Norm:         dataType = DataType::Int8;   components = 4; break;
+            case VectorType::UByte4Norm:        dataType = DataType::UInt8;  components = 4; break;
+            case VectorType::Short2Norm:        dataType = DataType::Int16;  components = 2; break;
+            case VectorType::Short4Norm:        dataType = DataType::Int16;  components = 4; break;
+            case VectorType::UShort2Norm:       dataType = DataType::UInt16; components = 2; break;
+            case VectorType::UShort4Norm:       dataType = DataType::UInt16; components = 4; break;
+            case VectorType::UInt1010102Norm:   dataType = DataType::UInt32; components = 4; break;
+            default:                                                                         break;
+        }
+    }
+}
+
+LLGL_EXPORT bool IsCompactVectorType(const VectorType vectorType)
+{
+    return (vectorType >= VectorType::Half2 && vectorType <= VectorType::UInt1010102Norm);
 }
 
 
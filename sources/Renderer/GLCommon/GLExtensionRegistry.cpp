@@ -6,7 +6,7 @@
  */
 
 #include "GLExtensionRegistry.h"
-#include <array>
+#include <bitset>
 
 
 namespace LLGL
@@ -31,11 +31,11 @@ bool HasExtension(const GLExt extension)
 
 #else
 
-static std::array<bool, static_cast<std::size_t>(GLExt::Count)> g_registeredExtensions { { false } };
+static std::bitset<static_cast<std::size_t>(GLExt::Count)> g_registeredExtensions;
 
 void RegisterExtension(GLExt extension)
 {
-    g_registeredExtensions[static_cast<std::size_t>(extension)] = true;
+    g_registeredExtensions.set(static_cast<std::size_t>(extension));
 }
 
 bool HasExtension(const GLExt extension)
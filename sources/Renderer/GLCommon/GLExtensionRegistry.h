@@ -34,17 +34,38 @@ enum class GLExt
     ARB_vertex_buffer_object,
     ARB_instanced_arrays,
     ARB_vertex_array_object,
+    ARB_vertex_attrib_binding,
     ARB_framebuffer_object,
+    ARB_invalidate_subdata,
     ARB_draw_instanced,
     ARB_draw_elements_base_vertex,
+    EXT_multi_draw_arrays,
     ARB_base_instance,
+    ARB_draw_indirect,
+    ARB_multi_draw_indirect,
     ARB_shader_objects,
     ARB_tessellation_shader,
     ARB_compute_shader,
+    ARB_shader_image_load_store,
     ARB_get_program_binary,
+    ARB_shader_subroutine,
+    ARB_separate_shader_objects,
+    ARB_parallel_shader_compile,
+    ARB_gl_spirv,
     ARB_program_interface_query,
     ARB_uniform_buffer_object,
     ARB_shader_storage_buffer_object,
+    ARB_map_buffer_range,
+    ARB_buffer_storage,
+    ARB_sync,
+    ARB_copy_buffer,
+    ARB_copy_image,
+    ARB_texture_storage,
+    ARB_texture_storage_multisample,
+    ARB_texture_view,
+    ARB_internalformat_query,
+    ARB_sparse_texture,
+    ARB_direct_state_access,
     ARB_occlusion_query,
     NV_conditional_render,
     ARB_timer_query,
@@ -54,7 +75,13 @@ enum class GLExt
     ARB_clip_control,
     EXT_transform_feedback,
     NV_transform_feedback,
+    ARB_transform_feedback2,
     EXT_gpu_shader4,
+    ARB_bindless_texture,
+    NV_shading_rate_image,
+    OVR_multiview,
+    NV_mesh_shader,
+    EXT_depth_bounds_test,
 
     /* Extensions without procedures */
     ARB_texture_cube_map,
@@ -63,6 +90,17 @@ enum class GLExt
     ARB_geometry_shader4,
     NV_conservative_raster,
     INTEL_conservative_rasterization,
+    ARB_query_buffer_object,
+    ARB_pipeline_statistics_query,
+    ARB_transform_feedback3,
+    ARB_shader_atomic_counters,
+    NVX_gpu_memory_info,
+    ATI_meminfo,
+    OVR_multiview2,
+    ARB_shader_viewport_layer_array,
+    AMD_vertex_shader_layer,
+    KHR_shader_subgroup,
+    NV_shader_thread_group,
 
     /* Enumeration entry counter */
     Count,
@@ -39,9 +39,11 @@ GLenum Map(const BufferCPUAccess cpuAccess)
     #ifdef LLGL_OPENGL
     switch (cpuAccess)
     {
-        case BufferCPUAccess::ReadOnly:     return GL_READ_ONLY;
-        case BufferCPUAccess::WriteOnly:    return GL_WRITE_ONLY;
-        case BufferCPUAccess::ReadWrite:    return GL_READ_WRITE;
+        case BufferCPUAccess::ReadOnly:         return GL_READ_ONLY;
+        case BufferCPUAccess::WriteOnly:        return GL_WRITE_ONLY;
+        case BufferCPUAccess::ReadWrite:        return GL_READ_WRITE;
+        case BufferCPUAccess::WriteDiscard:     return GL_WRITE_ONLY;
+        case BufferCPUAccess::WriteNoOverwrite: return GL_WRITE_ONLY;
     }
     #endif
     MapFailed("BufferCPUAccess");
@@ -58,6 +60,7 @@ GLenum Map(const DataType dataType)
         case DataType::Int32:   return GL_INT;
         case DataType::UInt32:  return GL_UNSIGNED_INT;
         case DataType::Float:   return GL_FLOAT;
+        case DataType::Float16: return GL_HALF_FLOAT;
         #ifdef LLGL_OPENGL
         case DataType::Double:  return GL_DOUBLE;
         #else
@@ -67,6 +70,30 @@ GLenum Map(const DataType dataType)
     MapFailed("DataType");
 }
 
+GLenum Map(const VectorType vectorType)
+{
+    switch (vectorType)
+    {
+        case VectorType::Half2:
+        case VectorType::Half4:             return GL_HALF_FLOAT;
+        case VectorType::Byte4Norm:         return GL_BYTE;
+        case VectorType::UByte4Norm:        return GL_UNSIGNED_BYTE;
+        case VectorType::Short2Norm:
+        case VectorType::Short4Norm:        return GL_SHORT;
+        case VectorType::UShort2Norm:
+        case VectorType::UShort4Norm:       return GL_UNSIGNED_SHORT;
+        case VectorType::UInt1010102Norm:   return GL_UNSIGNED_INT_2_10_10_10_REV;
+        default:                            break;
+    }
+
+    /* Map component type of non-compact vector types */
+    DataType        dataType    = DataType::Float;
+    unsigned int    components  = 0;
+    VectorTypeFormat(vectorType, dataType, components);
+
+    return Map(dataType);
+}
+
 GLenum Map(const PrimitiveType primitiveType)
 {
     switch (primitiveType)
@@ -152,6 +179,7 @@ GLenum Map(const TextureFormat textureFormat)
         /* --- Sized internal formats --- */
         case TextureFormat::R8:             return GL_R8;
         case TextureFormat::R8Sgn:          return GL_R8_SNORM;
+        case TextureFormat::R8UInt:         return GL_R8UI;
 
         #ifdef LLGL_OPENGL
         case TextureFormat::R16:            return GL_R16;
@@ -208,6 +236,16 @@ GLenum Map(const TextureFormat textureFormat)
         case TextureFormat::RGBA_DXT1:      return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
         case TextureFormat::RGBA_DXT3:      return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
         case TextureFormat::RGBA_DXT5:      return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::R_BC4:          return GL_COMPRESSED_RED_RGTC1;
+        case TextureFormat::RG_BC5:         return GL_COMPRESSED_RG_RGTC2;
+        case TextureFormat::RGB_BC6H:       return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+        case TextureFormat::RGBA_BC7:       return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        #endif
+        case TextureFormat::RGB_ETC2:       return GL_COMPRESSED_RGB8_ETC2;
+        case TextureFormat::RGBA_ETC2:      return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        #ifdef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+        case TextureFormat::RGBA_ASTC4x4:   return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        case TextureFormat::RGBA_ASTC8x8:   return GL_COMPRESSED_RGBA_ASTC_8x8_KHR;
         #endif
         
         default:                            break;
@@ -416,6 +454,10 @@ GLenum Map(const ShaderType shaderType)
         #if defined(GL_VERSION_4_3) || defined(GL_ES_VERSION_3_1)
         case ShaderType::Compute:           return GL_COMPUTE_SHADER;
         #endif
+        #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_mesh_shader
+        case ShaderType::Amplification:     return GL_TASK_SHADER_NV;
+        case ShaderType::Mesh:              return GL_MESH_SHADER_NV;
+        #endif
         default:                            break;
     }
     MapFailed("ShaderType");
@@ -435,6 +477,7 @@ GLenum Map(const QueryType queryType)
         #ifdef LLGL_OPENGL
         case QueryType::PrimitivesGenerated:                return GL_PRIMITIVES_GENERATED;
         case QueryType::TimeElapsed:                        return GL_TIME_ELAPSED;
+        case QueryType::Timestamp:                          return GL_TIMESTAMP;
         #endif
         case QueryType::StreamOutPrimitivesWritten:         return GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN;
 
@@ -564,6 +607,22 @@ static UniformType UnmapUniformType(const GLenum uniformType)
             return UniformType::Int3;
         case GL_INT_VEC4:
             return UniformType::Int4;
+        case GL_UNSIGNED_INT:
+            return UniformType::UInt;
+        case GL_UNSIGNED_INT_VEC2:
+            return UniformType::UInt2;
+        case GL_UNSIGNED_INT_VEC3:
+            return UniformType::UInt3;
+        case GL_UNSIGNED_INT_VEC4:
+            return UniformType::UInt4;
+        case GL_BOOL:
+            return UniformType::Boolean;
+        case GL_BOOL_VEC2:
+            return UniformType::Boolean2;
+        case GL_BOOL_VEC3:
+            return UniformType::Boolean3;
+        case GL_BOOL_VEC4:
+            return UniformType::Boolean4;
         case GL_FLOAT_MAT2:
             return UniformType::Float2x2;
         case GL_FLOAT_MAT3:
@@ -671,14 +730,22 @@ static UniformType UnmapUniformType(const GLenum uniformType)
             return UniformType::Int3;
         case GL_INT_VEC4:
             return UniformType::Int4;
-        /*case GL_UNSIGNED_INT:
+        case GL_UNSIGNED_INT:
+            return UniformType::UInt;
         case GL_UNSIGNED_INT_VEC2:
+            return UniformType::UInt2;
         case GL_UNSIGNED_INT_VEC3:
-        case GL_UNSIGNED_INT_VEC4:*/
-        /*case GL_BOOL:
+            return UniformType::UInt3;
+        case GL_UNSIGNED_INT_VEC4:
+            return UniformType::UInt4;
+        case GL_BOOL:
+            return UniformType::Boolean;
         case GL_BOOL_VEC2:
+            return UniformType::Boolean2;
         case GL_BOOL_VEC3:
-        case GL_BOOL_VEC4:*/
+            return UniformType::Boolean3;
+        case GL_BOOL_VEC4:
+            return UniformType::Boolean4;
         case GL_FLOAT_MAT2:
             return UniformType::Float2x2;
         case GL_FLOAT_MAT3:
@@ -730,6 +797,7 @@ static TextureFormat UnmapTextureFormat(const GLenum internalFormat)
         /* --- Sized internal formats --- */
         case GL_R8:                             return TextureFormat::R8;
         case GL_R8_SNORM:                       return TextureFormat::R8Sgn;
+        case GL_R8UI:                           return TextureFormat::R8UInt;
 
         #ifdef LLGL_OPENGL
         case GL_R16:                            return TextureFormat::R16;
@@ -786,6 +854,16 @@ static TextureFormat UnmapTextureFormat(const GLenum internalFormat)
         case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:  return TextureFormat::RGBA_DXT1;
         case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:  return TextureFormat::RGBA_DXT3;
         case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:  return TextureFormat::RGBA_DXT5;
+        case GL_COMPRESSED_RED_RGTC1:           return TextureFormat::R_BC4;
+        case GL_COMPRESSED_RG_RGTC2:            return TextureFormat::RG_BC5;
+        case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT: return TextureFormat::RGB_BC6H;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:     return TextureFormat::RGBA_BC7;
+        #endif
+        case GL_COMPRESSED_RGB8_ETC2:           return TextureFormat::RGB_ETC2;
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:      return TextureFormat::RGBA_ETC2;
+        #ifdef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+        case GL_COMPRESSED_RGBA_ASTC_4x4_KHR:   return TextureFormat::RGBA_ASTC4x4;
+        case GL_COMPRESSED_RGBA_ASTC_8x8_KHR:   return TextureFormat::RGBA_ASTC8x8;
         #endif
         
         default:                                break;
@@ -31,6 +31,7 @@ namespace GLTypes
 
 GLenum Map( const BufferCPUAccess       cpuAccess           );
 GLenum Map( const DataType              dataType            );
+GLenum Map( const VectorType            vectorType          ); // Component type of vertex attributes, e.g. GL_FLOAT, GL_HALF_FLOAT
 GLenum Map( const PrimitiveType         primitiveType       );
 GLenum Map( const PrimitiveTopology     primitiveTopology   );
 GLenum Map( const TextureType           textureType         );
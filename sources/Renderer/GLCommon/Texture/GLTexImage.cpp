@@ -9,6 +9,7 @@
 #include "../GLTypes.h"
 #include "../GLImport.h"
 #include "../GLImportExt.h"
+#include "../../../Core/Exception.h"
 #include <array>
 
 
@@ -16,27 +17,19 @@ namespace LLGL
 {
 
 
-static ImageInitialization g_imageInitialization;
-
-void GLTexImageInitialization(const ImageInitialization& imageInitialization)
-{
-    g_imageInitialization = imageInitialization;
-}
-
-static std::vector<ColorRGBAub> GenImageDataRGBAub(int numPixels, const ColorRGBAub& color)
-{
-    return std::vector<ColorRGBAub>(static_cast<std::size_t>(numPixels), color);
-}
-
-static std::vector<float> GenImageDataRf(int numPixels, float value)
+// Reports the illegal use of a depth-stencil format; the caller must not upload any image data after this call.
+static void ErrIllegalUseOfDepthFormat()
 {
-    return std::vector<float>(static_cast<std::size_t>(numPixels), value);
+    ReportRuntimeError("illegal use of depth-stencil format for texture");
 }
 
-[[noreturn]]
-void ErrIllegalUseOfDepthFormat()
+// Returns the specified size of compressed image data, or computes it from the block size of the compressed format if it is unspecified.
+static GLsizei GLGetCompressedImageSize(
+    const TextureFormat internalFormat, unsigned int width, unsigned int height, unsigned int depth, unsigned int compressedSize)
 {
-    throw std::runtime_error("illegal use of depth-stencil format for texture");
+    if (compressedSize == 0)
+        compressedSize = CompressedImageSize(internalFormat, width, height, depth);
+    return static_cast<GLsizei>(compressedSize);
 }
 
 #ifdef LLGL_OPENGL
@@ -50,7 +43,7 @@ static void GLTexImage1DBase(
         glCompressedTexImage1D(
             target, 0, GLTypes::Map(internalFormat),
             static_cast<GLsizei>(width),
-            0, static_cast<GLsizei>(compressedSize), data
+            0, GLGetCompressedImageSize(internalFormat, width, 1, 1, compressedSize), data
         );
     }
     else
@@ -75,7 +68,7 @@ static void GLTexImage2DBase(
             target, 0, GLTypes::Map(internalFormat),
             static_cast<GLsizei>(width),
             static_cast<GLsizei>(height),
-            0, static_cast<GLsizei>(compressedSize), data
+            0, GLGetCompressedImageSize(internalFormat, width, height, 1, compressedSize), data
         );
     }
     else
@@ -100,7 +93,7 @@ static void GLTexImage3DBase(
             static_cast<GLsizei>(width),
             static_cast<GLsizei>(height),
             static_cast<GLsizei>(depth),
-            0, static_cast<GLsizei>(compressedSize), data
+            0, GLGetCompressedImageSize(internalFormat, width, height, depth, compressedSize), data
         );
     }
     else
@@ -226,10 +219,10 @@ void GLTexImage1D(const TextureDescriptor& desc, const ImageDescriptor* imageDes
     }
     else if (IsDepthStencilFormat(desc.format))
     {
-        /* Throw runtime error for illegal use of depth-stencil format */
+        /* Report error for illegal use of depth-stencil format */
         ErrIllegalUseOfDepthFormat();
     }
-    else if (IsCompressedFormat(desc.format) || !g_imageInitialization.enabled)
+    else
     {
         /* Allocate texture without initial data */
         GLTexImage1D(
@@ -238,20 +231,6 @@ void GLTexImage1D(const TextureDescriptor& desc, const ImageDescriptor* imageDes
             GL_RGBA, GL_UNSIGNED_BYTE, nullptr
         );
     }
-    else
-    {
-        /* Initialize texture image with default color */
-        auto image = GenImageDataRGBAub(
-            desc.texture1D.width,
-            g_imageInitialization.color
-        );
-
-        GLTexImage1D(
-            desc.format,
-            desc.texture1D.width,
-            GL_RGBA, GL_UNSIGNED_BYTE, image.data()
-        );
-    }
 }
 
 #endif
@@ -269,51 +248,20 @@ void GLTexImage2D(const TextureDescriptor& desc, const ImageDescriptor* imageDes
     }
     else if (IsDepthStencilFormat(desc.format))
     {
-        if (g_imageInitialization.enabled)
-        {
-            /* Initialize depth texture image with default depth */
-            auto image = GenImageDataRf(
-                desc.texture2D.width * desc.texture2D.height,
-                g_imageInitialization.depth
-            );
-
-            GLTexImage2D(
-                desc.format,
-                desc.texture2D.width, desc.texture2D.height,
-                GL_DEPTH_COMPONENT, GL_FLOAT, image.data()
-            );
-        }
-        else
-        {
-            /* Allocate depth texture image without initial data */
-            GLTexImage2D(
-                desc.format,
-                desc.texture2D.width, desc.texture2D.height,
-                GL_DEPTH_COMPONENT, GL_FLOAT, nullptr
-            );
-        }
-    }
-    else if (IsCompressedFormat(desc.format) || !g_imageInitialization.enabled)
-    {
-        /* Allocate texture without initial data */
+        /* Allocate depth texture image without initial data */
         GLTexImage2D(
             desc.format,
             desc.texture2D.width, desc.texture2D.height,
-            GL_RGBA, GL_UNSIGNED_BYTE, nullptr
+            GL_DEPTH_COMPONENT, GL_FLOAT, nullptr
         );
     }
     else
     {
-        /* Initialize texture image with default color */
-        auto image = GenImageDataRGBAub(
-            desc.texture2D.width * desc.texture2D.height,
-            g_imageInitialization.color
-        );
-
+        /* Allocate texture without initial data */
         GLTexImage2D(
             desc.format,
             desc.texture2D.width, desc.texture2D.height,
-            GL_RGBA, GL_UNSIGNED_BYTE, image.data()
+            GL_RGBA, GL_UNSIGNED_BYTE, nullptr
         );
     }
 }
@@ -331,10 +279,10 @@ void GLTexImage3D(const TextureDescriptor& desc, const ImageDescriptor* imageDes
     }
     else if (IsDepthStencilFormat(desc.format))
     {
-        /* Throw runtime error for illegal use of depth-stencil format */
+        /* Report error for illegal use of depth-stencil format */
         ErrIllegalUseOfDepthFormat();
     }
-    else if (IsCompressedFormat(desc.format) || !g_imageInitialization.enabled)
+    else
     {
         /* Allocate texture without initial data */
         GLTexImage3D(
@@ -343,20 +291,6 @@ void GLTexImage3D(const TextureDescriptor& desc, const ImageDescriptor* imageDes
             GL_RGBA, GL_UNSIGNED_BYTE, nullptr
         );
     }
-    else
-    {
-        /* Initialize texture image with default color */
-        auto image = GenImageDataRGBAub(
-            desc.texture3D.width * desc.texture3D.height * desc.texture3D.depth,
-            g_imageInitialization.color
-        );
-
-        GLTexImage3D(
-            desc.format,
-            desc.texture3D.width, desc.texture3D.height, desc.texture3D.depth,
-            GL_RGBA, GL_UNSIGNED_BYTE, image.data()
-        );
-    }
 }
 
 void GLTexImageCube(const TextureDescriptor& desc, const ImageDescriptor* imageDesc)
@@ -395,10 +329,10 @@ void GLTexImageCube(const TextureDescriptor& desc, const ImageDescriptor* imageD
     }
     else if (IsDepthStencilFormat(desc.format))
     {
-        /* Throw runtime error for illegal use of depth-stencil format */
+        /* Report error for illegal use of depth-stencil format */
         ErrIllegalUseOfDepthFormat();
     }
-    else if (IsCompressedFormat(desc.format) || !g_imageInitialization.enabled)
+    else
     {
         /* Allocate texture without initial data */
         for (auto face : cubeFaces)
@@ -410,23 +344,6 @@ void GLTexImageCube(const TextureDescriptor& desc, const ImageDescriptor* imageD
             );
         }
     }
-    else
-    {
-        /* Initialize texture image cube-faces with default color */
-        auto image = GenImageDataRGBAub(
-            desc.textureCube.width * desc.textureCube.height,
-            g_imageInitialization.color
-        );
-
-        for (auto face : cubeFaces)
-        {
-            GLTexImageCube(
-                desc.format,
-                desc.textureCube.width, desc.textureCube.height, face,
-                GL_RGBA, GL_UNSIGNED_BYTE, image.data()
-            );
-        }
-    }
 }
 
 #ifdef LLGL_OPENGL
@@ -444,10 +361,10 @@ void GLTexImage1DArray(const TextureDescriptor& desc, const ImageDescriptor* ima
     }
     else if (IsDepthStencilFormat(desc.format))
     {
-        /* Throw runtime error for illegal use of depth-stencil format */
+        /* Report error for illegal use of depth-stencil format */
         ErrIllegalUseOfDepthFormat();
     }
-    else if (IsCompressedFormat(desc.format) || !g_imageInitialization.enabled)
+    else
     {
         /* Allocate texture without initial data */
         GLTexImage1DArray(
@@ -456,20 +373,6 @@ void GLTexImage1DArray(const TextureDescriptor& desc, const ImageDescriptor* ima
             GL_RGBA, GL_UNSIGNED_BYTE, nullptr
         );
     }
-    else
-    {
-        /* Initialize texture image with default color */
-        auto image = GenImageDataRGBAub(
-            desc.texture1D.width * static_cast<int>(desc.texture1D.layers),
-            g_imageInitialization.color
-        );
-
-        GLTexImage1DArray(
-            desc.format,
-            desc.texture1D.width, desc.texture1D.layers,
-            GL_RGBA, GL_UNSIGNED_BYTE, image.data()
-        );
-    }
 }
 
 #endif
@@ -487,51 +390,20 @@ void GLTexImage2DArray(const TextureDescriptor& desc, const ImageDescriptor* ima
     }
     else if (IsDepthStencilFormat(desc.format))
     {
-        if (g_imageInitialization.enabled)
-        {
-            /* Initialize depth texture image with default depth */
-            auto image = GenImageDataRf(
-                desc.texture2D.width * desc.texture2D.height * static_cast<int>(desc.texture2D.layers),
-                g_imageInitialization.depth
-            );
-
-            GLTexImage2DArray(
-                desc.format,
-                desc.texture2D.width, desc.texture2D.height, desc.texture2D.layers,
-                GL_DEPTH_COMPONENT, GL_FLOAT, image.data()
-            );
-        }
-        else
-        {
-            /* Allocate depth texture image without initial data */
-            GLTexImage2DArray(
-                desc.format,
-                desc.texture2D.width, desc.texture2D.height, desc.texture2D.layers,
-                GL_DEPTH_COMPONENT, GL_FLOAT, nullptr
-            );
-        }
-    }
-    else if (IsCompressedFormat(desc.format) || !g_imageInitialization.enabled)
-    {
-        /* Allocate texture without initial data */
+        /* Allocate depth texture image without initial data */
         GLTexImage2DArray(
             desc.format,
             desc.texture2D.width, desc.texture2D.height, desc.texture2D.layers,
-            GL_RGBA, GL_UNSIGNED_BYTE, nullptr
+            GL_DEPTH_COMPONENT, GL_FLOAT, nullptr
         );
     }
     else
     {
-        /* Initialize texture image with default color */
-        auto image = GenImageDataRGBAub(
-            desc.texture2D.width * desc.texture2D.height * static_cast<int>(desc.texture2D.layers),
-            g_imageInitialization.color
-        );
-
+        /* Allocate texture without initial data */
         GLTexImage2DArray(
             desc.format,
             desc.texture2D.width, desc.texture2D.height, desc.texture2D.layers,
-            GL_RGBA, GL_UNSIGNED_BYTE, image.data()
+            GL_RGBA, GL_UNSIGNED_BYTE, nullptr
         );
     }
 }
@@ -551,10 +423,10 @@ void GLTexImageCubeArray(const TextureDescriptor& desc, const ImageDescriptor* i
     }
     else if (IsDepthStencilFormat(desc.format))
     {
-        /* Throw runtime error for illegal use of depth-stencil format */
+        /* Report error for illegal use of depth-stencil format */
         ErrIllegalUseOfDepthFormat();
     }
-    else if (IsCompressedFormat(desc.format) || !g_imageInitialization.enabled)
+    else
     {
         /* Allocate texture without initial data */
         GLTexImageCubeArray(
@@ -563,20 +435,6 @@ void GLTexImageCubeArray(const TextureDescriptor& desc, const ImageDescriptor* i
             GL_RGBA, GL_UNSIGNED_BYTE, nullptr
         );
     }
-    else
-    {
-        /* Initialize texture image cube-faces with default color */
-        auto image = GenImageDataRGBAub(
-            desc.textureCube.width * desc.textureCube.height * static_cast<int>(desc.textureCube.layers*6),
-            g_imageInitialization.color
-        );
-
-        GLTexImageCubeArray(
-            desc.format,
-            desc.textureCube.width, desc.textureCube.height, desc.textureCube.layers,
-            GL_RGBA, GL_UNSIGNED_BYTE, image.data()
-        );
-    }
 }
 
 void GLTexImage2DMS(const TextureDescriptor& desc)
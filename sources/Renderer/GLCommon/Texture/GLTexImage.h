@@ -11,15 +11,12 @@
 
 #include <LLGL/Image.h>
 #include <LLGL/TextureFlags.h>
-#include <LLGL/RenderSystemFlags.h>
 
 
 namespace LLGL
 {
 
 
-void GLTexImageInitialization(const ImageInitialization& imageInitialization);
-
 #ifdef LLGL_OPENGL
 
 void GLTexImage1D(const TextureDescriptor& desc, const ImageDescriptor* imageDesc);
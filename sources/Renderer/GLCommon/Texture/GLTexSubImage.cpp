@@ -16,6 +16,34 @@ namespace LLGL
 {
 
 
+/*
+Returns the internal format of the currently bound texture for the specified target,
+since compressed image data must be uploaded with the exact compressed format of the texture.
+*/
+static GLenum GLGetCompressedInternalFormat(GLenum target, const ImageDescriptor& imageDesc)
+{
+    #ifdef LLGL_OPENGL
+    GLint internalFormat = 0;
+    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+    return static_cast<GLenum>(internalFormat);
+    #else
+    return GLTypes::Map(imageDesc.format);
+    #endif
+}
+
+// Returns the size of the compressed image data, or computes it from the block size of the compressed format if it is unspecified.
+static GLsizei GLGetCompressedImageSize(
+    GLenum internalFormat, unsigned int width, unsigned int height, unsigned int depth, const ImageDescriptor& imageDesc)
+{
+    if (imageDesc.compressedSize == 0)
+    {
+        TextureFormat format = TextureFormat::Unknown;
+        GLTypes::Unmap(format, internalFormat);
+        return static_cast<GLsizei>(CompressedImageSize(format, width, height, depth));
+    }
+    return static_cast<GLsizei>(imageDesc.compressedSize);
+}
+
 #ifdef LLGL_OPENGL
 
 static void GLTexSubImage1DBase(
@@ -23,13 +51,14 @@ static void GLTexSubImage1DBase(
 {
     if (IsCompressedFormat(imageDesc.format))
     {
+        auto internalFormat = GLGetCompressedInternalFormat(target, imageDesc);
         glCompressedTexSubImage1D(
             target,
             static_cast<GLint>(mipLevel),
             static_cast<GLint>(x),
             static_cast<GLsizei>(width),
-            GLTypes::Map(imageDesc.format),
-            static_cast<GLsizei>(imageDesc.compressedSize),
+            internalFormat,
+            GLGetCompressedImageSize(internalFormat, width, 1, 1, imageDesc),
             imageDesc.buffer
         );
     }
@@ -55,6 +84,7 @@ static void GLTexSubImage2DBase(
 {
     if (IsCompressedFormat(imageDesc.format))
     {
+        auto internalFormat = GLGetCompressedInternalFormat(target, imageDesc);
         glCompressedTexSubImage2D(
             target,
             static_cast<GLint>(mipLevel),
@@ -62,8 +92,9 @@ static void GLTexSubImage2DBase(
             static_cast<GLint>(y),
             static_cast<GLsizei>(width),
             static_cast<GLsizei>(height),
-            GLTypes::Map(imageDesc.format),
-            static_cast<GLsizei>(imageDesc.compressedSize), imageDesc.buffer
+            internalFormat,
+            GLGetCompressedImageSize(internalFormat, width, height, 1, imageDesc),
+            imageDesc.buffer
         );
     }
     else
@@ -88,6 +119,7 @@ static void GLTexSubImage3DBase(
 {
     if (IsCompressedFormat(imageDesc.format))
     {
+        auto internalFormat = GLGetCompressedInternalFormat(target, imageDesc);
         glCompressedTexSubImage3D(
             target,
             static_cast<GLint>(mipLevel),
@@ -97,8 +129,8 @@ static void GLTexSubImage3DBase(
             static_cast<GLsizei>(width),
             static_cast<GLsizei>(height),
             static_cast<GLsizei>(depth),
-            GLTypes::Map(imageDesc.format),
-            static_cast<GLsizei>(imageDesc.compressedSize),
+            internalFormat,
+            GLGetCompressedImageSize(internalFormat, width, height, depth, imageDesc),
             imageDesc.buffer
         );
     }
@@ -242,6 +274,229 @@ void GLTexSubImageCubeArray(const SubTextureDescriptor& desc, const ImageDescrip
 
 #endif
 
+static void GLTexSubImageCubeFaces(const TextureRegion& region, const ImageDescriptor& imageDesc)
+{
+    const auto& offset = region.offset;
+    const auto& extent = region.extent;
+
+    auto faceDesc = imageDesc;
+    faceDesc.compressedSize = 0;
+
+    for (unsigned int i = 0; i < extent.z; ++i)
+    {
+        auto target = static_cast<GLenum>(GL_TEXTURE_CUBE_MAP_POSITIVE_X + offset.z + i);
+        GLTexSubImage2DBase(target, region.mipLevel, offset.x, offset.y, extent.x, extent.y, faceDesc);
+
+        /* Move to image data of the next cube face */
+        std::size_t faceSize = 0;
+
+        if (IsCompressedFormat(faceDesc.format))
+            faceSize = GLGetCompressedImageSize(GLGetCompressedInternalFormat(target, faceDesc), extent.x, extent.y, 1, faceDesc);
+        else
+            faceSize = extent.x * extent.y * faceDesc.GetElementSize();
+
+        faceDesc.buffer = (reinterpret_cast<const char*>(faceDesc.buffer) + faceSize);
+    }
+}
+
+#if defined(LLGL_OPENGL) && defined(GL_ARB_direct_state_access)
+
+// Returns the internal format of the specified texture, which is required to upload compressed image data.
+static GLenum GLGetTextureCompressedInternalFormat(GLuint texture)
+{
+    GLint internalFormat = 0;
+    glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+    return static_cast<GLenum>(internalFormat);
+}
+
+static void GLTextureSubImage1DBase(
+    GLuint texture, unsigned int mipLevel, unsigned int x, unsigned int width, const ImageDescriptor& imageDesc)
+{
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        auto internalFormat = GLGetTextureCompressedInternalFormat(texture);
+        glCompressedTextureSubImage1D(
+            texture,
+            static_cast<GLint>(mipLevel),
+            static_cast<GLint>(x),
+            static_cast<GLsizei>(width),
+            internalFormat,
+            GLGetCompressedImageSize(internalFormat, width, 1, 1, imageDesc),
+            imageDesc.buffer
+        );
+    }
+    else
+    {
+        glTextureSubImage1D(
+            texture,
+            static_cast<GLint>(mipLevel),
+            static_cast<GLint>(x),
+            static_cast<GLsizei>(width),
+            GLTypes::Map(imageDesc.format),
+            GLTypes::Map(imageDesc.dataType),
+            imageDesc.buffer
+        );
+    }
+}
+
+static void GLTextureSubImage2DBase(
+    GLuint texture, unsigned int mipLevel, unsigned int x, unsigned int y,
+    unsigned int width, unsigned int height, const ImageDescriptor& imageDesc)
+{
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        auto internalFormat = GLGetTextureCompressedInternalFormat(texture);
+        glCompressedTextureSubImage2D(
+            texture,
+            static_cast<GLint>(mipLevel),
+            static_cast<GLint>(x),
+            static_cast<GLint>(y),
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            internalFormat,
+            GLGetCompressedImageSize(internalFormat, width, height, 1, imageDesc),
+            imageDesc.buffer
+        );
+    }
+    else
+    {
+        glTextureSubImage2D(
+            texture,
+            static_cast<GLint>(mipLevel),
+            static_cast<GLint>(x),
+            static_cast<GLint>(y),
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            GLTypes::Map(imageDesc.format),
+            GLTypes::Map(imageDesc.dataType),
+            imageDesc.buffer
+        );
+    }
+}
+
+static void GLTextureSubImage3DBase(
+    GLuint texture, unsigned int mipLevel, unsigned int x, unsigned int y, unsigned int z,
+    unsigned int width, unsigned int height, unsigned int depth, const ImageDescriptor& imageDesc)
+{
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        auto internalFormat = GLGetTextureCompressedInternalFormat(texture);
+        glCompressedTextureSubImage3D(
+            texture,
+            static_cast<GLint>(mipLevel),
+            static_cast<GLint>(x),
+            static_cast<GLint>(y),
+            static_cast<GLint>(z),
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            static_cast<GLsizei>(depth),
+            internalFormat,
+            GLGetCompressedImageSize(internalFormat, width, height, depth, imageDesc),
+            imageDesc.buffer
+        );
+    }
+    else
+    {
+        glTextureSubImage3D(
+            texture,
+            static_cast<GLint>(mipLevel),
+            static_cast<GLint>(x),
+            static_cast<GLint>(y),
+            static_cast<GLint>(z),
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            static_cast<GLsizei>(depth),
+            GLTypes::Map(imageDesc.format),
+            GLTypes::Map(imageDesc.dataType),
+            imageDesc.buffer
+        );
+    }
+}
+
+#endif
+
+#ifdef LLGL_OPENGL
+
+void GLTextureSubImage(unsigned int texture, const TextureType type, const TextureRegion& region, const ImageDescriptor& imageDesc)
+{
+    #ifdef GL_ARB_direct_state_access
+
+    const auto& offset = region.offset;
+    const auto& extent = region.extent;
+
+    switch (type)
+    {
+        case TextureType::Texture1D:
+            GLTextureSubImage1DBase(texture, region.mipLevel, offset.x, extent.x, imageDesc);
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture1DArray:
+            GLTextureSubImage2DBase(texture, region.mipLevel, offset.x, offset.y, extent.x, extent.y, imageDesc);
+            break;
+
+        case TextureType::Texture3D:
+        case TextureType::TextureCube:
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCubeArray:
+            GLTextureSubImage3DBase(texture, region.mipLevel, offset.x, offset.y, offset.z, extent.x, extent.y, extent.z, imageDesc);
+            break;
+
+        default:
+            break;
+    }
+
+    #endif
+}
+
+#endif
+
+void GLTexSubImage(const TextureType type, const TextureRegion& region, const ImageDescriptor& imageDesc)
+{
+    const auto& offset = region.offset;
+    const auto& extent = region.extent;
+
+    switch (type)
+    {
+        #ifdef LLGL_OPENGL
+        case TextureType::Texture1D:
+            GLTexSubImage1DBase(GL_TEXTURE_1D, region.mipLevel, offset.x, extent.x, imageDesc);
+            break;
+        #endif
+
+        case TextureType::Texture2D:
+            GLTexSubImage2DBase(GL_TEXTURE_2D, region.mipLevel, offset.x, offset.y, extent.x, extent.y, imageDesc);
+            break;
+
+        case TextureType::Texture3D:
+            GLTexSubImage3DBase(GL_TEXTURE_3D, region.mipLevel, offset.x, offset.y, offset.z, extent.x, extent.y, extent.z, imageDesc);
+            break;
+
+        case TextureType::TextureCube:
+            GLTexSubImageCubeFaces(region, imageDesc);
+            break;
+
+        #ifdef LLGL_OPENGL
+        case TextureType::Texture1DArray:
+            GLTexSubImage2DBase(GL_TEXTURE_1D_ARRAY, region.mipLevel, offset.x, offset.y, extent.x, extent.y, imageDesc);
+            break;
+        #endif
+
+        case TextureType::Texture2DArray:
+            GLTexSubImage3DBase(GL_TEXTURE_2D_ARRAY, region.mipLevel, offset.x, offset.y, offset.z, extent.x, extent.y, extent.z, imageDesc);
+            break;
+
+        #ifdef LLGL_OPENGL
+        case TextureType::TextureCubeArray:
+            GLTexSubImage3DBase(GL_TEXTURE_CUBE_MAP_ARRAY, region.mipLevel, offset.x, offset.y, offset.z, extent.x, extent.y, extent.z, imageDesc);
+            break;
+        #endif
+
+        default:
+            break;
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -36,6 +36,22 @@ void GLTexSubImage2DArray(const SubTextureDescriptor& desc, const ImageDescripto
 
 #endif
 
+/*
+Writes the image data into the specified region of the currently bound texture of the specified type.
+Cube faces are written one after another, so the image data of each face must follow the previous one.
+*/
+void GLTexSubImage(const TextureType type, const TextureRegion& region, const ImageDescriptor& imageDesc);
+
+#ifdef LLGL_OPENGL
+
+/*
+Writes the image data into the specified region of the specified texture with direct state access (requires GL_ARB_direct_state_access),
+i.e. the texture does not need to be bound. Cube faces are addressed as array layers, so all faces are written with a single call.
+*/
+void GLTextureSubImage(unsigned int texture, const TextureType type, const TextureRegion& region, const ImageDescriptor& imageDesc);
+
+#endif
+
 
 } // /namespace LLGL
 
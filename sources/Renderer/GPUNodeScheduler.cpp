@@ -0,0 +1,92 @@
+/*
+ * GPUNodeScheduler.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/GPUNodeScheduler.h>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+GPUNodeScheduler::GPUNodeScheduler(RenderSystem& renderSystem, unsigned int maxNumNodes) :
+    renderSystem_ { renderSystem }
+{
+    auto numNodes = renderSystem.GetRenderingCaps().numGPUNodes;
+    if (numNodes == 0)
+        numNodes = 1;
+    if (maxNumNodes > 0 && numNodes > maxNumNodes)
+        numNodes = maxNumNodes;
+
+    /* Create one deferred command buffer for each GPU node */
+    for (unsigned int nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex)
+        commandBuffers_.push_back(renderSystem.CreateCommandBuffer(CommandBufferDescriptor(CommandBufferFlags::DeferredSubmit, nodeIndex)));
+}
+
+GPUNodeScheduler::~GPUNodeScheduler()
+{
+    for (auto commandBuffer : commandBuffers_)
+        renderSystem_.Release(*commandBuffer);
+}
+
+CommandBuffer& GPUNodeScheduler::NextFrame()
+{
+    /* Select nodes in turn, so consecutive frames run concurrently on different nodes */
+    frameNode_      = static_cast<unsigned int>(numFrames_ % commandBuffers_.size());
+    insideFrame_    = true;
+    ++numFrames_;
+
+    auto& commandBuffer = *commandBuffers_[frameNode_];
+    commandBuffer.Reset();
+
+    return commandBuffer;
+}
+
+void GPUNodeScheduler::SubmitFrame()
+{
+    if (!insideFrame_)
+        throw std::runtime_error("cannot submit GPU node frame that has not been begun");
+
+    insideFrame_ = false;
+
+    renderSystem_.ExecuteCommandBuffers(1, &commandBuffers_[frameNode_]);
+}
+
+void GPUNodeScheduler::BeginSplitFrame()
+{
+    ++numFrames_;
+    for (auto commandBuffer : commandBuffers_)
+        commandBuffer->Reset();
+}
+
+void GPUNodeScheduler::SubmitSplitFrame()
+{
+    renderSystem_.ExecuteCommandBuffers(static_cast<unsigned int>(commandBuffers_.size()), commandBuffers_.data());
+}
+
+Scissor GPUNodeScheduler::GetSplitScissor(unsigned int nodeIndex, const Gs::Vector2ui& resolution) const
+{
+    /* Divide frame into horizontal bands, whose bounds are rounded down, so the bands of all nodes cover the entire frame */
+    auto numNodes   = static_cast<std::uint64_t>(commandBuffers_.size());
+    auto top        = static_cast<int>(resolution.y * static_cast<std::uint64_t>(nodeIndex) / numNodes);
+    auto bottom     = static_cast<int>(resolution.y * static_cast<std::uint64_t>(nodeIndex + 1) / numNodes);
+    return Scissor(0, top, static_cast<int>(resolution.x), bottom - top);
+}
+
+CommandBuffer& GPUNodeScheduler::GetCommandBuffer(unsigned int nodeIndex) const
+{
+    if (nodeIndex >= commandBuffers_.size())
+        throw std::out_of_range("GPU node index out of range");
+    return *commandBuffers_[nodeIndex];
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,271 @@
+/*
+ * GPUProfiler.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/GPUProfiler.h>
+#include "../Core/Exception.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+GPUProfiler::GPUProfiler(RenderSystem& renderSystem, CommandBuffer& commandBuffer, std::size_t maxPendingFrames, bool pipelineStatistics) :
+    renderSystem_       { renderSystem                                   },
+    commandBuffer_      { commandBuffer                                  },
+    maxPendingFrames_   { (maxPendingFrames > 0 ? maxPendingFrames : 1u) },
+    pipelineStatistics_ { pipelineStatistics                             }
+{
+    /* Create first pipeline statistics query to fail early if they are not supported */
+    if (pipelineStatistics_)
+    {
+        auto query = renderSystem_.CreateQuery(QueryType::PipelineStatistics);
+        if (!query)
+            ThrowNotSupported("pipeline statistics queries");
+        allSegmentQueries_.push_back(query);
+        freeSegmentQueries_.push_back(query);
+    }
+}
+
+GPUProfiler::~GPUProfiler()
+{
+    for (auto query : allQueries_)
+        renderSystem_.Release(*query);
+    for (auto query : allSegmentQueries_)
+        renderSystem_.Release(*query);
+}
+
+void GPUProfiler::BeginFrame()
+{
+    if (insideFrame_)
+        throw std::runtime_error("cannot begin GPU profiler frame before the previous frame has been ended");
+
+    insideFrame_ = true;
+
+    /* Start new frame with the timestamp at the beginning of the frame */
+    currentFrame_.frameIndex = nextFrameIndex_++;
+    WriteTimestamp();
+    NextStatisticsSegment();
+}
+
+void GPUProfiler::EndFrame()
+{
+    if (!insideFrame_)
+        throw std::runtime_error("cannot end GPU profiler frame that has not been begun");
+    if (!scopeStack_.empty())
+        throw std::runtime_error("cannot end GPU profiler frame while scope \"" + currentFrame_.scopes[scopeStack_.back()].name + "\" has not been popped");
+
+    insideFrame_ = false;
+
+    /* Write timestamp at the end of the frame and move it to the pending frames */
+    EndStatisticsSegment();
+    WriteTimestamp();
+    pendingFrames_.emplace_back(std::move(currentFrame_));
+    currentFrame_ = PendingFrame();
+
+    /* Resolve all pending frames in order, until the results of a frame are not available yet */
+    while (!pendingFrames_.empty() && ResolveFrame(pendingFrames_.front()))
+    {
+        RecycleFrame(pendingFrames_.front());
+        pendingFrames_.pop_front();
+    }
+
+    /* Discard the oldest frames if too many are pending */
+    while (pendingFrames_.size() > maxPendingFrames_)
+    {
+        RecycleFrame(pendingFrames_.front());
+        pendingFrames_.pop_front();
+        ++numDiscardedFrames_;
+    }
+}
+
+void GPUProfiler::PushScope(const std::string& name)
+{
+    if (!insideFrame_)
+        throw std::runtime_error("cannot push GPU profiler scope outside of a frame");
+
+    PendingScope scope;
+    {
+        scope.name          = name;
+        scope.depth         = static_cast<unsigned int>(scopeStack_.size());
+        scope.parent        = (scopeStack_.empty() ? -1 : static_cast<int>(scopeStack_.back()));
+        scope.beginQuery    = WriteTimestamp();
+        scope.beginSegment  = NextStatisticsSegment();
+    }
+    scopeStack_.push_back(currentFrame_.scopes.size());
+    currentFrame_.scopes.emplace_back(std::move(scope));
+}
+
+void GPUProfiler::PopScope()
+{
+    if (scopeStack_.empty())
+        throw std::runtime_error("cannot pop GPU profiler scope from empty stack");
+
+    auto& scope = currentFrame_.scopes[scopeStack_.back()];
+    {
+        scope.endQuery      = WriteTimestamp();
+        scope.endSegment    = NextStatisticsSegment();
+    }
+    scopeStack_.pop_back();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Writes a timestamp into the current frame and returns the index of its query.
+std::size_t GPUProfiler::WriteTimestamp()
+{
+    /* Take query from the pool, or create a new one if the pool is empty */
+    Query* query = nullptr;
+
+    if (freeQueries_.empty())
+    {
+        query = renderSystem_.CreateQuery(QueryType::Timestamp);
+        if (!query)
+            ThrowNotSupported("timestamp queries");
+        allQueries_.push_back(query);
+    }
+    else
+    {
+        query = freeQueries_.back();
+        freeQueries_.pop_back();
+    }
+
+    commandBuffer_.EndQuery(*query);
+
+    currentFrame_.queries.push_back(query);
+    return (currentFrame_.queries.size() - 1);
+}
+
+/*
+Ends the current pipeline statistics segment and begins the next one. Returns the index of the new segment.
+Segments never overlap, so the statistics of a scope are the sum of all segments within its boundaries.
+*/
+std::size_t GPUProfiler::NextStatisticsSegment()
+{
+    if (!pipelineStatistics_)
+        return 0;
+
+    EndStatisticsSegment();
+
+    /* Take query from the pool, or create a new one if the pool is empty */
+    Query* query = nullptr;
+
+    if (freeSegmentQueries_.empty())
+    {
+        query = renderSystem_.CreateQuery(QueryType::PipelineStatistics);
+        allSegmentQueries_.push_back(query);
+    }
+    else
+    {
+        query = freeSegmentQueries_.back();
+        freeSegmentQueries_.pop_back();
+    }
+
+    commandBuffer_.BeginQuery(*query);
+
+    currentFrame_.segmentQueries.push_back(query);
+    return (currentFrame_.segmentQueries.size() - 1);
+}
+
+void GPUProfiler::EndStatisticsSegment()
+{
+    if (!currentFrame_.segmentQueries.empty())
+        commandBuffer_.EndQuery(*currentFrame_.segmentQueries.back());
+}
+
+static void Accumulate(QueryPipelineStatistics& dst, const QueryPipelineStatistics& src)
+{
+    dst.numPrimitivesGenerated              += src.numPrimitivesGenerated;
+    dst.numVerticesSubmitted                += src.numVerticesSubmitted;
+    dst.numPrimitivesSubmitted              += src.numPrimitivesSubmitted;
+    dst.numVertexShaderInvocations          += src.numVertexShaderInvocations;
+    dst.numTessControlShaderInvocations     += src.numTessControlShaderInvocations;
+    dst.numTessEvaluationShaderInvocations  += src.numTessEvaluationShaderInvocations;
+    dst.numGeometryShaderInvocations        += src.numGeometryShaderInvocations;
+    dst.numFragmentShaderInvocations        += src.numFragmentShaderInvocations;
+    dst.numComputeShaderInvocations         += src.numComputeShaderInvocations;
+    dst.numGeometryPrimitivesGenerated      += src.numGeometryPrimitivesGenerated;
+    dst.numClippingInputPrimitives          += src.numClippingInputPrimitives;
+    dst.numClippingOutputPrimitives         += src.numClippingOutputPrimitives;
+}
+
+/*
+Polls the query results of the specified frame without blocking.
+Timestamps are written in command order, so polling stops at the first result that is not available,
+and the results that are already available are kept for the next attempt.
+*/
+bool GPUProfiler::ResolveFrame(PendingFrame& frame)
+{
+    while (frame.timestamps.size() < frame.queries.size())
+    {
+        std::uint64_t timestamp = 0;
+        if (!commandBuffer_.QueryResult(*frame.queries[frame.timestamps.size()], timestamp))
+            return false;
+        frame.timestamps.push_back(timestamp);
+    }
+
+    while (frame.segments.size() < frame.segmentQueries.size())
+    {
+        QueryPipelineStatistics segment;
+        if (!commandBuffer_.QueryPipelineStatisticsResult(*frame.segmentQueries[frame.segments.size()], segment))
+            return false;
+        frame.segments.push_back(segment);
+    }
+
+    /* Convert timestamps into scope timings */
+    const auto frameStart = frame.timestamps.front();
+
+    resolvedFrame_.frameIndex       = frame.frameIndex;
+    resolvedFrame_.startTimestamp   = frameStart;
+    resolvedFrame_.elapsedTime      = frame.timestamps.back() - frameStart;
+    resolvedFrame_.statistics       = QueryPipelineStatistics();
+    resolvedFrame_.scopes.resize(frame.scopes.size());
+
+    for (const auto& segment : frame.segments)
+        Accumulate(resolvedFrame_.statistics, segment);
+
+    for (std::size_t i = 0; i < frame.scopes.size(); ++i)
+    {
+        const auto& src = frame.scopes[i];
+        auto& dst = resolvedFrame_.scopes[i];
+
+        const auto beginTime    = frame.timestamps[src.beginQuery];
+        const auto endTime      = frame.timestamps[src.endQuery];
+
+        dst.name        = src.name;
+        dst.depth       = src.depth;
+        dst.parent      = src.parent;
+        dst.startTime   = beginTime - frameStart;
+        dst.elapsedTime = (endTime > beginTime ? endTime - beginTime : 0);
+        dst.statistics  = QueryPipelineStatistics();
+
+        for (auto segment = src.beginSegment; segment < src.endSegment && segment < frame.segments.size(); ++segment)
+            Accumulate(dst.statistics, frame.segments[segment]);
+    }
+
+    hasResolvedFrame_ = true;
+
+    return true;
+}
+
+void GPUProfiler::RecycleFrame(PendingFrame& frame)
+{
+    freeQueries_.insert(freeQueries_.end(), frame.queries.begin(), frame.queries.end());
+    frame.queries.clear();
+    freeSegmentQueries_.insert(freeSegmentQueries_.end(), frame.segmentQueries.begin(), frame.segmentQueries.end());
+    frame.segmentQueries.clear();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,239 @@
+/*
+ * GeometryAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/GeometryAllocator.h>
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+GeometryAllocator::GeometryAllocator(RenderSystem& renderSystem, const GeometryAllocatorDescriptor& desc) :
+    renderSystem_ { renderSystem },
+    desc_         { desc         }
+{
+    if (desc.vertexFormat.stride == 0)
+        throw std::invalid_argument("cannot create geometry allocator with vertex format of zero stride");
+    if (desc.maxVertices == 0 || desc.maxIndices == 0)
+        throw std::invalid_argument("cannot create geometry allocator with zero vertices or zero indices");
+
+    /* Create vertex and index buffers with their full capacity, so they never need to be reallocated */
+    BufferDescriptor vertexBufferDesc;
+    {
+        vertexBufferDesc.type                   = BufferType::Vertex;
+        vertexBufferDesc.size                   = desc.maxVertices * desc.vertexFormat.stride;
+        vertexBufferDesc.vertexBuffer.format    = desc.vertexFormat;
+    }
+    vertexBuffer_ = renderSystem.CreateBuffer(vertexBufferDesc);
+
+    BufferDescriptor indexBufferDesc;
+    {
+        indexBufferDesc.type                = BufferType::Index;
+        indexBufferDesc.size                = desc.maxIndices * desc.indexFormat.GetFormatSize();
+        indexBufferDesc.indexBuffer.format  = desc.indexFormat;
+    }
+    indexBuffer_ = renderSystem.CreateBuffer(indexBufferDesc);
+
+    Clear();
+}
+
+GeometryAllocator::~GeometryAllocator()
+{
+    renderSystem_.Release(*vertexBuffer_);
+    renderSystem_.Release(*indexBuffer_);
+}
+
+bool GeometryAllocator::Allocate(unsigned int numVertices, unsigned int numIndices, GeometryRange& range)
+{
+    if (numVertices == 0)
+        return false;
+
+    unsigned int firstVertex = 0, firstIndex = 0;
+
+    if (!AllocateBlock(freeVertices_, numVertices, firstVertex))
+        return false;
+
+    if (numIndices > 0 && !AllocateBlock(freeIndices_, numIndices, firstIndex))
+    {
+        /* Roll back vertex allocation */
+        ReleaseBlock(freeVertices_, firstVertex, numVertices);
+        return false;
+    }
+
+    range.firstVertex   = firstVertex;
+    range.numVertices   = numVertices;
+    range.firstIndex    = firstIndex;
+    range.numIndices    = numIndices;
+
+    numAllocatedVertices_   += numVertices;
+    numAllocatedIndices_    += numIndices;
+
+    return true;
+}
+
+bool GeometryAllocator::Insert(const void* vertices, unsigned int numVertices, const void* indices, unsigned int numIndices, GeometryRange& range)
+{
+    if (Allocate(numVertices, numIndices, range))
+    {
+        Write(range, vertices, indices);
+        return true;
+    }
+    return false;
+}
+
+void GeometryAllocator::Write(const GeometryRange& range, const void* vertices, const void* indices)
+{
+    const auto vertexStride = desc_.vertexFormat.stride;
+    const auto indexStride  = desc_.indexFormat.GetFormatSize();
+
+    if (vertices != nullptr && range.numVertices > 0)
+        renderSystem_.WriteBuffer(*vertexBuffer_, vertices, range.numVertices * vertexStride, range.firstVertex * vertexStride);
+    if (indices != nullptr && range.numIndices > 0)
+        renderSystem_.WriteBuffer(*indexBuffer_, indices, range.numIndices * indexStride, range.firstIndex * indexStride);
+}
+
+void GeometryAllocator::Free(const GeometryRange& range)
+{
+    if (range.numVertices > 0)
+    {
+        ReleaseBlock(freeVertices_, range.firstVertex, range.numVertices);
+        numAllocatedVertices_ -= range.numVertices;
+    }
+    if (range.numIndices > 0)
+    {
+        ReleaseBlock(freeIndices_, range.firstIndex, range.numIndices);
+        numAllocatedIndices_ -= range.numIndices;
+    }
+}
+
+void GeometryAllocator::Clear()
+{
+    freeVertices_   = { FreeBlock{ 0, desc_.maxVertices } };
+    freeIndices_    = { FreeBlock{ 0, desc_.maxIndices  } };
+
+    numAllocatedVertices_   = 0;
+    numAllocatedIndices_    = 0;
+}
+
+void GeometryAllocator::Bind(CommandBuffer& commandBuffer) const
+{
+    commandBuffer.SetVertexBuffer(*vertexBuffer_);
+    commandBuffer.SetIndexBuffer(*indexBuffer_);
+}
+
+void GeometryAllocator::Draw(CommandBuffer& commandBuffer, const GeometryRange& range, unsigned int numInstances) const
+{
+    if (range.numIndices > 0)
+    {
+        commandBuffer.DrawIndexedInstanced(
+            range.numIndices,
+            numInstances,
+            range.firstIndex,
+            static_cast<int>(range.firstVertex)
+        );
+    }
+    else
+        commandBuffer.DrawInstanced(range.numVertices, range.firstVertex, numInstances);
+}
+
+void GeometryAllocator::ReportMemoryUsage(RenderingProfiler& profiler, const std::string& name) const
+{
+    RenderingProfiler::SuballocatorUsage vertexUsage;
+    {
+        vertexUsage.capacity            = desc_.maxVertices;
+        vertexUsage.used                = numAllocatedVertices_;
+        vertexUsage.largestFreeBlock    = GetLargestBlockSize(freeVertices_);
+    }
+    profiler.ReportSuballocator(name + ".vertices", vertexUsage);
+
+    RenderingProfiler::SuballocatorUsage indexUsage;
+    {
+        indexUsage.capacity         = desc_.maxIndices;
+        indexUsage.used             = numAllocatedIndices_;
+        indexUsage.largestFreeBlock = GetLargestBlockSize(freeIndices_);
+    }
+    profiler.ReportSuballocator(name + ".indices", indexUsage);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool GeometryAllocator::AllocateBlock(std::vector<FreeBlock>& freeBlocks, unsigned int size, unsigned int& offset)
+{
+    /* Take the range from the first free block that is large enough (first-fit) */
+    for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it)
+    {
+        if (it->size >= size)
+        {
+            offset = it->offset;
+            if (it->size == size)
+                freeBlocks.erase(it);
+            else
+            {
+                it->offset  += size;
+                it->size    -= size;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeometryAllocator::ReleaseBlock(std::vector<FreeBlock>& freeBlocks, unsigned int offset, unsigned int size)
+{
+    /* Find insertion position to keep the free blocks sorted by their offsets */
+    auto it = freeBlocks.begin();
+    while (it != freeBlocks.end() && it->offset < offset)
+        ++it;
+
+    /* Merge with the previous block */
+    if (it != freeBlocks.begin())
+    {
+        auto prev = it - 1;
+        if (prev->offset + prev->size == offset)
+        {
+            prev->size += size;
+
+            /* Merge with the next block, too */
+            if (it != freeBlocks.end() && offset + size == it->offset)
+            {
+                prev->size += it->size;
+                freeBlocks.erase(it);
+            }
+            return;
+        }
+    }
+
+    /* Merge with the next block */
+    if (it != freeBlocks.end() && offset + size == it->offset)
+    {
+        it->offset  = offset;
+        it->size    += size;
+        return;
+    }
+
+    freeBlocks.insert(it, FreeBlock{ offset, size });
+}
+
+unsigned int GeometryAllocator::GetLargestBlockSize(const std::vector<FreeBlock>& freeBlocks)
+{
+    unsigned int size = 0;
+    for (const auto& block : freeBlocks)
+        size = std::max(size, block.size);
+    return size;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
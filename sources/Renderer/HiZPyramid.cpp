@@ -0,0 +1,153 @@
+/*
+ * HiZPyramid.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/HiZPyramid.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+HiZPyramid::HiZPyramid(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const HiZPyramidDescriptor& desc) :
+    renderSystem_  { renderSystem  },
+    commandBuffer_ { commandBuffer },
+    desc_          { desc          }
+{
+    if (!desc.pipeline)
+        throw std::invalid_argument("cannot create hierarchical-Z pyramid without graphics pipeline");
+    if (desc.width == 0 || desc.height == 0)
+        throw std::invalid_argument("cannot create hierarchical-Z pyramid with zero size");
+
+    const auto& caps = renderSystem.GetRenderingCaps();
+    if (!caps.hasRenderTargets || !caps.hasTextureViews || caps.maxPushConstantsSize < sizeof(HiZPyramidParameters))
+        throw std::runtime_error("hierarchical-Z pyramid requires render targets, texture views, and push constants");
+
+    CreateResources();
+}
+
+HiZPyramid::~HiZPyramid()
+{
+    ReleaseResources();
+}
+
+void HiZPyramid::Build(Texture& depthTexture)
+{
+    /* Each level is written in its own render pass, so its previous content does not need to be loaded */
+    RenderPassDescriptor renderPassDesc;
+    renderPassDesc.colorAttachments.push_back(RenderPassAttachmentDescriptor { AttachmentLoadOp::DontCare });
+
+    HiZPyramidParameters params;
+
+    for (std::size_t i = 0; i < levels_.size(); ++i)
+    {
+        const auto& level = levels_[i];
+
+        /* Read depth texture for level 0, and the previous level through its texture view otherwise */
+        auto& srcTexture = (i == 0 ? depthTexture : *levels_[i - 1].textureView);
+
+        params.srcSize[0]   = (i == 0 ? level.width  : levels_[i - 1].width);
+        params.srcSize[1]   = (i == 0 ? level.height : levels_[i - 1].height);
+        params.dstSize[0]   = level.width;
+        params.dstSize[1]   = level.height;
+        params.level        = static_cast<std::uint32_t>(i);
+
+        commandBuffer_.BeginRenderPass(*level.renderTarget, renderPassDesc);
+        {
+            commandBuffer_.SetViewport(Viewport { 0.0f, 0.0f, static_cast<float>(level.width), static_cast<float>(level.height) });
+            commandBuffer_.SetGraphicsPipeline(*desc_.pipeline);
+            commandBuffer_.SetTexture(srcTexture, 0, ShaderStageFlags::FragmentStage);
+            commandBuffer_.SetPushConstants(0, sizeof(params), &params);
+            commandBuffer_.Draw(3, 0);
+        }
+        commandBuffer_.EndRenderPass();
+    }
+}
+
+void HiZPyramid::Resize(std::uint32_t width, std::uint32_t height)
+{
+    if (width == 0 || height == 0)
+        throw std::invalid_argument("cannot resize hierarchical-Z pyramid to zero size");
+
+    if (desc_.width != width || desc_.height != height)
+    {
+        ReleaseResources();
+        desc_.width     = width;
+        desc_.height    = height;
+        CreateResources();
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void HiZPyramid::CreateResources()
+{
+    /* Create pyramid texture with a full MIP-map chain */
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.type                = TextureType::Texture2D;
+        textureDesc.format              = desc_.format;
+        textureDesc.texture2D.width     = desc_.width;
+        textureDesc.texture2D.height    = desc_.height;
+        textureDesc.texture2D.layers    = 1;
+    }
+    texture_ = renderSystem_.CreateTexture(textureDesc);
+
+    /* Create render target and single-level texture view for each level */
+    const auto numLevels = NumMipLevels(desc_.width, desc_.height);
+    levels_.resize(numLevels);
+
+    for (unsigned int i = 0; i < numLevels; ++i)
+    {
+        auto& level = levels_[i];
+
+        level.width     = std::max(1u, desc_.width  >> i);
+        level.height    = std::max(1u, desc_.height >> i);
+
+        RenderTargetAttachmentDescriptor attachmentDesc;
+        attachmentDesc.mipLevel = i;
+
+        level.renderTarget = renderSystem_.CreateRenderTarget({});
+        level.renderTarget->AttachTexture(*texture_, attachmentDesc);
+
+        TextureViewDescriptor textureViewDesc;
+        {
+            textureViewDesc.type            = TextureType::Texture2D;
+            textureViewDesc.firstMipLevel   = i;
+            textureViewDesc.numMipLevels    = 1;
+        }
+        level.textureView = renderSystem_.CreateTextureView(*texture_, textureViewDesc);
+    }
+}
+
+void HiZPyramid::ReleaseResources()
+{
+    /* Release render targets and texture views before the shared texture */
+    for (auto& level : levels_)
+    {
+        renderSystem_.Release(*level.renderTarget);
+        renderSystem_.Release(*level.textureView);
+    }
+    levels_.clear();
+
+    if (texture_)
+    {
+        renderSystem_.Release(*texture_);
+        texture_ = nullptr;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,158 @@
+/*
+ * InstanceStream.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/InstanceStream.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+InstanceStream::InstanceStream(RenderSystem& renderSystem, const InstanceStreamDescriptor& desc) :
+    renderSystem_ { renderSystem },
+    desc_         { desc         }
+{
+    if (desc.format.stride == 0)
+        throw std::invalid_argument("cannot create instance stream with zero stride");
+    if (desc.maxInstances == 0 || desc.numFrames == 0)
+        throw std::invalid_argument("cannot create instance stream without instances or frames");
+
+    const auto bufferSize = desc.format.stride * desc.maxInstances;
+
+    /* Allocate staging memory for a single frame */
+    staging_ = AllocByteBuffer(bufferSize, "InstanceStream");
+
+    /* Create instance buffer for each frame */
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type                 = BufferType::Vertex;
+        bufferDesc.size                 = bufferSize;
+        bufferDesc.flags                = BufferFlags::DynamicUsage;
+        bufferDesc.vertexBuffer.format  = desc.format;
+    }
+
+    instanceBuffers_.reserve(desc.numFrames);
+    for (std::uint32_t i = 0; i < desc.numFrames; ++i)
+        instanceBuffers_.push_back(renderSystem_.CreateBuffer(bufferDesc));
+}
+
+InstanceStream::~InstanceStream()
+{
+    for (auto& entry : bufferArrays_)
+    {
+        for (auto bufferArray : entry.second)
+            renderSystem_.Release(*bufferArray);
+    }
+
+    for (auto buffer : instanceBuffers_)
+        renderSystem_.Release(*buffer);
+}
+
+InstanceRange InstanceStream::Append(const void* instances, std::uint32_t numInstances)
+{
+    InstanceRange range;
+
+    if (numInstances > 0)
+    {
+        /* Reserve range with a single atomic operation */
+        auto first = numAppended_.fetch_add(numInstances);
+
+        if (first <= desc_.maxInstances && numInstances <= desc_.maxInstances - first)
+        {
+            /* Copy instances into the reserved range of the staging memory */
+            const auto stride = desc_.format.stride;
+            ::memcpy(staging_.get() + first * stride, instances, numInstances * stride);
+
+            range.firstInstance = first;
+            range.numInstances  = numInstances;
+        }
+    }
+
+    return range;
+}
+
+void InstanceStream::Upload()
+{
+    /* Upload only the instances that have been appended since the last upload */
+    auto numAppended = GetNumInstances();
+
+    if (numUploaded_ < numAppended)
+    {
+        const auto stride = desc_.format.stride;
+        renderSystem_.WriteBuffer(
+            GetInstanceBuffer(),
+            staging_.get() + numUploaded_ * stride,
+            (numAppended - numUploaded_) * stride,
+            numUploaded_ * stride
+        );
+        numUploaded_ = numAppended;
+    }
+}
+
+void InstanceStream::NextFrame()
+{
+    frame_ = (frame_ + 1) % desc_.numFrames;
+    numAppended_.store(0);
+    numUploaded_ = 0;
+}
+
+BufferArray& InstanceStream::GetBufferArray(Buffer& vertexBuffer)
+{
+    auto& bufferArrays = bufferArrays_[&vertexBuffer];
+
+    if (bufferArrays.empty())
+    {
+        /* Create buffer arrays with the instance buffer of each frame */
+        bufferArrays.reserve(desc_.numFrames);
+        for (auto instanceBuffer : instanceBuffers_)
+        {
+            Buffer* buffers[] = { &vertexBuffer, instanceBuffer };
+            bufferArrays.push_back(renderSystem_.CreateBufferArray(2, buffers));
+        }
+    }
+
+    return *bufferArrays[frame_];
+}
+
+void InstanceStream::ReleaseBufferArrays(Buffer& vertexBuffer)
+{
+    auto it = bufferArrays_.find(&vertexBuffer);
+    if (it != bufferArrays_.end())
+    {
+        for (auto bufferArray : it->second)
+            renderSystem_.Release(*bufferArray);
+        bufferArrays_.erase(it);
+    }
+}
+
+void InstanceStream::Draw(CommandBuffer& commandBuffer, const InstanceRange& range, unsigned int numVertices, unsigned int firstVertex)
+{
+    if (range.numInstances > 0)
+        commandBuffer.DrawInstanced(numVertices, firstVertex, range.numInstances, range.firstInstance);
+}
+
+void InstanceStream::DrawIndexed(CommandBuffer& commandBuffer, const InstanceRange& range, unsigned int numIndices, unsigned int firstIndex, int vertexOffset)
+{
+    if (range.numInstances > 0)
+        commandBuffer.DrawIndexedInstanced(numIndices, range.numInstances, firstIndex, vertexOffset, range.firstInstance);
+}
+
+std::uint32_t InstanceStream::GetNumInstances() const
+{
+    /* Counter can exceed the maximum if appends have failed */
+    return std::min(numAppended_.load(), desc_.maxInstances);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -11,6 +11,7 @@
 
 #include "BuildID.h"
 #include <LLGL/Export.h>
+#include <LLGL/RenderSystemFlags.h>
 
 
 extern "C"
@@ -30,8 +31,8 @@ LLGL_EXPORT int LLGL_RenderSystem_RendererID();
 // Returns the name of this render system module.
 LLGL_EXPORT const char* LLGL_RenderSystem_Name();
 
-// Returns a raw pointer to the allocated render system (allocated with "new" keyword)
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc();
+// Returns a raw pointer to the allocated render system (allocated with "new" keyword) for the specified descriptor, which is never null.
+LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const LLGL::RenderSystemDescriptor* renderSystemDesc);
 
 } // /extern "C"
 
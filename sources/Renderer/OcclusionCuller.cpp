@@ -0,0 +1,210 @@
+/*
+ * OcclusionCuller.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/OcclusionCuller.h>
+#include "../Core/Exception.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static bool IsOcclusionQuery(const QueryType type)
+{
+    return
+    (
+        type == QueryType::SamplesPassed    ||
+        type == QueryType::AnySamplesPassed ||
+        type == QueryType::AnySamplesPassedConservative
+    );
+}
+
+OcclusionCuller::OcclusionCuller(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const OcclusionCullerDescriptor& desc) :
+    renderSystem_  { renderSystem    },
+    commandBuffer_ { commandBuffer   },
+    desc_          { desc            },
+    objects_       ( desc.maxObjects ),
+    querySets_     ( desc.numFrames  ),
+    results_       ( desc.maxObjects )
+{
+    if (desc.maxObjects == 0 || desc.numFrames == 0)
+        throw std::invalid_argument("cannot create occlusion culler without objects or frames");
+    if (!IsOcclusionQuery(desc.queryType))
+        throw std::invalid_argument("cannot create occlusion culler with query type that is not an occlusion query");
+
+    if (desc_.visibleTestInterval == 0)
+        desc_.visibleTestInterval = 1;
+
+    /* Create a query for each object and frame, which can be used as render condition */
+    const QueryDescriptor queryDesc { desc.queryType, true };
+
+    for (auto& querySet : querySets_)
+    {
+        querySet.queries.reserve(desc.maxObjects);
+        querySet.objects.reserve(desc.maxObjects);
+
+        for (std::uint32_t i = 0; i < desc.maxObjects; ++i)
+        {
+            auto query = renderSystem_.CreateQuery(queryDesc);
+            if (!query)
+                ThrowNotSupported("occlusion queries");
+            querySet.queries.push_back(query);
+        }
+
+        /* Create query array to poll all results of a frame at once */
+        querySet.queryArray = renderSystem_.CreateQueryArray(desc.maxObjects, querySet.queries.data());
+    }
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+    for (auto& querySet : querySets_)
+    {
+        if (querySet.queryArray)
+            renderSystem_.Release(*querySet.queryArray);
+        for (auto query : querySet.queries)
+            renderSystem_.Release(*query);
+    }
+}
+
+void OcclusionCuller::BeginFrame()
+{
+    if (insideFrame_)
+        throw std::runtime_error("cannot begin occlusion culler frame before the previous frame has been ended");
+
+    insideFrame_            = true;
+    numConditionalDraws_    = 0;
+    ++frameIndex_;
+
+    /*
+    Resolve pending query sets from the oldest to the newest frame, until the results of a frame are not available yet.
+    The oldest query set is the one of the current frame, which is discarded if its results are still not available.
+    */
+    const auto numFrames = static_cast<std::uint64_t>(desc_.numFrames);
+
+    for (auto age = numFrames; age > 0; --age)
+    {
+        auto& querySet = querySets_[(frameIndex_ + numFrames - age) % numFrames];
+        if (!querySet.objects.empty())
+        {
+            if (!ResolveQuerySet(querySet))
+                break;
+            querySet.objects.clear();
+        }
+    }
+
+    auto& currentSet = querySets_[frameIndex_ % numFrames];
+    {
+        currentSet.objects.clear();
+        currentSet.frameIndex = frameIndex_;
+    }
+}
+
+void OcclusionCuller::EndFrame()
+{
+    if (!insideFrame_)
+        throw std::runtime_error("cannot end occlusion culler frame that has not been begun");
+
+    insideFrame_ = false;
+}
+
+void OcclusionCuller::Draw(std::uint32_t object, const DrawCallback& drawProxy, const DrawCallback& drawObject)
+{
+    if (!insideFrame_)
+        throw std::runtime_error("cannot draw with occlusion culler outside of a frame");
+    if (object >= desc_.maxObjects)
+        throw std::out_of_range("object ID exceeds maximal number of objects in occlusion culler");
+
+    if (objects_[object].visible)
+    {
+        /* Reuse visibility of visible object, but test its actual geometry in a staggered interval */
+        Query* query = nullptr;
+        if ((frameIndex_ + object) % desc_.visibleTestInterval == 0)
+            query = NextQuery(object);
+
+        if (query)
+        {
+            commandBuffer_.BeginQuery(*query);
+            drawObject();
+            commandBuffer_.EndQuery(*query);
+        }
+        else
+            drawObject();
+    }
+    else if (auto query = NextQuery(object))
+    {
+        /* Test proxy of occluded object, and draw object only if the proxy passes the test */
+        commandBuffer_.BeginQuery(*query);
+        drawProxy();
+        commandBuffer_.EndQuery(*query);
+
+        commandBuffer_.BeginRenderCondition(*query, desc_.conditionMode);
+        drawObject();
+        commandBuffer_.EndRenderCondition();
+
+        ++numConditionalDraws_;
+    }
+    else
+    {
+        /* Draw object without occlusion culling if all queries are in use */
+        drawObject();
+    }
+}
+
+bool OcclusionCuller::IsVisible(std::uint32_t object) const
+{
+    return (object < desc_.maxObjects ? objects_[object].visible : true);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Returns the next free query of the current frame for the specified object, or null if all queries are in use.
+Query* OcclusionCuller::NextQuery(std::uint32_t object)
+{
+    auto& querySet = querySets_[frameIndex_ % desc_.numFrames];
+
+    if (querySet.objects.size() < querySet.queries.size())
+    {
+        auto query = querySet.queries[querySet.objects.size()];
+        querySet.objects.push_back(object);
+        return query;
+    }
+
+    return nullptr;
+}
+
+// Polls the results of the specified query set without blocking, and updates the visibility of its objects.
+bool OcclusionCuller::ResolveQuerySet(QuerySet& querySet)
+{
+    const auto numQueries = static_cast<unsigned int>(querySet.objects.size());
+
+    if (!commandBuffer_.QueryResult(*querySet.queryArray, 0, numQueries, results_.data()))
+        return false;
+
+    for (unsigned int i = 0; i < numQueries; ++i)
+    {
+        auto& state = objects_[querySet.objects[i]];
+        if (state.resultFrame < querySet.frameIndex)
+        {
+            state.visible       = (results_[i] != 0);
+            state.resultFrame   = querySet.frameIndex;
+        }
+    }
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -8,16 +8,32 @@
 #include "GLBuffer.h"
 #include "../../GLCommon/GLTypes.h"
 #include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+#include "../RenderState/GLStateManager.h"
 
 
 namespace LLGL
 {
 
 
-GLBuffer::GLBuffer(const BufferType type) :
-    Buffer { type }
+GLBuffer::GLBuffer(const BufferType type, GLuint id) :
+    Buffer { type },
+    id_    { id   }
 {
-    glGenBuffers(1, &id_);
+    if (id_ != 0)
+        return;
+
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Create buffer object immediately, so it can be edited without being bound */
+        glCreateBuffers(1, &id_);
+    }
+    else
+    #endif
+    {
+        glGenBuffers(1, &id_);
+    }
 }
 
 GLBuffer::~GLBuffer()
@@ -27,16 +43,45 @@ GLBuffer::~GLBuffer()
 
 void GLBuffer::BufferData(const void* data, GLsizeiptr size, GLenum usage)
 {
-    glBufferData(GetTarget(), size, data, usage);
+    size_ = size;
+
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedBufferData(id_, size, data, usage);
+    }
+    else
+    #endif
+    {
+        GLStateManager::active->BindBuffer(*this);
+        glBufferData(GetTarget(), size, data, usage);
+    }
 }
 
 void GLBuffer::BufferSubData(const void* data, GLsizeiptr size, GLintptr offset)
 {
-    glBufferSubData(GetTarget(), offset, size, data);
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glNamedBufferSubData(id_, offset, size, data);
+    }
+    else
+    #endif
+    {
+        GLStateManager::active->BindBuffer(*this);
+        glBufferSubData(GetTarget(), offset, size, data);
+    }
 }
 
 void* GLBuffer::MapBuffer(GLenum access)
 {
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+        return glMapNamedBuffer(id_, access);
+    #endif
+
+    GLStateManager::active->BindBuffer(*this);
+
     #ifdef LLGL_GL_OPENGLES
     //TODO: move this into "Renderer/OpenGLES2/Buffer/GLES2Buffer.cpp"
     return glMapBufferOES(GetTarget(), access);
@@ -45,8 +90,40 @@ void* GLBuffer::MapBuffer(GLenum access)
     #endif
 }
 
+void* GLBuffer::MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+        return glMapNamedBufferRange(id_, offset, length, access);
+    #endif
+
+    GLStateManager::active->BindBuffer(*this);
+    return glMapBufferRange(GetTarget(), offset, length, access);
+}
+
+void GLBuffer::FlushMappedBufferRange(GLintptr offset, GLsizeiptr length)
+{
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glFlushMappedNamedBufferRange(id_, offset, length);
+        return;
+    }
+    #endif
+
+    GLStateManager::active->BindBuffer(*this);
+    glFlushMappedBufferRange(GetTarget(), offset, length);
+}
+
 GLboolean GLBuffer::UnmapBuffer()
 {
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+        return glUnmapNamedBuffer(id_);
+    #endif
+
+    GLStateManager::active->BindBuffer(*this);
+
     #ifdef LLGL_GL_OPENGLES
     //TODO: move this into "Renderer/OpenGLES2/Buffer/GLES2Buffer.cpp"
     return glUnmapBufferOES(GetTarget());
@@ -22,13 +22,21 @@ class GLBuffer : public Buffer
 
     public:
 
-        GLBuffer(const BufferType type);
+        // Creates a new buffer object, or takes ownership of the specified buffer name if 'id' is non-zero (see GLRenderSystem::CreateBuffers).
+        GLBuffer(const BufferType type, GLuint id = 0);
         ~GLBuffer();
 
+        /*
+        The following functions edit the buffer with direct state access if GL_ARB_direct_state_access is supported,
+        otherwise they bind the buffer to its target with the active state manager first.
+        */
+
         void BufferData(const void* data, GLsizeiptr size, GLenum usage);
         void BufferSubData(const void* data, GLsizeiptr size, GLintptr offset);
 
         void* MapBuffer(GLenum access);
+        void* MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access);
+        void FlushMappedBufferRange(GLintptr offset, GLsizeiptr length);
         GLboolean UnmapBuffer();
 
         //! Returns the hardware buffer ID.
@@ -37,12 +45,19 @@ class GLBuffer : public Buffer
             return id_;
         }
 
+        //! Returns the size (in bytes) of the buffer storage, which was specified with the last call to BufferData.
+        inline GLsizeiptr GetSize() const
+        {
+            return size_;
+        }
+
     private:
 
         //! Returns the buffer target.
         GLenum GetTarget() const;
 
-        GLuint id_ = 0;
+        GLuint      id_     = 0;
+        GLsizeiptr  size_   = 0;
 
 };
 
@@ -12,8 +12,8 @@ namespace LLGL
 {
 
 
-GLIndexBuffer::GLIndexBuffer(const IndexFormat& indexFormat) :
-    GLBuffer     { BufferType::Index },
+GLIndexBuffer::GLIndexBuffer(const IndexFormat& indexFormat, GLuint id) :
+    GLBuffer     { BufferType::Index, id },
     indexFormat_ { indexFormat       }
 {
 }
@@ -21,7 +21,7 @@ class GLIndexBuffer : public GLBuffer
 
     public:
 
-        GLIndexBuffer(const IndexFormat& indexFormat);
+        GLIndexBuffer(const IndexFormat& indexFormat, GLuint id = 0);
 
         inline const IndexFormat& GetIndexFormat() const
         {
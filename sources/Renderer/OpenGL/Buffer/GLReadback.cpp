@@ -0,0 +1,177 @@
+/*
+ * GLReadback.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLReadback.h"
+#include "GLBuffer.h"
+#include "../Texture/GLTexture.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLTypes.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+#include <algorithm>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+GLReadback::GLReadback(std::size_t dataSize) :
+    Readback { dataSize }
+{
+    glGenBuffers(1, &id_);
+
+    /* Allocate buffer storage for reading from the GPU */
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, id_);
+    glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(dataSize), nullptr, GL_STREAM_READ);
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+}
+
+GLReadback::~GLReadback()
+{
+    #ifdef GL_ARB_sync
+    if (fence_)
+        glDeleteSync(fence_);
+    #endif
+
+    glDeleteBuffers(1, &id_);
+}
+
+bool GLReadback::IsReady()
+{
+    #ifdef GL_ARB_sync
+    if (fence_)
+    {
+        /* Poll fence without waiting */
+        return (glClientWaitSync(fence_, 0, 0) != GL_TIMEOUT_EXPIRED);
+    }
+    #endif
+    return true;
+}
+
+void GLReadback::ReadData(void* buffer, std::size_t bufferSize)
+{
+    WaitFence();
+
+    /* Map readback buffer and copy data into output buffer */
+    auto size = std::min(bufferSize, GetDataSize());
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, id_);
+    {
+        if (auto data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT))
+        {
+            ::memcpy(buffer, data, size);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+    }
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+}
+
+void GLReadback::ReadTexture(const GLTexture& textureGL, int mipLevel, ImageFormat imageFormat, DataType dataType)
+{
+    /* Bind texture and readback buffer, so the image data is written into the buffer at offset zero */
+    GLStateManager::active->BindTexture(textureGL);
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, id_);
+
+    if (IsCompressedFormat(imageFormat))
+    {
+        /* Read compressed image data from texture in its hardware format */
+        glGetCompressedTexImage(
+            GLTypes::Map(textureGL.GetType()),
+            mipLevel,
+            nullptr
+        );
+    }
+    else
+    {
+        /* Read image data tightly packed, since the readback buffer is sized without row padding */
+        GLint packAlignment = 4;
+        glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+        /* Read image data from texture */
+        glGetTexImage(
+            GLTypes::Map(textureGL.GetType()),
+            mipLevel,
+            GLTypes::Map(imageFormat),
+            GLTypes::Map(dataType),
+            nullptr
+        );
+
+        glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+    }
+
+    /* Unbind readback buffer, otherwise all following pixel transfers would refer to this buffer */
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_PACK_BUFFER, 0);
+
+    InsertFence();
+}
+
+void GLReadback::ReadBuffer(const GLBuffer& bufferGL, std::size_t offset)
+{
+    #ifdef GL_ARB_copy_buffer
+
+    /* Copy buffer range into readback buffer */
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_READ_BUFFER, bufferGL.GetID());
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, id_);
+
+    glCopyBufferSubData(
+        GL_COPY_READ_BUFFER,
+        GL_COPY_WRITE_BUFFER,
+        static_cast<GLintptr>(offset),
+        0,
+        static_cast<GLsizeiptr>(GetDataSize())
+    );
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, 0);
+
+    InsertFence();
+
+    #endif
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLReadback::InsertFence()
+{
+    #ifdef GL_ARB_sync
+    if (HasExtension(GLExt::ARB_sync))
+    {
+        fence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        /* Flush command queue, so that the fence is eventually signaled while it is polled with "IsReady" */
+        glFlush();
+    }
+    #endif
+}
+
+void GLReadback::WaitFence()
+{
+    #ifdef GL_ARB_sync
+    if (fence_)
+    {
+        /* Wait until the GPU has finished copying the data */
+        while (glClientWaitSync(fence_, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+        {
+            // wait for 1 ms per iteration
+        }
+
+        glDeleteSync(fence_);
+        fence_ = 0;
+    }
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,65 @@
+/*
+ * GLReadback.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_READBACK_H
+#define LLGL_GL_READBACK_H
+
+
+#include <LLGL/Readback.h>
+#include <LLGL/Image.h>
+#include "../OpenGL.h"
+
+
+namespace LLGL
+{
+
+
+class GLTexture;
+class GLBuffer;
+
+/*
+Asynchronous readback into a pixel pack buffer (PBO).
+If GL_ARB_sync is supported, the readback is guarded by a fence, which can be polled without stalling the pipeline;
+otherwise the driver synchronizes when the buffer is mapped.
+*/
+class GLReadback : public Readback
+{
+
+    public:
+
+        GLReadback(std::size_t dataSize);
+        ~GLReadback();
+
+        bool IsReady() override;
+
+        void ReadData(void* buffer, std::size_t bufferSize) override;
+
+        // Schedules the copy of the specified texture MIP-level into this readback buffer.
+        void ReadTexture(const GLTexture& textureGL, int mipLevel, ImageFormat imageFormat, DataType dataType);
+
+        // Schedules the copy of the specified buffer range into this readback buffer (requires GL_ARB_copy_buffer).
+        void ReadBuffer(const GLBuffer& bufferGL, std::size_t offset);
+
+    private:
+
+        void InsertFence();
+        void WaitFence();
+
+        GLuint  id_     = 0;
+        GLsync  fence_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
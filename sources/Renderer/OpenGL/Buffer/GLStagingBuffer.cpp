@@ -0,0 +1,68 @@
+/*
+ * GLStagingBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLStagingBuffer.h"
+#include "GLBuffer.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+
+
+namespace LLGL
+{
+
+
+GLStagingBuffer::GLStagingBuffer()
+{
+    glGenBuffers(1, &id_);
+}
+
+GLStagingBuffer::~GLStagingBuffer()
+{
+    glDeleteBuffers(1, &id_);
+}
+
+void GLStagingBuffer::WriteBuffer(const GLBuffer& bufferGL, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    #ifdef GL_ARB_copy_buffer
+
+    /* Respecify staging storage with the new data and copy it into the buffer range */
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_READ_BUFFER, id_);
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, bufferGL.GetID());
+
+    glBufferData(GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(dataSize), data, GL_STREAM_DRAW);
+
+    glCopyBufferSubData(
+        GL_COPY_READ_BUFFER,
+        GL_COPY_WRITE_BUFFER,
+        0,
+        static_cast<GLintptr>(offset),
+        static_cast<GLsizeiptr>(dataSize)
+    );
+
+    GLStateManager::active->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, 0);
+
+    #endif
+}
+
+void GLStagingBuffer::BeginWriteTexture(const void* data, std::size_t dataSize)
+{
+    /* Respecify staging storage with the new image data */
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, id_);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(dataSize), data, GL_STREAM_DRAW);
+}
+
+void GLStagingBuffer::EndWriteTexture()
+{
+    GLStateManager::active->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
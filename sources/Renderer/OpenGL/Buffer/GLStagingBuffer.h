@@ -0,0 +1,58 @@
+/*
+ * GLStagingBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STAGING_BUFFER_H
+#define LLGL_GL_STAGING_BUFFER_H
+
+
+#include "../OpenGL.h"
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class GLBuffer;
+
+/*
+Staging buffer for asynchronous uploads (see RenderSystem::WriteBufferAsync and RenderSystem::WriteTextureAsync).
+The buffer storage is respecified with each upload, so the driver takes new storage from its pool while the GPU still copies from
+the previous storage, instead of waiting for the GPU. The copies from the staging buffer are scheduled in the GL command stream.
+*/
+class GLStagingBuffer
+{
+
+    public:
+
+        GLStagingBuffer();
+        ~GLStagingBuffer();
+
+        // Copies the data into new storage and schedules the copy into the specified buffer range (requires GL_ARB_copy_buffer).
+        void WriteBuffer(const GLBuffer& bufferGL, const void* data, std::size_t dataSize, std::size_t offset);
+
+        // Copies the image data into new storage and binds this staging buffer as pixel unpack buffer, so image data pointers become offsets.
+        void BeginWriteTexture(const void* data, std::size_t dataSize);
+
+        // Unbinds the pixel unpack buffer, otherwise all following pixel transfers would refer to this staging buffer.
+        void EndWriteTexture();
+
+    private:
+
+        GLuint id_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,53 @@
+/*
+ * GLStorageBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLStorageBuffer.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+
+
+namespace LLGL
+{
+
+
+GLStorageBuffer::GLStorageBuffer(const StorageBufferType storageType, GLuint id) :
+    GLBuffer { BufferType::Storage, id }
+{
+    if (HasCounter(storageType))
+    {
+        /* Create atomic counter buffer, which is initialized with zero */
+        const GLuint initialValue = 0;
+        glGenBuffers(1, &counterID_);
+        GLStateManager::active->BindBuffer(GLBufferTarget::ATOMIC_COUNTER_BUFFER, counterID_);
+        glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(initialValue), &initialValue, GL_DYNAMIC_COPY);
+    }
+}
+
+GLStorageBuffer::~GLStorageBuffer()
+{
+    if (counterID_ != 0)
+        glDeleteBuffers(1, &counterID_);
+}
+
+void GLStorageBuffer::ResetCounter(GLStateManager& stateMngr, GLuint value)
+{
+    stateMngr.BindBuffer(GLBufferTarget::ATOMIC_COUNTER_BUFFER, counterID_);
+    glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(value), &value);
+}
+
+bool GLStorageBuffer::HasCounter(const StorageBufferType storageType)
+{
+    return ( storageType == StorageBufferType::AppendStructuredBuffer ||
+             storageType == StorageBufferType::ConsumeStructuredBuffer );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,60 @@
+/*
+ * GLStorageBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STORAGE_BUFFER_H
+#define LLGL_GL_STORAGE_BUFFER_H
+
+
+#include "GLBuffer.h"
+#include <LLGL/BufferFlags.h>
+
+
+namespace LLGL
+{
+
+
+class GLStateManager;
+
+/*
+Shader storage buffer, which owns an additional atomic counter buffer for the storage types with a hidden counter
+(i.e. StorageBufferType::AppendStructuredBuffer and StorageBufferType::ConsumeStructuredBuffer).
+*/
+class GLStorageBuffer : public GLBuffer
+{
+
+    public:
+
+        GLStorageBuffer(const StorageBufferType storageType, GLuint id = 0);
+        ~GLStorageBuffer();
+
+        //! Writes the specified value into the atomic counter buffer.
+        void ResetCounter(GLStateManager& stateMngr, GLuint value);
+
+        //! Returns true if the specified storage type has a hidden counter.
+        static bool HasCounter(const StorageBufferType storageType);
+
+        //! Returns the ID of the atomic counter buffer, or 0 if this storage buffer has no counter.
+        inline GLuint GetCounterID() const
+        {
+            return counterID_;
+        }
+
+    private:
+
+        GLuint counterID_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
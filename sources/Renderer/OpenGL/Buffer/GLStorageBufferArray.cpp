@@ -0,0 +1,36 @@
+/*
+ * GLStorageBufferArray.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLStorageBufferArray.h"
+#include "GLStorageBuffer.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+
+
+namespace LLGL
+{
+
+
+GLStorageBufferArray::GLStorageBufferArray(unsigned int numBuffers, Buffer* const * bufferArray) :
+    GLBufferArray { BufferType::Storage, numBuffers, bufferArray }
+{
+    /* Store the counter ID of each GLStorageBuffer inside the array */
+    counterIDArray_.reserve(numBuffers);
+    while (auto next = NextArrayResource<GLStorageBuffer>(numBuffers, bufferArray))
+    {
+        counterIDArray_.push_back(next->GetCounterID());
+        if (next->GetCounterID() != 0)
+            hasCounters_ = true;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
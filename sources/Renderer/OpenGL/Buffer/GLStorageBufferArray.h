@@ -0,0 +1,53 @@
+/*
+ * GLStorageBufferArray.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STORAGE_BUFFER_ARRAY_H
+#define LLGL_GL_STORAGE_BUFFER_ARRAY_H
+
+
+#include "GLBufferArray.h"
+
+
+namespace LLGL
+{
+
+
+class GLStorageBufferArray : public GLBufferArray
+{
+
+    public:
+
+        GLStorageBufferArray(unsigned int numBuffers, Buffer* const * bufferArray);
+
+        //! Returns the array of atomic counter buffer IDs, which contains 0 for each storage buffer without counter.
+        inline const std::vector<GLuint>& GetCounterIDArray() const
+        {
+            return counterIDArray_;
+        }
+
+        //! Returns true if any storage buffer of this array has a counter.
+        inline bool HasCounters() const
+        {
+            return hasCounters_;
+        }
+
+    private:
+
+        std::vector<GLuint> counterIDArray_;
+        bool                hasCounters_    = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
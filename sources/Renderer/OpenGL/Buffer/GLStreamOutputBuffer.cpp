@@ -0,0 +1,35 @@
+/*
+ * GLStreamOutputBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLStreamOutputBuffer.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionLoader.h"
+
+
+namespace LLGL
+{
+
+
+GLStreamOutputBuffer::GLStreamOutputBuffer(GLuint id) :
+    GLVertexBuffer { BufferType::StreamOutput, id }
+{
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glGenTransformFeedbacks(1, &transformFeedbackID_);
+}
+
+GLStreamOutputBuffer::~GLStreamOutputBuffer()
+{
+    if (transformFeedbackID_ != 0)
+        glDeleteTransformFeedbacks(1, &transformFeedbackID_);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,52 @@
+/*
+ * GLStreamOutputBuffer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STREAM_OUTPUT_BUFFER_H
+#define LLGL_GL_STREAM_OUTPUT_BUFFER_H
+
+
+#include "GLVertexBuffer.h"
+
+
+namespace LLGL
+{
+
+
+/*
+Stream-output buffer with its own transform feedback object (GL_ARB_transform_feedback2),
+which records the number of captured vertices for "glDrawTransformFeedback".
+The VAO is only built, if the buffer has a vertex format, i.e. if it can be drawn as vertex buffer.
+*/
+class GLStreamOutputBuffer : public GLVertexBuffer
+{
+
+    public:
+
+        GLStreamOutputBuffer(GLuint id = 0);
+        ~GLStreamOutputBuffer();
+
+        //! Returns the ID of the transform feedback object, or 0 if GL_ARB_transform_feedback2 is not supported.
+        inline GLuint GetTransformFeedbackID() const
+        {
+            return transformFeedbackID_;
+        }
+
+    private:
+
+        GLuint transformFeedbackID_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,29 @@
+/*
+ * GLStreamOutputBufferArray.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLStreamOutputBufferArray.h"
+#include "GLStreamOutputBuffer.h"
+#include "../../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+GLStreamOutputBufferArray::GLStreamOutputBufferArray(unsigned int numBuffers, Buffer* const * bufferArray) :
+    GLBufferArray { BufferType::StreamOutput, numBuffers, bufferArray }
+{
+    auto bufferGL = LLGL_CAST(GLStreamOutputBuffer*, bufferArray[0]);
+    transformFeedbackID_ = bufferGL->GetTransformFeedbackID();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
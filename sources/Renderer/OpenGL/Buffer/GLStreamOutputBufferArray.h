@@ -0,0 +1,49 @@
+/*
+ * GLStreamOutputBufferArray.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STREAM_OUTPUT_BUFFER_ARRAY_H
+#define LLGL_GL_STREAM_OUTPUT_BUFFER_ARRAY_H
+
+
+#include "GLBufferArray.h"
+
+
+namespace LLGL
+{
+
+
+class GLStreamOutputBufferArray : public GLBufferArray
+{
+
+    public:
+
+        GLStreamOutputBufferArray(unsigned int numBuffers, Buffer* const * bufferArray);
+
+        /**
+        \brief Returns the ID of the transform feedback object of the first buffer, or 0 if GL_ARB_transform_feedback2 is not supported.
+        \remarks All buffers of the array are bound to this object, so only the first buffer records the number of captured vertices.
+        */
+        inline GLuint GetTransformFeedbackID() const
+        {
+            return transformFeedbackID_;
+        }
+
+    private:
+
+        GLuint transformFeedbackID_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
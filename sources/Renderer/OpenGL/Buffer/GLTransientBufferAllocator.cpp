@@ -0,0 +1,118 @@
+/*
+ * GLTransientBufferAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLTransientBufferAllocator.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+GLTransientBufferAllocator::GLTransientBufferAllocator(unsigned int capacity, unsigned int alignment) :
+    TransientBufferAllocator { capacity, alignment, numSegments },
+    buffer_                  { BufferType::Constant             }
+{
+    auto size = static_cast<GLsizeiptr>(GetCapacity());
+
+    #if defined(GL_ARB_buffer_storage) && defined(GL_ARB_sync)
+    if (HasExtension(GLExt::ARB_buffer_storage) && HasExtension(GLExt::ARB_sync))
+    {
+        GLStateManager::active->BindBuffer(buffer_);
+
+        /* Allocate immutable storage and keep it mapped for the entire lifetime of the buffer */
+        const GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+        glBufferStorage(GL_UNIFORM_BUFFER, size, nullptr, flags);
+        mappedData_ = reinterpret_cast<char*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags));
+    }
+    else
+    #endif
+    {
+        /* Allocate mutable storage which is updated with "glBufferSubData" */
+        buffer_.BufferData(nullptr, size, GL_STREAM_DRAW);
+    }
+}
+
+GLTransientBufferAllocator::~GLTransientBufferAllocator()
+{
+    #ifdef GL_ARB_sync
+    for (auto fence : fences_)
+    {
+        if (fence)
+            glDeleteSync(fence);
+    }
+    #endif
+
+    if (mappedData_)
+        buffer_.UnmapBuffer();
+}
+
+Buffer& GLTransientBufferAllocator::GetBuffer()
+{
+    return buffer_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLTransientBufferAllocator::OnLeaveSegment(unsigned int segment)
+{
+    #ifdef GL_ARB_sync
+    if (mappedData_)
+    {
+        /* Insert fence to track when the GPU no longer references this segment */
+        fences_[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    #endif
+}
+
+void GLTransientBufferAllocator::OnEnterSegment(unsigned int segment)
+{
+    #ifdef GL_ARB_sync
+    if (auto fence = fences_[segment])
+    {
+        /* Wait until the GPU has finished all commands that reference this segment */
+        GLbitfield flags = 0;
+        GLuint64 timeout = 0;
+
+        while (glClientWaitSync(fence, flags, timeout) == GL_TIMEOUT_EXPIRED)
+        {
+            flags   = GL_SYNC_FLUSH_COMMANDS_BIT;
+            timeout = 1000000; // 1 ms
+        }
+
+        glDeleteSync(fence);
+        fences_[segment] = 0;
+    }
+    #endif
+}
+
+void GLTransientBufferAllocator::WriteRange(const void* data, unsigned int size, unsigned int offset)
+{
+    if (mappedData_)
+    {
+        /* Write directly into persistently mapped memory */
+        ::memcpy(mappedData_ + offset, data, size);
+    }
+    else
+    {
+        /* Update buffer range */
+        buffer_.BufferSubData(data, static_cast<GLsizeiptr>(size), static_cast<GLintptr>(offset));
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
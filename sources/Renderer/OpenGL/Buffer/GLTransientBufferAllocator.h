@@ -0,0 +1,58 @@
+/*
+ * GLTransientBufferAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_TRANSIENT_BUFFER_ALLOCATOR_H
+#define LLGL_GL_TRANSIENT_BUFFER_ALLOCATOR_H
+
+
+#include "../../TransientBufferAllocator.h"
+#include "GLBuffer.h"
+
+
+namespace LLGL
+{
+
+
+/*
+Ring buffer for transient constant buffer ranges.
+If GL_ARB_buffer_storage and GL_ARB_sync are supported, the buffer is persistently mapped
+and each segment is guarded by a fence; otherwise the ranges are updated with "glBufferSubData".
+*/
+class GLTransientBufferAllocator : public TransientBufferAllocator
+{
+
+    public:
+
+        GLTransientBufferAllocator(unsigned int capacity, unsigned int alignment);
+        ~GLTransientBufferAllocator();
+
+        Buffer& GetBuffer() override;
+
+    private:
+
+        static const unsigned int numSegments = 4;
+
+        void OnLeaveSegment(unsigned int segment) override;
+        void OnEnterSegment(unsigned int segment) override;
+
+        void WriteRange(const void* data, unsigned int size, unsigned int offset) override;
+
+        GLBuffer    buffer_;
+        char*       mappedData_             = nullptr;
+        GLsync      fences_[numSegments]    = {};
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,93 @@
+/*
+ * GLVertexArrayCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLVertexArrayCache.h"
+#include "../RenderState/GLStateManager.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+#include "../../../Core/Helper.h"
+
+
+namespace LLGL
+{
+
+
+// Returns true if the specified vertex attributes have the same format (the names are irrelevant for the VAO).
+static bool IsAttributeFormatEqual(const VertexAttribute& lhs, const VertexAttribute& rhs)
+{
+    return
+    (
+        lhs.vectorType      == rhs.vectorType       &&
+        lhs.instanceDivisor == rhs.instanceDivisor  &&
+        lhs.conversion      == rhs.conversion       &&
+        lhs.offset          == rhs.offset
+    );
+}
+
+static bool IsBindingFormatEqual(const std::vector<VertexAttribute>& lhs, const std::vector<VertexAttribute>& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (!IsAttributeFormatEqual(lhs[i], rhs[i]))
+            return false;
+    }
+
+    return true;
+}
+
+bool GLVertexArrayCache::IsSupported()
+{
+    return HasExtension(GLExt::ARB_vertex_attrib_binding);
+}
+
+GLVertexArrayObject* GLVertexArrayCache::FindOrCreate(const std::vector<const VertexFormat*>& vertexFormats)
+{
+    /* Find VAO with compatible vertex formats */
+    for (const auto& entry : entries_)
+    {
+        if (entry.bindings.size() == vertexFormats.size())
+        {
+            std::size_t i = 0;
+            while (i < vertexFormats.size() && IsBindingFormatEqual(entry.bindings[i], vertexFormats[i]->attributes))
+                ++i;
+
+            if (i == vertexFormats.size())
+                return entry.vao.get();
+        }
+    }
+
+    /* Create new VAO and build the attribute formats for each vertex buffer binding */
+    Entry entry;
+    entry.vao = MakeUnique<GLVertexArrayObject>();
+
+    GLStateManager::active->BindVertexArray(entry.vao->GetID());
+    {
+        unsigned int index = 0;
+
+        for (unsigned int bindingIndex = 0; bindingIndex < vertexFormats.size(); ++bindingIndex)
+        {
+            const auto& attributes = vertexFormats[bindingIndex]->attributes;
+            for (const auto& attrib : attributes)
+                entry.vao->BuildVertexAttributeFormat(attrib, bindingIndex, index++);
+            entry.bindings.push_back(attributes);
+        }
+    }
+    GLStateManager::active->BindVertexArray(0);
+
+    entries_.push_back(std::move(entry));
+
+    return entries_.back().vao.get();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
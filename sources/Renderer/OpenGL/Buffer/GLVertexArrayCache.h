@@ -0,0 +1,61 @@
+/*
+ * GLVertexArrayCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_VERTEX_ARRAY_CACHE_H
+#define LLGL_GL_VERTEX_ARRAY_CACHE_H
+
+
+#include "GLVertexArrayObject.h"
+#include <memory>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Cache for format-only vertex-array-objects (VAO), which are shared between all vertex buffers with the same vertex format.
+This is only used when GL_ARB_vertex_attrib_binding is supported. The vertex buffers are then attached to the VAO at binding time,
+so switching between meshes of the same vertex format does not require a VAO switch.
+*/
+class GLVertexArrayCache
+{
+
+    public:
+
+        // Returns true if format-only VAOs are supported, i.e. GL_ARB_vertex_attrib_binding is available.
+        static bool IsSupported();
+
+        /*
+        Returns the VAO for the specified vertex formats, where each format corresponds to one vertex buffer binding.
+        The VAO is created if there is no VAO with compatible vertex formats yet. The stride of the formats is ignored,
+        since it is specified when the vertex buffers are bound.
+        */
+        GLVertexArrayObject* FindOrCreate(const std::vector<const VertexFormat*>& vertexFormats);
+
+    private:
+
+        struct Entry
+        {
+            std::vector<std::vector<VertexAttribute>>   bindings;
+            std::unique_ptr<GLVertexArrayObject>        vao;
+        };
+
+        std::vector<Entry> entries_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
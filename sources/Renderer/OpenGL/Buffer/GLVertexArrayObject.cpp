@@ -17,6 +17,12 @@ namespace LLGL
 {
 
 
+// Returns GL_TRUE if the specified vector type is read as normalized fixed-point vector.
+static GLboolean IsNormalizedVectorType(const VectorType vectorType)
+{
+    return (IsCompactVectorType(vectorType) && vectorType != VectorType::Half2 && vectorType != VectorType::Half4 ? GL_TRUE : GL_FALSE);
+}
+
 GLVertexArrayObject::GLVertexArrayObject()
 {
     glGenVertexArrays(1, &id_);
@@ -27,7 +33,7 @@ GLVertexArrayObject::~GLVertexArrayObject()
     glDeleteVertexArrays(1, &id_);
 }
 
-void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute, unsigned int stride, unsigned int index)
+void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute, unsigned int stride, unsigned int index, GLintptr baseOffset)
 {
     /* Enable array index in currently bound VAO */
     glEnableVertexAttribArray(index);
@@ -42,10 +48,10 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute,
     VectorTypeFormat(attribute.vectorType, dataType, components);
 
     /* Convert offset to pointer sized type (for 32- and 64 bit builds */
-    std::size_t offsetPtrSized = attribute.offset;
+    std::size_t offsetPtrSized = static_cast<std::size_t>(baseOffset) + attribute.offset;
 
     /* Use currently bound VBO for VertexAttribPointer functions */
-    if (!attribute.conversion && dataType != DataType::Float && dataType != DataType::Double)
+    if (!attribute.conversion && !IsCompactVectorType(attribute.vectorType) && dataType != DataType::Float && dataType != DataType::Double)
     {
         if (!HasExtension(GLExt::EXT_gpu_shader4))
             ThrowNotSupported("integral vertex attributes");
@@ -63,14 +69,64 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute,
         glVertexAttribPointer(
             index,
             components,
-            GLTypes::Map(dataType),
-            GL_FALSE,
+            GLTypes::Map(attribute.vectorType),
+            IsNormalizedVectorType(attribute.vectorType),
             stride,
             reinterpret_cast<const void*>(offsetPtrSized)
         );
     }
 }
 
+void GLVertexArrayObject::BuildVertexAttributeFormat(const VertexAttribute& attribute, unsigned int bindingIndex, unsigned int index)
+{
+    #ifdef GL_ARB_vertex_attrib_binding
+
+    /* Enable array index in currently bound VAO */
+    glEnableVertexAttribArray(index);
+
+    /* Set instance divisor for the entire vertex buffer binding */
+    if (attribute.instanceDivisor > 0)
+        glVertexBindingDivisor(bindingIndex, attribute.instanceDivisor);
+
+    /* Get data type and components of vector type */
+    DataType        dataType    = DataType::Float;
+    unsigned int    components  = 0;
+    VectorTypeFormat(attribute.vectorType, dataType, components);
+
+    /* Specify attribute format relative to the vertex buffer binding */
+    if (!attribute.conversion && !IsCompactVectorType(attribute.vectorType) && dataType != DataType::Float && dataType != DataType::Double)
+    {
+        if (!HasExtension(GLExt::EXT_gpu_shader4))
+            ThrowNotSupported("integral vertex attributes");
+
+        glVertexAttribIFormat(
+            index,
+            components,
+            GLTypes::Map(dataType),
+            attribute.offset
+        );
+    }
+    else
+    {
+        glVertexAttribFormat(
+            index,
+            components,
+            GLTypes::Map(attribute.vectorType),
+            IsNormalizedVectorType(attribute.vectorType),
+            attribute.offset
+        );
+    }
+
+    /* Assign attribute to vertex buffer binding */
+    glVertexAttribBinding(index, bindingIndex);
+
+    #else
+
+    ThrowNotSupported("GL_ARB_vertex_attrib_binding");
+
+    #endif
+}
+
 
 } // /namespace LLGL
 
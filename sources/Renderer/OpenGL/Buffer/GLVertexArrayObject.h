@@ -25,7 +25,14 @@ class GLVertexArrayObject
         GLVertexArrayObject();
         ~GLVertexArrayObject();
 
-        void BuildVertexAttribute(const VertexAttribute& attribute, unsigned int stride, unsigned int index);
+        //! Builds the specified vertex attribute for the currently bound VBO, whose vertices start at the specified byte offset.
+        void BuildVertexAttribute(const VertexAttribute& attribute, unsigned int stride, unsigned int index, GLintptr baseOffset = 0);
+
+        /**
+        \brief Builds only the format of the specified vertex attribute and assigns it to the specified vertex buffer binding.
+        \remarks This requires GL_ARB_vertex_attrib_binding. The vertex buffers are then bound with "glBindVertexBuffer(s)".
+        */
+        void BuildVertexAttributeFormat(const VertexAttribute& attribute, unsigned int bindingIndex, unsigned int index);
 
         //! Returns the ID of the hardware vertex-array-object (VAO)
         inline GLuint GetID() const
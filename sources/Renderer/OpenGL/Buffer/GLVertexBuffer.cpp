@@ -7,35 +7,75 @@
 
 #include "GLVertexBuffer.h"
 #include "../RenderState/GLStateManager.h"
+#include "../../../Core/Helper.h"
 
 
 namespace LLGL
 {
 
 
-GLVertexBuffer::GLVertexBuffer() :
-    GLBuffer { BufferType::Vertex }
+GLVertexBuffer::GLVertexBuffer(GLuint id) :
+    GLBuffer { BufferType::Vertex, id }
 {
 }
 
-void GLVertexBuffer::BuildVertexArray(const VertexFormat& vertexFormat)
+GLVertexBuffer::GLVertexBuffer(const BufferType type, GLuint id) :
+    GLBuffer { type, id }
 {
-    /* Bind VAO */
-    GLStateManager::active->BindVertexArray(GetVaoID());
+}
+
+void GLVertexBuffer::BuildVertexArray(const VertexFormat& vertexFormat, GLVertexArrayCache* vaoCache)
+{
+    if (vaoCache != nullptr && GLVertexArrayCache::IsSupported())
     {
-        /* Bind VBO */
-        GLStateManager::active->BindBuffer(GLBufferTarget::ARRAY_BUFFER, GetID());
+        /* Share format-only VAO with all vertex buffers of the same format */
+        vao_        = vaoCache->FindOrCreate({ &vertexFormat });
+        sharedVao_  = true;
+    }
+    else
+    {
+        ownVao_     = MakeUnique<GLVertexArrayObject>();
+        vao_        = ownVao_.get();
+        sharedVao_  = false;
+
+        /* Bind VAO */
+        GLStateManager::active->BindVertexArray(GetVaoID());
+        {
+            /* Bind VBO */
+            GLStateManager::active->BindBuffer(GLBufferTarget::ARRAY_BUFFER, GetID());
 
-        /* Build each vertex attribute */
-        for (unsigned int i = 0, n = static_cast<unsigned int>(vertexFormat.attributes.size()); i < n; ++i)
-            vao_.BuildVertexAttribute(vertexFormat.attributes[i], vertexFormat.stride, i);
+            /* Build each vertex attribute */
+            for (unsigned int i = 0, n = static_cast<unsigned int>(vertexFormat.attributes.size()); i < n; ++i)
+                vao_->BuildVertexAttribute(vertexFormat.attributes[i], vertexFormat.stride, i);
+        }
+        GLStateManager::active->BindVertexArray(0);
     }
-    GLStateManager::active->BindVertexArray(0);
 
     /* Store vertex format (required if this buffer is used in a buffer array) */
     vertexFormat_ = vertexFormat;
 }
 
+void GLVertexBuffer::Bind(GLStateManager& stateMngr, GLintptr offset) const
+{
+    stateMngr.BindVertexArray(GetVaoID());
+
+    if (sharedVao_)
+    {
+        /* Attach this buffer to the shared VAO */
+        const GLuint    buffer  = GetID();
+        const GLsizei   stride  = static_cast<GLsizei>(vertexFormat_.stride);
+        stateMngr.BindVertexBuffers(0, 1, &buffer, &offset, &stride);
+    }
+    else if (vaoOffset_ != offset)
+    {
+        /* Re-specify vertex attributes of the own VAO relative to the new offset */
+        stateMngr.BindBuffer(GLBufferTarget::ARRAY_BUFFER, GetID());
+        for (unsigned int i = 0, n = static_cast<unsigned int>(vertexFormat_.attributes.size()); i < n; ++i)
+            vao_->BuildVertexAttribute(vertexFormat_.attributes[i], vertexFormat_.stride, i, offset);
+        vaoOffset_ = offset;
+    }
+}
+
 
 } // /namespace LLGL
 
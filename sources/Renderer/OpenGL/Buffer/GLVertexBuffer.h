@@ -10,26 +10,40 @@
 
 
 #include "GLBuffer.h"
-#include "GLVertexArrayObject.h"
+#include "GLVertexArrayCache.h"
+#include <memory>
 
 
 namespace LLGL
 {
 
 
+class GLStateManager;
+
 class GLVertexBuffer : public GLBuffer
 {
 
     public:
 
-        GLVertexBuffer();
+        GLVertexBuffer(GLuint id = 0);
+
+        /**
+        \brief Builds the vertex-array-object (VAO) for the specified vertex format.
+        \remarks If the VAO cache is non-null and supported, this buffer shares a format-only VAO with all other buffers of the same format.
+        Otherwise, an own VAO is built which references this buffer.
+        */
+        void BuildVertexArray(const VertexFormat& vertexFormat, GLVertexArrayCache* vaoCache = nullptr);
 
-        void BuildVertexArray(const VertexFormat& vertexFormat);
+        /**
+        \brief Binds the VAO and, if the VAO is shared, attaches this buffer to binding point 0 at the specified offset.
+        \remarks If the VAO is not shared, its vertex attributes are re-specified whenever the offset differs from the previous binding.
+        */
+        void Bind(GLStateManager& stateMngr, GLintptr offset = 0) const;
 
         //! Returns the ID of the vertex-array-object (VAO)
         inline GLuint GetVaoID() const
         {
-            return vao_.GetID();
+            return vao_->GetID();
         }
 
         //! Returns the vertex format.
@@ -38,10 +52,17 @@ class GLVertexBuffer : public GLBuffer
             return vertexFormat_;
         }
 
+    protected:
+
+        GLVertexBuffer(const BufferType type, GLuint id = 0);
+
     private:
 
-        GLVertexArrayObject vao_;
-        VertexFormat        vertexFormat_;
+        std::unique_ptr<GLVertexArrayObject>    ownVao_;
+        GLVertexArrayObject*                    vao_        = nullptr;
+        bool                                    sharedVao_  = false;
+        mutable GLintptr                        vaoOffset_  = 0;
+        VertexFormat                            vertexFormat_;
 
 };
 
@@ -9,6 +9,7 @@
 #include "GLVertexBuffer.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
 
 
 namespace LLGL
@@ -20,8 +21,36 @@ GLVertexBufferArray::GLVertexBufferArray() :
 {
 }
 
-void GLVertexBufferArray::BuildVertexArray(unsigned int numBuffers, Buffer* const * bufferArray)
+void GLVertexBufferArray::BuildVertexArray(unsigned int numBuffers, Buffer* const * bufferArray, GLVertexArrayCache* vaoCache)
 {
+    if (vaoCache != nullptr && GLVertexArrayCache::IsSupported())
+    {
+        /* Store buffer IDs and strides for the vertex buffer bindings */
+        BuildArray(numBuffers, bufferArray);
+
+        std::vector<const VertexFormat*> vertexFormats;
+        vertexFormats.reserve(numBuffers);
+
+        for (unsigned int i = 0; i < numBuffers; ++i)
+        {
+            auto vertexBufferGL = LLGL_CAST(GLVertexBuffer*, bufferArray[i]);
+            const auto& vertexFormat = vertexBufferGL->GetVertexFormat();
+            vertexFormats.push_back(&vertexFormat);
+            strides_.push_back(static_cast<GLsizei>(vertexFormat.stride));
+        }
+
+        offsets_.resize(numBuffers, 0);
+
+        /* Share format-only VAO with all vertex buffer arrays of the same formats */
+        vao_        = vaoCache->FindOrCreate(vertexFormats);
+        sharedVao_  = true;
+        return;
+    }
+
+    ownVao_     = MakeUnique<GLVertexArrayObject>();
+    vao_        = ownVao_.get();
+    sharedVao_  = false;
+
     /* Bind VAO */
     GLStateManager::active->BindVertexArray(GetVaoID());
     {
@@ -36,7 +65,7 @@ void GLVertexBufferArray::BuildVertexArray(unsigned int numBuffers, Buffer* cons
 
                 /* Build each vertex attribute */
                 for (unsigned int j = 0, n = static_cast<unsigned int>(vertexFormat.attributes.size()); j < n; ++j, ++i)
-                    vao_.BuildVertexAttribute(vertexFormat.attributes[j], vertexFormat.stride, i);
+                    vao_->BuildVertexAttribute(vertexFormat.attributes[j], vertexFormat.stride, i);
             }
             ++bufferArray;
         }
@@ -44,6 +73,24 @@ void GLVertexBufferArray::BuildVertexArray(unsigned int numBuffers, Buffer* cons
     GLStateManager::active->BindVertexArray(0);
 }
 
+void GLVertexBufferArray::Bind(GLStateManager& stateMngr) const
+{
+    stateMngr.BindVertexArray(GetVaoID());
+
+    /* Attach all buffers to the shared VAO */
+    if (sharedVao_)
+    {
+        const auto& idArray = GetIDArray();
+        stateMngr.BindVertexBuffers(
+            0,
+            static_cast<GLsizei>(idArray.size()),
+            idArray.data(),
+            offsets_.data(),
+            strides_.data()
+        );
+    }
+}
+
 
 } // /namespace LLGL
 
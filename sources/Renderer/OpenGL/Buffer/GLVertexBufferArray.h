@@ -10,13 +10,17 @@
 
 
 #include "GLBufferArray.h"
-#include "GLVertexArrayObject.h"
+#include "GLVertexArrayCache.h"
+#include <memory>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class GLStateManager;
+
 class GLVertexBufferArray : public GLBufferArray
 {
 
@@ -24,17 +28,29 @@ class GLVertexBufferArray : public GLBufferArray
 
         GLVertexBufferArray();
 
-        void BuildVertexArray(unsigned int numBuffers, Buffer* const * bufferArray);
+        /**
+        \brief Builds the vertex-array-object (VAO) for the vertex formats of all specified vertex buffers.
+        \remarks If the VAO cache is non-null and supported, this buffer array shares a format-only VAO with all other buffer arrays of the same formats.
+        */
+        void BuildVertexArray(unsigned int numBuffers, Buffer* const * bufferArray, GLVertexArrayCache* vaoCache = nullptr);
+
+        //! Binds the VAO and, if the VAO is shared, attaches all buffers of this array to the binding points 0 to N-1.
+        void Bind(GLStateManager& stateMngr) const;
 
         //! Returns the ID of the vertex-array-object (VAO)
         inline GLuint GetVaoID() const
         {
-            return vao_.GetID();
+            return vao_->GetID();
         }
 
     private:
 
-        GLVertexArrayObject vao_;
+        std::unique_ptr<GLVertexArrayObject>    ownVao_;
+        GLVertexArrayObject*                    vao_        = nullptr;
+        bool                                    sharedVao_  = false;
+
+        std::vector<GLintptr>                   offsets_;
+        std::vector<GLsizei>                    strides_;
 
 };
 
@@ -8,8 +8,9 @@
 #include "GLExtensionLoader.h"
 #include "GLExtensions.h"
 #include "GLExtensionsNull.h"
-#include <LLGL/Log.h>
-#include <functional>
+#include "../../../Core/HelperMacros.h"
+#include <cstring>
+#include <string>
 
 
 namespace LLGL
@@ -30,34 +31,166 @@ bool LoadGLProc(T& procAddr, const char* procName)
     #elif defined(__linux__)
     procAddr = reinterpret_cast<T>(glXGetProcAddress(reinterpret_cast<const GLubyte*>(procName)));
     #else
-    Log::StdErr() << "OS not supported for loading OpenGL extensions" << std::endl;
+    LLGL_LOG(Error, "OS not supported for loading OpenGL extensions");
     return false;
     #endif
     
     /* Check for errors */
     if (!procAddr)
     {
-        Log::StdErr() << "failed to load OpenGL procedure: " << procName << std::endl;
+        LLGL_LOG(Error, "failed to load OpenGL procedure: " << procName);
         return false;
     }
     
     return true;
 }
 
-static void ExtractExtensionsFromString(GLExtensionList& extensions, const std::string& extString)
+/* --- Extension name table --- */
+
+struct GLExtensionName
 {
-    size_t first = 0, last = 0;
-    
-    /* Find next extension name in string */
-    while ( ( last = extString.find(' ', first) ) != std::string::npos )
+    const char* name;
+    GLExt       extension;
+};
+
+#define GLEXT_NAME(NAME) { "GL_" #NAME, GLExt::NAME }
+
+static const GLExtensionName g_extensionNames[] =
+{
+    GLEXT_NAME( EXT_blend_func_separate          ),
+    GLEXT_NAME( EXT_blend_minmax                 ),
+    GLEXT_NAME( EXT_blend_color                  ),
+    GLEXT_NAME( EXT_blend_equation_separate      ),
+    GLEXT_NAME( ARB_draw_buffers                 ),
+    GLEXT_NAME( EXT_draw_buffers2                ),
+    GLEXT_NAME( ARB_draw_buffers_blend           ),
+    GLEXT_NAME( ARB_multitexture                 ),
+    GLEXT_NAME( EXT_texture3D                    ),
+    GLEXT_NAME( ARB_clear_texture                ),
+    GLEXT_NAME( ARB_texture_compression          ),
+    GLEXT_NAME( ARB_texture_multisample          ),
+    GLEXT_NAME( ARB_sampler_objects              ),
+    GLEXT_NAME( ARB_multi_bind                   ),
+    GLEXT_NAME( ARB_vertex_buffer_object         ),
+    GLEXT_NAME( ARB_instanced_arrays             ),
+    GLEXT_NAME( ARB_vertex_array_object          ),
+    GLEXT_NAME( ARB_vertex_attrib_binding        ),
+    GLEXT_NAME( ARB_framebuffer_object           ),
+    GLEXT_NAME( ARB_invalidate_subdata           ),
+    GLEXT_NAME( ARB_draw_instanced               ),
+    GLEXT_NAME( ARB_draw_elements_base_vertex    ),
+    GLEXT_NAME( EXT_multi_draw_arrays            ),
+    GLEXT_NAME( ARB_base_instance                ),
+    GLEXT_NAME( ARB_draw_indirect                ),
+    GLEXT_NAME( ARB_multi_draw_indirect          ),
+    GLEXT_NAME( ARB_shader_objects               ),
+    GLEXT_NAME( ARB_tessellation_shader          ),
+    GLEXT_NAME( ARB_compute_shader               ),
+    GLEXT_NAME( ARB_shader_image_load_store      ),
+    GLEXT_NAME( ARB_get_program_binary           ),
+    GLEXT_NAME( ARB_shader_subroutine            ),
+    GLEXT_NAME( ARB_separate_shader_objects      ),
+    GLEXT_NAME( ARB_parallel_shader_compile      ),
+    GLEXT_NAME( ARB_gl_spirv                     ),
+    GLEXT_NAME( ARB_program_interface_query      ),
+    GLEXT_NAME( ARB_uniform_buffer_object        ),
+    GLEXT_NAME( ARB_shader_storage_buffer_object ),
+    GLEXT_NAME( ARB_map_buffer_range             ),
+    GLEXT_NAME( ARB_buffer_storage               ),
+    GLEXT_NAME( ARB_sync                         ),
+    GLEXT_NAME( ARB_copy_buffer                  ),
+    GLEXT_NAME( ARB_copy_image                   ),
+    GLEXT_NAME( ARB_texture_storage              ),
+    GLEXT_NAME( ARB_texture_storage_multisample  ),
+    GLEXT_NAME( ARB_texture_view                 ),
+    GLEXT_NAME( ARB_internalformat_query         ),
+    GLEXT_NAME( ARB_sparse_texture               ),
+    GLEXT_NAME( ARB_direct_state_access          ),
+    GLEXT_NAME( ARB_occlusion_query              ),
+    GLEXT_NAME( NV_conditional_render            ),
+    GLEXT_NAME( ARB_timer_query                  ),
+    GLEXT_NAME( ARB_viewport_array               ),
+    GLEXT_NAME( EXT_stencil_two_side             ),
+    GLEXT_NAME( KHR_debug                        ),
+    GLEXT_NAME( ARB_clip_control                 ),
+    GLEXT_NAME( EXT_transform_feedback           ),
+    GLEXT_NAME( NV_transform_feedback            ),
+    GLEXT_NAME( ARB_transform_feedback2          ),
+    GLEXT_NAME( EXT_gpu_shader4                  ),
+    GLEXT_NAME( ARB_bindless_texture             ),
+    GLEXT_NAME( NV_shading_rate_image            ),
+    GLEXT_NAME( OVR_multiview                    ),
+    GLEXT_NAME( NV_mesh_shader                   ),
+    GLEXT_NAME( EXT_depth_bounds_test            ),
+    GLEXT_NAME( ARB_texture_cube_map             ),
+    GLEXT_NAME( EXT_texture_array                ),
+    GLEXT_NAME( ARB_texture_cube_map_array       ),
+    GLEXT_NAME( ARB_geometry_shader4             ),
+    GLEXT_NAME( NV_conservative_raster           ),
+    GLEXT_NAME( INTEL_conservative_rasterization ),
+    GLEXT_NAME( ARB_query_buffer_object          ),
+    GLEXT_NAME( ARB_pipeline_statistics_query    ),
+    GLEXT_NAME( ARB_transform_feedback3          ),
+    GLEXT_NAME( ARB_shader_atomic_counters       ),
+    GLEXT_NAME( NVX_gpu_memory_info              ),
+    GLEXT_NAME( ATI_meminfo                      ),
+    GLEXT_NAME( OVR_multiview2                   ),
+    GLEXT_NAME( ARB_shader_viewport_layer_array  ),
+    GLEXT_NAME( AMD_vertex_shader_layer          ),
+    GLEXT_NAME( KHR_shader_subgroup              ),
+    GLEXT_NAME( NV_shader_thread_group           ),
+};
+
+#undef GLEXT_NAME
+
+// Returns the extension with the specified name (which is not null-terminated), or GLExt::Count if the extension is unknown.
+static GLExt FindExtension(const char* name, std::size_t length)
+{
+    for (const auto& entry : g_extensionNames)
     {
-        /* Store current extension name in hash-map */
-        auto name = extString.substr(first, last - first);
-        extensions[name] = false;
-        first = last + 1;
+        if (std::strncmp(entry.name, name, length) == 0 && entry.name[length] == '\0')
+            return entry.extension;
     }
+    return GLExt::Count;
 }
 
+#ifndef __APPLE__
+
+static const char* GetExtensionName(const GLExt extension)
+{
+    for (const auto& entry : g_extensionNames)
+    {
+        if (entry.extension == extension)
+            return entry.name;
+    }
+    return "";
+}
+
+#endif
+
+static void AddExtension(GLExtensionSet& extensions, const char* name, std::size_t length)
+{
+    auto extension = FindExtension(name, length);
+    if (extension != GLExt::Count)
+        extensions.set(static_cast<std::size_t>(extension));
+}
+
+static void ExtractExtensionsFromString(GLExtensionSet& extensions, const char* extString)
+{
+    /* Find next extension name in string without copying it */
+    while (*extString != '\0')
+    {
+        while (*extString == ' ')
+            ++extString;
+
+        auto first = extString;
+        while (*extString != ' ' && *extString != '\0')
+            ++extString;
+
+        if (extString != first)
+            AddExtension(extensions, first, static_cast<std::size_t>(extString - first));
+    }
+}
 
 #ifndef __APPLE__
 
@@ -93,6 +226,51 @@ bool LoadSwapIntervalProcs()
     #endif
 }
 
+// Returns true if the specified WGL or GLX extension is supported by the current context.
+static bool HasPlatformExtension(const std::string& name)
+{
+    const char* extString = nullptr;
+
+    #if defined(_WIN32)
+    if (wglGetExtensionsStringARB || LoadGLProc(wglGetExtensionsStringARB, "wglGetExtensionsStringARB"))
+        extString = wglGetExtensionsStringARB(wglGetCurrentDC());
+    #elif defined(__linux__)
+    if (auto display = glXGetCurrentDisplay())
+        extString = glXQueryExtensionsString(display, DefaultScreen(display));
+    #endif
+
+    if (extString)
+    {
+        /* Search for the extension name between separating spaces */
+        auto extensions = " " + std::string(extString) + " ";
+        return (extensions.find(" " + name + " ") != std::string::npos);
+    }
+
+    return false;
+}
+
+bool LoadSwapControlTearProcs()
+{
+    #if defined(_WIN32)
+    return (HasPlatformExtension("WGL_EXT_swap_control_tear") && (wglSwapIntervalEXT || LoadSwapIntervalProcs()));
+    #elif defined(__linux__)
+    return (HasPlatformExtension("GLX_EXT_swap_control_tear") && LOAD_GLPROC_SIMPLE(glXSwapIntervalEXT));
+    #else
+    return false;
+    #endif
+}
+
+bool LoadSyncControlProcs()
+{
+    #if defined(_WIN32)
+    return (HasPlatformExtension("WGL_OML_sync_control") && LOAD_GLPROC_SIMPLE(wglGetSyncValuesOML) && LOAD_GLPROC_SIMPLE(wglWaitForMscOML));
+    #elif defined(__linux__)
+    return (HasPlatformExtension("GLX_OML_sync_control") && LOAD_GLPROC_SIMPLE(glXGetSyncValuesOML) && LOAD_GLPROC_SIMPLE(glXWaitForMscOML));
+    #else
+    return false;
+    #endif
+}
+
 bool LoadPixelFormatProcs()
 {
     #if defined(_WIN32)
@@ -140,6 +318,16 @@ static bool Load_GL_ARB_vertex_array_object(bool usePlaceHolder)
     return true;
 }
 
+static bool Load_GL_ARB_vertex_attrib_binding(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glBindVertexBuffer     );
+    LOAD_GLPROC( glVertexAttribFormat   );
+    LOAD_GLPROC( glVertexAttribIFormat  );
+    LOAD_GLPROC( glVertexAttribBinding  );
+    LOAD_GLPROC( glVertexBindingDivisor );
+    return true;
+}
+
 static bool Load_GL_ARB_framebuffer_object(bool usePlaceHolder)
 {
     LOAD_GLPROC( glGenRenderbuffers                    );
@@ -161,6 +349,13 @@ static bool Load_GL_ARB_framebuffer_object(bool usePlaceHolder)
     LOAD_GLPROC( glBlitFramebuffer                     );
     LOAD_GLPROC( glGenerateMipmap                      );
     LOAD_GLPROC( glClearBufferfv                       ); // <--- other extension! (but which one???)
+    LOAD_GLPROC( glClearBufferfi                       );
+    return true;
+}
+
+static bool Load_GL_ARB_invalidate_subdata(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glInvalidateFramebuffer );
     return true;
 }
 
@@ -169,8 +364,11 @@ static bool Load_GL_ARB_uniform_buffer_object(bool usePlaceHolder)
     LOAD_GLPROC( glGetUniformBlockIndex      );
     LOAD_GLPROC( glGetActiveUniformBlockiv   );
     LOAD_GLPROC( glGetActiveUniformBlockName );
+    LOAD_GLPROC( glGetActiveUniformsiv       );
+    LOAD_GLPROC( glGetActiveUniformName      );
     LOAD_GLPROC( glUniformBlockBinding       );
     LOAD_GLPROC( glBindBufferBase            );
+    LOAD_GLPROC( glBindBufferRange           );
     return true;
 }
 
@@ -201,6 +399,28 @@ static bool Load_GL_ARB_draw_elements_base_vertex(bool usePlaceHolder)
 {
     LOAD_GLPROC( glDrawElementsBaseVertex          );
     LOAD_GLPROC( glDrawElementsInstancedBaseVertex );
+    LOAD_GLPROC( glMultiDrawElementsBaseVertex     );
+    return true;
+}
+
+static bool Load_GL_EXT_multi_draw_arrays(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glMultiDrawArrays   );
+    LOAD_GLPROC( glMultiDrawElements );
+    return true;
+}
+
+static bool Load_GL_ARB_draw_indirect(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glDrawArraysIndirect   );
+    LOAD_GLPROC( glDrawElementsIndirect );
+    return true;
+}
+
+static bool Load_GL_ARB_multi_draw_indirect(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glMultiDrawArraysIndirect   );
+    LOAD_GLPROC( glMultiDrawElementsIndirect );
     return true;
 }
 
@@ -262,6 +482,12 @@ static bool Load_GL_ARB_compute_shader(bool usePlaceHolder)
     return true;
 }
 
+static bool Load_GL_ARB_shader_image_load_store(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glMemoryBarrier );
+    return true;
+}
+
 static bool Load_GL_ARB_get_program_binary(bool usePlaceHolder)
 {
     LOAD_GLPROC( glGetProgramBinary  );
@@ -270,6 +496,40 @@ static bool Load_GL_ARB_get_program_binary(bool usePlaceHolder)
     return true;
 }
 
+static bool Load_GL_ARB_shader_subroutine(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glGetSubroutineUniformLocation );
+    LOAD_GLPROC( glGetSubroutineIndex           );
+    LOAD_GLPROC( glGetProgramStageiv            );
+    LOAD_GLPROC( glUniformSubroutinesuiv        );
+    return true;
+}
+
+static bool Load_GL_ARB_separate_shader_objects(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glUseProgramStages          );
+    LOAD_GLPROC( glActiveShaderProgram       );
+    LOAD_GLPROC( glCreateShaderProgramv      );
+    LOAD_GLPROC( glBindProgramPipeline       );
+    LOAD_GLPROC( glDeleteProgramPipelines    );
+    LOAD_GLPROC( glGenProgramPipelines       );
+    LOAD_GLPROC( glGetProgramPipelineiv      );
+    LOAD_GLPROC( glValidateProgramPipeline   );
+    LOAD_GLPROC( glGetProgramPipelineInfoLog );
+    LOAD_GLPROC( glProgramUniform1iv         );
+    LOAD_GLPROC( glProgramUniform2iv         );
+    LOAD_GLPROC( glProgramUniform3iv         );
+    LOAD_GLPROC( glProgramUniform4iv         );
+    LOAD_GLPROC( glProgramUniform1fv         );
+    LOAD_GLPROC( glProgramUniform2fv         );
+    LOAD_GLPROC( glProgramUniform3fv         );
+    LOAD_GLPROC( glProgramUniform4fv         );
+    LOAD_GLPROC( glProgramUniformMatrix2fv   );
+    LOAD_GLPROC( glProgramUniformMatrix3fv   );
+    LOAD_GLPROC( glProgramUniformMatrix4fv   );
+    return true;
+}
+
 static bool Load_GL_ARB_program_interface_query(bool usePlaceHolder)
 {
     LOAD_GLPROC( glGetProgramInterfaceiv           );
@@ -281,6 +541,23 @@ static bool Load_GL_ARB_program_interface_query(bool usePlaceHolder)
     return true;
 }
 
+static bool Load_GL_ARB_parallel_shader_compile(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glMaxShaderCompilerThreadsARB );
+    return true;
+}
+
+#ifdef GL_ARB_gl_spirv
+
+static bool Load_GL_ARB_gl_spirv(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glShaderBinary        );
+    LOAD_GLPROC( glSpecializeShaderARB );
+    return true;
+}
+
+#endif
+
 static bool Load_GL_EXT_gpu_shader4(bool usePlaceHolder)
 {
     LOAD_GLPROC( glVertexAttribIPointer );
@@ -445,6 +722,104 @@ static bool Load_GL_ARB_clip_control(bool usePlaceHolder)
     return true;
 }
 
+static bool Load_GL_ARB_map_buffer_range(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glMapBufferRange         );
+    LOAD_GLPROC( glFlushMappedBufferRange );
+    return true;
+}
+
+static bool Load_GL_ARB_buffer_storage(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glBufferStorage );
+    return true;
+}
+
+static bool Load_GL_ARB_sync(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glFenceSync      );
+    LOAD_GLPROC( glDeleteSync     );
+    LOAD_GLPROC( glClientWaitSync );
+    LOAD_GLPROC( glGetInteger64v  );
+    return true;
+}
+
+static bool Load_GL_ARB_copy_buffer(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glCopyBufferSubData );
+    return true;
+}
+
+static bool Load_GL_ARB_copy_image(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glCopyImageSubData );
+    return true;
+}
+
+static bool Load_GL_ARB_texture_storage(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glTexStorage1D );
+    LOAD_GLPROC( glTexStorage2D );
+    LOAD_GLPROC( glTexStorage3D );
+    return true;
+}
+
+static bool Load_GL_ARB_texture_storage_multisample(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glTexStorage2DMultisample );
+    LOAD_GLPROC( glTexStorage3DMultisample );
+    return true;
+}
+
+static bool Load_GL_ARB_texture_view(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glTextureView );
+    return true;
+}
+
+static bool Load_GL_ARB_internalformat_query(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glGetInternalformativ );
+    return true;
+}
+
+static bool Load_GL_ARB_sparse_texture(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glTexPageCommitmentARB );
+    return true;
+}
+
+static bool Load_GL_ARB_direct_state_access(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glCreateBuffers               );
+    LOAD_GLPROC( glNamedBufferData             );
+    LOAD_GLPROC( glNamedBufferSubData          );
+    LOAD_GLPROC( glMapNamedBuffer              );
+    LOAD_GLPROC( glMapNamedBufferRange         );
+    LOAD_GLPROC( glUnmapNamedBuffer            );
+    LOAD_GLPROC( glFlushMappedNamedBufferRange );
+    LOAD_GLPROC( glCreateTextures              );
+    LOAD_GLPROC( glTextureParameteri           );
+    LOAD_GLPROC( glTextureSubImage1D           );
+    LOAD_GLPROC( glTextureSubImage2D           );
+    LOAD_GLPROC( glTextureSubImage3D           );
+    LOAD_GLPROC( glCompressedTextureSubImage1D );
+    LOAD_GLPROC( glCompressedTextureSubImage2D );
+    LOAD_GLPROC( glCompressedTextureSubImage3D );
+    LOAD_GLPROC( glGenerateTextureMipmap       );
+    LOAD_GLPROC( glGetTextureLevelParameteriv  );
+    return true;
+}
+
+static bool Load_GL_ARB_bindless_texture(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glGetTextureHandleARB             );
+    LOAD_GLPROC( glGetTextureSamplerHandleARB      );
+    LOAD_GLPROC( glMakeTextureHandleResidentARB    );
+    LOAD_GLPROC( glMakeTextureHandleNonResidentARB );
+    return true;
+}
+
 static bool Load_GL_ARB_draw_buffers(bool usePlaceHolder)
 {
     LOAD_GLPROC( glDrawBuffers );
@@ -483,17 +858,194 @@ static bool Load_GL_NV_transform_feedback(bool usePlaceHolder)
     return true;
 }
 
+static bool Load_GL_ARB_transform_feedback2(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glGenTransformFeedbacks    );
+    LOAD_GLPROC( glDeleteTransformFeedbacks );
+    LOAD_GLPROC( glBindTransformFeedback    );
+    LOAD_GLPROC( glIsTransformFeedback      );
+    LOAD_GLPROC( glPauseTransformFeedback   );
+    LOAD_GLPROC( glResumeTransformFeedback  );
+    LOAD_GLPROC( glDrawTransformFeedback    );
+    return true;
+}
+
+#ifdef GL_NV_shading_rate_image
+
+static bool Load_GL_NV_shading_rate_image(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glBindShadingRateImageNV    );
+    LOAD_GLPROC( glShadingRateImagePaletteNV );
+    return true;
+}
+
+#endif
+
+#ifdef GL_NV_mesh_shader
+
+static bool Load_GL_NV_mesh_shader(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glDrawMeshTasksNV );
+    return true;
+}
+
+#endif
+
+#ifdef GL_EXT_depth_bounds_test
+
+static bool Load_GL_EXT_depth_bounds_test(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glDepthBoundsEXT );
+    return true;
+}
+
+#endif
+
+#ifdef GL_OVR_multiview
+
+static bool Load_GL_OVR_multiview(bool usePlaceHolder)
+{
+    LOAD_GLPROC( glFramebufferTextureMultiviewOVR );
+    return true;
+}
+
+#endif
+
 #undef LOAD_GLPROC_SIMPLE
 #undef LOAD_GLPROC
+
+/* --- Extension loading table --- */
+
+// Entry of the extension loading table. Extensions without procedures have no loading function.
+struct GLExtensionLoadingEntry
+{
+    GLExt   extension;
+    bool    (*loadProc)(bool usePlaceHolder);
+};
+
+#define GLEXT_LOAD(NAME)    { GLExt::NAME, Load_GL_##NAME }
+#define GLEXT_ENABLE(NAME)  { GLExt::NAME, nullptr        }
+
+static const GLExtensionLoadingEntry g_extensionLoadingTable[] =
+{
+    /* Hardware buffer extensions */
+    GLEXT_LOAD( ARB_vertex_buffer_object         ),
+    GLEXT_LOAD( ARB_vertex_array_object          ),
+    GLEXT_LOAD( ARB_vertex_attrib_binding        ),
+    GLEXT_LOAD( ARB_framebuffer_object           ),
+    GLEXT_LOAD( ARB_invalidate_subdata           ),
+    GLEXT_LOAD( ARB_uniform_buffer_object        ),
+    GLEXT_LOAD( ARB_shader_storage_buffer_object ),
+    GLEXT_LOAD( ARB_map_buffer_range             ),
+    GLEXT_LOAD( ARB_buffer_storage               ),
+    GLEXT_LOAD( ARB_sync                         ),
+    GLEXT_LOAD( ARB_copy_buffer                  ),
+    GLEXT_LOAD( ARB_copy_image                   ),
+    GLEXT_LOAD( ARB_texture_storage              ),
+    GLEXT_LOAD( ARB_texture_storage_multisample  ),
+    GLEXT_LOAD( ARB_texture_view                 ),
+    GLEXT_LOAD( ARB_internalformat_query         ),
+    GLEXT_LOAD( ARB_sparse_texture               ),
+    GLEXT_LOAD( ARB_direct_state_access          ),
+
+    /* Drawing extensions */
+    GLEXT_LOAD( ARB_draw_instanced               ),
+    GLEXT_LOAD( ARB_base_instance                ),
+    GLEXT_LOAD( ARB_draw_elements_base_vertex    ),
+    GLEXT_LOAD( EXT_multi_draw_arrays            ),
+    GLEXT_LOAD( ARB_draw_indirect                ),
+    GLEXT_LOAD( ARB_multi_draw_indirect          ),
+
+    /* Shader extensions */
+    GLEXT_LOAD( ARB_shader_objects               ),
+    GLEXT_LOAD( ARB_instanced_arrays             ),
+    GLEXT_LOAD( ARB_tessellation_shader          ),
+    GLEXT_LOAD( ARB_compute_shader               ),
+    GLEXT_LOAD( ARB_shader_image_load_store      ),
+    GLEXT_LOAD( ARB_get_program_binary           ),
+    GLEXT_LOAD( ARB_shader_subroutine            ),
+    GLEXT_LOAD( ARB_separate_shader_objects      ),
+    GLEXT_LOAD( ARB_parallel_shader_compile      ),
+    #ifdef GL_ARB_gl_spirv
+    GLEXT_LOAD( ARB_gl_spirv                     ),
+    #endif
+    GLEXT_LOAD( ARB_program_interface_query      ),
+    GLEXT_LOAD( EXT_gpu_shader4                  ),
+
+    /* Texture extensions */
+    GLEXT_LOAD( ARB_multitexture                 ),
+    GLEXT_LOAD( EXT_texture3D                    ),
+    GLEXT_LOAD( ARB_clear_texture                ),
+    GLEXT_LOAD( ARB_texture_compression          ),
+    GLEXT_LOAD( ARB_bindless_texture             ),
+    GLEXT_LOAD( ARB_texture_multisample          ),
+    GLEXT_LOAD( ARB_sampler_objects              ),
+
+    /* Blending extensions */
+    GLEXT_LOAD( EXT_blend_minmax                 ),
+    GLEXT_LOAD( EXT_blend_func_separate          ),
+    GLEXT_LOAD( EXT_blend_equation_separate      ),
+    GLEXT_LOAD( EXT_blend_color                  ),
+    GLEXT_LOAD( ARB_draw_buffers_blend           ),
+
+    /* Misc extensions */
+    GLEXT_LOAD( ARB_viewport_array               ),
+    GLEXT_LOAD( ARB_occlusion_query              ),
+    GLEXT_LOAD( NV_conditional_render            ),
+    GLEXT_LOAD( ARB_timer_query                  ),
+    GLEXT_LOAD( ARB_multi_bind                   ),
+    GLEXT_LOAD( EXT_stencil_two_side             ),
+    GLEXT_LOAD( KHR_debug                        ),
+    GLEXT_LOAD( ARB_clip_control                 ),
+    GLEXT_LOAD( ARB_draw_buffers                 ),
+    GLEXT_LOAD( EXT_draw_buffers2                ),
+    GLEXT_LOAD( EXT_transform_feedback           ),
+    GLEXT_LOAD( NV_transform_feedback            ),
+    GLEXT_LOAD( ARB_transform_feedback2          ),
+    #ifdef GL_NV_shading_rate_image
+    GLEXT_LOAD( NV_shading_rate_image            ),
+    #endif
+    #ifdef GL_OVR_multiview
+    GLEXT_LOAD( OVR_multiview                    ),
+    #endif
+    #ifdef GL_NV_mesh_shader
+    GLEXT_LOAD( NV_mesh_shader                   ),
+    #endif
+    #ifdef GL_EXT_depth_bounds_test
+    GLEXT_LOAD( EXT_depth_bounds_test            ),
+    #endif
+
+    /* Extensions without procedures */
+    GLEXT_ENABLE( ARB_texture_cube_map             ),
+    GLEXT_ENABLE( EXT_texture_array                ),
+    GLEXT_ENABLE( ARB_texture_cube_map_array       ),
+    GLEXT_ENABLE( ARB_geometry_shader4             ),
+    GLEXT_ENABLE( NV_conservative_raster           ),
+    GLEXT_ENABLE( INTEL_conservative_rasterization ),
+    GLEXT_ENABLE( ARB_query_buffer_object          ),
+    GLEXT_ENABLE( ARB_pipeline_statistics_query    ),
+    GLEXT_ENABLE( ARB_transform_feedback3          ),
+    GLEXT_ENABLE( ARB_shader_atomic_counters       ),
+    GLEXT_ENABLE( NVX_gpu_memory_info              ),
+    GLEXT_ENABLE( ATI_meminfo                      ),
+    GLEXT_ENABLE( OVR_multiview2                   ),
+    GLEXT_ENABLE( ARB_shader_viewport_layer_array  ),
+    GLEXT_ENABLE( AMD_vertex_shader_layer          ),
+    GLEXT_ENABLE( KHR_shader_subgroup              ),
+    GLEXT_ENABLE( NV_shader_thread_group           ),
+};
+
+#undef GLEXT_LOAD
+#undef GLEXT_ENABLE
     
 #endif
 
 
 /* --- Common extension loading functions --- */
 
-GLExtensionList QueryExtensions(bool coreProfile)
+GLExtensionSet QueryExtensions(bool coreProfile)
 {
-    GLExtensionList extensions;
+    GLExtensionSet extensions;
 
     const char* extString = nullptr;
     
@@ -515,7 +1067,7 @@ GLExtensionList QueryExtensions(bool coreProfile)
                 /* Get current extension string */
                 extString = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
                 if (extString)
-                    extensions[extString] = false;
+                    AddExtension(extensions, extString, std::strlen(extString));
             }
         }
         
@@ -529,25 +1081,13 @@ GLExtensionList QueryExtensions(bool coreProfile)
             ExtractExtensionsFromString(extensions, extString);
     }
 
-    #if defined(_WIN32) && defined(WGL_ARB_extensions_string)
-
-    /* Filter Win32 related extensions */
-    if (wglGetExtensionsStringARB || LoadGLProc(wglGetExtensionsStringARB, "wglGetExtensionsStringARB"))
-    {
-        extString = wglGetExtensionsStringARB(wglGetCurrentDC());
-        if (extString)
-            ExtractExtensionsFromString(extensions, extString);
-    }
-    
-    #endif
-
     return extensions;
 }
 
 // Global member to store if the extension have already been loaded
 static bool g_extAlreadyLoaded = false;
 
-void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
+void LoadAllExtensions(const GLExtensionSet& extensions, bool coreProfile)
 {
     /* Only load GL extensions once */
     if (g_extAlreadyLoaded)
@@ -565,11 +1105,16 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( ARB_framebuffer_object           );
     ENABLE_GLEXT( ARB_uniform_buffer_object        );
     ENABLE_GLEXT( ARB_shader_storage_buffer_object );
+    ENABLE_GLEXT( ARB_map_buffer_range             );
+    ENABLE_GLEXT( ARB_sync                         );
+    ENABLE_GLEXT( ARB_copy_buffer                  );
     
     /* Enable drawing extensions */
     ENABLE_GLEXT( ARB_draw_instanced               );
     ENABLE_GLEXT( ARB_base_instance                );
     ENABLE_GLEXT( ARB_draw_elements_base_vertex    );
+    ENABLE_GLEXT( EXT_multi_draw_arrays            );
+    ENABLE_GLEXT( ARB_draw_indirect                );
     
     /* Enable shader extensions */
     ENABLE_GLEXT( ARB_shader_objects               );
@@ -577,6 +1122,8 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( ARB_tessellation_shader          );
     ENABLE_GLEXT( ARB_compute_shader               );
     ENABLE_GLEXT( ARB_get_program_binary           );
+    ENABLE_GLEXT( ARB_shader_subroutine            );
+    ENABLE_GLEXT( ARB_separate_shader_objects      );
     ENABLE_GLEXT( ARB_program_interface_query      );
     ENABLE_GLEXT( EXT_gpu_shader4                  );
     
@@ -608,6 +1155,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( EXT_draw_buffers2                );
     ENABLE_GLEXT( EXT_transform_feedback           );
     ENABLE_GLEXT( NV_transform_feedback            );
+    ENABLE_GLEXT( ARB_transform_feedback2          );
     
     /* Enable extensions without procedures */
     ENABLE_GLEXT( ARB_texture_cube_map             );
@@ -616,116 +1164,42 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( ARB_geometry_shader4             );
     ENABLE_GLEXT( NV_conservative_raster           );
     ENABLE_GLEXT( INTEL_conservative_rasterization );
+    ENABLE_GLEXT( ARB_transform_feedback3          );
+    ENABLE_GLEXT( ARB_shader_atomic_counters       );
     
     #undef ENABLE_GLEXT
     
     #else
     
-    auto LoadExtension = [&](const std::string& extName, const std::function<bool(bool)>& extLoadingProc, GLExt viewerExt) -> void
+    /* Add standard extensions */
+    auto supportedExtensions = extensions;
+
+    if (coreProfile)
     {
-        /* Try to load OpenGL extension */
-        auto it = extensions.find(extName);
-        if (it != extensions.end() && !extLoadingProc(false))
+        supportedExtensions.set(static_cast<std::size_t>(GLExt::ARB_shader_objects));
+        supportedExtensions.set(static_cast<std::size_t>(GLExt::ARB_vertex_buffer_object));
+        supportedExtensions.set(static_cast<std::size_t>(GLExt::EXT_texture3D));
+        supportedExtensions.set(static_cast<std::size_t>(GLExt::EXT_multi_draw_arrays));
+    }
+
+    /* Load procedures of all supported extensions in a single pass over the loading table */
+    for (const auto& entry : g_extensionLoadingTable)
+    {
+        if (supportedExtensions.test(static_cast<std::size_t>(entry.extension)))
         {
-            /* Loading extension failed */
-            Log::StdErr() << "failed to load OpenGL extension: " << extName << std::endl;
+            if (entry.loadProc == nullptr || entry.loadProc(false))
+                RegisterExtension(entry.extension);
+            else
+                LLGL_LOG(Error, "failed to load OpenGL extension: " << GetExtensionName(entry.extension));
         }
         #ifdef LLGL_GL_ENABLE_EXT_PLACEHOLDERS
-        else if (it == extensions.end())
+        else if (entry.loadProc != nullptr)
         {
-            /* If failed, use dummy procedures to detect illegal use of OpenGL extension */
-            extLoadingProc(true);
+            /* Use dummy procedures to detect illegal use of OpenGL extension */
+            entry.loadProc(true);
         }
         #endif
-        else if (it != extensions.end())
-        {
-            /* Enable extension in viewer */
-            RegisterExtension(viewerExt);
-            it->second = true;
-        }
-    };
-
-    auto EnableExtension = [&](const std::string& extName, GLExt viewerExt) -> void
-    {
-        /* Try to enable OpenGL extension */
-        if (extensions.find(extName) != extensions.end())
-            RegisterExtension(viewerExt);
-    };
-
-    #define LOAD_GLEXT(NAME) \
-        LoadExtension("GL_" + std::string(#NAME), Load_GL_##NAME, GLExt::NAME)
-
-    #define ENABLE_GLEXT(NAME) \
-        EnableExtension("GL_" + std::string(#NAME), GLExt::NAME)
-        
-    /* Add standard extensions */
-    if (coreProfile)
-    {
-        extensions["GL_ARB_shader_objects"] = false;
-        extensions["GL_ARB_vertex_buffer_object"] = false;
-        extensions["GL_EXT_texture3D"] = false;
     }
-
-    /* Load hardware buffer extensions */
-    LOAD_GLEXT( ARB_vertex_buffer_object         );
-    LOAD_GLEXT( ARB_vertex_array_object          );
-    LOAD_GLEXT( ARB_framebuffer_object           );
-    LOAD_GLEXT( ARB_uniform_buffer_object        );
-    LOAD_GLEXT( ARB_shader_storage_buffer_object );
-
-    /* Load drawing extensions */
-    LOAD_GLEXT( ARB_draw_instanced               );
-    LOAD_GLEXT( ARB_base_instance                );
-    LOAD_GLEXT( ARB_draw_elements_base_vertex    );
-
-    /* Load shader extensions */
-    LOAD_GLEXT( ARB_shader_objects               );
-    LOAD_GLEXT( ARB_instanced_arrays             );
-    LOAD_GLEXT( ARB_tessellation_shader          );
-    LOAD_GLEXT( ARB_compute_shader               );
-    LOAD_GLEXT( ARB_get_program_binary           );
-    LOAD_GLEXT( ARB_program_interface_query      );
-    LOAD_GLEXT( EXT_gpu_shader4                  );
-
-    /* Load texture extensions */
-    LOAD_GLEXT( ARB_multitexture                 );
-    LOAD_GLEXT( EXT_texture3D                    );
-    LOAD_GLEXT( ARB_clear_texture                );
-    LOAD_GLEXT( ARB_texture_compression          );
-    LOAD_GLEXT( ARB_texture_multisample          );
-    LOAD_GLEXT( ARB_sampler_objects              );
-
-    /* Load blending extensions */
-    LOAD_GLEXT( EXT_blend_minmax                 );
-    LOAD_GLEXT( EXT_blend_func_separate          );
-    LOAD_GLEXT( EXT_blend_equation_separate      );
-    LOAD_GLEXT( EXT_blend_color                  );
-    LOAD_GLEXT( ARB_draw_buffers_blend           );
-
-    /* Load misc extensions */
-    LOAD_GLEXT( ARB_viewport_array               );
-    LOAD_GLEXT( ARB_occlusion_query              );
-    LOAD_GLEXT( NV_conditional_render            );
-    LOAD_GLEXT( ARB_timer_query                  );
-    LOAD_GLEXT( ARB_multi_bind                   );
-    LOAD_GLEXT( EXT_stencil_two_side             );
-    LOAD_GLEXT( KHR_debug                        );
-    LOAD_GLEXT( ARB_clip_control                 );
-    LOAD_GLEXT( ARB_draw_buffers                 );
-    LOAD_GLEXT( EXT_draw_buffers2                );
-    LOAD_GLEXT( EXT_transform_feedback           );
-    LOAD_GLEXT( NV_transform_feedback            );
-
-    /* Enable extensions without procedures */
-    ENABLE_GLEXT( ARB_texture_cube_map             );
-    ENABLE_GLEXT( EXT_texture_array                );
-    ENABLE_GLEXT( ARB_texture_cube_map_array       );
-    ENABLE_GLEXT( ARB_geometry_shader4             );
-    ENABLE_GLEXT( NV_conservative_raster           );
-    ENABLE_GLEXT( INTEL_conservative_rasterization );
-
-    #undef LOAD_GLEXT
-    #undef ENABLE_GLEXT
     
     #endif
     
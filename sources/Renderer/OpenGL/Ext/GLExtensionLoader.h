@@ -10,35 +10,34 @@
 
 
 #include "../../GLCommon/GLExtensionRegistry.h"
-#include <string>
-#include <array>
-#include <map>
+#include <bitset>
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
-//! OpenGL extension map type.
-using GLExtensionList = std::map<std::string, bool>;
+//! OpenGL extension set type with one bit for each entry of the GLExt enumeration.
+using GLExtensionSet = std::bitset<static_cast<std::size_t>(GLExt::Count)>;
 
 /* --- Common extension loading functions --- */
 
 /**
-Returns a hash-map with all supported OpenGL extensions.
-The hash-map can be used for faster single-extension queries.
+Returns the set of all supported OpenGL extensions that are known to the GLExt enumeration.
+The extension strings are matched against a static name table without copying them.
 \param[in] coreProfile Specifies whether the extension are to be loaded via GL core profile or not.
 */
-GLExtensionList QueryExtensions(bool coreProfile);
+GLExtensionSet QueryExtensions(bool coreProfile);
 
 /**
-Loads all available extensions and prints errors if an extension is available,
-but their respective functions could not be loaded.
-\param[in,out] extensions Specifies the extension map. This can be queried by the "QueryExtensions" function.
-The respective entry will be set to true if all its functions have been loaded successfully.
+Loads all available extensions in a single pass over a static loading table and prints errors if an extension is available,
+but their respective functions could not be loaded. Only extensions whose functions have been loaded successfully are registered.
+\param[in] extensions Specifies the extension set. This can be queried by the "QueryExtensions" function.
 \see QueryExtensions
+\see RegisterExtension
 */
-void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile);
+void LoadAllExtensions(const GLExtensionSet& extensions, bool coreProfile);
 
 //! Returns true if all available extensions have been loaded.
 bool AreExtensionsLoaded();
@@ -48,6 +47,8 @@ bool AreExtensionsLoaded();
 #ifndef __APPLE__
 
 bool LoadSwapIntervalProcs();
+bool LoadSwapControlTearProcs();
+bool LoadSyncControlProcs();
 bool LoadPixelFormatProcs();
 bool LoadCreateContextProcs();
 
@@ -24,11 +24,22 @@ PFNWGLCHOOSEPIXELFORMATARBPROC                          wglChoosePixelFormatARB
 PFNWGLCREATECONTEXTATTRIBSARBPROC                       wglCreateContextAttribsARB                      = nullptr;
 PFNWGLGETEXTENSIONSSTRINGARBPROC                        wglGetExtensionsStringARB                       = nullptr;
 
+// WGL_OML_sync_control
+PFNWGLGETSYNCVALUESOMLPROC                              wglGetSyncValuesOML                             = nullptr;
+PFNWGLWAITFORMSCOMLPROC                                 wglWaitForMscOML                                = nullptr;
+
 #elif defined(LLGL_OS_LINUX)
 
 // GLX_SGI_swap_control
 PFNGLXSWAPINTERVALSGIPROC                               glXSwapIntervalSGI                              = nullptr;
 
+// GLX_EXT_swap_control
+PFNGLXSWAPINTERVALEXTPROC                               glXSwapIntervalEXT                              = nullptr;
+
+// GLX_OML_sync_control
+PFNGLXGETSYNCVALUESOMLPROC                              glXGetSyncValuesOML                             = nullptr;
+PFNGLXWAITFORMSCOMLPROC                                 glXWaitForMscOML                                = nullptr;
+
 #endif
 
 #if defined(GL_VERSION_3_0) && !defined(GL_GLEXT_PROTOTYPES)
@@ -158,6 +169,14 @@ PFNGLGENVERTEXARRAYSPROC                                glGenVertexArrays
 PFNGLDELETEVERTEXARRAYSPROC                             glDeleteVertexArrays                            = nullptr;
 PFNGLBINDVERTEXARRAYPROC                                glBindVertexArray                               = nullptr;
 
+/* GL_ARB_vertex_attrib_binding */
+
+PFNGLBINDVERTEXBUFFERPROC                               glBindVertexBuffer                              = nullptr;
+PFNGLVERTEXATTRIBFORMATPROC                             glVertexAttribFormat                            = nullptr;
+PFNGLVERTEXATTRIBIFORMATPROC                            glVertexAttribIFormat                           = nullptr;
+PFNGLVERTEXATTRIBBINDINGPROC                            glVertexAttribBinding                           = nullptr;
+PFNGLVERTEXBINDINGDIVISORPROC                           glVertexBindingDivisor                          = nullptr;
+
 /* GL_ARB_framebuffer_object */
 
 PFNGLGENRENDERBUFFERSPROC                               glGenRenderbuffers                              = nullptr;
@@ -181,8 +200,13 @@ PFNGLGENERATEMIPMAPPROC                                 glGenerateMipmap
 
 #if 1 //WHICH EXTENSION???
 PFNGLCLEARBUFFERFVPROC                                  glClearBufferfv                                 = nullptr;
+PFNGLCLEARBUFFERFIPROC                                  glClearBufferfi                                 = nullptr;
 #endif
 
+/* GL_ARB_invalidate_subdata */
+
+PFNGLINVALIDATEFRAMEBUFFERPROC                          glInvalidateFramebuffer                         = nullptr;
+
 /* GL_ARB_draw_instanced */
 
 PFNGLDRAWARRAYSINSTANCEDPROC                            glDrawArraysInstanced                           = nullptr;
@@ -192,6 +216,12 @@ PFNGLDRAWELEMENTSINSTANCEDPROC                          glDrawElementsInstanced
 
 PFNGLDRAWELEMENTSBASEVERTEXPROC                         glDrawElementsBaseVertex                        = nullptr;
 PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC                glDrawElementsInstancedBaseVertex               = nullptr;
+PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC                    glMultiDrawElementsBaseVertex                   = nullptr;
+
+/* GL_EXT_multi_draw_arrays */
+
+PFNGLMULTIDRAWARRAYSPROC                                glMultiDrawArrays                               = nullptr;
+PFNGLMULTIDRAWELEMENTSPROC                              glMultiDrawElements                             = nullptr;
 
 /* GL_ARB_base_instance */
 
@@ -199,6 +229,16 @@ PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC                glDrawArraysInstancedBas
 PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC              glDrawElementsInstancedBaseInstance             = nullptr;
 PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC    glDrawElementsInstancedBaseVertexBaseInstance   = nullptr;
 
+/* GL_ARB_draw_indirect */
+
+PFNGLDRAWARRAYSINDIRECTPROC                             glDrawArraysIndirect                            = nullptr;
+PFNGLDRAWELEMENTSINDIRECTPROC                           glDrawElementsIndirect                          = nullptr;
+
+/* GL_ARB_multi_draw_indirect */
+
+PFNGLMULTIDRAWARRAYSINDIRECTPROC                        glMultiDrawArraysIndirect                       = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC                      glMultiDrawElementsIndirect                     = nullptr;
+
 /* GL_ARB_shader_objects */
 
 PFNGLCREATESHADERPROC                                   glCreateShader                                  = nullptr;
@@ -243,12 +283,46 @@ PFNGLPATCHPARAMETERFVPROC                               glPatchParameterfv
 PFNGLDISPATCHCOMPUTEPROC                                glDispatchCompute                               = nullptr;
 PFNGLDISPATCHCOMPUTEINDIRECTPROC                        glDispatchComputeIndirect                       = nullptr;
 
+/* GL_ARB_shader_image_load_store */
+
+PFNGLMEMORYBARRIERPROC                                  glMemoryBarrier                                 = nullptr;
+
 /* GL_ARB_get_program_binary */
 
 PFNGLGETPROGRAMBINARYPROC                               glGetProgramBinary                              = nullptr;
 PFNGLPROGRAMBINARYPROC                                  glProgramBinary                                 = nullptr;
 PFNGLPROGRAMPARAMETERIPROC                              glProgramParameteri                             = nullptr;
 
+/* GL_ARB_shader_subroutine */
+
+PFNGLGETSUBROUTINEUNIFORMLOCATIONPROC                   glGetSubroutineUniformLocation                  = nullptr;
+PFNGLGETSUBROUTINEINDEXPROC                             glGetSubroutineIndex                            = nullptr;
+PFNGLGETPROGRAMSTAGEIVPROC                              glGetProgramStageiv                             = nullptr;
+PFNGLUNIFORMSUBROUTINESUIVPROC                          glUniformSubroutinesuiv                         = nullptr;
+
+/* GL_ARB_separate_shader_objects */
+
+PFNGLUSEPROGRAMSTAGESPROC                               glUseProgramStages                              = nullptr;
+PFNGLACTIVESHADERPROGRAMPROC                            glActiveShaderProgram                           = nullptr;
+PFNGLCREATESHADERPROGRAMVPROC                           glCreateShaderProgramv                          = nullptr;
+PFNGLBINDPROGRAMPIPELINEPROC                            glBindProgramPipeline                           = nullptr;
+PFNGLDELETEPROGRAMPIPELINESPROC                         glDeleteProgramPipelines                        = nullptr;
+PFNGLGENPROGRAMPIPELINESPROC                            glGenProgramPipelines                           = nullptr;
+PFNGLGETPROGRAMPIPELINEIVPROC                           glGetProgramPipelineiv                          = nullptr;
+PFNGLVALIDATEPROGRAMPIPELINEPROC                        glValidateProgramPipeline                       = nullptr;
+PFNGLGETPROGRAMPIPELINEINFOLOGPROC                      glGetProgramPipelineInfoLog                     = nullptr;
+PFNGLPROGRAMUNIFORM1IVPROC                              glProgramUniform1iv                             = nullptr;
+PFNGLPROGRAMUNIFORM2IVPROC                              glProgramUniform2iv                             = nullptr;
+PFNGLPROGRAMUNIFORM3IVPROC                              glProgramUniform3iv                             = nullptr;
+PFNGLPROGRAMUNIFORM4IVPROC                              glProgramUniform4iv                             = nullptr;
+PFNGLPROGRAMUNIFORM1FVPROC                              glProgramUniform1fv                             = nullptr;
+PFNGLPROGRAMUNIFORM2FVPROC                              glProgramUniform2fv                             = nullptr;
+PFNGLPROGRAMUNIFORM3FVPROC                              glProgramUniform3fv                             = nullptr;
+PFNGLPROGRAMUNIFORM4FVPROC                              glProgramUniform4fv                             = nullptr;
+PFNGLPROGRAMUNIFORMMATRIX2FVPROC                        glProgramUniformMatrix2fv                       = nullptr;
+PFNGLPROGRAMUNIFORMMATRIX3FVPROC                        glProgramUniformMatrix3fv                       = nullptr;
+PFNGLPROGRAMUNIFORMMATRIX4FVPROC                        glProgramUniformMatrix4fv                       = nullptr;
+
 /* GL_ARB_program_interface_query */
 
 PFNGLGETPROGRAMINTERFACEIVPROC                          glGetProgramInterfaceiv                         = nullptr;
@@ -263,6 +337,8 @@ PFNGLGETPROGRAMRESOURCELOCATIONINDEXPROC                glGetProgramResourceLoca
 PFNGLGETUNIFORMBLOCKINDEXPROC                           glGetUniformBlockIndex                          = nullptr;
 PFNGLGETACTIVEUNIFORMBLOCKIVPROC                        glGetActiveUniformBlockiv                       = nullptr;
 PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC                      glGetActiveUniformBlockName                     = nullptr;
+PFNGLGETACTIVEUNIFORMSIVPROC                            glGetActiveUniformsiv                           = nullptr;
+PFNGLGETACTIVEUNIFORMNAMEPROC                           glGetActiveUniformName                          = nullptr;
 PFNGLUNIFORMBLOCKBINDINGPROC                            glUniformBlockBinding                           = nullptr;
 PFNGLBINDBUFFERBASEPROC                                 glBindBufferBase                                = nullptr;
 
@@ -310,6 +386,91 @@ PFNGLDEBUGMESSAGECALLBACKPROC                           glDebugMessageCallback
 
 PFNGLCLIPCONTROLPROC                                    glClipControl                                   = nullptr;
 
+/* GL_ARB_map_buffer_range */
+
+PFNGLMAPBUFFERRANGEPROC                                 glMapBufferRange                                = nullptr;
+PFNGLFLUSHMAPPEDBUFFERRANGEPROC                         glFlushMappedBufferRange                        = nullptr;
+
+/* GL_ARB_buffer_storage */
+
+PFNGLBUFFERSTORAGEPROC                                  glBufferStorage                                 = nullptr;
+
+/* GL_ARB_sync */
+
+PFNGLFENCESYNCPROC                                      glFenceSync                                     = nullptr;
+PFNGLDELETESYNCPROC                                     glDeleteSync                                    = nullptr;
+PFNGLCLIENTWAITSYNCPROC                                 glClientWaitSync                                = nullptr;
+PFNGLGETINTEGER64VPROC                                  glGetInteger64v                                 = nullptr;
+
+/* GL_ARB_copy_buffer */
+
+PFNGLCOPYBUFFERSUBDATAPROC                              glCopyBufferSubData                             = nullptr;
+
+/* GL_ARB_copy_image */
+
+PFNGLCOPYIMAGESUBDATAPROC                               glCopyImageSubData                              = nullptr;
+
+/* GL_ARB_texture_storage */
+
+PFNGLTEXSTORAGE1DPROC                                   glTexStorage1D                                  = nullptr;
+PFNGLTEXSTORAGE2DPROC                                   glTexStorage2D                                  = nullptr;
+PFNGLTEXSTORAGE3DPROC                                   glTexStorage3D                                  = nullptr;
+
+/* GL_ARB_texture_storage_multisample */
+
+PFNGLTEXSTORAGE2DMULTISAMPLEPROC                        glTexStorage2DMultisample                       = nullptr;
+PFNGLTEXSTORAGE3DMULTISAMPLEPROC                        glTexStorage3DMultisample                       = nullptr;
+
+/* GL_ARB_texture_view */
+
+PFNGLTEXTUREVIEWPROC                                    glTextureView                                   = nullptr;
+
+/* GL_ARB_internalformat_query */
+
+PFNGLGETINTERNALFORMATIVPROC                            glGetInternalformativ                           = nullptr;
+
+/* GL_ARB_sparse_texture */
+
+PFNGLTEXPAGECOMMITMENTARBPROC                           glTexPageCommitmentARB                          = nullptr;
+
+/* GL_ARB_direct_state_access */
+
+PFNGLCREATEBUFFERSPROC                                  glCreateBuffers                                 = nullptr;
+PFNGLNAMEDBUFFERDATAPROC                                glNamedBufferData                               = nullptr;
+PFNGLNAMEDBUFFERSUBDATAPROC                             glNamedBufferSubData                            = nullptr;
+PFNGLMAPNAMEDBUFFERPROC                                 glMapNamedBuffer                                = nullptr;
+PFNGLMAPNAMEDBUFFERRANGEPROC                            glMapNamedBufferRange                           = nullptr;
+PFNGLUNMAPNAMEDBUFFERPROC                               glUnmapNamedBuffer                              = nullptr;
+PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC                    glFlushMappedNamedBufferRange                   = nullptr;
+PFNGLCREATETEXTURESPROC                                 glCreateTextures                                = nullptr;
+PFNGLTEXTUREPARAMETERIPROC                              glTextureParameteri                             = nullptr;
+PFNGLTEXTURESUBIMAGE1DPROC                              glTextureSubImage1D                             = nullptr;
+PFNGLTEXTURESUBIMAGE2DPROC                              glTextureSubImage2D                             = nullptr;
+PFNGLTEXTURESUBIMAGE3DPROC                              glTextureSubImage3D                             = nullptr;
+PFNGLCOMPRESSEDTEXTURESUBIMAGE1DPROC                    glCompressedTextureSubImage1D                   = nullptr;
+PFNGLCOMPRESSEDTEXTURESUBIMAGE2DPROC                    glCompressedTextureSubImage2D                   = nullptr;
+PFNGLCOMPRESSEDTEXTURESUBIMAGE3DPROC                    glCompressedTextureSubImage3D                   = nullptr;
+PFNGLGENERATETEXTUREMIPMAPPROC                          glGenerateTextureMipmap                         = nullptr;
+PFNGLGETTEXTURELEVELPARAMETERIVPROC                     glGetTextureLevelParameteriv                    = nullptr;
+
+/* GL_ARB_bindless_texture */
+
+PFNGLGETTEXTUREHANDLEARBPROC                            glGetTextureHandleARB                           = nullptr;
+PFNGLGETTEXTURESAMPLERHANDLEARBPROC                     glGetTextureSamplerHandleARB                    = nullptr;
+PFNGLMAKETEXTUREHANDLERESIDENTARBPROC                   glMakeTextureHandleResidentARB                  = nullptr;
+PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC                glMakeTextureHandleNonResidentARB               = nullptr;
+
+/* GL_ARB_parallel_shader_compile */
+
+PFNGLMAXSHADERCOMPILERTHREADSARBPROC                    glMaxShaderCompilerThreadsARB                   = nullptr;
+
+/* GL_ARB_gl_spirv */
+
+#ifdef GL_ARB_gl_spirv
+PFNGLSHADERBINARYPROC                                   glShaderBinary                                  = nullptr;
+PFNGLSPECIALIZESHADERARBPROC                            glSpecializeShaderARB                           = nullptr;
+#endif
+
 /* GL_EXT_transform_feedback */
 
 PFNGLBINDBUFFERRANGEPROC                                glBindBufferRange                               = nullptr;
@@ -327,6 +488,41 @@ PFNGLTRANSFORMFEEDBACKVARYINGSNVPROC                    glTransformFeedbackVaryi
 PFNGLGETVARYINGLOCATIONNVPROC                           glGetVaryingLocationNV                          = nullptr;
 PFNGLGETACTIVEVARYINGNVPROC                             glGetActiveVaryingNV                            = nullptr;
 
+/* GL_ARB_transform_feedback2 */
+
+PFNGLGENTRANSFORMFEEDBACKSPROC                          glGenTransformFeedbacks                         = nullptr;
+PFNGLDELETETRANSFORMFEEDBACKSPROC                       glDeleteTransformFeedbacks                      = nullptr;
+PFNGLBINDTRANSFORMFEEDBACKPROC                          glBindTransformFeedback                         = nullptr;
+PFNGLISTRANSFORMFEEDBACKPROC                            glIsTransformFeedback                           = nullptr;
+PFNGLPAUSETRANSFORMFEEDBACKPROC                         glPauseTransformFeedback                        = nullptr;
+PFNGLRESUMETRANSFORMFEEDBACKPROC                        glResumeTransformFeedback                       = nullptr;
+PFNGLDRAWTRANSFORMFEEDBACKPROC                          glDrawTransformFeedback                         = nullptr;
+
+/* GL_NV_shading_rate_image */
+
+#ifdef GL_NV_shading_rate_image
+PFNGLBINDSHADINGRATEIMAGENVPROC                         glBindShadingRateImageNV                        = nullptr;
+PFNGLSHADINGRATEIMAGEPALETTENVPROC                      glShadingRateImagePaletteNV                     = nullptr;
+#endif
+
+/* GL_NV_mesh_shader */
+
+#ifdef GL_NV_mesh_shader
+PFNGLDRAWMESHTASKSNVPROC                                glDrawMeshTasksNV                               = nullptr;
+#endif
+
+/* GL_EXT_depth_bounds_test */
+
+#ifdef GL_EXT_depth_bounds_test
+PFNGLDEPTHBOUNDSEXTPROC                                 glDepthBoundsEXT                                = nullptr;
+#endif
+
+/* GL_OVR_multiview */
+
+#ifdef GL_OVR_multiview
+PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC                 glFramebufferTextureMultiviewOVR                = nullptr;
+#endif
+
 #endif // /ifndef(__APPLE__)
 
 
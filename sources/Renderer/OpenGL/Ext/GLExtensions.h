@@ -25,10 +25,15 @@ extern PFNWGLSWAPINTERVALEXTPROC                            wglSwapIntervalEXT;
 extern PFNWGLCHOOSEPIXELFORMATARBPROC                       wglChoosePixelFormatARB;
 extern PFNWGLCREATECONTEXTATTRIBSARBPROC                    wglCreateContextAttribsARB;
 extern PFNWGLGETEXTENSIONSSTRINGARBPROC                     wglGetExtensionsStringARB;
+extern PFNWGLGETSYNCVALUESOMLPROC                           wglGetSyncValuesOML;
+extern PFNWGLWAITFORMSCOMLPROC                              wglWaitForMscOML;
 
 #elif defined(LLGL_OS_LINUX)
 
 extern PFNGLXSWAPINTERVALSGIPROC                            glXSwapIntervalSGI;
+extern PFNGLXSWAPINTERVALEXTPROC                            glXSwapIntervalEXT;
+extern PFNGLXGETSYNCVALUESOMLPROC                           glXGetSyncValuesOML;
+extern PFNGLXWAITFORMSCOMLPROC                              glXWaitForMscOML;
 
 #endif
 
@@ -161,6 +166,14 @@ extern PFNGLGENVERTEXARRAYSPROC                             glGenVertexArrays;
 extern PFNGLDELETEVERTEXARRAYSPROC                          glDeleteVertexArrays;
 extern PFNGLBINDVERTEXARRAYPROC                             glBindVertexArray;
 
+/* GL_ARB_vertex_attrib_binding */
+
+extern PFNGLBINDVERTEXBUFFERPROC                            glBindVertexBuffer;
+extern PFNGLVERTEXATTRIBFORMATPROC                          glVertexAttribFormat;
+extern PFNGLVERTEXATTRIBIFORMATPROC                         glVertexAttribIFormat;
+extern PFNGLVERTEXATTRIBBINDINGPROC                         glVertexAttribBinding;
+extern PFNGLVERTEXBINDINGDIVISORPROC                        glVertexBindingDivisor;
+
 /* GL_ARB_framebuffer_object */
 
 extern PFNGLGENRENDERBUFFERSPROC                            glGenRenderbuffers;
@@ -184,8 +197,13 @@ extern PFNGLGENERATEMIPMAPPROC                              glGenerateMipmap;
 
 #if 1 //WHICH EXTENSION???
 extern PFNGLCLEARBUFFERFVPROC                               glClearBufferfv;
+extern PFNGLCLEARBUFFERFIPROC                               glClearBufferfi;
 #endif
 
+/* GL_ARB_invalidate_subdata */
+
+extern PFNGLINVALIDATEFRAMEBUFFERPROC                       glInvalidateFramebuffer;
+
 /* GL_ARB_draw_instanced */
 
 extern PFNGLDRAWARRAYSINSTANCEDPROC                         glDrawArraysInstanced;
@@ -195,6 +213,12 @@ extern PFNGLDRAWELEMENTSINSTANCEDPROC                       glDrawElementsInstan
 
 extern PFNGLDRAWELEMENTSBASEVERTEXPROC                      glDrawElementsBaseVertex;
 extern PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC             glDrawElementsInstancedBaseVertex;
+extern PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC                 glMultiDrawElementsBaseVertex;
+
+/* GL_EXT_multi_draw_arrays */
+
+extern PFNGLMULTIDRAWARRAYSPROC                             glMultiDrawArrays;
+extern PFNGLMULTIDRAWELEMENTSPROC                           glMultiDrawElements;
 
 /* GL_ARB_base_instance */
 
@@ -202,6 +226,16 @@ extern PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC             glDrawArraysInstance
 extern PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC           glDrawElementsInstancedBaseInstance;
 extern PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC glDrawElementsInstancedBaseVertexBaseInstance;
 
+/* GL_ARB_draw_indirect */
+
+extern PFNGLDRAWARRAYSINDIRECTPROC                          glDrawArraysIndirect;
+extern PFNGLDRAWELEMENTSINDIRECTPROC                        glDrawElementsIndirect;
+
+/* GL_ARB_multi_draw_indirect */
+
+extern PFNGLMULTIDRAWARRAYSINDIRECTPROC                     glMultiDrawArraysIndirect;
+extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC                   glMultiDrawElementsIndirect;
+
 /* GL_ARB_shader_objects */
 
 extern PFNGLCREATESHADERPROC                                glCreateShader;
@@ -246,12 +280,46 @@ extern PFNGLPATCHPARAMETERFVPROC                            glPatchParameterfv;
 extern PFNGLDISPATCHCOMPUTEPROC                             glDispatchCompute;
 extern PFNGLDISPATCHCOMPUTEINDIRECTPROC                     glDispatchComputeIndirect;
 
+/* GL_ARB_shader_image_load_store */
+
+extern PFNGLMEMORYBARRIERPROC                               glMemoryBarrier;
+
 /* GL_ARB_get_program_binary */
 
 extern PFNGLGETPROGRAMBINARYPROC                            glGetProgramBinary;
 extern PFNGLPROGRAMBINARYPROC                               glProgramBinary;
 extern PFNGLPROGRAMPARAMETERIPROC                           glProgramParameteri;
 
+/* GL_ARB_shader_subroutine */
+
+extern PFNGLGETSUBROUTINEUNIFORMLOCATIONPROC                glGetSubroutineUniformLocation;
+extern PFNGLGETSUBROUTINEINDEXPROC                          glGetSubroutineIndex;
+extern PFNGLGETPROGRAMSTAGEIVPROC                           glGetProgramStageiv;
+extern PFNGLUNIFORMSUBROUTINESUIVPROC                       glUniformSubroutinesuiv;
+
+/* GL_ARB_separate_shader_objects */
+
+extern PFNGLUSEPROGRAMSTAGESPROC                            glUseProgramStages;
+extern PFNGLACTIVESHADERPROGRAMPROC                         glActiveShaderProgram;
+extern PFNGLCREATESHADERPROGRAMVPROC                        glCreateShaderProgramv;
+extern PFNGLBINDPROGRAMPIPELINEPROC                         glBindProgramPipeline;
+extern PFNGLDELETEPROGRAMPIPELINESPROC                      glDeleteProgramPipelines;
+extern PFNGLGENPROGRAMPIPELINESPROC                         glGenProgramPipelines;
+extern PFNGLGETPROGRAMPIPELINEIVPROC                        glGetProgramPipelineiv;
+extern PFNGLVALIDATEPROGRAMPIPELINEPROC                     glValidateProgramPipeline;
+extern PFNGLGETPROGRAMPIPELINEINFOLOGPROC                   glGetProgramPipelineInfoLog;
+extern PFNGLPROGRAMUNIFORM1IVPROC                           glProgramUniform1iv;
+extern PFNGLPROGRAMUNIFORM2IVPROC                           glProgramUniform2iv;
+extern PFNGLPROGRAMUNIFORM3IVPROC                           glProgramUniform3iv;
+extern PFNGLPROGRAMUNIFORM4IVPROC                           glProgramUniform4iv;
+extern PFNGLPROGRAMUNIFORM1FVPROC                           glProgramUniform1fv;
+extern PFNGLPROGRAMUNIFORM2FVPROC                           glProgramUniform2fv;
+extern PFNGLPROGRAMUNIFORM3FVPROC                           glProgramUniform3fv;
+extern PFNGLPROGRAMUNIFORM4FVPROC                           glProgramUniform4fv;
+extern PFNGLPROGRAMUNIFORMMATRIX2FVPROC                     glProgramUniformMatrix2fv;
+extern PFNGLPROGRAMUNIFORMMATRIX3FVPROC                     glProgramUniformMatrix3fv;
+extern PFNGLPROGRAMUNIFORMMATRIX4FVPROC                     glProgramUniformMatrix4fv;
+
 /* GL_ARB_program_interface_query */
 
 extern PFNGLGETPROGRAMINTERFACEIVPROC                       glGetProgramInterfaceiv;
@@ -266,6 +334,8 @@ extern PFNGLGETPROGRAMRESOURCELOCATIONINDEXPROC             glGetProgramResource
 extern PFNGLGETUNIFORMBLOCKINDEXPROC                        glGetUniformBlockIndex;
 extern PFNGLGETACTIVEUNIFORMBLOCKIVPROC                     glGetActiveUniformBlockiv;
 extern PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC                   glGetActiveUniformBlockName;
+extern PFNGLGETACTIVEUNIFORMSIVPROC                         glGetActiveUniformsiv;
+extern PFNGLGETACTIVEUNIFORMNAMEPROC                        glGetActiveUniformName;
 extern PFNGLUNIFORMBLOCKBINDINGPROC                         glUniformBlockBinding;
 extern PFNGLBINDBUFFERBASEPROC                              glBindBufferBase;
 
@@ -313,6 +383,91 @@ extern PFNGLDEBUGMESSAGECALLBACKPROC                        glDebugMessageCallba
 
 extern PFNGLCLIPCONTROLPROC                                 glClipControl;
 
+/* GL_ARB_map_buffer_range */
+
+extern PFNGLMAPBUFFERRANGEPROC                              glMapBufferRange;
+extern PFNGLFLUSHMAPPEDBUFFERRANGEPROC                      glFlushMappedBufferRange;
+
+/* GL_ARB_buffer_storage */
+
+extern PFNGLBUFFERSTORAGEPROC                               glBufferStorage;
+
+/* GL_ARB_sync */
+
+extern PFNGLFENCESYNCPROC                                   glFenceSync;
+extern PFNGLDELETESYNCPROC                                  glDeleteSync;
+extern PFNGLCLIENTWAITSYNCPROC                              glClientWaitSync;
+extern PFNGLGETINTEGER64VPROC                               glGetInteger64v;
+
+/* GL_ARB_copy_buffer */
+
+extern PFNGLCOPYBUFFERSUBDATAPROC                           glCopyBufferSubData;
+
+/* GL_ARB_copy_image */
+
+extern PFNGLCOPYIMAGESUBDATAPROC                            glCopyImageSubData;
+
+/* GL_ARB_texture_storage */
+
+extern PFNGLTEXSTORAGE1DPROC                                glTexStorage1D;
+extern PFNGLTEXSTORAGE2DPROC                                glTexStorage2D;
+extern PFNGLTEXSTORAGE3DPROC                                glTexStorage3D;
+
+/* GL_ARB_texture_storage_multisample */
+
+extern PFNGLTEXSTORAGE2DMULTISAMPLEPROC                     glTexStorage2DMultisample;
+extern PFNGLTEXSTORAGE3DMULTISAMPLEPROC                     glTexStorage3DMultisample;
+
+/* GL_ARB_texture_view */
+
+extern PFNGLTEXTUREVIEWPROC                                 glTextureView;
+
+/* GL_ARB_internalformat_query */
+
+extern PFNGLGETINTERNALFORMATIVPROC                         glGetInternalformativ;
+
+/* GL_ARB_sparse_texture */
+
+extern PFNGLTEXPAGECOMMITMENTARBPROC                        glTexPageCommitmentARB;
+
+/* GL_ARB_direct_state_access */
+
+extern PFNGLCREATEBUFFERSPROC                               glCreateBuffers;
+extern PFNGLNAMEDBUFFERDATAPROC                             glNamedBufferData;
+extern PFNGLNAMEDBUFFERSUBDATAPROC                          glNamedBufferSubData;
+extern PFNGLMAPNAMEDBUFFERPROC                              glMapNamedBuffer;
+extern PFNGLMAPNAMEDBUFFERRANGEPROC                         glMapNamedBufferRange;
+extern PFNGLUNMAPNAMEDBUFFERPROC                            glUnmapNamedBuffer;
+extern PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC                 glFlushMappedNamedBufferRange;
+extern PFNGLCREATETEXTURESPROC                              glCreateTextures;
+extern PFNGLTEXTUREPARAMETERIPROC                           glTextureParameteri;
+extern PFNGLTEXTURESUBIMAGE1DPROC                           glTextureSubImage1D;
+extern PFNGLTEXTURESUBIMAGE2DPROC                           glTextureSubImage2D;
+extern PFNGLTEXTURESUBIMAGE3DPROC                           glTextureSubImage3D;
+extern PFNGLCOMPRESSEDTEXTURESUBIMAGE1DPROC                 glCompressedTextureSubImage1D;
+extern PFNGLCOMPRESSEDTEXTURESUBIMAGE2DPROC                 glCompressedTextureSubImage2D;
+extern PFNGLCOMPRESSEDTEXTURESUBIMAGE3DPROC                 glCompressedTextureSubImage3D;
+extern PFNGLGENERATETEXTUREMIPMAPPROC                       glGenerateTextureMipmap;
+extern PFNGLGETTEXTURELEVELPARAMETERIVPROC                  glGetTextureLevelParameteriv;
+
+/* GL_ARB_bindless_texture */
+
+extern PFNGLGETTEXTUREHANDLEARBPROC                         glGetTextureHandleARB;
+extern PFNGLGETTEXTURESAMPLERHANDLEARBPROC                  glGetTextureSamplerHandleARB;
+extern PFNGLMAKETEXTUREHANDLERESIDENTARBPROC                glMakeTextureHandleResidentARB;
+extern PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC             glMakeTextureHandleNonResidentARB;
+
+/* GL_ARB_parallel_shader_compile */
+
+extern PFNGLMAXSHADERCOMPILERTHREADSARBPROC                 glMaxShaderCompilerThreadsARB;
+
+/* GL_ARB_gl_spirv */
+
+#ifdef GL_ARB_gl_spirv
+extern PFNGLSHADERBINARYPROC                                glShaderBinary;
+extern PFNGLSPECIALIZESHADERARBPROC                         glSpecializeShaderARB;
+#endif
+
 /* GL_EXT_transform_feedback */
 
 extern PFNGLBINDBUFFERRANGEPROC                             glBindBufferRange;
@@ -329,6 +484,41 @@ extern PFNGLENDTRANSFORMFEEDBACKNVPROC                      glEndTransformFeedba
 extern PFNGLTRANSFORMFEEDBACKVARYINGSNVPROC                 glTransformFeedbackVaryingsNV;
 extern PFNGLGETVARYINGLOCATIONNVPROC                        glGetVaryingLocationNV;
 extern PFNGLGETACTIVEVARYINGNVPROC                          glGetActiveVaryingNV;
+
+/* GL_ARB_transform_feedback2 */
+
+extern PFNGLGENTRANSFORMFEEDBACKSPROC                       glGenTransformFeedbacks;
+extern PFNGLDELETETRANSFORMFEEDBACKSPROC                    glDeleteTransformFeedbacks;
+extern PFNGLBINDTRANSFORMFEEDBACKPROC                       glBindTransformFeedback;
+extern PFNGLISTRANSFORMFEEDBACKPROC                         glIsTransformFeedback;
+extern PFNGLPAUSETRANSFORMFEEDBACKPROC                      glPauseTransformFeedback;
+extern PFNGLRESUMETRANSFORMFEEDBACKPROC                     glResumeTransformFeedback;
+extern PFNGLDRAWTRANSFORMFEEDBACKPROC                       glDrawTransformFeedback;
+
+/* GL_NV_shading_rate_image */
+
+#ifdef GL_NV_shading_rate_image
+extern PFNGLBINDSHADINGRATEIMAGENVPROC                      glBindShadingRateImageNV;
+extern PFNGLSHADINGRATEIMAGEPALETTENVPROC                   glShadingRateImagePaletteNV;
+#endif
+
+/* GL_NV_mesh_shader */
+
+#ifdef GL_NV_mesh_shader
+extern PFNGLDRAWMESHTASKSNVPROC                             glDrawMeshTasksNV;
+#endif
+
+/* GL_EXT_depth_bounds_test */
+
+#ifdef GL_EXT_depth_bounds_test
+extern PFNGLDEPTHBOUNDSEXTPROC                              glDepthBoundsEXT;
+#endif
+
+/* GL_OVR_multiview */
+
+#ifdef GL_OVR_multiview
+extern PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC              glFramebufferTextureMultiviewOVR;
+#endif
     
 #endif
 
@@ -57,11 +57,22 @@ DECL_GLPROC(BOOL, wglChoosePixelFormatARB, (HDC, const int*, const FLOAT*, UINT,
 DECL_GLPROC(HGLRC, wglCreateContextAttribsARB, (HDC, HGLRC, const int*));
 DECL_GLPROC(const char*, wglGetExtensionsStringARB, (HDC));
 
+// WGL_OML_sync_control
+DECL_GLPROC(BOOL, wglGetSyncValuesOML, (HDC, INT64*, INT64*, INT64*));
+DECL_GLPROC(BOOL, wglWaitForMscOML, (HDC, INT64, INT64, INT64, INT64*, INT64*, INT64*));
+
 #elif defined(__linux__)
 
 // GLX_SGI_swap_control
 DECL_GLPROC(int, glXSwapIntervalSGI, (int));
 
+// GLX_EXT_swap_control
+DECL_GLPROC(void, glXSwapIntervalEXT, (Display*, GLXDrawable, int));
+
+// GLX_OML_sync_control
+DECL_GLPROC(Bool, glXGetSyncValuesOML, (Display*, GLXDrawable, int64_t*, int64_t*, int64_t*));
+DECL_GLPROC(Bool, glXWaitForMscOML, (Display*, GLXDrawable, int64_t, int64_t, int64_t, int64_t*, int64_t*, int64_t*));
+
 #endif
 
 #if defined(GL_VERSION_3_0) && !defined(GL_GLEXT_PROTOTYPES)
@@ -191,6 +202,14 @@ DECL_GLPROC(void, glGenVertexArrays, (GLsizei, GLuint*));
 DECL_GLPROC(void, glDeleteVertexArrays, (GLsizei, const GLuint*));
 DECL_GLPROC(void, glBindVertexArray, (GLuint));
 
+/* GL_ARB_vertex_attrib_binding */
+
+DECL_GLPROC(void, glBindVertexBuffer, (GLuint, GLuint, GLintptr, GLsizei));
+DECL_GLPROC(void, glVertexAttribFormat, (GLuint, GLint, GLenum, GLboolean, GLuint));
+DECL_GLPROC(void, glVertexAttribIFormat, (GLuint, GLint, GLenum, GLuint));
+DECL_GLPROC(void, glVertexAttribBinding, (GLuint, GLuint));
+DECL_GLPROC(void, glVertexBindingDivisor, (GLuint, GLuint));
+
 /* GL_ARB_framebuffer_object */
 
 DECL_GLPROC(void, glGenRenderbuffers, (GLsizei n, GLuint *));
@@ -214,8 +233,13 @@ DECL_GLPROC(void, glGenerateMipmap, (GLenum));
 
 #if 1 //WHICH EXTENSION???
 DECL_GLPROC(void, glClearBufferfv, (GLenum, GLint, const GLfloat*));
+DECL_GLPROC(void, glClearBufferfi, (GLenum, GLint, GLfloat, GLint));
 #endif
 
+/* GL_ARB_invalidate_subdata */
+
+DECL_GLPROC(void, glInvalidateFramebuffer, (GLenum, GLsizei, const GLenum*));
+
 /* GL_ARB_draw_instanced */
 
 DECL_GLPROC(void, glDrawArraysInstanced, (GLenum, GLint, GLsizei, GLsizei));
@@ -225,6 +249,12 @@ DECL_GLPROC(void, glDrawElementsInstanced, (GLenum, GLsizei, GLenum, const void*
 
 DECL_GLPROC(void, glDrawElementsBaseVertex, (GLenum, GLsizei, GLenum, const void*, GLint));
 DECL_GLPROC(void, glDrawElementsInstancedBaseVertex, (GLenum, GLsizei, GLenum, const void*, GLsizei, GLint));
+DECL_GLPROC(void, glMultiDrawElementsBaseVertex, (GLenum, const GLsizei*, GLenum, const void* const*, GLsizei, const GLint*));
+
+/* GL_EXT_multi_draw_arrays */
+
+DECL_GLPROC(void, glMultiDrawArrays, (GLenum, const GLint*, const GLsizei*, GLsizei));
+DECL_GLPROC(void, glMultiDrawElements, (GLenum, const GLsizei*, GLenum, const void* const*, GLsizei));
 
 /* GL_ARB_base_instance */
 
@@ -232,6 +262,16 @@ DECL_GLPROC(void, glDrawArraysInstancedBaseInstance, (GLenum, GLint, GLsizei, GL
 DECL_GLPROC(void, glDrawElementsInstancedBaseInstance, (GLenum, GLsizei, GLenum, const void*, GLsizei, GLuint));
 DECL_GLPROC(void, glDrawElementsInstancedBaseVertexBaseInstance, (GLenum, GLsizei, GLenum, const void*, GLsizei, GLint, GLuint));
 
+/* GL_ARB_draw_indirect */
+
+DECL_GLPROC(void, glDrawArraysIndirect, (GLenum, const void*));
+DECL_GLPROC(void, glDrawElementsIndirect, (GLenum, GLenum, const void*));
+
+/* GL_ARB_multi_draw_indirect */
+
+DECL_GLPROC(void, glMultiDrawArraysIndirect, (GLenum, const void*, GLsizei, GLsizei));
+DECL_GLPROC(void, glMultiDrawElementsIndirect, (GLenum, GLenum, const void*, GLsizei, GLsizei));
+
 /* GL_ARB_shader_objects */
 
 DECL_GLPROC(GLuint, glCreateShader, (GLenum));
@@ -276,12 +316,46 @@ DECL_GLPROC(void, glPatchParameterfv, (GLenum, const GLfloat*));
 DECL_GLPROC(void, glDispatchCompute, (GLuint, GLuint, GLuint));
 DECL_GLPROC(void, glDispatchComputeIndirect, (GLintptr));
 
+/* GL_ARB_shader_image_load_store */
+
+DECL_GLPROC(void, glMemoryBarrier, (GLbitfield));
+
 /* GL_ARB_get_program_binary */
 
 DECL_GLPROC(void, glGetProgramBinary, (GLuint, GLsizei, GLsizei*, GLenum*, void*));
 DECL_GLPROC(void, glProgramBinary, (GLuint, GLenum, const void*, GLsizei));
 DECL_GLPROC(void, glProgramParameteri, (GLuint, GLenum, GLint));
 
+/* GL_ARB_shader_subroutine */
+
+DECL_GLPROC(GLint, glGetSubroutineUniformLocation, (GLuint, GLenum, const GLchar*));
+DECL_GLPROC(GLuint, glGetSubroutineIndex, (GLuint, GLenum, const GLchar*));
+DECL_GLPROC(void, glGetProgramStageiv, (GLuint, GLenum, GLenum, GLint*));
+DECL_GLPROC(void, glUniformSubroutinesuiv, (GLenum, GLsizei, const GLuint*));
+
+/* GL_ARB_separate_shader_objects */
+
+DECL_GLPROC(void, glUseProgramStages, (GLuint, GLbitfield, GLuint));
+DECL_GLPROC(void, glActiveShaderProgram, (GLuint, GLuint));
+DECL_GLPROC(GLuint, glCreateShaderProgramv, (GLenum, GLsizei, const GLchar* const*));
+DECL_GLPROC(void, glBindProgramPipeline, (GLuint));
+DECL_GLPROC(void, glDeleteProgramPipelines, (GLsizei, const GLuint*));
+DECL_GLPROC(void, glGenProgramPipelines, (GLsizei, GLuint*));
+DECL_GLPROC(void, glGetProgramPipelineiv, (GLuint, GLenum, GLint*));
+DECL_GLPROC(void, glValidateProgramPipeline, (GLuint));
+DECL_GLPROC(void, glGetProgramPipelineInfoLog, (GLuint, GLsizei, GLsizei*, GLchar*));
+DECL_GLPROC(void, glProgramUniform1iv, (GLuint, GLint, GLsizei, const GLint*));
+DECL_GLPROC(void, glProgramUniform2iv, (GLuint, GLint, GLsizei, const GLint*));
+DECL_GLPROC(void, glProgramUniform3iv, (GLuint, GLint, GLsizei, const GLint*));
+DECL_GLPROC(void, glProgramUniform4iv, (GLuint, GLint, GLsizei, const GLint*));
+DECL_GLPROC(void, glProgramUniform1fv, (GLuint, GLint, GLsizei, const GLfloat*));
+DECL_GLPROC(void, glProgramUniform2fv, (GLuint, GLint, GLsizei, const GLfloat*));
+DECL_GLPROC(void, glProgramUniform3fv, (GLuint, GLint, GLsizei, const GLfloat*));
+DECL_GLPROC(void, glProgramUniform4fv, (GLuint, GLint, GLsizei, const GLfloat*));
+DECL_GLPROC(void, glProgramUniformMatrix2fv, (GLuint, GLint, GLsizei, GLboolean, const GLfloat*));
+DECL_GLPROC(void, glProgramUniformMatrix3fv, (GLuint, GLint, GLsizei, GLboolean, const GLfloat*));
+DECL_GLPROC(void, glProgramUniformMatrix4fv, (GLuint, GLint, GLsizei, GLboolean, const GLfloat*));
+
 /* GL_ARB_program_interface_query */
 
 DECL_GLPROC(void, glGetProgramInterfaceiv, (GLuint, GLenum, GLenum, GLint*));
@@ -296,6 +370,8 @@ DECL_GLPROC(GLint, glGetProgramResourceLocationIndex, (GLuint, GLenum, const GLc
 DECL_GLPROC(GLuint, glGetUniformBlockIndex, (GLuint, const GLchar*));
 DECL_GLPROC(void, glGetActiveUniformBlockiv, (GLuint, GLuint, GLenum, GLint*));
 DECL_GLPROC(void, glGetActiveUniformBlockName, (GLuint, GLuint, GLsizei, GLsizei*, GLchar*));
+DECL_GLPROC(void, glGetActiveUniformsiv, (GLuint, GLsizei, const GLuint*, GLenum, GLint*));
+DECL_GLPROC(void, glGetActiveUniformName, (GLuint, GLuint, GLsizei, GLsizei*, GLchar*));
 DECL_GLPROC(void, glUniformBlockBinding, (GLuint, GLuint, GLuint));
 DECL_GLPROC(void, glBindBufferBase, (GLenum, GLuint, GLuint));
 
@@ -342,6 +418,91 @@ DECL_GLPROC(void, glDebugMessageCallback, (GLDEBUGPROC, const void*));
 /* GL_ARB_clip_control */
 
 DECL_GLPROC(void, glClipControl, (GLenum, GLenum));
+
+/* GL_ARB_map_buffer_range */
+
+DECL_GLPROC(void*, glMapBufferRange, (GLenum, GLintptr, GLsizeiptr, GLbitfield));
+DECL_GLPROC(void, glFlushMappedBufferRange, (GLenum, GLintptr, GLsizeiptr));
+
+/* GL_ARB_buffer_storage */
+
+DECL_GLPROC(void, glBufferStorage, (GLenum, GLsizeiptr, const void*, GLbitfield));
+
+/* GL_ARB_sync */
+
+DECL_GLPROC(GLsync, glFenceSync, (GLenum, GLbitfield));
+DECL_GLPROC(void, glDeleteSync, (GLsync));
+DECL_GLPROC(GLenum, glClientWaitSync, (GLsync, GLbitfield, GLuint64));
+DECL_GLPROC(void, glGetInteger64v, (GLenum, GLint64*));
+
+/* GL_ARB_copy_buffer */
+
+DECL_GLPROC(void, glCopyBufferSubData, (GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr));
+
+/* GL_ARB_copy_image */
+
+DECL_GLPROC(void, glCopyImageSubData, (GLuint, GLenum, GLint, GLint, GLint, GLint, GLuint, GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei));
+
+/* GL_ARB_texture_storage */
+
+DECL_GLPROC(void, glTexStorage1D, (GLenum, GLsizei, GLenum, GLsizei));
+DECL_GLPROC(void, glTexStorage2D, (GLenum, GLsizei, GLenum, GLsizei, GLsizei));
+DECL_GLPROC(void, glTexStorage3D, (GLenum, GLsizei, GLenum, GLsizei, GLsizei, GLsizei));
+
+/* GL_ARB_texture_storage_multisample */
+
+DECL_GLPROC(void, glTexStorage2DMultisample, (GLenum, GLsizei, GLenum, GLsizei, GLsizei, GLboolean));
+DECL_GLPROC(void, glTexStorage3DMultisample, (GLenum, GLsizei, GLenum, GLsizei, GLsizei, GLsizei, GLboolean));
+
+/* GL_ARB_texture_view */
+
+DECL_GLPROC(void, glTextureView, (GLuint, GLenum, GLuint, GLenum, GLuint, GLuint, GLuint, GLuint));
+
+/* GL_ARB_internalformat_query */
+
+DECL_GLPROC(void, glGetInternalformativ, (GLenum, GLenum, GLenum, GLsizei, GLint*));
+
+/* GL_ARB_sparse_texture */
+
+DECL_GLPROC(void, glTexPageCommitmentARB, (GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLboolean));
+
+/* GL_ARB_direct_state_access */
+
+DECL_GLPROC(void, glCreateBuffers, (GLsizei, GLuint*));
+DECL_GLPROC(void, glNamedBufferData, (GLuint, GLsizeiptr, const void*, GLenum));
+DECL_GLPROC(void, glNamedBufferSubData, (GLuint, GLintptr, GLsizeiptr, const void*));
+DECL_GLPROC(void*, glMapNamedBuffer, (GLuint, GLenum));
+DECL_GLPROC(void*, glMapNamedBufferRange, (GLuint, GLintptr, GLsizeiptr, GLbitfield));
+DECL_GLPROC(GLboolean, glUnmapNamedBuffer, (GLuint));
+DECL_GLPROC(void, glFlushMappedNamedBufferRange, (GLuint, GLintptr, GLsizeiptr));
+DECL_GLPROC(void, glCreateTextures, (GLenum, GLsizei, GLuint*));
+DECL_GLPROC(void, glTextureParameteri, (GLuint, GLenum, GLint));
+DECL_GLPROC(void, glTextureSubImage1D, (GLuint, GLint, GLint, GLsizei, GLenum, GLenum, const void*));
+DECL_GLPROC(void, glTextureSubImage2D, (GLuint, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*));
+DECL_GLPROC(void, glTextureSubImage3D, (GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void*));
+DECL_GLPROC(void, glCompressedTextureSubImage1D, (GLuint, GLint, GLint, GLsizei, GLenum, GLsizei, const void*));
+DECL_GLPROC(void, glCompressedTextureSubImage2D, (GLuint, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*));
+DECL_GLPROC(void, glCompressedTextureSubImage3D, (GLuint, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void*));
+DECL_GLPROC(void, glGenerateTextureMipmap, (GLuint));
+DECL_GLPROC(void, glGetTextureLevelParameteriv, (GLuint, GLint, GLenum, GLint*));
+
+/* GL_ARB_bindless_texture */
+
+DECL_GLPROC(GLuint64, glGetTextureHandleARB, (GLuint));
+DECL_GLPROC(GLuint64, glGetTextureSamplerHandleARB, (GLuint, GLuint));
+DECL_GLPROC(void, glMakeTextureHandleResidentARB, (GLuint64));
+DECL_GLPROC(void, glMakeTextureHandleNonResidentARB, (GLuint64));
+
+/* GL_ARB_parallel_shader_compile */
+
+DECL_GLPROC(void, glMaxShaderCompilerThreadsARB, (GLuint));
+
+/* GL_ARB_gl_spirv */
+
+#ifdef GL_ARB_gl_spirv
+DECL_GLPROC(void, glShaderBinary, (GLsizei, const GLuint*, GLenum, const void*, GLsizei));
+DECL_GLPROC(void, glSpecializeShaderARB, (GLuint, const GLchar*, GLuint, const GLuint*, const GLuint*));
+#endif
     
 /* GL_EXT_transform_feedback */
 
@@ -360,6 +521,41 @@ DECL_GLPROC(void, glTransformFeedbackVaryingsNV, (GLuint, GLsizei, const GLint*,
 DECL_GLPROC(GLint, glGetVaryingLocationNV, (GLuint, const GLchar*));
 DECL_GLPROC(void, glGetActiveVaryingNV, (GLuint, GLuint, GLsizei, GLsizei*, GLsizei*, GLenum*, GLchar*));
 
+/* GL_ARB_transform_feedback2 */
+
+DECL_GLPROC(void, glGenTransformFeedbacks, (GLsizei, GLuint*));
+DECL_GLPROC(void, glDeleteTransformFeedbacks, (GLsizei, const GLuint*));
+DECL_GLPROC(void, glBindTransformFeedback, (GLenum, GLuint));
+DECL_GLPROC(GLboolean, glIsTransformFeedback, (GLuint));
+DECL_GLPROC(void, glPauseTransformFeedback, (void));
+DECL_GLPROC(void, glResumeTransformFeedback, (void));
+DECL_GLPROC(void, glDrawTransformFeedback, (GLenum, GLuint));
+
+/* GL_NV_shading_rate_image */
+
+#ifdef GL_NV_shading_rate_image
+DECL_GLPROC(void, glBindShadingRateImageNV, (GLuint));
+DECL_GLPROC(void, glShadingRateImagePaletteNV, (GLuint, GLuint, GLsizei, const GLenum*));
+#endif
+
+/* GL_NV_mesh_shader */
+
+#ifdef GL_NV_mesh_shader
+DECL_GLPROC(void, glDrawMeshTasksNV, (GLuint, GLuint));
+#endif
+
+/* GL_EXT_depth_bounds_test */
+
+#ifdef GL_EXT_depth_bounds_test
+DECL_GLPROC(void, glDepthBoundsEXT, (GLclampd, GLclampd));
+#endif
+
+/* GL_OVR_multiview */
+
+#ifdef GL_OVR_multiview
+DECL_GLPROC(void, glFramebufferTextureMultiviewOVR, (GLenum, GLenum, GLuint, GLint, GLint, GLsizei));
+#endif
+
 #endif // /ifndef(__APPLE__)
 
 #undef DECL_GLPROC
@@ -8,11 +8,14 @@
 #include "GLCommandBuffer.h"
 #include "GLRenderContext.h"
 #include "../GLCommon/GLTypes.h"
+#include "../GLCommon/Texture/GLTexSubImage.h"
 #include "Ext/GLExtensions.h"
 #include "Ext/GLExtensionLoader.h"
 #include "../Assertion.h"
 #include "../CheckedCast.h"
+#include "../DeferredCommandBuffer.h"
 #include "../../Core/Exception.h"
+#include "../../Core/Helper.h"
 
 #include "Shader/GLShaderProgram.h"
 
@@ -25,31 +28,54 @@
 #include "Buffer/GLVertexBuffer.h"
 #include "Buffer/GLIndexBuffer.h"
 #include "Buffer/GLVertexBufferArray.h"
+#include "Buffer/GLStorageBuffer.h"
+#include "Buffer/GLStorageBufferArray.h"
+#include "Buffer/GLStreamOutputBuffer.h"
+#include "Buffer/GLStreamOutputBufferArray.h"
 
 #include "RenderState/GLStateManager.h"
 #include "RenderState/GLGraphicsPipeline.h"
 #include "RenderState/GLComputePipeline.h"
+#include "RenderState/GLResourceHeap.h"
 #include "RenderState/GLQuery.h"
+#include "RenderState/GLQueryArray.h"
+#include "RenderState/GLFence.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-GLCommandBuffer::GLCommandBuffer(const std::shared_ptr<GLStateManager>& stateMngr) :
+// Minimum value of GL_MAX_VIEWPORTS that is guaranteed by GL_ARB_viewport_array.
+static const unsigned int g_maxNumViewports = 16;
+
+GLCommandBuffer::GLCommandBuffer(const std::shared_ptr<GLStateManager>& stateMngr, long flags) :
     stateMngr_ { stateMngr }
 {
+    if ((flags & CommandBufferFlags::MergeDraws) != 0 && GLDrawMerger::IsSupported())
+        drawMerger_ = MakeUnique<GLDrawMerger>();
+}
+
+GLCommandBuffer::~GLCommandBuffer()
+{
+    /* Submit remaining draw commands, since the state manager must not refer to the draw merger of this command buffer */
+    if (drawMerger_)
+        stateMngr_->FlushPendingDraws();
 }
 
 /* ----- Configuration ----- */
 
 void GLCommandBuffer::SetGraphicsAPIDependentState(const GraphicsAPIDependentStateDescriptor& state)
 {
+    stateMngr_->FlushPendingDraws();
     stateMngr_->SetGraphicsAPIDependentState(state);
 }
 
 void GLCommandBuffer::SetViewport(const Viewport& viewport)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Setup GL viewport and depth-range */
     GLViewport viewportGL { viewport.x, viewport.y, viewport.width, viewport.height };
     GLDepthRange depthRangeGL { viewport.minDepth, viewport.maxDepth };
@@ -61,27 +87,30 @@ void GLCommandBuffer::SetViewport(const Viewport& viewport)
 
 void GLCommandBuffer::SetViewportArray(unsigned int numViewports, const Viewport* viewportArray)
 {
-    /* Setup GL viewports and depth-ranges */
-    std::vector<GLViewport> viewportsGL;
-    viewportsGL.reserve(numViewports);
+    stateMngr_->FlushPendingDraws();
+
+    /* Setup GL viewports and depth-ranges in fixed-size arrays to avoid heap allocations */
+    GLViewport viewportsGL[g_maxNumViewports];
+    GLDepthRange depthRangesGL[g_maxNumViewports];
 
-    std::vector<GLDepthRange> depthRangesGL;
-    depthRangesGL.reserve(numViewports);
+    auto count = std::min(numViewports, g_maxNumViewports);
 
-    for (unsigned int i = 0; i < numViewports; ++i)
+    for (unsigned int i = 0; i < count; ++i)
     {
         const auto& vp = viewportArray[i];
-        viewportsGL.push_back({ vp.x, vp.y, vp.width, vp.height });
-        depthRangesGL.push_back({ static_cast<GLdouble>(vp.minDepth), static_cast<GLdouble>(vp.maxDepth) });
+        viewportsGL[i] = { vp.x, vp.y, vp.width, vp.height };
+        depthRangesGL[i] = { static_cast<GLdouble>(vp.minDepth), static_cast<GLdouble>(vp.maxDepth) };
     }
 
     /* Submit viewports and depth-ranges to state manager */
-    stateMngr_->SetViewportArray(std::move(viewportsGL));
-    stateMngr_->SetDepthRangeArray(std::move(depthRangesGL));
+    stateMngr_->SetViewportArray(static_cast<GLsizei>(count), viewportsGL);
+    stateMngr_->SetDepthRangeArray(static_cast<GLsizei>(count), depthRangesGL);
 }
 
 void GLCommandBuffer::SetScissor(const Scissor& scissor)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Setup and submit GL scissor to state manager */
     GLScissor scissorGL { scissor.x, scissor.y, scissor.width, scissor.height };
     stateMngr_->SetScissor(scissorGL);
@@ -89,37 +118,83 @@ void GLCommandBuffer::SetScissor(const Scissor& scissor)
 
 void GLCommandBuffer::SetScissorArray(unsigned int numScissors, const Scissor* scissorArray)
 {
-    /* Setup GL scissors */
-    std::vector<GLScissor> scissorsGL;
-    scissorsGL.reserve(numScissors);
+    stateMngr_->FlushPendingDraws();
 
-    for (unsigned int i = 0; i < numScissors; ++i)
+    /* Setup GL scissors in a fixed-size array to avoid heap allocations */
+    GLScissor scissorsGL[g_maxNumViewports];
+
+    auto count = std::min(numScissors, g_maxNumViewports);
+
+    for (unsigned int i = 0; i < count; ++i)
     {
         const auto& sc = scissorArray[i];
-        scissorsGL.push_back({ sc.x, sc.y, sc.width, sc.height });
+        scissorsGL[i] = { sc.x, sc.y, sc.width, sc.height };
     }
 
     /* Submit scissors to state manager */
-    stateMngr_->SetScissorArray(std::move(scissorsGL));
+    stateMngr_->SetScissorArray(static_cast<GLsizei>(count), scissorsGL);
+}
+
+void GLCommandBuffer::SetShadingRate(const ShadingRate rate)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+    if (HasExtension(GLExt::NV_shading_rate_image))
+    {
+        shadingRate_ = rate;
+        SubmitShadingRateNV();
+    }
+    #endif
+}
+
+void GLCommandBuffer::SetShadingRateImage(Texture* texture)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+    if (HasExtension(GLExt::NV_shading_rate_image))
+    {
+        shadingRateImage_ = (texture != nullptr ? LLGL_CAST(GLTexture*, texture)->GetID() : 0);
+        glBindShadingRateImageNV(shadingRateImage_);
+        SubmitShadingRateNV();
+    }
+    #endif
+}
+
+void GLCommandBuffer::SetDepthBounds(float minDepth, float maxDepth)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #ifdef GL_EXT_depth_bounds_test
+    if (HasExtension(GLExt::EXT_depth_bounds_test))
+        glDepthBoundsEXT(minDepth, maxDepth);
+    #endif
 }
 
 void GLCommandBuffer::SetClearColor(const ColorRGBAf& color)
 {
+    stateMngr_->FlushPendingDraws();
     glClearColor(color.r, color.g, color.b, color.a);
+    clearColor_ = color;
 }
 
 void GLCommandBuffer::SetClearDepth(float depth)
 {
+    stateMngr_->FlushPendingDraws();
     glClearDepth(depth);
 }
 
 void GLCommandBuffer::SetClearStencil(int stencil)
 {
+    stateMngr_->FlushPendingDraws();
     glClearStencil(stencil);
 }
 
 void GLCommandBuffer::Clear(long flags)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Setup GL clear mask and clear respective buffer */
     GLbitfield mask = 0;
 
@@ -132,6 +207,7 @@ void GLCommandBuffer::Clear(long flags)
     if ((flags & ClearFlags::Depth) != 0)
     {
         stateMngr_->SetDepthMask(GL_TRUE);
+        stateMngr_->InvalidatePipelineState();
         mask |= GL_DEPTH_BUFFER_BIT;
     }
 
@@ -146,28 +222,43 @@ void GLCommandBuffer::Clear(long flags)
 
 void GLCommandBuffer::ClearTarget(unsigned int targetIndex, const LLGL::ColorRGBAf& color)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Clear target color buffer */
     glClearBufferfv(GL_COLOR, targetIndex, color.Ptr());
 }
 
 /* ----- Buffers ------ */
 
-void GLCommandBuffer::SetVertexBuffer(Buffer& buffer)
+void GLCommandBuffer::SetVertexBuffer(Buffer& buffer, unsigned int offset)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Bind vertex buffer */
     auto& vertexBufferGL = LLGL_CAST(GLVertexBuffer&, buffer);
-    stateMngr_->BindVertexArray(vertexBufferGL.GetVaoID());
+    vertexBufferGL.Bind(*stateMngr_, static_cast<GLintptr>(offset));
+
+    /* Store transform feedback object of stream-output buffers for "DrawStreamOutput" */
+    if (buffer.GetType() == BufferType::StreamOutput)
+        renderState_.drawTransformFeedback = LLGL_CAST(GLStreamOutputBuffer&, buffer).GetTransformFeedbackID();
+    else
+        renderState_.drawTransformFeedback = 0;
 }
 
 void GLCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Bind vertex buffer */
     auto& vertexBufferArrayGL = LLGL_CAST(GLVertexBufferArray&, bufferArray);
-    stateMngr_->BindVertexArray(vertexBufferArrayGL.GetVaoID());
+    vertexBufferArrayGL.Bind(*stateMngr_);
+    renderState_.drawTransformFeedback = 0;
 }
 
-void GLCommandBuffer::SetIndexBuffer(Buffer& buffer)
+void GLCommandBuffer::SetIndexBuffer(Buffer& buffer, unsigned int offset)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Bind index buffer deferred (can only be bound to the active VAO) */
     auto& indexBufferGL = LLGL_CAST(GLIndexBuffer&, buffer);
     stateMngr_->DeferredBindIndexBuffer(indexBufferGL.GetID());
@@ -176,40 +267,127 @@ void GLCommandBuffer::SetIndexBuffer(Buffer& buffer)
     const auto& format = indexBufferGL.GetIndexFormat();
     renderState_.indexBufferDataType    = GLTypes::Map(format.GetDataType());
     renderState_.indexBufferStride      = format.GetFormatSize();
+    renderState_.indexBufferOffset      = static_cast<GLintptr>(offset);
 }
 
 void GLCommandBuffer::SetConstantBuffer(Buffer& buffer, unsigned int slot, long /*shaderStageFlags*/)
 {
+    stateMngr_->FlushPendingDraws();
     SetGenericBuffer(GLBufferTarget::UNIFORM_BUFFER, buffer, slot);
 }
 
 void GLCommandBuffer::SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long /*shaderStageFlags*/)
 {
+    stateMngr_->FlushPendingDraws();
     SetGenericBufferArray(GLBufferTarget::UNIFORM_BUFFER, bufferArray, startSlot);
 }
 
+void GLCommandBuffer::SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long /*shaderStageFlags*/)
+{
+    stateMngr_->FlushPendingDraws();
+
+    /* Bind buffer range with BindBufferRange */
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBufferRange(
+        GLBufferTarget::UNIFORM_BUFFER,
+        slot,
+        bufferGL.GetID(),
+        static_cast<GLintptr>(offset),
+        static_cast<GLsizeiptr>(size)
+    );
+}
+
 void GLCommandBuffer::SetStorageBuffer(Buffer& buffer, unsigned int slot, long /*shaderStageFlags*/)
 {
+    stateMngr_->FlushPendingDraws();
     SetGenericBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, buffer, slot);
+
+    /* Bind atomic counter to the same binding point as the storage buffer */
+    auto& bufferGL = LLGL_CAST(GLStorageBuffer&, buffer);
+    if (auto counterID = bufferGL.GetCounterID())
+        stateMngr_->BindBufferBase(GLBufferTarget::ATOMIC_COUNTER_BUFFER, slot, counterID);
 }
 
 void GLCommandBuffer::SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long /*shaderStageFlags*/)
 {
+    stateMngr_->FlushPendingDraws();
     SetGenericBufferArray(GLBufferTarget::SHADER_STORAGE_BUFFER, bufferArray, startSlot);
+
+    /* Bind atomic counters to the same binding points as the storage buffers */
+    auto& bufferArrayGL = LLGL_CAST(GLStorageBufferArray&, bufferArray);
+    if (bufferArrayGL.HasCounters())
+    {
+        stateMngr_->BindBuffersBase(
+            GLBufferTarget::ATOMIC_COUNTER_BUFFER,
+            startSlot,
+            static_cast<GLsizei>(bufferArrayGL.GetCounterIDArray().size()),
+            bufferArrayGL.GetCounterIDArray().data()
+        );
+    }
+}
+
+void GLCommandBuffer::ResetBufferCounter(Buffer& buffer, unsigned int value)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& bufferGL = LLGL_CAST(GLStorageBuffer&, buffer);
+    if (bufferGL.GetCounterID() != 0)
+        bufferGL.ResetCounter(*stateMngr_, static_cast<GLuint>(value));
+}
+
+void GLCommandBuffer::CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #ifdef GL_ARB_copy_buffer
+    if (HasExtension(GLExt::ARB_copy_buffer))
+    {
+        auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+        auto& srcBufferGL = LLGL_CAST(GLStorageBuffer&, srcBuffer);
+
+        stateMngr_->BindBuffer(GLBufferTarget::COPY_READ_BUFFER, srcBufferGL.GetCounterID());
+        stateMngr_->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, dstBufferGL.GetID());
+
+        glCopyBufferSubData(
+            GL_COPY_READ_BUFFER,
+            GL_COPY_WRITE_BUFFER,
+            0,
+            static_cast<GLintptr>(dstOffset),
+            static_cast<GLsizeiptr>(sizeof(GLuint))
+        );
+    }
+    else
+    #endif
+    {
+        ThrowNotSupported("buffer counter copies");
+    }
 }
 
 void GLCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
 {
+    stateMngr_->FlushPendingDraws();
+
+    /* Bind transform feedback object first, since it stores the buffer bindings */
+    auto& bufferGL = LLGL_CAST(GLStreamOutputBuffer&, buffer);
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, bufferGL.GetTransformFeedbackID());
     SetGenericBuffer(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, buffer, 0);
 }
 
 void GLCommandBuffer::SetStreamOutputBufferArray(BufferArray& bufferArray)
 {
+    stateMngr_->FlushPendingDraws();
+
+    /* Bind transform feedback object of the first buffer, since it stores the buffer bindings */
+    auto& bufferArrayGL = LLGL_CAST(GLStreamOutputBufferArray&, bufferArray);
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, bufferArrayGL.GetTransformFeedbackID());
     SetGenericBufferArray(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, bufferArray, 0);
 }
 
 void GLCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 {
+    stateMngr_->FlushPendingDraws();
+
     #ifdef __APPLE__
     glBeginTransformFeedback(GLTypes::Map(primitiveType));
     #else
@@ -224,6 +402,8 @@ void GLCommandBuffer::BeginStreamOutput(const PrimitiveType primitiveType)
 
 void GLCommandBuffer::EndStreamOutput()
 {
+    stateMngr_->FlushPendingDraws();
+
     #ifdef __APPLE__
     glEndTransformFeedback();
     #else
@@ -236,10 +416,30 @@ void GLCommandBuffer::EndStreamOutput()
     #endif
 }
 
+void GLCommandBuffer::PauseStreamOutput()
+{
+    stateMngr_->FlushPendingDraws();
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glPauseTransformFeedback();
+    else
+        ThrowNotSupported("pausing stream-outputs");
+}
+
+void GLCommandBuffer::ResumeStreamOutput()
+{
+    stateMngr_->FlushPendingDraws();
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glResumeTransformFeedback();
+    else
+        ThrowNotSupported("resuming stream-outputs");
+}
+
 /* ----- Textures ----- */
 
 void GLCommandBuffer::SetTexture(Texture& texture, unsigned int slot, long /*shaderStageFlags*/)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Bind texture to layer */
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     stateMngr_->ActiveTexture(slot);
@@ -248,6 +448,8 @@ void GLCommandBuffer::SetTexture(Texture& texture, unsigned int slot, long /*sha
 
 void GLCommandBuffer::SetTextureArray(TextureArray& textureArray, unsigned int startSlot, long /*shaderStageFlags*/)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Bind texture array to layers */
     auto& textureArrayGL = LLGL_CAST(GLTextureArray&, textureArray);
     stateMngr_->BindTextures(
@@ -262,12 +464,14 @@ void GLCommandBuffer::SetTextureArray(TextureArray& textureArray, unsigned int s
 
 void GLCommandBuffer::SetSampler(Sampler& sampler, unsigned int slot, long /*shaderStageFlags*/)
 {
+    stateMngr_->FlushPendingDraws();
     auto& samplerGL = LLGL_CAST(GLSampler&, sampler);
     stateMngr_->BindSampler(slot, samplerGL.GetID());
 }
 
 void GLCommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long /*shaderStageFlags*/)
 {
+    stateMngr_->FlushPendingDraws();
     auto& samplerArrayGL = LLGL_CAST(GLSamplerArray&, samplerArray);
     stateMngr_->BindSamplers(
         startSlot,
@@ -276,6 +480,15 @@ void GLCommandBuffer::SetSamplerArray(SamplerArray& samplerArray, unsigned int s
     );
 }
 
+/* ----- Resource Heaps ----- */
+
+void GLCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& resourceHeapGL = LLGL_CAST(GLResourceHeap&, resourceHeap);
+    resourceHeapGL.Bind(*stateMngr_);
+}
+
 /* ----- Render Targets ----- */
 
 //private
@@ -287,6 +500,8 @@ void GLCommandBuffer::BlitBoundRenderTarget()
 
 void GLCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Blit previously bound render target (in case mutli-sampling is used) */
     BlitBoundRenderTarget();
 
@@ -303,6 +518,7 @@ void GLCommandBuffer::SetRenderTarget(RenderTarget& renderTarget)
 
 void GLCommandBuffer::SetRenderTarget(RenderContext& renderContext)
 {
+    stateMngr_->FlushPendingDraws();
     auto& renderContextGL = LLGL_CAST(GLRenderContext&, renderContext);
 
     /* Blit previously bound render target (in case mutli-sampling is used) */
@@ -317,17 +533,126 @@ void GLCommandBuffer::SetRenderTarget(RenderContext& renderContext)
     */
     GLRenderContext::GLMakeCurrent(&renderContextGL);
 
+    /* Continue with the state manager of the render context, since each hardware context has its own GL states */
+    stateMngr_ = renderContextGL.GetStateManager();
+
     /* Reset reference to render target */
     boundRenderTarget_ = nullptr;
 }
 
+/* ----- Render Passes ----- */
+
+// Maximum number of color attachments that are considered for a render pass (minimum of GL_MAX_COLOR_ATTACHMENTS).
+static const std::size_t g_maxNumRenderPassColorAttachments = 8;
+
+// Returns the number of color attachments of the specified render pass that are applied to the bound framebuffer.
+static std::size_t GetNumRenderPassColorAttachments(const RenderPassDescriptor& renderPassDesc, bool defaultFramebuffer)
+{
+    return std::min(renderPassDesc.colorAttachments.size(), (defaultFramebuffer ? 1 : g_maxNumRenderPassColorAttachments));
+}
+
+// Invalidates all attachments of the bound draw framebuffer, for which the predicate returns true (requires GL_ARB_invalidate_subdata).
+template <typename TPredicate>
+static void GLInvalidateAttachments(const RenderPassDescriptor& renderPassDesc, bool defaultFramebuffer, TPredicate pred)
+{
+    #ifdef GL_ARB_invalidate_subdata
+    if (HasExtension(GLExt::ARB_invalidate_subdata))
+    {
+        GLenum  attachments[g_maxNumRenderPassColorAttachments + 2];
+        GLsizei numAttachments = 0;
+
+        for (std::size_t i = 0, n = GetNumRenderPassColorAttachments(renderPassDesc, defaultFramebuffer); i < n; ++i)
+        {
+            if (pred(renderPassDesc.colorAttachments[i]))
+                attachments[numAttachments++] = (defaultFramebuffer ? GL_COLOR : static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + i));
+        }
+
+        if (pred(renderPassDesc.depthAttachment))
+            attachments[numAttachments++] = (defaultFramebuffer ? GL_DEPTH : GL_DEPTH_ATTACHMENT);
+        if (pred(renderPassDesc.stencilAttachment))
+            attachments[numAttachments++] = (defaultFramebuffer ? GL_STENCIL : GL_STENCIL_ATTACHMENT);
+
+        if (numAttachments > 0)
+            glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, numAttachments, attachments);
+    }
+    #endif
+}
+
+void GLCommandBuffer::BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc)
+{
+    stateMngr_->FlushPendingDraws();
+    SetRenderTarget(renderTarget);
+    renderPassDefaultFBO_ = false;
+    LoadRenderPassAttachments(renderPassDesc);
+}
+
+void GLCommandBuffer::BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc)
+{
+    stateMngr_->FlushPendingDraws();
+    SetRenderTarget(renderContext);
+    renderPassDefaultFBO_ = true;
+    LoadRenderPassAttachments(renderPassDesc);
+}
+
+void GLCommandBuffer::EndRenderPass()
+{
+    stateMngr_->FlushPendingDraws();
+    if (boundRenderTarget_ != nullptr && boundRenderTarget_->HasFramebufferMS())
+    {
+        /* Resolve multi-sample framebuffer, unless all attachments are discarded */
+        auto IsDiscarded = [](const RenderPassAttachmentDescriptor& attachment)
+        {
+            return (attachment.storeOp == AttachmentStoreOp::Discard);
+        };
+
+        bool resolve =
+        (
+            renderPassDesc_.colorAttachments.size() < boundRenderTarget_->GetNumColorAttachments() ||
+            !std::all_of(renderPassDesc_.colorAttachments.begin(), renderPassDesc_.colorAttachments.end(), IsDiscarded) ||
+            !IsDiscarded(renderPassDesc_.depthAttachment) ||
+            !IsDiscarded(renderPassDesc_.stencilAttachment)
+        );
+
+        if (resolve)
+        {
+            boundRenderTarget_->BlitOntoFrameBuffer();
+            stateMngr_->BindFramebuffer(GLFramebufferTarget::DRAW_FRAMEBUFFER, boundRenderTarget_->GetFramebuffer().GetID());
+        }
+
+        /* Multi-sample content is no longer required after it has been resolved */
+        GLInvalidateAttachments(
+            renderPassDesc_, false,
+            [](const RenderPassAttachmentDescriptor& attachment)
+            {
+                return (attachment.storeOp != AttachmentStoreOp::Store);
+            }
+        );
+
+        /* Don't blit the render target again when the next render target is set */
+        boundRenderTarget_ = nullptr;
+    }
+    else
+    {
+        GLInvalidateAttachments(
+            renderPassDesc_, renderPassDefaultFBO_,
+            [](const RenderPassAttachmentDescriptor& attachment)
+            {
+                return (attachment.storeOp == AttachmentStoreOp::Discard);
+            }
+        );
+    }
+}
+
 /* ----- Pipeline States ----- */
 
 void GLCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 {
+    stateMngr_->FlushPendingDraws();
+
     /* Set graphics pipeline render states */
     auto& graphicsPipelineGL = LLGL_CAST(GLGraphicsPipeline&, graphicsPipeline);
     graphicsPipelineGL.Bind(*stateMngr_);
+    boundGraphicsPipeline_ = (&graphicsPipelineGL);
 
     /* Store draw modes */
     renderState_.drawMode = graphicsPipelineGL.GetDrawMode();
@@ -335,30 +660,83 @@ void GLCommandBuffer::SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline)
 
 void GLCommandBuffer::SetComputePipeline(ComputePipeline& computePipeline)
 {
+    stateMngr_->FlushPendingDraws();
     auto& computePipelineGL = LLGL_CAST(GLComputePipeline&, computePipeline);
     computePipelineGL.Bind(*stateMngr_);
 }
 
+void GLCommandBuffer::SetPushConstants(unsigned int offset, unsigned int size, const void* data)
+{
+    stateMngr_->FlushPendingDraws();
+    if (boundGraphicsPipeline_)
+        boundGraphicsPipeline_->SetPushConstants(*stateMngr_, offset, size, data);
+}
+
+void GLCommandBuffer::SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances)
+{
+    stateMngr_->FlushPendingDraws();
+    if (numSlots > 0 && HasExtension(GLExt::ARB_shader_subroutine))
+    {
+        /* Select subroutines for all subroutine uniforms of the stage at once (the selection is reset by "glUseProgram") */
+        subroutineIndices_.assign(classInstances, classInstances + numSlots);
+        glUniformSubroutinesuiv(GLTypes::Map(stage), static_cast<GLsizei>(numSlots), subroutineIndices_.data());
+    }
+}
+
 /* ----- Queries ----- */
 
 void GLCommandBuffer::BeginQuery(Query& query)
 {
-    /* Begin query with internal target */
+    stateMngr_->FlushPendingDraws();
     auto& queryGL = LLGL_CAST(GLQuery&, query);
-    glBeginQuery(queryGL.GetTarget(), queryGL.GetID());
+
+    if (queryGL.GetType() == QueryType::PipelineStatistics)
+    {
+        /* Begin hardware queries of all statistics */
+        const auto targets = GLQuery::GetPipelineStatisticsTargets();
+        const auto& ids = queryGL.GetPipelineStatisticsIDs();
+        for (std::size_t i = 0; i < ids.size(); ++i)
+            glBeginQuery(targets[i], ids[i]);
+    }
+    else
+    {
+        /* Begin query with internal target */
+        glBeginQuery(queryGL.GetTarget(), queryGL.GetID());
+    }
 }
 
 void GLCommandBuffer::EndQuery(Query& query)
 {
-    /* Begin query with internal target */
+    stateMngr_->FlushPendingDraws();
     auto& queryGL = LLGL_CAST(GLQuery&, query);
-    glEndQuery(queryGL.GetTarget());
+
+    if (queryGL.GetType() == QueryType::PipelineStatistics)
+    {
+        /* End hardware queries of all statistics */
+        const auto targets = GLQuery::GetPipelineStatisticsTargets();
+        for (std::size_t i = 0; i < GLQuery::numPipelineStatistics; ++i)
+            glEndQuery(targets[i]);
+    }
+    else if (queryGL.GetTarget() == GL_TIMESTAMP)
+    {
+        /* Record timestamp (requires GL_ARB_timer_query) */
+        glQueryCounter(queryGL.GetID(), GL_TIMESTAMP);
+    }
+    else
+    {
+        /* End query with internal target */
+        glEndQuery(queryGL.GetTarget());
+    }
 }
 
 bool GLCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
 {
     auto& queryGL = LLGL_CAST(GLQuery&, query);
 
+    /* Pipeline statistics can only be retrieved with "QueryPipelineStatisticsResult" */
+    if (queryGL.GetType() == QueryType::PipelineStatistics)
+        return false;
+
     /* Check if query result is available */
     GLint available = 0;
     glGetQueryObjectiv(queryGL.GetID(), GL_QUERY_RESULT_AVAILABLE, &available);
@@ -383,51 +761,379 @@ bool GLCommandBuffer::QueryResult(Query& query, std::uint64_t& result)
     return false;
 }
 
+bool GLCommandBuffer::QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results)
+{
+    auto& queryArrayGL = LLGL_CAST(GLQueryArray&, queryArray);
+    const auto& idArray = queryArrayGL.GetIDArray();
+
+    /* Check if all query results are available (starting with the last query, which is most likely still pending) */
+    for (auto i = numQueries; i > 0; --i)
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(idArray[firstQuery + i - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+            return false;
+    }
+
+    /* Get all query results */
+    if (HasExtension(GLExt::ARB_timer_query))
+    {
+        for (unsigned int i = 0; i < numQueries; ++i)
+            glGetQueryObjectui64v(idArray[firstQuery + i], GL_QUERY_RESULT, &results[i]);
+    }
+    else
+    {
+        for (unsigned int i = 0; i < numQueries; ++i)
+        {
+            GLuint result32 = 0;
+            glGetQueryObjectuiv(idArray[firstQuery + i], GL_QUERY_RESULT, &result32);
+            results[i] = result32;
+        }
+    }
+
+    return true;
+}
+
+bool GLCommandBuffer::QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result)
+{
+    auto& queryGL = LLGL_CAST(GLQuery&, query);
+    const auto& ids = queryGL.GetPipelineStatisticsIDs();
+
+    if (ids.empty())
+        return false;
+
+    /* Check if all query results are available (starting with the last query, which is most likely still pending) */
+    for (auto i = ids.size(); i > 0; --i)
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(ids[i - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+            return false;
+    }
+
+    /* Get all query results in the order of the members of QueryPipelineStatistics */
+    GLuint64 values[GLQuery::numPipelineStatistics] = {};
+
+    if (HasExtension(GLExt::ARB_timer_query))
+    {
+        for (std::size_t i = 0; i < ids.size(); ++i)
+            glGetQueryObjectui64v(ids[i], GL_QUERY_RESULT, &values[i]);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            GLuint result32 = 0;
+            glGetQueryObjectuiv(ids[i], GL_QUERY_RESULT, &result32);
+            values[i] = result32;
+        }
+    }
+
+    result.numPrimitivesGenerated               = values[ 0];
+    result.numVerticesSubmitted                 = values[ 1];
+    result.numPrimitivesSubmitted               = values[ 2];
+    result.numVertexShaderInvocations           = values[ 3];
+    result.numTessControlShaderInvocations      = values[ 4];
+    result.numTessEvaluationShaderInvocations   = values[ 5];
+    result.numGeometryShaderInvocations         = values[ 6];
+    result.numFragmentShaderInvocations         = values[ 7];
+    result.numComputeShaderInvocations          = values[ 8];
+    result.numGeometryPrimitivesGenerated       = values[ 9];
+    result.numClippingInputPrimitives           = values[10];
+    result.numClippingOutputPrimitives          = values[11];
+
+    return true;
+}
+
+void GLCommandBuffer::ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #ifdef GL_ARB_query_buffer_object
+    if (HasExtension(GLExt::ARB_query_buffer_object) && HasExtension(GLExt::ARB_timer_query))
+    {
+        auto& queryArrayGL = LLGL_CAST(GLQueryArray&, queryArray);
+        auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+        const auto& idArray = queryArrayGL.GetIDArray();
+
+        /* With a bound query buffer, the result pointer is interpreted as offset into that buffer, so the GL writes the results without a CPU round trip */
+        stateMngr_->BindBuffer(GLBufferTarget::QUERY_BUFFER, dstBufferGL.GetID());
+
+        for (unsigned int i = 0; i < numQueries; ++i)
+        {
+            auto offset = static_cast<std::size_t>(dstOffset) + static_cast<std::size_t>(i) * sizeof(GLuint64);
+            glGetQueryObjectui64v(idArray[firstQuery + i], GL_QUERY_RESULT, reinterpret_cast<GLuint64*>(offset));
+        }
+
+        stateMngr_->BindBuffer(GLBufferTarget::QUERY_BUFFER, 0);
+    }
+    else
+    #endif
+    {
+        ThrowNotSupported("resolving query data into buffers");
+    }
+}
+
 void GLCommandBuffer::BeginRenderCondition(Query& query, const RenderConditionMode mode)
 {
+    stateMngr_->FlushPendingDraws();
     auto& queryGL = LLGL_CAST(GLQuery&, query);
     glBeginConditionalRender(queryGL.GetID(), GLTypes::Map(mode));
 }
 
 void GLCommandBuffer::EndRenderCondition()
 {
+    stateMngr_->FlushPendingDraws();
     glEndConditionalRender();
 }
 
+/* ----- Copy ----- */
+
+void GLCommandBuffer::CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #ifdef GL_ARB_copy_buffer
+    if (HasExtension(GLExt::ARB_copy_buffer))
+    {
+        auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+        auto& srcBufferGL = LLGL_CAST(GLBuffer&, srcBuffer);
+
+        stateMngr_->BindBuffer(GLBufferTarget::COPY_READ_BUFFER, srcBufferGL.GetID());
+        stateMngr_->BindBuffer(GLBufferTarget::COPY_WRITE_BUFFER, dstBufferGL.GetID());
+
+        glCopyBufferSubData(
+            GL_COPY_READ_BUFFER,
+            GL_COPY_WRITE_BUFFER,
+            static_cast<GLintptr>(srcOffset),
+            static_cast<GLintptr>(dstOffset),
+            static_cast<GLsizeiptr>(size)
+        );
+    }
+    else
+    #endif
+    {
+        ThrowNotSupported("buffer copies");
+    }
+}
+
+void GLCommandBuffer::CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #ifdef GL_ARB_copy_image
+    if (HasExtension(GLExt::ARB_copy_image))
+    {
+        auto& dstTextureGL = LLGL_CAST(GLTexture&, dstTexture);
+        auto& srcTextureGL = LLGL_CAST(GLTexture&, srcTexture);
+
+        glCopyImageSubData(
+            srcTextureGL.GetID(),
+            GLTypes::Map(srcTextureGL.GetType()),
+            static_cast<GLint>(srcRegion.mipLevel),
+            static_cast<GLint>(srcRegion.offset.x),
+            static_cast<GLint>(srcRegion.offset.y),
+            static_cast<GLint>(srcRegion.offset.z),
+            dstTextureGL.GetID(),
+            GLTypes::Map(dstTextureGL.GetType()),
+            static_cast<GLint>(dstMipLevel),
+            static_cast<GLint>(dstOffset.x),
+            static_cast<GLint>(dstOffset.y),
+            static_cast<GLint>(dstOffset.z),
+            static_cast<GLsizei>(srcRegion.extent.x),
+            static_cast<GLsizei>(srcRegion.extent.y),
+            static_cast<GLsizei>(srcRegion.extent.z)
+        );
+    }
+    else
+    #endif
+    {
+        ThrowNotSupported("texture copies");
+    }
+}
+
+// Returns the framebuffer attachment and blit mask for the internal format of the specified texture.
+static GLenum GetResolveAttachment(GLStateManager& stateMngr, const GLTexture& textureGL, GLbitfield& mask)
+{
+    GLint internalFormat = GL_RGBA;
+    stateMngr.BindTexture(textureGL);
+    glGetTexLevelParameteriv(GLTypes::Map(textureGL.GetType()), 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+
+    switch (internalFormat)
+    {
+        case GL_DEPTH_COMPONENT:
+        case GL_DEPTH_COMPONENT16:
+        case GL_DEPTH_COMPONENT24:
+        case GL_DEPTH_COMPONENT32:
+        case GL_DEPTH_COMPONENT32F:
+            mask = GL_DEPTH_BUFFER_BIT;
+            return GL_DEPTH_ATTACHMENT;
+        case GL_DEPTH_STENCIL:
+        case GL_DEPTH24_STENCIL8:
+        case GL_DEPTH32F_STENCIL8:
+            mask = (GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+            return GL_DEPTH_STENCIL_ATTACHMENT;
+        default:
+            mask = GL_COLOR_BUFFER_BIT;
+            return GL_COLOR_ATTACHMENT0;
+    }
+}
+
+// Attaches the specified texture layer to the bound framebuffer and detaches the attachment of a previous resolve.
+static void AttachResolveTexture(const GLTexture& textureGL, GLenum attachment, GLint mipLevel, GLint layer)
+{
+    GLFramebuffer::AttachTexture2D(GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    GLFramebuffer::AttachTexture2D(GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, 0, 0);
+
+    switch (textureGL.GetType())
+    {
+        case TextureType::Texture2D:
+        case TextureType::Texture2DMS:
+            GLFramebuffer::AttachTexture2D(attachment, GLTypes::Map(textureGL.GetType()), textureGL.GetID(), mipLevel);
+            break;
+        default:
+            GLFramebuffer::AttachTextureLayer(attachment, textureGL.GetID(), mipLevel, layer);
+            break;
+    }
+}
+
+/*
+Resolves the multi-sampled texture with a blit between two dedicated FBOs,
+so only the specified region of the required texture is resolved.
+*/
+void GLCommandBuffer::ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& dstTextureGL = LLGL_CAST(GLTexture&, dstTexture);
+    auto& srcTextureGL = LLGL_CAST(GLTexture&, srcTexture);
+
+    if (!resolveReadFramebuffer_)
+    {
+        resolveReadFramebuffer_ = MakeUnique<GLFramebuffer>();
+        resolveDrawFramebuffer_ = MakeUnique<GLFramebuffer>();
+    }
+
+    GLbitfield mask = 0;
+    const auto attachment = GetResolveAttachment(*stateMngr_, srcTextureGL, mask);
+
+    const Gs::Vector2i srcPos0 { static_cast<int>(srcRegion.offset.x), static_cast<int>(srcRegion.offset.y) };
+    const Gs::Vector2i srcPos1 { static_cast<int>(srcRegion.offset.x + srcRegion.extent.x), static_cast<int>(srcRegion.offset.y + srcRegion.extent.y) };
+    const Gs::Vector2i dstPos0 { static_cast<int>(dstOffset.x), static_cast<int>(dstOffset.y) };
+    const Gs::Vector2i dstPos1 { static_cast<int>(dstOffset.x + srcRegion.extent.x), static_cast<int>(dstOffset.y + srcRegion.extent.y) };
+
+    /* Resolve each array layer separately, since a blit only operates on a single layer */
+    const auto numLayers = std::max(1u, srcRegion.extent.z);
+
+    for (unsigned int i = 0; i < numLayers; ++i)
+    {
+        /* Attachments are modified on the draw framebuffer target, so the source FBO is bound as draw framebuffer first */
+        resolveReadFramebuffer_->Bind(GLFramebufferTarget::DRAW_FRAMEBUFFER);
+        AttachResolveTexture(srcTextureGL, attachment, 0, static_cast<GLint>(srcRegion.offset.z + i));
+
+        resolveDrawFramebuffer_->Bind(GLFramebufferTarget::DRAW_FRAMEBUFFER);
+        AttachResolveTexture(dstTextureGL, attachment, static_cast<GLint>(dstMipLevel), static_cast<GLint>(dstOffset.z + i));
+
+        resolveReadFramebuffer_->Bind(GLFramebufferTarget::READ_FRAMEBUFFER);
+        GLFramebuffer::Blit(srcPos0, srcPos1, dstPos0, dstPos1, mask, GL_NEAREST);
+    }
+
+    /* Restore framebuffer of the bound render target */
+    stateMngr_->BindFramebuffer(GLFramebufferTarget::READ_FRAMEBUFFER, 0);
+    stateMngr_->BindFramebuffer(
+        GLFramebufferTarget::DRAW_FRAMEBUFFER,
+        (boundRenderTarget_ != nullptr ? boundRenderTarget_->GetFramebuffer().GetID() : 0)
+    );
+}
+
+void GLCommandBuffer::CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& dstTextureGL = LLGL_CAST(GLTexture&, dstTexture);
+    auto& srcBufferGL = LLGL_CAST(GLBuffer&, srcBuffer);
+
+    /* Bind source buffer as pixel unpack buffer, so the image data pointer is interpreted as offset into this buffer */
+    stateMngr_->BindTexture(dstTextureGL);
+    stateMngr_->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, srcBufferGL.GetID());
+    {
+        ImageDescriptor imageDesc { imageFormat, dataType, reinterpret_cast<const void*>(static_cast<std::size_t>(srcOffset)) };
+        GLTexSubImage(dstTextureGL.GetType(), dstRegion, imageDesc);
+    }
+    stateMngr_->BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+}
+
 /* ----- Drawing ----- */
 
 void GLCommandBuffer::Draw(unsigned int numVertices, unsigned int firstVertex)
 {
-    glDrawArrays(
-        renderState_.drawMode,
-        static_cast<GLint>(firstVertex),
-        static_cast<GLsizei>(numVertices)
-    );
+    if (drawMerger_)
+    {
+        /* Queue draw command until the next state change */
+        stateMngr_->SetPendingDrawMerger(drawMerger_.get());
+        drawMerger_->DrawArrays(
+            renderState_.drawMode,
+            static_cast<GLint>(firstVertex),
+            static_cast<GLsizei>(numVertices)
+        );
+    }
+    else
+    {
+        stateMngr_->FlushPendingDraws();
+        glDrawArrays(
+            renderState_.drawMode,
+            static_cast<GLint>(firstVertex),
+            static_cast<GLsizei>(numVertices)
+        );
+    }
 }
 
 void GLCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex)
 {
-    glDrawElements(
-        renderState_.drawMode,
-        static_cast<GLsizei>(numVertices),
-        renderState_.indexBufferDataType,
-        (reinterpret_cast<const GLvoid*>(firstIndex * renderState_.indexBufferStride))
-    );
+    if (drawMerger_)
+    {
+        DrawIndexed(numVertices, firstIndex, 0);
+    }
+    else
+    {
+        stateMngr_->FlushPendingDraws();
+        glDrawElements(
+            renderState_.drawMode,
+            static_cast<GLsizei>(numVertices),
+            renderState_.indexBufferDataType,
+            (reinterpret_cast<const GLvoid*>(renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride))
+        );
+    }
 }
 
 void GLCommandBuffer::DrawIndexed(unsigned int numVertices, unsigned int firstIndex, int vertexOffset)
 {
-    glDrawElementsBaseVertex(
-        renderState_.drawMode,
-        static_cast<GLsizei>(numVertices),
-        renderState_.indexBufferDataType,
-        (reinterpret_cast<const GLvoid*>(firstIndex * renderState_.indexBufferStride)),
-        vertexOffset
-    );
+    if (drawMerger_)
+    {
+        /* Queue draw command until the next state change */
+        stateMngr_->SetPendingDrawMerger(drawMerger_.get());
+        drawMerger_->DrawElements(
+            renderState_.drawMode,
+            static_cast<GLsizei>(numVertices),
+            renderState_.indexBufferDataType,
+            (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride),
+            vertexOffset
+        );
+    }
+    else
+    {
+        stateMngr_->FlushPendingDraws();
+        glDrawElementsBaseVertex(
+            renderState_.drawMode,
+            static_cast<GLsizei>(numVertices),
+            renderState_.indexBufferDataType,
+            (reinterpret_cast<const GLvoid*>(renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride)),
+            vertexOffset
+        );
+    }
 }
 
 void GLCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances)
 {
+    stateMngr_->FlushPendingDraws();
     glDrawArraysInstanced(
         renderState_.drawMode,
         static_cast<GLint>(firstVertex),
@@ -438,6 +1144,8 @@ void GLCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int first
 
 void GLCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int firstVertex, unsigned int numInstances, unsigned int instanceOffset)
 {
+    stateMngr_->FlushPendingDraws();
+
     #ifndef __APPLE__
     glDrawArraysInstancedBaseInstance(
         renderState_.drawMode,
@@ -451,22 +1159,24 @@ void GLCommandBuffer::DrawInstanced(unsigned int numVertices, unsigned int first
 
 void GLCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex)
 {
+    stateMngr_->FlushPendingDraws();
     glDrawElementsInstanced(
         renderState_.drawMode,
         static_cast<GLsizei>(numVertices),
         renderState_.indexBufferDataType,
-        (reinterpret_cast<const GLvoid*>(firstIndex * renderState_.indexBufferStride)),
+        (reinterpret_cast<const GLvoid*>(renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride)),
         static_cast<GLsizei>(numInstances)
     );
 }
 
 void GLCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset)
 {
+    stateMngr_->FlushPendingDraws();
     glDrawElementsInstancedBaseVertex(
         renderState_.drawMode,
         static_cast<GLsizei>(numVertices),
         renderState_.indexBufferDataType,
-        (reinterpret_cast<const GLvoid*>(firstIndex * renderState_.indexBufferStride)),
+        (reinterpret_cast<const GLvoid*>(renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride)),
         static_cast<GLsizei>(numInstances),
         vertexOffset
     );
@@ -474,12 +1184,14 @@ void GLCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned in
 
 void GLCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset)
 {
+    stateMngr_->FlushPendingDraws();
+
     #ifndef __APPLE__
     glDrawElementsInstancedBaseVertexBaseInstance(
         renderState_.drawMode,
         static_cast<GLsizei>(numVertices),
         renderState_.indexBufferDataType,
-        (reinterpret_cast<const GLvoid*>(firstIndex * renderState_.indexBufferStride)),
+        (reinterpret_cast<const GLvoid*>(renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride)),
         static_cast<GLsizei>(numInstances),
         vertexOffset,
         instanceOffset
@@ -487,19 +1199,228 @@ void GLCommandBuffer::DrawIndexedInstanced(unsigned int numVertices, unsigned in
     #endif
 }
 
+void GLCommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
+    glDrawArraysIndirect(
+        renderState_.drawMode,
+        reinterpret_cast<const GLvoid*>(static_cast<std::size_t>(offset))
+    );
+}
+
+void GLCommandBuffer::DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
+    #ifndef __APPLE__
+    if (HasExtension(GLExt::ARB_multi_draw_indirect))
+    {
+        /* Submit all draw commands at once */
+        glMultiDrawArraysIndirect(
+            renderState_.drawMode,
+            reinterpret_cast<const GLvoid*>(static_cast<std::size_t>(offset)),
+            static_cast<GLsizei>(numCommands),
+            static_cast<GLsizei>(stride)
+        );
+    }
+    else
+    #endif
+    {
+        /* Emulate multi-draw command with a sequence of single indirect draw commands */
+        for (; numCommands-- > 0; offset += stride)
+        {
+            glDrawArraysIndirect(
+                renderState_.drawMode,
+                reinterpret_cast<const GLvoid*>(static_cast<std::size_t>(offset))
+            );
+        }
+    }
+}
+
+void GLCommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
+    glDrawElementsIndirect(
+        renderState_.drawMode,
+        renderState_.indexBufferDataType,
+        reinterpret_cast<const GLvoid*>(static_cast<std::size_t>(offset))
+    );
+}
+
+void GLCommandBuffer::DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, bufferGL.GetID());
+    #ifndef __APPLE__
+    if (HasExtension(GLExt::ARB_multi_draw_indirect))
+    {
+        /* Submit all draw commands at once */
+        glMultiDrawElementsIndirect(
+            renderState_.drawMode,
+            renderState_.indexBufferDataType,
+            reinterpret_cast<const GLvoid*>(static_cast<std::size_t>(offset)),
+            static_cast<GLsizei>(numCommands),
+            static_cast<GLsizei>(stride)
+        );
+    }
+    else
+    #endif
+    {
+        /* Emulate multi-draw command with a sequence of single indirect draw commands */
+        for (; numCommands-- > 0; offset += stride)
+        {
+            glDrawElementsIndirect(
+                renderState_.drawMode,
+                renderState_.indexBufferDataType,
+                reinterpret_cast<const GLvoid*>(static_cast<std::size_t>(offset))
+            );
+        }
+    }
+}
+
+void GLCommandBuffer::DrawStreamOutput()
+{
+    stateMngr_->FlushPendingDraws();
+
+    /* Draw vertices with the number of vertices captured in the transform feedback object of the bound vertex buffer */
+    if (HasExtension(GLExt::ARB_transform_feedback2))
+        glDrawTransformFeedback(renderState_.drawMode, renderState_.drawTransformFeedback);
+    else
+        ThrowNotSupported("drawing stream-outputs");
+}
+
+void GLCommandBuffer::DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ)
+{
+    stateMngr_->FlushPendingDraws();
+
+    /* GL_NV_mesh_shader only launches a one-dimensional range of task groups */
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_mesh_shader
+    if (HasExtension(GLExt::NV_mesh_shader))
+        glDrawMeshTasksNV(0, numTasksX * numTasksY * numTasksZ);
+    else
+    #endif
+        ThrowNotSupported("mesh shaders");
+}
+
 /* ----- Compute ----- */
 
+#ifndef __APPLE__
+
+/*
+Makes the storage buffer and image writes of a compute dispatch visible to all subsequent commands,
+e.g. indirect draw arguments or vertex data that is generated by a compute shader.
+Direct3D resolves these hazards implicitly, so the same command sequence works for all renderers,
+unless the client programmer inserts the barriers explicitly (see StateOpenGLDescriptor::explicitBarriers).
+*/
+static void MemoryBarrierAfterDispatch(const GLStateManager& stateMngr)
+{
+    if (!stateMngr.GetGraphicsAPIDependentState().stateOpenGL.explicitBarriers)
+    {
+        if (HasExtension(GLExt::ARB_shader_image_load_store))
+            glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    }
+}
+
+static GLbitfield ToGLBarrierBits(long barrierFlags)
+{
+    GLbitfield bits = 0;
+
+    if ((barrierFlags & BarrierFlags::StorageBuffer) != 0)
+        bits |= (GL_SHADER_STORAGE_BARRIER_BIT | GL_ATOMIC_COUNTER_BARRIER_BIT);
+    if ((barrierFlags & BarrierFlags::ConstantBuffer) != 0)
+        bits |= GL_UNIFORM_BARRIER_BIT;
+    if ((barrierFlags & BarrierFlags::VertexBuffer) != 0)
+        bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+    if ((barrierFlags & BarrierFlags::IndexBuffer) != 0)
+        bits |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+    if ((barrierFlags & BarrierFlags::IndirectArguments) != 0)
+        bits |= GL_COMMAND_BARRIER_BIT;
+    if ((barrierFlags & BarrierFlags::Texture) != 0)
+        bits |= (GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    if ((barrierFlags & BarrierFlags::Copy) != 0)
+        bits |= (GL_BUFFER_UPDATE_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT);
+
+    return bits;
+}
+
+#endif
+
 void GLCommandBuffer::Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ)
 {
+    stateMngr_->FlushPendingDraws();
+
     #ifndef __APPLE__
     glDispatchCompute(groupSizeX, groupSizeY, groupSizeZ);
+    MemoryBarrierAfterDispatch(*stateMngr_);
     #endif
 }
 
+void GLCommandBuffer::DispatchIndirect(Buffer& buffer, unsigned int offset)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #ifndef __APPLE__
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    stateMngr_->BindBuffer(GLBufferTarget::DISPATCH_INDIRECT_BUFFER, bufferGL.GetID());
+    glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+    MemoryBarrierAfterDispatch(*stateMngr_);
+    #endif
+}
+
+void GLCommandBuffer::Barrier(long barrierFlags)
+{
+    stateMngr_->FlushPendingDraws();
+
+    #ifndef __APPLE__
+    if (HasExtension(GLExt::ARB_shader_image_load_store))
+    {
+        auto bits = ToGLBarrierBits(barrierFlags);
+        if (bits != 0)
+            glMemoryBarrier(bits);
+    }
+    #endif
+}
+
+void GLCommandBuffer::StorageBarrier(Buffer& /*buffer*/)
+{
+    stateMngr_->FlushPendingDraws();
+
+    /* OpenGL has no memory barriers for individual buffers */
+    Barrier(BarrierFlags::StorageBuffer);
+}
+
+/* ----- Command Recording ----- */
+
+void GLCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& deferredCommandBufferRef = LLGL_CAST(DeferredCommandBuffer&, deferredCommandBuffer);
+    deferredCommandBufferRef.Replay(*this);
+}
+
+void GLCommandBuffer::Reset()
+{
+    /* Dummy (commands are submitted immediately) */
+}
+
 /* ----- Misc ----- */
 
+void GLCommandBuffer::Signal(Fence& fence)
+{
+    stateMngr_->FlushPendingDraws();
+    auto& fenceGL = LLGL_CAST(GLFence&, fence);
+    fenceGL.Signal();
+}
+
 void GLCommandBuffer::SyncGPU()
 {
+    stateMngr_->FlushPendingDraws();
     glFinish();
 }
 
@@ -527,6 +1448,94 @@ void GLCommandBuffer::SetGenericBufferArray(const GLBufferTarget bufferTarget, B
     );
 }
 
+void GLCommandBuffer::LoadRenderPassAttachments(const RenderPassDescriptor& renderPassDesc)
+{
+    /* Store render pass for the store operations in "EndRenderPass" */
+    renderPassDesc_ = renderPassDesc;
+
+    /* Invalidate all attachments whose previous content is not required */
+    GLInvalidateAttachments(
+        renderPassDesc, renderPassDefaultFBO_,
+        [](const RenderPassAttachmentDescriptor& attachment)
+        {
+            return (attachment.loadOp == AttachmentLoadOp::DontCare);
+        }
+    );
+
+    /* Clear color attachments individually */
+    for (std::size_t i = 0, n = GetNumRenderPassColorAttachments(renderPassDesc, renderPassDefaultFBO_); i < n; ++i)
+    {
+        if (renderPassDesc.colorAttachments[i].loadOp == AttachmentLoadOp::Clear)
+            glClearBufferfv(GL_COLOR, static_cast<GLint>(i), clearColor_.Ptr());
+    }
+
+    /* Clear depth and stencil attachments with the current clear values */
+    GLbitfield mask = 0;
+
+    if (renderPassDesc.depthAttachment.loadOp == AttachmentLoadOp::Clear)
+    {
+        stateMngr_->SetDepthMask(GL_TRUE);
+        stateMngr_->InvalidatePipelineState();
+        mask |= GL_DEPTH_BUFFER_BIT;
+    }
+
+    if (renderPassDesc.stencilAttachment.loadOp == AttachmentLoadOp::Clear)
+        mask |= GL_STENCIL_BUFFER_BIT;
+
+    if (mask != 0)
+        glClear(mask);
+}
+
+#if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+
+// Returns the NV shading rate for the specified binary logarithms of the pixel width and height.
+static GLenum ToGLShadingRateNV(unsigned int log2Width, unsigned int log2Height)
+{
+    /* Clamp to 4x4 pixels, and clamp 1x4 and 4x1 pixels to 1x2 and 2x1 pixels, which are not supported */
+    log2Width   = std::min(log2Width, 2u);
+    log2Height  = std::min(log2Height, 2u);
+
+    if (log2Width == 2 && log2Height == 0)
+        log2Width = 1;
+    else if (log2Width == 0 && log2Height == 2)
+        log2Height = 1;
+
+    switch ((log2Width << 2) | log2Height)
+    {
+        case 0x1: return GL_SHADING_RATE_1_INVOCATION_PER_1X2_PIXELS_NV;
+        case 0x4: return GL_SHADING_RATE_1_INVOCATION_PER_2X1_PIXELS_NV;
+        case 0x5: return GL_SHADING_RATE_1_INVOCATION_PER_2X2_PIXELS_NV;
+        case 0x6: return GL_SHADING_RATE_1_INVOCATION_PER_2X4_PIXELS_NV;
+        case 0x9: return GL_SHADING_RATE_1_INVOCATION_PER_4X2_PIXELS_NV;
+        case 0xA: return GL_SHADING_RATE_1_INVOCATION_PER_4X4_PIXELS_NV;
+        default:  return GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV;
+    }
+}
+
+void GLCommandBuffer::SubmitShadingRateNV()
+{
+    /* Shading rate image is only enabled if it has any effect */
+    auto enabled = (shadingRate_ != ShadingRate::Rate1x1 || shadingRateImage_ != 0);
+    stateMngr_->Set(GLStateExt::SHADING_RATE_IMAGE, enabled);
+
+    if (enabled)
+    {
+        /*
+        The per-draw rate is combined with the rate of each texel by taking the coarser rate for each axis.
+        Without a bound shading rate image, all texels are read as zero, i.e. only the per-draw rate is used.
+        */
+        const auto drawRate = static_cast<unsigned int>(shadingRate_);
+
+        GLenum palette[16];
+        for (unsigned int i = 0; i < 16; ++i)
+            palette[i] = ToGLShadingRateNV(std::max(drawRate >> 2, i >> 2), std::max(drawRate & 0x3, i & 0x3));
+
+        glShadingRateImagePaletteNV(0, 0, 16, palette);
+    }
+}
+
+#endif
+
 
 } // /namespace LLGL
 
@@ -11,7 +11,10 @@
 
 #include <LLGL/CommandBuffer.h>
 #include "RenderState/GLState.h"
+#include "Texture/GLFramebuffer.h"
 #include "OpenGL.h"
+#include <memory>
+#include <vector>
 
 
 namespace LLGL
@@ -19,16 +22,19 @@ namespace LLGL
 
 
 class GLRenderTarget;
+class GLGraphicsPipeline;
 class GLStateManager;
+class GLDrawMerger;
 
-class GLCommandBuffer : public CommandBuffer
+class GLCommandBuffer final : public CommandBuffer
 {
 
     public:
 
         /* ----- Common ----- */
 
-        GLCommandBuffer(const std::shared_ptr<GLStateManager>& stateManager);
+        GLCommandBuffer(const std::shared_ptr<GLStateManager>& stateManager, long flags = 0);
+        ~GLCommandBuffer();
 
         /* ----- Configuration ----- */
 
@@ -40,6 +46,11 @@ class GLCommandBuffer : public CommandBuffer
         void SetScissor(const Scissor& scissor) override;
         void SetScissorArray(unsigned int numScissors, const Scissor* scissorArray) override;
 
+        void SetShadingRate(const ShadingRate rate) override;
+        void SetShadingRateImage(Texture* texture) override;
+
+        void SetDepthBounds(float minDepth, float maxDepth) override;
+
         void SetClearColor(const ColorRGBAf& color) override;
         void SetClearDepth(float depth) override;
         void SetClearStencil(int stencil) override;
@@ -49,23 +60,30 @@ class GLCommandBuffer : public CommandBuffer
 
         /* ----- Buffers ------ */
 
-        void SetVertexBuffer(Buffer& buffer) override;
+        void SetVertexBuffer(Buffer& buffer, unsigned int offset = 0) override;
         void SetVertexBufferArray(BufferArray& bufferArray) override;
 
-        void SetIndexBuffer(Buffer& buffer) override;
+        void SetIndexBuffer(Buffer& buffer, unsigned int offset = 0) override;
         
         void SetConstantBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetConstantBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
+        void SetConstantBufferRange(Buffer& buffer, unsigned int offset, unsigned int size, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         
         void SetStorageBuffer(Buffer& buffer, unsigned int slot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetStorageBufferArray(BufferArray& bufferArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
 
+        void ResetBufferCounter(Buffer& buffer, unsigned int value = 0) override;
+        void CopyBufferCounter(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer) override;
+
         void SetStreamOutputBuffer(Buffer& buffer) override;
         void SetStreamOutputBufferArray(BufferArray& bufferArray) override;
 
         void BeginStreamOutput(const PrimitiveType primitiveType) override;
         void EndStreamOutput() override;
 
+        void PauseStreamOutput() override;
+        void ResumeStreamOutput() override;
+
         /* ----- Textures ----- */
 
         void SetTexture(Texture& texture, unsigned int layer, long shaderStageFlags = ShaderStageFlags::AllStages) override;
@@ -76,26 +94,52 @@ class GLCommandBuffer : public CommandBuffer
         void SetSampler(Sampler& sampler, unsigned int layer, long shaderStageFlags = ShaderStageFlags::AllStages) override;
         void SetSamplerArray(SamplerArray& samplerArray, unsigned int startSlot, long shaderStageFlags = ShaderStageFlags::AllStages) override;
 
+        /* ----- Resource Heaps ----- */
+
+        void SetResourceHeap(ResourceHeap& resourceHeap) override;
+
         /* ----- Render Targets ----- */
 
         void SetRenderTarget(RenderTarget& renderTarget) override;
         void SetRenderTarget(RenderContext& renderContext) override;
 
+        /* ----- Render Passes ----- */
+
+        void BeginRenderPass(RenderTarget& renderTarget, const RenderPassDescriptor& renderPassDesc) override;
+        void BeginRenderPass(RenderContext& renderContext, const RenderPassDescriptor& renderPassDesc) override;
+
+        void EndRenderPass() override;
+
         /* ----- Pipeline States ----- */
 
         void SetGraphicsPipeline(GraphicsPipeline& graphicsPipeline) override;
         void SetComputePipeline(ComputePipeline& computePipeline) override;
 
+        void SetPushConstants(unsigned int offset, unsigned int size, const void* data) override;
+
+        void SetShaderClassInstances(const ShaderType stage, unsigned int numSlots, const int* classInstances) override;
+
         /* ----- Queries ----- */
 
         void BeginQuery(Query& query) override;
         void EndQuery(Query& query) override;
 
         bool QueryResult(Query& query, std::uint64_t& result) override;
+        bool QueryResult(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, std::uint64_t* results) override;
+        bool QueryPipelineStatisticsResult(Query& query, QueryPipelineStatistics& result) override;
+
+        void ResolveQueryData(QueryArray& queryArray, unsigned int firstQuery, unsigned int numQueries, Buffer& dstBuffer, unsigned int dstOffset) override;
 
         void BeginRenderCondition(Query& query, const RenderConditionMode mode) override;
         void EndRenderCondition() override;
 
+        /* ----- Copy ----- */
+
+        void CopyBuffer(Buffer& dstBuffer, unsigned int dstOffset, Buffer& srcBuffer, unsigned int srcOffset, unsigned int size) override;
+        void CopyTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void ResolveTexture(Texture& dstTexture, unsigned int dstMipLevel, const Gs::Vector3ui& dstOffset, Texture& srcTexture, const TextureRegion& srcRegion) override;
+        void CopyBufferToTexture(Texture& dstTexture, const TextureRegion& dstRegion, Buffer& srcBuffer, unsigned int srcOffset, ImageFormat imageFormat, DataType dataType) override;
+
         /* ----- Drawing ----- */
 
         void Draw(unsigned int numVertices, unsigned int firstVertex) override;
@@ -110,21 +154,45 @@ class GLCommandBuffer : public CommandBuffer
         void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset) override;
         void DrawIndexedInstanced(unsigned int numVertices, unsigned int numInstances, unsigned int firstIndex, int vertexOffset, unsigned int instanceOffset) override;
 
+        void DrawIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset) override;
+        void DrawIndexedIndirect(Buffer& buffer, unsigned int offset, unsigned int numCommands, unsigned int stride) override;
+
+        void DrawStreamOutput() override;
+
+        void DrawMeshTasks(unsigned int numTasksX, unsigned int numTasksY, unsigned int numTasksZ) override;
+
         /* ----- Compute ----- */
 
         void Dispatch(unsigned int groupSizeX, unsigned int groupSizeY, unsigned int groupSizeZ) override;
+        void DispatchIndirect(Buffer& buffer, unsigned int offset) override;
+
+        void Barrier(long barrierFlags) override;
+        void StorageBarrier(Buffer& buffer) override;
+
+        /* ----- Command Recording ----- */
+
+        void Execute(CommandBuffer& deferredCommandBuffer) override;
+
+        void Reset() override;
 
         /* ----- Misc ----- */
 
+        void Signal(Fence& fence) override;
+
         void SyncGPU() override;
 
     private:
 
         struct RenderState
         {
-            GLenum      drawMode            = GL_TRIANGLES;     // Render mode for "glDraw*"
-            GLenum      indexBufferDataType = GL_UNSIGNED_INT;
-            GLintptr    indexBufferStride   = 4;
+            GLenum      drawMode                = GL_TRIANGLES;     // Render mode for "glDraw*"
+            GLenum      indexBufferDataType     = GL_UNSIGNED_INT;
+            GLintptr    indexBufferStride       = 4;
+            GLintptr    indexBufferOffset       = 0;                // Byte offset of the bound index buffer range, which is added to the "firstIndex" of each draw command
+            GLuint      drawTransformFeedback   = 0;                // Transform feedback object of the bound stream-output buffer for "glDrawTransformFeedback"
         };
 
         void SetGenericBuffer(const GLBufferTarget bufferTarget, Buffer& buffer, unsigned int slot);
@@ -133,10 +201,36 @@ class GLCommandBuffer : public CommandBuffer
         // Blits the currently bound render target
         void BlitBoundRenderTarget();
 
+        // Performs the load operations of the specified render pass on the bound draw framebuffer.
+        void LoadRenderPassAttachments(const RenderPassDescriptor& renderPassDesc);
+
+        #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+        // Enables the shading rate image state and submits the shading rate palette for the current per-draw rate.
+        void SubmitShadingRateNV();
+        #endif
+
         std::shared_ptr<GLStateManager> stateMngr_;
         RenderState                     renderState_;
 
-        GLRenderTarget*                 boundRenderTarget_  = nullptr;
+        ColorRGBAf                      clearColor_             { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        RenderPassDescriptor            renderPassDesc_;        // descriptor of the current render pass for the store operations
+        bool                            renderPassDefaultFBO_   = false;
+
+        GLRenderTarget*                 boundRenderTarget_      = nullptr;
+
+        std::unique_ptr<GLFramebuffer>  resolveReadFramebuffer_;    // created on first use of "ResolveTexture"
+        std::unique_ptr<GLFramebuffer>  resolveDrawFramebuffer_;
+        GLGraphicsPipeline*             boundGraphicsPipeline_  = nullptr;
+
+        std::unique_ptr<GLDrawMerger>   drawMerger_;            // only created with CommandBufferFlags::MergeDraws
+
+        std::vector<GLuint>             subroutineIndices_;     // intermediate array for "glUniformSubroutinesuiv"
+
+        #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+        ShadingRate                     shadingRate_            = ShadingRate::Rate1x1;
+        GLuint                          shadingRateImage_       = 0;
+        #endif
 
 };
 
@@ -27,9 +27,9 @@ LLGL_EXPORT const char* LLGL_RenderSystem_Name()
     return "OpenGL";
 }
 
-LLGL_EXPORT void* LLGL_RenderSystem_Alloc()
+LLGL_EXPORT void* LLGL_RenderSystem_Alloc(const LLGL::RenderSystemDescriptor* renderSystemDesc)
 {
-    return new LLGL::GLRenderSystem();
+    return new LLGL::GLRenderSystem(*renderSystemDesc);
 }
 
 } // /extern "C"
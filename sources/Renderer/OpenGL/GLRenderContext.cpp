@@ -6,6 +6,13 @@
  */
 
 #include "GLRenderContext.h"
+#include "../CheckedCast.h"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined __linux__ && defined LLGL_ENABLE_WAYLAND
+#include "../../Platform/Linux/WaylandWindow.h"
+#endif
 
 
 namespace LLGL
@@ -18,10 +25,25 @@ GLRenderContext::GLRenderContext(RenderContextDescriptor desc, const std::shared
 {
     #ifdef __linux__
 
-    /* Setup surface for the render context and pass native context handle */
-    NativeContextHandle windowContext;
-    GetNativeContextHandle(windowContext);
-    SetOrCreateSurface(surface, desc.videoMode, &windowContext);
+    if (desc.headless)
+    {
+        /* Setup surface without X11 window for a headless render context */
+        SetHeadlessSurface(desc.videoMode);
+    }
+    #ifdef LLGL_ENABLE_WAYLAND
+    else if (WaylandWindow::IsSessionAvailable())
+    {
+        /* Setup Wayland window for the render context; the EGL context does not require an X11 visual */
+        SetOrCreateSurface(surface, desc.videoMode, nullptr);
+    }
+    #endif
+    else
+    {
+        /* Setup surface for the render context and pass native context handle */
+        NativeContextHandle windowContext;
+        GetNativeContextHandle(windowContext, sharedRenderContext);
+        SetOrCreateSurface(surface, desc.videoMode, &windowContext);
+    }
 
     #else
 
@@ -33,6 +55,9 @@ GLRenderContext::GLRenderContext(RenderContextDescriptor desc, const std::shared
     /* Create platform dependent OpenGL context */
     context_ = GLContext::Create(desc_, GetSurface(), (sharedRenderContext != nullptr ? sharedRenderContext->context_.get() : nullptr));
 
+    /* Platform contexts are made current on creation, so also make it the active context of this thread */
+    GLContext::MakeCurrent(context_.get());
+
     /* Setup swap interval (for v-sync) */
     UpdateSwapInterval();
 
@@ -40,16 +65,63 @@ GLRenderContext::GLRenderContext(RenderContextDescriptor desc, const std::shared
     stateMngr_ = context_->GetStateManager();
     stateMngr_->NotifyRenderTargetHeight(contextHeight_);
 
-    /* Initialize render states for the first time */
-    if (!sharedRenderContext)
+    /* Initialize render states for each new hardware context, i.e. unless the state manager is shared */
+    if (!sharedRenderContext || sharedRenderContext->stateMngr_ != stateMngr_)
         InitRenderStates();
 }
 
 void GLRenderContext::Present()
 {
+    stateMngr_->FlushPendingDraws();
+    ApplySwapInterval(swapInterval_);
     context_->SwapBuffers();
 }
 
+void GLRenderContext::PresentWithoutVsync()
+{
+    stateMngr_->FlushPendingDraws();
+    ApplySwapInterval(0);
+    context_->SwapBuffers();
+}
+
+void GLRenderContext::WaitForNextFrame()
+{
+    /* Pace frames to the target frame rate, then align the beginning of the frame to the next vertical blank */
+    RenderContext::WaitForNextFrame();
+    if (desc_.vsync.enabled)
+        context_->WaitForVerticalBlank();
+}
+
+bool GLRenderContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    return context_->QueryFrameStatistics(stats);
+}
+
+void GLRenderContext::CopyBackBuffer(Texture& dstTexture)
+{
+    auto& textureGL = LLGL_CAST(GLTexture&, dstTexture);
+    if (textureGL.GetType() != TextureType::Texture2D)
+        throw std::invalid_argument("back buffer can only be copied into a 2D texture");
+
+    stateMngr_->FlushPendingDraws();
+    GLMakeCurrent(this);
+
+    /* Copy region of the back buffer that is covered by the texture */
+    auto size   = textureGL.QueryMipLevelSize(0);
+    auto width  = std::min(static_cast<GLsizei>(size.x), static_cast<GLsizei>(GetVideoMode().resolution.x));
+    auto height = std::min(static_cast<GLsizei>(size.y), static_cast<GLsizei>(GetVideoMode().resolution.y));
+
+    stateMngr_->BindFramebuffer(GLFramebufferTarget::READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+
+    stateMngr_->PushBoundTexture(GLTextureTarget::TEXTURE_2D);
+    {
+        stateMngr_->BindTexture(textureGL);
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+    }
+    stateMngr_->PopBoundTexture();
+}
+
 /* ----- Configuration ----- */
 
 void GLRenderContext::SetVideoMode(const VideoModeDescriptor& videoModeDesc)
@@ -79,6 +151,10 @@ void GLRenderContext::SetVsync(const VsyncDescriptor& vsyncDesc)
 
 bool GLRenderContext::GLMakeCurrent(GLRenderContext* renderContext)
 {
+    /* Submit merged draw commands before their GL context is switched */
+    if (GLStateManager::active != nullptr)
+        GLStateManager::active->FlushPendingDraws();
+
     if (renderContext)
     {
         /* Make OpenGL context of the specified render contex current and notify the state manager */
@@ -90,6 +166,46 @@ bool GLRenderContext::GLMakeCurrent(GLRenderContext* renderContext)
         return GLContext::MakeCurrent(nullptr);
 }
 
+std::unique_ptr<GLContext> GLRenderContext::CreateSharedContext(RenderContextDescriptor& desc, std::shared_ptr<Surface>& surface)
+{
+    /* Shared context is not used for presentation, so neither multi-sampling nor v-sync is required */
+    desc = desc_;
+    desc.multiSampling  = MultiSamplingDescriptor{};
+    desc.vsync.enabled  = false;
+
+    if (!desc.headless)
+    {
+        /* Create hidden window for the shared context */
+        WindowDescriptor windowDesc;
+        {
+            windowDesc.size = { 1, 1 };
+        }
+
+        #ifdef __linux__
+        NativeContextHandle windowContext;
+        #ifdef LLGL_ENABLE_WAYLAND
+        if (!WaylandWindow::IsSessionAvailable())
+        #endif
+        {
+            GetNativeContextHandle(windowContext, this);
+            windowDesc.windowContext = &windowContext;
+        }
+        #endif
+
+        surface = Window::Create(windowDesc);
+    }
+
+    /* Platform contexts are made current on creation, so deactivate the current context first and restore it afterwards */
+    auto prevContext = GLContext::Active();
+    GLContext::MakeCurrent(nullptr);
+
+    auto sharedContext = GLContext::Create(desc, (surface ? *surface : GetSurface()), context_.get(), true);
+
+    GLContext::MakeCurrent(prevContext != nullptr ? prevContext : context_.get());
+
+    return sharedContext;
+}
+
 
 /*
  * ======= Private: =======
@@ -113,7 +229,30 @@ void GLRenderContext::InitRenderStates()
 
 void GLRenderContext::UpdateSwapInterval()
 {
-    context_->SetSwapInterval(desc_.vsync.enabled ? static_cast<int>(desc_.vsync.interval) : 0);
+    auto interval = (desc_.vsync.enabled ? static_cast<int>(desc_.vsync.interval) : 0);
+
+    /* Request late swap tearing with a negative swap interval */
+    if (desc_.vsync.adaptive)
+        interval = -interval;
+
+    context_->SetSwapInterval(interval);
+
+    swapInterval_           = interval;
+    activeSwapInterval_     = interval;
+}
+
+void GLRenderContext::ApplySwapInterval(int interval)
+{
+    /* Only change swap interval when the presentation mode changes, e.g. when a render context is presented within a batch */
+    if (activeSwapInterval_ != interval)
+    {
+        /* Swap interval applies to the current GL context, so restore the previous context afterwards */
+        auto prevContext = GLContext::Active();
+        GLContext::MakeCurrent(context_.get());
+        context_->SetSwapInterval(interval);
+        GLContext::MakeCurrent(prevContext);
+        activeSwapInterval_ = interval;
+    }
 }
 
 
@@ -27,7 +27,7 @@ namespace LLGL
 
 class GLRenderTarget;
 
-class GLRenderContext : public RenderContext
+class GLRenderContext final : public RenderContext
 {
 
     public:
@@ -37,6 +37,13 @@ class GLRenderContext : public RenderContext
         GLRenderContext(RenderContextDescriptor desc, const std::shared_ptr<Surface>& surface, GLRenderContext* sharedRenderContext);
 
         void Present() override;
+        void PresentWithoutVsync() override;
+
+        void WaitForNextFrame() override;
+
+        bool QueryFrameStatistics(FrameStatistics& stats) override;
+
+        void CopyBackBuffer(Texture& dstTexture) override;
 
         /* ----- Configuration ----- */
 
@@ -47,6 +54,13 @@ class GLRenderContext : public RenderContext
 
         static bool GLMakeCurrent(GLRenderContext* renderContext);
 
+        /*
+        Creates a new GL context with its own hardware context that shares its objects with this render context, e.g. for a loader thread.
+        The new context is created on a hidden window (or without window for headless contexts), which is returned in 'surface'.
+        Both 'desc' and 'surface' must outlive the new context. The current context of the calling thread is restored afterwards.
+        */
+        std::unique_ptr<GLContext> CreateSharedContext(RenderContextDescriptor& desc, std::shared_ptr<Surface>& surface);
+
         inline const std::shared_ptr<GLStateManager>& GetStateManager() const
         {
             return stateMngr_;
@@ -63,9 +77,12 @@ class GLRenderContext : public RenderContext
 
         void InitRenderStates();
         void UpdateSwapInterval();
+        void ApplySwapInterval(int interval);
 
         #ifdef __linux__
-        void GetNativeContextHandle(NativeContextHandle& windowContext);
+        // Opens the X11 display and chooses the visual for the window; the visual of the shared render context is reused if it was chosen for the same settings.
+        void GetNativeContextHandle(NativeContextHandle& windowContext, const GLRenderContext* sharedRenderContext);
+        void ChooseVisual(NativeContextHandle& windowContext);
         #endif
 
         RenderContextDescriptor         desc_;
@@ -77,6 +94,13 @@ class GLRenderContext : public RenderContext
 
         GLint                           contextHeight_      = 0;
 
+        int                             swapInterval_       = 0;
+        int                             activeSwapInterval_ = 0;
+
+        #ifdef __linux__
+        VisualID                        visualID_           = 0;    // ID of the X11 visual chosen for the window (0 if not chosen yet).
+        #endif
+
 };
 
 
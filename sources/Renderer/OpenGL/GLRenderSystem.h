@@ -12,25 +12,38 @@
 #include <LLGL/RenderSystem.h>
 #include "Ext/GLExtensionLoader.h"
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
+#include "../DeferredCommandBuffer.h"
+#include "../DriverMessageBridge.h"
 
 #include "GLCommandBuffer.h"
 #include "GLRenderContext.h"
+#include "GLResourceLoader.h"
 
 #include "Buffer/GLBuffer.h"
 #include "Buffer/GLBufferArray.h"
+#include "Buffer/GLTransientBufferAllocator.h"
+#include "Buffer/GLReadback.h"
+#include "Buffer/GLStagingBuffer.h"
 
 #include "Shader/GLShader.h"
 #include "Shader/GLShaderProgram.h"
+#include "Shader/GLProgramBinaryCache.h"
+#include "Buffer/GLVertexArrayCache.h"
 
 #include "Texture/GLTexture.h"
 #include "Texture/GLTextureArray.h"
 #include "Texture/GLSampler.h"
 #include "Texture/GLSamplerArray.h"
 #include "Texture/GLRenderTarget.h"
+#include "Texture/GLFramebufferCache.h"
 
 #include "RenderState/GLQuery.h"
+#include "RenderState/GLQueryArray.h"
+#include "RenderState/GLFence.h"
 #include "RenderState/GLGraphicsPipeline.h"
 #include "RenderState/GLComputePipeline.h"
+#include "RenderState/GLResourceHeap.h"
 
 #include <string>
 #include <memory>
@@ -46,18 +59,16 @@ namespace LLGL
     AssertCap(GetRenderingCaps().FEATURE, #FEATURE)
 
 
-class GLRenderSystem : public RenderSystem
+class GLRenderSystem final : public RenderSystem
 {
 
     public:
 
         /* ----- Common ----- */
 
-        GLRenderSystem();
+        GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~GLRenderSystem();
 
-        void SetConfiguration(const RenderSystemConfiguration& config) override;
-
         /* ----- Render Context ----- */
 
         RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
@@ -66,13 +77,17 @@ class GLRenderSystem : public RenderSystem
 
         /* ----- Command buffers ----- */
 
-        CommandBuffer* CreateCommandBuffer() override;
+        CommandBuffer* CreateCommandBuffer(const CommandBufferDescriptor& desc = {}) override;
+
+        void ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray) override;
 
         void Release(CommandBuffer& commandBuffer) override;
 
         /* ----- Buffers ------ */
 
         Buffer* CreateBuffer(const BufferDescriptor& desc, const void* initialData = nullptr) override;
+        std::shared_future<Buffer*> CreateBufferAsync(const BufferDescriptor& desc, const void* initialData = nullptr) override;
+        std::vector<Buffer*> CreateBuffers(unsigned int numBuffers, const BufferDescriptor* descArray, const void* const * initialDataArray = nullptr) override;
         BufferArray* CreateBufferArray(unsigned int numBuffers, Buffer* const * bufferArray) override;
 
         void Release(Buffer& buffer) override;
@@ -81,12 +96,19 @@ class GLRenderSystem : public RenderSystem
         void WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
 
         void* MapBuffer(Buffer& buffer, const BufferCPUAccess access) override;
+        void* MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags = 0) override;
+        void FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size) override;
         void UnmapBuffer(Buffer& buffer) override;
 
+        TransientBufferRange WriteTransientConstantBuffer(const void* data, std::size_t dataSize) override;
+
         /* ----- Textures ----- */
 
         Texture* CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc = nullptr) override;
+        std::shared_future<Texture*> CreateTextureAsync(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc = nullptr) override;
         TextureArray* CreateTextureArray(unsigned int numTextures, Texture* const * textureArray) override;
+        Texture* CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc) override;
+        Texture* CreateSparseTexture(const TextureDescriptor& textureDesc) override;
 
         void Release(Texture& texture) override;
         void Release(TextureArray& textureArray) override;
@@ -99,6 +121,12 @@ class GLRenderSystem : public RenderSystem
 
         void GenerateMips(Texture& texture) override;
 
+        std::uint64_t GetBindlessTextureHandle(Texture& texture, Sampler* sampler = nullptr) override;
+
+        void CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit) override;
+        bool IsSparseTextureResident(const Texture& texture, const TextureRegion& region) override;
+        Gs::Vector3ui QuerySparseTexturePageSize(const Texture& texture) override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
@@ -107,6 +135,12 @@ class GLRenderSystem : public RenderSystem
         void Release(Sampler& sampler) override;
         void Release(SamplerArray& samplerArray) override;
 
+        /* ----- Resource Heaps ----- */
+
+        ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
+
+        void Release(ResourceHeap& resourceHeap) override;
+
         /* ----- Render Targets ----- */
 
         RenderTarget* CreateRenderTarget(const RenderTargetDescriptor& desc) override;
@@ -129,11 +163,42 @@ class GLRenderSystem : public RenderSystem
         void Release(GraphicsPipeline& graphicsPipeline) override;
         void Release(ComputePipeline& computePipeline) override;
 
+        bool LoadPipelineCache(const std::vector<char>& data) override;
+        std::vector<char> SavePipelineCache() override;
+
         /* ----- Queries ----- */
 
         Query* CreateQuery(const QueryDescriptor& desc) override;
+        QueryArray* CreateQueryArray(unsigned int numQueries, Query* const * queryArray) override;
 
         void Release(Query& query) override;
+        void Release(QueryArray& queryArray) override;
+
+        /* ----- Readbacks ----- */
+
+        Readback* ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType) override;
+        Readback* ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize) override;
+
+        void Release(Readback& readback) override;
+
+        /* ----- Uploads ----- */
+
+        Fence* WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset) override;
+        Fence* WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc) override;
+
+        /* ----- Fences ----- */
+
+        Fence* CreateFence() override;
+
+        void Release(Fence& fence) override;
+
+        /* ----- Memory ----- */
+
+        MemoryInfo QueryMemoryInfo() override;
+
+        bool QueryClockCalibration(ClockCalibration& calibration) override;
+
+        bool ReportStateCacheStatistics(RenderingProfiler& profiler) override;
 
     protected:
 
@@ -144,6 +209,13 @@ class GLRenderSystem : public RenderSystem
         void LoadGLExtensions(const ProfileOpenGLDescriptor& profileDesc);
         void SetDebugCallback(const DebugCallback& debugCallback);
 
+        #ifndef __APPLE__
+        // Forwards a message of GL_KHR_debug to the debug callback and to the driver debugger.
+        static void APIENTRY DebugMessageCallback(
+            GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam
+        );
+        #endif
+
         void QueryRendererInfo();
         void QueryRenderingCaps();
 
@@ -151,24 +223,65 @@ class GLRenderSystem : public RenderSystem
 
         GLRenderContext* GetSharedRenderContext() const;
 
+        // Returns the internal command buffer which is used to replay deferred command buffers.
+        GLCommandBuffer& GetPrimaryCommandBuffer();
+
+        // Submits the merged draw commands that are still queued, before a resource is written, read, or released (see CommandBufferFlags::MergeDraws).
+        void FlushPendingDraws();
+
+        // Creates the respective GLBuffer sub-class for the specified buffer type. If 'id' is non-zero, the buffer takes ownership of this buffer name.
+        std::unique_ptr<GLBuffer> MakeGLBuffer(const BufferDescriptor& desc, const void* initialData, GLuint id = 0);
+
+        // Allocates mutable storage for the bound texture and uploads the optional image data into the first MIP-map level.
+        void AllocMutableStorage(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc);
+
+        // Notifies the state managers of all render contexts about the release of the specified texture.
+        void NotifyTextureRelease(GLTextureTarget target, GLuint texture);
+
+        // Returns the background loader for asynchronous resource uploads, which is created with the first call.
+        GLResourceLoader& GetResourceLoader();
+
+        // Returns the staging buffer for asynchronous writes, which is created with the first call.
+        GLStagingBuffer& GetStagingBuffer();
+
+        // Creates a new fence and signals it after all commands that have been submitted so far.
+        Fence* SignalNewFence();
+
         /* ----- Hardware object containers ----- */
 
-        HWObjectContainer<GLRenderContext>      renderContexts_;
-        HWObjectContainer<GLCommandBuffer>      commandBuffers_;
-        HWObjectContainer<GLBuffer>             buffers_;
-        HWObjectContainer<GLBufferArray>        bufferArrays_;
-        HWObjectContainer<GLTexture>            textures_;
-        HWObjectContainer<GLTextureArray>       textureArrays_;
-        HWObjectContainer<GLSampler>            samplers_;
-        HWObjectContainer<GLSamplerArray>       samplerArrays_;
-        HWObjectContainer<GLRenderTarget>       renderTargets_;
-        HWObjectContainer<GLShader>             shaders_;
-        HWObjectContainer<GLShaderProgram>      shaderPrograms_;
-        HWObjectContainer<GLGraphicsPipeline>   graphicsPipelines_;
-        HWObjectContainer<GLComputePipeline>    computePipelines_;
-        HWObjectContainer<GLQuery>              queries_;
-
-        DebugCallback                           debugCallback_;
+        HWObjectContainer<GLRenderContext>          renderContexts_;
+        HWObjectContainer<GLCommandBuffer>          commandBuffers_;
+        HWObjectContainer<DeferredCommandBuffer>    deferredCommandBuffers_;
+        HWObjectContainer<GLBuffer>                 buffers_;
+        HWObjectContainer<GLBufferArray>            bufferArrays_;
+        HWObjectContainer<GLTexture>                textures_;
+        HWObjectContainer<GLTextureArray>           textureArrays_;
+        SamplerCache<GLSampler>                     samplers_;
+        HWObjectContainer<GLSamplerArray>           samplerArrays_;
+        HWObjectContainer<GLResourceHeap>           resourceHeaps_;
+        HWObjectContainer<GLRenderTarget>           renderTargets_;
+        HWObjectContainer<GLShader>                 shaders_;
+        HWObjectContainer<GLShaderProgram>          shaderPrograms_;
+        HWObjectContainer<GLGraphicsPipeline>       graphicsPipelines_;
+        HWObjectContainer<GLComputePipeline>        computePipelines_;
+        HWObjectContainer<GLQuery>                  queries_;
+        HWObjectContainer<GLQueryArray>             queryArrays_;
+        HWObjectContainer<GLReadback>               readbacks_;
+        HWObjectContainer<GLFence>                  fences_;
+
+        std::unique_ptr<GLCommandBuffer>            primaryCommandBuffer_;
+        std::unique_ptr<GLTransientBufferAllocator> transientConstantBuffer_;
+        std::unique_ptr<GLStagingBuffer>            stagingBuffer_;
+        std::unique_ptr<GLResourceLoader>           resourceLoader_;
+
+        GLProgramBinaryCache                        programBinaryCache_;
+        GLVertexArrayCache                          vertexArrayCache_;
+        GLFramebufferCache                          framebufferCache_;
+
+        DebugCallback                               debugCallback_;
+        DriverMessageBridge                         driverMessages_;
+
+        bool                                        separableShaders_           = false;
 
 };
 
@@ -9,9 +9,16 @@
 #include "../CheckedCast.h"
 #include "../../Core/Helper.h"
 #include "../GLCommon/GLTypes.h"
+#include "../GLCommon/GLExtensionRegistry.h"
+#include "Ext/GLExtensions.h"
 #include "Buffer/GLVertexBuffer.h"
 #include "Buffer/GLIndexBuffer.h"
 #include "Buffer/GLVertexBufferArray.h"
+#include "Buffer/GLStorageBuffer.h"
+#include "Buffer/GLStorageBufferArray.h"
+#include "Buffer/GLStreamOutputBuffer.h"
+#include "Buffer/GLStreamOutputBufferArray.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -26,6 +33,54 @@ static GLenum GetGLBufferUsage(long flags)
 }
 
 Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
+{
+    auto buffer = TakeOwnership(buffers_, MakeGLBuffer(desc, initialData));
+    TrackMemory(*buffer, desc.size);
+    return buffer;
+}
+
+std::vector<Buffer*> GLRenderSystem::CreateBuffers(unsigned int numBuffers, const BufferDescriptor* descArray, const void* const * initialDataArray)
+{
+    std::vector<Buffer*> buffers;
+    if (numBuffers == 0)
+        return buffers;
+
+    buffers.reserve(numBuffers);
+
+    /* Generate all buffer names with a single GL call */
+    std::vector<GLuint> ids(numBuffers, 0);
+
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+        glCreateBuffers(static_cast<GLsizei>(numBuffers), ids.data());
+    else
+    #endif
+        glGenBuffers(static_cast<GLsizei>(numBuffers), ids.data());
+
+    unsigned int i = 0;
+    try
+    {
+        for (; i < numBuffers; ++i)
+        {
+            const auto& desc = descArray[i];
+            auto buffer = TakeOwnership(buffers_, MakeGLBuffer(desc, (initialDataArray != nullptr ? initialDataArray[i] : nullptr), ids[i]));
+            TrackMemory(*buffer, desc.size);
+            buffers.push_back(buffer);
+        }
+    }
+    catch (...)
+    {
+        /* Delete the buffer names that have not been taken by a buffer object yet (the failed buffer has already deleted its own name) */
+        if (i + 1 < numBuffers)
+            glDeleteBuffers(static_cast<GLsizei>(numBuffers - i - 1), &ids[i + 1]);
+        throw;
+    }
+
+    return buffers;
+}
+
+// private
+std::unique_ptr<GLBuffer> GLRenderSystem::MakeGLBuffer(const BufferDescriptor& desc, const void* initialData, GLuint id)
 {
     /* Create either base of sub-class GLBuffer object */
     switch (desc.type)
@@ -33,41 +88,85 @@ Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
         case BufferType::Vertex:
         {
             /* Create vertex buffer and build vertex array */
-            auto bufferGL = MakeUnique<GLVertexBuffer>();
+            auto bufferGL = MakeUnique<GLVertexBuffer>(id);
             {
-                GLStateManager::active->BindBuffer(*bufferGL);
                 bufferGL->BufferData(initialData, desc.size, GetGLBufferUsage(desc.flags));
-                bufferGL->BuildVertexArray(desc.vertexBuffer.format);
+                bufferGL->BuildVertexArray(desc.vertexBuffer.format, &vertexArrayCache_);
             }
-            return TakeOwnership(buffers_, std::move(bufferGL));
+            return bufferGL;
         }
         break;
 
         case BufferType::Index:
         {
             /* Create index buffer and store index format */
-            auto bufferGL = MakeUnique<GLIndexBuffer>(desc.indexBuffer.format);
+            auto bufferGL = MakeUnique<GLIndexBuffer>(desc.indexBuffer.format, id);
+            {
+                bufferGL->BufferData(initialData, desc.size, GetGLBufferUsage(desc.flags));
+            }
+            return bufferGL;
+        }
+        break;
+
+        case BufferType::Storage:
+        {
+            /* Create storage buffer with optional atomic counter */
+            auto bufferGL = MakeUnique<GLStorageBuffer>(desc.storageBuffer.storageType, id);
             {
-                GLStateManager::active->BindBuffer(*bufferGL);
                 bufferGL->BufferData(initialData, desc.size, GetGLBufferUsage(desc.flags));
             }
-            return TakeOwnership(buffers_, std::move(bufferGL));
+            return bufferGL;
+        }
+        break;
+
+        case BufferType::StreamOutput:
+        {
+            /* Create stream-output buffer and build vertex array if it can be drawn as vertex buffer */
+            auto bufferGL = MakeUnique<GLStreamOutputBuffer>(id);
+            {
+                bufferGL->BufferData(initialData, desc.size, GetGLBufferUsage(desc.flags));
+                if (desc.vertexBuffer.format.stride > 0)
+                    bufferGL->BuildVertexArray(desc.vertexBuffer.format, &vertexArrayCache_);
+            }
+            return bufferGL;
         }
         break;
 
         default:
         {
             /* Create generic buffer */
-            auto bufferGL = MakeUnique<GLBuffer>(desc.type);
+            auto bufferGL = MakeUnique<GLBuffer>(desc.type, id);
             {
-                GLStateManager::active->BindBuffer(*bufferGL);
                 bufferGL->BufferData(initialData, desc.size, GetGLBufferUsage(desc.flags));
             }
-            return TakeOwnership(buffers_, std::move(bufferGL));
+            return bufferGL;
         }
     }
 }
 
+std::shared_future<Buffer*> GLRenderSystem::CreateBufferAsync(const BufferDescriptor& desc, const void* initialData)
+{
+    /* Create buffer storage on the calling thread, since vertex arrays are not shared between GL contexts */
+    auto buffer = CreateBuffer(desc, nullptr);
+
+    if (!initialData)
+    {
+        std::promise<Buffer*> result;
+        result.set_value(buffer);
+        return result.get_future().share();
+    }
+
+    /* Upload initial data on the loader thread */
+    const auto dataSize = static_cast<std::size_t>(desc.size);
+    return GetResourceLoader().Submit(
+        [this, buffer, initialData, dataSize]() -> Buffer*
+        {
+            WriteBuffer(*buffer, initialData, dataSize, 0);
+            return buffer;
+        }
+    );
+}
+
 BufferArray* GLRenderSystem::CreateBufferArray(unsigned int numBuffers, Buffer* const * bufferArray)
 {
     AssertCreateBufferArray(numBuffers, bufferArray);
@@ -77,15 +176,29 @@ BufferArray* GLRenderSystem::CreateBufferArray(unsigned int numBuffers, Buffer*
     {
         /* Create vertex buffer array and build VAO */
         auto vertexBufferArray = MakeUnique<GLVertexBufferArray>();
-        vertexBufferArray->BuildVertexArray(numBuffers, bufferArray);
+        vertexBufferArray->BuildVertexArray(numBuffers, bufferArray, &vertexArrayCache_);
         return TakeOwnership(bufferArrays_, std::move(vertexBufferArray));
     }
 
+    if (type == BufferType::Storage)
+    {
+        /* Create storage buffer array with the atomic counters of all buffers */
+        return TakeOwnership(bufferArrays_, MakeUnique<GLStorageBufferArray>(numBuffers, bufferArray));
+    }
+
+    if (type == BufferType::StreamOutput)
+    {
+        /* Create stream-output buffer array with the transform feedback object of the first buffer */
+        return TakeOwnership(bufferArrays_, MakeUnique<GLStreamOutputBufferArray>(numBuffers, bufferArray));
+    }
+
     return TakeOwnership(bufferArrays_, MakeUnique<GLBufferArray>(type, numBuffers, bufferArray));
 }
 
 void GLRenderSystem::Release(Buffer& buffer)
 {
+    FlushPendingDraws();
+    UntrackMemory(buffer);
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
@@ -94,29 +207,124 @@ void GLRenderSystem::Release(BufferArray& bufferArray)
     RemoveFromUniqueSet(bufferArrays_, &bufferArray);
 }
 
-static GLBuffer& BindAndGetGLBuffer(Buffer& buffer)
+void GLRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
 {
+    FlushPendingDraws();
+
+    /* Update buffer sub-data (binds the buffer only without direct state access) */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
-    GLStateManager::active->BindBuffer(bufferGL);
-    return bufferGL;
+    bufferGL.BufferSubData(data, dataSize, static_cast<GLintptr>(offset));
 }
 
-void GLRenderSystem::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+#ifdef GL_ARB_map_buffer_range
+
+// Returns the access bits for glMapBufferRange, which can also discard the buffer content or skip the synchronization with the GPU.
+static GLbitfield GetGLMapBufferRangeAccess(const BufferCPUAccess access)
 {
-    /* Bind and update buffer sub-data */
-    BindAndGetGLBuffer(buffer).BufferSubData(data, dataSize, static_cast<GLintptr>(offset));
+    switch (access)
+    {
+        case BufferCPUAccess::ReadOnly:         return GL_MAP_READ_BIT;
+        case BufferCPUAccess::WriteOnly:        return GL_MAP_WRITE_BIT;
+        case BufferCPUAccess::ReadWrite:        return (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
+        case BufferCPUAccess::WriteDiscard:     return (GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        case BufferCPUAccess::WriteNoOverwrite: return (GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    }
+    return 0;
 }
 
+// Returns the access bits for glMapBufferRange with the additional mapping flags.
+static GLbitfield GetGLMapBufferRangeAccess(const BufferCPUAccess access, long mapFlags)
+{
+    GLbitfield bitfield = GetGLMapBufferRangeAccess(access);
+
+    if ((mapFlags & BufferMapFlags::DiscardRange) != 0)
+        bitfield |= GL_MAP_INVALIDATE_RANGE_BIT;
+    if ((mapFlags & BufferMapFlags::DiscardBuffer) != 0)
+        bitfield |= GL_MAP_INVALIDATE_BUFFER_BIT;
+    if ((mapFlags & BufferMapFlags::Unsynchronized) != 0)
+        bitfield |= GL_MAP_UNSYNCHRONIZED_BIT;
+    if ((mapFlags & BufferMapFlags::FlushExplicit) != 0)
+        bitfield |= GL_MAP_FLUSH_EXPLICIT_BIT;
+
+    return bitfield;
+}
+
+#endif
+
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const BufferCPUAccess access)
 {
-    /* Bind and map buffer */
-    return BindAndGetGLBuffer(buffer).MapBuffer(GLTypes::Map(access));
+    FlushPendingDraws();
+
+    /* Map buffer (binds the buffer only without direct state access) */
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+
+    #ifdef GL_ARB_map_buffer_range
+    if (HasExtension(GLExt::ARB_map_buffer_range))
+        return bufferGL.MapBufferRange(0, bufferGL.GetSize(), GetGLMapBufferRangeAccess(access));
+    #endif
+
+    return bufferGL.MapBuffer(GLTypes::Map(access));
+}
+
+void* GLRenderSystem::MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags)
+{
+    FlushPendingDraws();
+
+    #ifdef GL_ARB_map_buffer_range
+    if (HasExtension(GLExt::ARB_map_buffer_range))
+    {
+        /* Map buffer range (binds the buffer only without direct state access) */
+        auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+        return bufferGL.MapBufferRange(
+            static_cast<GLintptr>(offset),
+            static_cast<GLsizeiptr>(size),
+            GetGLMapBufferRangeAccess(access, mapFlags)
+        );
+    }
+    #endif
+
+    /* Fall back to mapping the entire buffer */
+    return RenderSystem::MapBufferRange(buffer, offset, size, access, mapFlags);
+}
+
+void GLRenderSystem::FlushMappedBufferRange(Buffer& buffer, std::size_t offset, std::size_t size)
+{
+    #ifdef GL_ARB_map_buffer_range
+    if (HasExtension(GLExt::ARB_map_buffer_range))
+    {
+        auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+        bufferGL.FlushMappedBufferRange(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+    }
+    #endif
 }
 
 void GLRenderSystem::UnmapBuffer(Buffer& buffer)
 {
-    /* Bind and unmap buffer */
-    BindAndGetGLBuffer(buffer).UnmapBuffer();
+    /* Unmap buffer (binds the buffer only without direct state access) */
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+    bufferGL.UnmapBuffer();
+}
+
+// Size (in bytes) of the ring buffer for transient constant buffer ranges.
+static const unsigned int g_transientConstantBufferSize = (4u << 20);
+
+TransientBufferRange GLRenderSystem::WriteTransientConstantBuffer(const void* data, std::size_t dataSize)
+{
+    if (!GetRenderingCaps().hasConstantBufferRanges)
+        return {};
+
+    if (!transientConstantBuffer_)
+    {
+        /* Create ring buffer with an offset alignment that is valid for all render systems */
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        transientConstantBuffer_ = MakeUnique<GLTransientBufferAllocator>(
+            g_transientConstantBufferSize,
+            std::max(256u, static_cast<unsigned int>(alignment))
+        );
+    }
+
+    return transientConstantBuffer_->Write(data, dataSize);
 }
 
 
@@ -11,11 +11,13 @@
 #include "../GLCommon/Texture/GLTexImage.h"
 #include "Ext/GLExtensions.h"
 #include "../CheckedCast.h"
+#include "../Assertion.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Exception.h"
 #include <LLGL/Desktop.h>
 
 #include <LLGL/Log.h>
+#include <chrono>
 
 
 namespace LLGL
@@ -24,7 +26,8 @@ namespace LLGL
 
 /* ----- Render System ----- */
 
-GLRenderSystem::GLRenderSystem()
+GLRenderSystem::GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
+    driverMessages_ { renderSystemDesc.driverDebugger, renderSystemDesc.driverMessageLimit, "OpenGL" }
 {
 }
 
@@ -33,12 +36,6 @@ GLRenderSystem::~GLRenderSystem()
     Desktop::ResetVideoMode();
 }
 
-void GLRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
-{
-    RenderSystem::SetConfiguration(config);
-    GLTexImageInitialization(config.imageInitialization);
-}
-
 /* ----- Render Context ----- */
 
 // private
@@ -49,6 +46,13 @@ GLRenderContext* GLRenderSystem::GetSharedRenderContext() const
 
 RenderContext* GLRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
 {
+    if (desc.profileOpenGL.noErrorContext && driverMessages_.IsEnabled())
+    {
+        /* Driver messages are not generated for a context without error checking */
+        auto contextDesc = desc;
+        contextDesc.profileOpenGL.noErrorContext = false;
+        return AddRenderContext(MakeUnique<GLRenderContext>(contextDesc, surface, GetSharedRenderContext()), contextDesc);
+    }
     return AddRenderContext(MakeUnique<GLRenderContext>(desc, surface, GetSharedRenderContext()), desc);
 }
 
@@ -59,20 +63,96 @@ void GLRenderSystem::Release(RenderContext& renderContext)
 
 /* ----- Command buffers ----- */
 
-CommandBuffer* GLRenderSystem::CreateCommandBuffer()
+CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
+    /* Deferred command buffers are independent of the render system */
+    if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
+        return TakeOwnership(deferredCommandBuffers_, MakeUnique<DeferredCommandBuffer>());
+
     /* Get state manager from shared render context */
     auto sharedContext = GetSharedRenderContext();
     if (!sharedContext)
         throw std::runtime_error("can not create OpenGL command buffer without active render context");
 
-    /* Create command buffer */
-    return TakeOwnership(commandBuffers_, MakeUnique<GLCommandBuffer>(sharedContext->GetStateManager()));
+    /* Create command buffer with the state manager of the active context of this thread (it switches with "SetRenderTarget") */
+    auto activeContext = GLContext::Active();
+    return TakeOwnership(
+        commandBuffers_,
+        MakeUnique<GLCommandBuffer>(
+            (activeContext != nullptr ? activeContext->GetStateManager() : sharedContext->GetStateManager()),
+            desc.flags
+        )
+    );
+}
+
+// private
+GLCommandBuffer& GLRenderSystem::GetPrimaryCommandBuffer()
+{
+    if (!primaryCommandBuffer_)
+    {
+        /* Get state manager from shared render context */
+        auto sharedContext = GetSharedRenderContext();
+        if (!sharedContext)
+            throw std::runtime_error("can not execute OpenGL command buffers without active render context");
+
+        primaryCommandBuffer_ = MakeUnique<GLCommandBuffer>(sharedContext->GetStateManager());
+    }
+    return *primaryCommandBuffer_;
+}
+
+// private
+void GLRenderSystem::FlushPendingDraws()
+{
+    if (GLStateManager::active != nullptr)
+        GLStateManager::active->FlushPendingDraws();
+}
+
+// private
+GLStagingBuffer& GLRenderSystem::GetStagingBuffer()
+{
+    if (!stagingBuffer_)
+        stagingBuffer_ = MakeUnique<GLStagingBuffer>();
+    return *stagingBuffer_;
+}
+
+// private
+Fence* GLRenderSystem::SignalNewFence()
+{
+    auto fenceGL = MakeUnique<GLFence>();
+    fenceGL->Signal();
+    return TakeOwnership(fences_, std::move(fenceGL));
+}
+
+// private
+GLResourceLoader& GLRenderSystem::GetResourceLoader()
+{
+    if (!resourceLoader_)
+    {
+        /* Create loader context that shares its objects with the shared render context */
+        auto sharedContext = GetSharedRenderContext();
+        if (!sharedContext)
+            throw std::runtime_error("can not create OpenGL resources asynchronously without active render context");
+
+        resourceLoader_ = MakeUnique<GLResourceLoader>(*sharedContext);
+    }
+    return *resourceLoader_;
+}
+
+void GLRenderSystem::ExecuteCommandBuffers(unsigned int numCommandBuffers, CommandBuffer* const * commandBufferArray)
+{
+    LLGL_ASSERT_PTR(commandBufferArray);
+
+    /* Replay all deferred command buffers with the primary command buffer */
+    auto& primaryCommandBuffer = GetPrimaryCommandBuffer();
+
+    while (auto commandBuffer = NextArrayResource<DeferredCommandBuffer>(numCommandBuffers, commandBufferArray))
+        commandBuffer->Replay(primaryCommandBuffer);
 }
 
 void GLRenderSystem::Release(CommandBuffer& commandBuffer)
 {
     RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
+    RemoveFromUniqueSet(deferredCommandBuffers_, &commandBuffer);
 }
 
 /* ----- Buffers ------ */
@@ -88,9 +168,15 @@ void GLRenderSystem::Release(CommandBuffer& commandBuffer)
 Sampler* GLRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
     LLGL_ASSERT_CAP(hasSamplers);
-    auto sampler = MakeUnique<GLSampler>();
-    sampler->SetDesc(desc);
-    return TakeOwnership(samplers_, std::move(sampler));
+    return samplers_.Acquire(
+        desc,
+        [&desc]()
+        {
+            auto sampler = MakeUnique<GLSampler>();
+            sampler->SetDesc(desc);
+            return sampler;
+        }
+    );
 }
 
 SamplerArray* GLRenderSystem::CreateSamplerArray(unsigned int numSamplers, Sampler* const * samplerArray)
@@ -102,7 +188,7 @@ SamplerArray* GLRenderSystem::CreateSamplerArray(unsigned int numSamplers, Sampl
 
 void GLRenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    samplers_.Release(&sampler);
 }
 
 void GLRenderSystem::Release(SamplerArray& samplerArray)
@@ -110,16 +196,33 @@ void GLRenderSystem::Release(SamplerArray& samplerArray)
     RemoveFromUniqueSet(samplerArrays_, &samplerArray);
 }
 
+/* ----- Resource Heaps ----- */
+
+ResourceHeap* GLRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    AssertCreateResourceHeap(desc);
+    return TakeOwnership(resourceHeaps_, MakeUnique<GLResourceHeap>(desc));
+}
+
+void GLRenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+}
+
 /* ----- Render Targets ----- */
 
 RenderTarget* GLRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
 {
     LLGL_ASSERT_CAP(hasRenderTargets);
-    return TakeOwnership(renderTargets_, MakeUnique<GLRenderTarget>(desc));
+    return TakeOwnership(renderTargets_, MakeUnique<GLRenderTarget>(desc, framebufferCache_));
 }
 
 void GLRenderSystem::Release(RenderTarget& renderTarget)
 {
+    /* Detach all attachments to release the cached FBOs of the render target's renderbuffers */
+    auto& renderTargetGL = LLGL_CAST(GLRenderTarget&, renderTarget);
+    renderTargetGL.DetachAll();
+
     RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
@@ -140,6 +243,10 @@ Shader* GLRenderSystem::CreateShader(const ShaderType type)
         case ShaderType::Compute:
             LLGL_ASSERT_CAP(hasComputeShaders);
             break;
+        case ShaderType::Amplification:
+        case ShaderType::Mesh:
+            LLGL_ASSERT_CAP(hasMeshShaders);
+            break;
         default:
             break;
     }
@@ -150,7 +257,7 @@ Shader* GLRenderSystem::CreateShader(const ShaderType type)
 
 ShaderProgram* GLRenderSystem::CreateShaderProgram()
 {
-    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>());
+    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(&programBinaryCache_, separableShaders_));
 }
 
 void GLRenderSystem::Release(Shader& shader)
@@ -185,18 +292,211 @@ void GLRenderSystem::Release(ComputePipeline& computePipeline)
     RemoveFromUniqueSet(computePipelines_, &computePipeline);
 }
 
+bool GLRenderSystem::LoadPipelineCache(const std::vector<char>& data)
+{
+    return programBinaryCache_.Load(data);
+}
+
+std::vector<char> GLRenderSystem::SavePipelineCache()
+{
+    return programBinaryCache_.Save();
+}
+
 /* ----- Queries ----- */
 
 Query* GLRenderSystem::CreateQuery(const QueryDescriptor& desc)
 {
+    if (desc.type == QueryType::Timestamp && !HasExtension(GLExt::ARB_timer_query))
+        ThrowNotSupported("timestamp queries");
+    if (desc.type == QueryType::PipelineStatistics && (!HasExtension(GLExt::ARB_pipeline_statistics_query) || !GLQuery::GetPipelineStatisticsTargets()))
+        ThrowNotSupported("pipeline statistics queries");
     return TakeOwnership(queries_, MakeUnique<GLQuery>(desc));
 }
 
+QueryArray* GLRenderSystem::CreateQueryArray(unsigned int numQueries, Query* const * queryArray)
+{
+    AssertCreateQueryArray(numQueries, queryArray);
+    return TakeOwnership(queryArrays_, MakeUnique<GLQueryArray>(numQueries, queryArray));
+}
+
 void GLRenderSystem::Release(Query& query)
 {
     RemoveFromUniqueSet(queries_, &query);
 }
 
+void GLRenderSystem::Release(QueryArray& queryArray)
+{
+    RemoveFromUniqueSet(queryArrays_, &queryArray);
+}
+
+/* ----- Readbacks ----- */
+
+Readback* GLRenderSystem::ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType)
+{
+    FlushPendingDraws();
+    auto& textureGL = LLGL_CAST(const GLTexture&, texture);
+    auto readbackGL = MakeUnique<GLReadback>(GetTextureReadbackSize(texture, mipLevel, imageFormat, dataType));
+    readbackGL->ReadTexture(textureGL, mipLevel, imageFormat, dataType);
+    return TakeOwnership(readbacks_, std::move(readbackGL));
+}
+
+Readback* GLRenderSystem::ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize)
+{
+    FlushPendingDraws();
+
+    #ifdef GL_ARB_copy_buffer
+    if (HasExtension(GLExt::ARB_copy_buffer))
+    {
+        auto& bufferGL = LLGL_CAST(const GLBuffer&, buffer);
+        auto readbackGL = MakeUnique<GLReadback>(dataSize);
+        readbackGL->ReadBuffer(bufferGL, offset);
+        return TakeOwnership(readbacks_, std::move(readbackGL));
+    }
+    #endif
+
+    /* Fall back to immediate readback by mapping the buffer */
+    return RenderSystem::ReadBufferAsync(buffer, offset, dataSize);
+}
+
+void GLRenderSystem::Release(Readback& readback)
+{
+    /* Readback is either owned by this render system or by the default implementation */
+    RemoveFromUniqueSet(readbacks_, &readback);
+    RenderSystem::Release(readback);
+}
+
+/* ----- Uploads ----- */
+
+Fence* GLRenderSystem::WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    #ifdef GL_ARB_copy_buffer
+    if (HasExtension(GLExt::ARB_copy_buffer))
+    {
+        FlushPendingDraws();
+        auto& bufferGL = LLGL_CAST(const GLBuffer&, buffer);
+        GetStagingBuffer().WriteBuffer(bufferGL, data, dataSize, offset);
+        return SignalNewFence();
+    }
+    #endif
+
+    /* Fall back to immediate write */
+    return RenderSystem::WriteBufferAsync(buffer, data, dataSize, offset);
+}
+
+Fence* GLRenderSystem::WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    /* Fall back to immediate write if the size of the image data is unknown */
+    auto dataSize = GetSubTextureDataSize(texture, subTextureDesc, imageDesc);
+    if (imageDesc.buffer == nullptr || dataSize == 0)
+        return RenderSystem::WriteTextureAsync(texture, subTextureDesc, imageDesc);
+
+    /* Write texture from the staging buffer, where the image data pointer is interpreted as offset into the bound pixel unpack buffer */
+    auto& stagingBuffer = GetStagingBuffer();
+    stagingBuffer.BeginWriteTexture(imageDesc.buffer, dataSize);
+    {
+        auto stagingImageDesc = imageDesc;
+        stagingImageDesc.buffer = nullptr;
+        WriteTexture(texture, subTextureDesc, stagingImageDesc);
+    }
+    stagingBuffer.EndWriteTexture();
+
+    return SignalNewFence();
+}
+
+/* ----- Fences ----- */
+
+Fence* GLRenderSystem::CreateFence()
+{
+    return TakeOwnership(fences_, MakeUnique<GLFence>());
+}
+
+void GLRenderSystem::Release(Fence& fence)
+{
+    RemoveFromUniqueSet(fences_, &fence);
+}
+
+/* ----- Memory ----- */
+
+MemoryInfo GLRenderSystem::QueryMemoryInfo()
+{
+    MemoryInfo memoryInfo;
+
+    /* Accumulate memory the render system has allocated */
+    GetTrackedMemory(memoryInfo);
+
+    for (const auto& renderTarget : renderTargets_)
+        memoryInfo.renderTargetMemory += renderTarget->GetRenderbufferMemory();
+
+    /* Query memory budget from vendor specific extensions (all values are in KB) */
+    #ifdef GL_NVX_gpu_memory_info
+    if (HasExtension(GLExt::NVX_gpu_memory_info))
+    {
+        GLint totalAvailableMemory = 0, currentAvailableMemory = 0;
+        glGetIntegerv(GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX, &totalAvailableMemory);
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &currentAvailableMemory);
+
+        memoryInfo.local.budget         = static_cast<std::uint64_t>(totalAvailableMemory) * 1024;
+        memoryInfo.local.currentUsage   = static_cast<std::uint64_t>(totalAvailableMemory - currentAvailableMemory) * 1024;
+
+        return memoryInfo;
+    }
+    #endif // /GL_NVX_gpu_memory_info
+
+    #ifdef GL_ATI_meminfo
+    if (HasExtension(GLExt::ATI_meminfo))
+    {
+        /* Only the free memory is reported, so the budget is estimated with the memory the render system has allocated */
+        GLint freeTextureMemory[4] = { 0, 0, 0, 0 };
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, freeTextureMemory);
+
+        memoryInfo.local.currentUsage   = memoryInfo.bufferMemory + memoryInfo.textureMemory + memoryInfo.renderTargetMemory;
+        memoryInfo.local.budget         = static_cast<std::uint64_t>(freeTextureMemory[0]) * 1024 + memoryInfo.local.currentUsage;
+        memoryInfo.nonLocal.budget      = static_cast<std::uint64_t>(freeTextureMemory[2]) * 1024;
+    }
+    #endif // /GL_ATI_meminfo
+
+    return memoryInfo;
+}
+
+bool GLRenderSystem::QueryClockCalibration(ClockCalibration& calibration)
+{
+    #ifdef GL_TIMESTAMP
+    if (HasExtension(GLExt::ARB_timer_query) && HasExtension(GLExt::ARB_sync))
+    {
+        using Clock = std::chrono::steady_clock;
+
+        /* Query GPU timestamp between two CPU timestamps and take their midpoint as the moment the GPU time was sampled */
+        auto cpuTimeBefore = Clock::now();
+
+        GLint64 gpuTime = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+
+        auto cpuTimeAfter = Clock::now();
+
+        auto cpuTime = cpuTimeBefore + (cpuTimeAfter - cpuTimeBefore) / 2;
+
+        calibration.gpuTime = static_cast<std::uint64_t>(gpuTime);
+        calibration.cpuTime = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(cpuTime.time_since_epoch()).count()
+        );
+
+        return true;
+    }
+    #endif // /GL_TIMESTAMP
+    return false;
+}
+
+bool GLRenderSystem::ReportStateCacheStatistics(RenderingProfiler& profiler)
+{
+    #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+    for (const auto& renderContext : renderContexts_)
+        renderContext->GetStateManager()->ReportCacheStatistics(profiler);
+    return true;
+    #else
+    return false;
+    #endif // /LLGL_GL_ENABLE_STATE_CACHE_STATS
+}
+
 
 /*
  * ======= Protected: =======
@@ -213,6 +513,13 @@ RenderContext* GLRenderSystem::AddRenderContext(std::unique_ptr<GLRenderContext>
     {
         LoadGLExtensions(desc.profileOpenGL);
         SetDebugCallback(desc.debugCallback);
+
+        /* Separable programs require GL_PROGRAM_SEPARABLE, which is set with "glProgramParameteri" of GL_ARB_get_program_binary */
+        separableShaders_ = (
+            desc.profileOpenGL.separableShaders &&
+            HasExtension(GLExt::ARB_separate_shader_objects) &&
+            HasExtension(GLExt::ARB_get_program_binary)
+        );
     }
 
     /* Use uniform clipping space */
@@ -239,44 +546,90 @@ void GLRenderSystem::LoadGLExtensions(const ProfileOpenGLDescriptor& profileDesc
         auto extensions = QueryExtensions(coreProfile);
         LoadAllExtensions(extensions, coreProfile);
 
+        #ifndef __APPLE__
+        /* Let the driver choose the number of threads for parallel shader compilation */
+        if (HasExtension(GLExt::ARB_parallel_shader_compile))
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        #endif
+
         /* Query and store all renderer information and capabilities */
         QueryRendererInfo();
         QueryRenderingCaps();
     }
 }
 
-#ifdef LLGL_DEBUG
+#ifndef __APPLE__
+
+// Determines the category of the specified GL debug message type, or returns false if the message is not a driver diagnostic (e.g. debug group markers).
+static bool GLGetDriverMessageCategory(GLenum type, DriverMessageCategory& category)
+{
+    switch (type)
+    {
+        case GL_DEBUG_TYPE_ERROR:
+            category = DriverMessageCategory::Error;
+            return true;
+        case GL_DEBUG_TYPE_PERFORMANCE:
+            category = DriverMessageCategory::Performance;
+            return true;
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:
+        case GL_DEBUG_TYPE_PORTABILITY:
+            category = DriverMessageCategory::ImproperUsage;
+            return true;
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:
+            category = DriverMessageCategory::UndefinedBehavior;
+            return true;
+        default:
+            return false;
+    }
+}
 
-void APIENTRY GLDebugCallback(
+void APIENTRY GLRenderSystem::DebugMessageCallback(
     GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam)
 {
-    /* Generate output stream */
-    std::stringstream typeStr;
+    auto renderSystemGL = reinterpret_cast<GLRenderSystem*>(const_cast<void*>(userParam));
 
-    typeStr
-        << "OpenGL debug callback ("
-        << GLDebugSourceToStr(source) << ", "
-        << GLDebugTypeToStr(type) << ", "
-        << GLDebugSeverityToStr(severity) << ")";
+    #ifdef LLGL_DEBUG
+    if (renderSystemGL->debugCallback_)
+    {
+        /* Generate output stream */
+        std::stringstream typeStr;
+
+        typeStr
+            << "OpenGL debug callback ("
+            << GLDebugSourceToStr(source) << ", "
+            << GLDebugTypeToStr(type) << ", "
+            << GLDebugSeverityToStr(severity) << ")";
+
+        /* Call debug callback */
+        renderSystemGL->debugCallback_(typeStr.str(), message);
+    }
+    #endif
 
-    /* Call debug callback */
-    auto& debugCallback = *reinterpret_cast<const DebugCallback*>(userParam);
-    debugCallback(typeStr.str(), message);
+    /* Post driver diagnostics to the driver debugger */
+    DriverMessageCategory category;
+    if (GLGetDriverMessageCategory(type, category))
+        renderSystemGL->driverMessages_.Post(category, id, message);
 }
 
 #endif
 
 void GLRenderSystem::SetDebugCallback(const DebugCallback& debugCallback)
 {
-    #if defined(LLGL_DEBUG) && !defined(__APPLE__)
+    #ifndef __APPLE__
 
+    #ifdef LLGL_DEBUG
     debugCallback_ = debugCallback;
+    #endif
+
+    if (!HasExtension(GLExt::KHR_debug))
+        return;
 
-    if (debugCallback_)
+    if (debugCallback_ || driverMessages_.IsEnabled())
     {
+        /* Messages are generated synchronously, so driver messages are reported within the function that caused them */
         GLStateManager::active->Enable(GLState::DEBUG_OUTPUT);
         GLStateManager::active->Enable(GLState::DEBUG_OUTPUT_SYNCHRONOUS);
-        glDebugMessageCallback(GLDebugCallback, &debugCallback_);
+        glDebugMessageCallback(GLRenderSystem::DebugMessageCallback, this);
     }
     else
     {
@@ -350,18 +703,50 @@ void GLRenderSystem::QueryRenderingCaps()
     caps.hasTextureArrays               = HasExtension(GLExt::EXT_texture_array);
     caps.hasCubeTextureArrays           = HasExtension(GLExt::ARB_texture_cube_map_array);
     caps.hasMultiSampleTextures         = HasExtension(GLExt::ARB_texture_multisample);
+    caps.hasTextureViews                = ( HasExtension(GLExt::ARB_texture_storage) && HasExtension(GLExt::ARB_texture_view) );
+    caps.hasSparseTextures              = ( HasExtension(GLExt::ARB_texture_storage) && HasExtension(GLExt::ARB_internalformat_query) && HasExtension(GLExt::ARB_sparse_texture) );
     caps.hasSamplers                    = HasExtension(GLExt::ARB_sampler_objects);
     caps.hasConstantBuffers             = HasExtension(GLExt::ARB_uniform_buffer_object);
     caps.hasStorageBuffers              = HasExtension(GLExt::ARB_shader_storage_buffer_object);
+    caps.hasBufferCounters              = ( caps.hasStorageBuffers && HasExtension(GLExt::ARB_shader_atomic_counters) );
+    caps.hasConstantBufferRanges        = HasExtension(GLExt::ARB_uniform_buffer_object);
     caps.hasUniforms                    = HasExtension(GLExt::ARB_shader_objects);
     caps.hasGeometryShaders             = HasExtension(GLExt::ARB_geometry_shader4);
     caps.hasTessellationShaders         = HasExtension(GLExt::ARB_tessellation_shader);
     caps.hasComputeShaders              = HasExtension(GLExt::ARB_compute_shader);
+    caps.hasShaderClassInterfaces       = HasExtension(GLExt::ARB_shader_subroutine);
+    caps.hasIndirectDrawing             = HasExtension(GLExt::ARB_draw_indirect);
+    caps.hasBindlessTextures            = HasExtension(GLExt::ARB_bindless_texture);
     caps.hasInstancing                  = HasExtension(GLExt::ARB_draw_instanced);
     caps.hasOffsetInstancing            = HasExtension(GLExt::ARB_base_instance);
     caps.hasViewportArrays              = HasExtension(GLExt::ARB_viewport_array);
+    caps.hasLayeredRenderTargets        = HasExtension(GLExt::ARB_geometry_shader4);
+    caps.hasVertexShaderLayer           = ( HasExtension(GLExt::ARB_shader_viewport_layer_array) || HasExtension(GLExt::AMD_vertex_shader_layer) );
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
     caps.hasConservativeRasterization   = ( HasExtension(GLExt::NV_conservative_raster) || HasExtension(GLExt::INTEL_conservative_rasterization) );
+    #else
+    caps.hasConservativeRasterization   = false;
+    #endif
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+    caps.hasVariableRateShading         = HasExtension(GLExt::NV_shading_rate_image);
+    caps.hasShadingRateImage            = HasExtension(GLExt::NV_shading_rate_image);
+    #else
+    caps.hasVariableRateShading         = false;
+    caps.hasShadingRateImage            = false;
+    #endif
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_mesh_shader
+    caps.hasMeshShaders                 = HasExtension(GLExt::NV_mesh_shader);
+    #else
+    caps.hasMeshShaders                 = false;
+    #endif
+    #ifdef GL_EXT_depth_bounds_test
+    caps.hasDepthBoundsTest             = HasExtension(GLExt::EXT_depth_bounds_test);
+    #else
+    caps.hasDepthBoundsTest             = false;
+    #endif
     caps.hasStreamOutputs               = ( HasExtension(GLExt::EXT_transform_feedback) || HasExtension(GLExt::NV_transform_feedback) );
+    caps.hasStreamOutputDraws           = HasExtension(GLExt::ARB_transform_feedback2);
+    caps.hasShaderBinaries              = HasExtension(GLExt::ARB_gl_spirv);
 
     /* Query integral attributes */
     auto GetInt = [](GLenum param)
@@ -387,6 +772,7 @@ void GLRenderSystem::QueryRenderingCaps()
     caps.maxNumTextureArrayLayers           = GetUInt(GL_MAX_ARRAY_TEXTURE_LAYERS);
     caps.maxNumRenderTargetAttachments      = GetUInt(GL_MAX_DRAW_BUFFERS);
     caps.maxConstantBufferSize              = GetUInt(GL_MAX_UNIFORM_BLOCK_SIZE);
+    caps.maxPushConstantsSize               = 128;
     caps.maxPatchVertices                   = GetInt(GL_MAX_PATCH_VERTICES);
     caps.maxAnisotropy                      = 16;
     
@@ -398,6 +784,27 @@ void GLRenderSystem::QueryRenderingCaps()
     caps.maxComputeShaderWorkGroupSize.y    = GetUIntIdx(GL_MAX_COMPUTE_WORK_GROUP_SIZE, 1);
     caps.maxComputeShaderWorkGroupSize.z    = GetUIntIdx(GL_MAX_COMPUTE_WORK_GROUP_SIZE, 2);
 
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shading_rate_image
+    if (caps.hasShadingRateImage)
+        caps.shadingRateImageTileSize       = GetUInt(GL_SHADING_RATE_IMAGE_TEXEL_WIDTH_NV);
+    #endif
+
+    #ifdef GL_OVR_multiview
+    if (HasExtension(GLExt::OVR_multiview) && HasExtension(GLExt::OVR_multiview2))
+        caps.maxNumViews                    = GetUInt(GL_MAX_VIEWS_OVR);
+    #endif
+
+    /* Query wave size from the subgroup extension, or the warp size of NVIDIA GPUs as fallback */
+    #ifdef GL_KHR_shader_subgroup
+    if (HasExtension(GLExt::KHR_shader_subgroup))
+        caps.waveSize                       = GetUInt(GL_SUBGROUP_SIZE_KHR);
+    #endif
+
+    #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_shader_thread_group
+    if (caps.waveSize == 0 && HasExtension(GLExt::NV_shader_thread_group))
+        caps.waveSize                       = GetUInt(GL_WARP_SIZE_NV);
+    #endif
+
     /* Query maximum texture dimensions */
     GLint querySizeBase = 0;
     glGetIntegerv(GL_MAX_TEXTURE_SIZE, &querySizeBase);
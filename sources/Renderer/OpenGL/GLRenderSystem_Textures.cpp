@@ -21,6 +21,147 @@ namespace LLGL
 
 /* ----- Textures ----- */
 
+// Returns the number of layers of the first MIP-map level, where cube faces and 3D slices are separate layers.
+static GLint GetInitialTextureLayers(const TextureDescriptor& desc)
+{
+    switch (desc.type)
+    {
+        case TextureType::Texture3D:        return static_cast<GLint>(desc.texture3D.depth);
+        case TextureType::TextureCube:      return 6;
+        case TextureType::Texture1DArray:   return static_cast<GLint>(desc.texture1D.layers);
+        case TextureType::Texture2DArray:   return static_cast<GLint>(desc.texture2D.layers);
+        case TextureType::TextureCubeArray: return static_cast<GLint>(desc.textureCube.layers * 6);
+        default:                            return 1;
+    }
+}
+
+// Attaches the specified layer of the first MIP-map level to the bound draw framebuffer.
+static void AttachInitialTextureLayer(const TextureDescriptor& desc, GLenum attachment, GLuint texID, GLint layer)
+{
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+            GLFramebuffer::AttachTexture1D(attachment, GL_TEXTURE_1D, texID, 0);
+            break;
+        case TextureType::Texture2D:
+            GLFramebuffer::AttachTexture2D(attachment, GL_TEXTURE_2D, texID, 0);
+            break;
+        case TextureType::Texture3D:
+            GLFramebuffer::AttachTexture3D(attachment, GL_TEXTURE_3D, texID, 0, layer);
+            break;
+        case TextureType::TextureCube:
+            GLFramebuffer::AttachTexture2D(attachment, GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(layer), texID, 0);
+            break;
+        default:
+            GLFramebuffer::AttachTextureLayer(attachment, texID, 0, layer);
+            break;
+    }
+}
+
+// Returns true if the specified format is a base format without an explicit size, which cannot be used for immutable storage.
+static bool IsBaseTextureFormat(const TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::Unknown:
+        case TextureFormat::DepthComponent:
+        case TextureFormat::DepthStencil:
+        case TextureFormat::R:
+        case TextureFormat::RG:
+        case TextureFormat::RGB:
+        case TextureFormat::RGBA:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+Returns true if the texture is created with immutable storage (glTexStorage*), which is used whenever it's supported.
+The driver does not need to re-validate the completeness of immutable textures on each binding and never reallocates them on later uploads.
+Immutable storage requires a sized internal format, and is also required to create texture views.
+*/
+static bool HasImmutableStorage(const TextureDescriptor& desc)
+{
+    if (!HasExtension(GLExt::ARB_texture_storage) || IsBaseTextureFormat(desc.format))
+        return false;
+    if (IsMultiSampleTexture(desc.type))
+        return HasExtension(GLExt::ARB_texture_storage_multisample);
+    return true;
+}
+
+// Returns the texture region of the entire first MIP-map level.
+static TextureRegion GetInitialTextureRegion(const TextureDescriptor& desc)
+{
+    const auto layers = static_cast<unsigned int>(GetInitialTextureLayers(desc));
+
+    if (desc.type == TextureType::Texture1D || desc.type == TextureType::Texture1DArray)
+        return TextureRegion { 0, { 0, 0, 0 }, { desc.texture1D.width, layers, 1 } };
+    else
+        return TextureRegion { 0, { 0, 0, 0 }, { desc.texture2D.width, desc.texture2D.height, layers } };
+}
+
+/*
+Initializes the image of a new texture on the GPU with the default color or depth of the render system configuration,
+instead of uploading a CPU generated image. Multi-sampled and compressed textures are left uninitialized.
+*/
+static void InitializeTextureImage(const GLTexture& textureGL, const TextureDescriptor& desc, const ImageInitialization& imageInitialization)
+{
+    if (!imageInitialization.enabled || IsCompressedFormat(desc.format) || IsMultiSampleTexture(desc.type))
+        return;
+
+    const auto texID = textureGL.GetID();
+
+    #ifdef GL_ARB_clear_texture
+    if (HasExtension(GLExt::ARB_clear_texture))
+    {
+        /* Clear entire first MIP-map level in a single command */
+        if (desc.format == TextureFormat::DepthComponent)
+            glClearTexImage(texID, 0, GL_DEPTH_COMPONENT, GL_FLOAT, &imageInitialization.depth);
+        else if (desc.format == TextureFormat::DepthStencil)
+        {
+            const GLuint depthStencil = (static_cast<GLuint>(imageInitialization.depth * 16777215.0f) << 8);
+            glClearTexImage(texID, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, &depthStencil);
+        }
+        else
+            glClearTexImage(texID, 0, GL_RGBA, GL_UNSIGNED_BYTE, imageInitialization.color.Ptr());
+        return;
+    }
+    #endif
+
+    /* Clear each layer of the first MIP-map level with a temporary FBO */
+    const auto colorf       = imageInitialization.color.Cast<float>();
+    const auto attachment   = (desc.format == TextureFormat::DepthComponent ? GL_DEPTH_ATTACHMENT : desc.format == TextureFormat::DepthStencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_COLOR_ATTACHMENT0);
+
+    GLFramebuffer framebuffer;
+    GLStateManager::active->BindFramebuffer(GLFramebufferTarget::DRAW_FRAMEBUFFER, framebuffer.GetID());
+
+    GLStateManager::active->PushState(GLState::SCISSOR_TEST);
+    GLStateManager::active->Disable(GLState::SCISSOR_TEST);
+    GLStateManager::active->SetDepthMask(GL_TRUE);
+    GLStateManager::active->InvalidatePipelineState();
+
+    if (attachment == GL_COLOR_ATTACHMENT0)
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    else
+        glDrawBuffer(GL_NONE);
+
+    for (GLint layer = 0, numLayers = GetInitialTextureLayers(desc); layer < numLayers; ++layer)
+    {
+        AttachInitialTextureLayer(desc, attachment, texID, layer);
+
+        if (attachment == GL_DEPTH_ATTACHMENT)
+            glClearBufferfv(GL_DEPTH, 0, &imageInitialization.depth);
+        else if (attachment == GL_DEPTH_STENCIL_ATTACHMENT)
+            glClearBufferfi(GL_DEPTH_STENCIL, 0, imageInitialization.depth, 0);
+        else
+            glClearBufferfv(GL_COLOR, 0, colorf.Ptr());
+    }
+
+    GLStateManager::active->PopState();
+    GLStateManager::active->BindFramebuffer(GLFramebufferTarget::DRAW_FRAMEBUFFER, 0);
+}
+
 Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
 {
     auto texture = MakeUnique<GLTexture>(textureDesc.type);
@@ -33,7 +174,31 @@ Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    /* Build texture storage and upload image dataa */
+    if (HasImmutableStorage(textureDesc))
+    {
+        /* Allocate immutable texture storage and upload image data into the first MIP-map level with a sub-image command */
+        texture->AllocImmutableStorage(textureDesc);
+        if (imageDesc && !IsMultiSampleTexture(textureDesc.type))
+            GLTexSubImage(textureDesc.type, GetInitialTextureRegion(textureDesc), *imageDesc);
+    }
+    else
+    {
+        /* Build mutable texture storage and upload image data for base formats or if immutable storage is not supported */
+        AllocMutableStorage(textureDesc, imageDesc);
+    }
+
+    /* Initialize texture image on the GPU if no image data was specified */
+    if (!imageDesc)
+        InitializeTextureImage(*texture, textureDesc, GetConfiguration().imageInitialization);
+
+    TrackMemory(*texture, textureDesc);
+
+    return TakeOwnership(textures_, std::move(texture));
+}
+
+// private
+void GLRenderSystem::AllocMutableStorage(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
+{
     switch (textureDesc.type)
     {
         case TextureType::Texture1D:
@@ -83,8 +248,71 @@ Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
             throw std::invalid_argument("failed to create texture with invalid texture type");
             break;
     }
+}
 
-    return TakeOwnership(textures_, std::move(texture));
+// Returns the sub-texture descriptor for the entire first MIP-map level.
+static SubTextureDescriptor GetInitialSubTextureDescriptor(const TextureDescriptor& desc)
+{
+    SubTextureDescriptor subTextureDesc;
+
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            subTextureDesc.texture1D.width  = desc.texture1D.width;
+            subTextureDesc.texture1D.layers = desc.texture1D.layers;
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+            subTextureDesc.texture2D.width  = desc.texture2D.width;
+            subTextureDesc.texture2D.height = desc.texture2D.height;
+            subTextureDesc.texture2D.layers = desc.texture2D.layers;
+            break;
+
+        case TextureType::Texture3D:
+            subTextureDesc.texture3D.width  = desc.texture3D.width;
+            subTextureDesc.texture3D.height = desc.texture3D.height;
+            subTextureDesc.texture3D.depth  = desc.texture3D.depth;
+            break;
+
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            subTextureDesc.textureCube.width        = desc.textureCube.width;
+            subTextureDesc.textureCube.height       = desc.textureCube.height;
+            subTextureDesc.textureCube.cubeFaces    = static_cast<unsigned int>(GetInitialTextureLayers(desc));
+            break;
+
+        default:
+            break;
+    }
+
+    return subTextureDesc;
+}
+
+std::shared_future<Texture*> GLRenderSystem::CreateTextureAsync(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
+{
+    /* Create texture storage on the calling thread, where it is initialized if no image data was specified */
+    auto texture = CreateTexture(textureDesc, nullptr);
+
+    if (!imageDesc || IsMultiSampleTexture(textureDesc.type))
+    {
+        std::promise<Texture*> result;
+        result.set_value(texture);
+        return result.get_future().share();
+    }
+
+    /* Upload initial image on the loader thread */
+    const auto subTextureDesc   = GetInitialSubTextureDescriptor(textureDesc);
+    const auto imageDescCopy    = *imageDesc;
+
+    return GetResourceLoader().Submit(
+        [this, texture, subTextureDesc, imageDescCopy]() -> Texture*
+        {
+            WriteTexture(*texture, subTextureDesc, imageDescCopy);
+            return texture;
+        }
+    );
 }
 
 TextureArray* GLRenderSystem::CreateTextureArray(unsigned int numTextures, Texture* const * textureArray)
@@ -93,13 +321,63 @@ TextureArray* GLRenderSystem::CreateTextureArray(unsigned int numTextures, Textu
     return TakeOwnership(textureArrays_, MakeUnique<GLTextureArray>(numTextures, textureArray));
 }
 
+Texture* GLRenderSystem::CreateTextureView(Texture& sharedTexture, const TextureViewDescriptor& textureViewDesc)
+{
+    LLGL_ASSERT_CAP(hasTextureViews);
+
+    auto& sharedTextureGL = LLGL_CAST(const GLTexture&, sharedTexture);
+    if (sharedTextureGL.GetImmutableFormat() == 0)
+        throw std::invalid_argument("cannot create texture view of texture with mutable storage (base texture formats are not supported)");
+
+    return TakeOwnership(textures_, MakeUnique<GLTexture>(sharedTextureGL, textureViewDesc));
+}
+
+Texture* GLRenderSystem::CreateSparseTexture(const TextureDescriptor& textureDesc)
+{
+    LLGL_ASSERT_CAP(hasSparseTextures);
+
+    switch (textureDesc.type)
+    {
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+        case TextureType::Texture3D:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            break;
+        default:
+            throw std::invalid_argument("cannot create sparse texture with 1D or multi-sampled texture type");
+    }
+
+    if (IsBaseTextureFormat(textureDesc.format))
+        throw std::invalid_argument("cannot create sparse texture with base texture format");
+
+    auto texture = MakeUnique<GLTexture>(textureDesc.type);
+
+    /* Bind texture and allocate sparse storage */
+    GLStateManager::active->BindTexture(*texture);
+
+    auto target = GLTypes::Map(textureDesc.type);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    texture->AllocSparseStorage(textureDesc);
+
+    return TakeOwnership(textures_, std::move(texture));
+}
+
 void GLRenderSystem::Release(Texture& texture)
 {
+    FlushPendingDraws();
+
     /* Notify state manager about texture release */
     auto& textureGL = LLGL_CAST(const GLTexture&, texture);
-    GLStateManager::active->NotifyTextureRelease(GLStateManager::GetTextureTarget(textureGL.GetType()), textureGL.GetID());
+    NotifyTextureRelease(GLStateManager::GetTextureTarget(textureGL.GetType()), textureGL.GetID());
+
+    /* Release all cached FBOs the texture is attached to */
+    framebufferCache_.NotifyTextureRelease(textureGL.GetID());
 
     /* Release object */
+    UntrackMemory(texture);
     RemoveFromUniqueSet(textures_, &texture);
 }
 
@@ -111,37 +389,61 @@ void GLRenderSystem::Release(TextureArray& textureArray)
     const auto& texIDs      = textureArrayGL.GetIDArray();
     const auto& texTargets  = textureArrayGL.GetTargetArray();
 
-    //TODO: must be done for ALL state managers!!!
     for (std::size_t i = 0, n = texIDs.size(); i < n; ++i)
-        GLStateManager::active->NotifyTextureRelease(texTargets[i], texIDs[i]);
+        NotifyTextureRelease(texTargets[i], texIDs[i]);
 
     /* Release object */
     RemoveFromUniqueSet(textureArrays_, &textureArray);
 }
 
+// private
+void GLRenderSystem::NotifyTextureRelease(GLTextureTarget target, GLuint texture)
+{
+    /* Each hardware context has its own state manager, so all of them must drop the texture binding */
+    for (const auto& renderContext : renderContexts_)
+        renderContext->GetStateManager()->NotifyTextureRelease(target, texture);
+}
+
 TextureDescriptor GLRenderSystem::QueryTextureDescriptor(const Texture& texture)
 {
-    /* Bind texture */
     auto& textureGL = LLGL_CAST(const GLTexture&, texture);
-    GLStateManager::active->BindTexture(textureGL);
 
     /* Setup texture descriptor */
     TextureDescriptor desc;
 
     desc.type = texture.GetType();
 
-    auto target = GLTypes::Map(texture.GetType());
-
-    /* Query hardware texture format */
     GLint internalFormat = 0;
-    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
-    GLTypes::Unmap(desc.format, static_cast<GLenum>(internalFormat));
-
-    /* Query texture size */
     GLint texSize[3] = { 0 };
-    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_WIDTH,  &texSize[0]);
-    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_HEIGHT, &texSize[1]);
-    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_DEPTH,  &texSize[2]);
+
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Query hardware texture format and size without binding the texture */
+        auto id = textureGL.GetID();
+        glGetTextureLevelParameteriv(id, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+        glGetTextureLevelParameteriv(id, 0, GL_TEXTURE_WIDTH,  &texSize[0]);
+        glGetTextureLevelParameteriv(id, 0, GL_TEXTURE_HEIGHT, &texSize[1]);
+        glGetTextureLevelParameteriv(id, 0, GL_TEXTURE_DEPTH,  &texSize[2]);
+    }
+    else
+    #endif
+    {
+        /* Bind texture */
+        GLStateManager::active->BindTexture(textureGL);
+
+        auto target = GLTypes::Map(texture.GetType());
+
+        /* Query hardware texture format */
+        glGetTexLevelParameteriv(target, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+
+        /* Query texture size */
+        glGetTexLevelParameteriv(target, 0, GL_TEXTURE_WIDTH,  &texSize[0]);
+        glGetTexLevelParameteriv(target, 0, GL_TEXTURE_HEIGHT, &texSize[1]);
+        glGetTexLevelParameteriv(target, 0, GL_TEXTURE_DEPTH,  &texSize[2]);
+    }
+
+    GLTypes::Unmap(desc.format, static_cast<GLenum>(internalFormat));
 
     desc.texture3D.width    = static_cast<unsigned int>(texSize[0]);
     desc.texture3D.height   = static_cast<unsigned int>(texSize[1]);
@@ -155,10 +457,77 @@ TextureDescriptor GLRenderSystem::QueryTextureDescriptor(const Texture& texture)
 
 /* ----- "WriteTexture..." functions ----- */
 
+#ifdef GL_ARB_direct_state_access
+
+// Converts the sub-texture descriptor into a texture region, where array layers and cube faces are mapped onto the Z axis.
+static TextureRegion ToTextureRegion(const TextureType type, const SubTextureDescriptor& desc)
+{
+    TextureRegion region;
+    region.mipLevel = desc.mipLevel;
+
+    switch (type)
+    {
+        case TextureType::Texture1D:
+            region.offset = { desc.texture1D.x, 0, 0 };
+            region.extent = { desc.texture1D.width, 1, 1 };
+            break;
+
+        case TextureType::Texture1DArray:
+            region.offset = { desc.texture1D.x, desc.texture1D.layerOffset, 0 };
+            region.extent = { desc.texture1D.width, desc.texture1D.layers, 1 };
+            break;
+
+        case TextureType::Texture2D:
+            region.offset = { desc.texture2D.x, desc.texture2D.y, 0 };
+            region.extent = { desc.texture2D.width, desc.texture2D.height, 1 };
+            break;
+
+        case TextureType::Texture2DArray:
+            region.offset = { desc.texture2D.x, desc.texture2D.y, desc.texture2D.layerOffset };
+            region.extent = { desc.texture2D.width, desc.texture2D.height, desc.texture2D.layers };
+            break;
+
+        case TextureType::Texture3D:
+            region.offset = { desc.texture3D.x, desc.texture3D.y, desc.texture3D.z };
+            region.extent = { desc.texture3D.width, desc.texture3D.height, desc.texture3D.depth };
+            break;
+
+        case TextureType::TextureCube:
+            /* Write a single cube face (like the bind-to-edit path does) */
+            region.offset = { desc.textureCube.x, desc.textureCube.y, static_cast<unsigned int>(desc.textureCube.cubeFaceOffset) };
+            region.extent = { desc.textureCube.width, desc.textureCube.height, 1 };
+            break;
+
+        case TextureType::TextureCubeArray:
+            region.offset = { desc.textureCube.x, desc.textureCube.y, desc.textureCube.layerOffset * 6 + static_cast<unsigned int>(desc.textureCube.cubeFaceOffset) };
+            region.extent = { desc.textureCube.width, desc.textureCube.height, desc.textureCube.cubeFaces };
+            break;
+
+        default:
+            break;
+    }
+
+    return region;
+}
+
+#endif
+
 void GLRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
 {
-    /* Bind texture and write texture sub data */
+    FlushPendingDraws();
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
+
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Write texture sub data without binding the texture */
+        GLTextureSubImage(textureGL.GetID(), texture.GetType(), ToTextureRegion(texture.GetType(), subTextureDesc), imageDesc);
+        return;
+    }
+    #endif
+
+    /* Bind texture and write texture sub data */
     GLStateManager::active->BindTexture(textureGL);
 
     /* Write data into specific texture type */
@@ -205,34 +574,99 @@ void GLRenderSystem::WriteTexture(Texture& texture, const SubTextureDescriptor&
 void GLRenderSystem::ReadTexture(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType, void* buffer)
 {
     LLGL_ASSERT_PTR(buffer);
+    FlushPendingDraws();
 
     /* Bind texture */
     auto& textureGL = LLGL_CAST(const GLTexture&, texture);
     GLStateManager::active->BindTexture(textureGL);
 
-    /* Read image data from texture */
-    glGetTexImage(
-        GLTypes::Map(textureGL.GetType()),
-        mipLevel,
-        GLTypes::Map(imageFormat),
-        GLTypes::Map(dataType),
-        buffer
-    );
+    if (IsCompressedFormat(imageFormat))
+    {
+        /* Read compressed image data from texture in its hardware format */
+        glGetCompressedTexImage(
+            GLTypes::Map(textureGL.GetType()),
+            mipLevel,
+            buffer
+        );
+    }
+    else
+    {
+        /* Read image data from texture */
+        glGetTexImage(
+            GLTypes::Map(textureGL.GetType()),
+            mipLevel,
+            GLTypes::Map(imageFormat),
+            GLTypes::Map(dataType),
+            buffer
+        );
+    }
 }
 
 void GLRenderSystem::GenerateMips(Texture& texture)
 {
-    /* Bind texture to active layer */
+    FlushPendingDraws();
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
-    GLStateManager::active->BindTexture(textureGL);
 
-    auto target = GLTypes::Map(textureGL.GetType());
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Generate MIP-maps and update minification filter without binding the texture */
+        glGenerateTextureMipmap(textureGL.GetID());
+        glTextureParameteri(textureGL.GetID(), GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+    else
+    #endif
+    {
+        /* Bind texture to active layer */
+        GLStateManager::active->BindTexture(textureGL);
+
+        auto target = GLTypes::Map(textureGL.GetType());
+
+        /* Generate MIP-maps */
+        glGenerateMipmap(target);
+
+        /* Update texture minification filter to a default value */
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+}
+
+std::uint64_t GLRenderSystem::GetBindlessTextureHandle(Texture& texture, Sampler* sampler)
+{
+    LLGL_ASSERT_CAP(hasBindlessTextures);
 
-    /* Generate MIP-maps */
-    glGenerateMipmap(target);
+    auto& textureGL = LLGL_CAST(GLTexture&, texture);
+    auto samplerGL = (sampler != nullptr ? LLGL_CAST(GLSampler*, sampler) : nullptr);
 
-    /* Update texture minification filter to a default value */
-    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    return static_cast<std::uint64_t>(textureGL.GetBindlessHandle(samplerGL));
+}
+
+static const SparsePageTable& GetSparsePageTable(const GLTexture& textureGL)
+{
+    if (auto pageTable = textureGL.GetSparsePageTable())
+        return *pageTable;
+    throw std::invalid_argument("texture was not created as sparse texture");
+}
+
+void GLRenderSystem::CommitSparseTexture(Texture& texture, const TextureRegion& region, bool commit)
+{
+    auto& textureGL = LLGL_CAST(GLTexture&, texture);
+    GetSparsePageTable(textureGL);
+
+    GLStateManager::active->BindTexture(textureGL);
+    textureGL.CommitSparseRegion(region, commit);
+}
+
+bool GLRenderSystem::IsSparseTextureResident(const Texture& texture, const TextureRegion& region)
+{
+    auto& textureGL = LLGL_CAST(const GLTexture&, texture);
+    return GetSparsePageTable(textureGL).IsResident(region);
+}
+
+Gs::Vector3ui GLRenderSystem::QuerySparseTexturePageSize(const Texture& texture)
+{
+    auto& textureGL = LLGL_CAST(const GLTexture&, texture);
+    return GetSparsePageTable(textureGL).GetPageSize();
 }
 
 
@@ -0,0 +1,57 @@
+/*
+ * GLResourceLoader.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLResourceLoader.h"
+
+
+namespace LLGL
+{
+
+
+GLResourceLoader::GLResourceLoader(GLRenderContext& sharedRenderContext)
+{
+    /* Create loader context on the calling thread, then move it to the worker thread */
+    context_ = sharedRenderContext.CreateSharedContext(desc_, surface_);
+
+    worker_.Submit(
+        [this]()
+        {
+            /* Activate loader context, which has its own state manager, for the worker thread */
+            GLContext::MakeCurrent(context_.get());
+            GLStateManager::active->DetermineExtensions();
+
+            /* Use byte-alignment for pixel storage like the render contexts */
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        }
+    );
+}
+
+GLResourceLoader::~GLResourceLoader()
+{
+    /* Deactivate loader context on the worker thread, so it can be deleted on this thread */
+    worker_.Submit([]() { GLContext::MakeCurrent(nullptr); });
+    worker_.WaitIdle();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLResourceLoader::WaitForCommands()
+{
+    GLFence fence;
+    fence.Signal();
+    fence.Wait(~0ull);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
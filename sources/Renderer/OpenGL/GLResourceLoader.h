@@ -0,0 +1,84 @@
+/*
+ * GLResourceLoader.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_RESOURCE_LOADER_H
+#define LLGL_GL_RESOURCE_LOADER_H
+
+
+#include "GLRenderContext.h"
+#include "RenderState/GLFence.h"
+#include "../../Core/ThreadPool.h"
+#include <memory>
+#include <future>
+
+
+namespace LLGL
+{
+
+
+/*
+Background loader for GL resources. Upload tasks run on a single worker thread with its own GL context,
+which shares its objects with the render contexts, and its own state manager (see GLStateManager::active).
+*/
+class GLResourceLoader
+{
+
+    public:
+
+        GLResourceLoader(const GLResourceLoader&) = delete;
+        GLResourceLoader& operator = (const GLResourceLoader&) = delete;
+
+        // Creates the loader context for the specified render context. This must be called on the thread of the render context.
+        GLResourceLoader(GLRenderContext& sharedRenderContext);
+
+        // Waits until all tasks have been done and releases the loader context.
+        ~GLResourceLoader();
+
+        /*
+        Submits the specified upload task to the loader thread. The task starts after the GPU has finished all commands
+        the calling thread has submitted so far (e.g. to create the resource storage), and the returned future
+        is only ready after the GPU has finished the commands of the task, so the resource can be used by any context.
+        */
+        template <typename Task>
+        auto Submit(Task&& task) -> std::shared_future<decltype(task())>
+        {
+            /* Synchronize with the commands of the calling thread */
+            auto fence = std::make_shared<GLFence>();
+            fence->Signal();
+
+            return worker_.Submit(
+                [fence, task]()
+                {
+                    fence->Wait(~0ull);
+                    auto result = task();
+                    WaitForCommands();
+                    return result;
+                }
+            );
+        }
+
+    private:
+
+        // Blocks the loader thread until the GPU has finished all commands of the loader context.
+        static void WaitForCommands();
+
+        RenderContextDescriptor     desc_;
+        std::shared_ptr<Surface>    surface_;
+        std::unique_ptr<GLContext>  context_;
+        ThreadPool                  worker_     { 1 };
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -12,14 +12,12 @@ namespace LLGL
 {
 
 
-static GLContext* g_activeGLContext = nullptr;
+// Active GL context of the calling thread (a GL context can only be current on one thread at a time)
+static thread_local GLContext* g_activeGLContext = nullptr;
 
-GLContext::GLContext(GLContext* sharedContext)
+GLContext::GLContext() :
+    stateMngr_ { std::make_shared<GLStateManager>() }
 {
-    if (sharedContext)
-        stateMngr_ = sharedContext->stateMngr_;
-    else
-        stateMngr_ = std::make_shared<GLStateManager>();
 }
 
 GLContext::~GLContext()
@@ -58,6 +56,37 @@ GLContext* GLContext::Active()
     return g_activeGLContext;
 }
 
+bool GLContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    return false; // dummy
+}
+
+bool GLContext::WaitForVerticalBlank()
+{
+    return false; // dummy
+}
+
+
+/*
+ * ======= Protected: =======
+ */
+
+void GLContext::ShareStateManager(const GLContext& sharedContext)
+{
+    /* Use the same state manager, since the GL states belong to the hardware context */
+    stateMngr_ = sharedContext.stateMngr_;
+    GLStateManager::active = stateMngr_.get();
+}
+
+bool GLContext::IsNoErrorContext(const ProfileOpenGLDescriptor& profileDesc)
+{
+    #ifdef LLGL_DEBUG
+    return false;
+    #else
+    return profileDesc.noErrorContext;
+    #endif
+}
+
 
 } // /namespace LLGL
 
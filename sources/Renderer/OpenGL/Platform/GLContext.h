@@ -27,8 +27,11 @@ class GLContext
 
         virtual ~GLContext();
 
-        // Creates a platform specific GLContext instance.
-        static std::unique_ptr<GLContext> Create(RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext);
+        /*
+        Creates a platform specific GLContext instance. If 'ownHardwareContext' is true, a new hardware context is created
+        even if a shared context is specified (Win32 otherwise reuses the hardware context of the shared context).
+        */
+        static std::unique_ptr<GLContext> Create(RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext, bool ownHardwareContext = false);
 
         // Makes the specified GLContext current. If null, the current context will be deactivated.
         static bool MakeCurrent(GLContext* context);
@@ -36,15 +39,22 @@ class GLContext
         // Returns the active GLContext instance.
         static GLContext* Active();
 
-        // Sets the swap interval for vsync (Win32: wglSwapIntervalEXT, X11: glXSwapIntervalSGI).
+        // Sets the swap interval for vsync (Win32: wglSwapIntervalEXT, X11: glXSwapIntervalSGI). A negative interval enables late swap tearing if supported.
         virtual bool SetSwapInterval(int interval) = 0;
 
+        // Queries the presentation statistics (Win32: wglGetSyncValuesOML, X11: glXGetSyncValuesOML).
+        virtual bool QueryFrameStatistics(FrameStatistics& stats);
+
+        // Blocks until the next vertical blank (Win32: wglWaitForMscOML, X11: glXWaitForMscOML).
+        virtual bool WaitForVerticalBlank();
+
         // Swaps the back buffer with the front buffer (Win32: ::SwapBuffers, X11: glXSwapBuffers).
         virtual bool SwapBuffers() = 0;
 
         // Resizes the GL context. This is called after the context surface has been resized.
         virtual void Resize(const Size& resolution) = 0;
 
+        // Returns the state manager of this context. Only contexts that share the same hardware context share their state manager.
         inline const std::shared_ptr<GLStateManager>& GetStateManager() const
         {
             return stateMngr_;
@@ -52,7 +62,13 @@ class GLContext
 
     protected:
 
-        GLContext(GLContext* sharedContext);
+        GLContext();
+
+        // Shares the state manager with the specified context. This must only be used if both contexts use the same hardware context (Win32).
+        void ShareStateManager(const GLContext& sharedContext);
+
+        // Returns true if the context is to be created without error checking (GL_KHR_no_error). This is always false in debug builds.
+        static bool IsNoErrorContext(const ProfileOpenGLDescriptor& profileDesc);
 
         // Activates or deactivates this GLContext (Win32: wglMakeCurrent, X11: glXMakeCurrent).
         virtual bool Activate(bool activate) = 0;
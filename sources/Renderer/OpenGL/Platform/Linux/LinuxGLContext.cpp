@@ -6,12 +6,16 @@
  */
 
 #include "LinuxGLContext.h"
+#include "LinuxGLHeadlessContext.h"
+#include "LinuxGLWaylandContext.h"
+#include "../../../../Platform/Linux/WaylandWindow.h"
 #include "../../Ext/GLExtensions.h"
 #include "../../Ext/GLExtensionLoader.h"
 #include "../../../CheckedCast.h"
 #include "../../../../Core/Helper.h"
-#include <LLGL/Log.h>
+#include "../../../../Core/HelperMacros.h"
 #include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
@@ -26,6 +30,10 @@ namespace LLGL
 #define GLX_CONTEXT_MINOR_VERSION_ARB 0x2092
 #endif
 
+#ifndef GLX_CONTEXT_OPENGL_NO_ERROR_ARB
+#define GLX_CONTEXT_OPENGL_NO_ERROR_ARB 0x31B3
+#endif
+
 typedef GLXContext (*GXLCREATECONTEXTATTRIBARBPROC)(Display*, GLXFBConfig, GLXContext, Bool, const int*);
 
 
@@ -33,9 +41,42 @@ typedef GLXContext (*GXLCREATECONTEXTATTRIBARBPROC)(Display*, GLXFBConfig, GLXCo
  * GLContext class
  */
 
-std::unique_ptr<GLContext> GLContext::Create(RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext)
+std::unique_ptr<GLContext> GLContext::Create(RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext, bool /*ownHardwareContext*/)
 {
-    LinuxGLContext* sharedContextGLX = (sharedContext != nullptr ? LLGL_CAST(LinuxGLContext*, sharedContext) : nullptr);
+    if (desc.headless)
+    {
+        #ifdef LLGL_GL_ENABLE_EGL
+
+        auto sharedContextEGL = (sharedContext != nullptr ? dynamic_cast<LinuxGLHeadlessContext*>(sharedContext) : nullptr);
+        if (sharedContext != nullptr && sharedContextEGL == nullptr)
+            throw std::invalid_argument("cannot share OpenGL context between headless and non-headless render contexts");
+
+        return MakeUnique<LinuxGLHeadlessContext>(desc, sharedContextEGL);
+
+        #else
+
+        throw std::runtime_error("headless OpenGL render contexts require EGL, but LLGL has been built without EGL support");
+
+        #endif
+    }
+
+    #if defined LLGL_GL_ENABLE_EGL && defined LLGL_ENABLE_WAYLAND
+
+    if (auto waylandWindow = dynamic_cast<WaylandWindow*>(&surface))
+    {
+        auto sharedContextWL = (sharedContext != nullptr ? dynamic_cast<LinuxGLWaylandContext*>(sharedContext) : nullptr);
+        if (sharedContext != nullptr && sharedContextWL == nullptr)
+            throw std::invalid_argument("cannot share OpenGL context between Wayland and non-Wayland render contexts");
+
+        return MakeUnique<LinuxGLWaylandContext>(desc, *waylandWindow, sharedContextWL);
+    }
+
+    #endif
+
+    auto sharedContextGLX = (sharedContext != nullptr ? dynamic_cast<LinuxGLContext*>(sharedContext) : nullptr);
+    if (sharedContext != nullptr && sharedContextGLX == nullptr)
+        throw std::invalid_argument("cannot share OpenGL context between headless and non-headless render contexts");
+
     return MakeUnique<LinuxGLContext>(desc, surface, sharedContextGLX);
 }
 
@@ -44,8 +85,7 @@ std::unique_ptr<GLContext> GLContext::Create(RenderContextDescriptor& desc, Surf
  * LinuxGLContext class
  */
 
-LinuxGLContext::LinuxGLContext(RenderContextDescriptor& desc, Surface& surface, LinuxGLContext* sharedContext) :
-    GLContext { sharedContext }
+LinuxGLContext::LinuxGLContext(RenderContextDescriptor& desc, Surface& surface, LinuxGLContext* sharedContext)
 {
     NativeHandle nativeHandle;
     surface.GetNativeHandle(&nativeHandle);
@@ -54,9 +94,19 @@ LinuxGLContext::LinuxGLContext(RenderContextDescriptor& desc, Surface& surface,
     {
         auto sharedContextGLX = LLGL_CAST(LinuxGLContext*, sharedContext);
         CreateContext(desc, nativeHandle, sharedContextGLX);
+
+        /* Take the state of the optional GLX extensions from the shared context, since they are the same for all contexts on the same device */
+        hasSwapControlTear_ = sharedContextGLX->hasSwapControlTear_;
+        hasSyncControl_     = sharedContextGLX->hasSyncControl_;
     }
     else
+    {
         CreateContext(desc, nativeHandle, nullptr);
+
+        /* Load optional GLX extensions for frame pacing */
+        hasSwapControlTear_ = LoadSwapControlTearProcs();
+        hasSyncControl_     = LoadSyncControlProcs();
+    }
 }
 
 LinuxGLContext::~LinuxGLContext()
@@ -66,6 +116,18 @@ LinuxGLContext::~LinuxGLContext()
 
 bool LinuxGLContext::SetSwapInterval(int interval)
 {
+    /*
+    Prefer "glXSwapIntervalEXT", which also accepts an interval of 0 to present without Vsync (see RenderContext::PresentWithoutVsync).
+    Late swap tearing is requested with a negative interval, which requires "GLX_EXT_swap_control_tear".
+    */
+    if (hasSwapControlTear_)
+    {
+        glXSwapIntervalEXT(display_, wnd_, interval);
+        return true;
+    }
+    if (interval < 0)
+        interval = -interval;
+
     /* Load GL extension "glXSwapIntervalSGI" to set v-sync interval */
     if (glXSwapIntervalSGI || LoadSwapIntervalProcs())
         return (glXSwapIntervalSGI(interval) == 0);
@@ -84,6 +146,27 @@ void LinuxGLContext::Resize(const Size& resolution)
     //TODO...
 }
 
+bool LinuxGLContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    int64_t ust = 0, msc = 0, sbc = 0;
+    if (hasSyncControl_ && glXGetSyncValuesOML(display_, wnd_, &ust, &msc, &sbc))
+    {
+        /* UST (unadjusted system time) is specified in microseconds */
+        stats.presentCount      = static_cast<std::uint64_t>(sbc);
+        stats.syncRefreshCount  = static_cast<std::uint64_t>(msc);
+        stats.syncTime          = static_cast<std::uint64_t>(ust);
+        return true;
+    }
+    return false;
+}
+
+bool LinuxGLContext::WaitForVerticalBlank()
+{
+    /* Wait until the MSC (media stream counter) is incremented the next time */
+    int64_t ust = 0, msc = 0, sbc = 0;
+    return (hasSyncControl_ && glXWaitForMscOML(display_, wnd_, 0, 1, 0, &ust, &msc, &sbc));
+}
+
 
 /*
  * ======= Private: =======
@@ -94,7 +177,7 @@ bool LinuxGLContext::Activate(bool activate)
     if (activate)
         return glXMakeCurrent(display_, wnd_, glc_);
     else
-        return glXMakeCurrent(nullptr, 0, 0);
+        return glXMakeCurrent(display_, None, nullptr);
 }
 
 void LinuxGLContext::CreateContext(const RenderContextDescriptor& contextDesc, const NativeHandle& nativeHandle, LinuxGLContext* sharedContext)
@@ -117,7 +200,7 @@ void LinuxGLContext::CreateContext(const RenderContextDescriptor& contextDesc, c
         /* Create core profile */
         int major = GetMajorVersion(profileDesc.version);
         int minor = GetMinorVersion(profileDesc.version);
-        glc_ = CreateContextCoreProfile(glcShared, major, minor);
+        glc_ = CreateContextCoreProfile(glcShared, major, minor, IsNoErrorContext(profileDesc));
     }
     
     if (!glc_)
@@ -128,7 +211,7 @@ void LinuxGLContext::CreateContext(const RenderContextDescriptor& contextDesc, c
     
     /* Make new OpenGL context current */
     if (glXMakeCurrent(display_, wnd_, glc_) != True)
-        Log::StdErr() << "failed to make OpenGL render context current (glXMakeCurrent)" << std::endl;
+        LLGL_LOG(Error, "failed to make OpenGL render context current (glXMakeCurrent)");
 }
 
 void LinuxGLContext::DeleteContext()
@@ -136,11 +219,37 @@ void LinuxGLContext::DeleteContext()
     glXDestroyContext(display_, glc_);
 }
 
-GLXContext LinuxGLContext::CreateContextCoreProfile(GLXContext glcShared, int major, int minor)
+// Returns true if the specified space separated list of GLX extensions contains the specified name.
+static bool HasGLXExtension(const char* extensions, const char* name)
+{
+    if (!extensions)
+        return false;
+
+    const auto nameLen = std::strlen(name);
+
+    for (auto s = std::strstr(extensions, name); s != nullptr; s = std::strstr(s + nameLen, name))
+    {
+        /* Extension names are separated by spaces */
+        if ((s == extensions || s[-1] == ' ') && (s[nameLen] == ' ' || s[nameLen] == '\0'))
+            return true;
+    }
+
+    return false;
+}
+
+// Returns the GLX extension procedure to create a core profile; it is loaded only once, since GLX procedures do not depend on the current context.
+static GXLCREATECONTEXTATTRIBARBPROC GetCreateContextAttribsProc()
+{
+    static const auto proc = reinterpret_cast<GXLCREATECONTEXTATTRIBARBPROC>(
+        glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glXCreateContextAttribsARB"))
+    );
+    return proc;
+}
+
+GLXContext LinuxGLContext::CreateContextCoreProfile(GLXContext glcShared, int major, int minor, bool noError)
 {
     /* Load GL extension to create core profile */
-    GXLCREATECONTEXTATTRIBARBPROC glXCreateContextAttribsARB = nullptr;
-    glXCreateContextAttribsARB = (GXLCREATECONTEXTATTRIBARBPROC)glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glXCreateContextAttribsARB"));
+    auto glXCreateContextAttribsARB = GetCreateContextAttribsProc();
 
     if (glXCreateContextAttribsARB != nullptr)
     {
@@ -179,10 +288,18 @@ GLXContext LinuxGLContext::CreateContextCoreProfile(GLXContext glcShared, int ma
                 GLX_CONTEXT_MINOR_VERSION_ARB, minor,
                 GLX_CONTEXT_PROFILE_MASK_ARB,  GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
                 //GLX_CONTEXT_FLAGS_ARB      , GLX_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB,
+                None,                          None,
                 None
             };
+
+            /* Disable error checking of the driver (only if supported, since unknown attributes let the context creation fail) */
+            if (noError && HasGLXExtension(glXQueryExtensionsString(display_, screen), "GLX_ARB_create_context_no_error"))
+            {
+                contextAttribs[6] = GLX_CONTEXT_OPENGL_NO_ERROR_ARB;
+                contextAttribs[7] = True;
+            }
             
-            auto glc = glXCreateContextAttribsARB(display_, fbcList[0], nullptr, True, contextAttribs);
+            auto glc = glXCreateContextAttribsARB(display_, fbcList[0], glcShared, True, contextAttribs);
             
             XFree(fbcList);
             
@@ -191,7 +308,7 @@ GLXContext LinuxGLContext::CreateContextCoreProfile(GLXContext glcShared, int ma
     }
     
     /* Context creation failed */
-    Log::StdErr() << "failed to create OpenGL core profile" << std::endl;
+    LLGL_LOG(Error, "failed to create OpenGL core profile");
     
     return nullptr;
 }
@@ -31,6 +31,9 @@ class LinuxGLContext : public GLContext
         bool SwapBuffers() override;
         void Resize(const Size& resolution) override;
 
+        bool QueryFrameStatistics(FrameStatistics& stats) override;
+        bool WaitForVerticalBlank() override;
+
     private:
 
         bool Activate(bool activate) override;
@@ -38,7 +41,7 @@ class LinuxGLContext : public GLContext
         void CreateContext(const RenderContextDescriptor& contextDesc, const NativeHandle& nativeHandle, LinuxGLContext* sharedContext);
         void DeleteContext();
         
-        GLXContext CreateContextCoreProfile(GLXContext glcShared, int major, int minor);
+        GLXContext CreateContextCoreProfile(GLXContext glcShared, int major, int minor, bool noError);
         GLXContext CreateContextCompatibilityProfile(GLXContext glcShared);
 
         ::Display*      display_    = nullptr;
@@ -46,6 +49,9 @@ class LinuxGLContext : public GLContext
         XVisualInfo*    visual_     = nullptr;
         GLXContext      glc_        = nullptr;
 
+        bool            hasSwapControlTear_ = false;
+        bool            hasSyncControl_     = false;
+
 };
 
 
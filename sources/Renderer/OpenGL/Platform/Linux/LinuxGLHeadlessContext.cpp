@@ -0,0 +1,270 @@
+/*
+ * LinuxGLHeadlessContext.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_GL_ENABLE_EGL
+
+
+#include "LinuxGLHeadlessContext.h"
+#include "../../../../Core/HelperMacros.h"
+#include <EGL/eglext.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+
+#ifndef EGL_CONTEXT_OPENGL_NO_ERROR_KHR
+#define EGL_CONTEXT_OPENGL_NO_ERROR_KHR 0x31B3
+#endif
+
+
+namespace LLGL
+{
+
+
+LinuxGLHeadlessContext::LinuxGLHeadlessContext(const RenderContextDescriptor& desc, LinuxGLHeadlessContext* sharedContext)
+{
+    CreateContext(desc, sharedContext);
+}
+
+LinuxGLHeadlessContext::~LinuxGLHeadlessContext()
+{
+    DeleteContext();
+}
+
+bool LinuxGLHeadlessContext::SetSwapInterval(int interval)
+{
+    /* Swap interval has no effect on pbuffer surfaces */
+    return true;
+}
+
+bool LinuxGLHeadlessContext::SwapBuffers()
+{
+    /* Pbuffer surfaces have no front buffer, so only submit the pending commands */
+    glFlush();
+    return true;
+}
+
+void LinuxGLHeadlessContext::Resize(const Size& resolution)
+{
+    /* Re-create pbuffer surface with the new resolution */
+    bool isCurrent = (eglGetCurrentContext() == eglc_);
+
+    if (isCurrent)
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    eglDestroySurface(display_, pbuffer_);
+    CreatePbuffer(resolution);
+
+    if (isCurrent)
+        eglMakeCurrent(display_, pbuffer_, pbuffer_, eglc_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool LinuxGLHeadlessContext::Activate(bool activate)
+{
+    if (activate)
+        return (eglMakeCurrent(display_, pbuffer_, pbuffer_, eglc_) == EGL_TRUE);
+    else
+        return (eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE);
+}
+
+void LinuxGLHeadlessContext::CreateContext(const RenderContextDescriptor& contextDesc, LinuxGLHeadlessContext* sharedContext)
+{
+    EGLContext eglcShared = (sharedContext != nullptr ? sharedContext->eglc_ : EGL_NO_CONTEXT);
+
+    /* Get EGL display (shared contexts must use the same display) */
+    if (sharedContext)
+        display_ = sharedContext->display_;
+    else
+    {
+        display_ = GetHeadlessDisplay();
+
+        if (display_ == EGL_NO_DISPLAY)
+            throw std::runtime_error("failed to get EGL display for headless OpenGL context");
+
+        if (eglInitialize(display_, nullptr, nullptr) != EGL_TRUE)
+            throw std::runtime_error("failed to initialize EGL display for headless OpenGL context");
+    }
+
+    if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+        throw std::runtime_error("failed to bind OpenGL API for EGL");
+
+    /* Choose frame buffer configuration for pbuffer surfaces */
+    const EGLint samples = (contextDesc.multiSampling.enabled ? static_cast<EGLint>(std::max(1u, contextDesc.multiSampling.samples)) : 0);
+
+    const EGLint configAttribs[] =
+    {
+        EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         8,
+        EGL_DEPTH_SIZE,         24,
+        EGL_STENCIL_SIZE,       8,
+        EGL_SAMPLE_BUFFERS,     (samples > 1 ? 1 : 0),
+        EGL_SAMPLES,            (samples > 1 ? samples : 0),
+        EGL_NONE
+    };
+
+    EGLint numConfigs = 0;
+    if (eglChooseConfig(display_, configAttribs, &config_, 1, &numConfigs) != EGL_TRUE || numConfigs == 0)
+        throw std::runtime_error("failed to choose EGL configuration for headless OpenGL context");
+
+    /* Create OpenGL context with EGL */
+    const auto& profileDesc = contextDesc.profileOpenGL;
+
+    if (profileDesc.extProfile && profileDesc.coreProfile)
+    {
+        /* Create core profile */
+        int major = GetMajorVersion(profileDesc.version);
+        int minor = GetMinorVersion(profileDesc.version);
+        eglc_ = CreateContextCoreProfile(eglcShared, major, minor, IsNoErrorContext(profileDesc));
+    }
+
+    if (eglc_ == EGL_NO_CONTEXT)
+    {
+        /* Create compatibility profile */
+        eglc_ = CreateContextCompatibilityProfile(eglcShared);
+    }
+
+    if (eglc_ == EGL_NO_CONTEXT)
+        throw std::runtime_error("failed to create headless OpenGL context with EGL");
+
+    /* Create pbuffer surface as default framebuffer */
+    CreatePbuffer(contextDesc.videoMode.resolution);
+
+    /* Make new OpenGL context current */
+    if (eglMakeCurrent(display_, pbuffer_, pbuffer_, eglc_) != EGL_TRUE)
+        LLGL_LOG(Error, "failed to make OpenGL render context current (eglMakeCurrent)");
+}
+
+void LinuxGLHeadlessContext::CreatePbuffer(const Size& resolution)
+{
+    const EGLint pbufferAttribs[] =
+    {
+        EGL_WIDTH,  std::max(1, resolution.x),
+        EGL_HEIGHT, std::max(1, resolution.y),
+        EGL_NONE
+    };
+
+    pbuffer_ = eglCreatePbufferSurface(display_, config_, pbufferAttribs);
+
+    if (pbuffer_ == EGL_NO_SURFACE)
+        throw std::runtime_error("failed to create EGL pbuffer surface for headless OpenGL context");
+}
+
+void LinuxGLHeadlessContext::DeleteContext()
+{
+    /*
+    The EGL display is not terminated here, since it is shared between all headless contexts
+    and terminating it would invalidate the contexts that are still alive
+    */
+    eglDestroyContext(display_, eglc_);
+    eglDestroySurface(display_, pbuffer_);
+}
+
+bool HasEGLExtension(const char* extensions, const char* name)
+{
+    if (!extensions)
+        return false;
+
+    const auto nameLen = std::strlen(name);
+
+    for (auto s = std::strstr(extensions, name); s != nullptr; s = std::strstr(s + nameLen, name))
+    {
+        /* Extension names are separated by spaces */
+        if ((s == extensions || s[-1] == ' ') && (s[nameLen] == ' ' || s[nameLen] == '\0'))
+            return true;
+    }
+
+    return false;
+}
+
+EGLContext LinuxGLHeadlessContext::CreateContextCoreProfile(EGLContext eglcShared, int major, int minor, bool noError)
+{
+    EGLint contextAttribs[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION_KHR,          major,
+        EGL_CONTEXT_MINOR_VERSION_KHR,          minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_NONE,                               EGL_FALSE,
+        EGL_NONE
+    };
+
+    /* Disable error checking of the driver (only if supported, since unknown attributes let the context creation fail) */
+    if (noError && HasEGLExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_create_context_no_error"))
+    {
+        contextAttribs[6] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+        contextAttribs[7] = EGL_TRUE;
+    }
+
+    auto eglc = eglCreateContext(display_, config_, eglcShared, contextAttribs);
+
+    /* Context creation failed */
+    if (eglc == EGL_NO_CONTEXT)
+        LLGL_LOG(Error, "failed to create OpenGL core profile");
+
+    return eglc;
+}
+
+EGLContext LinuxGLHeadlessContext::CreateContextCompatibilityProfile(EGLContext eglcShared)
+{
+    return eglCreateContext(display_, config_, eglcShared, nullptr);
+}
+
+/*
+Returns an EGL display that does not require an X server. The first device of 'EGL_EXT_platform_device'
+is preferred (e.g. for proprietary drivers), then the surfaceless platform of Mesa, and finally the default display.
+*/
+EGLDisplay LinuxGLHeadlessContext::GetHeadlessDisplay()
+{
+    auto clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    auto eglGetPlatformDisplayEXT = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+    if (eglGetPlatformDisplayEXT != nullptr)
+    {
+        if (HasEGLExtension(clientExtensions, "EGL_EXT_platform_device"))
+        {
+            auto eglQueryDevicesEXT = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+
+            EGLDeviceEXT device = nullptr;
+            EGLint numDevices = 0;
+
+            if (eglQueryDevicesEXT != nullptr && eglQueryDevicesEXT(1, &device, &numDevices) == EGL_TRUE && numDevices > 0)
+            {
+                auto display = eglGetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+                if (display != EGL_NO_DISPLAY)
+                    return display;
+            }
+        }
+
+        if (HasEGLExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+        {
+            auto display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY)
+                return display;
+        }
+    }
+
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_GL_ENABLE_EGL
+
+
+
+// ================================================================================
@@ -0,0 +1,71 @@
+/*
+ * LinuxGLHeadlessContext.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_LINUX_GL_HEADLESS_CONTEXT_H
+#define LLGL_LINUX_GL_HEADLESS_CONTEXT_H
+
+
+#ifdef LLGL_GL_ENABLE_EGL
+
+
+#include "../GLContext.h"
+#include "../../OpenGL.h"
+#include <EGL/egl.h>
+
+
+namespace LLGL
+{
+
+
+// OpenGL context without X11 window, which renders into an EGL pbuffer surface.
+class LinuxGLHeadlessContext : public GLContext
+{
+
+    public:
+
+        LinuxGLHeadlessContext(const RenderContextDescriptor& desc, LinuxGLHeadlessContext* sharedContext);
+        ~LinuxGLHeadlessContext();
+
+        bool SetSwapInterval(int interval) override;
+        bool SwapBuffers() override;
+        void Resize(const Size& resolution) override;
+
+    private:
+
+        bool Activate(bool activate) override;
+
+        void CreateContext(const RenderContextDescriptor& contextDesc, LinuxGLHeadlessContext* sharedContext);
+        void CreatePbuffer(const Size& resolution);
+        void DeleteContext();
+
+        EGLContext CreateContextCoreProfile(EGLContext eglcShared, int major, int minor, bool noError);
+        EGLContext CreateContextCompatibilityProfile(EGLContext eglcShared);
+
+        static EGLDisplay GetHeadlessDisplay();
+
+        EGLDisplay  display_    = EGL_NO_DISPLAY;
+        EGLConfig   config_     = nullptr;
+        EGLSurface  pbuffer_    = EGL_NO_SURFACE;
+        EGLContext  eglc_       = EGL_NO_CONTEXT;
+
+};
+
+// Returns true if the specified space separated list of EGL extensions contains the specified name.
+bool HasEGLExtension(const char* extensions, const char* name);
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_GL_ENABLE_EGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -10,7 +10,7 @@
 #include "../../Ext/GLExtensionLoader.h"
 #include "../../../../Platform/Linux/LinuxWindow.h"
 #include <LLGL/Platform/NativeHandle.h>
-#include <LLGL/Log.h>
+#include "../../../../Core/HelperMacros.h"
 
 
 namespace LLGL
@@ -21,7 +21,20 @@ namespace LLGL
  * ======= Private: =======
  */
 
-void GLRenderContext::GetNativeContextHandle(NativeContextHandle& windowContext)
+// Returns the visual with the specified ID, or null if there is no such visual on the specified screen.
+static XVisualInfo* GetVisualInfoByID(::Display* display, int screen, VisualID visualID)
+{
+    /* Visuals are part of the connection setup data, so this does not require a round trip to the X server */
+    XVisualInfo visualTemplate;
+    {
+        visualTemplate.visualid = visualID;
+        visualTemplate.screen   = screen;
+    }
+    int numVisuals = 0;
+    return XGetVisualInfo(display, VisualIDMask | VisualScreenMask, &visualTemplate, &numVisuals);
+}
+
+void GLRenderContext::GetNativeContextHandle(NativeContextHandle& windowContext, const GLRenderContext* sharedRenderContext)
 {
     /* Open X11 display */
     windowContext.display = XOpenDisplay(nullptr);
@@ -30,7 +43,31 @@ void GLRenderContext::GetNativeContextHandle(NativeContextHandle& windowContext)
 
     windowContext.parentWindow  = DefaultRootWindow(windowContext.display);
     windowContext.screen        = DefaultScreen(windowContext.display);
-    
+    windowContext.visual        = nullptr;
+
+    /* Reuse the visual of the shared render context, which avoids enumerating the GLX frame buffer configurations on each new display connection */
+    if (sharedRenderContext != nullptr &&
+        sharedRenderContext->visualID_ != 0 &&
+        sharedRenderContext->desc_.multiSampling.enabled == desc_.multiSampling.enabled &&
+        sharedRenderContext->desc_.multiSampling.samples == desc_.multiSampling.samples)
+    {
+        windowContext.visual = GetVisualInfoByID(windowContext.display, windowContext.screen, sharedRenderContext->visualID_);
+    }
+
+    if (!windowContext.visual)
+        ChooseVisual(windowContext);
+
+    if (!windowContext.visual)
+        throw std::runtime_error("failed to choose X11 visual for OpenGL");
+
+    visualID_ = windowContext.visual->visualid;
+
+    /* Create Colormap structure */
+    windowContext.colorMap = XCreateColormap(windowContext.display, windowContext.parentWindow, windowContext.visual->visual, AllocNone);
+}
+
+void GLRenderContext::ChooseVisual(NativeContextHandle& windowContext)
+{
     GLXFBConfig fbc = 0;
     
     if (desc_.multiSampling.enabled)
@@ -76,7 +113,7 @@ void GLRenderContext::GetNativeContextHandle(NativeContextHandle& windowContext)
     else
     {
         if (desc_.multiSampling.enabled)
-            Log::StdErr() << "failed to choose XVisualInfo for multi-sampling" << std::endl;
+            LLGL_LOG(Error, "failed to choose XVisualInfo for multi-sampling");
         
         /* Choose standard XVisualInfo structure */
         int visualAttribs[] =
@@ -89,12 +126,6 @@ void GLRenderContext::GetNativeContextHandle(NativeContextHandle& windowContext)
 
         windowContext.visual = glXChooseVisual(windowContext.display, windowContext.screen, visualAttribs);
     }
-    
-    /* Create Colormap structure */
-    windowContext.colorMap = XCreateColormap(windowContext.display, windowContext.parentWindow, windowContext.visual->visual, AllocNone);
-    
-    if (!windowContext.visual)
-        throw std::runtime_error("failed to choose X11 visual for OpenGL");
 }
 
 
@@ -0,0 +1,225 @@
+/*
+ * LinuxGLWaylandContext.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#if defined LLGL_GL_ENABLE_EGL && defined LLGL_ENABLE_WAYLAND
+
+
+#include "LinuxGLWaylandContext.h"
+#include "LinuxGLHeadlessContext.h"
+#include "../../../../Platform/Linux/WaylandWindow.h"
+#include "../../../../Core/HelperMacros.h"
+#include <LLGL/Platform/NativeHandle.h>
+#include <wayland-egl.h>
+#include <EGL/eglext.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+#ifndef EGL_CONTEXT_OPENGL_NO_ERROR_KHR
+#define EGL_CONTEXT_OPENGL_NO_ERROR_KHR 0x31B3
+#endif
+
+#ifndef EGL_PLATFORM_WAYLAND_KHR
+#define EGL_PLATFORM_WAYLAND_KHR 0x31D8
+#endif
+
+
+namespace LLGL
+{
+
+
+LinuxGLWaylandContext::LinuxGLWaylandContext(const RenderContextDescriptor& desc, WaylandWindow& window, LinuxGLWaylandContext* sharedContext) :
+    window_ { window }
+{
+    CreateContext(desc, sharedContext);
+}
+
+LinuxGLWaylandContext::~LinuxGLWaylandContext()
+{
+    DeleteContext();
+}
+
+bool LinuxGLWaylandContext::SetSwapInterval(int interval)
+{
+    /* Late swap tearing is not supported by EGL, so a negative interval is treated like a positive one */
+    return (eglSwapInterval(display_, std::abs(interval)) == EGL_TRUE);
+}
+
+bool LinuxGLWaylandContext::SwapBuffers()
+{
+    /* Request presentation feedback and frame callback for the surface commit of eglSwapBuffers */
+    window_.PrepareSurfaceCommit();
+    return (eglSwapBuffers(display_, surface_) == EGL_TRUE);
+}
+
+void LinuxGLWaylandContext::Resize(const Size& resolution)
+{
+    /* The EGL surface takes the new size with the next eglSwapBuffers */
+    wl_egl_window_resize(eglWindow_, std::max(1, resolution.x), std::max(1, resolution.y), 0, 0);
+}
+
+bool LinuxGLWaylandContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    return window_.QueryPresentationStatistics(stats);
+}
+
+bool LinuxGLWaylandContext::WaitForVerticalBlank()
+{
+    /* The frame callback is the compositor's signal that it is a good time to draw the next frame */
+    return window_.WaitForFrameCallback();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool LinuxGLWaylandContext::Activate(bool activate)
+{
+    if (activate)
+        return (eglMakeCurrent(display_, surface_, surface_, eglc_) == EGL_TRUE);
+    else
+        return (eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE);
+}
+
+// Returns the EGL display for the specified Wayland display connection.
+static EGLDisplay GetWaylandDisplay(wl_display* wlDisplay)
+{
+    auto eglGetPlatformDisplayEXT = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+    if (eglGetPlatformDisplayEXT != nullptr && HasEGLExtension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), "EGL_KHR_platform_wayland"))
+        return eglGetPlatformDisplayEXT(EGL_PLATFORM_WAYLAND_KHR, wlDisplay, nullptr);
+
+    return eglGetDisplay(reinterpret_cast<EGLNativeDisplayType>(wlDisplay));
+}
+
+void LinuxGLWaylandContext::CreateContext(const RenderContextDescriptor& contextDesc, LinuxGLWaylandContext* sharedContext)
+{
+    EGLContext eglcShared = (sharedContext != nullptr ? sharedContext->eglc_ : EGL_NO_CONTEXT);
+
+    NativeHandle nativeHandle;
+    window_.GetNativeHandle(&nativeHandle);
+
+    /* Get EGL display of the Wayland connection (all Wayland windows share the same connection) */
+    if (sharedContext)
+        display_ = sharedContext->display_;
+    else
+    {
+        display_ = GetWaylandDisplay(nativeHandle.wlDisplay);
+
+        if (display_ == EGL_NO_DISPLAY)
+            throw std::runtime_error("failed to get EGL display for Wayland window");
+
+        if (eglInitialize(display_, nullptr, nullptr) != EGL_TRUE)
+            throw std::runtime_error("failed to initialize EGL display for Wayland window");
+    }
+
+    if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+        throw std::runtime_error("failed to bind OpenGL API for EGL");
+
+    /* Choose frame buffer configuration for window surfaces */
+    const EGLint samples = (contextDesc.multiSampling.enabled ? static_cast<EGLint>(std::max(1u, contextDesc.multiSampling.samples)) : 0);
+
+    const EGLint configAttribs[] =
+    {
+        EGL_SURFACE_TYPE,       EGL_WINDOW_BIT,
+        EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         8,
+        EGL_DEPTH_SIZE,         24,
+        EGL_STENCIL_SIZE,       8,
+        EGL_SAMPLE_BUFFERS,     (samples > 1 ? 1 : 0),
+        EGL_SAMPLES,            (samples > 1 ? samples : 0),
+        EGL_NONE
+    };
+
+    EGLint numConfigs = 0;
+    if (eglChooseConfig(display_, configAttribs, &config_, 1, &numConfigs) != EGL_TRUE || numConfigs == 0)
+        throw std::runtime_error("failed to choose EGL configuration for Wayland window");
+
+    /* Create OpenGL context with EGL */
+    const auto& profileDesc = contextDesc.profileOpenGL;
+
+    if (profileDesc.extProfile && profileDesc.coreProfile)
+    {
+        /* Create core profile */
+        int major = GetMajorVersion(profileDesc.version);
+        int minor = GetMinorVersion(profileDesc.version);
+        eglc_ = CreateContextCoreProfile(eglcShared, major, minor, IsNoErrorContext(profileDesc));
+    }
+
+    if (eglc_ == EGL_NO_CONTEXT)
+    {
+        /* Create compatibility profile */
+        eglc_ = eglCreateContext(display_, config_, eglcShared, nullptr);
+    }
+
+    if (eglc_ == EGL_NO_CONTEXT)
+        throw std::runtime_error("failed to create OpenGL context for Wayland window with EGL");
+
+    /* Create EGL window surface for the Wayland surface */
+    const auto& resolution = contextDesc.videoMode.resolution;
+
+    eglWindow_ = wl_egl_window_create(nativeHandle.wlSurface, std::max(1, resolution.x), std::max(1, resolution.y));
+    if (!eglWindow_)
+        throw std::runtime_error("failed to create Wayland EGL window");
+
+    surface_ = eglCreateWindowSurface(display_, config_, reinterpret_cast<EGLNativeWindowType>(eglWindow_), nullptr);
+    if (surface_ == EGL_NO_SURFACE)
+        throw std::runtime_error("failed to create EGL window surface for Wayland window");
+
+    /* Make new OpenGL context current */
+    if (eglMakeCurrent(display_, surface_, surface_, eglc_) != EGL_TRUE)
+        LLGL_LOG(Error, "failed to make OpenGL render context current (eglMakeCurrent)");
+}
+
+void LinuxGLWaylandContext::DeleteContext()
+{
+    /* The EGL display is not terminated here, since it is shared between all contexts of the Wayland connection */
+    eglDestroyContext(display_, eglc_);
+    eglDestroySurface(display_, surface_);
+    wl_egl_window_destroy(eglWindow_);
+}
+
+EGLContext LinuxGLWaylandContext::CreateContextCoreProfile(EGLContext eglcShared, int major, int minor, bool noError)
+{
+    EGLint contextAttribs[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION_KHR,          major,
+        EGL_CONTEXT_MINOR_VERSION_KHR,          minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_NONE,                               EGL_FALSE,
+        EGL_NONE
+    };
+
+    /* Disable error checking of the driver (only if supported, since unknown attributes let the context creation fail) */
+    if (noError && HasEGLExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_create_context_no_error"))
+    {
+        contextAttribs[6] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+        contextAttribs[7] = EGL_TRUE;
+    }
+
+    auto eglc = eglCreateContext(display_, config_, eglcShared, contextAttribs);
+
+    /* Context creation failed */
+    if (eglc == EGL_NO_CONTEXT)
+        LLGL_LOG(Error, "failed to create OpenGL core profile");
+
+    return eglc;
+}
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_GL_ENABLE_EGL && LLGL_ENABLE_WAYLAND
+
+
+
+// ================================================================================
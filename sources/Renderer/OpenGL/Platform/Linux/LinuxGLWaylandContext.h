@@ -0,0 +1,74 @@
+/*
+ * LinuxGLWaylandContext.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_LINUX_GL_WAYLAND_CONTEXT_H
+#define LLGL_LINUX_GL_WAYLAND_CONTEXT_H
+
+
+#if defined LLGL_GL_ENABLE_EGL && defined LLGL_ENABLE_WAYLAND
+
+
+#include "../GLContext.h"
+#include "../../OpenGL.h"
+#include <EGL/egl.h>
+
+
+struct wl_egl_window;
+
+namespace LLGL
+{
+
+
+class WaylandWindow;
+
+// OpenGL context for a Wayland window, which renders into an EGL window surface (wl_egl_window).
+class LinuxGLWaylandContext : public GLContext
+{
+
+    public:
+
+        LinuxGLWaylandContext(const RenderContextDescriptor& desc, WaylandWindow& window, LinuxGLWaylandContext* sharedContext);
+        ~LinuxGLWaylandContext();
+
+        bool SetSwapInterval(int interval) override;
+        bool SwapBuffers() override;
+        void Resize(const Size& resolution) override;
+
+        bool QueryFrameStatistics(FrameStatistics& stats) override;
+        bool WaitForVerticalBlank() override;
+
+    private:
+
+        bool Activate(bool activate) override;
+
+        void CreateContext(const RenderContextDescriptor& contextDesc, LinuxGLWaylandContext* sharedContext);
+        void DeleteContext();
+
+        EGLContext CreateContextCoreProfile(EGLContext eglcShared, int major, int minor, bool noError);
+
+        WaylandWindow&  window_;
+
+        EGLDisplay      display_    = EGL_NO_DISPLAY;
+        EGLConfig       config_     = nullptr;
+        wl_egl_window*  eglWindow_  = nullptr;
+        EGLSurface      surface_    = EGL_NO_SURFACE;
+        EGLContext      eglc_       = EGL_NO_CONTEXT;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_GL_ENABLE_EGL && LLGL_ENABLE_WAYLAND
+
+
+#endif
+
+
+
+// ================================================================================
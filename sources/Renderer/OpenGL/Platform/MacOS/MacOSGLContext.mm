@@ -17,14 +17,13 @@ namespace LLGL
 {
 
 
-std::unique_ptr<GLContext> GLContext::Create(RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext)
+std::unique_ptr<GLContext> GLContext::Create(RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext, bool /*ownHardwareContext*/)
 {
     MacOSGLContext* sharedContextGLNS = (sharedContext != nullptr ? LLGL_CAST(MacOSGLContext*, sharedContext) : nullptr);
     return MakeUnique<MacOSGLContext>(desc, surface, sharedContextGLNS);
 }
 
-MacOSGLContext::MacOSGLContext(RenderContextDescriptor& desc, Surface& surface, MacOSGLContext* sharedContext) :
-    LLGL::GLContext { sharedContext }
+MacOSGLContext::MacOSGLContext(RenderContextDescriptor& desc, Surface& surface, MacOSGLContext* sharedContext)
 {
     CreatePixelFormat(desc);
     
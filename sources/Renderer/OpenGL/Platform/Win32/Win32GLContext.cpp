@@ -11,10 +11,15 @@
 #include "../../../CheckedCast.h"
 #include "../../../../Core/Helper.h"
 #include <LLGL/Platform/NativeHandle.h>
-#include <LLGL/Log.h>
+#include "../../../../Core/HelperMacros.h"
 #include <algorithm>
 
 
+#ifndef WGL_CONTEXT_OPENGL_NO_ERROR_ARB
+#define WGL_CONTEXT_OPENGL_NO_ERROR_ARB 0x31B3
+#endif
+
+
 namespace LLGL
 {
 
@@ -23,10 +28,10 @@ namespace LLGL
  * GLContext class
  */
 
-std::unique_ptr<GLContext> GLContext::Create(RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext)
+std::unique_ptr<GLContext> GLContext::Create(RenderContextDescriptor& desc, Surface& surface, GLContext* sharedContext, bool ownHardwareContext)
 {
     Win32GLContext* sharedContextWGL = (sharedContext != nullptr ? LLGL_CAST(Win32GLContext*, sharedContext) : nullptr);
-    return MakeUnique<Win32GLContext>(desc, surface, sharedContextWGL);
+    return MakeUnique<Win32GLContext>(desc, surface, sharedContextWGL, ownHardwareContext);
 }
 
 
@@ -34,18 +39,33 @@ std::unique_ptr<GLContext> GLContext::Create(RenderContextDescriptor& desc, Surf
  * Win32GLContext class
  */
 
-Win32GLContext::Win32GLContext(RenderContextDescriptor& desc, Surface& surface, Win32GLContext* sharedContext) :
-    GLContext { sharedContext },
-    desc_     { desc          },
-    surface_  { surface       }
+Win32GLContext::Win32GLContext(RenderContextDescriptor& desc, Surface& surface, Win32GLContext* sharedContext, bool ownHardwareContext) :
+    desc_               { desc                        },
+    surface_            { surface                     },
+    ownHardwareContext_ { ownHardwareContext          },
+    requestedSamples_   { desc.multiSampling.samples  }
 {
     if (sharedContext)
     {
         auto sharedContextWGL = LLGL_CAST(Win32GLContext*, sharedContext);
         CreateContext(sharedContextWGL);
+
+        /* Contexts that reuse the hardware context of the shared context also share its GL states */
+        if (hasSharedContext_)
+            ShareStateManager(*sharedContextWGL);
+
+        /* Take the state of the optional WGL extensions from the shared context, since they are the same for all contexts on the same device */
+        hasSwapControlTear_ = sharedContextWGL->hasSwapControlTear_;
+        hasSyncControl_     = sharedContextWGL->hasSyncControl_;
     }
     else
+    {
         CreateContext(nullptr);
+
+        /* Load optional WGL extensions for frame pacing */
+        hasSwapControlTear_ = LoadSwapControlTearProcs();
+        hasSyncControl_     = LoadSyncControlProcs();
+    }
 }
 
 Win32GLContext::~Win32GLContext()
@@ -55,6 +75,10 @@ Win32GLContext::~Win32GLContext()
 
 bool Win32GLContext::SetSwapInterval(int interval)
 {
+    /* Late swap tearing is requested with a negative interval, which requires "WGL_EXT_swap_control_tear" */
+    if (interval < 0 && !hasSwapControlTear_)
+        interval = -interval;
+
     /* Load GL extension "wglSwapIntervalEXT" to set swap interval */
     if (wglSwapIntervalEXT || LoadSwapIntervalProcs())
         return (wglSwapIntervalEXT(interval) == TRUE);
@@ -72,6 +96,27 @@ void Win32GLContext::Resize(const Size& resolution)
     // do nothing (WGL context does not need to be resized)
 }
 
+bool Win32GLContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    INT64 ust = 0, msc = 0, sbc = 0;
+    if (hasSyncControl_ && wglGetSyncValuesOML(hDC_, &ust, &msc, &sbc) == TRUE)
+    {
+        /* UST (unadjusted system time) is specified in microseconds */
+        stats.presentCount      = static_cast<std::uint64_t>(sbc);
+        stats.syncRefreshCount  = static_cast<std::uint64_t>(msc);
+        stats.syncTime          = static_cast<std::uint64_t>(ust);
+        return true;
+    }
+    return false;
+}
+
+bool Win32GLContext::WaitForVerticalBlank()
+{
+    /* Wait until the MSC (media stream counter) is incremented the next time */
+    INT64 ust = 0, msc = 0, sbc = 0;
+    return (hasSyncControl_ && wglWaitForMscOML(hDC_, 0, 1, 0, &ust, &msc, &sbc) == TRUE);
+}
+
 
 /*
  * ======= Private: =======
@@ -87,7 +132,7 @@ bool Win32GLContext::Activate(bool activate)
 
 static void ErrAntiAliasingNotSupported()
 {
-    Log::StdErr() << "multi-sample anti-aliasing is not supported" << std::endl;
+    LLGL_LOG(Error, "multi-sample anti-aliasing is not supported");
 }
 
 /*
@@ -97,21 +142,54 @@ TODO:
 */
 void Win32GLContext::CreateContext(Win32GLContext* sharedContext)
 {
-    /* If a shared context has passed, use its pre-selected pixel format */
-    if (desc_.multiSampling.enabled && sharedContext)
-        CopyPixelFormat(*sharedContext);
+    /*
+    If a shared context has passed, use its pre-selected pixel format if it was selected for the same settings.
+    This avoids the intermediate context and the recreation of the window for multi-sampling.
+    */
+    const bool hasCachedPixelFormat = (sharedContext != nullptr && CopyPixelFormat(*sharedContext));
 
     /* First setup device context and choose pixel format */
     SetupDeviceContextAndPixelFormat();
 
+    /* Create extended profile directly if the pixel format is known and "wglCreateContextAttribsARB" has already been loaded by the shared context */
+    if (hasCachedPixelFormat && desc_.profileOpenGL.extProfile && wglCreateContextAttribsARB != nullptr)
+        hGLRC_ = CreateGLContext(true, sharedContext);
+
+    if (!hGLRC_)
+        CreateContextWithIntermediateProfile(sharedContext, hasCachedPixelFormat);
+
+    /* Check if context creation was successful */
+    if (!hGLRC_)
+        throw std::runtime_error("failed to create OpenGL render context");
+
+    if (wglMakeCurrent(hDC_, hGLRC_) != TRUE)
+        throw std::runtime_error("failed to activate OpenGL render context");
+
+    /*
+    Share resources with previous render context (only for compatibility profile).
+    -> Only do this, if this context has its own GL hardware context (hasSharedContext_ == false),
+       but a shared render context was passed (sharedContext != null).
+    */
+    if (sharedContext && !hasSharedContext_ && !desc_.profileOpenGL.extProfile)
+    {
+        if (!wglShareLists(sharedContext->hGLRC_, hGLRC_))
+            throw std::runtime_error("failed to share resources from OpenGL render context");
+    }
+
+    /* Query GL version of final render context */
+    //QueryGLVersion();
+}
+
+void Win32GLContext::CreateContextWithIntermediateProfile(Win32GLContext* sharedContext, bool hasCachedPixelFormat)
+{
     /* Create standard render context first */
     auto stdRenderContext = CreateGLContext(false, sharedContext);
 
     if (!stdRenderContext)
         throw std::runtime_error("failed to create standard OpenGL render context");
 
-    /* Check for multi-sample anti-aliasing */
-    if (desc_.multiSampling.enabled && !hasSharedContext_)
+    /* Check for multi-sample anti-aliasing (a cached pixel format already supports it) */
+    if (desc_.multiSampling.enabled && !hasSharedContext_ && !hasCachedPixelFormat)
     {
         /* Setup anti-aliasing after creating a standard render context. */
         if (SetupAntiAliasing())
@@ -130,7 +208,7 @@ void Win32GLContext::CreateContext(Win32GLContext* sharedContext)
             stdRenderContext = CreateGLContext(false, sharedContext);
 
             if (!stdRenderContext)
-                Log::StdErr() << "failed to create multi-sample anti-aliasing" << std::endl;
+                LLGL_LOG(Error, "failed to create multi-sample anti-aliasing");
         }
         else
         {
@@ -164,38 +242,17 @@ void Win32GLContext::CreateContext(Win32GLContext* sharedContext)
             else
             {
                 /* Print warning and disbale profile selection */
-                Log::StdErr() << "failed to create extended OpenGL profile" << std::endl;
+                LLGL_LOG(Error, "failed to create extended OpenGL profile");
                 desc_.profileOpenGL.extProfile = false;
             }
         }
         else
         {
             /* Print warning and disable profile settings */
-            Log::StdErr() << "failed to select OpenGL profile" << std::endl;
+            LLGL_LOG(Error, "failed to select OpenGL profile");
             desc_.profileOpenGL.extProfile = false;
         }
     }
-
-    /* Check if context creation was successful */
-    if (!hGLRC_)
-        throw std::runtime_error("failed to create OpenGL render context");
-
-    if (wglMakeCurrent(hDC_, hGLRC_) != TRUE)
-        throw std::runtime_error("failed to activate OpenGL render context");
-
-    /*
-    Share resources with previous render context (only for compatibility profile).
-    -> Only do this, if this context has its own GL hardware context (hasSharedContext_ == false),
-       but a shared render context was passed (sharedContext != null).
-    */
-    if (sharedContext && !hasSharedContext_ && !desc_.profileOpenGL.extProfile)
-    {
-        if (!wglShareLists(sharedContext->hGLRC_, hGLRC_))
-            throw std::runtime_error("failed to share resources from OpenGL render context");
-    }
-
-    /* Query GL version of final render context */
-    //QueryGLVersion();
 }
 
 void Win32GLContext::DeleteContext()
@@ -214,7 +271,7 @@ void Win32GLContext::DeleteGLContext(HGLRC& renderContext)
 {
     /* Delete GL render context */
     if (!wglDeleteContext(renderContext))
-        Log::StdErr() << "failed to delete OpenGL render context" << std::endl;
+        LLGL_LOG(Error, "failed to delete OpenGL render context");
     else
         renderContext = 0;
 }
@@ -224,7 +281,7 @@ HGLRC Win32GLContext::CreateGLContext(bool useExtProfile, Win32GLContext* shared
     /* Create hardware render context */
     HGLRC renderContext = 0;
 
-    if (!sharedContext || !sharedContext->hGLRC_ /* || createOwnHardwareContext == true*/)
+    if (!sharedContext || !sharedContext->hGLRC_ || ownHardwareContext_)
     {
         /* Create own hardware context */
         hasSharedContext_ = false;
@@ -252,7 +309,7 @@ HGLRC Win32GLContext::CreateGLContext(bool useExtProfile, Win32GLContext* shared
     if (wglMakeCurrent(hDC_, renderContext) != TRUE)
     {
         /* Print error and delete unusable render context */
-        Log::StdErr() << "failed to active OpenGL render context (wglMakeCurrent)" << std::endl;
+        LLGL_LOG(Error, "failed to active OpenGL render context (wglMakeCurrent)");
         DeleteGLContext(renderContext);
         return 0;
     }
@@ -278,7 +335,7 @@ HGLRC Win32GLContext::CreateExtContextProfile(HGLRC sharedGLRC)
     int minor = GetMinorVersion(desc_.profileOpenGL.version);
 
     /* Setup extended attributes to select the OpenGL profile */
-    const int attribList[] =
+    int attribList[] =
     {
         WGL_CONTEXT_MAJOR_VERSION_ARB,  major,
         WGL_CONTEXT_MINOR_VERSION_ARB,  minor,
@@ -286,19 +343,38 @@ HGLRC Win32GLContext::CreateExtContextProfile(HGLRC sharedGLRC)
         WGL_CONTEXT_FLAGS_ARB,          WGL_CONTEXT_DEBUG_BIT_ARB /*| WGL_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB*/,
         #endif
         WGL_CONTEXT_PROFILE_MASK_ARB,   (useCoreProfile ? WGL_CONTEXT_CORE_PROFILE_BIT_ARB : WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB),
+        0,                              0,
         0, 0
     };
 
+    /* Disable error checking of the driver for core profiles (GL_KHR_no_error) */
+    const bool noError = (useCoreProfile && IsNoErrorContext(desc_.profileOpenGL));
+    const auto noErrorAttrib = (sizeof(attribList)/sizeof(attribList[0]) - 4);
+
+    if (noError)
+    {
+        attribList[noErrorAttrib    ] = WGL_CONTEXT_OPENGL_NO_ERROR_ARB;
+        attribList[noErrorAttrib + 1] = GL_TRUE;
+    }
+
     /* Create OpenGL "Core Profile" or "Compatibility Profile" render context */
     HGLRC renderContext = wglCreateContextAttribsARB(hDC_, sharedGLRC, attribList);
 
+    if (!renderContext && noError)
+    {
+        /* Create context with error checking if WGL_ARB_create_context_no_error is not supported */
+        attribList[noErrorAttrib    ] = 0;
+        attribList[noErrorAttrib + 1] = 0;
+        renderContext = wglCreateContextAttribsARB(hDC_, sharedGLRC, attribList);
+    }
+
     /* Check for errors */
     DWORD error = GetLastError();
 
     if (error == ERROR_INVALID_VERSION_ARB)
-        Log::StdErr() << "invalid version for OpenGL profile" << std::endl;
+        LLGL_LOG(Error, "invalid version for OpenGL profile");
     else if (error == ERROR_INVALID_PROFILE_ARB)
-        Log::StdErr() << "invalid OpenGL profile" << std::endl;
+        LLGL_LOG(Error, "invalid OpenGL profile");
     else
         return renderContext;
 
@@ -462,10 +538,11 @@ bool Win32GLContext::SetupAntiAliasing()
     /* Check if multi-sample count was reduced */
     if (desc_.multiSampling.samples < queriedMultiSamples)
     {
-        Log::StdOut()
-            << "reduced multi-samples for anti-aliasing from "
-            << std::to_string(queriedMultiSamples) << " to "
-            << std::to_string(desc_.multiSampling.samples) << std::endl;
+        LLGL_LOG(
+            Info,
+            "reduced multi-samples for anti-aliasing from "
+            << queriedMultiSamples << " to " << desc_.multiSampling.samples
+        );
     }
 
     /* Enable anti-aliasing */
@@ -477,10 +554,25 @@ bool Win32GLContext::SetupAntiAliasing()
     return true;
 }
 
-void Win32GLContext::CopyPixelFormat(Win32GLContext& sourceContext)
+bool Win32GLContext::CopyPixelFormat(Win32GLContext& sourceContext)
 {
+    /* Pixel formats can only be reused if they were selected for the same multi-sampling settings */
+    if (sourceContext.pixelFormat_ == 0 || sourceContext.desc_.multiSampling.enabled != desc_.multiSampling.enabled)
+        return false;
+
+    if (desc_.multiSampling.enabled)
+    {
+        if (sourceContext.requestedSamples_ != requestedSamples_ || sourceContext.pixelFormatsMS_.empty())
+            return false;
+
+        /* Take the sample count the source context has possibly reduced to */
+        desc_.multiSampling.samples = sourceContext.desc_.multiSampling.samples;
+    }
+
     pixelFormat_    = sourceContext.pixelFormat_;
     pixelFormatsMS_ = sourceContext.pixelFormatsMS_;
+
+    return true;
 }
 
 void Win32GLContext::RecreateWindow()
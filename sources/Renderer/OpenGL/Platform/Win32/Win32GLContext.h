@@ -24,18 +24,22 @@ class Win32GLContext : public GLContext
 
     public:
 
-        Win32GLContext(RenderContextDescriptor& desc, Surface& surface, Win32GLContext* sharedContext);
+        Win32GLContext(RenderContextDescriptor& desc, Surface& surface, Win32GLContext* sharedContext, bool ownHardwareContext);
         ~Win32GLContext();
 
         bool SetSwapInterval(int interval) override;
         bool SwapBuffers() override;
         void Resize(const Size& resolution) override;
 
+        bool QueryFrameStatistics(FrameStatistics& stats) override;
+        bool WaitForVerticalBlank() override;
+
     private:
 
         bool Activate(bool activate) override;
 
         void CreateContext(Win32GLContext* sharedContext);
+        void CreateContextWithIntermediateProfile(Win32GLContext* sharedContext, bool hasCachedPixelFormat);
         void DeleteContext();
 
         void DeleteGLContext(HGLRC& renderContext);
@@ -48,7 +52,7 @@ class Win32GLContext : public GLContext
 
         void SelectPixelFormat();
         bool SetupAntiAliasing();
-        void CopyPixelFormat(Win32GLContext& sourceContext);
+        bool CopyPixelFormat(Win32GLContext& sourceContext);
 
         void RecreateWindow();
 
@@ -64,6 +68,11 @@ class Win32GLContext : public GLContext
         Surface&                    surface_;
 
         bool                        hasSharedContext_       = false;
+        bool                        ownHardwareContext_     = false;
+        unsigned int                requestedSamples_       = 0;    //!< Multi-samples before they were possibly reduced to a supported count.
+
+        bool                        hasSwapControlTear_     = false;
+        bool                        hasSyncControl_         = false;
 
 };
 
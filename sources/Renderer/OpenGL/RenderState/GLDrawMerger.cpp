@@ -0,0 +1,98 @@
+/*
+ * GLDrawMerger.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLDrawMerger.h"
+#include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+
+
+namespace LLGL
+{
+
+
+bool GLDrawMerger::IsSupported()
+{
+    return (HasExtension(GLExt::EXT_multi_draw_arrays) && HasExtension(GLExt::ARB_draw_elements_base_vertex));
+}
+
+void GLDrawMerger::DrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    Enqueue(DrawType::Arrays, mode, GL_UNSIGNED_INT);
+    counts_.push_back(count);
+    firsts_.push_back(first);
+    if (counts_.size() >= maxNumDraws)
+        Flush();
+}
+
+void GLDrawMerger::DrawElements(GLenum mode, GLsizei count, GLenum type, GLintptr indices, GLint baseVertex)
+{
+    Enqueue(DrawType::Elements, mode, type);
+    counts_.push_back(count);
+    firsts_.push_back(baseVertex);
+    indices_.push_back(reinterpret_cast<const GLvoid*>(indices));
+    if (baseVertex != 0)
+        hasBaseVertex_ = true;
+    if (counts_.size() >= maxNumDraws)
+        Flush();
+}
+
+void GLDrawMerger::Flush()
+{
+    const auto numDraws = static_cast<GLsizei>(counts_.size());
+    if (numDraws == 0)
+        return;
+
+    if (type_ == DrawType::Arrays)
+    {
+        if (numDraws == 1)
+            glDrawArrays(mode_, firsts_[0], counts_[0]);
+        else
+            glMultiDrawArrays(mode_, firsts_.data(), counts_.data(), numDraws);
+    }
+    else if (hasBaseVertex_)
+    {
+        if (numDraws == 1)
+            glDrawElementsBaseVertex(mode_, counts_[0], indexType_, indices_[0], firsts_[0]);
+        else
+            glMultiDrawElementsBaseVertex(mode_, counts_.data(), indexType_, indices_.data(), numDraws, firsts_.data());
+    }
+    else
+    {
+        if (numDraws == 1)
+            glDrawElements(mode_, counts_[0], indexType_, indices_[0]);
+        else
+            glMultiDrawElements(mode_, counts_.data(), indexType_, indices_.data(), numDraws);
+    }
+
+    counts_.clear();
+    firsts_.clear();
+    indices_.clear();
+    hasBaseVertex_ = false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLDrawMerger::Enqueue(DrawType type, GLenum mode, GLenum indexType)
+{
+    /* Draw commands of different types, primitive modes, or index types cannot be merged */
+    if (!IsEmpty() && (type_ != type || mode_ != mode || (type == DrawType::Elements && indexType_ != indexType)))
+        Flush();
+
+    type_       = type;
+    mode_       = mode;
+    indexType_  = indexType;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,81 @@
+/*
+ * GLDrawMerger.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_DRAW_MERGER_H
+#define LLGL_GL_DRAW_MERGER_H
+
+
+#include "../OpenGL.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Queue of consecutive non-instanced draw commands, which are submitted with a single "glMultiDrawArrays" or "glMultiDrawElementsBaseVertex" call.
+Draw commands can only be merged as long as no state changes in between, so the queue is flushed by the state manager
+before any other command is submitted (see GLStateManager::FlushPendingDraws).
+This requires GL_EXT_multi_draw_arrays and GL_ARB_draw_elements_base_vertex.
+*/
+class GLDrawMerger
+{
+
+    public:
+
+        // Returns true if draw commands can be merged with the available GL extensions.
+        static bool IsSupported();
+
+        // Queues a draw command for "glDrawArrays". The queue is flushed when it is full.
+        void DrawArrays(GLenum mode, GLint first, GLsizei count);
+
+        // Queues a draw command for "glDrawElementsBaseVertex". The queue is flushed when it is full.
+        void DrawElements(GLenum mode, GLsizei count, GLenum type, GLintptr indices, GLint baseVertex);
+
+        // Submits all queued draw commands and clears the queue.
+        void Flush();
+
+        // Returns true if there are no queued draw commands.
+        inline bool IsEmpty() const
+        {
+            return counts_.empty();
+        }
+
+    private:
+
+        enum class DrawType
+        {
+            Arrays,
+            Elements,
+        };
+
+        // Maximum number of draw commands that are merged into a single call.
+        static const std::size_t maxNumDraws = 256;
+
+        void Enqueue(DrawType type, GLenum mode, GLenum indexType);
+
+        DrawType                    type_           = DrawType::Arrays;
+        GLenum                      mode_           = GL_TRIANGLES;
+        GLenum                      indexType_      = GL_UNSIGNED_INT;
+        bool                        hasBaseVertex_  = false;
+
+        std::vector<GLsizei>        counts_;
+        std::vector<GLint>          firsts_;        // First vertices for arrays, or base vertices for elements
+        std::vector<const GLvoid*>  indices_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
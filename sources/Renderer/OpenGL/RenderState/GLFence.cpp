@@ -0,0 +1,90 @@
+/*
+ * GLFence.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLFence.h"
+#include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+
+
+namespace LLGL
+{
+
+
+GLFence::~GLFence()
+{
+    DeleteSync();
+}
+
+bool GLFence::IsSignaled()
+{
+    #ifdef GL_ARB_sync
+    if (sync_)
+    {
+        /* Poll sync object without waiting */
+        if (glClientWaitSync(sync_, 0, 0) == GL_TIMEOUT_EXPIRED)
+            return false;
+        DeleteSync();
+    }
+    #endif
+    return true;
+}
+
+bool GLFence::Wait(std::uint64_t timeout)
+{
+    #ifdef GL_ARB_sync
+    if (sync_)
+    {
+        /* Flush command queue while waiting, otherwise the sync object might never be signaled */
+        auto result = glClientWaitSync(sync_, GL_SYNC_FLUSH_COMMANDS_BIT, static_cast<GLuint64>(timeout));
+        if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+            return false;
+        DeleteSync();
+    }
+    #endif
+    return true;
+}
+
+void GLFence::Signal()
+{
+    #ifdef GL_ARB_sync
+    if (HasExtension(GLExt::ARB_sync))
+    {
+        DeleteSync();
+        sync_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        /* Flush command queue, so that the sync object is eventually signaled while it is polled with "IsSignaled" */
+        glFlush();
+        return;
+    }
+    #endif
+
+    /* Fall back to synchronous wait */
+    glFinish();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLFence::DeleteSync()
+{
+    #ifdef GL_ARB_sync
+    if (sync_)
+    {
+        glDeleteSync(sync_);
+        sync_ = 0;
+    }
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
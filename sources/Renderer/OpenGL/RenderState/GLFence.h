@@ -0,0 +1,54 @@
+/*
+ * GLFence.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_FENCE_H
+#define LLGL_GL_FENCE_H
+
+
+#include <LLGL/Fence.h>
+#include "../OpenGL.h"
+
+
+namespace LLGL
+{
+
+
+/*
+Fence object based on a GL sync object (requires GL_ARB_sync).
+Without GL_ARB_sync, "Signal" waits for the GPU with glFinish, so the fence is always signaled.
+*/
+class GLFence : public Fence
+{
+
+    public:
+
+        GLFence() = default;
+        ~GLFence();
+
+        bool IsSignaled() override;
+        bool Wait(std::uint64_t timeout) override;
+
+        // Inserts a new sync object into the GL command stream and deletes the previous one.
+        void Signal();
+
+    private:
+
+        void DeleteSync();
+
+        GLsync sync_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
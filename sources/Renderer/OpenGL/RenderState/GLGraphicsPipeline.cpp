@@ -9,7 +9,10 @@
 #include "../Ext/GLExtensions.h"
 #include "../../GLCommon/GLTypes.h"
 #include "../../GLCommon/GLCore.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
+#include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
@@ -76,6 +79,98 @@ static bool IsBlendColorNeeded(const BlendDescriptor& blendDesc)
     return false;
 }
 
+// Bitmasks of the state groups that are applied separately when a graphics pipeline is bound
+struct GLPipelineStateGroup
+{
+    enum
+    {
+        PatchVertices   = (1 << 0),
+        Depth           = (1 << 1),
+        Stencil         = (1 << 2),
+        Rasterizer      = (1 << 3),
+        Blend           = (1 << 4),
+        BlendColor      = (1 << 5),
+
+        All             = (PatchVertices | Depth | Stencil | Rasterizer | Blend | BlendColor),
+    };
+};
+
+template <typename T>
+std::uint32_t PackBits(T value, unsigned int offset)
+{
+    return (static_cast<std::uint32_t>(value) << offset);
+}
+
+static std::uint32_t PackStencilFace(const StencilFaceDescriptor& desc)
+{
+    return
+    (
+        PackBits(desc.stencilFailOp,    0) |
+        PackBits(desc.depthFailOp,      3) |
+        PackBits(desc.depthPassOp,      6) |
+        PackBits(desc.compareOp,        9)
+    );
+}
+
+static std::uint32_t PackBlendTarget(const BlendTargetDescriptor& desc)
+{
+    return
+    (
+        PackBits(desc.srcColor,         0) |
+        PackBits(desc.destColor,        5) |
+        PackBits(desc.srcAlpha,         10) |
+        PackBits(desc.destAlpha,        15) |
+        PackBits(desc.colorArithmetic,  20) |
+        PackBits(desc.alphaArithmetic,  23) |
+        PackBits(desc.colorMask.r,      26) |
+        PackBits(desc.colorMask.g,      27) |
+        PackBits(desc.colorMask.b,      28) |
+        PackBits(desc.colorMask.a,      29)
+    );
+}
+
+static std::uint32_t PackFloat(float value)
+{
+    std::uint32_t word = 0;
+    std::memcpy(&word, &value, sizeof(word));
+    return word;
+}
+
+template <std::size_t N>
+bool WordsDiffer(const std::uint32_t (&lhs)[N], const std::uint32_t (&rhs)[N])
+{
+    std::uint32_t diff = 0;
+    for (std::size_t i = 0; i < N; ++i)
+        diff |= (lhs[i] ^ rhs[i]);
+    return (diff != 0);
+}
+
+// Returns the bitmask of state groups (see GLPipelineStateGroup) that differ between the previous and the next pipeline states.
+static long GetDirtyStateGroups(const GLPipelineStateBlock* prev, const GLPipelineStateBlock& next)
+{
+    if (!prev)
+        return GLPipelineStateGroup::All;
+
+    long groups = 0;
+
+    if (prev->patchVertices != next.patchVertices)
+        groups |= GLPipelineStateGroup::PatchVertices;
+    if (prev->depth != next.depth)
+        groups |= GLPipelineStateGroup::Depth;
+    if (WordsDiffer(prev->stencil, next.stencil))
+        groups |= GLPipelineStateGroup::Stencil;
+    if (prev->rasterizer != next.rasterizer)
+        groups |= GLPipelineStateGroup::Rasterizer;
+
+    /* Blend states that don't fit into the state block are always applied */
+    if (WordsDiffer(prev->blend, next.blend) || (next.blend[0] >> 1) > GLPipelineStateBlock::maxNumBlendTargets)
+        groups |= GLPipelineStateGroup::Blend;
+    if (WordsDiffer(prev->blendColor, next.blendColor))
+        groups |= GLPipelineStateGroup::BlendColor;
+
+    return groups;
+}
+
 
 /* ----- GLGraphicsPipeline class ----- */
 
@@ -87,6 +182,27 @@ GLGraphicsPipeline::GLGraphicsPipeline(const GraphicsPipelineDescriptor& desc, c
     if (!shaderProgram_)
         throw std::invalid_argument("failed to create graphics pipeline due to missing shader program");
 
+    /* Query uniform locations of push constants in each program that declares them */
+    if (desc.pushConstants.size > 0)
+    {
+        if (shaderProgram_->IsSeparable())
+        {
+            for (auto program : shaderProgram_->GetStagePrograms())
+                QueryPushConstantsLocations(program, desc.pushConstants.size / 16);
+        }
+        else
+            QueryPushConstantsLocations(shaderProgram_->GetID(), desc.pushConstants.size / 16);
+    }
+
+    /* Validate view mask; the views themselves are determined by the multiview attachments and the "num_views" shader layout */
+    if (desc.viewMask != 0)
+    {
+        if (renderCaps.maxNumViews == 0)
+            throw std::runtime_error("renderer does not support multiview rendering (requires GL_OVR_multiview2)");
+        if ((desc.viewMask & (desc.viewMask + 1)) != 0)
+            throw std::invalid_argument("view mask of graphics pipeline must have consecutive bits beginning with the first view for OpenGL");
+    }
+
     /* Convert input-assembler state */
     drawMode_ = GLTypes::Map(desc.primitiveTopology);
 
@@ -109,6 +225,7 @@ GLGraphicsPipeline::GLGraphicsPipeline(const GraphicsPipelineDescriptor& desc, c
     depthTestEnabled_   = desc.depth.testEnabled;
     depthMask_          = (desc.depth.writeEnabled ? GL_TRUE : GL_FALSE);
     depthFunc_          = GLTypes::Map(desc.depth.compareOp);
+    depthBoundsTest_    = (desc.depth.boundsTestEnabled && renderCaps.hasDepthBoundsTest);
 
     /* Convert stencil state */
     stencilTestEnabled_ = desc.stencil.testEnabled;
@@ -133,66 +250,206 @@ GLGraphicsPipeline::GLGraphicsPipeline(const GraphicsPipelineDescriptor& desc, c
     blendColor_         = desc.blend.blendFactor;
     blendColorNeeded_   = IsBlendColorNeeded(desc.blend);
     Convert(blendStates_, desc.blend.targets);
+
+    /* Pack states to determine which state groups differ from the previously bound pipeline */
+    PackStateBlock(desc);
 }
 
 void GLGraphicsPipeline::Bind(GLStateManager& stateMngr)
 {
-    /* Bind shader program and discard rasterizer if there is no fragment shader */
-    stateMngr.BindShaderProgram(shaderProgram_->GetID());
-    stateMngr.Set(GLState::RASTERIZER_DISCARD, !shaderProgram_->HasFragmentShader());
+    /* Bind shader program (or program pipeline of separable stages) */
+    if (shaderProgram_->IsSeparable())
+    {
+        /* A program bound with "glUseProgram" takes precedence over the program pipeline */
+        stateMngr.BindShaderProgram(0);
+        stateMngr.BindProgramPipeline(shaderProgram_->GetPipelineID());
+    }
+    else
+        stateMngr.BindShaderProgram(shaderProgram_->GetID());
+
+    /* Only apply the state groups that differ from the previously bound pipeline */
+    auto dirtyGroups = GetDirtyStateGroups(stateMngr.GetPipelineState(), stateBlock_);
 
     /* Setup input-assembler state */
-    if (patchVertices_ > 0)
+    if ((dirtyGroups & GLPipelineStateGroup::PatchVertices) != 0 && patchVertices_ > 0)
         stateMngr.SetPatchVertices(patchVertices_);
 
     /* Setup depth state */
-    if (depthTestEnabled_)
+    if ((dirtyGroups & GLPipelineStateGroup::Depth) != 0)
     {
-        stateMngr.Enable(GLState::DEPTH_TEST);
-        stateMngr.SetDepthFunc(depthFunc_);
-    }
-    else
-        stateMngr.Disable(GLState::DEPTH_TEST);
+        if (depthTestEnabled_)
+        {
+            stateMngr.Enable(GLState::DEPTH_TEST);
+            stateMngr.SetDepthFunc(depthFunc_);
+        }
+        else
+            stateMngr.Disable(GLState::DEPTH_TEST);
 
-    stateMngr.SetDepthMask(depthMask_);
+        stateMngr.SetDepthMask(depthMask_);
+        stateMngr.SetDepthBoundsTest(depthBoundsTest_);
+    }
 
     /* Setup stencil state */
-    if (stencilTestEnabled_)
+    if ((dirtyGroups & GLPipelineStateGroup::Stencil) != 0)
+    {
+        if (stencilTestEnabled_)
+        {
+            stateMngr.Enable(GLState::STENCIL_TEST);
+            stateMngr.SetStencilState(GL_FRONT, stencilFront_);
+            stateMngr.SetStencilState(GL_BACK, stencilBack_);
+        }
+        else
+            stateMngr.Disable(GLState::STENCIL_TEST);
+    }
+
+    /* Setup rasterizer state and discard rasterizer if there is no fragment shader */
+    if ((dirtyGroups & GLPipelineStateGroup::Rasterizer) != 0)
     {
-        stateMngr.Enable(GLState::STENCIL_TEST);
-        stateMngr.SetStencilState(GL_FRONT, stencilFront_);
-        stateMngr.SetStencilState(GL_BACK, stencilBack_);
+        stateMngr.Set(GLState::RASTERIZER_DISCARD, !shaderProgram_->HasFragmentShader());
+        stateMngr.SetPolygonMode(polygonMode_);
+        stateMngr.SetFrontFace(frontFace_);
+
+        if (cullFace_ != 0)
+        {
+            stateMngr.Enable(GLState::CULL_FACE);
+            stateMngr.SetCullFace(cullFace_);
+        }
+        else
+            stateMngr.Disable(GLState::CULL_FACE);
+
+        stateMngr.Set(GLState::SCISSOR_TEST, scissorTestEnabled_);
+        stateMngr.Set(GLState::DEPTH_CLAMP, depthClampEnabled_);
+        stateMngr.Set(GLState::MULTISAMPLE, multiSampleEnabled_);
+        stateMngr.Set(GLState::LINE_SMOOTH, lineSmoothEnabled_);
+
+        #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+        stateMngr.Set(GLStateExt::CONSERVATIVE_RASTERIZATION, conservativeRaster_);
+        #endif
     }
-    else
-        stateMngr.Disable(GLState::STENCIL_TEST);
 
-    /* Setup rasterizer state */
-    stateMngr.SetPolygonMode(polygonMode_);
-    stateMngr.SetFrontFace(frontFace_);
+    /* Setup blend state */
+    if ((dirtyGroups & GLPipelineStateGroup::Blend) != 0)
+    {
+        stateMngr.Set(GLState::BLEND, blendEnabled_);
+        stateMngr.SetBlendStates(blendStates_, blendEnabled_);
+    }
+
+    if ((dirtyGroups & GLPipelineStateGroup::BlendColor) != 0 && blendColorNeeded_)
+        stateMngr.SetBlendColor(blendColor_);
 
-    if (cullFace_ != 0)
+    stateMngr.SetPipelineState(stateBlock_);
+}
+
+void GLGraphicsPipeline::SetPushConstants(GLStateManager& stateMngr, unsigned int offset, unsigned int size, const void* data)
+{
+    auto first = offset / 16;
+    auto values = reinterpret_cast<const GLfloat*>(data);
+
+    for (const auto& entry : pushConstants_)
     {
-        stateMngr.Enable(GLState::CULL_FACE);
-        stateMngr.SetCullFace(cullFace_);
+        if (first < entry.locations.size() && entry.locations[first] != -1)
+        {
+            /* Write consecutive array elements with a single call */
+            auto count = static_cast<GLsizei>(std::min(size / 16, static_cast<unsigned int>(entry.locations.size()) - first));
+            if (shaderProgram_->IsSeparable() || HasExtension(GLExt::ARB_separate_shader_objects))
+            {
+                /* Write program directly if possible, and always for separable programs, since "glUseProgram" would override the program pipeline */
+                glProgramUniform4fv(entry.program, entry.locations[first], count, values);
+            }
+            else
+            {
+                /* The shader program must be bound for "glUniform*" */
+                stateMngr.BindShaderProgram(entry.program);
+                glUniform4fv(entry.locations[first], count, values);
+            }
+        }
     }
-    else
-        stateMngr.Disable(GLState::CULL_FACE);
+}
+
+
+/*
+ * ======= Private: =======
+ */
 
-    stateMngr.Set(GLState::SCISSOR_TEST, scissorTestEnabled_);
-    stateMngr.Set(GLState::DEPTH_CLAMP, depthClampEnabled_);
-    stateMngr.Set(GLState::MULTISAMPLE, multiSampleEnabled_);
-    stateMngr.Set(GLState::LINE_SMOOTH, lineSmoothEnabled_);
+void GLGraphicsPipeline::PackStateBlock(const GraphicsPipelineDescriptor& desc)
+{
+    /* Pack input-assembler state */
+    stateBlock_.patchVertices = static_cast<std::uint32_t>(patchVertices_);
+
+    /* Pack depth state */
+    stateBlock_.depth =
+    (
+        PackBits(desc.depth.testEnabled,    0) |
+        PackBits(desc.depth.writeEnabled,   1) |
+        PackBits(desc.depth.compareOp,      2) |
+        PackBits(depthBoundsTest_,          5)
+    );
+
+    /* Pack stencil state */
+    stateBlock_.stencil[0] =
+    (
+        PackBits(desc.stencil.testEnabled,              0) |
+        PackBits(PackStencilFace(desc.stencil.front),   1) |
+        PackBits(PackStencilFace(desc.stencil.back),    13)
+    );
+    stateBlock_.stencil[1] = desc.stencil.front.reference;
+    stateBlock_.stencil[2] = desc.stencil.front.readMask;
+    stateBlock_.stencil[3] = desc.stencil.front.writeMask;
+    stateBlock_.stencil[4] = desc.stencil.back.reference;
+    stateBlock_.stencil[5] = desc.stencil.back.readMask;
+    stateBlock_.stencil[6] = desc.stencil.back.writeMask;
+
+    /* Pack rasterizer state */
+    stateBlock_.rasterizer =
+    (
+        PackBits(desc.rasterizer.polygonMode,               0) |
+        PackBits(desc.rasterizer.cullMode,                  2) |
+        PackBits(desc.rasterizer.frontCCW,                  4) |
+        PackBits(scissorTestEnabled_,                       5) |
+        PackBits(depthClampEnabled_,                        6) |
+        PackBits(multiSampleEnabled_,                       7) |
+        PackBits(lineSmoothEnabled_,                        8) |
+        PackBits(!shaderProgram_->HasFragmentShader(),      9)
+    );
 
     #ifdef LLGL_GL_ENABLE_VENDOR_EXT
-    stateMngr.Set(GLStateExt::CONSERVATIVE_RASTERIZATION, conservativeRaster_);
+    stateBlock_.rasterizer |= PackBits(conservativeRaster_, 10);
     #endif
 
-    /* Setup blend state */
-    stateMngr.Set(GLState::BLEND, blendEnabled_);
-    stateMngr.SetBlendStates(blendStates_, blendEnabled_);
+    /* Pack blend state */
+    const auto& targets = desc.blend.targets;
+    stateBlock_.blend[0] = (PackBits(blendEnabled_, 0) | PackBits(targets.size(), 1));
 
-    if (blendColorNeeded_)
-        stateMngr.SetBlendColor(blendColor_);
+    for (std::size_t i = 0, n = std::min(targets.size(), GLPipelineStateBlock::maxNumBlendTargets); i < n; ++i)
+        stateBlock_.blend[1 + i] = PackBlendTarget(targets[i]);
+
+    /* Pack blend color */
+    stateBlock_.blendColor[0] = PackBits(blendColorNeeded_, 0);
+    stateBlock_.blendColor[1] = PackFloat(blendColor_.r);
+    stateBlock_.blendColor[2] = PackFloat(blendColor_.g);
+    stateBlock_.blendColor[3] = PackFloat(blendColor_.b);
+    stateBlock_.blendColor[4] = PackFloat(blendColor_.a);
+}
+
+void GLGraphicsPipeline::QueryPushConstantsLocations(GLuint program, unsigned int count)
+{
+    GLPushConstantsLocations entry;
+    entry.program = program;
+
+    /* Query locations of all array elements (locations of array elements are not guaranteed to be consecutive) */
+    bool declared = false;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        auto name = "PushConstants[" + std::to_string(i) + "]";
+        auto location = glGetUniformLocation(program, name.c_str());
+        entry.locations.push_back(location);
+        declared = (declared || location != -1);
+    }
+
+    /* Only store programs that declare the push constants */
+    if (declared)
+        pushConstants_.push_back(std::move(entry));
 }
 
 
@@ -30,6 +30,9 @@ class GLGraphicsPipeline : public GraphicsPipeline
 
         void Bind(GLStateManager& stateMngr);
 
+        // Writes the specified data into the push constants uniform array of the shader program (see PushConstantsDescriptor).
+        void SetPushConstants(GLStateManager& stateMngr, unsigned int offset, unsigned int size, const void* data);
+
         inline GLenum GetDrawMode() const
         {
             return drawMode_;
@@ -37,8 +40,21 @@ class GLGraphicsPipeline : public GraphicsPipeline
 
     private:
 
+        // Uniform locations of "PushConstants[i]" (one vec4 each) within a single program.
+        struct GLPushConstantsLocations
+        {
+            GLuint              program = 0;
+            std::vector<GLint>  locations;
+        };
+
+        void QueryPushConstantsLocations(GLuint program, unsigned int count);
+
+        // Packs the render states into the state block, which is compared against the previously bound pipeline.
+        void PackStateBlock(const GraphicsPipelineDescriptor& desc);
+
         // shader state
-        GLShaderProgram*        shaderProgram_      = nullptr;
+        GLShaderProgram*                        shaderProgram_      = nullptr;
+        std::vector<GLPushConstantsLocations>   pushConstants_;                 // one entry per program (multiple for separable shader stages)
 
         // input-assembler state
         GLenum                  drawMode_           = GL_TRIANGLES;
@@ -48,6 +64,7 @@ class GLGraphicsPipeline : public GraphicsPipeline
         bool                    depthTestEnabled_   = false;    // glEnable(GL_DEPTH_TEST)
         GLboolean               depthMask_          = false;    // glDepthMask(GL_TRUE)
         GLenum                  depthFunc_          = GL_LESS;
+        bool                    depthBoundsTest_    = false;    // glEnable(GL_DEPTH_BOUNDS_TEST_EXT)
 
         // stencil state
         bool                    stencilTestEnabled_ = false;    // glEnable(GL_STENCIL_TEST)
@@ -73,6 +90,9 @@ class GLGraphicsPipeline : public GraphicsPipeline
         bool                    blendColorNeeded_   = false;
         std::vector<GLBlend>    blendStates_;
 
+        // packed states
+        GLPipelineStateBlock    stateBlock_;
+
 };
 
 
@@ -14,16 +14,57 @@ namespace LLGL
 {
 
 
+#ifdef GL_ARB_pipeline_statistics_query
+
+static const GLenum g_pipelineStatisticsTargets[GLQuery::numPipelineStatistics] =
+{
+    GL_PRIMITIVES_GENERATED,
+    GL_VERTICES_SUBMITTED_ARB,
+    GL_PRIMITIVES_SUBMITTED_ARB,
+    GL_VERTEX_SHADER_INVOCATIONS_ARB,
+    GL_TESS_CONTROL_SHADER_PATCHES_ARB,
+    GL_TESS_EVALUATION_SHADER_INVOCATIONS_ARB,
+    GL_GEOMETRY_SHADER_INVOCATIONS,
+    GL_FRAGMENT_SHADER_INVOCATIONS_ARB,
+    GL_COMPUTE_SHADER_INVOCATIONS_ARB,
+    GL_GEOMETRY_SHADER_PRIMITIVES_EMITTED_ARB,
+    GL_CLIPPING_INPUT_PRIMITIVES_ARB,
+    GL_CLIPPING_OUTPUT_PRIMITIVES_ARB,
+};
+
+#endif
+
 GLQuery::GLQuery(const QueryDescriptor& desc) :
-    Query   { desc.type               },
-    target_ { GLTypes::Map(desc.type) }
+    Query { desc.type }
 {
-    glGenQueries(1, &id_);
+    if (desc.type == QueryType::PipelineStatistics)
+    {
+        /* Generate one hardware query for each statistic, which are all active at the same time */
+        statisticsIDs_.resize(numPipelineStatistics);
+        glGenQueries(static_cast<GLsizei>(numPipelineStatistics), statisticsIDs_.data());
+    }
+    else
+    {
+        target_ = GLTypes::Map(desc.type);
+        glGenQueries(1, &id_);
+    }
 }
 
 GLQuery::~GLQuery()
 {
-    glDeleteQueries(1, &id_);
+    if (statisticsIDs_.empty())
+        glDeleteQueries(1, &id_);
+    else
+        glDeleteQueries(static_cast<GLsizei>(statisticsIDs_.size()), statisticsIDs_.data());
+}
+
+const GLenum* GLQuery::GetPipelineStatisticsTargets()
+{
+    #ifdef GL_ARB_pipeline_statistics_query
+    return g_pipelineStatisticsTargets;
+    #else
+    return nullptr;
+    #endif
 }
 
 
@@ -11,6 +11,8 @@
 
 #include <LLGL/Query.h>
 #include "../OpenGL.h"
+#include <vector>
+#include <cstddef>
 
 
 namespace LLGL
@@ -22,25 +24,38 @@ class GLQuery : public Query
 
     public:
 
+        // Number of hardware queries of a query with type QueryType::PipelineStatistics.
+        static const std::size_t numPipelineStatistics = 12;
+
         GLQuery(const QueryDescriptor& desc);
         ~GLQuery();
 
+        // Returns the query targets of a pipeline statistics query in the order of the members of QueryPipelineStatistics.
+        static const GLenum* GetPipelineStatisticsTargets();
+
         //! Returns the query target.
         inline GLenum GetTarget() const
         {
             return target_;
         }
 
-        //! Returns the hardware query ID.
+        //! Returns the hardware query ID. This is 0 for pipeline statistics queries.
         inline GLuint GetID() const
         {
             return id_;
         }
 
+        // Returns the hardware query IDs of a pipeline statistics query (see GetPipelineStatisticsTargets).
+        inline const std::vector<GLuint>& GetPipelineStatisticsIDs() const
+        {
+            return statisticsIDs_;
+        }
+
     private:
 
-        GLenum target_  = 0;
-        GLuint id_      = 0;
+        GLenum              target_         = 0;
+        GLuint              id_             = 0;
+        std::vector<GLuint> statisticsIDs_;
 
 };
 
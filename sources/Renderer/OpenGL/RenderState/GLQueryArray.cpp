@@ -0,0 +1,31 @@
+/*
+ * GLQueryArray.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLQueryArray.h"
+#include "GLQuery.h"
+#include "../../../Core/Helper.h"
+
+
+namespace LLGL
+{
+
+
+GLQueryArray::GLQueryArray(unsigned int numQueries, Query* const * queryArray) :
+    QueryArray { (*queryArray)->GetType(), numQueries }
+{
+    /* Store the ID of each GLQuery inside the array */
+    idArray_.reserve(numQueries);
+    while (auto next = NextArrayResource<GLQuery>(numQueries, queryArray))
+        idArray_.push_back(next->GetID());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
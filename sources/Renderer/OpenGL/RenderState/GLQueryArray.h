@@ -0,0 +1,50 @@
+/*
+ * GLQueryArray.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_QUERY_ARRAY_H
+#define LLGL_GL_QUERY_ARRAY_H
+
+
+#include <LLGL/QueryArray.h>
+#include "../OpenGL.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class Query;
+
+class GLQueryArray : public QueryArray
+{
+
+    public:
+
+        GLQueryArray(unsigned int numQueries, Query* const * queryArray);
+
+        //! Returns the array of query IDs.
+        inline const std::vector<GLuint>& GetIDArray() const
+        {
+            return idArray_;
+        }
+
+    private:
+
+        std::vector<GLuint> idArray_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,139 @@
+/*
+ * GLResourceHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLResourceHeap.h"
+#include "../Buffer/GLBuffer.h"
+#include "../Buffer/GLStorageBuffer.h"
+#include "../Texture/GLTexture.h"
+#include "../Texture/GLSampler.h"
+#include "../../CheckedCast.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+/*
+Collects all resource views of the specified type sorted by their slot index,
+and merges consecutive slots into segments, so each segment can be bound with a single multi-bind call.
+*/
+template <typename TAppendFunc>
+static void BuildSegments(
+    const ResourceHeapDescriptor&           desc,
+    const ResourceType                      type,
+    std::vector<GLResourceBindingSegment>&  segments,
+    TAppendFunc                             appendResource)
+{
+    std::vector<const ResourceViewDescriptor*> resourceViews;
+
+    for (const auto& resourceView : desc.resourceViews)
+    {
+        if (resourceView.type == type)
+            resourceViews.push_back(&resourceView);
+    }
+
+    std::stable_sort(
+        resourceViews.begin(), resourceViews.end(),
+        [](const ResourceViewDescriptor* lhs, const ResourceViewDescriptor* rhs)
+        {
+            return (lhs->slot < rhs->slot);
+        }
+    );
+
+    std::size_t offset = 0;
+
+    for (auto resourceView : resourceViews)
+    {
+        const auto slot = static_cast<GLuint>(resourceView->slot);
+
+        if (!segments.empty() && segments.back().first + static_cast<GLuint>(segments.back().count) == slot)
+        {
+            /* Append resource to previous segment */
+            ++segments.back().count;
+        }
+        else
+        {
+            /* Start new segment */
+            segments.push_back({ slot, 1, offset });
+        }
+
+        appendResource(*resourceView);
+        ++offset;
+    }
+}
+
+GLResourceHeap::GLResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    /* Build segments for constant buffers */
+    BuildSegments(
+        desc, ResourceType::ConstantBuffer, uboSegments_,
+        [&](const ResourceViewDescriptor& resourceView)
+        {
+            auto bufferGL = LLGL_CAST(GLBuffer*, resourceView.buffer);
+            uboIDs_.push_back(bufferGL->GetID());
+        }
+    );
+
+    /* Build segments for storage buffers */
+    BuildSegments(
+        desc, ResourceType::StorageBuffer, ssboSegments_,
+        [&](const ResourceViewDescriptor& resourceView)
+        {
+            auto bufferGL = LLGL_CAST(GLStorageBuffer*, resourceView.buffer);
+            ssboIDs_.push_back(bufferGL->GetID());
+            if (auto counterID = bufferGL->GetCounterID())
+                counterBindings_.push_back({ static_cast<GLuint>(resourceView.slot), counterID });
+        }
+    );
+
+    /* Build segments for textures */
+    BuildSegments(
+        desc, ResourceType::Texture, textureSegments_,
+        [&](const ResourceViewDescriptor& resourceView)
+        {
+            auto textureGL = LLGL_CAST(GLTexture*, resourceView.texture);
+            textureIDs_.push_back(textureGL->GetID());
+            textureTargets_.push_back(GLStateManager::GetTextureTarget(textureGL->GetType()));
+        }
+    );
+
+    /* Build segments for samplers */
+    BuildSegments(
+        desc, ResourceType::Sampler, samplerSegments_,
+        [&](const ResourceViewDescriptor& resourceView)
+        {
+            auto samplerGL = LLGL_CAST(GLSampler*, resourceView.sampler);
+            samplerIDs_.push_back(samplerGL->GetID());
+        }
+    );
+}
+
+void GLResourceHeap::Bind(GLStateManager& stateMngr) const
+{
+    for (const auto& segment : uboSegments_)
+        stateMngr.BindBuffersBase(GLBufferTarget::UNIFORM_BUFFER, segment.first, segment.count, &uboIDs_[segment.offset]);
+
+    for (const auto& segment : ssboSegments_)
+        stateMngr.BindBuffersBase(GLBufferTarget::SHADER_STORAGE_BUFFER, segment.first, segment.count, &ssboIDs_[segment.offset]);
+
+    for (const auto& binding : counterBindings_)
+        stateMngr.BindBufferBase(GLBufferTarget::ATOMIC_COUNTER_BUFFER, binding.slot, binding.id);
+
+    for (const auto& segment : textureSegments_)
+        stateMngr.BindTextures(segment.first, segment.count, &textureTargets_[segment.offset], &textureIDs_[segment.offset]);
+
+    for (const auto& segment : samplerSegments_)
+        stateMngr.BindSamplers(segment.first, static_cast<unsigned int>(segment.count), &samplerIDs_[segment.offset]);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
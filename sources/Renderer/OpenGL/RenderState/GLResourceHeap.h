@@ -0,0 +1,73 @@
+/*
+ * GLResourceHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_RESOURCE_HEAP_H
+#define LLGL_GL_RESOURCE_HEAP_H
+
+
+#include <LLGL/ResourceHeap.h>
+#include "GLStateManager.h"
+#include "../OpenGL.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Range of consecutive binding slots, whose resources are stored at 'offset' in the respective ID array.
+struct GLResourceBindingSegment
+{
+    GLuint      first;
+    GLsizei     count;
+    std::size_t offset;
+};
+
+// Atomic counter buffer, which is bound to the same slot as its storage buffer.
+struct GLCounterBinding
+{
+    GLuint      slot;
+    GLuint      id;
+};
+
+class GLResourceHeap : public ResourceHeap
+{
+
+    public:
+
+        GLResourceHeap(const ResourceHeapDescriptor& desc);
+
+        // Binds all resources of this heap with the specified state manager.
+        void Bind(GLStateManager& stateMngr) const;
+
+    private:
+
+        std::vector<GLResourceBindingSegment>   uboSegments_;
+        std::vector<GLuint>                     uboIDs_;
+
+        std::vector<GLResourceBindingSegment>   ssboSegments_;
+        std::vector<GLuint>                     ssboIDs_;
+        std::vector<GLCounterBinding>           counterBindings_;
+
+        std::vector<GLResourceBindingSegment>   textureSegments_;
+        std::vector<GLuint>                     textureIDs_;
+        std::vector<GLTextureTarget>            textureTargets_;
+
+        std::vector<GLResourceBindingSegment>   samplerSegments_;
+        std::vector<GLuint>                     samplerIDs_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -11,6 +11,7 @@
 
 #include "../OpenGL.h"
 #include <LLGL/ColorRGBA.h>
+#include <cstdint>
 
 
 namespace LLGL
@@ -59,6 +60,7 @@ enum class GLState
 enum class GLStateExt
 {
     CONSERVATIVE_RASTERIZATION = 0, // either NV or INTEL extension
+    SHADING_RATE_IMAGE,             // NV extension only
 };
 
 #endif
@@ -150,6 +152,22 @@ struct GLBlend
     ColorRGBAT<GLboolean>   colorMask   = { GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE };
 };
 
+/*
+Packed render states of a graphics pipeline. Each state group is packed into one or more 32-bit words,
+so the groups that differ between two pipelines can be determined by comparing their words (see GLGraphicsPipeline::Bind).
+*/
+struct GLPipelineStateBlock
+{
+    static const std::size_t maxNumBlendTargets = 8;
+
+    std::uint32_t   rasterizer                      = 0;    // polygon mode, cull mode, front face, and boolean states
+    std::uint32_t   patchVertices                   = 0;
+    std::uint32_t   depth                           = 0;    // test enabled, write mask, and compare function
+    std::uint32_t   stencil[7]                      = {};   // test enabled and operations of both faces, followed by reference and masks of each face
+    std::uint32_t   blend[1 + maxNumBlendTargets]   = {};   // blend enabled and number of targets, followed by one word per target
+    std::uint32_t   blendColor[5]                   = {};   // blend color needed, followed by the RGBA components
+};
+
 
 } // /namespace LLGL
 
@@ -12,11 +12,26 @@
 #include "../../Assertion.h"
 #include "../../../Core/Helper.h"
 
+#ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+#include <LLGL/RenderingProfiler.h>
+#endif
+
 
 namespace LLGL
 {
 
 
+/* ----- Internal macros ----- */
+
+#ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+#define LLGL_GL_COUNT_CACHE(CATEGORY, MISS) \
+    CountCache(CacheCategory::CATEGORY, (MISS))
+#else
+#define LLGL_GL_COUNT_CACHE(CATEGORY, MISS) \
+    ((void)0)
+#endif
+
+
 /* ----- Internal constants ---- */
 
 static const GLenum stateCapsMap[] =
@@ -105,7 +120,7 @@ static const GLenum textureLayersMap[] =
 
 /* ----- Common ----- */
 
-GLStateManager* GLStateManager::active = nullptr;
+thread_local GLStateManager* GLStateManager::active = nullptr;
 
 GLStateManager::GLStateManager()
 {
@@ -118,6 +133,11 @@ GLStateManager::GLStateManager()
     for (auto& layer : textureState_.layers)
         Fill(layer.boundTextures, 0);
 
+    #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+    Fill(cacheHits_, 0);
+    Fill(cacheMisses_, 0);
+    #endif
+
     SetActiveTextureLayer(0);
 
     /* Make this to the active state manager */
@@ -150,6 +170,11 @@ void GLStateManager::DetermineExtensions()
     InitStateExt(GLStateExt::CONSERVATIVE_RASTERIZATION, GLExt::INTEL_conservative_rasterization, GL_CONSERVATIVE_RASTERIZATION_INTEL);
     #endif
 
+    #ifdef GL_NV_shading_rate_image
+    // see https://www.khronos.org/registry/OpenGL/extensions/NV/NV_shading_rate_image.txt
+    InitStateExt(GLStateExt::SHADING_RATE_IMAGE, GLExt::NV_shading_rate_image, GL_SHADING_RATE_IMAGE_NV);
+    #endif
+
     #endif
 }
 
@@ -198,11 +223,15 @@ void GLStateManager::Reset()
     /* Query all states from OpenGL */
     for (std::size_t i = 0; i < numStates; ++i)
         renderState_.values[i] = (glIsEnabled(stateCapsMap[i]) != GL_FALSE);
+
+    /* States of the previous graphics pipeline are no longer known */
+    InvalidatePipelineState();
 }
 
 void GLStateManager::Set(GLState state, bool value)
 {
     auto idx = static_cast<std::size_t>(state);
+    LLGL_GL_COUNT_CACHE(Capability, renderState_.values[idx] != value);
     if (renderState_.values[idx] != value)
     {
         renderState_.values[idx] = value;
@@ -216,6 +245,7 @@ void GLStateManager::Set(GLState state, bool value)
 void GLStateManager::Enable(GLState state)
 {
     auto idx = static_cast<std::size_t>(state);
+    LLGL_GL_COUNT_CACHE(Capability, !renderState_.values[idx]);
     if (!renderState_.values[idx])
     {
         renderState_.values[idx] = true;
@@ -226,6 +256,7 @@ void GLStateManager::Enable(GLState state)
 void GLStateManager::Disable(GLState state)
 {
     auto idx = static_cast<std::size_t>(state);
+    LLGL_GL_COUNT_CACHE(Capability, renderState_.values[idx]);
     if (renderState_.values[idx])
     {
         renderState_.values[idx] = false;
@@ -331,47 +362,38 @@ void GLStateManager::SetViewport(GLViewport& viewport)
     );
 }
 
-void GLStateManager::SetViewportArray(std::vector<GLViewport>&& viewports)
+void GLStateManager::SetViewportArray(GLsizei count, GLViewport* viewports)
 {
-    if (viewports.size() > 1)
+    if (count > 1)
     {
         AssertExtViewportArray();
 
         if (emulateClipControl_ && !gfxDependentState_.stateOpenGL.screenSpaceOriginLowerLeft)
         {
-            for (auto& vp : viewports)
-                AdjustViewport(vp);
+            for (GLsizei i = 0; i < count; ++i)
+                AdjustViewport(viewports[i]);
         }
 
-        glViewportArrayv(
-            0,
-            static_cast<GLsizei>(viewports.size()),
-            reinterpret_cast<const GLfloat*>(viewports.data())
-        );
+        glViewportArrayv(0, count, reinterpret_cast<const GLfloat*>(viewports));
     }
-    else if (viewports.size() == 1)
-        SetViewport(viewports.front());
+    else if (count == 1)
+        SetViewport(viewports[0]);
 }
 
-void GLStateManager::SetDepthRange(GLDepthRange& depthRange)
+void GLStateManager::SetDepthRange(const GLDepthRange& depthRange)
 {
     glDepthRange(depthRange.minDepth, depthRange.maxDepth);
 }
 
-void GLStateManager::SetDepthRangeArray(std::vector<GLDepthRange>&& depthRanges)
+void GLStateManager::SetDepthRangeArray(GLsizei count, const GLDepthRange* depthRanges)
 {
-    if (depthRanges.size() > 1)
+    if (count > 1)
     {
         AssertExtViewportArray();
-
-        glDepthRangeArrayv(
-            0,
-            static_cast<GLsizei>(depthRanges.size()),
-            reinterpret_cast<const GLdouble*>(depthRanges.data())
-        );
+        glDepthRangeArrayv(0, count, reinterpret_cast<const GLdouble*>(depthRanges));
     }
-    else if (depthRanges.size() == 1)
-        SetDepthRange(depthRanges.front());
+    else if (count == 1)
+        SetDepthRange(depthRanges[0]);
 }
 
 //private
@@ -388,26 +410,22 @@ void GLStateManager::SetScissor(GLScissor& scissor)
     glScissor(scissor.x, scissor.y, scissor.width, scissor.height);
 }
 
-void GLStateManager::SetScissorArray(std::vector<GLScissor>&& scissors)
+void GLStateManager::SetScissorArray(GLsizei count, GLScissor* scissors)
 {
-    if (scissors.size() > 1)
+    if (count > 1)
     {
         AssertExtViewportArray();
 
         if (emulateClipControl_)
         {
-            for (auto& sc : scissors)
-                AdjustScissor(sc);
+            for (GLsizei i = 0; i < count; ++i)
+                AdjustScissor(scissors[i]);
         }
 
-        glScissorArrayv(
-            0,
-            static_cast<GLsizei>(scissors.size()),
-            reinterpret_cast<const GLint*>(scissors.data())
-        );
+        glScissorArrayv(0, count, reinterpret_cast<const GLint*>(scissors));
     }
-    else if (scissors.size() == 1)
-        SetScissor(scissors.front());
+    else if (count == 1)
+        SetScissor(scissors[0]);
 }
 
 void GLStateManager::SetBlendStates(const std::vector<GLBlend>& blendStates, bool blendEnabled)
@@ -473,6 +491,7 @@ void GLStateManager::SetClipControl(GLenum origin, GLenum depth)
 
 void GLStateManager::SetDepthFunc(GLenum func)
 {
+    LLGL_GL_COUNT_CACHE(RenderState, commonState_.depthFunc != func);
     if (commonState_.depthFunc != func)
     {
         commonState_.depthFunc = func;
@@ -499,6 +518,7 @@ void GLStateManager::SetStencilState(GLenum face, const GLStencil& state)
 
 void GLStateManager::SetStencilState(GLenum face, GLStencil& to, const GLStencil& from)
 {
+    LLGL_GL_COUNT_CACHE(RenderState, to.sfail != from.sfail || to.dpfail != from.dpfail || to.dppass != from.dppass);
     if (to.sfail != from.sfail || to.dpfail != from.dpfail || to.dppass != from.dppass)
     {
         to.sfail    = from.sfail;
@@ -507,6 +527,7 @@ void GLStateManager::SetStencilState(GLenum face, GLStencil& to, const GLStencil
         glStencilOpSeparate(face, to.sfail, to.dpfail, to.dppass);
     }
 
+    LLGL_GL_COUNT_CACHE(RenderState, to.func != from.func || to.ref != from.ref || to.mask != from.mask);
     if (to.func != from.func || to.ref != from.ref || to.mask != from.mask)
     {
         to.func = from.func;
@@ -515,6 +536,7 @@ void GLStateManager::SetStencilState(GLenum face, GLStencil& to, const GLStencil
         glStencilFuncSeparate(face, to.func, to.ref, to.mask);
     }
 
+    LLGL_GL_COUNT_CACHE(RenderState, to.writeMask != from.writeMask);
     if (to.writeMask != from.writeMask)
     {
         to.writeMask = from.writeMask;
@@ -524,6 +546,7 @@ void GLStateManager::SetStencilState(GLenum face, GLStencil& to, const GLStencil
 
 void GLStateManager::SetPolygonMode(GLenum mode)
 {
+    LLGL_GL_COUNT_CACHE(RenderState, commonState_.polygonMode != mode);
     if (commonState_.polygonMode != mode)
     {
         commonState_.polygonMode = mode;
@@ -533,6 +556,7 @@ void GLStateManager::SetPolygonMode(GLenum mode)
 
 void GLStateManager::SetCullFace(GLenum face)
 {
+    LLGL_GL_COUNT_CACHE(RenderState, commonState_.cullFace != face);
     if (commonState_.cullFace != face)
     {
         commonState_.cullFace = face;
@@ -550,6 +574,7 @@ void GLStateManager::SetFrontFace(GLenum mode)
         mode = (mode == GL_CW ? GL_CCW : GL_CW);
 
     /* Set front face */
+    LLGL_GL_COUNT_CACHE(RenderState, commonState_.frontFace != mode);
     if (commonState_.frontFace != mode)
     {
         commonState_.frontFace = mode;
@@ -559,6 +584,7 @@ void GLStateManager::SetFrontFace(GLenum mode)
 
 void GLStateManager::SetDepthMask(GLboolean flag)
 {
+    LLGL_GL_COUNT_CACHE(RenderState, commonState_.depthMask != flag);
     if (commonState_.depthMask != flag)
     {
         commonState_.depthMask = flag;
@@ -566,8 +592,24 @@ void GLStateManager::SetDepthMask(GLboolean flag)
     }
 }
 
+void GLStateManager::SetDepthBoundsTest(bool enabled)
+{
+    #ifdef GL_EXT_depth_bounds_test
+    LLGL_GL_COUNT_CACHE(RenderState, commonState_.depthBoundsTest != enabled);
+    if (commonState_.depthBoundsTest != enabled)
+    {
+        commonState_.depthBoundsTest = enabled;
+        if (enabled)
+            glEnable(GL_DEPTH_BOUNDS_TEST_EXT);
+        else
+            glDisable(GL_DEPTH_BOUNDS_TEST_EXT);
+    }
+    #endif
+}
+
 void GLStateManager::SetPatchVertices(GLint patchVertices)
 {
+    LLGL_GL_COUNT_CACHE(RenderState, commonState_.patchVertices_ != patchVertices);
     if (commonState_.patchVertices_ != patchVertices)
     {
         commonState_.patchVertices_ = patchVertices;
@@ -577,6 +619,7 @@ void GLStateManager::SetPatchVertices(GLint patchVertices)
 
 void GLStateManager::SetBlendColor(const ColorRGBAf& color)
 {
+    LLGL_GL_COUNT_CACHE(RenderState, !Gs::Equals(color, commonState_.blendColor));
     if (!Gs::Equals(color, commonState_.blendColor))
     {
         commonState_.blendColor = color;
@@ -586,6 +629,7 @@ void GLStateManager::SetBlendColor(const ColorRGBAf& color)
 
 void GLStateManager::SetLogicOp(GLenum opcode)
 {
+    LLGL_GL_COUNT_CACHE(RenderState, commonState_.logicOpCode != opcode);
     if (commonState_.logicOpCode != opcode)
     {
         commonState_.logicOpCode = opcode;
@@ -593,12 +637,31 @@ void GLStateManager::SetLogicOp(GLenum opcode)
     }
 }
 
+/* ----- Graphics pipeline ----- */
+
+const GLPipelineStateBlock* GLStateManager::GetPipelineState() const
+{
+    return (pipelineStateValid_ ? &pipelineState_ : nullptr);
+}
+
+void GLStateManager::SetPipelineState(const GLPipelineStateBlock& stateBlock)
+{
+    pipelineState_      = stateBlock;
+    pipelineStateValid_ = true;
+}
+
+void GLStateManager::InvalidatePipelineState()
+{
+    pipelineStateValid_ = false;
+}
+
 /* ----- Buffer ----- */
 
 void GLStateManager::BindBuffer(GLBufferTarget target, GLuint buffer)
 {
     /* Only bind buffer if the buffer has changed */
     auto targetIdx = static_cast<std::size_t>(target);
+    LLGL_GL_COUNT_CACHE(Buffer, bufferState_.boundBuffers[targetIdx] != buffer);
     if (bufferState_.boundBuffers[targetIdx] != buffer)
     {
         glBindBuffer(bufferTargetsMap[targetIdx], buffer);
@@ -614,6 +677,14 @@ void GLStateManager::BindBufferBase(GLBufferTarget target, GLuint index, GLuint
     bufferState_.boundBuffers[targetIdx] = buffer;
 }
 
+void GLStateManager::BindBufferRange(GLBufferTarget target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    /* Always bind buffer with a range */
+    auto targetIdx = static_cast<std::size_t>(target);
+    glBindBufferRange(bufferTargetsMap[targetIdx], index, buffer, offset, size);
+    bufferState_.boundBuffers[targetIdx] = buffer;
+}
+
 void GLStateManager::BindBuffersBase(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers)
 {
     /* Always bind buffers with a base index */
@@ -648,6 +719,7 @@ void GLStateManager::BindBuffersBase(GLBufferTarget target, GLuint first, GLsize
 void GLStateManager::BindVertexArray(GLuint vertexArray)
 {
     /* Only bind VAO if it has changed */
+    LLGL_GL_COUNT_CACHE(VertexArray, vertexArrayState_.boundVertexArray != vertexArray);
     if (vertexArrayState_.boundVertexArray != vertexArray)
     {
         /* Bind VAO */
@@ -671,6 +743,24 @@ void GLStateManager::BindVertexArray(GLuint vertexArray)
     }
 }
 
+void GLStateManager::BindVertexBuffers(GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizei* strides)
+{
+    /* Always bind vertex buffers, since their bindings are part of the VAO state */
+    #ifdef GL_ARB_multi_bind
+    if (count > 1 && HasExtension(GLExt::ARB_multi_bind))
+    {
+        glBindVertexBuffers(first, count, buffers, offsets, strides);
+    }
+    else
+    #endif
+    {
+        #ifdef GL_ARB_vertex_attrib_binding
+        while (count-- > 0)
+            glBindVertexBuffer(first++, *(buffers++), *(offsets++), *(strides++));
+        #endif
+    }
+}
+
 void GLStateManager::DeferredBindIndexBuffer(GLuint buffer)
 {
     /* Always store buffer ID to bind the index buffer the next time "BindVertexArray" is called */
@@ -724,6 +814,7 @@ void GLStateManager::BindFramebuffer(GLFramebufferTarget target, GLuint framebuf
 {
     /* Only bind framebuffer if the framebuffer has changed */
     auto targetIdx = static_cast<std::size_t>(target);
+    LLGL_GL_COUNT_CACHE(Framebuffer, framebufferState_.boundFramebuffers[targetIdx] != framebuffer);
     if (framebufferState_.boundFramebuffers[targetIdx] != framebuffer)
     {
         framebufferState_.boundFramebuffers[targetIdx] = framebuffer;
@@ -735,6 +826,7 @@ void GLStateManager::BindFramebuffer(GLFramebufferTarget target, GLuint framebuf
 
 void GLStateManager::BindRenderbuffer(GLuint renderbuffer)
 {
+    LLGL_GL_COUNT_CACHE(Framebuffer, renderbufferState_.boundRenderbuffer != renderbuffer);
     if (renderbufferState_.boundRenderbuffer != renderbuffer)
     {
         renderbufferState_.boundRenderbuffer = renderbuffer;
@@ -780,6 +872,7 @@ void GLStateManager::BindTexture(GLTextureTarget target, GLuint texture)
 {
     /* Only bind texutre if the texture has changed */
     auto targetIdx = static_cast<std::size_t>(target);
+    LLGL_GL_COUNT_CACHE(Texture, activeTextureLayer_->boundTextures[targetIdx] != texture);
     if (activeTextureLayer_->boundTextures[targetIdx] != texture)
     {
         activeTextureLayer_->boundTextures[targetIdx] = texture;
@@ -789,33 +882,59 @@ void GLStateManager::BindTexture(GLTextureTarget target, GLuint texture)
 
 void GLStateManager::BindTextures(GLuint first, GLsizei count, const GLTextureTarget* targets, const GLuint* textures)
 {
+    #ifdef LLGL_DEBUG
+    LLGL_ASSERT_RANGE(first + count, numTextureLayers + 1);
+    #endif
+
     #ifdef GL_ARB_multi_bind
     if (HasExtension(GLExt::ARB_multi_bind))
     {
+        /* Skip unchanged layers at the front and back of the range */
+        GLsizei begin = 0, end = count;
+
+        while (begin < end && IsTextureBound(first + begin, targets[begin], textures[begin]))
+            ++begin;
+        while (end > begin && IsTextureBound(first + end - 1, targets[end - 1], textures[end - 1]))
+            --end;
+
+        #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+        CountCache(CacheCategory::Texture, false, static_cast<std::uint64_t>(count - (end - begin)));
+        CountCache(CacheCategory::Texture, true, static_cast<std::uint64_t>(end - begin));
+        #endif
+
+        if (begin == end)
+            return;
+
         /* Store bound textures */
-        for (GLsizei i = 0; i < count; ++i)
+        for (auto i = begin; i < end; ++i)
         {
-            auto targetIdx = static_cast<std::size_t>(targets[i]);
-            textureState_.layers[i].boundTextures[targetIdx] = textures[i];
+            auto& boundTextures = textureState_.layers[first + i].boundTextures;
+            if (textures[i] == 0)
+                Fill(boundTextures, 0);
+            else
+                boundTextures[static_cast<std::size_t>(targets[i])] = textures[i];
         }
 
         /*
-        Bind all textures at once, but don't reset the currently active texture layer.
+        Bind the changed sub-range of textures at once, but don't reset the currently active texture layer.
         The spec. of GL_ARB_multi_bind says, that the active texture slot is not modified by this function!
         */
-        glBindTextures(first, count, textures);
+        glBindTextures(first + begin, end - begin, textures + begin);
     }
     else
     #endif
     {
-        /* Bind each texture layer individually */
-        while (count-- > 0)
+        /* Bind each changed texture layer individually */
+        for (GLsizei i = 0; i < count; ++i)
         {
-            ActiveTexture(first);
-            BindTexture(*targets, *textures);
-            ++targets;
-            ++textures;
-            ++first;
+            auto targetIdx = static_cast<std::size_t>(targets[i]);
+            if (textureState_.layers[first + i].boundTextures[targetIdx] != textures[i])
+            {
+                ActiveTexture(first + i);
+                BindTexture(targets[i], textures[i]);
+            }
+            else
+                LLGL_GL_COUNT_CACHE(Texture, false);
         }
     }
 }
@@ -876,6 +995,7 @@ void GLStateManager::BindSampler(unsigned int layer, GLuint sampler)
     LLGL_ASSERT_RANGE(layer, numTextureLayers);
     #endif
 
+    LLGL_GL_COUNT_CACHE(Sampler, samplerState_.boundSamplers[layer] != sampler);
     if (samplerState_.boundSamplers[layer] != sampler)
     {
         samplerState_.boundSamplers[layer] = sampler;
@@ -885,15 +1005,36 @@ void GLStateManager::BindSampler(unsigned int layer, GLuint sampler)
 
 void GLStateManager::BindSamplers(unsigned int first, unsigned int count, const GLuint* samplers)
 {
+    #ifdef LLGL_DEBUG
+    LLGL_ASSERT_RANGE(first + count, numTextureLayers + 1);
+    #endif
+
     #ifdef GL_ARB_multi_bind
     if (HasExtension(GLExt::ARB_multi_bind))
     {
-        /* Bind all samplers at once */
-        glBindSamplers(first, static_cast<GLsizei>(count), samplers);
+        /* Skip unchanged samplers at the front and back of the range */
+        auto boundSamplers = &(samplerState_.boundSamplers[first]);
+        unsigned int begin = 0, end = count;
 
-        /* Store bound textures */
-        for (unsigned int i = 0; i < count; ++i)
-            samplerState_.boundSamplers[i] = samplers[i];
+        while (begin < end && boundSamplers[begin] == samplers[begin])
+            ++begin;
+        while (end > begin && boundSamplers[end - 1] == samplers[end - 1])
+            --end;
+
+        #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+        CountCache(CacheCategory::Sampler, false, count - (end - begin));
+        CountCache(CacheCategory::Sampler, true, end - begin);
+        #endif
+
+        if (begin == end)
+            return;
+
+        /* Bind the changed sub-range of samplers at once */
+        glBindSamplers(first + begin, static_cast<GLsizei>(end - begin), samplers + begin);
+
+        /* Store bound samplers */
+        for (auto i = begin; i < end; ++i)
+            boundSamplers[i] = samplers[i];
     }
     else
     #endif
@@ -908,6 +1049,7 @@ void GLStateManager::BindSamplers(unsigned int first, unsigned int count, const
 
 void GLStateManager::BindShaderProgram(GLuint program)
 {
+    LLGL_GL_COUNT_CACHE(Program, shaderState_.boundProgram != program);
     if (shaderState_.boundProgram != program)
     {
         shaderState_.boundProgram = program;
@@ -926,6 +1068,68 @@ void GLStateManager::PopShaderProgram()
     shaderState_.boundProgramStack.pop();
 }
 
+void GLStateManager::BindProgramPipeline(GLuint pipeline)
+{
+    LLGL_GL_COUNT_CACHE(Program, shaderState_.boundProgramPipeline != pipeline);
+    if (shaderState_.boundProgramPipeline != pipeline)
+    {
+        shaderState_.boundProgramPipeline = pipeline;
+        glBindProgramPipeline(pipeline);
+    }
+}
+
+void GLStateManager::NotifyProgramPipelineRelease(GLuint pipeline)
+{
+    /* A deleted program pipeline is unbound implicitly */
+    if (shaderState_.boundProgramPipeline == pipeline)
+        shaderState_.boundProgramPipeline = 0;
+}
+
+/* ----- Draw merging ----- */
+
+void GLStateManager::SetPendingDrawMerger(GLDrawMerger* drawMerger)
+{
+    if (pendingDrawMerger_ != drawMerger)
+    {
+        FlushPendingDraws();
+        pendingDrawMerger_ = drawMerger;
+    }
+}
+
+#ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+
+/* ----- State cache statistics ----- */
+
+void GLStateManager::ReportCacheStatistics(RenderingProfiler& profiler)
+{
+    static const char* categoryNames[numCacheCategories] =
+    {
+        "Capability",
+        "Buffer",
+        "VertexArray",
+        "Framebuffer",
+        "Texture",
+        "Sampler",
+        "Program",
+        "RenderState",
+    };
+
+    for (std::size_t i = 0; i < numCacheCategories; ++i)
+    {
+        RenderingProfiler::StateCacheUsage usage;
+        {
+            usage.hits      = cacheHits_[i];
+            usage.misses    = cacheMisses_[i];
+        }
+        profiler.ReportStateCache(categoryNames[i], usage);
+    }
+
+    Fill(cacheHits_, 0);
+    Fill(cacheMisses_, 0);
+}
+
+#endif // /LLGL_GL_ENABLE_STATE_CACHE_STATS
+
 
 /*
  * ======= Private: =======
@@ -943,6 +1147,30 @@ void GLStateManager::SetActiveTextureLayer(unsigned int layer)
     activeTextureLayer_ = &(textureState_.layers[textureState_.activeTexture]);
 }
 
+void GLStateManager::FlushPendingDrawMerger()
+{
+    /* Reset pending draw merger before flushing, since its draw commands are submitted directly */
+    auto drawMerger = pendingDrawMerger_;
+    pendingDrawMerger_ = nullptr;
+    drawMerger->Flush();
+}
+
+bool GLStateManager::IsTextureBound(GLuint layer, GLTextureTarget target, GLuint texture) const
+{
+    const auto& boundTextures = textureState_.layers[layer].boundTextures;
+    if (texture == 0)
+    {
+        /* Binding texture 0 with GL_ARB_multi_bind unbinds all targets of that layer */
+        for (auto boundTexture : boundTextures)
+        {
+            if (boundTexture != 0)
+                return false;
+        }
+        return true;
+    }
+    return (boundTextures[static_cast<std::size_t>(target)] == texture);
+}
+
 
 } // /namespace LLGL
 
@@ -12,16 +12,19 @@
 #include "GLState.h"
 #include "../Buffer/GLBuffer.h"
 #include "../Texture/GLTexture.h"
+#include "GLStateStack.h"
+#include "GLDrawMerger.h"
 #include <LLGL/RenderContextFlags.h>
 #include <array>
 #include <vector>
-#include <stack>
 
 
 namespace LLGL
 {
 
 
+class RenderingProfiler;
+
 // OpenGL state machine manager that tries to reduce GL state changes.
 class GLStateManager
 {
@@ -32,8 +35,8 @@ class GLStateManager
 
         GLStateManager();
 
-        // Active state manager. Each GL context has its own states, thus its own state manager.
-        static GLStateManager* active;
+        // Active state manager of the calling thread. Each GL context has its own states, thus its own state manager.
+        static thread_local GLStateManager* active;
 
         void DetermineExtensions();
 
@@ -42,6 +45,11 @@ class GLStateManager
 
         void SetGraphicsAPIDependentState(const GraphicsAPIDependentStateDescriptor& state);
 
+        inline const GraphicsAPIDependentStateDescriptor& GetGraphicsAPIDependentState() const
+        {
+            return gfxDependentState_;
+        }
+
         /* ----- Boolean states ----- */
 
         //! Resets all internal states by querying the values from OpenGL.
@@ -70,13 +78,13 @@ class GLStateManager
         /* ----- Common states ----- */
 
         void SetViewport(GLViewport& viewport);
-        void SetViewportArray(std::vector<GLViewport>&& viewports);
+        void SetViewportArray(GLsizei count, GLViewport* viewports);
 
-        void SetDepthRange(GLDepthRange& depthRange);
-        void SetDepthRangeArray(std::vector<GLDepthRange>&& depthRanges);
+        void SetDepthRange(const GLDepthRange& depthRange);
+        void SetDepthRangeArray(GLsizei count, const GLDepthRange* depthRanges);
 
         void SetScissor(GLScissor& scissor);
-        void SetScissorArray(std::vector<GLScissor>&& scissors);
+        void SetScissorArray(GLsizei count, GLScissor* scissors);
 
         void SetBlendStates(const std::vector<GLBlend>& blendStates, bool blendEnabled);
 
@@ -87,18 +95,37 @@ class GLStateManager
         void SetCullFace(GLenum face);
         void SetFrontFace(GLenum mode);
         void SetDepthMask(GLboolean flag);
+        void SetDepthBoundsTest(bool enabled);
         void SetPatchVertices(GLint patchVertices);
         void SetBlendColor(const ColorRGBAf& color);
         void SetLogicOp(GLenum opcode);
 
+        /* ----- Graphics pipeline ----- */
+
+        // Returns the packed states of the graphics pipeline that was bound last, or null if these states have been invalidated.
+        const GLPipelineStateBlock* GetPipelineState() const;
+
+        // Stores the packed states of the graphics pipeline that has just been bound.
+        void SetPipelineState(const GLPipelineStateBlock& stateBlock);
+
+        // Invalidates the stored pipeline states. This must be called whenever any state of a graphics pipeline is changed outside of GLGraphicsPipeline::Bind.
+        void InvalidatePipelineState();
+
         /* ----- Buffer ----- */
 
         void BindBuffer(GLBufferTarget target, GLuint buffer);
         void BindBufferBase(GLBufferTarget target, GLuint index, GLuint buffer);
+        void BindBufferRange(GLBufferTarget target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
         void BindBuffersBase(GLBufferTarget target, GLuint first, GLsizei count, const GLuint* buffers);
 
         void BindVertexArray(GLuint vertexArray);
 
+        /**
+        \brief Binds the specified vertex buffers to the consecutive binding points of the currently bound VAO.
+        \remarks This requires GL_ARB_vertex_attrib_binding and uses GL_ARB_multi_bind if available.
+        */
+        void BindVertexBuffers(GLuint first, GLsizei count, const GLuint* buffers, const GLintptr* offsets, const GLsizei* strides);
+
         /**
         \brief Binds the specified index buffer as soon as the next VAO with "BindVertexArray" is bound.
         \see BindVertexArray
@@ -125,6 +152,12 @@ class GLStateManager
         void ActiveTexture(unsigned int layer);
 
         void BindTexture(GLTextureTarget target, GLuint texture);
+
+        /**
+        \brief Binds the specified textures to the consecutive texture layers, beginning at 'first'.
+        \remarks Layers that already have the respective texture bound are skipped, and with GL_ARB_multi_bind
+        only the changed sub-range (from the first to the last changed layer) is submitted with a single call.
+        */
         void BindTextures(GLuint first, GLsizei count, const GLTextureTarget* targets, const GLuint* textures);
         
         void PushBoundTexture(unsigned int layer, GLTextureTarget target);
@@ -138,6 +171,12 @@ class GLStateManager
         /* ----- Sampler ----- */
 
         void BindSampler(unsigned int layer, GLuint sampler);
+
+        /**
+        \brief Binds the specified samplers to the consecutive texture layers, beginning at 'first'.
+        \remarks Like BindTextures, only the changed sub-range is submitted with GL_ARB_multi_bind.
+        \see BindTextures
+        */
         void BindSamplers(unsigned int first, unsigned int count, const GLuint* samplers);
 
         /* ----- Shader ----- */
@@ -147,8 +186,52 @@ class GLStateManager
         void PushShaderProgram();
         void PopShaderProgram();
 
+        // Binds the specified program pipeline (requires GL_ARB_separate_shader_objects). It is only used while no shader program is bound.
+        void BindProgramPipeline(GLuint pipeline);
+
+        // Invalidates the program pipeline binding if the specified pipeline is about to be deleted.
+        void NotifyProgramPipelineRelease(GLuint pipeline);
+
+        /* ----- Draw merging ----- */
+
+        // Sets the draw merger whose queued draw commands are flushed before any other command. A previous draw merger is flushed first.
+        void SetPendingDrawMerger(GLDrawMerger* drawMerger);
+
+        // Flushes the queued draw commands of the pending draw merger. This must be called before any command other than a mergeable draw command.
+        inline void FlushPendingDraws()
+        {
+            if (pendingDrawMerger_ != nullptr)
+                FlushPendingDrawMerger();
+        }
+
+        #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+
+        /* ----- State cache statistics ----- */
+
+        // Adds the hit and miss counts of this state manager to the specified profiler and resets them.
+        void ReportCacheStatistics(RenderingProfiler& profiler);
+
+        #endif
+
     private:
 
+        #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+
+        // Categories of state changes, for which the hits and misses of the state cache are counted separately.
+        enum class CacheCategory
+        {
+            Capability,     // glEnable/glDisable
+            Buffer,         // glBindBuffer
+            VertexArray,    // glBindVertexArray
+            Framebuffer,    // glBindFramebuffer/glBindRenderbuffer
+            Texture,        // glBindTexture/glBindTextures
+            Sampler,        // glBindSampler/glBindSamplers
+            Program,        // glUseProgram/glBindProgramPipeline
+            RenderState,    // glDepthFunc, glStencil*, glCullFace, glBlendColor etc.
+        };
+
+        #endif
+
         /* ----- Functions ----- */
 
         void SetStencilState(GLenum face, GLStencil& to, const GLStencil& from);
@@ -160,6 +243,22 @@ class GLStateManager
 
         void SetActiveTextureLayer(unsigned int layer);
 
+        // Returns true if the specified texture is already bound to the specified layer and target (for diffing multi-bind ranges).
+        bool IsTextureBound(GLuint layer, GLTextureTarget target, GLuint texture) const;
+
+        void FlushPendingDrawMerger();
+
+        #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+
+        // Counts a state change as hit (if it was filtered out) or as miss (if it was submitted to GL).
+        inline void CountCache(CacheCategory category, bool miss, std::uint64_t count = 1)
+        {
+            auto& counts = (miss ? cacheMisses_ : cacheHits_);
+            counts[static_cast<std::size_t>(category)] += count;
+        }
+
+        #endif
+
         /* ----- Constants ----- */
 
         static const unsigned int numTextureLayers      = 32;
@@ -169,7 +268,11 @@ class GLStateManager
         static const unsigned int numTextureTargets     = (static_cast<unsigned int>(GLTextureTarget::TEXTURE_2D_MULTISAMPLE_ARRAY) + 1);
 
         #ifdef LLGL_GL_ENABLE_VENDOR_EXT
-        static const unsigned int numStatesExt          = (static_cast<unsigned int>(GLStateExt::CONSERVATIVE_RASTERIZATION) + 1);
+        static const unsigned int numStatesExt          = (static_cast<unsigned int>(GLStateExt::SHADING_RATE_IMAGE) + 1);
+        #endif
+
+        #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+        static const unsigned int numCacheCategories    = (static_cast<unsigned int>(CacheCategory::RenderState) + 1);
         #endif
 
         /* ----- Structure ----- */
@@ -183,6 +286,7 @@ class GLStateManager
             GLenum      frontFace       = GL_CCW;
             GLenum      frontFaceAct    = GL_CCW; // actual front face input (without possible inversion)
             GLboolean   depthMask       = GL_TRUE;
+            bool        depthBoundsTest = false;
             GLint       patchVertices_  = 0;
             ColorRGBAf  blendColor      = { 0.0f, 0.0f, 0.0f, 0.0f };
             GLenum      logicOpCode     = GL_COPY;
@@ -197,7 +301,7 @@ class GLStateManager
             };
 
             std::array<bool, numStates> values;
-            std::stack<StackEntry>      valueStack;
+            GLStateStack<StackEntry>    valueStack;
         };
 
         #ifdef LLGL_GL_ENABLE_VENDOR_EXT
@@ -224,7 +328,7 @@ class GLStateManager
             };
 
             std::array<GLuint, numBufferTargets>    boundBuffers;
-            std::stack<StackEntry>                  boundBufferStack;
+            GLStateStack<StackEntry>                boundBufferStack;
         };
 
         struct GLFramebufferState
@@ -253,7 +357,7 @@ class GLStateManager
 
             unsigned int                                    activeTexture = 0;
             std::array<GLTextureLayer, numTextureLayers>    layers;
-            std::stack<StackEntry>                          boundTextureStack;
+            GLStateStack<StackEntry>                        boundTextureStack;
         };
 
         struct GLVertexArrayState
@@ -264,8 +368,9 @@ class GLStateManager
 
         struct GLShaderState
         {
-            GLuint              boundProgram = 0;
-            std::stack<GLuint>  boundProgramStack;
+            GLuint                  boundProgram            = 0;
+            GLStateStack<GLuint>    boundProgramStack;
+            GLuint                  boundProgramPipeline    = 0;
         };
 
         struct GLSamplerState
@@ -291,11 +396,21 @@ class GLStateManager
         GLRenderStateExt                    renderStateExt_;
         #endif
 
+        GLPipelineStateBlock                pipelineState_;
+        bool                                pipelineStateValid_ = false;
+
         GLTextureLayer*                     activeTextureLayer_ = nullptr;
 
+        GLDrawMerger*                       pendingDrawMerger_  = nullptr;
+
         bool                                emulateClipControl_ = false;
         GLint                               renderTargetHeight_ = 0;
 
+        #ifdef LLGL_GL_ENABLE_STATE_CACHE_STATS
+        std::array<std::uint64_t, numCacheCategories>   cacheHits_;
+        std::array<std::uint64_t, numCacheCategories>   cacheMisses_;
+        #endif
+
 };
 
 
@@ -0,0 +1,79 @@
+/*
+ * GLStateStack.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STATE_STACK_H
+#define LLGL_GL_STATE_STACK_H
+
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/*
+Fixed-capacity stack with inline storage for the push/pop state functions of the GLStateManager.
+Unlike std::stack (which is backed by a std::deque), pushing and popping never allocates memory.
+The push/pop functions are only used for short save-and-restore sequences, so a small capacity is sufficient.
+*/
+template <typename T, std::size_t N = 16>
+class GLStateStack
+{
+
+    public:
+
+        void push(const T& entry)
+        {
+            if (size_ >= N)
+                throw std::runtime_error("GL state stack overflow (capacity is " + std::to_string(N) + ")");
+            entries_[size_++] = entry;
+        }
+
+        void pop()
+        {
+            #ifdef LLGL_DEBUG
+            if (size_ == 0)
+                throw std::runtime_error("GL state stack underflow");
+            #endif
+            --size_;
+        }
+
+        const T& top() const
+        {
+            return entries_[size_ - 1];
+        }
+
+        bool empty() const
+        {
+            return (size_ == 0);
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+
+        std::array<T, N>    entries_;
+        std::size_t         size_       = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,351 @@
+/*
+ * GLProgramBinaryCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLProgramBinaryCache.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionLoader.h"
+#include "../../../Core/Hash.h"
+#include <cstring>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/* ----- Hashing ----- */
+
+static void HashGLString(std::uint64_t& hash, GLenum name)
+{
+    auto str = reinterpret_cast<const char*>(glGetString(name));
+    if (str)
+        HashBytes(hash, str, std::strlen(str));
+    HashBytes(hash, "\0", 1);
+}
+
+
+/* ----- Serialization ----- */
+
+static const std::uint32_t g_cacheMagic     = 0x4350474C; // "LGPC"
+static const std::uint32_t g_cacheVersion   = 2;
+
+class BlobWriter
+{
+
+    public:
+
+        BlobWriter(std::vector<char>& data) :
+            data_ { data }
+        {
+        }
+
+        void Write(const void* data, std::size_t size)
+        {
+            auto bytes = reinterpret_cast<const char*>(data);
+            data_.insert(data_.end(), bytes, bytes + size);
+        }
+
+        void WriteUInt(std::uint32_t value)
+        {
+            Write(&value, sizeof(value));
+        }
+
+        void WriteString(const std::string& str)
+        {
+            WriteUInt(static_cast<std::uint32_t>(str.size()));
+            Write(str.data(), str.size());
+        }
+
+    private:
+
+        std::vector<char>& data_;
+
+};
+
+class BlobReader
+{
+
+    public:
+
+        BlobReader(const std::vector<char>& data) :
+            data_ { data }
+        {
+        }
+
+        bool Read(void* data, std::size_t size)
+        {
+            if (size > data_.size() - offset_)
+                return false;
+            std::memcpy(data, &data_[offset_], size);
+            offset_ += size;
+            return true;
+        }
+
+        bool ReadUInt(std::uint32_t& value)
+        {
+            return Read(&value, sizeof(value));
+        }
+
+        template <typename T>
+        bool ReadUIntAs(T& value)
+        {
+            std::uint32_t n = 0;
+            if (!ReadUInt(n))
+                return false;
+            value = static_cast<T>(n);
+            return true;
+        }
+
+        bool ReadString(std::string& str)
+        {
+            std::uint32_t len = 0;
+            if (!ReadUInt(len) || len > data_.size() - offset_)
+                return false;
+            str.assign(&data_[offset_], len);
+            offset_ += len;
+            return true;
+        }
+
+        bool ReadBytes(std::vector<char>& bytes)
+        {
+            std::uint32_t len = 0;
+            if (!ReadUInt(len) || len > data_.size() - offset_)
+                return false;
+            bytes.assign(data_.begin() + offset_, data_.begin() + offset_ + len);
+            offset_ += len;
+            return true;
+        }
+
+    private:
+
+        const std::vector<char>&    data_;
+        std::size_t                 offset_ = 0;
+
+};
+
+static void WriteReflection(BlobWriter& writer, const GLProgramReflection& reflection)
+{
+    writer.WriteUInt(static_cast<std::uint32_t>(reflection.vertexAttributes.size()));
+    for (const auto& attr : reflection.vertexAttributes)
+    {
+        writer.WriteString(attr.name);
+        writer.WriteUInt(static_cast<std::uint32_t>(attr.vectorType));
+        writer.WriteUInt(attr.instanceDivisor);
+        writer.WriteUInt(attr.conversion ? 1 : 0);
+        writer.WriteUInt(attr.offset);
+        writer.WriteUInt(attr.semanticIndex);
+        writer.WriteUInt(attr.inputSlot);
+    }
+
+    writer.WriteUInt(static_cast<std::uint32_t>(reflection.constantBuffers.size()));
+    for (const auto& desc : reflection.constantBuffers)
+    {
+        writer.WriteString(desc.name);
+        writer.WriteUInt(desc.index);
+        writer.WriteUInt(desc.size);
+
+        writer.WriteUInt(static_cast<std::uint32_t>(desc.fields.size()));
+        for (const auto& field : desc.fields)
+        {
+            writer.WriteString(field.name);
+            writer.WriteUInt(static_cast<std::uint32_t>(field.type));
+            writer.WriteUInt(field.offset);
+            writer.WriteUInt(field.size);
+            writer.WriteUInt(field.arraySize);
+            writer.WriteUInt(field.arrayStride);
+        }
+    }
+
+    writer.WriteUInt(static_cast<std::uint32_t>(reflection.storageBuffers.size()));
+    for (const auto& desc : reflection.storageBuffers)
+    {
+        writer.WriteString(desc.name);
+        writer.WriteUInt(desc.index);
+        writer.WriteUInt(static_cast<std::uint32_t>(desc.type));
+    }
+
+    writer.WriteUInt(static_cast<std::uint32_t>(reflection.uniforms.size()));
+    for (const auto& desc : reflection.uniforms)
+    {
+        writer.WriteString(desc.name);
+        writer.WriteUInt(static_cast<std::uint32_t>(desc.type));
+        writer.WriteUInt(static_cast<std::uint32_t>(desc.location));
+        writer.WriteUInt(desc.size);
+    }
+}
+
+static bool ReadReflection(BlobReader& reader, GLProgramReflection& reflection)
+{
+    std::uint32_t n = 0;
+
+    if (!reader.ReadUInt(n))
+        return false;
+    reflection.vertexAttributes.resize(n);
+    for (auto& attr : reflection.vertexAttributes)
+    {
+        if ( !reader.ReadString(attr.name)               ||
+             !reader.ReadUIntAs(attr.vectorType)         ||
+             !reader.ReadUIntAs(attr.instanceDivisor)    ||
+             !reader.ReadUIntAs(attr.conversion)         ||
+             !reader.ReadUIntAs(attr.offset)             ||
+             !reader.ReadUIntAs(attr.semanticIndex)      ||
+             !reader.ReadUIntAs(attr.inputSlot) )
+        {
+            return false;
+        }
+    }
+
+    if (!reader.ReadUInt(n))
+        return false;
+    reflection.constantBuffers.resize(n);
+    for (auto& desc : reflection.constantBuffers)
+    {
+        if (!reader.ReadString(desc.name) || !reader.ReadUIntAs(desc.index) || !reader.ReadUIntAs(desc.size))
+            return false;
+
+        std::uint32_t numFields = 0;
+        if (!reader.ReadUInt(numFields))
+            return false;
+        desc.fields.resize(numFields);
+        for (auto& field : desc.fields)
+        {
+            if ( !reader.ReadString(field.name)         ||
+                 !reader.ReadUIntAs(field.type)         ||
+                 !reader.ReadUIntAs(field.offset)       ||
+                 !reader.ReadUIntAs(field.size)         ||
+                 !reader.ReadUIntAs(field.arraySize)    ||
+                 !reader.ReadUIntAs(field.arrayStride) )
+            {
+                return false;
+            }
+        }
+    }
+
+    if (!reader.ReadUInt(n))
+        return false;
+    reflection.storageBuffers.resize(n);
+    for (auto& desc : reflection.storageBuffers)
+    {
+        if (!reader.ReadString(desc.name) || !reader.ReadUIntAs(desc.index) || !reader.ReadUIntAs(desc.type))
+            return false;
+    }
+
+    if (!reader.ReadUInt(n))
+        return false;
+    reflection.uniforms.resize(n);
+    for (auto& desc : reflection.uniforms)
+    {
+        if (!reader.ReadString(desc.name) || !reader.ReadUIntAs(desc.type) || !reader.ReadUIntAs(desc.location) || !reader.ReadUIntAs(desc.size))
+            return false;
+    }
+
+    return true;
+}
+
+
+/* ----- GLProgramBinaryCache class ----- */
+
+bool GLProgramBinaryCache::Load(const std::vector<char>& data)
+{
+    /* Enable cache even if the data is empty, e.g. for the first run of the application */
+    enabled_ = true;
+
+    BlobReader reader(data);
+
+    /* Read and validate header */
+    std::uint32_t magic = 0, version = 0, numEntries = 0;
+    if (!reader.ReadUInt(magic) || magic != g_cacheMagic || !reader.ReadUInt(version) || version != g_cacheVersion || !reader.ReadUInt(numEntries))
+        return false;
+
+    /* Read all entries into a temporary container first, so invalid data leaves the cache untouched */
+    std::map<std::uint64_t, GLProgramBinary> binaries;
+
+    for (std::uint32_t i = 0; i < numEntries; ++i)
+    {
+        std::uint64_t key = 0;
+        GLProgramBinary binary;
+
+        if ( !reader.Read(&key, sizeof(key))         ||
+             !reader.ReadUIntAs(binary.format)       ||
+             !reader.ReadBytes(binary.data)          ||
+             !ReadReflection(reader, binary.reflection) )
+        {
+            return false;
+        }
+
+        binaries[key] = std::move(binary);
+    }
+
+    for (auto& entry : binaries)
+        binaries_[entry.first] = std::move(entry.second);
+
+    return true;
+}
+
+std::vector<char> GLProgramBinaryCache::Save() const
+{
+    std::vector<char> data;
+    BlobWriter writer(data);
+
+    /* Write header */
+    writer.WriteUInt(g_cacheMagic);
+    writer.WriteUInt(g_cacheVersion);
+    writer.WriteUInt(static_cast<std::uint32_t>(binaries_.size()));
+
+    /* Write all program binaries */
+    for (const auto& entry : binaries_)
+    {
+        writer.Write(&(entry.first), sizeof(entry.first));
+        writer.WriteUInt(static_cast<std::uint32_t>(entry.second.format));
+        writer.WriteUInt(static_cast<std::uint32_t>(entry.second.data.size()));
+        writer.Write(entry.second.data.data(), entry.second.data.size());
+        WriteReflection(writer, entry.second.reflection);
+    }
+
+    return data;
+}
+
+const GLProgramBinary* GLProgramBinaryCache::Find(std::uint64_t key) const
+{
+    auto it = binaries_.find(key);
+    return (it != binaries_.end() ? &(it->second) : nullptr);
+}
+
+void GLProgramBinaryCache::Store(std::uint64_t key, GLProgramBinary&& binary)
+{
+    binaries_[key] = std::move(binary);
+}
+
+void GLProgramBinaryCache::Remove(std::uint64_t key)
+{
+    binaries_.erase(key);
+}
+
+bool GLProgramBinaryCache::IsEnabled() const
+{
+    return (enabled_ && HasExtension(GLExt::ARB_get_program_binary));
+}
+
+std::uint64_t GLProgramBinaryCache::GetDriverHash()
+{
+    if (!hasDriverHash_)
+    {
+        driverHash_ = HashInitValue();
+        HashGLString(driverHash_, GL_VENDOR);
+        HashGLString(driverHash_, GL_RENDERER);
+        HashGLString(driverHash_, GL_VERSION);
+        hasDriverHash_ = true;
+    }
+    return driverHash_;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,92 @@
+/*
+ * GLProgramBinaryCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PROGRAM_BINARY_CACHE_H
+#define LLGL_GL_PROGRAM_BINARY_CACHE_H
+
+
+#include <LLGL/VertexAttribute.h>
+#include <LLGL/BufferFlags.h>
+#include <LLGL/ShaderUniform.h>
+#include "../OpenGL.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Reflection data of a shader program, which is stored together with the program binary.
+struct GLProgramReflection
+{
+    std::vector<VertexAttribute>                vertexAttributes;
+    std::vector<ConstantBufferViewDescriptor>   constantBuffers;
+    std::vector<StorageBufferViewDescriptor>    storageBuffers;
+    std::vector<UniformDescriptor>              uniforms;
+};
+
+// Cached GL program binary (see GL_ARB_get_program_binary).
+struct GLProgramBinary
+{
+    GLenum              format  = 0;
+    std::vector<char>   data;
+    GLProgramReflection reflection;
+};
+
+
+/*
+Cache for GL program binaries, which are keyed by a hash over the shader sources, the attribute bindings,
+and the driver identification (vendor, renderer, and version string). The cache is opt-in and only enabled
+after "Load" has been called, since it requires the shader programs to retrieve their binaries after linking.
+*/
+class GLProgramBinaryCache
+{
+
+    public:
+
+        // Enables the cache and loads all program binaries from the specified serialized data. Returns false if the data is invalid.
+        bool Load(const std::vector<char>& data);
+
+        // Serializes all program binaries.
+        std::vector<char> Save() const;
+
+        // Returns the program binary for the specified key, or null if there is no such entry.
+        const GLProgramBinary* Find(std::uint64_t key) const;
+
+        // Stores the specified program binary under the specified key.
+        void Store(std::uint64_t key, GLProgramBinary&& binary);
+
+        // Removes the program binary with the specified key, e.g. when the driver rejected it.
+        void Remove(std::uint64_t key);
+
+        // Returns true if the cache is enabled and GL_ARB_get_program_binary is supported.
+        bool IsEnabled() const;
+
+        // Returns the hash of the driver identification. This requires an active GL context.
+        std::uint64_t GetDriverHash();
+
+    private:
+
+        std::map<std::uint64_t, GLProgramBinary>    binaries_;
+
+        bool                                        enabled_        = false;
+        bool                                        hasDriverHash_  = false;
+        std::uint64_t                               driverHash_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,7 +6,10 @@
  */
 
 #include "GLShader.h"
+#include "GLProgramBinaryCache.h"
+#include "../../../Core/Hash.h"
 #include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionLoader.h"
 #include "../../GLCommon/GLTypes.h"
 #include <vector>
 #include <sstream>
@@ -25,32 +28,51 @@ GLShader::GLShader(const ShaderType type) :
 
 GLShader::~GLShader()
 {
+    if (separableID_ != 0)
+        glDeleteProgram(separableID_);
     glDeleteShader(id_);
 }
 
 bool GLShader::Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
 {
-    /* Setup shader source */
-    const GLchar* strings[] = { sourceCode.c_str() };
-    glShaderSource(id_, 1, strings, nullptr);
-
-    /* Compile shader */
-    glCompileShader(id_);
+    SubmitCompile(sourceCode, shaderDesc);
+    return QueryCompileStatus();
+}
 
-    /* Store stream-output format */
-    streamOutputFormat_ = shaderDesc.streamOutput.format;
+std::shared_future<bool> GLShader::CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
+{
+    if (!HasExtension(GLExt::ARB_parallel_shader_compile))
+        return Shader::CompileAsync(sourceCode, shaderDesc);
 
-    /* Query compilation status */
-    GLint compileStatus = 0;
-    glGetShaderiv(id_, GL_COMPILE_STATUS, &compileStatus);
+    /*
+    Dispatch compilation to the driver, which compiles the shader in the background with GL_ARB_parallel_shader_compile.
+    The status query blocks until the compilation is done and must be called on the thread of the GL context.
+    */
+    SubmitCompile(sourceCode, shaderDesc);
 
-    return (compileStatus != GL_FALSE);
+    return std::async(std::launch::deferred, [this]() { return QueryCompileStatus(); }).share();
 }
 
 
 bool GLShader::LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc)
 {
-    return false; // dummy
+    #ifdef GL_ARB_gl_spirv
+    if (binaryCode.empty() || !HasExtension(GLExt::ARB_gl_spirv))
+        return false;
+
+    /* Load SPIR-V module (word aligned byte code) and specialize it for the entry point, which is "main" by default */
+    glShaderBinary(1, &id_, GL_SHADER_BINARY_FORMAT_SPIR_V_ARB, binaryCode.data(), static_cast<GLsizei>(binaryCode.size()));
+
+    const auto entryPoint = (shaderDesc.entryPoint.empty() ? "main" : shaderDesc.entryPoint.c_str());
+    glSpecializeShaderARB(id_, entryPoint, 0, nullptr, nullptr);
+
+    StoreCodeAttributes(binaryCode.data(), binaryCode.size(), shaderDesc);
+
+    /* Specialization status is queried like the compilation status */
+    return QueryCompileStatus();
+    #else
+    return false;
+    #endif
 }
 
 std::string GLShader::Disassemble(int flags)
@@ -58,6 +80,40 @@ std::string GLShader::Disassemble(int flags)
     return ""; // dummy
 }
 
+GLuint GLShader::GetSeparableID()
+{
+    CreateSeparableProgram();
+
+    if (!separableLinked_)
+    {
+        /* Link program with this shader only (the shader can be detached right after linking) */
+        glAttachShader(separableID_, id_);
+        glLinkProgram(separableID_);
+        glDetachShader(separableID_, id_);
+        separableLinked_ = true;
+    }
+
+    return separableID_;
+}
+
+void GLShader::BindSeparableAttribLocations(const VertexFormat& vertexFormat)
+{
+    CreateSeparableProgram();
+
+    /* Bind attribute locations (matrices only use the column) */
+    GLuint index = 0;
+
+    for (const auto& attrib : vertexFormat.attributes)
+    {
+        if (attrib.semanticIndex == 0)
+            glBindAttribLocation(separableID_, index, attrib.name.c_str());
+        ++index;
+    }
+
+    /* Attribute locations only take effect with the next linking */
+    separableLinked_ = false;
+}
+
 std::string GLShader::QueryInfoLog()
 {
     /* Query info log length */
@@ -97,6 +153,57 @@ bool GLShader::MoveStreamOutputFormat(StreamOutputFormat& streamOutputFormat)
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void GLShader::SubmitCompile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
+{
+    /* Setup shader source */
+    const GLchar* strings[] = { sourceCode.c_str() };
+    glShaderSource(id_, 1, strings, nullptr);
+
+    /* Compile shader */
+    glCompileShader(id_);
+
+    StoreCodeAttributes(sourceCode.data(), sourceCode.size(), shaderDesc);
+}
+
+void GLShader::StoreCodeAttributes(const char* code, std::size_t codeSize, const ShaderDescriptor& shaderDesc)
+{
+    /* Separable program must be re-linked with the new shader */
+    separableLinked_ = false;
+
+    /* Store stream-output format */
+    streamOutputFormat_ = shaderDesc.streamOutput.format;
+
+    /* Store code hash to identify cached program binaries */
+    sourceHash_ = HashInitValue();
+    {
+        auto type = GetType();
+        HashBytes(sourceHash_, &type, sizeof(type));
+        HashBytes(sourceHash_, code, codeSize);
+    }
+}
+
+void GLShader::CreateSeparableProgram()
+{
+    if (separableID_ == 0)
+    {
+        separableID_ = glCreateProgram();
+        glProgramParameteri(separableID_, GL_PROGRAM_SEPARABLE, GL_TRUE);
+    }
+}
+
+bool GLShader::QueryCompileStatus() const
+{
+    /* Query compilation status */
+    GLint compileStatus = 0;
+    glGetShaderiv(id_, GL_COMPILE_STATUS, &compileStatus);
+    return (compileStatus != GL_FALSE);
+}
+
+
 } // /namespace LLGL
 
 
@@ -10,7 +10,9 @@
 
 
 #include <LLGL/Shader.h>
+#include <LLGL/VertexFormat.h>
 #include "../OpenGL.h"
+#include <cstdint>
 
 
 namespace LLGL
@@ -27,6 +29,8 @@ class GLShader : public Shader
 
         bool Compile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
 
+        std::shared_future<bool> CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc = {}) override;
+
         bool LoadBinary(std::vector<char>&& binaryCode, const ShaderDescriptor& shaderDesc = {}) override;
 
         std::string Disassemble(int flags = 0) override;
@@ -39,6 +43,22 @@ class GLShader : public Shader
             return id_;
         }
 
+        //! Returns the hash of the shader source or binary, which has been passed to the last call of "Compile" or "LoadBinary".
+        inline std::uint64_t GetSourceHash() const
+        {
+            return sourceHash_;
+        }
+
+        /*
+        Returns the ID of the separable program that only contains this shader (requires GL_ARB_separate_shader_objects).
+        The program is linked on demand and shared by all shader programs this shader is attached to,
+        i.e. it is only re-linked after the shader or its vertex attribute locations have changed.
+        */
+        GLuint GetSeparableID();
+
+        // Binds the vertex attribute locations of the separable program, which is re-linked with the next call to "GetSeparableID".
+        void BindSeparableAttribLocations(const VertexFormat& vertexFormat);
+
     protected:
 
         friend class GLShaderProgram;
@@ -47,10 +67,20 @@ class GLShader : public Shader
 
     private:
 
+        void SubmitCompile(const std::string& sourceCode, const ShaderDescriptor& shaderDesc);
+        void StoreCodeAttributes(const char* code, std::size_t codeSize, const ShaderDescriptor& shaderDesc);
+        void CreateSeparableProgram();
+        bool QueryCompileStatus() const;
+
         GLuint              id_ = 0;
 
         StreamOutputFormat  streamOutputFormat_;
 
+        std::uint64_t       sourceHash_         = 0;
+
+        GLuint              separableID_        = 0;
+        bool                separableLinked_    = false;
+
 };
 
 
@@ -11,35 +11,51 @@
 #include "../Ext/GLExtensionLoader.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Exception.h"
+#include "../../../Core/Hash.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../GLCommon/GLTypes.h"
-#include <LLGL/Log.h>
+#include "../../../Core/HelperMacros.h"
 #include <LLGL/VertexFormat.h>
 #include <vector>
 #include <stdexcept>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-GLShaderProgram::GLShaderProgram() :
-    id_      { glCreateProgram() },
-    uniform_ { id_               }
+GLShaderProgram::GLShaderProgram(GLProgramBinaryCache* binaryCache, bool separable) :
+    id_          { separable ? 0 : glCreateProgram() },
+    uniform_     { id_                               },
+    binaryCache_ { binaryCache                       },
+    separable_   { separable                         }
 {
+    if (separable_)
+        glGenProgramPipelines(1, &pipelineID_);
 }
 
 GLShaderProgram::~GLShaderProgram()
 {
-    glDeleteProgram(id_);
+    if (separable_)
+    {
+        /* Programs of the separable stages are owned by their shaders */
+        GLStateManager::active->NotifyProgramPipelineRelease(pipelineID_);
+        glDeleteProgramPipelines(1, &pipelineID_);
+    }
+    else
+        glDeleteProgram(id_);
 }
 
 void GLShaderProgram::AttachShader(Shader& shader)
 {
     auto& shaderGL = LLGL_CAST(GLShader&, shader);
 
-    /* Attach shader to shader program */
-    glAttachShader(id_, shaderGL.GetID());
+    /* Attach shader to shader program, or store it for the program pipeline */
+    if (separable_)
+        separableShaders_.push_back(&shaderGL);
+    else
+        glAttachShader(id_, shaderGL.GetID());
 
     /* Store attribute if fragment shader is set */
     if (shader.GetType() == ShaderType::Fragment)
@@ -47,26 +63,39 @@ void GLShaderProgram::AttachShader(Shader& shader)
 
     /* Move stream-output format from shader to shader program (if available) */
     shaderGL.MoveStreamOutputFormat(streamOutputFormat_);
+
+    /* Store source hash to identify the cached program binary */
+    shaderHashes_.push_back(shaderGL.GetSourceHash());
 }
 
 void GLShaderProgram::DetachAll()
 {
-    /* Retrieve all attached shaders from program */
-    GLsizei numShaders = 0;
-    GLuint shaders[6] = { 0 };
-    glGetAttachedShaders(id_, 6, &numShaders, shaders);
-
-    /* Detach all shaders */
-    for (GLsizei i = 0; i < numShaders; ++i)
-        glDetachShader(id_, shaders[i]);
+    if (separable_)
+        separableShaders_.clear();
+    else
+    {
+        /* Retrieve all attached shaders from program */
+        GLsizei numShaders = 0;
+        GLuint shaders[6] = { 0 };
+        glGetAttachedShaders(id_, 6, &numShaders, shaders);
+
+        /* Detach all shaders */
+        for (GLsizei i = 0; i < numShaders; ++i)
+            glDetachShader(id_, shaders[i]);
+    }
 
     /* Reset shader attributes */
     hasFragmentShader_ = false;
     streamOutputFormat_.attributes.clear();
+    shaderHashes_.clear();
 }
 
 bool GLShaderProgram::LinkShaders()
 {
+    /* Separable stages are linked individually by their shaders */
+    if (separable_)
+        return LinkSeparableStages();
+
     /* Check if transform-feedback varyings must be specified (before or after shader linking) */
     if (!streamOutputFormat_.attributes.empty())
     {
@@ -94,11 +123,11 @@ bool GLShaderProgram::LinkShaders()
     return LinkShaderProgram();
 }
 
-std::string GLShaderProgram::QueryInfoLog()
+static std::string QueryProgramInfoLog(GLuint program)
 {
     /* Query info log length */
     GLint infoLogLength = 0;
-    glGetProgramiv(id_, GL_INFO_LOG_LENGTH, &infoLogLength);
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLogLength);
 
     if (infoLogLength > 0)
     {
@@ -108,7 +137,7 @@ std::string GLShaderProgram::QueryInfoLog()
 
         /* Query info log output */
         GLsizei charsWritten = 0;
-        glGetProgramInfoLog(id_, infoLogLength, &charsWritten, infoLog.data());
+        glGetProgramInfoLog(program, infoLogLength, &charsWritten, infoLog.data());
 
         /* Convert byte buffer to string */
         return std::string(infoLog.data());
@@ -117,6 +146,19 @@ std::string GLShaderProgram::QueryInfoLog()
     return "";
 }
 
+std::string GLShaderProgram::QueryInfoLog()
+{
+    if (separable_)
+    {
+        /* Concatenate info logs of all separable stages */
+        std::string infoLog;
+        for (auto program : stagePrograms_)
+            infoLog += QueryProgramInfoLog(program);
+        return infoLog;
+    }
+    return QueryProgramInfoLog(id_);
+}
+
 static std::pair<VectorType, unsigned int> UnmapAttribType(GLenum type)
 {
     switch (type)
@@ -161,6 +203,10 @@ static std::pair<VectorType, unsigned int> UnmapAttribType(GLenum type)
 
 std::vector<VertexAttribute> GLShaderProgram::QueryVertexAttributes() const
 {
+    /* Return cached reflection (see ReflectProgram) */
+    if (hasReflection_)
+        return reflection_.vertexAttributes;
+
     VertexFormat vertexFormat;
 
     /* Query active vertex attributes */
@@ -270,6 +316,10 @@ std::vector<StreamOutputAttribute> GLShaderProgram::QueryStreamOutputAttributes(
 
 std::vector<ConstantBufferViewDescriptor> GLShaderProgram::QueryConstantBuffers() const
 {
+    /* Return cached reflection (see ReflectProgram) */
+    if (hasReflection_)
+        return reflection_.constantBuffers;
+
     std::vector<ConstantBufferViewDescriptor> descList;
 
     /* Query active uniform blocks */
@@ -278,6 +328,8 @@ std::vector<ConstantBufferViewDescriptor> GLShaderProgram::QueryConstantBuffers(
     if (!QueryActiveAttribs(GL_ACTIVE_UNIFORM_BLOCKS, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, numUniformBlocks, maxNameLength, blockName))
         return {};
 
+    descList.reserve(static_cast<std::size_t>(numUniformBlocks));
+
     /* Iterate over all uniform blocks */
     for (GLuint i = 0; i < static_cast<GLuint>(numUniformBlocks); ++i)
     {
@@ -294,6 +346,9 @@ std::vector<ConstantBufferViewDescriptor> GLShaderProgram::QueryConstantBuffers(
         glGetActiveUniformBlockiv(id_, i, GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize);
         desc.size = blockSize;
 
+        /* Query uniform block members */
+        QueryConstantBufferFields(i, desc.fields);
+
         /* Insert uniform block into list */
         descList.push_back(desc);
     }
@@ -303,6 +358,10 @@ std::vector<ConstantBufferViewDescriptor> GLShaderProgram::QueryConstantBuffers(
 
 std::vector<StorageBufferViewDescriptor> GLShaderProgram::QueryStorageBuffers() const
 {
+    /* Return cached reflection (see ReflectProgram) */
+    if (hasReflection_)
+        return reflection_.storageBuffers;
+
     std::vector<StorageBufferViewDescriptor> descList;
 
     #ifndef __APPLE__
@@ -322,6 +381,7 @@ std::vector<StorageBufferViewDescriptor> GLShaderProgram::QueryStorageBuffers()
         return descList;
 
     std::vector<char> blockName(maxNameLength, 0);
+    descList.reserve(static_cast<std::size_t>(numStorageBlocks));
 
     /* Iterate over all shader storage blocks */
     for (GLuint i = 0; i < static_cast<GLuint>(numStorageBlocks); ++i)
@@ -345,6 +405,10 @@ std::vector<StorageBufferViewDescriptor> GLShaderProgram::QueryStorageBuffers()
 
 std::vector<UniformDescriptor> GLShaderProgram::QueryUniforms() const
 {
+    /* Return cached reflection (see ReflectProgram) */
+    if (hasReflection_)
+        return reflection_.uniforms;
+
     std::vector<UniformDescriptor> descList;
 
     /* Query active uniforms */
@@ -353,6 +417,8 @@ std::vector<UniformDescriptor> GLShaderProgram::QueryUniforms() const
     if (!QueryActiveAttribs(GL_ACTIVE_UNIFORMS, GL_ACTIVE_UNIFORM_MAX_LENGTH, numUniforms, maxNameLength, uniformName))
         return {};
 
+    descList.reserve(static_cast<std::size_t>(numUniforms));
+
     /* Iterate over all uniforms */
     for (GLuint i = 0; i < static_cast<GLuint>(numUniforms); ++i)
     {
@@ -378,13 +444,40 @@ std::vector<UniformDescriptor> GLShaderProgram::QueryUniforms() const
         }
         catch (const std::exception& e)
         {
-            Log::StdOut() << e.what() << std::endl;
+            LLGL_LOG(Info, e.what());
         }
     }
 
     return descList;
 }
 
+int GLShaderProgram::QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name)
+{
+    if (!HasExtension(GLExt::ARB_shader_subroutine))
+        return -1;
+
+    /* Subroutine uniform locations are the indices into the array of "glUniformSubroutinesuiv" */
+    if (auto program = GetStageProgram(stage))
+        return glGetSubroutineUniformLocation(program, GLTypes::Map(stage), name.c_str());
+
+    return -1;
+}
+
+int GLShaderProgram::QueryShaderClassInstance(const ShaderType stage, const std::string& name)
+{
+    if (!HasExtension(GLExt::ARB_shader_subroutine))
+        return -1;
+
+    if (auto program = GetStageProgram(stage))
+    {
+        auto index = glGetSubroutineIndex(program, GLTypes::Map(stage), name.c_str());
+        if (index != GL_INVALID_INDEX)
+            return static_cast<int>(index);
+    }
+
+    return -1;
+}
+
 void GLShaderProgram::BuildInputLayout(const VertexFormat& vertexFormat)
 {
     if (vertexFormat.attributes.size() > GL_MAX_VERTEX_ATTRIBS)
@@ -395,14 +488,36 @@ void GLShaderProgram::BuildInputLayout(const VertexFormat& vertexFormat)
         );
     }
 
+    if (separable_)
+    {
+        /* Bind vertex attribute locations in the separable program of the vertex shader */
+        for (auto shader : separableShaders_)
+        {
+            if (shader->GetType() == ShaderType::Vertex)
+                shader->BindSeparableAttribLocations(vertexFormat);
+        }
+
+        /* Re-link stages if the shader has already been linked */
+        if (isLinked_)
+            LinkSeparableStages();
+
+        return;
+    }
+
     /* Bind all vertex attribute locations */
     GLuint index = 0;
 
+    inputLayoutHash_ = HashInitValue();
+
     for (const auto& attrib : vertexFormat.attributes)
     {
         /* Bind attribute location (matrices only use the column) */
         if (attrib.semanticIndex == 0)
+        {
             glBindAttribLocation(id_, index, attrib.name.c_str());
+            HashBytes(inputLayoutHash_, &index, sizeof(index));
+            HashBytes(inputLayoutHash_, attrib.name.c_str(), attrib.name.size() + 1);
+        }
         ++index;
     }
 
@@ -411,24 +526,64 @@ void GLShaderProgram::BuildInputLayout(const VertexFormat& vertexFormat)
         LinkShaderProgram();
 }
 
-void GLShaderProgram::BindConstantBuffer(const std::string& name, unsigned int bindingIndex)
+static bool BindUniformBlock(GLuint program, const std::string& name, unsigned int bindingIndex)
 {
     /* Query uniform block index and bind it to the specified binding index */
-    auto blockIndex = glGetUniformBlockIndex(id_, name.c_str());
-    if (blockIndex != GL_INVALID_INDEX)
-        glUniformBlockBinding(id_, blockIndex, bindingIndex);
+    auto blockIndex = glGetUniformBlockIndex(program, name.c_str());
+    if (blockIndex == GL_INVALID_INDEX)
+        return false;
+
+    glUniformBlockBinding(program, blockIndex, bindingIndex);
+    return true;
+}
+
+void GLShaderProgram::BindConstantBuffer(const std::string& name, unsigned int bindingIndex)
+{
+    bool found = false;
+
+    /* Bind uniform block in all separable stages that declare it (bindings are stored in the programs shared by their shaders) */
+    if (separable_)
+    {
+        for (auto program : stagePrograms_)
+            found = (BindUniformBlock(program, name, bindingIndex) || found);
+    }
     else
+        found = BindUniformBlock(id_, name, bindingIndex);
+
+    if (!found)
         throw std::invalid_argument("failed to bind constant buffer, because uniform block name is invalid");
 }
 
+#ifndef __APPLE__
+
+static bool BindShaderStorageBlock(GLuint program, const std::string& name, unsigned int bindingIndex)
+{
+    /* Query shader storage block index and bind it to the specified binding index */
+    auto blockIndex = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, name.c_str());
+    if (blockIndex == GL_INVALID_INDEX)
+        return false;
+
+    glShaderStorageBlockBinding(program, blockIndex, bindingIndex);
+    return true;
+}
+
+#endif
+
 void GLShaderProgram::BindStorageBuffer(const std::string& name, unsigned int bindingIndex)
 {
     #ifndef __APPLE__
-    /* Query shader storage block index and bind it to the specified binding index */
-    auto blockIndex = glGetProgramResourceIndex(id_, GL_SHADER_STORAGE_BLOCK, name.c_str());
-    if (blockIndex != GL_INVALID_INDEX)
-        glShaderStorageBlockBinding(id_, blockIndex, bindingIndex);
+    bool found = false;
+
+    /* Bind storage block in all separable stages that declare it (see BindConstantBuffer) */
+    if (separable_)
+    {
+        for (auto program : stagePrograms_)
+            found = (BindShaderStorageBlock(program, name, bindingIndex) || found);
+    }
     else
+        found = BindShaderStorageBlock(id_, name, bindingIndex);
+
+    if (!found)
         throw std::invalid_argument("failed to bind storage buffer, because storage block name is invalid");
     #else
     throw std::runtime_error("storage buffers not supported on this platform");
@@ -437,14 +592,19 @@ void GLShaderProgram::BindStorageBuffer(const std::string& name, unsigned int bi
 
 ShaderUniform* GLShaderProgram::LockShaderUniform()
 {
-    GLStateManager::active->PushShaderProgram();
-    GLStateManager::active->BindShaderProgram(id_);
+    /* Program uniforms are written without binding the program, which leaves the state cache untouched */
+    if (!uniform_.HasProgramUniforms())
+    {
+        GLStateManager::active->PushShaderProgram();
+        GLStateManager::active->BindShaderProgram(id_);
+    }
     return (&uniform_);
 }
 
 void GLShaderProgram::UnlockShaderUniform()
 {
-    GLStateManager::active->PopShaderProgram();
+    if (!uniform_.HasProgramUniforms())
+        GLStateManager::active->PopShaderProgram();
 }
 
 
@@ -471,8 +631,141 @@ bool GLShaderProgram::QueryActiveAttribs(
     return true;
 }
 
+// Returns the size (in bytes) of a single uniform of the specified type within a uniform block.
+static unsigned int GetUniformBlockFieldSize(const UniformType type, GLint matrixStride)
+{
+    switch (type)
+    {
+        case UniformType::Float:
+        case UniformType::Int:
+        case UniformType::UInt:
+        case UniformType::Boolean:
+            return 4;
+        case UniformType::Float2:
+        case UniformType::Int2:
+        case UniformType::UInt2:
+        case UniformType::Boolean2:
+        case UniformType::Double:
+            return 8;
+        case UniformType::Float3:
+        case UniformType::Int3:
+        case UniformType::UInt3:
+        case UniformType::Boolean3:
+            return 12;
+        case UniformType::Float4:
+        case UniformType::Int4:
+        case UniformType::UInt4:
+        case UniformType::Boolean4:
+        case UniformType::Double2:
+            return 16;
+        case UniformType::Double3:
+            return 24;
+        case UniformType::Double4:
+            return 32;
+        case UniformType::Float2x2:
+        case UniformType::Double2x2:
+            return static_cast<unsigned int>(matrixStride) * 2;
+        case UniformType::Float3x3:
+        case UniformType::Double3x3:
+            return static_cast<unsigned int>(matrixStride) * 3;
+        case UniformType::Float4x4:
+        case UniformType::Double4x4:
+            return static_cast<unsigned int>(matrixStride) * 4;
+        default:
+            return 0;
+    }
+}
+
+void GLShaderProgram::QueryConstantBufferFields(GLuint blockIndex, std::vector<ConstantBufferFieldDescriptor>& fields) const
+{
+    /* Query indices of all active uniforms within the block */
+    GLint numUniforms = 0;
+    glGetActiveUniformBlockiv(id_, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &numUniforms);
+    if (numUniforms <= 0)
+        return;
+
+    std::vector<GLint> indices(static_cast<std::size_t>(numUniforms));
+    glGetActiveUniformBlockiv(id_, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data());
+
+    std::vector<GLuint> uniformIndices(indices.begin(), indices.end());
+
+    /* Query layout of all uniforms at once */
+    std::vector<GLint> types(indices.size()), offsets(indices.size()), arraySizes(indices.size()), arrayStrides(indices.size()), matrixStrides(indices.size());
+    glGetActiveUniformsiv(id_, numUniforms, uniformIndices.data(), GL_UNIFORM_TYPE, types.data());
+    glGetActiveUniformsiv(id_, numUniforms, uniformIndices.data(), GL_UNIFORM_OFFSET, offsets.data());
+    glGetActiveUniformsiv(id_, numUniforms, uniformIndices.data(), GL_UNIFORM_SIZE, arraySizes.data());
+    glGetActiveUniformsiv(id_, numUniforms, uniformIndices.data(), GL_UNIFORM_ARRAY_STRIDE, arrayStrides.data());
+    glGetActiveUniformsiv(id_, numUniforms, uniformIndices.data(), GL_UNIFORM_MATRIX_STRIDE, matrixStrides.data());
+
+    GLint maxNameLength = 0;
+    glGetProgramiv(id_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    std::vector<char> uniformName(static_cast<std::size_t>(std::max(maxNameLength, 1)), '\0');
+
+    fields.reserve(indices.size());
+
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+        try
+        {
+            ConstantBufferFieldDescriptor field;
+
+            GLTypes::Unmap(field.type, static_cast<GLenum>(types[i]));
+
+            /* Query uniform name and remove the subscript of the first array element (e.g. "lights[0]") */
+            GLsizei nameLength = 0;
+            glGetActiveUniformName(id_, uniformIndices[i], static_cast<GLsizei>(uniformName.size()), &nameLength, uniformName.data());
+            field.name = std::string(uniformName.data(), static_cast<std::size_t>(nameLength));
+
+            if (field.name.size() > 3 && field.name.compare(field.name.size() - 3, 3, "[0]") == 0)
+            {
+                field.name.resize(field.name.size() - 3);
+                field.arraySize     = static_cast<unsigned int>(arraySizes[i]);
+                field.arrayStride   = static_cast<unsigned int>(arrayStrides[i]);
+            }
+
+            field.offset    = static_cast<unsigned int>(offsets[i]);
+            field.size      = GetUniformBlockFieldSize(field.type, matrixStrides[i]);
+
+            /* Insert uniform block member into list */
+            fields.push_back(field);
+        }
+        catch (const std::exception& e)
+        {
+            LLGL_LOG(Info, e.what());
+        }
+    }
+
+    /* Sort fields by their offsets (the order of active uniforms is implementation dependent) */
+    std::sort(
+        fields.begin(), fields.end(),
+        [](const ConstantBufferFieldDescriptor& lhs, const ConstantBufferFieldDescriptor& rhs)
+        {
+            return (lhs.offset < rhs.offset);
+        }
+    );
+}
+
 bool GLShaderProgram::LinkShaderProgram()
 {
+    hasReflection_ = false;
+
+    /* Try to load program binary from cache instead of linking the shaders */
+    const bool useBinaryCache = (binaryCache_ != nullptr && binaryCache_->IsEnabled());
+    std::uint64_t binaryKey = 0;
+
+    if (useBinaryCache)
+    {
+        binaryKey = MakeBinaryKey();
+        if (LoadCachedBinary(binaryKey))
+        {
+            uniform_.BuildLocationMap(reflection_.uniforms);
+            return true;
+        }
+
+        /* Program binary must be retrievable after linking */
+        glProgramParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     /* Link shader program */
     glLinkProgram(id_);
 
@@ -483,17 +776,212 @@ bool GLShaderProgram::LinkShaderProgram()
     /* Store if program is linked successful */
     isLinked_ = (linkStatus != GL_FALSE);
 
+    /* Reflect program once, so neither the reflection queries nor the name based uniform setters query the driver again */
+    ReflectProgram();
+    uniform_.BuildLocationMap(reflection_.uniforms);
+
+    /* Store program binary in cache */
+    if (isLinked_ && useBinaryCache)
+        StoreCachedBinary(binaryKey);
+
     return isLinked_;
 }
 
+// Returns the bitmask of the specified shader stage for "glUseProgramStages".
+static GLbitfield GetShaderStageBit(const ShaderType type)
+{
+    switch (type)
+    {
+        case ShaderType::Vertex:            return GL_VERTEX_SHADER_BIT;
+        case ShaderType::TessControl:       return GL_TESS_CONTROL_SHADER_BIT;
+        case ShaderType::TessEvaluation:    return GL_TESS_EVALUATION_SHADER_BIT;
+        case ShaderType::Geometry:          return GL_GEOMETRY_SHADER_BIT;
+        case ShaderType::Fragment:          return GL_FRAGMENT_SHADER_BIT;
+        case ShaderType::Compute:           return GL_COMPUTE_SHADER_BIT;
+        #if defined LLGL_GL_ENABLE_VENDOR_EXT && defined GL_NV_mesh_shader
+        case ShaderType::Amplification:     return GL_TASK_SHADER_BIT_NV;
+        case ShaderType::Mesh:              return GL_MESH_SHADER_BIT_NV;
+        #endif
+        default:                            break;
+    }
+    return 0;
+}
+
+bool GLShaderProgram::LinkSeparableStages()
+{
+    if (!streamOutputFormat_.attributes.empty())
+        throw std::runtime_error("stream-outputs are not supported for separable shader programs");
+
+    hasReflection_ = false;
+    isLinked_ = true;
+
+    /* Reset all stages of the program pipeline */
+    glUseProgramStages(pipelineID_, GL_ALL_SHADER_BITS, 0);
+    stagePrograms_.clear();
+
+    for (auto shader : separableShaders_)
+    {
+        /* Get separable program of the shader (which is only linked once for all shader programs) */
+        auto program = shader->GetSeparableID();
+        stagePrograms_.push_back(program);
+
+        /* Query linking status */
+        GLint linkStatus = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus == GL_FALSE)
+            isLinked_ = false;
+
+        /* Use separable program for the stage of its shader */
+        glUseProgramStages(pipelineID_, GetShaderStageBit(shader->GetType()), program);
+    }
+
+    /* Uniforms and reflection refer to the first stage */
+    id_ = (stagePrograms_.empty() ? 0 : stagePrograms_.front());
+    ReflectProgram();
+    uniform_.SetProgram(id_);
+    uniform_.BuildLocationMap(reflection_.uniforms);
+
+    return isLinked_;
+}
+
+GLuint GLShaderProgram::GetStageProgram(const ShaderType stage) const
+{
+    if (!isLinked_)
+        return 0;
+
+    if (separable_)
+    {
+        /* Find separable program of the shader with the specified stage */
+        for (std::size_t i = 0; i < separableShaders_.size() && i < stagePrograms_.size(); ++i)
+        {
+            if (separableShaders_[i]->GetType() == stage)
+                return stagePrograms_[i];
+        }
+        return 0;
+    }
+
+    return id_;
+}
+
+void GLShaderProgram::ReflectProgram()
+{
+    hasReflection_ = false;
+
+    if (isLinked_)
+    {
+        /* Query reflection from the driver (the query functions only return the cache once it is complete) */
+        reflection_.vertexAttributes    = QueryVertexAttributes();
+        reflection_.constantBuffers     = QueryConstantBuffers();
+        reflection_.storageBuffers      = QueryStorageBuffers();
+        reflection_.uniforms            = QueryUniforms();
+        hasReflection_ = true;
+    }
+    else
+        reflection_ = GLProgramReflection();
+}
+
+// Returns the key for the program binary cache, which is identified by shader sources, attribute bindings, varyings, and driver.
+std::uint64_t GLShaderProgram::MakeBinaryKey()
+{
+    auto key = HashInitValue();
+
+    auto driverHash = binaryCache_->GetDriverHash();
+    HashBytes(key, &driverHash, sizeof(driverHash));
+
+    for (auto hash : shaderHashes_)
+        HashBytes(key, &hash, sizeof(hash));
+
+    HashBytes(key, &inputLayoutHash_, sizeof(inputLayoutHash_));
+
+    for (const auto& attr : streamOutputFormat_.attributes)
+        HashBytes(key, attr.name.c_str(), attr.name.size() + 1);
+
+    return key;
+}
+
+bool GLShaderProgram::LoadCachedBinary(std::uint64_t key)
+{
+    auto binary = binaryCache_->Find(key);
+    if (!binary)
+        return false;
+
+    /* Load program binary */
+    glProgramBinary(id_, binary->format, binary->data.data(), static_cast<GLsizei>(binary->data.size()));
+
+    /* Query linking status (the driver may reject binaries, e.g. after a driver update) */
+    GLint linkStatus = 0;
+    glGetProgramiv(id_, GL_LINK_STATUS, &linkStatus);
+
+    if (linkStatus == GL_FALSE)
+    {
+        binaryCache_->Remove(key);
+        return false;
+    }
+
+    /* Take reflection from cache to avoid the reflection queries */
+    isLinked_       = true;
+    reflection_     = binary->reflection;
+    hasReflection_  = true;
+
+    return true;
+}
+
+void GLShaderProgram::StoreCachedBinary(std::uint64_t key)
+{
+    /* Query program binary */
+    GLint binaryLength = 0;
+    glGetProgramiv(id_, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
+        return;
+
+    GLProgramBinary binary;
+    binary.data.resize(static_cast<std::size_t>(binaryLength));
+
+    GLsizei length = 0;
+    glGetProgramBinary(id_, binaryLength, &length, &(binary.format), binary.data.data());
+    binary.data.resize(static_cast<std::size_t>(length));
+
+    /* Store reflection together with the program binary */
+    binary.reflection = reflection_;
+
+    binaryCache_->Store(key, std::move(binary));
+}
+
 void GLShaderProgram::BuildTransformFeedbackVaryingsEXT(const std::vector<StreamOutputAttribute>& attributes)
 {
-    /* Specify transform-feedback varyings by names */
+    /* Sort attributes by their output slots */
+    std::vector<const StreamOutputAttribute*> sortedAttribs;
+    sortedAttribs.reserve(attributes.size());
+
+    for (const auto& attr : attributes)
+        sortedAttribs.push_back(&attr);
+
+    std::stable_sort(
+        sortedAttribs.begin(),
+        sortedAttribs.end(),
+        [](const StreamOutputAttribute* lhs, const StreamOutputAttribute* rhs)
+        {
+            return (lhs->outputSlot < rhs->outputSlot);
+        }
+    );
+
+    /* Specify transform-feedback varyings by names, and advance to the next buffer with "gl_NextBuffer" (GL_ARB_transform_feedback3) */
     std::vector<const GLchar*> varyings;
     varyings.reserve(attributes.size());
 
-    for (const auto& attr : attributes)
-        varyings.push_back(attr.name.c_str());
+    unsigned char outputSlot = 0;
+
+    for (auto attr : sortedAttribs)
+    {
+        if (attr->outputSlot > outputSlot)
+        {
+            if (!HasExtension(GLExt::ARB_transform_feedback3))
+                ThrowNotSupported("multiple stream-output buffers");
+            for (; outputSlot < attr->outputSlot; ++outputSlot)
+                varyings.push_back("gl_NextBuffer");
+        }
+        varyings.push_back(attr->name.c_str());
+    }
 
     glTransformFeedbackVaryings(id_, static_cast<GLsizei>(varyings.size()), varyings.data(), GL_INTERLEAVED_ATTRIBS);
 }
@@ -11,19 +11,28 @@
 
 #include <LLGL/ShaderProgram.h>
 #include "GLShaderUniform.h"
+#include "GLProgramBinaryCache.h"
 #include "../OpenGL.h"
+#include <cstdint>
+#include <vector>
 
 
 namespace LLGL
 {
 
 
+class GLShader;
+
 class GLShaderProgram : public ShaderProgram
 {
 
     public:
 
-        GLShaderProgram();
+        /*
+        If 'separable' is true, the attached shaders are not linked into this program,
+        but their separable programs are combined in a program pipeline object (requires GL_ARB_separate_shader_objects).
+        */
+        GLShaderProgram(GLProgramBinaryCache* binaryCache = nullptr, bool separable = false);
         ~GLShaderProgram();
 
         void AttachShader(Shader& shader) override;
@@ -39,6 +48,9 @@ class GLShaderProgram : public ShaderProgram
         std::vector<StorageBufferViewDescriptor> QueryStorageBuffers() const override;
         std::vector<UniformDescriptor> QueryUniforms() const override;
 
+        int QueryShaderInterfaceSlot(const ShaderType stage, const std::string& name) override;
+        int QueryShaderClassInstance(const ShaderType stage, const std::string& name) override;
+
         void BuildInputLayout(const VertexFormat& vertexFormat) override;
         void BindConstantBuffer(const std::string& name, unsigned int bindingIndex) override;
         void BindStorageBuffer(const std::string& name, unsigned int bindingIndex) override;
@@ -46,12 +58,30 @@ class GLShaderProgram : public ShaderProgram
         ShaderUniform* LockShaderUniform() override;
         void UnlockShaderUniform() override;
 
-        // Returns the shader program ID.
+        // Returns the shader program ID. For separable shader stages, this is the program of the first stage.
         inline GLuint GetID() const
         {
             return id_;
         }
 
+        // Returns true if this shader program combines separable shader stages in a program pipeline.
+        inline bool IsSeparable() const
+        {
+            return separable_;
+        }
+
+        // Returns the program pipeline ID, or zero if this shader program is not separable.
+        inline GLuint GetPipelineID() const
+        {
+            return pipelineID_;
+        }
+
+        // Returns the programs of all separable shader stages after linking.
+        inline const std::vector<GLuint>& GetStagePrograms() const
+        {
+            return stagePrograms_;
+        }
+
         // Returns true if this shader program has a fragment shader.
         inline bool HasFragmentShader() const
         {
@@ -65,7 +95,21 @@ class GLShaderProgram : public ShaderProgram
             GLint& numAttribs, GLint& maxNameLength, std::vector<char>& nameBuffer
         ) const;
 
+        // Queries the layout of all active members of the specified uniform block.
+        void QueryConstantBufferFields(GLuint blockIndex, std::vector<ConstantBufferFieldDescriptor>& fields) const;
+
         bool LinkShaderProgram();
+        bool LinkSeparableStages();
+
+        // Returns the program that contains the specified shader stage, or zero if there is no such stage.
+        GLuint GetStageProgram(const ShaderType stage) const;
+
+        // Queries the reflection of the linked program once and caches it for all further reflection queries.
+        void ReflectProgram();
+
+        std::uint64_t MakeBinaryKey();
+        bool LoadCachedBinary(std::uint64_t key);
+        void StoreCachedBinary(std::uint64_t key);
 
         void BuildTransformFeedbackVaryingsEXT(const std::vector<StreamOutputAttribute>& attributes);
     
@@ -82,6 +126,18 @@ class GLShaderProgram : public ShaderProgram
 
         StreamOutputFormat  streamOutputFormat_;
 
+        GLProgramBinaryCache*       binaryCache_        = nullptr;
+        std::vector<std::uint64_t>  shaderHashes_;
+        std::uint64_t               inputLayoutHash_    = 0;
+
+        GLProgramReflection         reflection_;
+        bool                        hasReflection_      = false;
+
+        bool                        separable_          = false;
+        GLuint                      pipelineID_         = 0;
+        std::vector<GLShader*>      separableShaders_;
+        std::vector<GLuint>         stagePrograms_;
+
 };
 
 
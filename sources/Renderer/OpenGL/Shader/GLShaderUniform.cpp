@@ -7,6 +7,7 @@
 
 #include "GLShaderUniform.h"
 #include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
 
 
 namespace LLGL
@@ -14,63 +15,69 @@ namespace LLGL
 
 
 GLShaderUniform::GLShaderUniform(GLuint program) :
-    program_ { program }
+    program_         { program                                          },
+    programUniforms_ { HasExtension(GLExt::ARB_separate_shader_objects) }
 {
 }
 
+int GLShaderUniform::GetUniformLocation(const std::string& name)
+{
+    return GetLocation(name);
+}
+
 void GLShaderUniform::SetUniform(int location, const int value)
 {
-    glUniform1iv(location, 1, &value);
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Vector2i& value)
 {
-    glUniform2iv(location, 1, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Vector3i& value)
 {
-    glUniform3iv(location, 1, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Vector4i& value)
 {
-    glUniform4iv(location, 1, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const float value)
 {
-    glUniform4fv(location, 1, &value);
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Vector2f& value)
 {
-    glUniform4fv(location, 1, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Vector3f& value)
 {
-    glUniform4fv(location, 1, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Vector4f& value)
 {
-    glUniform4fv(location, 1, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Matrix2f& value)
 {
-    glUniformMatrix2fv(location, 1, GL_FALSE, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Matrix3f& value)
 {
-    glUniformMatrix3fv(location, 1, GL_FALSE, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(int location, const Gs::Matrix4f& value)
 {
-    glUniformMatrix4fv(location, 1, GL_FALSE, value.Ptr());
+    SetUniformArray(location, &value, 1);
 }
 
 void GLShaderUniform::SetUniform(const std::string& name, const int value)
@@ -130,60 +137,92 @@ void GLShaderUniform::SetUniform(const std::string& name, const Gs::Matrix4f& va
 
 void GLShaderUniform::SetUniformArray(int location, const int* value, std::size_t count)
 {
-    glUniform1iv(location, static_cast<GLsizei>(count), value);
+    if (programUniforms_)
+        glProgramUniform1iv(program_, location, static_cast<GLsizei>(count), value);
+    else
+        glUniform1iv(location, static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Vector2i* value, std::size_t count)
 {
-    glUniform2iv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
+    if (programUniforms_)
+        glProgramUniform2iv(program_, location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
+    else
+        glUniform2iv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Vector3i* value, std::size_t count)
 {
-    glUniform3iv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
+    if (programUniforms_)
+        glProgramUniform3iv(program_, location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
+    else
+        glUniform3iv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Vector4i* value, std::size_t count)
 {
-    glUniform4iv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
+    if (programUniforms_)
+        glProgramUniform4iv(program_, location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
+    else
+        glUniform4iv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLint*>(value));
 }
 
 void GLShaderUniform::SetUniformArray(int location, const float* value, std::size_t count)
 {
-    glUniform1fv(location, static_cast<GLsizei>(count), value);
+    if (programUniforms_)
+        glProgramUniform1fv(program_, location, static_cast<GLsizei>(count), value);
+    else
+        glUniform1fv(location, static_cast<GLsizei>(count), value);
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Vector2f* value, std::size_t count)
 {
-    glUniform2fv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
+    if (programUniforms_)
+        glProgramUniform2fv(program_, location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
+    else
+        glUniform2fv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Vector3f* value, std::size_t count)
 {
-    glUniform3fv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
+    if (programUniforms_)
+        glProgramUniform3fv(program_, location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
+    else
+        glUniform3fv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Vector4f* value, std::size_t count)
 {
-    glUniform4fv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
+    if (programUniforms_)
+        glProgramUniform4fv(program_, location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
+    else
+        glUniform4fv(location, static_cast<GLsizei>(count), reinterpret_cast<const GLfloat*>(value));
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Matrix2f* value, std::size_t count)
 {
-    glUniformMatrix2fv(location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
+    if (programUniforms_)
+        glProgramUniformMatrix2fv(program_, location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
+    else
+        glUniformMatrix2fv(location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Matrix3f* value, std::size_t count)
 {
-    glUniformMatrix3fv(location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
+    if (programUniforms_)
+        glProgramUniformMatrix3fv(program_, location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
+    else
+        glUniformMatrix3fv(location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
 }
 
 void GLShaderUniform::SetUniformArray(int location, const Gs::Matrix4f* value, std::size_t count)
 {
-    glUniformMatrix4fv(location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
+    if (programUniforms_)
+        glProgramUniformMatrix4fv(program_, location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
+    else
+        glUniformMatrix4fv(location, static_cast<GLsizei>(count), GL_FALSE, reinterpret_cast<const GLfloat*>(value));
 }
 
-
 void GLShaderUniform::SetUniformArray(const std::string& name, const int* value, std::size_t count)
 {
     SetUniformArray(GetLocation(name), value, count);
@@ -239,14 +278,42 @@ void GLShaderUniform::SetUniformArray(const std::string& name, const Gs::Matrix4
     SetUniformArray(GetLocation(name), value, count);
 }
 
+void GLShaderUniform::BuildLocationMap(const std::vector<UniformDescriptor>& uniforms)
+{
+    locations_.Clear();
+
+    for (const auto& uniform : uniforms)
+    {
+        locations_.Insert(uniform.name, uniform.location, uniform.type);
+
+        /* Active uniform arrays are reported as "name[0]", but they can also be referred to as "name" */
+        const auto n = uniform.name.size();
+        if (n > 3 && uniform.name.compare(n - 3, 3, "[0]") == 0)
+            locations_.Insert(uniform.name.substr(0, n - 3), uniform.location, uniform.type);
+    }
+}
+
+void GLShaderUniform::SetProgram(GLuint program)
+{
+    program_ = program;
+    locations_.Clear();
+}
+
 
 /*
  * ======= Private: =======
  */
 
-GLint GLShaderUniform::GetLocation(const std::string& name) const
+GLint GLShaderUniform::GetLocation(const std::string& name)
 {
-    return glGetUniformLocation(program_, name.c_str());
+    /* Find location in the reflected uniforms first, and only query the driver for unknown names */
+    if (auto entry = locations_.Find(name))
+        return entry->location;
+
+    auto location = glGetUniformLocation(program_, name.c_str());
+    locations_.Insert(name, location, UniformType::Float);
+
+    return location;
 }
 
 
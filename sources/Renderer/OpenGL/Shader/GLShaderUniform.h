@@ -10,7 +10,9 @@
 
 
 #include <LLGL/ShaderUniform.h>
+#include "GLUniformLocationMap.h"
 #include "../OpenGL.h"
+#include <vector>
 
 
 namespace LLGL
@@ -24,6 +26,8 @@ class GLShaderUniform : public ShaderUniform
 
         GLShaderUniform(GLuint program);
 
+        int GetUniformLocation(const std::string& name) override;
+
         void SetUniform(int location, const int value) override;
         void SetUniform(int location, const Gs::Vector2i& value) override;
         void SetUniform(int location, const Gs::Vector3i& value) override;
@@ -80,11 +84,28 @@ class GLShaderUniform : public ShaderUniform
         void SetUniformArray(const std::string& name, const Gs::Matrix3f* value, std::size_t count) override;
         void SetUniformArray(const std::string& name, const Gs::Matrix4f* value, std::size_t count) override;
 
+        /*
+        Rebuilds the uniform location map from the reflection of the linked shader program.
+        Names that are not in the map (e.g. array elements other than the first one) are queried on demand and then cached as well.
+        */
+        void BuildLocationMap(const std::vector<UniformDescriptor>& uniforms);
+
+        // Sets the program whose uniforms are addressed (for separable shader stages). The location map must be rebuilt afterwards.
+        void SetProgram(GLuint program);
+
+        // Returns true if uniforms are written with "glProgramUniform*" (GL_ARB_separate_shader_objects), so the program does not need to be bound.
+        inline bool HasProgramUniforms() const
+        {
+            return programUniforms_;
+        }
+
     private:
 
-        GLint GetLocation(const std::string& name) const;
+        GLint GetLocation(const std::string& name);
 
-        GLuint program_ = 0;
+        GLuint                  program_            = 0;
+        bool                    programUniforms_    = false;
+        GLUniformLocationMap    locations_;
 
 };
 
@@ -0,0 +1,111 @@
+/*
+ * GLUniformLocationMap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLUniformLocationMap.h"
+#include "GLProgramBinaryCache.h"
+#include "../../../Core/Hash.h"
+
+
+namespace LLGL
+{
+
+
+// Initial number of slots, which is sufficient for most shader programs.
+static const std::size_t g_uniformMapInitialCapacity = 16;
+
+void GLUniformLocationMap::Clear()
+{
+    entries_.clear();
+    used_.clear();
+    size_ = 0;
+}
+
+void GLUniformLocationMap::Insert(const std::string& name, GLint location, UniformType type)
+{
+    /* Keep the load factor below 1/2, so the probing sequences stay short */
+    if ((size_ + 1) * 2 > entries_.size())
+        Rehash(entries_.empty() ? g_uniformMapInitialCapacity : entries_.size() * 2);
+
+    auto hash = HashName(name);
+    auto slot = FindSlot(hash, name);
+
+    auto& entry = entries_[slot];
+    if (!used_[slot])
+    {
+        entry.hash  = hash;
+        entry.name  = name;
+        used_[slot] = true;
+        ++size_;
+    }
+
+    entry.location  = location;
+    entry.type      = type;
+}
+
+const GLUniformLocationMap::Entry* GLUniformLocationMap::Find(const std::string& name) const
+{
+    if (size_ == 0)
+        return nullptr;
+
+    auto slot = FindSlot(HashName(name), name);
+    return (used_[slot] ? &(entries_[slot]) : nullptr);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint64_t GLUniformLocationMap::HashName(const std::string& name)
+{
+    auto hash = HashInitValue();
+    HashBytes(hash, name.data(), name.size());
+    return hash;
+}
+
+std::size_t GLUniformLocationMap::FindSlot(std::uint64_t hash, const std::string& name) const
+{
+    const auto mask = entries_.size() - 1;
+
+    for (auto slot = static_cast<std::size_t>(hash) & mask;; slot = (slot + 1) & mask)
+    {
+        if (!used_[slot])
+            return slot;
+
+        const auto& entry = entries_[slot];
+        if (entry.hash == hash && entry.name == name)
+            return slot;
+    }
+}
+
+void GLUniformLocationMap::Rehash(std::size_t capacity)
+{
+    auto entries    = std::move(entries_);
+    auto used       = std::move(used_);
+
+    entries_.clear();
+    entries_.resize(capacity);
+    used_.assign(capacity, false);
+
+    /* Re-insert all used entries into the new slots */
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        if (used[i])
+        {
+            auto slot = FindSlot(entries[i].hash, entries[i].name);
+            entries_[slot]  = std::move(entries[i]);
+            used_[slot]     = true;
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
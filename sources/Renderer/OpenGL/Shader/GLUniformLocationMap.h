@@ -0,0 +1,78 @@
+/*
+ * GLUniformLocationMap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_UNIFORM_LOCATION_MAP_H
+#define LLGL_GL_UNIFORM_LOCATION_MAP_H
+
+
+#include <LLGL/ShaderUniform.h>
+#include "../OpenGL.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Flat hash map (open addressing with linear probing) from uniform names to their locations and types.
+All entries are stored in a single array, so a lookup only compares the hash values until the matching entry is found.
+*/
+class GLUniformLocationMap
+{
+
+    public:
+
+        struct Entry
+        {
+            std::uint64_t   hash        = 0;
+            std::string     name;
+            GLint           location    = -1;
+            UniformType     type        = UniformType::Float;
+        };
+
+        // Removes all entries.
+        void Clear();
+
+        // Inserts the specified entry or replaces the location and type of the entry with the same name.
+        void Insert(const std::string& name, GLint location, UniformType type);
+
+        // Returns the entry with the specified name, or null if there is no such entry.
+        const Entry* Find(const std::string& name) const;
+
+        // Returns the number of entries.
+        inline std::size_t Size() const
+        {
+            return size_;
+        }
+
+    private:
+
+        static std::uint64_t HashName(const std::string& name);
+
+        // Returns the slot for the specified name, which is either the matching entry or the first free slot.
+        std::size_t FindSlot(std::uint64_t hash, const std::string& name) const;
+
+        void Rehash(std::size_t capacity);
+
+        std::vector<Entry>  entries_;   // capacity is always zero or a power of two
+        std::vector<bool>   used_;
+        std::size_t         size_       = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -61,6 +61,18 @@ void GLFramebuffer::AttachTextureLayer(GLenum attachment, GLuint textureID, GLin
     glFramebufferTextureLayer(GL_FRAMEBUFFER, attachment, textureID, mipLevel, layer);
 }
 
+void GLFramebuffer::AttachTextureMultiview(GLenum attachment, GLuint textureID, GLint mipLevel, GLint baseViewIndex, GLsizei numViews)
+{
+    #ifdef GL_OVR_multiview
+    glFramebufferTextureMultiviewOVR(GL_FRAMEBUFFER, attachment, textureID, mipLevel, baseViewIndex, numViews);
+    #endif
+}
+
+void GLFramebuffer::AttachTextureLayered(GLenum attachment, GLuint textureID, GLint mipLevel)
+{
+    glFramebufferTexture(GL_FRAMEBUFFER, attachment, textureID, mipLevel);
+}
+
 void GLFramebuffer::AttachRenderbuffer(GLenum attachment, GLuint renderbufferID)
 {
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, renderbufferID);
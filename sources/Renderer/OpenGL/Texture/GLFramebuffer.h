@@ -39,6 +39,8 @@ class GLFramebuffer
         static void AttachTexture2D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel);
         static void AttachTexture3D(GLenum attachment, GLenum textureTarget, GLuint textureID, GLint mipLevel, GLint zOffset);
         static void AttachTextureLayer(GLenum attachment, GLuint textureID, GLint mipLevel, GLint layer);
+        static void AttachTextureMultiview(GLenum attachment, GLuint textureID, GLint mipLevel, GLint baseViewIndex, GLsizei numViews);
+        static void AttachTextureLayered(GLenum attachment, GLuint textureID, GLint mipLevel);
         
         static void AttachRenderbuffer(GLenum attachment, GLuint renderbufferID);
 
@@ -0,0 +1,159 @@
+/*
+ * GLFramebufferCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLFramebufferCache.h"
+#include "../Ext/GLExtensions.h"
+#include "../../GLCommon/GLCore.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+
+namespace LLGL
+{
+
+
+bool operator < (const GLFramebufferAttachment& lhs, const GLFramebufferAttachment& rhs)
+{
+    return
+    (
+        std::tie(lhs.type, lhs.attachment, lhs.target, lhs.id, lhs.mipLevel, lhs.layer, lhs.numViews) <
+        std::tie(rhs.type, rhs.attachment, rhs.target, rhs.id, rhs.mipLevel, rhs.layer, rhs.numViews)
+    );
+}
+
+static void AttachToBoundFramebuffer(const GLFramebufferAttachment& attachment)
+{
+    switch (attachment.type)
+    {
+        case GLFramebufferAttachmentType::Texture1D:
+            GLFramebuffer::AttachTexture1D(attachment.attachment, attachment.target, attachment.id, attachment.mipLevel);
+            break;
+        case GLFramebufferAttachmentType::Texture2D:
+            GLFramebuffer::AttachTexture2D(attachment.attachment, attachment.target, attachment.id, attachment.mipLevel);
+            break;
+        case GLFramebufferAttachmentType::Texture3D:
+            GLFramebuffer::AttachTexture3D(attachment.attachment, attachment.target, attachment.id, attachment.mipLevel, attachment.layer);
+            break;
+        case GLFramebufferAttachmentType::TextureLayer:
+            GLFramebuffer::AttachTextureLayer(attachment.attachment, attachment.id, attachment.mipLevel, attachment.layer);
+            break;
+        case GLFramebufferAttachmentType::TextureMultiview:
+            GLFramebuffer::AttachTextureMultiview(attachment.attachment, attachment.id, attachment.mipLevel, attachment.layer, attachment.numViews);
+            break;
+        case GLFramebufferAttachmentType::TextureLayered:
+            GLFramebuffer::AttachTextureLayered(attachment.attachment, attachment.id, attachment.mipLevel);
+            break;
+        case GLFramebufferAttachmentType::Renderbuffer:
+            GLFramebuffer::AttachRenderbuffer(attachment.attachment, attachment.id);
+            break;
+    }
+}
+
+static bool IsColorAttachment(GLenum attachment)
+{
+    return (attachment >= GL_COLOR_ATTACHMENT0 && attachment <= GL_COLOR_ATTACHMENT15);
+}
+
+// Sets the draw buffers of the bound FBO to its color attachments.
+static void SetDrawBuffersToBoundFramebuffer(const std::vector<GLFramebufferAttachment>& attachments)
+{
+    std::vector<GLenum> drawBuffers;
+
+    for (const auto& attachment : attachments)
+    {
+        if (IsColorAttachment(attachment.attachment))
+            drawBuffers.push_back(attachment.attachment);
+    }
+
+    if (drawBuffers.empty())
+        glDrawBuffer(GL_NONE);
+    else if (drawBuffers.size() == 1)
+        glDrawBuffer(drawBuffers.front());
+    else
+        glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+}
+
+GLFramebuffer* GLFramebufferCache::FindOrCreate(const std::vector<GLFramebufferAttachment>& attachments)
+{
+    /* Find FBO with the same attachment set */
+    auto it = framebuffers_.find(attachments);
+    if (it != framebuffers_.end())
+        return it->second.get();
+
+    /* Create new FBO and validate it once */
+    auto framebuffer = MakeUnique<GLFramebuffer>();
+    GLenum status = GL_FRAMEBUFFER_COMPLETE;
+
+    framebuffer->Bind();
+    {
+        for (const auto& attachment : attachments)
+            AttachToBoundFramebuffer(attachment);
+
+        SetDrawBuffersToBoundFramebuffer(attachments);
+
+        /* An empty attachment set is used for render targets that have not been configured yet */
+        if (!attachments.empty())
+            status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    }
+    framebuffer->Unbind();
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        throw std::runtime_error("validation of framebuffer object (FBO) failed (error code = " + GLErrorToStr(status) + ")");
+
+    auto ref = framebuffer.get();
+    framebuffers_[attachments] = std::move(framebuffer);
+
+    return ref;
+}
+
+void GLFramebufferCache::NotifyTextureRelease(GLuint texture)
+{
+    ReleaseFramebuffersWithObject(false, texture);
+}
+
+void GLFramebufferCache::NotifyRenderbufferRelease(GLuint renderbuffer)
+{
+    ReleaseFramebuffersWithObject(true, renderbuffer);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLFramebufferCache::ReleaseFramebuffersWithObject(bool renderbuffer, GLuint id)
+{
+    auto HasObject = [renderbuffer, id](const GLFramebufferAttachment& attachment)
+    {
+        return ((attachment.type == GLFramebufferAttachmentType::Renderbuffer) == renderbuffer && attachment.id == id);
+    };
+
+    bool released = false;
+
+    for (auto it = framebuffers_.begin(); it != framebuffers_.end();)
+    {
+        if (std::any_of(it->first.begin(), it->first.end(), HasObject))
+        {
+            it = framebuffers_.erase(it);
+            released = true;
+        }
+        else
+            ++it;
+    }
+
+    if (released)
+        ++generation_;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,92 @@
+/*
+ * GLFramebufferCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_FRAMEBUFFER_CACHE_H
+#define LLGL_GL_FRAMEBUFFER_CACHE_H
+
+
+#include "GLFramebuffer.h"
+#include <map>
+#include <memory>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+enum class GLFramebufferAttachmentType
+{
+    Texture1D,
+    Texture2D,
+    Texture3D,
+    TextureLayer,
+    TextureMultiview,
+    TextureLayered,
+    Renderbuffer,
+};
+
+// Single attachment of a framebuffer object, i.e. a texture subresource or a renderbuffer.
+struct GLFramebufferAttachment
+{
+    GLFramebufferAttachmentType type;
+    GLenum                      attachment;     // e.g. GL_COLOR_ATTACHMENT0 or GL_DEPTH_ATTACHMENT
+    GLenum                      target;         // texture target (e.g. a cube face), or GL_RENDERBUFFER
+    GLuint                      id;             // texture or renderbuffer ID
+    GLint                       mipLevel;
+    GLint                       layer;          // z-offset for 3D textures, or first view for multiview attachments
+    GLsizei                     numViews;       // number of views for multiview attachments
+};
+
+bool operator < (const GLFramebufferAttachment& lhs, const GLFramebufferAttachment& rhs);
+
+/*
+Cache for framebuffer objects (FBO), which are shared between all render targets with the same attachment set.
+An FBO is validated with "glCheckFramebufferStatus" only once when it is created, so switching between
+attachment sets that have already been used (e.g. post-processing ping-pong) does not validate the FBO again.
+The draw buffers of each FBO are set to its color attachments in the order they appear in the attachment set.
+*/
+class GLFramebufferCache
+{
+
+    public:
+
+        // Returns the FBO for the specified attachment set. The FBO is created and validated if there is no FBO with these attachments yet.
+        GLFramebuffer* FindOrCreate(const std::vector<GLFramebufferAttachment>& attachments);
+
+        // Releases all FBOs that have the specified texture attached, since the texture ID might be reused.
+        void NotifyTextureRelease(GLuint texture);
+
+        // Releases all FBOs that have the specified renderbuffer attached, since the renderbuffer ID might be reused.
+        void NotifyRenderbufferRelease(GLuint renderbuffer);
+
+        // Returns the number of times FBOs have been released. FBO references must be looked up again when this value has changed.
+        inline unsigned int GetGeneration() const
+        {
+            return generation_;
+        }
+
+    private:
+
+        using GLFramebufferKey = std::vector<GLFramebufferAttachment>;
+
+        void ReleaseFramebuffersWithObject(bool renderbuffer, GLuint id);
+
+        std::map<GLFramebufferKey, std::unique_ptr<GLFramebuffer>>  framebuffers_;
+        unsigned int                                                generation_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
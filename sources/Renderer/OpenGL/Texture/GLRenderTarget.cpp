@@ -11,6 +11,7 @@
 #include "../../CheckedCast.h"
 #include "../../GLCommon/GLTypes.h"
 #include "../../GLCommon/GLCore.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
 #include "../../../Core/Helper.h"
 
 
@@ -24,11 +25,11 @@ static void DepthAttachmentFailed()
     throw std::runtime_error("attachment to render target failed, because render target already has a depth- or depth-stencil buffer");
 }
 
-GLRenderTarget::GLRenderTarget(const RenderTargetDescriptor& desc) :
-    multiSamples_ { static_cast<GLsizei>(desc.multiSampling.SampleCount()) }
+GLRenderTarget::GLRenderTarget(const RenderTargetDescriptor& desc, GLFramebufferCache& framebufferCache) :
+    framebufferCache_ { framebufferCache                                        },
+    multiSamples_     { static_cast<GLsizei>(desc.multiSampling.SampleCount()) }
 {
-    if (HasMultiSampling() && !desc.customMultiSampling)
-        CreateOnceFramebufferMS();
+    useFramebufferMS_ = (HasMultiSampling() && !desc.customMultiSampling);
 }
 
 void GLRenderTarget::AttachDepthBuffer(const Gs::Vector2ui& size)
@@ -49,11 +50,6 @@ void GLRenderTarget::AttachDepthStencilBuffer(const Gs::Vector2ui& size)
     blitMask_ |= (GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 }
 
-static GLenum CheckDrawFramebufferStatus()
-{
-    return glCheckFramebufferStatus(GL_FRAMEBUFFER);
-}
-
 // Returns the GL internal format for the specified texture object
 static GLint GetTexInternalFormat(const GLTexture& textureGL)
 {
@@ -67,6 +63,11 @@ static GLint GetTexInternalFormat(const GLTexture& textureGL)
 
 void GLRenderTarget::AttachTexture(Texture& texture, const RenderTargetAttachmentDescriptor& attachmentDesc)
 {
+    if (attachmentDesc.layered)
+        ValidateLayeredAttachment(texture);
+    else if (attachmentDesc.numViews > 1)
+        ValidateMultiviewAttachment(texture, attachmentDesc.numViews);
+
     /* Get OpenGL texture object */
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     auto textureID = textureGL.GetID();
@@ -79,93 +80,107 @@ void GLRenderTarget::AttachTexture(Texture& texture, const RenderTargetAttachmen
     const auto internalFormat   = GetTexInternalFormat(textureGL);
     const auto attachment       = MakeFramebufferAttachment(internalFormat);
 
-    /* Attach texture to framebuffer */
-    GLenum status = 0;
+    /* Add texture to attachment set of the framebuffer (the FBO is validated once it is bound) */
+    GLFramebufferAttachment attachmentGL;
+    {
+        attachmentGL.type       = GLFramebufferAttachmentType::TextureLayer;
+        attachmentGL.attachment = attachment;
+        attachmentGL.target     = GLTypes::Map(texture.GetType());
+        attachmentGL.id         = textureID;
+        attachmentGL.mipLevel   = static_cast<GLint>(mipLevel);
+        attachmentGL.layer      = static_cast<GLint>(attachmentDesc.layer);
+        attachmentGL.numViews   = 1;
+    }
 
-    framebuffer_.Bind();
+    switch (texture.GetType())
     {
-        switch (texture.GetType())
-        {
-            case TextureType::Texture1D:
-                GLFramebuffer::AttachTexture1D(attachment, GL_TEXTURE_1D, textureID, mipLevel);
-                break;
-            case TextureType::Texture2D:
-                GLFramebuffer::AttachTexture2D(attachment, GL_TEXTURE_2D, textureID, mipLevel);
-                break;
-            case TextureType::Texture3D:
-                GLFramebuffer::AttachTexture3D(attachment, GL_TEXTURE_3D, textureID, mipLevel, attachmentDesc.layer);
-                break;
-            case TextureType::TextureCube:
-                GLFramebuffer::AttachTexture2D(attachment, GLTypes::Map(attachmentDesc.cubeFace), textureID, mipLevel);
-                break;
-            case TextureType::Texture1DArray:
-                GLFramebuffer::AttachTextureLayer(attachment, textureID, mipLevel, attachmentDesc.layer);
-                break;
-            case TextureType::Texture2DArray:
-                GLFramebuffer::AttachTextureLayer(attachment, textureID, mipLevel, attachmentDesc.layer);
-                break;
-            case TextureType::TextureCubeArray:
-                GLFramebuffer::AttachTextureLayer(attachment, textureID, mipLevel, attachmentDesc.layer * 6 + static_cast<int>(attachmentDesc.cubeFace));
-                break;
-            case TextureType::Texture2DMS:
-                GLFramebuffer::AttachTexture2D(attachment, GL_TEXTURE_2D_MULTISAMPLE, textureID, 0);
-                break;
-            case TextureType::Texture2DMSArray:
-                GLFramebuffer::AttachTextureLayer(attachment, textureID, 0, attachmentDesc.layer);
-                break;
-        }
+        case TextureType::Texture1D:
+            attachmentGL.type   = GLFramebufferAttachmentType::Texture1D;
+            attachmentGL.layer  = 0;
+            break;
+        case TextureType::Texture2D:
+            attachmentGL.type   = GLFramebufferAttachmentType::Texture2D;
+            attachmentGL.layer  = 0;
+            break;
+        case TextureType::Texture3D:
+            attachmentGL.type   = GLFramebufferAttachmentType::Texture3D;
+            break;
+        case TextureType::TextureCube:
+            attachmentGL.type   = GLFramebufferAttachmentType::Texture2D;
+            attachmentGL.target = GLTypes::Map(attachmentDesc.cubeFace);
+            attachmentGL.layer  = 0;
+            break;
+        case TextureType::Texture1DArray:
+            break;
+        case TextureType::Texture2DArray:
+            if (attachmentDesc.numViews > 1 && !attachmentDesc.layered)
+            {
+                /* Attach range of layers as views, which are rendered with a single draw call */
+                attachmentGL.type       = GLFramebufferAttachmentType::TextureMultiview;
+                attachmentGL.numViews   = static_cast<GLsizei>(attachmentDesc.numViews);
+            }
+            break;
+        case TextureType::TextureCubeArray:
+            attachmentGL.layer  = static_cast<GLint>(attachmentDesc.layer * 6 + static_cast<int>(attachmentDesc.cubeFace));
+            break;
+        case TextureType::Texture2DMS:
+            attachmentGL.type       = GLFramebufferAttachmentType::Texture2D;
+            attachmentGL.target     = GL_TEXTURE_2D_MULTISAMPLE;
+            attachmentGL.mipLevel   = 0;
+            attachmentGL.layer      = 0;
+            break;
+        case TextureType::Texture2DMSArray:
+            attachmentGL.mipLevel   = 0;
+            break;
+    }
 
-        status = CheckDrawFramebufferStatus();
-        
-        /* Set draw buffers for this framebuffer if multi-sampling is disabled */
-        if (!framebufferMS_)
-            SetDrawBuffers();
+    /* Attach all layers (or cube faces, or depth slices) at once, which are selected per primitive in the shader */
+    if (attachmentDesc.layered)
+    {
+        attachmentGL.type   = GLFramebufferAttachmentType::TextureLayered;
+        attachmentGL.layer  = 0;
     }
-    framebuffer_.Unbind();
 
-    CheckFramebufferStatus(status, "color attachment to framebuffer object (FBO)");
+    attachments_.push_back(attachmentGL);
 
     /* Create renderbuffer for attachment if multi-sample framebuffer is used */
-    if (framebufferMS_)
+    if (useFramebufferMS_)
     {
         auto renderbuffer = MakeUnique<GLRenderbuffer>();
         {
             /* Setup renderbuffer storage by texture's internal format */
             InitRenderbufferStorage(*renderbuffer, static_cast<GLenum>(internalFormat));
 
-            /* Attach renderbuffer to multi-sample framebuffer */
-            framebufferMS_->Bind();
-            {
-                GLFramebuffer::AttachRenderbuffer(attachment, renderbuffer->GetID());
-                status = CheckDrawFramebufferStatus();
-                
-                /* Set draw buffers for this framebuffer is multi-sampling is enabled */
-                SetDrawBuffers();
-            }
-            framebufferMS_->Unbind();
-
-            CheckFramebufferStatus(status, "color attachment to multi-sample framebuffer object (FBO)");
+            /* Add renderbuffer to attachment set of the multi-sample framebuffer */
+            attachmentsMS_.push_back({ GLFramebufferAttachmentType::Renderbuffer, attachment, GL_RENDERBUFFER, renderbuffer->GetID(), 0, 0, 0 });
         }
         renderbuffersMS_.emplace_back(std::move(renderbuffer));
     }
+
+    framebuffersDirty_ = true;
 }
 
 void GLRenderTarget::DetachAll()
 {
-    /* Reset framebuffer and renderbuffer objects */
+    /* Reset attachment sets and renderbuffer objects; the FBOs of texture attachments remain in the FBO cache for reuse */
     ResetResolution();
 
-    framebuffer_.Recreate();
+    ReleaseRenderbuffers();
 
     renderbuffer_.reset();
+    renderbuffersMS_.clear();
 
-    if (framebufferMS_)
-        framebufferMS_->Recreate();
-
+    attachments_.clear();
+    attachmentsMS_.clear();
     colorAttachments_.clear();
-    renderbuffersMS_.clear();
 
-    blitMask_ = 0;
+    framebuffer_        = nullptr;
+    framebufferMS_      = nullptr;
+    framebuffersDirty_  = true;
+
+    blitMask_           = 0;
+    numViews_           = 0;
+    renderbufferMemory_ = 0;
 }
 
 /* ----- Extended Internal Functions ----- */
@@ -176,21 +191,34 @@ multi-sample framebuffer (read) into the main framebuffer (draw)
 */
 void GLRenderTarget::BlitOntoFrameBuffer()
 {
-    if (framebufferMS_)
+    if (useFramebufferMS_)
     {
-        framebuffer_.Bind(GLFramebufferTarget::DRAW_FRAMEBUFFER);
+        UpdateFramebuffers();
+
+        framebuffer_->Bind(GLFramebufferTarget::DRAW_FRAMEBUFFER);
         framebufferMS_->Bind(GLFramebufferTarget::READ_FRAMEBUFFER);
 
-        for (auto attachment : colorAttachments_)
+        if (colorAttachments_.empty())
         {
-            glReadBuffer(attachment);
-            glDrawBuffer(attachment);
-
+            /* Blit only the depth-stencil attachment (e.g. for shadow maps) */
             GLFramebuffer::Blit(GetResolution().Cast<int>(), blitMask_);
         }
+        else
+        {
+            for (auto attachment : colorAttachments_)
+            {
+                glReadBuffer(attachment);
+                glDrawBuffer(attachment);
+
+                GLFramebuffer::Blit(GetResolution().Cast<int>(), blitMask_);
+            }
+
+            /* Restore draw buffers, since the FBO might be shared with other render targets */
+            SetDrawBuffers();
+        }
 
         framebufferMS_->Unbind(GLFramebufferTarget::READ_FRAMEBUFFER);
-        framebuffer_.Unbind(GLFramebufferTarget::DRAW_FRAMEBUFFER);
+        framebuffer_->Unbind(GLFramebufferTarget::DRAW_FRAMEBUFFER);
     }
 }
 
@@ -214,9 +242,10 @@ void GLRenderTarget::BlitOntoScreen(std::size_t colorAttachmentIndex)
     }
 }
 
-const GLFramebuffer& GLRenderTarget::GetFramebuffer() const
+const GLFramebuffer& GLRenderTarget::GetFramebuffer()
 {
-    return (framebufferMS_ != nullptr ? *framebufferMS_ : framebuffer_);
+    UpdateFramebuffers();
+    return (useFramebufferMS_ ? *framebufferMS_ : *framebuffer_);
 }
 
 
@@ -231,20 +260,15 @@ void GLRenderTarget::InitRenderbufferStorage(GLRenderbuffer& renderbuffer, GLenu
         GLRenderbuffer::Storage(internalFormat, GetResolution().Cast<int>(), multiSamples_);
     }
     renderbuffer.Unbind();
-}
 
-GLenum GLRenderTarget::AttachDefaultRenderbuffer(GLFramebuffer& framebuffer, GLenum attachment)
-{
-    GLenum status = 0;
+    /* Accumulate estimated renderbuffer memory */
+    TextureFormat format = TextureFormat::Unknown;
+    GLTypes::Unmap(format, internalFormat);
 
-    framebuffer.Bind();
-    {
-        GLFramebuffer::AttachRenderbuffer(attachment, renderbuffer_->GetID());
-        status = CheckDrawFramebufferStatus();
-    }
-    framebuffer.Unbind();
+    auto texelSize  = (internalFormat == GL_STENCIL_INDEX ? 1u : TextureFormatSize(format));
+    auto resolution = GetResolution();
 
-    return status;
+    renderbufferMemory_ += static_cast<std::uint64_t>(resolution.x) * resolution.y * std::max(1, multiSamples_) * texelSize;
 }
 
 void GLRenderTarget::AttachRenderbuffer(const Gs::Vector2ui& size, GLenum internalFormat, GLenum attachment)
@@ -259,27 +283,53 @@ void GLRenderTarget::AttachRenderbuffer(const Gs::Vector2ui& size, GLenum intern
         /* Setup renderbuffer storage */
         InitRenderbufferStorage(*renderbuffer_, internalFormat);
 
-        /* Attach renderbuffer to framebuffer (or multi-sample framebuffer if multi-sampling is used) */
-        GLenum status = 0;
+        /* Add renderbuffer to attachment set of the framebuffer (or multi-sample framebuffer if multi-sampling is used) */
+        GLFramebufferAttachment attachmentGL { GLFramebufferAttachmentType::Renderbuffer, attachment, GL_RENDERBUFFER, renderbuffer_->GetID(), 0, 0, 0 };
 
-        if (framebufferMS_)
-        {
-            status = AttachDefaultRenderbuffer(*framebufferMS_, attachment);
-            CheckFramebufferStatus(status, "depth- or depth-stencil attachment to multi-sample framebuffer object (FBO)");
-        }
+        if (useFramebufferMS_)
+            attachmentsMS_.push_back(attachmentGL);
         else
-        {
-            status = AttachDefaultRenderbuffer(framebuffer_, attachment);
-            CheckFramebufferStatus(status, "depth- or depth-stencil attachment to framebuffer object (FBO)");
-        }
+            attachments_.push_back(attachmentGL);
+
+        framebuffersDirty_ = true;
     }
     else
         DepthAttachmentFailed();
 }
 
+// Returns true if the specified internal format is a depth format (GL reports sized formats for textures with an unsized internal format).
+static bool IsDepthInternalFormat(GLint internalFormat)
+{
+    switch (internalFormat)
+    {
+        case GL_DEPTH_COMPONENT:
+        case GL_DEPTH_COMPONENT16:
+        case GL_DEPTH_COMPONENT24:
+        case GL_DEPTH_COMPONENT32:
+        case GL_DEPTH_COMPONENT32F:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns true if the specified internal format is a depth-stencil format.
+static bool IsDepthStencilInternalFormat(GLint internalFormat)
+{
+    switch (internalFormat)
+    {
+        case GL_DEPTH_STENCIL:
+        case GL_DEPTH24_STENCIL8:
+        case GL_DEPTH32F_STENCIL8:
+            return true;
+        default:
+            return false;
+    }
+}
+
 GLenum GLRenderTarget::MakeFramebufferAttachment(GLint internalFormat)
 {
-    if (internalFormat == GL_DEPTH_COMPONENT)
+    if (IsDepthInternalFormat(internalFormat))
     {
         if (!HasDepthAttachment())
         {
@@ -290,7 +340,7 @@ GLenum GLRenderTarget::MakeFramebufferAttachment(GLint internalFormat)
         else
             DepthAttachmentFailed();
     }
-    else if (internalFormat == GL_DEPTH_STENCIL)
+    else if (IsDepthStencilInternalFormat(internalFormat))
     {
         if (!HasDepthAttachment())
         {
@@ -325,16 +375,51 @@ void GLRenderTarget::SetDrawBuffers()
         glDrawBuffers(static_cast<GLsizei>(colorAttachments_.size()), colorAttachments_.data());
 }
 
-void GLRenderTarget::CheckFramebufferStatus(GLenum status, const std::string& info)
+void GLRenderTarget::UpdateFramebuffers()
+{
+    if (framebuffersDirty_ || cacheGeneration_ != framebufferCache_.GetGeneration())
+    {
+        framebuffer_ = framebufferCache_.FindOrCreate(attachments_);
+
+        if (useFramebufferMS_)
+            framebufferMS_ = framebufferCache_.FindOrCreate(attachmentsMS_);
+
+        cacheGeneration_    = framebufferCache_.GetGeneration();
+        framebuffersDirty_  = false;
+    }
+}
+
+void GLRenderTarget::ReleaseRenderbuffers()
+{
+    if (renderbuffer_)
+        framebufferCache_.NotifyRenderbufferRelease(renderbuffer_->GetID());
+    for (const auto& renderbuffer : renderbuffersMS_)
+        framebufferCache_.NotifyRenderbufferRelease(renderbuffer->GetID());
+}
+
+void GLRenderTarget::ValidateMultiviewAttachment(const Texture& texture, unsigned int numViews)
 {
-    if (status != GL_FRAMEBUFFER_COMPLETE)
-        throw std::runtime_error(info + " failed (error code = " + GLErrorToStr(status) + ")");
+    if (!HasExtension(GLExt::OVR_multiview))
+        throw std::runtime_error("multiview render target attachments are not supported (requires GL_OVR_multiview)");
+    if (texture.GetType() != TextureType::Texture2DArray)
+        throw std::invalid_argument("multiview render target attachments must be 2D array textures");
+    if (useFramebufferMS_)
+        throw std::invalid_argument("multiview render target attachments cannot be resolved from a multi-sample framebuffer (requires custom multi-sampling)");
+    if (numViews_ != 0 && numViews_ != numViews)
+        throw std::invalid_argument("all multiview render target attachments must have the same number of views");
+    numViews_ = numViews;
 }
 
-void GLRenderTarget::CreateOnceFramebufferMS()
+void GLRenderTarget::ValidateLayeredAttachment(const Texture& texture)
 {
-    if (!framebufferMS_)
-        framebufferMS_ = MakeUnique<GLFramebuffer>();
+    if (!HasExtension(GLExt::ARB_geometry_shader4))
+        throw std::runtime_error("layered render target attachments are not supported (requires OpenGL 3.2)");
+
+    const auto type = texture.GetType();
+    if (!IsArrayTexture(type) && type != TextureType::TextureCube && type != TextureType::Texture3D)
+        throw std::invalid_argument("layered render target attachments must be array, cube, or 3D textures");
+    if (useFramebufferMS_)
+        throw std::invalid_argument("layered render target attachments cannot be resolved from a multi-sample framebuffer (requires custom multi-sampling)");
 }
 
 bool GLRenderTarget::HasMultiSampling() const
@@ -344,7 +429,7 @@ bool GLRenderTarget::HasMultiSampling() const
 
 bool GLRenderTarget::HasCustomMultiSampling() const
 {
-    return (framebufferMS_ == nullptr);
+    return !useFramebufferMS_;
 }
 
 bool GLRenderTarget::HasDepthAttachment() const
@@ -11,11 +11,13 @@
 
 #include <LLGL/RenderTarget.h>
 #include "GLFramebuffer.h"
+#include "GLFramebufferCache.h"
 #include "GLRenderbuffer.h"
 #include "GLTexture.h"
 #include <functional>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 
 namespace LLGL
@@ -27,7 +29,7 @@ class GLRenderTarget : public RenderTarget
 
     public:
 
-        GLRenderTarget(const RenderTargetDescriptor& desc);
+        GLRenderTarget(const RenderTargetDescriptor& desc, GLFramebufferCache& framebufferCache);
 
         void AttachDepthBuffer(const Gs::Vector2ui& size) override;
         void AttachStencilBuffer(const Gs::Vector2ui& size) override;
@@ -45,13 +47,33 @@ class GLRenderTarget : public RenderTarget
         // Blits the specified color attachment from the framebuffer onto the screen.
         void BlitOntoScreen(std::size_t colorAttachmentIndex);
 
-        // Returns the active framebuffer (i.e. either the default framebuffer or the multi-sample framebuffer).
-        const GLFramebuffer& GetFramebuffer() const;
+        /*
+        Returns the active framebuffer (i.e. either the default framebuffer or the multi-sample framebuffer).
+        The framebuffers are taken from the FBO cache when the attachments have changed.
+        */
+        const GLFramebuffer& GetFramebuffer();
+
+        // Returns true if this render target draws into a multi-sample framebuffer, which is blitted onto the attached textures.
+        inline bool HasFramebufferMS() const
+        {
+            return useFramebufferMS_;
+        }
+
+        // Returns the number of color attachments.
+        inline std::size_t GetNumColorAttachments() const
+        {
+            return colorAttachments_.size();
+        }
+
+        // Returns the estimated size (in bytes) of all renderbuffers this render target has allocated.
+        inline std::uint64_t GetRenderbufferMemory() const
+        {
+            return renderbufferMemory_;
+        }
 
     private:
 
         void InitRenderbufferStorage(GLRenderbuffer& renderbuffer, GLenum internalFormat);
-        GLenum AttachDefaultRenderbuffer(GLFramebuffer& framebuffer, GLenum attachment);
 
         void AttachRenderbuffer(const Gs::Vector2ui& size, GLenum internalFormat, GLenum attachment);
 
@@ -60,9 +82,17 @@ class GLRenderTarget : public RenderTarget
         // Sets the draw buffers for the currently bound FBO.
         void SetDrawBuffers();
 
-        void CheckFramebufferStatus(GLenum status, const std::string& info);
+        // Looks up the framebuffers for the current attachment sets in the FBO cache if the attachments or the cache have changed.
+        void UpdateFramebuffers();
+
+        // Notifies the FBO cache about the release of all renderbuffers of this render target.
+        void ReleaseRenderbuffers();
 
-        void CreateOnceFramebufferMS();
+        // Throws an exception if the specified texture cannot be attached with the specified number of views.
+        void ValidateMultiviewAttachment(const Texture& texture, unsigned int numViews);
+
+        // Throws an exception if the specified texture cannot be attached with all of its layers.
+        void ValidateLayeredAttachment(const Texture& texture);
 
         bool HasMultiSampling() const;
         bool HasCustomMultiSampling() const;
@@ -70,12 +100,22 @@ class GLRenderTarget : public RenderTarget
 
         /* === Members === */
 
-        GLFramebuffer                                   framebuffer_;
+        GLFramebufferCache&                             framebufferCache_;
 
-        std::unique_ptr<GLRenderbuffer>                 renderbuffer_;
+        // Attachment sets of the framebuffer and the multi-sample framebuffer; the FBOs are shared with other render targets via the FBO cache.
+        std::vector<GLFramebufferAttachment>            attachments_;
+        std::vector<GLFramebufferAttachment>            attachmentsMS_;
+
+        GLFramebuffer*                                  framebuffer_            = nullptr;
 
         // Multi-sampled framebuffer; required since we cannot directly draw into a texture when using multi-sampling.
-        std::unique_ptr<GLFramebuffer>                  framebufferMS_;
+        GLFramebuffer*                                  framebufferMS_          = nullptr;
+        bool                                            useFramebufferMS_       = false;
+
+        bool                                            framebuffersDirty_      = true;
+        unsigned int                                    cacheGeneration_        = 0;
+
+        std::unique_ptr<GLRenderbuffer>                 renderbuffer_;
 
         /*
         For multi-sampled render targets we also need a renderbuffer for each attached texture.
@@ -88,6 +128,9 @@ class GLRenderTarget : public RenderTarget
 
         GLsizei                                         multiSamples_           = 0;
         GLbitfield                                      blitMask_               = 0;
+        unsigned int                                    numViews_               = 0;
+
+        std::uint64_t                                   renderbufferMemory_     = 0;
 
 };
 
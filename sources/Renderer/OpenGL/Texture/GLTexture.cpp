@@ -6,8 +6,12 @@
  */
 
 #include "GLTexture.h"
+#include "GLSampler.h"
 #include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
 #include "../../GLCommon/GLTypes.h"
+#include "../../GLCommon/GLExtensionRegistry.h"
+#include <stdexcept>
 
 
 namespace LLGL
@@ -17,11 +21,35 @@ namespace LLGL
 GLTexture::GLTexture(const TextureType type) :
     Texture { type }
 {
+    CreateID();
+}
+
+GLTexture::GLTexture(const GLTexture& sharedTexture, const TextureViewDescriptor& desc) :
+    Texture { desc.type }
+{
+    #ifdef GL_ARB_texture_view
+
+    immutableFormat_ = (desc.format != TextureFormat::Unknown ? GLTypes::Map(desc.format) : sharedTexture.GetImmutableFormat());
+
+    /* Texture views must not be bound before "glTextureView", so the ID is not created with "glCreateTextures" */
     glGenTextures(1, &id_);
+    glTextureView(
+        id_,
+        GLTypes::Map(desc.type),
+        sharedTexture.GetID(),
+        immutableFormat_,
+        desc.firstMipLevel,
+        desc.numMipLevels,
+        desc.firstArrayLayer,
+        desc.numArrayLayers
+    );
+
+    #endif
 }
 
 GLTexture::~GLTexture()
 {
+    ReleaseBindlessHandles();
     glDeleteTextures(1, &id_);
 }
 
@@ -29,6 +57,23 @@ Gs::Vector3ui GLTexture::QueryMipLevelSize(unsigned int mipLevel) const
 {
     Gs::Vector3ui size;
 
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Query MIP-map level size without binding the texture */
+        GLint texSize[3] = { 0 };
+        glGetTextureLevelParameteriv(id_, mipLevel, GL_TEXTURE_WIDTH,  &texSize[0]);
+        glGetTextureLevelParameteriv(id_, mipLevel, GL_TEXTURE_HEIGHT, &texSize[1]);
+        glGetTextureLevelParameteriv(id_, mipLevel, GL_TEXTURE_DEPTH,  &texSize[2]);
+
+        size.x = static_cast<unsigned int>(texSize[0]);
+        size.y = static_cast<unsigned int>(texSize[1]);
+        size.z = static_cast<unsigned int>(texSize[2]);
+
+        return size;
+    }
+    #endif
+
     GLStateManager::active->PushBoundTexture(GLStateManager::GetTextureTarget(GetType()));
     {
         GLStateManager::active->BindTexture(*this);
@@ -52,8 +97,283 @@ Gs::Vector3ui GLTexture::QueryMipLevelSize(unsigned int mipLevel) const
 void GLTexture::Recreate()
 {
     /* Delete previous texture and create a new one */
+    ReleaseBindlessHandles();
     glDeleteTextures(1, &id_);
-    glGenTextures(1, &id_);
+    CreateID();
+}
+
+GLuint64 GLTexture::GetBindlessHandle(const GLSampler* sampler)
+{
+    #ifdef GL_ARB_bindless_texture
+
+    const GLuint samplerID = (sampler != nullptr ? sampler->GetID() : 0);
+
+    /* Return previous handle for the same sampler */
+    for (const auto& entry : bindlessHandles_)
+    {
+        if (entry.samplerID == samplerID)
+            return entry.handle;
+    }
+
+    /* Create new handle and make it resident, so shaders can access the texture */
+    GLuint64 handle = 0;
+
+    if (samplerID != 0)
+        handle = glGetTextureSamplerHandleARB(id_, samplerID);
+    else
+        handle = glGetTextureHandleARB(id_);
+
+    glMakeTextureHandleResidentARB(handle);
+
+    bindlessHandles_.push_back({ samplerID, handle });
+
+    return handle;
+
+    #else
+
+    return 0;
+
+    #endif
+}
+
+
+void GLTexture::AllocImmutableStorage(const TextureDescriptor& desc)
+{
+    #ifdef GL_ARB_texture_storage
+
+    const auto target = GLTypes::Map(desc.type);
+
+    immutableFormat_ = GLTypes::Map(desc.format);
+
+    auto ToGLsizei = [](unsigned int value)
+    {
+        return static_cast<GLsizei>(value);
+    };
+
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+            glTexStorage1D(
+                target, ToGLsizei(NumMipLevels(desc.texture1D.width)), immutableFormat_,
+                ToGLsizei(desc.texture1D.width)
+            );
+            break;
+
+        case TextureType::Texture1DArray:
+            glTexStorage2D(
+                target, ToGLsizei(NumMipLevels(desc.texture1D.width)), immutableFormat_,
+                ToGLsizei(desc.texture1D.width), ToGLsizei(desc.texture1D.layers)
+            );
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::TextureCube:
+            glTexStorage2D(
+                target, ToGLsizei(NumMipLevels(desc.texture2D.width, desc.texture2D.height)), immutableFormat_,
+                ToGLsizei(desc.texture2D.width), ToGLsizei(desc.texture2D.height)
+            );
+            break;
+
+        case TextureType::Texture2DArray:
+            glTexStorage3D(
+                target, ToGLsizei(NumMipLevels(desc.texture2D.width, desc.texture2D.height)), immutableFormat_,
+                ToGLsizei(desc.texture2D.width), ToGLsizei(desc.texture2D.height), ToGLsizei(desc.texture2D.layers)
+            );
+            break;
+
+        case TextureType::Texture3D:
+            glTexStorage3D(
+                target, ToGLsizei(NumMipLevels(desc.texture3D.width, desc.texture3D.height, desc.texture3D.depth)), immutableFormat_,
+                ToGLsizei(desc.texture3D.width), ToGLsizei(desc.texture3D.height), ToGLsizei(desc.texture3D.depth)
+            );
+            break;
+
+        case TextureType::TextureCubeArray:
+            glTexStorage3D(
+                target, ToGLsizei(NumMipLevels(desc.textureCube.width, desc.textureCube.height)), immutableFormat_,
+                ToGLsizei(desc.textureCube.width), ToGLsizei(desc.textureCube.height), ToGLsizei(desc.textureCube.layers * 6)
+            );
+            break;
+
+        #ifdef GL_ARB_texture_storage_multisample
+
+        case TextureType::Texture2DMS:
+            glTexStorage2DMultisample(
+                target, ToGLsizei(desc.texture2DMS.samples), immutableFormat_,
+                ToGLsizei(desc.texture2DMS.width), ToGLsizei(desc.texture2DMS.height),
+                (desc.texture2DMS.fixedSamples ? GL_TRUE : GL_FALSE)
+            );
+            break;
+
+        case TextureType::Texture2DMSArray:
+            glTexStorage3DMultisample(
+                target, ToGLsizei(desc.texture2DMS.samples), immutableFormat_,
+                ToGLsizei(desc.texture2DMS.width), ToGLsizei(desc.texture2DMS.height), ToGLsizei(desc.texture2DMS.layers),
+                (desc.texture2DMS.fixedSamples ? GL_TRUE : GL_FALSE)
+            );
+            break;
+
+        #endif
+
+        default:
+            immutableFormat_ = 0;
+            break;
+    }
+
+    #endif
+}
+
+// Returns the extent of the first MIP-map level, where the last component are the array layers (or cube faces) for array textures.
+static Gs::Vector3ui GetSparseTextureExtent(const TextureDescriptor& desc)
+{
+    switch (desc.type)
+    {
+        case TextureType::Texture2D:        return { desc.texture2D.width, desc.texture2D.height, 1 };
+        case TextureType::Texture2DArray:   return { desc.texture2D.width, desc.texture2D.height, desc.texture2D.layers };
+        case TextureType::Texture3D:        return { desc.texture3D.width, desc.texture3D.height, desc.texture3D.depth };
+        case TextureType::TextureCube:      return { desc.textureCube.width, desc.textureCube.height, 6 };
+        case TextureType::TextureCubeArray: return { desc.textureCube.width, desc.textureCube.height, desc.textureCube.layers * 6 };
+        default:                            return { 0, 0, 0 };
+    }
+}
+
+void GLTexture::AllocSparseStorage(const TextureDescriptor& desc)
+{
+    #ifdef GL_ARB_sparse_texture
+
+    const auto target           = GLTypes::Map(desc.type);
+    const auto internalFormat   = GLTypes::Map(desc.format);
+
+    /* Query page size of the first page layout for this format */
+    GLint numPageSizes = 0;
+    glGetInternalformativ(target, internalFormat, GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &numPageSizes);
+    if (numPageSizes <= 0)
+        throw std::invalid_argument("texture format is not supported for sparse textures");
+
+    GLint pageSize[3] = { 0 };
+    glGetInternalformativ(target, internalFormat, GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &pageSize[0]);
+    glGetInternalformativ(target, internalFormat, GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &pageSize[1]);
+    glGetInternalformativ(target, internalFormat, GL_VIRTUAL_PAGE_SIZE_Z_ARB, 1, &pageSize[2]);
+
+    /* Allocate virtual storage, which is not committed yet */
+    glTexParameteri(target, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+    glTexParameteri(target, GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, 0);
+    AllocImmutableStorage(desc);
+
+    GLint numSparseLevels = 0;
+    glGetTexParameteriv(target, GL_NUM_SPARSE_LEVELS_ARB, &numSparseLevels);
+
+    /* Create page table for all MIP-map levels that can be committed page by page */
+    const bool layered  = (desc.type != TextureType::Texture2D && desc.type != TextureType::Texture3D);
+    const auto extent   = GetSparseTextureExtent(desc);
+
+    sparsePageTable_ = std::unique_ptr<SparsePageTable>(
+        new SparsePageTable(
+            extent,
+            layered,
+            Gs::Vector3ui
+            {
+                static_cast<unsigned int>(pageSize[0]),
+                static_cast<unsigned int>(pageSize[1]),
+                (layered ? 1u : static_cast<unsigned int>(pageSize[2]))
+            },
+            static_cast<unsigned int>(numSparseLevels)
+        )
+    );
+
+    /* Commit MIP-map tail, which is always resident */
+    const auto numMipLevels = NumMipLevels(extent.x, extent.y, (layered ? 1 : extent.z));
+
+    for (auto mipLevel = static_cast<unsigned int>(numSparseLevels); mipLevel < numMipLevels; ++mipLevel)
+    {
+        auto levelExtent = sparsePageTable_->GetLevelExtent(mipLevel);
+        glTexPageCommitmentARB(
+            target,
+            static_cast<GLint>(mipLevel),
+            0,
+            0,
+            0,
+            static_cast<GLsizei>(levelExtent.x),
+            static_cast<GLsizei>(levelExtent.y),
+            static_cast<GLsizei>(levelExtent.z),
+            GL_TRUE
+        );
+    }
+
+    #else
+
+    throw std::runtime_error("sparse textures not supported");
+
+    #endif
+}
+
+void GLTexture::CommitSparseRegion(const TextureRegion& region, bool commit)
+{
+    #ifdef GL_ARB_sparse_texture
+
+    if (!sparsePageTable_ || region.mipLevel >= sparsePageTable_->GetNumSparseLevels())
+        return;
+
+    /* Validate region and update page table, before the entire region is (de)committed with a single command */
+    std::size_t numChangedPages = 0;
+    sparsePageTable_->Commit(
+        region,
+        commit,
+        [&numChangedPages](unsigned int, const Gs::Vector3ui&)
+        {
+            ++numChangedPages;
+        }
+    );
+
+    if (numChangedPages > 0)
+    {
+        glTexPageCommitmentARB(
+            GLTypes::Map(GetType()),
+            static_cast<GLint>(region.mipLevel),
+            static_cast<GLint>(region.offset.x),
+            static_cast<GLint>(region.offset.y),
+            static_cast<GLint>(region.offset.z),
+            static_cast<GLsizei>(region.extent.x),
+            static_cast<GLsizei>(region.extent.y),
+            static_cast<GLsizei>(region.extent.z),
+            (commit ? GL_TRUE : GL_FALSE)
+        );
+    }
+
+    #endif
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLTexture::CreateID()
+{
+    #ifdef GL_ARB_direct_state_access
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        /* Create texture object with its target, so it can be used with DSA functions right away */
+        glCreateTextures(GLTypes::Map(GetType()), 1, &id_);
+    }
+    else
+    #endif
+    {
+        glGenTextures(1, &id_);
+    }
+}
+
+void GLTexture::ReleaseBindlessHandles()
+{
+    #ifdef GL_ARB_bindless_texture
+
+    /* Handles must be non-resident before the texture is deleted */
+    for (const auto& entry : bindlessHandles_)
+        glMakeTextureHandleNonResidentARB(entry.handle);
+
+    #endif
+
+    bindlessHandles_.clear();
 }
 
 
@@ -10,35 +10,81 @@
 
 
 #include <LLGL/Texture.h>
+#include <LLGL/TextureFlags.h>
 #include "../OpenGL.h"
+#include "../../SparsePageTable.h"
+#include <vector>
+#include <memory>
 
 
 namespace LLGL
 {
 
 
+class GLSampler;
+
 class GLTexture : public Texture
 {
 
     public:
 
         GLTexture(const TextureType type);
+
+        // Creates a texture view of the specified texture, which must have immutable storage (requires GL_ARB_texture_view).
+        GLTexture(const GLTexture& sharedTexture, const TextureViewDescriptor& desc);
+
         ~GLTexture();
 
         Gs::Vector3ui QueryMipLevelSize(unsigned int mipLevel) const override;
 
-        // Recreates the internal texture object. This will invalidate the previous texture ID.
+        // Recreates the internal texture object. This will invalidate the previous texture ID and all bindless handles.
         void Recreate();
 
+        // Returns the resident bindless handle for this texture and the optional sampler (requires GL_ARB_bindless_texture).
+        GLuint64 GetBindlessHandle(const GLSampler* sampler);
+
+        // Allocates immutable storage with a full MIP-map chain for the bound texture (requires GL_ARB_texture_storage, and GL_ARB_texture_storage_multisample for multi-sampled textures).
+        void AllocImmutableStorage(const TextureDescriptor& desc);
+
+        // Allocates sparse immutable storage for the bound texture and commits its MIP-map tail (requires GL_ARB_sparse_texture).
+        void AllocSparseStorage(const TextureDescriptor& desc);
+
+        // Commits or decommits the pages of the bound sparse texture, which the specified region overlaps with.
+        void CommitSparseRegion(const TextureRegion& region, bool commit);
+
         // Returns the hardware texture ID.
         inline GLuint GetID() const
         {
             return id_;
         }
 
+        // Returns the internal format of the immutable storage, or 0 if this texture has mutable storage.
+        inline GLenum GetImmutableFormat() const
+        {
+            return immutableFormat_;
+        }
+
+        // Returns the page table if this is a sparse texture, or null otherwise.
+        inline const SparsePageTable* GetSparsePageTable() const
+        {
+            return sparsePageTable_.get();
+        }
+
     private:
 
-        GLuint id_ = 0;
+        struct BindlessHandle
+        {
+            GLuint      samplerID;
+            GLuint64    handle;
+        };
+
+        void CreateID();
+        void ReleaseBindlessHandles();
+
+        GLuint                              id_                 = 0;
+        GLenum                              immutableFormat_    = 0;
+        std::vector<BindlessHandle>         bindlessHandles_;
+        std::unique_ptr<SparsePageTable>    sparsePageTable_;
 
 };
 
@@ -0,0 +1,177 @@
+/*
+ * AndroidGLES3Context.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "AndroidGLES3Context.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+#ifndef EGL_OPENGL_ES3_BIT_KHR
+#define EGL_OPENGL_ES3_BIT_KHR 0x00000040
+#endif
+
+// Returns true if the specified space separated list of EGL extensions contains the specified name.
+static bool HasEGLExtension(const char* extensions, const char* name)
+{
+    if (extensions != nullptr)
+    {
+        const auto nameLen = std::strlen(name);
+        for (auto s = std::strstr(extensions, name); s != nullptr; s = std::strstr(s + nameLen, name))
+        {
+            if ((s == extensions || s[-1] == ' ') && (s[nameLen] == ' ' || s[nameLen] == '\0'))
+                return true;
+        }
+    }
+    return false;
+}
+
+AndroidGLES3Context::AndroidGLES3Context(const RenderContextDescriptor& desc, ANativeWindow* window, AndroidGLES3Context* sharedContext)
+{
+    CreateContext(desc, sharedContext);
+    CreateSurface(window);
+    MakeCurrent(true);
+}
+
+AndroidGLES3Context::~AndroidGLES3Context()
+{
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    DestroySurface();
+    eglDestroyContext(display_, context_);
+}
+
+bool AndroidGLES3Context::SetSwapInterval(int interval)
+{
+    return (eglSwapInterval(display_, std::max(0, interval)) == EGL_TRUE);
+}
+
+void AndroidGLES3Context::SetPresentationTime(double targetTimestamp)
+{
+    presentationTime_ = static_cast<EGLnsecsANDROID>(targetTimestamp * 1.0e9);
+}
+
+bool AndroidGLES3Context::SwapBuffers()
+{
+    if (surface_ == EGL_NO_SURFACE)
+        return false;
+
+    /* Pass target time of this frame to the compositor, so the frame is not displayed before its display refresh */
+    if (presentationTime_ > 0 && eglPresentationTimeANDROID_ != nullptr)
+    {
+        eglPresentationTimeANDROID_(display_, surface_, presentationTime_);
+        presentationTime_ = 0;
+    }
+
+    return (eglSwapBuffers(display_, surface_) == EGL_TRUE);
+}
+
+bool AndroidGLES3Context::MakeCurrent(bool activate)
+{
+    if (activate)
+        return (eglMakeCurrent(display_, surface_, surface_, context_) == EGL_TRUE);
+    else
+        return (eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE);
+}
+
+void AndroidGLES3Context::RecreateSurface(ANativeWindow* window)
+{
+    /* Surface must not be current while it is destroyed; the context and its resources remain valid */
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    DestroySurface();
+
+    if (window)
+    {
+        CreateSurface(window);
+        MakeCurrent(true);
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void AndroidGLES3Context::CreateContext(const RenderContextDescriptor& desc, AndroidGLES3Context* sharedContext)
+{
+    /* Initialize default display */
+    display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display_ == EGL_NO_DISPLAY)
+        throw std::runtime_error("failed to get EGL display");
+
+    if (eglInitialize(display_, nullptr, nullptr) != EGL_TRUE)
+        throw std::runtime_error("failed to initialize EGL display");
+
+    /* Choose frame buffer configuration for window surfaces */
+    const EGLint samples = (desc.multiSampling.enabled ? static_cast<EGLint>(desc.multiSampling.samples) : 0);
+
+    const EGLint configAttribs[] =
+    {
+        EGL_SURFACE_TYPE,       EGL_WINDOW_BIT,
+        EGL_RENDERABLE_TYPE,    EGL_OPENGL_ES3_BIT_KHR,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         8,
+        EGL_DEPTH_SIZE,         24,
+        EGL_STENCIL_SIZE,       8,
+        EGL_SAMPLE_BUFFERS,     (samples > 1 ? 1 : 0),
+        EGL_SAMPLES,            (samples > 1 ? samples : 0),
+        EGL_NONE
+    };
+
+    EGLint numConfigs = 0;
+    if (eglChooseConfig(display_, configAttribs, &config_, 1, &numConfigs) != EGL_TRUE || numConfigs == 0)
+        throw std::runtime_error("failed to choose EGL configuration for OpenGL ES 3");
+
+    /* Create OpenGL ES 3 context */
+    const EGLint contextAttribs[] =
+    {
+        EGL_CONTEXT_CLIENT_VERSION, 3,
+        EGL_NONE
+    };
+
+    context_ = eglCreateContext(
+        display_,
+        config_,
+        (sharedContext != nullptr ? sharedContext->context_ : EGL_NO_CONTEXT),
+        contextAttribs
+    );
+
+    if (context_ == EGL_NO_CONTEXT)
+        throw std::runtime_error("failed to create OpenGL ES 3 context with EGL");
+
+    /* Load extension for frame pacing */
+    if (HasEGLExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_ANDROID_presentation_time"))
+        eglPresentationTimeANDROID_ = reinterpret_cast<PFNEGLPRESENTATIONTIMEANDROIDPROC>(eglGetProcAddress("eglPresentationTimeANDROID"));
+}
+
+void AndroidGLES3Context::CreateSurface(ANativeWindow* window)
+{
+    surface_ = eglCreateWindowSurface(display_, config_, window, nullptr);
+    if (surface_ == EGL_NO_SURFACE)
+        throw std::runtime_error("failed to create EGL window surface for Android window");
+}
+
+void AndroidGLES3Context::DestroySurface()
+{
+    if (surface_ != EGL_NO_SURFACE)
+    {
+        eglDestroySurface(display_, surface_);
+        surface_ = EGL_NO_SURFACE;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
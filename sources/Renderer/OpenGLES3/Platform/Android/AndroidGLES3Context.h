@@ -0,0 +1,84 @@
+/*
+ * AndroidGLES3Context.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ANDROID_GLES3_CONTEXT_H
+#define LLGL_ANDROID_GLES3_CONTEXT_H
+
+
+#include <LLGL/RenderContextDescriptor.h>
+#include <android/native_window.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+
+namespace LLGL
+{
+
+
+/*
+OpenGL ES 3 context with EGL for the native window of an Android activity.
+Frames are paced with EGL_ANDROID_presentation_time (if supported): the target timestamp of the canvas frame loop is passed to the compositor,
+which then holds the frame until its display refresh instead of presenting it as soon as possible. This avoids the uneven frame times
+of a naive eglSwapBuffers loop, where frames that finish early are displayed early and the next frame appears to stutter.
+*/
+class AndroidGLES3Context
+{
+
+    public:
+
+        AndroidGLES3Context(const RenderContextDescriptor& desc, ANativeWindow* window, AndroidGLES3Context* sharedContext);
+        ~AndroidGLES3Context();
+
+        AndroidGLES3Context(const AndroidGLES3Context&) = delete;
+        AndroidGLES3Context& operator = (const AndroidGLES3Context&) = delete;
+
+        bool SetSwapInterval(int interval);
+
+        /*
+        Sets the time (in seconds of CLOCK_MONOTONIC, see CanvasFrameTimes::targetTimestamp) at which the next swapped frame shall be displayed.
+        The time only applies to the next SwapBuffers call. This has no effect if EGL_ANDROID_presentation_time is not supported.
+        */
+        void SetPresentationTime(double targetTimestamp);
+
+        bool SwapBuffers();
+
+        bool MakeCurrent(bool activate);
+
+        // Recreates the window surface for the specified window, e.g. after the activity has been resumed. A null window only destroys the surface.
+        void RecreateSurface(ANativeWindow* window);
+
+        // Returns true if frames can be paced with EGL_ANDROID_presentation_time.
+        inline bool HasPresentationTime() const
+        {
+            return (eglPresentationTimeANDROID_ != nullptr);
+        }
+
+    private:
+
+        void CreateContext(const RenderContextDescriptor& desc, AndroidGLES3Context* sharedContext);
+        void CreateSurface(ANativeWindow* window);
+        void DestroySurface();
+
+        EGLDisplay                          display_                    = EGL_NO_DISPLAY;
+        EGLConfig                           config_                     = nullptr;
+        EGLSurface                          surface_                    = EGL_NO_SURFACE;
+        EGLContext                          context_                    = EGL_NO_CONTEXT;
+
+        PFNEGLPRESENTATIONTIMEANDROIDPROC   eglPresentationTimeANDROID_ = nullptr;
+        EGLnsecsANDROID                     presentationTime_           = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
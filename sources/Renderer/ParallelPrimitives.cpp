@@ -0,0 +1,896 @@
+/*
+ * ParallelPrimitives.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ParallelPrimitives.h>
+#include "../Core/Exception.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+// Number of elements each thread processes
+static const std::uint32_t g_itemsPerThread = 4;
+
+// Number of bits of each radix sort pass, and number of digits per pass
+static const std::uint32_t g_radixBits      = 4;
+static const std::uint32_t g_radix          = (1u << g_radixBits);
+
+// Layout of the constant buffer of all built-in compute shaders, which is compatible with the std140 layout in GLSL.
+struct ParallelPrimitivesParameters
+{
+    std::uint32_t count         = 0;    // Number of input elements
+    std::uint32_t numBlocks     = 0;    // Number of thread groups, i.e. the stride of the digit histogram
+    std::uint32_t shift         = 0;    // Shift of the digit of the current radix sort pass
+    std::uint32_t predicate     = 0;    // Scan flags (non-zero input is 1) instead of values, with one additional output for the total sum
+    std::uint32_t countIndex    = 0;    // Index of the number of kept elements within the count buffer of the stream compaction
+    std::uint32_t reserved[3]   = {};
+};
+
+static bool IsGLSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::GLSL_110 && language <= ShadingLanguage::GLSL_460);
+}
+
+static bool IsESSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::GLSL_ES_100 && language <= ShadingLanguage::GLSL_ES_320);
+}
+
+static bool IsHLSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::HLSL_4_0 && language <= ShadingLanguage::HLSL_5_1);
+}
+
+static std::uint32_t GetDefaultThreadGroupSize(const RenderingCaps& caps)
+{
+    /* Use 8 waves per thread group to hide the latency of the group barriers, but at least 64 and at most 256 threads */
+    auto size = (caps.waveSize > 0 ? std::max(64u, std::min(caps.waveSize * 8, 256u)) : 256u);
+    if (caps.maxComputeShaderWorkGroupSize.x > 0)
+        size = std::min(size, caps.maxComputeShaderWorkGroupSize.x);
+    return size;
+}
+
+/*
+Each thread group scans a block of elements: each thread scans its consecutive elements sequentially,
+and the sums of all threads are scanned in shared memory with log2(GROUP_SIZE) steps (Hillis-Steele).
+The radix sort splits each block by one bit after the other with this scan, so each block is sorted stably by its digit
+before it is scattered, which keeps the writes of each digit consecutive. Out-of-range keys are loaded as the maximal key,
+so they remain at the end of the last block.
+*/
+
+static const char* g_glslCommon =
+    "const uint groupSize = uint(GROUP_SIZE);\n"
+    "const uint itemsPerThread = 4u;\n"
+    "const uint blockSize = groupSize * itemsPerThread;\n"
+    "const uint radixBits = 4u;\n"
+    "const uint radix = 16u;\n"
+    "#define GROUP_BARRIER() memoryBarrierShared(); barrier()\n"
+    "layout(local_size_x = GROUP_SIZE) in;\n"
+    "layout(std140, binding = 0) uniform Parameters\n"
+    "{\n"
+    "    uint count;\n"
+    "    uint numBlocks;\n"
+    "    uint shift;\n"
+    "    uint predicate;\n"
+    "    uint countIndex;\n"
+    "};\n"
+    "shared uint groupSums[GROUP_SIZE];\n"
+    "uint GroupExclusiveScan(uint value, uint tid, out uint total)\n"
+    "{\n"
+    "    groupSums[tid] = value;\n"
+    "    GROUP_BARRIER();\n"
+    "    for (uint offset = 1u; offset < groupSize; offset <<= 1u)\n"
+    "    {\n"
+    "        uint sum = groupSums[max(tid, offset) - offset];\n"
+    "        GROUP_BARRIER();\n"
+    "        if (tid >= offset)\n"
+    "            groupSums[tid] += sum;\n"
+    "        GROUP_BARRIER();\n"
+    "    }\n"
+    "    total = groupSums[groupSize - 1u];\n"
+    "    uint result = groupSums[tid] - value;\n"
+    "    GROUP_BARRIER();\n"
+    "    return result;\n"
+    "}\n"
+;
+
+static const char* g_glslScanBlocks =
+    "layout(std430, binding = 1) readonly buffer SrcBuffer { uint src[]; };\n"
+    "layout(std430, binding = 2) writeonly buffer DstBuffer { uint dst[]; };\n"
+    "layout(std430, binding = 3) writeonly buffer BlockSumsBuffer { uint blockSums[]; };\n"
+    "void main()\n"
+    "{\n"
+    "    uint tid = gl_LocalInvocationID.x;\n"
+    "    uint first = gl_WorkGroupID.x * blockSize + tid * itemsPerThread;\n"
+    "    uint prefix[4];\n"
+    "    uint sum = 0u;\n"
+    "    for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint value = 0u;\n"
+    "        if (first + i < count)\n"
+    "        {\n"
+    "            value = src[first + i];\n"
+    "            if (predicate != 0u)\n"
+    "                value = (value != 0u ? 1u : 0u);\n"
+    "        }\n"
+    "        prefix[i] = sum;\n"
+    "        sum += value;\n"
+    "    }\n"
+    "    uint total;\n"
+    "    uint offset = GroupExclusiveScan(sum, tid, total);\n"
+    "    for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        if (first + i < count + predicate)\n"
+    "            dst[first + i] = offset + prefix[i];\n"
+    "    }\n"
+    "    if (tid == 0u)\n"
+    "        blockSums[gl_WorkGroupID.x] = total;\n"
+    "}\n"
+;
+
+static const char* g_glslAddOffsets =
+    "layout(std430, binding = 2) buffer DstBuffer { uint dst[]; };\n"
+    "layout(std430, binding = 3) readonly buffer BlockOffsetsBuffer { uint blockOffsets[]; };\n"
+    "void main()\n"
+    "{\n"
+    "    uint first = gl_WorkGroupID.x * blockSize + gl_LocalInvocationID.x;\n"
+    "    uint offset = blockOffsets[gl_WorkGroupID.x];\n"
+    "    for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = first + i * groupSize;\n"
+    "        if (index < count + predicate)\n"
+    "            dst[index] += offset;\n"
+    "    }\n"
+    "}\n"
+;
+
+static const char* g_glslCompact =
+    "layout(std430, binding = 1) readonly buffer SrcBuffer { uint src[]; };\n"
+    "layout(std430, binding = 2) writeonly buffer DstBuffer { uint dst[]; };\n"
+    "layout(std430, binding = 3) readonly buffer IndicesBuffer { uint indices[]; };\n"
+    "layout(std430, binding = 4) writeonly buffer CountBuffer { uint counts[]; };\n"
+    "void main()\n"
+    "{\n"
+    "    uint first = gl_WorkGroupID.x * blockSize + gl_LocalInvocationID.x;\n"
+    "    for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = first + i * groupSize;\n"
+    "        if (index < count && indices[index + 1u] != indices[index])\n"
+    "            dst[indices[index]] = src[index];\n"
+    "    }\n"
+    "    if (gl_GlobalInvocationID.x == 0u)\n"
+    "        counts[countIndex] = indices[count];\n"
+    "}\n"
+;
+
+static const char* g_glslSortHistogram =
+    "layout(std430, binding = 1) readonly buffer KeysBuffer { uint keys[]; };\n"
+    "layout(std430, binding = 2) writeonly buffer HistogramBuffer { uint histogram[]; };\n"
+    "shared uint digitCounts[16];\n"
+    "void main()\n"
+    "{\n"
+    "    uint tid = gl_LocalInvocationID.x;\n"
+    "    if (tid < radix)\n"
+    "        digitCounts[tid] = 0u;\n"
+    "    GROUP_BARRIER();\n"
+    "    uint first = gl_WorkGroupID.x * blockSize + tid;\n"
+    "    for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = first + i * groupSize;\n"
+    "        if (index < count)\n"
+    "            atomicAdd(digitCounts[(keys[index] >> shift) & (radix - 1u)], 1u);\n"
+    "    }\n"
+    "    GROUP_BARRIER();\n"
+    "    if (tid < radix)\n"
+    "        histogram[tid * numBlocks + gl_WorkGroupID.x] = digitCounts[tid];\n"
+    "}\n"
+;
+
+static const char* g_glslSortScatter =
+    "layout(std430, binding = 1) readonly buffer SrcKeysBuffer { uint srcKeys[]; };\n"
+    "layout(std430, binding = 2) writeonly buffer DstKeysBuffer { uint dstKeys[]; };\n"
+    "layout(std430, binding = 3) readonly buffer DigitOffsetsBuffer { uint digitOffsets[]; };\n"
+    "#ifdef KEY_VALUES\n"
+    "layout(std430, binding = 4) readonly buffer SrcValuesBuffer { uint srcValues[]; };\n"
+    "layout(std430, binding = 5) writeonly buffer DstValuesBuffer { uint dstValues[]; };\n"
+    "shared uint blockValues[GROUP_SIZE * 4];\n"
+    "#endif\n"
+    "shared uint blockKeys[GROUP_SIZE * 4];\n"
+    "shared uint blockDigitOffsets[16];\n"
+    "shared uint blockDigitStarts[16];\n"
+    "uint Digit(uint key)\n"
+    "{\n"
+    "    return (key >> shift) & (radix - 1u);\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    uint tid = gl_LocalInvocationID.x;\n"
+    "    uint first = gl_WorkGroupID.x * blockSize;\n"
+    "    for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = i * groupSize + tid;\n"
+    "        blockKeys[index] = (first + index < count ? srcKeys[first + index] : 0xFFFFFFFFu);\n"
+    "        #ifdef KEY_VALUES\n"
+    "        blockValues[index] = (first + index < count ? srcValues[first + index] : 0u);\n"
+    "        #endif\n"
+    "    }\n"
+    "    if (tid < radix)\n"
+    "        blockDigitOffsets[tid] = digitOffsets[tid * numBlocks + gl_WorkGroupID.x];\n"
+    "    GROUP_BARRIER();\n"
+    "    for (uint bit = 0u; bit < radixBits; ++bit)\n"
+    "    {\n"
+    "        uint keys[4];\n"
+    "        #ifdef KEY_VALUES\n"
+    "        uint values[4];\n"
+    "        #endif\n"
+    "        uint numZeros = 0u;\n"
+    "        for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "        {\n"
+    "            keys[i] = blockKeys[tid * itemsPerThread + i];\n"
+    "            #ifdef KEY_VALUES\n"
+    "            values[i] = blockValues[tid * itemsPerThread + i];\n"
+    "            #endif\n"
+    "            numZeros += ((keys[i] >> (shift + bit)) & 1u) ^ 1u;\n"
+    "        }\n"
+    "        uint totalZeros;\n"
+    "        uint zerosBefore = GroupExclusiveScan(numZeros, tid, totalZeros);\n"
+    "        for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "        {\n"
+    "            uint pos;\n"
+    "            if (((keys[i] >> (shift + bit)) & 1u) == 0u)\n"
+    "                pos = zerosBefore++;\n"
+    "            else\n"
+    "                pos = totalZeros + tid * itemsPerThread + i - zerosBefore;\n"
+    "            blockKeys[pos] = keys[i];\n"
+    "            #ifdef KEY_VALUES\n"
+    "            blockValues[pos] = values[i];\n"
+    "            #endif\n"
+    "        }\n"
+    "        GROUP_BARRIER();\n"
+    "    }\n"
+    "    for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = tid * itemsPerThread + i;\n"
+    "        uint digit = Digit(blockKeys[index]);\n"
+    "        if (index == 0u || Digit(blockKeys[max(index, 1u) - 1u]) != digit)\n"
+    "            blockDigitStarts[digit] = index;\n"
+    "    }\n"
+    "    GROUP_BARRIER();\n"
+    "    for (uint i = 0u; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = i * groupSize + tid;\n"
+    "        if (first + index < count)\n"
+    "        {\n"
+    "            uint digit = Digit(blockKeys[index]);\n"
+    "            uint pos = blockDigitOffsets[digit] + index - blockDigitStarts[digit];\n"
+    "            dstKeys[pos] = blockKeys[index];\n"
+    "            #ifdef KEY_VALUES\n"
+    "            dstValues[pos] = blockValues[index];\n"
+    "            #endif\n"
+    "        }\n"
+    "    }\n"
+    "}\n"
+;
+
+static const char* g_hlslCommon =
+    "static const uint groupSize = GROUP_SIZE;\n"
+    "static const uint itemsPerThread = 4;\n"
+    "static const uint blockSize = groupSize * itemsPerThread;\n"
+    "static const uint radixBits = 4;\n"
+    "static const uint radix = 16;\n"
+    "cbuffer Parameters : register(b0)\n"
+    "{\n"
+    "    uint count;\n"
+    "    uint numBlocks;\n"
+    "    uint shift;\n"
+    "    uint predicate;\n"
+    "    uint countIndex;\n"
+    "};\n"
+    "groupshared uint groupSums[GROUP_SIZE];\n"
+    "uint GroupExclusiveScan(uint value, uint tid, out uint total)\n"
+    "{\n"
+    "    groupSums[tid] = value;\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    [unroll]\n"
+    "    for (uint offset = 1; offset < groupSize; offset <<= 1)\n"
+    "    {\n"
+    "        uint sum = groupSums[max(tid, offset) - offset];\n"
+    "        GroupMemoryBarrierWithGroupSync();\n"
+    "        if (tid >= offset)\n"
+    "            groupSums[tid] += sum;\n"
+    "        GroupMemoryBarrierWithGroupSync();\n"
+    "    }\n"
+    "    total = groupSums[groupSize - 1];\n"
+    "    uint result = groupSums[tid] - value;\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    return result;\n"
+    "}\n"
+;
+
+static const char* g_hlslScanBlocks =
+    "RWStructuredBuffer<uint> src : register(u1);\n"
+    "RWStructuredBuffer<uint> dst : register(u2);\n"
+    "RWStructuredBuffer<uint> blockSums : register(u3);\n"
+    "[numthreads(GROUP_SIZE, 1, 1)]\n"
+    "void CS(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)\n"
+    "{\n"
+    "    uint tid = threadID.x;\n"
+    "    uint first = groupID.x * blockSize + tid * itemsPerThread;\n"
+    "    uint prefix[4];\n"
+    "    uint sum = 0;\n"
+    "    [unroll]\n"
+    "    for (uint i = 0; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint value = 0;\n"
+    "        if (first + i < count)\n"
+    "        {\n"
+    "            value = src[first + i];\n"
+    "            if (predicate != 0)\n"
+    "                value = (value != 0 ? 1 : 0);\n"
+    "        }\n"
+    "        prefix[i] = sum;\n"
+    "        sum += value;\n"
+    "    }\n"
+    "    uint total;\n"
+    "    uint offset = GroupExclusiveScan(sum, tid, total);\n"
+    "    [unroll]\n"
+    "    for (uint j = 0; j < itemsPerThread; ++j)\n"
+    "    {\n"
+    "        if (first + j < count + predicate)\n"
+    "            dst[first + j] = offset + prefix[j];\n"
+    "    }\n"
+    "    if (tid == 0)\n"
+    "        blockSums[groupID.x] = total;\n"
+    "}\n"
+;
+
+static const char* g_hlslAddOffsets =
+    "RWStructuredBuffer<uint> dst : register(u2);\n"
+    "RWStructuredBuffer<uint> blockOffsets : register(u3);\n"
+    "[numthreads(GROUP_SIZE, 1, 1)]\n"
+    "void CS(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)\n"
+    "{\n"
+    "    uint first = groupID.x * blockSize + threadID.x;\n"
+    "    uint offset = blockOffsets[groupID.x];\n"
+    "    [unroll]\n"
+    "    for (uint i = 0; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = first + i * groupSize;\n"
+    "        if (index < count + predicate)\n"
+    "            dst[index] += offset;\n"
+    "    }\n"
+    "}\n"
+;
+
+static const char* g_hlslCompact =
+    "RWStructuredBuffer<uint> src : register(u1);\n"
+    "RWStructuredBuffer<uint> dst : register(u2);\n"
+    "RWStructuredBuffer<uint> indices : register(u3);\n"
+    "RWStructuredBuffer<uint> counts : register(u4);\n"
+    "[numthreads(GROUP_SIZE, 1, 1)]\n"
+    "void CS(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)\n"
+    "{\n"
+    "    uint first = groupID.x * blockSize + threadID.x;\n"
+    "    [unroll]\n"
+    "    for (uint i = 0; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = first + i * groupSize;\n"
+    "        if (index < count)\n"
+    "        {\n"
+    "            if (indices[index + 1] != indices[index])\n"
+    "                dst[indices[index]] = src[index];\n"
+    "        }\n"
+    "    }\n"
+    "    if (groupID.x == 0 && threadID.x == 0)\n"
+    "        counts[countIndex] = indices[count];\n"
+    "}\n"
+;
+
+static const char* g_hlslSortHistogram =
+    "RWStructuredBuffer<uint> keys : register(u1);\n"
+    "RWStructuredBuffer<uint> histogram : register(u2);\n"
+    "groupshared uint digitCounts[16];\n"
+    "[numthreads(GROUP_SIZE, 1, 1)]\n"
+    "void CS(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)\n"
+    "{\n"
+    "    uint tid = threadID.x;\n"
+    "    if (tid < radix)\n"
+    "        digitCounts[tid] = 0;\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    uint first = groupID.x * blockSize + tid;\n"
+    "    [unroll]\n"
+    "    for (uint i = 0; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = first + i * groupSize;\n"
+    "        if (index < count)\n"
+    "            InterlockedAdd(digitCounts[(keys[index] >> shift) & (radix - 1)], 1);\n"
+    "    }\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    if (tid < radix)\n"
+    "        histogram[tid * numBlocks + groupID.x] = digitCounts[tid];\n"
+    "}\n"
+;
+
+static const char* g_hlslSortScatter =
+    "RWStructuredBuffer<uint> srcKeys : register(u1);\n"
+    "RWStructuredBuffer<uint> dstKeys : register(u2);\n"
+    "RWStructuredBuffer<uint> digitOffsets : register(u3);\n"
+    "#ifdef KEY_VALUES\n"
+    "RWStructuredBuffer<uint> srcValues : register(u4);\n"
+    "RWStructuredBuffer<uint> dstValues : register(u5);\n"
+    "groupshared uint blockValues[GROUP_SIZE * 4];\n"
+    "#endif\n"
+    "groupshared uint blockKeys[GROUP_SIZE * 4];\n"
+    "groupshared uint blockDigitOffsets[16];\n"
+    "groupshared uint blockDigitStarts[16];\n"
+    "uint Digit(uint key)\n"
+    "{\n"
+    "    return (key >> shift) & (radix - 1);\n"
+    "}\n"
+    "[numthreads(GROUP_SIZE, 1, 1)]\n"
+    "void CS(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)\n"
+    "{\n"
+    "    uint tid = threadID.x;\n"
+    "    uint first = groupID.x * blockSize;\n"
+    "    [unroll]\n"
+    "    for (uint i = 0; i < itemsPerThread; ++i)\n"
+    "    {\n"
+    "        uint index = i * groupSize + tid;\n"
+    "        blockKeys[index] = 0xFFFFFFFF;\n"
+    "        #ifdef KEY_VALUES\n"
+    "        blockValues[index] = 0;\n"
+    "        #endif\n"
+    "        if (first + index < count)\n"
+    "        {\n"
+    "            blockKeys[index] = srcKeys[first + index];\n"
+    "            #ifdef KEY_VALUES\n"
+    "            blockValues[index] = srcValues[first + index];\n"
+    "            #endif\n"
+    "        }\n"
+    "    }\n"
+    "    if (tid < radix)\n"
+    "        blockDigitOffsets[tid] = digitOffsets[tid * numBlocks + groupID.x];\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    [unroll]\n"
+    "    for (uint bit = 0; bit < radixBits; ++bit)\n"
+    "    {\n"
+    "        uint keys[4];\n"
+    "        #ifdef KEY_VALUES\n"
+    "        uint values[4];\n"
+    "        #endif\n"
+    "        uint numZeros = 0;\n"
+    "        [unroll]\n"
+    "        for (uint j = 0; j < itemsPerThread; ++j)\n"
+    "        {\n"
+    "            keys[j] = blockKeys[tid * itemsPerThread + j];\n"
+    "            #ifdef KEY_VALUES\n"
+    "            values[j] = blockValues[tid * itemsPerThread + j];\n"
+    "            #endif\n"
+    "            numZeros += ((keys[j] >> (shift + bit)) & 1) ^ 1;\n"
+    "        }\n"
+    "        uint totalZeros;\n"
+    "        uint zerosBefore = GroupExclusiveScan(numZeros, tid, totalZeros);\n"
+    "        [unroll]\n"
+    "        for (uint k = 0; k < itemsPerThread; ++k)\n"
+    "        {\n"
+    "            uint pos;\n"
+    "            if (((keys[k] >> (shift + bit)) & 1) == 0)\n"
+    "                pos = zerosBefore++;\n"
+    "            else\n"
+    "                pos = totalZeros + tid * itemsPerThread + k - zerosBefore;\n"
+    "            blockKeys[pos] = keys[k];\n"
+    "            #ifdef KEY_VALUES\n"
+    "            blockValues[pos] = values[k];\n"
+    "            #endif\n"
+    "        }\n"
+    "        GroupMemoryBarrierWithGroupSync();\n"
+    "    }\n"
+    "    [unroll]\n"
+    "    for (uint m = 0; m < itemsPerThread; ++m)\n"
+    "    {\n"
+    "        uint index = tid * itemsPerThread + m;\n"
+    "        uint digit = Digit(blockKeys[index]);\n"
+    "        if (index == 0 || Digit(blockKeys[max(index, 1) - 1]) != digit)\n"
+    "            blockDigitStarts[digit] = index;\n"
+    "    }\n"
+    "    GroupMemoryBarrierWithGroupSync();\n"
+    "    [unroll]\n"
+    "    for (uint n = 0; n < itemsPerThread; ++n)\n"
+    "    {\n"
+    "        uint index = n * groupSize + tid;\n"
+    "        if (first + index < count)\n"
+    "        {\n"
+    "            uint digit = Digit(blockKeys[index]);\n"
+    "            uint pos = blockDigitOffsets[digit] + index - blockDigitStarts[digit];\n"
+    "            dstKeys[pos] = blockKeys[index];\n"
+    "            #ifdef KEY_VALUES\n"
+    "            dstValues[pos] = blockValues[index];\n"
+    "            #endif\n"
+    "        }\n"
+    "    }\n"
+    "}\n"
+;
+
+ParallelPrimitives::ParallelPrimitives(RenderSystem& renderSystem, CommandBuffer& commandBuffer, const ParallelPrimitivesDescriptor& desc) :
+    renderSystem_  { renderSystem  },
+    commandBuffer_ { commandBuffer },
+    desc_          { desc          }
+{
+    if (desc.maxElements == 0)
+        throw std::invalid_argument("cannot create parallel primitives with zero elements");
+    if (desc.threadGroupSize != 0 && (desc.threadGroupSize < g_radix || desc.threadGroupSize > 256))
+        throw std::invalid_argument("cannot create parallel primitives with thread group size out of range [16, 256]");
+
+    const auto& caps = renderSystem.GetRenderingCaps();
+    if (!caps.hasComputeShaders || !caps.hasStorageBuffers)
+        throw std::runtime_error("parallel primitives require compute shaders and storage buffers");
+
+    threadGroupSize_ = (desc.threadGroupSize != 0 ? desc.threadGroupSize : GetDefaultThreadGroupSize(caps));
+
+    if (caps.maxNumComputeShaderWorkGroups.x > 0 && NumBlocks(desc.maxElements) > caps.maxNumComputeShaderWorkGroups.x)
+        throw std::invalid_argument("cannot create parallel primitives with more elements than thread groups of a single dispatch command can process");
+
+    CreateKernels();
+    CreateBuffers();
+}
+
+ParallelPrimitives::~ParallelPrimitives()
+{
+    for (auto pipeline : pipelines_)
+    {
+        if (pipeline)
+            renderSystem_.Release(*pipeline);
+    }
+    for (auto shaderProgram : shaderPrograms_)
+    {
+        if (shaderProgram)
+            renderSystem_.Release(*shaderProgram);
+    }
+    for (auto shader : shaders_)
+        renderSystem_.Release(*shader);
+
+    for (const auto& level : scanLevels_)
+    {
+        renderSystem_.Release(*level.blockSums);
+        if (level.scannedSums)
+            renderSystem_.Release(*level.scannedSums);
+    }
+    for (auto paramBuffers : { &scanParams_, &compactParams_, &sortParams_ })
+    {
+        for (auto buffer : *paramBuffers)
+            renderSystem_.Release(*buffer);
+    }
+    for (auto buffer : { compactIndices_, sortHistogram_, sortOffsets_, sortKeys_, sortValues_ })
+    {
+        if (buffer)
+            renderSystem_.Release(*buffer);
+    }
+}
+
+void ParallelPrimitives::ExclusiveScan(Buffer& srcBuffer, Buffer& dstBuffer, std::uint32_t numElements)
+{
+    if (numElements > desc_.maxElements)
+        throw std::out_of_range("number of elements exceeds maximal number of elements of parallel primitives");
+    if (numElements > 0)
+        RecordScan(srcBuffer, dstBuffer, numElements, false, 0, scanParams_.data());
+}
+
+void ParallelPrimitives::Compact(
+    Buffer&         flagsBuffer,
+    Buffer&         srcBuffer,
+    Buffer&         dstBuffer,
+    std::uint32_t   numElements,
+    Buffer&         countBuffer,
+    std::uint32_t   countIndex)
+{
+    if (numElements > desc_.maxElements)
+        throw std::out_of_range("number of elements exceeds maximal number of elements of parallel primitives");
+
+    /* Scan the flags into the destination indices, with the number of kept elements as additional last index */
+    RecordScan(flagsBuffer, *compactIndices_, numElements, true, countIndex, compactParams_.data());
+
+    /* Move each kept element to its destination index, i.e. where the index increments; the first thread also writes the number of kept elements */
+    Buffer* storageBuffers[] = { &srcBuffer, &dstBuffer, compactIndices_, &countBuffer };
+    Dispatch(KernelCompact, *compactParams_[0], std::max(1u, NumBlocks(numElements)), storageBuffers, 4);
+}
+
+void ParallelPrimitives::Sort(Buffer& keysBuffer, std::uint32_t numElements, std::uint32_t keyBits)
+{
+    RecordSort(keysBuffer, nullptr, numElements, keyBits);
+}
+
+void ParallelPrimitives::SortKeyValues(Buffer& keysBuffer, Buffer& valuesBuffer, std::uint32_t numElements, std::uint32_t keyBits)
+{
+    if (!desc_.keyValueSort)
+        throw std::runtime_error("cannot sort key-value pairs with parallel primitives that have been created without key-value sort");
+    RecordSort(keysBuffer, &valuesBuffer, numElements, keyBits);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ParallelPrimitives::CreateKernels()
+{
+    const auto language = renderSystem_.GetRenderingCaps().shadingLanguage;
+
+    /* Select built-in shaders for the shading language; all of them require compute shaders and storage buffers */
+    std::string header;
+    const char* common = nullptr;
+    const char* sources[KernelCount] = {};
+    ShaderDescriptor shaderDesc;
+
+    if (IsGLSL(language) && language >= ShadingLanguage::GLSL_430)
+    {
+        header      = "#version 430\n";
+        common      = g_glslCommon;
+        sources[0]  = g_glslScanBlocks;
+        sources[1]  = g_glslAddOffsets;
+        sources[2]  = g_glslCompact;
+        sources[3]  = g_glslSortHistogram;
+        sources[4]  = g_glslSortScatter;
+        sources[5]  = g_glslSortScatter;
+    }
+    else if (IsESSL(language) && language >= ShadingLanguage::GLSL_ES_310)
+    {
+        header      = "#version 310 es\nprecision highp int;\n";
+        common      = g_glslCommon;
+        sources[0]  = g_glslScanBlocks;
+        sources[1]  = g_glslAddOffsets;
+        sources[2]  = g_glslCompact;
+        sources[3]  = g_glslSortHistogram;
+        sources[4]  = g_glslSortScatter;
+        sources[5]  = g_glslSortScatter;
+    }
+    else if (IsHLSL(language) && language >= ShadingLanguage::HLSL_5_0)
+    {
+        common      = g_hlslCommon;
+        sources[0]  = g_hlslScanBlocks;
+        sources[1]  = g_hlslAddOffsets;
+        sources[2]  = g_hlslCompact;
+        sources[3]  = g_hlslSortHistogram;
+        sources[4]  = g_hlslSortScatter;
+        sources[5]  = g_hlslSortScatter;
+        shaderDesc  = ShaderDescriptor { "CS", "cs_5_0" };
+    }
+    else
+        ThrowNotSupported("parallel primitives for the shading language of this render system");
+
+    header += "#define GROUP_SIZE " + std::to_string(threadGroupSize_) + "\n";
+
+    /* Compile each kernel into its own compute pipeline */
+    for (int kernel = 0; kernel < KernelCount; ++kernel)
+    {
+        if (kernel == KernelSortScatterKeyValues && !desc_.keyValueSort)
+            continue;
+
+        auto source = header;
+        if (kernel == KernelSortScatterKeyValues)
+            source += "#define KEY_VALUES\n";
+        source += common;
+        source += sources[kernel];
+
+        auto shader = renderSystem_.CreateShader(ShaderType::Compute);
+        shaders_.push_back(shader);
+
+        if (!shader->Compile(source, shaderDesc))
+            throw std::runtime_error("failed to compile shader of parallel primitives: " + shader->QueryInfoLog());
+
+        shaderPrograms_[kernel] = renderSystem_.CreateShaderProgram();
+        shaderPrograms_[kernel]->AttachShader(*shader);
+
+        if (!shaderPrograms_[kernel]->LinkShaders())
+            throw std::runtime_error("failed to link shader program of parallel primitives: " + shaderPrograms_[kernel]->QueryInfoLog());
+
+        pipelines_[kernel] = renderSystem_.CreateComputePipeline(ComputePipelineDescriptor { shaderPrograms_[kernel] });
+    }
+}
+
+void ParallelPrimitives::CreateBuffers()
+{
+    /* Largest scan is either the compaction (with the additional total) or the digit histogram of the radix sort */
+    const auto maxHistogramSize = g_radix * NumBlocks(desc_.maxElements);
+    auto numElements = std::max(desc_.maxElements + 1, maxHistogramSize);
+
+    /* Create block sums for each level of the hierarchical scan, until a level fits into a single block */
+    while (true)
+    {
+        const auto numBlocks = NumBlocks(numElements);
+
+        ScanLevel level;
+        level.blockSums = CreateStorageBuffer(numBlocks);
+        if (numBlocks > 1)
+            level.scannedSums = CreateStorageBuffer(numBlocks);
+        scanLevels_.push_back(level);
+
+        if (numBlocks == 1)
+            break;
+
+        numElements = numBlocks;
+    }
+
+    /* Create one constant buffer per scan level for each operation, and one per pass for the radix sort */
+    const auto numLevels = scanLevels_.size();
+    const auto maxPasses = 32 / g_radixBits;
+
+    for (std::size_t i = 0; i < numLevels; ++i)
+    {
+        scanParams_.push_back(CreateConstantBuffer());
+        compactParams_.push_back(CreateConstantBuffer());
+    }
+    for (std::size_t i = 0; i < numLevels + maxPasses; ++i)
+        sortParams_.push_back(CreateConstantBuffer());
+
+    /* Create scratch buffers */
+    compactIndices_ = CreateStorageBuffer(desc_.maxElements + 1);
+    sortHistogram_  = CreateStorageBuffer(maxHistogramSize);
+    sortOffsets_    = CreateStorageBuffer(maxHistogramSize);
+    sortKeys_       = CreateStorageBuffer(desc_.maxElements);
+    if (desc_.keyValueSort)
+        sortValues_ = CreateStorageBuffer(desc_.maxElements);
+}
+
+Buffer* ParallelPrimitives::CreateStorageBuffer(std::uint32_t numElements)
+{
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type                         = BufferType::Storage;
+        bufferDesc.size                         = numElements * sizeof(std::uint32_t);
+        bufferDesc.storageBuffer.storageType    = StorageBufferType::RWStructuredBuffer;
+        bufferDesc.storageBuffer.stride         = sizeof(std::uint32_t);
+    }
+    return renderSystem_.CreateBuffer(bufferDesc);
+}
+
+Buffer* ParallelPrimitives::CreateConstantBuffer()
+{
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type     = BufferType::Constant;
+        bufferDesc.size     = sizeof(ParallelPrimitivesParameters);
+        bufferDesc.flags    = BufferFlags::DynamicUsage;
+    }
+    return renderSystem_.CreateBuffer(bufferDesc);
+}
+
+void ParallelPrimitives::RecordScan(
+    Buffer&         srcBuffer,
+    Buffer&         dstBuffer,
+    std::uint32_t   numElements,
+    bool            predicate,
+    std::uint32_t   countIndex,
+    Buffer* const*  paramBuffers)
+{
+    /* Scan each level into its destination and the sums of its blocks, until a level fits into a single block */
+    ParallelPrimitivesParameters params;
+    {
+        params.count        = numElements;
+        params.predicate    = (predicate ? 1u : 0u);
+        params.countIndex   = countIndex;
+    }
+
+    Buffer* src = &srcBuffer;
+    Buffer* dst = &dstBuffer;
+    std::size_t level = 0;
+    std::uint32_t levelBlocks[32] = {};
+
+    while (true)
+    {
+        params.numBlocks = NumBlocks(params.count + params.predicate);
+        levelBlocks[level] = params.numBlocks;
+        renderSystem_.WriteBuffer(*paramBuffers[level], &params, sizeof(params), 0);
+
+        Buffer* storageBuffers[] = { src, dst, scanLevels_[level].blockSums };
+        Dispatch(KernelScanBlocks, *paramBuffers[level], params.numBlocks, storageBuffers, 3);
+
+        if (params.numBlocks == 1)
+            break;
+
+        /* Scan the block sums of this level with the next level */
+        src                 = scanLevels_[level].blockSums;
+        dst                 = scanLevels_[level].scannedSums;
+        params.count        = params.numBlocks;
+        params.predicate    = 0;
+        ++level;
+    }
+
+    /* Add the scanned block sums of the next level to each block, from the top level down to the first level */
+    while (level-- > 0)
+    {
+        Buffer* levelDst = (level > 0 ? scanLevels_[level - 1].scannedSums : &dstBuffer);
+        Buffer* storageBuffers[] = { nullptr, levelDst, scanLevels_[level].scannedSums };
+        Dispatch(KernelAddOffsets, *paramBuffers[level], levelBlocks[level], storageBuffers, 3);
+    }
+}
+
+void ParallelPrimitives::RecordSort(Buffer& keysBuffer, Buffer* valuesBuffer, std::uint32_t numElements, std::uint32_t keyBits)
+{
+    if (numElements > desc_.maxElements)
+        throw std::out_of_range("number of elements exceeds maximal number of elements of parallel primitives");
+    if (keyBits == 0 || keyBits > 32)
+        throw std::invalid_argument("number of key bits for radix sort must be in the range [1, 32]");
+    if (numElements == 0)
+        return;
+
+    const auto numBlocks    = NumBlocks(numElements);
+    const auto numPasses    = (keyBits + g_radixBits - 1) / g_radixBits;
+    const auto numLevels    = scanLevels_.size();
+    const auto kernel       = (valuesBuffer != nullptr ? KernelSortScatterKeyValues : KernelSortScatter);
+
+    /* Ping-pong between the input buffers and the scratch buffers */
+    Buffer* keys[2]     = { &keysBuffer, sortKeys_ };
+    Buffer* values[2]   = { valuesBuffer, sortValues_ };
+
+    for (std::uint32_t pass = 0; pass < numPasses; ++pass)
+    {
+        auto paramBuffer = sortParams_[numLevels + pass];
+
+        ParallelPrimitivesParameters params;
+        {
+            params.count        = numElements;
+            params.numBlocks    = numBlocks;
+            params.shift        = pass * g_radixBits;
+        }
+        renderSystem_.WriteBuffer(*paramBuffer, &params, sizeof(params), 0);
+
+        /* Count the digits of each block, with the digit-major layout of the histogram */
+        Buffer* histogramBuffers[] = { keys[pass % 2], sortHistogram_ };
+        Dispatch(KernelSortHistogram, *paramBuffer, numBlocks, histogramBuffers, 2);
+
+        /* Scan the histogram, which yields the destination offset of each digit within each block */
+        RecordScan(*sortHistogram_, *sortOffsets_, g_radix * numBlocks, false, 0, sortParams_.data());
+
+        /* Sort each block locally by the digit, and move the elements to their destination */
+        Buffer* scatterBuffers[] = { keys[pass % 2], keys[(pass + 1) % 2], sortOffsets_, values[pass % 2], values[(pass + 1) % 2] };
+        Dispatch(kernel, *paramBuffer, numBlocks, scatterBuffers, (valuesBuffer != nullptr ? 5 : 3));
+    }
+
+    /* Copy the result of an odd number of passes from the scratch buffers into the input buffers */
+    if (numPasses % 2 != 0)
+    {
+        const auto size = static_cast<unsigned int>(numElements * sizeof(std::uint32_t));
+        commandBuffer_.Barrier(BarrierFlags::Copy);
+        commandBuffer_.CopyBuffer(keysBuffer, 0, *sortKeys_, 0, size);
+        if (valuesBuffer != nullptr)
+            commandBuffer_.CopyBuffer(*valuesBuffer, 0, *sortValues_, 0, size);
+        commandBuffer_.Barrier(BarrierFlags::StorageBuffer);
+    }
+}
+
+void ParallelPrimitives::Dispatch(Kernel kernel, Buffer& paramBuffer, std::uint32_t numBlocks, Buffer* const* storageBuffers, std::uint32_t numStorageBuffers)
+{
+    /* Storage buffers are bound to consecutive slots after the constant buffer; null entries are not used by the kernel */
+    commandBuffer_.SetComputePipeline(*pipelines_[kernel]);
+    commandBuffer_.SetConstantBuffer(paramBuffer, 0, ShaderStageFlags::ComputeStage);
+
+    for (std::uint32_t i = 0; i < numStorageBuffers; ++i)
+    {
+        if (storageBuffers[i] != nullptr)
+            commandBuffer_.SetStorageBuffer(*storageBuffers[i], i + 1, ShaderStageFlags::ComputeStage);
+    }
+
+    commandBuffer_.Dispatch(numBlocks, 1, 1);
+    commandBuffer_.Barrier(BarrierFlags::StorageBuffer);
+}
+
+std::uint32_t ParallelPrimitives::NumBlocks(std::uint32_t numElements) const
+{
+    const auto blockSize = threadGroupSize_ * g_itemsPerThread;
+    return (numElements + blockSize - 1) / blockSize;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,546 @@
+/*
+ * PerformanceHUD.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/PerformanceHUD.h>
+#include "../Core/Exception.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+
+
+namespace LLGL
+{
+
+
+/*
+Built-in 3x5 pixel font for the ASCII characters 32 (' ') to 95 ('_'); lower case letters are mapped to upper case.
+Each glyph stores its 5 rows from top to bottom with 3 bits per row, where the most significant bit is the left pixel.
+*/
+static const std::uint16_t g_fontGlyphs[64] =
+{
+    0x0000, 0x2482, 0x5A00, 0x5F7D, 0x3C9E, 0x42A1, 0x2AAB, 0x2400, // ' !"#$%&''
+    0x1491, 0x4494, 0x0AA8, 0x05D0, 0x0014, 0x01C0, 0x0002, 0x12A4, // '()*+,-./'
+    0x7B6F, 0x2C97, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7249, // '01234567'
+    0x7BEF, 0x7BCF, 0x0410, 0x0414, 0x1511, 0x0E38, 0x4454, 0x72C2, // '89:;<=>?'
+    0x7BE7, 0x2BED, 0x6BAE, 0x3923, 0x6B6E, 0x79A7, 0x79A4, 0x396B, // '@ABCDEFG'
+    0x5BED, 0x7497, 0x126A, 0x5BAD, 0x4927, 0x5FED, 0x6B6D, 0x2B6A, // 'HIJKLMNO'
+    0x6BA4, 0x2B73, 0x6BAD, 0x388E, 0x7492, 0x5B6F, 0x5B6A, 0x5BFD, // 'PQRSTUVW'
+    0x5AAD, 0x5A92, 0x72A7, 0x6926, 0x4889, 0x324B, 0x2A00, 0x0007, // 'XYZ[\]^_'
+};
+
+// Glyph cell size in font pixels, including the spacing to the next glyph and line.
+static const unsigned int g_glyphAdvance    = 4;
+static const unsigned int g_lineAdvance     = 7;
+
+// Height of the frame-time graph in font pixels.
+static const unsigned int g_graphHeight     = 24;
+
+static const ColorRGBAub g_colorBackground  { 0,   0,   0,   176 };
+static const ColorRGBAub g_colorText        { 255, 255, 255, 255 };
+static const ColorRGBAub g_colorLabel       { 160, 200, 255, 255 };
+static const ColorRGBAub g_colorGood        { 64,  224, 64,  255 };
+static const ColorRGBAub g_colorWarning     { 255, 208, 32,  255 };
+static const ColorRGBAub g_colorBad         { 255, 64,  48,  255 };
+static const ColorRGBAub g_colorGrid        { 255, 255, 255, 64  };
+
+static const std::uint64_t g_megabyte = 1024 * 1024;
+
+static std::size_t FindCounterIndex(const char* name)
+{
+    for (std::size_t i = 0; i < RenderingProfiler::numCounters; ++i)
+    {
+        if (std::strcmp(RenderingProfiler::GetCounterName(i), name) == 0)
+            return i;
+    }
+    return 0;
+}
+
+static std::string FormatString(const char* format, double value0, double value1 = 0.0, double value2 = 0.0)
+{
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), format, value0, value1, value2);
+    return buffer;
+}
+
+static double ToMegabytes(std::uint64_t size)
+{
+    return static_cast<double>(size) / static_cast<double>(g_megabyte);
+}
+
+// Returns the color of the specified frame time (in milliseconds), relative to 60 Hz and 30 Hz.
+static const ColorRGBAub& GetFrameTimeColor(double frameTime)
+{
+    if (frameTime <= 1000.0/60.0)
+        return g_colorGood;
+    if (frameTime <= 1000.0/30.0)
+        return g_colorWarning;
+    return g_colorBad;
+}
+
+static bool IsGLSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::GLSL_110 && language <= ShadingLanguage::GLSL_460);
+}
+
+static bool IsESSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::GLSL_ES_100 && language <= ShadingLanguage::GLSL_ES_320);
+}
+
+static bool IsHLSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::HLSL_4_0 && language <= ShadingLanguage::HLSL_5_1);
+}
+
+// Returns the version directive and keywords of the GLSL shaders for the specified shading language.
+static std::string GetGLSLHeader(const ShadingLanguage language, bool fragmentShader)
+{
+    std::string header;
+
+    const bool legacy = (language < ShadingLanguage::GLSL_140 || language == ShadingLanguage::GLSL_ES_100);
+
+    if (IsESSL(language))
+        header = (legacy ? "#version 100\nprecision mediump float;\n" : "#version 300 es\nprecision mediump float;\n");
+    else
+        header = (legacy ? "#version 110\n" : "#version 140\n");
+
+    if (legacy)
+        header += (fragmentShader ? "#define IN varying\n#define FRAG_COLOR gl_FragColor\n" : "#define IN attribute\n#define OUT varying\n");
+    else
+        header += (fragmentShader ? "#define IN in\nout vec4 fragColor;\n#define FRAG_COLOR fragColor\n" : "#define IN in\n#define OUT out\n");
+
+    return header;
+}
+
+static const char* g_glslVertexShader =
+    "IN vec2 position;\n"
+    "IN vec4 color;\n"
+    "OUT vec4 vColor;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = vec4(position, 0.0, 1.0);\n"
+    "    vColor = color;\n"
+    "}\n"
+;
+
+static const char* g_glslFragmentShader =
+    "IN vec4 vColor;\n"
+    "void main()\n"
+    "{\n"
+    "    FRAG_COLOR = vColor;\n"
+    "}\n"
+;
+
+static const char* g_hlslShader =
+    "struct VertexIn\n"
+    "{\n"
+    "    float2 position : POSITION;\n"
+    "    float4 color    : COLOR;\n"
+    "};\n"
+    "struct VertexOut\n"
+    "{\n"
+    "    float4 position : SV_Position;\n"
+    "    float4 color    : COLOR;\n"
+    "};\n"
+    "VertexOut VS(VertexIn inp)\n"
+    "{\n"
+    "    VertexOut outp;\n"
+    "    outp.position = float4(inp.position, 0.0, 1.0);\n"
+    "    outp.color = inp.color;\n"
+    "    return outp;\n"
+    "}\n"
+    "float4 PS(VertexOut inp) : SV_Target\n"
+    "{\n"
+    "    return inp.color;\n"
+    "}\n"
+;
+
+PerformanceHUD::PerformanceHUD(RenderSystem& renderSystem, RenderContext& renderContext, const PerformanceHUDDescriptor& desc) :
+    renderSystem_  { renderSystem  },
+    renderContext_ { renderContext },
+    desc_          { desc          }
+{
+    if (desc.scale == 0 || desc.maxVertices == 0 || desc.numFrames == 0)
+        throw std::invalid_argument("cannot create performance HUD with zero scale, vertices, or frames");
+
+    vertices_.reserve(desc.maxVertices);
+
+    CreateShaderProgram();
+    CreateGraphicsPipeline();
+    CreateVertexBuffer();
+}
+
+PerformanceHUD::~PerformanceHUD()
+{
+    if (vertexBuffer_)
+        renderSystem_.Release(*vertexBuffer_);
+    if (graphicsPipeline_)
+        renderSystem_.Release(*graphicsPipeline_);
+    if (shaderProgram_)
+        renderSystem_.Release(*shaderProgram_);
+    for (auto shader : shaders_)
+        renderSystem_.Release(*shader);
+}
+
+void PerformanceHUD::SetRenderingProfiler(const RenderingProfiler* profiler)
+{
+    profiler_ = profiler;
+}
+
+void PerformanceHUD::SetGPUFrame(const GPUProfilerFrame& frame)
+{
+    gpuFrame_       = frame;
+    hasGPUFrame_    = true;
+}
+
+void PerformanceHUD::Draw(CommandBuffer& commandBuffer)
+{
+    const auto& resolution = renderContext_.GetVideoMode().resolution;
+    if (resolution.x <= 0 || resolution.y <= 0)
+        return;
+
+    /* Generate all vertices of the overlay in normalized device coordinates */
+    pixelToNDC_[0] = 2.0f / static_cast<float>(resolution.x);
+    pixelToNDC_[1] = 2.0f / static_cast<float>(resolution.y);
+
+    BuildOverlay();
+
+    if (vertices_.empty())
+        return;
+
+    /* Write vertices into the next partition of the ring buffer */
+    const auto partition = static_cast<unsigned int>(frameIndex_++ % desc_.numFrames);
+    const auto firstVertex = partition * desc_.maxVertices;
+
+    renderSystem_.WriteBuffer(
+        *vertexBuffer_,
+        vertices_.data(),
+        vertices_.size() * sizeof(Vertex),
+        firstVertex * sizeof(Vertex)
+    );
+
+    /* Draw entire overlay with a single draw call */
+    commandBuffer.SetViewport(Viewport { 0.0f, 0.0f, static_cast<float>(resolution.x), static_cast<float>(resolution.y) });
+    commandBuffer.SetGraphicsPipeline(*graphicsPipeline_);
+    commandBuffer.SetVertexBuffer(*vertexBuffer_);
+    commandBuffer.Draw(static_cast<unsigned int>(vertices_.size()), firstVertex);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void PerformanceHUD::CreateShaderProgram()
+{
+    const auto language = renderSystem_.GetRenderingCaps().shadingLanguage;
+
+    /* Select built-in shaders and vertex attribute names for the shading language */
+    std::string vertexSource, fragmentSource;
+    ShaderDescriptor vertexDesc, fragmentDesc;
+
+    if (IsGLSL(language) || IsESSL(language))
+    {
+        vertexSource    = GetGLSLHeader(language, false) + g_glslVertexShader;
+        fragmentSource  = GetGLSLHeader(language, true) + g_glslFragmentShader;
+        vertexFormat_.AppendAttribute({ "position", VectorType::Float2     });
+        vertexFormat_.AppendAttribute({ "color",    VectorType::UByte4Norm });
+    }
+    else if (IsHLSL(language))
+    {
+        vertexSource    = g_hlslShader;
+        fragmentSource  = g_hlslShader;
+        vertexDesc      = ShaderDescriptor { "VS", "vs_4_0" };
+        fragmentDesc    = ShaderDescriptor { "PS", "ps_4_0" };
+        vertexFormat_.AppendAttribute({ "POSITION", VectorType::Float2     });
+        vertexFormat_.AppendAttribute({ "COLOR",    VectorType::UByte4Norm });
+    }
+    else
+        ThrowNotSupported("performance HUD for the shading language of this render system");
+
+    /* Compile vertex and fragment shader */
+    shaderProgram_ = renderSystem_.CreateShaderProgram();
+
+    auto CompileShader = [&](const ShaderType type, const std::string& source, const ShaderDescriptor& shaderDesc)
+    {
+        auto shader = renderSystem_.CreateShader(type);
+        shaders_.push_back(shader);
+
+        if (!shader->Compile(source, shaderDesc))
+            throw std::runtime_error("failed to compile shader of performance HUD: " + shader->QueryInfoLog());
+
+        shaderProgram_->AttachShader(*shader);
+    };
+
+    CompileShader(ShaderType::Vertex, vertexSource, vertexDesc);
+    CompileShader(ShaderType::Fragment, fragmentSource, fragmentDesc);
+
+    shaderProgram_->BuildInputLayout(vertexFormat_);
+
+    if (!shaderProgram_->LinkShaders())
+        throw std::runtime_error("failed to link shader program of performance HUD: " + shaderProgram_->QueryInfoLog());
+}
+
+void PerformanceHUD::CreateGraphicsPipeline()
+{
+    /* Create pipeline with alpha blending and without depth test, so the overlay is drawn on top of the scene */
+    GraphicsPipelineDescriptor pipelineDesc;
+    {
+        pipelineDesc.shaderProgram                  = shaderProgram_;
+        pipelineDesc.primitiveTopology              = PrimitiveTopology::TriangleList;
+        pipelineDesc.rasterizer.multiSampling       = MultiSamplingDescriptor { desc_.samples };
+        pipelineDesc.blend.blendEnabled             = true;
+        pipelineDesc.blend.targets.resize(1);
+    }
+    graphicsPipeline_ = renderSystem_.CreateGraphicsPipeline(pipelineDesc);
+}
+
+void PerformanceHUD::CreateVertexBuffer()
+{
+    /* Create vertex buffer with one partition of vertices per frame */
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type                 = BufferType::Vertex;
+        bufferDesc.size                 = static_cast<unsigned int>(sizeof(Vertex) * desc_.maxVertices * desc_.numFrames);
+        bufferDesc.flags                = BufferFlags::DynamicUsage;
+        bufferDesc.vertexBuffer.format  = vertexFormat_;
+    }
+    vertexBuffer_ = renderSystem_.CreateBuffer(bufferDesc);
+}
+
+void PerformanceHUD::BuildOverlay()
+{
+    vertices_.clear();
+
+    const auto scale    = static_cast<float>(desc_.scale);
+    const auto margin   = 2.0f * scale;
+    const auto left     = static_cast<float>(desc_.x) + margin;
+    const auto top      = static_cast<float>(desc_.y) + margin;
+
+    /* Reserve vertices for the background panel, whose size is known only after all other elements have been generated */
+    AddRect(0.0f, 0.0f, 0.0f, 0.0f, g_colorBackground);
+    panelWidth_ = 0.0f;
+
+    auto y = top;
+
+    /* Frame times and counters of the most recent frame */
+    if (profiler_ != nullptr && profiler_->GetNumFrames() > 0)
+    {
+        const auto stats = profiler_->GetFrameTimeStatistics();
+        const auto& frame = profiler_->GetFrame(profiler_->GetNumFrames() - 1);
+        const auto avgTime = stats.avg * 1000.0;
+
+        AddText(left, y, FormatString("FPS %.1f  CPU %.2f MS  P99 %.2f MS", (avgTime > 0.0 ? 1000.0 / avgTime : 0.0), avgTime, stats.p99 * 1000.0), g_colorText);
+
+        BuildFrameTimeGraph(left, y);
+
+        static const std::size_t drawCalls          = FindCounterIndex("drawCalls");
+        static const std::size_t dispatchCalls      = FindCounterIndex("dispatchComputeCalls");
+        static const std::size_t setPipelines       = FindCounterIndex("setGraphicsPipeline");
+        static const std::size_t setComputePipes    = FindCounterIndex("setComputePipeline");
+        static const std::size_t setVertexBuffers   = FindCounterIndex("setVertexBuffer");
+        static const std::size_t setIndexBuffers    = FindCounterIndex("setIndexBuffer");
+        static const std::size_t setConstBuffers    = FindCounterIndex("setConstantBuffer");
+        static const std::size_t setStorageBuffers  = FindCounterIndex("setStorageBuffer");
+        static const std::size_t setTextures        = FindCounterIndex("setTexture");
+        static const std::size_t setSamplers        = FindCounterIndex("setSampler");
+        static const std::size_t setResourceHeaps   = FindCounterIndex("setResourceHeap");
+        static const std::size_t redundantBindings  = FindCounterIndex("redundantBindings");
+
+        const auto& counters = frame.counters;
+
+        AddText(
+            left, y,
+            FormatString(
+                "DRAWS %.0f  DISPATCHES %.0f  PIPELINES %.0f",
+                counters[drawCalls], counters[dispatchCalls], counters[setPipelines] + counters[setComputePipes]
+            ),
+            g_colorText
+        );
+        AddText(
+            left, y,
+            FormatString(
+                "BUFFERS %.0f  TEXTURES %.0f  HEAPS %.0f",
+                counters[setVertexBuffers] + counters[setIndexBuffers] + counters[setConstBuffers] + counters[setStorageBuffers],
+                counters[setTextures] + counters[setSamplers],
+                counters[setResourceHeaps]
+            ),
+            g_colorText
+        );
+        if (counters[redundantBindings] > 0)
+            AddText(left, y, FormatString("REDUNDANT BINDINGS %.0f", counters[redundantBindings]), g_colorWarning);
+    }
+
+    /* GPU timings of the top-level scopes */
+    if (hasGPUFrame_)
+    {
+        const auto frameTime = static_cast<double>(gpuFrame_.elapsedTime) / 1000000.0;
+        AddText(left, y, FormatString("GPU %.2f MS", frameTime), GetFrameTimeColor(frameTime));
+
+        unsigned int numScopes = 0;
+        for (const auto& scope : gpuFrame_.scopes)
+        {
+            if (scope.depth != 0)
+                continue;
+            if (numScopes++ == desc_.maxGPUScopes)
+                break;
+
+            /* Draw bar with the share of this scope in the entire frame, followed by the name and time of the scope */
+            const auto barWidth = static_cast<float>(g_glyphAdvance * 8) * scale;
+            const auto share    = (gpuFrame_.elapsedTime > 0 ? static_cast<float>(scope.elapsedTime) / static_cast<float>(gpuFrame_.elapsedTime) : 0.0f);
+
+            AddRect(left, y, barWidth, 5.0f * scale, g_colorGrid);
+            AddRect(left, y, barWidth * std::min(share, 1.0f), 5.0f * scale, g_colorLabel);
+
+            AddText(left + barWidth + static_cast<float>(g_glyphAdvance) * scale, y, FormatString("%.2f MS  ", static_cast<double>(scope.elapsedTime) / 1000000.0) + scope.name, g_colorText);
+        }
+    }
+
+    /* Memory usage */
+    const auto memoryInfo = renderSystem_.QueryMemoryInfo();
+
+    const auto localUsage = (memoryInfo.local.currentUsage > 0 ? memoryInfo.local.currentUsage : memoryInfo.bufferMemory + memoryInfo.textureMemory + memoryInfo.renderTargetMemory);
+    if (memoryInfo.local.budget > 0)
+    {
+        const auto& color = (localUsage > memoryInfo.local.budget ? g_colorBad : g_colorText);
+        AddText(left, y, FormatString("VRAM %.0f / %.0f MB", ToMegabytes(localUsage), ToMegabytes(memoryInfo.local.budget)), color);
+    }
+    else
+        AddText(left, y, FormatString("VRAM %.0f MB", ToMegabytes(localUsage)), g_colorText);
+
+    AddText(
+        left, y,
+        FormatString(
+            "BUF %.1f MB  TEX %.1f MB  RT %.1f MB",
+            ToMegabytes(memoryInfo.bufferMemory), ToMegabytes(memoryInfo.textureMemory), ToMegabytes(memoryInfo.renderTargetMemory)
+        ),
+        g_colorLabel
+    );
+
+    /* Update background panel, which is drawn first and covers all elements */
+    if (vertices_.size() >= 6)
+    {
+        const auto panelHeight = (y - top) + margin * 2.0f - static_cast<float>(g_lineAdvance - 5) * scale;
+        WriteRect(&vertices_[0], static_cast<float>(desc_.x), static_cast<float>(desc_.y), panelWidth_ + margin * 2.0f, panelHeight, g_colorBackground);
+    }
+}
+
+void PerformanceHUD::BuildFrameTimeGraph(float x, float& y)
+{
+    const auto scale        = static_cast<float>(desc_.scale);
+    const auto height       = static_cast<float>(g_graphHeight) * scale;
+    const auto numFrames    = profiler_->GetNumFrames();
+    const auto maxTime      = static_cast<double>(std::max(desc_.graphMaxTime, 1.0f));
+    const auto width        = static_cast<float>(numFrames) * scale;
+
+    /* Draw reference lines for 60 Hz and 30 Hz */
+    const double refTimes[] = { 1000.0/60.0, 1000.0/30.0 };
+    for (auto refTime : refTimes)
+    {
+        if (refTime < maxTime)
+        {
+            const auto refY = y + height - static_cast<float>(refTime / maxTime) * height;
+            AddRect(x, refY, width, 1.0f, g_colorGrid);
+        }
+    }
+
+    /* Draw one bar per frame from the oldest to the most recent frame */
+    for (std::size_t i = 0; i < numFrames; ++i)
+    {
+        const auto frameTime = profiler_->GetFrame(i).frameTime * 1000.0;
+        const auto barHeight = static_cast<float>(std::min(frameTime / maxTime, 1.0)) * height;
+        AddRect(x + static_cast<float>(i) * scale, y + height - barHeight, scale, barHeight, GetFrameTimeColor(frameTime));
+    }
+
+    panelWidth_ = std::max(panelWidth_, width);
+    y += height + static_cast<float>(g_lineAdvance - 5) * scale;
+}
+
+void PerformanceHUD::AddRect(float x, float y, float width, float height, const ColorRGBAub& color)
+{
+    if (vertices_.size() + 6 > desc_.maxVertices)
+        return;
+
+    vertices_.resize(vertices_.size() + 6);
+    WriteRect(&vertices_[vertices_.size() - 6], x, y, width, height, color);
+}
+
+void PerformanceHUD::WriteRect(Vertex* vertices, float x, float y, float width, float height, const ColorRGBAub& color)
+{
+    /* Convert pixel coordinates (with upper-left origin) into normalized device coordinates */
+    const auto x0 = x * pixelToNDC_[0] - 1.0f;
+    const auto y0 = 1.0f - y * pixelToNDC_[1];
+    const auto x1 = (x + width) * pixelToNDC_[0] - 1.0f;
+    const auto y1 = 1.0f - (y + height) * pixelToNDC_[1];
+
+    /* Write two triangles of the rectangle */
+    vertices[0] = { { x0, y0 }, color };
+    vertices[1] = { { x1, y0 }, color };
+    vertices[2] = { { x0, y1 }, color };
+    vertices[3] = { { x0, y1 }, color };
+    vertices[4] = { { x1, y0 }, color };
+    vertices[5] = { { x1, y1 }, color };
+}
+
+void PerformanceHUD::AddText(float x, float& y, const std::string& text, const ColorRGBAub& color)
+{
+    const auto scale = static_cast<float>(desc_.scale);
+
+    auto penX = x;
+
+    for (auto c : text)
+    {
+        /* Map character onto the glyph table; unknown characters are drawn as '?' */
+        if (c >= 'a' && c <= 'z')
+            c = static_cast<char>(c - 'a' + 'A');
+        if (c < ' ' || c > '_')
+            c = '?';
+
+        const auto glyph = g_fontGlyphs[c - ' '];
+
+        /* Add one rectangle per horizontal run of pixels in each row */
+        for (unsigned int row = 0; row < 5; ++row)
+        {
+            const auto bits = (glyph >> ((4 - row) * 3)) & 0x7;
+            for (unsigned int col = 0; col < 3;)
+            {
+                if ((bits & (0x4 >> col)) == 0)
+                {
+                    ++col;
+                    continue;
+                }
+
+                auto runEnd = col + 1;
+                while (runEnd < 3 && (bits & (0x4 >> runEnd)) != 0)
+                    ++runEnd;
+
+                AddRect(
+                    penX + static_cast<float>(col) * scale,
+                    y + static_cast<float>(row) * scale,
+                    static_cast<float>(runEnd - col) * scale,
+                    scale,
+                    color
+                );
+
+                col = runEnd;
+            }
+        }
+
+        penX += static_cast<float>(g_glyphAdvance) * scale;
+    }
+
+    panelWidth_ = std::max(panelWidth_, penX - x - scale);
+    y += static_cast<float>(g_lineAdvance) * scale;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,496 @@
+/*
+ * PipelineManifest.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/PipelineManifest.h>
+#include <stdexcept>
+#include <chrono>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+static const std::uint32_t g_manifestMagic      = 0x4D50474C; // 'LGPM'
+static const std::uint32_t g_manifestVersion    = 1;
+
+template <typename T>
+static void WriteValue(std::vector<char>& data, const T& value)
+{
+    auto bytes = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+static bool ReadValue(const std::vector<char>& data, std::size_t& pos, T& value)
+{
+    if (pos + sizeof(T) > data.size())
+        return false;
+    std::memcpy(&value, &data[pos], sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+/*
+All members are written one by one with a fixed size (enumerations as 32-bit and booleans as 8-bit values),
+so the serialized state contains no padding bytes and can be compared byte by byte.
+*/
+
+static void WriteEnum(std::vector<char>& data, std::uint32_t value)
+{
+    WriteValue(data, value);
+}
+
+static void WriteBool(std::vector<char>& data, bool value)
+{
+    WriteValue(data, static_cast<std::uint8_t>(value ? 1 : 0));
+}
+
+template <typename T>
+static bool ReadEnum(const std::vector<char>& data, std::size_t& pos, T& value)
+{
+    std::uint32_t raw = 0;
+    if (!ReadValue(data, pos, raw))
+        return false;
+    value = static_cast<T>(raw);
+    return true;
+}
+
+static bool ReadBool(const std::vector<char>& data, std::size_t& pos, bool& value)
+{
+    std::uint8_t raw = 0;
+    if (!ReadValue(data, pos, raw))
+        return false;
+    value = (raw != 0);
+    return true;
+}
+
+static void WriteStencilFace(std::vector<char>& data, const StencilFaceDescriptor& desc)
+{
+    WriteEnum(data, static_cast<std::uint32_t>(desc.stencilFailOp));
+    WriteEnum(data, static_cast<std::uint32_t>(desc.depthFailOp));
+    WriteEnum(data, static_cast<std::uint32_t>(desc.depthPassOp));
+    WriteEnum(data, static_cast<std::uint32_t>(desc.compareOp));
+    WriteValue(data, desc.readMask);
+    WriteValue(data, desc.writeMask);
+    WriteValue(data, desc.reference);
+}
+
+static bool ReadStencilFace(const std::vector<char>& data, std::size_t& pos, StencilFaceDescriptor& desc)
+{
+    return
+    (
+        ReadEnum(data, pos, desc.stencilFailOp) &&
+        ReadEnum(data, pos, desc.depthFailOp)   &&
+        ReadEnum(data, pos, desc.depthPassOp)   &&
+        ReadEnum(data, pos, desc.compareOp)     &&
+        ReadValue(data, pos, desc.readMask)     &&
+        ReadValue(data, pos, desc.writeMask)    &&
+        ReadValue(data, pos, desc.reference)
+    );
+}
+
+// Serializes the pipeline state of the specified descriptor, except for the shader program.
+static std::vector<char> WritePipelineState(const GraphicsPipelineDescriptor& desc)
+{
+    std::vector<char> data;
+    data.reserve(128);
+
+    WriteEnum(data, static_cast<std::uint32_t>(desc.primitiveTopology));
+
+    /* Write depth and stencil state */
+    WriteBool(data, desc.depth.testEnabled);
+    WriteBool(data, desc.depth.writeEnabled);
+    WriteEnum(data, static_cast<std::uint32_t>(desc.depth.compareOp));
+    WriteBool(data, desc.depth.boundsTestEnabled);
+
+    WriteBool(data, desc.stencil.testEnabled);
+    WriteStencilFace(data, desc.stencil.front);
+    WriteStencilFace(data, desc.stencil.back);
+
+    /* Write rasterizer state */
+    const auto& rasterizer = desc.rasterizer;
+    WriteEnum(data, static_cast<std::uint32_t>(rasterizer.polygonMode));
+    WriteEnum(data, static_cast<std::uint32_t>(rasterizer.cullMode));
+    WriteValue(data, static_cast<std::int32_t>(rasterizer.depthBias));
+    WriteValue(data, rasterizer.depthBiasClamp);
+    WriteValue(data, rasterizer.slopeScaledDepthBias);
+    WriteBool(data, rasterizer.multiSampling.enabled);
+    WriteValue(data, static_cast<std::uint32_t>(rasterizer.multiSampling.samples));
+    WriteBool(data, rasterizer.frontCCW);
+    WriteBool(data, rasterizer.depthClampEnabled);
+    WriteBool(data, rasterizer.scissorTestEnabled);
+    WriteBool(data, rasterizer.antiAliasedLineEnabled);
+    WriteBool(data, rasterizer.conservativeRasterization);
+
+    /* Write blend state */
+    const auto& blend = desc.blend;
+    WriteBool(data, blend.blendEnabled);
+    WriteValue(data, blend.blendFactor.r);
+    WriteValue(data, blend.blendFactor.g);
+    WriteValue(data, blend.blendFactor.b);
+    WriteValue(data, blend.blendFactor.a);
+    WriteValue(data, static_cast<std::uint32_t>(blend.targets.size()));
+
+    for (const auto& target : blend.targets)
+    {
+        WriteEnum(data, static_cast<std::uint32_t>(target.srcColor));
+        WriteEnum(data, static_cast<std::uint32_t>(target.destColor));
+        WriteEnum(data, static_cast<std::uint32_t>(target.colorArithmetic));
+        WriteEnum(data, static_cast<std::uint32_t>(target.srcAlpha));
+        WriteEnum(data, static_cast<std::uint32_t>(target.destAlpha));
+        WriteEnum(data, static_cast<std::uint32_t>(target.alphaArithmetic));
+        WriteBool(data, target.colorMask.r);
+        WriteBool(data, target.colorMask.g);
+        WriteBool(data, target.colorMask.b);
+        WriteBool(data, target.colorMask.a);
+    }
+
+    /* Write remaining states */
+    WriteValue(data, static_cast<std::uint32_t>(desc.pushConstants.size));
+    WriteValue(data, static_cast<std::uint32_t>(desc.pushConstants.slot));
+    WriteValue(data, desc.viewMask);
+
+    return data;
+}
+
+// Deserializes the pipeline state, which has been serialized with "WritePipelineState". Returns false if the data is malformed.
+static bool ReadPipelineState(const std::vector<char>& data, GraphicsPipelineDescriptor& desc)
+{
+    std::size_t pos = 0;
+
+    if (!ReadEnum(data, pos, desc.primitiveTopology))
+        return false;
+
+    /* Read depth and stencil state */
+    if (!ReadBool(data, pos, desc.depth.testEnabled)         ||
+        !ReadBool(data, pos, desc.depth.writeEnabled)        ||
+        !ReadEnum(data, pos, desc.depth.compareOp)           ||
+        !ReadBool(data, pos, desc.depth.boundsTestEnabled)   ||
+        !ReadBool(data, pos, desc.stencil.testEnabled)       ||
+        !ReadStencilFace(data, pos, desc.stencil.front)      ||
+        !ReadStencilFace(data, pos, desc.stencil.back))
+    {
+        return false;
+    }
+
+    /* Read rasterizer state */
+    auto&           rasterizer  = desc.rasterizer;
+    std::int32_t    depthBias   = 0;
+    std::uint32_t   samples     = 0;
+
+    if (!ReadEnum(data, pos, rasterizer.polygonMode)                 ||
+        !ReadEnum(data, pos, rasterizer.cullMode)                    ||
+        !ReadValue(data, pos, depthBias)                             ||
+        !ReadValue(data, pos, rasterizer.depthBiasClamp)             ||
+        !ReadValue(data, pos, rasterizer.slopeScaledDepthBias)       ||
+        !ReadBool(data, pos, rasterizer.multiSampling.enabled)       ||
+        !ReadValue(data, pos, samples)                               ||
+        !ReadBool(data, pos, rasterizer.frontCCW)                    ||
+        !ReadBool(data, pos, rasterizer.depthClampEnabled)           ||
+        !ReadBool(data, pos, rasterizer.scissorTestEnabled)          ||
+        !ReadBool(data, pos, rasterizer.antiAliasedLineEnabled)      ||
+        !ReadBool(data, pos, rasterizer.conservativeRasterization))
+    {
+        return false;
+    }
+
+    rasterizer.depthBias                = static_cast<int>(depthBias);
+    rasterizer.multiSampling.samples    = static_cast<unsigned int>(samples);
+
+    /* Read blend state */
+    auto&           blend       = desc.blend;
+    std::uint32_t   numTargets  = 0;
+
+    if (!ReadBool(data, pos, blend.blendEnabled)     ||
+        !ReadValue(data, pos, blend.blendFactor.r)   ||
+        !ReadValue(data, pos, blend.blendFactor.g)   ||
+        !ReadValue(data, pos, blend.blendFactor.b)   ||
+        !ReadValue(data, pos, blend.blendFactor.a)   ||
+        !ReadValue(data, pos, numTargets)            ||
+        numTargets > (data.size() - pos))
+    {
+        return false;
+    }
+
+    blend.targets.resize(numTargets);
+
+    for (auto& target : blend.targets)
+    {
+        if (!ReadEnum(data, pos, target.srcColor)           ||
+            !ReadEnum(data, pos, target.destColor)          ||
+            !ReadEnum(data, pos, target.colorArithmetic)    ||
+            !ReadEnum(data, pos, target.srcAlpha)           ||
+            !ReadEnum(data, pos, target.destAlpha)          ||
+            !ReadEnum(data, pos, target.alphaArithmetic)    ||
+            !ReadBool(data, pos, target.colorMask.r)        ||
+            !ReadBool(data, pos, target.colorMask.g)        ||
+            !ReadBool(data, pos, target.colorMask.b)        ||
+            !ReadBool(data, pos, target.colorMask.a))
+        {
+            return false;
+        }
+    }
+
+    /* Read remaining states */
+    std::uint32_t pushConstantsSize = 0, pushConstantsSlot = 0;
+
+    if (!ReadValue(data, pos, pushConstantsSize) ||
+        !ReadValue(data, pos, pushConstantsSlot) ||
+        !ReadValue(data, pos, desc.viewMask))
+    {
+        return false;
+    }
+
+    desc.pushConstants.size = pushConstantsSize;
+    desc.pushConstants.slot = pushConstantsSlot;
+
+    return (pos == data.size());
+}
+
+// Returns the key of an entry, i.e. the program name (including its terminating null character) followed by the serialized pipeline state.
+static std::string MakeEntryKey(const std::string& programName, const std::vector<char>& state)
+{
+    std::string key = programName;
+    key += '\0';
+    key.append(state.begin(), state.end());
+    return key;
+}
+
+
+/* ----- PipelineManifest class ----- */
+
+PipelineManifest::PipelineManifest(RenderSystem& renderSystem) :
+    renderSystem_ { renderSystem }
+{
+}
+
+PipelineManifest::~PipelineManifest()
+{
+    Clear();
+}
+
+void PipelineManifest::AddShaderProgram(const std::string& name, ShaderProgram& shaderProgram)
+{
+    for (const auto& program : programs_)
+    {
+        if (program.first == name)
+            throw std::invalid_argument("shader program already added to pipeline manifest: '" + name + "'");
+        if (program.second == &shaderProgram)
+            throw std::invalid_argument("shader program already added to pipeline manifest as '" + program.first + "'");
+    }
+
+    programs_[name] = &shaderProgram;
+
+    /* Pre-create loaded pipelines that have been waiting for this shader program */
+    for (auto& entry : entries_)
+    {
+        if (entry.second.programName == name)
+            WarmUp(entry.second);
+    }
+}
+
+GraphicsPipeline* PipelineManifest::GetGraphicsPipeline(const GraphicsPipelineDescriptor& desc)
+{
+    /* Find name of shader program */
+    auto itProgram = programs_.begin();
+    for (; itProgram != programs_.end(); ++itProgram)
+    {
+        if (itProgram->second == desc.shaderProgram)
+            break;
+    }
+
+    if (itProgram == programs_.end())
+        throw std::invalid_argument("cannot get graphics pipeline with shader program that has not been added to pipeline manifest");
+
+    /* Find entry with equal pipeline state */
+    auto& entry = entries_[MakeEntryKey(itProgram->first, WritePipelineState(desc))];
+
+    ResolveEntry(entry);
+
+    if (entry.pipeline != nullptr)
+    {
+        ++stats_.numHits;
+        return entry.pipeline;
+    }
+
+    /* Create pipeline on first use */
+    if (entry.programName.empty())
+    {
+        entry.programName   = itProgram->first;
+        entry.state         = WritePipelineState(desc);
+    }
+
+    entry.pipeline = renderSystem_.CreateGraphicsPipeline(desc);
+    ++stats_.numCreated;
+
+    return entry.pipeline;
+}
+
+bool PipelineManifest::Load(const std::vector<char>& data)
+{
+    if (data.empty())
+        return true;
+
+    /* Read header */
+    std::size_t     pos         = 0;
+    std::uint32_t   magic       = 0;
+    std::uint32_t   version     = 0;
+    std::uint32_t   numEntries  = 0;
+
+    if (!ReadValue(data, pos, magic) || magic != g_manifestMagic)
+        return false;
+    if (!ReadValue(data, pos, version) || version != g_manifestVersion)
+        return false;
+    if (!ReadValue(data, pos, numEntries))
+        return false;
+
+    /* Read and validate all entries before any pipeline is created */
+    std::vector<Entry> loadedEntries;
+
+    for (std::uint32_t i = 0; i < numEntries; ++i)
+    {
+        std::uint32_t nameLen = 0, stateLen = 0;
+
+        if (!ReadValue(data, pos, nameLen) || pos + nameLen > data.size())
+            return false;
+
+        Entry entry;
+        entry.programName.assign(&data[pos], nameLen);
+        pos += nameLen;
+
+        if (!ReadValue(data, pos, stateLen) || pos + stateLen > data.size())
+            return false;
+
+        entry.state.assign(data.begin() + pos, data.begin() + pos + stateLen);
+        pos += stateLen;
+
+        GraphicsPipelineDescriptor desc;
+        if (entry.programName.empty() || !ReadPipelineState(entry.state, desc))
+            return false;
+
+        loadedEntries.push_back(std::move(entry));
+    }
+
+    /* Start pre-creation of all new entries whose shader programs are known */
+    for (auto& loadedEntry : loadedEntries)
+    {
+        auto& entry = entries_[MakeEntryKey(loadedEntry.programName, loadedEntry.state)];
+        if (entry.programName.empty())
+        {
+            entry = std::move(loadedEntry);
+            if (programs_.find(entry.programName) != programs_.end())
+                WarmUp(entry);
+        }
+    }
+
+    return true;
+}
+
+std::vector<char> PipelineManifest::Save() const
+{
+    std::vector<char> data;
+
+    WriteValue(data, g_manifestMagic);
+    WriteValue(data, g_manifestVersion);
+    WriteValue(data, static_cast<std::uint32_t>(entries_.size()));
+
+    for (const auto& it : entries_)
+    {
+        const auto& entry = it.second;
+        WriteValue(data, static_cast<std::uint32_t>(entry.programName.size()));
+        data.insert(data.end(), entry.programName.begin(), entry.programName.end());
+        WriteValue(data, static_cast<std::uint32_t>(entry.state.size()));
+        data.insert(data.end(), entry.state.begin(), entry.state.end());
+    }
+
+    return data;
+}
+
+std::size_t PipelineManifest::GetNumPendingPipelines() const
+{
+    std::size_t numPending = 0;
+
+    for (const auto& it : entries_)
+    {
+        const auto& pending = it.second.pending;
+        if (pending.valid() && pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            ++numPending;
+    }
+
+    return numPending;
+}
+
+void PipelineManifest::WaitForPendingPipelines()
+{
+    for (auto& it : entries_)
+    {
+        auto& pending = it.second.pending;
+        if (pending.valid())
+            pending.wait();
+    }
+}
+
+void PipelineManifest::Clear()
+{
+    for (auto& it : entries_)
+    {
+        auto& entry = it.second;
+        ResolveEntry(entry);
+        if (entry.pipeline)
+            renderSystem_.Release(*entry.pipeline);
+    }
+
+    entries_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void PipelineManifest::WarmUp(Entry& entry)
+{
+    if (entry.pipeline != nullptr || entry.pending.valid())
+        return;
+
+    GraphicsPipelineDescriptor desc;
+    ReadPipelineState(entry.state, desc);
+    desc.shaderProgram = programs_[entry.programName];
+
+    entry.pending = renderSystem_.CreateGraphicsPipelineAsync(desc);
+    ++stats_.numWarmedUp;
+}
+
+void PipelineManifest::ResolveEntry(Entry& entry)
+{
+    if (!entry.pending.valid())
+        return;
+
+    auto pending = std::move(entry.pending);
+    entry.pending = std::shared_future<GraphicsPipeline*>();
+
+    try
+    {
+        entry.pipeline = pending.get();
+    }
+    catch (const std::exception&)
+    {
+        /* Keep entry without pipeline, so it is created again on first use, which reports the error to the caller */
+        entry.pipeline = nullptr;
+        ++stats_.numFailed;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
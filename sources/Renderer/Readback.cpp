@@ -0,0 +1,29 @@
+/*
+ * Readback.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/Readback.h>
+
+
+namespace LLGL
+{
+
+
+Readback::Readback(std::size_t dataSize) :
+    dataSize_ { dataSize }
+{
+}
+
+Readback::~Readback()
+{
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
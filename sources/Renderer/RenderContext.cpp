@@ -9,16 +9,127 @@
 #include <LLGL/Window.h>
 #include <LLGL/Canvas.h>
 #include "CheckedCast.h"
+#include "../Core/Exception.h"
+#include <algorithm>
+#include <thread>
 
 
 namespace LLGL
 {
 
 
+/*
+ * HeadlessSurface class
+ */
+
+// Surface without a native handle, which only keeps track of the resolution of a headless render context.
+class HeadlessSurface : public Surface
+{
+
+    public:
+
+        HeadlessSurface(const Size& size) :
+            size_ { size }
+        {
+        }
+
+        void GetNativeHandle(void* nativeHandle) const override
+        {
+            /* Headless surfaces have no native handle */
+        }
+
+        void Recreate() override
+        {
+            /* Nothing to recreate */
+        }
+
+        Size GetContentSize() const override
+        {
+            return size_;
+        }
+
+        bool AdaptForVideoMode(VideoModeDescriptor& videoModeDesc) override
+        {
+            size_ = videoModeDesc.resolution;
+            return true;
+        }
+
+    private:
+
+        Size size_;
+
+};
+
+
+/*
+ * RenderContext class
+ */
+
 RenderContext::~RenderContext()
 {
 }
 
+/*
+Paces the frames to the target frame rate. The thread sleeps until shortly before the time slot of the next frame begins
+and yields for the remaining time, since the sleep granularity of some platforms is too coarse for an even frame delivery.
+*/
+void RenderContext::WaitForNextFrame()
+{
+    /* Throttle frames to the background frame rate while the content is not visible */
+    const auto frameRate = (backgroundFrameRate_ > 0 && IsOccluded() ? backgroundFrameRate_ : targetFrameRate_);
+    if (frameRate == 0)
+        return;
+
+    using Clock = std::chrono::steady_clock;
+
+    const auto now = Clock::now();
+
+    if (nextFrameTime_ > now)
+    {
+        const auto sleepMargin = std::chrono::milliseconds(2);
+        if (nextFrameTime_ - now > sleepMargin)
+            std::this_thread::sleep_until(nextFrameTime_ - sleepMargin);
+        while (Clock::now() < nextFrameTime_)
+            std::this_thread::yield();
+    }
+
+    /* Schedule the next frame, but do not try to catch up with frames that have been missed */
+    const auto frameDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRate));
+    nextFrameTime_ = std::max(nextFrameTime_, now) + frameDuration;
+}
+
+void RenderContext::PresentWithoutVsync()
+{
+    Present();
+}
+
+bool RenderContext::QueryFrameStatistics(FrameStatistics& stats)
+{
+    /* Dummy (no presentation statistics by default) */
+    return false;
+}
+
+bool RenderContext::IsOccluded() const
+{
+    return IsMinimized();
+}
+
+bool RenderContext::IsMinimized() const
+{
+    const auto size = GetSurface().GetContentSize();
+    return (size.x <= 0 || size.y <= 0);
+}
+
+bool RenderContext::TestPresent()
+{
+    return !IsOccluded();
+}
+
+void RenderContext::CopyBackBuffer(Texture& dstTexture)
+{
+    ThrowNotSupported("copying the back buffer of a render context");
+}
+
 void RenderContext::SetVideoMode(const VideoModeDescriptor& videoModeDesc)
 {
     if (videoModeDesc_ != videoModeDesc)
@@ -31,6 +142,17 @@ void RenderContext::SetVideoMode(const VideoModeDescriptor& videoModeDesc)
     }
 }
 
+void RenderContext::SetTargetFrameRate(unsigned int frameRate)
+{
+    targetFrameRate_    = frameRate;
+    nextFrameTime_      = std::chrono::steady_clock::time_point();
+}
+
+void RenderContext::SetBackgroundFrameRate(unsigned int frameRate)
+{
+    backgroundFrameRate_ = frameRate;
+}
+
 
 /*
  * ======= Protected: =======
@@ -74,6 +196,12 @@ void RenderContext::SetOrCreateSurface(const std::shared_ptr<Surface>& surface,
     videoModeDesc_ = videoModeDesc;
 }
 
+void RenderContext::SetHeadlessSurface(const VideoModeDescriptor& videoModeDesc)
+{
+    surface_        = std::make_shared<HeadlessSurface>(videoModeDesc.resolution);
+    videoModeDesc_  = videoModeDesc;
+}
+
 void RenderContext::ShareSurfaceAndVideoMode(RenderContext& other)
 {
     surface_        = other.surface_;
@@ -21,7 +21,8 @@ LLGL_EXPORT bool operator == (const VsyncDescriptor& lhs, const VsyncDescriptor&
     (
         LLGL_COMPARE_MEMBER_EQ( enabled     ) &&
         LLGL_COMPARE_MEMBER_EQ( refreshRate ) &&
-        LLGL_COMPARE_MEMBER_EQ( interval    )
+        LLGL_COMPARE_MEMBER_EQ( interval    ) &&
+        LLGL_COMPARE_MEMBER_EQ( adaptive    )
     );
 }
 
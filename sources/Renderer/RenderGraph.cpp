@@ -0,0 +1,726 @@
+/*
+ * RenderGraph.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderGraph.h>
+#include "../Core/ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+#include <exception>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/* ----- RenderGraphBuilder class ----- */
+
+RenderGraphBuilder::RenderGraphBuilder(RenderGraph& graph, std::uint32_t passIndex) :
+    graph_     { graph     },
+    passIndex_ { passIndex }
+{
+}
+
+RenderGraphResource RenderGraphBuilder::CreateTexture(const TransientTextureDescriptor& desc)
+{
+    if (desc.size.x == 0 || desc.size.y == 0)
+        throw std::invalid_argument("cannot create transient texture with zero size in render graph");
+
+    RenderGraph::Resource resource;
+    {
+        resource.type = RenderGraph::ResourceType::TransientTexture;
+        resource.desc = desc;
+    }
+    return graph_.AddResource(resource);
+}
+
+void RenderGraphBuilder::Read(RenderGraphResource resource, long barrierFlags)
+{
+    RenderGraph::Access access;
+    {
+        access.type         = RenderGraph::AccessType::Read;
+        access.barrierFlags = barrierFlags;
+    }
+    graph_.AddAccess(passIndex_, resource, access);
+}
+
+void RenderGraphBuilder::WriteStorage(RenderGraphResource resource)
+{
+    RenderGraph::Access access;
+    {
+        access.type = RenderGraph::AccessType::WriteStorage;
+    }
+    graph_.AddAccess(passIndex_, resource, access);
+}
+
+void RenderGraphBuilder::WriteRenderTarget(RenderGraphResource resource)
+{
+    RenderGraph::Access access;
+    {
+        access.type = RenderGraph::AccessType::WriteRenderTarget;
+    }
+    graph_.AddAccess(passIndex_, resource, access);
+}
+
+void RenderGraphBuilder::ClearRenderTarget(RenderGraphResource resource, const ColorRGBAf& color, float depth)
+{
+    RenderGraph::Access access;
+    {
+        access.type         = RenderGraph::AccessType::ClearRenderTarget;
+        access.clearColor   = color;
+        access.clearDepth   = depth;
+    }
+    graph_.AddAccess(passIndex_, resource, access);
+}
+
+void RenderGraphBuilder::SetSideEffects()
+{
+    graph_.passes_[passIndex_].sideEffects = true;
+}
+
+
+/* ----- RenderGraphResources class ----- */
+
+RenderGraphResources::RenderGraphResources(const RenderGraph& graph, std::uint32_t passIndex) :
+    graph_     { graph     },
+    passIndex_ { passIndex }
+{
+}
+
+Texture& RenderGraphResources::GetTexture(RenderGraphResource resource) const
+{
+    const auto& entry = graph_.GetResource(passIndex_, resource);
+    if (entry.type == RenderGraph::ResourceType::TransientTexture)
+        return *entry.transient.texture;
+    if (entry.type == RenderGraph::ResourceType::Texture)
+        return *entry.texture;
+    throw std::invalid_argument("render graph resource is not a texture");
+}
+
+Buffer& RenderGraphResources::GetBuffer(RenderGraphResource resource) const
+{
+    const auto& entry = graph_.GetResource(passIndex_, resource);
+    if (entry.type == RenderGraph::ResourceType::Buffer)
+        return *entry.buffer;
+    throw std::invalid_argument("render graph resource is not a buffer");
+}
+
+
+/* ----- RenderGraph class ----- */
+
+RenderGraph::RenderGraph(RenderSystem& renderSystem, TransientTexturePool& texturePool, bool asyncCompute, bool parallelRecording) :
+    renderSystem_      { renderSystem      },
+    texturePool_       { texturePool       },
+    asyncCompute_      { asyncCompute      },
+    parallelRecording_ { parallelRecording }
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+    for (auto commandBuffer : graphicsCommandBuffers_)
+        renderSystem_.Release(*commandBuffer);
+    for (auto commandBuffer : computeCommandBuffers_)
+        renderSystem_.Release(*commandBuffer);
+}
+
+RenderGraphResource RenderGraph::ImportTexture(Texture& texture)
+{
+    Resource resource;
+    {
+        resource.type       = ResourceType::Texture;
+        resource.texture    = &texture;
+    }
+    return AddResource(resource);
+}
+
+RenderGraphResource RenderGraph::ImportBuffer(Buffer& buffer)
+{
+    Resource resource;
+    {
+        resource.type   = ResourceType::Buffer;
+        resource.buffer = &buffer;
+    }
+    return AddResource(resource);
+}
+
+RenderGraphResource RenderGraph::ImportRenderTarget(RenderTarget& renderTarget)
+{
+    Resource resource;
+    {
+        resource.type           = ResourceType::RenderTarget;
+        resource.renderTarget   = &renderTarget;
+    }
+    return AddResource(resource);
+}
+
+RenderGraphResource RenderGraph::ImportRenderContext(RenderContext& renderContext)
+{
+    Resource resource;
+    {
+        resource.type           = ResourceType::RenderContext;
+        resource.renderContext  = &renderContext;
+    }
+    return AddResource(resource);
+}
+
+void RenderGraph::AddPass(const std::string& name, const RenderGraphPassType type, const SetupFunction& setup, const ExecuteFunction& execute)
+{
+    Pass pass;
+    {
+        pass.name       = name;
+        pass.type       = type;
+        pass.execute    = execute;
+    }
+    passes_.push_back(std::move(pass));
+
+    /* Declare resource accesses of the new pass */
+    if (setup)
+    {
+        RenderGraphBuilder builder { *this, static_cast<std::uint32_t>(passes_.size() - 1) };
+        setup(builder);
+    }
+}
+
+void RenderGraph::Execute()
+{
+    CullPasses();
+    SchedulePasses();
+    if (parallelRecording_)
+        SplitSegments();
+    AllocateTransientTextures();
+    ResolveBarriers();
+
+    /* Fetch a deferred command buffer for each segment before the recording starts */
+    std::vector<CommandBuffer*> commandBuffers;
+    commandBuffers.reserve(segments_.size());
+
+    std::size_t numGraphicsSegments = 0, numComputeSegments = 0;
+    for (const auto& segment : segments_)
+        commandBuffers.push_back(&GetCommandBuffer(segment.async, (segment.async ? numComputeSegments++ : numGraphicsSegments++)));
+
+    try
+    {
+        RecordSegments(commandBuffers);
+    }
+    catch (...)
+    {
+        /* Discard the entire frame, since the command buffers are incomplete */
+        resources_.clear();
+        passes_.clear();
+        segments_.clear();
+        throw;
+    }
+
+    /* Submit all segments in their scheduled order */
+    if (!commandBuffers.empty())
+        renderSystem_.ExecuteCommandBuffers(static_cast<unsigned int>(commandBuffers.size()), commandBuffers.data());
+
+    /* Start declaring the next frame */
+    resources_.clear();
+    passes_.clear();
+    segments_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+RenderGraphResource RenderGraph::AddResource(const Resource& resource)
+{
+    resources_.push_back(resource);
+    RenderGraphResource handle;
+    handle.id = static_cast<std::uint32_t>(resources_.size() - 1);
+    return handle;
+}
+
+void RenderGraph::AddAccess(std::uint32_t passIndex, RenderGraphResource resource, const Access& access)
+{
+    if (resource.id >= resources_.size())
+        throw std::invalid_argument("invalid resource handle in render graph pass");
+
+    auto& pass = passes_[passIndex];
+    const auto type = resources_[resource.id].type;
+
+    if (access.type == AccessType::WriteStorage)
+    {
+        if (type == ResourceType::RenderTarget || type == ResourceType::RenderContext)
+            throw std::invalid_argument("cannot write render target or render context as storage resource in render graph pass");
+    }
+    else if (access.type == AccessType::WriteRenderTarget || access.type == AccessType::ClearRenderTarget)
+    {
+        if (pass.type != RenderGraphPassType::Graphics)
+            throw std::invalid_argument("cannot write render target in compute pass of render graph");
+        if (type == ResourceType::Texture || type == ResourceType::Buffer)
+            throw std::invalid_argument("cannot write imported texture or buffer as render target in render graph pass");
+
+        for (const auto& other : pass.accesses)
+        {
+            if (other.type == AccessType::WriteRenderTarget || other.type == AccessType::ClearRenderTarget)
+                throw std::invalid_argument("cannot write more than one render target in render graph pass");
+        }
+    }
+
+    pass.accesses.push_back(access);
+    pass.accesses.back().resource = resource.id;
+}
+
+const RenderGraph::Resource& RenderGraph::GetResource(std::uint32_t passIndex, RenderGraphResource resource) const
+{
+    for (const auto& access : passes_[passIndex].accesses)
+    {
+        if (access.resource == resource.id)
+            return resources_[resource.id];
+    }
+    throw std::invalid_argument("render graph resource has not been declared by the current pass");
+}
+
+void RenderGraph::CullPasses()
+{
+    /* Walk the passes backwards, and keep a pass if it has side effects or writes any resource whose contents are needed later */
+    std::vector<bool> needed(resources_.size(), false);
+    numCulledPasses_ = 0;
+
+    for (auto it = passes_.rbegin(); it != passes_.rend(); ++it)
+    {
+        auto& pass = *it;
+        bool alive = pass.sideEffects;
+
+        for (const auto& access : pass.accesses)
+        {
+            if (access.type != AccessType::Read)
+            {
+                if (needed[access.resource] || IsImported(resources_[access.resource]))
+                    alive = true;
+            }
+        }
+
+        pass.culled = !alive;
+        if (pass.culled)
+        {
+            ++numCulledPasses_;
+            continue;
+        }
+
+        /* All resources this pass reads, or partially overwrites, need the contents of the previous passes */
+        for (const auto& access : pass.accesses)
+        {
+            if (access.type == AccessType::ClearRenderTarget)
+                needed[access.resource] = false;
+        }
+        for (const auto& access : pass.accesses)
+        {
+            if (access.type != AccessType::ClearRenderTarget)
+                needed[access.resource] = true;
+        }
+    }
+}
+
+void RenderGraph::SchedulePasses()
+{
+    /* Determine which graphics passes access and write each resource, in declaration order */
+    std::vector<bool> accessedByGraphics(resources_.size(), false);
+    std::vector<bool> writtenByGraphics(resources_.size(), false);
+
+    /* Resources which are accessed by the compute passes that have not been submitted yet */
+    std::vector<bool> accessedByPending(resources_.size(), false);
+
+    Segment graphicsSegment, computeSegment;
+    numAsyncComputePasses_ = 0;
+
+    auto FlushSegments = [&]()
+    {
+        if (!graphicsSegment.passes.empty())
+            segments_.push_back(std::move(graphicsSegment));
+        if (!computeSegment.passes.empty())
+            segments_.push_back(std::move(computeSegment));
+
+        graphicsSegment = Segment{};
+        computeSegment  = Segment{};
+        computeSegment.async = true;
+
+        std::fill(accessedByPending.begin(), accessedByPending.end(), false);
+    };
+
+    computeSegment.async = true;
+
+    for (std::uint32_t passIndex = 0; passIndex < passes_.size(); ++passIndex)
+    {
+        auto& pass = passes_[passIndex];
+        if (pass.culled)
+            continue;
+
+        /*
+        Compute passes are independent if they neither read results of preceding graphics passes,
+        nor write resources that preceding graphics passes access, since the compute queue does not wait for the graphics queue
+        */
+        pass.async = (asyncCompute_ && pass.type == RenderGraphPassType::Compute);
+        for (const auto& access : pass.accesses)
+        {
+            if (!pass.async)
+                break;
+            if (writtenByGraphics[access.resource] || (access.type != AccessType::Read && accessedByGraphics[access.resource]))
+                pass.async = false;
+        }
+
+        if (pass.async)
+        {
+            /* Defer compute pass until the first graphics pass that depends on it */
+            computeSegment.passes.push_back(passIndex);
+            for (const auto& access : pass.accesses)
+            {
+                accessedByPending[access.resource]          = true;
+                resources_[access.resource].asyncAccess     = true;
+            }
+            ++numAsyncComputePasses_;
+        }
+        else
+        {
+            /* Submit the pending compute passes before this pass, if it accesses any of their resources */
+            for (const auto& access : pass.accesses)
+            {
+                if (accessedByPending[access.resource])
+                {
+                    FlushSegments();
+                    break;
+                }
+            }
+
+            graphicsSegment.passes.push_back(passIndex);
+            for (const auto& access : pass.accesses)
+            {
+                accessedByGraphics[access.resource] = true;
+                if (access.type != AccessType::Read)
+                    writtenByGraphics[access.resource] = true;
+            }
+        }
+    }
+
+    FlushSegments();
+}
+
+void RenderGraph::SplitSegments()
+{
+    /* Give each pass its own segment, so all passes can be recorded concurrently */
+    std::vector<Segment> segments;
+
+    for (const auto& segment : segments_)
+    {
+        for (auto passIndex : segment.passes)
+        {
+            Segment passSegment;
+            {
+                passSegment.async   = segment.async;
+                passSegment.passes  = { passIndex };
+            }
+            segments.push_back(std::move(passSegment));
+        }
+    }
+
+    segments_ = std::move(segments);
+}
+
+void RenderGraph::AllocateTransientTextures()
+{
+    /* Determine lifetime of each transient texture in submission order */
+    std::size_t submissionIndex = 0;
+
+    for (const auto& segment : segments_)
+    {
+        for (auto passIndex : segment.passes)
+        {
+            for (const auto& access : passes_[passIndex].accesses)
+            {
+                auto& resource = resources_[access.resource];
+                if (!resource.used)
+                {
+                    resource.firstUse   = submissionIndex;
+                    resource.used       = true;
+                }
+                resource.lastUse = submissionIndex;
+            }
+            ++submissionIndex;
+        }
+    }
+
+    /* Textures of async compute passes overlap with graphics passes on the GPU, so they are allocated for the entire frame */
+    std::vector<std::uint32_t> asyncTextures;
+
+    for (std::uint32_t i = 0; i < resources_.size(); ++i)
+    {
+        auto& resource = resources_[i];
+        if (resource.type == ResourceType::TransientTexture && resource.used && resource.asyncAccess)
+        {
+            resource.transient = texturePool_.Acquire(resource.desc);
+            asyncTextures.push_back(i);
+        }
+    }
+
+    /*
+    Acquire all other textures at their first use and release them after their last use, so subsequent passes can alias them.
+    The released targets remain assigned to their resources, because the passes are recorded after all textures have been allocated.
+    */
+    submissionIndex = 0;
+
+    for (const auto& segment : segments_)
+    {
+        for (auto passIndex : segment.passes)
+        {
+            const auto& accesses = passes_[passIndex].accesses;
+
+            for (const auto& access : accesses)
+            {
+                auto& resource = resources_[access.resource];
+                if (resource.type == ResourceType::TransientTexture && !resource.asyncAccess && resource.firstUse == submissionIndex && resource.transient.texture == nullptr)
+                    resource.transient = texturePool_.Acquire(resource.desc);
+            }
+
+            for (const auto& access : accesses)
+            {
+                auto& resource = resources_[access.resource];
+                if (resource.type == ResourceType::TransientTexture && !resource.asyncAccess && resource.lastUse == submissionIndex && resource.used)
+                {
+                    texturePool_.Release(resource.transient);
+                    resource.used = false;
+                }
+            }
+
+            ++submissionIndex;
+        }
+    }
+
+    for (auto i : asyncTextures)
+        texturePool_.Release(resources_[i].transient);
+}
+
+void RenderGraph::ResolveBarriers()
+{
+    /* Resources which have been written as storage resource since their last barrier */
+    std::vector<bool> storageWritten(resources_.size(), false);
+
+    for (const auto& segment : segments_)
+    {
+        for (auto passIndex : segment.passes)
+        {
+            auto& pass = passes_[passIndex];
+
+            /* Merge the barriers for all resources which have been written as storage resource before */
+            for (const auto& access : pass.accesses)
+            {
+                if (storageWritten[access.resource])
+                {
+                    if (access.type == AccessType::Read)
+                        pass.barrierFlags |= access.barrierFlags;
+                    else if (access.type == AccessType::WriteStorage)
+                        pass.barrierFlags |= (resources_[access.resource].type == ResourceType::Buffer ? BarrierFlags::StorageBuffer : BarrierFlags::Texture);
+                    else
+                        pass.barrierFlags |= BarrierFlags::Texture;
+                    storageWritten[access.resource] = false;
+                }
+            }
+
+            for (const auto& access : pass.accesses)
+            {
+                if (access.type == AccessType::WriteStorage)
+                    storageWritten[access.resource] = true;
+            }
+        }
+    }
+}
+
+void RenderGraph::RecordSegments(const std::vector<CommandBuffer*>& commandBuffers)
+{
+    std::exception_ptr  exception;
+    std::mutex          exceptionMutex;
+
+    auto RecordSegmentRange = [&](std::size_t begin, std::size_t end)
+    {
+        for (auto i = begin; i < end; ++i)
+        {
+            try
+            {
+                auto& commands = *commandBuffers[i];
+                commands.Reset();
+                for (auto passIndex : segments_[i].passes)
+                    RecordPass(commands, passIndex);
+            }
+            catch (...)
+            {
+                /* Keep the first exception to rethrow it on the calling thread */
+                std::lock_guard<std::mutex> guard { exceptionMutex };
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+    };
+
+    /* Record on the worker threads of the shared thread pool, which is owned by the render system */
+    auto threadPool = GetSharedThreadPool();
+    if (parallelRecording_ && threadPool != nullptr)
+        threadPool->ParallelFor(segments_.size(), 1, threadPool->GetThreadCount() + 1, RecordSegmentRange);
+    else
+        RecordSegmentRange(0, segments_.size());
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+void RenderGraph::RecordPass(CommandBuffer& commands, std::uint32_t passIndex)
+{
+    const auto& pass = passes_[passIndex];
+
+    if (pass.barrierFlags != 0)
+        commands.Barrier(pass.barrierFlags);
+
+    /* Record commands of this pass within its render pass */
+    const Access* renderTargetAccess = nullptr;
+    for (const auto& access : pass.accesses)
+    {
+        if (access.type == AccessType::WriteRenderTarget || access.type == AccessType::ClearRenderTarget)
+            renderTargetAccess = &access;
+    }
+
+    if (renderTargetAccess != nullptr)
+        RecordBeginRenderPass(commands, passIndex, *renderTargetAccess);
+
+    if (pass.execute)
+    {
+        RenderGraphResources resources { *this, passIndex };
+        pass.execute(commands, resources);
+    }
+
+    if (renderTargetAccess != nullptr)
+        commands.EndRenderPass();
+}
+
+void RenderGraph::RecordBeginRenderPass(CommandBuffer& commands, std::uint32_t passIndex, const Access& access)
+{
+    const auto& resource = resources_[access.resource];
+
+    /* Select load operation: clear, load previous contents, or ignore undefined contents */
+    RenderPassAttachmentDescriptor attachmentDesc;
+
+    if (access.type == AccessType::ClearRenderTarget)
+    {
+        attachmentDesc.loadOp = AttachmentLoadOp::Clear;
+        commands.SetClearColor(access.clearColor);
+        commands.SetClearDepth(access.clearDepth);
+    }
+    else if (HasContentsBefore(passIndex, access.resource))
+        attachmentDesc.loadOp = AttachmentLoadOp::Load;
+    else
+        attachmentDesc.loadOp = AttachmentLoadOp::DontCare;
+
+    /* Select store operation: discard contents if no other pass accesses them afterwards */
+    if (IsImported(resource) || IsAccessedAfter(passIndex, access.resource))
+        attachmentDesc.storeOp = AttachmentStoreOp::Store;
+    else
+        attachmentDesc.storeOp = AttachmentStoreOp::Discard;
+
+    RenderPassDescriptor renderPassDesc;
+
+    switch (resource.type)
+    {
+        case ResourceType::TransientTexture:
+        {
+            if (IsDepthStencilFormat(resource.desc.format))
+            {
+                renderPassDesc.depthAttachment      = attachmentDesc;
+                renderPassDesc.stencilAttachment    = attachmentDesc;
+            }
+            else
+                renderPassDesc.colorAttachments = { attachmentDesc };
+            commands.BeginRenderPass(*resource.transient.renderTarget, renderPassDesc);
+        }
+        break;
+
+        case ResourceType::RenderTarget:
+        {
+            renderPassDesc.colorAttachments     = { attachmentDesc };
+            renderPassDesc.depthAttachment      = attachmentDesc;
+            renderPassDesc.stencilAttachment    = attachmentDesc;
+            commands.BeginRenderPass(*resource.renderTarget, renderPassDesc);
+        }
+        break;
+
+        case ResourceType::RenderContext:
+        {
+            renderPassDesc.colorAttachments     = { attachmentDesc };
+            renderPassDesc.depthAttachment      = attachmentDesc;
+            renderPassDesc.stencilAttachment    = attachmentDesc;
+            commands.BeginRenderPass(*resource.renderContext, renderPassDesc);
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+bool RenderGraph::IsImported(const Resource& resource) const
+{
+    return (resource.type != ResourceType::TransientTexture);
+}
+
+bool RenderGraph::HasContentsBefore(std::uint32_t passIndex, std::uint32_t resource) const
+{
+    /* Imported resources always have their previous contents */
+    if (IsImported(resources_[resource]))
+        return true;
+
+    for (std::uint32_t i = 0; i < passIndex; ++i)
+    {
+        if (passes_[i].culled)
+            continue;
+        for (const auto& access : passes_[i].accesses)
+        {
+            if (access.resource == resource && access.type != AccessType::Read)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+bool RenderGraph::IsAccessedAfter(std::uint32_t passIndex, std::uint32_t resource) const
+{
+    for (auto i = passIndex + 1; i < passes_.size(); ++i)
+    {
+        if (passes_[i].culled)
+            continue;
+        for (const auto& access : passes_[i].accesses)
+        {
+            if (access.resource == resource)
+                return true;
+        }
+    }
+    return false;
+}
+
+CommandBuffer& RenderGraph::GetCommandBuffer(bool async, std::size_t index)
+{
+    auto& commandBuffers = (async ? computeCommandBuffers_ : graphicsCommandBuffers_);
+
+    /* Create command buffers on demand, and keep them for the subsequent frames */
+    while (commandBuffers.size() <= index)
+    {
+        long flags = CommandBufferFlags::DeferredSubmit;
+        if (async)
+            flags |= CommandBufferFlags::AsyncCompute;
+        commandBuffers.push_back(renderSystem_.CreateCommandBuffer(CommandBufferDescriptor(flags)));
+    }
+
+    return *commandBuffers[index];
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
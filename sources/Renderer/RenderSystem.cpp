@@ -7,13 +7,18 @@
 
 #include "../Platform/Module.h"
 #include "../Core/Helper.h"
+#include "../Core/ThreadPool.h"
 #include <LLGL/Platform/Platform.h>
-#include <LLGL/Log.h>
+#include "../Core/HelperMacros.h"
 #include "BuildID.h"
 
 #include <LLGL/RenderSystem.h>
 #include <array>
 #include <map>
+#include <algorithm>
+#include <cstring>
+
+#include "CaptureLayer/CapRenderSystem.h"
 
 #ifdef LLGL_ENABLE_DEBUG_LAYER
 #   include "DebugLayer/DbgRenderSystem.h"
@@ -32,11 +37,24 @@ namespace LLGL
 
 static std::map<RenderSystem*, std::unique_ptr<Module>> g_renderSystemModules;
 
+#ifndef LLGL_BUILD_STATIC_LIB
+
+// Modules that have been preloaded with "RenderSystem::PreloadModule" and whose build ID has already been verified.
+static std::map<std::string, std::unique_ptr<Module>> g_preloadedModules;
+
+#endif
+
+RenderSystem::RenderSystem()
+{
+    AcquireSharedThreadPool();
+}
+
 RenderSystem::~RenderSystem()
 {
+    ReleaseSharedThreadPool();
 }
 
-std::vector<std::string> RenderSystem::FindModules()
+static std::vector<std::string> QueryAvailableModules()
 {
     /* Iterate over all known modules and return those that are available on the current platform */
     const std::vector<std::string> knownModules
@@ -70,6 +88,13 @@ std::vector<std::string> RenderSystem::FindModules()
     return modules;
 }
 
+std::vector<std::string> RenderSystem::FindModules()
+{
+    /* Query available modules only once, since probing the module files is not free */
+    static const std::vector<std::string> modules = QueryAvailableModules();
+    return modules;
+}
+
 #ifndef LLGL_BUILD_STATIC_LIB
 
 static bool LoadRenderSystemBuildID(Module& module, const std::string& moduleFilename)
@@ -108,23 +133,36 @@ static std::string LoadRenderSystemName(Module& module)
     return "";
 }
 
-static RenderSystem* LoadRenderSystem(Module& module, const std::string& moduleFilename)
+static RenderSystem* LoadRenderSystem(Module& module, const std::string& moduleFilename, const RenderSystemDescriptor& renderSystemDesc)
 {
     /* Load "LLGL_RenderSystem_Alloc" procedure */
-    LLGL_PROC_INTERFACE(void*, PFN_RENDERSYSTEM_ALLOC, (void));
+    LLGL_PROC_INTERFACE(void*, PFN_RENDERSYSTEM_ALLOC, (const RenderSystemDescriptor*));
 
     auto RenderSystem_Alloc = reinterpret_cast<PFN_RENDERSYSTEM_ALLOC>(module.LoadProcedure("LLGL_RenderSystem_Alloc"));
     if (!RenderSystem_Alloc)
         throw std::runtime_error("failed to load \"LLGL_RenderSystem_Alloc\" procedure from module \"" + moduleFilename + "\"");
 
-    return reinterpret_cast<RenderSystem*>(RenderSystem_Alloc());
+    return reinterpret_cast<RenderSystem*>(RenderSystem_Alloc(&renderSystemDesc));
 }
 
 #endif
 
 std::unique_ptr<RenderSystem> RenderSystem::Load(
-    const std::string& moduleName, RenderingProfiler* profiler, RenderingDebugger* debugger)
+    const std::string& moduleName, RenderingProfiler* profiler, RenderingDebugger* debugger, RenderingTracer* tracer, RenderingCapture* capture)
 {
+    return Load(RenderSystemDescriptor(moduleName), profiler, debugger, tracer, capture);
+}
+
+std::unique_ptr<RenderSystem> RenderSystem::Load(
+    const RenderSystemDescriptor& renderSystemDesc, RenderingProfiler* profiler, RenderingDebugger* debugger, RenderingTracer* tracer, RenderingCapture* capture)
+{
+    #if defined LLGL_ENABLE_DEBUG_LAYER && LLGL_DBG_VALIDATION_LEVEL == LLGL_DBG_VALIDATION_OFF
+
+    /* Validation is disabled at compile time, so the debug layer is only required for profiling and tracing */
+    debugger = nullptr;
+
+    #endif
+
     #ifdef LLGL_BUILD_STATIC_LIB
 
     /*
@@ -135,18 +173,22 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
         throw std::runtime_error("build ID mismatch in render system module");
 
     /* Allocate render system */
-    auto renderSystem   = std::unique_ptr<RenderSystem>(reinterpret_cast<RenderSystem*>(LLGL_RenderSystem_Alloc()));
+    auto renderSystem   = std::unique_ptr<RenderSystem>(reinterpret_cast<RenderSystem*>(LLGL_RenderSystem_Alloc(&renderSystemDesc)));
 
-    if (profiler != nullptr || debugger != nullptr)
+    /* Create capture layer render system beneath the debug layer, so only valid calls are captured */
+    if (capture != nullptr)
+        renderSystem = MakeUnique<CapRenderSystem>(std::move(renderSystem), *capture);
+
+    if (profiler != nullptr || debugger != nullptr || tracer != nullptr)
     {
         #ifdef LLGL_ENABLE_DEBUG_LAYER
 
         /* Create debug layer render system */
-        renderSystem = MakeUnique<DbgRenderSystem>(std::move(renderSystem), profiler, debugger);
+        renderSystem = MakeUnique<DbgRenderSystem>(std::move(renderSystem), profiler, debugger, tracer);
 
         #else
 
-        Log::StdErr() << "LLGL was not compiled with debug layer support" << std::endl;
+        LLGL_LOG(Warning, "LLGL was not compiled with debug layer support");
 
         #endif
     }
@@ -159,40 +201,56 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
 
     #else
 
-    /* Load render system module */
+    const auto& moduleName = renderSystemDesc.moduleName;
     auto moduleFilename = Module::GetModuleFilename(moduleName);
-    auto module         = Module::Load(moduleFilename);
 
-    /*
-    Verify build ID from render system module to detect a module,
-    that has compiled with a different compiler (type, version, debug/release mode etc.)
-    */
-    if (!LoadRenderSystemBuildID(*module, moduleFilename))
-        throw std::runtime_error("build ID mismatch in render system module");
+    /* Use preloaded module if there is one, otherwise load render system module */
+    std::unique_ptr<Module> module;
+    Module* moduleRef = nullptr;
+
+    auto preloaded = g_preloadedModules.find(moduleName);
+    if (preloaded != g_preloadedModules.end())
+        moduleRef = preloaded->second.get();
+    else
+    {
+        module      = Module::Load(moduleFilename);
+        moduleRef   = module.get();
+
+        /*
+        Verify build ID from render system module to detect a module,
+        that has compiled with a different compiler (type, version, debug/release mode etc.)
+        */
+        if (!LoadRenderSystemBuildID(*module, moduleFilename))
+            throw std::runtime_error("build ID mismatch in render system module");
+    }
 
     try
     {
         /* Allocate render system */
-        auto renderSystem   = std::unique_ptr<RenderSystem>(LoadRenderSystem(*module, moduleFilename));
+        auto renderSystem   = std::unique_ptr<RenderSystem>(LoadRenderSystem(*moduleRef, moduleFilename, renderSystemDesc));
 
-        if (profiler != nullptr || debugger != nullptr)
+        /* Create capture layer render system beneath the debug layer, so only valid calls are captured */
+        if (capture != nullptr)
+            renderSystem = MakeUnique<CapRenderSystem>(std::move(renderSystem), *capture);
+
+        if (profiler != nullptr || debugger != nullptr || tracer != nullptr)
         {
             #ifdef LLGL_ENABLE_DEBUG_LAYER
 
             /* Create debug layer render system */
-            renderSystem = MakeUnique<DbgRenderSystem>(std::move(renderSystem), profiler, debugger);
+            renderSystem = MakeUnique<DbgRenderSystem>(std::move(renderSystem), profiler, debugger, tracer);
 
             #else
 
-            Log::StdErr() << "LLGL was not compiled with debug layer support" << std::endl;
+            LLGL_LOG(Warning, "LLGL was not compiled with debug layer support");
 
             #endif
         }
 
-        renderSystem->name_         = LoadRenderSystemName(*module);
-        renderSystem->rendererID_   = LoadRenderSystemRendererID(*module);
+        renderSystem->name_         = LoadRenderSystemName(*moduleRef);
+        renderSystem->rendererID_   = LoadRenderSystemRendererID(*moduleRef);
 
-        /* Store new module inside internal map */
+        /* Store new module inside internal map (preloaded modules remain owned by their own map) */
         g_renderSystemModules[renderSystem.get()] = std::move(module);
 
         /* Return new render system and unique pointer */
@@ -201,13 +259,50 @@ std::unique_ptr<RenderSystem> RenderSystem::Load(
     catch (const std::exception&)
     {
         /* Keep module, otherwise the exception 's vtable might be corrupted because it's part of the module */
-        g_renderSystemModules[nullptr] = std::move(module);
+        if (module)
+            g_renderSystemModules[nullptr] = std::move(module);
         throw;
     }
 
     #endif
 }
 
+bool RenderSystem::PreloadModule(const std::string& moduleName)
+{
+    #ifdef LLGL_BUILD_STATIC_LIB
+
+    /* The only render system is linked statically, which is also what "Load" returns regardless of the module name */
+    return true;
+
+    #else
+
+    /* Check if module has already been preloaded */
+    if (g_preloadedModules.find(moduleName) != g_preloadedModules.end())
+        return true;
+
+    /* Load render system module and verify its build ID */
+    auto moduleFilename = Module::GetModuleFilename(moduleName);
+
+    std::unique_ptr<Module> module;
+    try
+    {
+        module = Module::Load(moduleFilename);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+
+    if (!LoadRenderSystemBuildID(*module, moduleFilename))
+        return false;
+
+    g_preloadedModules[moduleName] = std::move(module);
+
+    return true;
+
+    #endif
+}
+
 void RenderSystem::Unload(std::unique_ptr<RenderSystem>&& renderSystem)
 {
     auto it = g_renderSystemModules.find(renderSystem.get());
@@ -215,6 +310,10 @@ void RenderSystem::Unload(std::unique_ptr<RenderSystem>&& renderSystem)
     {
         renderSystem.release();
         g_renderSystemModules.erase(it);
+
+        /* Stop logger thread with the last render system, rather than joining it during static destruction */
+        if (g_renderSystemModules.empty() || (g_renderSystemModules.size() == 1 && g_renderSystemModules.begin()->first == nullptr))
+            Log::Shutdown();
     }
 }
 
@@ -223,6 +322,196 @@ void RenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
     config_ = config;
 }
 
+void RenderSystem::PresentAll(unsigned int numRenderContexts, RenderContext* const * renderContextArray)
+{
+    /* Only the first render context waits for the vertical blank, all others are presented immediately afterwards */
+    for (unsigned int i = 0; i < numRenderContexts; ++i)
+    {
+        if (i == 0)
+            renderContextArray[i]->Present();
+        else
+            renderContextArray[i]->PresentWithoutVsync();
+    }
+}
+
+void* RenderSystem::MapBufferRange(Buffer& buffer, std::size_t offset, std::size_t size, const BufferCPUAccess access, long mapFlags)
+{
+    /* Map entire buffer by default, where the mapping flags can only be translated into whole-buffer access */
+    auto mappedAccess = access;
+    if ((mapFlags & BufferMapFlags::DiscardBuffer) != 0)
+        mappedAccess = BufferCPUAccess::WriteDiscard;
+    else if ((mapFlags & BufferMapFlags::Unsynchronized) != 0)
+        mappedAccess = BufferCPUAccess::WriteNoOverwrite;
+
+    if (auto data = MapBuffer(buffer, mappedAccess))
+        return (reinterpret_cast<char*>(data) + offset);
+    else
+        return nullptr;
+}
+
+void RenderSystem::FlushMappedBufferRange(Buffer& /*buffer*/, std::size_t /*offset*/, std::size_t /*size*/)
+{
+    // dummy
+}
+
+std::shared_future<Buffer*> RenderSystem::CreateBufferAsync(const BufferDescriptor& desc, const void* initialData)
+{
+    /* Create buffer immediately by default */
+    std::promise<Buffer*> result;
+    result.set_value(CreateBuffer(desc, initialData));
+    return result.get_future().share();
+}
+
+std::vector<Buffer*> RenderSystem::CreateBuffers(unsigned int numBuffers, const BufferDescriptor* descArray, const void* const * initialDataArray)
+{
+    /* Create buffers one by one by default */
+    std::vector<Buffer*> buffers;
+    buffers.reserve(numBuffers);
+
+    for (unsigned int i = 0; i < numBuffers; ++i)
+        buffers.push_back(CreateBuffer(descArray[i], (initialDataArray != nullptr ? initialDataArray[i] : nullptr)));
+
+    return buffers;
+}
+
+std::shared_future<Texture*> RenderSystem::CreateTextureAsync(const TextureDescriptor& textureDesc, const ImageDescriptor* imageDesc)
+{
+    /* Create texture immediately by default */
+    std::promise<Texture*> result;
+    result.set_value(CreateTexture(textureDesc, imageDesc));
+    return result.get_future().share();
+}
+
+std::vector<Texture*> RenderSystem::CreateTextures(unsigned int numTextures, const TextureDescriptor* textureDescArray, const ImageDescriptor* const * imageDescArray)
+{
+    /* Create textures one by one by default */
+    std::vector<Texture*> textures;
+    textures.reserve(numTextures);
+
+    for (unsigned int i = 0; i < numTextures; ++i)
+        textures.push_back(CreateTexture(textureDescArray[i], (imageDescArray != nullptr ? imageDescArray[i] : nullptr)));
+
+    return textures;
+}
+
+std::shared_future<GraphicsPipeline*> RenderSystem::CreateGraphicsPipelineAsync(const GraphicsPipelineDescriptor& desc)
+{
+    /* Create graphics pipeline immediately by default */
+    std::promise<GraphicsPipeline*> result;
+    result.set_value(CreateGraphicsPipeline(desc));
+    return result.get_future().share();
+}
+
+bool RenderSystem::SetResidency(Buffer& /*buffer*/, bool /*resident*/)
+{
+    return false; // dummy
+}
+
+bool RenderSystem::SetResidency(Texture& /*texture*/, bool /*resident*/)
+{
+    return false; // dummy
+}
+
+bool RenderSystem::QueryClockCalibration(ClockCalibration& /*calibration*/)
+{
+    return false; // dummy
+}
+
+bool RenderSystem::ReportStateCacheStatistics(RenderingProfiler& /*profiler*/)
+{
+    return false; // dummy
+}
+
+bool RenderSystem::LoadPipelineCache(const std::vector<char>& /*data*/)
+{
+    return false; // dummy
+}
+
+std::vector<char> RenderSystem::SavePipelineCache()
+{
+    return {}; // dummy
+}
+
+/* ----- Readbacks ----- */
+
+// Default readback implementation, which stores the data immediately in CPU memory
+class ImmediateReadback : public Readback
+{
+
+    public:
+
+        ImmediateReadback(std::size_t dataSize) :
+            Readback { dataSize },
+            data_    ( dataSize )
+        {
+        }
+
+        bool IsReady() override
+        {
+            return true;
+        }
+
+        void ReadData(void* buffer, std::size_t bufferSize) override
+        {
+            ::memcpy(buffer, data_.data(), std::min(bufferSize, data_.size()));
+        }
+
+        inline char* GetData()
+        {
+            return data_.data();
+        }
+
+    private:
+
+        std::vector<char> data_;
+
+};
+
+Readback* RenderSystem::ReadTextureAsync(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType)
+{
+    /* Read texture immediately by default */
+    auto readback = MakeUnique<ImmediateReadback>(GetTextureReadbackSize(texture, mipLevel, imageFormat, dataType));
+    ReadTexture(texture, mipLevel, imageFormat, dataType, readback->GetData());
+    return TakeOwnership(immediateReadbacks_, std::move(readback));
+}
+
+Readback* RenderSystem::ReadBufferAsync(Buffer& buffer, std::size_t offset, std::size_t dataSize)
+{
+    /* Read buffer immediately by default */
+    auto readback = MakeUnique<ImmediateReadback>(dataSize);
+
+    if (auto data = MapBuffer(buffer, BufferCPUAccess::ReadOnly))
+    {
+        ::memcpy(readback->GetData(), reinterpret_cast<const char*>(data) + offset, dataSize);
+        UnmapBuffer(buffer);
+    }
+    else
+        throw std::runtime_error("failed to map buffer for readback");
+
+    return TakeOwnership(immediateReadbacks_, std::move(readback));
+}
+
+void RenderSystem::Release(Readback& readback)
+{
+    RemoveFromUniqueSet(immediateReadbacks_, &readback);
+}
+
+/* ----- Uploads ----- */
+
+Fence* RenderSystem::WriteBufferAsync(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    /* Write buffer immediately by default, so the new fence is already signaled */
+    WriteBuffer(buffer, data, dataSize, offset);
+    return CreateFence();
+}
+
+Fence* RenderSystem::WriteTextureAsync(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    /* Write texture immediately by default, so the new fence is already signaled */
+    WriteTexture(texture, subTextureDesc, imageDesc);
+    return CreateFence();
+}
+
 
 /*
  * ======= Protected: =======
@@ -238,11 +527,67 @@ void RenderSystem::SetRenderingCaps(const RenderingCaps& caps)
     caps_ = caps;
 }
 
+void RenderSystem::SetVideoAdapters(const std::vector<VideoAdapterDescriptor>& videoAdapters)
+{
+    videoAdapters_ = videoAdapters;
+}
+
 std::vector<ColorRGBAub> RenderSystem::GetDefaultTextureImageRGBAub(int numPixels) const
 {
     return std::vector<ColorRGBAub>(static_cast<size_t>(numPixels), GetConfiguration().imageInitialization.color);
 }
 
+std::size_t RenderSystem::GetTextureReadbackSize(const Texture& texture, int mipLevel, ImageFormat imageFormat, DataType dataType)
+{
+    auto size = texture.QueryMipLevelSize(static_cast<unsigned int>(mipLevel));
+
+    if (IsCompressedFormat(imageFormat))
+    {
+        /* Compressed images are read as tightly packed blocks */
+        auto format = QueryTextureDescriptor(texture).format;
+        return CompressedImageSize(format, size.x, size.y, size.z);
+    }
+
+    return (static_cast<std::size_t>(size.x) * size.y * size.z * ImageFormatSize(imageFormat) * DataTypeSize(dataType));
+}
+
+std::size_t RenderSystem::GetSubTextureDataSize(const Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    /* Compressed images must specify their size */
+    if (IsCompressedFormat(imageDesc.format))
+        return imageDesc.compressedSize;
+
+    std::size_t numTexels = 0;
+
+    switch (texture.GetType())
+    {
+        case TextureType::Texture1D:
+            numTexels = subTextureDesc.texture1D.width;
+            break;
+        case TextureType::Texture1DArray:
+            numTexels = subTextureDesc.texture1D.width * subTextureDesc.texture1D.layers;
+            break;
+        case TextureType::Texture2D:
+            numTexels = subTextureDesc.texture2D.width * subTextureDesc.texture2D.height;
+            break;
+        case TextureType::Texture2DArray:
+            numTexels = subTextureDesc.texture2D.width * subTextureDesc.texture2D.height * subTextureDesc.texture2D.layers;
+            break;
+        case TextureType::Texture3D:
+            numTexels = subTextureDesc.texture3D.width * subTextureDesc.texture3D.height * subTextureDesc.texture3D.depth;
+            break;
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            numTexels = subTextureDesc.textureCube.width * subTextureDesc.textureCube.height * subTextureDesc.textureCube.cubeFaces;
+            break;
+        case TextureType::Texture2DMS:
+        case TextureType::Texture2DMSArray:
+            break;
+    }
+
+    return (numTexels * imageDesc.GetElementSize());
+}
+
 void RenderSystem::AssertCreateBuffer(const BufferDescriptor& desc)
 {
     if (desc.type < BufferType::Vertex || desc.type > BufferType::StreamOutput)
@@ -302,6 +647,163 @@ void RenderSystem::AssertCreateSamplerArray(unsigned int numSamplers, Sampler* c
     AssertCreateResourceArrayCommon(numSamplers, reinterpret_cast<void* const*>(samplerArray), "sampler");
 }
 
+void RenderSystem::AssertCreateQueryArray(unsigned int numQueries, Query* const * queryArray)
+{
+    /* Validate common resource array parameters */
+    AssertCreateResourceArrayCommon(numQueries, reinterpret_cast<void* const*>(queryArray), "query");
+
+    /* Validate query types */
+    auto refType = queryArray[0]->GetType();
+    for (unsigned int i = 1; i < numQueries; ++i)
+    {
+        if (queryArray[i]->GetType() != refType)
+            throw std::invalid_argument("can not create query array with type mismatch");
+    }
+}
+
+void RenderSystem::AssertCreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    for (const auto& resourceView : desc.resourceViews)
+    {
+        /* Validate resource pointer for the respective resource type */
+        switch (resourceView.type)
+        {
+            case ResourceType::ConstantBuffer:
+            case ResourceType::StorageBuffer:
+                if (resourceView.buffer == nullptr)
+                    throw std::invalid_argument("can not create resource heap with invalid buffer pointer");
+                break;
+            case ResourceType::Texture:
+                if (resourceView.texture == nullptr)
+                    throw std::invalid_argument("can not create resource heap with invalid texture pointer");
+                break;
+            case ResourceType::Sampler:
+                if (resourceView.sampler == nullptr)
+                    throw std::invalid_argument("can not create resource heap with invalid sampler pointer");
+                break;
+            default:
+                throw std::invalid_argument("can not create resource heap with undefined resource type");
+        }
+    }
+}
+
+// Returns the estimated size (in bytes) of the specified texture including its entire MIP-map chain.
+static std::uint64_t EstimateTextureMemory(const TextureDescriptor& desc)
+{
+    Gs::Vector3ui   extent  { 1, 1, 1 };
+    std::uint64_t   layers  = 1;
+    std::uint64_t   samples = 1;
+
+    switch (desc.type)
+    {
+        case TextureType::Texture1D:
+            extent.x    = desc.texture1D.width;
+            break;
+        case TextureType::Texture1DArray:
+            extent.x    = desc.texture1D.width;
+            layers      = std::max(1u, desc.texture1D.layers);
+            break;
+        case TextureType::Texture2D:
+            extent.x    = desc.texture2D.width;
+            extent.y    = desc.texture2D.height;
+            break;
+        case TextureType::Texture2DArray:
+            extent.x    = desc.texture2D.width;
+            extent.y    = desc.texture2D.height;
+            layers      = std::max(1u, desc.texture2D.layers);
+            break;
+        case TextureType::Texture3D:
+            extent      = { desc.texture3D.width, desc.texture3D.height, desc.texture3D.depth };
+            break;
+        case TextureType::TextureCube:
+            extent.x    = desc.textureCube.width;
+            extent.y    = desc.textureCube.height;
+            layers      = 6;
+            break;
+        case TextureType::TextureCubeArray:
+            extent.x    = desc.textureCube.width;
+            extent.y    = desc.textureCube.height;
+            layers      = 6 * std::max(1u, desc.textureCube.layers);
+            break;
+        case TextureType::Texture2DMS:
+            extent.x    = desc.texture2DMS.width;
+            extent.y    = desc.texture2DMS.height;
+            samples     = std::max(1u, desc.texture2DMS.samples);
+            break;
+        case TextureType::Texture2DMSArray:
+            extent.x    = desc.texture2DMS.width;
+            extent.y    = desc.texture2DMS.height;
+            layers      = std::max(1u, desc.texture2DMS.layers);
+            samples     = std::max(1u, desc.texture2DMS.samples);
+            break;
+    }
+
+    /* Multi-sample textures have no MIP-maps */
+    auto numMipLevels = (IsMultiSampleTexture(desc.type) ? 1u : NumMipLevels(extent.x, extent.y, extent.z));
+
+    std::uint64_t size = 0;
+
+    for (unsigned int mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        auto width  = std::max(1u, extent.x >> mipLevel);
+        auto height = std::max(1u, extent.y >> mipLevel);
+        auto depth  = std::max(1u, extent.z >> mipLevel);
+
+        if (IsCompressedFormat(desc.format))
+            size += CompressedImageSize(desc.format, width, height, depth);
+        else
+            size += static_cast<std::uint64_t>(width) * height * depth * TextureFormatSize(desc.format);
+    }
+
+    return (size * layers * samples);
+}
+
+void RenderSystem::TrackMemory(const Buffer& buffer, std::uint64_t size)
+{
+    std::lock_guard<std::mutex> guard(memoryMutex_);
+    auto& trackedSize = bufferMemory_[&buffer];
+    totalBufferMemory_ = totalBufferMemory_ - trackedSize + size;
+    trackedSize = size;
+}
+
+void RenderSystem::TrackMemory(const Texture& texture, const TextureDescriptor& textureDesc)
+{
+    auto size = EstimateTextureMemory(textureDesc);
+    std::lock_guard<std::mutex> guard(memoryMutex_);
+    auto& trackedSize = textureMemory_[&texture];
+    totalTextureMemory_ = totalTextureMemory_ - trackedSize + size;
+    trackedSize = size;
+}
+
+void RenderSystem::UntrackMemory(const Buffer& buffer)
+{
+    std::lock_guard<std::mutex> guard(memoryMutex_);
+    auto it = bufferMemory_.find(&buffer);
+    if (it != bufferMemory_.end())
+    {
+        totalBufferMemory_ -= it->second;
+        bufferMemory_.erase(it);
+    }
+}
+
+void RenderSystem::UntrackMemory(const Texture& texture)
+{
+    std::lock_guard<std::mutex> guard(memoryMutex_);
+    auto it = textureMemory_.find(&texture);
+    if (it != textureMemory_.end())
+    {
+        totalTextureMemory_ -= it->second;
+        textureMemory_.erase(it);
+    }
+}
+
+void RenderSystem::GetTrackedMemory(MemoryInfo& memoryInfo) const
+{
+    std::lock_guard<std::mutex> guard(memoryMutex_);
+    memoryInfo.bufferMemory     = totalBufferMemory_;
+    memoryInfo.textureMemory    = totalTextureMemory_;
+}
+
 
 } // /namespace LLGL
 
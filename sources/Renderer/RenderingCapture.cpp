@@ -0,0 +1,76 @@
+/*
+ * RenderingCapture.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderingCapture.h>
+#include "CaptureLayer/CapFormat.h"
+#include <fstream>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+RenderingCapture::RenderingCapture()
+{
+    /* Write trace header */
+    const CapTraceHeader header { capTraceMagic, capTraceVersion };
+    auto bytes = reinterpret_cast<const char*>(&header);
+    data_.insert(data_.end(), bytes, bytes + sizeof(header));
+}
+
+void RenderingCapture::AppendRecord(const void* data, std::size_t size)
+{
+    auto bytes = reinterpret_cast<const char*>(data);
+    std::lock_guard<std::mutex> guard { mutex_ };
+    data_.insert(data_.end(), bytes, bytes + size);
+}
+
+void RenderingCapture::NextFrame()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    ++numFrames_;
+}
+
+std::uint32_t RenderingCapture::GetNumFrames() const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    return numFrames_;
+}
+
+std::size_t RenderingCapture::GetSize() const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    return data_.size();
+}
+
+std::vector<char> RenderingCapture::GetTrace() const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    return data_;
+}
+
+void RenderingCapture::WriteTrace(std::ostream& stream) const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    stream.write(data_.data(), static_cast<std::streamsize>(data_.size()));
+}
+
+void RenderingCapture::SaveTrace(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.good())
+        throw std::runtime_error("failed to open file for writing: \"" + filename + "\"");
+    WriteTrace(file);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
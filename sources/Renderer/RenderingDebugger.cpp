@@ -6,6 +6,8 @@
  */
 
 #include <LLGL/RenderingDebugger.h>
+#include "../Core/Hash.h"
+#include <cstring>
 
 
 namespace LLGL
@@ -16,6 +18,14 @@ RenderingDebugger::~RenderingDebugger()
 {
 }
 
+RenderingDebugger::MessageID RenderingDebugger::MakeMessageID(const char* key, std::uint32_t index)
+{
+    MessageID id = HashInitValue();
+    HashBytes(id, key, std::strlen(key));
+    HashValue(id, index);
+    return id;
+}
+
 void RenderingDebugger::SetSource(const char* source)
 {
     source_ = (source != nullptr ? source : "");
@@ -23,37 +33,29 @@ void RenderingDebugger::SetSource(const char* source)
 
 void RenderingDebugger::PostError(const ErrorType type, const std::string& message)
 {
-    auto it = errors_.find(message);
-    if (it != errors_.end())
-    {
-        if (!it->second.IsBlocked())
-        {
-            it->second.IncOccurrence();
-            OnError(type, it->second);
-        }
-    }
-    else
-    {
-        errors_[message] = Message(message, source_);
-        OnError(type, errors_[message]);
-    }
+    PostError(type, MakeMessageID(message.c_str()), [&message]() { return message; });
 }
 
 void RenderingDebugger::PostWarning(const WarningType type, const std::string& message)
 {
-    auto it = warnings_.find(message);
-    if (it != warnings_.end())
+    PostWarning(type, MakeMessageID(message.c_str()), [&message]() { return message; });
+}
+
+void RenderingDebugger::PostError(const ErrorType type, MessageID id, const MessageFormatter& formatter)
+{
+    if (auto message = FindMessage(errors_, id, formatter))
     {
-        if (!it->second.IsBlocked())
-        {
-            it->second.IncOccurrence();
-            OnWarning(type, it->second);
-        }
+        OnError(type, *message);
+        message->SetFormatter({});
     }
-    else
+}
+
+void RenderingDebugger::PostWarning(const WarningType type, MessageID id, const MessageFormatter& formatter)
+{
+    if (auto message = FindMessage(warnings_, id, formatter))
     {
-        warnings_[message] = Message(message, source_);
-        OnWarning(type, warnings_[message]);
+        OnWarning(type, *message);
+        message->SetFormatter({});
     }
 }
 
@@ -73,16 +75,48 @@ void RenderingDebugger::OnWarning(WarningType type, Message& message)
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+RenderingDebugger::Message* RenderingDebugger::FindMessage(
+    std::unordered_map<MessageID, Message>& messages, MessageID id, const MessageFormatter& formatter)
+{
+    auto it = messages.find(id);
+    if (it != messages.end())
+    {
+        /* Skip blocked messages before their text is formatted */
+        if (it->second.IsBlocked())
+            return nullptr;
+        it->second.IncOccurrence();
+    }
+    else
+        it = messages.insert({ id, Message(source_) }).first;
+
+    it->second.SetFormatter(formatter);
+    return &(it->second);
+}
+
+
 /*
  * Message class
  */
 
-RenderingDebugger::Message::Message(const std::string& text, const std::string& source) :
-    text_   { text   },
+RenderingDebugger::Message::Message(const std::string& source) :
     source_ { source }
 {
 }
 
+const std::string& RenderingDebugger::Message::GetText() const
+{
+    if (formatter_.format != nullptr)
+    {
+        text_ = formatter_.format(formatter_.data);
+        formatter_ = {};
+    }
+    return text_;
+}
+
 void RenderingDebugger::Message::Block()
 {
     blocked_ = true;
@@ -99,6 +133,11 @@ void RenderingDebugger::Message::IncOccurrence()
     ++occurrences_;
 }
 
+void RenderingDebugger::Message::SetFormatter(const MessageFormatter& formatter)
+{
+    formatter_ = formatter;
+}
+
 
 } // /namespace LLGL
 
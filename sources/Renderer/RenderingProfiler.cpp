@@ -6,35 +6,123 @@
  */
 
 #include <LLGL/RenderingProfiler.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <iomanip>
 
 
 namespace LLGL
 {
 
 
-void RenderingProfiler::ResetCounters()
+/* ----- Counter class ----- */
+
+void RenderingProfiler::Counter::Reset()
 {
-    writeBuffer.Reset();
-    mapBuffer.Reset();
+    for (auto& shard : shards_)
+        shard.value.store(0, std::memory_order_relaxed);
+}
 
-    setVertexBuffer.Reset();
-    setIndexBuffer.Reset();
-    setConstantBuffer.Reset();
-    setStorageBuffer.Reset();
-    setStreamOutputBuffer.Reset();
-    setGraphicsPipeline.Reset();
-    setComputePipeline.Reset();
-    setTexture.Reset();
-    setSampler.Reset();
-    setRenderTarget.Reset();
+RenderingProfiler::Counter::ValueType RenderingProfiler::Counter::Flush()
+{
+    ValueType value = 0;
+    for (auto& shard : shards_)
+        value += shard.value.exchange(0, std::memory_order_relaxed);
+    return value;
+}
 
-    drawCalls.Reset();
-    dispatchComputeCalls.Reset();
+RenderingProfiler::Counter::ValueType RenderingProfiler::Counter::Count() const
+{
+    ValueType value = 0;
+    for (const auto& shard : shards_)
+        value += shard.value.load(std::memory_order_relaxed);
+    return value;
+}
 
-    renderedPoints.Reset();
-    renderedLines.Reset();
-    renderedTriangles.Reset();
-    renderedPatches.Reset();
+std::size_t RenderingProfiler::Counter::GetThreadShardIndex()
+{
+    /* Assign shards to threads in the order of their first increment */
+    static std::atomic<std::size_t> nextShardIndex { 0 };
+    thread_local std::size_t shardIndex = (nextShardIndex.fetch_add(1, std::memory_order_relaxed) % numShards);
+    return shardIndex;
+}
+
+
+/* ----- SuballocatorUsage structure ----- */
+
+double RenderingProfiler::SuballocatorUsage::GetFragmentation() const
+{
+    const auto freeElements = (capacity > used ? capacity - used : 0);
+    if (freeElements == 0)
+        return 0.0;
+    return 1.0 - static_cast<double>(largestFreeBlock) / static_cast<double>(freeElements);
+}
+
+double RenderingProfiler::StateCacheUsage::GetHitRate() const
+{
+    const auto total = hits + misses;
+    if (total == 0)
+        return 0.0;
+    return static_cast<double>(hits) / static_cast<double>(total);
+}
+
+
+/* ----- RenderingProfiler class ----- */
+
+struct CounterEntry
+{
+    RenderingProfiler::Counter RenderingProfiler::* counter;
+    const char*                                     name;
+};
+
+#define LLGL_COUNTER_ENTRY(NAME) \
+    { &RenderingProfiler::NAME, #NAME }
+
+// Table of all counters in the order of their declaration
+static const CounterEntry g_counterEntries[] =
+{
+    LLGL_COUNTER_ENTRY( writeBuffer           ),
+    LLGL_COUNTER_ENTRY( mapBuffer             ),
+    LLGL_COUNTER_ENTRY( setVertexBuffer       ),
+    LLGL_COUNTER_ENTRY( setIndexBuffer        ),
+    LLGL_COUNTER_ENTRY( setConstantBuffer     ),
+    LLGL_COUNTER_ENTRY( setStorageBuffer      ),
+    LLGL_COUNTER_ENTRY( setStreamOutputBuffer ),
+    LLGL_COUNTER_ENTRY( setGraphicsPipeline   ),
+    LLGL_COUNTER_ENTRY( setComputePipeline    ),
+    LLGL_COUNTER_ENTRY( setTexture            ),
+    LLGL_COUNTER_ENTRY( setSampler            ),
+    LLGL_COUNTER_ENTRY( setResourceHeap       ),
+    LLGL_COUNTER_ENTRY( setRenderTarget       ),
+    LLGL_COUNTER_ENTRY( drawCalls             ),
+    LLGL_COUNTER_ENTRY( dispatchComputeCalls  ),
+    LLGL_COUNTER_ENTRY( renderedPoints        ),
+    LLGL_COUNTER_ENTRY( renderedLines         ),
+    LLGL_COUNTER_ENTRY( renderedTriangles     ),
+    LLGL_COUNTER_ENTRY( renderedPatches       ),
+    LLGL_COUNTER_ENTRY( redundantBindings     ),
+    LLGL_COUNTER_ENTRY( redundantClears       ),
+    LLGL_COUNTER_ENTRY( emptyDraws            ),
+    LLGL_COUNTER_ENTRY( redundantBufferWrites ),
+};
+
+#undef LLGL_COUNTER_ENTRY
+
+static_assert(
+    sizeof(g_counterEntries)/sizeof(g_counterEntries[0]) == RenderingProfiler::numCounters,
+    "RenderingProfiler::numCounters does not match the number of counters"
+);
+
+RenderingProfiler::RenderingProfiler(std::size_t frameHistorySize) :
+    frames_ { std::max(frameHistorySize, std::size_t(1)) }
+{
+}
+
+void RenderingProfiler::ResetCounters()
+{
+    for (const auto& entry : g_counterEntries)
+        (this->*entry.counter).Reset();
 }
 
 void RenderingProfiler::RecordDrawCall(const PrimitiveTopology topology, Counter::ValueType numVertices)
@@ -165,6 +253,379 @@ void RenderingProfiler::RecordDrawCall(const PrimitiveTopology topology, Counter
     }
 }
 
+void RenderingProfiler::RecordWastedWork(const WastedWorkType type, const char* command)
+{
+    switch (type)
+    {
+        case WastedWorkType::RedundantBinding:
+            redundantBindings.Inc();
+            break;
+        case WastedWorkType::RedundantClear:
+            redundantClears.Inc();
+            break;
+        case WastedWorkType::EmptyDraw:
+            emptyDraws.Inc();
+            break;
+        case WastedWorkType::RedundantBufferWrite:
+            redundantBufferWrites.Inc();
+            break;
+    }
+
+    /* Increment entry of the current call site */
+    auto callSite = GetCallSiteTag();
+    std::lock_guard<std::mutex> guard { wastedWorkMutex_ };
+    ++wastedWork_[WastedWorkKey{ type, command, (callSite != nullptr ? callSite : "") }];
+}
+
+std::vector<RenderingProfiler::WastedWorkRecord> RenderingProfiler::GetTopWastedWork(std::size_t maxCount) const
+{
+    std::vector<WastedWorkRecord> records;
+
+    /* Copy all entries into the records */
+    {
+        std::lock_guard<std::mutex> guard { wastedWorkMutex_ };
+        records.reserve(wastedWork_.size());
+        for (const auto& entry : wastedWork_)
+        {
+            WastedWorkRecord record;
+            {
+                record.type     = std::get<0>(entry.first);
+                record.command  = std::get<1>(entry.first);
+                record.callSite = std::get<2>(entry.first);
+                record.count    = entry.second;
+            }
+            records.push_back(std::move(record));
+        }
+    }
+
+    /* Keep the records with the most occurrences */
+    auto n = std::min(maxCount, records.size());
+    std::partial_sort(
+        records.begin(), records.begin() + n, records.end(),
+        [](const WastedWorkRecord& lhs, const WastedWorkRecord& rhs)
+        {
+            return (lhs.count > rhs.count);
+        }
+    );
+    records.resize(n);
+
+    return records;
+}
+
+void RenderingProfiler::ClearWastedWork()
+{
+    std::lock_guard<std::mutex> guard { wastedWorkMutex_ };
+    wastedWork_.clear();
+}
+
+static void AddMemoryUsage(RenderingProfiler::MemoryUsage& usage, std::uint64_t size)
+{
+    usage.bytes += size;
+    ++usage.numAllocations;
+}
+
+static void SubtractMemoryUsage(RenderingProfiler::MemoryUsage& usage, std::uint64_t size)
+{
+    usage.bytes -= std::min(usage.bytes, size);
+    if (usage.numAllocations > 0)
+        --usage.numAllocations;
+}
+
+void RenderingProfiler::RecordAllocation(const MemoryAllocation& allocation)
+{
+    std::lock_guard<std::mutex> guard { memoryMutex_ };
+
+    AddMemoryUsage(memory_.total, allocation.size);
+    AddMemoryUsage(memory_.types[static_cast<std::size_t>(allocation.type)], allocation.size);
+    if (allocation.format != TextureFormat::Unknown)
+        AddMemoryUsage(memory_.formats[allocation.format], allocation.size);
+    AddMemoryUsage(memory_.tags[allocation.tag], allocation.size);
+
+    /* Update high-water marks */
+    memory_.peakBytes   = std::max(memory_.peakBytes, memory_.total.bytes);
+    framePeakMemory_    = std::max(framePeakMemory_, memory_.total.bytes);
+}
+
+void RenderingProfiler::RecordRelease(const MemoryAllocation& allocation)
+{
+    std::lock_guard<std::mutex> guard { memoryMutex_ };
+
+    SubtractMemoryUsage(memory_.total, allocation.size);
+    SubtractMemoryUsage(memory_.types[static_cast<std::size_t>(allocation.type)], allocation.size);
+
+    /* Remove entries without allocations, so the report only lists the current consumers */
+    if (allocation.format != TextureFormat::Unknown)
+    {
+        auto it = memory_.formats.find(allocation.format);
+        if (it != memory_.formats.end())
+        {
+            SubtractMemoryUsage(it->second, allocation.size);
+            if (it->second.numAllocations == 0)
+                memory_.formats.erase(it);
+        }
+    }
+
+    auto it = memory_.tags.find(allocation.tag);
+    if (it != memory_.tags.end())
+    {
+        SubtractMemoryUsage(it->second, allocation.size);
+        if (it->second.numAllocations == 0)
+            memory_.tags.erase(it);
+    }
+}
+
+void RenderingProfiler::ReportSuballocator(const std::string& name, const SuballocatorUsage& usage)
+{
+    std::lock_guard<std::mutex> guard { memoryMutex_ };
+    memory_.suballocators[name] = usage;
+}
+
+RenderingProfiler::MemoryReport RenderingProfiler::GetMemoryReport() const
+{
+    std::lock_guard<std::mutex> guard { memoryMutex_ };
+    return memory_;
+}
+
+void RenderingProfiler::ResetPeakMemory()
+{
+    std::lock_guard<std::mutex> guard { memoryMutex_ };
+    memory_.peakBytes = memory_.total.bytes;
+}
+
+static void WriteMemoryUsage(std::ostream& stream, const std::string& name, const RenderingProfiler::MemoryUsage& usage)
+{
+    stream << "  " << std::left << std::setw(24) << name << std::right;
+    stream << std::setw(12) << std::fixed << std::setprecision(2) << (static_cast<double>(usage.bytes) / (1024.0 * 1024.0)) << " MiB";
+    stream << " in " << usage.numAllocations << " allocation(s)\n";
+}
+
+// Writes the specified entries sorted by their size in descending order.
+template <typename TKey, typename TNameGetter>
+static void WriteSortedMemoryUsages(std::ostream& stream, const std::map<TKey, RenderingProfiler::MemoryUsage>& usages, TNameGetter getName)
+{
+    std::vector<std::pair<TKey, RenderingProfiler::MemoryUsage>> entries { usages.begin(), usages.end() };
+    std::stable_sort(
+        entries.begin(), entries.end(),
+        [](const std::pair<TKey, RenderingProfiler::MemoryUsage>& lhs, const std::pair<TKey, RenderingProfiler::MemoryUsage>& rhs)
+        {
+            return (lhs.second.bytes > rhs.second.bytes);
+        }
+    );
+    for (const auto& entry : entries)
+        WriteMemoryUsage(stream, getName(entry.first), entry.second);
+}
+
+// Returns the name of the specified texture format for the memory report.
+static std::string GetTextureFormatName(TextureFormat format)
+{
+    static const char* names[] =
+    {
+        "Unknown", "DepthComponent", "DepthStencil", "R", "RG", "RGB",
+        "RGBA", "R8", "R8Sgn", "R8UInt", "R16", "R16Sgn",
+        "R16Float", "R32UInt", "R32SInt", "R32Float", "RG8", "RG8Sgn",
+        "RG16", "RG16Sgn", "RG16Float", "RG32UInt", "RG32SInt", "RG32Float",
+        "RGB8", "RGB8Sgn", "RGB16", "RGB16Sgn", "RGB16Float", "RGB32UInt",
+        "RGB32SInt", "RGB32Float", "RGBA8", "RGBA8Sgn", "RGBA16", "RGBA16Sgn",
+        "RGBA16Float", "RGBA32UInt", "RGBA32SInt", "RGBA32Float", "RGB_DXT1", "RGBA_DXT1",
+        "RGBA_DXT3", "RGBA_DXT5", "R_BC4", "RG_BC5", "RGB_BC6H", "RGBA_BC7",
+        "RGB_ETC2", "RGBA_ETC2", "RGBA_ASTC4x4", "RGBA_ASTC8x8",
+    };
+    const auto index = static_cast<std::size_t>(format);
+    if (index < sizeof(names)/sizeof(names[0]))
+        return names[index];
+    return std::to_string(index);
+}
+
+void RenderingProfiler::WriteMemoryReport(std::ostream& stream) const
+{
+    static const char* typeNames[numMemoryTypes] = { "Buffer", "Texture", "RenderTarget" };
+
+    const auto report = GetMemoryReport();
+
+    stream << "GPU memory report:\n";
+    WriteMemoryUsage(stream, "Total", report.total);
+    stream << "  " << std::left << std::setw(24) << "Peak" << std::right << std::setw(12) << std::fixed << std::setprecision(2);
+    stream << (static_cast<double>(report.peakBytes) / (1024.0 * 1024.0)) << " MiB\n";
+
+    stream << "By type:\n";
+    for (std::size_t i = 0; i < numMemoryTypes; ++i)
+        WriteMemoryUsage(stream, typeNames[i], report.types[i]);
+
+    stream << "By texture format:\n";
+    WriteSortedMemoryUsages(
+        stream, report.formats,
+        [](TextureFormat format)
+        {
+            return GetTextureFormatName(format);
+        }
+    );
+
+    stream << "By tag:\n";
+    WriteSortedMemoryUsages(
+        stream, report.tags,
+        [](const std::string& tag)
+        {
+            return (tag.empty() ? std::string("<untagged>") : tag);
+        }
+    );
+
+    if (!report.suballocators.empty())
+    {
+        stream << "Suballocators:\n";
+        for (const auto& entry : report.suballocators)
+        {
+            const auto& usage = entry.second;
+            stream << "  " << std::left << std::setw(24) << entry.first << std::right;
+            stream << ' ' << usage.used << '/' << usage.capacity << " used, largest free block " << usage.largestFreeBlock;
+            stream << ", fragmentation " << std::fixed << std::setprecision(1) << (usage.GetFragmentation() * 100.0) << "%\n";
+        }
+    }
+}
+
+void RenderingProfiler::ReportStateCache(const std::string& category, const StateCacheUsage& usage)
+{
+    std::lock_guard<std::mutex> guard { stateCacheMutex_ };
+    auto& entry = stateCache_[category];
+    entry.hits      += usage.hits;
+    entry.misses    += usage.misses;
+}
+
+std::map<std::string, RenderingProfiler::StateCacheUsage> RenderingProfiler::GetStateCacheReport() const
+{
+    std::lock_guard<std::mutex> guard { stateCacheMutex_ };
+    return stateCache_;
+}
+
+void RenderingProfiler::ResetStateCacheReport()
+{
+    std::lock_guard<std::mutex> guard { stateCacheMutex_ };
+    stateCache_.clear();
+}
+
+static const char*& CallSiteTagRef()
+{
+    thread_local const char* tag = nullptr;
+    return tag;
+}
+
+void RenderingProfiler::SetCallSiteTag(const char* tag)
+{
+    CallSiteTagRef() = tag;
+}
+
+const char* RenderingProfiler::GetCallSiteTag()
+{
+    return CallSiteTagRef();
+}
+
+void RenderingProfiler::NextFrame(double frameTime)
+{
+    /* Select next frame record; overwrite the oldest one if the history is full */
+    auto& frame = frames_[(firstFrame_ + numFrames_) % frames_.size()];
+
+    if (numFrames_ < frames_.size())
+        ++numFrames_;
+    else
+        firstFrame_ = (firstFrame_ + 1) % frames_.size();
+
+    /* Move all counter values into the frame record */
+    frame.frameTime = frameTime;
+    for (std::size_t i = 0; i < numCounters; ++i)
+        frame.counters[i] = (this->*g_counterEntries[i].counter).Flush();
+
+    /* Start high-water mark of the next frame with the memory that remains allocated */
+    std::lock_guard<std::mutex> guard { memoryMutex_ };
+    frame.peakMemory    = framePeakMemory_;
+    framePeakMemory_    = memory_.total.bytes;
+}
+
+void RenderingProfiler::ClearFrameHistory()
+{
+    firstFrame_ = 0;
+    numFrames_  = 0;
+}
+
+const RenderingProfiler::FrameRecord& RenderingProfiler::GetFrame(std::size_t index) const
+{
+    if (index >= numFrames_)
+        throw std::out_of_range("frame index out of range in rendering profiler history");
+    return frames_[(firstFrame_ + index) % frames_.size()];
+}
+
+RenderingProfiler::FrameStatistics RenderingProfiler::GetFrameTimeStatistics() const
+{
+    return ComputeStatistics(
+        [](const FrameRecord& frame)
+        {
+            return frame.frameTime;
+        }
+    );
+}
+
+RenderingProfiler::FrameStatistics RenderingProfiler::GetCounterStatistics(std::size_t counterIndex) const
+{
+    if (counterIndex >= numCounters)
+        throw std::out_of_range("counter index out of range in rendering profiler");
+
+    return ComputeStatistics(
+        [counterIndex](const FrameRecord& frame)
+        {
+            return static_cast<double>(frame.counters[counterIndex]);
+        }
+    );
+}
+
+const RenderingProfiler::Counter& RenderingProfiler::GetCounter(std::size_t counterIndex) const
+{
+    if (counterIndex >= numCounters)
+        throw std::out_of_range("counter index out of range in rendering profiler");
+    return (this->*g_counterEntries[counterIndex].counter);
+}
+
+const char* RenderingProfiler::GetCounterName(std::size_t counterIndex)
+{
+    return (counterIndex < numCounters ? g_counterEntries[counterIndex].name : nullptr);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+template <typename TGetter>
+RenderingProfiler::FrameStatistics RenderingProfiler::ComputeStatistics(TGetter getter) const
+{
+    FrameStatistics stats;
+
+    if (numFrames_ > 0)
+    {
+        /* Gather values of all frames */
+        std::vector<double> values(numFrames_);
+        for (std::size_t i = 0; i < numFrames_; ++i)
+            values[i] = getter(GetFrame(i));
+
+        /* Determine minimum and average */
+        double sum = 0.0;
+        stats.min = values[0];
+        for (auto value : values)
+        {
+            stats.min = std::min(stats.min, value);
+            sum += value;
+        }
+        stats.avg = sum / static_cast<double>(numFrames_);
+
+        /* Determine 99th percentile with the nearest-rank method */
+        auto rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(numFrames_)));
+        auto nth = values.begin() + (std::max(rank, std::size_t(1)) - 1);
+        std::nth_element(values.begin(), nth, values.end());
+        stats.p99 = *nth;
+
+        stats.numFrames = numFrames_;
+    }
+
+    return stats;
+}
+
 
 } // /namespace LLGL
 
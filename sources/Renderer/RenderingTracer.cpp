@@ -0,0 +1,224 @@
+/*
+ * RenderingTracer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderingTracer.h>
+#include <LLGL/GPUProfiler.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <cstdio>
+
+
+namespace LLGL
+{
+
+
+// Returns the index of the calling thread, which is assigned at its first recorded event.
+static std::uint32_t GetThreadIndex()
+{
+    static std::atomic<std::uint32_t> nextThreadIndex { 0 };
+    thread_local std::uint32_t threadIndex = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return threadIndex;
+}
+
+static const char* GetCategoryName(const TraceCategory category)
+{
+    switch (category)
+    {
+        case TraceCategory::CommandBuffer:  return "CommandBuffer";
+        case TraceCategory::RenderSystem:   return "RenderSystem";
+        case TraceCategory::Shader:         return "Shader";
+        case TraceCategory::Present:        return "Present";
+        case TraceCategory::GPU:            return "GPU";
+        case TraceCategory::User:           return "User";
+    }
+    return "";
+}
+
+// Writes the specified string as JSON string literal (including the quotation marks).
+static void WriteJSONString(std::ostream& stream, const std::string& str)
+{
+    stream << '\"';
+    for (auto c : str)
+    {
+        switch (c)
+        {
+            case '\"': stream << "\\\""; break;
+            case '\\': stream << "\\\\"; break;
+            case '\n': stream << "\\n";  break;
+            case '\r': stream << "\\r";  break;
+            case '\t': stream << "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char hex[8];
+                    std::snprintf(hex, sizeof(hex), "\\u%04x", static_cast<unsigned int>(c));
+                    stream << hex;
+                }
+                else
+                    stream << c;
+                break;
+        }
+    }
+    stream << '\"';
+}
+
+// Writes the specified time (in nanoseconds) in microseconds, as required by the Chrome trace event format.
+static void WriteJSONMicroseconds(std::ostream& stream, std::uint64_t nanoseconds)
+{
+    stream << (nanoseconds / 1000) << '.';
+
+    auto fraction = static_cast<unsigned int>(nanoseconds % 1000);
+    stream << static_cast<char>('0' + fraction / 100) << static_cast<char>('0' + (fraction / 10) % 10) << static_cast<char>('0' + fraction % 10);
+}
+
+RenderingTracer::RenderingTracer() :
+    startTime_ { Clock::now() }
+{
+}
+
+std::uint64_t RenderingTracer::GetTime() const
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime_);
+    return static_cast<std::uint64_t>(elapsed.count());
+}
+
+void RenderingTracer::RecordEvent(const char* name, const TraceCategory category, std::uint64_t startTime, std::uint64_t endTime)
+{
+    TraceEvent event;
+    {
+        event.name          = name;
+        event.category      = category;
+        event.startTime     = startTime;
+        event.duration      = (endTime > startTime ? endTime - startTime : 0);
+        event.threadIndex   = GetThreadIndex();
+    }
+    PostEvent(std::move(event));
+}
+
+void RenderingTracer::RecordGPUFrame(const GPUProfilerFrame& frame, std::uint64_t cpuStartTime)
+{
+    /* Map GPU start timestamp of the frame onto the CPU timeline if a clock calibration is available */
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        if (hasCalibration_)
+        {
+            auto tracerStart = std::chrono::duration_cast<std::chrono::nanoseconds>(startTime_.time_since_epoch()).count();
+            auto gpuOffset   = static_cast<std::int64_t>(frame.startTimestamp - calibration_.gpuTime);
+            auto startTime   = static_cast<std::int64_t>(calibration_.cpuTime) + gpuOffset - static_cast<std::int64_t>(tracerStart);
+            cpuStartTime = static_cast<std::uint64_t>(std::max<std::int64_t>(0, startTime));
+        }
+    }
+
+    /* Record event for the entire frame */
+    TraceEvent frameEvent;
+    {
+        frameEvent.name         = "Frame " + std::to_string(frame.frameIndex);
+        frameEvent.category     = TraceCategory::GPU;
+        frameEvent.startTime    = cpuStartTime;
+        frameEvent.duration     = frame.elapsedTime;
+    }
+    PostEvent(std::move(frameEvent));
+
+    /* Record events for all scopes; nested scopes are nested events on the same timeline */
+    for (const auto& scope : frame.scopes)
+    {
+        TraceEvent event;
+        {
+            event.name      = scope.name;
+            event.category  = TraceCategory::GPU;
+            event.startTime = cpuStartTime + scope.startTime;
+            event.duration  = scope.elapsedTime;
+        }
+        PostEvent(std::move(event));
+    }
+}
+
+void RenderingTracer::SetClockCalibration(const ClockCalibration& calibration)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    calibration_    = calibration;
+    hasCalibration_ = true;
+}
+
+void RenderingTracer::SetEventCallback(const EventCallback& callback, bool storeEvents)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    callback_       = callback;
+    storeEvents_    = storeEvents;
+}
+
+std::vector<TraceEvent> RenderingTracer::GetEvents() const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    return events_;
+}
+
+void RenderingTracer::Clear()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    events_.clear();
+}
+
+void RenderingTracer::WriteChromeTrace(std::ostream& stream) const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    stream << "{\"traceEvents\":[\n";
+
+    /* Write process names, so the CPU and GPU timelines are labeled in the viewer */
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CPU\"}},\n";
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}";
+
+    /* Write all events as complete events (phase "X") */
+    for (const auto& event : events_)
+    {
+        stream << ",\n{\"name\":";
+        WriteJSONString(stream, event.name);
+        stream << ",\"cat\":\"" << GetCategoryName(event.category) << '\"';
+        stream << ",\"ph\":\"X\",\"ts\":";
+        WriteJSONMicroseconds(stream, event.startTime);
+        stream << ",\"dur\":";
+        WriteJSONMicroseconds(stream, event.duration);
+        stream << ",\"pid\":" << (event.category == TraceCategory::GPU ? 1 : 0);
+        stream << ",\"tid\":" << event.threadIndex << '}';
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void RenderingTracer::SaveChromeTrace(const std::string& filename) const
+{
+    std::ofstream file { filename };
+    if (!file.good())
+        throw std::runtime_error("failed to open file for writing: \"" + filename + "\"");
+    WriteChromeTrace(file);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void RenderingTracer::PostEvent(TraceEvent&& event)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    if (callback_)
+        callback_(event);
+
+    if (storeEvents_)
+        events_.emplace_back(std::move(event));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,231 @@
+/*
+ * ResidencyManager.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ResidencyManager.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+ResidencyManager::ResidencyManager(RenderSystem& renderSystem, const ResidencyManagerDescriptor& desc) :
+    renderSystem_ { renderSystem },
+    desc_         { desc         }
+{
+}
+
+void ResidencyManager::Register(Buffer& buffer, std::uint64_t size)
+{
+    Entry entry;
+    {
+        entry.buffer    = &buffer;
+        entry.size      = size;
+    }
+    Register(&buffer, entry);
+}
+
+void ResidencyManager::Register(Texture& texture, std::uint64_t size, const DemoteCallback& demoteCallback)
+{
+    Entry entry;
+    {
+        entry.texture           = &texture;
+        entry.size              = size;
+        entry.demoteCallback    = demoteCallback;
+    }
+    Register(&texture, entry);
+}
+
+void ResidencyManager::Unregister(Buffer& buffer)
+{
+    Unregister(&buffer);
+}
+
+void ResidencyManager::Unregister(Texture& texture)
+{
+    Unregister(&texture);
+}
+
+bool ResidencyManager::MarkUsed(Buffer& buffer)
+{
+    auto it = entries_.find(&buffer);
+    if (it == entries_.end())
+        return false;
+
+    it->second.lastFrame = frame_;
+    return Restore(it->second);
+}
+
+bool ResidencyManager::MarkUsed(Texture& texture)
+{
+    auto it = entries_.find(&texture);
+    if (it == entries_.end())
+        return false;
+
+    it->second.lastFrame = frame_;
+    return Restore(it->second);
+}
+
+void ResidencyManager::NextFrame()
+{
+    /* Determine budget and usage, either of the registered resources only or of the entire process */
+    std::uint64_t budget    = desc_.budget;
+    std::uint64_t usage     = residentSize_;
+
+    if (budget == 0)
+    {
+        auto memoryInfo = renderSystem_.QueryMemoryInfo();
+        budget  = memoryInfo.local.budget;
+        usage   = memoryInfo.local.currentUsage;
+    }
+
+    if (budget > 0 && usage > budget)
+    {
+        /* Gather all resident resources that have not been used for the minimal number of frames */
+        std::vector<Entry*> candidates;
+
+        for (auto& it : entries_)
+        {
+            auto& entry = it.second;
+            if (entry.state == State::Resident && entry.lastFrame + desc_.minUnusedFrames <= frame_)
+                candidates.push_back(&entry);
+        }
+
+        /* Evict least recently used resources first, until the usage is back at the target */
+        std::sort(
+            candidates.begin(), candidates.end(),
+            [](const Entry* lhs, const Entry* rhs)
+            {
+                return (lhs->lastFrame < rhs->lastFrame);
+            }
+        );
+
+        const auto target = static_cast<std::uint64_t>(static_cast<double>(budget) * std::max(0.0f, std::min(desc_.targetRatio, 1.0f)));
+
+        std::uint32_t numEvictions = 0;
+
+        for (auto entry : candidates)
+        {
+            if (usage <= target || (desc_.maxEvictionsPerFrame > 0 && numEvictions >= desc_.maxEvictionsPerFrame))
+                break;
+
+            if (Evict(*entry))
+            {
+                usage -= std::min(usage, entry->releasedSize);
+                ++numEvictions;
+            }
+        }
+    }
+
+    ++frame_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ResidencyManager::Register(const void* resource, const Entry& entry)
+{
+    auto it = entries_.find(resource);
+    if (it != entries_.end())
+    {
+        /* Update size and callback of the registered resource */
+        auto& prevEntry = it->second;
+        residentSize_ -= (prevEntry.size - prevEntry.releasedSize);
+        prevEntry.size              = std::max(entry.size, prevEntry.releasedSize);
+        prevEntry.demoteCallback    = entry.demoteCallback;
+        residentSize_ += (prevEntry.size - prevEntry.releasedSize);
+    }
+    else
+    {
+        auto& newEntry = entries_[resource];
+        newEntry = entry;
+        newEntry.lastFrame = frame_;
+        residentSize_ += entry.size;
+    }
+}
+
+void ResidencyManager::Unregister(const void* resource)
+{
+    auto it = entries_.find(resource);
+    if (it != entries_.end())
+    {
+        const auto& entry = it->second;
+        residentSize_   -= (entry.size - entry.releasedSize);
+        evictedSize_    -= entry.releasedSize;
+        entries_.erase(it);
+    }
+}
+
+bool ResidencyManager::Restore(Entry& entry)
+{
+    switch (entry.state)
+    {
+        case State::Evicted:
+            if (entry.buffer != nullptr)
+                renderSystem_.SetResidency(*entry.buffer, true);
+            else
+                renderSystem_.SetResidency(*entry.texture, true);
+            break;
+
+        case State::Demoted:
+            entry.demoteCallback(*entry.texture, false);
+            break;
+
+        default:
+            return false;
+    }
+
+    residentSize_   += entry.releasedSize;
+    evictedSize_    -= entry.releasedSize;
+    entry.releasedSize  = 0;
+    entry.state         = State::Resident;
+
+    return true;
+}
+
+bool ResidencyManager::Evict(Entry& entry)
+{
+    if (entry.buffer != nullptr)
+    {
+        /* Buffers can only be evicted by the render system */
+        if (!renderSystem_.SetResidency(*entry.buffer, false))
+            return false;
+
+        entry.releasedSize  = entry.size;
+        entry.state         = State::Evicted;
+    }
+    else if (renderSystem_.SetResidency(*entry.texture, false))
+    {
+        entry.releasedSize  = entry.size;
+        entry.state         = State::Evicted;
+    }
+    else if (entry.demoteCallback)
+    {
+        /* Let the application drop the high-resolution MIP-map levels */
+        entry.releasedSize = std::min(entry.demoteCallback(*entry.texture, true), entry.size);
+        if (entry.releasedSize == 0)
+            return false;
+
+        entry.state = State::Demoted;
+    }
+    else
+        return false;
+
+    residentSize_   -= entry.releasedSize;
+    evictedSize_    += entry.releasedSize;
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
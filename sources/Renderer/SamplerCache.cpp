@@ -0,0 +1,58 @@
+/*
+ * SamplerCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "SamplerCache.h"
+#include "../Core/Helper.h"
+
+
+namespace LLGL
+{
+
+
+template <typename T>
+static void HashEnum(std::size_t& seed, const T value)
+{
+    HashCombine(seed, static_cast<int>(value));
+}
+
+// Hashes the float value, so that equal values (e.g. 0 and -0) have the same hash.
+static void HashFloat(std::size_t& seed, float value)
+{
+    HashCombine(seed, (value == 0.0f ? 0.0f : value));
+}
+
+std::size_t SamplerDescriptorHash::operator () (const SamplerDescriptor& desc) const
+{
+    std::size_t seed = 0;
+
+    HashEnum    (seed, desc.textureWrapU    );
+    HashEnum    (seed, desc.textureWrapV    );
+    HashEnum    (seed, desc.textureWrapW    );
+    HashEnum    (seed, desc.minFilter       );
+    HashEnum    (seed, desc.magFilter       );
+    HashEnum    (seed, desc.mipMapFilter    );
+    HashCombine (seed, desc.mipMapping      );
+    HashFloat   (seed, desc.mipMapLODBias   );
+    HashFloat   (seed, desc.minLOD          );
+    HashFloat   (seed, desc.maxLOD          );
+    HashCombine (seed, desc.maxAnisotropy   );
+    HashCombine (seed, desc.depthCompare    );
+    HashEnum    (seed, desc.compareOp       );
+    HashFloat   (seed, desc.borderColor.r   );
+    HashFloat   (seed, desc.borderColor.g   );
+    HashFloat   (seed, desc.borderColor.b   );
+    HashFloat   (seed, desc.borderColor.a   );
+
+    return seed;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,41 @@
+/*
+ * SamplerCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SAMPLER_CACHE_H
+#define LLGL_SAMPLER_CACHE_H
+
+
+#include "ContainerTypes.h"
+#include <LLGL/SamplerFlags.h>
+
+
+namespace LLGL
+{
+
+
+// Hash function object for sampler descriptors.
+struct SamplerDescriptorHash
+{
+    std::size_t operator () (const SamplerDescriptor& desc) const;
+};
+
+/*
+Sampler container that interns the samplers by their descriptors,
+so identical sampler descriptors share the same native sampler object.
+*/
+template <typename T>
+using SamplerCache = HWObjectCache<T, SamplerDescriptor, SamplerDescriptorHash>;
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,53 @@
+/*
+ * SamplerFlags.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/SamplerFlags.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Compare all members exactly (without epsilon), so that equal descriptors
+always have the same hash value in the sampler caches of the backends.
+*/
+LLGL_EXPORT bool operator == (const SamplerDescriptor& lhs, const SamplerDescriptor& rhs)
+{
+    return
+    (
+        lhs.textureWrapU  == rhs.textureWrapU  &&
+        lhs.textureWrapV  == rhs.textureWrapV  &&
+        lhs.textureWrapW  == rhs.textureWrapW  &&
+        lhs.minFilter     == rhs.minFilter     &&
+        lhs.magFilter     == rhs.magFilter     &&
+        lhs.mipMapFilter  == rhs.mipMapFilter  &&
+        lhs.mipMapping    == rhs.mipMapping    &&
+        lhs.mipMapLODBias == rhs.mipMapLODBias &&
+        lhs.minLOD        == rhs.minLOD        &&
+        lhs.maxLOD        == rhs.maxLOD        &&
+        lhs.maxAnisotropy == rhs.maxAnisotropy &&
+        lhs.depthCompare  == rhs.depthCompare  &&
+        lhs.compareOp     == rhs.compareOp     &&
+        lhs.borderColor.r == rhs.borderColor.r &&
+        lhs.borderColor.g == rhs.borderColor.g &&
+        lhs.borderColor.b == rhs.borderColor.b &&
+        lhs.borderColor.a == rhs.borderColor.a
+    );
+}
+
+LLGL_EXPORT bool operator != (const SamplerDescriptor& lhs, const SamplerDescriptor& rhs)
+{
+    return !(lhs == rhs);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -21,6 +21,14 @@ Shader::~Shader()
 {
 }
 
+std::shared_future<bool> Shader::CompileAsync(const std::string& sourceCode, const ShaderDescriptor& shaderDesc)
+{
+    /* Compile shader immediately by default */
+    std::promise<bool> result;
+    result.set_value(Compile(sourceCode, shaderDesc));
+    return result.get_future().share();
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,372 @@
+/*
+ * ShaderVariantCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ShaderVariantCache.h>
+#include "../Core/Hash.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal functions ----- */
+
+static const std::uint32_t g_variantListMagic   = 0x5653474C; // 'LGSV'
+static const std::uint32_t g_variantListVersion = 1;
+
+static void HashString(std::uint64_t& hash, const std::string& s)
+{
+    /* Include the length to distinguish consecutive strings like "ab"+"c" and "a"+"bc" */
+    auto len = static_cast<std::uint64_t>(s.size());
+    HashBytes(hash, &len, sizeof(len));
+    HashBytes(hash, s.data(), s.size());
+}
+
+static void HashShaderDescriptor(std::uint64_t& hash, const ShaderType type, const ShaderDescriptor& desc)
+{
+    HashBytes(hash, &type, sizeof(type));
+    HashString(hash, desc.entryPoint);
+    HashString(hash, desc.target);
+    HashBytes(hash, &desc.flags, sizeof(desc.flags));
+
+    for (const auto& attr : desc.streamOutput.format.attributes)
+    {
+        HashString(hash, attr.name);
+        HashBytes(hash, &attr.stream, sizeof(attr.stream));
+        HashBytes(hash, &attr.startComponent, sizeof(attr.startComponent));
+        HashBytes(hash, &attr.components, sizeof(attr.components));
+        HashBytes(hash, &attr.semanticIndex, sizeof(attr.semanticIndex));
+        HashBytes(hash, &attr.outputSlot, sizeof(attr.outputSlot));
+    }
+}
+
+// Returns the source code with the macros of the specified mask defined after the '#version' directive (if there is one).
+static std::string MakeVariantSource(const ShaderVariantSourceDescriptor& desc, std::uint64_t mask)
+{
+    std::string defines;
+
+    for (std::size_t i = 0; i < desc.defineKeys.size(); ++i)
+    {
+        if ((mask & (1ull << i)) != 0)
+        {
+            defines += "#define ";
+            defines += desc.defineKeys[i];
+            defines += " 1\n";
+        }
+    }
+
+    if (defines.empty())
+        return desc.sourceCode;
+
+    /* Find '#version' directive at the beginning of a line */
+    const auto& src = desc.sourceCode;
+    std::size_t insertPos = 0;
+
+    for (auto pos = src.find("#version"); pos != std::string::npos; pos = src.find("#version", pos + 1))
+    {
+        auto lineStart = src.find_last_not_of(" \t", pos == 0 ? std::string::npos : pos - 1);
+        if (pos == 0 || lineStart == std::string::npos || src[lineStart] == '\n')
+        {
+            auto lineEnd = src.find('\n', pos);
+            insertPos = (lineEnd != std::string::npos ? lineEnd + 1 : src.size());
+            break;
+        }
+    }
+
+    std::string result = src.substr(0, insertPos);
+    if (!result.empty() && result.back() != '\n')
+        result += '\n';
+    result += defines;
+    result.append(src, insertPos, std::string::npos);
+
+    return result;
+}
+
+template <typename T>
+static void WriteValue(std::vector<char>& data, const T& value)
+{
+    auto bytes = reinterpret_cast<const char*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+static bool ReadValue(const std::vector<char>& data, std::size_t& pos, T& value)
+{
+    if (pos + sizeof(T) > data.size())
+        return false;
+    std::memcpy(&value, &data[pos], sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+
+/* ----- ShaderVariantCache class ----- */
+
+ShaderVariantCache::ShaderVariantCache(RenderSystem& renderSystem) :
+    renderSystem_ { renderSystem }
+{
+}
+
+ShaderVariantCache::~ShaderVariantCache()
+{
+    Clear();
+}
+
+std::size_t ShaderVariantCache::AddSource(const ShaderVariantSourceDescriptor& desc)
+{
+    if (desc.defineKeys.size() > 64)
+        throw std::invalid_argument("cannot add shader variant source with more than 64 define keys");
+
+    for (const auto& src : sources_)
+    {
+        if (src.desc.name == desc.name)
+            throw std::invalid_argument("shader variant source already added: '" + desc.name + "'");
+    }
+
+    Source src;
+    {
+        src.desc = desc;
+        src.hash = HashInitValue();
+        HashShaderDescriptor(src.hash, desc.type, desc.shaderDesc);
+        HashString(src.hash, desc.sourceCode);
+        for (const auto& key : desc.defineKeys)
+            HashString(src.hash, key);
+    }
+    sources_.push_back(std::move(src));
+
+    return (sources_.size() - 1);
+}
+
+std::uint64_t ShaderVariantCache::MakeMask(std::size_t source, const std::vector<std::string>& defines) const
+{
+    const auto& keys = GetSource(source).desc.defineKeys;
+
+    std::uint64_t mask = 0;
+
+    for (const auto& define : defines)
+    {
+        auto it = std::find(keys.begin(), keys.end(), define);
+        if (it == keys.end())
+            throw std::invalid_argument("'" + define + "' is not a define key of shader variant source '" + GetSource(source).desc.name + "'");
+        mask |= (1ull << static_cast<std::uint64_t>(it - keys.begin()));
+    }
+
+    return mask;
+}
+
+Shader* ShaderVariantCache::GetVariant(std::size_t source, std::uint64_t mask)
+{
+    auto& variant = FindOrCompileVariant(source, mask, false);
+
+    /* Wait for pending pre-compilation */
+    ResolveVariant(variant);
+
+    if (variant.failed)
+    {
+        infoLog_ = variant.infoLog;
+        return nullptr;
+    }
+
+    return variant.shader;
+}
+
+void ShaderVariantCache::Precompile(std::size_t source, const std::vector<std::uint64_t>& masks)
+{
+    for (auto mask : masks)
+        FindOrCompileVariant(source, mask, true);
+}
+
+bool ShaderVariantCache::Load(const std::vector<char>& data)
+{
+    if (data.empty())
+        return true;
+
+    /* Read header */
+    std::size_t     pos         = 0;
+    std::uint32_t   magic       = 0;
+    std::uint32_t   version     = 0;
+    std::uint32_t   numEntries  = 0;
+
+    if (!ReadValue(data, pos, magic) || magic != g_variantListMagic)
+        return false;
+    if (!ReadValue(data, pos, version) || version != g_variantListVersion)
+        return false;
+    if (!ReadValue(data, pos, numEntries))
+        return false;
+
+    /* Read all entries before any compilation is started */
+    std::vector<std::vector<std::uint64_t>> masksPerSource(sources_.size());
+
+    for (std::uint32_t i = 0; i < numEntries; ++i)
+    {
+        std::uint32_t   nameLen = 0;
+        std::uint64_t   hash    = 0;
+        std::uint64_t   mask    = 0;
+
+        if (!ReadValue(data, pos, nameLen) || pos + nameLen > data.size())
+            return false;
+
+        std::string name(&data[pos], nameLen);
+        pos += nameLen;
+
+        if (!ReadValue(data, pos, hash) || !ReadValue(data, pos, mask))
+            return false;
+
+        /* Ignore entries of unknown or modified sources */
+        for (std::size_t j = 0; j < sources_.size(); ++j)
+        {
+            if (sources_[j].desc.name == name && sources_[j].hash == hash)
+            {
+                masksPerSource[j].push_back(mask);
+                break;
+            }
+        }
+    }
+
+    /* Start pre-compilation of all known variants */
+    for (std::size_t i = 0; i < masksPerSource.size(); ++i)
+        Precompile(i, masksPerSource[i]);
+
+    return true;
+}
+
+std::vector<char> ShaderVariantCache::Save() const
+{
+    std::uint32_t numEntries = 0;
+    for (const auto& src : sources_)
+        numEntries += static_cast<std::uint32_t>(src.variantHashes.size());
+
+    std::vector<char> data;
+
+    WriteValue(data, g_variantListMagic);
+    WriteValue(data, g_variantListVersion);
+    WriteValue(data, numEntries);
+
+    for (const auto& src : sources_)
+    {
+        for (const auto& entry : src.variantHashes)
+        {
+            WriteValue(data, static_cast<std::uint32_t>(src.desc.name.size()));
+            data.insert(data.end(), src.desc.name.begin(), src.desc.name.end());
+            WriteValue(data, src.hash);
+            WriteValue(data, entry.first);
+        }
+    }
+
+    return data;
+}
+
+void ShaderVariantCache::Clear()
+{
+    for (auto& entry : variants_)
+    {
+        auto& variant = entry.second;
+        if (variant.pending.valid())
+            variant.pending.wait();
+        if (variant.shader)
+            renderSystem_.Release(*variant.shader);
+    }
+
+    variants_.clear();
+
+    for (auto& src : sources_)
+        src.variantHashes.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+ShaderVariantCache::Variant& ShaderVariantCache::FindOrCompileVariant(std::size_t source, std::uint64_t mask, bool async)
+{
+    /* Validate source index */
+    GetSource(source);
+
+    auto& src = sources_[source];
+
+    /* Ignore bits that do not refer to a define key */
+    if (src.desc.defineKeys.size() < 64)
+        mask &= ((1ull << src.desc.defineKeys.size()) - 1);
+
+    /* Find variant that has already been used with this mask */
+    auto itHash = src.variantHashes.find(mask);
+    if (itHash != src.variantHashes.end())
+    {
+        ++stats_.numHits;
+        return variants_[itHash->second];
+    }
+
+    /* Find variant with equal final source and shader descriptor */
+    auto sourceCode = MakeVariantSource(src.desc, mask);
+
+    std::uint64_t hash = HashInitValue();
+    HashShaderDescriptor(hash, src.desc.type, src.desc.shaderDesc);
+    HashString(hash, sourceCode);
+
+    src.variantHashes[mask] = hash;
+
+    auto itVariant = variants_.find(hash);
+    if (itVariant != variants_.end())
+    {
+        ++stats_.numDeduplicated;
+        return itVariant->second;
+    }
+
+    /* Compile new variant */
+    auto& variant = variants_[hash];
+
+    variant.shader = renderSystem_.CreateShader(src.desc.type);
+    ++stats_.numCompiled;
+
+    if (async)
+        variant.pending = variant.shader->CompileAsync(sourceCode, src.desc.shaderDesc);
+    else
+    {
+        std::promise<bool> result;
+        result.set_value(variant.shader->Compile(sourceCode, src.desc.shaderDesc));
+        variant.pending = result.get_future().share();
+    }
+
+    return variant;
+}
+
+void ShaderVariantCache::ResolveVariant(Variant& variant)
+{
+    if (!variant.pending.valid())
+        return;
+
+    auto succeeded = variant.pending.get();
+    variant.pending = std::shared_future<bool>();
+
+    if (!succeeded)
+    {
+        /* Keep info log, but release the shader, so failed variants are not compiled again */
+        variant.failed  = true;
+        variant.infoLog = variant.shader->QueryInfoLog();
+        renderSystem_.Release(*variant.shader);
+        variant.shader  = nullptr;
+        ++stats_.numFailed;
+    }
+}
+
+const ShaderVariantCache::Source& ShaderVariantCache::GetSource(std::size_t source) const
+{
+    if (source >= sources_.size())
+        throw std::out_of_range("shader variant source index out of range: " + std::to_string(source));
+    return sources_[source];
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
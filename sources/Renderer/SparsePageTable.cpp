@@ -0,0 +1,145 @@
+/*
+ * SparsePageTable.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "SparsePageTable.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static unsigned int DivideRoundUp(unsigned int x, unsigned int y)
+{
+    return (x + y - 1) / y;
+}
+
+SparsePageTable::SparsePageTable(const Gs::Vector3ui& extent, bool layered, const Gs::Vector3ui& pageSize, unsigned int numSparseLevels) :
+    extent_   { extent   },
+    layered_  { layered  },
+    pageSize_ { pageSize }
+{
+    if (pageSize.x == 0 || pageSize.y == 0 || pageSize.z == 0)
+        throw std::invalid_argument("cannot create sparse page table with zero page size");
+
+    levels_.resize(numSparseLevels);
+
+    for (unsigned int mipLevel = 0; mipLevel < numSparseLevels; ++mipLevel)
+    {
+        auto& level = levels_[mipLevel];
+        auto levelExtent = GetLevelExtent(mipLevel);
+
+        level.numPages.x = DivideRoundUp(levelExtent.x, pageSize.x);
+        level.numPages.y = DivideRoundUp(levelExtent.y, pageSize.y);
+        level.numPages.z = DivideRoundUp(levelExtent.z, pageSize.z);
+        level.committed.resize(level.numPages.x * level.numPages.y * level.numPages.z, false);
+    }
+}
+
+void SparsePageTable::Commit(const TextureRegion& region, bool commit, const PageCallback& callback)
+{
+    if (region.mipLevel >= levels_.size())
+        return;
+
+    Gs::Vector3ui first, last;
+    GetPageRange(region, first, last);
+
+    /* Validate alignment, since partially covered pages would be (de)committed entirely */
+    auto levelExtent = GetLevelExtent(region.mipLevel);
+    auto end = region.offset + region.extent;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (region.offset[i] % pageSize_[i] != 0 || (end[i] % pageSize_[i] != 0 && end[i] != levelExtent[i]))
+            throw std::invalid_argument("sparse texture region is not aligned to the page size");
+    }
+
+    /* Update commitment of all pages within the range */
+    auto& level = levels_[region.mipLevel];
+
+    for (auto z = first.z; z < last.z; ++z)
+    {
+        for (auto y = first.y; y < last.y; ++y)
+        {
+            for (auto x = first.x; x < last.x; ++x)
+            {
+                auto index = (z * level.numPages.y + y) * level.numPages.x + x;
+                if (level.committed[index] != commit)
+                {
+                    callback(region.mipLevel, { x, y, z });
+                    level.committed[index] = commit;
+                    if (commit)
+                        ++numCommittedPages_;
+                    else
+                        --numCommittedPages_;
+                }
+            }
+        }
+    }
+}
+
+bool SparsePageTable::IsResident(const TextureRegion& region) const
+{
+    if (region.mipLevel >= levels_.size())
+        return true;
+
+    Gs::Vector3ui first, last;
+    GetPageRange(region, first, last);
+
+    const auto& level = levels_[region.mipLevel];
+
+    for (auto z = first.z; z < last.z; ++z)
+    {
+        for (auto y = first.y; y < last.y; ++y)
+        {
+            for (auto x = first.x; x < last.x; ++x)
+            {
+                if (!level.committed[(z * level.numPages.y + y) * level.numPages.x + x])
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+Gs::Vector3ui SparsePageTable::GetLevelExtent(unsigned int mipLevel) const
+{
+    return
+    {
+        std::max(1u, extent_.x >> mipLevel),
+        std::max(1u, extent_.y >> mipLevel),
+        (layered_ ? extent_.z : std::max(1u, extent_.z >> mipLevel))
+    };
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void SparsePageTable::GetPageRange(const TextureRegion& region, Gs::Vector3ui& first, Gs::Vector3ui& last) const
+{
+    auto levelExtent = GetLevelExtent(region.mipLevel);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (region.offset[i] + region.extent[i] > levelExtent[i])
+            throw std::out_of_range("sparse texture region exceeds MIP-map level");
+
+        first[i]    = region.offset[i] / pageSize_[i];
+        last[i]     = DivideRoundUp(region.offset[i] + region.extent[i], pageSize_[i]);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,105 @@
+/*
+ * SparsePageTable.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SPARSE_PAGE_TABLE_H
+#define LLGL_SPARSE_PAGE_TABLE_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/TextureFlags.h>
+#include <Gauss/Vector3.h>
+#include <functional>
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Backend independent page table of a sparse texture, which keeps track of the committed pages of each MIP-map level.
+\remarks The MIP-map levels starting at 'numSparseLevels' form the MIP-map tail, which is committed as a whole when the texture is created.
+For array textures, each array layer (or cube face) is a separate page in Z-direction, which does not shrink with the MIP-map levels.
+*/
+class LLGL_EXPORT SparsePageTable
+{
+
+    public:
+
+        // Callback that is invoked for each page whose commitment changes, with its MIP-map level and its coordinate (in pages).
+        using PageCallback = std::function<void(unsigned int mipLevel, const Gs::Vector3ui& page)>;
+
+        /**
+        \brief Initializes the page table with all pages being decommitted.
+        \param[in] extent Specifies the extent (in texels) of the first MIP-map level. For array textures, the last component is the number of layers.
+        \param[in] layered Specifies whether the last component of the extent are array layers.
+        \param[in] pageSize Specifies the extent (in texels) of a single page.
+        \param[in] numSparseLevels Specifies the number of MIP-map levels that can be committed page by page.
+        */
+        SparsePageTable(const Gs::Vector3ui& extent, bool layered, const Gs::Vector3ui& pageSize, unsigned int numSparseLevels);
+
+        /**
+        \brief Commits or decommits all pages the specified region overlaps with, and invokes the callback for each page whose commitment changes.
+        \remarks Regions within the MIP-map tail are ignored, since the tail is always resident.
+        \throws std::out_of_range If the region exceeds its MIP-map level.
+        \throws std::invalid_argument If the region is not aligned to the page size (except at the border of its MIP-map level).
+        */
+        void Commit(const TextureRegion& region, bool commit, const PageCallback& callback);
+
+        // Returns true if all pages the specified region overlaps with are committed.
+        bool IsResident(const TextureRegion& region) const;
+
+        // Returns the extent (in texels) of the specified MIP-map level, where the array layers are not reduced.
+        Gs::Vector3ui GetLevelExtent(unsigned int mipLevel) const;
+
+        // Returns the extent (in texels) of a single page.
+        inline const Gs::Vector3ui& GetPageSize() const
+        {
+            return pageSize_;
+        }
+
+        // Returns the number of MIP-map levels that can be committed page by page.
+        inline unsigned int GetNumSparseLevels() const
+        {
+            return static_cast<unsigned int>(levels_.size());
+        }
+
+        // Returns the number of pages that are currently committed (excluding the MIP-map tail).
+        inline std::size_t GetNumCommittedPages() const
+        {
+            return numCommittedPages_;
+        }
+
+    private:
+
+        struct Level
+        {
+            Gs::Vector3ui       numPages;
+            std::vector<bool>   committed;
+        };
+
+        // Returns the range of pages the region overlaps with as [first, last).
+        void GetPageRange(const TextureRegion& region, Gs::Vector3ui& first, Gs::Vector3ui& last) const;
+
+        Gs::Vector3ui       extent_;
+        bool                layered_            = false;
+        Gs::Vector3ui       pageSize_;
+        std::vector<Level>  levels_;
+        std::size_t         numCommittedPages_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
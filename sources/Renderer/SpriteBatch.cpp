@@ -0,0 +1,433 @@
+/*
+ * SpriteBatch.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/SpriteBatch.h>
+#include "../Core/Exception.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static bool IsGLSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::GLSL_110 && language <= ShadingLanguage::GLSL_460);
+}
+
+static bool IsESSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::GLSL_ES_100 && language <= ShadingLanguage::GLSL_ES_320);
+}
+
+static bool IsHLSL(const ShadingLanguage language)
+{
+    return (language >= ShadingLanguage::HLSL_4_0 && language <= ShadingLanguage::HLSL_5_1);
+}
+
+// Returns the version directive of the GLSL shaders, or an empty string if the shading language has no 2D array textures.
+static std::string GetGLSLVersion(const ShadingLanguage language)
+{
+    if (IsESSL(language))
+        return (language >= ShadingLanguage::GLSL_ES_300 ? "#version 300 es\nprecision mediump float;\nprecision mediump sampler2DArray;\n" : "");
+    else
+        return (language >= ShadingLanguage::GLSL_140 ? "#version 140\n" : "");
+}
+
+static const char* g_glslVertexShader =
+    "in vec2 corner;\n"
+    "in vec4 rect;\n"
+    "in vec4 texRect;\n"
+    "in float layer;\n"
+    "in vec4 color;\n"
+    "out vec3 vTexCoord;\n"
+    "out vec4 vColor;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = vec4(rect.xy + corner * rect.zw, 0.0, 1.0);\n"
+    "    vTexCoord = vec3(texRect.xy + corner * texRect.zw, layer + 0.5);\n"
+    "    vColor = color;\n"
+    "}\n"
+;
+
+static const char* g_glslFragmentShader =
+    "uniform sampler2DArray spriteTexture;\n"
+    "in vec3 vTexCoord;\n"
+    "in vec4 vColor;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    fragColor = vColor * texelFetch(spriteTexture, ivec3(vTexCoord), 0);\n"
+    "}\n"
+;
+
+static const char* g_hlslShader =
+    "Texture2DArray spriteTexture : register(t0);\n"
+    "struct VertexIn\n"
+    "{\n"
+    "    float2 corner   : CORNER;\n"
+    "    float4 rect     : RECT;\n"
+    "    float4 texRect  : TEXRECT;\n"
+    "    float  layer    : LAYER;\n"
+    "    float4 color    : COLOR;\n"
+    "};\n"
+    "struct VertexOut\n"
+    "{\n"
+    "    float4 position : SV_Position;\n"
+    "    float3 texCoord : TEXCOORD;\n"
+    "    float4 color    : COLOR;\n"
+    "};\n"
+    "VertexOut VS(VertexIn inp)\n"
+    "{\n"
+    "    VertexOut outp;\n"
+    "    outp.position = float4(inp.rect.xy + inp.corner * inp.rect.zw, 0.0, 1.0);\n"
+    "    outp.texCoord = float3(inp.texRect.xy + inp.corner * inp.texRect.zw, inp.layer + 0.5);\n"
+    "    outp.color = inp.color;\n"
+    "    return outp;\n"
+    "}\n"
+    "float4 PS(VertexOut inp) : SV_Target\n"
+    "{\n"
+    "    return inp.color * spriteTexture.Load(int4(int3(inp.texCoord), 0));\n"
+    "}\n"
+;
+
+SpriteBatch::SpriteBatch(RenderSystem& renderSystem, RenderContext& renderContext, const SpriteBatchDescriptor& desc) :
+    renderSystem_  { renderSystem  },
+    renderContext_ { renderContext },
+    desc_          { desc          }
+{
+    if (desc.maxSprites == 0 || desc.numFrames == 0)
+        throw std::invalid_argument("cannot create sprite batch with zero sprites or frames");
+
+    sprites_.reserve(desc.maxSprites);
+    instances_.reserve(desc.maxSprites);
+
+    CreateShaderProgram();
+    CreateGraphicsPipeline();
+    CreateBuffers();
+    CreateWhiteTexture();
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    if (instanceStream_ && vertexBuffer_)
+        instanceStream_->ReleaseBufferArrays(*vertexBuffer_);
+    instanceStream_.reset();
+    if (whiteTexture_)
+        renderSystem_.Release(*whiteTexture_);
+    if (vertexBuffer_)
+        renderSystem_.Release(*vertexBuffer_);
+    if (graphicsPipeline_)
+        renderSystem_.Release(*graphicsPipeline_);
+    if (shaderProgram_)
+        renderSystem_.Release(*shaderProgram_);
+    for (auto shader : shaders_)
+        renderSystem_.Release(*shader);
+}
+
+void SpriteBatch::Begin()
+{
+    sprites_.clear();
+}
+
+void SpriteBatch::Draw(
+    Texture&                    texture,
+    const TextureAtlasRegion&   region,
+    float                       x,
+    float                       y,
+    float                       width,
+    float                       height,
+    const ColorRGBAub&          color)
+{
+    if (sprites_.size() >= desc_.maxSprites)
+        return;
+
+    Sprite sprite;
+    {
+        sprite.texture              = &texture;
+        sprite.instance.rect[0]     = x;
+        sprite.instance.rect[1]     = y;
+        sprite.instance.rect[2]     = width;
+        sprite.instance.rect[3]     = height;
+        sprite.instance.texRect[0]  = static_cast<float>(region.x);
+        sprite.instance.texRect[1]  = static_cast<float>(region.y);
+        sprite.instance.texRect[2]  = static_cast<float>(region.width);
+        sprite.instance.texRect[3]  = static_cast<float>(region.height);
+        sprite.instance.layer       = static_cast<float>(region.layer);
+        sprite.instance.color       = color;
+    }
+    sprites_.push_back(sprite);
+}
+
+void SpriteBatch::DrawRect(float x, float y, float width, float height, const ColorRGBAub& color)
+{
+    /* Solid rectangles sample the single texel of the white texture */
+    TextureAtlasRegion region;
+    {
+        region.width    = 1;
+        region.height   = 1;
+    }
+    Draw(*whiteTexture_, region, x, y, width, height, color);
+}
+
+float SpriteBatch::DrawString(
+    const SpriteFont&   font,
+    float               x,
+    float               y,
+    const std::string&  text,
+    const ColorRGBAub&  color,
+    float               scale)
+{
+    if (font.texture == nullptr)
+        throw std::invalid_argument("cannot draw text with sprite font that has no texture");
+
+    /* Lines advance by the tallest glyph of the font */
+    unsigned int lineHeight = 0;
+    for (const auto& glyph : font.glyphs)
+        lineHeight = std::max(lineHeight, glyph.height);
+
+    const auto lineAdvance = (static_cast<float>(lineHeight) + font.spacing) * scale;
+
+    auto penX       = x;
+    auto penY       = y;
+    auto maxWidth   = 0.0f;
+
+    for (auto c : text)
+    {
+        if (c == '\n')
+        {
+            maxWidth = std::max(maxWidth, penX - x);
+            penX = x;
+            penY += lineAdvance;
+            continue;
+        }
+
+        /* Skip characters without glyph */
+        const auto index = static_cast<int>(c) - static_cast<int>(font.firstChar);
+        if (index < 0 || static_cast<std::size_t>(index) >= font.glyphs.size())
+            continue;
+
+        const auto& glyph   = font.glyphs[index];
+        const auto width    = static_cast<float>(glyph.width) * scale;
+
+        if (glyph.width > 0 && glyph.height > 0)
+            Draw(*font.texture, glyph, penX, penY, width, static_cast<float>(glyph.height) * scale, color);
+
+        penX += width + font.spacing * scale;
+    }
+
+    return std::max(maxWidth, penX - x);
+}
+
+void SpriteBatch::End(CommandBuffer& commandBuffer)
+{
+    numDrawCalls_ = 0;
+
+    const auto& resolution = renderContext_.GetVideoMode().resolution;
+    if (sprites_.empty() || resolution.x <= 0 || resolution.y <= 0)
+    {
+        sprites_.clear();
+        return;
+    }
+
+    /* Group sprites of the same texture, so all sprites of a texture atlas are drawn together */
+    if (desc_.sortByTexture)
+    {
+        std::stable_sort(
+            sprites_.begin(), sprites_.end(),
+            [](const Sprite& lhs, const Sprite& rhs)
+            {
+                return (lhs.texture < rhs.texture);
+            }
+        );
+    }
+
+    /* Convert pixel coordinates (with upper-left origin) into normalized device coordinates */
+    const auto pixelToNDCX = 2.0f / static_cast<float>(resolution.x);
+    const auto pixelToNDCY = 2.0f / static_cast<float>(resolution.y);
+
+    instances_.clear();
+    for (const auto& sprite : sprites_)
+    {
+        auto instance = sprite.instance;
+        {
+            instance.rect[0] = instance.rect[0] * pixelToNDCX - 1.0f;
+            instance.rect[1] = 1.0f - instance.rect[1] * pixelToNDCY;
+            instance.rect[2] = instance.rect[2] * pixelToNDCX;
+            instance.rect[3] = -instance.rect[3] * pixelToNDCY;
+        }
+        instances_.push_back(instance);
+    }
+
+    /* Stream all instances of this batch into the instance buffer of the current frame */
+    const auto range = instanceStream_->Append(instances_.data(), static_cast<std::uint32_t>(instances_.size()));
+    instanceStream_->Upload();
+
+    if (range.numInstances > 0)
+    {
+        commandBuffer.SetViewport(Viewport { 0.0f, 0.0f, static_cast<float>(resolution.x), static_cast<float>(resolution.y) });
+        commandBuffer.SetGraphicsPipeline(*graphicsPipeline_);
+        commandBuffer.SetVertexBufferArray(instanceStream_->GetBufferArray(*vertexBuffer_));
+
+        /* Record one instanced draw call per run of sprites with the same texture */
+        for (std::uint32_t first = 0, n = range.numInstances; first < n;)
+        {
+            auto texture = sprites_[first].texture;
+
+            auto last = first + 1;
+            while (last < n && sprites_[last].texture == texture)
+                ++last;
+
+            InstanceRange batchRange;
+            {
+                batchRange.firstInstance    = range.firstInstance + first;
+                batchRange.numInstances     = last - first;
+            }
+            commandBuffer.SetTexture(*texture, 0, ShaderStageFlags::FragmentStage);
+            instanceStream_->Draw(commandBuffer, batchRange, 4);
+            ++numDrawCalls_;
+
+            first = last;
+        }
+    }
+
+    instanceStream_->NextFrame();
+    sprites_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void SpriteBatch::CreateShaderProgram()
+{
+    const auto language = renderSystem_.GetRenderingCaps().shadingLanguage;
+
+    /* Select built-in shaders and vertex attribute names for the shading language */
+    std::string vertexSource, fragmentSource;
+    ShaderDescriptor vertexDesc, fragmentDesc;
+
+    if ((IsGLSL(language) || IsESSL(language)) && !GetGLSLVersion(language).empty())
+    {
+        vertexSource    = GetGLSLVersion(language) + g_glslVertexShader;
+        fragmentSource  = GetGLSLVersion(language) + g_glslFragmentShader;
+        vertexFormat_.AppendAttribute({ "corner", VectorType::Float2 });
+        instanceFormat_.AppendAttribute({ "rect",    VectorType::Float4,     1 });
+        instanceFormat_.AppendAttribute({ "texRect", VectorType::Float4,     1 });
+        instanceFormat_.AppendAttribute({ "layer",   VectorType::Float,      1 });
+        instanceFormat_.AppendAttribute({ "color",   VectorType::UByte4Norm, 1 });
+    }
+    else if (IsHLSL(language))
+    {
+        vertexSource    = g_hlslShader;
+        fragmentSource  = g_hlslShader;
+        vertexDesc      = ShaderDescriptor { "VS", "vs_4_0" };
+        fragmentDesc    = ShaderDescriptor { "PS", "ps_4_0" };
+        vertexFormat_.AppendAttribute({ "CORNER", VectorType::Float2 });
+        instanceFormat_.AppendAttribute({ "RECT",    VectorType::Float4,     1 });
+        instanceFormat_.AppendAttribute({ "TEXRECT", VectorType::Float4,     1 });
+        instanceFormat_.AppendAttribute({ "LAYER",   VectorType::Float,      1 });
+        instanceFormat_.AppendAttribute({ "COLOR",   VectorType::UByte4Norm, 1 });
+    }
+    else
+        ThrowNotSupported("sprite batch for the shading language of this render system");
+
+    /* Compile vertex and fragment shader */
+    shaderProgram_ = renderSystem_.CreateShaderProgram();
+
+    auto CompileShader = [&](const ShaderType type, const std::string& source, const ShaderDescriptor& shaderDesc)
+    {
+        auto shader = renderSystem_.CreateShader(type);
+        shaders_.push_back(shader);
+
+        if (!shader->Compile(source, shaderDesc))
+            throw std::runtime_error("failed to compile shader of sprite batch: " + shader->QueryInfoLog());
+
+        shaderProgram_->AttachShader(*shader);
+    };
+
+    CompileShader(ShaderType::Vertex, vertexSource, vertexDesc);
+    CompileShader(ShaderType::Fragment, fragmentSource, fragmentDesc);
+
+    /* Input layout with the quad corners in the first slot and the sprite instances in the second slot */
+    VertexFormat inputFormat = vertexFormat_;
+    inputFormat.AppendAttributes(instanceFormat_);
+
+    shaderProgram_->BuildInputLayout(inputFormat);
+
+    if (!shaderProgram_->LinkShaders())
+        throw std::runtime_error("failed to link shader program of sprite batch: " + shaderProgram_->QueryInfoLog());
+}
+
+void SpriteBatch::CreateGraphicsPipeline()
+{
+    /* Create pipeline with alpha blending and without depth test, so the sprites are drawn on top of the scene */
+    GraphicsPipelineDescriptor pipelineDesc;
+    {
+        pipelineDesc.shaderProgram                  = shaderProgram_;
+        pipelineDesc.primitiveTopology              = PrimitiveTopology::TriangleStrip;
+        pipelineDesc.rasterizer.multiSampling       = MultiSamplingDescriptor { desc_.samples };
+        pipelineDesc.blend.blendEnabled             = true;
+        pipelineDesc.blend.targets.resize(1);
+    }
+    graphicsPipeline_ = renderSystem_.CreateGraphicsPipeline(pipelineDesc);
+}
+
+void SpriteBatch::CreateBuffers()
+{
+    /* Create static vertex buffer with the corners of the unit quad as triangle strip */
+    static const float corners[] =
+    {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f,
+    };
+
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.type                 = BufferType::Vertex;
+        bufferDesc.size                 = sizeof(corners);
+        bufferDesc.vertexBuffer.format  = vertexFormat_;
+    }
+    vertexBuffer_ = renderSystem_.CreateBuffer(bufferDesc, corners);
+
+    /* Create instance stream with one instance per sprite */
+    InstanceStreamDescriptor streamDesc;
+    {
+        streamDesc.format       = instanceFormat_;
+        streamDesc.maxInstances = desc_.maxSprites;
+        streamDesc.numFrames    = desc_.numFrames;
+    }
+    instanceStream_ = std::unique_ptr<InstanceStream>(new InstanceStream(renderSystem_, streamDesc));
+}
+
+void SpriteBatch::CreateWhiteTexture()
+{
+    /* Create 1x1 white texture for solid rectangles, so they are drawn with the same shader */
+    static const ColorRGBAub white { 255, 255, 255, 255 };
+
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.type                = TextureType::Texture2DArray;
+        textureDesc.format              = TextureFormat::RGBA8;
+        textureDesc.texture2D.width     = 1;
+        textureDesc.texture2D.height    = 1;
+        textureDesc.texture2D.layers    = 1;
+    }
+    ImageDescriptor imageDesc { ImageFormat::RGBA, DataType::UInt8, &white };
+    whiteTexture_ = renderSystem_.CreateTexture(textureDesc, &imageDesc);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,136 @@
+/*
+ * TextureAtlas.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TextureAtlas.h>
+#include "AtlasPacker.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static std::unique_ptr<AtlasPacker> MakeAtlasPacker(const TextureAtlasPacking packing, const Gs::Vector2ui& size)
+{
+    if (packing == TextureAtlasPacking::Shelf)
+        return std::unique_ptr<AtlasPacker>(new ShelfPacker(size.x, size.y));
+    else
+        return std::unique_ptr<AtlasPacker>(new SkylinePacker(size.x, size.y));
+}
+
+TextureAtlas::TextureAtlas(RenderSystem& renderSystem, const TextureAtlasDescriptor& desc) :
+    renderSystem_ { renderSystem },
+    desc_         { desc         }
+{
+    if (desc.layerSize.x == 0 || desc.layerSize.y == 0 || desc.numLayers == 0)
+        throw std::invalid_argument("cannot create texture atlas with zero layers or zero layer size");
+
+    /* Create 2D array texture with all layers at once, so it never needs to be reallocated */
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.type                = TextureType::Texture2DArray;
+        textureDesc.format              = desc.format;
+        textureDesc.texture2D.width     = desc.layerSize.x;
+        textureDesc.texture2D.height    = desc.layerSize.y;
+        textureDesc.texture2D.layers    = desc.numLayers;
+    }
+    texture_ = renderSystem.CreateTexture(textureDesc);
+
+    /* Create packer for each layer */
+    for (unsigned int i = 0; i < desc.numLayers; ++i)
+        packers_.emplace_back(MakeAtlasPacker(desc.packing, desc.layerSize));
+
+    layerRegions_.resize(desc.numLayers, 0);
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    renderSystem_.Release(*texture_);
+}
+
+bool TextureAtlas::Allocate(const Gs::Vector2ui& size, TextureAtlasRegion& region)
+{
+    if (size.x == 0 || size.y == 0)
+        return false;
+
+    /* Reserve padding on all sides of the image */
+    auto paddedWidth    = size.x + desc_.padding * 2;
+    auto paddedHeight   = size.y + desc_.padding * 2;
+
+    for (unsigned int layer = 0; layer < desc_.numLayers; ++layer)
+    {
+        unsigned int x = 0, y = 0;
+        if (packers_[layer]->Insert(paddedWidth, paddedHeight, x, y))
+        {
+            region.x        = x + desc_.padding;
+            region.y        = y + desc_.padding;
+            region.width    = size.x;
+            region.height   = size.y;
+            region.layer    = layer;
+
+            /* Determine remapping of the texture coordinates into the layer */
+            auto invWidth   = 1.0f / static_cast<float>(desc_.layerSize.x);
+            auto invHeight  = 1.0f / static_cast<float>(desc_.layerSize.y);
+
+            region.uvOffset = Gs::Vector2f(static_cast<float>(region.x) * invWidth, static_cast<float>(region.y) * invHeight);
+            region.uvScale  = Gs::Vector2f(static_cast<float>(region.width) * invWidth, static_cast<float>(region.height) * invHeight);
+
+            ++layerRegions_[layer];
+            ++numRegions_;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TextureAtlas::Insert(const Gs::Vector2ui& size, const ImageDescriptor& imageDesc, TextureAtlasRegion& region)
+{
+    if (!Allocate(size, region))
+        return false;
+    Write(region, imageDesc);
+    return true;
+}
+
+void TextureAtlas::Write(const TextureAtlasRegion& region, const ImageDescriptor& imageDesc)
+{
+    SubTextureDescriptor subTextureDesc;
+    {
+        subTextureDesc.mipLevel                 = 0;
+        subTextureDesc.texture2D.x              = region.x;
+        subTextureDesc.texture2D.y              = region.y;
+        subTextureDesc.texture2D.layerOffset    = region.layer;
+        subTextureDesc.texture2D.width          = region.width;
+        subTextureDesc.texture2D.height         = region.height;
+        subTextureDesc.texture2D.layers         = 1;
+    }
+    renderSystem_.WriteTexture(*texture_, subTextureDesc, imageDesc);
+}
+
+void TextureAtlas::ClearLayer(unsigned int layer)
+{
+    if (layer >= desc_.numLayers)
+        throw std::out_of_range("texture atlas layer index out of range");
+
+    packers_[layer]->Reset();
+    numRegions_ -= layerRegions_[layer];
+    layerRegions_[layer] = 0;
+}
+
+void TextureAtlas::Clear()
+{
+    for (unsigned int layer = 0; layer < desc_.numLayers; ++layer)
+        ClearLayer(layer);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
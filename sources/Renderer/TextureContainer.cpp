@@ -0,0 +1,783 @@
+/*
+ * TextureContainer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TextureContainer.h>
+#include "../Platform/MappedFile.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- DDS file format ----- */
+
+static const std::uint32_t ddsMagic             = 0x20534444; // "DDS "
+
+static const std::uint32_t ddsFlagMipMapCount   = 0x00020000;
+static const std::uint32_t ddsFlagDepth         = 0x00800000;
+
+static const std::uint32_t ddsPixelFourCC       = 0x00000004;
+static const std::uint32_t ddsPixelRGB          = 0x00000040;
+static const std::uint32_t ddsPixelLuminance    = 0x00020000;
+
+static const std::uint32_t ddsCaps2Cubemap      = 0x00000200;
+static const std::uint32_t ddsCaps2Volume       = 0x00200000;
+
+static const std::uint32_t dx10Texture1D        = 2;
+static const std::uint32_t dx10Texture3D        = 4;
+static const std::uint32_t dx10MiscCube         = 0x00000004;
+
+struct DDSPixelFormat
+{
+    std::uint32_t size;
+    std::uint32_t flags;
+    std::uint32_t fourCC;
+    std::uint32_t rgbBitCount;
+    std::uint32_t rBitMask;
+    std::uint32_t gBitMask;
+    std::uint32_t bBitMask;
+    std::uint32_t aBitMask;
+};
+
+struct DDSHeader
+{
+    std::uint32_t   size;
+    std::uint32_t   flags;
+    std::uint32_t   height;
+    std::uint32_t   width;
+    std::uint32_t   pitchOrLinearSize;
+    std::uint32_t   depth;
+    std::uint32_t   mipMapCount;
+    std::uint32_t   reserved1[11];
+    DDSPixelFormat  pixelFormat;
+    std::uint32_t   caps;
+    std::uint32_t   caps2;
+    std::uint32_t   caps3;
+    std::uint32_t   caps4;
+    std::uint32_t   reserved2;
+};
+
+struct DDSHeaderDX10
+{
+    std::uint32_t dxgiFormat;
+    std::uint32_t resourceDimension;
+    std::uint32_t miscFlag;
+    std::uint32_t arraySize;
+    std::uint32_t miscFlags2;
+};
+
+/* ----- KTX2 file format ----- */
+
+static const unsigned char ktx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+struct KTX2Header
+{
+    std::uint32_t vkFormat;
+    std::uint32_t typeSize;
+    std::uint32_t pixelWidth;
+    std::uint32_t pixelHeight;
+    std::uint32_t pixelDepth;
+    std::uint32_t layerCount;
+    std::uint32_t faceCount;
+    std::uint32_t levelCount;
+    std::uint32_t supercompressionScheme;
+    std::uint32_t dfdByteOffset;
+    std::uint32_t dfdByteLength;
+    std::uint32_t kvdByteOffset;
+    std::uint32_t kvdByteLength;
+    std::uint64_t sgdByteOffset;
+    std::uint64_t sgdByteLength;
+};
+
+struct KTX2LevelIndex
+{
+    std::uint64_t byteOffset;
+    std::uint64_t byteLength;
+    std::uint64_t uncompressedByteLength;
+};
+
+
+/* ----- Internal functions ----- */
+
+[[noreturn]]
+static void ThrowTruncatedFile(const char* fileFormat)
+{
+    throw std::runtime_error("truncated " + std::string(fileFormat) + " file");
+}
+
+// Copies the structure at the specified offset, since the mapped file does not guarantee any alignment.
+template <typename T>
+static void ReadStruct(T& dst, const char* data, std::size_t size, std::size_t offset, const char* fileFormat)
+{
+    if (offset + sizeof(T) > size)
+        ThrowTruncatedFile(fileFormat);
+    std::memcpy(&dst, data + offset, sizeof(T));
+}
+
+static std::uint32_t MakeFourCC(char a, char b, char c, char d)
+{
+    return
+    (
+        (static_cast<std::uint32_t>(static_cast<unsigned char>(a))      ) |
+        (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) <<  8) |
+        (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16) |
+        (static_cast<std::uint32_t>(static_cast<unsigned char>(d)) << 24)
+    );
+}
+
+// Maps the DXGI_FORMAT of a DDS file with DX10 header. sRGB formats are mapped to their linear counterparts, since LLGL has no sRGB texture formats.
+static TextureFormat MapDXGIFormat(std::uint32_t format)
+{
+    switch (format)
+    {
+        case  2: return TextureFormat::RGBA32Float;
+        case  3: return TextureFormat::RGBA32UInt;
+        case  4: return TextureFormat::RGBA32SInt;
+        case  6: return TextureFormat::RGB32Float;
+        case  7: return TextureFormat::RGB32UInt;
+        case  8: return TextureFormat::RGB32SInt;
+        case 11: return TextureFormat::RGBA16;
+        case 13: return TextureFormat::RGBA16Sgn;
+        case 16: return TextureFormat::RG32Float;
+        case 17: return TextureFormat::RG32UInt;
+        case 18: return TextureFormat::RG32SInt;
+        case 28: return TextureFormat::RGBA8;
+        case 29: return TextureFormat::RGBA8;       // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+        case 31: return TextureFormat::RGBA8Sgn;
+        case 35: return TextureFormat::RG16;
+        case 37: return TextureFormat::RG16Sgn;
+        case 41: return TextureFormat::R32Float;
+        case 42: return TextureFormat::R32UInt;
+        case 43: return TextureFormat::R32SInt;
+        case 49: return TextureFormat::RG8;
+        case 51: return TextureFormat::RG8Sgn;
+        case 56: return TextureFormat::R16;
+        case 58: return TextureFormat::R16Sgn;
+        case 61: return TextureFormat::R8;
+        case 62: return TextureFormat::R8UInt;
+        case 63: return TextureFormat::R8Sgn;
+        case 71: return TextureFormat::RGBA_DXT1;
+        case 72: return TextureFormat::RGBA_DXT1;   // DXGI_FORMAT_BC1_UNORM_SRGB
+        case 74: return TextureFormat::RGBA_DXT3;
+        case 75: return TextureFormat::RGBA_DXT3;   // DXGI_FORMAT_BC2_UNORM_SRGB
+        case 77: return TextureFormat::RGBA_DXT5;
+        case 78: return TextureFormat::RGBA_DXT5;   // DXGI_FORMAT_BC3_UNORM_SRGB
+        case 80: return TextureFormat::R_BC4;
+        case 83: return TextureFormat::RG_BC5;
+        case 95: return TextureFormat::RGB_BC6H;
+        case 98: return TextureFormat::RGBA_BC7;
+        case 99: return TextureFormat::RGBA_BC7;    // DXGI_FORMAT_BC7_UNORM_SRGB
+        default: return TextureFormat::Unknown;
+    }
+}
+
+// Maps the legacy pixel format of a DDS file without DX10 header, and determines the order of the color components.
+static TextureFormat MapDDSPixelFormat(const DDSPixelFormat& pf, ImageFormat& imageFormat)
+{
+    if ((pf.flags & ddsPixelFourCC) != 0)
+    {
+        switch (pf.fourCC)
+        {
+            case  36: return TextureFormat::RGBA16;     // D3DFMT_A16B16G16R16
+            case 114: return TextureFormat::R32Float;   // D3DFMT_R32F
+            case 115: return TextureFormat::RG32Float;  // D3DFMT_G32R32F
+            case 116: return TextureFormat::RGBA32Float;// D3DFMT_A32B32G32R32F
+        }
+
+        if (pf.fourCC == MakeFourCC('D', 'X', 'T', '1'))
+            return TextureFormat::RGBA_DXT1;
+        if (pf.fourCC == MakeFourCC('D', 'X', 'T', '3'))
+            return TextureFormat::RGBA_DXT3;
+        if (pf.fourCC == MakeFourCC('D', 'X', 'T', '5'))
+            return TextureFormat::RGBA_DXT5;
+        if (pf.fourCC == MakeFourCC('A', 'T', 'I', '1') || pf.fourCC == MakeFourCC('B', 'C', '4', 'U'))
+            return TextureFormat::R_BC4;
+        if (pf.fourCC == MakeFourCC('A', 'T', 'I', '2') || pf.fourCC == MakeFourCC('B', 'C', '5', 'U'))
+            return TextureFormat::RG_BC5;
+    }
+    else if ((pf.flags & (ddsPixelRGB | ddsPixelLuminance)) != 0)
+    {
+        switch (pf.rgbBitCount)
+        {
+            case 8:
+                if (pf.rBitMask == 0xff)
+                    return TextureFormat::R8;
+                break;
+
+            case 16:
+                if (pf.rBitMask == 0xffff)
+                    return TextureFormat::R16;
+                if (pf.rBitMask == 0xff && pf.gBitMask == 0xff00)
+                    return TextureFormat::RG8;
+                break;
+
+            case 24:
+                if (pf.rBitMask == 0xff && pf.gBitMask == 0xff00 && pf.bBitMask == 0xff0000)
+                    return TextureFormat::RGB8;
+                if (pf.rBitMask == 0xff0000 && pf.gBitMask == 0xff00 && pf.bBitMask == 0xff)
+                {
+                    imageFormat = ImageFormat::BGR;
+                    return TextureFormat::RGB8;
+                }
+                break;
+
+            case 32:
+                if (pf.rBitMask == 0xff && pf.gBitMask == 0xff00 && pf.bBitMask == 0xff0000)
+                    return TextureFormat::RGBA8;
+                if (pf.rBitMask == 0xff0000 && pf.gBitMask == 0xff00 && pf.bBitMask == 0xff)
+                {
+                    imageFormat = ImageFormat::BGRA;
+                    return TextureFormat::RGBA8;
+                }
+                if (pf.rBitMask == 0xffff && pf.gBitMask == 0xffff0000)
+                    return TextureFormat::RG16;
+                break;
+        }
+    }
+    return TextureFormat::Unknown;
+}
+
+// Maps the VkFormat of a KTX2 file.
+static TextureFormat MapVkFormat(std::uint32_t format)
+{
+    switch (format)
+    {
+        case   9: return TextureFormat::R8;
+        case  10: return TextureFormat::R8Sgn;
+        case  13: return TextureFormat::R8UInt;
+        case  16: return TextureFormat::RG8;
+        case  17: return TextureFormat::RG8Sgn;
+        case  23: return TextureFormat::RGB8;
+        case  24: return TextureFormat::RGB8Sgn;
+        case  29: return TextureFormat::RGB8;           // VK_FORMAT_R8G8B8_SRGB
+        case  37: return TextureFormat::RGBA8;
+        case  38: return TextureFormat::RGBA8Sgn;
+        case  43: return TextureFormat::RGBA8;          // VK_FORMAT_R8G8B8A8_SRGB
+        case  70: return TextureFormat::R16;
+        case  71: return TextureFormat::R16Sgn;
+        case  77: return TextureFormat::RG16;
+        case  78: return TextureFormat::RG16Sgn;
+        case  84: return TextureFormat::RGB16;
+        case  85: return TextureFormat::RGB16Sgn;
+        case  91: return TextureFormat::RGBA16;
+        case  92: return TextureFormat::RGBA16Sgn;
+        case  98: return TextureFormat::R32UInt;
+        case  99: return TextureFormat::R32SInt;
+        case 100: return TextureFormat::R32Float;
+        case 101: return TextureFormat::RG32UInt;
+        case 102: return TextureFormat::RG32SInt;
+        case 103: return TextureFormat::RG32Float;
+        case 104: return TextureFormat::RGB32UInt;
+        case 105: return TextureFormat::RGB32SInt;
+        case 106: return TextureFormat::RGB32Float;
+        case 107: return TextureFormat::RGBA32UInt;
+        case 108: return TextureFormat::RGBA32SInt;
+        case 109: return TextureFormat::RGBA32Float;
+        case 131: return TextureFormat::RGB_DXT1;
+        case 132: return TextureFormat::RGB_DXT1;       // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+        case 133: return TextureFormat::RGBA_DXT1;
+        case 134: return TextureFormat::RGBA_DXT1;      // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        case 135: return TextureFormat::RGBA_DXT3;
+        case 136: return TextureFormat::RGBA_DXT3;      // VK_FORMAT_BC2_SRGB_BLOCK
+        case 137: return TextureFormat::RGBA_DXT5;
+        case 138: return TextureFormat::RGBA_DXT5;      // VK_FORMAT_BC3_SRGB_BLOCK
+        case 139: return TextureFormat::R_BC4;
+        case 141: return TextureFormat::RG_BC5;
+        case 143: return TextureFormat::RGB_BC6H;
+        case 145: return TextureFormat::RGBA_BC7;
+        case 146: return TextureFormat::RGBA_BC7;       // VK_FORMAT_BC7_SRGB_BLOCK
+        case 147: return TextureFormat::RGB_ETC2;
+        case 148: return TextureFormat::RGB_ETC2;       // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+        case 151: return TextureFormat::RGBA_ETC2;
+        case 152: return TextureFormat::RGBA_ETC2;      // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+        case 157: return TextureFormat::RGBA_ASTC4x4;
+        case 158: return TextureFormat::RGBA_ASTC4x4;   // VK_FORMAT_ASTC_4x4_SRGB_BLOCK
+        case 171: return TextureFormat::RGBA_ASTC8x8;
+        case 172: return TextureFormat::RGBA_ASTC8x8;   // VK_FORMAT_ASTC_8x8_SRGB_BLOCK
+        default:  return TextureFormat::Unknown;
+    }
+}
+
+// Returns the data type that describes the components of the specified texture format without conversion, or false if there is none.
+static bool GetFormatDataType(const TextureFormat format, DataType& dataType)
+{
+    switch (format)
+    {
+        case TextureFormat::R8:
+        case TextureFormat::R8UInt:
+        case TextureFormat::RG8:
+        case TextureFormat::RGB8:
+        case TextureFormat::RGBA8:
+            dataType = DataType::UInt8;
+            return true;
+
+        case TextureFormat::R8Sgn:
+        case TextureFormat::RG8Sgn:
+        case TextureFormat::RGB8Sgn:
+        case TextureFormat::RGBA8Sgn:
+            dataType = DataType::Int8;
+            return true;
+
+        case TextureFormat::R16:
+        case TextureFormat::RG16:
+        case TextureFormat::RGB16:
+        case TextureFormat::RGBA16:
+            dataType = DataType::UInt16;
+            return true;
+
+        case TextureFormat::R16Sgn:
+        case TextureFormat::RG16Sgn:
+        case TextureFormat::RGB16Sgn:
+        case TextureFormat::RGBA16Sgn:
+            dataType = DataType::Int16;
+            return true;
+
+        case TextureFormat::R32UInt:
+        case TextureFormat::RG32UInt:
+        case TextureFormat::RGB32UInt:
+        case TextureFormat::RGBA32UInt:
+            dataType = DataType::UInt32;
+            return true;
+
+        case TextureFormat::R32SInt:
+        case TextureFormat::RG32SInt:
+        case TextureFormat::RGB32SInt:
+        case TextureFormat::RGBA32SInt:
+            dataType = DataType::Int32;
+            return true;
+
+        case TextureFormat::R32Float:
+        case TextureFormat::RG32Float:
+        case TextureFormat::RGB32Float:
+        case TextureFormat::RGBA32Float:
+            dataType = DataType::Float;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static ImageFormat GetFormatComponents(const TextureFormat format)
+{
+    switch (format)
+    {
+        case TextureFormat::R8:
+        case TextureFormat::R8Sgn:
+        case TextureFormat::R8UInt:
+        case TextureFormat::R16:
+        case TextureFormat::R16Sgn:
+        case TextureFormat::R32UInt:
+        case TextureFormat::R32SInt:
+        case TextureFormat::R32Float:
+            return ImageFormat::R;
+
+        case TextureFormat::RG8:
+        case TextureFormat::RG8Sgn:
+        case TextureFormat::RG16:
+        case TextureFormat::RG16Sgn:
+        case TextureFormat::RG32UInt:
+        case TextureFormat::RG32SInt:
+        case TextureFormat::RG32Float:
+            return ImageFormat::RG;
+
+        case TextureFormat::RGB8:
+        case TextureFormat::RGB8Sgn:
+        case TextureFormat::RGB16:
+        case TextureFormat::RGB16Sgn:
+        case TextureFormat::RGB32UInt:
+        case TextureFormat::RGB32SInt:
+        case TextureFormat::RGB32Float:
+        case TextureFormat::RGB_DXT1:
+        case TextureFormat::R_BC4:
+        case TextureFormat::RG_BC5:
+        case TextureFormat::RGB_BC6H:
+        case TextureFormat::RGB_ETC2:
+            return ImageFormat::RGB;
+
+        default:
+            return ImageFormat::RGBA;
+    }
+}
+
+
+/* ----- TextureContainer class ----- */
+
+TextureContainer::TextureContainer(const std::string& filename) :
+    file_ { MappedFile::Open(filename) }
+{
+    auto data = static_cast<const char*>(file_->GetData());
+    auto size = file_->GetSize();
+
+    if (size >= sizeof(ddsMagic) && std::memcmp(data, &ddsMagic, sizeof(ddsMagic)) == 0)
+        ReadDDS(data, size);
+    else if (size >= sizeof(ktx2Identifier) && std::memcmp(data, ktx2Identifier, sizeof(ktx2Identifier)) == 0)
+        ReadKTX2(data, size);
+    else
+        throw std::runtime_error("unknown texture container format: \"" + filename + "\"");
+
+    ValidateSubresources(size);
+}
+
+TextureContainer::~TextureContainer()
+{
+    // Dummy (required for unique_ptr of forward declared MappedFile)
+}
+
+ImageDescriptor TextureContainer::GetImageDescriptor(unsigned int mipLevel, unsigned int layer) const
+{
+    const auto& subresource = GetSubresource(mipLevel, layer);
+    return MakeImageDescriptor(subresource.offset, subresource.size);
+}
+
+Texture* TextureContainer::CreateTexture(RenderSystem& renderSystem) const
+{
+    Texture* texture = nullptr;
+
+    if (levelMajor_ || numLayers_ == 1)
+    {
+        /* Upload all layers of each MIP-map level at once, since they are stored consecutively */
+        for (unsigned int mipLevel = 0; mipLevel < numMipLevels_; ++mipLevel)
+        {
+            const auto& subresource = GetSubresource(mipLevel, 0);
+            auto imageDesc = MakeImageDescriptor(subresource.offset, subresource.size * numLayers_);
+
+            if (mipLevel == 0)
+                texture = renderSystem.CreateTexture(desc_, &imageDesc);
+            else
+                renderSystem.WriteTexture(*texture, MakeSubTextureDescriptor(mipLevel, 0, numLayers_), imageDesc);
+        }
+    }
+    else
+    {
+        /* Upload each layer of each MIP-map level separately, since the MIP-map chains of each layer are stored consecutively */
+        texture = renderSystem.CreateTexture(desc_, nullptr);
+
+        for (unsigned int layer = 0; layer < numLayers_; ++layer)
+        {
+            for (unsigned int mipLevel = 0; mipLevel < numMipLevels_; ++mipLevel)
+                renderSystem.WriteTexture(*texture, MakeSubTextureDescriptor(mipLevel, layer, 1), GetImageDescriptor(mipLevel, layer));
+        }
+    }
+
+    return texture;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void TextureContainer::ReadDDS(const char* data, std::size_t size)
+{
+    DDSHeader header;
+    ReadStruct(header, data, size, sizeof(ddsMagic), "DDS");
+
+    std::size_t offset = sizeof(ddsMagic) + sizeof(DDSHeader);
+
+    /* Determine texture format */
+    TextureFormat format = TextureFormat::Unknown;
+    std::string formatName;
+
+    DDSHeaderDX10 headerDX10;
+    bool hasHeaderDX10 = ((header.pixelFormat.flags & ddsPixelFourCC) != 0 && header.pixelFormat.fourCC == MakeFourCC('D', 'X', '1', '0'));
+
+    if (hasHeaderDX10)
+    {
+        ReadStruct(headerDX10, data, size, offset, "DDS");
+        offset += sizeof(DDSHeaderDX10);
+        format      = MapDXGIFormat(headerDX10.dxgiFormat);
+        formatName  = "DXGI_FORMAT " + std::to_string(headerDX10.dxgiFormat);
+    }
+    else
+    {
+        format      = MapDDSPixelFormat(header.pixelFormat, imageFormat_);
+        formatName  = "DDS pixel format";
+    }
+
+    SetFormat(format, formatName);
+
+    /* Determine texture type and extent */
+    Gs::Vector3ui extent { std::max(1u, header.width), std::max(1u, header.height), 1u };
+
+    if (hasHeaderDX10)
+    {
+        auto arraySize = std::max(1u, headerDX10.arraySize);
+
+        if (headerDX10.resourceDimension == dx10Texture3D)
+        {
+            extent.z = std::max(1u, header.depth);
+            SetTypeAndExtent(TextureType::Texture3D, extent, 1);
+        }
+        else if (headerDX10.resourceDimension == dx10Texture1D)
+            SetTypeAndExtent((arraySize > 1 ? TextureType::Texture1DArray : TextureType::Texture1D), extent, arraySize);
+        else if ((headerDX10.miscFlag & dx10MiscCube) != 0)
+            SetTypeAndExtent((arraySize > 1 ? TextureType::TextureCubeArray : TextureType::TextureCube), extent, arraySize * 6);
+        else
+            SetTypeAndExtent((arraySize > 1 ? TextureType::Texture2DArray : TextureType::Texture2D), extent, arraySize);
+    }
+    else if ((header.caps2 & ddsCaps2Volume) != 0 || (header.flags & ddsFlagDepth) != 0)
+    {
+        extent.z = std::max(1u, header.depth);
+        SetTypeAndExtent(TextureType::Texture3D, extent, 1);
+    }
+    else if ((header.caps2 & ddsCaps2Cubemap) != 0)
+        SetTypeAndExtent(TextureType::TextureCube, extent, 6);
+    else
+        SetTypeAndExtent(TextureType::Texture2D, extent, 1);
+
+    if ((header.flags & ddsFlagMipMapCount) != 0)
+        numMipLevels_ = std::max(1u, header.mipMapCount);
+
+    /* Store the MIP-map chains of all layers consecutively */
+    levelMajor_ = false;
+    subresources_.resize(numLayers_ * numMipLevels_);
+
+    for (unsigned int layer = 0; layer < numLayers_; ++layer)
+    {
+        for (unsigned int mipLevel = 0; mipLevel < numMipLevels_; ++mipLevel)
+        {
+            auto& subresource = subresources_[layer * numMipLevels_ + mipLevel];
+            subresource.offset  = offset;
+            subresource.size    = GetLayerSize(mipLevel);
+            offset += subresource.size;
+        }
+    }
+}
+
+void TextureContainer::ReadKTX2(const char* data, std::size_t size)
+{
+    KTX2Header header;
+    ReadStruct(header, data, size, sizeof(ktx2Identifier), "KTX2");
+
+    if (header.supercompressionScheme != 0)
+        throw std::runtime_error("supercompressed KTX2 files are not supported");
+
+    SetFormat(MapVkFormat(header.vkFormat), "VkFormat " + std::to_string(header.vkFormat));
+
+    /* Determine texture type and extent */
+    Gs::Vector3ui extent { std::max(1u, header.pixelWidth), std::max(1u, header.pixelHeight), std::max(1u, header.pixelDepth) };
+    auto arraySize = std::max(1u, header.layerCount);
+
+    if (header.pixelDepth > 0)
+        SetTypeAndExtent(TextureType::Texture3D, extent, 1);
+    else if (header.faceCount == 6)
+        SetTypeAndExtent((header.layerCount > 0 ? TextureType::TextureCubeArray : TextureType::TextureCube), extent, arraySize * 6);
+    else if (header.pixelHeight == 0)
+        SetTypeAndExtent((header.layerCount > 0 ? TextureType::Texture1DArray : TextureType::Texture1D), extent, arraySize);
+    else
+        SetTypeAndExtent((header.layerCount > 0 ? TextureType::Texture2DArray : TextureType::Texture2D), extent, arraySize);
+
+    numMipLevels_ = std::max(1u, header.levelCount);
+
+    /* Store all layers of each MIP-map level consecutively at the offset of the level index */
+    levelMajor_ = true;
+    subresources_.resize(numLayers_ * numMipLevels_);
+
+    for (unsigned int mipLevel = 0; mipLevel < numMipLevels_; ++mipLevel)
+    {
+        KTX2LevelIndex levelIndex;
+        ReadStruct(levelIndex, data, size, sizeof(ktx2Identifier) + sizeof(KTX2Header) + mipLevel * sizeof(KTX2LevelIndex), "KTX2");
+
+        auto layerSize = GetLayerSize(mipLevel);
+        if (levelIndex.byteLength < layerSize * numLayers_)
+            ThrowTruncatedFile("KTX2");
+
+        for (unsigned int layer = 0; layer < numLayers_; ++layer)
+        {
+            auto& subresource = subresources_[layer * numMipLevels_ + mipLevel];
+            subresource.offset  = static_cast<std::size_t>(levelIndex.byteOffset) + layer * layerSize;
+            subresource.size    = layerSize;
+        }
+    }
+}
+
+void TextureContainer::SetFormat(const TextureFormat format, const std::string& formatName)
+{
+    if (format == TextureFormat::Unknown)
+        throw std::runtime_error("unsupported texture container format: " + formatName);
+
+    desc_.format = format;
+
+    if (IsCompressedFormat(format))
+    {
+        imageFormat_    = (GetFormatComponents(format) == ImageFormat::RGB ? ImageFormat::CompressedRGB : ImageFormat::CompressedRGBA);
+        dataType_       = DataType::UInt8;
+    }
+    else
+    {
+        /* Keep swizzled component order (e.g. BGRA) of legacy DDS pixel formats */
+        auto components = GetFormatComponents(format);
+        if (!(imageFormat_ == ImageFormat::BGR && components == ImageFormat::RGB) &&
+            !(imageFormat_ == ImageFormat::BGRA && components == ImageFormat::RGBA))
+        {
+            imageFormat_ = components;
+        }
+        GetFormatDataType(format, dataType_);
+    }
+}
+
+void TextureContainer::SetTypeAndExtent(const TextureType type, const Gs::Vector3ui& extent, unsigned int layers)
+{
+    desc_.type  = type;
+    numLayers_  = layers;
+
+    switch (type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            desc_.texture1D.width   = extent.x;
+            desc_.texture1D.layers  = layers;
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DArray:
+            desc_.texture2D.width   = extent.x;
+            desc_.texture2D.height  = extent.y;
+            desc_.texture2D.layers  = layers;
+            break;
+
+        case TextureType::Texture3D:
+            desc_.texture3D.width   = extent.x;
+            desc_.texture3D.height  = extent.y;
+            desc_.texture3D.depth   = extent.z;
+            break;
+
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            desc_.textureCube.width     = extent.x;
+            desc_.textureCube.height    = extent.y;
+            desc_.textureCube.layers    = layers / 6;
+            break;
+
+        default:
+            break;
+    }
+}
+
+Gs::Vector3ui TextureContainer::GetMipExtent(unsigned int mipLevel) const
+{
+    switch (desc_.type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            return { std::max(1u, desc_.texture1D.width >> mipLevel), 1u, 1u };
+
+        case TextureType::Texture3D:
+            return
+            {
+                std::max(1u, desc_.texture3D.width  >> mipLevel),
+                std::max(1u, desc_.texture3D.height >> mipLevel),
+                std::max(1u, desc_.texture3D.depth  >> mipLevel)
+            };
+
+        default:
+            return
+            {
+                std::max(1u, desc_.texture2D.width  >> mipLevel),
+                std::max(1u, desc_.texture2D.height >> mipLevel),
+                1u
+            };
+    }
+}
+
+std::size_t TextureContainer::GetLayerSize(unsigned int mipLevel) const
+{
+    auto extent = GetMipExtent(mipLevel);
+    if (IsCompressedFormat(desc_.format))
+        return CompressedImageSize(desc_.format, extent.x, extent.y, extent.z);
+    else
+        return static_cast<std::size_t>(extent.x) * extent.y * extent.z * TextureFormatSize(desc_.format);
+}
+
+void TextureContainer::ValidateSubresources(std::size_t fileSize) const
+{
+    for (const auto& subresource : subresources_)
+    {
+        if (subresource.offset > fileSize || subresource.size > fileSize - subresource.offset)
+            ThrowTruncatedFile(levelMajor_ ? "KTX2" : "DDS");
+    }
+}
+
+const TextureContainer::Subresource& TextureContainer::GetSubresource(unsigned int mipLevel, unsigned int layer) const
+{
+    if (mipLevel >= numMipLevels_)
+        throw std::out_of_range("MIP-map level out of range in texture container");
+    if (layer >= numLayers_)
+        throw std::out_of_range("array layer out of range in texture container");
+    return subresources_[layer * numMipLevels_ + mipLevel];
+}
+
+ImageDescriptor TextureContainer::MakeImageDescriptor(std::size_t offset, std::size_t size) const
+{
+    auto buffer = static_cast<const char*>(file_->GetData()) + offset;
+    if (IsCompressedFormat(imageFormat_))
+        return ImageDescriptor(imageFormat_, buffer, static_cast<unsigned int>(size));
+    else
+        return ImageDescriptor(imageFormat_, dataType_, buffer);
+}
+
+SubTextureDescriptor TextureContainer::MakeSubTextureDescriptor(unsigned int mipLevel, unsigned int firstLayer, unsigned int numLayers) const
+{
+    SubTextureDescriptor subTextureDesc;
+    subTextureDesc.mipLevel = mipLevel;
+
+    auto extent = GetMipExtent(mipLevel);
+
+    switch (desc_.type)
+    {
+        case TextureType::Texture1D:
+        case TextureType::Texture1DArray:
+            subTextureDesc.texture1D.x              = 0;
+            subTextureDesc.texture1D.layerOffset    = firstLayer;
+            subTextureDesc.texture1D.width          = extent.x;
+            subTextureDesc.texture1D.layers         = numLayers;
+            break;
+
+        case TextureType::Texture3D:
+            subTextureDesc.texture3D.x              = 0;
+            subTextureDesc.texture3D.y              = 0;
+            subTextureDesc.texture3D.z              = 0;
+            subTextureDesc.texture3D.width          = extent.x;
+            subTextureDesc.texture3D.height         = extent.y;
+            subTextureDesc.texture3D.depth          = extent.z;
+            break;
+
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            subTextureDesc.textureCube.x                = 0;
+            subTextureDesc.textureCube.y                = 0;
+            subTextureDesc.textureCube.layerOffset      = firstLayer / 6;
+            subTextureDesc.textureCube.width            = extent.x;
+            subTextureDesc.textureCube.height           = extent.y;
+            subTextureDesc.textureCube.cubeFaces        = numLayers;
+            subTextureDesc.textureCube.cubeFaceOffset   = static_cast<AxisDirection>(firstLayer % 6);
+            break;
+
+        default:
+            subTextureDesc.texture2D.x              = 0;
+            subTextureDesc.texture2D.y              = 0;
+            subTextureDesc.texture2D.layerOffset    = firstLayer;
+            subTextureDesc.texture2D.width          = extent.x;
+            subTextureDesc.texture2D.height         = extent.y;
+            subTextureDesc.texture2D.layers         = numLayers;
+            break;
+    }
+
+    return subTextureDesc;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -25,6 +25,120 @@ LLGL_EXPORT bool IsCompressedFormat(const TextureFormat format)
     return (format >= TextureFormat::RGB_DXT1);
 }
 
+// Returns the block width, block height, and block size (in bytes) of the specified compressed format.
+static bool GetCompressedBlockSize(const TextureFormat format, unsigned int& blockWidth, unsigned int& blockHeight, unsigned int& blockSize)
+{
+    blockWidth  = 4;
+    blockHeight = 4;
+
+    switch (format)
+    {
+        case TextureFormat::RGB_DXT1:
+        case TextureFormat::RGBA_DXT1:
+        case TextureFormat::R_BC4:
+        case TextureFormat::RGB_ETC2:
+            blockSize = 8;
+            return true;
+
+        case TextureFormat::RGBA_DXT3:
+        case TextureFormat::RGBA_DXT5:
+        case TextureFormat::RG_BC5:
+        case TextureFormat::RGB_BC6H:
+        case TextureFormat::RGBA_BC7:
+        case TextureFormat::RGBA_ETC2:
+        case TextureFormat::RGBA_ASTC4x4:
+            blockSize = 16;
+            return true;
+
+        case TextureFormat::RGBA_ASTC8x8:
+            blockWidth  = 8;
+            blockHeight = 8;
+            blockSize   = 16;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+LLGL_EXPORT unsigned int CompressedImageRowPitch(const TextureFormat format, unsigned int width)
+{
+    unsigned int blockWidth = 0, blockHeight = 0, blockSize = 0;
+    if (GetCompressedBlockSize(format, blockWidth, blockHeight, blockSize))
+        return ((width + blockWidth - 1) / blockWidth) * blockSize;
+    return 0;
+}
+
+LLGL_EXPORT unsigned int CompressedImageSize(const TextureFormat format, unsigned int width, unsigned int height, unsigned int depth)
+{
+    unsigned int blockWidth = 0, blockHeight = 0, blockSize = 0;
+    if (GetCompressedBlockSize(format, blockWidth, blockHeight, blockSize))
+        return ((width + blockWidth - 1) / blockWidth) * ((height + blockHeight - 1) / blockHeight) * depth * blockSize;
+    return 0;
+}
+
+LLGL_EXPORT unsigned int TextureFormatSize(const TextureFormat format)
+{
+    switch (format)
+    {
+        /* --- Base formats --- */
+        case TextureFormat::DepthComponent: return 4;
+        case TextureFormat::DepthStencil:   return 4;
+        case TextureFormat::R:              return 1;
+        case TextureFormat::RG:             return 2;
+        case TextureFormat::RGB:            return 3;
+        case TextureFormat::RGBA:           return 4;
+
+        /* --- Sized formats --- */
+        case TextureFormat::R8:             return 1;
+        case TextureFormat::R8Sgn:          return 1;
+        case TextureFormat::R8UInt:         return 1;
+
+        case TextureFormat::R16:            return 2;
+        case TextureFormat::R16Sgn:         return 2;
+        case TextureFormat::R16Float:       return 2;
+
+        case TextureFormat::R32UInt:        return 4;
+        case TextureFormat::R32SInt:        return 4;
+        case TextureFormat::R32Float:       return 4;
+
+        case TextureFormat::RG8:            return 2;
+        case TextureFormat::RG8Sgn:         return 2;
+
+        case TextureFormat::RG16:           return 4;
+        case TextureFormat::RG16Sgn:        return 4;
+        case TextureFormat::RG16Float:      return 4;
+
+        case TextureFormat::RG32UInt:       return 8;
+        case TextureFormat::RG32SInt:       return 8;
+        case TextureFormat::RG32Float:      return 8;
+
+        case TextureFormat::RGB8:           return 3;
+        case TextureFormat::RGB8Sgn:        return 3;
+
+        case TextureFormat::RGB16:          return 6;
+        case TextureFormat::RGB16Sgn:       return 6;
+        case TextureFormat::RGB16Float:     return 6;
+
+        case TextureFormat::RGB32UInt:      return 12;
+        case TextureFormat::RGB32SInt:      return 12;
+        case TextureFormat::RGB32Float:     return 12;
+
+        case TextureFormat::RGBA8:          return 4;
+        case TextureFormat::RGBA8Sgn:       return 4;
+
+        case TextureFormat::RGBA16:         return 8;
+        case TextureFormat::RGBA16Sgn:      return 8;
+        case TextureFormat::RGBA16Float:    return 8;
+
+        case TextureFormat::RGBA32UInt:     return 16;
+        case TextureFormat::RGBA32SInt:     return 16;
+        case TextureFormat::RGBA32Float:    return 16;
+
+        default:                            return 0;
+    }
+}
+
 LLGL_EXPORT bool IsDepthStencilFormat(const TextureFormat format)
 {
     return (format == TextureFormat::DepthComponent || format == TextureFormat::DepthStencil);
@@ -0,0 +1,96 @@
+/*
+ * TransientBufferAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "TransientBufferAllocator.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+static unsigned int AlignUp(unsigned int value, unsigned int alignment)
+{
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+TransientBufferAllocator::TransientBufferAllocator(unsigned int capacity, unsigned int alignment, unsigned int numSegments) :
+    alignment_   { std::max(1u, alignment)   },
+    numSegments_ { std::max(2u, numSegments) }
+{
+    /* Round segment size down to the offset alignment */
+    segmentSize_    = (capacity / numSegments_ / alignment_) * alignment_;
+    capacity_       = segmentSize_ * numSegments_;
+
+    if (segmentSize_ == 0)
+        throw std::invalid_argument("capacity of transient buffer is too small for " + std::to_string(numSegments_) + " segments");
+}
+
+TransientBufferRange TransientBufferAllocator::Write(const void* data, std::size_t dataSize)
+{
+    /* Validate size of the data block */
+    if (dataSize == 0 || dataSize > segmentSize_)
+    {
+        throw std::invalid_argument(
+            "invalid size of transient buffer data (" + std::to_string(dataSize) +
+            " bytes, but limit is " + std::to_string(segmentSize_) + " bytes)"
+        );
+    }
+
+    auto size   = AlignUp(static_cast<unsigned int>(dataSize), alignment_);
+    auto offset = offset_;
+
+    /* Wrap around to the beginning if the range does not fit into the remaining space */
+    if (offset + size > capacity_)
+        offset = 0;
+
+    /* Move through all segments the write position passes */
+    auto lastSegment = (offset + size - 1) / segmentSize_;
+
+    while (currentSegment_ != lastSegment)
+    {
+        OnLeaveSegment(currentSegment_);
+        currentSegment_ = (currentSegment_ + 1) % numSegments_;
+        OnEnterSegment(currentSegment_);
+    }
+
+    WriteRange(data, static_cast<unsigned int>(dataSize), offset);
+    offset_ = offset + size;
+
+    /* Return allocated range */
+    TransientBufferRange range;
+    {
+        range.buffer    = &(GetBuffer());
+        range.offset    = offset;
+        range.size      = size;
+    }
+    return range;
+}
+
+
+/*
+ * ======= Protected: =======
+ */
+
+void TransientBufferAllocator::OnLeaveSegment(unsigned int /*segment*/)
+{
+    // dummy
+}
+
+void TransientBufferAllocator::OnEnterSegment(unsigned int /*segment*/)
+{
+    // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
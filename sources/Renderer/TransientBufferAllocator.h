@@ -0,0 +1,89 @@
+/*
+ * TransientBufferAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TRANSIENT_BUFFER_ALLOCATOR_H
+#define LLGL_TRANSIENT_BUFFER_ALLOCATOR_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/BufferFlags.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Backend independent base class for ring buffers that hand out transient buffer ranges.
+\remarks The ring buffer is divided into equally sized segments. Whenever the write position leaves a segment,
+the "OnLeaveSegment" callback is invoked (e.g. to insert a fence), and whenever it enters a segment,
+the "OnEnterSegment" callback is invoked (e.g. to wait until the GPU no longer references that segment).
+*/
+class LLGL_EXPORT TransientBufferAllocator
+{
+
+    public:
+
+        virtual ~TransientBufferAllocator() = default;
+
+        /**
+        \brief Writes the specified data into the next free range of the ring buffer and returns that range.
+        \throws std::invalid_argument If 'dataSize' is zero or greater than the segment size.
+        */
+        TransientBufferRange Write(const void* data, std::size_t dataSize);
+
+        // Returns the buffer all ranges are allocated from.
+        virtual Buffer& GetBuffer() = 0;
+
+    protected:
+
+        /**
+        \brief Initializes the ring buffer allocator.
+        \param[in] capacity Specifies the size (in bytes) of the entire ring buffer.
+        This will be rounded down to a multiple of 'alignment' times 'numSegments'.
+        \param[in] alignment Specifies the offset alignment (in bytes) of each range.
+        \param[in] numSegments Specifies the number of segments the ring buffer is divided into. This must be at least 2.
+        */
+        TransientBufferAllocator(unsigned int capacity, unsigned int alignment, unsigned int numSegments);
+
+        // Is called when the write position leaves the specified segment.
+        virtual void OnLeaveSegment(unsigned int segment);
+
+        // Is called when the write position enters the specified segment, before any data is written into it.
+        virtual void OnEnterSegment(unsigned int segment);
+
+        // Writes the data into the specified range of the buffer.
+        virtual void WriteRange(const void* data, unsigned int size, unsigned int offset) = 0;
+
+        // Returns the size (in bytes) of the entire ring buffer.
+        inline unsigned int GetCapacity() const
+        {
+            return capacity_;
+        }
+
+    private:
+
+        unsigned int alignment_         = 1;
+        unsigned int numSegments_       = 2;
+        unsigned int segmentSize_       = 0;
+        unsigned int capacity_          = 0;
+
+        unsigned int offset_            = 0;
+        unsigned int currentSegment_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
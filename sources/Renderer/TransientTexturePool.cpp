@@ -0,0 +1,187 @@
+/*
+ * TransientTexturePool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TransientTexturePool.h>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static bool operator == (const TransientTextureDescriptor& lhs, const TransientTextureDescriptor& rhs)
+{
+    return (lhs.size == rhs.size && lhs.format == rhs.format && std::max(1u, lhs.samples) == std::max(1u, rhs.samples));
+}
+
+TransientTexturePool::TransientTexturePool(RenderSystem& renderSystem, unsigned int maxUnusedFrames) :
+    renderSystem_    { renderSystem    },
+    maxUnusedFrames_ { maxUnusedFrames }
+{
+}
+
+TransientTexturePool::~TransientTexturePool()
+{
+    Clear();
+}
+
+TransientTarget TransientTexturePool::Acquire(const TransientTextureDescriptor& desc)
+{
+    if (desc.size.x == 0 || desc.size.y == 0)
+        throw std::invalid_argument("cannot acquire transient texture with zero size");
+
+    /* Find free entry with equal descriptor */
+    auto it = std::find_if(
+        entries_.begin(), entries_.end(),
+        [&desc](const Entry& entry)
+        {
+            return (!entry.inUse && entry.desc == desc);
+        }
+    );
+
+    if (it == entries_.end())
+    {
+        entries_.push_back(CreateEntry(desc));
+        it = entries_.end() - 1;
+    }
+
+    /* Mark entry as used in the current frame */
+    it->inUse       = true;
+    it->lastFrame   = frame_;
+
+    TransientTarget target;
+    {
+        target.texture      = it->texture;
+        target.renderTarget = it->renderTarget;
+    }
+    return target;
+}
+
+void TransientTexturePool::Release(const TransientTarget& target)
+{
+    auto it = std::find_if(
+        entries_.begin(), entries_.end(),
+        [&target](const Entry& entry)
+        {
+            return (entry.texture == target.texture);
+        }
+    );
+
+    if (it == entries_.end() || !it->inUse)
+        throw std::invalid_argument("cannot release transient target that has not been acquired from this pool");
+
+    it->inUse = false;
+}
+
+void TransientTexturePool::NextFrame()
+{
+    /* Release all entries that have not been used for too many frames */
+    auto it = std::remove_if(
+        entries_.begin(), entries_.end(),
+        [this](Entry& entry)
+        {
+            if (frame_ - entry.lastFrame >= maxUnusedFrames_)
+            {
+                ReleaseEntry(entry);
+                return true;
+            }
+            return false;
+        }
+    );
+    entries_.erase(it, entries_.end());
+
+    /* Make all remaining entries available for the next frame */
+    for (auto& entry : entries_)
+        entry.inUse = false;
+
+    ++frame_;
+}
+
+void TransientTexturePool::Clear()
+{
+    for (auto& entry : entries_)
+        ReleaseEntry(entry);
+    entries_.clear();
+}
+
+std::size_t TransientTexturePool::GetNumTexturesInUse() const
+{
+    return static_cast<std::size_t>(
+        std::count_if(
+            entries_.begin(), entries_.end(),
+            [](const Entry& entry)
+            {
+                return entry.inUse;
+            }
+        )
+    );
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+TransientTexturePool::Entry TransientTexturePool::CreateEntry(const TransientTextureDescriptor& desc)
+{
+    Entry entry;
+    entry.desc = desc;
+
+    /* Create texture */
+    const auto samples = std::max(1u, desc.samples);
+
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.format = desc.format;
+
+        if (samples > 1)
+        {
+            textureDesc.type                        = TextureType::Texture2DMS;
+            textureDesc.texture2DMS.width           = desc.size.x;
+            textureDesc.texture2DMS.height          = desc.size.y;
+            textureDesc.texture2DMS.layers          = 1;
+            textureDesc.texture2DMS.samples         = samples;
+            textureDesc.texture2DMS.fixedSamples    = true;
+        }
+        else
+        {
+            textureDesc.type                        = TextureType::Texture2D;
+            textureDesc.texture2D.width             = desc.size.x;
+            textureDesc.texture2D.height            = desc.size.y;
+            textureDesc.texture2D.layers            = 1;
+        }
+    }
+    entry.texture = renderSystem_.CreateTexture(textureDesc);
+
+    /* Create render target and attach the texture */
+    RenderTargetDescriptor renderTargetDesc;
+    {
+        renderTargetDesc.multiSampling          = MultiSamplingDescriptor { samples };
+        renderTargetDesc.customMultiSampling    = (samples > 1);
+    }
+    entry.renderTarget = renderSystem_.CreateRenderTarget(renderTargetDesc);
+    entry.renderTarget->AttachTexture(*entry.texture, {});
+
+    return entry;
+}
+
+void TransientTexturePool::ReleaseEntry(Entry& entry)
+{
+    /* Release render target before its attachment */
+    if (entry.renderTarget)
+        renderSystem_.Release(*entry.renderTarget);
+    if (entry.texture)
+        renderSystem_.Release(*entry.texture);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,317 @@
+/*
+ * UploadQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/UploadQueue.h>
+#include "../Platform/AsyncFileRead.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Returns the number of image elements of the specified sub-texture region.
+static std::size_t GetSubTextureNumElements(const TextureType type, const SubTextureDescriptor& desc)
+{
+    switch (type)
+    {
+        case TextureType::Texture1D:
+            return desc.texture1D.width;
+        case TextureType::Texture1DArray:
+            return desc.texture1D.width * desc.texture1D.layers;
+        case TextureType::Texture2D:
+            return desc.texture2D.width * desc.texture2D.height;
+        case TextureType::Texture2DArray:
+            return desc.texture2D.width * desc.texture2D.height * desc.texture2D.layers;
+        case TextureType::Texture3D:
+            return desc.texture3D.width * desc.texture3D.height * desc.texture3D.depth;
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+            return desc.textureCube.width * desc.textureCube.height * desc.textureCube.cubeFaces;
+        default:
+            break;
+    }
+    throw std::invalid_argument("can not upload image data to multi-sampled texture");
+}
+
+// Returns the size (in bytes) of the image data that is written into the sub-texture region.
+static std::size_t GetImageDataSize(const Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    if (IsCompressedFormat(imageDesc.format))
+    {
+        if (imageDesc.compressedSize == 0)
+            throw std::invalid_argument("compressed image size must be specified for texture upload");
+        return imageDesc.compressedSize;
+    }
+    return GetSubTextureNumElements(texture.GetType(), subTextureDesc) * imageDesc.GetElementSize();
+}
+
+UploadQueue::UploadQueue(RenderSystem& renderSystem, const UploadQueueDescriptor& desc) :
+    renderSystem_ { renderSystem },
+    desc_         { desc         }
+{
+}
+
+UploadQueue::~UploadQueue()
+{
+    for (const auto& upload : inFlightUploads_)
+    {
+        if (upload.fence)
+            renderSystem_.Release(*upload.fence);
+    }
+}
+
+std::uint64_t UploadQueue::WriteBuffer(Buffer& buffer, const void* data, std::size_t dataSize, std::size_t offset)
+{
+    Upload upload;
+    {
+        upload.buffer   = &buffer;
+        upload.offset   = offset;
+        upload.dataSize = dataSize;
+    }
+    return Submit(std::move(upload), data);
+}
+
+std::uint64_t UploadQueue::WriteTexture(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc)
+{
+    Upload upload;
+    {
+        upload.texture          = &texture;
+        upload.subTextureDesc   = subTextureDesc;
+        upload.imageDesc        = imageDesc;
+        upload.dataSize         = GetImageDataSize(texture, subTextureDesc, imageDesc);
+    }
+    return Submit(std::move(upload), imageDesc.buffer);
+}
+
+std::uint64_t UploadQueue::WriteBufferFromFile(Buffer& buffer, const std::string& filename, std::uint64_t fileOffset, std::size_t dataSize, std::size_t offset)
+{
+    Upload upload;
+    {
+        upload.buffer   = &buffer;
+        upload.offset   = offset;
+        upload.dataSize = dataSize;
+    }
+    return SubmitFromFile(std::move(upload), filename, fileOffset);
+}
+
+std::uint64_t UploadQueue::WriteTextureFromFile(Texture& texture, const SubTextureDescriptor& subTextureDesc, const ImageDescriptor& imageDesc, const std::string& filename, std::uint64_t fileOffset)
+{
+    Upload upload;
+    {
+        upload.texture          = &texture;
+        upload.subTextureDesc   = subTextureDesc;
+        upload.imageDesc        = imageDesc;
+        upload.dataSize         = GetImageDataSize(texture, subTextureDesc, imageDesc);
+    }
+    return SubmitFromFile(std::move(upload), filename, fileOffset);
+}
+
+std::uint64_t UploadQueue::Flush()
+{
+    return ExecuteUploads(desc_.maxBytesPerFlush, false);
+}
+
+std::uint64_t UploadQueue::FlushAll()
+{
+    return ExecuteUploads(0, true);
+}
+
+std::size_t UploadQueue::GetNumPendingUploads() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pendingUploads_.size();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+UploadQueue::StagingBlock UploadQueue::AcquireStagingBlock(std::size_t size)
+{
+    /* Find smallest staging block in the pool that is large enough */
+    auto it = stagingPool_.end();
+
+    for (auto block = stagingPool_.begin(); block != stagingPool_.end(); ++block)
+    {
+        if (block->capacity() >= size && (it == stagingPool_.end() || block->capacity() < it->capacity()))
+            it = block;
+    }
+
+    StagingBlock block;
+
+    if (it != stagingPool_.end())
+    {
+        /* Take staging block from the pool */
+        stagingPoolSize_ -= it->capacity();
+        block = std::move(*it);
+        stagingPool_.erase(it);
+    }
+
+    block.resize(size);
+
+    return block;
+}
+
+void UploadQueue::ReleaseStagingBlock(StagingBlock&& block)
+{
+    /* Return staging block to the pool, if the pool limit has not been reached */
+    if (stagingPoolSize_ + block.capacity() <= desc_.maxStagingPoolSize)
+    {
+        stagingPoolSize_ += block.capacity();
+        stagingPool_.push_back(std::move(block));
+    }
+}
+
+std::uint64_t UploadQueue::Submit(Upload&& upload, const void* data)
+{
+    /* Acquire staging memory */
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        upload.staging = AcquireStagingBlock(upload.dataSize);
+    }
+
+    /* Copy data into staging memory outside the lock, so other threads can submit uploads concurrently */
+    if (data != nullptr && upload.dataSize > 0)
+        ::memcpy(upload.staging.data(), data, upload.dataSize);
+
+    /* Assign ticket and append upload while locked, so the tickets are in submission order */
+    std::lock_guard<std::mutex> lock(mutex_);
+    upload.ticket = nextTicket_++;
+    pendingUploads_.push_back(std::move(upload));
+    return pendingUploads_.back().ticket;
+}
+
+std::uint64_t UploadQueue::SubmitFromFile(Upload&& upload, const std::string& filename, std::uint64_t fileOffset)
+{
+    /* Acquire staging memory */
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        upload.staging = AcquireStagingBlock(upload.dataSize);
+    }
+
+    /* Start reading the file directly into staging memory; the staging block keeps its address when the upload is moved */
+    if (upload.dataSize > 0)
+    {
+        try
+        {
+            upload.fileRead = AsyncFileRead::Start(filename, fileOffset, upload.dataSize, upload.staging.data());
+        }
+        catch (const std::exception&)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ReleaseStagingBlock(std::move(upload.staging));
+            throw;
+        }
+    }
+
+    /* Assign ticket and append upload while locked, so the tickets are in submission order */
+    std::lock_guard<std::mutex> lock(mutex_);
+    upload.ticket = nextTicket_++;
+    pendingUploads_.push_back(std::move(upload));
+    return pendingUploads_.back().ticket;
+}
+
+std::uint64_t UploadQueue::ExecuteUploads(std::size_t maxBytes, bool waitForCompletion)
+{
+    std::size_t numBytes = 0;
+
+    while (true)
+    {
+        /* Take next pending upload */
+        Upload upload;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (pendingUploads_.empty())
+                break;
+            if (maxBytes > 0 && numBytes > 0 && numBytes + pendingUploads_.front().dataSize > maxBytes)
+                break;
+
+            /* Keep submission order, so stop at the first upload whose file read is still in flight */
+            if (!waitForCompletion && pendingUploads_.front().fileRead && !pendingUploads_.front().fileRead->Poll())
+                break;
+
+            upload = std::move(pendingUploads_.front());
+            pendingUploads_.pop_front();
+        }
+
+        /* Wait until the file has been read into staging memory */
+        if (upload.fileRead && !upload.fileRead->Wait())
+        {
+            /* Complete the failed upload in order with the uploads that are still in flight */
+            upload.fileRead.reset();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ReleaseStagingBlock(std::move(upload.staging));
+            }
+            InFlightUpload failedUpload;
+            failedUpload.ticket = upload.ticket;
+            inFlightUploads_.push_back(failedUpload);
+            CompleteUploads(waitForCompletion);
+            throw std::runtime_error("failed to read upload data from file");
+        }
+        upload.fileRead.reset();
+
+        ExecuteUpload(upload);
+        numBytes += upload.dataSize;
+
+        /* Recycle staging memory, since the render system has copied the data into its own staging buffer */
+        std::lock_guard<std::mutex> lock(mutex_);
+        ReleaseStagingBlock(std::move(upload.staging));
+    }
+
+    CompleteUploads(waitForCompletion);
+
+    return completedTicket_.load();
+}
+
+void UploadQueue::ExecuteUpload(Upload& upload)
+{
+    /* Execute upload from staging memory without waiting for the GPU */
+    InFlightUpload inFlightUpload;
+    inFlightUpload.ticket = upload.ticket;
+
+    if (upload.buffer)
+        inFlightUpload.fence = renderSystem_.WriteBufferAsync(*upload.buffer, upload.staging.data(), upload.dataSize, upload.offset);
+    else if (upload.texture)
+    {
+        upload.imageDesc.buffer = upload.staging.data();
+        inFlightUpload.fence = renderSystem_.WriteTextureAsync(*upload.texture, upload.subTextureDesc, upload.imageDesc);
+    }
+
+    inFlightUploads_.push_back(inFlightUpload);
+}
+
+void UploadQueue::CompleteUploads(bool waitForCompletion)
+{
+    /* The GPU finishes the uploads in submission order, so stop at the first fence that has not been signaled yet */
+    while (!inFlightUploads_.empty())
+    {
+        auto& upload = inFlightUploads_.front();
+
+        if (upload.fence)
+        {
+            if (waitForCompletion ? !upload.fence->Wait() : !upload.fence->IsSignaled())
+                break;
+            renderSystem_.Release(*upload.fence);
+        }
+
+        completedTicket_.store(upload.ticket);
+        inFlightUploads_.pop_front();
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -7,6 +7,9 @@
 
 #include <LLGL/VertexFormat.h>
 #include <LLGL/RenderSystemFlags.h>
+#include "../Core/Hash.h"
+#include <unordered_map>
+#include <mutex>
 #include <stdexcept>
 #include <sstream>
 
@@ -22,6 +25,23 @@ static void UpdateStride(VertexFormat& vertexFormat)
         vertexFormat.stride = std::max(vertexFormat.stride, attr.offset + attr.GetSize());
 }
 
+// Returns the unique ID of the specified attribute name; IDs are never released, since vertex attribute names are typically few.
+static std::uint32_t InternAttributeName(const std::string& name)
+{
+    static std::mutex                                       internMutex;
+    static std::unordered_map<std::string, std::uint32_t>   internedNames;
+
+    std::lock_guard<std::mutex> guard { internMutex };
+
+    auto it = internedNames.find(name);
+    if (it != internedNames.end())
+        return it->second;
+
+    auto id = static_cast<std::uint32_t>(internedNames.size());
+    internedNames[name] = id;
+    return id;
+}
+
 void VertexFormat::AppendAttribute(const VertexAttribute& attrib, unsigned int offset)
 {
     /* Append attribute to the list */
@@ -64,6 +84,8 @@ void VertexFormat::AppendAttribute(const VertexAttribute& attrib, unsigned int o
     }
     else
         attr.inputSlot = 0;
+
+    UpdateLayout();
 }
 
 void VertexFormat::AppendAttributes(const VertexFormat& format)
@@ -72,6 +94,38 @@ void VertexFormat::AppendAttributes(const VertexFormat& format)
         AppendAttribute(attr, attr.offset);
 }
 
+void VertexFormat::UpdateLayout()
+{
+    /* Store one record per attribute with the same members that are compared by the equality operator of VertexAttribute */
+    compactLayout.clear();
+    compactLayout.reserve(attributes.size() * 7);
+
+    for (const auto& attr : attributes)
+    {
+        compactLayout.push_back(InternAttributeName(attr.name));
+        compactLayout.push_back(static_cast<std::uint32_t>(attr.vectorType));
+        compactLayout.push_back(attr.instanceDivisor);
+        compactLayout.push_back(attr.conversion ? 1u : 0u);
+        compactLayout.push_back(attr.offset);
+        compactLayout.push_back(attr.semanticIndex);
+        compactLayout.push_back(attr.inputSlot);
+    }
+
+    /* Hash compact layout; an empty layout has the hash 0 */
+    if (compactLayout.empty())
+        layoutHash = 0;
+    else
+    {
+        layoutHash = HashInitValue();
+        HashBytes(layoutHash, compactLayout.data(), compactLayout.size() * sizeof(std::uint32_t));
+    }
+}
+
+bool VertexFormat::HasEqualLayout(const VertexFormat& rhs) const
+{
+    return (layoutHash == rhs.layoutHash && compactLayout == rhs.compactLayout);
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,515 @@
+/*
+ * Benchmark1_Overhead.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+
+/*
+Measures the CPU overhead of the render system for the specified backend and writes the results in JSON format.
+A headless render context is used, so the benchmark can also run on servers without a display.
+Usage: Benchmark1_Overhead [RENDERER_MODULE [OUTPUT_FILE]]
+By default, the "OpenGL" module is used and the results are written to the standard output.
+*/
+
+static const unsigned int numDrawCalls          = 10000;
+static const unsigned int numDrawBatches        = 20;
+static const unsigned int numBufferWrites       = 200;
+static const unsigned int numTextureUploads     = 50;
+static const unsigned int numPipelines          = 200;
+static const unsigned int numBindCalls          = 100000;
+
+static const std::size_t  bufferSize            = 1024 * 1024;
+static const unsigned int textureSize           = 512;
+static const unsigned int numRecordedFrames     = 100;
+
+
+/* ----- Allocation counter ----- */
+
+/*
+Counts all heap allocations with the global operator new.
+Allocations inside the render system modules are only counted where the replacement operator is shared with them,
+i.e. on Linux and MacOS, but not across DLL boundaries on Windows.
+*/
+static std::atomic<std::size_t> g_allocationCounter { 0 };
+
+void* operator new (std::size_t size)
+{
+    ++g_allocationCounter;
+    if (auto ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+/* ----- Shaders ----- */
+
+static const char* g_vertexShaderGLSL =
+    "#version 330 core\n"
+    "in vec2 position;\n"
+    "void main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+
+static const char* g_fragmentShaderGLSL =
+    "#version 330 core\n"
+    "out vec4 fragColor;\n"
+    "void main() { fragColor = vec4(1.0); }\n";
+
+static const char* g_shaderHLSL =
+    "float4 VS(float2 position : POSITION) : SV_Position { return float4(position, 0, 1); }\n"
+    "float4 PS() : SV_Target { return (float4)1; }\n";
+
+
+/* ----- Result output ----- */
+
+struct BenchmarkResult
+{
+    std::string name;
+    double      value;
+    std::string unit;
+};
+
+class Benchmark
+{
+
+    public:
+
+        Benchmark(const std::string& rendererModule)
+        {
+            renderer_ = LLGL::RenderSystem::Load(rendererModule);
+
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution    = { 640, 480 };
+                contextDesc.vsync.enabled           = false;
+                contextDesc.headless                = true;
+            }
+            context_ = renderer_->CreateRenderContext(contextDesc);
+
+            commands_ = renderer_->CreateCommandBuffer();
+
+            CreateResources();
+        }
+
+        void Run()
+        {
+            BenchmarkDrawCalls(false);
+            BenchmarkDrawCalls(true);
+            BenchmarkBindCalls();
+            BenchmarkSteadyStateAllocations();
+            BenchmarkWriteBuffer();
+            BenchmarkMapBuffer();
+            BenchmarkTextureUpload();
+            BenchmarkPipelineCreation();
+        }
+
+        void WriteJSON(std::ostream& stream) const
+        {
+            const auto& info = renderer_->GetRendererInfo();
+
+            stream << "{\n";
+            stream << "  \"module\": \"" << renderer_->GetName() << "\",\n";
+            stream << "  \"renderer\": \"" << info.rendererName << "\",\n";
+            stream << "  \"device\": \"" << info.deviceName << "\",\n";
+            stream << "  \"results\": [\n";
+
+            for (std::size_t i = 0; i < results_.size(); ++i)
+            {
+                const auto& result = results_[i];
+                stream << "    { \"name\": \"" << result.name << "\", \"value\": " << result.value << ", \"unit\": \"" << result.unit << "\" }";
+                stream << (i + 1 < results_.size() ? ",\n" : "\n");
+            }
+
+            stream << "  ]\n";
+            stream << "}\n";
+        }
+
+    private:
+
+        using Clock = std::chrono::high_resolution_clock;
+
+        static double ElapsedSeconds(const Clock::time_point& startTime)
+        {
+            return std::chrono::duration<double>(Clock::now() - startTime).count();
+        }
+
+        void AddResult(const std::string& name, double value, const std::string& unit)
+        {
+            results_.push_back({ name, value, unit });
+        }
+
+        void CreateResources()
+        {
+            /* Create vertex buffers with a single triangle */
+            vertexFormat_.AppendAttribute({ "position", LLGL::VectorType::Float2 });
+
+            const float vertices[] = { 0.0f, 0.5f, 0.5f, -0.5f, -0.5f, -0.5f };
+
+            LLGL::BufferDescriptor vertexBufferDesc;
+            {
+                vertexBufferDesc.type                   = LLGL::BufferType::Vertex;
+                vertexBufferDesc.size                   = sizeof(vertices);
+                vertexBufferDesc.vertexBuffer.format    = vertexFormat_;
+            }
+            for (auto& vertexBuffer : vertexBuffers_)
+                vertexBuffer = renderer_->CreateBuffer(vertexBufferDesc, vertices);
+
+            /* Create shader program */
+            auto vertexShader   = renderer_->CreateShader(LLGL::ShaderType::Vertex);
+            auto fragmentShader = renderer_->CreateShader(LLGL::ShaderType::Fragment);
+
+            if (renderer_->GetRenderingCaps().shadingLanguage >= LLGL::ShadingLanguage::HLSL_2_0)
+            {
+                vertexShader->Compile(g_shaderHLSL, LLGL::ShaderDescriptor("VS", "vs_4_0"));
+                fragmentShader->Compile(g_shaderHLSL, LLGL::ShaderDescriptor("PS", "ps_4_0"));
+            }
+            else
+            {
+                vertexShader->Compile(g_vertexShaderGLSL);
+                fragmentShader->Compile(g_fragmentShaderGLSL);
+            }
+
+            shaderProgram_ = renderer_->CreateShaderProgram();
+            shaderProgram_->AttachShader(*vertexShader);
+            shaderProgram_->AttachShader(*fragmentShader);
+            shaderProgram_->BuildInputLayout(vertexFormat_);
+
+            if (!shaderProgram_->LinkShaders())
+                throw std::runtime_error(shaderProgram_->QueryInfoLog());
+
+            /* Create two graphics pipelines, which only differ in their blend state */
+            for (std::size_t i = 0; i < 2; ++i)
+                pipelines_[i] = renderer_->CreateGraphicsPipeline(GetPipelineDesc(i == 1));
+        }
+
+        LLGL::GraphicsPipelineDescriptor GetPipelineDesc(bool blendEnabled) const
+        {
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram          = shaderProgram_;
+                pipelineDesc.blend.blendEnabled     = blendEnabled;
+                pipelineDesc.blend.targets.push_back({});
+            }
+            return pipelineDesc;
+        }
+
+        // Measures the draw call submission rate, optionally with a pipeline and vertex buffer change for every draw call.
+        void BenchmarkDrawCalls(bool stateChanges)
+        {
+            double seconds = 0.0;
+
+            for (unsigned int batch = 0; batch < numDrawBatches; ++batch)
+            {
+                commands_->SetRenderTarget(*context_);
+                commands_->SetViewport({ 0, 0, 640, 480 });
+                commands_->Clear(LLGL::ClearFlags::Color);
+
+                auto startTime = Clock::now();
+
+                if (stateChanges)
+                {
+                    for (unsigned int i = 0; i < numDrawCalls; ++i)
+                    {
+                        commands_->SetGraphicsPipeline(*pipelines_[i % 2]);
+                        commands_->SetVertexBuffer(*vertexBuffers_[i % 2]);
+                        commands_->Draw(3, 0);
+                    }
+                }
+                else
+                {
+                    commands_->SetGraphicsPipeline(*pipelines_[0]);
+                    commands_->SetVertexBuffer(*vertexBuffers_[0]);
+                    for (unsigned int i = 0; i < numDrawCalls; ++i)
+                        commands_->Draw(3, 0);
+                }
+
+                seconds += ElapsedSeconds(startTime);
+
+                /* Present outside of the measurement, so the driver queue does not overflow */
+                context_->Present();
+            }
+
+            AddResult(
+                (stateChanges ? "draw_calls_with_state_changes" : "draw_calls"),
+                static_cast<double>(numDrawCalls * numDrawBatches) / seconds,
+                "calls/s"
+            );
+        }
+
+        /*
+        Measures redundant against alternating pipeline and vertex buffer bindings.
+        The ratio between both shows how effectively the backend filters out redundant state changes
+        (e.g. by the state cache of the GLStateManager), where a ratio close to 0 means all redundant bindings are filtered out.
+        */
+        void BenchmarkBindCalls()
+        {
+            commands_->SetRenderTarget(*context_);
+
+            auto startTime = Clock::now();
+            {
+                for (unsigned int i = 0; i < numBindCalls; ++i)
+                {
+                    commands_->SetGraphicsPipeline(*pipelines_[0]);
+                    commands_->SetVertexBuffer(*vertexBuffers_[0]);
+                }
+            }
+            auto redundantSeconds = ElapsedSeconds(startTime);
+
+            startTime = Clock::now();
+            {
+                for (unsigned int i = 0; i < numBindCalls; ++i)
+                {
+                    commands_->SetGraphicsPipeline(*pipelines_[i % 2]);
+                    commands_->SetVertexBuffer(*vertexBuffers_[i % 2]);
+                }
+            }
+            auto alternatingSeconds = ElapsedSeconds(startTime);
+
+            context_->Present();
+
+            AddResult("redundant_bind_time", redundantSeconds * 1.0e9 / numBindCalls, "ns/call");
+            AddResult("alternating_bind_time", alternatingSeconds * 1.0e9 / numBindCalls, "ns/call");
+            AddResult("redundant_bind_ratio", redundantSeconds / alternatingSeconds, "ratio");
+        }
+
+        // Records a frame with the common command buffer functions.
+        void RecordFrame()
+        {
+            const LLGL::Viewport viewports[2] = { { 0, 0, 320, 480 }, { 320, 0, 320, 480 } };
+            const LLGL::Scissor scissors[2] = { { 0, 0, 320, 480 }, { 320, 0, 320, 480 } };
+
+            commands_->SetRenderTarget(*context_);
+            commands_->SetViewport({ 0, 0, 640, 480 });
+            commands_->SetScissor({ 0, 0, 640, 480 });
+            commands_->Clear(LLGL::ClearFlags::Color);
+
+            if (renderer_->GetRenderingCaps().hasViewportArrays)
+            {
+                commands_->SetViewportArray(2, viewports);
+                commands_->SetScissorArray(2, scissors);
+            }
+
+            for (unsigned int i = 0; i < numDrawCalls; ++i)
+            {
+                commands_->SetGraphicsPipeline(*pipelines_[i % 2]);
+                commands_->SetVertexBuffer(*vertexBuffers_[i % 2]);
+                commands_->Draw(3, 0);
+            }
+        }
+
+        /*
+        Counts the heap allocations during steady-state command recording, i.e. after a first frame has been recorded.
+        Any value other than 0 means that a command buffer function allocates memory per call.
+        */
+        void BenchmarkSteadyStateAllocations()
+        {
+            RecordFrame();
+            context_->Present();
+
+            std::size_t numAllocations = 0;
+
+            for (unsigned int frame = 0; frame < numRecordedFrames; ++frame)
+            {
+                auto startCounter = g_allocationCounter.load();
+                RecordFrame();
+                numAllocations += g_allocationCounter.load() - startCounter;
+
+                /* Present outside of the measurement, since swapping buffers is not part of command recording */
+                context_->Present();
+            }
+
+            AddResult("steady_state_allocations", static_cast<double>(numAllocations) / numRecordedFrames, "allocs/frame");
+        }
+
+        // Measures the bandwidth of RenderSystem::WriteBuffer.
+        void BenchmarkWriteBuffer()
+        {
+            std::vector<char> data(bufferSize, 1);
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.type     = LLGL::BufferType::Storage;
+                bufferDesc.size     = static_cast<unsigned int>(bufferSize);
+                bufferDesc.flags    = LLGL::BufferFlags::DynamicUsage;
+            }
+            auto buffer = renderer_->CreateBuffer(bufferDesc);
+
+            auto startTime = Clock::now();
+            {
+                for (unsigned int i = 0; i < numBufferWrites; ++i)
+                    renderer_->WriteBuffer(*buffer, data.data(), data.size(), 0);
+            }
+            auto seconds = ElapsedSeconds(startTime);
+
+            renderer_->Release(*buffer);
+
+            AddResult("write_buffer_bandwidth", ToMegabytes(bufferSize * numBufferWrites) / seconds, "MB/s");
+        }
+
+        // Measures the bandwidth of RenderSystem::MapBuffer with write access.
+        void BenchmarkMapBuffer()
+        {
+            std::vector<char> data(bufferSize, 1);
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.type     = LLGL::BufferType::Storage;
+                bufferDesc.size     = static_cast<unsigned int>(bufferSize);
+                bufferDesc.flags    = LLGL::BufferFlags::MapWriteAccess | LLGL::BufferFlags::DynamicUsage;
+            }
+            auto buffer = renderer_->CreateBuffer(bufferDesc);
+
+            auto startTime = Clock::now();
+            {
+                for (unsigned int i = 0; i < numBufferWrites; ++i)
+                {
+                    if (auto dst = renderer_->MapBuffer(*buffer, LLGL::BufferCPUAccess::WriteOnly))
+                    {
+                        std::memcpy(dst, data.data(), data.size());
+                        renderer_->UnmapBuffer(*buffer);
+                    }
+                }
+            }
+            auto seconds = ElapsedSeconds(startTime);
+
+            renderer_->Release(*buffer);
+
+            AddResult("map_buffer_bandwidth", ToMegabytes(bufferSize * numBufferWrites) / seconds, "MB/s");
+        }
+
+        // Measures the texture upload bandwidth, including the conversion of RGB into RGBA image data with ConvertImageBuffer.
+        void BenchmarkTextureUpload()
+        {
+            const std::size_t numTexels = textureSize * textureSize;
+
+            std::vector<unsigned char> srcImage(numTexels * 3, 0x80);
+            std::vector<unsigned char> dstImage(numTexels * 4);
+
+            LLGL::TextureDescriptor textureDesc;
+            {
+                textureDesc.type                = LLGL::TextureType::Texture2D;
+                textureDesc.format              = LLGL::TextureFormat::RGBA8;
+                textureDesc.texture2D.width     = textureSize;
+                textureDesc.texture2D.height    = textureSize;
+                textureDesc.texture2D.layers    = 1;
+            }
+            auto texture = renderer_->CreateTexture(textureDesc);
+
+            LLGL::SubTextureDescriptor subTextureDesc;
+            {
+                subTextureDesc.mipLevel             = 0;
+                subTextureDesc.texture2D.x          = 0;
+                subTextureDesc.texture2D.y          = 0;
+                subTextureDesc.texture2D.layerOffset  = 0;
+                subTextureDesc.texture2D.width      = textureSize;
+                subTextureDesc.texture2D.height     = textureSize;
+                subTextureDesc.texture2D.layers     = 1;
+            }
+
+            double convertSeconds = 0.0;
+
+            auto startTime = Clock::now();
+            {
+                for (unsigned int i = 0; i < numTextureUploads; ++i)
+                {
+                    auto convertStartTime = Clock::now();
+                    {
+                        LLGL::ConvertImageBuffer(
+                            LLGL::ImageFormat::RGB, LLGL::DataType::UInt8, srcImage.data(), srcImage.size(),
+                            LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, dstImage.data(), dstImage.size(),
+                            LLGL::maxThreadCount
+                        );
+                    }
+                    convertSeconds += ElapsedSeconds(convertStartTime);
+
+                    LLGL::ImageDescriptor imageDesc(LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, dstImage.data());
+                    renderer_->WriteTexture(*texture, subTextureDesc, imageDesc);
+                }
+            }
+            auto seconds = ElapsedSeconds(startTime);
+
+            renderer_->Release(*texture);
+
+            AddResult("convert_image_bandwidth", ToMegabytes(srcImage.size() * numTextureUploads) / convertSeconds, "MB/s");
+            AddResult("texture_upload_bandwidth", ToMegabytes(dstImage.size() * numTextureUploads) / seconds, "MB/s");
+        }
+
+        // Measures the creation time of graphics pipelines (without shader compilation).
+        void BenchmarkPipelineCreation()
+        {
+            std::vector<LLGL::GraphicsPipeline*> pipelines(numPipelines);
+
+            auto startTime = Clock::now();
+            {
+                for (unsigned int i = 0; i < numPipelines; ++i)
+                    pipelines[i] = renderer_->CreateGraphicsPipeline(GetPipelineDesc(i % 2 == 0));
+            }
+            auto seconds = ElapsedSeconds(startTime);
+
+            for (auto pipeline : pipelines)
+                renderer_->Release(*pipeline);
+
+            AddResult("pipeline_creation_time", seconds * 1.0e6 / numPipelines, "us/pipeline");
+        }
+
+        static double ToMegabytes(std::size_t size)
+        {
+            return static_cast<double>(size) / (1024.0 * 1024.0);
+        }
+
+        std::unique_ptr<LLGL::RenderSystem> renderer_;
+        LLGL::RenderContext*                context_            = nullptr;
+        LLGL::CommandBuffer*                commands_           = nullptr;
+
+        LLGL::VertexFormat                  vertexFormat_;
+        LLGL::Buffer*                       vertexBuffers_[2]   = {};
+        LLGL::ShaderProgram*                shaderProgram_      = nullptr;
+        LLGL::GraphicsPipeline*             pipelines_[2]       = {};
+
+        std::vector<BenchmarkResult>        results_;
+
+};
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::string rendererModule = (argc > 1 ? argv[1] : "OpenGL");
+
+        Benchmark benchmark(rendererModule);
+        benchmark.Run();
+
+        if (argc > 2)
+        {
+            std::ofstream file(argv[2]);
+            if (!file.good())
+                throw std::runtime_error("failed to open file: \"" + std::string(argv[2]) + "\"");
+            benchmark.WriteJSON(file);
+        }
+        else
+            benchmark.WriteJSON(std::cout);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Benchmark2_Replay.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/CaptureReplay.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+
+/*
+Replays a capture trace (see LLGL::RenderingCapture) with the specified backend and writes the frame times in JSON format.
+The first loop warms up the driver and is not included in the results.
+Usage: Benchmark2_Replay TRACE_FILE [RENDERER_MODULE [NUM_LOOPS]] [-headless]
+By default, the "OpenGL" module is used and the trace is replayed 3 times after the warm-up loop.
+*/
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        /* Parse arguments */
+        std::vector<std::string> args;
+        bool headless = false;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "-headless") == 0)
+                headless = true;
+            else
+                args.push_back(argv[i]);
+        }
+
+        if (args.empty())
+        {
+            std::cerr << "usage: Benchmark2_Replay TRACE_FILE [RENDERER_MODULE [NUM_LOOPS]] [-headless]" << std::endl;
+            return 1;
+        }
+
+        std::string rendererModule  = (args.size() > 1 ? args[1] : "OpenGL");
+        int         numLoops        = (args.size() > 2 ? std::atoi(args[2].c_str()) : 3);
+
+        /* Load render system and trace */
+        auto renderer = LLGL::RenderSystem::Load(rendererModule);
+
+        LLGL::CaptureReplay replay(*renderer, LLGL::CaptureReplay::LoadTrace(args[0]), headless);
+
+        /* Replay trace once to warm up the driver, then measure all frames of each loop */
+        std::vector<std::uint64_t> frameTimes;
+
+        for (int loop = 0; loop <= numLoops; ++loop)
+        {
+            replay.Restart();
+
+            while (replay.ReplayFrame())
+            {
+                if (auto context = replay.GetRenderContext())
+                {
+                    if (auto window = dynamic_cast<LLGL::Window*>(&(context->GetSurface())))
+                        window->ProcessEvents();
+                }
+                if (loop > 0)
+                    frameTimes.push_back(replay.GetFrameTime());
+            }
+        }
+
+        /* Write results */
+        std::uint64_t totalTime = 0;
+        for (auto t : frameTimes)
+            totalTime += t;
+
+        const auto& info = renderer->GetRendererInfo();
+
+        std::cout << "{\n";
+        std::cout << "  \"module\": \"" << renderer->GetName() << "\",\n";
+        std::cout << "  \"renderer\": \"" << info.rendererName << "\",\n";
+        std::cout << "  \"device\": \"" << info.deviceName << "\",\n";
+        std::cout << "  \"trace\": \"" << args[0] << "\",\n";
+        std::cout << "  \"loops\": " << numLoops << ",\n";
+        std::cout << "  \"average_frame_time_ms\": " << (frameTimes.empty() ? 0.0 : static_cast<double>(totalTime) / frameTimes.size() / 1000000.0) << ",\n";
+        std::cout << "  \"frame_times_ms\": [";
+
+        for (std::size_t i = 0; i < frameTimes.size(); ++i)
+            std::cout << (i > 0 ? ", " : "") << static_cast<double>(frameTimes[i]) / 1000000.0;
+
+        std::cout << "]\n";
+        std::cout << "}\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,615 @@
+/*
+ * Benchmark3_Tessellation.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/AdaptiveTessellation.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cmath>
+
+
+/*
+Measures the GPU cost of tessellation for the specified backend and writes the results in JSON format.
+A terrain-like grid of quad patches is rendered with fixed tessellation factors for several patch counts,
+and once more with screen-space adaptive factors computed by LLGL::AdaptiveTessellation.
+For each configuration, the GPU time per frame and the number of tessellation-evaluation shader invocations are measured.
+Usage: Benchmark3_Tessellation [RENDERER_MODULE [OUTPUT_FILE]]
+By default, the "OpenGL" module is used and the results are written to the standard output.
+*/
+
+static const unsigned int   numFramesPerConfig  = 10;
+static const unsigned int   patchGridSizes[]    = { 8, 32, 128 };
+static const float          tessFactors[]       = { 1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f };
+static const float          targetEdgeLength    = 16.0f;
+
+static const unsigned int   resolutionX         = 1280;
+static const unsigned int   resolutionY         = 720;
+
+
+/* ----- Shaders ----- */
+
+static const char* g_vertexShaderGLSL =
+    "#version 430 core\n"
+    "in vec3 position;\n"
+    "out vec3 vPosition;\n"
+    "void main() { vPosition = position; }\n";
+
+static const char* g_tessControlShaderGLSL =
+    "#version 430 core\n"
+    "layout(vertices = 4) out;\n"
+    "layout(std140, binding = 0) uniform Settings { mat4 vpMatrix; float tessFactor; uint adaptive; vec2 _pad; };\n"
+    "struct Factors { vec4 edges; vec2 inside; vec2 reserved; };\n"
+    "layout(std430, binding = 1) readonly buffer FactorBuffer { Factors factors[]; };\n"
+    "in vec3 vPosition[];\n"
+    "out vec3 tcPosition[];\n"
+    "void main()\n"
+    "{\n"
+    "    tcPosition[gl_InvocationID] = vPosition[gl_InvocationID];\n"
+    "    if (gl_InvocationID == 0)\n"
+    "    {\n"
+    "        vec4 edges = vec4(tessFactor);\n"
+    "        vec2 inside = vec2(tessFactor);\n"
+    "        if (adaptive != 0u) { edges = factors[gl_PrimitiveID].edges; inside = factors[gl_PrimitiveID].inside; }\n"
+    "        gl_TessLevelOuter[0] = edges.x; gl_TessLevelOuter[1] = edges.y;\n"
+    "        gl_TessLevelOuter[2] = edges.z; gl_TessLevelOuter[3] = edges.w;\n"
+    "        gl_TessLevelInner[0] = inside.x; gl_TessLevelInner[1] = inside.y;\n"
+    "    }\n"
+    "}\n";
+
+static const char* g_tessEvaluationShaderGLSL =
+    "#version 430 core\n"
+    "layout(quads, equal_spacing, cw) in;\n"
+    "layout(std140, binding = 0) uniform Settings { mat4 vpMatrix; float tessFactor; uint adaptive; vec2 _pad; };\n"
+    "in vec3 tcPosition[];\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 a = mix(tcPosition[0], tcPosition[1], gl_TessCoord.x);\n"
+    "    vec3 b = mix(tcPosition[2], tcPosition[3], gl_TessCoord.x);\n"
+    "    gl_Position = vpMatrix * vec4(mix(a, b, gl_TessCoord.y), 1.0);\n"
+    "}\n";
+
+static const char* g_fragmentShaderGLSL =
+    "#version 430 core\n"
+    "out vec4 fragColor;\n"
+    "void main() { fragColor = vec4(1.0); }\n";
+
+/*
+Reference compute shader for LLGL::AdaptiveTessellation.
+The edges follow the quad domain: edge 0 is u=0 (corners 0-2), edge 1 is v=0 (corners 0-1), edge 2 is u=1 (corners 1-3), and edge 3 is v=1 (corners 2-3).
+Edges with a corner behind the camera get the minimal factor.
+*/
+static const char* g_computeShaderGLSL =
+    "#version 430 core\n"
+    "layout(local_size_x = 64) in;\n"
+    "layout(std140, binding = 0) uniform Parameters\n"
+    "{\n"
+    "    mat4 viewProjection; vec2 viewportSize; float targetEdgeLength; float minFactor; float maxFactor; uint numPatches; uvec2 reserved;\n"
+    "};\n"
+    "struct Factors { vec4 edges; vec2 inside; vec2 reserved; };\n"
+    "layout(std430, binding = 0) readonly buffer PatchBuffer { vec4 patches[]; };\n"
+    "layout(std430, binding = 1) writeonly buffer FactorBuffer { Factors factors[]; };\n"
+    "vec3 Project(vec4 p)\n"
+    "{\n"
+    "    vec4 c = viewProjection * vec4(p.xyz, 1.0);\n"
+    "    return vec3(c.xy / max(c.w, 1.0e-4) * 0.5 * viewportSize, c.w);\n"
+    "}\n"
+    "float EdgeFactor(vec3 a, vec3 b)\n"
+    "{\n"
+    "    if (a.z <= 0.0 || b.z <= 0.0) { return minFactor; }\n"
+    "    return clamp(distance(a.xy, b.xy) / targetEdgeLength, minFactor, maxFactor);\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    uint id = gl_GlobalInvocationID.x;\n"
+    "    if (id >= numPatches) { return; }\n"
+    "    vec3 p0 = Project(patches[id*4u]), p1 = Project(patches[id*4u + 1u]);\n"
+    "    vec3 p2 = Project(patches[id*4u + 2u]), p3 = Project(patches[id*4u + 3u]);\n"
+    "    vec4 edges = vec4(EdgeFactor(p0, p2), EdgeFactor(p0, p1), EdgeFactor(p1, p3), EdgeFactor(p2, p3));\n"
+    "    factors[id].edges = edges;\n"
+    "    factors[id].inside = vec2(max(edges.y, edges.w), max(edges.x, edges.z));\n"
+    "    factors[id].reserved = vec2(0.0);\n"
+    "}\n";
+
+static const char* g_shaderHLSL =
+    "cbuffer Settings : register(b0) { float4x4 vpMatrix; float tessFactor; uint adaptive; float2 _pad; };\n"
+    "struct Factors { float4 edges; float2 inside; float2 reserved; };\n"
+    "StructuredBuffer<Factors> factors : register(t1);\n"
+    "struct VertexOut { float3 position : WORLDPOS; };\n"
+    "struct PatchOut { float edges[4] : SV_TessFactor; float inside[2] : SV_InsideTessFactor; };\n"
+    "VertexOut VS(float3 position : POSITION) { VertexOut outp; outp.position = position; return outp; }\n"
+    "PatchOut PatchHS(InputPatch<VertexOut, 4> patch, uint id : SV_PrimitiveID)\n"
+    "{\n"
+    "    float4 edges = (float4)tessFactor;\n"
+    "    float2 inside = (float2)tessFactor;\n"
+    "    if (adaptive != 0) { edges = factors[id].edges; inside = factors[id].inside; }\n"
+    "    PatchOut outp;\n"
+    "    outp.edges[0] = edges.x; outp.edges[1] = edges.y; outp.edges[2] = edges.z; outp.edges[3] = edges.w;\n"
+    "    outp.inside[0] = inside.x; outp.inside[1] = inside.y;\n"
+    "    return outp;\n"
+    "}\n"
+    "[domain(\"quad\")]\n"
+    "[partitioning(\"integer\")]\n"
+    "[outputtopology(\"triangle_cw\")]\n"
+    "[outputcontrolpoints(4)]\n"
+    "[patchconstantfunc(\"PatchHS\")]\n"
+    "[maxtessfactor(64.0)]\n"
+    "VertexOut HS(InputPatch<VertexOut, 4> patch, uint id : SV_OutputControlPointID) { return patch[id]; }\n"
+    "[domain(\"quad\")]\n"
+    "float4 DS(PatchOut inp, float2 uv : SV_DomainLocation, const OutputPatch<VertexOut, 4> patch) : SV_Position\n"
+    "{\n"
+    "    float3 a = lerp(patch[0].position, patch[1].position, uv.x);\n"
+    "    float3 b = lerp(patch[2].position, patch[3].position, uv.x);\n"
+    "    return mul(vpMatrix, float4(lerp(a, b, uv.y), 1));\n"
+    "}\n"
+    "float4 PS() : SV_Target { return (float4)1; }\n";
+
+static const char* g_computeShaderHLSL =
+    "cbuffer Parameters : register(b0)\n"
+    "{\n"
+    "    float4x4 viewProjection; float2 viewportSize; float targetEdgeLength; float minFactor; float maxFactor; uint numPatches; uint2 reserved;\n"
+    "};\n"
+    "struct Factors { float4 edges; float2 inside; float2 reserved; };\n"
+    "StructuredBuffer<float4> patches : register(t0);\n"
+    "RWStructuredBuffer<Factors> factors : register(u1);\n"
+    "float3 Project(float4 p)\n"
+    "{\n"
+    "    float4 c = mul(viewProjection, float4(p.xyz, 1));\n"
+    "    return float3(c.xy / max(c.w, 1.0e-4) * 0.5 * viewportSize, c.w);\n"
+    "}\n"
+    "float EdgeFactor(float3 a, float3 b)\n"
+    "{\n"
+    "    if (a.z <= 0.0 || b.z <= 0.0) { return minFactor; }\n"
+    "    return clamp(distance(a.xy, b.xy) / targetEdgeLength, minFactor, maxFactor);\n"
+    "}\n"
+    "[numthreads(64, 1, 1)]\n"
+    "void CS(uint3 threadID : SV_DispatchThreadID)\n"
+    "{\n"
+    "    uint id = threadID.x;\n"
+    "    if (id >= numPatches) { return; }\n"
+    "    float3 p0 = Project(patches[id*4]), p1 = Project(patches[id*4 + 1]);\n"
+    "    float3 p2 = Project(patches[id*4 + 2]), p3 = Project(patches[id*4 + 3]);\n"
+    "    Factors f;\n"
+    "    f.edges = float4(EdgeFactor(p0, p2), EdgeFactor(p0, p1), EdgeFactor(p1, p3), EdgeFactor(p2, p3));\n"
+    "    f.inside = float2(max(f.edges.y, f.edges.w), max(f.edges.x, f.edges.z));\n"
+    "    f.reserved = (float2)0;\n"
+    "    factors[id] = f;\n"
+    "}\n";
+
+
+/* ----- Result output ----- */
+
+struct BenchmarkResult
+{
+    std::string name;
+    double      value;
+    std::string unit;
+};
+
+struct Settings
+{
+    float           vpMatrix[16];
+    float           tessFactor;
+    std::uint32_t   adaptive;
+    float           _pad[2];
+};
+
+class Benchmark
+{
+
+    public:
+
+        Benchmark(const std::string& rendererModule)
+        {
+            renderer_ = LLGL::RenderSystem::Load(rendererModule);
+
+            const auto& caps = renderer_->GetRenderingCaps();
+            if (!caps.hasTessellationShaders)
+                throw std::runtime_error("tessellation shaders are not supported by this renderer");
+
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution    = { static_cast<int>(resolutionX), static_cast<int>(resolutionY) };
+                contextDesc.vsync.enabled           = false;
+                contextDesc.headless                = true;
+            }
+            context_ = renderer_->CreateRenderContext(contextDesc);
+
+            commands_ = renderer_->CreateCommandBuffer();
+
+            CreateResources();
+        }
+
+        void Run()
+        {
+            for (auto gridSize : patchGridSizes)
+            {
+                CreatePatchGrid(gridSize);
+
+                for (auto factor : tessFactors)
+                    BenchmarkFixedFactor(gridSize, factor);
+
+                if (adaptiveTess_)
+                    BenchmarkAdaptiveFactors(gridSize);
+
+                ReleasePatchGrid();
+            }
+        }
+
+        void WriteJSON(std::ostream& stream) const
+        {
+            const auto& info = renderer_->GetRendererInfo();
+
+            stream << "{\n";
+            stream << "  \"module\": \"" << renderer_->GetName() << "\",\n";
+            stream << "  \"renderer\": \"" << info.rendererName << "\",\n";
+            stream << "  \"device\": \"" << info.deviceName << "\",\n";
+            stream << "  \"results\": [\n";
+
+            for (std::size_t i = 0; i < results_.size(); ++i)
+            {
+                const auto& result = results_[i];
+                stream << "    { \"name\": \"" << result.name << "\", \"value\": " << result.value << ", \"unit\": \"" << result.unit << "\" }";
+                stream << (i + 1 < results_.size() ? ",\n" : "\n");
+            }
+
+            stream << "  ]\n";
+            stream << "}\n";
+        }
+
+    private:
+
+        void AddResult(const std::string& name, double value, const std::string& unit)
+        {
+            results_.push_back({ name, value, unit });
+        }
+
+        bool IsHLSL() const
+        {
+            return (renderer_->GetRenderingCaps().shadingLanguage >= LLGL::ShadingLanguage::HLSL_2_0);
+        }
+
+        LLGL::Shader* CompileShader(const LLGL::ShaderType type, const char* sourceGLSL, const char* sourceHLSL, const char* entry, const char* target)
+        {
+            auto shader = renderer_->CreateShader(type);
+
+            bool compiled = false;
+            if (IsHLSL())
+                compiled = shader->Compile(sourceHLSL, LLGL::ShaderDescriptor(entry, target));
+            else
+                compiled = shader->Compile(sourceGLSL);
+
+            if (!compiled)
+                throw std::runtime_error(shader->QueryInfoLog());
+
+            return shader;
+        }
+
+        void CreateResources()
+        {
+            const auto& caps = renderer_->GetRenderingCaps();
+
+            vertexFormat_.AppendAttribute({ "position", LLGL::VectorType::Float3 });
+
+            /* Create tessellation shader program */
+            shaderProgram_ = renderer_->CreateShaderProgram();
+            shaderProgram_->AttachShader(*CompileShader(LLGL::ShaderType::Vertex, g_vertexShaderGLSL, g_shaderHLSL, "VS", "vs_5_0"));
+            shaderProgram_->AttachShader(*CompileShader(LLGL::ShaderType::TessControl, g_tessControlShaderGLSL, g_shaderHLSL, "HS", "hs_5_0"));
+            shaderProgram_->AttachShader(*CompileShader(LLGL::ShaderType::TessEvaluation, g_tessEvaluationShaderGLSL, g_shaderHLSL, "DS", "ds_5_0"));
+            shaderProgram_->AttachShader(*CompileShader(LLGL::ShaderType::Fragment, g_fragmentShaderGLSL, g_shaderHLSL, "PS", "ps_5_0"));
+            shaderProgram_->BuildInputLayout(vertexFormat_);
+
+            if (!shaderProgram_->LinkShaders())
+                throw std::runtime_error(shaderProgram_->QueryInfoLog());
+
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram      = shaderProgram_;
+                pipelineDesc.primitiveTopology  = LLGL::PrimitiveTopology::Patches4;
+                pipelineDesc.blend.targets.push_back({});
+            }
+            pipeline_ = renderer_->CreateGraphicsPipeline(pipelineDesc);
+
+            /* Create constant buffer for the settings */
+            LLGL::BufferDescriptor constantBufferDesc;
+            {
+                constantBufferDesc.type     = LLGL::BufferType::Constant;
+                constantBufferDesc.size     = sizeof(Settings);
+                constantBufferDesc.flags    = LLGL::BufferFlags::DynamicUsage;
+            }
+            constantBuffer_ = renderer_->CreateBuffer(constantBufferDesc);
+
+            /* Create queries for the GPU time and the number of tessellated vertices */
+            timeQuery_ = renderer_->CreateQuery(LLGL::QueryType::TimeElapsed);
+            statsQuery_ = renderer_->CreateQuery(LLGL::QueryType::PipelineStatistics);
+
+            /* Create compute pipeline for the adaptive tessellation factors */
+            if (caps.hasComputeShaders && caps.hasStorageBuffers)
+            {
+                auto computeProgram = renderer_->CreateShaderProgram();
+                computeProgram->AttachShader(*CompileShader(LLGL::ShaderType::Compute, g_computeShaderGLSL, g_computeShaderHLSL, "CS", "cs_5_0"));
+
+                if (!computeProgram->LinkShaders())
+                    throw std::runtime_error(computeProgram->QueryInfoLog());
+
+                computePipeline_ = renderer_->CreateComputePipeline(computeProgram);
+
+                LLGL::AdaptiveTessellationDescriptor adaptiveTessDesc;
+                {
+                    adaptiveTessDesc.pipeline           = computePipeline_;
+                    adaptiveTessDesc.maxPatches         = patchGridSizes[2] * patchGridSizes[2];
+                    adaptiveTessDesc.threadGroupSize    = 64;
+                }
+                adaptiveTess_ = std::unique_ptr<LLGL::AdaptiveTessellation>(
+                    new LLGL::AdaptiveTessellation(*renderer_, *commands_, adaptiveTessDesc)
+                );
+            }
+        }
+
+        /*
+        Builds a column-major perspective projection (left-handed, depth range [0, 1]) for a camera at the origin looking along +Z,
+        so the grid on the ground plane recedes into the distance and the projected size of the patches varies strongly.
+        */
+        static void BuildViewProjection(float (&m)[16])
+        {
+            const float nearPlane   = 0.1f;
+            const float farPlane    = 100.0f;
+            const float aspect      = static_cast<float>(resolutionX) / static_cast<float>(resolutionY);
+            const float f           = 1.0f / std::tan(0.5f * 1.0471976f);
+
+            for (auto& value : m)
+                value = 0.0f;
+
+            m[ 0] = f / aspect;
+            m[ 5] = f;
+            m[10] = farPlane / (farPlane - nearPlane);
+            m[11] = 1.0f;
+            m[14] = -nearPlane * farPlane / (farPlane - nearPlane);
+        }
+
+        // Creates a grid of quad patches on the ground plane, one unit below the camera, from 1 to 41 units in front of it.
+        void CreatePatchGrid(unsigned int gridSize)
+        {
+            numPatches_ = gridSize * gridSize;
+
+            std::vector<float> vertices;
+            std::vector<float> corners;
+            vertices.reserve(numPatches_ * 4 * 3);
+            corners.reserve(numPatches_ * 4 * 4);
+
+            const float extent = 20.0f / static_cast<float>(gridSize);
+            const float depth = 40.0f / static_cast<float>(gridSize);
+
+            for (unsigned int z = 0; z < gridSize; ++z)
+            {
+                for (unsigned int x = 0; x < gridSize; ++x)
+                {
+                    const float x0 = -10.0f + static_cast<float>(x) * extent;
+                    const float z0 = 1.0f + static_cast<float>(z) * depth;
+                    const float patchCorners[4][2] = { { x0, z0 }, { x0 + extent, z0 }, { x0, z0 + depth }, { x0 + extent, z0 + depth } };
+
+                    for (const auto& corner : patchCorners)
+                    {
+                        vertices.insert(vertices.end(), { corner[0], -1.0f, corner[1] });
+                        corners.insert(corners.end(), { corner[0], -1.0f, corner[1], 1.0f });
+                    }
+                }
+            }
+
+            LLGL::BufferDescriptor vertexBufferDesc;
+            {
+                vertexBufferDesc.type                   = LLGL::BufferType::Vertex;
+                vertexBufferDesc.size                   = static_cast<unsigned int>(vertices.size() * sizeof(float));
+                vertexBufferDesc.vertexBuffer.format    = vertexFormat_;
+            }
+            vertexBuffer_ = renderer_->CreateBuffer(vertexBufferDesc, vertices.data());
+
+            if (adaptiveTess_)
+            {
+                LLGL::BufferDescriptor patchBufferDesc;
+                {
+                    patchBufferDesc.type                        = LLGL::BufferType::Storage;
+                    patchBufferDesc.size                        = static_cast<unsigned int>(corners.size() * sizeof(float));
+                    patchBufferDesc.storageBuffer.storageType   = LLGL::StorageBufferType::StructuredBuffer;
+                    patchBufferDesc.storageBuffer.stride        = sizeof(float) * 4;
+                }
+                patchBuffer_ = renderer_->CreateBuffer(patchBufferDesc, corners.data());
+            }
+        }
+
+        void ReleasePatchGrid()
+        {
+            renderer_->Release(*vertexBuffer_);
+            vertexBuffer_ = nullptr;
+
+            if (patchBuffer_)
+            {
+                renderer_->Release(*patchBuffer_);
+                patchBuffer_ = nullptr;
+            }
+        }
+
+        void WriteSettings(float tessFactor, bool adaptive)
+        {
+            Settings settings;
+            {
+                BuildViewProjection(settings.vpMatrix);
+                settings.tessFactor = tessFactor;
+                settings.adaptive   = (adaptive ? 1u : 0u);
+                settings._pad[0]    = 0.0f;
+                settings._pad[1]    = 0.0f;
+            }
+            renderer_->WriteBuffer(*constantBuffer_, &settings, sizeof(settings), 0);
+        }
+
+        void WaitForQuery(LLGL::Query& query, std::uint64_t& result)
+        {
+            while (!commands_->QueryResult(query, result))
+            {
+                /* Wait until the query result is available */
+            }
+        }
+
+        void WaitForPipelineStatistics(LLGL::Query& query, LLGL::QueryPipelineStatistics& result)
+        {
+            while (!commands_->QueryPipelineStatisticsResult(query, result))
+            {
+                /* Wait until the query result is available */
+            }
+        }
+
+        void BindPatches(bool adaptive)
+        {
+            commands_->SetGraphicsPipeline(*pipeline_);
+            commands_->SetVertexBuffer(*vertexBuffer_);
+            commands_->SetConstantBuffer(*constantBuffer_, 0, LLGL::ShaderStageFlags::AllTessStages);
+            if (adaptive)
+                commands_->SetStorageBuffer(adaptiveTess_->GetFactorBuffer(), 1, LLGL::ShaderStageFlags::TessControlStage | LLGL::ShaderStageFlags::ReadOnlyResource);
+        }
+
+        // Renders the patch grid for several frames and returns the average GPU time (in nanoseconds) and tessellation-evaluation invocations per frame.
+        void MeasureFrames(bool adaptive, double& gpuTime, double& numTessInvocations, double* computeTime = nullptr)
+        {
+            std::uint64_t totalTime = 0, totalComputeTime = 0, totalInvocations = 0;
+
+            for (unsigned int frame = 0; frame < numFramesPerConfig; ++frame)
+            {
+                commands_->SetRenderTarget(*context_);
+                commands_->SetViewport({ 0, 0, static_cast<float>(resolutionX), static_cast<float>(resolutionY) });
+                commands_->Clear(LLGL::ClearFlags::Color);
+
+                if (adaptive)
+                {
+                    LLGL::AdaptiveTessellationParameters params;
+                    {
+                        BuildViewProjection(params.viewProjection);
+                        params.viewportSize[0]  = static_cast<float>(resolutionX);
+                        params.viewportSize[1]  = static_cast<float>(resolutionY);
+                        params.targetEdgeLength = targetEdgeLength;
+                    }
+
+                    commands_->BeginQuery(*timeQuery_);
+                    adaptiveTess_->Compute(*patchBuffer_, numPatches_, params);
+                    commands_->EndQuery(*timeQuery_);
+
+                    std::uint64_t elapsed = 0;
+                    WaitForQuery(*timeQuery_, elapsed);
+                    totalComputeTime += elapsed;
+                }
+
+                BindPatches(adaptive);
+
+                commands_->BeginQuery(*timeQuery_);
+                commands_->BeginQuery(*statsQuery_);
+                {
+                    commands_->Draw(numPatches_ * 4, 0);
+                }
+                commands_->EndQuery(*statsQuery_);
+                commands_->EndQuery(*timeQuery_);
+
+                std::uint64_t elapsed = 0;
+                WaitForQuery(*timeQuery_, elapsed);
+                totalTime += elapsed;
+
+                LLGL::QueryPipelineStatistics stats;
+                WaitForPipelineStatistics(*statsQuery_, stats);
+                totalInvocations += stats.numTessEvaluationShaderInvocations;
+
+                context_->Present();
+            }
+
+            gpuTime             = static_cast<double>(totalTime) / numFramesPerConfig;
+            numTessInvocations  = static_cast<double>(totalInvocations) / numFramesPerConfig;
+
+            if (computeTime)
+                *computeTime = static_cast<double>(totalComputeTime) / numFramesPerConfig;
+        }
+
+        static std::string ConfigName(unsigned int gridSize, const std::string& factorName)
+        {
+            std::stringstream s;
+            s << "patches" << gridSize << "x" << gridSize << "_" << factorName;
+            return s.str();
+        }
+
+        void BenchmarkFixedFactor(unsigned int gridSize, float factor)
+        {
+            WriteSettings(factor, false);
+
+            double gpuTime = 0.0, numTessInvocations = 0.0;
+            MeasureFrames(false, gpuTime, numTessInvocations);
+
+            std::stringstream factorName;
+            factorName << "factor" << factor;
+
+            auto name = ConfigName(gridSize, factorName.str());
+            AddResult(name + "_gpu_time", gpuTime * 1.0e-3, "us/frame");
+            AddResult(name + "_tess_invocations", numTessInvocations, "invocations/frame");
+        }
+
+        void BenchmarkAdaptiveFactors(unsigned int gridSize)
+        {
+            WriteSettings(0.0f, true);
+
+            double gpuTime = 0.0, numTessInvocations = 0.0, computeTime = 0.0;
+            MeasureFrames(true, gpuTime, numTessInvocations, &computeTime);
+
+            auto name = ConfigName(gridSize, "adaptive");
+            AddResult(name + "_compute_time", computeTime * 1.0e-3, "us/frame");
+            AddResult(name + "_gpu_time", gpuTime * 1.0e-3, "us/frame");
+            AddResult(name + "_tess_invocations", numTessInvocations, "invocations/frame");
+        }
+
+        std::unique_ptr<LLGL::RenderSystem>         renderer_;
+        LLGL::RenderContext*                        context_            = nullptr;
+        LLGL::CommandBuffer*                        commands_           = nullptr;
+
+        LLGL::VertexFormat                          vertexFormat_;
+        LLGL::ShaderProgram*                        shaderProgram_      = nullptr;
+        LLGL::GraphicsPipeline*                     pipeline_           = nullptr;
+        LLGL::ComputePipeline*                      computePipeline_    = nullptr;
+        LLGL::Buffer*                               constantBuffer_     = nullptr;
+        LLGL::Buffer*                               vertexBuffer_       = nullptr;
+        LLGL::Buffer*                               patchBuffer_        = nullptr;
+        LLGL::Query*                                timeQuery_          = nullptr;
+        LLGL::Query*                                statsQuery_         = nullptr;
+        unsigned int                                numPatches_         = 0;
+
+        std::unique_ptr<LLGL::AdaptiveTessellation> adaptiveTess_;
+
+        std::vector<BenchmarkResult>                results_;
+
+};
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::string rendererModule = (argc > 1 ? argv[1] : "OpenGL");
+
+        Benchmark benchmark(rendererModule);
+        benchmark.Run();
+
+        if (argc > 2)
+        {
+            std::ofstream file(argv[2]);
+            if (!file.good())
+                throw std::runtime_error("failed to open file: \"" + std::string(argv[2]) + "\"");
+            benchmark.WriteJSON(file);
+        }
+        else
+            benchmark.WriteJSON(std::cout);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
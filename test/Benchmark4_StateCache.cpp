@@ -0,0 +1,354 @@
+/*
+ * Benchmark4_StateCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <random>
+
+
+/*
+Replays synthetic bind patterns and measures the binding time together with the hit rate of the state cache of the render system.
+The hit rates are only available if the renderer records state cache statistics (see RenderSystem::ReportStateCacheStatistics),
+i.e. the OpenGL renderer must be built with the CMake option LLGL_GL_ENABLE_STATE_CACHE_STATS; otherwise only the timings are written.
+Usage: Benchmark4_StateCache [RENDERER_MODULE [OUTPUT_FILE]]
+By default, the "OpenGL" module is used and the results are written to the standard output.
+*/
+
+static const unsigned int numObjects        = 8;
+static const unsigned int numDrawCalls      = 10000;
+static const unsigned int numFrames         = 20;
+static const unsigned int textureSize       = 4;
+
+
+/* ----- Shaders ----- */
+
+static const char* g_vertexShaderGLSL =
+    "#version 330 core\n"
+    "in vec2 position;\n"
+    "void main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+
+static const char* g_fragmentShaderGLSL =
+    "#version 330 core\n"
+    "out vec4 fragColor;\n"
+    "void main() { fragColor = vec4(1.0); }\n";
+
+static const char* g_shaderHLSL =
+    "float4 VS(float2 position : POSITION) : SV_Position { return float4(position, 0, 1); }\n"
+    "float4 PS() : SV_Target { return (float4)1; }\n";
+
+
+/* ----- Bind patterns ----- */
+
+/*
+Synthetic bind patterns, which select the object index for each draw call:
+Redundant binds the same objects for all draw calls (best case for the state cache),
+Sorted binds the same objects for consecutive runs of draw calls (like a renderer that sorts by state),
+Alternating switches between two sets of objects with every draw call,
+and Random selects the objects randomly with a fixed seed (worst case for the state cache).
+*/
+enum class BindPattern
+{
+    Redundant,
+    Sorted,
+    Alternating,
+    Random,
+};
+
+static const char* GetBindPatternName(BindPattern pattern)
+{
+    switch (pattern)
+    {
+        case BindPattern::Redundant:    return "redundant";
+        case BindPattern::Sorted:       return "sorted";
+        case BindPattern::Alternating:  return "alternating";
+        case BindPattern::Random:       return "random";
+    }
+    return "";
+}
+
+// Returns the object indices for all draw calls of the specified pattern.
+static std::vector<unsigned int> GenerateBindIndices(BindPattern pattern)
+{
+    std::vector<unsigned int> indices(numDrawCalls, 0);
+
+    switch (pattern)
+    {
+        case BindPattern::Redundant:
+            break;
+
+        case BindPattern::Sorted:
+            for (unsigned int i = 0; i < numDrawCalls; ++i)
+                indices[i] = i * numObjects / numDrawCalls;
+            break;
+
+        case BindPattern::Alternating:
+            for (unsigned int i = 0; i < numDrawCalls; ++i)
+                indices[i] = i % 2;
+            break;
+
+        case BindPattern::Random:
+        {
+            std::mt19937 generator { 1234 };
+            std::uniform_int_distribution<unsigned int> distribution { 0, numObjects - 1 };
+            for (auto& index : indices)
+                index = distribution(generator);
+        }
+        break;
+    }
+
+    return indices;
+}
+
+
+/* ----- Result output ----- */
+
+struct BenchmarkResult
+{
+    std::string name;
+    double      value;
+    std::string unit;
+};
+
+class Benchmark
+{
+
+    public:
+
+        Benchmark(const std::string& rendererModule)
+        {
+            renderer_ = LLGL::RenderSystem::Load(rendererModule);
+
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution    = { 640, 480 };
+                contextDesc.vsync.enabled           = false;
+                contextDesc.headless                = true;
+            }
+            context_ = renderer_->CreateRenderContext(contextDesc);
+
+            commands_ = renderer_->CreateCommandBuffer();
+
+            CreateResources();
+        }
+
+        void Run()
+        {
+            /* Discard the state changes of the resource creation */
+            renderer_->ReportStateCacheStatistics(profiler_);
+            profiler_.ResetStateCacheReport();
+
+            BenchmarkBindPattern(BindPattern::Redundant);
+            BenchmarkBindPattern(BindPattern::Sorted);
+            BenchmarkBindPattern(BindPattern::Alternating);
+            BenchmarkBindPattern(BindPattern::Random);
+        }
+
+        void WriteJSON(std::ostream& stream) const
+        {
+            const auto& info = renderer_->GetRendererInfo();
+
+            stream << "{\n";
+            stream << "  \"module\": \"" << renderer_->GetName() << "\",\n";
+            stream << "  \"renderer\": \"" << info.rendererName << "\",\n";
+            stream << "  \"device\": \"" << info.deviceName << "\",\n";
+            stream << "  \"results\": [\n";
+
+            for (std::size_t i = 0; i < results_.size(); ++i)
+            {
+                const auto& result = results_[i];
+                stream << "    { \"name\": \"" << result.name << "\", \"value\": " << result.value << ", \"unit\": \"" << result.unit << "\" }";
+                stream << (i + 1 < results_.size() ? ",\n" : "\n");
+            }
+
+            stream << "  ]\n";
+            stream << "}\n";
+        }
+
+    private:
+
+        using Clock = std::chrono::high_resolution_clock;
+
+        static double ElapsedSeconds(const Clock::time_point& startTime)
+        {
+            return std::chrono::duration<double>(Clock::now() - startTime).count();
+        }
+
+        void AddResult(const std::string& name, double value, const std::string& unit)
+        {
+            results_.push_back({ name, value, unit });
+        }
+
+        void CreateResources()
+        {
+            /* Create vertex buffers with a single triangle */
+            vertexFormat_.AppendAttribute({ "position", LLGL::VectorType::Float2 });
+
+            const float vertices[] = { 0.0f, 0.5f, 0.5f, -0.5f, -0.5f, -0.5f };
+
+            LLGL::BufferDescriptor vertexBufferDesc;
+            {
+                vertexBufferDesc.type                   = LLGL::BufferType::Vertex;
+                vertexBufferDesc.size                   = sizeof(vertices);
+                vertexBufferDesc.vertexBuffer.format    = vertexFormat_;
+            }
+            for (auto& vertexBuffer : vertexBuffers_)
+                vertexBuffer = renderer_->CreateBuffer(vertexBufferDesc, vertices);
+
+            /* Create small textures, and samplers which only differ in their wrap modes */
+            LLGL::TextureDescriptor textureDesc;
+            {
+                textureDesc.type                = LLGL::TextureType::Texture2D;
+                textureDesc.format              = LLGL::TextureFormat::RGBA8;
+                textureDesc.texture2D.width     = textureSize;
+                textureDesc.texture2D.height    = textureSize;
+                textureDesc.texture2D.layers    = 1;
+            }
+            for (auto& texture : textures_)
+                texture = renderer_->CreateTexture(textureDesc);
+
+            for (unsigned int i = 0; i < numObjects; ++i)
+            {
+                LLGL::SamplerDescriptor samplerDesc;
+                {
+                    samplerDesc.textureWrapU = (i % 2 == 0 ? LLGL::TextureWrap::Repeat : LLGL::TextureWrap::Clamp);
+                    samplerDesc.textureWrapV = (i % 4 < 2 ? LLGL::TextureWrap::Repeat : LLGL::TextureWrap::Clamp);
+                    samplerDesc.textureWrapW = (i < 4 ? LLGL::TextureWrap::Repeat : LLGL::TextureWrap::Clamp);
+                }
+                samplers_[i] = renderer_->CreateSampler(samplerDesc);
+            }
+
+            /* Create shader program */
+            auto vertexShader   = renderer_->CreateShader(LLGL::ShaderType::Vertex);
+            auto fragmentShader = renderer_->CreateShader(LLGL::ShaderType::Fragment);
+
+            if (renderer_->GetRenderingCaps().shadingLanguage >= LLGL::ShadingLanguage::HLSL_2_0)
+            {
+                vertexShader->Compile(g_shaderHLSL, LLGL::ShaderDescriptor("VS", "vs_4_0"));
+                fragmentShader->Compile(g_shaderHLSL, LLGL::ShaderDescriptor("PS", "ps_4_0"));
+            }
+            else
+            {
+                vertexShader->Compile(g_vertexShaderGLSL);
+                fragmentShader->Compile(g_fragmentShaderGLSL);
+            }
+
+            shaderProgram_ = renderer_->CreateShaderProgram();
+            shaderProgram_->AttachShader(*vertexShader);
+            shaderProgram_->AttachShader(*fragmentShader);
+            shaderProgram_->BuildInputLayout(vertexFormat_);
+
+            if (!shaderProgram_->LinkShaders())
+                throw std::runtime_error(shaderProgram_->QueryInfoLog());
+
+            /* Create graphics pipelines, which differ in their blend, depth, and rasterizer states */
+            for (unsigned int i = 0; i < numObjects; ++i)
+            {
+                LLGL::GraphicsPipelineDescriptor pipelineDesc;
+                {
+                    pipelineDesc.shaderProgram          = shaderProgram_;
+                    pipelineDesc.blend.blendEnabled     = (i % 2 == 1);
+                    pipelineDesc.depth.testEnabled      = (i % 4 >= 2);
+                    pipelineDesc.rasterizer.cullMode    = (i < 4 ? LLGL::CullMode::Disabled : LLGL::CullMode::Back);
+                    pipelineDesc.blend.targets.push_back({});
+                }
+                pipelines_[i] = renderer_->CreateGraphicsPipeline(pipelineDesc);
+            }
+        }
+
+        // Replays the specified bind pattern with a pipeline, vertex buffer, texture, and sampler binding for every draw call.
+        void BenchmarkBindPattern(BindPattern pattern)
+        {
+            const auto indices = GenerateBindIndices(pattern);
+
+            double seconds = 0.0;
+
+            for (unsigned int frame = 0; frame < numFrames; ++frame)
+            {
+                commands_->SetRenderTarget(*context_);
+                commands_->SetViewport({ 0, 0, 640, 480 });
+                commands_->Clear(LLGL::ClearFlags::Color);
+
+                auto startTime = Clock::now();
+                {
+                    for (auto i : indices)
+                    {
+                        commands_->SetGraphicsPipeline(*pipelines_[i]);
+                        commands_->SetVertexBuffer(*vertexBuffers_[i]);
+                        commands_->SetTexture(*textures_[i], 0);
+                        commands_->SetSampler(*samplers_[i], 0);
+                        commands_->Draw(3, 0);
+                    }
+                }
+                seconds += ElapsedSeconds(startTime);
+
+                /* Present outside of the measurement, so the driver queue does not overflow */
+                context_->Present();
+            }
+
+            const std::string name = GetBindPatternName(pattern);
+
+            AddResult(name + "_draw_time", seconds * 1.0e9 / (numDrawCalls * numFrames), "ns/draw");
+
+            /* Write the hit rate of each state cache category that has been touched by this pattern */
+            if (renderer_->ReportStateCacheStatistics(profiler_))
+            {
+                for (const auto& entry : profiler_.GetStateCacheReport())
+                {
+                    const auto& usage = entry.second;
+                    if (usage.hits + usage.misses > 0)
+                        AddResult(name + "_" + entry.first + "_hit_rate", usage.GetHitRate(), "ratio");
+                }
+                profiler_.ResetStateCacheReport();
+            }
+        }
+
+        std::unique_ptr<LLGL::RenderSystem> renderer_;
+        LLGL::RenderContext*                context_                        = nullptr;
+        LLGL::CommandBuffer*                commands_                       = nullptr;
+        LLGL::RenderingProfiler             profiler_;
+
+        LLGL::VertexFormat                  vertexFormat_;
+        LLGL::Buffer*                       vertexBuffers_[numObjects]      = {};
+        LLGL::Texture*                      textures_[numObjects]           = {};
+        LLGL::Sampler*                      samplers_[numObjects]           = {};
+        LLGL::ShaderProgram*                shaderProgram_                  = nullptr;
+        LLGL::GraphicsPipeline*             pipelines_[numObjects]          = {};
+
+        std::vector<BenchmarkResult>        results_;
+
+};
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::string rendererModule = (argc > 1 ? argv[1] : "OpenGL");
+
+        Benchmark benchmark(rendererModule);
+        benchmark.Run();
+
+        if (argc > 2)
+        {
+            std::ofstream file(argv[2]);
+            if (!file.good())
+                throw std::runtime_error("failed to open file: \"" + std::string(argv[2]) + "\"");
+            benchmark.WriteJSON(file);
+        }
+        else
+            benchmark.WriteJSON(std::cout);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
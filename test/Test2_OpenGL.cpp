@@ -10,6 +10,7 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <vector>
 
 
 //#define TEST_RENDER_TARGET
@@ -17,10 +18,50 @@
 //#define TEST_STORAGE_BUFFER
 
 
+// Returns true if all bytes of the specified image buffer have the specified value.
+static bool IsUniformImage(const LLGL::ByteBuffer& buffer, std::size_t size, char value)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (buffer[i] != value)
+            return false;
+    }
+    return true;
+}
+
+// Checks that resampling and MIP-map generation preserve the color of a uniform RGBA8 image.
+static void TestUniformImageFiltering()
+{
+    const char value = 77;
+    std::vector<char> image(64 * 64 * 4, value);
+
+    auto lanczos = LLGL::ResampleImage(
+        LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data(), 64, 64, 24, 24, LLGL::ResampleFilter::Lanczos
+    );
+    if (!IsUniformImage(lanczos, 24 * 24 * 4, value))
+        std::cerr << "resampling uniform image with Lanczos filter changed its color" << std::endl;
+
+    auto bilinearSRGB = LLGL::ResampleImage(
+        LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data(), 64, 64, 16, 16, LLGL::ResampleFilter::Bilinear, true
+    );
+    if (!IsUniformImage(bilinearSRGB, 16 * 16 * 4, value))
+        std::cerr << "resampling uniform sRGB image with Bilinear filter changed its color" << std::endl;
+
+    auto mipLevels = LLGL::GenerateMipMaps(LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data(), 64, 64);
+    for (std::size_t i = 0; i < mipLevels.size(); ++i)
+    {
+        const std::size_t size = (64u >> (i + 1)) * (64u >> (i + 1)) * 4;
+        if (!IsUniformImage(mipLevels[i], size, value))
+            std::cerr << "MIP-map level " << (i + 1) << " of uniform image changed its color" << std::endl;
+    }
+}
+
 int main()
 {
     try
     {
+        TestUniformImageFiltering();
+
         // Setup profiler and debugger
         std::shared_ptr<LLGL::RenderingProfiler> profiler;
         std::shared_ptr<LLGL::RenderingDebugger> debugger;
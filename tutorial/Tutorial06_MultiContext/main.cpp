@@ -189,9 +189,6 @@ int main(int argc, char* argv[])
 
                 // Draw triangle with 3 vertices
                 commands->Draw(3, 0);
-
-                // Present the result on the screen
-                context1->Present();
             }
 
             // Draw content in 2nd render context
@@ -208,10 +205,11 @@ int main(int argc, char* argv[])
 
                 // Draw quad with 4 vertices
                 commands->Draw(4, 3);
-
-                // Present the result on the screen
-                context2->Present();
             }
+
+            // Present the results of both render contexts with a single wait for the vertical blank
+            LLGL::RenderContext* contexts[] = { context1, context2 };
+            renderer->PresentAll(2, contexts);
         }
     }
     catch (const std::exception& e)
@@ -0,0 +1,54 @@
+// GLSL compute shader
+#version 430
+
+layout(std140, binding = 0) uniform Settings
+{
+	mat4 vpMatrix;
+	vec4 frustumPlanes[6];
+	uint numInstances;
+};
+
+// Bounding sphere of each instance (xyz = center, w = radius)
+layout(std430, binding = 0) readonly buffer BoundingSpheres
+{
+	vec4 boundingSpheres[];
+};
+
+// Compacted indices of all visible instances
+layout(std430, binding = 1) writeonly buffer VisibleInstances
+{
+	uint visibleInstances[];
+};
+
+// Arguments for the indirect draw command (see LLGL::DrawIndexedIndirectArguments)
+layout(std430, binding = 2) buffer DrawArguments
+{
+	uint	numIndices;
+	uint	numVisibleInstances;
+	uint	firstIndex;
+	int		vertexOffset;
+	uint	firstInstance;
+};
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+// Compute shader main function
+void main()
+{
+	uint id = gl_GlobalInvocationID.x;
+	if (id >= numInstances)
+		return;
+	
+	// Test bounding sphere against all frustum planes
+	vec4 sphere = boundingSpheres[id];
+	
+	for (int i = 0; i < 6; ++i)
+	{
+		if (dot(frustumPlanes[i].xyz, sphere.xyz) + frustumPlanes[i].w < -sphere.w)
+			return;
+	}
+	
+	// Append instance to the visible instances
+	uint slot = atomicAdd(numVisibleInstances, 1u);
+	visibleInstances[slot] = id;
+}
@@ -0,0 +1,14 @@
+// GLSL fragment shader
+#version 430
+
+// Fragment input from the vertex shader
+in vec3 vColor;
+
+// Fragment output color
+out vec4 fragColor;
+
+// Fragment shader main function
+void main()
+{
+	fragColor = vec4(vColor, 1.0);
+}
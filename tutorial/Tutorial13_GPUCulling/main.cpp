@@ -0,0 +1,318 @@
+/*
+ * main.cpp (Tutorial13_GPUCulling)
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../tutorial.h"
+
+
+class Tutorial13 : public Tutorial
+{
+
+    // Static configuration for this demo
+    static const unsigned int   numInstances        = 100000;
+    static const unsigned int   numThreadsPerGroup  = 64;
+    const float                 positionRange       = 90.0f;
+
+    LLGL::ShaderProgram*        shaderProgram       = nullptr;
+    LLGL::ShaderProgram*        cullShaderProgram   = nullptr;
+
+    LLGL::GraphicsPipeline*     pipeline            = nullptr;
+    LLGL::ComputePipeline*      cullPipeline        = nullptr;
+
+    LLGL::Buffer*               vertexBuffer        = nullptr;
+    LLGL::Buffer*               indexBuffer         = nullptr;
+    LLGL::Buffer*               constantBuffer      = nullptr;
+
+    // Input of the culling shader
+    LLGL::Buffer*               instanceBuffer      = nullptr;
+    LLGL::Buffer*               boundingBuffer      = nullptr;
+
+    // Output of the culling shader
+    LLGL::Buffer*               visibleBuffer       = nullptr;
+    LLGL::Buffer*               drawArgsBuffer      = nullptr;
+
+    LLGL::DrawIndexedIndirectArguments initialDrawArgs;
+
+    float                       viewRotation        = 0.0f;
+
+    struct Settings
+    {
+        Gs::Matrix4f    vpMatrix;           // View-projection matrix
+        Gs::Vector4f    frustumPlanes[6];   // View frustum planes (xyz = normal, w = distance)
+        std::uint32_t   numInstances;       // Number of instances to cull
+        std::uint32_t   _pad0[3];
+    }
+    settings;
+
+public:
+
+    Tutorial13() :
+        Tutorial { L"LLGL Tutorial 13: GPU Culling" }
+    {
+        // Check if compute shaders and indirect draw commands are supported
+        const auto& caps = renderer->GetRenderingCaps();
+        if (!caps.hasComputeShaders || !caps.hasIndirectDrawing)
+            throw std::runtime_error("compute shaders and indirect drawing are required for this tutorial");
+
+        // Create all graphics objects
+        auto vertexFormat = CreateBuffers();
+        CreateShaders(vertexFormat);
+        CreatePipelines();
+
+        // Show info
+        std::cout << "press LEFT/RIGHT MOUSE BUTTON to rotate the camera" << std::endl;
+        std::cout << "press SPACE KEY to print the number of visible instances" << std::endl;
+    }
+
+private:
+
+    float Random(float a, float b) const
+    {
+        auto rnd = static_cast<float>(rand()) / RAND_MAX;
+        return a + (b - a) * rnd;
+    }
+
+    LLGL::VertexFormat CreateBuffers()
+    {
+        // Specify vertex format
+        LLGL::VertexFormat vertexFormat;
+        vertexFormat.AppendAttribute({ "position", LLGL::VectorType::Float3 });
+
+        // Create vertex and index buffer for a unit cube
+        auto indices = GenerateCubeTriangleIndices();
+
+        vertexBuffer = CreateVertexBuffer(GenerateCubeVertices(), vertexFormat);
+        indexBuffer = CreateIndexBuffer(indices, LLGL::DataType::UInt32);
+
+        // Initialize instances and their bounding spheres (use dynamic containers to avoid a stack overflow)
+        struct Instance
+        {
+            Gs::Matrix4f        wMatrix;    // World matrix
+            LLGL::ColorRGBAf    color;      // Instance color
+        };
+
+        std::vector<Instance> instanceData(numInstances);
+        std::vector<Gs::Vector4f> boundingData(numInstances);
+
+        for (unsigned int i = 0; i < numInstances; ++i)
+        {
+            auto& instance = instanceData[i];
+
+            // Set random color
+            instance.color = LLGL::ColorRGBAf(Random(0.2f, 1.0f), Random(0.2f, 1.0f), Random(0.2f, 1.0f));
+
+            // Distribute instances randomly over the specified position range
+            Gs::Vector3f position
+            {
+                Random(-positionRange, positionRange),
+                Random(-positionRange, positionRange) * 0.1f,
+                Random(-positionRange, positionRange)
+            };
+
+            auto scale = Random(0.2f, 0.6f);
+
+            Gs::Vector3f axis { Random(-1.0f, 1.0f), 1.0f, Random(-1.0f, 1.0f) };
+            axis.Normalize();
+
+            Gs::Translate(instance.wMatrix, position);
+            Gs::RotateFree(instance.wMatrix, axis, Random(0.0f, Gs::pi*2.0f));
+            Gs::Scale(instance.wMatrix, Gs::Vector3f(scale));
+
+            // Bounding sphere of the rotated unit cube [-1, 1]
+            boundingData[i] = Gs::Vector4f(position.x, position.y, position.z, scale * std::sqrt(3.0f));
+        }
+
+        // Create read-only storage buffers for the instances and their bounding spheres
+        LLGL::BufferDescriptor desc;
+        {
+            desc.type                       = LLGL::BufferType::Storage;
+            desc.size                       = static_cast<unsigned int>(sizeof(Instance) * numInstances);
+            desc.storageBuffer.storageType  = LLGL::StorageBufferType::StructuredBuffer;
+            desc.storageBuffer.stride       = sizeof(Instance);
+        }
+        instanceBuffer = renderer->CreateBuffer(desc, instanceData.data());
+
+        {
+            desc.size                       = static_cast<unsigned int>(sizeof(Gs::Vector4f) * numInstances);
+            desc.storageBuffer.stride       = sizeof(Gs::Vector4f);
+        }
+        boundingBuffer = renderer->CreateBuffer(desc, boundingData.data());
+
+        // Create read/write storage buffer for the compacted indices of the visible instances
+        {
+            desc.size                       = static_cast<unsigned int>(sizeof(std::uint32_t) * numInstances);
+            desc.storageBuffer.storageType  = LLGL::StorageBufferType::RWStructuredBuffer;
+            desc.storageBuffer.stride       = sizeof(std::uint32_t);
+        }
+        visibleBuffer = renderer->CreateBuffer(desc);
+
+        // Create read/write storage buffer for the indirect draw arguments (byte-address buffer, since structured buffers can not hold indirect arguments with D3D)
+        initialDrawArgs.numIndices      = static_cast<unsigned int>(indices.size());
+        initialDrawArgs.numInstances    = 0;
+
+        {
+            desc.size                       = sizeof(initialDrawArgs);
+            desc.flags                      = LLGL::BufferFlags::IndirectArguments | LLGL::BufferFlags::MapReadAccess;
+            desc.storageBuffer.storageType  = LLGL::StorageBufferType::RWByteAddressBuffer;
+            desc.storageBuffer.stride       = sizeof(std::uint32_t);
+        }
+        drawArgsBuffer = renderer->CreateBuffer(desc, &initialDrawArgs);
+
+        // Create constant buffer
+        settings.numInstances = numInstances;
+        constantBuffer = CreateConstantBuffer(settings);
+
+        return vertexFormat;
+    }
+
+    void CreateShaders(const LLGL::VertexFormat& vertexFormat)
+    {
+        if (renderer->GetRenderingCaps().shadingLanguage >= LLGL::ShadingLanguage::HLSL_2_0)
+        {
+            shaderProgram = LoadShaderProgram(
+                {
+                    { LLGL::ShaderType::Vertex, "shader.hlsl", "VS", "vs_5_0" },
+                    { LLGL::ShaderType::Fragment, "shader.hlsl", "PS", "ps_5_0" }
+                },
+                vertexFormat
+            );
+            cullShaderProgram = LoadShaderProgram({ { LLGL::ShaderType::Compute, "shader.hlsl", "CS", "cs_5_0" } });
+        }
+        else
+        {
+            shaderProgram = LoadShaderProgram(
+                {
+                    { LLGL::ShaderType::Vertex, "vertex.glsl" },
+                    { LLGL::ShaderType::Fragment, "fragment.glsl" }
+                },
+                vertexFormat
+            );
+            cullShaderProgram = LoadShaderProgram({ { LLGL::ShaderType::Compute, "cull.glsl" } });
+        }
+    }
+
+    void CreatePipelines()
+    {
+        // Create graphics pipeline for the scene rendering
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.shaderProgram      = shaderProgram;
+            pipelineDesc.depth.testEnabled  = true;
+            pipelineDesc.depth.writeEnabled = true;
+        }
+        pipeline = renderer->CreateGraphicsPipeline(pipelineDesc);
+
+        // Create compute pipeline for the culling
+        cullPipeline = renderer->CreateComputePipeline(cullShaderProgram);
+    }
+
+    // Extracts the normalized frustum planes from the view-projection matrix (see Gribb and Hartmann, "Fast Extraction of Viewing Frustum Planes").
+    void UpdateFrustumPlanes()
+    {
+        const auto& m = settings.vpMatrix;
+
+        auto Row = [&m](std::size_t row)
+        {
+            return Gs::Vector4f(m(row, 0), m(row, 1), m(row, 2), m(row, 3));
+        };
+
+        auto r0 = Row(0), r1 = Row(1), r2 = Row(2), r3 = Row(3);
+
+        // Use the near plane of the [-1, 1] depth range, which is conservative for the [0, 1] depth range
+        settings.frustumPlanes[0] = r3 + r0; // left
+        settings.frustumPlanes[1] = r3 - r0; // right
+        settings.frustumPlanes[2] = r3 + r1; // bottom
+        settings.frustumPlanes[3] = r3 - r1; // top
+        settings.frustumPlanes[4] = r3 + r2; // near
+        settings.frustumPlanes[5] = r3 - r2; // far
+
+        for (auto& plane : settings.frustumPlanes)
+        {
+            auto length = std::sqrt(plane.x*plane.x + plane.y*plane.y + plane.z*plane.z);
+            plane /= length;
+        }
+    }
+
+    void UpdateScene()
+    {
+        // Update view rotation by user input
+        if (input->KeyPressed(LLGL::Key::RButton) || input->KeyPressed(LLGL::Key::LButton))
+            viewRotation += static_cast<float>(input->GetMouseMotion().x) * 0.005f;
+        else
+            viewRotation += 0.002f;
+
+        // Set view-projection matrix
+        Gs::Matrix4f vMatrix;
+
+        Gs::RotateFree(vMatrix, { 0, 1, 0 }, viewRotation);
+        Gs::RotateFree(vMatrix, { 1, 0, 0 }, Gs::Deg2Rad(-10.0f));
+        Gs::Translate(vMatrix, { 0, 0, -10 });
+
+        settings.vpMatrix = projection * vMatrix.Inverse();
+
+        UpdateFrustumPlanes();
+
+        // Upload new data to the constant buffer on the GPU
+        UpdateBuffer(constantBuffer, settings);
+
+        // Print number of visible instances of the previous frame
+        if (input->KeyDown(LLGL::Key::Space))
+        {
+            auto drawArgs = renderer->MapBuffer(*drawArgsBuffer, LLGL::BufferCPUAccess::ReadOnly);
+            if (drawArgs)
+            {
+                auto numVisible = reinterpret_cast<const LLGL::DrawIndexedIndirectArguments*>(drawArgs)->numInstances;
+                std::cout << "visible instances: " << numVisible << " of " << numInstances << std::endl;
+                renderer->UnmapBuffer(*drawArgsBuffer);
+            }
+        }
+    }
+
+    void CullInstances()
+    {
+        // Reset number of visible instances
+        renderer->WriteBuffer(*drawArgsBuffer, &initialDrawArgs, sizeof(initialDrawArgs), 0);
+
+        // Append visible instances with the culling shader
+        commands->SetComputePipeline(*cullPipeline);
+        commands->SetConstantBuffer(*constantBuffer, 0, LLGL::ShaderStageFlags::ComputeStage);
+        commands->SetStorageBuffer(*boundingBuffer, 0, LLGL::ShaderStageFlags::ComputeStage | LLGL::ShaderStageFlags::ReadOnlyResource);
+        commands->SetStorageBuffer(*visibleBuffer, 1, LLGL::ShaderStageFlags::ComputeStage);
+        commands->SetStorageBuffer(*drawArgsBuffer, 2, LLGL::ShaderStageFlags::ComputeStage);
+        commands->Dispatch((numInstances + numThreadsPerGroup - 1) / numThreadsPerGroup, 1, 1);
+    }
+
+    void OnDrawFrame() override
+    {
+        UpdateScene();
+
+        // Cull instances on the GPU
+        CullInstances();
+
+        // Clear color- and depth buffers
+        commands->Clear(LLGL::ClearFlags::Color | LLGL::ClearFlags::Depth);
+
+        // Set buffers and graphics pipeline state
+        commands->SetVertexBuffer(*vertexBuffer);
+        commands->SetIndexBuffer(*indexBuffer);
+        commands->SetConstantBuffer(*constantBuffer, 0, LLGL::ShaderStageFlags::VertexStage);
+        commands->SetStorageBuffer(*instanceBuffer, 0, LLGL::ShaderStageFlags::VertexStage | LLGL::ShaderStageFlags::ReadOnlyResource);
+        commands->SetStorageBuffer(*visibleBuffer, 1, LLGL::ShaderStageFlags::VertexStage | LLGL::ShaderStageFlags::ReadOnlyResource);
+        commands->SetGraphicsPipeline(*pipeline);
+
+        // Draw all visible instances with the arguments that have been written by the culling shader
+        commands->DrawIndexedIndirect(*drawArgsBuffer, 0);
+
+        // Present result on the screen
+        context->Present();
+    }
+
+};
+
+LLGL_IMPLEMENT_TUTORIAL(Tutorial13);
+
+
+
@@ -0,0 +1,89 @@
+// HLSL shader version 5.0 (for Direct3D 11/ 12)
+
+cbuffer Settings : register(b0)
+{
+	float4x4	vpMatrix;
+	float4		frustumPlanes[6];
+	uint		numInstances;
+};
+
+
+// COMPUTE SHADER
+
+// Bounding sphere of each instance (xyz = center, w = radius)
+StructuredBuffer<float4> boundingSpheres : register(t0);
+
+// Compacted indices of all visible instances
+RWStructuredBuffer<uint> visibleInstancesOut : register(u1);
+
+// Arguments for the indirect draw command (see LLGL::DrawIndexedIndirectArguments)
+RWByteAddressBuffer drawArguments : register(u2);
+
+[numthreads(64, 1, 1)]
+void CS(uint3 threadID : SV_DispatchThreadID)
+{
+	uint id = threadID.x;
+	if (id >= numInstances)
+		return;
+	
+	// Test bounding sphere against all frustum planes
+	float4 sphere = boundingSpheres[id];
+	
+	for (int i = 0; i < 6; ++i)
+	{
+		if (dot(frustumPlanes[i].xyz, sphere.xyz) + frustumPlanes[i].w < -sphere.w)
+			return;
+	}
+	
+	// Append instance to the visible instances (byte offset 4 is the number of instances)
+	uint slot;
+	drawArguments.InterlockedAdd(4, 1, slot);
+	visibleInstancesOut[slot] = id;
+}
+
+
+// VERTEX SHADER
+
+struct Instance
+{
+	float4x4	wMatrix;
+	float4		color;
+};
+
+StructuredBuffer<Instance> instances : register(t0);
+StructuredBuffer<uint> visibleInstances : register(t1);
+
+struct InputVS
+{
+	float3	position	: POSITION;
+	uint	instanceID	: SV_InstanceID;
+};
+
+struct OutputVS
+{
+	float4 position	: SV_Position;
+	float3 color	: COLOR;
+};
+
+OutputVS VS(InputVS inp)
+{
+	OutputVS outp;
+	
+	// Fetch instance by the compacted index that has been written by the culling shader
+	Instance inst = instances[visibleInstances[inp.instanceID]];
+	
+	outp.position = mul(vpMatrix, mul(inst.wMatrix, float4(inp.position, 1.0)));
+	
+	// Shade cube corners a little differently
+	outp.color = inst.color.rgb * (0.75 + 0.25 * inp.position.y);
+	
+	return outp;
+}
+
+
+// PIXEL SHADER
+
+float4 PS(OutputVS inp) : SV_Target
+{
+	return float4(inp.color, 1.0);
+};
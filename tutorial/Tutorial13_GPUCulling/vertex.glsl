@@ -0,0 +1,44 @@
+// GLSL vertex shader
+#version 430
+
+layout(std140, binding = 0) uniform Settings
+{
+	mat4 vpMatrix;
+	vec4 frustumPlanes[6];
+	uint numInstances;
+};
+
+struct Instance
+{
+	mat4 wMatrix;
+	vec4 color;
+};
+
+layout(std430, binding = 0) readonly buffer Instances
+{
+	Instance instances[];
+};
+
+layout(std430, binding = 1) readonly buffer VisibleInstances
+{
+	uint visibleInstances[];
+};
+
+// Per-vertex attributes
+in vec3 position;
+
+// Vertex output to the fragment shader
+out vec3 vColor;
+
+// Vertex shader main function
+void main()
+{
+	// Fetch instance by the compacted index that has been written by the culling shader
+	Instance inst = instances[visibleInstances[gl_InstanceID]];
+	
+	gl_Position = inst.wMatrix * vec4(position, 1.0);
+	gl_Position = vpMatrix * gl_Position;
+	
+	// Shade cube corners a little differently
+	vColor = inst.color.rgb * (0.75 + 0.25 * position.y);
+}
@@ -11,11 +11,16 @@
 
 #include <LLGL/LLGL.h>
 #include <LLGL/Utility.h>
+#include <LLGL/Log.h>
+#include <LLGL/GPUProfiler.h>
 #include <Gauss/Gauss.h>
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <type_traits>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -107,7 +112,21 @@ public:
 
     static void SelectRendererModule(int argc, char* argv[])
     {
-        rendererModule_ = GetSelectedRendererModule(argc, argv);
+        // Extract benchmark options and pass all other arguments on to the renderer selection
+        std::vector<char*> args;
+
+        for (int i = 0; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--benchmark" && i + 1 < argc)
+                benchmarkFrames_ = static_cast<unsigned int>(std::stoul(argv[++i]));
+            else if (arg == "--benchmark-output" && i + 1 < argc)
+                benchmarkOutput_ = argv[++i];
+            else
+                args.push_back(argv[i]);
+        }
+
+        rendererModule_ = GetSelectedRendererModule(static_cast<int>(args.size()), args.data());
     }
 
     virtual ~Tutorial()
@@ -116,6 +135,12 @@ public:
 
     void Run()
     {
+        if (IsBenchmark())
+        {
+            RunBenchmark();
+            return;
+        }
+
         auto& window = static_cast<LLGL::Window&>(context->GetSurface());
         while (window.ProcessEvents() && !input->KeyDown(LLGL::Key::Escape))
         {
@@ -157,13 +182,13 @@ public:
         
         void OnError(LLGL::ErrorType type, Message& message) override
         {
-            std::cerr << "ERROR: " << message.GetSource() << ": " << message.GetText() << std::endl;
+            LLGL::Log::Post(LLGL::Log::Severity::Error, "ERROR: " + message.GetSource() + ": " + message.GetText());
             message.Block();
         }
 
         void OnWarning(LLGL::WarningType type, Message& message) override
         {
-            std::cerr << "WARNING: " << message.GetSource() << ": " << message.GetText() << std::endl;
+            LLGL::Log::Post(LLGL::Log::Severity::Warning, "WARNING: " + message.GetSource() + ": " + message.GetText());
             message.Block();
         }
 
@@ -248,7 +273,135 @@ private:
 
     bool                                        loadingDone_    = false;
 
+    std::wstring                                title_;
+
     static std::string                          rendererModule_;
+    static unsigned int                         benchmarkFrames_;
+    static std::string                          benchmarkOutput_;
+
+    // Returns the percentile 'p' (in the range [0, 1]) of the specified values with the nearest-rank method.
+    static double Percentile(std::vector<double> values, double p)
+    {
+        if (values.empty())
+            return 0.0;
+        auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(values.size())));
+        auto nth = values.begin() + (std::max(rank, std::size_t(1)) - 1);
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    }
+
+    // Writes a JSON object with the statistics of the specified values (in milliseconds).
+    static void WriteJSONStatistics(std::ostream& s, const std::vector<double>& values)
+    {
+        double sum = 0.0;
+        for (auto v : values)
+            sum += v;
+
+        s << "{ ";
+        s << "\"samples\": " << values.size();
+        if (!values.empty())
+        {
+            s << ", \"min\": " << *std::min_element(values.begin(), values.end());
+            s << ", \"avg\": " << sum / static_cast<double>(values.size());
+            s << ", \"p50\": " << Percentile(values, 0.50);
+            s << ", \"p90\": " << Percentile(values, 0.90);
+            s << ", \"p99\": " << Percentile(values, 0.99);
+            s << ", \"max\": " << *std::max_element(values.begin(), values.end());
+        }
+        s << " }";
+    }
+
+    // Renders the specified number of frames without window and vsync, and writes the frame timings and counters as JSON file.
+    void RunBenchmark()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<double> frameTimes, gpuTimes;
+        frameTimes.reserve(benchmarkFrames_);
+
+        // Measure GPU time of each frame if timestamp queries are supported
+        std::unique_ptr<LLGL::GPUProfiler> gpuProfiler { new LLGL::GPUProfiler(*renderer, *commands) };
+        std::uint64_t nextGPUFrame = 0;
+
+        std::cout << "benchmark: rendering " << benchmarkFrames_ << " frames ..." << std::endl;
+
+        for (unsigned int i = 0; i < benchmarkFrames_; ++i)
+        {
+            if (gpuProfiler)
+            {
+                try
+                {
+                    gpuProfiler->BeginFrame();
+                }
+                catch (const std::exception&)
+                {
+                    gpuProfiler.reset();
+                }
+            }
+
+            auto startTime = Clock::now();
+            OnDrawFrame();
+            auto frameTime = std::chrono::duration<double>(Clock::now() - startTime).count();
+
+            frameTimes.push_back(frameTime * 1000.0);
+            profilerObj_->NextFrame(frameTime);
+
+            if (gpuProfiler)
+            {
+                // Only the most recently resolved frame is available, so some GPU frames might not be sampled
+                gpuProfiler->EndFrame();
+                if (gpuProfiler->HasResolvedFrame() && gpuProfiler->GetResolvedFrame().frameIndex >= nextGPUFrame)
+                {
+                    const auto& gpuFrame = gpuProfiler->GetResolvedFrame();
+                    gpuTimes.push_back(static_cast<double>(gpuFrame.elapsedTime) / 1000000.0);
+                    nextGPUFrame = gpuFrame.frameIndex + 1;
+                }
+            }
+        }
+
+        // Write results as JSON file
+        auto rendererName = renderer->GetName();
+        auto filename = benchmarkOutput_;
+        if (filename.empty())
+        {
+            filename = "benchmark_" + rendererName + ".json";
+            std::replace(filename.begin(), filename.end(), ' ', '_');
+        }
+
+        std::ofstream file(filename);
+        if (!file.good())
+            throw std::runtime_error("failed to write benchmark results to file: \"" + filename + "\"");
+
+        const auto& info = renderer->GetRendererInfo();
+        const auto& resolution = context->GetVideoMode().resolution;
+
+        file << "{\n";
+        file << "  \"tutorial\": \"" << std::string(title_.begin(), title_.end()) << "\",\n";
+        file << "  \"renderer\": \"" << rendererName << "\",\n";
+        file << "  \"device\": \"" << info.deviceName << "\",\n";
+        file << "  \"resolution\": [ " << resolution.x << ", " << resolution.y << " ],\n";
+        file << "  \"frames\": " << benchmarkFrames_ << ",\n";
+        file << "  \"frameTimeMs\": ";
+        WriteJSONStatistics(file, frameTimes);
+        file << ",\n";
+        file << "  \"gpuTimeMs\": ";
+        if (gpuProfiler)
+            WriteJSONStatistics(file, gpuTimes);
+        else
+            file << "null";
+        file << ",\n";
+        file << "  \"countersPerFrame\": {\n";
+        for (std::size_t i = 0; i < LLGL::RenderingProfiler::numCounters; ++i)
+        {
+            auto stats = profilerObj_->GetCounterStatistics(i);
+            file << "    \"" << LLGL::RenderingProfiler::GetCounterName(i) << "\": { \"avg\": " << stats.avg << ", \"p99\": " << stats.p99 << " }";
+            file << (i + 1 < LLGL::RenderingProfiler::numCounters ? ",\n" : "\n");
+        }
+        file << "  }\n";
+        file << "}\n";
+
+        std::cout << "benchmark: results written to " << filename << std::endl;
+    }
 
 public:
 
@@ -294,23 +447,25 @@ protected:
         unsigned int        multiSampling   = 8,
         bool                vsync           = true,
         bool                debugger        = true) :
-            profilerObj_ { new LLGL::RenderingProfiler() },
-            debuggerObj_ { new Debugger()                },
-            timer        { LLGL::Timer::Create()         },
-            profiler     { *profilerObj_                 }
+            profilerObj_ { new LLGL::RenderingProfiler(IsBenchmark() ? benchmarkFrames_ : 128) },
+            debuggerObj_ { new Debugger()                                                    },
+            title_       { title                                                             },
+            timer        { LLGL::Timer::Create()                                             },
+            profiler     { *profilerObj_                                                     }
     {
-        // Create render system
+        // Create render system (benchmarks only count the commands without validating them)
         renderer = LLGL::RenderSystem::Load(
             rendererModule_,
-            (debugger ? profilerObj_.get() : nullptr),
-            (debugger ? debuggerObj_.get() : nullptr)
+            (debugger || IsBenchmark() ? profilerObj_.get() : nullptr),
+            (debugger && !IsBenchmark() ? debuggerObj_.get() : nullptr)
         );
 
         // Create render context
         LLGL::RenderContextDescriptor contextDesc;
         {
             contextDesc.videoMode.resolution    = resolution;
-            contextDesc.vsync.enabled           = vsync;
+            contextDesc.vsync.enabled           = (vsync && !IsBenchmark());
+            contextDesc.headless                = IsBenchmark();
             contextDesc.multiSampling.enabled   = (multiSampling > 1);
             contextDesc.multiSampling.samples   = multiSampling;
             
@@ -350,35 +505,41 @@ protected:
         std::cout << "  vendor:           " << info.vendorName << std::endl;
         std::cout << "  shading language: " << info.shadingLanguageName << std::endl;
 
-        // Set window title
-        auto& window = static_cast<LLGL::Window&>(context->GetSurface());
+        // Create input event listener
+        input = std::make_shared<LLGL::Input>();
 
-        auto rendererName = renderer->GetName();
-        window.SetTitle(title + L" ( " + std::wstring(rendererName.begin(), rendererName.end()) + L" )");
+        // Initialize default projection matrix
+        projection = PerspectiveProjection(GetAspectRatio(), 0.1f, 100.0f, Gs::Deg2Rad(45.0f));
 
-        // Add input event listener to window
-        input = std::make_shared<LLGL::Input>();
-        window.AddEventListener(input);
+        // Headless render context for benchmarks has no window
+        if (!IsBenchmark())
+        {
+            // Set window title
+            auto& window = static_cast<LLGL::Window&>(context->GetSurface());
 
-        // Change window descriptor to allow resizing
-        auto wndDesc = window.GetDesc();
-        wndDesc.resizable = true;
-        window.SetDesc(wndDesc);
+            auto rendererName = renderer->GetName();
+            window.SetTitle(title + L" ( " + std::wstring(rendererName.begin(), rendererName.end()) + L" )");
 
-        // Change window behavior
-        auto behavior = window.GetBehavior();
-        behavior.disableClearOnResize = true;
-        behavior.moveAndResizeTimerID = 1;
-        window.SetBehavior(behavior);
+            // Add input event listener to window
+            window.AddEventListener(input);
 
-        // Add window resize listener
-        window.AddEventListener(std::make_shared<ResizeEventHandler>(*this, context, commands, projection));
+            // Change window descriptor to allow resizing
+            auto wndDesc = window.GetDesc();
+            wndDesc.resizable = true;
+            window.SetDesc(wndDesc);
 
-        // Initialize default projection matrix
-        projection = PerspectiveProjection(GetAspectRatio(), 0.1f, 100.0f, Gs::Deg2Rad(45.0f));
+            // Change window behavior
+            auto behavior = window.GetBehavior();
+            behavior.disableClearOnResize = true;
+            behavior.moveAndResizeTimerID = 1;
+            window.SetBehavior(behavior);
+
+            // Add window resize listener
+            window.AddEventListener(std::make_shared<ResizeEventHandler>(*this, context, commands, projection));
 
-        // Show window
-        window.Show();
+            // Show window
+            window.Show();
+        }
 
         // Store information that loading is done
         loadingDone_ = true;
@@ -803,6 +964,12 @@ protected:
         return (resolution.x / resolution.y);
     }
 
+    // Returns true if the tutorial runs in benchmark mode (see "--benchmark N" command line option).
+    static bool IsBenchmark()
+    {
+        return (benchmarkFrames_ > 0);
+    }
+
     // Returns ture if OpenGL is used as rendering API.
     bool IsOpenGL() const
     {
@@ -824,6 +991,8 @@ protected:
 };
 
 std::string Tutorial::rendererModule_;
+unsigned int Tutorial::benchmarkFrames_ = 0;
+std::string Tutorial::benchmarkOutput_;
 
 
 template <typename T>